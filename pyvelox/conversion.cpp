@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,157 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+// Keeps a Python object alive while a Velox buffer views its memory. Velox
+// may release the buffer on any thread, so the reference count is updated
+// under the GIL.
+class PyObjectReleaser {
+ public:
+  explicit PyObjectReleaser(const py::handle& object) : object_(object) {}
+
+  void addRef() const {
+    py::gil_scoped_acquire gil;
+    object_.inc_ref();
+  }
+
+  void release() const {
+    py::gil_scoped_acquire gil;
+    object_.dec_ref();
+  }
+
+ private:
+  const py::handle object_;
+};
+
+template <typename T>
+VectorPtr numpyToFlatVector(
+    const py::array& array,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  auto size = array.size();
+  if constexpr (std::is_same_v<T, bool>) {
+    // Velox booleans are bits, NumPy booleans are bytes.
+    auto result = BaseVector::create<FlatVector<bool>>(type, size, pool);
+    const auto* data = static_cast<const bool*>(array.data());
+    for (auto i = 0; i < size; ++i) {
+      result->set(i, data[i]);
+    }
+    return result;
+  } else {
+    auto values = BufferView<PyObjectReleaser>::create(
+        static_cast<const uint8_t*>(array.data()),
+        array.nbytes(),
+        PyObjectReleaser(array));
+    return std::make_shared<FlatVector<T>>(
+        pool,
+        type,
+        BufferPtr(nullptr),
+        size,
+        std::move(values),
+        std::vector<BufferPtr>{});
+  }
+}
+
+VectorPtr importFromNumpy(const py::array& input, memory::MemoryPool* pool) {
+  if (input.ndim() != 1) {
+    throw py::value_error("Only 1-dimensional NumPy arrays are supported");
+  }
+  // Copies the array only if it is not contiguous.
+  auto array = py::array::ensure(input, py::array::c_style);
+  if (!array.dtype().attr("isnative").cast<bool>()) {
+    throw py::value_error(
+        "Only NumPy arrays in native byte order are supported");
+  }
+  switch (array.dtype().num()) {
+    case py::detail::npy_api::NPY_BOOL_:
+      return numpyToFlatVector<bool>(array, BOOLEAN(), pool);
+    case py::detail::npy_api::NPY_BYTE_:
+      return numpyToFlatVector<int8_t>(array, TINYINT(), pool);
+    case py::detail::npy_api::NPY_SHORT_:
+      return numpyToFlatVector<int16_t>(array, SMALLINT(), pool);
+    case py::detail::npy_api::NPY_INT_:
+      return numpyToFlatVector<int32_t>(array, INTEGER(), pool);
+    case py::detail::npy_api::NPY_LONG_:
+    case py::detail::npy_api::NPY_LONGLONG_:
+      if (array.itemsize() != sizeof(int64_t)) {
+        break;
+      }
+      return numpyToFlatVector<int64_t>(array, BIGINT(), pool);
+    case py::detail::npy_api::NPY_FLOAT_:
+      return numpyToFlatVector<float>(array, REAL(), pool);
+    case py::detail::npy_api::NPY_DOUBLE_:
+      return numpyToFlatVector<double>(array, DOUBLE(), pool);
+    default:
+      break;
+  }
+  throw py::type_error(
+      "Unsupported NumPy dtype: " + py::str(array.dtype()).cast<std::string>());
+}
+
+template <typename T>
+py::array flatVectorToNumpy(const VectorPtr& vector) {
+  auto* flat = vector->asUnchecked<FlatVector<T>>();
+  if constexpr (std::is_same_v<T, bool>) {
+    py::array_t<bool> result(vector->size());
+    auto* data = result.mutable_data();
+    for (auto i = 0; i < vector->size(); ++i) {
+      data[i] = flat->valueAtFast(i);
+    }
+    return result;
+  } else {
+    // The array views the values of the vector and keeps it alive.
+    py::capsule owner(new VectorPtr(vector), [](void* vectorPtr) {
+      delete static_cast<VectorPtr*>(vectorPtr);
+    });
+    py::array result(
+        py::dtype::of<T>(), {vector->size()}, flat->rawValues(), owner);
+    // Velox buffers may be shared with other vectors.
+    result.attr("setflags")(py::arg("write") = false);
+    return result;
+  }
+}
+
+py::array exportToNumpy(VectorPtr vector) {
+  if (!vector->type()->isPrimitiveType() || vector->type()->isDecimal() ||
+      vector->typeKind() == TypeKind::VARCHAR ||
+      vector->typeKind() == TypeKind::VARBINARY ||
+      vector->typeKind() == TypeKind::TIMESTAMP) {
+    throw py::type_error(
+        "Only numeric and boolean vectors can be exported to NumPy, use "
+        "export_to_arrow for " +
+        vector->type()->toString());
+  }
+  BaseVector::flattenVector(vector);
+  if (vector->mayHaveNulls() &&
+      BaseVector::countNulls(vector->nulls(), vector->size()) > 0) {
+    throw py::value_error(
+        "Vectors with nulls cannot be exported to NumPy, use "
+        "export_to_arrow instead");
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::BOOLEAN:
+      return flatVectorToNumpy<bool>(vector);
+    case TypeKind::TINYINT:
+      return flatVectorToNumpy<int8_t>(vector);
+    case TypeKind::SMALLINT:
+      return flatVectorToNumpy<int16_t>(vector);
+    case TypeKind::INTEGER:
+      return flatVectorToNumpy<int32_t>(vector);
+    case TypeKind::BIGINT:
+      return flatVectorToNumpy<int64_t>(vector);
+    case TypeKind::REAL:
+      return flatVectorToNumpy<float>(vector);
+    case TypeKind::DOUBLE:
+      return flatVectorToNumpy<double>(vector);
+    default:
+      throw py::type_error(
+          "Unsupported type for NumPy export: " + vector->type()->toString());
+  }
+}
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +201,20 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "from_numpy",
+      [](const py::array& array) {
+        return importFromNumpy(
+            array, PyVeloxContext::getSingletonInstance().pool());
+      },
+      "Creates a flat vector from a 1-dimensional numeric or boolean NumPy "
+      "array. The vector shares the memory of contiguous numeric arrays.");
+
+  m.def(
+      "to_numpy",
+      &exportToNumpy,
+      "Returns a read-only NumPy array over the values of a numeric or "
+      "boolean vector without nulls. Flat numeric vectors are not copied.");
 }
 } // namespace facebook::velox::py
@@ -208,12 +208,20 @@ static VectorPtr evaluateExpression(
   RowVectorPtr rowVector = std::make_shared<RowVector>(
       pool, rowType, BufferPtr{nullptr}, numRows, inputs);
   core::TypedExprPtr typed = core::Expressions::inferTypes(expr, rowType, pool);
-  exec::ExprSet set({typed}, PyVeloxContext::getSingletonInstance().execCtx());
-  exec::EvalCtx evalCtx(
-      PyVeloxContext::getSingletonInstance().execCtx(), &set, rowVector.get());
+  // Each evaluation has its own ExecCtx because the Python threads may
+  // evaluate concurrently once the GIL is released.
+  core::ExecCtx execCtx(
+      pool, PyVeloxContext::getSingletonInstance().queryCtx());
+  exec::ExprSet set({typed}, &execCtx);
+  exec::EvalCtx evalCtx(&execCtx, &set, rowVector.get());
   SelectivityVector rows(numRows);
   std::vector<VectorPtr> result;
-  set.eval(rows, evalCtx, result);
+  {
+    // Evaluation does not touch Python objects. Buffers viewing NumPy arrays
+    // take the GIL when they are released.
+    py::gil_scoped_release release;
+    set.eval(rows, evalCtx, result);
+  }
   return result[0];
 }
 
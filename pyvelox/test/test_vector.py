@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -321,3 +322,56 @@ class TestVeloxVector(unittest.TestCase):
                 self.assertTrue(velox_vector.dtype(), expected_type)
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
+
+    def test_from_numpy(self):
+        test_cases = [
+            (np.array([1, 2, 3], dtype=np.int32), pv.IntegerType()),
+            (np.array([4, 5, 6], dtype=np.int64), pv.BigintType()),
+            (np.array([0.5, 1.5], dtype=np.float64), pv.DoubleType()),
+            (np.array([True, False, True]), pv.BooleanType()),
+        ]
+        for array, expected_type in test_cases:
+            with self.subTest(array=array):
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.size(), len(array))
+                self.assertEqual(vector.dtype(), expected_type)
+                for i in range(0, len(array)):
+                    self.assertEqual(vector[i], array[i])
+
+        # Numeric arrays are not copied.
+        array = np.array([1, 2, 3], dtype=np.int64)
+        vector = pv.from_numpy(array)
+        array[0] = 10
+        self.assertEqual(vector[0], 10)
+
+        # Strided arrays are copied into contiguous memory.
+        vector = pv.from_numpy(np.arange(10, dtype=np.int64)[::2])
+        self.assertEqual([vector[i] for i in range(5)], [0, 2, 4, 6, 8])
+
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.zeros((2, 2), dtype=np.int64))
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array(["a", "b"]))
+
+    def test_to_numpy(self):
+        vector = pv.from_list([1, 2, 3])
+        array = pv.to_numpy(vector)
+        self.assertEqual(array.dtype, np.int64)
+        self.assertListEqual(array.tolist(), [1, 2, 3])
+        self.assertFalse(array.flags.writeable)
+
+        # The array keeps the vector alive.
+        del vector
+        self.assertListEqual(array.tolist(), [1, 2, 3])
+
+        self.assertListEqual(
+            pv.to_numpy(pv.from_list([True, False])).tolist(), [True, False])
+
+        array = np.array([0.25, 0.5, 0.75])
+        self.assertListEqual(
+            pv.to_numpy(pv.from_numpy(array)).tolist(), array.tolist())
+
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None, 3]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
@@ -98,6 +98,25 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorSize_;
   }
 
+  // Runs over a decoded dictionary vector after gathering its values into a
+  // flat buffer.
+  size_t gatheredRunDict() {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(*dictionaryVector_, rows_);
+    suspender.dismiss();
+    gatheredRun(decodedVector);
+    return vectorSize_;
+  }
+
+  // Same as above over a 5-way nested dictionary vector.
+  size_t gatheredRunDict5Nested() {
+    folly::BenchmarkSuspender suspender;
+    DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
+    suspender.dismiss();
+    gatheredRun(decodedVector);
+    return vectorSize_;
+  }
+
   // Measure time to decode a flat vector.
   void decodeFlat() {
     DecodedVector decodedVector(*flatVector_, rows_);
@@ -127,6 +146,15 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::doNotOptimizeAway(sum);
   }
 
+  void gatheredRun(const DecodedVector& decodedVector) {
+    decodedVector.gather(rows_, gathered_.data());
+    size_t sum = 0;
+    for (auto i = 0; i < vectorSize_; i++) {
+      sum += gathered_[i];
+    }
+    folly::doNotOptimizeAway(sum);
+  }
+
   const size_t vectorSize_;
 
   VectorPtr flatVector_;
@@ -135,6 +163,7 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr dictionaryNestedVector_;
 
   SelectivityVector rows_;
+  std::vector<int64_t> gathered_ = std::vector<int64_t>(vectorSize_);
 };
 
 std::unique_ptr<DecodedVectorBenchmark> benchmark;
@@ -166,6 +195,14 @@ BENCHMARK(scanDecodedDict5Nested) {
   run([&] { benchmark->decodedRunDict5Nested(); });
 }
 
+BENCHMARK(scanGatheredDict) {
+  run([&] { benchmark->gatheredRunDict(); });
+}
+
+BENCHMARK(scanGatheredDict5Nested) {
+  run([&] { benchmark->gatheredRunDict5Nested(); });
+}
+
 BENCHMARK_DRAW_LINE();
 
 // For those we alwast report total runtime.
@@ -50,6 +50,10 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
  public:
   explicit LikeFunctionsBenchmark() {
     exec::registerStatefulVectorFunction("like", likeSignatures(), makeLike);
+    exec::registerStatefulVectorFunction(
+        "regexp_like", re2SearchSignatures(), makeRe2Search);
+    exec::registerStatefulVectorFunction(
+        "regexp_like_any", re2SearchAnySignatures(), makeRe2SearchAny);
 
     VectorFuzzer::Options opts;
     opts.vectorSize = FLAGS_vector_size;
@@ -91,6 +95,11 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
         auto fixedPatternString = inputString.substr(fixedPatternStartIdx, 10);
         return generateRandomString(kAnyWildcardCharacter) + fixedPatternString;
       }
+      case PatternKind::kSubstring: {
+        auto fixedPatternString = inputString.substr(inputString.size() / 3, 5);
+        return generateRandomString(kAnyWildcardCharacter) +
+            fixedPatternString + generateRandomString(kAnyWildcardCharacter);
+      }
       default:
         return inputString;
     }
@@ -123,11 +132,18 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
     }
   }
 
-  size_t run(const TpchBenchmarkCase tpchCase, const StringView patternString) {
+  // With 'escape', the pattern has an escape character, which makes LIKE
+  // match it with RE2 instead of an optimized path.
+  size_t run(
+      const TpchBenchmarkCase tpchCase,
+      const StringView patternString,
+      bool escape = false) {
     folly::BenchmarkSuspender kSuspender;
     const auto input = getTpchData(tpchCase);
     const auto data = makeRowVector({input});
-    auto likeExpression = fmt::format("like(c0, '{}')", patternString);
+    auto likeExpression = escape
+        ? fmt::format("like(c0, '{}', '#')", patternString)
+        : fmt::format("like(c0, '{}')", patternString);
     auto rowType = std::dynamic_pointer_cast<const RowType>(data->type());
     exec::ExprSet exprSet =
         FunctionBenchmarkBase::compileExpression(likeExpression, rowType);
@@ -165,6 +181,44 @@ class LikeFunctionsBenchmark : public FunctionBaseTest,
     return cnt;
   }
 
+  // Matches the part names with an OR of 'numPatterns' LIKEs of the form
+  // '%color%', with or without combining them into one regexp_like_any.
+  size_t runDisjunction(size_t numPatterns, bool combine) {
+    folly::BenchmarkSuspender kSuspender;
+    static const std::vector<std::string> kColors = {
+        "almond", "antique", "aquamarine", "azure", "beige", "bisque", "black",
+        "blanched", "blue", "blush", "brown", "burlywood", "burnished",
+        "chartreuse", "chiffon", "chocolate", "coral", "cornflower", "cornsilk",
+        "cream", "cyan", "dark", "deep", "dim", "dodger", "drab", "firebrick",
+        "floral", "forest", "frosted"};
+    VELOX_CHECK_LE(numPatterns, kColors.size());
+    const auto data =
+        makeRowVector({getTpchData(TpchBenchmarkCase::TpchQuery9)});
+    std::vector<std::string> likes;
+    for (auto i = 0; i < numPatterns; ++i) {
+      likes.push_back(fmt::format("like(c0, '%{}%')", kColors[i]));
+    }
+    if (combine) {
+      exec::registerExpressionRewrite(
+          "regexp_like_any",
+          makeRe2DisjunctionRewrite("like", "regexp_like", "regexp_like_any"));
+    }
+    auto rowType = std::dynamic_pointer_cast<const RowType>(data->type());
+    exec::ExprSet exprSet = FunctionBenchmarkBase::compileExpression(
+        folly::join(" OR ", likes), rowType);
+    exec::unregisterExpressionRewrite("regexp_like_any");
+    kSuspender.dismiss();
+
+    size_t cnt = 0;
+    for (auto i = 0; i < FLAGS_num_runs; i++) {
+      auto result = FunctionBenchmarkBase::evaluate(exprSet, data);
+      cnt += result->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+
+    return cnt;
+  }
+
   // We inherit from FunctionBaseTest so that we can get access to the helpers
   // it defines, but since it is supposed to be a test fixture TestBody() is
   // declared pure virtual.  We must provide an implementation here.
@@ -199,16 +253,32 @@ BENCHMARK(suffixPattern) {
   benchmark->run(PatternKind::kSuffix);
 }
 
+BENCHMARK(substringPattern) {
+  benchmark->run(PatternKind::kSubstring);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(tpchQuery2) {
   benchmark->run(TpchBenchmarkCase::TpchQuery2, "%BRASS");
 }
 
-BENCHMARK(tpchQuery9) {
+BENCHMARK(tpchQuery9Re2) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery9, "%green%", true);
+}
+
+BENCHMARK_RELATIVE(tpchQuery9) {
   benchmark->run(TpchBenchmarkCase::TpchQuery9, "%green%");
 }
 
+BENCHMARK(orderCommentSubstringRe2) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special%", true);
+}
+
+BENCHMARK_RELATIVE(orderCommentSubstring) {
+  benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special%");
+}
+
 BENCHMARK(tpchQuery13) {
   benchmark->run(TpchBenchmarkCase::TpchQuery13, "%special%requests%");
 }
@@ -230,6 +300,32 @@ BENCHMARK(tpchQuery20) {
   benchmark->run(TpchBenchmarkCase::TpchQuery20, "forest%");
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(likeDisjunction3) {
+  benchmark->runDisjunction(3, false);
+}
+
+BENCHMARK_RELATIVE(likeDisjunction3Combined) {
+  benchmark->runDisjunction(3, true);
+}
+
+BENCHMARK(likeDisjunction10) {
+  benchmark->runDisjunction(10, false);
+}
+
+BENCHMARK_RELATIVE(likeDisjunction10Combined) {
+  benchmark->runDisjunction(10, true);
+}
+
+BENCHMARK(likeDisjunction30) {
+  benchmark->runDisjunction(30, false);
+}
+
+BENCHMARK_RELATIVE(likeDisjunction30Combined) {
+  benchmark->runDisjunction(30, true);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -19,14 +19,21 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fstream>
+#include <random>
+#include <thread>
 
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MemoryArbitrator.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/dwio/common/Options.h"
@@ -82,6 +89,58 @@ void printResults(const std::vector<RowVectorPtr>& results, std::ostream& out) {
     }
   }
 }
+
+folly::dynamic timingToJson(const CpuWallTiming& timing) {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["count"] = timing.count;
+  obj["cpuNanos"] = timing.cpuNanos;
+  obj["wallNanos"] = timing.wallNanos;
+  return obj;
+}
+
+/// Returns the execution time, peak memory and spill stats of a finished run of
+/// 'query' with per operator stats.
+folly::dynamic runToJson(
+    const std::string& query,
+    const TaskStats& stats,
+    int64_t peakMemoryBytes) {
+  folly::dynamic operators = folly::dynamic::array;
+  uint64_t spilledBytes = 0;
+  for (const auto& pipeline : stats.pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      folly::dynamic obj = folly::dynamic::object;
+      obj["pipelineId"] = op.pipelineId;
+      obj["operatorId"] = op.operatorId;
+      obj["planNodeId"] = op.planNodeId;
+      obj["operatorType"] = op.operatorType;
+      obj["inputRows"] = op.inputPositions;
+      obj["inputBytes"] = op.inputBytes;
+      obj["outputRows"] = op.outputPositions;
+      obj["outputBytes"] = op.outputBytes;
+      obj["rawInputBytes"] = op.rawInputBytes;
+      obj["addInputTiming"] = timingToJson(op.addInputTiming);
+      obj["getOutputTiming"] = timingToJson(op.getOutputTiming);
+      obj["finishTiming"] = timingToJson(op.finishTiming);
+      obj["blockedWallNanos"] = op.blockedWallNanos;
+      obj["peakMemoryBytes"] = op.memoryStats.peakTotalMemoryReservation;
+      obj["spilledBytes"] = op.spilledBytes;
+      obj["spilledRows"] = op.spilledRows;
+      spilledBytes += op.spilledBytes;
+      operators.push_back(std::move(obj));
+    }
+  }
+
+  folly::dynamic obj = folly::dynamic::object;
+  obj["query"] = query;
+  obj["executionTimeMs"] =
+      stats.executionEndTimeMs - stats.executionStartTimeMs;
+  obj["numTotalSplits"] = stats.numTotalSplits;
+  obj["numFinishedSplits"] = stats.numFinishedSplits;
+  obj["peakMemoryBytes"] = peakMemoryBytes;
+  obj["spilledBytes"] = spilledBytes;
+  obj["operators"] = std::move(operators);
+  return obj;
+}
 } // namespace
 
 DEFINE_string(
@@ -118,6 +177,12 @@ DEFINE_bool(
     false,
     "Include custom statistics along with execution statistics");
 DEFINE_bool(include_results, false, "Include results in the output");
+DEFINE_string(
+    json_results_path,
+    "",
+    "If set, appends a line of JSON with the per operator stats, spilled bytes "
+    "and peak memory of each run with --run_query_verbose or "
+    "--io_meter_column_pct to this file");
 DEFINE_bool(use_native_parquet_reader, true, "Use Native Parquet Reader");
 DEFINE_int32(num_drivers, 4, "Number of drivers");
 DEFINE_string(data_format, "parquet", "Data format");
@@ -164,6 +229,41 @@ DEFINE_bool(
     "Runs one warmup of the query before "
     "measured run. Use to run warm after clearing caches.");
 
+DEFINE_int32(
+    num_query_streams,
+    0,
+    "If non-0, runs this many concurrent streams of queries instead of one "
+    "query at a time and reports the throughput. The streams share the "
+    "cache, memory manager and executor");
+DEFINE_int32(
+    num_queries_per_stream,
+    0,
+    "Number of queries run by each stream with --num_query_streams. 0 runs "
+    "each of --stream_queries once");
+DEFINE_string(
+    stream_queries,
+    "",
+    "Comma separated TPC-H query numbers run by --num_query_streams. Each "
+    "stream runs them in its own random order. Empty means all queries");
+DEFINE_int32(
+    stream_seed,
+    1,
+    "Seed for the random query order of --num_query_streams");
+DEFINE_int32(
+    num_cpu_threads,
+    0,
+    "Threads of the executor shared by --num_query_streams. 0 means the "
+    "number of hardware threads");
+DEFINE_int32(
+    query_memory_gb,
+    0,
+    "If non-0 with --num_query_streams, the queries share this much memory "
+    "through the shared memory arbitrator");
+DEFINE_string(
+    spill_path,
+    "",
+    "If set with --num_query_streams, enables spilling to this directory");
+
 DEFINE_validator(data_path, &notEmpty);
 DEFINE_validator(data_format, &validateDataFormat);
 
@@ -193,6 +293,14 @@ struct RunStats {
   }
 };
 
+/// Outcome of one query in a stream of --num_query_streams.
+struct StreamQueryRun {
+  int32_t query{0};
+  uint64_t micros{0};
+  uint64_t spilledBytes{0};
+  bool failed{false};
+};
+
 struct ParameterDim {
   std::string flag;
   std::vector<std::string> values;
@@ -227,6 +335,17 @@ class TpchBenchmark {
           allocator, memoryBytes, std::move(ssdCache));
       memory::MemoryAllocator::setDefaultInstance(allocator_.get());
     }
+    if (FLAGS_num_query_streams > 0 && FLAGS_query_memory_gb > 0) {
+      memory::IMemoryManager::Options options;
+      options.capacity = FLAGS_query_memory_gb * (1LL << 30);
+      options.arbitratorFactory = [capacity = options.capacity]() {
+        memory::MemoryArbitrator::Config config;
+        config.kind = memory::MemoryArbitrator::Kind::kShared;
+        config.capacity = capacity;
+        return memory::MemoryArbitrator::create(config);
+      };
+      memory::MemoryManager::getInstance(options, true);
+    }
     functions::prestosql::registerAllScalarFunctions();
     aggregate::prestosql::registerAllAggregateFunctions();
     parse::registerTypeResolver();
@@ -252,30 +371,7 @@ class TpchBenchmark {
     int32_t repeat = 0;
     try {
       for (;;) {
-        CursorParameters params;
-        params.maxDrivers = FLAGS_num_drivers;
-        params.planNode = tpchPlan.plan;
-        const int numSplitsPerFile = FLAGS_num_splits_per_file;
-
-        bool noMoreSplits = false;
-        auto addSplits = [&](exec::Task* task) {
-          if (!noMoreSplits) {
-            for (const auto& entry : tpchPlan.dataFiles) {
-              for (const auto& path : entry.second) {
-                auto const splits =
-                    HiveConnectorTestBase::makeHiveConnectorSplits(
-                        path, numSplitsPerFile, tpchPlan.dataFileFormat);
-                for (const auto& split : splits) {
-                  task->addSplit(entry.first, exec::Split(split));
-                }
-              }
-              task->noMoreSplits(entry.first);
-            }
-          }
-          noMoreSplits = true;
-        };
-        auto result = readCursor(params, addSplits);
-        ensureTaskCompletion(result.first->task().get());
+        auto result = runOnce(tpchPlan, nullptr, "");
         if (++repeat >= FLAGS_num_repeats) {
           return result;
         }
@@ -286,6 +382,231 @@ class TpchBenchmark {
     }
   }
 
+  /// Runs 'tpchPlan' once to completion. Creates a query context with its own
+  /// executor if 'queryCtx' is null.
+  std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> runOnce(
+      const TpchPlan& tpchPlan,
+      std::shared_ptr<core::QueryCtx> queryCtx,
+      const std::string& spillDirectory) {
+    CursorParameters params;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.planNode = tpchPlan.plan;
+    params.queryCtx = std::move(queryCtx);
+    params.spillDirectory = spillDirectory;
+    const int numSplitsPerFile = FLAGS_num_splits_per_file;
+
+    bool noMoreSplits = false;
+    auto addSplits = [&](exec::Task* task) {
+      if (!noMoreSplits) {
+        for (const auto& entry : tpchPlan.dataFiles) {
+          for (const auto& path : entry.second) {
+            auto const splits = HiveConnectorTestBase::makeHiveConnectorSplits(
+                path, numSplitsPerFile, tpchPlan.dataFileFormat);
+            for (const auto& split : splits) {
+              task->addSplit(entry.first, exec::Split(split));
+            }
+          }
+          task->noMoreSplits(entry.first);
+        }
+      }
+      noMoreSplits = true;
+    };
+    auto result = readCursor(params, addSplits);
+    ensureTaskCompletion(result.first->task().get());
+    return result;
+  }
+
+  /// Runs --num_query_streams streams of queries concurrently, each in its own
+  /// random order, and reports the throughput, latency percentiles, memory
+  /// arbitration, spill and cache stats of the whole run.
+  void runThroughput(std::ostream& out) {
+    std::vector<int32_t> queries;
+    if (FLAGS_stream_queries.empty()) {
+      for (auto i = 1; i <= 22; ++i) {
+        queries.push_back(i);
+      }
+    } else {
+      std::vector<std::string> numbers;
+      folly::split(',', FLAGS_stream_queries, numbers, true);
+      for (const auto& number : numbers) {
+        queries.push_back(folly::to<int32_t>(number));
+      }
+    }
+    // Plans are built up front and shared since the query builder is not
+    // meant to be used from several threads at once.
+    std::unordered_map<int32_t, TpchPlan> plans;
+    for (auto query : queries) {
+      plans.emplace(query, queryBuilder->getQueryPlan(query));
+    }
+    const int32_t numQueriesPerStream = FLAGS_num_queries_per_stream > 0
+        ? FLAGS_num_queries_per_stream
+        : queries.size();
+
+    const int32_t numThreads = FLAGS_num_cpu_threads > 0
+        ? FLAGS_num_cpu_threads
+        : std::thread::hardware_concurrency();
+    auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(numThreads);
+
+    std::unordered_map<std::string, std::string> queryConfigs;
+    if (!FLAGS_spill_path.empty()) {
+      queryConfigs[core::QueryConfig::kSpillEnabled] = "true";
+    }
+
+    auto* cache = dynamic_cast<cache::AsyncDataCache*>(allocator_.get());
+    const auto cacheStatsBefore =
+        cache != nullptr ? cache->refreshStats() : cache::CacheStats{};
+    auto* arbitrator = memory::MemoryManager::getInstance().arbitrator();
+    const auto arbitrationStatsBefore = arbitrator != nullptr
+        ? arbitrator->stats()
+        : memory::MemoryArbitrator::Stats{};
+
+    std::vector<std::vector<StreamQueryRun>> streamRuns(
+        FLAGS_num_query_streams);
+    std::atomic<int32_t> querySerial{0};
+    uint64_t wallMicros = 0;
+    {
+      MicrosecondTimer timer(&wallMicros);
+      std::vector<std::thread> streams;
+      for (auto stream = 0; stream < FLAGS_num_query_streams; ++stream) {
+        streams.emplace_back([&, stream]() {
+          std::mt19937 rng(FLAGS_stream_seed + stream);
+          auto order = queries;
+          for (auto i = 0; i < numQueriesPerStream; ++i) {
+            if (i % order.size() == 0) {
+              std::shuffle(order.begin(), order.end(), rng);
+            }
+            StreamQueryRun run;
+            run.query = order[i % order.size()];
+            const auto queryId = fmt::format("stream_query_{}", ++querySerial);
+            try {
+              MicrosecondTimer queryTimer(&run.micros);
+              auto queryCtx = std::make_shared<core::QueryCtx>(
+                  executor.get(),
+                  queryConfigs,
+                  std::unordered_map<std::string, std::shared_ptr<Config>>{},
+                  memory::MemoryAllocator::getInstance(),
+                  memory::defaultMemoryManager().addRootPool(
+                      queryId,
+                      memory::kMaxMemory,
+                      memory::MemoryReclaimer::create()),
+                  nullptr,
+                  queryId);
+              auto result =
+                  runOnce(plans.at(run.query), queryCtx, FLAGS_spill_path);
+              for (const auto& pipeline :
+                   result.first->task()->taskStats().pipelineStats) {
+                for (const auto& op : pipeline.operatorStats) {
+                  run.spilledBytes += op.spilledBytes;
+                }
+              }
+            } catch (const std::exception& e) {
+              LOG(ERROR) << "Query q" << run.query
+                         << " terminated with: " << e.what();
+              run.failed = true;
+            }
+            streamRuns[stream].push_back(run);
+          }
+        });
+      }
+      for (auto& stream : streams) {
+        stream.join();
+      }
+    }
+
+    std::vector<uint64_t> latencies;
+    int32_t numFailed = 0;
+    uint64_t spilledBytes = 0;
+    for (const auto& runs : streamRuns) {
+      for (const auto& run : runs) {
+        if (run.failed) {
+          ++numFailed;
+          continue;
+        }
+        latencies.push_back(run.micros);
+        spilledBytes += run.spilledBytes;
+      }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](int32_t pct) -> uint64_t {
+      if (latencies.empty()) {
+        return 0;
+      }
+      return latencies[std::min<size_t>(
+          latencies.size() - 1, latencies.size() * pct / 100)];
+    };
+    const double qps = latencies.size() / (wallMicros / 1'000'000.0);
+
+    folly::dynamic obj = folly::dynamic::object;
+    obj["numStreams"] = FLAGS_num_query_streams;
+    obj["numQueries"] = latencies.size();
+    obj["numFailedQueries"] = numFailed;
+    obj["wallMicros"] = wallMicros;
+    obj["qps"] = qps;
+    obj["p50LatencyMicros"] = percentile(50);
+    obj["p99LatencyMicros"] = percentile(99);
+    obj["maxLatencyMicros"] = latencies.empty() ? 0 : latencies.back();
+    obj["spilledBytes"] = spilledBytes;
+
+    out << fmt::format(
+               "Streams: {}, queries: {}, failed: {}, wall time: {}, "
+               "QPS: {:.3f}",
+               FLAGS_num_query_streams,
+               latencies.size(),
+               numFailed,
+               succinctMicros(wallMicros),
+               qps)
+        << std::endl;
+    out << fmt::format(
+               "Latency p50: {}, p99: {}, max: {}",
+               succinctMicros(percentile(50)),
+               succinctMicros(percentile(99)),
+               succinctMicros(latencies.empty() ? 0 : latencies.back()))
+        << std::endl;
+    out << "Spilled: " << succinctBytes(spilledBytes) << std::endl;
+    if (arbitrator != nullptr) {
+      const auto stats = arbitrator->stats();
+      const auto numRequests =
+          stats.numRequests - arbitrationStatsBefore.numRequests;
+      const auto queueTimeUs =
+          stats.queueTimeUs - arbitrationStatsBefore.queueTimeUs;
+      const auto arbitrationTimeUs =
+          stats.arbitrationTimeUs - arbitrationStatsBefore.arbitrationTimeUs;
+      out << fmt::format(
+                 "Arbitration requests: {}, queue time: {}, arbitration time: "
+                 "{}, reclaimed: {}",
+                 numRequests,
+                 succinctMicros(queueTimeUs),
+                 succinctMicros(arbitrationTimeUs),
+                 succinctBytes(
+                     stats.numReclaimedBytes -
+                     arbitrationStatsBefore.numReclaimedBytes))
+          << std::endl;
+      obj["arbitrationRequests"] = numRequests;
+      obj["arbitrationQueueMicros"] = queueTimeUs;
+      obj["arbitrationMicros"] = arbitrationTimeUs;
+    }
+    if (cache != nullptr) {
+      const auto stats = cache->refreshStats();
+      const auto numHit = stats.numHit - cacheStatsBefore.numHit;
+      const auto numNew = stats.numNew - cacheStatsBefore.numNew;
+      const double hitRate =
+          numHit + numNew == 0 ? 0 : 100.0 * numHit / (numHit + numNew);
+      out << fmt::format(
+                 "Cache hits: {}, misses: {}, hit rate: {:.1f}%",
+                 numHit,
+                 numNew,
+                 hitRate)
+          << std::endl;
+      obj["cacheHits"] = numHit;
+      obj["cacheMisses"] = numNew;
+      obj["cacheHitRate"] = hitRate;
+    }
+    if (!FLAGS_json_results_path.empty()) {
+      std::ofstream json(FLAGS_json_results_path, std::ios::app);
+      json << folly::toJson(obj) << std::endl;
+    }
+  }
+
   void runMain(std::ostream& out, RunStats& runStats) {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
@@ -326,6 +647,15 @@ class TpchBenchmark {
       out << printPlanWithStats(
                  *queryPlan.plan, stats, FLAGS_include_custom_stats)
           << std::endl;
+      if (!FLAGS_json_results_path.empty()) {
+        const auto query = FLAGS_io_meter_column_pct > 0
+            ? fmt::format("io_meter_{}", FLAGS_io_meter_column_pct)
+            : fmt::format("q{}", FLAGS_run_query_verbose);
+        std::ofstream json(FLAGS_json_results_path, std::ios::app);
+        json << folly::toJson(
+                    runToJson(query, stats, task->pool()->peakBytes()))
+             << std::endl;
+      }
     }
   }
 
@@ -463,11 +793,21 @@ BENCHMARK(q1) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q2) {
+  const auto planContext = queryBuilder->getQueryPlan(2);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q3) {
   const auto planContext = queryBuilder->getQueryPlan(3);
   benchmark.run(planContext);
 }
 
+BENCHMARK(q4) {
+  const auto planContext = queryBuilder->getQueryPlan(4);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q5) {
   const auto planContext = queryBuilder->getQueryPlan(5);
   benchmark.run(planContext);
@@ -498,6 +838,11 @@ BENCHMARK(q10) {
   benchmark.run(planContext);
 }
 
+BENCHMARK(q11) {
+  const auto planContext = queryBuilder->getQueryPlan(11);
+  benchmark.run(planContext);
+}
+
 BENCHMARK(q12) {
   const auto planContext = queryBuilder->getQueryPlan(12);
   benchmark.run(planContext);
@@ -558,7 +903,9 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  if (FLAGS_num_query_streams > 0) {
+    benchmark.runThroughput(std::cout);
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
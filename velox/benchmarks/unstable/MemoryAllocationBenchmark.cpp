@@ -15,10 +15,12 @@
  */
 
 #include <deque>
+#include <thread>
 
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/MmapAllocator.h"
 
 DEFINE_int64(memory_allocation_count, 10'000, "The number of allocations");
 DEFINE_int64(
@@ -33,6 +35,14 @@ DEFINE_int64(
     memory_free_every_n_operations,
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
+DEFINE_int64(
+    tlb_working_set_bytes,
+    1L << 30,
+    "The bytes of memory read at random by the random access benchmarks");
+DEFINE_int64(
+    tlb_num_reads,
+    10'000'000,
+    "The number of reads made by the random access benchmarks");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -432,6 +442,131 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateMix64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kMmap, 64, 128, 32 << 20);
   return benchmark.runReallocate();
 }
+
+// Allocates and frees 128 byte blocks from a leaf pool per thread under a
+// shared root pool on 'numThreads' threads. With 'batchBytes' 0, every
+// allocation updates the total usage of the memory manager, which is shared by
+// all threads.
+unsigned runConcurrentAllocate(
+    unsigned /*iters*/,
+    int32_t numThreads,
+    int64_t batchBytes) {
+  constexpr int32_t kNumLive = 16;
+  constexpr int64_t kBytes = 128;
+  folly::BenchmarkSuspender suspender;
+  MemoryManager manager{{.reservationBatchBytes = batchBytes}};
+  auto root = manager.addRootPool();
+  std::vector<std::shared_ptr<MemoryPool>> pools;
+  for (auto i = 0; i < numThreads; ++i) {
+    pools.push_back(root->addLeafChild(fmt::format("leaf{}", i)));
+  }
+  suspender.dismiss();
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      auto* pool = pools[i].get();
+      std::vector<void*> buffers(kNumLive, nullptr);
+      for (auto j = 0; j < FLAGS_memory_allocation_count; ++j) {
+        auto& buffer = buffers[j % kNumLive];
+        if (buffer != nullptr) {
+          pool->free(buffer, kBytes);
+        }
+        buffer = pool->allocate(kBytes);
+      }
+      for (auto* buffer : buffers) {
+        if (buffer != nullptr) {
+          pool->free(buffer, kBytes);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return numThreads * FLAGS_memory_allocation_count;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(runConcurrentAllocate, 1_thread, 1, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    runConcurrentAllocate,
+    1_thread_batch,
+    1,
+    1 << 20);
+BENCHMARK_NAMED_PARAM_MULTI(runConcurrentAllocate, 8_threads, 8, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    runConcurrentAllocate,
+    8_threads_batch,
+    8,
+    1 << 20);
+BENCHMARK_NAMED_PARAM_MULTI(runConcurrentAllocate, 32_threads, 32, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    runConcurrentAllocate,
+    32_threads_batch,
+    32,
+    1 << 20);
+BENCHMARK_NAMED_PARAM_MULTI(runConcurrentAllocate, 128_threads, 128, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(
+    runConcurrentAllocate,
+    128_threads_batch,
+    128,
+    1 << 20);
+BENCHMARK_DRAW_LINE();
+
+// Reads random words of a 'FLAGS_tlb_working_set_bytes' allocation from the
+// largest size class. With a working set much larger than the TLB reach of 4K
+// pages, most reads miss the TLB unless the size class is backed by huge
+// pages.
+size_t runRandomAccess(bool useHugePages) {
+  folly::BenchmarkSuspender suspender;
+  MmapAllocator::Options options;
+  options.capacity = 2 * FLAGS_tlb_working_set_bytes;
+  options.useHugePages = useHugePages;
+  MmapAllocator allocator(options);
+  Allocation allocation;
+  const auto largestClass = allocator.largestSizeClass();
+  VELOX_CHECK(allocator.allocateNonContiguous(
+      AllocationTraits::numPages(FLAGS_tlb_working_set_bytes),
+      allocation,
+      nullptr,
+      largestClass));
+  constexpr int32_t kWordsPerPage = AllocationTraits::kPageSize / 8;
+  std::vector<uint64_t*> pages;
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    memset(run.data(), 1, run.numBytes());
+    for (auto page = 0; page < run.numPages(); ++page) {
+      pages.push_back(run.data<uint64_t>() + page * kWordsPerPage);
+    }
+  }
+  suspender.dismiss();
+
+  uint64_t sum = 0;
+  uint64_t random = FLAGS_allocation_size_seed;
+  for (auto i = 0; i < FLAGS_tlb_num_reads; ++i) {
+    random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+    const auto index = random >> 16;
+    sum += pages[index % pages.size()][(index >> 32) % kWordsPerPage];
+  }
+  folly::doNotOptimizeAway(sum);
+
+  suspender.rehire();
+  if (useHugePages) {
+    // Shows the achieved huge page coverage.
+    LOG(INFO) << allocator.toString();
+  }
+  allocator.freeNonContiguous(allocation);
+  return FLAGS_tlb_num_reads;
+}
+
+BENCHMARK_MULTI(MmapRandomAccess) {
+  return runRandomAccess(false);
+}
+
+BENCHMARK_RELATIVE_MULTI(MmapRandomAccessHugePages) {
+  return runRandomAccess(true);
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
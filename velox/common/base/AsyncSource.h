@@ -21,6 +21,7 @@
 #include <folly/futures/Future.h>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/Portability.h"
@@ -60,6 +61,7 @@ class AsyncSource {
       exception_ = std::current_exception();
     }
     std::unique_ptr<ContinuePromise> promise;
+    std::vector<ContinuePromise> readyPromises;
     {
       std::lock_guard<std::mutex> l(mutex_);
       VELOX_CHECK_NULL(item_);
@@ -68,10 +70,29 @@ class AsyncSource {
       }
       making_ = false;
       promise.swap(promise_);
+      readyPromises.swap(readyPromises_);
     }
     if (promise != nullptr) {
       promise->setValue();
     }
+    for (auto& readyPromise : readyPromises) {
+      readyPromise.setValue();
+    }
+  }
+
+  // Returns true if move() will not wait for the executor to finish making the
+  // item. Otherwise sets 'future' to be realized when the item is made, so that
+  // the caller can go off thread instead of blocking in move().
+  bool isReadyOrFuture(ContinueFuture* future) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!making_) {
+      return true;
+    }
+    auto [promise, readyFuture] =
+        makeVeloxContinuePromiseContract("AsyncSource::isReadyOrFuture");
+    readyPromises_.push_back(std::move(promise));
+    *future = std::move(readyFuture);
+    return false;
   }
 
   // Returns the item to the first caller and nullptr to subsequent callers. If
@@ -135,6 +156,8 @@ class AsyncSource {
   // True if 'prepare() is making the item.
   bool making_{false};
   std::unique_ptr<ContinuePromise> promise_;
+  // Promises given out by isReadyOrFuture().
+  std::vector<ContinuePromise> readyPromises_;
   std::unique_ptr<Item> item_;
   std::function<std::unique_ptr<Item>()> make_;
   std::exception_ptr exception_;
@@ -30,20 +30,38 @@ namespace facebook::velox {
 // expected entry, we get ~2% false positives. 'hashInput' determines
 // if the value added or checked needs to be hashed. If this is false,
 // we assume that the input is already a 64 bit hash number.
+//
+// Version 2 of the filter is a split block Bloom filter with blocks of 256
+// bits: the high 32 bits of the hash select the block and the low 32 bits
+// select one bit in each of the 8 32-bit words of the block. A probe still
+// reads one cache line and sets or tests 8 bits with a loop that vectorizes
+// to a few AVX2 instructions, for a lower false positive rate at the same
+// size. The version is part of the serialized form, so that filters of
+// either version can be read.
 template <typename Allocator = std::allocator<uint64_t>>
 class BloomFilter {
  public:
+  static constexpr int8_t kBloomFilterV1 = 1;
+  static constexpr int8_t kBloomFilterV2 = 2;
+
   explicit BloomFilter() : bits_{Allocator()} {}
   explicit BloomFilter(const Allocator& allocator) : bits_{allocator} {}
 
   // Prepares 'this' for use with an expected 'capacity'
-  // entries. Drops any prior content.
-  void reset(int32_t capacity) {
+  // entries. Drops any prior content. 'version' is kBloomFilterV1 or
+  // kBloomFilterV2.
+  void reset(int32_t capacity, int8_t version = kBloomFilterV1) {
+    checkVersion(version);
+    version_ = version;
     bits_.clear();
-    // 2 bytes per value.
+    // 2 bytes per value. At least one block of 4 words for version 2.
     bits_.resize(std::max<int32_t>(4, bits::nextPowerOfTwo(capacity) / 4));
   }
 
+  int8_t version() const {
+    return version_;
+  }
+
   bool isSet() const {
     return bits_.size() > 0;
   }
@@ -52,20 +70,41 @@ class BloomFilter {
   // Input is hashed uint64_t value, optional hash function is
   // folly::hasher<InputType>()(value).
   void insert(uint64_t value) {
-    set(bits_.data(), bits_.size(), value);
+    if (version_ == kBloomFilterV1) {
+      set(bits_.data(), bits_.size(), value);
+    } else {
+      setBlock(bits_.data(), bits_.size(), value);
+    }
   }
 
   // Input is hashed uint64_t value, optional hash function is
   // folly::hasher<InputType>()(value).
   bool mayContain(uint64_t value) const {
-    return test(bits_.data(), bits_.size(), value);
+    if (version_ == kBloomFilterV1) {
+      return test(bits_.data(), bits_.size(), value);
+    }
+    return testBlock(bits_.data(), bits_.size(), value);
   }
 
+  // Adds the serialized filter to 'this'. If 'this' is not set, it takes the
+  // version of the serialized filter. Otherwise the versions must match.
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
-    VELOX_USER_CHECK_EQ(kBloomFilterV1, version);
+    checkVersion(version);
+    if (isSet()) {
+      VELOX_USER_CHECK_EQ(
+          version_,
+          version,
+          "Cannot merge Bloom filters of different versions");
+    } else {
+      version_ = version;
+    }
     auto size = stream.read<int32_t>();
+    VELOX_USER_CHECK(
+        version_ == kBloomFilterV1 || size % kWordsPerBlock == 0,
+        "Bloom filter of version 2 must have whole blocks: {} words",
+        size);
     bits_.resize(size);
     auto bitsdata =
         reinterpret_cast<const uint64_t*>(serialized + stream.offset());
@@ -89,7 +128,7 @@ class BloomFilter {
 
   void serialize(char* output) const {
     common::OutputByteStream stream(output);
-    stream.appendOne(kBloomFilterV1);
+    stream.appendOne(version_);
     stream.appendOne((int32_t)bits_.size());
     for (auto bit : bits_) {
       stream.appendOne(bit);
@@ -129,7 +168,66 @@ class BloomFilter {
     return mask == (bloom[index] & mask);
   }
 
-  const int8_t kBloomFilterV1 = 1;
+  static void checkVersion(int8_t version) {
+    VELOX_USER_CHECK(
+        version == kBloomFilterV1 || version == kBloomFilterV2,
+        "Unsupported Bloom filter version: {}",
+        version);
+  }
+
+  // Number of 64-bit words in a 256 bit block of version 2.
+  static constexpr int32_t kWordsPerBlock = 4;
+
+  // Multipliers that map the low 32 bits of the hash code to one bit in each
+  // 32-bit word of a block. The same as in the Parquet split block Bloom
+  // filter.
+  static constexpr uint32_t kSalt[8] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  // Returns the offset of the first word of the block selected by the high 32
+  // bits of 'hashCode'. 'bloomSize' does not need to be a power of 2.
+  inline static uint64_t blockOffset(int32_t bloomSize, uint64_t hashCode) {
+    const uint64_t numBlocks = bloomSize / kWordsPerBlock;
+    return (((hashCode >> 32) * numBlocks) >> 32) * kWordsPerBlock;
+  }
+
+  inline static void setBlock(
+      uint64_t* FOLLY_NONNULL bloom,
+      int32_t bloomSize,
+      uint64_t hashCode) {
+    auto* words =
+        reinterpret_cast<uint32_t*>(bloom + blockOffset(bloomSize, hashCode));
+    const auto key = static_cast<uint32_t>(hashCode);
+    for (auto i = 0; i < 8; ++i) {
+      words[i] |= 1U << ((key * kSalt[i]) >> 27);
+    }
+  }
+
+  // Tests all 8 words without early exit, so that the loop is branch free
+  // and vectorizes.
+  inline static bool testBlock(
+      const uint64_t* FOLLY_NONNULL bloom,
+      int32_t bloomSize,
+      uint64_t hashCode) {
+    const auto* words = reinterpret_cast<const uint32_t*>(
+        bloom + blockOffset(bloomSize, hashCode));
+    const auto key = static_cast<uint32_t>(hashCode);
+    uint32_t missing = 0;
+    for (auto i = 0; i < 8; ++i) {
+      const uint32_t mask = 1U << ((key * kSalt[i]) >> 27);
+      missing |= mask & ~words[i];
+    }
+    return missing == 0;
+  }
+
+  int8_t version_{kBloomFilterV1};
   std::vector<uint64_t, Allocator> bits_;
 };
 
@@ -24,6 +24,29 @@ void registerVeloxCounters() {
   // P50, P90, P99, and P100.
   REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
       kCounterHiveFileHandleGenerateLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Track the memory cache lookups that found an entry and the ones that
+  // created a new entry.
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterCacheNumHits, velox::StatType::COUNT);
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterCacheNumMisses, velox::StatType::COUNT);
+
+  // Track the bytes written to spill files.
+  REPORT_ADD_STAT_EXPORT_TYPE(kCounterSpillWriteBytes, velox::StatType::SUM);
+
+  // Track the time memory arbitration requests wait for a running
+  // arbitration in range of [0, 100s] and reports P50, P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterArbitrationQueueTimeUs, 10000, 0, 100000000, 50, 90, 99, 100);
+
+  // Track the number of pages buffered in an exchange queue when a page is
+  // added, in range of [0, 1000] and reports P50, P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterExchangeQueuePages, 10, 0, 1000, 50, 90, 99, 100);
+
+  // Track the time drivers wait in the executor queue in range of [0, 100s]
+  // and reports P50, P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterDriverQueueTimeMs, 10, 0, 100000, 50, 90, 99, 100);
 }
 
 } // namespace facebook::velox
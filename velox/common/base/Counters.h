@@ -25,4 +25,20 @@ void registerVeloxCounters();
 
 constexpr folly::StringPiece kCounterHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
+
+constexpr folly::StringPiece kCounterCacheNumHits{"velox.cache_num_hits"};
+
+constexpr folly::StringPiece kCounterCacheNumMisses{"velox.cache_num_misses"};
+
+constexpr folly::StringPiece kCounterSpillWriteBytes{
+    "velox.spill_write_bytes"};
+
+constexpr folly::StringPiece kCounterArbitrationQueueTimeUs{
+    "velox.arbitration_queue_time_us"};
+
+constexpr folly::StringPiece kCounterExchangeQueuePages{
+    "velox.exchange_queue_pages"};
+
+constexpr folly::StringPiece kCounterDriverQueueTimeMs{
+    "velox.driver_queue_time_ms"};
 } // namespace facebook::velox
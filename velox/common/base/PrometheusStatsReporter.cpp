@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/base/PrometheusStatsReporter.h"
+
+#include <folly/lang/Align.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <sstream>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+namespace {
+constexpr int32_t kNumCounterShards = 16;
+
+// Spreads the threads over the counter shards in the order they first
+// update a counter.
+int32_t counterShard() {
+  static std::atomic<int32_t> nextShard{0};
+  thread_local const int32_t shard =
+      nextShard.fetch_add(1, std::memory_order_relaxed) % kNumCounterShards;
+  return shard;
+}
+
+std::string metricName(folly::StringPiece key) {
+  std::string name = key.str();
+  for (auto i = 0; i < name.size(); ++i) {
+    const char c = name[i];
+    const bool valid = std::isalpha(c) || c == '_' || c == ':' ||
+        (i > 0 && std::isdigit(c));
+    if (!valid) {
+      name[i] = '_';
+    }
+  }
+  return name;
+}
+} // namespace
+
+class PrometheusStatsReporter::Counter {
+ public:
+  explicit Counter(StatType type) : type_{type} {}
+
+  void add(uint64_t value) {
+    auto& shard = shards_[counterShard()];
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  StatType type() const {
+    return type_;
+  }
+
+  double value() const {
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    for (const auto& shard : shards_) {
+      sum += shard.sum.load(std::memory_order_relaxed);
+      count += shard.count.load(std::memory_order_relaxed);
+    }
+    switch (type_) {
+      case StatType::COUNT:
+        return count;
+      case StatType::AVG:
+        return count == 0 ? 0 : static_cast<double>(sum) / count;
+      case StatType::SUM:
+      case StatType::RATE:
+        return sum;
+    }
+    VELOX_UNREACHABLE();
+  }
+
+ private:
+  struct alignas(folly::hardware_destructive_interference_size) Shard {
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> count{0};
+  };
+
+  const StatType type_;
+  std::array<Shard, kNumCounterShards> shards_;
+};
+
+class PrometheusStatsReporter::Histogram {
+ public:
+  Histogram(
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts)
+      : bucketWidth_{bucketWidth},
+        min_{min},
+        max_{max},
+        pcts_{pcts},
+        // One bucket below 'min' and one above 'max'.
+        numBuckets_{(max - min + bucketWidth - 1) / bucketWidth + 2},
+        buckets_{new std::atomic<uint64_t>[numBuckets_]} {
+    for (auto i = 0; i < numBuckets_; ++i) {
+      buckets_[i] = 0;
+    }
+  }
+
+  void add(int64_t value) {
+    int64_t bucket;
+    if (value < min_) {
+      bucket = 0;
+    } else if (value >= max_) {
+      bucket = numBuckets_ - 1;
+    } else {
+      bucket = 1 + (value - min_) / bucketWidth_;
+    }
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  const std::vector<int32_t>& pcts() const {
+    return pcts_;
+  }
+
+  uint64_t sum() const {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  std::optional<int64_t> percentile(int32_t pct) const {
+    uint64_t total = 0;
+    for (auto i = 0; i < numBuckets_; ++i) {
+      total += buckets_[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+      return std::nullopt;
+    }
+    const uint64_t target =
+        std::max<uint64_t>(1, std::ceil(total * pct / 100.0));
+    uint64_t seen = 0;
+    for (auto i = 0; i < numBuckets_; ++i) {
+      seen += buckets_[i].load(std::memory_order_relaxed);
+      if (seen >= target) {
+        return std::clamp(min_ + i * bucketWidth_, min_, max_);
+      }
+    }
+    return max_;
+  }
+
+ private:
+  const int64_t bucketWidth_;
+  const int64_t min_;
+  const int64_t max_;
+  const std::vector<int32_t> pcts_;
+  const int64_t numBuckets_;
+  const std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> count_{0};
+};
+
+PrometheusStatsReporter::PrometheusStatsReporter() {
+  registries_.push_back(std::make_unique<Registry>());
+  registry_ = registries_.back().get();
+}
+
+PrometheusStatsReporter::~PrometheusStatsReporter() = default;
+
+void PrometheusStatsReporter::updateRegistry(
+    const std::function<void(Registry&)>& update) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto registry = std::make_unique<Registry>(registry());
+  update(*registry);
+  registry_.store(registry.get(), std::memory_order_release);
+  registries_.push_back(std::move(registry));
+}
+
+void PrometheusStatsReporter::addStatExportType(
+    const char* key,
+    StatType statType) const {
+  addStatExportType(folly::StringPiece(key), statType);
+}
+
+void PrometheusStatsReporter::addStatExportType(
+    folly::StringPiece key,
+    StatType statType) const {
+  if (registry().counters.count(key) > 0) {
+    return;
+  }
+  updateRegistry([&](Registry& registry) {
+    registry.counters.emplace(key.str(), std::make_shared<Counter>(statType));
+  });
+}
+
+void PrometheusStatsReporter::addHistogramExportPercentiles(
+    const char* key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  addHistogramExportPercentiles(
+      folly::StringPiece(key), bucketWidth, min, max, pcts);
+}
+
+void PrometheusStatsReporter::addHistogramExportPercentiles(
+    folly::StringPiece key,
+    int64_t bucketWidth,
+    int64_t min,
+    int64_t max,
+    const std::vector<int32_t>& pcts) const {
+  VELOX_CHECK_GT(bucketWidth, 0);
+  VELOX_CHECK_LT(min, max);
+  if (registry().histograms.count(key) > 0) {
+    return;
+  }
+  updateRegistry([&](Registry& registry) {
+    registry.histograms.emplace(
+        key.str(), std::make_shared<Histogram>(bucketWidth, min, max, pcts));
+  });
+}
+
+void PrometheusStatsReporter::addStatValue(
+    const std::string& key,
+    size_t value) const {
+  addStatValue(folly::StringPiece(key), value);
+}
+
+void PrometheusStatsReporter::addStatValue(const char* key, size_t value)
+    const {
+  addStatValue(folly::StringPiece(key), value);
+}
+
+void PrometheusStatsReporter::addStatValue(
+    folly::StringPiece key,
+    size_t value) const {
+  const auto& counters = registry().counters;
+  auto it = counters.find(key);
+  if (it != counters.end()) {
+    it->second->add(value);
+  }
+}
+
+void PrometheusStatsReporter::addHistogramValue(
+    const std::string& key,
+    size_t value) const {
+  addHistogramValue(folly::StringPiece(key), value);
+}
+
+void PrometheusStatsReporter::addHistogramValue(const char* key, size_t value)
+    const {
+  addHistogramValue(folly::StringPiece(key), value);
+}
+
+void PrometheusStatsReporter::addHistogramValue(
+    folly::StringPiece key,
+    size_t value) const {
+  const auto& histograms = registry().histograms;
+  auto it = histograms.find(key);
+  if (it != histograms.end()) {
+    it->second->add(value);
+  }
+}
+
+std::optional<double> PrometheusStatsReporter::statValue(
+    folly::StringPiece key) const {
+  const auto& counters = registry().counters;
+  auto it = counters.find(key);
+  if (it == counters.end()) {
+    return std::nullopt;
+  }
+  return it->second->value();
+}
+
+std::optional<int64_t> PrometheusStatsReporter::histogramPercentile(
+    folly::StringPiece key,
+    int32_t pct) const {
+  const auto& histograms = registry().histograms;
+  auto it = histograms.find(key);
+  if (it == histograms.end()) {
+    return std::nullopt;
+  }
+  return it->second->percentile(pct);
+}
+
+std::string PrometheusStatsReporter::toPrometheusText() const {
+  const auto& registry = this->registry();
+  std::vector<std::pair<std::string, const std::string*>> names;
+  names.reserve(registry.counters.size() + registry.histograms.size());
+  for (const auto& [key, _] : registry.counters) {
+    names.emplace_back(metricName(key), &key);
+  }
+  for (const auto& [key, _] : registry.histograms) {
+    names.emplace_back(metricName(key), &key);
+  }
+  std::sort(names.begin(), names.end());
+
+  std::stringstream out;
+  for (const auto& [name, key] : names) {
+    auto counter = registry.counters.find(*key);
+    if (counter != registry.counters.end()) {
+      const bool isGauge = counter->second->type() == StatType::AVG;
+      out << "# TYPE " << name << (isGauge ? " gauge\n" : " counter\n");
+      out << name << " " << counter->second->value() << "\n";
+      continue;
+    }
+    const auto& histogram = *registry.histograms.at(*key);
+    out << "# TYPE " << name << " summary\n";
+    for (auto pct : histogram.pcts()) {
+      if (auto value = histogram.percentile(pct)) {
+        out << name << "{quantile=\"" << pct / 100.0 << "\"} " << *value
+            << "\n";
+      }
+    }
+    out << name << "_sum " << histogram.sum() << "\n";
+    out << name << "_count " << histogram.count() << "\n";
+  }
+  return out.str();
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "velox/common/base/StatsReporter.h"
+
+namespace facebook::velox {
+
+/// A BaseStatsReporter that keeps the stats in process and renders them in
+/// the Prometheus text exposition format, e.g. for a /metrics endpoint:
+///
+///   folly::Singleton<facebook::velox::BaseStatsReporter> reporter([]() {
+///     return new facebook::velox::PrometheusStatsReporter();
+///   });
+///
+/// Counters are sharded by thread so that concurrent updates do not contend
+/// on one cache line. Histograms have one atomic count per bucket and are
+/// exported as summaries with the registered percentiles. Registration
+/// takes a mutex and publishes a new copy of the registry, so that updates
+/// only do an atomic load and a hash lookup. Values of unregistered keys are
+/// dropped.
+class PrometheusStatsReporter : public BaseStatsReporter {
+ public:
+  PrometheusStatsReporter();
+
+  ~PrometheusStatsReporter() override;
+
+  void addStatExportType(const char* key, StatType statType) const override;
+
+  void addStatExportType(folly::StringPiece key, StatType statType)
+      const override;
+
+  void addHistogramExportPercentiles(
+      const char* key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override;
+
+  void addHistogramExportPercentiles(
+      folly::StringPiece key,
+      int64_t bucketWidth,
+      int64_t min,
+      int64_t max,
+      const std::vector<int32_t>& pcts) const override;
+
+  void addStatValue(const std::string& key, size_t value = 1) const override;
+
+  void addStatValue(const char* key, size_t value = 1) const override;
+
+  void addStatValue(folly::StringPiece key, size_t value = 1) const override;
+
+  void addHistogramValue(const std::string& key, size_t value) const override;
+
+  void addHistogramValue(const char* key, size_t value) const override;
+
+  void addHistogramValue(folly::StringPiece key, size_t value) const override;
+
+  /// Returns the exported value of stat 'key': the number of values for
+  /// COUNT, their sum for SUM and RATE and their mean for AVG. Returns
+  /// std::nullopt if 'key' is not a registered stat.
+  std::optional<double> statValue(folly::StringPiece key) const;
+
+  /// Returns the 'pct' percentile of histogram 'key', as the upper bound of
+  /// the bucket that contains it. Returns std::nullopt if 'key' is not a
+  /// registered histogram or has no values.
+  std::optional<int64_t> histogramPercentile(
+      folly::StringPiece key,
+      int32_t pct) const;
+
+  /// Returns all stats and histograms in the Prometheus text format, ordered
+  /// by name. Characters that are not valid in metric names, e.g. '.', are
+  /// replaced by '_'.
+  std::string toPrometheusText() const;
+
+ private:
+  class Counter;
+  class Histogram;
+
+  struct Registry {
+    folly::F14FastMap<std::string, std::shared_ptr<Counter>> counters;
+    folly::F14FastMap<std::string, std::shared_ptr<Histogram>> histograms;
+  };
+
+  const Registry& registry() const {
+    return *registry_.load(std::memory_order_acquire);
+  }
+
+  // Publishes a copy of the current registry changed by 'update'.
+  void updateRegistry(const std::function<void(Registry&)>& update) const;
+
+  mutable std::mutex mutex_;
+  mutable std::atomic<const Registry*> registry_{nullptr};
+  // All published registries. The replaced ones are kept since concurrent
+  // updates may still be using them. Registration is rare and at startup.
+  mutable std::vector<std::unique_ptr<const Registry>> registries_;
+};
+
+} // namespace facebook::velox
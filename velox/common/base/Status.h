@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+enum class StatusCode : int8_t {
+  kOk = 0,
+  kUserError = 1,
+  kArithmeticError = 2,
+};
+
+/// Outcome of an operation that reports a failure by returning it instead of
+/// throwing. Simple functions may return a Status from call() so that a row
+/// failing under TRY is recorded without unwinding the stack. An OK Status
+/// holds no state and costs a null check to test.
+class [[nodiscard]] Status {
+ public:
+  Status() = default;
+
+  static Status OK() {
+    return Status();
+  }
+
+  /// Equivalent of VELOX_USER_FAIL.
+  template <typename... Args>
+  static Status UserError(Args&&... args) {
+    return Status(
+        StatusCode::kUserError,
+        detail::errorMessage(std::forward<Args>(args)...));
+  }
+
+  /// Equivalent of VELOX_ARITHMETIC_ERROR.
+  template <typename... Args>
+  static Status ArithmeticError(Args&&... args) {
+    return Status(
+        StatusCode::kArithmeticError,
+        detail::errorMessage(std::forward<Args>(args)...));
+  }
+
+  bool ok() const {
+    return state_ == nullptr;
+  }
+
+  StatusCode code() const {
+    return ok() ? StatusCode::kOk : state_->code;
+  }
+
+  /// Empty for an OK Status.
+  const std::string& message() const {
+    static const std::string kEmpty;
+    return ok() ? kEmpty : state_->message;
+  }
+
+ private:
+  struct State {
+    StatusCode code;
+    std::string message;
+  };
+
+  Status(StatusCode code, std::string message)
+      : state_(std::make_unique<State>(State{code, std::move(message)})) {}
+
+  std::unique_ptr<State> state_;
+};
+
+} // namespace facebook::velox
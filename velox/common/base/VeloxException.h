@@ -101,6 +101,9 @@ inline constexpr auto kNoCacheSpace = "NO_CACHE_SPACE"_fs;
 // Errors indicating file read corruptions.
 inline constexpr auto kFileCorruption = "FILE_CORRUPTION"_fs;
 
+// An error raised when a query spills more than its spill quota.
+inline constexpr auto kSpillLimitExceeded = "SPILL_LIMIT_EXCEEDED"_fs;
+
 // We do not know how to classify it yet.
 inline constexpr auto kUnknown = "UNKNOWN"_fs;
 } // namespace error_code
@@ -18,6 +18,7 @@
 #include <fmt/format.h>
 #include <folly/Random.h>
 #include <folly/Synchronized.h>
+#include <folly/synchronization/Baton.h>
 #include <gtest/gtest.h>
 #include <thread>
 #include "velox/common/base/Exceptions.h"
@@ -46,6 +47,30 @@ TEST(AsyncSourceTest, basic) {
   EXPECT_TRUE(error.hasValue());
 }
 
+TEST(AsyncSourceTest, isReadyOrFuture) {
+  folly::Baton<> started;
+  folly::Baton<> release;
+  AsyncSource<Gizmo> gizmo([&]() {
+    started.post();
+    release.wait();
+    return std::make_unique<Gizmo>(11);
+  });
+  auto future = ContinueFuture::makeEmpty();
+  // Nobody makes the item yet, so move() would make it on the caller thread.
+  EXPECT_TRUE(gizmo.isReadyOrFuture(&future));
+  EXPECT_FALSE(future.valid());
+
+  std::thread thread([&]() { gizmo.prepare(); });
+  started.wait();
+  EXPECT_FALSE(gizmo.isReadyOrFuture(&future));
+  EXPECT_FALSE(future.isReady());
+  release.post();
+  std::move(future).wait();
+  EXPECT_TRUE(gizmo.hasValue());
+  EXPECT_EQ(11, gizmo.move()->id);
+  thread.join();
+}
+
 TEST(AsyncSourceTest, threads) {
   constexpr int32_t kNumThreads = 10;
   constexpr int32_t kNumGizmos = 2000;
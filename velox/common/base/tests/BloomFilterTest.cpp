@@ -90,3 +90,69 @@ TEST_F(BloomFilterTest, merge) {
 
   EXPECT_EQ(bloom.serializedSize(), merge.serializedSize());
 }
+
+TEST_F(BloomFilterTest, blocked) {
+  constexpr int32_t kSize = 1024;
+  BloomFilter bloom;
+  bloom.reset(kSize, BloomFilter<>::kBloomFilterV2);
+  EXPECT_EQ(BloomFilter<>::kBloomFilterV2, bloom.version());
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(folly::hasher<int32_t>()(i)));
+    numFalsePositives += bloom.mayContain(folly::hasher<int32_t>()(i + kSize));
+    numFalsePositives +=
+        bloom.mayContain(folly::hasher<int32_t>()((i + kSize) * 123451));
+  }
+  EXPECT_GT(1, 100 * numFalsePositives / kSize);
+
+  // The version is serialized with the filter.
+  std::string data;
+  data.resize(bloom.serializedSize());
+  bloom.serialize(data.data());
+  BloomFilter deserialized;
+  deserialized.merge(data.data());
+  EXPECT_EQ(BloomFilter<>::kBloomFilterV2, deserialized.version());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(deserialized.mayContain(folly::hasher<int32_t>()(i)));
+  }
+  EXPECT_EQ(bloom.serializedSize(), deserialized.serializedSize());
+}
+
+TEST_F(BloomFilterTest, mergeBlocked) {
+  constexpr int32_t kSize = 10;
+  BloomFilter bloom;
+  bloom.reset(kSize, BloomFilter<>::kBloomFilterV2);
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i));
+  }
+
+  BloomFilter merge;
+  merge.reset(kSize, BloomFilter<>::kBloomFilterV2);
+  for (auto i = kSize; i < kSize + kSize; i++) {
+    merge.insert(folly::hasher<int32_t>()(i));
+  }
+
+  std::string data;
+  data.resize(merge.serializedSize());
+  merge.serialize(data.data());
+  bloom.merge(data.data());
+  for (auto i = 0; i < kSize + kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(folly::hasher<int32_t>()(i)));
+  }
+
+  // Filters of different versions do not merge.
+  BloomFilter v1;
+  v1.reset(kSize);
+  v1.insert(folly::hasher<int32_t>()(1));
+  std::string v1Data;
+  v1Data.resize(v1.serializedSize());
+  v1.serialize(v1Data.data());
+  EXPECT_THROW(bloom.merge(v1Data.data()), VeloxUserError);
+
+  v1Data[0] = 3;
+  BloomFilter unknown;
+  EXPECT_THROW(unknown.merge(v1Data.data()), VeloxUserError);
+}
@@ -16,10 +16,13 @@
 
 #include "velox/common/base/StatsReporter.h"
 #include <folly/Singleton.h>
+#include <folly/synchronization/Latch.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <thread>
 #include <unordered_map>
+#include "velox/common/base/PrometheusStatsReporter.h"
 
 namespace facebook::velox {
 
@@ -121,6 +124,79 @@ TEST_F(StatsReporterTest, trivialReporter) {
   EXPECT_EQ(100, reporter->counterMap["key4"]);
 };
 
+TEST_F(StatsReporterTest, prometheusReporter) {
+  PrometheusStatsReporter reporter;
+  reporter.addStatExportType("velox.count", StatType::COUNT);
+  reporter.addStatExportType("velox.sum", StatType::SUM);
+  reporter.addStatExportType("velox.avg", StatType::AVG);
+  reporter.addHistogramExportPercentiles(
+      "velox.latency_ms", 10, 0, 100, {50, 99, 100});
+
+  EXPECT_EQ(0, reporter.statValue("velox.count").value());
+  EXPECT_FALSE(reporter.statValue("velox.unknown").has_value());
+  EXPECT_FALSE(reporter.histogramPercentile("velox.latency_ms", 50));
+
+  reporter.addStatValue("velox.count", 10);
+  reporter.addStatValue("velox.count", 20);
+  reporter.addStatValue(std::string("velox.sum"), 10);
+  reporter.addStatValue(folly::StringPiece("velox.sum"), 20);
+  reporter.addStatValue("velox.avg", 10);
+  reporter.addStatValue("velox.avg", 20);
+  // Values of unregistered stats are dropped.
+  reporter.addStatValue("velox.unknown", 10);
+  reporter.addHistogramValue("velox.latency_ms", 10);
+  reporter.addHistogramValue("velox.latency_ms", 20);
+  reporter.addHistogramValue("velox.latency_ms", 30);
+  reporter.addHistogramValue("velox.latency_ms", 1000);
+
+  EXPECT_EQ(2, reporter.statValue("velox.count").value());
+  EXPECT_EQ(30, reporter.statValue("velox.sum").value());
+  EXPECT_EQ(15, reporter.statValue("velox.avg").value());
+  EXPECT_FALSE(reporter.statValue("velox.unknown").has_value());
+  // Percentiles are the upper bounds of the buckets, capped at 'max'.
+  EXPECT_EQ(30, reporter.histogramPercentile("velox.latency_ms", 50).value());
+  EXPECT_EQ(100, reporter.histogramPercentile("velox.latency_ms", 99).value());
+
+  EXPECT_EQ(
+      "# TYPE velox_avg gauge\n"
+      "velox_avg 15\n"
+      "# TYPE velox_count counter\n"
+      "velox_count 2\n"
+      "# TYPE velox_latency_ms summary\n"
+      "velox_latency_ms{quantile=\"0.5\"} 30\n"
+      "velox_latency_ms{quantile=\"0.99\"} 100\n"
+      "velox_latency_ms{quantile=\"1\"} 100\n"
+      "velox_latency_ms_sum 1060\n"
+      "velox_latency_ms_count 4\n"
+      "# TYPE velox_sum counter\n"
+      "velox_sum 30\n",
+      reporter.toPrometheusText());
+}
+
+TEST_F(StatsReporterTest, prometheusReporterConcurrentUpdates) {
+  PrometheusStatsReporter reporter;
+  reporter.addStatExportType("velox.sum", StatType::SUM);
+  constexpr int32_t kNumThreads = 8;
+  constexpr int32_t kNumUpdates = 10'000;
+  folly::Latch start(kNumThreads);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&]() {
+      start.arrive_and_wait();
+      for (auto j = 0; j < kNumUpdates; ++j) {
+        reporter.addStatValue("velox.sum", 2);
+      }
+    });
+  }
+  // Registering other stats does not lose concurrent updates.
+  reporter.addStatExportType("velox.other", StatType::COUNT);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(
+      2 * kNumThreads * kNumUpdates, reporter.statValue("velox.sum").value());
+}
+
 // Registering to folly Singleton with intended reporter type
 folly::Singleton<BaseStatsReporter> reporter([]() {
   return new TestReporter();
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/base/Status.h"
+
+#include <gtest/gtest.h>
+
+namespace facebook::velox {
+namespace {
+
+TEST(StatusTest, ok) {
+  auto status = Status::OK();
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(status.code(), StatusCode::kOk);
+  EXPECT_EQ(status.message(), "");
+}
+
+TEST(StatusTest, errors) {
+  auto status = Status::UserError("Invalid input: {}", "abc");
+  EXPECT_FALSE(status.ok());
+  EXPECT_EQ(status.code(), StatusCode::kUserError);
+  EXPECT_EQ(status.message(), "Invalid input: abc");
+
+  status = Status::ArithmeticError("division by zero");
+  EXPECT_EQ(status.code(), StatusCode::kArithmeticError);
+  EXPECT_EQ(status.message(), "division by zero");
+
+  // Moving out of a Status leaves an OK Status behind.
+  auto moved = std::move(status);
+  EXPECT_FALSE(moved.ok());
+  EXPECT_TRUE(status.ok());
+}
+
+} // namespace
+} // namespace facebook::velox
@@ -16,6 +16,8 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include <velox/common/base/BitUtil.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
 
@@ -124,11 +126,34 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   }
 }
 
+void AsyncDataCacheEntry::setTenant(CacheTenant* tenant) {
+  VELOX_CHECK(isExclusive());
+  VELOX_CHECK_NULL(tenant_);
+  tenant_ = tenant;
+  if (tenant_) {
+    tenant_->addCachedBytes(size_);
+    tenant_->recordMiss(size_);
+  }
+}
+
 void AsyncDataCacheEntry::makeEvictable() {
   accessStats_.lastUse = 0;
   accessStats_.numUses = 0;
 }
 
+CacheTenantStats CacheTenant::stats() const {
+  CacheTenantStats stats;
+  stats.name = name_;
+  stats.quotaBytes = quotaBytes_;
+  stats.cachedBytes = cachedBytes_;
+  stats.numHit = numHit_;
+  stats.hitBytes = hitBytes_;
+  stats.numMiss = numMiss_;
+  stats.missBytes = missBytes_;
+  stats.numQuotaEvict = numQuotaEvict_;
+  return stats;
+}
+
 std::string AsyncDataCacheEntry::toString() const {
   return fmt::format(
       "<entry key:{}:{} size {} pins {}>",
@@ -158,6 +183,7 @@ CachePin CacheShard::findOrCreate(
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    recordAccess(key);
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto found = it->second;
@@ -178,6 +204,7 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          REPORT_ADD_STAT_VALUE(kCounterCacheNumHits);
         }
         ++found->numPins_;
         CachePin pin;
@@ -207,6 +234,7 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    REPORT_ADD_STAT_VALUE(kCounterCacheNumMisses);
     // Inside the shard mutex.
     VELOX_CHECK_EQ(0, entryToInit->size_);
     entryToInit->size_ = size;
@@ -217,6 +245,7 @@ CachePin CacheShard::findOrCreate(
 
 bool CacheShard::exists(RawFileCacheKey key) const {
   std::lock_guard<std::mutex> l(mutex_);
+  recordAccess(key);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -307,6 +336,10 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  if (entry->tenant_) {
+    entry->tenant_->addCachedBytes(-entry->size_);
+    entry->tenant_ = nullptr;
+  }
   if (entry->key_.fileNum.hasValue()) {
     auto removeIter = entryMap_.find(
         RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
@@ -370,13 +403,19 @@ void CacheShard::evict(uint64_t bytesToFree, bool evictAllUnpinned) {
         eventCounter_ = 0;
       }
       int32_t score = 0;
+      auto* tenant = candidate->tenant_;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (tenant && tenant->overQuota()) ||
+           ((!tenant || !tenant->underQuota()) &&
+            (score = entryScore(*candidate, now)) >= evictionThreshold_))) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
         }
+        if (tenant && !evictAllUnpinned && tenant->overQuota()) {
+          tenant->recordQuotaEvict();
+        }
         largeFreed += candidate->data_.byteSize();
         toFree.push_back(std::move(candidate->data()));
         removeEntryLocked(candidate);
@@ -392,6 +431,10 @@ void CacheShard::evict(uint64_t bytesToFree, bool evictAllUnpinned) {
         if (largeFreed + tinyFreed > bytesToFree) {
           break;
         }
+      } else if (
+          score != 0 && policy_ &&
+          candidate->score(now) >= evictionThreshold_) {
+        ++numPolicyRetained_;
       }
     }
   }
@@ -426,7 +469,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? entryScore(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -440,6 +483,19 @@ void CacheShard::calibrateThreshold() {
       80);
 }
 
+int32_t CacheShard::entryScore(
+    const AsyncDataCacheEntry& entry,
+    AccessTime now) const {
+  const auto score = entry.score(now);
+  if (!policy_ || !entry.key_.fileNum.hasValue()) {
+    return score;
+  }
+  return policy_->score(
+      std::hash<RawFileCacheKey>()(
+          RawFileCacheKey{entry.key_.fileNum.id(), entry.key_.offset}),
+      score);
+}
+
 void CacheShard::updateStats(CacheStats& stats) {
   std::lock_guard<std::mutex> l(mutex_);
   for (auto& entry : entries_) {
@@ -468,9 +524,30 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numPolicyRetained += numPolicyRetained_;
   stats.allocClocks += allocClocks_;
 }
 
+void CacheShard::appendCachedRanges(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t length,
+    std::vector<std::pair<uint64_t, uint64_t>>& ranges) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (!entry || !entry->key_.fileNum.hasValue() ||
+        entry->key_.fileNum.id() != fileNum || entry->isExclusive()) {
+      continue;
+    }
+    const uint64_t begin = std::max<uint64_t>(entry->offset(), offset);
+    const uint64_t end =
+        std::min<uint64_t>(entry->offset() + entry->size(), offset + length);
+    if (begin < end) {
+      ranges.emplace_back(begin, end);
+    }
+  }
+}
+
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   std::lock_guard<std::mutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
@@ -497,19 +574,28 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
 AsyncDataCache::AsyncDataCache(
     const std::shared_ptr<MemoryAllocator>& allocator,
     uint64_t /* maxBytes */,
-    std::unique_ptr<SsdCache> ssdCache)
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyFactory policyFactory)
     : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
-  for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
-  }
+  makeShards(policyFactory);
 }
 
 AsyncDataCache::AsyncDataCache(
     const std::shared_ptr<MemoryAllocator>& allocator,
-    std::unique_ptr<SsdCache> ssdCache)
+    std::unique_ptr<SsdCache> ssdCache,
+    CachePolicyFactory policyFactory)
     : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
+  makeShards(policyFactory);
+}
+
+void AsyncDataCache::makeShards(const CachePolicyFactory& policyFactory) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    std::unique_ptr<CachePolicy> policy;
+    if (policyFactory) {
+      policy = policyFactory(allocator_->capacity() / kNumShards);
+      policyName_ = policy->name();
+    }
+    shards_.push_back(std::make_unique<CacheShard>(this, std::move(policy)));
   }
 }
 
@@ -526,6 +612,34 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+double AsyncDataCache::cachedFraction(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t length) const {
+  if (length == 0) {
+    return 0;
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  for (auto& shard : shards_) {
+    shard->appendCachedRanges(fileNum, offset, length, ranges);
+  }
+  if (ssdCache_) {
+    ssdCache_->file(fileNum).appendCachedRanges(
+        fileNum, offset, length, ranges);
+  }
+  // The same bytes may be in memory and on SSD. Counts the union.
+  std::sort(ranges.begin(), ranges.end());
+  uint64_t cachedBytes = 0;
+  uint64_t covered = offset;
+  for (const auto& [begin, end] : ranges) {
+    if (end > covered) {
+      cachedBytes += end - std::max(begin, covered);
+      covered = end;
+    }
+  }
+  return static_cast<double>(cachedBytes) / length;
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool()> allocate) {
@@ -694,9 +808,34 @@ CacheStats AsyncDataCache::refreshStats() const {
   if (ssdCache_) {
     stats.ssdStats = std::make_shared<SsdCacheStats>(ssdCache_->stats());
   }
+  tenants_.withRLock([&](const auto& tenants) {
+    for (const auto& [name, tenant] : tenants) {
+      stats.tenantStats.push_back(tenant->stats());
+    }
+  });
   return stats;
 }
 
+CacheTenant* AsyncDataCache::tenant(std::string_view name) {
+  if (name.empty()) {
+    return nullptr;
+  }
+  const std::string key(name);
+  {
+    auto tenants = tenants_.rlock();
+    auto it = tenants->find(key);
+    if (it != tenants->end()) {
+      return it->second.get();
+    }
+  }
+  auto tenants = tenants_.wlock();
+  auto& tenant = (*tenants)[key];
+  if (!tenant) {
+    tenant = std::make_unique<CacheTenant>(key);
+  }
+  return tenant.get();
+}
+
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     shard->evict(std::numeric_limits<int32_t>::max(), true);
@@ -711,12 +850,22 @@ std::string AsyncDataCache::toString() const {
           stats.largePadding
       << " bytes\n"
       << "Miss: " << stats.numNew << " Hit " << stats.numHit << " evict "
-      << stats.numEvict << "\n"
+      << stats.numEvict;
+  if (!policyName_.empty()) {
+    out << " " << policyName_ << " retained " << stats.numPolicyRetained;
+  }
+  out << "\n"
       << " read pins " << stats.numShared << " write pins "
       << stats.numExclusive << " unused prefetch " << stats.numPrefetch
       << " Alloc Megaclocks " << (stats.allocClocks >> 20)
       << " allocated pages " << numAllocated() << " cached pages "
       << cachedPages_;
+  for (const auto& tenant : stats.tenantStats) {
+    out << "\nTenant " << tenant.name << ": " << tenant.cachedBytes
+        << " bytes, quota " << tenant.quotaBytes << " hit " << tenant.numHit
+        << " miss " << tenant.numMiss << " quota evict "
+        << tenant.numQuotaEvict;
+  }
   out << "\nBacking: " << allocator_->toString();
   if (ssdCache_) {
     out << "\nSSD: " << ssdCache_->toString();
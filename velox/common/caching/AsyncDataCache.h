@@ -19,12 +19,14 @@
 #include <deque>
 
 #include <fmt/format.h>
+#include <folly/Synchronized.h>
 #include <folly/chrono/Hardware.h>
 #include <folly/futures/SharedPromise.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CachePolicy.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -125,6 +127,85 @@ struct hash<::facebook::velox::cache::RawFileCacheKey> {
 
 namespace facebook::velox::cache {
 
+// Snapshot of the usage of a CacheTenant.
+struct CacheTenantStats {
+  std::string name;
+  // Soft quota in bytes, 0 if none.
+  uint64_t quotaBytes{};
+  // Bytes in entries charged to the tenant.
+  int64_t cachedBytes{};
+  // Number and bytes of hits by the tenant. The first hit to a prefetched
+  // entry does not count.
+  int64_t numHit{};
+  int64_t hitBytes{};
+  // Number and bytes of entries loaded by the tenant.
+  int64_t numMiss{};
+  int64_t missBytes{};
+  // Number of entries evicted because the tenant was over its quota.
+  int64_t numQuotaEvict{};
+};
+
+// Divides the contents of AsyncDataCache between users, e.g. teams or query
+// groups. An entry is charged to the tenant of the ScanTracker that loads it.
+// A tenant may have a soft quota. In eviction, unpinned entries of a tenant
+// over its quota go first regardless of their score, and the entries of a
+// tenant under its quota are retained unless all unpinned entries must go.
+// This keeps a working set for each tenant with a quota. Tenants are owned by
+// the AsyncDataCache and live as long as it.
+class CacheTenant {
+ public:
+  explicit CacheTenant(std::string name) : name_(std::move(name)) {}
+
+  const std::string& name() const {
+    return name_;
+  }
+
+  // Sets the soft quota in bytes. 0 means no quota.
+  void setQuota(uint64_t bytes) {
+    quotaBytes_ = bytes;
+  }
+
+  bool overQuota() const {
+    const uint64_t quota = quotaBytes_;
+    return quota != 0 && cachedBytes_ > quota;
+  }
+
+  bool underQuota() const {
+    const uint64_t quota = quotaBytes_;
+    return quota != 0 && cachedBytes_ < quota;
+  }
+
+  void addCachedBytes(int64_t bytes) {
+    cachedBytes_ += bytes;
+  }
+
+  void recordHit(int64_t bytes) {
+    ++numHit_;
+    hitBytes_ += bytes;
+  }
+
+  void recordMiss(int64_t bytes) {
+    ++numMiss_;
+    missBytes_ += bytes;
+  }
+
+  void recordQuotaEvict() {
+    ++numQuotaEvict_;
+  }
+
+  CacheTenantStats stats() const;
+
+ private:
+  const std::string name_;
+  std::atomic<uint64_t> quotaBytes_{0};
+  std::atomic<int64_t> cachedBytes_{0};
+  std::atomic<int64_t> numHit_{0};
+  std::atomic<int64_t> hitBytes_{0};
+  std::atomic<int64_t> numMiss_{0};
+  std::atomic<int64_t> missBytes_{0};
+  std::atomic<int64_t> numQuotaEvict_{0};
+};
+
 // Represents a contiguous range of bytes cached from a file. This
 // is the primary unit of access. These are typically owned via
 // CachePin and can be in shared or exclusive mode. 'numPins_'
@@ -238,6 +319,14 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  // Charges 'this' to 'tenant' and counts a miss for 'tenant'. Must be called
+  // at most once while 'this' is exclusive. 'tenant' may be nullptr.
+  void setTenant(CacheTenant* FOLLY_NULLABLE tenant);
+
+  CacheTenant* FOLLY_NULLABLE tenant() const {
+    return tenant_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
@@ -299,6 +388,9 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // The tenant 'this' is charged to, nullptr if none.
+  CacheTenant* FOLLY_NULLABLE tenant_{nullptr};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -503,8 +595,14 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{};
+  // Number of times an entry was kept in eviction only because the cache
+  // policy found it frequently used.
+  int64_t numPolicyRetained{};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
+
+  // Stats of the tenants of the cache.
+  std::vector<CacheTenantStats> tenantStats;
 };
 // Collection of cache entries whose key hashes to the same shard of
 // the hash number space.  The cache population is divided into shards
@@ -512,7 +610,10 @@ struct CacheStats {
 // and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* FOLLY_NONNULL cache) : cache_(cache) {}
+  explicit CacheShard(
+      AsyncDataCache* FOLLY_NONNULL cache,
+      std::unique_ptr<CachePolicy> policy = nullptr)
+      : cache_(cache), policy_(std::move(policy)) {}
 
   // See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -546,6 +647,14 @@ class CacheShard {
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Appends the [begin, end) ranges of loaded entries of 'fileNum' that
+  // overlap [offset, offset + length) to 'ranges'. Visits all entries.
+  void appendCachedRanges(
+      uint64_t fileNum,
+      uint64_t offset,
+      uint64_t length,
+      std::vector<std::pair<uint64_t, uint64_t>>& ranges) const;
+
   // Appends a batch of non-saved SSD saveable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The saveable entries
@@ -562,6 +671,16 @@ class CacheShard {
 
   void calibrateThreshold();
 
+  // Returns the retention score of 'entry', adjusted by 'policy_' if set.
+  int32_t entryScore(const AsyncDataCacheEntry& entry, AccessTime now) const;
+
+  // Records a lookup of 'key' in 'policy_' if set.
+  void recordAccess(RawFileCacheKey key) const {
+    if (policy_) {
+      policy_->recordAccess(std::hash<RawFileCacheKey>()(key));
+    }
+  }
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found. 'size' is a hint for selecting an entry
@@ -582,6 +701,9 @@ class CacheShard {
   // few around to avoid allocating one inside 'mutex_'.
   std::vector<std::unique_ptr<AsyncDataCacheEntry>> freeEntries_;
   AsyncDataCache* const cache_;
+  // Adjusts the eviction scores. nullptr means that the scores of
+  // AccessStats are used as is.
+  const std::unique_ptr<CachePolicy> policy_;
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{};
   // Number of gets  since last stats sampling.
@@ -604,6 +726,8 @@ class CacheShard {
   // Sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{};
+  // Count of eviction candidates kept because of 'policy_'.
+  uint64_t numPolicyRetained_{};
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_;
@@ -616,11 +740,16 @@ class AsyncDataCache : public memory::MemoryAllocator {
   AsyncDataCache(
       const std::shared_ptr<memory::MemoryAllocator>& allocator,
       uint64_t maxBytes,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyFactory policyFactory = nullptr);
 
+  // If 'policyFactory' is set, each shard gets a policy from it, e.g.
+  // TinyLfuPolicy::create, for adjusting the eviction order. Otherwise
+  // entries are evicted by AccessStats::score().
   AsyncDataCache(
       const std::shared_ptr<memory::MemoryAllocator>& allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CachePolicyFactory policyFactory = nullptr);
 
   // Finds or creates a cache entry corresponding to 'key'. The entry
   // is returned in 'pin'. If the entry is new, it is pinned in
@@ -641,6 +770,14 @@ class AsyncDataCache : public memory::MemoryAllocator {
   // Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  // Returns the fraction of bytes [offset, offset + length) of 'fileNum' that
+  // is cached in memory or on SSD in this process. 'fileNum' is the id of the
+  // file in fileIds(). This is for preferring splits whose data is cached,
+  // e.g. in scheduling. All entries are visited, so this is not for use on
+  // every read.
+  double cachedFraction(uint64_t fileNum, uint64_t offset, uint64_t length)
+      const;
+
   Kind kind() const override {
     return allocator_->kind();
   }
@@ -693,8 +830,22 @@ class AsyncDataCache : public memory::MemoryAllocator {
 
   CacheStats refreshStats() const;
 
+  // Returns the tenant named 'name', creating it if needed. Returns nullptr
+  // if 'name' is empty.
+  CacheTenant* FOLLY_NULLABLE tenant(std::string_view name);
+
+  // Sets the soft quota of tenant 'name' to 'bytes'. See CacheTenant.
+  void setTenantQuota(std::string_view name, uint64_t bytes) {
+    tenant(name)->setQuota(bytes);
+  }
+
   std::string toString() const override;
 
+  // Returns the number of pages held by cache entries.
+  memory::MachinePageCount cachedPages() const {
+    return cachedPages_;
+  }
+
   memory::MachinePageCount incrementCachedPages(int64_t pages) {
     // The counter is unsigned and the increment is signed.
     return cachedPages_.fetch_add(pages) + pages;
@@ -767,6 +918,8 @@ class AsyncDataCache : public memory::MemoryAllocator {
   static constexpr int32_t kNumShards = 4; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
 
+  void makeShards(const CachePolicyFactory& policyFactory);
+
   // Waits a pseudorandom delay times 'counter'.
   void backoff(int32_t counter);
 
@@ -784,6 +937,11 @@ class AsyncDataCache : public memory::MemoryAllocator {
   std::shared_ptr<memory::MemoryAllocator> allocator_;
   std::unique_ptr<SsdCache> ssdCache_;
   std::vector<std::unique_ptr<CacheShard>> shards_;
+  // Name of the CachePolicy of the shards, empty if none.
+  std::string policyName_;
+  folly::Synchronized<
+      folly::F14FastMap<std::string, std::unique_ptr<CacheTenant>>>
+      tenants_;
   std::atomic<int32_t> shardCounter_{0};
   std::atomic<memory::MachinePageCount> cachedPages_{0};
   // Number of pages that are allocated and not yet loaded or loaded
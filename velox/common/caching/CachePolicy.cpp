@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CachePolicy.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Odd multipliers for deriving the counter of each row from the key hash.
+constexpr uint64_t kSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+
+constexpr uint64_t kHalfMask = 0x7777777777777777ULL;
+} // namespace
+
+FrequencySketch::FrequencySketch(int32_t numCounters) {
+  const auto width = bits::nextPowerOfTwo(
+      std::clamp<uint64_t>(numCounters, kCountersPerWord, 1 << 22));
+  mask_ = width - 1;
+  table_.resize(kDepth * width / kCountersPerWord);
+  sampleSize_ = 10 * width;
+}
+
+int32_t FrequencySketch::counterIndex(uint64_t hash, int32_t row) const {
+  const auto mixed = (hash + kSeeds[row]) * kSeeds[row];
+  return row * width() + ((mixed >> 32) & mask_);
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  bool added = false;
+  for (auto row = 0; row < kDepth; ++row) {
+    const auto index = counterIndex(hash, row);
+    if (counterAt(index) < kMaxFrequency) {
+      table_[index / kCountersPerWord] += 1ULL
+          << (4 * (index % kCountersPerWord));
+      added = true;
+    }
+  }
+  if (added && ++numAdditions_ >= sampleSize_) {
+    reset();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t frequency = kMaxFrequency;
+  for (auto row = 0; row < kDepth; ++row) {
+    frequency = std::min(frequency, counterAt(counterIndex(hash, row)));
+  }
+  return frequency;
+}
+
+void FrequencySketch::reset() {
+  for (auto& word : table_) {
+    word = (word >> 1) & kHalfMask;
+  }
+  numAdditions_ /= 2;
+  ++numResets_;
+}
+
+// static
+std::unique_ptr<CachePolicy> TinyLfuPolicy::create(uint64_t capacity) {
+  return std::make_unique<TinyLfuPolicy>(std::min<uint64_t>(
+      std::numeric_limits<int32_t>::max(), capacity / kBytesPerKey));
+}
+
+int32_t TinyLfuPolicy::score(uint64_t hash, int32_t accessScore) const {
+  if (accessScore == std::numeric_limits<int32_t>::max()) {
+    // Explicitly evictable.
+    return accessScore;
+  }
+  const auto frequency = sketch_.estimate(hash);
+  if (frequency <= 1) {
+    return accessScore;
+  }
+  return accessScore / frequency;
+}
+
+} // namespace facebook::velox::cache
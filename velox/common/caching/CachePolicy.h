@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+// Approximate counter of how often each of a large number of keys has been
+// seen. This is a count-min sketch of 4 rows of 4 bit counters. The counters
+// are halved after a number of increments proportional to the width, so that
+// the frequencies reflect recent history. This is the frequency estimator of
+// TinyLFU.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxFrequency = 15;
+
+  // 'numCounters' is the expected number of distinct keys, rounded up to a
+  // power of 2.
+  explicit FrequencySketch(int32_t numCounters);
+
+  // Counts an occurrence of the key with 'hash'.
+  void increment(uint64_t hash);
+
+  // Returns the estimated number of occurrences of the key with 'hash' since
+  // the last halvings, between 0 and kMaxFrequency.
+  int32_t estimate(uint64_t hash) const;
+
+  int32_t width() const {
+    return mask_ + 1;
+  }
+
+  // Number of times the counters have been halved.
+  uint64_t numResets() const {
+    return numResets_;
+  }
+
+ private:
+  static constexpr int32_t kDepth = 4;
+  static constexpr int32_t kCountersPerWord = 16;
+
+  // Returns the index of the counter of 'hash' in 'row'.
+  int32_t counterIndex(uint64_t hash, int32_t row) const;
+
+  int32_t counterAt(int32_t index) const {
+    return (table_[index / kCountersPerWord] >>
+            (4 * (index % kCountersPerWord))) &
+        kMaxFrequency;
+  }
+
+  // Halves all counters.
+  void reset();
+
+  // 'kDepth' rows of 'mask_' + 1 counters each, 16 counters per word.
+  std::vector<uint64_t> table_;
+  uint32_t mask_;
+  // Number of increments after which the counters are halved.
+  int32_t sampleSize_;
+  int32_t numAdditions_{0};
+  uint64_t numResets_{0};
+};
+
+// Retention policy for the entries of a CacheShard. A policy sees every
+// lookup of the shard and adjusts the score that AccessStats gives to an
+// entry in eviction. Each shard has its own policy. All calls are made under
+// the mutex of the shard.
+class CachePolicy {
+ public:
+  virtual ~CachePolicy() = default;
+
+  // Records a lookup of the key with 'hash', whether a hit or a miss.
+  virtual void recordAccess(uint64_t hash) = 0;
+
+  // Returns the retention score of the entry with key 'hash' and score
+  // 'accessScore' from AccessStats. A higher number means less worth
+  // retaining.
+  virtual int32_t score(uint64_t hash, int32_t accessScore) const = 0;
+
+  virtual std::string name() const = 0;
+};
+
+// Makes a CachePolicy for a shard with 'capacity' bytes of memory.
+using CachePolicyFactory =
+    std::function<std::unique_ptr<CachePolicy>(uint64_t capacity)>;
+
+// Frequency based retention on top of recency (W-TinyLFU). The lookups of all
+// keys, including the ones not in the cache, are counted in a
+// FrequencySketch. The score of an entry is divided by its frequency, so that
+// often used data outlives a large scan of data that is used once. Entries
+// seen only once are not protected, which makes new data compete with the
+// least valuable entries until it is used again. This is the admission
+// filter. The recency of AccessStats plays the part of the window.
+class TinyLfuPolicy : public CachePolicy {
+ public:
+  // Approximate average cached bytes per key, used for sizing the sketch.
+  static constexpr uint64_t kBytesPerKey = 8 << 10;
+
+  explicit TinyLfuPolicy(int32_t numKeys) : sketch_(numKeys) {}
+
+  static std::unique_ptr<CachePolicy> create(uint64_t capacity);
+
+  void recordAccess(uint64_t hash) override {
+    sketch_.increment(hash);
+  }
+
+  int32_t score(uint64_t hash, int32_t accessScore) const override;
+
+  std::string name() const override {
+    return "TinyLFU";
+  }
+
+  const FrequencySketch& sketch() const {
+    return sketch_;
+  }
+
+ private:
+  FrequencySketch sketch_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox::cache {
+
+std::shared_ptr<const FileMetadata> FileMetadataCache::find(
+    const std::string& path,
+    uint64_t version) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(path);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+  auto entry = it->second;
+  if (entry->version != version) {
+    removeLocked(entry);
+    return nullptr;
+  }
+  if (ttlMs_ != 0 && getCurrentTimeMs() - entry->insertTimeMs >= ttlMs_) {
+    ++numExpired_;
+    removeLocked(entry);
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, entry);
+  return entry->metadata;
+}
+
+void FileMetadataCache::insert(
+    const std::string& path,
+    uint64_t version,
+    std::shared_ptr<const FileMetadata> metadata) {
+  const auto size = metadata->size();
+  if (size > maxBytes_ / 4) {
+    return;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(path);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  while (curBytes_ + size > maxBytes_ && !lru_.empty()) {
+    ++numEvictions_;
+    removeLocked(std::prev(lru_.end()));
+  }
+  lru_.push_front(
+      Entry{path, version, std::move(metadata), size, getCurrentTimeMs()});
+  entries_[path] = lru_.begin();
+  curBytes_ += size;
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  curBytes_ = 0;
+}
+
+FileMetadataCacheStats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  FileMetadataCacheStats stats;
+  stats.numEntries = lru_.size();
+  stats.curBytes = curBytes_;
+  stats.maxBytes = maxBytes_;
+  stats.numHits = numHits_;
+  stats.numLookups = numLookups_;
+  stats.numEvictions = numEvictions_;
+  stats.numExpired = numExpired_;
+  return stats;
+}
+
+void FileMetadataCache::removeLocked(EntryList::iterator it) {
+  curBytes_ -= it->size;
+  entries_.erase(it->path);
+  lru_.erase(it);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <fmt/format.h>
+#include "folly/container/F14Map.h"
+
+namespace facebook::velox::memory {
+class MemoryPool;
+}
+
+namespace facebook::velox::cache {
+
+// Parsed metadata of a file, e.g. the footer, schema and stripe or row group
+// statistics of a columnar file. Immutable once cached, so that readers of
+// the same file on different threads can share it.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  // Approximate memory footprint in bytes.
+  virtual uint64_t size() const = 0;
+};
+
+struct FileMetadataCacheStats {
+  uint64_t numEntries{0};
+  uint64_t curBytes{0};
+  uint64_t maxBytes{0};
+  uint64_t numHits{0};
+  uint64_t numLookups{0};
+  uint64_t numEvictions{0};
+  uint64_t numExpired{0};
+
+  std::string toString() const {
+    return fmt::format(
+        "{{entries: {} bytes: {}/{} hits/lookups: {}/{} evictions: {} "
+        "expired: {}}}",
+        numEntries,
+        curBytes,
+        maxBytes,
+        numHits,
+        numLookups,
+        numEvictions,
+        numExpired);
+  }
+};
+
+// Thread-safe LRU cache of FileMetadata bounded by the total size of the
+// entries. An entry is keyed by the path of the file and identified by a
+// version, e.g. the modification time or size of the file. A lookup with a
+// different version drops the entry, so that a rewritten file is not read
+// with stale metadata. Entries older than 'ttlMs' are dropped on lookup so
+// that files replaced with the same version are seen eventually.
+class FileMetadataCache {
+ public:
+  // 'ttlMs' of 0 means that entries do not expire. If 'pool' is set, the
+  // readers allocate the buffers of the metadata they cache from it instead
+  // of the pools of their queries, which the cached entries may outlive.
+  FileMetadataCache(
+      uint64_t maxBytes,
+      uint64_t ttlMs,
+      std::shared_ptr<memory::MemoryPool> pool = nullptr)
+      : maxBytes_(maxBytes), ttlMs_(ttlMs), pool_(std::move(pool)) {}
+
+  // Returns the metadata of 'path' with 'version' or nullptr if not cached.
+  std::shared_ptr<const FileMetadata> find(
+      const std::string& path,
+      uint64_t version);
+
+  // Adds 'metadata' for 'path' with 'version', replacing any previous entry
+  // of 'path' and evicting least recently used entries to stay within
+  // 'maxBytes_'. Metadata larger than a quarter of the capacity is not
+  // cached.
+  void insert(
+      const std::string& path,
+      uint64_t version,
+      std::shared_ptr<const FileMetadata> metadata);
+
+  void clear();
+
+  FileMetadataCacheStats stats() const;
+
+  const std::shared_ptr<memory::MemoryPool>& pool() const {
+    return pool_;
+  }
+
+ private:
+  struct Entry {
+    std::string path;
+    uint64_t version;
+    std::shared_ptr<const FileMetadata> metadata;
+    uint64_t size;
+    uint64_t insertTimeMs;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  // Removes the entry at 'it'. Must be called under 'mutex_'.
+  void removeLocked(EntryList::iterator it);
+
+  const uint64_t maxBytes_;
+  const uint64_t ttlMs_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Most recently used entry first.
+  EntryList lru_;
+  folly::F14FastMap<std::string, EntryList::iterator> entries_;
+  uint64_t curBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numLookups_{0};
+  uint64_t numEvictions_{0};
+  uint64_t numExpired_{0};
+};
+
+} // namespace facebook::velox::cache
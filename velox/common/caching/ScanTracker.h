@@ -114,16 +114,19 @@ class ScanTracker {
   // shared_ptr and will be referenced from a map from id to weak_ptr
   // to 'this'. 'unregisterer' is supplied so that the destructor can
   // remove the weak_ptr from the map of pending trackers. 'loadQuantum' is the
-  // largest single IO size for read.
+  // largest single IO size for read. 'tenant' is the cache tenant the data
+  // read by the scan is charged to, empty if none. See CacheTenant.
   ScanTracker(
       std::string_view id,
       std::function<void(ScanTracker* FOLLY_NONNULL)> unregisterer,
       int32_t loadQuantum,
-      FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr)
+      FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr,
+      std::string_view tenant = "")
       : id_(id),
         unregisterer_(unregisterer),
         loadQuantum_(loadQuantum),
-        fileGroupStats_(fileGroupStats) {}
+        fileGroupStats_(fileGroupStats),
+        tenant_(tenant) {}
 
   ~ScanTracker() {
     if (unregisterer_) {
@@ -176,6 +179,10 @@ class ScanTracker {
     return fileGroupStats_;
   }
 
+  const std::string& tenant() const {
+    return tenant_;
+  }
+
   std::string toString() const;
 
  private:
@@ -191,6 +198,7 @@ class ScanTracker {
   // size is unlimited.
   const int32_t loadQuantum_;
   FileGroupStats* FOLLY_NULLABLE fileGroupStats_;
+  const std::string tenant_;
 };
 
 } // namespace facebook::velox::cache
@@ -17,7 +17,6 @@
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
 #include <folly/portability/SysUio.h>
-#include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/FileIds.h"
 
 #include <fcntl.h>
@@ -27,11 +26,18 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <deque>
 #include <fstream>
 #include <numeric>
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_int32(
+    ssd_max_inflight_writes,
+    1,
+    "Maximum number of concurrent writes to one SSD cache file. Writes "
+    "beyond the first are issued on the cache executor. 1 writes from the "
+    "calling thread only");
 
 namespace facebook::velox::cache {
 
@@ -214,6 +220,37 @@ bool SsdFile::erase(RawFileCacheKey key) {
   return true;
 }
 
+void SsdFile::checkFileSize(uint64_t fileNum, uint64_t fileSize) {
+  if (!checkpointIntervalBytes_) {
+    return;
+  }
+  {
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    auto it = fileSizes_.find(fileNum);
+    if (it != fileSizes_.end() && it->second == fileSize) {
+      return;
+    }
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  auto& recordedSize = fileSizes_[fileNum];
+  if (recordedSize != 0 && recordedSize != fileSize) {
+    uint64_t numErased = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->first.fileNum.id() == fileNum) {
+        it = entries_.erase(it);
+        ++numErased;
+      } else {
+        ++it;
+      }
+    }
+    stats_.entriesInvalidated += numErased;
+    LOG(INFO) << "Erased " << numErased << " entries of changed file "
+              << fileIds().string(fileNum) << " from shard " << shardId_
+              << ": size " << recordedSize << " vs " << fileSize;
+  }
+  recordedSize = fileSize;
+}
+
 CoalesceIoStats SsdFile::load(
     const std::vector<SsdPin>& ssdPins,
     const std::vector<CachePin>& pins) {
@@ -368,56 +405,53 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     VELOX_CHECK_NULL(entry->ssdFile());
     total += entry->size();
   }
+  // Writes that may be in progress on 'executor_', oldest first.
+  std::deque<std::unique_ptr<WriteBatch>> inflight;
+  const size_t maxInflight =
+      executor_ ? std::max(1, FLAGS_ssd_max_inflight_writes) : 1;
+  bool failed = false;
   int32_t storeIndex = 0;
-  while (storeIndex < pins.size()) {
+  while (!failed && storeIndex < pins.size()) {
     auto space = getSpace(pins, storeIndex);
 
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
-      return;
+      break;
     }
-    auto [offset, available] = space.value();
-    int32_t numWritten = 0;
-    int32_t bytes = 0;
-    std::vector<iovec> iovecs;
+    auto batch = std::make_unique<WriteBatch>();
+    batch->begin = storeIndex;
+    batch->offset = space.value().first;
+    const auto available = space.value().second;
+    auto iovecs = std::make_shared<std::vector<iovec>>();
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto entry = pins[i].checkedEntry();
       auto entrySize = entry->size();
-      if (bytes + entrySize > available) {
+      if (batch->bytes + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, iovecs);
-      bytes += entrySize;
-      ++numWritten;
-    }
-    VELOX_CHECK_GE(fileSize_, offset + bytes);
-    auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
-    if (rc != bytes) {
-      LOG(ERROR) << "Failed to write to SSD: " << folly::errnoStr(errno);
-      ++stats_.writeSsdErrors;
-      // If the write fails we return without adding the pins to the cache. The
-      // entries are unchanged.
-      return;
+      addEntryToIovecs(*entry, *iovecs);
+      batch->bytes += entrySize;
+      ++batch->numPins;
     }
-    {
-      std::lock_guard<std::shared_mutex> l(mutex_);
-      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
-        auto entry = pins[i].checkedEntry();
-        entry->setSsdFile(this, offset);
-        auto size = entry->size();
-        FileCacheKey key = {
-            entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
-        }
-        offset += size;
-        ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
-      }
+    VELOX_CHECK_GE(fileSize_, batch->offset + batch->bytes);
+    batch->write = std::make_shared<AsyncSource<ssize_t>>(
+        [fd = fd_, iovecs, offset = batch->offset]() {
+          auto rc = folly::pwritev(fd, iovecs->data(), iovecs->size(), offset);
+          // The errno of a failed write, negated.
+          return std::make_unique<ssize_t>(rc < 0 ? -errno : rc);
+        });
+    storeIndex += batch->numPins;
+    if (maxInflight > 1) {
+      executor_->add([write = batch->write]() { write->prepare(); });
+    }
+    inflight.push_back(std::move(batch));
+    while (inflight.size() >= maxInflight) {
+      failed |= !finishWrite(*inflight.front(), pins);
+      inflight.pop_front();
     }
-    storeIndex += numWritten;
+  }
+  for (auto& batch : inflight) {
+    finishWrite(*batch, pins);
   }
 
   if (checkpointIntervalBytes_ &&
@@ -426,6 +460,37 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   }
 }
 
+bool SsdFile::finishWrite(WriteBatch& batch, std::vector<CachePin>& pins) {
+  auto rc = batch.write->move();
+  if (rc == nullptr || *rc != batch.bytes) {
+    LOG(ERROR) << "Failed to write to SSD: "
+               << (rc != nullptr && *rc < 0 ? folly::errnoStr(-*rc)
+                                            : "short write");
+    ++stats_.writeSsdErrors;
+    // If the write fails we do not add the pins to the cache. The entries are
+    // unchanged.
+    return false;
+  }
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  auto offset = batch.offset;
+  for (auto i = batch.begin; i < batch.begin + batch.numPins; ++i) {
+    auto entry = pins[i].checkedEntry();
+    entry->setSsdFile(this, offset);
+    auto size = entry->size();
+    FileCacheKey key = {
+        entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+    entries_[std::move(key)] = SsdRun(offset, size);
+    if (FLAGS_ssd_verify_write) {
+      verifyWrite(*entry, SsdRun(offset, size));
+    }
+    offset += size;
+    ++stats_.entriesWritten;
+    stats_.bytesWritten += size;
+    bytesAfterCheckpoint_ += size;
+  }
+  return true;
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -466,6 +531,24 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+void SsdFile::appendCachedRanges(
+    uint64_t fileNum,
+    uint64_t offset,
+    uint64_t length,
+    std::vector<std::pair<uint64_t, uint64_t>>& ranges) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    if (key.fileNum.id() != fileNum) {
+      continue;
+    }
+    const uint64_t begin = std::max(key.offset, offset);
+    const uint64_t end = std::min(key.offset + run.size(), offset + length);
+    if (begin < end) {
+      ranges.emplace_back(begin, end);
+    }
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // emantics.
@@ -491,11 +574,13 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.entriesInvalidated += stats_.entriesInvalidated;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  fileSizes_.clear();
   std::fill(regionSize_.begin(), regionSize_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
@@ -595,7 +680,7 @@ void SsdFile::checkpoint(bool force) {
     // int32_t maxRegions,
     // int32_t numRegions,
     // regionScores from the 'tracker_',
-    // {fileId, fileName} pairs,
+    // {fileId, fileName, fileSize} triples, fileSize is 0 if not known,
     // kMapMarker,
     // {fileId, offset, SSdRun} triples,
     // kEndMarker.
@@ -615,6 +700,17 @@ void SsdFile::checkpoint(bool force) {
         int32_t length = name.size();
         state.write(asChar(&length), sizeof(length));
         state.write(name.data(), length);
+        auto it = fileSizes_.find(fileNum);
+        const uint64_t fileSize = it == fileSizes_.end() ? 0 : it->second;
+        state.write(asChar(&fileSize), sizeof(fileSize));
+      }
+    }
+    // Drops the sizes of the files that no longer have entries.
+    for (auto it = fileSizes_.begin(); it != fileSizes_.end();) {
+      if (fileNums.count(it->first) == 0) {
+        it = fileSizes_.erase(it);
+      } else {
+        ++it;
       }
     }
     const auto mapMarker = kCheckpointMapMarker;
@@ -733,7 +829,8 @@ T readNumber(std::ifstream& stream) {
 void SsdFile::readCheckpoint(std::ifstream& state) {
   char magic[4];
   state.read(magic, sizeof(magic));
-  VELOX_CHECK(strncmp(magic, kCheckpointMagic, 4) == 0);
+  const bool hasFileSizes = strncmp(magic, kCheckpointMagic, 4) == 0;
+  VELOX_CHECK(hasFileSizes || strncmp(magic, kCheckpointMagicV1, 4) == 0);
   auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
       maxRegions,
@@ -743,6 +840,7 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   std::vector<int64_t> scores(maxRegions);
   state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
   std::unordered_map<uint64_t, StringIdLease> idMap;
+  folly::F14FastMap<uint64_t, uint64_t> fileSizes;
   for (;;) {
     auto id = readNumber<uint64_t>(state);
     if (id == kCheckpointMapMarker) {
@@ -752,6 +850,12 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     name.resize(readNumber<int32_t>(state));
     state.read(name.data(), name.size());
     auto lease = StringIdLease(fileIds(), name);
+    if (hasFileSizes) {
+      const auto fileSize = readNumber<uint64_t>(state);
+      if (fileSize != 0) {
+        fileSizes[lease.id()] = fileSize;
+      }
+    }
     idMap[id] = std::move(lease);
   }
   auto logSize = lseek(evictLogFd_, 0, SEEK_END);
@@ -778,9 +882,15 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       entries_[std::move(key)] = run;
     }
   }
-  // The state is successfully read. Install the access frequency scores and
-  // evicted regions.
+  // The state is successfully read. Install the access frequency scores,
+  // evicted regions and the used bytes of the regions with entries.
   VELOX_CHECK_EQ(scores.size(), tracker_.regionScores().size());
+  fileSizes_ = std::move(fileSizes);
+  for (const auto& [key, run] : entries_) {
+    const auto region = regionIndex(run.offset());
+    const uint32_t end = run.offset() - region * kRegionSize + run.size();
+    regionSize_[region] = std::max(regionSize_[region], end);
+  }
   // Set the writable regions by deduplicated evicted regions.
   writableRegions_.clear();
   for (auto region : evictedMap) {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
 #include "velox/common/file/File.h"
@@ -24,6 +25,7 @@
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_int32(ssd_max_inflight_writes);
 
 namespace facebook::velox::cache {
 
@@ -144,6 +146,7 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    entriesInvalidated = tsanAtomicValue(other.entriesInvalidated);
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +166,8 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Entries dropped because their source file changed after they were cached.
+  tsan_atomic<uint64_t> entriesInvalidated{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -189,7 +194,9 @@ class SsdFile {
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
-  // The file of the entries must be a file that is backed by 'this'.
+  // The file of the entries must be a file that is backed by 'this'. Up to
+  // --ssd_max_inflight_writes contiguous runs of pins are written
+  // concurrently using 'executor_'.
   void write(std::vector<CachePin>& pins);
 
   // Finds an entry for 'key'. If no entry is found, the returned pin is empty.
@@ -198,6 +205,13 @@ class SsdFile {
   // Erases 'key'
   bool erase(RawFileCacheKey key);
 
+  // Records 'fileSize' as the size of the source file 'fileNum' when
+  // checkpointing is on. The sizes are saved with the checkpoint. If a
+  // different size is on record, e.g. from a checkpoint made before a restart,
+  // the file has changed since its entries were cached and the entries are
+  // erased. Must be called before looking up the entries of a file.
+  void checkFileSize(uint64_t fileNum, uint64_t fileSize);
+
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
   // entries if they are in ascending order and near enough.
   CoalesceIoStats load(
@@ -239,6 +253,14 @@ class SsdFile {
   // Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  // Appends the [begin, end) ranges of the entries of 'fileNum' that overlap
+  // [offset, offset + length) to 'ranges'. Visits all entries.
+  void appendCachedRanges(
+      uint64_t fileNum,
+      uint64_t offset,
+      uint64_t length,
+      std::vector<std::pair<uint64_t, uint64_t>>& ranges) const;
+
   // Resets this' to a post-construction empty state. See SsdCache::clear().
   void clear();
 
@@ -256,8 +278,9 @@ class SsdFile {
 
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
-  // versions.
-  static constexpr const char* FOLLY_NONNULL kCheckpointMagic = "CPT1";
+  // versions. Version 2 adds the source file size after each file name.
+  static constexpr const char* FOLLY_NONNULL kCheckpointMagic = "CPT2";
+  static constexpr const char* FOLLY_NONNULL kCheckpointMagicV1 = "CPT1";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -279,6 +302,22 @@ class SsdFile {
       const std::vector<CachePin>& pins,
       int32_t begin);
 
+  // A write of the data of consecutive pins to a contiguous range of the file.
+  struct WriteBatch {
+    // Index of the first pin in the write.
+    int32_t begin{0};
+    int32_t numPins{0};
+    uint64_t offset{0};
+    int32_t bytes{0};
+    // Makes the write and returns its result. May be prepared on 'executor_'.
+    std::shared_ptr<AsyncSource<ssize_t>> write;
+  };
+
+  // Waits for 'batch' to be written, or writes it on the calling thread if it
+  // has not started. Adds the entries of 'pins' in 'batch' to 'entries_' and
+  // returns true if the write succeeded.
+  bool finishWrite(WriteBatch& batch, std::vector<CachePin>& pins);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regionIndices);
@@ -356,6 +395,10 @@ class SsdFile {
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
+  // Size of the source files keyed on file number. Set by checkFileSize() and
+  // readCheckpoint() and pruned to the files with entries at checkpoint.
+  folly::F14FastMap<uint64_t, uint64_t> fileSizes_;
+
   // Name of backing file.
   const std::string filename_;
 
@@ -84,7 +84,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CachePolicyFactory policyFactory = nullptr) {
     std::unique_ptr<SsdCache> ssdCache;
     if (ssdBytes) {
       // tmpfs does not support O_DIRECT, so turn this off for testing.
@@ -107,7 +110,8 @@ class AsyncDataCacheTest : public testing::Test {
     cache_ = std::make_shared<AsyncDataCache>(
         std::make_shared<memory::MmapAllocator>(options),
         maxBytes,
-        std::move(ssdCache));
+        std::move(ssdCache),
+        std::move(policyFactory));
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -567,6 +571,102 @@ TEST_F(AsyncDataCacheTest, replace) {
       cache_->incrementCachedPages(0));
 }
 
+TEST_F(AsyncDataCacheTest, replaceWithTinyLfu) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  FLAGS_velox_exception_user_stacktrace_enabled = false;
+  initializeCache(kMaxBytes, 0, TinyLfuPolicy::create);
+  loadLoop(0, kMaxBytes * 10, 21);
+  if (executor_) {
+    executor_->join();
+  }
+  auto stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numHit);
+  EXPECT_LT(0, stats.numEvict);
+  EXPECT_NE(std::string::npos, cache_->toString().find("TinyLFU retained"));
+  EXPECT_GE(
+      kMaxBytes / memory::AllocationTraits::kPageSize,
+      cache_->incrementCachedPages(0));
+}
+
+TEST_F(AsyncDataCacheTest, tenantQuota) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 256 << 10;
+  constexpr int32_t kNumInteractive = 16;
+  constexpr uint64_t kQuota = 16 << 20;
+  initializeCache(kMaxBytes);
+  EXPECT_EQ(nullptr, cache_->tenant(""));
+  cache_->setTenantQuota("interactive", kQuota);
+  auto* interactive = cache_->tenant("interactive");
+  auto* backfill = cache_->tenant("backfill");
+  EXPECT_EQ(interactive, cache_->tenant("interactive"));
+
+  uint64_t offset = 0;
+  auto load = [&](CacheTenant* tenant, int32_t numEntries) {
+    for (auto i = 0; i < numEntries; ++i) {
+      auto pin = newEntry(offset += kSize, kSize);
+      ASSERT_FALSE(pin.empty());
+      pin.entry()->setTenant(tenant);
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  auto tenantStats = [&](const std::string& name) {
+    for (auto& stats : cache_->refreshStats().tenantStats) {
+      if (stats.name == name) {
+        return stats;
+      }
+    }
+    return CacheTenantStats{};
+  };
+
+  // The interactive tenant stays under its quota while the backfill loads 4x
+  // the capacity.
+  load(interactive, kNumInteractive);
+  load(backfill, 4 * kMaxBytes / kSize);
+  EXPECT_LT(0, cache_->refreshStats().numEvict);
+  auto stats = tenantStats("interactive");
+  EXPECT_EQ(kQuota, stats.quotaBytes);
+  EXPECT_EQ(kNumInteractive, stats.numMiss);
+  EXPECT_EQ(kNumInteractive * kSize, stats.missBytes);
+  EXPECT_EQ(kNumInteractive * kSize, stats.cachedBytes);
+  stats = tenantStats("backfill");
+  EXPECT_EQ(4 * kMaxBytes / kSize, stats.numMiss);
+  EXPECT_GT(kMaxBytes, stats.cachedBytes);
+
+  // With a lower quota the interactive tenant is over quota and its entries go
+  // first.
+  cache_->setTenantQuota("interactive", 2 << 20);
+  load(backfill, kMaxBytes / kSize);
+  stats = tenantStats("interactive");
+  EXPECT_GE(2 << 20, stats.cachedBytes);
+  EXPECT_LT(0, stats.numQuotaEvict);
+  EXPECT_NE(std::string::npos, cache_->toString().find("Tenant backfill"));
+
+  cache_->clear();
+  EXPECT_EQ(0, tenantStats("interactive").cachedBytes);
+  EXPECT_EQ(0, tenantStats("backfill").cachedBytes);
+}
+
+TEST_F(AsyncDataCacheTest, cachedFraction) {
+  constexpr int32_t kSize = 16 << 10;
+  initializeCache(64 << 20);
+  const auto fileNum = filenames_[0].id();
+  EXPECT_EQ(0, cache_->cachedFraction(fileNum, 0, 4 * kSize));
+  // Entries at [kSize, 2 * kSize) and [3 * kSize, 4 * kSize).
+  auto pin = newEntry(kSize, kSize);
+  // Entries being loaded do not count.
+  EXPECT_EQ(0, cache_->cachedFraction(fileNum, 0, 4 * kSize));
+  pin.entry()->setExclusiveToShared();
+  pin = newEntry(3 * kSize, kSize);
+  pin.entry()->setExclusiveToShared();
+  pin.clear();
+  EXPECT_EQ(0.5, cache_->cachedFraction(fileNum, 0, 4 * kSize));
+  EXPECT_EQ(1, cache_->cachedFraction(fileNum, kSize, kSize));
+  EXPECT_EQ(0.5, cache_->cachedFraction(fileNum, kSize / 2, kSize));
+  EXPECT_EQ(0, cache_->cachedFraction(fileNum, 2 * kSize, kSize));
+  EXPECT_EQ(0, cache_->cachedFraction(filenames_[1].id(), 0, 4 * kSize));
+  EXPECT_EQ(0, cache_->cachedFraction(fileNum, 0, 0));
+}
+
 TEST_F(AsyncDataCacheTest, outOfCapacity) {
   const int64_t kMaxBytes = 64
       << 20; // 64MB as MmapAllocator's min size is 64MB
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CachePolicy.h"
+#include "velox/common/base/BitUtil.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+uint64_t keyHash(uint64_t key) {
+  return bits::hashMix(1, key);
+}
+} // namespace
+
+TEST(CachePolicyTest, frequencySketch) {
+  FrequencySketch sketch(1000);
+  EXPECT_EQ(1024, sketch.width());
+  EXPECT_EQ(0, sketch.estimate(keyHash(1)));
+  // A few hot keys among many keys seen once.
+  for (auto i = 0; i < 1000; ++i) {
+    sketch.increment(keyHash(i % 4));
+    sketch.increment(keyHash(1000 + i));
+  }
+  for (auto key = 0; key < 4; ++key) {
+    EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.estimate(keyHash(key)));
+  }
+  int32_t numOverestimated = 0;
+  for (auto key = 1000; key < 2000; ++key) {
+    EXPECT_LE(1, sketch.estimate(keyHash(key)));
+    numOverestimated += sketch.estimate(keyHash(key)) > 2;
+  }
+  EXPECT_GT(50, numOverestimated);
+  EXPECT_EQ(0, sketch.numResets());
+
+  // The counters are halved after 10x the width of increments.
+  int32_t numIncrements = 0;
+  while (sketch.numResets() == 0) {
+    sketch.increment(keyHash(10'000 + numIncrements++));
+  }
+  EXPECT_LT(8 * sketch.width(), numIncrements);
+  for (auto key = 0; key < 4; ++key) {
+    EXPECT_EQ(
+        FrequencySketch::kMaxFrequency / 2, sketch.estimate(keyHash(key)));
+  }
+}
+
+TEST(CachePolicyTest, tinyLfu) {
+  auto policy = TinyLfuPolicy::create(1 << 30);
+  EXPECT_EQ("TinyLFU", policy->name());
+  for (auto i = 0; i < 10; ++i) {
+    policy->recordAccess(keyHash(1));
+  }
+  policy->recordAccess(keyHash(2));
+  // The frequently used key gets a lower score than the key seen once and a
+  // key never seen.
+  EXPECT_EQ(10, policy->score(keyHash(1), 100));
+  EXPECT_EQ(100, policy->score(keyHash(2), 100));
+  EXPECT_EQ(100, policy->score(keyHash(3), 100));
+  // Explicitly evictable entries stay evictable.
+  EXPECT_EQ(
+      std::numeric_limits<int32_t>::max(),
+      policy->score(keyHash(1), std::numeric_limits<int32_t>::max()));
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace facebook::velox::cache;
+
+namespace {
+class TestMetadata : public FileMetadata {
+ public:
+  explicit TestMetadata(uint64_t size) : size_(size) {}
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+ private:
+  const uint64_t size_;
+};
+
+std::shared_ptr<const FileMetadata> makeMetadata(uint64_t size) {
+  return std::make_shared<TestMetadata>(size);
+}
+} // namespace
+
+TEST(FileMetadataCacheTest, basic) {
+  FileMetadataCache cache(1000, 0);
+  EXPECT_EQ(nullptr, cache.find("a", 1));
+  auto a = makeMetadata(100);
+  cache.insert("a", 1, a);
+  EXPECT_EQ(a, cache.find("a", 1));
+
+  // A different version is a miss and drops the stale entry.
+  EXPECT_EQ(nullptr, cache.find("a", 2));
+  EXPECT_EQ(nullptr, cache.find("a", 1));
+
+  // Inserting a new version replaces the old one.
+  cache.insert("a", 1, a);
+  auto newA = makeMetadata(200);
+  cache.insert("a", 2, newA);
+  EXPECT_EQ(newA, cache.find("a", 2));
+  auto stats = cache.stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(200, stats.curBytes);
+  EXPECT_EQ(2, stats.numHits);
+  EXPECT_EQ(5, stats.numLookups);
+
+  cache.clear();
+  EXPECT_EQ(nullptr, cache.find("a", 2));
+  EXPECT_EQ(0, cache.stats().curBytes);
+}
+
+TEST(FileMetadataCacheTest, evict) {
+  FileMetadataCache cache(1000, 0);
+  for (auto i = 0; i < 4; ++i) {
+    cache.insert(std::to_string(i), 0, makeMetadata(250));
+  }
+  // Makes "0" the most recently used.
+  EXPECT_NE(nullptr, cache.find("0", 0));
+  cache.insert("4", 0, makeMetadata(250));
+  EXPECT_NE(nullptr, cache.find("0", 0));
+  EXPECT_EQ(nullptr, cache.find("1", 0));
+  EXPECT_NE(nullptr, cache.find("4", 0));
+  EXPECT_EQ(1, cache.stats().numEvictions);
+  EXPECT_EQ(1000, cache.stats().curBytes);
+
+  // Entries over a quarter of the capacity are not cached.
+  cache.insert("big", 0, makeMetadata(251));
+  EXPECT_EQ(nullptr, cache.find("big", 0));
+  EXPECT_EQ(4, cache.stats().numEntries);
+}
+
+TEST(FileMetadataCacheTest, ttl) {
+  FileMetadataCache cache(1000, 100);
+  cache.insert("a", 0, makeMetadata(10));
+  EXPECT_NE(nullptr, cache.find("a", 0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200)); // NOLINT
+  EXPECT_EQ(nullptr, cache.find("a", 0));
+  EXPECT_EQ(1, cache.stats().numExpired);
+  EXPECT_EQ(0, cache.stats().numEntries);
+}
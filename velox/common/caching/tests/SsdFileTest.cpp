@@ -18,6 +18,7 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -50,7 +51,9 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0,
+      folly::Executor* executor = nullptr) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = std::make_shared<AsyncDataCache>(
@@ -63,8 +66,9 @@ class SsdFileTest : public testing::Test {
         fmt::format("{}/ssdtest", tempDirectory_->path),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        checkpointIntervalBytes,
+        setNoCowFlag,
+        executor);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -297,6 +301,80 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, inflightWrites) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  folly::CPUThreadPoolExecutor executor(4);
+  FLAGS_ssd_max_inflight_writes = 4;
+  initializeCache(128 * kMB, kSsdSize, false, 0, &executor);
+  // Each batch but the first fills up the previous region and starts the
+  // next, so that there are at least two writes in flight.
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+    }
+  }
+  for (auto startOffset = 0; startOffset < kSsdSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    readAndCheckPins(pins);
+  }
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(0, stats.writeSsdErrors);
+  FLAGS_ssd_max_inflight_writes = 1;
+
+  // The ranges of all written entries are reported.
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  ssdFile_->appendCachedRanges(fileName_.id(), 0, 2 * kSsdSize, ranges);
+  EXPECT_EQ(stats.entriesWritten, ranges.size());
+  uint64_t cachedBytes = 0;
+  for (auto& [begin, end] : ranges) {
+    cachedBytes += end - begin;
+  }
+  EXPECT_EQ(stats.bytesWritten, cachedBytes);
+  ranges.clear();
+  ssdFile_->appendCachedRanges(fileName_.id() + 1, 0, kSsdSize, ranges);
+  EXPECT_TRUE(ranges.empty());
+}
+
+TEST_F(SsdFileTest, checkFileSizeAfterRecovery) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  constexpr uint64_t kFileSize = 100 * kMB;
+  initializeCache(128 * kMB, kSsdSize, false, kMB);
+  ssdFile_->checkFileSize(fileName_.id(), kFileSize);
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  const auto numEntries = pins.size();
+  pins.clear();
+  cache_->clear();
+  ssdFile_->checkpoint(true);
+
+  // Reopens the file from the checkpoint. The recovered entries are kept while
+  // the source file has the recorded size.
+  ssdFile_ = std::make_unique<SsdFile>(
+      fmt::format("{}/ssdtest", tempDirectory_->path),
+      0, // shardId
+      kSsdSize / SsdFile::kRegionSize,
+      kMB);
+  ssdFile_->checkFileSize(fileName_.id(), kFileSize);
+  EXPECT_FALSE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  readAndCheckPins(pins);
+  pins.clear();
+
+  // A different size means that the file was changed and its entries are gone.
+  ssdFile_->checkFileSize(fileName_.id(), kFileSize + 1);
+  EXPECT_TRUE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(numEntries, stats.entriesInvalidated);
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
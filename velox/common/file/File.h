@@ -30,6 +30,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <functional>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -44,6 +45,19 @@ namespace facebook::velox {
 // A read-only file.  All methods in this object should be thread safe.
 class ReadFile {
  public:
+  // Expected time of a read request: a fixed latency plus the transfer at
+  // 'bytesPerUs'.
+  struct ReadCost {
+    double latencyUs;
+    double bytesPerUs;
+
+    // Returns the gap between two ranges below which reading the gap takes
+    // less time than a separate request.
+    uint64_t breakEvenGap() const {
+      return latencyUs * bytesPerUs;
+    }
+  };
+
   struct Segment {
     // offset in the file to start reading from.
     uint64_t offset;
@@ -151,6 +165,14 @@ class ReadFile {
   //
   virtual uint64_t getNaturalReadSize() const = 0;
 
+  // Returns the expected cost of a read, published by the storage or learned
+  // from past reads. Readers coalesce nearby ranges so as to minimize the
+  // total time. std::nullopt means unknown, in which case readers coalesce
+  // with fixed distances.
+  virtual std::optional<ReadCost> readCost() const {
+    return std::nullopt;
+  }
+
  protected:
   mutable std::atomic<uint64_t> bytesRead_ = 0;
 };
@@ -25,6 +25,9 @@ namespace facebook::velox {
 class Config;
 class ReadFile;
 class WriteFile;
+namespace memory {
+class MemoryPool;
+}
 } // namespace facebook::velox
 
 namespace facebook::velox::filesystems {
@@ -33,6 +36,9 @@ namespace facebook::velox::filesystems {
 /// which can be easily extended to different storage systems.
 struct FileOptions {
   std::unordered_map<std::string, std::string> values;
+  /// Pool for the write buffers of file systems that buffer writes in memory,
+  /// e.g. S3. If nullptr, the file system uses its own pool.
+  memory::MemoryPool* pool{nullptr};
 };
 
 /// An abstract FileSystem
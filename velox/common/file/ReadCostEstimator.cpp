@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ReadCostEstimator.h"
+
+#include <algorithm>
+
+namespace facebook::velox {
+
+namespace {
+// Size of the larger of the two pseudo reads that make up the prior.
+constexpr double kPriorBytes = 1 << 20;
+} // namespace
+
+ReadCostEstimator::ReadCostEstimator(
+    ReadFile::ReadCost prior,
+    double priorWeight,
+    double decay)
+    : prior_(prior), decay_(decay) {
+  // The prior is a line through an empty read and a read of kPriorBytes.
+  addLocked(0, prior.latencyUs, priorWeight / 2);
+  addLocked(
+      kPriorBytes,
+      prior.latencyUs + kPriorBytes / prior.bytesPerUs,
+      priorWeight / 2);
+}
+
+void ReadCostEstimator::record(
+    uint64_t bytes,
+    std::chrono::microseconds time) {
+  std::lock_guard<std::mutex> l(mutex_);
+  addLocked(bytes, time.count(), 1);
+}
+
+void ReadCostEstimator::addLocked(double bytes, double us, double weight) {
+  weight_ = weight_ * decay_ + weight;
+  sumBytes_ = sumBytes_ * decay_ + weight * bytes;
+  sumUs_ = sumUs_ * decay_ + weight * us;
+  sumBytesSquared_ = sumBytesSquared_ * decay_ + weight * bytes * bytes;
+  sumBytesUs_ = sumBytesUs_ * decay_ + weight * bytes * us;
+}
+
+ReadFile::ReadCost ReadCostEstimator::estimate() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const double denominator = weight_ * sumBytesSquared_ - sumBytes_ * sumBytes_;
+  if (denominator <= 0) {
+    return prior_;
+  }
+  // Microseconds per byte.
+  const double slope =
+      (weight_ * sumBytesUs_ - sumBytes_ * sumUs_) / denominator;
+  if (slope <= 0) {
+    return prior_;
+  }
+  const double latency = std::max(0.0, (sumUs_ - slope * sumBytes_) / weight_);
+  return {latency, 1 / slope};
+}
+
+} // namespace facebook::velox
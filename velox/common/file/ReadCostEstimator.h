@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// Learns the latency and bandwidth of reads from a storage by fitting
+/// time = latency + bytes / bandwidth to the completed reads. The fit is a
+/// least squares line over exponentially decaying sums, so that it follows
+/// the recent behavior. It starts from 'prior', which counts as
+/// 'priorWeight' reads and decays like them. Thread safe.
+class ReadCostEstimator {
+ public:
+  explicit ReadCostEstimator(
+      ReadFile::ReadCost prior,
+      double priorWeight = 10,
+      double decay = 0.99);
+
+  /// Records a read of 'bytes' that took 'time'.
+  void record(uint64_t bytes, std::chrono::microseconds time);
+
+  /// Returns the current estimate. This is 'prior' if the reads so far do not
+  /// give a positive bandwidth.
+  ReadFile::ReadCost estimate() const;
+
+ private:
+  // Adds a sample of weight 'weight' after decaying the earlier ones.
+  void addLocked(double bytes, double us, double weight);
+
+  const ReadFile::ReadCost prior_;
+  const double decay_;
+
+  mutable std::mutex mutex_;
+  double weight_{0};
+  double sumBytes_{0};
+  double sumUs_{0};
+  double sumBytesSquared_{0};
+  double sumBytesUs_{0};
+};
+
+} // namespace facebook::velox
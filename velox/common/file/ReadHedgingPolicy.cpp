@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ReadHedgingPolicy.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox {
+
+void ReadHedgingPolicy::recordRead() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numReads_;
+}
+
+void ReadHedgingPolicy::recordLatency(std::chrono::microseconds latency) {
+  const uint64_t usec = std::max<int64_t>(1, latency.count());
+  const auto bucket = std::min<int32_t>(
+      kNumBuckets - 1, 63 - bits::countLeadingZeros(usec));
+  std::lock_guard<std::mutex> l(mutex_);
+  ++buckets_[bucket];
+  ++numSamples_;
+  if (++numSinceDecay_ < kDecayInterval) {
+    return;
+  }
+  numSinceDecay_ = 0;
+  numSamples_ = 0;
+  for (auto& count : buckets_) {
+    count /= 2;
+    numSamples_ += count;
+  }
+}
+
+std::optional<std::chrono::microseconds> ReadHedgingPolicy::hedgeDelay()
+    const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < minSamples_ || numSamples_ == 0) {
+    return std::nullopt;
+  }
+  const double target = percentile_ * numSamples_;
+  uint64_t cumulative = 0;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    if (buckets_[i] == 0 || cumulative + buckets_[i] < target) {
+      cumulative += buckets_[i];
+      continue;
+    }
+    // Interpolates linearly inside the bucket.
+    const double fraction = (target - cumulative) / buckets_[i];
+    const uint64_t lower = 1UL << i;
+    return std::chrono::microseconds(
+        lower + static_cast<uint64_t>(fraction * lower));
+  }
+  return std::chrono::microseconds(1UL << (kNumBuckets - 1));
+}
+
+bool ReadHedgingPolicy::tryHedge() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numHedges_ + 1 > budget_ * numReads_) {
+    return false;
+  }
+  ++numHedges_;
+  return true;
+}
+
+} // namespace facebook::velox
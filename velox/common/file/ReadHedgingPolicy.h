@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace facebook::velox {
+
+/// Decides when to issue a duplicate of a slow read from an object store. The
+/// latencies of completed reads are kept in a histogram of power of 2
+/// microsecond buckets whose counts are halved every 'kDecayInterval'
+/// samples, so that it follows recent behavior. A read that has not finished
+/// by the 'percentile' latency is hedged, as long as the hedges stay within
+/// 'budget' times the reads. Thread safe.
+class ReadHedgingPolicy {
+ public:
+  static constexpr int32_t kNumBuckets = 32;
+  static constexpr uint64_t kDecayInterval = 1'000;
+
+  /// 'budget' is the maximum number of hedges per read, e.g. 0.05 for at
+  /// most 5% extra requests. No read is hedged before 'minSamples'
+  /// latencies are recorded.
+  explicit ReadHedgingPolicy(
+      double budget,
+      double percentile = 0.95,
+      uint64_t minSamples = 100)
+      : budget_(budget), percentile_(percentile), minSamples_(minSamples) {}
+
+  /// Counts the start of a read.
+  void recordRead();
+
+  /// Records the latency of a finished read.
+  void recordLatency(std::chrono::microseconds latency);
+
+  /// Returns the time after which an unfinished read should be hedged, or
+  /// std::nullopt if there are too few samples.
+  std::optional<std::chrono::microseconds> hedgeDelay() const;
+
+  /// Returns true and counts a hedge if the budget allows one more.
+  bool tryHedge();
+
+  uint64_t numReads() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numReads_;
+  }
+
+  uint64_t numHedges() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numHedges_;
+  }
+
+ private:
+  const double budget_;
+  const double percentile_;
+  const uint64_t minSamples_;
+
+  mutable std::mutex mutex_;
+  // Bucket i counts the latencies in [2^i, 2^(i+1)) microseconds.
+  std::array<uint64_t, kNumBuckets> buckets_{};
+  // Sum of 'buckets_'.
+  uint64_t numSamples_{0};
+  uint64_t numSinceDecay_{0};
+  uint64_t numReads_{0};
+  uint64_t numHedges_{0};
+};
+
+} // namespace facebook::velox
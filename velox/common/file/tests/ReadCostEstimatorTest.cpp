@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ReadCostEstimator.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+
+TEST(ReadCostEstimatorTest, learn) {
+  // 20ms and 100MB/s, like an object store.
+  ReadCostEstimator estimator({20'000, 100});
+  auto cost = estimator.estimate();
+  EXPECT_NEAR(20'000, cost.latencyUs, 1);
+  EXPECT_NEAR(100, cost.bytesPerUs, 0.01);
+  EXPECT_NEAR(2'000'000, cost.breakEvenGap(), 1'000);
+
+  // Reads from a fast local device: 100us and 2GB/s. The estimate follows
+  // the reads once the prior has decayed.
+  for (auto i = 0; i < 2'000; ++i) {
+    const uint64_t bytes = (i % 16 + 1) * 64 << 10;
+    estimator.record(
+        bytes, std::chrono::microseconds(100 + bytes / 2'000));
+  }
+  cost = estimator.estimate();
+  EXPECT_NEAR(100, cost.latencyUs, 5);
+  EXPECT_NEAR(2'000, cost.bytesPerUs, 20);
+  EXPECT_NEAR(200'000, cost.breakEvenGap(), 10'000);
+}
+
+TEST(ReadCostEstimatorTest, noBandwidth) {
+  ReadCostEstimator estimator({1'000, 500}, 0.001);
+  // Larger reads that are not slower give no positive bandwidth.
+  for (auto i = 0; i < 100; ++i) {
+    estimator.record(i * 1'000, std::chrono::microseconds(1'000 - i));
+  }
+  const auto cost = estimator.estimate();
+  EXPECT_EQ(1'000, cost.latencyUs);
+  EXPECT_EQ(500, cost.bytesPerUs);
+}
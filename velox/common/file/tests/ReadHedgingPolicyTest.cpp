@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/file/ReadHedgingPolicy.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+
+TEST(ReadHedgingPolicyTest, hedgeDelay) {
+  ReadHedgingPolicy policy(0.05, 0.95, 100);
+  for (auto i = 0; i < 90; ++i) {
+    policy.recordLatency(std::chrono::microseconds(1'000));
+  }
+  // Too few samples.
+  EXPECT_FALSE(policy.hedgeDelay().has_value());
+
+  // 95 reads of ~1ms and 5 of ~100ms. The p95 is in the 1ms bucket.
+  for (auto i = 0; i < 5; ++i) {
+    policy.recordLatency(std::chrono::microseconds(1'000));
+  }
+  for (auto i = 0; i < 5; ++i) {
+    policy.recordLatency(std::chrono::microseconds(100'000));
+  }
+  auto delay = policy.hedgeDelay();
+  ASSERT_TRUE(delay.has_value());
+  EXPECT_LE(512, delay->count());
+  EXPECT_GE(1'024, delay->count());
+
+  // After many slow reads, the old samples decay and the p95 moves to the
+  // 100ms bucket.
+  for (auto i = 0; i < 3 * ReadHedgingPolicy::kDecayInterval; ++i) {
+    policy.recordLatency(std::chrono::microseconds(100'000));
+  }
+  delay = policy.hedgeDelay();
+  ASSERT_TRUE(delay.has_value());
+  EXPECT_LE(65'536, delay->count());
+  EXPECT_GE(131'072, delay->count());
+}
+
+TEST(ReadHedgingPolicyTest, budget) {
+  ReadHedgingPolicy policy(0.05);
+  EXPECT_FALSE(policy.tryHedge());
+  for (auto i = 0; i < 100; ++i) {
+    policy.recordRead();
+  }
+  int32_t numHedges = 0;
+  while (policy.tryHedge()) {
+    ++numHedges;
+  }
+  EXPECT_EQ(5, numHedges);
+  EXPECT_EQ(5, policy.numHedges());
+  for (auto i = 0; i < 20; ++i) {
+    policy.recordRead();
+  }
+  EXPECT_TRUE(policy.tryHedge());
+  EXPECT_FALSE(policy.tryHedge());
+
+  ReadHedgingPolicy disabled(0);
+  disabled.recordRead();
+  EXPECT_FALSE(disabled.tryHedge());
+}
@@ -18,6 +18,7 @@
 #include <exception>
 #include <sstream>
 #include "velox/common/base/IOUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/hyperloglog/BiasCorrection.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
@@ -143,6 +144,26 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(const uint64_t* hashes, int32_t numHashes) {
+  constexpr int32_t kBatch = 64;
+  uint32_t indices[kBatch];
+  int8_t values[kBatch];
+  for (auto start = 0; start < numHashes; start += kBatch) {
+    const auto size = std::min(kBatch, numHashes - start);
+    for (auto i = 0; i < size; ++i) {
+      indices[i] = computeIndex(hashes[start + i], indexBitLength_);
+      values[i] = computeValue(hashes[start + i], indexBitLength_);
+    }
+    for (auto i = 0; i < size; ++i) {
+      // Once many values are seen, most values are not above the delta of
+      // their bucket and need no update.
+      if (values[i] - baseline_ > getDelta(indices[i])) {
+        insert(indices[i], values[i]);
+      }
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
@@ -568,6 +589,11 @@ void DenseHll::mergeWith(
     int16_t otherOverflows,
     const uint16_t* otherOverflowBuckets,
     const int8_t* otherOverflowValues) {
+  if (baseline_ == otherBaseline && overflows_ == 0 && otherOverflows == 0) {
+    mergeDeltas(otherDeltas);
+    return;
+  }
+
   int8_t newBaseline = std::max(baseline_, otherBaseline);
   int32_t baselineCount = 0;
 
@@ -623,6 +649,40 @@ void DenseHll::mergeWith(
   adjustBaselineIfNeeded();
 }
 
+void DenseHll::mergeDeltas(const int8_t* otherDeltas) {
+  using Batch = xsimd::batch<uint8_t>;
+  constexpr uint8_t kHighMask = kBucketMask << kBitsPerBucket;
+  auto* deltas = reinterpret_cast<uint8_t*>(deltas_.data());
+  auto* other = reinterpret_cast<const uint8_t*>(otherDeltas);
+  const int32_t numBytes = deltas_.size();
+  int32_t i = 0;
+  // The buckets in the low and high 4 bits of each byte are compared
+  // separately. Masking leaves each bucket in place so the two maxes can be
+  // or'ed back together.
+  const auto lowMask = Batch::broadcast(kBucketMask);
+  const auto highMask = Batch::broadcast(kHighMask);
+  for (; i + Batch::size <= numBytes; i += Batch::size) {
+    const auto left = Batch::load_unaligned(deltas + i);
+    const auto right = Batch::load_unaligned(other + i);
+    const auto merged = xsimd::max(left & lowMask, right & lowMask) |
+        xsimd::max(left & highMask, right & highMask);
+    merged.store_unaligned(deltas + i);
+  }
+  for (; i < numBytes; ++i) {
+    deltas[i] =
+        std::max<uint8_t>(deltas[i] & kBucketMask, other[i] & kBucketMask) |
+        std::max<uint8_t>(deltas[i] & kHighMask, other[i] & kHighMask);
+  }
+
+  int32_t baselineCount = 0;
+  for (i = 0; i < numBytes; ++i) {
+    baselineCount +=
+        ((deltas[i] & kBucketMask) == 0) + ((deltas[i] & kHighMask) == 0);
+  }
+  baselineCount_ = baselineCount;
+  adjustBaselineIfNeeded();
+}
+
 int8_t
 DenseHll::updateOverflow(int32_t index, int overflowEntry, int8_t delta) {
   if (delta > kMaxDelta) {
@@ -48,6 +48,11 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Inserts 'numHashes' hashes. Faster than calling insertHash for each hash
+  /// because the buckets and values are computed for a batch of hashes at a
+  /// time and values that do not raise their bucket are skipped inline.
+  void insertHashes(const uint64_t* hashes, int32_t numHashes);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -109,6 +114,10 @@ class DenseHll {
 
   void removeOverflow(int overflowEntry);
 
+  /// Merges the deltas of an HLL with the same baseline and no overflows by
+  /// taking the max of each bucket, a vector of buckets at a time.
+  void mergeDeltas(const int8_t* otherDeltas);
+
   void mergeWith(
       int8_t otherBaseline,
       const int8_t* otherDeltas,
@@ -192,6 +192,26 @@ TEST_P(DenseHllTest, canDeserialize) {
   }
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  for (auto size : {1, 63, 64, 1'000, 100'000}) {
+    std::vector<uint64_t> hashes(size);
+    for (auto i = 0; i < size; ++i) {
+      hashes[i] = hashOne(i);
+    }
+    DenseHll expected{indexBitLength, &allocator_};
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+    DenseHll hll{indexBitLength, &allocator_};
+    hll.insertHashes(hashes.data(), size);
+
+    ASSERT_EQ(hll.cardinality(), expected.cardinality());
+    ASSERT_EQ(serialize(hll), serialize(expected));
+  }
+}
+
 TEST_P(DenseHllTest, mergeWith) {
   int8_t indexBitLength = GetParam();
 
@@ -113,6 +113,7 @@ class ByteStream {
     ranges_ = std::move(ranges);
     current_ = &ranges_[0];
     lastRangeEnd_ = ranges_.back().size;
+    inputOwner_.reset();
   }
 
   void setRange(ByteRange range) {
@@ -120,6 +121,32 @@ class ByteStream {
     ranges_[0] = range;
     current_ = ranges_.data();
     lastRangeEnd_ = ranges_[0].size;
+    inputOwner_.reset();
+  }
+
+  /// Sets the owner of the memory of the input ranges. A reader that holds a
+  /// reference to 'owner' may use the memory after 'this' is gone, e.g. to
+  /// make vectors over the input without copying.
+  void setInputOwner(std::shared_ptr<folly::IOBuf> owner) {
+    inputOwner_ = std::move(owner);
+  }
+
+  /// The owner of the input memory or nullptr if the memory may be used only
+  /// while reading.
+  const std::shared_ptr<folly::IOBuf>& inputOwner() const {
+    return inputOwner_;
+  }
+
+  /// Returns the next 'size' bytes and skips them if they are all in the
+  /// current range. Otherwise returns nullptr and does not change the
+  /// position.
+  const uint8_t* nextContiguous(int32_t size) {
+    if (current_->position + size > current_->size) {
+      return nullptr;
+    }
+    auto* data = current_->buffer + current_->position;
+    current_->position += size;
+    return data;
   }
 
   const std::vector<ByteRange>& ranges() const {
@@ -379,6 +406,9 @@ class ByteStream {
   // and the last may be partly full. The position in the last range
   // is not necessarily the the end if there has been a seek.
   int32_t lastRangeEnd_{0};
+
+  // Keeps the memory of the input ranges alive. See setInputOwner().
+  std::shared_ptr<folly::IOBuf> inputOwner_;
 };
 
 template <>
@@ -277,6 +277,12 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  // Returns the number of free blocks. Many small free blocks with a large
+  // freeSpace() mean the memory is fragmented.
+  uint64_t numFreeBlocks() const {
+    return numFree_;
+  }
+
   // Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear() {
     numFree_ = 0;
@@ -32,6 +32,8 @@ MemoryManager::MemoryManager(const Options& options)
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
+      reservationBatchBytes_(options.reservationBatchBytes),
+      retainedReservationBytes_(options.retainedReservationBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       defaultRoot_{std::make_shared<MemoryPoolImpl>(
           this,
@@ -51,6 +53,8 @@ MemoryManager::MemoryManager(const Options& options)
               .debugEnabled = options.debugEnabled})} {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_USER_CHECK_GE(capacity_, 0);
+  VELOX_USER_CHECK_GE(reservationBatchBytes_, 0);
+  VELOX_USER_CHECK_GE(retainedReservationBytes_, 0);
   if (arbitrator_ != nullptr) {
     VELOX_CHECK_EQ(arbitrator_->capacity(), capacity_);
   }
@@ -66,6 +70,11 @@ MemoryManager::MemoryManager(const Options& options)
 }
 
 MemoryManager::~MemoryManager() {
+  // The shared leaf pools outlive this destructor. Returns their unused
+  // reservation batches for the leak check.
+  for (auto& pool : sharedLeafPools_) {
+    static_cast<MemoryPoolImpl*>(pool.get())->releaseManagerReservation();
+  }
   if (checkUsageLeak_) {
     VELOX_CHECK_EQ(
         numPools(),
@@ -89,6 +89,21 @@ class IMemoryManager {
     /// Specifies the memory arbitrator
     std::function<std::unique_ptr<MemoryArbitrator>()> arbitratorFactory{
         []() { return MemoryArbitrator::create({}); }};
+
+    /// If not zero, each leaf memory pool reserves memory from the memory
+    /// manager in batches of this many bytes and serves its allocations from
+    /// the batch without updating the total usage of the memory manager,
+    /// which is shared by all the threads. The total usage then includes up
+    /// to twice this many unused bytes per leaf memory pool.
+    int64_t reservationBatchBytes{0};
+
+    /// If not zero, a leaf memory pool whose usage drops keeps up to this many
+    /// unused reserved bytes instead of returning them to its parents, as long
+    /// as it has any usage. This avoids updating all the pools up to the root
+    /// each time the usage of a leaf goes over a reservation quantum and back.
+    /// The reserved bytes of the parents then include up to this many unused
+    /// bytes per leaf memory pool.
+    int64_t retainedReservationBytes{0};
   };
 
   virtual ~IMemoryManager() = default;
@@ -211,6 +226,18 @@ class MemoryManager final : public IMemoryManager {
   bool reserve(int64_t size) final;
   void release(int64_t size) final;
 
+  /// Returns the bytes a leaf memory pool reserves at a time from 'this' or 0
+  /// if each allocation is reserved separately.
+  int64_t reservationBatchBytes() const {
+    return reservationBatchBytes_;
+  }
+
+  /// Returns the unused reserved bytes a leaf memory pool keeps when its usage
+  /// drops.
+  int64_t retainedReservationBytes() const {
+    return retainedReservationBytes_;
+  }
+
   size_t numPools() const final;
 
   MemoryAllocator& allocator();
@@ -242,6 +269,8 @@ class MemoryManager final : public IMemoryManager {
   const uint16_t alignment_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const int64_t reservationBatchBytes_;
+  const int64_t retainedReservationBytes_;
   // The destruction callback set for the allocated  root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
@@ -85,6 +85,13 @@ class MemoryArbitrator {
     /// same query on all the workers instead of a random victim query which
     /// happens to trigger the failed memory arbitration.
     bool retryArbitrationFailure{true};
+
+    /// If true, a candidate of a lower arbitration priority than the requestor
+    /// is reclaimed of all its reclaimable memory instead of just the request
+    /// size. This pauses and fully spills a low priority query once, rather
+    /// than shrinking it again on each request of a high priority query. See
+    /// MemoryPool::setArbitrationPriority().
+    bool reclaimLowerPriorityFully{false};
   };
   static std::unique_ptr<MemoryArbitrator> create(const Config& config);
 
@@ -165,13 +172,15 @@ class MemoryArbitrator {
         initMemoryPoolCapacity_(config.initMemoryPoolCapacity),
         minMemoryPoolCapacityTransferSize_(
             config.minMemoryPoolCapacityTransferSize),
-        retryArbitrationFailure_(config.retryArbitrationFailure) {}
+        retryArbitrationFailure_(config.retryArbitrationFailure),
+        reclaimLowerPriorityFully_(config.reclaimLowerPriorityFully) {}
 
   const Kind kind_;
   const uint64_t capacity_;
   const uint64_t initMemoryPoolCapacity_;
   const uint64_t minMemoryPoolCapacityTransferSize_;
   const bool retryArbitrationFailure_;
+  const bool reclaimLowerPriorityFully_;
 };
 
 std::ostream& operator<<(std::ostream& out, const MemoryArbitrator::Kind& kind);
@@ -372,7 +372,9 @@ MemoryPoolImpl::MemoryPoolImpl(
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
       // actually used memory arbitration policy.
-      capacity_(parent_ != nullptr ? kMaxMemory : 0) {
+      capacity_(parent_ != nullptr ? kMaxMemory : 0),
+      retainedReservationBytes_(
+          isLeaf() ? manager_->retainedReservationBytes() : 0) {
   VELOX_CHECK(options.threadSafe || isLeaf());
   // NOTE: we shall only set reclaimer in a child pool if its parent has also
   // set. Otherwise. it should be mis-configured.
@@ -386,6 +388,7 @@ MemoryPoolImpl::MemoryPoolImpl(
 
 MemoryPoolImpl::~MemoryPoolImpl() {
   DEBUG_LEAK_CHECK();
+  releaseManagerReservation();
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
@@ -624,7 +627,7 @@ void MemoryPoolImpl::reserve(uint64_t size, bool reserveOnly) {
   if (reserveOnly) {
     return;
   }
-  if (FOLLY_UNLIKELY(!manager_->reserve(size))) {
+  if (FOLLY_UNLIKELY(!reserveFromManager(size))) {
     // NOTE: If we can make the reserve and release a single transaction we
     // would have more accurate aggregates in intermediate states. However, this
     // is low-pri because we can only have inflated aggregates, and be on the
@@ -773,7 +776,7 @@ void MemoryPoolImpl::release() {
 
 void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   if (!releaseOnly) {
-    manager_->release(size);
+    releaseToManager(size);
   }
   if (FOLLY_LIKELY(trackUsage_)) {
     if (FOLLY_LIKELY(threadSafe_)) {
@@ -784,6 +787,51 @@ void MemoryPoolImpl::release(uint64_t size, bool releaseOnly) {
   }
 }
 
+bool MemoryPoolImpl::reserveFromManager(uint64_t size) {
+  const int64_t batchBytes = manager_->reservationBatchBytes();
+  if (batchBytes == 0) {
+    return manager_->reserve(size);
+  }
+  const int64_t bytes = size;
+  int64_t available = managerReservationBytes_;
+  while (available >= bytes) {
+    if (managerReservationBytes_.compare_exchange_weak(
+            available, available - bytes)) {
+      return true;
+    }
+  }
+  if (manager_->reserve(bytes + batchBytes)) {
+    managerReservationBytes_ += batchBytes;
+    return true;
+  }
+  // Keeps 'size' charged like MemoryManager::reserve() does on failure.
+  manager_->release(batchBytes);
+  return false;
+}
+
+void MemoryPoolImpl::releaseToManager(uint64_t size) {
+  const int64_t batchBytes = manager_->reservationBatchBytes();
+  if (batchBytes == 0) {
+    manager_->release(size);
+    return;
+  }
+  int64_t available = managerReservationBytes_ += size;
+  while (available > 2 * batchBytes) {
+    if (managerReservationBytes_.compare_exchange_weak(
+            available, batchBytes)) {
+      manager_->release(available - batchBytes);
+      return;
+    }
+  }
+}
+
+void MemoryPoolImpl::releaseManagerReservation() {
+  const auto bytes = managerReservationBytes_.exchange(0);
+  if (bytes > 0) {
+    manager_->release(bytes);
+  }
+}
+
 void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   VELOX_CHECK(isLeaf());
   VELOX_DCHECK_NOT_NULL(parent_);
@@ -803,7 +851,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = retainedSizeLocked(newCap);
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -410,6 +410,25 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// Returns true if this memory pool has been aborted.
   virtual bool aborted() const = 0;
 
+  /// Sets the priority and the deadline of the query of a root memory pool
+  /// for memory arbitration. The memory arbitrator reclaims memory from and
+  /// aborts the pools of a lower priority first. Among pools of the same
+  /// priority, the ones with a later deadline go first. 'deadlineMs' is in ms
+  /// since epoch. 0 means no deadline.
+  void setArbitrationPriority(int32_t priority, uint64_t deadlineMs = 0) {
+    VELOX_CHECK(isRoot(), "Only a root memory pool has arbitration priority");
+    arbitrationPriority_ = priority;
+    arbitrationDeadlineMs_ = deadlineMs;
+  }
+
+  int32_t arbitrationPriority() const {
+    return arbitrationPriority_;
+  }
+
+  uint64_t arbitrationDeadlineMs() const {
+    return arbitrationDeadlineMs_;
+  }
+
   /// The memory pool's execution stats.
   struct Stats {
     /// The current memory usage.
@@ -514,6 +533,9 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// reclaimer. We process a query abort request from the root memory pool.
   std::atomic<bool> aborted_{false};
 
+  std::atomic<int32_t> arbitrationPriority_{0};
+  std::atomic<uint64_t> arbitrationDeadlineMs_{0};
+
   mutable folly::SharedMutex poolMutex_;
   // NOTE: we use raw pointer instead of weak pointer here to minimize
   // visitChildren() cost as we don't have to upgrade the weak pointer and copy
@@ -645,6 +667,10 @@ class MemoryPoolImpl : public MemoryPool {
     allocator_ = allocator;
   }
 
+  /// Returns the unused part of the reservation batch of 'this' to the memory
+  /// manager. This is done at destruction.
+  void releaseManagerReservation();
+
  private:
   FOLLY_ALWAYS_INLINE static MemoryPoolImpl* toImpl(MemoryPool* pool) {
     return static_cast<MemoryPoolImpl*>(pool);
@@ -688,6 +714,22 @@ class MemoryPoolImpl : public MemoryPool {
     return quantizedSize(size + delta) - size;
   }
 
+  // Returns the reservation that a leaf keeps when its usage drops to 'size'.
+  // While there is any usage, keeps up to 'retainedReservationBytes_' unused
+  // bytes above the quantized usage so that the usage moving back and forth
+  // over a quantum boundary does not update the parents each time.
+  FOLLY_ALWAYS_INLINE int64_t retainedSizeLocked(int64_t size) const {
+    const int64_t quantized = quantizedSize(size);
+    if (FOLLY_LIKELY(retainedReservationBytes_ == 0) || size == 0) {
+      return quantized;
+    }
+    return std::max(
+        quantized,
+        std::min<int64_t>(
+            reservationBytes_,
+            quantizedSize(size + retainedReservationBytes_)));
+  }
+
   // Reserve memory for a new allocation/reservation with specified 'size'.
   // 'reserveThreadSafe' processes the memory reservation with mutex lock
   // protection to prevent concurrent updates to the same leaf memory pool.
@@ -781,6 +823,17 @@ class MemoryPoolImpl : public MemoryPool {
 
   void releaseThreadSafe(uint64_t size, bool releaseOnly);
 
+  // Charges 'size' bytes to the total usage of 'manager_'. Returns false if
+  // this exceeds the capacity of 'manager_'. The bytes are charged even on
+  // failure and must be returned by releaseFromManager(). If the manager has a
+  // reservation batch size, takes the bytes from 'managerReservationBytes_'
+  // and reserves another batch from the manager when this runs out.
+  bool reserveFromManager(uint64_t size);
+
+  // Returns 'size' bytes charged by reserveFromManager(). Keeps up to two
+  // batches in 'managerReservationBytes_'.
+  void releaseToManager(uint64_t size);
+
   FOLLY_ALWAYS_INLINE void releaseNonThreadSafe(
       uint64_t size,
       bool releaseOnly) {
@@ -799,7 +852,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = retainedSizeLocked(newCap);
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -958,6 +1011,13 @@ class MemoryPoolImpl : public MemoryPool {
   tsan_atomic<int64_t> peakBytes_{0};
   tsan_atomic<int64_t> cumulativeBytes_{0};
 
+  // Unused reserved bytes a leaf keeps on release. See retainedSizeLocked().
+  const int64_t retainedReservationBytes_;
+
+  // Bytes charged to 'manager_' which are not used by an allocation of a leaf
+  // pool. Updated without locks by concurrent allocations.
+  std::atomic<int64_t> managerReservationBytes_{0};
+
   // Stats counters.
   // The number of memory allocations.
   std::atomic<uint64_t> numAllocs_{0};
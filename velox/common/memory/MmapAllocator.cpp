@@ -25,6 +25,8 @@ namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      useHugePages_(options.useHugePages),
+      numaNode_(options.numaNode),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -33,8 +35,17 @@ MmapAllocator::MmapAllocator(const Options& options)
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
+  VELOX_CHECK(
+      numaNode_ == kNoNumaNode ||
+          (numaNode_ >= 0 && numaNode_ < numNumaNodes()),
+      "Invalid NUMA node {}",
+      numaNode_);
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size,
+        size,
+        useHugePages_ && size >= options.hugePageMinSizeClass,
+        numaNode_));
   }
 
   if (useMmapArena_) {
@@ -42,7 +53,9 @@ MmapAllocator::MmapAllocator(const Options& options)
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
     managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes),
+        useHugePages_,
+        numaNode_);
   }
 }
 
@@ -329,16 +342,10 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(numPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(numPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapAnonymous(
+          AllocationTraits::pageBytes(numPages), useHugePages_, numaNode_);
     }
   }
-  // TODO: add handling of MAP_FAILED.
   if (data == nullptr) {
     VELOX_MEM_LOG(ERROR) << "Mmap failed with " << numPages
                          << " pages, use MmapArena "
@@ -450,10 +457,15 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useHugePages,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
+      useHugePages_(useHugePages),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
       mappedFreeLookup_((capacity_ / kPagesPerLookupBit / 64) + kSimdTail),
@@ -464,14 +476,8 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
       0,
       "Sizeclass {} must have a multiple of 64 capacity",
       unitSize_);
-  void* ptr = mmap(
-      nullptr,
-      AllocationTraits::pageBytes(capacity_ * unitSize_),
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  if (ptr == MAP_FAILED || ptr == nullptr) {
+  void* ptr = mmapAnonymous(byteSize_, useHugePages_, numaNode);
+  if (ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory "
         "mmap failed with {} for sizeClass {}",
@@ -896,11 +902,33 @@ bool MmapAllocator::useMalloc(uint64_t bytes) {
 std::string MmapAllocator::toString() const {
   std::stringstream out;
   out << "[Memory capacity " << capacity_ << " allocated " << numAllocated_
-      << " mapped " << numMapped_ << " external mapped " << numExternalMapped_
-      << std::endl;
+      << " mapped " << numMapped_ << " external mapped " << numExternalMapped_;
+  if (numaNode_ != kNoNumaNode) {
+    out << " NUMA node " << numaNode_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
+  if (useHugePages_) {
+    std::vector<std::pair<const void*, uint64_t>> ranges;
+    uint64_t rangeBytes = 0;
+    for (auto& sizeClass : sizeClasses_) {
+      if (sizeClass->useHugePages()) {
+        ranges.emplace_back(sizeClass->address(), sizeClass->byteSize());
+        rangeBytes += sizeClass->byteSize();
+      }
+    }
+    if (useMmapArena_) {
+      std::lock_guard<std::mutex> l(arenaMutex_);
+      for (const auto& [address, arena] : managedArenas_->arenas()) {
+        ranges.emplace_back(arena->address(), arena->byteSize());
+        rangeBytes += arena->byteSize();
+      }
+    }
+    out << "[huge pages " << (hugePageBytes(ranges) >> 20) << "MB in "
+        << (rangeBytes >> 20) << "MB of huge page ranges]" << std::endl;
+  }
   out << "]" << std::endl;
   return out.str();
 }
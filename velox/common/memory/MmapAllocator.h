@@ -75,6 +75,22 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the size classes of at least 'hugePageMinSizeClass' machine
+    /// pages and the MmapArenas are backed by transparent huge pages where
+    /// the kernel allows. This reduces TLB misses for large working sets,
+    /// e.g. hash tables.
+    bool useHugePages = false;
+
+    /// The smallest size class that is backed by huge pages if
+    /// 'useHugePages' is true. The smaller size classes are more often
+    /// advised away in machine page units, which breaks up huge pages.
+    MachinePageCount hugePageMinSizeClass = 64;
+
+    /// If not kNoNumaNode, the memory of 'this' is preferably taken from
+    /// this NUMA node. A process can make an allocator per node and give the
+    /// pools of the drivers running on a node the allocator of that node.
+    int32_t numaNode = kNoNumaNode;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -89,6 +105,11 @@ class MmapAllocator : public MemoryAllocator {
     return AllocationTraits::pageBytes(capacity_);
   }
 
+  /// Returns the preferred NUMA node of the memory of 'this' or kNoNumaNode.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   bool allocateNonContiguous(
       MachinePageCount numPages,
       Allocation& out,
@@ -179,7 +200,11 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        bool useHugePages,
+        int32_t numaNode);
 
     ~SizeClass();
 
@@ -220,6 +245,18 @@ class MmapAllocator : public MemoryAllocator {
     // size class page boundary.
     bool isInRange(uint8_t* ptr) const;
 
+    const uint8_t* address() const {
+      return address_;
+    }
+
+    size_t byteSize() const {
+      return byteSize_;
+    }
+
+    bool useHugePages() const {
+      return useHugePages_;
+    }
+
     std::string toString() const;
 
    private:
@@ -287,6 +324,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size in bytes of the address range.
     const size_t byteSize_;
 
+    // True if the address range is advised to be backed by huge pages.
+    const bool useHugePages_;
+
     // Number of meaningful words in 'pageAllocated_'/'pageMapped'. The arrays
     // themselves are padded with extra zeros for SIMD access.
     const int32_t pageBitmapSize_;
@@ -365,6 +405,13 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // True if the larger size classes, the MmapArenas and the large contiguous
+  // allocations are backed by transparent huge pages.
+  const bool useHugePages_;
+
+  // The preferred NUMA node of the memory of 'this' or kNoNumaNode.
+  const int32_t numaNode_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -404,7 +451,7 @@ class MmapAllocator : public MemoryAllocator {
 
   // Allocations that are larger than largest size classes will be delegated to
   // ManagedMmapArenas, to avoid calling mmap on every allocation.
-  std::mutex arenaMutex_;
+  mutable std::mutex arenaMutex_;
   std::unique_ptr<ManagedMmapArenas> managedArenas_;
 
   Stats stats_;
@@ -17,28 +17,161 @@
 #include "velox/common/memory/MmapArena.h"
 
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#endif
+
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/memory/Memory.h"
 
 namespace facebook::velox::memory {
+
+namespace {
+void* mapRange(uint64_t bytes, bool hugePages) {
+  if (!hugePages || bytes < kHugePageBytes) {
+    void* ptr = ::mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+  // Maps an extra huge page and trims the ends so that the range starts at a
+  // huge page boundary. Otherwise the kernel can only use huge pages for the
+  // aligned middle of the range.
+  const uint64_t mappedBytes = bytes + kHugePageBytes;
+  void* ptr = ::mmap(
+      nullptr,
+      mappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (ptr == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto start = reinterpret_cast<uint64_t>(ptr);
+  const auto alignedStart = bits::roundUp(start, kHugePageBytes);
+  if (alignedStart > start) {
+    ::munmap(ptr, alignedStart - start);
+  }
+  const auto alignedEnd = alignedStart + bytes;
+  if (start + mappedBytes > alignedEnd) {
+    ::munmap(
+        reinterpret_cast<void*>(alignedEnd), start + mappedBytes - alignedEnd);
+  }
+#ifdef MADV_HUGEPAGE
+  if (::madvise(reinterpret_cast<void*>(alignedStart), bytes, MADV_HUGEPAGE) <
+      0) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 1000)
+        << "madvise(MADV_HUGEPAGE) got errno " << folly::errnoStr(errno);
+  }
+#endif
+  return reinterpret_cast<void*>(alignedStart);
+}
+
+// Sets the memory policy of the range to prefer 'numaNode'. The kernel falls
+// back to other nodes when 'numaNode' has no free memory.
+void bindToNumaNode(void* address, uint64_t bytes, int32_t numaNode) {
+#if defined(__linux__) && defined(SYS_mbind)
+  std::vector<unsigned long> nodeMask(numaNode / 64 + 1);
+  bits::setBit(reinterpret_cast<uint64_t*>(nodeMask.data()), numaNode);
+  if (::syscall(
+          SYS_mbind,
+          address,
+          bytes,
+          MPOL_PREFERRED,
+          nodeMask.data(),
+          nodeMask.size() * 64 + 1,
+          0) < 0) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 1000)
+        << "mbind to NUMA node " << numaNode << " got errno "
+        << folly::errnoStr(errno);
+  }
+#endif
+}
+} // namespace
+
+void* mmapAnonymous(uint64_t bytes, bool hugePages, int32_t numaNode) {
+  void* ptr = mapRange(bytes, hugePages);
+  if (ptr != nullptr && numaNode != kNoNumaNode) {
+    bindToNumaNode(ptr, bytes, numaNode);
+  }
+  return ptr;
+}
+
+int32_t numNumaNodes() {
+  // The online nodes are listed as ranges, e.g. '0-1'. The last number is the
+  // highest node.
+  std::ifstream online("/sys/devices/system/node/online");
+  std::string line;
+  if (!online.is_open() || !std::getline(online, line) || line.empty()) {
+    return 1;
+  }
+  const auto pos = line.find_last_of(",-");
+  const auto last = pos == std::string::npos ? line : line.substr(pos + 1);
+  try {
+    return std::stoi(last) + 1;
+  } catch (const std::exception&) {
+    return 1;
+  }
+}
+
+uint64_t hugePageBytes(
+    const std::vector<std::pair<const void*, uint64_t>>& ranges) {
+  std::ifstream smaps("/proc/self/smaps");
+  if (!smaps.is_open()) {
+    return 0;
+  }
+  uint64_t totalBytes = 0;
+  bool overlaps = false;
+  std::string line;
+  while (std::getline(smaps, line)) {
+    uint64_t begin;
+    uint64_t end;
+    // A mapping starts with a line of 'begin-end perms offset ...'.
+    if (sscanf(line.c_str(), "%" SCNx64 "-%" SCNx64 " ", &begin, &end) == 2) {
+      overlaps = false;
+      for (const auto& [address, bytes] : ranges) {
+        const auto rangeBegin = reinterpret_cast<uint64_t>(address);
+        if (begin < rangeBegin + bytes && end > rangeBegin) {
+          overlaps = true;
+          break;
+        }
+      }
+      continue;
+    }
+    uint64_t kb;
+    if (overlaps &&
+        sscanf(line.c_str(), "AnonHugePages: %" SCNu64 " kB", &kb) == 1) {
+      totalBytes += kb << 10;
+    }
+  }
+  return totalBytes;
+}
 uint64_t MmapArena::roundBytes(uint64_t bytes) {
   return bits::nextPowerOfTwo(bytes);
 }
 
-MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
+MmapArena::MmapArena(
+    size_t capacityBytes,
+    bool useHugePages,
+    int32_t numaNode)
+    : byteSize_(capacityBytes) {
   VELOX_CHECK_EQ(
       byteSize_ % kMinGrainSizeBytes,
       0,
       "Arena must have a multiple of {} bytes capacity.",
       kMinGrainSizeBytes);
-  void* ptr = mmap(
-      nullptr,
-      capacityBytes,
-      PROT_READ | PROT_WRITE,
-      MAP_PRIVATE | MAP_ANONYMOUS,
-      -1,
-      0);
-  if (ptr == MAP_FAILED || ptr == nullptr) {
+  void* ptr = mmapAnonymous(capacityBytes, useHugePages, numaNode);
+  if (ptr == nullptr) {
     VELOX_FAIL(
         "Could not allocate working memory"
         "mmap failed with errno {} with capacity bytes {}",
@@ -276,9 +409,15 @@ std::string MmapArena::toString() const {
       freeList_.size());
 }
 
-ManagedMmapArenas::ManagedMmapArenas(uint64_t singleArenaCapacity)
-    : singleArenaCapacity_(singleArenaCapacity) {
-  auto arena = std::make_shared<MmapArena>(singleArenaCapacity);
+ManagedMmapArenas::ManagedMmapArenas(
+    uint64_t singleArenaCapacity,
+    bool useHugePages,
+    int32_t numaNode)
+    : singleArenaCapacity_(singleArenaCapacity),
+      useHugePages_(useHugePages),
+      numaNode_(numaNode) {
+  auto arena = std::make_shared<MmapArena>(
+      singleArenaCapacity, useHugePages_, numaNode_);
   arenas_.emplace(reinterpret_cast<uint64_t>(arena->address()), arena);
   currentArena_ = arena;
 }
@@ -292,7 +431,8 @@ void* ManagedMmapArenas::allocate(uint64_t bytes) {
   // If first allocation fails we create a new MmapArena for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // MmapArena's capacity. No further attempts will happen.
-  auto newArena = std::make_shared<MmapArena>(singleArenaCapacity_);
+  auto newArena = std::make_shared<MmapArena>(
+      singleArenaCapacity_, useHugePages_, numaNode_);
   arenas_.emplace(reinterpret_cast<uint64_t>(newArena->address()), newArena);
   currentArena_ = newArena;
   return currentArena_->allocate(bytes);
@@ -21,11 +21,38 @@
 #include <map>
 #include <memory>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "velox/common/memory/MemoryAllocator.h"
 
 namespace facebook::velox::memory {
 
+/// Size of a transparent huge page with 4K base pages.
+constexpr uint64_t kHugePageBytes = 2 << 20;
+
+/// Denotes no preference of NUMA node for memory.
+constexpr int32_t kNoNumaNode = -1;
+
+/// Maps 'bytes' of anonymous read-write memory. If 'hugePages' is true and
+/// 'bytes' is at least kHugePageBytes, the mapping starts at a huge page
+/// boundary and is advised to be backed by transparent huge pages. If
+/// 'numaNode' is not kNoNumaNode, the memory is preferably taken from that
+/// NUMA node. Returns nullptr if the mapping fails.
+void* mmapAnonymous(
+    uint64_t bytes,
+    bool hugePages,
+    int32_t numaNode = kNoNumaNode);
+
+/// Returns the number of NUMA nodes of the host, 1 if this is not known.
+int32_t numNumaNodes();
+
+/// Returns the bytes of the mappings that overlap the [address, address +
+/// bytes) 'ranges' that are backed by transparent huge pages, as reported by
+/// /proc/self/smaps. Returns 0 if this information is not available.
+uint64_t hugePageBytes(
+    const std::vector<std::pair<const void*, uint64_t>>& ranges);
+
 class MmapArena {
  public:
   /// Single MmapArena capacity is determined by mmap_arena_capacity_ratio ratio
@@ -36,7 +63,13 @@ class MmapArena {
   /// MmapArena capacity should be multiple of kMinGrainSizeBytes.
   static constexpr uint64_t kMinGrainSizeBytes = 1024 * 1024; // 1M
 
-  MmapArena(size_t capacityBytes);
+  /// If 'useHugePages' is true, the arena is backed by transparent huge
+  /// pages where possible. If 'numaNode' is not kNoNumaNode, the arena
+  /// memory is preferably taken from that NUMA node.
+  MmapArena(
+      size_t capacityBytes,
+      bool useHugePages = false,
+      int32_t numaNode = kNoNumaNode);
   ~MmapArena();
 
   void* allocate(uint64_t bytes);
@@ -123,7 +156,10 @@ class MmapArena {
 /// fragmentation happens.
 class ManagedMmapArenas {
  public:
-  ManagedMmapArenas(uint64_t singleArenaCapacity);
+  ManagedMmapArenas(
+      uint64_t singleArenaCapacity,
+      bool useHugePages = false,
+      int32_t numaNode = kNoNumaNode);
 
   void* allocate(uint64_t bytes);
 
@@ -137,6 +173,12 @@ class ManagedMmapArenas {
   // Capacity in bytes for a single MmapArena managed by this.
   const uint64_t singleArenaCapacity_;
 
+  // True if the arenas are backed by transparent huge pages.
+  const bool useHugePages_;
+
+  // The preferred NUMA node of the arenas or kNoNumaNode.
+  const int32_t numaNode_;
+
   // A sorted list of MmapArena by its initial address
   std::map<uint64_t, std::shared_ptr<MmapArena>> arenas_;
 
@@ -16,7 +16,9 @@
 
 #include "velox/common/memory/SharedArbitrator.h"
 
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -34,6 +36,15 @@ uint64_t maxGrowBytes(const MemoryPool& pool) {
 uint64_t capacityAfterGrowth(const MemoryPool& pool, uint64_t targetBytes) {
   return pool.capacity() + targetBytes;
 }
+
+// Returns true if deadline 'lhs' is later than 'rhs'. 0 is no deadline, which
+// is later than any deadline.
+bool laterDeadline(uint64_t lhs, uint64_t rhs) {
+  if (lhs == 0 || rhs == 0) {
+    return rhs != 0;
+  }
+  return lhs > rhs;
+}
 } // namespace
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -62,6 +73,12 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
         if (!rhs.reclaimable) {
           return true;
         }
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
+        if (lhs.deadlineMs != rhs.deadlineMs) {
+          return laterDeadline(lhs.deadlineMs, rhs.deadlineMs);
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -76,16 +93,23 @@ SharedArbitrator::findCandidateWithLargestCapacity(
     uint64_t targetBytes,
     const std::vector<Candidate>& candidates) const {
   VELOX_CHECK(!candidates.empty());
+  int32_t minPriority = candidates[0].priority;
+  for (const auto& candidate : candidates) {
+    minPriority = std::min(minPriority, candidate.priority);
+  }
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
+    if (candidates[i].priority != minPriority) {
+      continue;
+    }
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (candidateIdx == -1) {
+      candidateIdx = i;
       maxCapacity = capacity;
       continue;
     }
@@ -139,7 +163,12 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
     uint64_t reclaimableBytes;
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
     candidates.push_back(
-        {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+        {reclaimable,
+         reclaimableBytes,
+         pool->freeBytes(),
+         pool.get(),
+         pool->arbitrationPriority(),
+         pool->arbitrationDeadlineMs()});
   }
   return candidates;
 }
@@ -341,8 +370,13 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     if (!candidate.reclaimable || candidate.reclaimableBytes == 0) {
       break;
     }
-    const int64_t bytesToReclaim = std::max<int64_t>(
+    int64_t bytesToReclaim = std::max<int64_t>(
         targetBytes - freedBytes, minMemoryPoolCapacityTransferSize_);
+    if (reclaimLowerPriorityFully_ &&
+        candidate.priority < requestor->arbitrationPriority()) {
+      bytesToReclaim =
+          std::max<int64_t>(bytesToReclaim, candidate.reclaimableBytes);
+    }
     VELOX_CHECK_GT(bytesToReclaim, 0);
     freedBytes += reclaim(candidate.pool, bytesToReclaim);
     if ((freedBytes >= targetBytes) || requestor->aborted()) {
@@ -480,11 +514,13 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
     std::lock_guard<std::mutex> l(mutex_);
     ++numRequests_;
     if (running_) {
-      waitPromises_.emplace_back(fmt::format(
-          "Wait for arbitration, requestor: {}[{}]",
-          requestor->name(),
-          requestor->root()->name()));
-      waitPromise = waitPromises_.back().getSemiFuture();
+      waitPromises_.push_back(
+          {requestor->root()->arbitrationPriority(),
+           ContinuePromise(fmt::format(
+               "Wait for arbitration, requestor: {}[{}]",
+               requestor->name(),
+               requestor->root()->name()))});
+      waitPromise = waitPromises_.back().promise.getSemiFuture();
     } else {
       VELOX_CHECK(waitPromises_.empty());
       running_ = true;
@@ -501,6 +537,7 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
       waitPromise.wait();
     }
     queueTimeUs_ += waitTimeUs;
+    REPORT_ADD_HISTOGRAM_VALUE(kCounterArbitrationQueueTimeUs, waitTimeUs);
   }
 }
 
@@ -510,8 +547,14 @@ void SharedArbitrator::finishArbitration() {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(running_);
     if (!waitPromises_.empty()) {
-      resumePromise = std::move(waitPromises_.back());
-      waitPromises_.pop_back();
+      auto next = waitPromises_.rbegin();
+      for (auto it = waitPromises_.rbegin(); it != waitPromises_.rend(); ++it) {
+        if (it->priority > next->priority) {
+          next = it;
+        }
+      }
+      resumePromise = std::move(next->promise);
+      waitPromises_.erase(std::next(next).base());
     } else {
       running_ = false;
     }
@@ -50,6 +50,8 @@ class SharedArbitrator : public MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    int32_t priority{0};
+    uint64_t deadlineMs{0};
   };
 
  private:
@@ -87,9 +89,9 @@ class SharedArbitrator : public MemoryArbitrator {
 
   void sortCandidatesByFreeCapacity(std::vector<Candidate>& candidates) const;
 
-  // Finds the candidate with the largest capacity. For 'requestor', the
-  // capacity for comparison including its current capacity and the capacity to
-  // grow.
+  // Finds the candidate with the largest capacity among the candidates of the
+  // lowest arbitration priority. For 'requestor', the capacity for comparison
+  // including its current capacity and the capacity to grow.
   const Candidate& findCandidateWithLargestCapacity(
       MemoryPool* requestor,
       uint64_t targetBytes,
@@ -160,9 +162,15 @@ class SharedArbitrator : public MemoryArbitrator {
   // Indicates if there is a running arbitration request or not.
   bool running_{false};
 
-  // The promises of the arbitration requests waiting for the serialized
-  // execution.
-  std::vector<ContinuePromise> waitPromises_;
+  // An arbitration request waiting for the serialized execution.
+  struct ArbitrationWait {
+    int32_t priority;
+    ContinuePromise promise;
+  };
+
+  // The arbitration requests waiting for the serialized execution. The next
+  // request to run is the last added one of the highest arbitration priority.
+  std::vector<ArbitrationWait> waitPromises_;
 
   tsan_atomic<uint64_t> numRequests_{0};
   tsan_atomic<uint64_t> numAborted_{0};
@@ -405,6 +405,67 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, hugePages) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useMmapArena = true;
+  options.useHugePages = true;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  Allocation allocation;
+  const auto largestClass = mmapAllocator->sizeClasses().back();
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(
+      4 * largestClass, allocation, nullptr, largestClass));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    memset(run.data(), 1, run.numBytes());
+  }
+  ContiguousAllocation contiguous;
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(
+      AllocationTraits::numPages(4 * kHugePageBytes), nullptr, contiguous));
+  EXPECT_EQ(0, reinterpret_cast<uint64_t>(contiguous.data()) % kHugePageBytes);
+  memset(contiguous.data(), 1, contiguous.size());
+  EXPECT_NE(std::string::npos, mmapAllocator->toString().find("huge pages"));
+  EXPECT_TRUE(mmapAllocator->checkConsistency());
+  mmapAllocator->freeContiguous(contiguous);
+  mmapAllocator->freeNonContiguous(allocation);
+}
+
+TEST_P(MemoryAllocatorTest, numaNode) {
+  if (!useMmap_) {
+    return;
+  }
+  ASSERT_LE(1, numNumaNodes());
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useMmapArena = true;
+  options.numaNode = numNumaNodes() - 1;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  EXPECT_EQ(options.numaNode, mmapAllocator->numaNode());
+  Allocation allocation;
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(100, allocation));
+  for (auto i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    memset(run.data(), 1, run.numBytes());
+  }
+  ContiguousAllocation contiguous;
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(
+      mmapAllocator->largestSizeClass() + 1, nullptr, contiguous));
+  memset(contiguous.data(), 1, contiguous.size());
+  EXPECT_NE(
+      std::string::npos,
+      mmapAllocator->toString().find(
+          fmt::format("NUMA node {}", options.numaNode)));
+  mmapAllocator->freeContiguous(contiguous);
+  mmapAllocator->freeNonContiguous(allocation);
+
+  options.numaNode = numNumaNodes();
+  VELOX_ASSERT_THROW(
+      std::make_shared<MmapAllocator>(options), "Invalid NUMA node");
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   AllocationPool pool(pool_.get());
@@ -1653,6 +1714,19 @@ TEST_F(MmapArenaTest, managedMmapArenasFree) {
   }
 }
 
+TEST_F(MmapArenaTest, hugePages) {
+  auto arena = std::make_unique<MmapArena>(kArenaCapacityBytes, true);
+  EXPECT_EQ(0, reinterpret_cast<uint64_t>(arena->address()) % kHugePageBytes);
+  memset(arena->address(), 1, kArenaCapacityBytes);
+  // The coverage of 'arena' depends on the kernel settings. Nothing is
+  // reported for no ranges.
+  EXPECT_EQ(0, hugePageBytes({}));
+  void* ptr = arena->allocate(kHugePageBytes);
+  ASSERT_NE(nullptr, ptr);
+  arena->free(ptr, kHugePageBytes);
+  EXPECT_TRUE(arena->checkConsistency());
+}
+
 TEST_F(MmapArenaTest, managedMmapArenasFreeError) {
   {
     std::unique_ptr<ManagedMmapArenas> managedArenas =
@@ -606,6 +606,73 @@ TEST_P(MemoryPoolTest, MemoryManagerGlobalCap) {
   child->free(oneChunk, 32L * MB);
 }
 
+TEST_P(MemoryPoolTest, reservationBatch) {
+  constexpr int64_t kBatchBytes = MB;
+  MemoryManager manager{
+      {.capacity = 32 * MB, .reservationBatchBytes = kBatchBytes}};
+  auto root = manager.addRootPool();
+  auto child = root->addLeafChild("batch", isLeafThreadSafe_);
+
+  // The first allocation reserves a batch ahead from the manager.
+  void* first = child->allocate(1024);
+  ASSERT_EQ(1024 + kBatchBytes, manager.getTotalBytes());
+  std::vector<void*> buffers;
+  for (auto i = 0; i < 1000; ++i) {
+    buffers.push_back(child->allocate(1024));
+  }
+  ASSERT_EQ(1024 + kBatchBytes, manager.getTotalBytes());
+  for (auto* buffer : buffers) {
+    child->free(buffer, 1024);
+  }
+  ASSERT_EQ(1024 + kBatchBytes, manager.getTotalBytes());
+
+  // An allocation larger than the batch reserves the allocation and another
+  // batch. The free returns all but one batch.
+  void* large = child->allocate(8 * MB);
+  ASSERT_EQ(1024 + 8 * MB + 2 * kBatchBytes, manager.getTotalBytes());
+  child->free(large, 8 * MB);
+  ASSERT_EQ(1024 + kBatchBytes, manager.getTotalBytes());
+
+  EXPECT_THROW(child->allocate(32 * MB), velox::VeloxRuntimeError);
+  ASSERT_EQ(1024 + kBatchBytes, manager.getTotalBytes());
+
+  child->free(first, 1024);
+  ASSERT_EQ(child->currentBytes(), 0);
+  child.reset();
+  ASSERT_EQ(0, manager.getTotalBytes());
+}
+
+TEST_P(MemoryPoolTest, retainedReservation) {
+  MemoryManager manager{
+      {.capacity = 32 * MB, .retainedReservationBytes = 2 * MB}};
+  auto root = manager.addRootPool();
+  auto child = root->addLeafChild("retained", isLeafThreadSafe_);
+
+  void* first = child->allocate(1024);
+  ASSERT_EQ(MB, child->reservedBytes());
+  ASSERT_EQ(MB, root->reservedBytes());
+
+  // Going over a quantum and back keeps the reservation of the parents.
+  void* large = child->allocate(4 * MB);
+  ASSERT_EQ(5 * MB, child->reservedBytes());
+  ASSERT_EQ(5 * MB, root->reservedBytes());
+  child->free(large, 4 * MB);
+  ASSERT_EQ(3 * MB, child->reservedBytes());
+  ASSERT_EQ(3 * MB, root->reservedBytes());
+  for (auto i = 0; i < 10; ++i) {
+    large = child->allocate(MB);
+    ASSERT_EQ(3 * MB, root->reservedBytes());
+    child->free(large, MB);
+    ASSERT_EQ(3 * MB, root->reservedBytes());
+  }
+  ASSERT_EQ(1024, child->currentBytes());
+
+  // All the reservation is returned when nothing is used.
+  child->free(first, 1024);
+  ASSERT_EQ(0, child->reservedBytes());
+  ASSERT_EQ(0, root->reservedBytes());
+}
+
 // Tests how child updates itself and its parent's memory usage
 // and what it returns for currentBytes()/getMaxBytes and
 // with memoryUsageTracker.
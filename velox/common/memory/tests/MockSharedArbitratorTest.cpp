@@ -362,7 +362,8 @@ class MockSharedArbitrationTest : public testing::Test {
       int64_t memoryCapacity = 0,
       uint64_t initMemoryPoolCapacity = kMaxMemory,
       uint64_t minMemoryPoolCapacityTransferSize = 0,
-      bool retryArbitrationFailure = true) {
+      bool retryArbitrationFailure = true,
+      bool reclaimLowerPriorityFully = false) {
     if (initMemoryPoolCapacity == kMaxMemory) {
       initMemoryPoolCapacity = kInitMemoryPoolCapacity;
     }
@@ -376,7 +377,8 @@ class MockSharedArbitrationTest : public testing::Test {
         .capacity = options.capacity,
         .initMemoryPoolCapacity = initMemoryPoolCapacity,
         .minMemoryPoolCapacityTransferSize = minMemoryPoolCapacityTransferSize,
-        .retryArbitrationFailure = retryArbitrationFailure};
+        .retryArbitrationFailure = retryArbitrationFailure,
+        .reclaimLowerPriorityFully = reclaimLowerPriorityFully};
     options.arbitratorFactory = [&]() {
       return MemoryArbitrator::create(arbitratorConfig);
     };
@@ -867,6 +869,50 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrateByPriority) {
+  const uint64_t memoryCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  for (const bool reclaimFully : {false, true}) {
+    SCOPED_TRACE(fmt::format("reclaimFully {}", reclaimFully));
+    setupMemory(memoryCapacity, minPoolCapacity, 0, true, reclaimFully);
+    // The high priority query uses more memory than the low priority one but
+    // the low priority one is reclaimed first.
+    auto highQuery = addQuery();
+    highQuery->pool()->setArbitrationPriority(1);
+    queries_.push_back(highQuery);
+    auto* highOp = addMemoryOp(highQuery, true);
+    while (highOp->pool()->currentBytes() < memoryCapacity / 2 + 32 * MB) {
+      highOp->allocate(allocateSize);
+    }
+    auto lowQuery = addQuery();
+    ASSERT_EQ(lowQuery->pool()->arbitrationPriority(), 0);
+    queries_.push_back(lowQuery);
+    auto* lowOp = addMemoryOp(lowQuery, true);
+    while (highOp->pool()->currentBytes() + lowOp->pool()->currentBytes() <
+           memoryCapacity) {
+      lowOp->allocate(allocateSize);
+    }
+    const auto lowBytes = lowOp->pool()->currentBytes();
+    const auto highBytes = highOp->pool()->currentBytes();
+    ASSERT_LT(lowBytes, highBytes);
+
+    auto arbitrateQuery = addQuery();
+    arbitrateQuery->pool()->setArbitrationPriority(1);
+    queries_.push_back(arbitrateQuery);
+    auto* arbitrateOp = addMemoryOp(arbitrateQuery, true);
+    arbitrateOp->allocate(allocateSize);
+
+    ASSERT_EQ(highOp->reclaimer()->stats().numReclaims, 0);
+    ASSERT_EQ(lowOp->reclaimer()->stats().numReclaims, 1);
+    ASSERT_EQ(highOp->pool()->currentBytes(), highBytes);
+    ASSERT_EQ(
+        lowOp->pool()->currentBytes(),
+        reclaimFully ? 0 : lowBytes - allocateSize);
+    clearQueries();
+  }
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
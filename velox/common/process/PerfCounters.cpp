@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+#ifdef __linux__
+namespace {
+constexpr int kNumCounters = 4;
+
+// Opens a user space counter of the calling thread. 'groupFd' is the leader of
+// the group or -1 to open the leader.
+int openCounter(uint64_t config, int groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  // The group is enabled as a whole through the leader.
+  attr.disabled = groupFd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return syscall(
+      SYS_perf_event_open, &attr, /*pid*/ 0, /*cpu*/ -1, groupFd, /*flags*/ 0);
+}
+
+// The counters of one thread as a group that is read with one read() call.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    static constexpr uint64_t kEvents[kNumCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+    for (auto i = 0; i < kNumCounters; ++i) {
+      fds_[i] = openCounter(kEvents[i], i == 0 ? -1 : fds_[0]);
+      if (fds_[i] < 0) {
+        return;
+      }
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    valid_ = true;
+  }
+
+  ~ThreadCounters() {
+    for (auto fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+
+  std::optional<PerfCounters> read() const {
+    if (!valid_) {
+      return std::nullopt;
+    }
+    // A group read returns the number of counters followed by their values in
+    // the order they were opened.
+    uint64_t values[1 + kNumCounters];
+    if (::read(fds_[0], values, sizeof(values)) != sizeof(values)) {
+      return std::nullopt;
+    }
+    return PerfCounters{values[1], values[2], values[3], values[4]};
+  }
+
+ private:
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+  bool valid_{false};
+};
+} // namespace
+
+std::optional<PerfCounters> threadPerfCounters() {
+  thread_local ThreadCounters counters;
+  return counters.read();
+}
+#else
+std::optional<PerfCounters> threadPerfCounters() {
+  return std::nullopt;
+}
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+namespace facebook::velox::process {
+
+// Hardware event counts of a thread from the Linux perf_event interface.
+struct PerfCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  // Last level cache misses.
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounters operator-(const PerfCounters& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+};
+
+// Returns the user space counts of the calling thread since its first call,
+// which opens the counters of the thread. Returns std::nullopt if the counters
+// are not available, e.g. outside of Linux, in a VM without a virtual PMU or
+// if perf_event_paranoid does not allow them.
+std::optional<PerfCounters> threadPerfCounters();
+
+// Reads the counters of the calling thread at construction and destruction and
+// passes the difference to the user callback. Does not call the callback if
+// the counters are not available.
+template <typename F>
+class DeltaPerfCountersTimer {
+ public:
+  explicit DeltaPerfCountersTimer(F&& func)
+      : start_(threadPerfCounters()), func_(std::move(func)) {}
+
+  ~DeltaPerfCountersTimer() {
+    if (!start_.has_value()) {
+      return;
+    }
+    const auto end = threadPerfCounters();
+    if (end.has_value()) {
+      func_(end.value() - start_.value());
+    }
+  }
+
+ private:
+  const std::optional<PerfCounters> start_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/process/PerfCounters.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+namespace {
+// Keeps the CPU busy so that the counters advance.
+uint64_t spin(uint64_t n) {
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < n; ++i) {
+    sum = sum + i * i;
+  }
+  return sum;
+}
+} // namespace
+
+TEST(PerfCountersTest, threadCounters) {
+  const auto start = threadPerfCounters();
+  if (!start.has_value()) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  spin(1'000'000);
+  const auto end = threadPerfCounters();
+  ASSERT_TRUE(end.has_value());
+  const auto delta = end.value() - start.value();
+  EXPECT_GT(delta.cycles, 0);
+  // The loop retires several instructions per iteration.
+  EXPECT_GT(delta.instructions, 1'000'000);
+}
+
+TEST(PerfCountersTest, deltaTimer) {
+  if (!threadPerfCounters().has_value()) {
+    GTEST_SKIP() << "Hardware counters are not available";
+  }
+  PerfCounters total;
+  int32_t numCalls = 0;
+  for (auto i = 0; i < 2; ++i) {
+    DeltaPerfCountersTimer timer([&](const PerfCounters& delta) {
+      total.instructions += delta.instructions;
+      ++numCalls;
+    });
+    spin(100'000);
+  }
+  EXPECT_EQ(numCalls, 2);
+  EXPECT_GT(total.instructions, 200'000);
+
+  // Each thread has its own counters.
+  std::thread thread([]() { EXPECT_TRUE(threadPerfCounters().has_value()); });
+  thread.join();
+}
@@ -23,6 +23,7 @@
 #include "velox/vector/ComplexVector.h"
 
 #include <folly/Synchronized.h>
+#include <folly/compression/Compression.h>
 
 namespace facebook::velox::common {
 class Filter;
@@ -41,10 +42,15 @@ class DataSource;
 struct ConnectorSplit {
   const std::string connectorId;
 
+  // Relative cost of reading the split, e.g. its size in bytes. 0 if unknown.
+  const uint64_t splitWeight{0};
+
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
-  explicit ConnectorSplit(const std::string& _connectorId)
-      : connectorId(_connectorId) {}
+  explicit ConnectorSplit(
+      const std::string& _connectorId,
+      uint64_t _splitWeight = 0)
+      : connectorId(_connectorId), splitWeight(_splitWeight) {}
 
   virtual ~ConnectorSplit() {}
 
@@ -142,6 +148,19 @@ class DataSink {
   virtual std::vector<std::string> finish() const = 0;
 
   virtual void close() = 0;
+
+  /// Returns true if the sink can free memory on request of the memory
+  /// arbitrator, e.g. by flushing the data it buffers.
+  virtual bool canReclaim() const {
+    return false;
+  }
+
+  /// Frees at least 'targetBytes' of buffered memory if possible, or all of
+  /// it if 'targetBytes' is 0. Not called during appendData() or after
+  /// close(). Returns the number of bytes freed.
+  virtual uint64_t reclaim(uint64_t /*targetBytes*/) {
+    return 0;
+  }
 };
 
 class DataSource {
@@ -207,6 +226,28 @@ class DataSource {
   }
 };
 
+/// Disk spilling settings for a DataSource or DataSink that buffers rows in
+/// memory, e.g. to sort them before writing. Made from the spill config of
+/// the operator if it has spilling enabled.
+struct ConnectorSpillConfig {
+  /// Path prefix of the spill files.
+  std::string filePath;
+  /// Max size of a spill file. 0 means no limit.
+  uint64_t maxFileSize{0};
+  /// Min size of a sorted run to spill.
+  uint64_t minSpillRunSize{0};
+  /// Executor for writing spill files. Not owned. nullptr means spilling on
+  /// the calling thread.
+  folly::Executor* executor{nullptr};
+  /// Growth of the memory reservation before spilling, in percent of the
+  /// current reservation.
+  int32_t spillableReservationGrowthPct{0};
+  /// Percentage of input batches to spill for testing. 0 means none.
+  int32_t testSpillPct{0};
+  folly::io::CodecType compressionKind{folly::io::CodecType::NO_COMPRESSION};
+  bool checksumEnabled{false};
+};
+
 /// Collection of context data for use in a DataSource or DataSink. One instance
 /// of this per DataSource and DataSink. This may be passed between threads but
 /// methods must be invoked sequentially. Serializing use is the responsibility
@@ -221,7 +262,8 @@ class ConnectorQueryCtx {
       memory::MemoryAllocator* FOLLY_NONNULL allocator,
       const std::string& taskId,
       const std::string& planNodeId,
-      int driverId)
+      int driverId,
+      std::optional<ConnectorSpillConfig> spillConfig = std::nullopt)
       : operatorPool_(operatorPool),
         connectorPool_(connectorPool),
         config_(connectorConfig),
@@ -229,7 +271,8 @@ class ConnectorQueryCtx {
         allocator_(allocator),
         scanId_(fmt::format("{}.{}", taskId, planNodeId)),
         taskId_(taskId),
-        driverId_(driverId) {}
+        driverId_(driverId),
+        spillConfig_(std::move(spillConfig)) {}
 
   /// Returns the associated operator's memory pool which is a leaf kind of
   /// memory pool, used for direct memory allocation use.
@@ -274,6 +317,11 @@ class ConnectorQueryCtx {
     return driverId_;
   }
 
+  /// Returns the spilling settings or nullptr if spilling is disabled.
+  const ConnectorSpillConfig* spillConfig() const {
+    return spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
+  }
+
  private:
   memory::MemoryPool* operatorPool_;
   memory::MemoryPool* connectorPool_;
@@ -283,6 +331,7 @@ class ConnectorQueryCtx {
   const std::string scanId_;
   const std::string taskId_;
   const int driverId_;
+  const std::optional<ConnectorSpillConfig> spillConfig_;
 };
 
 class Connector {
@@ -324,6 +373,16 @@ class Connector {
     return false;
   }
 
+  // Returns pieces of 'split' of about 'pieceBytes' each that different
+  // drivers can read in parallel. Together, the pieces read the same rows
+  // as 'split', e.g. each piece reads the stripes that start in a byte range
+  // of the file. Returns an empty vector if 'split' is not worth dividing.
+  virtual std::vector<std::shared_ptr<ConnectorSplit>> divideSplit(
+      const std::shared_ptr<ConnectorSplit>& /*split*/,
+      uint64_t /*pieceBytes*/) const {
+    return {};
+  }
+
   virtual std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -333,10 +392,12 @@ class Connector {
   // Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   // tracker and different threads will share the same
   // instance. 'loadQuantum' is the largest single IO for the query
-  // being tracked.
+  // being tracked. 'cacheTenant' is the tenant of the cached data read by
+  // the scan, empty if none.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      const std::string& cacheTenant = "");
 
   virtual folly::Executor* FOLLY_NULLABLE executor() const {
     return nullptr;
@@ -32,6 +32,15 @@ FuzzerDataSource::FuzzerDataSource(
 
   vectorFuzzer_ = std::make_unique<VectorFuzzer>(
       fuzzerTableHandle->fuzzerOptions, pool_, fuzzerTableHandle->fuzzerSeed);
+  if (const auto& spec = fuzzerTableHandle->generatorSpec) {
+    VELOX_CHECK(
+        spec->type()->equivalent(*outputType_),
+        "GeneratorSpec type {} does not match the output type {}",
+        spec->type()->toString(),
+        outputType_->toString());
+    generatorSpec_ = spec;
+    rng_.seed(fuzzerTableHandle->fuzzerSeed);
+  }
 }
 
 void FuzzerDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
@@ -44,6 +53,10 @@ void FuzzerDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
 
   splitOffset_ = 0;
   splitEnd_ = currentSplit_->numRows;
+  if (currentSplit_->seed.has_value()) {
+    vectorFuzzer_->reSeed(currentSplit_->seed.value());
+    rng_.seed(currentSplit_->seed.value());
+  }
 }
 
 std::optional<RowVectorPtr> FuzzerDataSource::next(
@@ -63,7 +76,21 @@ std::optional<RowVectorPtr> FuzzerDataSource::next(
   const size_t outputRows = std::min(size, (splitEnd_ - splitOffset_));
   splitOffset_ += outputRows;
 
-  auto outputVector = vectorFuzzer_->fuzzRow(outputType_, outputRows);
+  RowVectorPtr outputVector;
+  if (generatorSpec_ != nullptr) {
+    // The spec names no columns, so the children are put in a vector of the
+    // output type.
+    auto generated = std::dynamic_pointer_cast<RowVector>(
+        generatorSpec_->generateData(rng_, pool_, outputRows));
+    outputVector = std::make_shared<RowVector>(
+        pool_,
+        outputType_,
+        generated->nulls(),
+        outputRows,
+        generated->children());
+  } else {
+    outputVector = vectorFuzzer_->fuzzRow(outputType_, outputRows);
+  }
   completedRows_ += outputVector->size();
   completedBytes_ += outputVector->retainedSize();
   return outputVector;
@@ -17,6 +17,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/fuzzer/FuzzerConnectorSplit.h"
+#include "velox/vector/fuzzer/GeneratorSpec.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 namespace facebook::velox::connector::fuzzer {
@@ -28,18 +29,26 @@ namespace facebook::velox::connector::fuzzer {
 /// `FuzzerTableHandle` clients can specify VectorFuzzer options and seed, which
 /// are used when instantiating VectorFuzzer.
 ///
+/// Instead of VectorFuzzer, the data can come from a GeneratorSpec for the
+/// whole row, which gives each column its own distribution, e.g. the number
+/// of distinct keys, Zipf skew, string lengths or correlation with another
+/// column. This is meant for load testing joins and aggregations on data
+/// with realistic skew.
+///
 /// FuzzerConnectorSplit lets clients specify how many rows are expected to be
-/// generated.
+/// generated, and optionally a seed for the split.
 
 class FuzzerTableHandle : public ConnectorTableHandle {
  public:
   explicit FuzzerTableHandle(
       std::string connectorId,
       VectorFuzzer::Options options,
-      size_t fuzzerSeed = 0)
+      size_t fuzzerSeed = 0,
+      GeneratorSpecPtr generatorSpec = nullptr)
       : ConnectorTableHandle(std::move(connectorId)),
         fuzzerOptions(options),
-        fuzzerSeed(fuzzerSeed) {}
+        fuzzerSeed(fuzzerSeed),
+        generatorSpec(std::move(generatorSpec)) {}
 
   ~FuzzerTableHandle() override {}
 
@@ -49,6 +58,10 @@ class FuzzerTableHandle : public ConnectorTableHandle {
 
   const VectorFuzzer::Options fuzzerOptions;
   size_t fuzzerSeed;
+
+  // If set, generates the rows instead of VectorFuzzer. This is a row spec of
+  // the output type of the scan. It is shared by all drivers of the scan.
+  const GeneratorSpecPtr generatorSpec;
 };
 
 class FuzzerDataSource : public DataSource {
@@ -85,6 +98,8 @@ class FuzzerDataSource : public DataSource {
  private:
   const RowTypePtr outputType_;
   std::unique_ptr<VectorFuzzer> vectorFuzzer_;
+  GeneratorSpecPtr generatorSpec_;
+  FuzzerGenerator rng_;
 
   // The current split being processed.
   std::shared_ptr<FuzzerConnectorSplit> currentSplit_;
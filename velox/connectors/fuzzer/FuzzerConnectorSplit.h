@@ -15,16 +15,26 @@
  */
 #pragma once
 
+#include <optional>
+
 #include "velox/connectors/Connector.h"
 
 namespace facebook::velox::connector::fuzzer {
 
 struct FuzzerConnectorSplit : public connector::ConnectorSplit {
-  explicit FuzzerConnectorSplit(const std::string& connectorId, size_t numRows)
-      : ConnectorSplit(connectorId), numRows(numRows) {}
+  explicit FuzzerConnectorSplit(
+      const std::string& connectorId,
+      size_t numRows,
+      std::optional<size_t> seed = std::nullopt)
+      : ConnectorSplit(connectorId), numRows(numRows), seed(seed) {}
 
   // Row many rows to generate.
   size_t numRows;
+
+  // If set, the data for the split is generated from this seed, so that it
+  // does not depend on which driver reads the split. Splits with different
+  // seeds let the drivers of a scan generate different data in parallel.
+  std::optional<size_t> seed;
 };
 
 } // namespace facebook::velox::connector::fuzzer
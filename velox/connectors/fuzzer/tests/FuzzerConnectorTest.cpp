@@ -20,6 +20,7 @@
 #include "velox/connectors/fuzzer/tests/FuzzerConnectorTestBase.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/ZetaDistribution.h"
 
 namespace facebook::velox::connector::fuzzer::test {
 
@@ -120,6 +121,83 @@ TEST_F(FuzzerConnectorTest, reproducible) {
   exec::test::assertEqualResults({results1}, {results2});
 }
 
+TEST_F(FuzzerConnectorTest, generatorSpec) {
+  using namespace generator_spec_maker;
+  const size_t rowsPerSplit = 1'000;
+  const size_t numSplits = 4;
+  auto type = ROW({"k", "name", "v"}, {BIGINT(), VARCHAR(), DOUBLE()});
+
+  // 100 Zipf distributed keys, names of 1 to 30 characters and uniform
+  // values.
+  auto spec = RANDOM_ROW({
+      RANDOM_BIGINT(functions::ZetaDistribution(1.5, 100)),
+      RANDOM_VARCHAR(std::uniform_int_distribution<int32_t>(1, 30)),
+      RANDOM_DOUBLE(std::uniform_real_distribution<double>(0, 1)),
+  });
+  auto tableHandle = std::make_shared<FuzzerTableHandle>(
+      kFuzzerConnectorId, VectorFuzzer::Options{}, 0, spec);
+
+  auto plan = PlanBuilder()
+                  .tableScan(type, tableHandle, {})
+                  .singleAggregation({"k"}, {"count(1)"})
+                  .orderBy({"a0 desc"}, false)
+                  .limit(0, 1, false)
+                  .planNode();
+
+  std::vector<exec::Split> splits;
+  for (auto i = 0; i < numSplits; ++i) {
+    splits.emplace_back(std::make_shared<FuzzerConnectorSplit>(
+        kFuzzerConnectorId, rowsPerSplit, i));
+  }
+  auto result =
+      exec::test::AssertQueryBuilder(plan).splits(splits).copyResults(pool());
+
+  // Key 1 has about 41% of the rows.
+  ASSERT_EQ(result->size(), 1);
+  EXPECT_EQ(result->childAt(0)->asFlatVector<int64_t>()->valueAt(0), 1);
+  auto count = result->childAt(1)->asFlatVector<int64_t>()->valueAt(0);
+  EXPECT_GT(count, 1'500);
+  EXPECT_LT(count, 1'800);
+
+  // The spec must be of the output type.
+  auto badPlan = PlanBuilder()
+                     .tableScan(ROW({BIGINT()}), tableHandle, {})
+                     .planNode();
+  VELOX_ASSERT_THROW(
+      exec::test::AssertQueryBuilder(badPlan)
+          .split(makeFuzzerSplit(10))
+          .copyResults(pool()),
+      "GeneratorSpec type");
+}
+
+TEST_F(FuzzerConnectorTest, splitSeed) {
+  const size_t numRows = 100;
+  auto type = ROW({BIGINT(), VARCHAR()});
+  auto plan =
+      PlanBuilder().tableScan(type, makeFuzzerTableHandle(), {}).planNode();
+
+  auto makeSplit = [&](size_t seed) {
+    return exec::Split(std::make_shared<FuzzerConnectorSplit>(
+        kFuzzerConnectorId, numRows, seed));
+  };
+  auto results1 = exec::test::AssertQueryBuilder(plan)
+                      .split(makeSplit(1))
+                      .copyResults(pool());
+  auto results2 = exec::test::AssertQueryBuilder(plan)
+                      .split(makeSplit(1))
+                      .copyResults(pool());
+  auto results3 = exec::test::AssertQueryBuilder(plan)
+                      .split(makeSplit(2))
+                      .copyResults(pool());
+
+  exec::test::assertEqualResults({results1}, {results2});
+  vector_size_t numDifferent = 0;
+  for (auto i = 0; i < numRows; ++i) {
+    numDifferent += !results1->equalValueAt(results3.get(), i, i);
+  }
+  EXPECT_GT(numDifferent, 0);
+}
+
 } // namespace facebook::velox::connector::fuzzer::test
 
 int main(int argc, char** argv) {
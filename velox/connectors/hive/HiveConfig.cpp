@@ -71,6 +71,16 @@ bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
 }
 
+// static
+uint64_t HiveConfig::sortWriterSpillMemoryThreshold(const Config* config) {
+  return config->get<uint64_t>(kSortWriterSpillMemoryThreshold, 0);
+}
+
+// static
+uint64_t HiveConfig::maxWriterMemory(const Config* config) {
+  return config->get<uint64_t>(kMaxWriterMemory, 0);
+}
+
 // static
 bool HiveConfig::s3UseVirtualAddressing(const Config* config) {
   return !config->get(kS3PathStyleAccess, false);
@@ -125,8 +135,56 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+uint64_t HiveConfig::s3UploadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3UploadPartSize, 16UL << 20);
+}
+
+// static
+uint32_t HiveConfig::s3MaxUploadsInFlight(const Config* config) {
+  return config->get<uint32_t>(kS3MaxUploadsInFlight, 4);
+}
+
+// static
+uint64_t HiveConfig::s3ReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadPartSize, 8UL << 20);
+}
+
+// static
+uint32_t HiveConfig::s3MaxConnections(const Config* config) {
+  return config->get<uint32_t>(kS3MaxConnections, 25);
+}
+
+// static
+uint32_t HiveConfig::s3ConnectTimeoutMs(const Config* config) {
+  return config->get<uint32_t>(kS3ConnectTimeout, 1'000);
+}
+
+// static
+uint32_t HiveConfig::s3RequestTimeoutMs(const Config* config) {
+  return config->get<uint32_t>(kS3RequestTimeout, 3'000);
+}
+
+// static
+uint32_t HiveConfig::s3MaxRetries(const Config* config) {
+  return config->get<uint32_t>(kS3MaxRetries, 10);
+}
+
+// static
+double HiveConfig::s3ReadHedgingBudget(const Config* config) {
+  return config->get<double>(kS3ReadHedgingBudget, 0);
+}
+
 // static.
 bool HiveConfig::isFileColumnNamesReadAsLowerCase(const Config* config) {
   return config->get<bool>(kFileColumnNamesReadAsLowerCase, false);
 }
+
+std::string HiveConfig::cacheTenant(const Config* config) {
+  return config->get<std::string>(kCacheTenant, "");
+}
+
+int32_t HiveConfig::minAverageRunLength(const Config* config) {
+  return config->get<int32_t>(kMinAverageRunLength, 0);
+}
 } // namespace facebook::velox::connector::hive
@@ -48,6 +48,18 @@ class HiveConfig {
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions = "immutable_partitions";
 
+  /// Maximum bytes of rows that a writer of a sorted bucket file buffers
+  /// before spilling them as a sorted run, if spilling is enabled. 0 means
+  /// that the writer spills only when its memory cannot grow.
+  static constexpr const char* kSortWriterSpillMemoryThreshold =
+      "sort_writer_spill_memory_threshold";
+
+  /// Maximum bytes that the open file writers of a table writer buffer
+  /// together. When they buffer more, the writers holding the most memory
+  /// flush their stripes first until the total is under the limit. 0 means
+  /// no limit.
+  static constexpr const char* kMaxWriterMemory = "max_writer_memory";
+
   /// Virtual addressing is used for AWS S3 and is the default
   /// (path-style-access is false). Path access style is used for some on-prem
   /// systems like Minio.
@@ -80,10 +92,50 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Size in bytes of the parts of a multipart upload to S3. S3 requires at
+  /// least 5MB for all but the last part.
+  static constexpr const char* kS3UploadPartSize = "hive.s3.upload-part-size";
+
+  /// Maximum number of parts of one S3 file that are uploaded at the same
+  /// time. Appends wait for an upload to finish when this many are pending.
+  static constexpr const char* kS3MaxUploadsInFlight =
+      "hive.s3.max-uploads-in-flight";
+
+  /// Maximum size in bytes of one ranged GET of an asynchronous S3 read. A
+  /// larger read is split into GETs that run in parallel.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
+  /// Maximum number of open connections of the S3 client. This is also the
+  /// number of threads that run the asynchronous S3 requests.
+  static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
+
+  /// Timeout in milliseconds for establishing an S3 connection.
+  static constexpr const char* kS3ConnectTimeout = "hive.s3.connect-timeout";
+
+  /// Timeout in milliseconds for an S3 request to make progress.
+  static constexpr const char* kS3RequestTimeout = "hive.s3.request-timeout";
+
+  /// Maximum number of retries of a failed S3 request.
+  static constexpr const char* kS3MaxRetries = "hive.s3.max-retries";
+
+  /// Maximum number of hedged S3 GETs per GET, e.g. 0.05 for at most 5% extra
+  /// requests. A GET of an asynchronous read that has not finished by the p95
+  /// of the recent GET latencies is sent again and the first response wins.
+  /// 0 disables hedging.
+  static constexpr const char* kS3ReadHedgingBudget =
+      "hive.s3.read-hedging-budget";
+
   // Read the source file column name as lower case.
   static constexpr const char* kFileColumnNamesReadAsLowerCase =
       "file_column_names_read_as_lower_case";
 
+  // Tenant of AsyncDataCache that the data read by the query is charged to.
+  static constexpr const char* kCacheTenant = "cache_tenant";
+
+  // If non-zero, scalar columns whose runs of equal values are on average at
+  // least this many rows long are read as SequenceVectors.
+  static constexpr const char* kMinAverageRunLength = "min_average_run_length";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
@@ -91,6 +143,10 @@ class HiveConfig {
 
   static bool immutablePartitions(const Config* config);
 
+  static uint64_t sortWriterSpillMemoryThreshold(const Config* config);
+
+  static uint64_t maxWriterMemory(const Config* config);
+
   static bool s3UseVirtualAddressing(const Config* config);
 
   static std::string s3GetLogLevel(const Config* config);
@@ -109,7 +165,27 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static uint64_t s3UploadPartSize(const Config* config);
+
+  static uint32_t s3MaxUploadsInFlight(const Config* config);
+
+  static uint64_t s3ReadPartSize(const Config* config);
+
+  static uint32_t s3MaxConnections(const Config* config);
+
+  static uint32_t s3ConnectTimeoutMs(const Config* config);
+
+  static uint32_t s3RequestTimeoutMs(const Config* config);
+
+  static uint32_t s3MaxRetries(const Config* config);
+
+  static double s3ReadHedgingBudget(const Config* config);
+
   static bool isFileColumnNamesReadAsLowerCase(const Config* config);
+
+  static std::string cacheTenant(const Config* config);
+
+  static int32_t minAverageRunLength(const Config* config);
 };
 
 } // namespace facebook::velox::connector::hive
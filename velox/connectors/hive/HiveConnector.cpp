@@ -32,6 +32,16 @@ DEFINE_int32(
     20'000,
     "Max number of file handles to cache.");
 
+DEFINE_int64(
+    file_metadata_cache_bytes,
+    0,
+    "Max bytes of parsed file footers to cache. 0 disables the cache.");
+
+DEFINE_int32(
+    file_metadata_cache_ttl_s,
+    3'600,
+    "Seconds after which a cached file footer is read again. 0 means never.");
+
 namespace facebook::velox::connector::hive {
 
 HiveConnector::HiveConnector(
@@ -44,8 +54,51 @@ HiveConnector::HiveConnector(
               SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
               FLAGS_num_file_handle_cache),
           std::make_unique<FileHandleGenerator>(std::move(properties))),
+      fileMetadataCache_(
+          FLAGS_file_metadata_cache_bytes > 0
+              ? std::make_shared<cache::FileMetadataCache>(
+                    FLAGS_file_metadata_cache_bytes,
+                    FLAGS_file_metadata_cache_ttl_s * 1'000ULL,
+                    memory::addDefaultLeafMemoryPool(
+                        fmt::format("{}.file_metadata_cache", id)))
+              : nullptr),
       executor_(executor) {}
 
+std::vector<std::shared_ptr<ConnectorSplit>> HiveConnector::divideSplit(
+    const std::shared_ptr<ConnectorSplit>& split,
+    uint64_t pieceBytes) const {
+  auto hiveSplit = std::dynamic_pointer_cast<HiveConnectorSplit>(split);
+  // A split without a length reads to the end of a file of unknown size.
+  if (hiveSplit == nullptr || pieceBytes == 0 ||
+      hiveSplit->length == std::numeric_limits<uint64_t>::max() ||
+      hiveSplit->length < 2 * pieceBytes) {
+    return {};
+  }
+  // The readers read the stripes or row groups that start in the byte range
+  // of a split, so each stripe is read by exactly one piece. A piece with no
+  // stripe start reads nothing.
+  const uint64_t numPieces = hiveSplit->length / pieceBytes;
+  const uint64_t end = hiveSplit->start + hiveSplit->length;
+  std::vector<std::shared_ptr<ConnectorSplit>> pieces;
+  pieces.reserve(numPieces);
+  uint64_t offset = hiveSplit->start;
+  for (uint64_t i = 0; i < numPieces; ++i) {
+    const uint64_t pieceEnd = i + 1 == numPieces ? end : offset + pieceBytes;
+    pieces.push_back(std::make_shared<HiveConnectorSplit>(
+        hiveSplit->connectorId,
+        hiveSplit->filePath,
+        hiveSplit->fileFormat,
+        offset,
+        pieceEnd - offset,
+        hiveSplit->partitionKeys,
+        hiveSplit->tableBucketNumber,
+        hiveSplit->customSplitInfo,
+        hiveSplit->extraFileInfo));
+    offset = pieceEnd;
+  }
+  return pieces;
+}
+
 std::unique_ptr<core::PartitionFunction> HivePartitionFunctionSpec::create(
     int numPartitions) const {
   return std::make_unique<velox::connector::hive::HivePartitionFunction>(
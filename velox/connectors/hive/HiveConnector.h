@@ -46,12 +46,15 @@ class HiveConnector : public Connector {
         tableHandle,
         columnHandles,
         &fileHandleFactory_,
+        fileMetadataCache_,
         connectorQueryCtx->memoryPool(),
         connectorQueryCtx->expressionEvaluator(),
         connectorQueryCtx->allocator(),
         connectorQueryCtx->scanId(),
         HiveConfig::isFileColumnNamesReadAsLowerCase(
             connectorQueryCtx->config()),
+        HiveConfig::cacheTenant(connectorQueryCtx->config()),
+        HiveConfig::minAverageRunLength(connectorQueryCtx->config()),
         executor_);
   }
 
@@ -59,6 +62,10 @@ class HiveConnector : public Connector {
     return true;
   }
 
+  std::vector<std::shared_ptr<ConnectorSplit>> divideSplit(
+      const std::shared_ptr<ConnectorSplit>& split,
+      uint64_t pieceBytes) const override;
+
   std::unique_ptr<DataSink> createDataSink(
       RowTypePtr inputType,
       std::shared_ptr<ConnectorInsertTableHandle> connectorInsertTableHandle,
@@ -86,8 +93,20 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  // Returns the stats of the cache of parsed file footers or std::nullopt if
+  // footers are not cached.
+  std::optional<cache::FileMetadataCacheStats> fileMetadataCacheStats() const {
+    if (fileMetadataCache_ == nullptr) {
+      return std::nullopt;
+    }
+    return fileMetadataCache_->stats();
+  }
+
  protected:
   FileHandleFactory fileHandleFactory_;
+  // Parsed footers of files shared between splits and queries. nullptr if
+  // disabled by --file_metadata_cache_bytes.
+  std::shared_ptr<cache::FileMetadataCache> fileMetadataCache_;
   folly::Executor* FOLLY_NULLABLE executor_;
 };
 
@@ -44,7 +44,9 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
       std::optional<int32_t> _tableBucketNumber = std::nullopt,
       const std::unordered_map<std::string, std::string>& _customSplitInfo = {},
       const std::shared_ptr<std::string>& _extraFileInfo = {})
-      : ConnectorSplit(connectorId),
+      : ConnectorSplit(
+            connectorId,
+            _length == std::numeric_limits<uint64_t>::max() ? 0 : _length),
         filePath(_filePath),
         fileFormat(_fileFormat),
         start(_start),
@@ -32,6 +32,9 @@ namespace facebook::velox::connector::hive {
 
 namespace {
 
+// Max number of rows of a batch written from a sort buffer.
+constexpr uint32_t kSortedWriteBatchRows = 1'024;
+
 // Returns a subset of column indices corresponding to partition keys.
 std::vector<column_index_t> getPartitionChannels(
     const std::shared_ptr<const HiveInsertTableHandle>& insertTableHandle) {
@@ -278,6 +281,8 @@ HiveDataSink::HiveDataSink(
       commitStrategy_(commitStrategy),
       maxOpenWriters_(
           HiveConfig::maxPartitionsPerWriters(connectorQueryCtx_->config())),
+      maxWriterMemory_(
+          HiveConfig::maxWriterMemory(connectorQueryCtx_->config())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty() ? std::make_unique<PartitionIdGenerator>(
@@ -300,6 +305,14 @@ HiveDataSink::HiveDataSink(
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
+    for (const auto& sortColumn :
+         insertTableHandle_->bucketProperty()->sortedBy()) {
+      sortColumnIndices_.push_back(
+          inputType_->getChildIdx(sortColumn->sortColumn()));
+      const auto& sortOrder = sortColumn->sortOrder();
+      sortCompareFlags_.push_back(
+          {sortOrder.isNullsFirst(), sortOrder.isAscending(), false, false});
+    }
   }
   VELOX_USER_CHECK(
       (commitStrategy_ == CommitStrategy::kNoCommit) ||
@@ -312,8 +325,8 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   // Write to unpartitioned table.
   if (!isPartitioned()) {
     const auto index = ensureWriter(HiveWriterId::unpartitionedId());
-    writers_[index]->write(input);
-    writerInfo_[index]->numWrittenRows += input->size();
+    write(index, input);
+    maybeFlushWriters();
     return;
   }
 
@@ -329,8 +342,8 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   // be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
     const auto index = ensureWriter(HiveWriterId{0});
-    writers_[index]->write(input);
-    writerInfo_[index]->numWrittenRows += input->size();
+    write(index, input);
+    maybeFlushWriters();
     return;
   }
 
@@ -345,9 +358,78 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     RowVectorPtr writerInput = partitionSize == input->size()
         ? input
         : exec::wrap(partitionSize, partitionRows_[index], input);
-    writers_[index]->write(writerInput);
-    writerInfo_[index]->numWrittenRows += partitionSize;
+    write(index, writerInput);
+  }
+  maybeFlushWriters();
+}
+
+void HiveDataSink::write(uint32_t index, const RowVectorPtr& input) {
+  if (isSorted()) {
+    sortBuffers_[index]->addInput(input);
+  } else {
+    writers_[index]->write(input);
+  }
+  writerInfo_[index]->numWrittenRows += input->size();
+}
+
+void HiveDataSink::maybeFlushWriters() {
+  if (maxWriterMemory_ == 0) {
+    return;
+  }
+  uint64_t writerBytes = 0;
+  for (const auto& pool : writerPools_) {
+    writerBytes += pool->currentBytes();
+  }
+  if (writerBytes > maxWriterMemory_) {
+    flushLargestWriters(writerBytes - maxWriterMemory_);
+  }
+}
+
+uint64_t HiveDataSink::flushLargestWriters(uint64_t targetBytes) {
+  // Flushing the largest writers first frees memory with the fewest and the
+  // largest stripes.
+  std::vector<std::pair<int64_t, uint32_t>> writerBytes;
+  writerBytes.reserve(writers_.size());
+  for (uint32_t index = 0; index < writers_.size(); ++index) {
+    writerBytes.emplace_back(writerPools_[index]->currentBytes(), index);
   }
+  std::sort(writerBytes.begin(), writerBytes.end(), std::greater<>());
+
+  uint64_t freedBytes = 0;
+  for (const auto& [bytes, index] : writerBytes) {
+    if (bytes == 0 || (targetBytes != 0 && freedBytes >= targetBytes)) {
+      break;
+    }
+    writers_[index]->flush();
+    freedBytes +=
+        std::max<int64_t>(0, bytes - writerPools_[index]->currentBytes());
+  }
+  return freedBytes;
+}
+
+uint64_t HiveDataSink::reclaim(uint64_t targetBytes) {
+  return flushLargestWriters(targetBytes);
+}
+
+std::optional<exec::Spiller::Config> HiveDataSink::makeSortSpillConfig(
+    uint32_t index) const {
+  const auto* spillConfig = connectorQueryCtx_->spillConfig();
+  if (spillConfig == nullptr) {
+    return std::nullopt;
+  }
+  // The sort buffers spill into separate files. A sort buffer has a single
+  // spill partition, so the hash bits and spill levels are not used.
+  return exec::Spiller::Config(
+      fmt::format("{}-sort-{}", spillConfig->filePath, index),
+      spillConfig->maxFileSize,
+      spillConfig->minSpillRunSize,
+      spillConfig->executor,
+      spillConfig->spillableReservationGrowthPct,
+      exec::HashBitRange(),
+      0,
+      spillConfig->testSpillPct,
+      exec::SpillCodecOptions{
+          spillConfig->compressionKind, spillConfig->checksumEnabled});
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
@@ -391,8 +473,18 @@ std::vector<std::string> HiveDataSink::finish() const {
 }
 
 void HiveDataSink::close() {
-  for (const auto& writer : writers_) {
-    writer->close();
+  for (auto index = 0; index < writers_.size(); ++index) {
+    if (isSorted()) {
+      // Writes the rows of the bucket file in sort order, merging any spilled
+      // runs.
+      auto& sortBuffer = sortBuffers_[index];
+      sortBuffer->noMoreInput();
+      while (auto output = sortBuffer->getOutput()) {
+        writers_[index]->write(output);
+      }
+      sortBuffer.reset();
+    }
+    writers_[index]->close();
   }
 }
 
@@ -427,11 +519,29 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
 
   auto writerFactory =
       dwio::common::getWriterFactory(insertTableHandle_->tableStorageFormat());
+  writerPools_.push_back(
+      connectorQueryCtx_->connectorMemoryPool()->addAggregateChild(fmt::format(
+          "{}.writer{}", connectorQueryCtx_->taskId(), writers_.size())));
   dwio::common::WriterOptions options;
   options.schema = inputType_;
-  options.memoryPool = connectorQueryCtx_->connectorMemoryPool();
+  options.memoryPool = writerPools_.back().get();
   writers_.emplace_back(writerFactory->createWriter(
       dwio::common::DataSink::create(writePath), options));
+  if (isSorted()) {
+    const auto index = writers_.size() - 1;
+    sortPools_.push_back(
+        connectorQueryCtx_->connectorMemoryPool()->addLeafChild(
+            fmt::format("{}.sort{}", connectorQueryCtx_->taskId(), index)));
+    sortBuffers_.push_back(std::make_unique<exec::SortBuffer>(
+        inputType_,
+        sortColumnIndices_,
+        sortCompareFlags_,
+        kSortedWriteBatchRows,
+        sortPools_.back().get(),
+        makeSortSpillConfig(index),
+        HiveConfig::sortWriterSpillMemoryThreshold(
+            connectorQueryCtx_->config())));
+  }
 
   writerIndexMap_.emplace(id, writers_.size() - 1);
   return writerIndexMap_[id];
@@ -442,34 +552,65 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
   if (isBucketed()) {
     VELOX_CHECK_EQ(bucketIds_.size(), partitionIds_.size());
   }
-  std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
-
   const auto numRows = partitionIds_.size();
+
+  // Finds the writer of each row and counts the rows of each writer. A row
+  // with the partition and bucket of the previous row reuses its writer.
+  rowWriterIndices_.resize(numRows);
+  std::optional<HiveWriterId> previousId;
+  uint32_t previousIndex = 0;
   for (auto row = 0; row < numRows; ++row) {
     VELOX_CHECK_LT(partitionIds_[row], std::numeric_limits<uint32_t>::max());
     const uint32_t partitionId = static_cast<uint32_t>(partitionIds_[row]);
-    const auto id = isBucketed() ? HiveWriterId{partitionId, bucketIds_[row]}
-                                 : HiveWriterId{partitionId};
-    const uint32_t index = ensureWriter(id);
-    if (FOLLY_UNLIKELY(partitionSizes_.size() <= index)) {
-      partitionSizes_.emplace_back(0);
-      partitionRows_.emplace_back(nullptr);
-      rawPartitionRows_.emplace_back(nullptr);
+    if (!isBucketed()) {
+      rowWriterIndices_[row] = ensurePartitionWriter(partitionId);
+      continue;
     }
-    if (FOLLY_UNLIKELY(partitionSizes_[index] == 0) ||
-        (partitionRows_[index]->capacity() < numRows * sizeof(vector_size_t))) {
-      partitionRows_[index] =
-          allocateIndices(numRows, connectorQueryCtx_->memoryPool());
-      rawPartitionRows_[index] =
-          partitionRows_[index]->asMutable<vector_size_t>();
+    const HiveWriterId id{partitionId, bucketIds_[row]};
+    if (!previousId.has_value() || !(id == previousId.value())) {
+      previousIndex = ensureWriter(id);
+      previousId = id;
     }
-    rawPartitionRows_[index][partitionSizes_[index]] = row;
-    ++partitionSizes_[index];
+    rowWriterIndices_[row] = previousIndex;
   }
 
+  partitionSizes_.resize(writers_.size());
+  partitionRows_.resize(writers_.size());
+  rawPartitionRows_.resize(writers_.size());
+  std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
+  for (auto row = 0; row < numRows; ++row) {
+    ++partitionSizes_[rowWriterIndices_[row]];
+  }
+
+  // Scatters the row numbers into an index buffer of the exact size for each
+  // writer. The buffers are new for each input because the writers may keep
+  // the dictionaries made over them.
   for (uint32_t i = 0; i < partitionSizes_.size(); ++i) {
-    partitionRows_[i]->setSize(partitionSizes_[i] * sizeof(vector_size_t));
+    if (partitionSizes_[i] == 0) {
+      partitionRows_[i] = nullptr;
+      rawPartitionRows_[i] = nullptr;
+      continue;
+    }
+    partitionRows_[i] =
+        allocateIndices(partitionSizes_[i], connectorQueryCtx_->memoryPool());
+    rawPartitionRows_[i] = partitionRows_[i]->asMutable<vector_size_t>();
+  }
+  std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
+  for (auto row = 0; row < numRows; ++row) {
+    const auto index = rowWriterIndices_[row];
+    rawPartitionRows_[index][partitionSizes_[index]++] = row;
+  }
+}
+
+uint32_t HiveDataSink::ensurePartitionWriter(uint32_t partitionId) {
+  if (FOLLY_UNLIKELY(partitionId >= partitionWriterIndices_.size())) {
+    partitionWriterIndices_.resize(partitionId + 1, kNoWriter);
+  }
+  auto& index = partitionWriterIndices_[partitionId];
+  if (FOLLY_UNLIKELY(index == kNoWriter)) {
+    index = ensureWriter(HiveWriterId{partitionId});
   }
+  return index;
 }
 
 HiveWriterParameters HiveDataSink::getWriterParameters(
@@ -19,6 +19,7 @@
 #include "velox/connectors/hive/PartitionIdGenerator.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
+#include "velox/exec/SortBuffer.h"
 
 namespace facebook::velox::dwrf {
 class Writer;
@@ -384,6 +385,12 @@ class HiveDataSink : public DataSink {
 
   void close() override;
 
+  bool canReclaim() const override {
+    return true;
+  }
+
+  uint64_t reclaim(uint64_t targetBytes) override;
+
  private:
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
@@ -399,6 +406,29 @@ class HiveDataSink : public DataSink {
     return commitStrategy_ != CommitStrategy::kNoCommit;
   }
 
+  // Returns true if the rows of each bucket file are sorted.
+  FOLLY_ALWAYS_INLINE bool isSorted() const {
+    return !sortColumnIndices_.empty();
+  }
+
+  // Writes 'input' with the writer at 'index' or, if the table is sorted,
+  // adds it to the sort buffer of the writer.
+  void write(uint32_t index, const RowVectorPtr& input);
+
+  // Makes the spill config of the sort buffer of the writer at 'index' from
+  // the spill config of the connector. std::nullopt if spilling is disabled.
+  std::optional<exec::Spiller::Config> makeSortSpillConfig(
+      uint32_t index) const;
+
+  // Flushes the writers with the most buffered memory until the writers
+  // together buffer less than 'maxWriterMemory_', if set.
+  void maybeFlushWriters();
+
+  // Flushes the writers in the order of their buffered memory, largest
+  // first, until at least 'targetBytes' are freed or all writers are
+  // flushed if 'targetBytes' is 0. Returns the number of bytes freed.
+  uint64_t flushLargestWriters(uint64_t targetBytes);
+
   // Compute the partition id and bucket id for each row in 'input'.
   void computePartitionAndBucketIds(const RowVectorPtr& input);
 
@@ -412,6 +442,10 @@ class HiveDataSink : public DataSink {
   // returns the corresponding index in 'writers_'.
   uint32_t ensureWriter(const HiveWriterId& id);
 
+  // Same as ensureWriter() for a partition of a table that is not bucketed.
+  // Looks up the writer by partition id in 'partitionWriterIndices_'.
+  uint32_t ensurePartitionWriter(uint32_t partitionId);
+
   // Appends a new writer for the given 'id'. The function returns the index of
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
@@ -437,10 +471,15 @@ class HiveDataSink : public DataSink {
   const ConnectorQueryCtx* connectorQueryCtx_;
   const CommitStrategy commitStrategy_;
   const uint32_t maxOpenWriters_;
+  const uint64_t maxWriterMemory_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   const int32_t bucketCount_{0};
   const std::unique_ptr<core::PartitionFunction> bucketFunction_;
+  // The channels in 'inputType_' and the compare flags of the sorted by
+  // columns of a sorted table. Empty if the table is not sorted.
+  std::vector<column_index_t> sortColumnIndices_;
+  std::vector<CompareFlags> sortCompareFlags_;
 
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
   folly::F14FastMap<HiveWriterId, uint32_t, HiveWriterIdHasher, HiveWriterIdEq>
@@ -449,12 +488,25 @@ class HiveDataSink : public DataSink {
   // Below are structures for partitions from all inputs. writerInfo_ and
   // writers_ are both indexed by partitionId.
   std::vector<std::shared_ptr<HiveWriterInfo>> writerInfo_;
+  // The memory pool of each writer in 'writers_', which tells how much memory
+  // the writer buffers.
+  std::vector<std::shared_ptr<memory::MemoryPool>> writerPools_;
   std::vector<std::unique_ptr<dwio::common::Writer>> writers_;
+  // The memory pools and sort buffers of 'writers_' if the table is sorted.
+  // The rows of a bucket file are buffered and written sorted on close.
+  std::vector<std::shared_ptr<memory::MemoryPool>> sortPools_;
+  std::vector<std::unique_ptr<exec::SortBuffer>> sortBuffers_;
+
+  // The writer index of each partition id of a table that is not bucketed,
+  // or kNoWriter if the partition has no writer yet.
+  static constexpr uint32_t kNoWriter = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> partitionWriterIndices_;
 
   // Below are structures updated when processing current input. partitionIds_
-  // are indexed by the row of input_. partitionRows_, rawPartitionRows_ and
-  // partitionSizes_ are indexed by partitionId.
+  // and rowWriterIndices_ are indexed by the row of input_. partitionRows_,
+  // rawPartitionRows_ and partitionSizes_ are indexed by writer index.
   raw_vector<uint64_t> partitionIds_;
+  raw_vector<uint32_t> rowWriterIndices_;
   std::vector<BufferPtr> partitionRows_;
   std::vector<vector_size_t*> rawPartitionRows_;
   std::vector<vector_size_t> partitionSizes_;
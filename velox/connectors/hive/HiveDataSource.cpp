@@ -357,19 +357,24 @@ HiveDataSource::HiveDataSource(
         std::string,
         std::shared_ptr<connector::ColumnHandle>>& columnHandles,
     FileHandleFactory* fileHandleFactory,
+    std::shared_ptr<cache::FileMetadataCache> fileMetadataCache,
     velox::memory::MemoryPool* pool,
     core::ExpressionEvaluator* expressionEvaluator,
     memory::MemoryAllocator* allocator,
     const std::string& scanId,
     bool fileColumnNamesReadAsLowerCase,
+    const std::string& cacheTenant,
+    vector_size_t minAverageRunLength,
     folly::Executor* executor)
     : fileHandleFactory_(fileHandleFactory),
+      fileMetadataCache_(std::move(fileMetadataCache)),
       readerOpts_(pool),
       pool_(pool),
       outputType_(outputType),
       expressionEvaluator_(expressionEvaluator),
       allocator_(allocator),
       scanId_(scanId),
+      cacheTenant_(cacheTenant),
       executor_(executor) {
   // Column handled keyed on the column alias, the name used in the query.
   for (const auto& [canonicalizedName, columnHandle] : columnHandles) {
@@ -442,6 +447,11 @@ HiveDataSource::HiveDataSource(
       hiveColumnHandles,
       remainingFilterInputs,
       pool_);
+  if (minAverageRunLength > 0) {
+    for (auto& child : scanSpec_->children()) {
+      child->setMinAverageRunLength(minAverageRunLength);
+    }
+  }
 
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
@@ -499,10 +509,12 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     readerOpts_.setFileFormat(split_->fileFormat);
   }
 
+  readerOpts_.setFileMetadataCache(fileMetadataCache_, split_->filePath);
   reader_ = dwio::common::getReaderFactory(readerOpts_.getFileFormat())
                 ->createReader(std::move(input), readerOpts_);
 
   emptySplit_ = false;
+  metadataRowsLeft_.reset();
   if (reader_->numberOfRows() == 0) {
     emptySplit_ = true;
     return;
@@ -572,6 +584,24 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   scanSpec_->resetCachedValues(false);
   configureRowReaderOptions(rowReaderOpts_);
   rowReader_ = createRowReader(rowReaderOpts_);
+  if (canCountFromMetadata()) {
+    metadataRowsLeft_ = rowReader_->numberOfRowsInRange();
+    if (metadataRowsLeft_.has_value()) {
+      ++runtimeStats_.metadataOnlySplits;
+    }
+  }
+}
+
+bool HiveDataSource::canCountFromMetadata() const {
+  if (outputType_->size() > 0 || remainingFilterExprSet_) {
+    return false;
+  }
+  for (const auto& child : scanSpec_->children()) {
+    if (child->filter() && !child->isConstant()) {
+      return false;
+    }
+  }
+  return true;
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
@@ -583,6 +613,24 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (metadataRowsLeft_.has_value()) {
+    // Returns the row count of the split in batches of empty rows.
+    if (*metadataRowsLeft_ == 0) {
+      metadataRowsLeft_.reset();
+      resetSplit();
+      return nullptr;
+    }
+    const auto numRows = std::min<uint64_t>(size, *metadataRowsLeft_);
+    *metadataRowsLeft_ -= numRows;
+    completedRows_ += numRows;
+    return std::make_shared<RowVector>(
+        pool_,
+        outputType_,
+        BufferPtr(nullptr),
+        static_cast<vector_size_t>(numRows),
+        std::vector<VectorPtr>{});
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -651,9 +699,25 @@ void HiveDataSource::addDynamicFilter(
   auto& fieldSpec = scanSpec_->getChildByChannel(outputChannel);
   fieldSpec.addFilter(*filter);
   scanSpec_->resetCachedValues(true);
-  if (rowReader_) {
-    rowReader_->resetFilterCaches();
+  if (!rowReader_) {
+    return;
+  }
+  // The rest of the split may be excluded by the file statistics. Otherwise
+  // the row reader drops the stripes or row groups that the new filter
+  // excludes.
+  if (split_ && !emptySplit_ &&
+      !testFilters(
+          scanSpec_.get(),
+          reader_.get(),
+          split_->filePath,
+          split_->partitionKeys,
+          partitionKeys_)) {
+    rowReader_->updateRuntimeStats(runtimeStats_);
+    emptySplit_ = true;
+    ++runtimeStats_.skippedSplits;
+    return;
   }
+  rowReader_->resetFilterCaches();
 }
 
 std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
@@ -673,6 +737,10 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
        {"numRamRead", RuntimeCounter(ioStats_->ramHit().count())},
        {"ramReadBytes",
         RuntimeCounter(ioStats_->ramHit().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numCoalescedRead",
+        RuntimeCounter(ioStats_->coalescedRead().count())},
+       {"numCoalescedRequests",
+        RuntimeCounter(ioStats_->coalescedRead().sum())},
        {"totalScanTime",
         RuntimeCounter(
             ioStats_->totalScanTime(), RuntimeCounter::Unit::kNanos)},
@@ -693,6 +761,7 @@ void HiveDataSource::setFromDataSource(
   auto source = dynamic_cast<HiveDataSource*>(sourceUnique.get());
   VELOX_CHECK(source, "Bad DataSource type");
   emptySplit_ = source->emptySplit_;
+  metadataRowsLeft_ = source->metadataRowsLeft_;
   split_ = std::move(source->split_);
   if (emptySplit_) {
     return;
@@ -787,7 +856,8 @@ HiveDataSource::createBufferedInput(
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
         asyncCache,
-        Connector::getTracker(scanId_, readerOpts.loadQuantum()),
+        Connector::getTracker(
+            scanId_, readerOpts.loadQuantum(), cacheTenant_),
         fileHandle.groupId.id(),
         ioStats_,
         executor_,
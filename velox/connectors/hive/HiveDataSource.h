@@ -36,11 +36,14 @@ class HiveDataSource : public DataSource {
           std::string,
           std::shared_ptr<connector::ColumnHandle>>& columnHandles,
       FileHandleFactory* fileHandleFactory,
+      std::shared_ptr<cache::FileMetadataCache> fileMetadataCache,
       velox::memory::MemoryPool* pool,
       core::ExpressionEvaluator* expressionEvaluator,
       memory::MemoryAllocator* allocator,
       const std::string& scanId,
       bool fileColumnNamesReadAsLowerCase,
+      const std::string& cacheTenant,
+      vector_size_t minAverageRunLength,
       folly::Executor* executor);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
@@ -103,6 +106,9 @@ class HiveDataSource : public DataSource {
 
   std::shared_ptr<HiveConnectorSplit> split_;
   FileHandleFactory* fileHandleFactory_;
+  // Parsed footers shared by the data sources of the connector. nullptr if
+  // footers are not cached.
+  const std::shared_ptr<cache::FileMetadataCache> fileMetadataCache_;
   dwio::common::ReaderOptions readerOpts_;
   memory::MemoryPool* pool_;
   VectorPtr output_;
@@ -136,6 +142,11 @@ class HiveDataSource : public DataSource {
 
   void configureRowReaderOptions(dwio::common::RowReaderOptions&) const;
 
+  // Returns true if the scan needs only the number of rows of a split, i.e.
+  // there are no output columns and the only filters are on partition keys
+  // or other constant columns, which are applied when adding the split.
+  bool canCountFromMetadata() const;
+
   const RowTypePtr outputType_;
   // Column handles for the partition key columns keyed on partition key column
   // name.
@@ -148,6 +159,10 @@ class HiveDataSource : public DataSource {
   std::unique_ptr<dwio::common::Reader> reader_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
   bool emptySplit_;
+  // Number of rows of the current split left to return without reading, if
+  // the row count is taken from the file metadata. See
+  // canCountFromMetadata().
+  std::optional<uint64_t> metadataRowsLeft_;
 
   dwio::common::RuntimeStatistics runtimeStats_;
 
@@ -162,6 +177,8 @@ class HiveDataSource : public DataSource {
 
   memory::MemoryAllocator* const allocator_;
   const std::string& scanId_;
+  // Tenant of the data cached for this scan. See cache::CacheTenant.
+  const std::string cacheTenant_;
   folly::Executor* executor_;
 };
 
@@ -65,13 +65,18 @@ void PartitionIdGenerator::run(
   computeValueIds(input, result);
 
   // Convert value IDs in 'result' into partition IDs using partitionIds
-  // mapping. Update 'result' in place.
-
-  // TODO Optimize common use case where all records belong to the same
-  // partition. VectorHashers keep track of the number of unique values, hence,
-  // we can find out if there is only one unique value for each partition key.
+  // mapping. Update 'result' in place. Rows of a partition often come in
+  // runs, e.g. when all rows belong to the same partition, so a row with the
+  // value ID of the previous row reuses its partition ID without a lookup.
+  uint64_t previousValueId = 0;
+  uint64_t previousPartitionId = 0;
   for (auto i = 0; i < numRows; ++i) {
-    auto valueId = result[i];
+    const auto valueId = result[i];
+    if (i > 0 && valueId == previousValueId) {
+      result[i] = previousPartitionId;
+      continue;
+    }
+    previousValueId = valueId;
     auto it = partitionIds_.find(valueId);
     if (it != partitionIds_.end()) {
       result[i] = it->second;
@@ -85,15 +90,19 @@ void PartitionIdGenerator::run(
 
       partitionIds_.emplace(valueId, nextPartitionId);
       savePartitionValues(nextPartitionId, input, i);
+      partitionNames_.push_back(FileUtils::makePartName(
+          extractPartitionKeyValues(partitionValues_, nextPartitionId)));
 
       result[i] = nextPartitionId;
     }
+    previousPartitionId = result[i];
   }
 }
 
-std::string PartitionIdGenerator::partitionName(uint64_t partitionId) const {
-  return FileUtils::makePartName(
-      extractPartitionKeyValues(partitionValues_, partitionId));
+const std::string& PartitionIdGenerator::partitionName(
+    uint64_t partitionId) const {
+  VELOX_CHECK_LT(partitionId, partitionNames_.size());
+  return partitionNames_[partitionId];
 }
 
 void PartitionIdGenerator::computeValueIds(
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::connector::hive {
@@ -49,8 +51,8 @@ class PartitionIdGenerator {
   /// Return partition name for the given partition id in the typical Hive
   /// style. It is derived from the partitionValues_ at index partitionId.
   /// Partition keys appear in the order of partition columns in the table
-  /// schema.
-  std::string partitionName(uint64_t partitionId) const;
+  /// schema. The name is made once when the partition is first seen.
+  const std::string& partitionName(uint64_t partitionId) const;
 
  private:
   static constexpr const int32_t kHasherReservePct = 20;
@@ -80,12 +82,15 @@ class PartitionIdGenerator {
   std::vector<std::unique_ptr<exec::VectorHasher>> hashers_;
 
   // A mapping from value ID produced by VectorHashers to a partition ID.
-  std::unordered_map<uint64_t, uint64_t> partitionIds_;
+  folly::F14FastMap<uint64_t, uint64_t> partitionIds_;
 
   // A vector holding unique partition key values. One row per partition. Row
   // numbers match partition IDs.
   RowVectorPtr partitionValues_;
 
+  // Partition names indexed by partition ID.
+  std::vector<std::string> partitionNames_;
+
   // All rows are set valid to compute partition IDs for all input rows.
   SelectivityVector allRows_;
 };
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/connectors/hive/storage_adapters/hdfs/HdfsFileSystem.h"
+#include <folly/executors/IOThreadPoolExecutor.h>
 #include <hdfs/hdfs.h>
 #include <mutex>
 #include "folly/concurrency/ConcurrentHashMap.h"
@@ -28,20 +29,39 @@ std::mutex mtx;
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    // Reads the blocks on the local datanode directly from the block files,
+    // with file descriptors passed over the domain socket of the datanode.
+    if (config != nullptr && config->get<bool>(kShortCircuitRead, false)) {
+      const auto socketPath = config->get(kDomainSocketPath);
+      VELOX_CHECK(
+          socketPath.hasValue(),
+          "{} is required for short-circuit reads",
+          kDomainSocketPath);
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", socketPath->c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
         "Unable to connect to HDFS: {}, got error: {}.",
         endpoint.identity(),
         hdfsGetLastError())
+    const auto numReadThreads =
+        config != nullptr ? config->get<int32_t>(kReadThreads, 8) : 8;
+    if (numReadThreads > 0) {
+      readExecutor_ =
+          std::make_unique<folly::IOThreadPoolExecutor>(numReadThreads);
+    }
   }
 
   ~Impl() {
+    // The reads in flight use the client.
+    readExecutor_.reset();
     LOG(INFO) << "Disconnecting HDFS file system";
     int disconnectResult = hdfsDisconnect(hdfsClient_);
     if (disconnectResult != 0) {
@@ -54,8 +74,13 @@ class HdfsFileSystem::Impl {
     return hdfsClient_;
   }
 
+  folly::Executor* readExecutor() const {
+    return readExecutor_.get();
+  }
+
  private:
   hdfsFS hdfsClient_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> readExecutor_;
 };
 
 HdfsFileSystem::HdfsFileSystem(
@@ -79,7 +104,8 @@ std::unique_ptr<ReadFile> HdfsFileSystem::openFileForRead(
     path.remove_prefix(index);
   }
 
-  return std::make_unique<HdfsReadFile>(impl_->hdfsClient(), path);
+  return std::make_unique<HdfsReadFile>(
+      impl_->hdfsClient(), path, impl_->readExecutor());
 }
 
 std::unique_ptr<WriteFile> HdfsFileSystem::openFileForWrite(
@@ -45,6 +45,20 @@ class HdfsFileSystem : public FileSystem {
   static std::string_view kScheme;
 
  public:
+  /// Number of threads that read the ranges of a preadv in parallel. 0 reads
+  /// them one after the other on the calling thread.
+  static constexpr const char* kReadThreads = "hive.hdfs.read-threads";
+
+  /// Whether to read local blocks directly from the datanode's block files
+  /// (short-circuit local reads). Requires kDomainSocketPath.
+  static constexpr const char* kShortCircuitRead =
+      "hive.hdfs.short-circuit-read";
+
+  /// The UNIX domain socket of the local datanode, e.g.
+  /// /var/lib/hadoop-hdfs/dn_socket.
+  static constexpr const char* kDomainSocketPath =
+      "hive.hdfs.domain-socket-path";
+
   explicit HdfsFileSystem(
       const std::shared_ptr<const Config>& config,
       const HdfsServiceEndpoint& endpoint);
@@ -15,13 +15,18 @@
  */
 
 #include "HdfsReadFile.h"
+#include <folly/futures/Future.h>
+#include <folly/io/IOBuf.h>
 #include <folly/synchronization/CallOnce.h>
 #include <hdfs/hdfs.h>
 
 namespace facebook::velox {
 
-HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
-    : hdfsClient_(hdfs), filePath_(path) {
+HdfsReadFile::HdfsReadFile(
+    hdfsFS hdfs,
+    const std::string_view path,
+    folly::Executor* executor)
+    : hdfsClient_(hdfs), filePath_(path), executor_(executor) {
   fileInfo_ = hdfsGetPathInfo(hdfsClient_, filePath_.data());
   VELOX_CHECK_NOT_NULL(
       fileInfo_,
@@ -33,34 +38,98 @@ HdfsReadFile::HdfsReadFile(hdfsFS hdfs, const std::string_view path)
 void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     const {
   checkFileReadParameters(offset, length);
-  auto file = hdfsOpenFile(hdfsClient_, filePath_.data(), O_RDONLY, 0, 0, 0);
+  readAt(hdfsClient_, filePath_, offset, length, pos);
+}
+
+// static
+void HdfsReadFile::readAt(
+    hdfsFS hdfs,
+    const std::string& path,
+    uint64_t offset,
+    uint64_t length,
+    char* pos) {
+  auto file = hdfsOpenFile(hdfs, path.data(), O_RDONLY, 0, 0, 0);
   VELOX_CHECK_NOT_NULL(
-      file,
-      "Unable to open file {}. got error: {}",
-      filePath_,
-      hdfsGetLastError());
-  seekToPosition(file, offset);
+      file, "Unable to open file {}. got error: {}", path, hdfsGetLastError());
+  auto seekStatus = hdfsSeek(hdfs, file, offset);
+  VELOX_CHECK_EQ(
+      seekStatus,
+      0,
+      "Cannot seek through HDFS file: {}, error: {}",
+      path,
+      std::string(hdfsGetLastError()));
   uint64_t totalBytesRead = 0;
   while (totalBytesRead < length) {
-    auto bytesRead = hdfsRead(hdfsClient_, file, pos, length - totalBytesRead);
+    auto bytesRead = hdfsRead(hdfs, file, pos, length - totalBytesRead);
     VELOX_CHECK(bytesRead >= 0, "Read failure in HDFSReadFile::preadInternal.")
     totalBytesRead += bytesRead;
     pos += bytesRead;
   }
 
-  if (hdfsCloseFile(hdfsClient_, file) == -1) {
+  if (hdfsCloseFile(hdfs, file) == -1) {
     LOG(ERROR) << "Unable to close file, errno: " << errno;
   }
 }
 
-void HdfsReadFile::seekToPosition(hdfsFile file, uint64_t offset) const {
-  auto seekStatus = hdfsSeek(hdfsClient_, file, offset);
-  VELOX_CHECK_EQ(
-      seekStatus,
-      0,
-      "Cannot seek through HDFS file: {}, error: {}",
-      filePath_,
-      std::string(hdfsGetLastError()));
+void HdfsReadFile::readParallel(const std::vector<Read>& reads) const {
+  if (executor_ == nullptr || reads.size() < 2) {
+    for (const auto& read : reads) {
+      preadInternal(read.offset, read.length, read.buffer);
+    }
+    return;
+  }
+  for (const auto& read : reads) {
+    checkFileReadParameters(read.offset, read.length);
+  }
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(reads.size() - 1);
+  for (size_t i = 1; i < reads.size(); ++i) {
+    futures.push_back(
+        folly::via(executor_, [this, read = reads[i]]() {
+          readAt(hdfsClient_, filePath_, read.offset, read.length, read.buffer);
+        }).semi());
+  }
+  std::exception_ptr error;
+  try {
+    readAt(
+        hdfsClient_,
+        filePath_,
+        reads[0].offset,
+        reads[0].length,
+        reads[0].buffer);
+  } catch (const std::exception&) {
+    error = std::current_exception();
+  }
+  // Waits for all the reads before throwing since they write to the caller's
+  // buffers.
+  auto results = folly::collectAll(std::move(futures)).get();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  for (auto& result : results) {
+    result.value();
+  }
+}
+
+std::vector<HdfsReadFile::Read> HdfsReadFile::toReads(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    uint64_t& numBytes) const {
+  const auto fileSize = size();
+  std::vector<Read> reads;
+  numBytes = 0;
+  for (const auto& range : buffers) {
+    if (offset >= fileSize) {
+      break;
+    }
+    const auto length = std::min<uint64_t>(range.size(), fileSize - offset);
+    if (range.data() != nullptr && length > 0) {
+      reads.push_back({offset, length, range.data()});
+    }
+    offset += length;
+    numBytes += length;
+  }
+  return reads;
 }
 
 std::string_view
@@ -76,6 +145,71 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
   return result;
 }
 
+uint64_t HdfsReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  uint64_t numBytes;
+  readParallel(toReads(offset, buffers, numBytes));
+  return numBytes;
+}
+
+void HdfsReadFile::preadv(const std::vector<Segment>& segments) const {
+  std::vector<Read> reads;
+  reads.reserve(segments.size());
+  for (const auto& segment : segments) {
+    reads.push_back(
+        {segment.offset, segment.buffer.size(), segment.buffer.data()});
+  }
+  readParallel(reads);
+}
+
+void HdfsReadFile::preadv(
+    const std::vector<common::Region>& regions,
+    folly::IOBuf* output) const {
+  std::vector<Read> reads;
+  reads.reserve(regions.size());
+  for (size_t i = 0; i < regions.size(); ++i) {
+    output[i] = folly::IOBuf(folly::IOBuf::CREATE, regions[i].length);
+    output[i].append(regions[i].length);
+    reads.push_back(
+        {regions[i].offset,
+         regions[i].length,
+         reinterpret_cast<char*>(output[i].writableData())});
+  }
+  readParallel(reads);
+}
+
+folly::SemiFuture<uint64_t> HdfsReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  if (executor_ == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  uint64_t numBytes;
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  for (const auto& read : toReads(offset, buffers, numBytes)) {
+    futures.push_back(folly::via(
+                          executor_,
+                          [hdfs = hdfsClient_, path = filePath_, read]() {
+                            readAt(
+                                hdfs,
+                                path,
+                                read.offset,
+                                read.length,
+                                read.buffer);
+                          })
+                          .semi());
+  }
+  return folly::collectAll(std::move(futures))
+      .deferValue(
+          [numBytes](std::vector<folly::Try<folly::Unit>>&& results) {
+            for (auto& result : results) {
+              result.value();
+            }
+            return numBytes;
+          });
+}
+
 uint64_t HdfsReadFile::size() const {
   return fileInfo_->mSize;
 }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Executor.h>
 #include <hdfs/hdfs.h>
 #include "velox/common/file/File.h"
 
@@ -21,13 +22,36 @@ namespace facebook::velox {
 
 class HdfsReadFile final : public ReadFile {
  public:
-  explicit HdfsReadFile(hdfsFS hdfs, std::string_view path);
+  // The ranges of a preadv are read in parallel on 'executor' if set. Each
+  // read opens its own handle, so reads do not share a file position.
+  explicit HdfsReadFile(
+      hdfsFS hdfs,
+      std::string_view path,
+      folly::Executor* executor = nullptr);
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buf)
       const final;
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  void preadv(const std::vector<Segment>& segments) const final;
+
+  void preadv(
+      const std::vector<common::Region>& regions,
+      folly::IOBuf* output) const final;
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return executor_ != nullptr;
+  }
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -43,11 +67,38 @@ class HdfsReadFile final : public ReadFile {
   }
 
  private:
+  struct Read {
+    uint64_t offset;
+    uint64_t length;
+    char* buffer;
+  };
+
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
-  void seekToPosition(hdfsFile file, uint64_t offset) const;
+
+  // Reads [offset, offset + length) of 'path' into 'pos' with a handle of
+  // its own. Static so that asynchronous reads do not refer to the file.
+  static void readAt(
+      hdfsFS hdfs,
+      const std::string& path,
+      uint64_t offset,
+      uint64_t length,
+      char* pos);
+
+  // Reads all 'reads' and returns when they are done. All but the first run
+  // on 'executor_' and the first on the calling thread.
+  void readParallel(const std::vector<Read>& reads) const;
+
+  // Returns the reads for the non-gap ranges of 'buffers' from 'offset',
+  // clipped to the file size. Sets 'numBytes' to the bytes covered.
+  std::vector<Read> toReads(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      uint64_t& numBytes) const;
+
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
   hdfsFS hdfsClient_;
   hdfsFileInfo* fileInfo_;
   std::string filePath_;
+  folly::Executor* const executor_;
 };
 } // namespace facebook::velox
@@ -187,6 +187,57 @@ TEST_F(HdfsFileSystemTest, viaFileSystem) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, parallelPreadv) {
+  auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
+  auto hdfsFileSystem =
+      filesystems::getFileSystem(fullDestinationPath, memConfig);
+  auto readFile = hdfsFileSystem->openFileForRead(fullDestinationPath);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  std::string head(12, 0);
+  std::string middle(4, 0);
+  std::string tail(7, 0);
+  const uint64_t gap = 500'000;
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(middle.data(), middle.size()),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(15 + kOneMB - gap - head.size() - middle.size() -
+                  tail.size())),
+      folly::Range<char*>(tail.data(), tail.size())};
+  auto check = [&]() {
+    EXPECT_EQ(head, "aaaaabbbbbcc");
+    EXPECT_EQ(middle, "cccc");
+    EXPECT_EQ(tail, "ccddddd");
+    head.assign(head.size(), 0);
+    middle.assign(middle.size(), 0);
+    tail.assign(tail.size(), 0);
+  };
+  ASSERT_EQ(15 + kOneMB, readFile->preadv(0, buffers));
+  check();
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  check();
+
+  std::vector<folly::IOBuf> iobufs(2);
+  readFile->preadv({{0, 5}, {10 + kOneMB, 5}}, iobufs.data());
+  EXPECT_EQ("aaaaa", iobufs[0].moveToFbString().toStdString());
+  EXPECT_EQ("ddddd", iobufs[1].moveToFbString().toStdString());
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitReadWithoutSocket) {
+  auto config = configurationValues;
+  config[filesystems::HdfsFileSystem::kShortCircuitRead] = "true";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  VELOX_ASSERT_THROW(
+      std::make_shared<filesystems::HdfsFileSystem>(
+          memConfig,
+          filesystems::HdfsFileSystem::getServiceEndpoint(
+              fullDestinationPath, memConfig.get())),
+      "hive.hdfs.domain-socket-path is required for short-circuit reads");
+}
+
 TEST_F(HdfsFileSystemTest, initializeFsWithEndpointInfoInFilePath) {
   filesystems::registerHdfsFileSystem();
   // Without host/port configured.
@@ -15,25 +15,42 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/ReadCostEstimator.h"
+#include "velox/common/file/ReadHedgingPolicy.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
 #include <aws/core/auth/AWSCredentialsProviderChain.h>
+#include <aws/core/client/DefaultRetryStrategy.h>
+#include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
 #include <aws/s3/model/GetObjectRequest.h>
 #include <aws/s3/model/HeadObjectRequest.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
 
 namespace facebook::velox {
 namespace {
@@ -60,10 +77,117 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// The GETs of the same bytes of a preadvAsync: the first and possibly a
+// hedge, i.e. a duplicate that is sent if the first is slow. The first GET
+// writes directly into 'ranges'. The hedge writes into 'hedgeBuffer'. If the
+// hedge finishes first, its data is copied to 'ranges' under 'mutex' after
+// setting 'cancelled', which stops the writes of the first GET.
+struct HedgedGet {
+  std::mutex mutex;
+  bool cancelled{false};
+  // Set when the outcome of the read is known. Stops the GET still running.
+  std::atomic<bool> finished{false};
+  int32_t numPending{1};
+  bool hedged{false};
+  bool hedgeWon{false};
+  std::vector<folly::Range<char*>> ranges;
+  std::string hedgeBuffer;
+  folly::Promise<folly::Unit> promise;
+};
+
+// A write-only stream buffer that fills 'ranges' left to right. The bytes
+// for a range with nullptr data are discarded. If 'get' is set, writes are
+// refused after the hedge of 'get' has won. The writes of the SDK come
+// through sputn().
+class ScatterStreamBuf : public std::streambuf {
+ public:
+  explicit ScatterStreamBuf(
+      std::vector<folly::Range<char*>> ranges,
+      std::shared_ptr<HedgedGet> get = nullptr)
+      : ranges_(std::move(ranges)), get_(std::move(get)) {
+    nextRange();
+  }
+
+ protected:
+  std::streamsize xsputn(const char* data, std::streamsize size) override {
+    if (get_ == nullptr) {
+      return std::streambuf::xsputn(data, size);
+    }
+    std::lock_guard<std::mutex> l(get_->mutex);
+    if (get_->cancelled) {
+      return 0;
+    }
+    return std::streambuf::xsputn(data, size);
+  }
+
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+      return traits_type::not_eof(c);
+    }
+    if (!nextRange()) {
+      return traits_type::eof();
+    }
+    *pptr() = traits_type::to_char_type(c);
+    pbump(1);
+    return c;
+  }
+
+ private:
+  // Sets the put area to the next range or to 'discard_' for a gap. Returns
+  // false if all the ranges are full.
+  bool nextRange() {
+    while (gapBytes_ == 0 && index_ < ranges_.size()) {
+      const auto& range = ranges_[index_++];
+      if (range.data() == nullptr) {
+        gapBytes_ = range.size();
+      } else if (!range.empty()) {
+        setp(range.data(), range.data() + range.size());
+        return true;
+      }
+    }
+    if (gapBytes_ == 0) {
+      return false;
+    }
+    const auto bytes = std::min<uint64_t>(gapBytes_, sizeof(discard_));
+    gapBytes_ -= bytes;
+    setp(discard_, discard_ + bytes);
+    return true;
+  }
+
+  const std::vector<folly::Range<char*>> ranges_;
+  const std::shared_ptr<HedgedGet> get_;
+  size_t index_{0};
+  // Bytes of the current gap that are not yet discarded.
+  uint64_t gapBytes_{0};
+  char discard_[4096];
+};
+
+// The response stream of a GET that covers several buffers of a
+// preadvAsync.
+class ScatterStream : ScatterStreamBuf, public std::iostream {
+ public:
+  explicit ScatterStream(
+      std::vector<folly::Range<char*>> ranges,
+      std::shared_ptr<HedgedGet> get = nullptr)
+      : ScatterStreamBuf(std::move(ranges), std::move(get)),
+        std::iostream(this) {}
+};
+
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // 'hedging' decides when to duplicate a slow GET of preadvAsync. nullptr
+  // means no hedging. 'readCost' learns the latency and bandwidth of the
+  // GETs.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      uint64_t readPartSize,
+      ReadHedgingPolicy* hedging,
+      ReadCostEstimator* readCost)
+      : client_(client),
+        readPartSize_(std::max<uint64_t>(1, readPartSize)),
+        hedging_(hedging),
+        readCost_(readCost) {
     bucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -125,6 +249,61 @@ class S3ReadFile final : public ReadFile {
     return length;
   }
 
+  // Reads with concurrent ranged GETs of at most 'readPartSize_' bytes each.
+  // The data goes directly into 'buffers'. The GETs run on the executor of
+  // the S3 client, so no caller thread waits on S3. A GET that is slower
+  // than 'hedging_' allows is duplicated and the first response wins.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    std::vector<folly::SemiFuture<HedgeStats>> futures;
+    std::vector<folly::Range<char*>> ranges;
+    uint64_t partOffset = offset;
+    uint64_t partBytes = 0;
+    for (const auto& buffer : buffers) {
+      uint64_t bufferOffset = 0;
+      while (bufferOffset < buffer.size()) {
+        const auto bytes = std::min<uint64_t>(
+            buffer.size() - bufferOffset, readPartSize_ - partBytes);
+        ranges.emplace_back(
+            buffer.data() ? buffer.data() + bufferOffset : nullptr, bytes);
+        bufferOffset += bytes;
+        partBytes += bytes;
+        if (partBytes == readPartSize_) {
+          futures.push_back(getAsync(partOffset, std::move(ranges)));
+          ranges.clear();
+          partOffset += partBytes;
+          partBytes = 0;
+        }
+      }
+    }
+    if (partBytes > 0) {
+      futures.push_back(getAsync(partOffset, std::move(ranges)));
+    }
+    const uint64_t length = partOffset + partBytes - offset;
+    // All the GETs must finish before the result is set, since the caller may
+    // free 'buffers' on error.
+    return folly::collectAll(std::move(futures))
+        .deferValue([length](std::vector<folly::Try<HedgeStats>>&& results) {
+          HedgeStats stats;
+          for (auto& result : results) {
+            stats.numHedges += result.value().numHedges;
+            stats.numHedgeWins += result.value().numHedgeWins;
+          }
+          if (stats.numHedges > 0) {
+            addThreadLocalRuntimeStat(
+                "s3NumHedgedGets", RuntimeCounter(stats.numHedges));
+            addThreadLocalRuntimeStat(
+                "s3NumHedgeWins", RuntimeCounter(stats.numHedgeWins));
+          }
+          return length;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return true;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -147,6 +326,10 @@ class S3ReadFile final : public ReadFile {
     return 72 << 20;
   }
 
+  std::optional<ReadCost> readCost() const final {
+    return readCost_->estimate();
+  }
+
  private:
   // The assumption here is that "position" has space for at least "length"
   // bytes.
@@ -162,16 +345,417 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
+    const auto start = std::chrono::steady_clock::now();
     auto outcome = client_->GetObject(request);
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    readCost_->record(
+        length,
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start));
+  }
+
+  struct HedgeStats {
+    int64_t numHedges{0};
+    int64_t numHedgeWins{0};
+  };
+
+  // Starts a GET of the bytes of 'ranges' from 'offset' and schedules its
+  // hedge. Leading and trailing gaps are not read.
+  folly::SemiFuture<HedgeStats> getAsync(
+      uint64_t offset,
+      std::vector<folly::Range<char*>> ranges) const {
+    auto first = ranges.begin();
+    for (; first != ranges.end() && first->data() == nullptr; ++first) {
+      offset += first->size();
+    }
+    while (ranges.end() != first && ranges.back().data() == nullptr) {
+      ranges.pop_back();
+    }
+    ranges.erase(ranges.begin(), first);
+    uint64_t length = 0;
+    for (const auto& range : ranges) {
+      length += range.size();
+    }
+    if (length == 0) {
+      return folly::makeSemiFuture(HedgeStats{});
+    }
+
+    auto get = std::make_shared<HedgedGet>();
+    get->ranges = std::move(ranges);
+    auto future = get->promise.getSemiFuture().deferValue([get](auto&&) {
+      return HedgeStats{get->hedged, get->hedgeWon};
+    });
+    startGet(
+        get,
+        client_,
+        bucket_,
+        key_,
+        offset,
+        length,
+        hedging_,
+        readCost_,
+        false);
+    if (hedging_ == nullptr) {
+      return future;
+    }
+    hedging_->recordRead();
+    const auto delay = hedging_->hedgeDelay();
+    if (!delay.has_value()) {
+      return future;
+    }
+    // The file may be gone when the timer fires, so the lambda does not
+    // refer to 'this'.
+    folly::futures::sleep(*delay).toUnsafeFuture().thenValue(
+        [get,
+         client = client_,
+         bucket = bucket_,
+         key = key_,
+         hedging = hedging_,
+         readCost = readCost_,
+         offset,
+         length](auto&&) {
+          {
+            std::lock_guard<std::mutex> l(get->mutex);
+            if (get->finished || !hedging->tryHedge()) {
+              return;
+            }
+            get->hedged = true;
+            ++get->numPending;
+            get->hedgeBuffer.resize(length);
+          }
+          startGet(
+              get,
+              client,
+              bucket,
+              key,
+              offset,
+              length,
+              hedging,
+              readCost,
+              true);
+        });
+    return future;
+  }
+
+  // Sends a GET of 'length' bytes from 'offset' for 'get'. The first GET to
+  // succeed completes 'get'. A failure completes 'get' only if no other GET
+  // is pending.
+  static void startGet(
+      const std::shared_ptr<HedgedGet>& get,
+      Aws::S3::S3Client* client,
+      const std::string& bucket,
+      const std::string& key,
+      uint64_t offset,
+      uint64_t length,
+      ReadHedgingPolicy* hedging,
+      ReadCostEstimator* readCost,
+      bool hedge) {
+    Aws::S3::Model::GetObjectRequest request;
+    request.SetBucket(awsString(bucket));
+    request.SetKey(awsString(key));
+    request.SetRange(
+        awsString(fmt::format("bytes={}-{}", offset, offset + length - 1)));
+    // The factory is called again for each retry.
+    if (hedge) {
+      request.SetResponseStreamFactory([get]() {
+        return Aws::New<ScatterStream>(
+            "",
+            std::vector<folly::Range<char*>>{folly::Range<char*>(
+                get->hedgeBuffer.data(), get->hedgeBuffer.size())});
+      });
+    } else {
+      request.SetResponseStreamFactory(
+          [get, guarded = hedging != nullptr]() {
+            return Aws::New<ScatterStream>(
+                "", get->ranges, guarded ? get : nullptr);
+          });
+    }
+    // Stops the transfer of the GET that lost.
+    request.SetContinueRequestHandler(
+        [get](const Aws::Http::HttpRequest* /*request*/) {
+          return !get->finished;
+        });
+    const auto start = std::chrono::steady_clock::now();
+    client->GetObjectAsync(
+        request,
+        [get, bucket, key, hedging, readCost, hedge, length, start](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            const auto& outcome,
+            const auto& /*context*/) {
+          folly::exception_wrapper error;
+          {
+            std::lock_guard<std::mutex> l(get->mutex);
+            --get->numPending;
+            if (get->finished) {
+              return;
+            }
+            if (outcome.IsSuccess()) {
+              if (hedge) {
+                get->cancelled = true;
+                get->hedgeWon = true;
+                uint64_t position = 0;
+                for (const auto& range : get->ranges) {
+                  if (range.data() != nullptr) {
+                    memcpy(
+                        range.data(),
+                        get->hedgeBuffer.data() + position,
+                        range.size());
+                  }
+                  position += range.size();
+                }
+              }
+            } else if (get->numPending > 0) {
+              return;
+            } else {
+              try {
+                VELOX_CHECK_AWS_OUTCOME(
+                    outcome, "Failed to get S3 object", bucket, key);
+              } catch (const std::exception&) {
+                error = folly::exception_wrapper(std::current_exception());
+              }
+            }
+            get->finished = true;
+          }
+          if (error) {
+            get->promise.setException(std::move(error));
+            return;
+          }
+          const auto latency =
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::steady_clock::now() - start);
+          readCost->record(length, latency);
+          if (hedging != nullptr) {
+            hedging->recordLatency(latency);
+          }
+          get->promise.setValue();
+        });
   }
 
   Aws::S3::S3Client* client_;
+  const uint64_t readPartSize_;
+  ReadHedgingPolicy* const hedging_;
+  ReadCostEstimator* const readCost_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
 };
 
+// Writes an S3 object with a multipart upload. Appended data is buffered in
+// parts of 'partSize' bytes allocated from 'pool'. A full part is uploaded
+// asynchronously by the S3 client while the appends continue. When
+// 'maxUploadsInFlight' parts are pending, the next full part waits for the
+// oldest to finish. An object smaller than one part is written with a single
+// PutObject on close(). If the file is destroyed without close(), the upload
+// is aborted.
+class S3WriteFile final : public WriteFile {
+ public:
+  // The minimum size of all but the last part of a multipart upload.
+  static constexpr uint64_t kMinPartSize = 5 << 20;
+
+  S3WriteFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      memory::MemoryPool* pool,
+      uint64_t partSize,
+      uint32_t maxUploadsInFlight)
+      : client_(client),
+        ownedPool_(pool ? nullptr : memory::addDefaultLeafMemoryPool()),
+        pool_(pool ? pool : ownedPool_.get()),
+        partSize_(partSize),
+        maxUploadsInFlight_(std::max<uint32_t>(1, maxUploadsInFlight)) {
+    VELOX_USER_CHECK_GE(
+        partSize_, kMinPartSize, "S3 upload part size is below 5MB");
+    bucketAndKeyFromS3Path(path, bucket_, key_);
+  }
+
+  ~S3WriteFile() override {
+    if (!closed_) {
+      try {
+        abort();
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Failed to abort the upload of " << getName() << ": "
+                     << e.what();
+      }
+    }
+  }
+
+  void append(std::string_view data) override {
+    VELOX_CHECK(!closed_, "Appending to a closed S3 file: {}", getName());
+    while (!data.empty()) {
+      if (buffer_ == nullptr) {
+        buffer_ = static_cast<char*>(pool_->allocate(partSize_));
+      }
+      const auto bytes = std::min<uint64_t>(data.size(), partSize_ - numBytes_);
+      memcpy(buffer_ + numBytes_, data.data(), bytes);
+      numBytes_ += bytes;
+      size_ += bytes;
+      data.remove_prefix(bytes);
+      if (numBytes_ == partSize_) {
+        uploadPart();
+      }
+    }
+  }
+
+  // S3 has no append to an object. The data is sent as the parts fill up and
+  // the rest on close().
+  void flush() override {}
+
+  void close() override {
+    if (closed_) {
+      return;
+    }
+    if (uploadId_.empty()) {
+      putObject();
+    } else {
+      if (numBytes_ > 0) {
+        uploadPart();
+      }
+      waitForUploads(0);
+      completeUpload();
+    }
+    freeBuffer();
+    closed_ = true;
+  }
+
+  uint64_t size() const override {
+    return size_;
+  }
+
+ private:
+  struct PendingPart {
+    int32_t partNumber;
+    char* buffer;
+    Aws::S3::Model::UploadPartOutcomeCallable outcome;
+  };
+
+  std::string getName() const {
+    return fmt::format("s3://{}/{}", bucket_, key_);
+  }
+
+  void putObject() {
+    Aws::S3::Model::PutObjectRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetContentLength(numBytes_);
+    if (numBytes_ > 0) {
+      request.SetBody(std::make_shared<StringViewStream>(buffer_, numBytes_));
+    } else {
+      request.SetBody(std::make_shared<Aws::StringStream>());
+    }
+    auto outcome = client_->PutObject(request);
+    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to put S3 object", bucket_, key_);
+  }
+
+  void createUpload() {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    auto outcome = client_->CreateMultipartUpload(request);
+    VELOX_CHECK_AWS_OUTCOME(
+        outcome, "Failed to create S3 multipart upload", bucket_, key_);
+    uploadId_ = outcome.GetResult().GetUploadId();
+  }
+
+  // Starts the upload of 'buffer_' as the next part. The buffer is owned by
+  // the pending part until its upload finishes.
+  void uploadPart() {
+    if (uploadId_.empty()) {
+      createUpload();
+    }
+    waitForUploads(maxUploadsInFlight_ - 1);
+    Aws::S3::Model::UploadPartRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetUploadId(uploadId_);
+    request.SetPartNumber(++numParts_);
+    request.SetContentLength(numBytes_);
+    request.SetBody(std::make_shared<StringViewStream>(buffer_, numBytes_));
+    pending_.push_back(
+        {numParts_, buffer_, client_->UploadPartCallable(request)});
+    buffer_ = nullptr;
+    numBytes_ = 0;
+  }
+
+  // Waits for the oldest uploads until at most 'maxPending' are in flight.
+  void waitForUploads(size_t maxPending) {
+    while (pending_.size() > maxPending) {
+      auto part = std::move(pending_.front());
+      pending_.pop_front();
+      auto outcome = part.outcome.get();
+      pool_->free(part.buffer, partSize_);
+      VELOX_CHECK_AWS_OUTCOME(
+          outcome, "Failed to upload S3 part", bucket_, key_);
+      Aws::S3::Model::CompletedPart completed;
+      completed.SetPartNumber(part.partNumber);
+      completed.SetETag(outcome.GetResult().GetETag());
+      completedParts_.push_back(std::move(completed));
+    }
+  }
+
+  void completeUpload() {
+    Aws::S3::Model::CompletedMultipartUpload upload;
+    upload.SetParts(completedParts_);
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.SetBucket(awsString(bucket_));
+    request.SetKey(awsString(key_));
+    request.SetUploadId(uploadId_);
+    request.SetMultipartUpload(std::move(upload));
+    auto outcome = client_->CompleteMultipartUpload(request);
+    VELOX_CHECK_AWS_OUTCOME(
+        outcome, "Failed to complete S3 multipart upload", bucket_, key_);
+  }
+
+  // Waits for the pending uploads, since they read from the buffers, then
+  // frees the buffers and aborts the upload.
+  void abort() {
+    for (auto& part : pending_) {
+      part.outcome.wait();
+      pool_->free(part.buffer, partSize_);
+    }
+    pending_.clear();
+    freeBuffer();
+    closed_ = true;
+    if (!uploadId_.empty()) {
+      Aws::S3::Model::AbortMultipartUploadRequest request;
+      request.SetBucket(awsString(bucket_));
+      request.SetKey(awsString(key_));
+      request.SetUploadId(uploadId_);
+      auto outcome = client_->AbortMultipartUpload(request);
+      VELOX_CHECK_AWS_OUTCOME(
+          outcome, "Failed to abort S3 multipart upload", bucket_, key_);
+    }
+  }
+
+  void freeBuffer() {
+    if (buffer_ != nullptr) {
+      pool_->free(buffer_, partSize_);
+      buffer_ = nullptr;
+      numBytes_ = 0;
+    }
+  }
+
+  Aws::S3::S3Client* const client_;
+  const std::shared_ptr<memory::MemoryPool> ownedPool_;
+  memory::MemoryPool* const pool_;
+  const uint64_t partSize_;
+  const uint32_t maxUploadsInFlight_;
+  std::string bucket_;
+  std::string key_;
+  Aws::String uploadId_;
+
+  // The part being filled, nullptr until the first append after a part is
+  // uploaded.
+  char* buffer_{nullptr};
+  uint64_t numBytes_{0};
+
+  int32_t numParts_{0};
+  std::deque<PendingPart> pending_;
+  Aws::Vector<Aws::S3::Model::CompletedPart> completedParts_;
+  uint64_t size_{0};
+  bool closed_{false};
+};
+
 Aws::Utils::Logging::LogLevel inferS3LogLevel(std::string level) {
   // Convert to upper case.
   std::transform(
@@ -305,6 +889,23 @@ class S3FileSystem::Impl {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
 
+    clientConfig.maxConnections = HiveConfig::s3MaxConnections(config_);
+    clientConfig.connectTimeoutMs = HiveConfig::s3ConnectTimeoutMs(config_);
+    clientConfig.requestTimeoutMs = HiveConfig::s3RequestTimeoutMs(config_);
+    clientConfig.retryStrategy =
+        std::make_shared<Aws::Client::DefaultRetryStrategy>(
+            HiveConfig::s3MaxRetries(config_));
+    // The asynchronous requests run on a pool of one thread per connection
+    // instead of a new thread per request.
+    clientConfig.executor =
+        std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+            clientConfig.maxConnections);
+
+    const auto hedgingBudget = HiveConfig::s3ReadHedgingBudget(config_);
+    if (hedgingBudget > 0) {
+      hedging_ = std::make_unique<ReadHedgingPolicy>(hedgingBudget);
+    }
+
     auto credentialsProvider = getCredentialsProvider();
 
     client_ = std::make_shared<Aws::S3::S3Client>(
@@ -325,9 +926,22 @@ class S3FileSystem::Impl {
     return GetLogLevelName(inferS3LogLevel(HiveConfig::s3GetLogLevel(config_)));
   }
 
+  // Returns the hedging policy shared by the reads of all the files, or
+  // nullptr if hedging is off.
+  ReadHedgingPolicy* hedging() const {
+    return hedging_.get();
+  }
+
+  ReadCostEstimator* readCost() {
+    return &readCost_;
+  }
+
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<ReadHedgingPolicy> hedging_;
+  // Starts from 20ms per request and 100MB/s per connection.
+  ReadCostEstimator readCost_{{20'000, 100}};
   static std::atomic<size_t> initCounter_;
 };
 
@@ -351,15 +965,26 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const std::string file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      HiveConfig::s3ReadPartSize(config_.get()),
+      impl_->hedging(),
+      impl_->readCost());
   s3file->initialize();
   return s3file;
 }
 
 std::unique_ptr<WriteFile> S3FileSystem::openFileForWrite(
     std::string_view path,
-    const FileOptions& /*unused*/) {
-  VELOX_NYI();
+    const FileOptions& options) {
+  const std::string file = s3Path(path);
+  return std::make_unique<S3WriteFile>(
+      file,
+      impl_->s3Client(),
+      options.pool,
+      HiveConfig::s3UploadPartSize(config_.get()),
+      HiveConfig::s3MaxUploadsInFlight(config_.get()));
 }
 
 std::string S3FileSystem::name() const {
@@ -17,6 +17,8 @@
 #include "velox/common/file/benchmark/ReadBenchmark.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 
+#include <deque>
+
 DECLARE_string(s3_config);
 
 namespace facebook::velox {
@@ -52,6 +54,49 @@ class S3ReadBenchmark : public ReadBenchmark {
       rng_.seed(FLAGS_seed);
     }
   }
+
+  // Measures the throughput of preadvAsync for reads of 'size' bytes at
+  // random offsets with 'concurrency' reads in flight.
+  void asyncReads(int32_t size, int32_t concurrency) {
+    const int32_t repeats =
+        std::max<int32_t>(concurrency, FLAGS_measurement_size / size);
+    std::vector<std::string> buffers(concurrency, std::string(size, 0));
+    uint64_t usec = 0;
+    {
+      MicrosecondTimer timer(&usec);
+      std::deque<folly::SemiFuture<uint64_t>> pending;
+      for (auto i = 0; i < repeats; ++i) {
+        // The oldest read in flight is the one with the buffer to reuse.
+        if (pending.size() == static_cast<size_t>(concurrency)) {
+          std::move(pending.front()).get();
+          pending.pop_front();
+        }
+        auto& buffer = buffers[i % concurrency];
+        const int64_t offset =
+            folly::Random::rand64(rng_) % (fileSize_ - size);
+        pending.push_back(readFile_->preadvAsync(
+            offset, {folly::Range<char*>(buffer.data(), size)}));
+      }
+      for (auto& future : pending) {
+        std::move(future).get();
+      }
+    }
+    std::cout << fmt::format(
+                     "{} MB/s preadvAsync Run: {} Concurrency: {}",
+                     (static_cast<float>(size) * repeats) / usec,
+                     size,
+                     concurrency)
+              << std::endl;
+  }
+
+  // Measures preadvAsync throughput against the number of reads in flight.
+  void runAsync() {
+    for (auto size : {64 << 10, 1 << 20, 8 << 20}) {
+      for (auto concurrency : {1, 4, 16, 64}) {
+        asyncReads(size, concurrency);
+      }
+    }
+  }
 };
 
 } // namespace facebook::velox
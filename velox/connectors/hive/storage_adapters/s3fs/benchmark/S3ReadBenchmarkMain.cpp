@@ -22,10 +22,12 @@ using namespace facebook::velox;
 // various ReadFile APIs. The output helps us understand the maximum possible
 // gains for queries. Example: If a single thread requires reading 1GB of data
 // and the IO throughput is 100 MBps, then it takes 10 seconds to just read the
-// data.
+// data. The preadvAsync runs show how the throughput scales with the number
+// of concurrent reads.
 int main(int argc, char** argv) {
   folly::init(&argc, &argv, false);
   S3ReadBenchmark bm;
   bm.initialize();
   bm.run();
+  bm.runAsync();
 }
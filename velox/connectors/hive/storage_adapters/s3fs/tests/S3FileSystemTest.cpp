@@ -17,6 +17,7 @@
 #include "connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "connectors/hive/storage_adapters/s3fs/tests/MinioServer.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
@@ -118,6 +119,132 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, openFileForWrite) {
+  const char* bucketName = "write";
+  const std::string s3File = s3URI(bucketName, "test.txt");
+  addBucket(bucketName);
+  auto hiveConfig = minioServer_->hiveConfig();
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  s3fs.initializeClient();
+  {
+    auto writeFile = s3fs.openFileForWrite(s3File);
+    writeData(writeFile.get());
+    writeFile->close();
+  }
+  readData(s3fs.openFileForRead(s3File).get());
+
+  // An empty file.
+  const std::string emptyFile = s3URI(bucketName, "empty.txt");
+  s3fs.openFileForWrite(emptyFile)->close();
+  ASSERT_EQ(0, s3fs.openFileForRead(emptyFile)->size());
+}
+
+TEST_F(S3FileSystemTest, multipartUpload) {
+  const char* bucketName = "multipart";
+  const std::string s3File = s3URI(bucketName, "test.txt");
+  addBucket(bucketName);
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.upload-part-size", std::to_string(5 << 20)},
+       {"hive.s3.max-uploads-in-flight", "2"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  s3fs.initializeClient();
+
+  // 12MB in appends that do not line up with the 5MB parts.
+  std::string data(1'000'000, ' ');
+  constexpr int32_t kNumAppends = 12;
+  {
+    auto writeFile = s3fs.openFileForWrite(s3File);
+    for (auto i = 0; i < kNumAppends; ++i) {
+      std::fill(data.begin(), data.end(), 'a' + i);
+      writeFile->append(data);
+    }
+    ASSERT_EQ(kNumAppends * data.size(), writeFile->size());
+    writeFile->close();
+  }
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_EQ(kNumAppends * data.size(), readFile->size());
+  for (auto i = 0; i < kNumAppends; ++i) {
+    ASSERT_EQ(
+        std::string(data.size(), 'a' + i),
+        readFile->pread(i * data.size(), data.size()));
+  }
+}
+
+TEST_F(S3FileSystemTest, preadvAsync) {
+  const char* bucketName = "async";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Small parts so that the reads below are split into several GETs.
+  auto hiveConfig =
+      minioServer_->hiveConfig({{"hive.s3.read-part-size", "100000"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  s3fs.initializeClient();
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  std::string head(12, 0);
+  std::string middle(300'000, 0);
+  std::string tail(7, 0);
+  const uint64_t gap = 500'000;
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head.data(), head.size()),
+      folly::Range<char*>(nullptr, (char*)gap),
+      folly::Range<char*>(middle.data(), middle.size()),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(15 + kOneMB - gap - head.size() - middle.size() -
+                  tail.size())),
+      folly::Range<char*>(tail.data(), tail.size())};
+  ASSERT_EQ(15 + kOneMB, readFile->preadvAsync(0, buffers).get());
+  ASSERT_EQ(head, "aaaaabbbbbcc");
+  ASSERT_EQ(middle, std::string(middle.size(), 'c'));
+  ASSERT_EQ(tail, "ccddddd");
+
+  // A read past the end fails after all GETs are done.
+  char buffer[10];
+  std::vector<folly::Range<char*>> pastEnd = {
+      folly::Range<char*>(buffer, sizeof(buffer))};
+  VELOX_ASSERT_THROW(
+      readFile->preadvAsync(2 * kOneMB, pastEnd).get(),
+      "Failed to get S3 object");
+}
+
+TEST_F(S3FileSystemTest, hedgedReads) {
+  const char* bucketName = "hedged";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  // Every GET that is slower than the p95 may be hedged. The data is the
+  // same whichever GET wins.
+  auto hiveConfig = minioServer_->hiveConfig(
+      {{"hive.s3.read-part-size", "100000"},
+       {"hive.s3.read-hedging-budget", "1"}});
+  filesystems::S3FileSystem s3fs(hiveConfig);
+  s3fs.initializeClient();
+  auto readFile = s3fs.openFileForRead(s3File);
+  std::string data(10 + kOneMB, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  for (auto i = 0; i < 20; ++i) {
+    std::fill(data.begin(), data.end(), 0);
+    ASSERT_EQ(data.size(), readFile->preadvAsync(5, buffers).get());
+    ASSERT_EQ(std::string(5, 'b'), data.substr(0, 5));
+    ASSERT_EQ(std::string(kOneMB, 'c'), data.substr(5, kOneMB));
+    ASSERT_EQ(std::string(5, 'd'), data.substr(5 + kOneMB));
+  }
+}
+
 TEST_F(S3FileSystemTest, viaRegistry) {
   const char* bucketName = "data2";
   const char* file = "test.txt";
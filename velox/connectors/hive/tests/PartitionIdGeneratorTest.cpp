@@ -189,4 +189,32 @@ TEST_F(PartitionIdGeneratorTest, limitOfPartitionNumber) {
       fmt::format("Exceeded limit of {} distinct partitions.", maxPartitions));
 }
 
+TEST_F(PartitionIdGeneratorTest, clusteredRowsAndNames) {
+  PartitionIdGenerator idGenerator(ROW({"c0"}, {BIGINT()}), {0}, 100, pool());
+
+  // Runs of 100 rows with the same key.
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return 10 - row / 100; }),
+  });
+  raw_vector<uint64_t> ids;
+  idGenerator.run(input, ids);
+  ASSERT_EQ(idGenerator.numPartitions(), 10);
+  for (auto i = 0; i < input->size(); ++i) {
+    ASSERT_EQ(ids[i], i / 100) << "at " << i;
+  }
+
+  // Values beyond the range of the first input change the value IDs, but the
+  // partition IDs and names stay the same.
+  auto moreInput = makeRowVector({
+      makeFlatVector<int64_t>(20, [](auto row) { return 100 + row * 50; }),
+  });
+  idGenerator.run(moreInput, ids);
+  idGenerator.run(input, ids);
+  for (auto i = 0; i < input->size(); ++i) {
+    ASSERT_EQ(ids[i], i / 100) << "at " << i;
+  }
+  EXPECT_EQ(idGenerator.partitionName(0), "c0=10");
+  EXPECT_EQ(idGenerator.partitionName(9), "c0=1");
+}
+
 } // namespace facebook::velox::connector::hive
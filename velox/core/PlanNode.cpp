@@ -650,7 +650,9 @@ const std::vector<PlanNodePtr>& ArrowStreamNode::sources() const {
 }
 
 void ArrowStreamNode::addDetails(std::stringstream& stream) const {
-  // Nothing to add.
+  if (arrowStreams_.size() > 1) {
+    stream << arrowStreams_.size() << " streams";
+  }
 }
 
 const std::vector<PlanNodePtr>& ExchangeNode::sources() const {
@@ -914,11 +916,15 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (broadcastBuild_) {
+    stream << ", broadcast build";
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  obj["broadcastBuild"] = broadcastBuild_;
   return obj;
 }
 
@@ -947,7 +953,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      obj.getDefault("broadcastBuild", false).asBool());
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
@@ -1160,12 +1167,14 @@ WindowNode::WindowNode(
     std::vector<SortOrder> sortingOrders,
     std::vector<std::string> windowColumnNames,
     std::vector<Function> windowFunctions,
+    bool inputsSorted,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       partitionKeys_(std::move(partitionKeys)),
       sortingKeys_(std::move(sortingKeys)),
       sortingOrders_(std::move(sortingOrders)),
       windowFunctions_(std::move(windowFunctions)),
+      inputsSorted_(inputsSorted),
       sources_{std::move(source)},
       outputType_(getWindowOutputType(
           sources_[0]->outputType(),
@@ -1182,6 +1191,10 @@ WindowNode::WindowNode(
 }
 
 void WindowNode::addDetails(std::stringstream& stream) const {
+  if (inputsSorted_) {
+    stream << "STREAMING ";
+  }
+
   stream << "partition by [";
   if (!partitionKeys_.empty()) {
     addFields(stream, partitionKeys_);
@@ -1317,6 +1330,7 @@ folly::dynamic WindowNode::serialize() const {
     windowNames.push_back(outputType_->nameOf(i));
   }
   obj["names"] = ISerializable::serialize(windowNames);
+  obj["inputsSorted"] = inputsSorted_;
 
   return obj;
 }
@@ -1343,6 +1357,7 @@ PlanNodePtr WindowNode::create(const folly::dynamic& obj, void* context) {
       sortingOrders,
       windowNames,
       functions,
+      obj["inputsSorted"].asBool(),
       source);
 }
 
@@ -1473,6 +1488,34 @@ RowTypePtr getTopNRowNumberOutputType(
 }
 } // namespace
 
+// static
+const char* TopNRowNumberNode::rankFunctionName(RankFunction function) {
+  switch (function) {
+    case RankFunction::kRowNumber:
+      return "row_number";
+    case RankFunction::kRank:
+      return "rank";
+    case RankFunction::kDenseRank:
+      return "dense_rank";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// static
+TopNRowNumberNode::RankFunction TopNRowNumberNode::rankFunctionFromName(
+    std::string_view name) {
+  if (name == "row_number") {
+    return RankFunction::kRowNumber;
+  }
+  if (name == "rank") {
+    return RankFunction::kRank;
+  }
+  if (name == "dense_rank") {
+    return RankFunction::kDenseRank;
+  }
+  VELOX_USER_FAIL("Unsupported ranking function: {}", name);
+}
+
 TopNRowNumberNode::TopNRowNumberNode(
     PlanNodeId id,
     std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -1480,12 +1523,14 @@ TopNRowNumberNode::TopNRowNumberNode(
     std::vector<SortOrder> sortingOrders,
     const std::optional<std::string>& rowNumberColumnName,
     int32_t limit,
-    PlanNodePtr source)
+    PlanNodePtr source,
+    RankFunction rankFunction)
     : PlanNode(std::move(id)),
       partitionKeys_{std::move(partitionKeys)},
       sortingKeys_{std::move(sortingKeys)},
       sortingOrders_{std::move(sortingOrders)},
       limit_{limit},
+      rankFunction_{rankFunction},
       sources_{std::move(source)},
       outputType_{getTopNRowNumberOutputType(
           sources_[0]->outputType(),
@@ -1502,6 +1547,10 @@ TopNRowNumberNode::TopNRowNumberNode(
 }
 
 void TopNRowNumberNode::addDetails(std::stringstream& stream) const {
+  if (rankFunction_ != RankFunction::kRowNumber) {
+    stream << rankFunctionName(rankFunction_) << " ";
+  }
+
   if (!partitionKeys_.empty()) {
     stream << "partition by (";
     addFields(stream, partitionKeys_);
@@ -1524,6 +1573,7 @@ folly::dynamic TopNRowNumberNode::serialize() const {
     obj["rowNumberColumnName"] = outputType_->names().back();
   }
   obj["limit"] = limit_;
+  obj["rankFunction"] = rankFunctionName(rankFunction_);
   return obj;
 }
 
@@ -1542,6 +1592,11 @@ PlanNodePtr TopNRowNumberNode::create(
     rowNumberColumnName = obj["rowNumberColumnName"].asString();
   }
 
+  auto rankFunction = RankFunction::kRowNumber;
+  if (obj.count("rankFunction")) {
+    rankFunction = rankFunctionFromName(obj["rankFunction"].asString());
+  }
+
   return std::make_shared<TopNRowNumberNode>(
       deserializePlanNodeId(obj),
       partitionKeys,
@@ -1549,7 +1604,8 @@ PlanNodePtr TopNRowNumberNode::create(
       sortingOrders,
       rowNumberColumnName,
       obj["limit"].asInt(),
-      source);
+      source,
+      rankFunction);
 }
 
 void LocalMergeNode::addDetails(std::stringstream& stream) const {
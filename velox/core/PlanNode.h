@@ -282,10 +282,26 @@ class ArrowStreamNode : public PlanNode {
       const PlanNodeId& id,
       RowTypePtr outputType,
       std::shared_ptr<ArrowArrayStream> arrowStream)
+      : ArrowStreamNode(
+            id,
+            std::move(outputType),
+            std::vector<std::shared_ptr<ArrowArrayStream>>{
+                std::move(arrowStream)}) {}
+
+  /// Reads 'arrowStreams' in parallel. Each driver reads a subset of the
+  /// streams one after the other, so that there are at most as many drivers
+  /// as streams.
+  ArrowStreamNode(
+      const PlanNodeId& id,
+      RowTypePtr outputType,
+      std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams)
       : PlanNode(id),
         outputType_(std::move(outputType)),
-        arrowStream_(std::move(arrowStream)) {
-    VELOX_CHECK_NOT_NULL(arrowStream_);
+        arrowStreams_(std::move(arrowStreams)) {
+    VELOX_CHECK(!arrowStreams_.empty());
+    for (const auto& arrowStream : arrowStreams_) {
+      VELOX_CHECK_NOT_NULL(arrowStream);
+    }
   }
 
   const RowTypePtr& outputType() const override {
@@ -295,7 +311,11 @@ class ArrowStreamNode : public PlanNode {
   const std::vector<PlanNodePtr>& sources() const override;
 
   const std::shared_ptr<ArrowArrayStream>& arrowStream() const {
-    return arrowStream_;
+    return arrowStreams_[0];
+  }
+
+  const std::vector<std::shared_ptr<ArrowArrayStream>>& arrowStreams() const {
+    return arrowStreams_;
   }
 
   std::string_view name() const override {
@@ -310,7 +330,7 @@ class ArrowStreamNode : public PlanNode {
   void addDetails(std::stringstream& stream) const override;
 
   const RowTypePtr outputType_;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+  const std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
 };
 
 class FilterNode : public PlanNode {
@@ -526,6 +546,10 @@ class TableWriteNode : public PlanNode {
     return commitStrategy_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.writerSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TableWrite";
   }
@@ -987,6 +1011,14 @@ class PartitionFunction {
   virtual void partition(
       const RowVector& input,
       std::vector<uint32_t>& partitions) = 0;
+
+  /// Returns the number of consecutive partitions, wrapping around, that
+  /// receive a copy of each row starting at the partition returned by
+  /// partition(). This is more than 1 for the side of a join that must meet
+  /// the rows of the other side wherever these were spread to.
+  virtual int32_t numReplicas() const {
+    return 1;
+  }
 };
 
 /// Factory class for creating PartitionFunction instances.
@@ -1451,7 +1483,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      bool broadcastBuild = false)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1461,7 +1494,8 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        broadcastBuild_{broadcastBuild} {
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1494,6 +1528,13 @@ class HashJoinNode : public AbstractJoinNode {
     return nullAware_;
   }
 
+  /// True if the build side is broadcast, so that all the tasks running this
+  /// join build the same hash table. The tasks of a query on the same worker
+  /// then probe a single copy of the table.
+  bool isBroadcastBuild() const {
+    return broadcastBuild_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1502,6 +1543,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const bool broadcastBuild_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -1995,6 +2037,10 @@ class WindowNode : public PlanNode {
   /// @param windowColumnNames specifies the output column
   /// names for each window function column. So
   /// windowColumnNames.length() = windowFunctions.length().
+  /// @param inputsSorted true if the input is already clustered on the
+  /// partition keys and sorted on the sorting keys within each partition.
+  /// The Window operator then outputs each partition as soon as the next one
+  /// starts instead of buffering all the input.
   WindowNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -2002,12 +2048,19 @@ class WindowNode : public PlanNode {
       std::vector<SortOrder> sortingOrders,
       std::vector<std::string> windowColumnNames,
       std::vector<Function> windowFunctions,
+      bool inputsSorted,
       PlanNodePtr source);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: streaming window only holds one partition at a time, so it doesn't
+    // need to spill.
+    return !inputsSorted_ && queryConfig.windowSpillEnabled();
+  }
+
   /// The outputType is the concatenation of the input columns
   /// with the output columns of each window function.
   const RowTypePtr& outputType() const override {
@@ -2030,6 +2083,10 @@ class WindowNode : public PlanNode {
     return windowFunctions_;
   }
 
+  bool inputsSorted() const {
+    return inputsSorted_;
+  }
+
   std::string_view name() const override {
     return "Window";
   }
@@ -2048,6 +2105,8 @@ class WindowNode : public PlanNode {
 
   const std::vector<Function> windowFunctions_;
 
+  const bool inputsSorted_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -2087,6 +2146,12 @@ class RowNumberNode : public PlanNode {
     return limit_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: without partition keys there is a single partition and nothing to
+    // spill but the counter.
+    return !partitionKeys_.empty() && queryConfig.rowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "RowNumber";
   }
@@ -2133,6 +2198,10 @@ class MarkDistinctNode : public PlanNode {
     return "MarkDistinct";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   const std::string& markerName() const {
     return markerName_;
   }
@@ -2157,19 +2226,33 @@ class MarkDistinctNode : public PlanNode {
   const RowTypePtr outputType_;
 };
 
-/// Optimized version of a WindowNode for a single row_number function with a
-/// limit over sorted partitions.
+/// Optimized version of a WindowNode for a single row_number, rank or
+/// dense_rank function with a limit over sorted partitions.
 /// The output of this node contains all input columns followed by an optional
 /// 'rowNumberColumnName' BIGINT column.
 class TopNRowNumberNode : public PlanNode {
  public:
+  /// The ranking function computed by the node.
+  enum class RankFunction {
+    kRowNumber,
+    kRank,
+    kDenseRank,
+  };
+
+  static const char* rankFunctionName(RankFunction function);
+
+  static RankFunction rankFunctionFromName(std::string_view name);
+
   /// @param partitionKeys Partitioning keys. May be empty.
   /// @param rowNumberColumnName Optional name of the column containing row
-  /// numbers. If not specified, the output doesn't include 'row number' column.
-  /// This is used when computing partial results.
-  /// @param limit Per-partition limit. The number of
+  /// numbers (or ranks). If not specified, the output doesn't include 'row
+  /// number' column. This is used when computing partial results.
+  /// @param limit Per-partition limit. With row_number, the number of
   /// rows produced by this node will not exceed this value for any given
-  /// partition. Extra rows will be dropped.
+  /// partition. With rank and dense_rank, the rows with a rank of at most
+  /// 'limit' are produced, which may be more rows if there are ties. Extra
+  /// rows will be dropped.
+  /// @param rankFunction The ranking function the limit applies to.
   TopNRowNumberNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -2177,7 +2260,8 @@ class TopNRowNumberNode : public PlanNode {
       std::vector<SortOrder> sortingOrders,
       const std::optional<std::string>& rowNumberColumnName,
       int32_t limit,
-      PlanNodePtr source);
+      PlanNodePtr source,
+      RankFunction rankFunction = RankFunction::kRowNumber);
 
   const std::vector<PlanNodePtr>& sources() const override {
     return sources_;
@@ -2203,10 +2287,20 @@ class TopNRowNumberNode : public PlanNode {
     return limit_;
   }
 
+  RankFunction rankFunction() const {
+    return rankFunction_;
+  }
+
   bool generateRowNumber() const {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: without partition keys the operator only holds the top 'limit'
+    // rows, so it doesn't need to spill.
+    return !partitionKeys_.empty() && queryConfig.topNRowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopNRowNumber";
   }
@@ -2225,6 +2319,8 @@ class TopNRowNumberNode : public PlanNode {
 
   const int32_t limit_;
 
+  const RankFunction rankFunction_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -60,7 +60,8 @@ class QueryConfig {
 
   // Whether to track CPU usage for individual expressions (supported by call
   // and cast expressions). False by default. Can be expensive when processing
-  // small batches, e.g. < 10K rows.
+  // small batches, e.g. < 10K rows. FilterProject reports the stats of each
+  // function in OperatorStats::expressionStats.
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
@@ -69,6 +70,51 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  // If true, reads the hardware counters of the thread around the calls of
+  // each operator and adds cycles, instructions, last level cache misses and
+  // branch misses to the runtime stats of the operator. Linux only.
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  // If true, a table scan pipeline starts with one Driver per queued split and
+  // at least one. More Drivers are started as splits queue up with no idle
+  // Driver to take them. The rest start when no more splits arrive.
+  static constexpr const char* kTableScanAdaptiveDriversEnabled =
+      "table_scan_adaptive_drivers_enabled";
+
+  // If not 0, each Task keeps up to this many of its latest Driver run, wait
+  // and memory reclaim events for export as a Chrome trace. See TaskTrace.
+  static constexpr const char* kTaskTraceMaxEvents = "task_trace_max_events";
+
+  // If not 0, each Task keeps up to this many of its latest memory
+  // reservation samples, spill and arbitration events. See MemoryTimeline.
+  static constexpr const char* kMemoryTimelineMaxEvents =
+      "memory_timeline_max_events";
+
+  // Minimum time in milliseconds between two samples of the operator memory
+  // reservations of a Task for the memory timeline.
+  static constexpr const char* kMemoryTimelineSampleIntervalMs =
+      "memory_timeline_sample_interval_ms";
+
+  // Maximum time in milliseconds a Driver stays on an executor thread before
+  // it yields and goes to the back of the queue. If the executor has more than
+  // one priority, Drivers of Tasks that have used more CPU are enqueued at a
+  // lower priority. 0 means no limit.
+  static constexpr const char* kDriverTimeSliceMs = "driver_time_slice_ms";
+
+  // Comma-separated ids of the plan nodes whose operators save their first
+  // input batches under kInputCaptureDir for replay. See InputCapture.
+  static constexpr const char* kInputCapturePlanNodeIds =
+      "input_capture_plan_node_ids";
+
+  // Directory that receives the captured inputs, one subdirectory per task.
+  static constexpr const char* kInputCaptureDir = "input_capture_dir";
+
+  // Maximum number of input batches each operator of a captured plan node
+  // saves.
+  static constexpr const char* kInputCaptureMaxBatches =
+      "input_capture_max_batches";
+
   // Flags used to configure the CAST operator:
 
   // This flag makes the Row conversion to by applied in a way that the casting
@@ -90,6 +136,50 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, a round robin local exchange feeds all consumers from a single
+  /// queue of whole input vectors. Any idle consumer takes the next vector, so
+  /// that consumers with uneven cost balance automatically. The local exchange
+  /// buffer size is the only limit on buffered data.
+  static constexpr const char* kLocalExchangeWorkStealing =
+      "local_exchange_work_stealing";
+
+  /// If true, a round robin local exchange that feeds table writers starts
+  /// with one writer driver and activates another one each time the exchange
+  /// buffers half of max_local_exchange_buffer_size, as long as the query
+  /// uses less than scale_writer_max_memory_usage_ratio of its memory
+  /// capacity. Writer drivers that are never activated write no files.
+  static constexpr const char* kScaleWriters = "scale_writers";
+
+  static constexpr const char* kScaleWriterMaxMemoryUsageRatio =
+      "scale_writer_max_memory_usage_ratio";
+
+  /// Number of key ranges that a local merge merges in parallel on the query
+  /// executor. The ranges are split at keys sampled from the buffered source
+  /// rows and the merged ranges are returned in key order. 1 merges all
+  /// sources on the driver thread.
+  static constexpr const char* kLocalMergeParallelism =
+      "local_merge_parallelism";
+
+  /// Size in bytes of the pieces that a table scan cuts a large split into,
+  /// e.g. a byte range of stripes of a file. The pieces go to a queue that
+  /// the other drivers of the scan take from before taking a new split, so
+  /// that the drivers share the work of a few large splits. 0 disables this.
+  static constexpr const char* kTableScanSplitPieceSize =
+      "table_scan_split_piece_size";
+
+  /// If true, the queued splits of a plan node are handed out in decreasing
+  /// order of ConnectorSplit::splitWeight, so that the largest splits start
+  /// first and the small ones even out the end of the scan. Splits of equal
+  /// or unknown weight keep their arrival order.
+  static constexpr const char* kTableScanLargestSplitFirst =
+      "table_scan_largest_split_first";
+
+  /// The number of batches an ArrowStream operator pulls ahead from its
+  /// ArrowArrayStreams on a separate thread, so that a slow stream does not
+  /// block the driver thread. 0 pulls each batch on the driver thread.
+  static constexpr const char* kArrowStreamPrefetchBatches =
+      "arrow_stream_prefetch_batches";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -102,9 +192,39 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// The max percentage of the groups that a full partial aggregation keeps
+  /// in memory when it flushes. Only the groups with repeated input since the
+  /// previous flush are kept, the others are flushed. 0 flushes all groups.
+  static constexpr const char* kPartialAggregationRetainedGroupsPct =
+      "partial_aggregation_retained_groups_pct";
+
+  /// If true, the drivers of a final aggregation with grouping keys merge
+  /// their hash tables in parallel at the end of input, each driver merging a
+  /// hash partition of the groups. This allows running final aggregations on
+  /// multiple drivers without a local exchange that partitions the input.
+  static constexpr const char* kParallelAggregationMergeEnabled =
+      "parallel_aggregation_merge_enabled";
+
+  /// Maximum number of threads an OrderBy operator uses for sorting its rows
+  /// without spilling. The threads come from the query executor. A plan that
+  /// sorts on multiple drivers and merges the runs with a LocalMerge usually
+  /// sets this to 1.
+  static constexpr const char* kOrderBySortThreads = "order_by_sort_threads";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// The compression codec of the pages sent between tasks: "none", "lz4",
+  /// "snappy" or "zstd". The producer and the consumer of an exchange must use
+  /// the same codec.
+  static constexpr const char* kExchangeCompressionKind =
+      "exchange_compression_codec";
+
+  /// If true, dictionary and constant columns are sent between tasks without
+  /// flattening them.
+  static constexpr const char* kExchangePreserveEncodings =
+      "exchange_preserve_encodings";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -124,6 +244,25 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, operators that size their output by
+  /// kPreferredOutputBatchRows use the average size of the rows they have
+  /// produced so far to fit their batches in kPreferredOutputBatchBytes.
+  static constexpr const char* kAdaptiveOutputBatchRowsEnabled =
+      "adaptive_output_batch_rows_enabled";
+
+  /// If true, the output of filters is merged into batches of at least half
+  /// the output batch size before going to the next operator. Selective
+  /// filters otherwise pass many small batches down the pipeline.
+  static constexpr const char* kMergeSmallVectorsEnabled =
+      "merge_small_vectors_enabled";
+
+  /// If true, a partial aggregation over GroupId first aggregates its input
+  /// on all grouping keys and then computes the grouping sets from these
+  /// partial results, instead of aggregating each input row once per
+  /// grouping set.
+  static constexpr const char* kGroupingSetsPreAggregationEnabled =
+      "grouping_sets_pre_aggregation_enabled";
+
   /// It is used when DataBuffer.reserve() method to reallocated buffer size.
   static constexpr const char* kDataBufferGrowRatio = "data_buffer_grow_ratio";
 
@@ -132,11 +271,33 @@ class QueryConfig {
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// If true, a nested loop join whose condition bounds a probe column by two
+  /// build columns, e.g. 'p BETWEEN b_start AND b_end', sorts the build side on
+  /// the lower bound and pairs each probe row only with the build rows whose
+  /// interval can contain it.
+  static constexpr const char* kNestedLoopJoinRangeEnabled =
+      "nested_loop_join_range_enabled";
+
   /// If true, the conjunction expression can reorder inputs based on the time
-  /// taken to calculate them.
+  /// taken to calculate them and the number of rows they decide. If false, the
+  /// inputs are not timed and run in plan order.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "adaptive_filter_reordering_enabled";
 
+  /// The max size in bytes of a Bloom filter that a hash join build creates
+  /// on an integer join key to push down into the probe side scan. Used for
+  /// keys with too many distinct values for an exact IN filter. 0 disables
+  /// the Bloom filters.
+  static constexpr const char* kJoinBloomFilterMaxSize =
+      "join_bloom_filter_max_size";
+
+  /// The max number of probe side rows that the HashProbe operators of an
+  /// inner join buffer while the build side is running. If the whole probe
+  /// side fits, the build side drops the rows whose integer join keys have
+  /// no match on the probe side. 0 disables the buffering.
+  static constexpr const char* kHashJoinProbeBufferMaxRows =
+      "hash_join_probe_buffer_max_rows";
+
   /// Global enable spilling flag.
   static constexpr const char* kSpillEnabled = "spill_enabled";
 
@@ -150,11 +311,38 @@ class QueryConfig {
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
+  /// Window spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
+
+  /// RowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kRowNumberSpillEnabled =
+      "row_number_spill_enabled";
+
+  /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNRowNumberSpillEnabled =
+      "topn_row_number_spill_enabled";
+
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
+  /// Table writer spilling flag, only applies if "spill_enabled" flag is set.
+  /// Lets a writer of sorted files spill the rows it buffers for sorting.
+  static constexpr const char* kWriterSpillEnabled = "writer_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
       "aggregation_spill_memory_threshold";
 
+  /// If non-zero, a spilling final or single aggregation switches to
+  /// sort-based aggregation once the groups it has produced are at least this
+  /// percentage of its input rows. The hash table then stops growing and all
+  /// its groups are spilled as sorted runs whenever it is full. 0 disables the
+  /// switch.
+  static constexpr const char* kAggregationSortFallbackDistinctPct =
+      "aggregation_sort_fallback_distinct_pct";
+
   /// The max memory that a hash join can use before spilling. If it 0, then
   /// there is no limit.
   static constexpr const char* kJoinSpillMemoryThreshold =
@@ -165,6 +353,11 @@ class QueryConfig {
   static constexpr const char* kOrderBySpillMemoryThreshold =
       "order_by_spill_memory_threshold";
 
+  /// The max memory that a window operator can use before spilling. If it 0,
+  /// then there is no limit.
+  static constexpr const char* kWindowSpillMemoryThreshold =
+      "window_spill_memory_threshold";
+
   static constexpr const char* kTestingSpillPct = "testing.spill_pct";
 
   /// The max allowed spilling level with zero being the initial spilling level.
@@ -179,6 +372,17 @@ class QueryConfig {
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
+  /// The max bytes of spill files that a task keeps in its local spill
+  /// directory. Spill files opened after that go to the spill overflow
+  /// directory of the task. Only applies if the task has an overflow
+  /// directory. If it is zero, then there is no limit.
+  static constexpr const char* kMaxLocalSpillBytes = "max_local_spill_bytes";
+
+  /// The max bytes that a task may spill over all its spill directories. The
+  /// task fails with SPILL_LIMIT_EXCEEDED if it spills more. If it is zero,
+  /// then there is no limit.
+  static constexpr const char* kMaxSpillBytes = "max_spill_bytes";
+
   /// The min spill run size limit used to select partitions for spilling. The
   /// spiller tries to spill a previously spilled partitions if its data size
   /// exceeds this limit, otherwise it spills the partition with most data.
@@ -196,6 +400,14 @@ class QueryConfig {
   static constexpr const char* kSpillableReservationGrowthPct =
       "spillable_reservation_growth_pct";
 
+  /// The compression codec of spill files: "none", "lz4", "snappy" or "zstd".
+  static constexpr const char* kSpillCompressionKind =
+      "spill_compression_codec";
+
+  /// If true, a checksum is written with each spilled page and verified when
+  /// the page is read back.
+  static constexpr const char* kSpillChecksumEnabled = "spill_checksum_enabled";
+
   /// If false, size function returns null for null input.
   static constexpr const char* kSparkLegacySizeOfNull =
       "spark.legacy_size_of_null";
@@ -218,11 +430,27 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t partialAggregationRetainedGroupsPct() const {
+    return get<int32_t>(kPartialAggregationRetainedGroupsPct, 0);
+  }
+
+  bool parallelAggregationMergeEnabled() const {
+    return get<bool>(kParallelAggregationMergeEnabled, false);
+  }
+
+  int32_t orderBySortThreads() const {
+    return get<int32_t>(kOrderBySortThreads, 8);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
   }
 
+  int32_t aggregationSortFallbackDistinctPct() const {
+    return get<int32_t>(kAggregationSortFallbackDistinctPct, 0);
+  }
+
   uint64_t joinSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kJoinSpillMemoryThreshold, kDefault);
@@ -233,6 +461,11 @@ class QueryConfig {
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
   }
 
+  uint64_t windowSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kWindowSpillMemoryThreshold, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -242,11 +475,47 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  std::string exchangeCompressionKind() const {
+    return get<std::string>(kExchangeCompressionKind, "none");
+  }
+
+  bool exchangePreserveEncodings() const {
+    return get<bool>(kExchangePreserveEncodings, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localExchangeWorkStealing() const {
+    return get<bool>(kLocalExchangeWorkStealing, false);
+  }
+
+  bool scaleWriters() const {
+    return get<bool>(kScaleWriters, false);
+  }
+
+  double scaleWriterMaxMemoryUsageRatio() const {
+    return get<double>(kScaleWriterMaxMemoryUsageRatio, 0.7);
+  }
+
+  int32_t localMergeParallelism() const {
+    return get<int32_t>(kLocalMergeParallelism, 1);
+  }
+
+  uint64_t tableScanSplitPieceSize() const {
+    return get<uint64_t>(kTableScanSplitPieceSize, 0);
+  }
+
+  bool tableScanLargestSplitFirst() const {
+    return get<bool>(kTableScanLargestSplitFirst, false);
+  }
+
+  int32_t arrowStreamPrefetchBatches() const {
+    return get<int32_t>(kArrowStreamPrefetchBatches, 0);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -260,6 +529,18 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchRowsEnabled() const {
+    return get<bool>(kAdaptiveOutputBatchRowsEnabled, false);
+  }
+
+  bool mergeSmallVectorsEnabled() const {
+    return get<bool>(kMergeSmallVectorsEnabled, false);
+  }
+
+  bool groupingSetsPreAggregationEnabled() const {
+    return get<bool>(kGroupingSetsPreAggregationEnabled, false);
+  }
+
   uint32_t dataBufferGrowRatio() const {
     return get<uint32_t>(kDataBufferGrowRatio, 1);
   }
@@ -268,6 +549,10 @@ class QueryConfig {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  bool nestedLoopJoinRangeEnabled() const {
+    return get<bool>(kNestedLoopJoinRangeEnabled, true);
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -282,6 +567,15 @@ class QueryConfig {
     return get<bool>(kAdaptiveFilterReorderingEnabled, true);
   }
 
+  uint64_t joinBloomFilterMaxSize() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kJoinBloomFilterMaxSize, kDefault);
+  }
+
+  uint64_t hashJoinProbeBufferMaxRows() const {
+    return get<uint64_t>(kHashJoinProbeBufferMaxRows, 0);
+  }
+
   bool isMatchStructByName() const {
     return get<bool>(kCastMatchStructByName, false);
   }
@@ -341,6 +635,36 @@ class QueryConfig {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  /// Returns 'is window spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool windowSpillEnabled() const {
+    return get<bool>(kWindowSpillEnabled, true);
+  }
+
+  /// Returns 'is row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool rowNumberSpillEnabled() const {
+    return get<bool>(kRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is topN row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool topNRowNumberSpillEnabled() const {
+    return get<bool>(kTopNRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is mark distinct spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
+  /// Returns 'is table writer spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool writerSpillEnabled() const {
+    return get<bool>(kWriterSpillEnabled, true);
+  }
+
   // Returns a percentage of aggregation or join input batches that
   // will be forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -373,6 +697,14 @@ class QueryConfig {
     return get<uint64_t>(kMaxSpillFileSize, kDefaultMaxFileSize);
   }
 
+  uint64_t maxLocalSpillBytes() const {
+    return get<uint64_t>(kMaxLocalSpillBytes, 0);
+  }
+
+  uint64_t maxSpillBytes() const {
+    return get<uint64_t>(kMaxSpillBytes, 0);
+  }
+
   uint64_t minSpillRunSize() const {
     constexpr uint64_t kDefaultMinSpillRunSize = 256 << 20; // 256MB.
     return get<uint64_t>(kMinSpillRunSize, kDefaultMinSpillRunSize);
@@ -387,6 +719,14 @@ class QueryConfig {
     return get<double>(kSpillableReservationGrowthPct, kDefaultPct);
   }
 
+  std::string spillCompressionKind() const {
+    return get<std::string>(kSpillCompressionKind, "none");
+  }
+
+  bool spillChecksumEnabled() const {
+    return get<bool>(kSpillChecksumEnabled, false);
+  }
+
   bool sparkLegacySizeOfNull() const {
     constexpr bool kDefault{true};
     return get<bool>(kSparkLegacySizeOfNull, kDefault);
@@ -400,6 +740,42 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  bool tableScanAdaptiveDriversEnabled() const {
+    return get<bool>(kTableScanAdaptiveDriversEnabled, false);
+  }
+
+  uint32_t taskTraceMaxEvents() const {
+    return get<uint32_t>(kTaskTraceMaxEvents, 0);
+  }
+
+  uint32_t memoryTimelineMaxEvents() const {
+    return get<uint32_t>(kMemoryTimelineMaxEvents, 0);
+  }
+
+  uint32_t memoryTimelineSampleIntervalMs() const {
+    return get<uint32_t>(kMemoryTimelineSampleIntervalMs, 1'000);
+  }
+
+  uint32_t driverTimeSliceMs() const {
+    return get<uint32_t>(kDriverTimeSliceMs, 0);
+  }
+
+  std::string inputCapturePlanNodeIds() const {
+    return get<std::string>(kInputCapturePlanNodeIds, "");
+  }
+
+  std::string inputCaptureDir() const {
+    return get<std::string>(kInputCaptureDir, "");
+  }
+
+  int32_t inputCaptureMaxBatches() const {
+    return get<int32_t>(kInputCaptureMaxBatches, 10);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -117,6 +117,20 @@ class QueryCtx {
     return queryId_;
   }
 
+  /// Sets the priority and deadline of this query for memory arbitration. See
+  /// memory::MemoryPool::setArbitrationPriority().
+  void setArbitrationPriority(int32_t priority, uint64_t deadlineMs = 0) {
+    pool_->setArbitrationPriority(priority, deadlineMs);
+  }
+
+  int32_t arbitrationPriority() const {
+    return pool_->arbitrationPriority();
+  }
+
+  uint64_t arbitrationDeadlineMs() const {
+    return pool_->arbitrationDeadlineMs();
+  }
+
   void testingOverrideMemoryPool(std::shared_ptr<memory::MemoryPool> pool) {
     pool_ = std::move(pool);
   }
@@ -19,6 +19,7 @@
 #include <folly/Likely.h>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/core/Metaprogramming.h"
 #include "velox/core/QueryConfig.h"
@@ -459,6 +460,10 @@ class UDFHolder final
     : public core::SimpleFunctionMetadata<Fun, TReturn, TArgs...> {
   Fun instance_;
 
+  // Error returned by the last failing call() of a UDF whose call() returns
+  // Status. Such a call reports a null result and leaves the error here.
+  Status error_;
+
  public:
   using udf_struct_t = Fun;
   using Metadata = core::SimpleFunctionMetadata<Fun, TReturn, TArgs...>;
@@ -489,6 +494,9 @@ class UDFHolder final
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(
+      callNullFreeBatch_method_resolver,
+      callNullFreeBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
@@ -499,11 +507,14 @@ class UDFHolder final
   // - bool|void callNullFree(...)
   //
   // Each of these methods can return either bool or void. Returning void means
-  // that the UDF is assumed never to return null values.
+  // that the UDF is assumed never to return null values. call() can also
+  // return Status to report a per-row error without throwing. See
+  // takeError().
   //
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callNullFreeBatch(...)
   // - void initialize(...)
 
   // call():
@@ -519,11 +530,19 @@ class UDFHolder final
       void,
       exec_return_type,
       const exec_arg_type<TArgs>&...>::value;
-  static constexpr bool udf_has_call =
-      udf_has_call_return_bool | udf_has_call_return_void;
+  static constexpr bool udf_has_call_return_status = util::has_method<
+      Fun,
+      call_method_resolver,
+      Status,
+      exec_return_type,
+      const exec_arg_type<TArgs>&...>::value;
+  static constexpr bool udf_has_call = udf_has_call_return_bool |
+      udf_has_call_return_void | udf_has_call_return_status;
   static_assert(
-      !(udf_has_call_return_bool && udf_has_call_return_void),
-      "Provided call() methods need to return either void OR bool.");
+      udf_has_call_return_bool + udf_has_call_return_void +
+              udf_has_call_return_status <=
+          1,
+      "Provided call() methods need to return either void OR bool OR Status.");
 
   // callNullable():
   static constexpr bool udf_has_callNullable_return_bool = util::has_method<
@@ -588,6 +607,18 @@ class UDFHolder final
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callNullFreeBatch(out, args..., size) computes 'size' consecutive rows
+  // from arrays of primitive values that are all not null. It must give the
+  // same results as call(), must not throw and must not produce nulls. This
+  // allows the compiler to vectorize the loop over the rows.
+  static constexpr bool udf_has_callNullFreeBatch = util::has_method<
+      Fun,
+      callNullFreeBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -651,6 +682,21 @@ class UDFHolder final
 
   explicit UDFHolder() : Metadata(), instance_{} {}
 
+  /// Returns true if the last call() returned an error that has not been taken
+  /// yet. Always false unless call() returns Status.
+  FOLLY_ALWAYS_INLINE bool hasError() const {
+    if constexpr (udf_has_call_return_status) {
+      return !error_.ok();
+    } else {
+      return false;
+    }
+  }
+
+  /// Returns the error left by the last failing call() and clears it.
+  Status takeError() {
+    return std::move(error_);
+  }
+
   FOLLY_ALWAYS_INLINE void initialize(
       const core::QueryConfig& config,
       const typename exec_resolver<TArgs>::in_type*... constantArgs) {
@@ -714,6 +760,14 @@ class UDFHolder final
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      exec_return_type* out,
+      const exec_arg_type<TArgs>*... args,
+      int32_t size) {
+    static_assert(udf_has_callNullFreeBatch);
+    instance_.callNullFreeBatch(out, args..., size);
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE bool callImpl(
@@ -722,6 +776,13 @@ class UDFHolder final
     static_assert(udf_has_call);
     if constexpr (udf_has_call_return_bool) {
       return instance_.call(out, args...);
+    } else if constexpr (udf_has_call_return_status) {
+      auto status = instance_.call(out, args...);
+      if (UNLIKELY(!status.ok())) {
+        error_ = std::move(status);
+        return false;
+      }
+      return true;
     } else {
       instance_.call(out, args...);
       return true;
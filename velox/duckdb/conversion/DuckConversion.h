@@ -110,6 +110,13 @@ struct DuckStringConversion {
   }
 };
 
+/// Velox StringView and DuckDB string_t have the same layout: a 4 byte size, a
+/// 4 byte prefix and either the rest of a string of up to 12 bytes or a
+/// pointer to the data. Flat string data is therefore handed between the
+/// engines without copying while the owner of the characters is alive.
+static_assert(sizeof(StringView) == sizeof(::duckdb::string_t));
+static_assert(StringView::kInlineSize == ::duckdb::string_t::INLINE_LENGTH);
+
 struct DuckBlobConversion {
   typedef ::duckdb::string_t DUCK_TYPE;
   typedef StringView VELOX_TYPE;
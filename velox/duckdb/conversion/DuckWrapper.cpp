@@ -150,6 +150,55 @@ inline bool isZeroCopyEligible(const ::duckdb::LogicalType& duckType) {
   return true;
 }
 
+// Makes a FlatVector<StringView> over the string_t values of the flat
+// 'duckVector' without copying them. The string heap of 'duckVector' owns the
+// characters of all its strings that are not inlined, so it is held by a
+// string buffer of the result.
+VectorPtr convertStringsNoCopy(
+    ::duckdb::Vector& duckVector,
+    const TypePtr& veloxType,
+    size_t size,
+    memory::MemoryPool* pool) {
+  auto& duckValidity = ::duckdb::FlatVector::Validity(duckVector);
+  auto* duckData =
+      ::duckdb::FlatVector::GetData<::duckdb::string_t>(duckVector);
+
+  BufferPtr nullsView(nullptr);
+  if (!duckValidity.AllValid()) {
+    // Null rows may hold garbage, while Velox reads any row as a StringView.
+    for (auto i = 0; i < size; i++) {
+      if (!duckValidity.RowIsValid(i)) {
+        memset(&duckData[i], 0, sizeof(::duckdb::string_t));
+      }
+    }
+    nullsView = BufferView<DuckDBValidityReleaser>::create(
+        reinterpret_cast<const uint8_t*>(duckValidity.GetData()),
+        bits::nbytes(size),
+        DuckDBValidityReleaser(duckValidity));
+  }
+
+  auto valuesView = BufferView<DuckDBBufferReleaser>::create(
+      reinterpret_cast<const uint8_t*>(duckData),
+      size * sizeof(StringView),
+      DuckDBBufferReleaser(duckVector.GetBuffer()));
+
+  std::vector<BufferPtr> stringBuffers;
+  if (auto heap = duckVector.GetAuxiliary()) {
+    stringBuffers.push_back(BufferView<DuckDBBufferReleaser>::create(
+        reinterpret_cast<const uint8_t*>(duckData),
+        0,
+        DuckDBBufferReleaser(std::move(heap))));
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      veloxType,
+      nullsView,
+      size,
+      valuesView,
+      std::move(stringBuffers));
+}
+
 template <class OP>
 VectorPtr convert(
     ::duckdb::Vector& duckVector,
@@ -160,6 +209,15 @@ VectorPtr convert(
   auto vectorType = duckVector.GetVectorType();
   switch (vectorType) {
     case ::duckdb::VectorType::FLAT_VECTOR: {
+      if constexpr (std::is_same_v<
+                        typename OP::DUCK_TYPE,
+                        ::duckdb::string_t>) {
+        // Unused dictionary entries, which 'validity' excludes, can be
+        // uninitialized and are copied below.
+        if (validity == nullptr) {
+          return convertStringsNoCopy(duckVector, veloxType, size, pool);
+        }
+      }
       VectorPtr result;
       auto& duckValidity = ::duckdb::FlatVector::Validity(duckVector);
       auto* duckData =
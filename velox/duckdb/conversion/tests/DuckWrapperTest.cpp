@@ -324,3 +324,38 @@ TEST_F(BaseDuckWrapperTest, dictConversion) {
     ASSERT_TRUE(expected->equalValueAt(actual.get(), i, i));
   }
 }
+
+TEST_F(BaseDuckWrapperTest, flatStringsNoCopy) {
+  std::vector<std::string> expectedData(
+      {"", "short", "exactly 12 b", "a string that is not inlined", ""});
+  VectorPtr actual;
+  {
+    ::duckdb::Vector data(::duckdb::LogicalTypeId::VARCHAR, 5);
+    auto dataPtr = ::duckdb::FlatVector::GetData<::duckdb::string_t>(data);
+    for (auto i = 0; i < 4; ++i) {
+      dataPtr[i] = ::duckdb::StringVector::AddString(data, expectedData[i]);
+    }
+    // Garbage in a null row.
+    memset(&dataPtr[4], 0xAB, sizeof(::duckdb::string_t));
+    ::duckdb::FlatVector::Validity(data).SetInvalid(4);
+
+    actual = toVeloxVector(5, data, VARCHAR(), pool_.get());
+    auto* flat = actual->asFlatVector<StringView>();
+    ASSERT_NE(flat, nullptr);
+    // The values point into the DuckDB vector.
+    ASSERT_EQ(
+        flat->rawValues(),
+        reinterpret_cast<StringView*>(
+            ::duckdb::FlatVector::GetData<::duckdb::string_t>(data)));
+    ASSERT_EQ(flat->stringBuffers().size(), 1);
+  }
+
+  // The DuckDB vector is gone but its string heap is held by 'actual'.
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_FALSE(actual->isNullAt(i));
+    ASSERT_EQ(
+        actual->asFlatVector<StringView>()->valueAt(i).str(), expectedData[i]);
+  }
+  ASSERT_TRUE(actual->isNullAt(4));
+  ASSERT_EQ(actual->asFlatVector<StringView>()->valueAt(4).size(), 0);
+}
@@ -117,31 +117,6 @@ static void veloxFlatVectorToDuckTemplated(
   ::duckdb::FlatVector::SetData(result, valuePtr + sizeof(T) * offset);
 }
 
-template <>
-void veloxFlatVectorToDuckTemplated<StringView>(
-    VectorPtr arg,
-    size_t offset,
-    size_t count,
-    Vector& result) {
-  // string type needs to be converted
-  // it is almost the same, but because DuckDB is null-terminated the length of
-  // inlined strings is off-by-one we can almost do zero copy but this breaks on
-  // strings of length exactly 12, because velox considers these inlined, but
-  // DuckDB considers them not inlined
-  // this can be fixed in the future (see DuckDB issue #1036)
-  auto resultVarchar = ::duckdb::FlatVector::GetData<string_t>(result);
-  auto veloxVarchar = (StringView*)arg->as<FlatVector<StringView>>()
-                          ->values()
-                          ->as<StringView>();
-  auto& duckdbValidity = ::duckdb::FlatVector::Validity(result);
-  for (size_t i = 0; i < count; i++) {
-    if (duckdbValidity.RowIsValid(i)) {
-      resultVarchar[i] =
-          DuckStringConversion::toDuck(veloxVarchar[offset + i], result);
-    }
-  }
-}
-
 template <>
 void veloxFlatVectorToDuckTemplated<Timestamp>(
     VectorPtr arg,
@@ -162,25 +137,18 @@ void veloxFlatVectorToDuckTemplated<Timestamp>(
 }
 
 static void veloxConvertValidity(
-    const SelectivityVector& rows,
     VectorPtr arg,
     size_t offset,
     size_t count,
     ValidityMask& result) {
-  if (!arg->mayHaveNulls()) {
+  auto rawNulls = arg->rawNulls();
+  if (!rawNulls) {
     // no nulls
     return;
   }
-
-  assert(rows.size() >= (count + offset));
-
-  for (size_t i = 0; i < count; i++) {
-    if (rows.isValid(offset + i)) {
-      result.SetValid(i);
-    } else {
-      result.SetInvalid(i);
-    }
-  }
+  // A set bit is a non-null row in both Velox nulls and DuckDB validity.
+  result.EnsureWritable();
+  bits::copyBits(rawNulls, offset, result.GetData(), 0, count);
 }
 
 static void veloxConvertSelectionVector(
@@ -303,15 +271,24 @@ void veloxDecodedVectorConversion(
   }
 }
 
+// Points DuckDB at the characters of a Velox string. The argument vectors
+// outlive the function call.
+struct DuckStringNoCopyConversion {
+  static string_t toDuck(const StringView& input, Vector& /* unused */) {
+    return string_t(input.data(), input.size());
+  }
+};
+
 template <>
 void veloxDecodedVectorToDuckTemplated<StringView>(
     DecodedVector& arg,
     size_t offset,
     size_t count,
     Vector& result) {
-  // string type needs to be converted, see veloxFlatVectorToDuckTemplated
-  veloxDecodedVectorConversion<StringView, string_t, DuckStringConversion>(
-      arg, offset, count, result);
+  veloxDecodedVectorConversion<
+      StringView,
+      string_t,
+      DuckStringNoCopyConversion>(arg, offset, count, result);
 }
 
 template <>
@@ -368,7 +345,7 @@ static void toDuck(
     switch (arg->encoding()) {
       case VectorEncoding::Simple::FLAT: {
         auto& nullMask = ::duckdb::FlatVector::Validity(target->data[i]);
-        veloxConvertValidity(rows, arg, offset, cardinality, nullMask);
+        veloxConvertValidity(arg, offset, cardinality, nullMask);
 
         for (size_t i = 0; i < cardinality; i++) {
           if (!selMask.RowIsValid(i)) {
@@ -150,6 +150,14 @@ inline void unpack<uint32_t>(
     uint8_t bitWidth,
     uint32_t* FOLLY_NONNULL& result);
 
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result);
+
 // The function definitions are put here to make sure they are inlined. Moving
 // them to the .cpp file may result in 10x regression.
 
@@ -789,6 +797,44 @@ inline void unpack<uint32_t>(
 #endif
 }
 
+// All widths from 1 to 64. Each value is shifted out of the 8 bytes starting
+// at its first byte, plus the 9th byte for widths over 56 that straddle it.
+// This needs no BMI2 and keeps a single loop for all widths.
+template <>
+inline void unpack<uint64_t>(
+    const uint8_t* FOLLY_NONNULL& inputBits,
+    uint64_t inputBufferLen,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* FOLLY_NONNULL& result) {
+  VELOX_CHECK(bitWidth >= 1 && bitWidth <= 64);
+  VELOX_CHECK(inputBufferLen * 8 >= bitWidth * numValues);
+
+  const uint64_t mask =
+      bitWidth == 64 ? ~static_cast<uint64_t>(0) : bits::lowMask(bitWidth);
+  const auto* end = inputBits + inputBufferLen;
+  uint64_t bitPosition = 0;
+  for (uint64_t i = 0; i < numValues; ++i) {
+    const auto* byte = inputBits + (bitPosition >> 3);
+    const auto shift = bitPosition & 7;
+    uint64_t word;
+    if (LIKELY(byte + sizeof(uint64_t) <= end)) {
+      word = *reinterpret_cast<const uint64_t*>(byte);
+    } else {
+      word = 0;
+      memcpy(&word, byte, end - byte);
+    }
+    uint64_t value = word >> shift;
+    if (bitWidth + shift > 64) {
+      value |= static_cast<uint64_t>(byte[8]) << (64 - shift);
+    }
+    result[i] = value & mask;
+    bitPosition += bitWidth;
+  }
+  inputBits += bitPosition / 8;
+  result += numValues;
+}
+
 // Loads a bit field from 'ptr' + bitOffset for up to 'bitWidth' bits. makes
 // sure not to access bytes past lastSafeWord + 7. The definition is put here
 // because it's inlined.
@@ -144,20 +144,37 @@ void BufferedInput::mergeRegions() {
   DWIO_ENSURE(!r.empty(), "Assumes that there's at least one region");
   DWIO_ENSURE_GT(r[ia].length, 0, "invalid region");
 
+  const auto maxMergeDistance = coalesceDistance(maxMergeDistance_);
+  auto* stats = input_->getStats();
+  // Number of regions merged into r[ia].
+  int32_t numMerged = 1;
+  auto recordMerged = [&]() {
+    if (stats != nullptr && numMerged > 1) {
+      stats->coalescedRead().increment(numMerged);
+    }
+  };
   te[e[0]] = 0;
   for (size_t ib = 1; ib < r.size(); ++ib) {
     DWIO_ENSURE_GT(r[ib].length, 0, "invalid region");
-    if (!tryMerge(r[ia], r[ib])) {
+    if (tryMerge(r[ia], r[ib], maxMergeDistance)) {
+      ++numMerged;
+    } else {
+      recordMerged();
+      numMerged = 1;
       r[++ia] = r[ib];
     }
     te[e[ib]] = ia;
   }
+  recordMerged();
   // After merging, remove what's left.
   r.resize(ia + 1);
   std::swap(e, te);
 }
 
-bool BufferedInput::tryMerge(Region& first, const Region& second) {
+bool BufferedInput::tryMerge(
+    Region& first,
+    const Region& second,
+    uint64_t maxMergeDistance) {
   DWIO_ENSURE_GE(second.offset, first.offset, "regions should be sorted.");
   const int64_t gap = second.offset - first.offset - first.length;
 
@@ -169,7 +186,7 @@ bool BufferedInput::tryMerge(Region& first, const Region& second) {
   }
 
   // compare with 0 since it's comparison in different types
-  if (gap < 0 || gap <= maxMergeDistance_) {
+  if (gap < 0 || gap <= maxMergeDistance) {
     // the second region is inside first one if extension is negative
     if (extension > 0) {
       first.length += extension;
@@ -184,6 +201,14 @@ bool BufferedInput::tryMerge(Region& first, const Region& second) {
   return false;
 }
 
+uint64_t BufferedInput::coalesceDistance(uint64_t fixedDistance) const {
+  const auto cost = input_->getReadFile()->readCost();
+  if (!cost.has_value()) {
+    return fixedDistance;
+  }
+  return std::min(cost->breakEvenGap(), kMaxAdaptiveMergeDistance);
+}
+
 std::unique_ptr<SeekableInputStream> BufferedInput::readBuffer(
     uint64_t offset,
     uint64_t length) const {
@@ -28,6 +28,8 @@ namespace facebook::velox::dwio::common {
 class BufferedInput {
  public:
   constexpr static uint64_t kMaxMergeDistance = 1024 * 1024 * 1.25;
+  // Upper limit for the distance derived from the read cost of a file.
+  constexpr static uint64_t kMaxAdaptiveMergeDistance = 16 << 20;
 
   BufferedInput(
       std::shared_ptr<ReadFile> readFile,
@@ -148,6 +150,11 @@ class BufferedInput {
   }
 
  protected:
+  // Returns the largest gap between two ranges that are read in one IO. This
+  // is the break-even gap of the read cost of the file if known, else
+  // 'fixedDistance'.
+  uint64_t coalesceDistance(uint64_t fixedDistance) const;
+
   std::shared_ptr<ReadFileInputStream> input_;
   memory::MemoryPool& pool_;
 
@@ -193,7 +200,8 @@ class BufferedInput {
   // tries and merges WS read regions into one
   bool tryMerge(
       velox::common::Region& first,
-      const velox::common::Region& second);
+      const velox::common::Region& second,
+      uint64_t maxMergeDistance);
 };
 
 } // namespace facebook::velox::dwio::common
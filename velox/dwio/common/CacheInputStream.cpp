@@ -197,6 +197,7 @@ void CacheInputStream::loadSync(Region region) {
       // missed, fall back to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      entry->setTenant(bufferedInput_->tenant());
       if (loadFromSsd(region, *entry)) {
         return;
       }
@@ -213,6 +214,9 @@ void CacheInputStream::loadSync(Region region) {
       // Hit memory cache.
       if (!entry->getAndClearFirstUseFlag()) {
         ioStats_->ramHit().increment(entry->size());
+        if (auto* tenant = bufferedInput_->tenant()) {
+          tenant->recordHit(entry->size());
+        }
       }
       return;
     }
@@ -165,6 +165,8 @@ void CachedBufferedInput::load(const LogType) {
   auto ssdCache = cache_->ssdCache();
   if (ssdCache) {
     ssdFile = &ssdCache->file(fileNum_);
+    // Drops entries recovered from a checkpoint if the file has changed since.
+    ssdFile->checkFileSize(fileNum_, fileSize_);
   }
   // Extra requests made for preloadable regions that are larger then
   // 'loadQuantum'.
@@ -222,7 +224,8 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   bool isSsd = !requests[0]->ssdPin.empty();
-  int32_t maxDistance = isSsd ? 20000 : maxCoalesceDistance_;
+  const int32_t maxDistance =
+      isSsd ? 20000 : coalesceDistance(maxCoalesceDistance_);
   std::sort(
       requests.begin(),
       requests.end(),
@@ -268,6 +271,9 @@ void CachedBufferedInput::makeLoads(
           uint64_t /*offset*/,
           const std::vector<CacheRequest*>& ranges) {
         ++numNewLoads;
+        if (ioStats_ && ranges.size() > 1) {
+          ioStats_->coalescedRead().increment(ranges.size());
+        }
         readRegion(ranges, prefetch);
       });
   if (prefetch && executor_) {
@@ -300,11 +306,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   DwioCoalescedLoadBase(
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
+      cache::CacheTenant* tenant,
       uint64_t groupId,
       std::vector<CacheRequest*> requests)
       : CoalescedLoad(makeKeys(requests), makeSizes(requests)),
         cache_(cache),
         ioStats_(std::move(ioStats)),
+        tenant_(tenant),
         groupId_(groupId) {
     for (auto& request : requests) {
       size_ += request->size;
@@ -372,6 +380,7 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   cache::AsyncDataCache& cache_;
   std::vector<CacheRequest> requests_;
   std::shared_ptr<IoStatistics> ioStats_;
+  cache::CacheTenant* const tenant_;
   const uint64_t groupId_;
   int64_t size_{0};
 };
@@ -383,10 +392,16 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       cache::AsyncDataCache& cache,
       std::shared_ptr<ReadFileInputStream> input,
       std::shared_ptr<IoStatistics> ioStats,
+      cache::CacheTenant* tenant,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
       int32_t maxCoalesceDistance)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            tenant,
+            groupId,
+            std::move(requests)),
         input_(std::move(input)),
         maxCoalesceDistance_(maxCoalesceDistance) {}
 
@@ -400,6 +415,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setTenant(tenant_);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -431,9 +447,15 @@ class SsdLoad : public DwioCoalescedLoadBase {
   SsdLoad(
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
+      cache::CacheTenant* tenant,
       uint64_t groupId,
       std::vector<CacheRequest*> requests)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            tenant,
+            groupId,
+            std::move(requests)) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<SsdPin> ssdPins;
@@ -445,6 +467,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setTenant(tenant_);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -468,10 +491,17 @@ void CachedBufferedInput::readRegion(
   }
   std::shared_ptr<cache::CoalescedLoad> load;
   if (!requests[0]->ssdPin.empty()) {
-    load = std::make_shared<SsdLoad>(*cache_, ioStats_, groupId_, requests);
+    load = std::make_shared<SsdLoad>(
+        *cache_, ioStats_, tenant_, groupId_, requests);
   } else {
     load = std::make_shared<DwioCoalescedLoad>(
-        *cache_, input_, ioStats_, groupId_, requests, maxCoalesceDistance_);
+        *cache_,
+        input_,
+        ioStats_,
+        tenant_,
+        groupId_,
+        requests,
+        maxCoalesceDistance_);
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
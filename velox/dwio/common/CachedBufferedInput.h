@@ -72,6 +72,7 @@ class CachedBufferedInput : public BufferedInput {
         cache_(cache),
         fileNum_(fileNum),
         tracker_(std::move(tracker)),
+        tenant_(cache_->tenant(tracker_ ? tracker_->tenant() : "")),
         groupId_(groupId),
         ioStats_(std::move(ioStats)),
         executor_(executor),
@@ -94,6 +95,7 @@ class CachedBufferedInput : public BufferedInput {
         cache_(cache),
         fileNum_(fileNum),
         tracker_(std::move(tracker)),
+        tenant_(cache_->tenant(tracker_ ? tracker_->tenant() : "")),
         groupId_(groupId),
         ioStats_(std::move(ioStats)),
         executor_(executor),
@@ -153,6 +155,11 @@ class CachedBufferedInput : public BufferedInput {
     return cache_;
   }
 
+  // Returns the tenant that the entries loaded by 'this' are charged to.
+  cache::CacheTenant* FOLLY_NULLABLE tenant() const {
+    return tenant_;
+  }
+
   // Returns the CoalescedLoad that contains the correlated loads for
   // 'stream' or nullptr if none. Returns nullptr on all but first
   // call for 'stream' since the load is to be triggered by the first
@@ -183,6 +190,7 @@ class CachedBufferedInput : public BufferedInput {
   cache::AsyncDataCache* FOLLY_NONNULL cache_;
   const uint64_t fileNum_;
   std::shared_ptr<cache::ScanTracker> tracker_;
+  cache::CacheTenant* const FOLLY_NULLABLE tenant_;
   const uint64_t groupId_;
   std::shared_ptr<IoStatistics> ioStats_;
   folly::Executor* const FOLLY_NULLABLE executor_;
@@ -71,6 +71,7 @@ void ColumnLoader::loadInternal(
     effectiveRows = RowSet(selectedRows);
   }
 
+  structReader_->addLazyLoadedRows(effectiveRows.size());
   structReader_->advanceFieldReader(fieldReader_, offset);
   fieldReader_->scanSpec()->setValueHook(hook);
   fieldReader_->read(offset, effectiveRows, incomingNulls);
@@ -87,6 +88,8 @@ void ColumnLoader::loadInternal(
       // at the indices in the result vector that were given by
       // 'rows'.
       scatter(rows, result);
+    } else {
+      fieldReader_->maybeEncodeRuns(result);
     }
   }
 }
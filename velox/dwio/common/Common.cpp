@@ -34,6 +34,12 @@ std::string compressionKindToString(CompressionKind kind) {
       return "zstd";
     case CompressionKind_LZ4:
       return "lz4";
+    case CompressionKind_GZIP:
+      return "gzip";
+    case CompressionKind_BROTLI:
+      return "brotli";
+    case CompressionKind_LZ4_HADOOP:
+      return "lz4_hadoop";
   }
   return folly::to<std::string>("unknown - ", kind);
 }
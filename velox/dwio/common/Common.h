@@ -28,6 +28,9 @@ enum CompressionKind {
   CompressionKind_ZSTD = 4,
   CompressionKind_LZ4 = 5,
   CompressionKind_GZIP = 6,
+  CompressionKind_BROTLI = 7,
+  // LZ4 blocks with Hadoop Lz4Codec framing, as in legacy Parquet LZ4.
+  CompressionKind_LZ4_HADOOP = 8,
   CompressionKind_MAX = INT64_MAX
 };
 
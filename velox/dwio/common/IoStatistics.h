@@ -99,6 +99,10 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& coalescedRead() {
+    return coalescedRead_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -139,6 +143,10 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // IOs that read several requests together. The sum is the number of
+  // requests in them.
+  IoCounter coalescedRead_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
@@ -40,6 +40,7 @@ class MetricsLog {
     STREAM_BUNDLE,
     GROUP,
     BLOCK,
+    BLOOM_FILTER,
     TEST
   };
 
@@ -157,6 +158,8 @@ class MetricsLog {
         return "GROUP";
       case MetricsType::BLOCK:
         return "BLOCK";
+      case MetricsType::BLOOM_FILTER:
+        return "BLOOM_FILTER";
       case MetricsType::TEST:
         return "TEST";
     }
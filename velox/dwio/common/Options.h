@@ -20,6 +20,7 @@
 #include <unordered_set>
 
 #include <folly/Executor.h>
+#include "velox/common/caching/FileMetadataCache.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/ErrorTolerance.h"
@@ -111,6 +112,9 @@ class RowReaderOptions {
   std::shared_ptr<folly::Executor> decodingExecutor_;
   std::shared_ptr<folly::Executor> ioExecutor_;
   bool appendRowNumberColumn_ = false;
+  // Sorted row numbers relative to the beginning of the file. If set, only
+  // these rows are read.
+  std::shared_ptr<const std::vector<uint64_t>> selectedRows_;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
   // This is a bit of a hack as there is (by design) no good way
@@ -302,6 +306,22 @@ class RowReaderOptions {
     return appendRowNumberColumn_;
   }
 
+  /*
+   * Restricts the read to the rows with the given row numbers. The row numbers
+   * are relative to the beginning of the file like the ones of the row number
+   * column and must be sorted ascending. Stripes and row groups without
+   * selected rows are skipped without being read. The other rows of the read
+   * row groups are dropped like deleted rows. Only supported by the selective
+   * readers.
+   */
+  void setSelectedRows(std::shared_ptr<const std::vector<uint64_t>> rows) {
+    selectedRows_ = std::move(rows);
+  }
+
+  const std::shared_ptr<const std::vector<uint64_t>>& getSelectedRows() const {
+    return selectedRows_;
+  }
+
   void setKeySelectionCallback(
       std::function<void(
           facebook::velox::dwio::common::flatmap::FlatMapKeySelectionStats)>
@@ -375,6 +395,8 @@ class ReaderOptions {
   uint64_t directorySizeGuess{kDefaultDirectorySizeGuess};
   uint64_t filePreloadThreshold{kDefaultFilePreloadThreshold};
   bool fileColumnNamesReadAsLowerCase = false;
+  std::shared_ptr<cache::FileMetadataCache> fileMetadataCache_;
+  std::string fileMetadataCachePath_;
 
  public:
   static constexpr int32_t kDefaultLoadQuantum = 8 << 20; // 8MB
@@ -410,6 +432,8 @@ class ReaderOptions {
     directorySizeGuess = other.directorySizeGuess;
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
+    fileMetadataCache_ = other.fileMetadataCache_;
+    fileMetadataCachePath_ = other.fileMetadataCachePath_;
     return *this;
   }
 
@@ -519,6 +543,19 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Set the cache of parsed file footers shared between readers and the path
+   * of the file to read, which is the key in the cache. The footer is not
+   * cached if either is unset.
+   */
+  ReaderOptions& setFileMetadataCache(
+      std::shared_ptr<cache::FileMetadataCache> cache,
+      const std::string& path) {
+    fileMetadataCache_ = std::move(cache);
+    fileMetadataCachePath_ = path;
+    return *this;
+  }
+
   /**
    * Get the desired tail location.
    * @return if not set, return the maximum long.
@@ -588,6 +625,14 @@ class ReaderOptions {
   bool isFileColumnNamesReadAsLowerCase() const {
     return fileColumnNamesReadAsLowerCase;
   }
+
+  cache::FileMetadataCache* getFileMetadataCache() const {
+    return fileMetadataCachePath_.empty() ? nullptr : fileMetadataCache_.get();
+  }
+
+  const std::string& getFileMetadataCachePath() const {
+    return fileMetadataCachePath_;
+  }
 };
 
 struct WriterOptions {
@@ -104,6 +104,16 @@ class RowReader {
   virtual bool allPrefetchIssued() const {
     return false;
   }
+
+  /**
+   * Returns the number of rows in the stripes or row groups that this reader
+   * reads, as recorded in the file metadata, or std::nullopt if this is not
+   * known without reading data. Filters are not applied. Used for answering
+   * count(*) from metadata when no column is read.
+   */
+  virtual std::optional<uint64_t> numberOfRowsInRange() const {
+    return std::nullopt;
+  }
 };
 
 /**
@@ -277,6 +277,14 @@ class ScanSpec {
     makeFlat_ = makeFlat;
   }
 
+  vector_size_t minAverageRunLength() const {
+    return minAverageRunLength_;
+  }
+
+  void setMinAverageRunLength(vector_size_t minAverageRunLength) {
+    minAverageRunLength_ = minAverageRunLength;
+  }
+
   // True if this or a descendant has a filter that will affect the number of
   // output rows.  Note that filter on map keys and array indices is not
   // counted, as they do not change the number of container output rows.
@@ -375,6 +383,9 @@ class ScanSpec {
   // True if a string dictionary or flat map in this field should be
   // returned as flat.
   bool makeFlat_ = false;
+  // If non-zero, a flat scalar result is returned as a SequenceVector over
+  // its runs if these are on average at least this many rows long.
+  vector_size_t minAverageRunLength_ = 0;
   std::shared_ptr<common::Filter> filter_;
 
   // Filters that will be only used for row group filtering based on metadata.
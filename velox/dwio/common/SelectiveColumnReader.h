@@ -170,6 +170,17 @@ class SelectiveColumnReader {
   // 'rows' passed to the last 'read().
   virtual void getValues(RowSet rows, VectorPtr* FOLLY_NONNULL result) = 0;
 
+  // Replaces a flat '*result' from getValues() with a SequenceVector over its
+  // runs if the ScanSpec sets a minimum average run length and the runs are
+  // that long.
+  void maybeEncodeRuns(VectorPtr* FOLLY_NONNULL result) const {
+    if (const auto minAverageRunLength = scanSpec_->minAverageRunLength()) {
+      if (auto encoded = BaseVector::encodeRuns(*result, minAverageRunLength)) {
+        *result = std::move(encoded);
+      }
+    }
+  }
+
   // Returns the rows that were selected/visited by the last
   // read(). If 'this' has no filter, returns 'rows' passed to last
   // read().
@@ -394,6 +405,13 @@ class SelectiveColumnReader {
     return true;
   }
 
+  // Returns the number of rows of columns returned as LazyVectors that were
+  // never decoded, e.g. because a remaining filter dropped them before the
+  // column was loaded. Summed over the columns.
+  virtual uint64_t numLazySkippedRows() const {
+    return 0;
+  }
+
   // Used by decoders to set encoding-related data to be kept between calls to
   // read().
   ScanState& scanState() {
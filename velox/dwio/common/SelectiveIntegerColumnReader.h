@@ -151,6 +151,12 @@ void SelectiveIntegerColumnReader::processFilter(
       readHelper<Reader, velox::common::BigintValuesUsingBitmask, isDense>(
           filter, rows, extractValues);
       break;
+    case velox::common::FilterKind::kBigintValuesUsingBloomFilter:
+      readHelper<
+          Reader,
+          velox::common::BigintValuesUsingBloomFilter,
+          isDense>(filter, rows, extractValues);
+      break;
     case velox::common::FilterKind::kNegatedBigintValuesUsingHashTable:
       readHelper<
           Reader,
@@ -175,6 +181,12 @@ void SelectiveIntegerColumnReader::processValueHook(
     RowSet rows,
     ValueHook* hook) {
   switch (hook->kind()) {
+    case aggregate::AggregationHook::kSumIntegerToBigint:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(),
+          rows,
+          ExtractToHook<aggregate::SumHook<int32_t, int64_t>>(hook));
+      break;
     case aggregate::AggregationHook::kSumBigintToBigint:
       readHelper<Reader, velox::common::AlwaysTrue, isDense>(
           &alwaysTrue(),
@@ -193,6 +205,10 @@ void SelectiveIntegerColumnReader::processValueHook(
           rows,
           ExtractToHook<aggregate::MinMaxHook<int64_t, true>>(hook));
       break;
+    case aggregate::AggregationHook::kCount:
+      readHelper<Reader, velox::common::AlwaysTrue, isDense>(
+          &alwaysTrue(), rows, ExtractToHook<aggregate::CountHook>(hook));
+      break;
     default:
       readHelper<Reader, velox::common::AlwaysTrue, isDense>(
           &alwaysTrue(), rows, ExtractToGenericHook(hook));
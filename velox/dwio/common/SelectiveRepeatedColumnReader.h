@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/common/SelectiveStructColumnReader.h"
 
 namespace facebook::velox::dwio::common {
 
@@ -60,12 +61,14 @@ class SelectiveRepeatedColumnReader : public SelectiveColumnReader {
   // in.
   void makeOffsetsAndSizes(RowSet rows);
 
-  // Creates a struct if '*result' is empty and 'type' is a row.
+  // Creates a struct if '*result' is empty and 'type' is a row. The struct
+  // reader of the elements makes only the children it reads.
   void prepareStructResult(
       const TypePtr& type,
       VectorPtr* FOLLY_NULLABLE result) {
     if (!*result && type->kind() == TypeKind::ROW) {
-      *result = BaseVector::create(type, 0, &memoryPool_);
+      *result = SelectiveStructColumnReaderBase::makeEmptyRowVector(
+          memoryPool_, type);
     }
   }
 
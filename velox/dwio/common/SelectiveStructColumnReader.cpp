@@ -195,30 +195,14 @@ void SelectiveStructColumnReaderBase::recordParentNullsInChildren(
   }
 }
 
-namespace {
-//   Recursively makes empty RowVectors for positions in 'children'
-//   where the corresponding child type in 'rowType' is a row. The
-//   reader expects RowVector outputs to be initialized so that the
-//   content corresponds to the query schema regardless of the file
-//   schema. An empty RowVector can have nullptr for all its non-row
-//   children.
-void fillRowVectorChildren(
+// static
+VectorPtr SelectiveStructColumnReaderBase::makeEmptyRowVector(
     memory::MemoryPool& pool,
-    const RowType& rowType,
-    std::vector<VectorPtr>& children) {
-  for (auto i = 0; i < children.size(); ++i) {
-    const auto& type = rowType.childAt(i);
-    if (type->isRow()) {
-      std::vector<VectorPtr> innerChildren(type->size());
-      fillRowVectorChildren(pool, type->asRow(), innerChildren);
-      children[i] = std::make_shared<RowVector>(
-          &pool, type, nullptr, 0, std::move(innerChildren));
-    }
-  }
+    const TypePtr& type) {
+  return std::make_shared<RowVector>(
+      &pool, type, nullptr, 0, std::vector<VectorPtr>(type->size()));
 }
 
-} // namespace
-
 void SelectiveStructColumnReaderBase::getValues(
     RowSet rows,
     VectorPtr* result) {
@@ -233,10 +217,9 @@ void SelectiveStructColumnReaderBase::getValues(
   const auto& outDataType = outputType_ ? outputType_ : result->get()->type();
   auto& rowType = outDataType->asRow();
   if (outputType_ || !result->unique() || result->get()->isLazy()) {
-    std::vector<VectorPtr> children(rowType.size());
-    fillRowVectorChildren(*result->get()->pool(), rowType, children);
-    *result = std::make_unique<RowVector>(
-        result->get()->pool(), outDataType, nullptr, 0, std::move(children));
+    // The children are made below as they are read. A pruned subfield of a
+    // wide struct costs only its constant null.
+    *result = makeEmptyRowVector(*result->get()->pool(), outDataType);
   }
   auto* resultRow = static_cast<RowVector*>(result->get());
   resultRow->resize(rows.size());
@@ -279,11 +262,27 @@ void SelectiveStructColumnReaderBase::getValues(
             outDataType->childAt(channel),
             rows.size(),
             std::make_unique<ColumnLoader>(this, children_[index], numReads_));
+        numLazyRows_ += rows.size();
       } else {
-        children_[index]->getValues(rows, &resultRow->childAt(channel));
+        auto& childResult = resultRow->childAt(channel);
+        const auto& childType = outDataType->childAt(channel);
+        if (childResult == nullptr && childType->isRow()) {
+          childResult = makeEmptyRowVector(*resultRow->pool(), childType);
+        }
+        children_[index]->getValues(rows, &childResult);
+        children_[index]->maybeEncodeRuns(&childResult);
       }
     }
   }
+  // The content corresponds to the query schema regardless of the file
+  // schema, so the row children that are not read are empty RowVectors. An
+  // empty RowVector can have nullptr for all its children.
+  for (auto i = 0; i < rowType.size(); ++i) {
+    if (resultRow->childAt(i) == nullptr && rowType.childAt(i)->isRow()) {
+      resultRow->childAt(i) =
+          makeEmptyRowVector(*resultRow->pool(), rowType.childAt(i));
+    }
+  }
 }
 
 void SelectiveStructColumnReaderBase::setOutputType(
@@ -50,6 +50,15 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return lazyVectorReadOffset_;
   }
 
+  uint64_t numLazySkippedRows() const override {
+    return numLazyRows_ - numLazyLoadedRows_;
+  }
+
+  // Called by ColumnLoader with the number of rows it decodes.
+  void addLazyLoadedRows(uint64_t numRows) {
+    numLazyLoadedRows_ += numRows;
+  }
+
   /// Advance field reader to the row group closest to specified offset by
   /// calling seekToRowGroup.
   virtual void advanceFieldReader(
@@ -95,6 +104,13 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
     return debugString_;
   }
 
+  /// Returns an empty RowVector of 'type' with nullptr children. The struct
+  /// reader makes the children it reads into it, so that no vectors are made
+  /// for the pruned fields of a wide nested struct.
+  static VectorPtr makeEmptyRowVector(
+      memory::MemoryPool& pool,
+      const TypePtr& type);
+
  protected:
   SelectiveStructColumnReaderBase(
       const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
@@ -128,6 +144,10 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
 
   vector_size_t lazyVectorReadOffset_;
 
+  // Rows of LazyVectors made by 'this' and rows of these decoded at load.
+  uint64_t numLazyRows_{0};
+  uint64_t numLazyLoadedRows_{0};
+
   // Dense set of rows to read in next().
   raw_vector<vector_size_t> rows_;
 
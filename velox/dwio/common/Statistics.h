@@ -529,6 +529,15 @@ struct RuntimeStatistics {
   // Number of strides (row groups) processed based on statistics.
   int64_t processedStrides{0};
 
+  // Rows of columns loaded lazily that were never decoded because no
+  // consumer accessed them, e.g. after a remaining filter dropped them.
+  // Summed over the columns.
+  int64_t skippedLazyRows{0};
+
+  // Number of splits whose row count was taken from the file metadata
+  // without reading any data.
+  int64_t metadataOnlySplits{0};
+
   std::unordered_map<std::string, RuntimeCounter> toMap() {
     return {
         {"skippedSplits", RuntimeCounter(skippedSplits)},
@@ -536,7 +545,9 @@ struct RuntimeStatistics {
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
-        {"processedStrides", RuntimeCounter(processedStrides)}};
+        {"processedStrides", RuntimeCounter(processedStrides)},
+        {"skippedLazyRows", RuntimeCounter(skippedLazyRows)},
+        {"metadataOnlySplits", RuntimeCounter(metadataOnlySplits)}};
   }
 };
 
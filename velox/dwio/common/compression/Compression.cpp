@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/Compression.h"
+
+#include "velox/dwio/common/compression/LzoDecompressor.h"
+#include "velox/dwio/common/exception/Exception.h"
+
+#include <folly/Conv.h>
+#include <lz4.h>
+#include <optional>
+#include <snappy.h>
+#include <zstd.h>
+
+#ifdef VELOX_ENABLE_BROTLI
+#include <brotli/decode.h>
+#endif
+
+namespace facebook::velox::dwio::common::compression {
+
+ZlibDecompressor::ZlibDecompressor(
+    uint64_t blockSize,
+    const std::string& streamDebugInfo,
+    int32_t windowBits)
+    : Decompressor{blockSize, streamDebugInfo} {
+  zstream_.next_in = Z_NULL;
+  zstream_.avail_in = 0;
+  zstream_.zalloc = Z_NULL;
+  zstream_.zfree = Z_NULL;
+  zstream_.opaque = Z_NULL;
+  zstream_.next_out = Z_NULL;
+  zstream_.avail_out = folly::to<uInt>(blockSize);
+  auto result = inflateInit2(&zstream_, windowBits);
+  DWIO_ENSURE_EQ(
+      result,
+      Z_OK,
+      "Error from inflateInit2. error: ",
+      result,
+      " Info: ",
+      streamDebugInfo_);
+}
+
+ZlibDecompressor::~ZlibDecompressor() {
+  auto result = inflateEnd(&zstream_);
+  DWIO_WARN_IF(
+      result != Z_OK,
+      "Error in ~ZlibDecompressor(). error: ",
+      result,
+      " Info: ",
+      streamDebugInfo_);
+}
+
+void ZlibDecompressor::reset() {
+  auto result = inflateReset(&zstream_);
+  DWIO_ENSURE_EQ(
+      result,
+      Z_OK,
+      "Bad inflateReset in ZlibDecompressor::reset. error: ",
+      result);
+}
+
+uint64_t ZlibDecompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  reset();
+  zstream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src));
+  zstream_.avail_in = folly::to<uInt>(srcLength);
+  zstream_.next_out = reinterpret_cast<Bytef*>(const_cast<char*>(dest));
+  zstream_.avail_out = folly::to<uInt>(destLength);
+  auto result = inflate(&zstream_, Z_FINISH);
+  DWIO_ENSURE_EQ(
+      result,
+      Z_STREAM_END,
+      "Error in ZlibDecompressor::decompress. error: ",
+      result);
+  return destLength - zstream_.avail_out;
+}
+
+namespace {
+
+class LzoDecompressor : public Decompressor {
+ public:
+  explicit LzoDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    return lzoDecompress(src, src + srcLength, dest, dest + destLength);
+  }
+};
+
+class Lz4Decompressor : public Decompressor {
+ public:
+  explicit Lz4Decompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+};
+
+uint64_t Lz4Decompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  int32_t result = LZ4_decompress_safe(
+      src,
+      dest,
+      static_cast<int32_t>(srcLength),
+      static_cast<int32_t>(destLength));
+
+  DWIO_ENSURE_GE(
+      result, 0, "lz4 failed to decompress. Info: ", streamDebugInfo_);
+  return static_cast<uint64_t>(result);
+}
+
+// LZ4 with the block framing of the Hadoop Lz4Codec: each block is
+// preceded by big endian 32 bit uncompressed and compressed sizes. Legacy
+// Parquet LZ4 files were written either with or without this framing, so
+// falls back to a raw LZ4 block if the data does not parse as framed.
+class Lz4HadoopDecompressor : public Lz4Decompressor {
+ public:
+  explicit Lz4HadoopDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Lz4Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    auto result = tryDecompressFramed(src, srcLength, dest, destLength);
+    if (result.has_value()) {
+      return result.value();
+    }
+    return Lz4Decompressor::decompress(src, srcLength, dest, destLength);
+  }
+
+ private:
+  static constexpr uint64_t kPrefixLength = 2 * sizeof(uint32_t);
+
+  static uint32_t readBigEndian(const char* data) {
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return __builtin_bswap32(value);
+  }
+
+  std::optional<uint64_t> tryDecompressFramed(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) {
+    uint64_t totalLength = 0;
+    while (srcLength >= kPrefixLength) {
+      auto uncompressedLength = readBigEndian(src);
+      auto compressedLength = readBigEndian(src + sizeof(uint32_t));
+      src += kPrefixLength;
+      srcLength -= kPrefixLength;
+      if (compressedLength > srcLength || uncompressedLength > destLength) {
+        return std::nullopt;
+      }
+      auto result = LZ4_decompress_safe(
+          src,
+          dest,
+          static_cast<int32_t>(compressedLength),
+          static_cast<int32_t>(destLength));
+      if (result < 0 || static_cast<uint32_t>(result) != uncompressedLength) {
+        return std::nullopt;
+      }
+      src += compressedLength;
+      srcLength -= compressedLength;
+      dest += result;
+      destLength -= result;
+      totalLength += result;
+    }
+    if (srcLength != 0) {
+      return std::nullopt;
+    }
+    return totalLength;
+  }
+};
+
+class ZstdDecompressor : public Decompressor {
+ public:
+  explicit ZstdDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+  uint64_t getUncompressedLength(const char* src, uint64_t srcLength)
+      const override;
+};
+
+uint64_t ZstdDecompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
+  DWIO_ENSURE(
+      !ZSTD_isError(ret),
+      "ZSTD returned an error: ",
+      ZSTD_getErrorName(ret),
+      " Info: ",
+      streamDebugInfo_);
+  return ret;
+}
+
+uint64_t ZstdDecompressor::getUncompressedLength(
+    const char* src,
+    uint64_t srcLength) const {
+  auto uncompressedLength = ZSTD_getFrameContentSize(src, srcLength);
+  // in the case when decompression size is not available, return the upper
+  // bound
+  if (uncompressedLength == ZSTD_CONTENTSIZE_UNKNOWN ||
+      uncompressedLength == ZSTD_CONTENTSIZE_ERROR) {
+    return blockSize_;
+  }
+  DWIO_ENSURE_LE(
+      uncompressedLength,
+      blockSize_,
+      "Insufficient buffer size. Info: ",
+      streamDebugInfo_);
+  return uncompressedLength;
+}
+
+class SnappyDecompressor : public Decompressor {
+ public:
+  explicit SnappyDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+  uint64_t getUncompressedLength(const char* src, uint64_t srcLength)
+      const override;
+};
+
+uint64_t SnappyDecompressor::decompress(
+    const char* src,
+    uint64_t srcLength,
+    char* dest,
+    uint64_t destLength) {
+  auto length = getUncompressedLength(src, srcLength);
+  DWIO_ENSURE_GE(destLength, length);
+  DWIO_ENSURE(
+      snappy::RawUncompress(src, srcLength, dest),
+      "Snappy decompress failed. Info: ",
+      streamDebugInfo_);
+  return length;
+}
+
+uint64_t SnappyDecompressor::getUncompressedLength(
+    const char* src,
+    uint64_t srcLength) const {
+  size_t uncompressedLength;
+  // in the case when decompression size is not available, return the upper
+  // bound
+  if (!snappy::GetUncompressedLength(src, srcLength, &uncompressedLength)) {
+    return blockSize_;
+  }
+  DWIO_ENSURE_LE(
+      uncompressedLength,
+      blockSize_,
+      "Insufficient buffer size. Info: ",
+      streamDebugInfo_);
+  return uncompressedLength;
+}
+
+#ifdef VELOX_ENABLE_BROTLI
+class BrotliDecompressor : public Decompressor {
+ public:
+  explicit BrotliDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo)
+      : Decompressor{blockSize, streamDebugInfo} {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    size_t length = destLength;
+    auto result = BrotliDecoderDecompress(
+        srcLength,
+        reinterpret_cast<const uint8_t*>(src),
+        &length,
+        reinterpret_cast<uint8_t*>(dest));
+    DWIO_ENSURE_EQ(
+        result,
+        BROTLI_DECODER_RESULT_SUCCESS,
+        "Brotli failed to decompress. Info: ",
+        streamDebugInfo_);
+    return length;
+  }
+};
+#endif
+
+} // namespace
+
+bool isDecompressorAvailable(CompressionKind kind) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind_ZLIB:
+    case CompressionKind_GZIP:
+    case CompressionKind_SNAPPY:
+    case CompressionKind_LZO:
+    case CompressionKind_LZ4:
+    case CompressionKind_LZ4_HADOOP:
+    case CompressionKind_ZSTD:
+      return true;
+#ifdef VELOX_ENABLE_BROTLI
+    case CompressionKind_BROTLI:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<Decompressor> createDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo) {
+  switch (static_cast<int64_t>(kind)) {
+    case CompressionKind_ZLIB:
+      return std::make_unique<ZlibDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind_GZIP:
+      // Window bits 15 with 32 added to detect zlib or gzip headers.
+      return std::make_unique<ZlibDecompressor>(
+          blockSize, streamDebugInfo, 15 + 32);
+    case CompressionKind_SNAPPY:
+      return std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind_LZO:
+      return std::make_unique<LzoDecompressor>(blockSize, streamDebugInfo);
+    case CompressionKind_LZ4:
+      return std::make_unique<Lz4Decompressor>(blockSize, streamDebugInfo);
+    case CompressionKind_LZ4_HADOOP:
+      return std::make_unique<Lz4HadoopDecompressor>(
+          blockSize, streamDebugInfo);
+    case CompressionKind_ZSTD:
+      return std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+#ifdef VELOX_ENABLE_BROTLI
+    case CompressionKind_BROTLI:
+      return std::make_unique<BrotliDecompressor>(blockSize, streamDebugInfo);
+#endif
+    default:
+      DWIO_RAISE("Unsupported compression codec ", kind);
+  }
+}
+
+} // namespace facebook::velox::dwio::common::compression
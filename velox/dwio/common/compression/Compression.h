@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <zlib.h>
+#include <memory>
+#include <string>
+
+#include "velox/dwio/common/Common.h"
+
+namespace facebook::velox::dwio::common::compression {
+
+/// Decompresses whole blocks of compressed data. Shared by the file formats
+/// so that every format gets the same set of codecs.
+class Decompressor {
+ public:
+  explicit Decompressor(uint64_t blockSize, const std::string& streamDebugInfo)
+      : blockSize_{blockSize}, streamDebugInfo_{streamDebugInfo} {}
+
+  virtual ~Decompressor() = default;
+
+  /// Returns the uncompressed size of the 'srcLength' bytes at 'src' if the
+  /// codec records it, otherwise the block size given at construction.
+  virtual uint64_t getUncompressedLength(
+      const char* /* unused */,
+      uint64_t /* unused */) const {
+    return blockSize_;
+  }
+
+  /// Decompresses 'srcLength' bytes at 'src' into at most 'destLength' bytes
+  /// at 'dest'. Returns the number of bytes produced.
+  virtual uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) = 0;
+
+ protected:
+  uint64_t blockSize_;
+  const std::string streamDebugInfo_;
+};
+
+/// Inflates deflate streams. 'windowBits' is passed to inflateInit2: the
+/// default of -15 reads raw deflate as in DWRF, 15 + 32 detects zlib and gzip
+/// headers as in Parquet GZIP.
+class ZlibDecompressor : public Decompressor {
+ public:
+  ZlibDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo,
+      int32_t windowBits = -15);
+
+  ~ZlibDecompressor() override;
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override;
+
+ protected:
+  void reset();
+
+  z_stream zstream_;
+};
+
+/// Returns true if a decompressor for 'kind' is available in this build.
+bool isDecompressorAvailable(CompressionKind kind);
+
+/// Creates a decompressor for 'kind'. 'blockSize' is the upper bound of the
+/// uncompressed size of a block. Throws for CompressionKind_NONE and for
+/// codecs that are not available.
+std::unique_ptr<Decompressor> createDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo);
+
+} // namespace facebook::velox::dwio::common::compression
@@ -89,6 +89,19 @@ class Decrypter {
   virtual std::unique_ptr<folly::IOBuf> decrypt(
       folly::StringPiece input) const = 0;
 
+  // Decrypts several independently encrypted blocks in one call. Providers
+  // that can pipeline blocks, e.g. through vectorized AES rounds, override
+  // this. The default decrypts the blocks one at a time.
+  virtual std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+      const std::vector<folly::StringPiece>& inputs) const {
+    std::vector<std::unique_ptr<folly::IOBuf>> outputs;
+    outputs.reserve(inputs.size());
+    for (const auto& input : inputs) {
+      outputs.push_back(decrypt(input));
+    }
+    return outputs;
+  }
+
   virtual std::unique_ptr<Decrypter> clone() const = 0;
 };
 
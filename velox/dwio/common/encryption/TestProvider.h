@@ -58,7 +58,7 @@ class TestEncryption {
 
  private:
   std::string key_;
-  mutable size_t count_;
+  mutable size_t count_{0};
 };
 
 class TestEncrypter : public TestEncryption, public Encrypter {
@@ -94,11 +94,24 @@ class TestDecrypter : public TestEncryption, public Decrypter {
     return TestEncryption::decrypt(input);
   }
 
+  std::vector<std::unique_ptr<folly::IOBuf>> decryptBatch(
+      const std::vector<folly::StringPiece>& inputs) const override {
+    ++batchCount_;
+    return Decrypter::decryptBatch(inputs);
+  }
+
+  size_t getBatchCount() const {
+    return batchCount_;
+  }
+
   std::unique_ptr<Decrypter> clone() const override {
     auto decrypter = std::make_unique<TestDecrypter>();
     decrypter->setKey(getKey());
     return decrypter;
   }
+
+ private:
+  mutable size_t batchCount_{0};
 };
 
 class TestEncryptionProperties : public EncryptionProperties {
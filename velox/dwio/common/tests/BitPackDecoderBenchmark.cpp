@@ -46,6 +46,10 @@ std::vector<uint8_t> result8;
 std::vector<uint16_t> result16;
 std::vector<uint32_t> result32;
 
+// Bit packed representations of randomInts_u64, 1 to 64 bits wide.
+std::vector<std::vector<uint64_t>> bitPackedData64;
+std::vector<uint64_t> result64;
+
 std::vector<int32_t> allRowNumbers;
 std::vector<int32_t> oddRowNumbers;
 RowSet allRows;
@@ -143,6 +147,21 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
       duckInputBuffer, bitpack_pos, result, kNumValues, bitWidth);
 }
 
+void veloxBitUnpack64(uint8_t bitWidth) {
+  const uint8_t* inputIter =
+      reinterpret_cast<const uint8_t*>(bitPackedData64[bitWidth].data());
+  auto* result = result64.data();
+  facebook::velox::dwio::common::unpack<uint64_t>(
+      inputIter, BYTES(kNumValues, bitWidth), kNumValues, bitWidth, result);
+}
+
+void arrowBitUnpack64(uint8_t bitWidth) {
+  arrow::bit_util::BitReader bitReader(
+      reinterpret_cast<const uint8_t*>(bitPackedData64[bitWidth].data()),
+      BYTES(kNumValues, bitWidth));
+  bitReader.GetBatch<uint64_t>(bitWidth, result64.data(), kNumValues);
+}
+
 #define BENCHMARK_UNPACK_FULLROWS_CASE_8(width)                  \
   BENCHMARK(velox_unpack_fullrows_##width##_8) {                 \
     veloxBitUnpack<uint8_t>(width, result8.data());              \
@@ -209,6 +228,15 @@ void duckdbBitUnpack(uint8_t bitWidth, T* result) {
   }                                                               \
   BENCHMARK_DRAW_LINE();
 
+#define BENCHMARK_UNPACK_FULLROWS_CASE_64(width)           \
+  BENCHMARK(velox_unpack_fullrows_##width##_64) {          \
+    veloxBitUnpack64(width);                               \
+  }                                                        \
+  BENCHMARK_RELATIVE(arrow_unpack_fullrows_##width##_64) { \
+    arrowBitUnpack64(width);                               \
+  }                                                        \
+  BENCHMARK_DRAW_LINE();
+
 #define BENCHMARK_UNPACK_ODDROWS_CASE_8(width)                  \
   BENCHMARK_RELATIVE(legacy_unpack_naive_oddrows_##width##_8) { \
     legacyUnpackNaive<uint8_t>(oddRows, width, result8.data()); \
@@ -289,6 +317,20 @@ BENCHMARK_UNPACK_FULLROWS_CASE_32(32)
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_UNPACK_FULLROWS_CASE_64(1)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(7)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(13)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(24)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(32)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(33)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(45)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(56)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(57)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(63)
+BENCHMARK_UNPACK_FULLROWS_CASE_64(64)
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_UNPACK_ODDROWS_CASE_8(1)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(2)
 BENCHMARK_UNPACK_ODDROWS_CASE_8(4)
@@ -331,6 +373,20 @@ void populateBitPacked() {
     }
   }
 
+  bitPackedData64.resize(65);
+  for (auto bitWidth = 1; bitWidth <= 64; ++bitWidth) {
+    auto numWords = bits::roundUp(randomInts_u64.size() * bitWidth, 64) / 64;
+    bitPackedData64[bitWidth].resize(numWords);
+    for (auto i = 0; i < randomInts_u64.size(); ++i) {
+      bits::copyBits(
+          randomInts_u64.data(),
+          i * 64,
+          bitPackedData64[bitWidth].data(),
+          i * bitWidth,
+          bitWidth);
+    }
+  }
+
   allRowNumbers.resize(randomInts_u32.size());
   std::iota(allRowNumbers.begin(), allRowNumbers.end(), 0);
 
@@ -421,12 +477,16 @@ int32_t main(int32_t argc, char* argv[]) {
     randomInts_u32.push_back(randomInt);
   }
   randomInts_u32_result.resize(randomInts_u32.size());
+  for (int32_t i = 0; i < kNumValues; i++) {
+    randomInts_u64.push_back(folly::Random::rand64());
+  }
 
   populateBitPacked();
 
   result8.resize(randomInts_u32.size());
   result16.resize(randomInts_u32.size());
   result32.resize(randomInts_u32.size());
+  result64.resize(randomInts_u64.size());
 
   randomInts_u64_result.resize(randomInts_u64.size());
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/compression/Compression.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <lz4.h>
+#include <zlib.h>
+
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwio::common::compression;
+
+namespace {
+
+std::string makeData(int32_t size) {
+  std::string data;
+  for (auto i = 0; data.size() < size; ++i) {
+    data += fmt::format("value {} ", i % 100);
+  }
+  data.resize(size);
+  return data;
+}
+
+std::string lz4Compress(const std::string& data) {
+  std::string compressed(LZ4_compressBound(data.size()), 0);
+  auto size = LZ4_compress_default(
+      data.data(), compressed.data(), data.size(), compressed.size());
+  compressed.resize(size);
+  return compressed;
+}
+
+void appendBigEndian(std::string& out, uint32_t value) {
+  value = __builtin_bswap32(value);
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void expectDecompress(
+    CompressionKind kind,
+    const std::string& compressed,
+    const std::string& expected) {
+  auto decompressor = createDecompressor(kind, expected.size(), "test");
+  std::string result(expected.size(), 0);
+  auto size = decompressor->decompress(
+      compressed.data(), compressed.size(), result.data(), result.size());
+  EXPECT_EQ(expected.size(), size);
+  EXPECT_EQ(expected, result);
+}
+
+} // namespace
+
+TEST(CompressionTest, lz4Raw) {
+  auto data = makeData(10'000);
+  expectDecompress(CompressionKind_LZ4, lz4Compress(data), data);
+}
+
+TEST(CompressionTest, lz4Hadoop) {
+  auto data = makeData(100'000);
+  // Two framed blocks.
+  std::string framed;
+  for (auto& part : {data.substr(0, 30'000), data.substr(30'000)}) {
+    auto compressed = lz4Compress(part);
+    appendBigEndian(framed, part.size());
+    appendBigEndian(framed, compressed.size());
+    framed += compressed;
+  }
+  expectDecompress(CompressionKind_LZ4_HADOOP, framed, data);
+  // Unframed data falls back to a raw LZ4 block.
+  expectDecompress(CompressionKind_LZ4_HADOOP, lz4Compress(data), data);
+}
+
+TEST(CompressionTest, gzip) {
+  auto data = makeData(10'000);
+  z_stream stream{};
+  // 15 + 16 writes a gzip header.
+  ASSERT_EQ(
+      Z_OK,
+      deflateInit2(
+          &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, 0));
+  std::string compressed(deflateBound(&stream, data.size()), 0);
+  stream.next_in = reinterpret_cast<Bytef*>(data.data());
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+  stream.avail_out = compressed.size();
+  ASSERT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  expectDecompress(CompressionKind_GZIP, compressed, data);
+}
+
+TEST(CompressionTest, availability) {
+  EXPECT_TRUE(isDecompressorAvailable(CompressionKind_LZ4));
+  EXPECT_TRUE(isDecompressorAvailable(CompressionKind_LZ4_HADOOP));
+  EXPECT_FALSE(isDecompressorAvailable(CompressionKind_NONE));
+  EXPECT_THROW(
+      createDecompressor(CompressionKind_NONE, 100, "test"), std::exception);
+}
@@ -39,6 +39,7 @@ class ReadFileMock : public ::facebook::velox::ReadFile {
   MOCK_METHOD(uint64_t, memoryUsage, (), (const, override));
   MOCK_METHOD(std::string, getName, (), (const, override));
   MOCK_METHOD(uint64_t, getNaturalReadSize, (), (const, override));
+  MOCK_METHOD(std::optional<ReadCost>, readCost, (), (const, override));
   MOCK_METHOD(
       void,
       preadv,
@@ -245,6 +246,36 @@ TEST(TestBufferedInput, WontMerge) {
   EXPECT_EQ(next2.value(), "world");
 }
 
+TEST(TestBufferedInput, MergeByReadCost) {
+  std::string content = "hello  world"; // two spaces
+  auto readFileMock = std::make_shared<ReadFileMock>();
+
+  // The fixed distance 1 would not merge but a read costs as much as reading
+  // 10 more bytes, so the gap of 2 is read. Expect one call.
+  expectPreads(*readFileMock, content, {{0, 12}});
+  EXPECT_CALL(*readFileMock, readCost())
+      .WillRepeatedly(Return(facebook::velox::ReadFile::ReadCost{1, 10}));
+
+  auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
+  IoStatistics stats;
+  BufferedInput input(
+      readFileMock,
+      *pool,
+      MetricsLog::voidLog(),
+      &stats,
+      1,
+      /* wsVRLoad = */ false);
+
+  auto ret1 = input.enqueue({0, 5});
+  auto ret2 = input.enqueue({7, 5});
+  input.load(LogType::TEST);
+  EXPECT_EQ(getNext(*ret1).value(), "hello");
+  EXPECT_EQ(getNext(*ret2).value(), "world");
+  EXPECT_EQ(1, stats.coalescedRead().count());
+  EXPECT_EQ(2, stats.coalescedRead().sum());
+  EXPECT_EQ(2, stats.rawOverreadBytes());
+}
+
 TEST(TestBufferedInput, ReadSorting) {
   std::string content = "aaabbbcccdddeeefffggghhhiiijjjkkklllmmmnnnooopppqqq";
   std::vector<Region> regions = {{6, 3}, {24, 3}, {3, 3}, {0, 3}, {29, 3}};
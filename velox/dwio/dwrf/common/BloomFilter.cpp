@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/dwrf/common/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::dwrf {
+
+uint64_t bloomFilterHash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+uint64_t bloomFilterHash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+bool isBloomFilterSupported(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace {
+template <typename Values>
+bool mayContainAny(const BloomFilter<>& bloomFilter, const Values& values) {
+  for (const auto& value : values) {
+    if (bloomFilter.mayContain(bloomFilterHash(value))) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool isBloomFilterApplicable(const common::Filter& filter, TypeKind kind) {
+  if (filter.testNull() || !isBloomFilterSupported(kind)) {
+    // Nulls are not in the Bloom filter.
+    return false;
+  }
+  const bool isString = kind == TypeKind::VARCHAR;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return !isString &&
+          static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return !isString;
+    case common::FilterKind::kBytesRange:
+      return isString &&
+          static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesValues:
+      return isString;
+    default:
+      return false;
+  }
+}
+
+bool testFilterOnBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter<>& bloomFilter,
+    TypeKind kind) {
+  if (!isBloomFilterApplicable(filter, kind)) {
+    return true;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return bloomFilter.mayContain(bloomFilterHash(range.lower()));
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      return mayContainAny(
+          bloomFilter,
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values());
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return mayContainAny(
+          bloomFilter,
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values());
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      return bloomFilter.mayContain(
+          bloomFilterHash(std::string_view(range.lower())));
+    }
+    case common::FilterKind::kBytesValues:
+      return mayContainAny(
+          bloomFilter,
+          static_cast<const common::BytesValues&>(filter).values());
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::dwrf
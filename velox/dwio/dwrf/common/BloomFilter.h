@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <string_view>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/type/Filter.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::dwrf {
+
+// Bloom filters of the DWRF row index are split block filters
+// (BloomFilter<>::kBloomFilterV2) in their serialized form in the utf8bitset
+// field of proto::BloomFilter. Each value sets one bit in each of 8 words of a
+// block.
+constexpr uint32_t kBloomFilterNumHashFunctions = 8;
+
+// Hash of an integer value in a Bloom filter. Values of all integer widths are
+// hashed as int64_t so that they match the values of integer filters.
+uint64_t bloomFilterHash(int64_t value);
+
+// Hash of a string value in a Bloom filter.
+uint64_t bloomFilterHash(std::string_view value);
+
+// True if the writer adds the values of a column of 'kind' to a Bloom filter
+// when requested.
+bool isBloomFilterSupported(TypeKind kind);
+
+// True if 'filter' on a column of 'kind' can be tested on a Bloom filter, i.e.
+// it passes only some discrete values and no nulls.
+bool isBloomFilterApplicable(const common::Filter& filter, TypeKind kind);
+
+// False if no value passing 'filter' is in 'bloomFilter'. True if 'filter'
+// is not applicable.
+bool testFilterOnBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter<>& bloomFilter,
+    TypeKind kind);
+
+} // namespace facebook::velox::dwrf
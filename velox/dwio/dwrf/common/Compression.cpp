@@ -17,20 +17,18 @@
 #include "velox/dwio/dwrf/common/Compression.h"
 
 #include "velox/dwio/common/Common.h"
-#include "velox/dwio/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/PagedInputStream.h"
 #include "velox/dwio/dwrf/common/PagedOutputStream.h"
 
 #include <folly/logging/xlog.h>
-#include <lz4.h>
-#include <snappy.h>
 #include <zlib.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 
 namespace facebook::velox::dwrf {
 
+using dwio::common::compression::ZlibDecompressor;
 using dwio::common::encryption::Decrypter;
 using dwio::common::encryption::Encrypter;
 using memory::MemoryPool;
@@ -110,227 +108,6 @@ ZlibCompressor::compress(const void* src, void* dest, uint64_t length) {
   return stream_.total_out;
 }
 
-class ZlibDecompressor : public Decompressor {
- public:
-  explicit ZlibDecompressor(
-      uint64_t blockSize,
-      const std::string& streamDebugInfo);
-  ~ZlibDecompressor() override;
-
-  uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) override;
-
- protected:
-  void reset() {
-    auto result = inflateReset(&zstream_);
-    DWIO_ENSURE_EQ(
-        result,
-        Z_OK,
-        "Bad inflateReset in ZlibDecompressor::reset. error: ",
-        result);
-  }
-
-  z_stream zstream_;
-};
-
-ZlibDecompressor::ZlibDecompressor(
-    uint64_t blockSize,
-    const std::string& streamDebugInfo)
-    : Decompressor{blockSize, streamDebugInfo} {
-  zstream_.next_in = Z_NULL;
-  zstream_.avail_in = 0;
-  zstream_.zalloc = Z_NULL;
-  zstream_.zfree = Z_NULL;
-  zstream_.opaque = Z_NULL;
-  zstream_.next_out = Z_NULL;
-  zstream_.avail_out = folly::to<uInt>(blockSize);
-  auto result = inflateInit2(&zstream_, -15);
-  DWIO_ENSURE_EQ(
-      result,
-      Z_OK,
-      "Error from inflateInit2. error: ",
-      result,
-      " Info: ",
-      streamDebugInfo_);
-}
-
-ZlibDecompressor::~ZlibDecompressor() {
-  auto result = inflateEnd(&zstream_);
-  DWIO_WARN_IF(
-      result != Z_OK,
-      "Error in ~ZlibDecompressor(). error: ",
-      result,
-      " Info: ",
-      streamDebugInfo_);
-}
-
-uint64_t ZlibDecompressor::decompress(
-    const char* src,
-    uint64_t srcLength,
-    char* dest,
-    uint64_t destLength) {
-  reset();
-  zstream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src));
-  zstream_.avail_in = folly::to<uInt>(srcLength);
-  zstream_.next_out = reinterpret_cast<Bytef*>(const_cast<char*>(dest));
-  zstream_.avail_out = folly::to<uInt>(destLength);
-  auto result = inflate(&zstream_, Z_FINISH);
-  DWIO_ENSURE_EQ(
-      result,
-      Z_STREAM_END,
-      "Error in ZlibDecompressor::decompress. error: ",
-      result);
-  return destLength - zstream_.avail_out;
-}
-
-class LzoDecompressor : public Decompressor {
- public:
-  explicit LzoDecompressor(
-      uint64_t blockSize,
-      const std::string& streamDebugInfo)
-      : Decompressor{blockSize, streamDebugInfo} {}
-
-  uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) override {
-    return dwio::common::compression::lzoDecompress(
-        src, src + srcLength, dest, dest + destLength);
-  }
-};
-
-class Lz4Decompressor : public Decompressor {
- public:
-  explicit Lz4Decompressor(
-      uint64_t blockSize,
-      const std::string& streamDebugInfo)
-      : Decompressor{blockSize, streamDebugInfo} {}
-
-  uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) override;
-};
-
-uint64_t Lz4Decompressor::decompress(
-    const char* src,
-    uint64_t srcLength,
-    char* dest,
-    uint64_t destLength) {
-  int32_t result = LZ4_decompress_safe(
-      src,
-      dest,
-      static_cast<int32_t>(srcLength),
-      static_cast<int32_t>(destLength));
-
-  DWIO_ENSURE_GE(
-      result, 0, "lz4 failed to decompress. Info: ", streamDebugInfo_);
-  return static_cast<uint64_t>(result);
-}
-
-class ZstdDecompressor : public Decompressor {
- public:
-  explicit ZstdDecompressor(
-      uint64_t blockSize,
-      const std::string& streamDebugInfo)
-      : Decompressor{blockSize, streamDebugInfo} {}
-
-  uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) override;
-
-  uint64_t getUncompressedLength(const char* src, uint64_t srcLength)
-      const override;
-};
-
-uint64_t ZstdDecompressor::decompress(
-    const char* src,
-    uint64_t srcLength,
-    char* dest,
-    uint64_t destLength) {
-  auto ret = ZSTD_decompress(dest, destLength, src, srcLength);
-  DWIO_ENSURE(
-      !ZSTD_isError(ret),
-      "ZSTD returned an error: ",
-      ZSTD_getErrorName(ret),
-      " Info: ",
-      streamDebugInfo_);
-  return ret;
-}
-
-uint64_t ZstdDecompressor::getUncompressedLength(
-    const char* src,
-    uint64_t srcLength) const {
-  auto uncompressedLength = ZSTD_getFrameContentSize(src, srcLength);
-  // in the case when decompression size is not available, return the upper
-  // bound
-  if (uncompressedLength == ZSTD_CONTENTSIZE_UNKNOWN ||
-      uncompressedLength == ZSTD_CONTENTSIZE_ERROR) {
-    return blockSize_;
-  }
-  DWIO_ENSURE_LE(
-      uncompressedLength,
-      blockSize_,
-      "Insufficient buffer size. Info: ",
-      streamDebugInfo_);
-  return uncompressedLength;
-}
-
-class SnappyDecompressor : public Decompressor {
- public:
-  explicit SnappyDecompressor(
-      uint64_t blockSize,
-      const std::string& streamDebugInfo)
-      : Decompressor{blockSize, streamDebugInfo} {}
-
-  uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) override;
-
-  uint64_t getUncompressedLength(const char* src, uint64_t srcLength)
-      const override;
-};
-
-uint64_t SnappyDecompressor::decompress(
-    const char* src,
-    uint64_t srcLength,
-    char* dest,
-    uint64_t destLength) {
-  auto length = getUncompressedLength(src, srcLength);
-  DWIO_ENSURE_GE(destLength, length);
-  DWIO_ENSURE(
-      snappy::RawUncompress(src, srcLength, dest),
-      "Snappy decompress failed. Info: ",
-      streamDebugInfo_);
-  return length;
-}
-
-uint64_t SnappyDecompressor::getUncompressedLength(
-    const char* src,
-    uint64_t srcLength) const {
-  size_t uncompressedLength;
-  // in the case when decompression size is not available, return the upper
-  // bound
-  if (!snappy::GetUncompressedLength(src, srcLength, &uncompressedLength)) {
-    return blockSize_;
-  }
-  DWIO_ENSURE_LE(
-      uncompressedLength,
-      blockSize_,
-      "Insufficient buffer size. Info: ",
-      streamDebugInfo_);
-  return uncompressedLength;
-}
-
 class ZlibDecompressionStream : public PagedInputStream,
                                 private ZlibDecompressor {
  public:
@@ -495,24 +272,15 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
         return std::make_unique<ZlibDecompressionStream>(
             std::move(input), blockSize, pool, streamDebugInfo);
       }
-      decompressor =
-          std::make_unique<ZlibDecompressor>(blockSize, streamDebugInfo);
+      decompressor = dwio::common::compression::createDecompressor(
+          kind, blockSize, streamDebugInfo);
       break;
     case dwio::common::CompressionKind_SNAPPY:
-      decompressor =
-          std::make_unique<SnappyDecompressor>(blockSize, streamDebugInfo);
-      break;
     case dwio::common::CompressionKind_LZO:
-      decompressor =
-          std::make_unique<LzoDecompressor>(blockSize, streamDebugInfo);
-      break;
     case dwio::common::CompressionKind_LZ4:
-      decompressor =
-          std::make_unique<Lz4Decompressor>(blockSize, streamDebugInfo);
-      break;
     case dwio::common::CompressionKind_ZSTD:
-      decompressor =
-          std::make_unique<ZstdDecompressor>(blockSize, streamDebugInfo);
+      decompressor = dwio::common::compression::createDecompressor(
+          kind, blockSize, streamDebugInfo);
       break;
     default:
       DWIO_RAISE("Unknown compression codec ", kind);
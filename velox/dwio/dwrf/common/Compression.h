@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/Common.h"
 #include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/CompressionBufferPool.h"
 #include "velox/dwio/dwrf/common/Config.h"
@@ -41,29 +42,7 @@ class Compressor {
   int32_t level_;
 };
 
-class Decompressor {
- public:
-  explicit Decompressor(uint64_t blockSize, const std::string& streamDebugInfo)
-      : blockSize_{blockSize}, streamDebugInfo_{streamDebugInfo} {}
-
-  virtual ~Decompressor() = default;
-
-  virtual uint64_t getUncompressedLength(
-      const char* /* unused */,
-      uint64_t /* unused */) const {
-    return blockSize_;
-  }
-
-  virtual uint64_t decompress(
-      const char* src,
-      uint64_t srcLength,
-      char* dest,
-      uint64_t destLength) = 0;
-
- protected:
-  uint64_t blockSize_;
-  const std::string streamDebugInfo_;
-};
+using dwio::common::compression::Decompressor;
 
 /**
  * Create a decompressor for the given compression kind.
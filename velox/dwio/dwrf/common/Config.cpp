@@ -21,6 +21,29 @@
 
 namespace facebook::velox::dwrf {
 
+namespace {
+std::string columnsToString(const std::vector<uint32_t>& val) {
+  return folly::join(",", val);
+}
+
+std::vector<uint32_t> columnsFromString(
+    const std::string& /* key */,
+    const std::string& val) {
+  std::vector<uint32_t> result;
+  if (!val.empty()) {
+    std::vector<folly::StringPiece> pieces;
+    folly::split(',', val, pieces, true);
+    for (auto& p : pieces) {
+      const auto& trimmedCol = folly::trimWhitespace(p);
+      if (!trimmedCol.empty()) {
+        result.push_back(folly::to<uint32_t>(trimmedCol));
+      }
+    }
+  }
+  return result;
+}
+} // namespace
+
 Config::Entry<WriterVersion> Config::WRITER_VERSION(
     "orc.writer.version",
     WriterVersion_CURRENT);
@@ -89,6 +112,13 @@ Config::Entry<bool> Config::DICTIONARY_SORT_KEYS{
     "hive.exec.orc.dictionary.key.sorted",
     false};
 
+// Number of values after which the first stripe re-evaluates whether to keep
+// dictionary encoding, so that a column that does not benefit switches to
+// direct encoding before buffering the whole stripe. 0 decides at flush only.
+Config::Entry<uint32_t> Config::DICTIONARY_EARLY_CHECK_ROWS{
+    "hive.exec.orc.dictionary.early.check.rows",
+    0};
+
 Config::Entry<float> Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD{
     "hive.exec.orc.entropy.key.string.size.threshold",
     0.9f};
@@ -126,21 +156,8 @@ Config::Entry<bool> Config::MAP_FLAT_DICT_SHARE(
 Config::Entry<const std::vector<uint32_t>> Config::MAP_FLAT_COLS(
     "orc.map.flat.cols",
     {},
-    [](const std::vector<uint32_t>& val) { return folly::join(",", val); },
-    [](const std::string& /* key */, const std::string& val) {
-      std::vector<uint32_t> result;
-      if (!val.empty()) {
-        std::vector<folly::StringPiece> pieces;
-        folly::split(',', val, pieces, true);
-        for (auto& p : pieces) {
-          const auto& trimmedCol = folly::trimWhitespace(p);
-          if (!trimmedCol.empty()) {
-            result.push_back(folly::to<uint32_t>(trimmedCol));
-          }
-        }
-      }
-      return result;
-    });
+    columnsToString,
+    columnsFromString);
 
 Config::Entry<const std::vector<std::vector<std::string>>>
     Config::MAP_FLAT_COLS_STRUCT_KEYS(
@@ -209,4 +226,10 @@ Config::Entry<uint64_t> Config::RAW_DATA_SIZE_PER_BATCH(
     50UL * 1024 * 1024);
 
 Config::Entry<bool> Config::MAP_STATISTICS("orc.map.statistics", false);
+
+Config::Entry<const std::vector<uint32_t>> Config::BLOOM_FILTER_COLS(
+    "orc.bloom.filter.cols",
+    {},
+    columnsToString,
+    columnsFromString);
 } // namespace facebook::velox::dwrf
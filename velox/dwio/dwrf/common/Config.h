@@ -47,6 +47,7 @@ class Config : public common::ConfigBase<Config> {
   static Entry<float> DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD;
   static Entry<float> DICTIONARY_STRING_KEY_SIZE_THRESHOLD;
   static Entry<bool> DICTIONARY_SORT_KEYS;
+  static Entry<uint32_t> DICTIONARY_EARLY_CHECK_ROWS;
   static Entry<float> ENTROPY_KEY_STRING_SIZE_THRESHOLD;
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
@@ -74,6 +75,9 @@ class Config : public common::ConfigBase<Config> {
   // to write oversized stripes.
   static Entry<uint64_t> RAW_DATA_SIZE_PER_BATCH;
   static Entry<bool> MAP_STATISTICS;
+  // Top level columns for which each row index entry has a Bloom filter of
+  // the values in the row group. Only for integer and string columns.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLS;
 
   static std::shared_ptr<Config> fromMap(
       const std::map<std::string, std::string>& map) {
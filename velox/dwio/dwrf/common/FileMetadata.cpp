@@ -39,6 +39,51 @@ CompressionKind orcCompressionToCompressionKind(
 }
 } // namespace detail
 
+LazyColumnStatistics::LazyColumnStatistics(
+    google::protobuf::Arena* arena,
+    dwio::common::DataBuffer<char> serialized,
+    std::vector<uint32_t> offsets)
+    : arena_{arena},
+      serialized_{std::move(serialized)},
+      offsets_{std::move(offsets)},
+      parsed_{std::make_unique<std::atomic<const proto::ColumnStatistics*>[]>(
+          offsets_.size() - 1)} {
+  VELOX_CHECK(!offsets_.empty());
+  VELOX_CHECK_LE(offsets_.back(), serialized_.capacity());
+}
+
+const proto::ColumnStatistics& LazyColumnStatistics::get(int index) const {
+  VELOX_CHECK_LT(index, size());
+  auto* stats = parsed_[index].load(std::memory_order_acquire);
+  if (stats) {
+    return *stats;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  stats = parsed_[index].load(std::memory_order_relaxed);
+  if (!stats) {
+    auto* parsed =
+        google::protobuf::Arena::CreateMessage<proto::ColumnStatistics>(
+            arena_);
+    DWIO_ENSURE(
+        parsed->ParseFromArray(
+            serialized_.data() + offsets_[index],
+            offsets_[index + 1] - offsets_[index]),
+        "Failed to parse column statistics ",
+        index);
+    parsed_[index].store(parsed, std::memory_order_release);
+    stats = parsed;
+  }
+  return *stats;
+}
+
+int LazyColumnStatistics::numParsed() const {
+  int count = 0;
+  for (auto i = 0; i < size(); ++i) {
+    count += parsed_[i].load(std::memory_order_relaxed) != nullptr;
+  }
+  return count;
+}
+
 TypeKind TypeWrapper::kind() const {
   if (format_ == DwrfFormat::kDwrf) {
     switch (dwrfPtr()->kind()) {
@@ -15,10 +15,13 @@
  */
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <string>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/dwio/common/Common.h"
+#include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/common/wrap/orc-proto-wrapper.h"
@@ -331,11 +334,54 @@ class UserMetadataItemWrapper : public ProtoWrapperBase {
   }
 };
 
+// The column statistics of a DWRF footer kept serialized and parsed per
+// column on first access, so that a reader of a few columns of a wide file
+// does not parse the statistics of all of them. Thread-safe since the
+// readers of a file share it through a cached file tail.
+class LazyColumnStatistics {
+ public:
+  // 'serialized' holds the entries back to back, the i-th from 'offsets[i]'
+  // to 'offsets[i + 1]'. Parsed entries are allocated from 'arena'.
+  LazyColumnStatistics(
+      google::protobuf::Arena* arena,
+      dwio::common::DataBuffer<char> serialized,
+      std::vector<uint32_t> offsets);
+
+  int size() const {
+    return offsets_.size() - 1;
+  }
+
+  const proto::ColumnStatistics& get(int index) const;
+
+  // Returns the number of entries parsed so far.
+  int numParsed() const;
+
+  uint64_t serializedBytes() const {
+    return serialized_.capacity();
+  }
+
+ private:
+  google::protobuf::Arena* const arena_;
+  const dwio::common::DataBuffer<char> serialized_;
+  const std::vector<uint32_t> offsets_;
+  // Serializes parsing so that each entry is parsed once.
+  mutable std::mutex mutex_;
+  const std::unique_ptr<std::atomic<const proto::ColumnStatistics*>[]>
+      parsed_;
+};
+
 class FooterWrapper : public ProtoWrapperBase {
  public:
   explicit FooterWrapper(const proto::Footer* footer)
       : ProtoWrapperBase(DwrfFormat::kDwrf, footer) {}
 
+  // 'footer' is parsed without its column statistics, which come from
+  // 'statistics'.
+  FooterWrapper(
+      const proto::Footer* footer,
+      const LazyColumnStatistics* statistics)
+      : ProtoWrapperBase(DwrfFormat::kDwrf, footer), statistics_{statistics} {}
+
   explicit FooterWrapper(const proto::orc::Footer* footer)
       : ProtoWrapperBase(DwrfFormat::kOrc, footer) {}
 
@@ -421,23 +467,35 @@ class FooterWrapper : public ProtoWrapperBase {
 
   // TODO: ORC has not supported column statistics yet
   int statisticsSize() const {
+    if (statistics_) {
+      return statistics_->size();
+    }
     return format_ == DwrfFormat::kDwrf ? dwrfPtr()->statistics_size()
                                         : orcPtr()->statistics_size();
   }
 
+  // Not available when the statistics are parsed lazily.
   const ::google::protobuf::RepeatedPtrField<
       ::facebook::velox::dwrf::proto::ColumnStatistics>&
   statistics() const {
     VELOX_CHECK_EQ(format_, DwrfFormat::kDwrf);
+    VELOX_CHECK_NULL(statistics_, "Footer statistics are parsed lazily");
     return dwrfPtr()->statistics();
   }
 
   const ::facebook::velox::dwrf::proto::ColumnStatistics& statistics(
       int index) const {
+    if (statistics_) {
+      return statistics_->get(index);
+    }
     // VELOX_CHECK_EQ(format_, DwrfFormat::kDwrf);
     return dwrfPtr()->statistics(index);
   }
 
+  const LazyColumnStatistics* lazyStatistics() const {
+    return statistics_;
+  }
+
   // TODO: ORC has not supported encryption yet
   bool hasEncryption() const {
     return format_ == DwrfFormat::kDwrf ? dwrfPtr()->has_encryption()
@@ -489,6 +547,8 @@ class FooterWrapper : public ProtoWrapperBase {
   inline const proto::orc::Footer* orcPtr() const {
     return reinterpret_cast<const proto::orc::Footer*>(rawProtoPtr());
   }
+
+  const LazyColumnStatistics* statistics_{nullptr};
 };
 
 } // namespace facebook::velox::dwrf
@@ -121,6 +121,10 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
   // release previous decryption buffer
   decryptionBuffer_ = nullptr;
 
+  if (decrypter_) {
+    return nextDecrypted(data, size);
+  }
+
   if (state_ == State::HEADER || remainingLength_ == 0) {
     readHeader();
   }
@@ -134,12 +138,12 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
   size_t availSize = std::min(
       static_cast<size_t>(inputBufferPtrEnd_ - inputBufferPtr_),
       remainingLength_);
-  // in the case when decompression or decryption is needed, need to copy data
-  // to input buffer if the input doesn't contain the entire block
-  bool original = !decrypter_ && (state_ == State::ORIGINAL);
+  // in the case when decompression is needed, need to copy data to input
+  // buffer if the input doesn't contain the entire block
+  bool original = state_ == State::ORIGINAL;
   const char* input = nullptr;
-  // if no decompression or decryption is needed, simply adjust the output
-  // pointer. Otherwise, make sure we have continuous block
+  // if no decompression is needed, simply adjust the output pointer.
+  // Otherwise, make sure we have continuous block
   if (original) {
     *data = inputBufferPtr_;
     *size = static_cast<int32_t>(availSize);
@@ -150,17 +154,6 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
     input = ensureInput(availSize);
   }
 
-  // perform decryption
-  if (decrypter_) {
-    decryptionBuffer_ =
-        decrypter_->decrypt(folly::StringPiece{input, remainingLength_});
-    input = reinterpret_cast<const char*>(decryptionBuffer_->data());
-    remainingLength_ = decryptionBuffer_->length();
-    *data = input;
-    *size = remainingLength_;
-    outputBufferPtr_ = input + remainingLength_;
-  }
-
   // perform decompression
   if (state_ == State::START) {
     DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
@@ -174,8 +167,6 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
     *data = outputBuffer_->data();
     *size = static_cast<int32_t>(outputBufferLength_);
     outputBufferPtr_ = outputBuffer_->data() + outputBufferLength_;
-    // release decryption buffer
-    decryptionBuffer_ = nullptr;
   }
 
   if (!original) {
@@ -189,6 +180,92 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
   return true;
 }
 
+bool PagedInputStream::decryptBlocks() {
+  readHeader();
+  if (state_ == State::END) {
+    return false;
+  }
+  if (inputBufferPtr_ == inputBufferPtrEnd_) {
+    readBuffer(true);
+  }
+  std::vector<folly::StringPiece> inputs;
+  std::vector<DecryptedBlock> blocks;
+  auto addBlock = [&](const char* input, bool original, uint64_t offset) {
+    inputs.emplace_back(input, remainingLength_);
+    blocks.push_back(DecryptedBlock{original, offset, nullptr});
+  };
+  const size_t availSize = std::min(
+      static_cast<size_t>(inputBufferPtrEnd_ - inputBufferPtr_),
+      remainingLength_);
+  addBlock(
+      ensureInput(availSize), state_ == State::ORIGINAL, lastHeaderOffset_);
+
+  // Reading another range may invalidate the previous one, so the batch only
+  // takes the blocks that do not need another read.
+  while (blocks.size() < kMaxDecryptBatch) {
+    const size_t available = inputBufferPtrEnd_ - inputBufferPtr_;
+    if (available < PAGE_HEADER_SIZE) {
+      break;
+    }
+    const auto* header =
+        reinterpret_cast<const unsigned char*>(inputBufferPtr_);
+    const uint32_t value = header[0] | (header[1] << 8) | (header[2] << 16);
+    remainingLength_ = value >> 1;
+    if (available < PAGE_HEADER_SIZE + remainingLength_) {
+      break;
+    }
+    addBlock(
+        inputBufferPtr_ + PAGE_HEADER_SIZE,
+        value & 1,
+        input_->ByteCount() - available);
+    inputBufferPtr_ += PAGE_HEADER_SIZE + remainingLength_;
+  }
+  remainingLength_ = 0;
+  state_ = State::HEADER;
+
+  auto decrypted = decrypter_->decryptBatch(inputs);
+  VELOX_CHECK_EQ(decrypted.size(), blocks.size());
+  for (auto i = 0; i < blocks.size(); ++i) {
+    blocks[i].data = std::move(decrypted[i]);
+    decryptedBlocks_.push_back(std::move(blocks[i]));
+  }
+  return true;
+}
+
+bool PagedInputStream::nextDecrypted(const void** data, int32_t* size) {
+  if (decryptedBlocks_.empty() && !decryptBlocks()) {
+    return false;
+  }
+  auto block = std::move(decryptedBlocks_.front());
+  decryptedBlocks_.pop_front();
+  lastHeaderOffset_ = block.headerOffset;
+  bytesReturnedAtLastHeaderOffset_ = bytesReturned_;
+
+  decryptionBuffer_ = std::move(block.data);
+  const auto* input = reinterpret_cast<const char*>(decryptionBuffer_->data());
+  const size_t length = decryptionBuffer_->length();
+  if (block.original) {
+    *data = input;
+    *size = static_cast<int32_t>(length);
+    outputBufferPtr_ = input + length;
+  } else {
+    DWIO_ENSURE_NOT_NULL(decompressor_.get(), "invalid stream state");
+    prepareOutputBuffer(decompressor_->getUncompressedLength(input, length));
+    const auto outputLength = decompressor_->decompress(
+        input, length, outputBuffer_->data(), outputBuffer_->capacity());
+    *data = outputBuffer_->data();
+    *size = static_cast<int32_t>(outputLength);
+    outputBufferPtr_ = outputBuffer_->data() + outputLength;
+    // release decryption buffer
+    decryptionBuffer_ = nullptr;
+  }
+
+  outputBufferLength_ = 0;
+  bytesReturned_ += *size;
+  lastWindowSize_ = *size;
+  return true;
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   DWIO_ENSURE(
       outputBufferPtr_ != nullptr,
@@ -234,6 +311,7 @@ void PagedInputStream::clearDecompressionState() {
   remainingLength_ = 0;
   inputBufferPtr_ = nullptr;
   inputBufferPtrEnd_ = nullptr;
+  decryptedBlocks_.clear();
 }
 
 void PagedInputStream::seekToPosition(
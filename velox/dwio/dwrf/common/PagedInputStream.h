@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Compression.h"
 
@@ -66,6 +68,11 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return 2;
   }
 
+  // Offset in the input of the header of the block last returned by Next().
+  uint64_t lastHeaderOffset() const {
+    return lastHeaderOffset_;
+  }
+
  protected:
   // Special constructor used by ZlibDecompressionStream
   PagedInputStream(
@@ -94,6 +101,15 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // make sure input is contiguous for decompression/decryption
   const char* ensureInput(size_t availableInputBytes);
 
+  // Next() for encrypted streams. Returns the next block of
+  // 'decryptedBlocks_', decompressed if needed.
+  bool nextDecrypted(const void** data, int32_t* size);
+
+  // Reads the next block and the following blocks that are entirely in the
+  // current input range, up to kMaxDecryptBatch, and decrypts them in one
+  // call. Returns false at the end of the stream.
+  bool decryptBlocks();
+
   // input stream where to read compressed/encrypted data
   std::unique_ptr<SeekableInputStream> input_;
   memory::MemoryPool& pool_;
@@ -114,6 +130,20 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // unencrypted output
   std::unique_ptr<folly::IOBuf> decryptionBuffer_{nullptr};
 
+  struct DecryptedBlock {
+    // True if the block is not compressed.
+    bool original;
+    // Offset in input_ of the block header.
+    uint64_t headerOffset;
+    std::unique_ptr<folly::IOBuf> data;
+  };
+
+  static constexpr int32_t kMaxDecryptBatch = 16;
+
+  // Blocks decrypted ahead of Next(). They are decompressed one at a time
+  // when returned.
+  std::deque<DecryptedBlock> decryptedBlocks_;
+
   // the current state
   State state_{State::HEADER};
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/dwio/dwrf/common/PrefetchedInputStream.h"
+
+#include <algorithm>
+
+namespace facebook::velox::dwrf {
+
+PrefetchedInputStream::PrefetchedInputStream(
+    std::unique_ptr<PagedInputStream> input,
+    memory::MemoryPool& pool)
+    : input_{std::move(input)},
+      pool_{pool},
+      source_{std::make_shared<AsyncSource<Content>>(
+          [this]() { return decompress(); })} {}
+
+PrefetchedInputStream::~PrefetchedInputStream() {
+  // Waits for a running decompression, which reads 'input_'. One that has
+  // not started runs here and returns right away.
+  cancelled_ = true;
+  try {
+    source_->move();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Error in prefetched decompression of " << getName()
+                 << ": " << e.what();
+  }
+}
+
+std::unique_ptr<PrefetchedInputStream::Content>
+PrefetchedInputStream::decompress() {
+  auto content = std::make_unique<Content>(pool_);
+  auto& data = content->data;
+  const void* buffer;
+  int32_t size;
+  while (!cancelled_ && input_->Next(&buffer, &size)) {
+    const auto headerOffset = input_->lastHeaderOffset();
+    if (content->blocks.empty() ||
+        content->blocks.back().first != headerOffset) {
+      content->blocks.emplace_back(headerOffset, data.size());
+    }
+    data.extendAppend(
+        data.size(), reinterpret_cast<const char*>(buffer), size);
+  }
+  return content;
+}
+
+void PrefetchedInputStream::ensureContent() {
+  if (!content_) {
+    content_ = source_->move();
+    DWIO_ENSURE_NOT_NULL(content_, "Stream already consumed ", getName());
+  }
+}
+
+bool PrefetchedInputStream::Next(const void** data, int32_t* size) {
+  ensureContent();
+  if (position_ >= content_->data.size()) {
+    return false;
+  }
+  *data = content_->data.data() + position_;
+  *size = static_cast<int32_t>(std::min<uint64_t>(
+      content_->data.size() - position_, std::numeric_limits<int32_t>::max()));
+  position_ += *size;
+  return true;
+}
+
+void PrefetchedInputStream::BackUp(int32_t count) {
+  DWIO_ENSURE_LE(count, position_, "Backup past start of ", getName());
+  position_ -= count;
+}
+
+bool PrefetchedInputStream::Skip(int32_t count) {
+  ensureContent();
+  position_ += count;
+  if (position_ > content_->data.size()) {
+    position_ = content_->data.size();
+    return false;
+  }
+  return true;
+}
+
+void PrefetchedInputStream::seekToPosition(
+    dwio::common::PositionProvider& positionProvider) {
+  ensureContent();
+  const auto compressedOffset = positionProvider.next();
+  const auto uncompressedOffset = positionProvider.next();
+  const auto& blocks = content_->blocks;
+  auto it = std::lower_bound(
+      blocks.begin(),
+      blocks.end(),
+      compressedOffset,
+      [](const auto& block, uint64_t offset) { return block.first < offset; });
+  if (it == blocks.end()) {
+    // A position after the last block is the end of the stream.
+    DWIO_ENSURE_EQ(uncompressedOffset, 0, "Bad position in ", getName());
+    position_ = content_->data.size();
+    return;
+  }
+  DWIO_ENSURE_EQ(
+      it->first, compressedOffset, "No block at position in ", getName());
+  position_ = it->second + uncompressedOffset;
+  DWIO_ENSURE_LE(position_, content_->data.size());
+}
+
+std::string PrefetchedInputStream::getName() const {
+  return fmt::format(
+      "PrefetchedInputStream position {} of {}",
+      position_,
+      input_->getName());
+}
+
+} // namespace facebook::velox::dwrf
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/dwio/dwrf/common/PagedInputStream.h"
+
+namespace facebook::velox::dwrf {
+
+// Decompresses a whole paged stream into a buffer, on an executor if
+// prefetchTask() is scheduled before the first read and otherwise on the
+// reader thread.
+class PrefetchedInputStream : public dwio::common::SeekableInputStream {
+ public:
+  PrefetchedInputStream(
+      std::unique_ptr<PagedInputStream> input,
+      memory::MemoryPool& pool);
+
+  ~PrefetchedInputStream() override;
+
+  // Returns a function that decompresses the stream. The function can run
+  // after 'this' is destroyed and then does nothing.
+  std::function<void()> prefetchTask() const {
+    return [source = source_]() { source->prepare(); };
+  }
+
+  bool Next(const void** data, int32_t* size) override;
+  void BackUp(int32_t count) override;
+  bool Skip(int32_t count) override;
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+  std::string getName() const override;
+
+  size_t positionSize() override {
+    // Same positions as the paged stream: compressed block start and offset
+    // in the uncompressed block.
+    return 2;
+  }
+
+ private:
+  struct Content {
+    explicit Content(memory::MemoryPool& pool) : data{pool} {}
+
+    dwio::common::DataBuffer<char> data;
+    // Offset of each block header in the compressed stream and offset of the
+    // block in 'data', in stream order.
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+  };
+
+  std::unique_ptr<Content> decompress();
+
+  void ensureContent();
+
+  const std::unique_ptr<PagedInputStream> input_;
+  memory::MemoryPool& pool_;
+  std::atomic_bool cancelled_{false};
+  std::shared_ptr<AsyncSource<Content>> source_;
+  std::unique_ptr<Content> content_;
+  uint64_t position_{0};
+};
+
+} // namespace facebook::velox::dwrf
@@ -24,6 +24,7 @@
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
 
+#include <folly/lang/Bits.h>
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -511,8 +512,10 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
+    if (readLongsInBuffer(data, offset, len, fb, nulls, ret)) {
+      return ret;
+    }
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -541,6 +544,65 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Unpacks the values of readLongs() with 64 bit loads if all their bytes
+  // and 8 more are in the current buffer. Sets 'numRead' and returns true if
+  // so, else returns false without reading.
+  bool readLongsInBuffer(
+      int64_t* data,
+      uint64_t offset,
+      uint64_t len,
+      uint64_t fb,
+      const uint64_t* nulls,
+      uint64_t& numRead) {
+    if (fb == 0 || fb > 64) {
+      return false;
+    }
+    using Base = dwio::common::IntDecoder<isSigned>;
+    const uint64_t numValues =
+        nulls ? bits::countNonNulls(nulls, offset, offset + len) : len;
+    // The unread bits of 'curByte' come first. 'curByte' is the last byte
+    // read, the one before 'bufferStart'.
+    const auto* start = reinterpret_cast<const uint8_t*>(Base::bufferStart) -
+        (bitsLeft > 0 ? 1 : 0);
+    const uint64_t startBit = bitsLeft > 0 ? 8 - bitsLeft : 0;
+    const uint64_t endBit = startBit + numValues * fb;
+    if (reinterpret_cast<const uint8_t*>(Base::bufferEnd) - start <
+        static_cast<int64_t>(endBit / 8 + sizeof(uint64_t) + 1)) {
+      return false;
+    }
+
+    uint64_t bitPosition = startBit;
+    for (uint64_t i = offset; i < offset + len; ++i) {
+      if (nulls && bits::isBitNull(nulls, i)) {
+        continue;
+      }
+      const auto* byte = start + (bitPosition >> 3);
+      const auto shift = bitPosition & 7;
+      // The values are big endian, the first bit is the most significant.
+      uint64_t value =
+          folly::Endian::big(*reinterpret_cast<const uint64_t*>(byte))
+          << shift;
+      if (fb + shift > 64) {
+        value |= byte[8] >> (8 - shift);
+      }
+      data[i] = static_cast<int64_t>(value >> (64 - fb));
+      bitPosition += fb;
+    }
+
+    const auto numBytes = bitPosition / 8;
+    const auto numBitsInLastByte = bitPosition & 7;
+    if (numBitsInLastByte == 0) {
+      Base::bufferStart = reinterpret_cast<const char*>(start + numBytes);
+      bitsLeft = 0;
+    } else {
+      curByte = start[numBytes];
+      Base::bufferStart = reinterpret_cast<const char*>(start + numBytes + 1);
+      bitsLeft = 8 - numBitsInLastByte;
+    }
+    numRead = numValues;
+    return true;
+  }
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 
 namespace facebook::velox::dwrf {
 
@@ -23,7 +24,8 @@ DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> nodeType,
     StripeStreams& stripe,
     const StreamLabels& streamLabels,
-    FlatMapContext flatMapContext)
+    FlatMapContext flatMapContext,
+    bool readBloomFilter)
     : memoryPool_(stripe.getMemoryPool()),
       nodeType_(std::move(nodeType)),
       flatMapContext_(std::move(flatMapContext)),
@@ -48,6 +50,13 @@ DwrfData::DwrfData(
     notNullDecoder_ = createBooleanRleDecoder(std::move(stream), encodingKey);
   }
   indexStream_ = stripe.getStream(rowIndexStream, streamLabels.label(), false);
+  if (readBloomFilter && format == DwrfFormat::kDwrf &&
+      isBloomFilterSupported(nodeType_->type->kind())) {
+    bloomFilterStream_ = stripe.getStream(
+        encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8),
+        streamLabels.label(),
+        false);
+  }
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -90,6 +99,28 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+void DwrfData::ensureBloomFilterIndex() {
+  if (bloomFilterStream_) {
+    bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+}
+
+bool DwrfData::testBloomFilter(const common::Filter& filter, int32_t index) {
+  const auto kind = nodeType_->type->kind();
+  if (!bloomFilterIndex_ || index >= bloomFilterIndex_->bloomfilter_size() ||
+      !isBloomFilterApplicable(filter, kind)) {
+    return true;
+  }
+  const auto& serialized = bloomFilterIndex_->bloomfilter(index).utf8bitset();
+  if (serialized.empty()) {
+    return true;
+  }
+  BloomFilter<> bloomFilter;
+  bloomFilter.merge(serialized.data());
+  return testFilterOnBloomFilter(filter, bloomFilter, kind);
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(uint32_t index) {
   ensureRowGroupIndex();
   tempPositions_ = toPositionsInner(index_->entry(index));
@@ -146,6 +177,7 @@ void DwrfData::filterRowGroups(
     return;
   }
   ensureRowGroupIndex();
+  ensureBloomFilterIndex();
   auto filter = scanSpec.filter();
   auto dwrfContext = reinterpret_cast<const StatsContext*>(&writerContext);
   result.totalCount = std::max(result.totalCount, index_->entry_size());
@@ -163,7 +195,9 @@ void DwrfData::filterRowGroups(
     auto columnStats =
         buildColumnStatisticsFromProto(entry.statistics(), *dwrfContext);
     if (filter &&
-        !testFilter(filter, columnStats.get(), rowGroupSize, nodeType_->type)) {
+        (!testFilter(
+             filter, columnStats.get(), rowGroupSize, nodeType_->type) ||
+         !testBloomFilter(*filter, i))) {
       VLOG(1) << "Drop stride " << i << " on " << scanSpec.toString();
       bits::setBit(result.filterResult.data(), i);
       continue;
@@ -174,7 +208,8 @@ void DwrfData::filterRowGroups(
               metadataFilter,
               columnStats.get(),
               rowGroupSize,
-              nodeType_->type)) {
+              nodeType_->type) ||
+          !testBloomFilter(*metadataFilter, i)) {
         bits::setBit(
             result.metadataFilterResults[metadataFiltersStartIndex + j]
                 .second.data(),
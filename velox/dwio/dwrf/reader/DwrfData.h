@@ -37,7 +37,8 @@ class DwrfData : public dwio::common::FormatData {
       std::shared_ptr<const dwio::common::TypeWithId> nodeType,
       StripeStreams& stripe,
       const StreamLabels& streamLabels,
-      FlatMapContext flatMapContext);
+      FlatMapContext flatMapContext,
+      bool readBloomFilter = false);
 
   void readNulls(
       vector_size_t numValues,
@@ -96,12 +97,22 @@ class DwrfData : public dwio::common::FormatData {
         entry.positions().begin(), entry.positions().end());
   }
 
+  // Decodes the Bloom filters of the row groups if the column has them and
+  // they are not already decoded.
+  void ensureBloomFilterIndex();
+
+  // False if the Bloom filter of row group 'index' shows that no value of the
+  // row group passes 'filter'.
+  bool testBloomFilter(const common::Filter& filter, int32_t index);
+
   memory::MemoryPool& memoryPool_;
   const std::shared_ptr<const dwio::common::TypeWithId> nodeType_;
   FlatMapContext flatMapContext_;
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
 
@@ -127,9 +138,15 @@ class DwrfParams : public dwio::common::FormatParams {
 
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
-      const common::ScanSpec& /*scanSpec*/) override {
+      const common::ScanSpec& scanSpec) override {
+    // Bloom filters are read only for columns with filters to evaluate on
+    // them.
     return std::make_unique<DwrfData>(
-        type, stripeStreams_, streamLabels_, flatMapContext_);
+        type,
+        stripeStreams_,
+        streamLabels_,
+        flatMapContext_,
+        scanSpec.filter() || scanSpec.numMetadataFilters() > 0);
   }
 
   StripeStreams& stripeStreams() {
@@ -132,6 +132,7 @@ uint64_t DwrfRowReader::seekToRow(uint64_t rowNumber) {
   currentStripe = seekToStripe;
   currentRowInStripe = rowNumber - firstRowOfStripe[currentStripe];
   previousRow = rowNumber;
+  nextSelectedRow_ = 0;
   newStripeLoaded = false;
   startNextStripe();
 
@@ -226,6 +227,80 @@ void DwrfRowReader::checkSkipStrides(uint64_t strideSize) {
   }
 }
 
+bool DwrfRowReader::stripeHasSelectedRows(uint32_t stripe) {
+  auto& selectedRows = options_.getSelectedRows();
+  if (!selectedRows) {
+    return true;
+  }
+  auto it = std::lower_bound(
+      selectedRows->begin() + nextSelectedRow_,
+      selectedRows->end(),
+      firstRowOfStripe[stripe]);
+  nextSelectedRow_ = it - selectedRows->begin();
+  return it != selectedRows->end() &&
+      *it < firstRowOfStripe[stripe] +
+          getReader().getFooter().stripes(stripe).numberOfRows();
+}
+
+void DwrfRowReader::skipUnselectedRowGroups(uint64_t strideSize) {
+  auto& selectedRows = options_.getSelectedRows();
+  if (!selectedRows) {
+    return;
+  }
+  const auto stripeStart = firstRowOfStripe[currentStripe];
+  while (currentRowInStripe < rowsInCurrentStripe) {
+    auto it = std::lower_bound(
+        selectedRows->begin() + nextSelectedRow_,
+        selectedRows->end(),
+        stripeStart + currentRowInStripe);
+    nextSelectedRow_ = it - selectedRows->begin();
+    if (it == selectedRows->end() ||
+        *it >= stripeStart + rowsInCurrentStripe) {
+      currentRowInStripe = rowsInCurrentStripe;
+      return;
+    }
+    auto row = *it - stripeStart;
+    if (!selectiveColumnReader_ || strideSize == 0 ||
+        row / strideSize == currentRowInStripe / strideSize) {
+      return;
+    }
+    // Seeks to the row group of 'row' using the positions in the row index.
+    auto stride = row / strideSize;
+    skippedStrides_ +=
+        stride - bits::roundUp(currentRowInStripe, strideSize) / strideSize;
+    currentRowInStripe = stride * strideSize;
+    selectiveColumnReader_->seekToRowGroup(stride);
+    // The row group may in turn be skipped by the stats.
+    checkSkipStrides(strideSize);
+  }
+}
+
+const dwio::common::Mutation* DwrfRowReader::addUnselectedRows(
+    uint64_t firstRow,
+    uint64_t numRows,
+    const dwio::common::Mutation* mutation,
+    dwio::common::Mutation& selection) {
+  auto& selectedRows = *options_.getSelectedRows();
+  auto end = std::lower_bound(
+      selectedRows.begin() + nextSelectedRow_,
+      selectedRows.end(),
+      firstRow + numRows);
+  uint64_t numSelected = end - (selectedRows.begin() + nextSelectedRow_);
+  if (numSelected == numRows) {
+    return mutation;
+  }
+  unselectedRows_.resize(bits::nwords(numRows));
+  bits::fillBits(unselectedRows_.data(), 0, numRows, true);
+  for (auto it = selectedRows.begin() + nextSelectedRow_; it != end; ++it) {
+    bits::clearBit(unselectedRows_.data(), *it - firstRow);
+  }
+  if (mutation && mutation->deletedRows) {
+    bits::orBits(unselectedRows_.data(), mutation->deletedRows, 0, numRows);
+  }
+  selection.deletedRows = unselectedRows_.data();
+  return &selection;
+}
+
 void DwrfRowReader::readNext(
     uint64_t rowsToRead,
     const dwio::common::Mutation* mutation,
@@ -320,9 +395,14 @@ int64_t DwrfRowReader::nextRowNumber() {
   auto strideSize = getReader().getFooter().rowIndexStride();
   while (currentStripe < lastStripe) {
     if (currentRowInStripe == 0) {
+      if (!newStripeLoaded && !stripeHasSelectedRows(currentStripe)) {
+        ++currentStripe;
+        continue;
+      }
       startNextStripe();
     }
     checkSkipStrides(strideSize);
+    skipUnselectedRowGroups(strideSize);
     if (currentRowInStripe < rowsInCurrentStripe) {
       return firstRowOfStripe[currentStripe] + currentRowInStripe;
     }
@@ -345,6 +425,17 @@ int64_t DwrfRowReader::nextReadSize(uint64_t size) {
     rowsToRead =
         std::min(rowsToRead, strideSize - currentRowInStripe % strideSize);
   }
+  if (auto& selectedRows = options_.getSelectedRows()) {
+    // Ends the read at the last selected row in range so that the rest of the
+    // row group can be skipped.
+    auto firstRow = firstRowOfStripe[currentStripe] + currentRowInStripe;
+    auto begin = selectedRows->begin() + nextSelectedRow_;
+    auto end =
+        std::lower_bound(begin, selectedRows->end(), firstRow + rowsToRead);
+    if (end != begin) {
+      rowsToRead = *(end - 1) - firstRow + 1;
+    }
+  }
   VELOX_DCHECK_GT(rowsToRead, 0);
   return rowsToRead;
 }
@@ -369,11 +460,24 @@ uint64_t DwrfRowReader::next(
   // reading of the data.
   auto strideSize = getReader().getFooter().rowIndexStride();
   strideIndex_ = strideSize > 0 ? currentRowInStripe / strideSize : 0;
+  dwio::common::Mutation selection;
+  if (options_.getSelectedRows()) {
+    mutation = addUnselectedRows(nextRow, rowsToRead, mutation, selection);
+  }
   readNext(rowsToRead, mutation, result);
   currentRowInStripe += rowsToRead;
   return rowsToRead;
 }
 
+std::optional<uint64_t> DwrfRowReader::numberOfRowsInRange() const {
+  if (firstStripe >= lastStripe) {
+    return 0;
+  }
+  return firstRowOfStripe[lastStripe - 1] +
+      getReader().getFooter().stripes(lastStripe - 1).numberOfRows() -
+      firstRowOfStripe[firstStripe];
+}
+
 void DwrfRowReader::resetFilterCaches() {
   if (selectiveColumnReader_) {
     selectiveColumnReader_->resetFilterCaches();
@@ -388,6 +492,14 @@ void DwrfRowReader::startNextStripe() {
     return;
   }
 
+  // Releases the column readers of the previous stripe before its input,
+  // which their streams may still be decompressing on the I/O executor.
+  columnReader_.reset();
+  if (selectiveColumnReader_) {
+    skippedLazyRows_ += selectiveColumnReader_->numLazySkippedRows();
+  }
+  selectiveColumnReader_.reset();
+
   bool preload = options_.getPreloadStripe();
   auto currentStripeInfo = loadStripe(currentStripe, preload);
   rowsInCurrentStripe = currentStripeInfo.numberOfRows();
@@ -399,10 +511,14 @@ void DwrfRowReader::startNextStripe() {
       currentStripeInfo.offset(),
       *this,
       currentStripe);
+  // Readers of string dictionaries identical to the ones of the previous
+  // stripe return the same dictionary vector.
+  if (stripeDictionaryCache_) {
+    stripeStreams.getStripeDictionaryCache()->inheritStringDictionaries(
+        *stripeDictionaryCache_);
+  }
 
   // Create column reader
-  columnReader_.reset();
-  selectiveColumnReader_.reset();
   auto scanSpec = options_.getScanSpec().get();
   auto requestedType = getColumnSelector().getSchemaWithId();
   auto dataType = getReader().getSchemaWithId();
@@ -435,6 +551,7 @@ void DwrfRowReader::startNextStripe() {
     VLOG(1) << "[DWRF] Load read plan for stripe " << currentStripe;
     stripeStreams.loadReadPlan();
   }
+  stripeStreams.prefetchDecompression();
 
   stripeDictionaryCache_ = stripeStreams.getStripeDictionaryCache();
   newStripeLoaded = true;
@@ -572,7 +689,9 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.getFileMetadataCache(),
+          options.getFileMetadataCachePath())),
       options_(options) {}
 
 std::unique_ptr<StripeInformation> DwrfReader::getStripe(
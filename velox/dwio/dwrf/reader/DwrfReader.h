@@ -91,6 +91,9 @@ class DwrfRowReader : public StrideIndexProvider,
   void updateRuntimeStats(
       dwio::common::RuntimeStatistics& stats) const override {
     stats.skippedStrides += skippedStrides_;
+    stats.skippedLazyRows += skippedLazyRows_ +
+        (selectiveColumnReader_ ? selectiveColumnReader_->numLazySkippedRows()
+                                : 0);
   }
 
   void resetFilterCaches() override;
@@ -99,6 +102,8 @@ class DwrfRowReader : public StrideIndexProvider,
     return true;
   }
 
+  std::optional<uint64_t> numberOfRowsInRange() const override;
+
   // Returns the skipped strides for 'stripe'. Used for testing.
   std::optional<std::vector<uint64_t>> stridesToSkip(uint32_t stripe) const {
     auto it = stripeStridesToSkip_.find(stripe);
@@ -144,12 +149,21 @@ class DwrfRowReader : public StrideIndexProvider,
   std::unordered_map<uint32_t, std::vector<uint64_t>> stripeStridesToSkip_;
   // Number of skipped strides.
   int64_t skippedStrides_{0};
+  // Lazy rows skipped by the column readers of the previous stripes.
+  int64_t skippedLazyRows_{0};
 
   // Set to true after clearing filter caches, i.e.  adding a dynamic
   // filter. Causes filters to be re-evaluated against stride stats on
   // next stride instead of next stripe.
   bool recomputeStridesToSkip_{false};
 
+  // Index of the first row of RowReaderOptions::getSelectedRows() at or after
+  // the current row.
+  size_t nextSelectedRow_{0};
+
+  // Deleted rows of the current read with the rows that are not selected.
+  std::vector<uint64_t> unselectedRows_;
+
   // internal methods
 
   std::optional<size_t> estimatedRowSizeHelper(
@@ -167,6 +181,24 @@ class DwrfRowReader : public StrideIndexProvider,
 
   void checkSkipStrides(uint64_t strideSize);
 
+  // True if RowReaderOptions::getSelectedRows() is not set or has a row in
+  // 'stripe'.
+  bool stripeHasSelectedRows(uint32_t stripe);
+
+  // Moves the current row to the row group of the next selected row if that
+  // is after the current row group. Moves to the end of the stripe if no
+  // selected row is left in it.
+  void skipUnselectedRowGroups(uint64_t strideSize);
+
+  // Returns 'mutation' with the rows in the 'numRows' rows from 'firstRow'
+  // that are not selected added as deleted rows. 'selection' holds the
+  // result if it is different from 'mutation'.
+  const dwio::common::Mutation* FOLLY_NULLABLE addUnselectedRows(
+      uint64_t firstRow,
+      uint64_t numRows,
+      const dwio::common::Mutation* FOLLY_NULLABLE mutation,
+      dwio::common::Mutation& selection);
+
   void readNext(
       uint64_t rowsToRead,
       const dwio::common::Mutation*,
@@ -17,8 +17,10 @@
 #include "velox/dwio/dwrf/reader/ReaderBase.h"
 
 #include <fmt/format.h>
+#include <google/protobuf/wire_format_lite.h>
 
 #include "velox/dwio/common/exception/Exception.h"
+#include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
 
 namespace facebook::velox::dwrf {
 
@@ -31,6 +33,75 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+// Field number of the column statistics in proto::Footer.
+constexpr int kFooterStatisticsField = 7;
+
+// Parses the serialized footer in 'stream' into 'footer' except for its
+// column statistics, which are copied unparsed into the returned
+// LazyColumnStatistics.
+std::unique_ptr<LazyColumnStatistics> parseFooterWithoutStatistics(
+    dwio::common::SeekableInputStream& stream,
+    MemoryPool& pool,
+    google::protobuf::Arena* arena,
+    proto::Footer* footer) {
+  using google::protobuf::internal::WireFormatLite;
+  std::string serialized;
+  const void* data;
+  int32_t size;
+  while (stream.Next(&data, &size)) {
+    serialized.append(static_cast<const char*>(data), size);
+  }
+  google::protobuf::io::CodedInputStream input(
+      reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size());
+  const auto statisticsTag = WireFormatLite::MakeTag(
+      kFooterStatisticsField, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+  // The fields other than the statistics, in their original order.
+  std::string rest;
+  rest.reserve(serialized.size());
+  std::vector<std::pair<uint32_t, uint32_t>> ranges;
+  uint64_t statisticsBytes = 0;
+  auto fieldStart = input.CurrentPosition();
+  while (const auto tag = input.ReadTag()) {
+    if (tag == statisticsTag) {
+      uint32_t length;
+      DWIO_ENSURE(input.ReadVarint32(&length), "Corrupted file footer");
+      const auto begin = input.CurrentPosition();
+      DWIO_ENSURE(input.Skip(length), "Corrupted file footer");
+      ranges.emplace_back(begin, length);
+      statisticsBytes += length;
+    } else {
+      DWIO_ENSURE(
+          WireFormatLite::SkipField(&input, tag), "Corrupted file footer");
+      rest.append(
+          serialized.data() + fieldStart, input.CurrentPosition() - fieldStart);
+    }
+    fieldStart = input.CurrentPosition();
+  }
+  DWIO_ENSURE(
+      input.ConsumedEntireMessage() &&
+          fieldStart == static_cast<int>(serialized.size()),
+      "Corrupted file footer");
+  DWIO_ENSURE(
+      footer->ParseFromArray(rest.data(), rest.size()),
+      "Failed to parse proto from ",
+      stream.getName());
+
+  dwio::common::DataBuffer<char> statistics(pool, statisticsBytes);
+  std::vector<uint32_t> offsets;
+  offsets.reserve(ranges.size() + 1);
+  uint32_t offset = 0;
+  for (const auto& [begin, length] : ranges) {
+    offsets.push_back(offset);
+    memcpy(statistics.data() + offset, serialized.data() + begin, length);
+    offset += length;
+  }
+  offsets.push_back(offset);
+  return std::make_unique<LazyColumnStatistics>(
+      arena, std::move(statistics), std::move(offsets));
+}
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -93,7 +164,9 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    cache::FileMetadataCache* metadataCache,
+    const std::string& metadataCachePath)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
@@ -111,77 +184,42 @@ ReaderBase::ReaderBase(
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
   DWIO_ENSURE_GE(readSize, 4, "File size too small");
 
-  input_->enqueue({fileLength_ - readSize, readSize, "footer"});
-  input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
-
-  // TODO: read footer from spectrum
-  {
-    const void* buf;
-    int32_t ignored;
-    auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
-    DWIO_ENSURE(lastByteStream->Next(&buf, &ignored), "failed to read");
-    // Make sure 'lastByteStream' is live while dereferencing 'buf'.
-    psLength_ = *static_cast<const char*>(buf) & 0xff;
+  if (metadataCachePath.empty()) {
+    metadataCache = nullptr;
   }
-  DWIO_ENSURE_LE(
-      psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
-      fileLength_,
-      "Corrupted file, Post script size is invalid");
-
-  if (fileFormat == FileFormat::DWRF) {
-    auto postScript = ProtoUtils::readProto<proto::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
-  } else {
-    auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
-        input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+  std::shared_ptr<const FileTail> tail;
+  if (metadataCache) {
+    tail = std::dynamic_pointer_cast<const FileTail>(
+        metadataCache->find(metadataCachePath, fileLength_));
+  }
+  const bool cachedTail = tail != nullptr;
+  // A small file is loaded whole also when the tail is cached since its
+  // stripes are read from the same buffer.
+  if (!cachedTail || preloadFile) {
+    input_->enqueue({fileLength_ - readSize, readSize, "footer"});
+    input_->load(preloadFile ? LogType::FILE : LogType::FOOTER);
+  }
+  if (!cachedTail) {
+    tail = readTail(
+        fileFormat, readSize, metadataCache ? metadataCache->pool() : nullptr);
+    if (metadataCache) {
+      metadataCache->insert(metadataCachePath, fileLength_, tail);
+    }
   }
+  postScript_ = std::shared_ptr<const PostScript>(tail, tail->postScript.get());
+  footer_ = std::shared_ptr<const FooterWrapper>(tail, tail->footer.get());
+  psLength_ = tail->psLength;
 
   uint64_t footerSize = postScript_->footerLength();
   uint64_t cacheSize =
       postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
   uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
-
-  // There are cases in warehouse, where RC/text files are stored
-  // in ORC partition. This causes the Reader to SIGSEGV. The following
-  // checks catches most of the corrupted files (but not all).
-  DWIO_ENSURE_LT(
-      footerSize, fileLength_, "Corrupted file, footer size is invalid");
-  DWIO_ENSURE_LT(
-      cacheSize, fileLength_, "Corrupted file, cache size is invalid");
-  DWIO_ENSURE_LE(tailSize, fileLength_, "Corrupted file, tail size is invalid");
-
-  DWIO_ENSURE(
-      (format() == DwrfFormat::kDwrf)
-          ? proto::CompressionKind_IsValid(postScript_->compression())
-          : proto::orc::CompressionKind_IsValid(postScript_->compression()),
-      "Corrupted File, invalid compression kind ",
-      postScript_->compression());
-
-  if (tailSize > readSize) {
-    input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
+  if (cachedTail && cacheSize > 0 && !preloadFile) {
+    // Only the stripe metadata cache is left to read.
+    input_->enqueue({fileLength_ - tailSize, cacheSize, "footer"});
     input_->load(LogType::FOOTER);
   }
 
-  auto footerStream = input_->read(
-      fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
-  if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
-    ProtoUtils::readProtoInto<proto::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
-  } else {
-    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
-    ProtoUtils::readProtoInto<proto::orc::Footer>(
-        createDecompressedStream(std::move(footerStream), "File Footer"),
-        footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
-  }
-
   schema_ = std::dynamic_pointer_cast<const RowType>(
       convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
   DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
@@ -223,6 +261,89 @@ ReaderBase::ReaderBase(
   handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
 }
 
+std::shared_ptr<const FileTail> ReaderBase::readTail(
+    FileFormat fileFormat,
+    uint64_t readSize,
+    std::shared_ptr<memory::MemoryPool> cachePool) {
+  auto tail = std::make_shared<FileTail>();
+  tail->pool = std::move(cachePool);
+  tail->arena = std::make_unique<google::protobuf::Arena>();
+  // TODO: read footer from spectrum
+  {
+    const void* buf;
+    int32_t ignored;
+    auto lastByteStream = input_->read(fileLength_ - 1, 1, LogType::FOOTER);
+    DWIO_ENSURE(lastByteStream->Next(&buf, &ignored), "failed to read");
+    // Make sure 'lastByteStream' is live while dereferencing 'buf'.
+    tail->psLength = *static_cast<const char*>(buf) & 0xff;
+  }
+  const auto psLength = tail->psLength;
+  DWIO_ENSURE_LE(
+      psLength + 4, // 1 byte for post script len, 3 byte "ORC" header.
+      fileLength_,
+      "Corrupted file, Post script size is invalid");
+
+  if (fileFormat == FileFormat::DWRF) {
+    auto postScript = ProtoUtils::readProto<proto::PostScript>(
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
+  } else {
+    auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
+        input_->read(fileLength_ - psLength - 1, psLength, LogType::FOOTER));
+    tail->postScript = std::make_unique<PostScript>(std::move(postScript));
+  }
+  const auto& postScript = *tail->postScript;
+  // The footer is decompressed as described by the post script.
+  postScript_ = std::shared_ptr<const PostScript>(tail, tail->postScript.get());
+
+  uint64_t footerSize = postScript.footerLength();
+  uint64_t cacheSize = postScript.hasCacheSize() ? postScript.cacheSize() : 0;
+  uint64_t tailSize = 1 + psLength + footerSize + cacheSize;
+
+  // There are cases in warehouse, where RC/text files are stored
+  // in ORC partition. This causes the Reader to SIGSEGV. The following
+  // checks catches most of the corrupted files (but not all).
+  DWIO_ENSURE_LT(
+      footerSize, fileLength_, "Corrupted file, footer size is invalid");
+  DWIO_ENSURE_LT(
+      cacheSize, fileLength_, "Corrupted file, cache size is invalid");
+  DWIO_ENSURE_LE(tailSize, fileLength_, "Corrupted file, tail size is invalid");
+
+  DWIO_ENSURE(
+      (postScript.format() == DwrfFormat::kDwrf)
+          ? proto::CompressionKind_IsValid(postScript.compression())
+          : proto::orc::CompressionKind_IsValid(postScript.compression()),
+      "Corrupted File, invalid compression kind ",
+      postScript.compression());
+
+  if (tailSize > readSize) {
+    input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
+    input_->load(LogType::FOOTER);
+  }
+
+  auto footerStream = input_->read(
+      fileLength_ - psLength - footerSize - 1, footerSize, LogType::FOOTER);
+  if (fileFormat == FileFormat::DWRF) {
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        tail->arena.get());
+    tail->statistics = parseFooterWithoutStatistics(
+        *createDecompressedStream(std::move(footerStream), "File Footer"),
+        tail->pool ? *tail->pool : pool_,
+        tail->arena.get(),
+        footer);
+    tail->footer =
+        std::make_unique<FooterWrapper>(footer, tail->statistics.get());
+  } else {
+    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
+        tail->arena.get());
+    ProtoUtils::readProtoInto<proto::orc::Footer>(
+        createDecompressedStream(std::move(footerStream), "File Footer"),
+        footer);
+    tail->footer = std::make_unique<FooterWrapper>(footer);
+  }
+  return tail;
+}
+
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
   std::vector<uint64_t> rowsPerStripe;
   auto numStripes = getFooter().stripesSize();
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/caching/FileMetadataCache.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
@@ -56,9 +57,31 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+// The parsed post script and footer of a file. Immutable, so that the
+// readers of the same file can share it through a FileMetadataCache. The
+// column statistics of a DWRF footer are parsed on first access.
+struct FileTail : public cache::FileMetadata {
+  // The pool of the FileMetadataCache if the tail is cached. Declared first
+  // so that it outlives the buffers allocated from it.
+  std::shared_ptr<memory::MemoryPool> pool;
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  std::unique_ptr<LazyColumnStatistics> statistics;
+  uint64_t psLength{0};
+
+  uint64_t size() const override {
+    return sizeof(*this) + sizeof(PostScript) + sizeof(FooterWrapper) +
+        arena->SpaceAllocated() +
+        (statistics ? statistics->serializedBytes() : 0);
+  }
+};
+
 class ReaderBase {
  public:
-  // create reader base from buffered input
+  // create reader base from buffered input. If 'metadataCache' is set, the
+  // parsed tail of the file is looked up there by 'metadataCachePath' and
+  // the length of the file before reading it from 'input'.
   ReaderBase(
       memory::MemoryPool& pool,
       std::unique_ptr<dwio::common::BufferedInput> input,
@@ -69,7 +92,9 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      cache::FileMetadataCache* metadataCache = nullptr,
+      const std::string& metadataCachePath = "");
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -231,10 +256,20 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the post script and footer of the file. The last
+  // 'readSize' bytes of the file are expected to be loaded in 'input_'.
+  // Buffers are allocated from 'cachePool' if set and from 'pool_'
+  // otherwise.
+  std::shared_ptr<const FileTail> readTail(
+      dwio::common::FileFormat fileFormat,
+      uint64_t readSize,
+      std::shared_ptr<memory::MemoryPool> cachePool);
+
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // Point into a FileTail that may be shared with other readers.
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
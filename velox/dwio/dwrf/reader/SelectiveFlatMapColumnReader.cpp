@@ -289,36 +289,39 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
         AlignedBuffer::allocate<vector_size_t>(rows.size(), &memoryPool_);
     auto* rawOffsets = offsets->template asMutable<vector_size_t>();
     auto* rawSizes = sizes->template asMutable<vector_size_t>();
+    // The maps are assembled one key at a time, so that the loops run over
+    // the in-map bitmap of a key instead of over the keys of each row.
+    std::fill(rawSizes, rawSizes + rows.size(), 0);
+    for (int k = 0; k < children_.size(); ++k) {
+      forEachRowInMap(k, rows, [&](vector_size_t i) { ++rawSizes[i]; });
+    }
+    // The offsets are first set to the ends of the maps and moved back as
+    // the entries are placed, with the keys in reverse order so that the
+    // entries of a map are in key order.
     vector_size_t totalSize = 0;
     for (vector_size_t i = 0; i < rows.size(); ++i) {
-      if (anyNulls_ && bits::isBitNull(rawResultNulls_, i)) {
-        continue;
-      }
-      int currentRowSize = 0;
-      for (int k = 0; k < children_.size(); ++k) {
-        auto& data = static_cast<const DwrfData&>(children_[k]->formatData());
-        auto* inMap = data.inMap();
-        if (inMap && bits::isBitNull(inMap, rows[i])) {
-          continue;
-        }
-        copyRanges_[k].push_back({
-            .sourceIndex = i,
-            .targetIndex = totalSize + currentRowSize,
-            .count = 1,
-        });
-        ++currentRowSize;
-      }
-      if (currentRowSize > 0) {
-        rawOffsets[i] = totalSize;
-        rawSizes[i] = currentRowSize;
-        totalSize += currentRowSize;
-      } else {
+      if (rawSizes[i] == 0 &&
+          !(anyNulls_ && bits::isBitNull(rawResultNulls_, i))) {
         if (!rawResultNulls_) {
-          setNulls(AlignedBuffer::allocate<bool>(rows.size(), &memoryPool_));
+          setNulls(AlignedBuffer::allocate<bool>(
+              rows.size(), &memoryPool_, bits::kNotNull));
+        } else if (!anyNulls_) {
+          bits::fillBits(rawResultNulls_, 0, rows.size(), bits::kNotNull);
         }
         bits::setNull(rawResultNulls_, i);
         anyNulls_ = true;
       }
+      totalSize += rawSizes[i];
+      rawOffsets[i] = totalSize;
+    }
+    for (int k = children_.size() - 1; k >= 0; --k) {
+      forEachRowInMap(k, rows, [&](vector_size_t i) {
+        copyRanges_[k].push_back({
+            .sourceIndex = i,
+            .targetIndex = --rawOffsets[i],
+            .count = 1,
+        });
+      });
     }
     auto& mapType = requestedType_->type->asMap();
     VectorPtr keys =
@@ -383,6 +386,30 @@ class SelectiveFlatMapReader : public SelectiveStructColumnReaderBase {
   }
 
  private:
+  // Calls 'func' with the index in 'rows' of each non-null map that has the
+  // k-th key.
+  template <typename F>
+  void forEachRowInMap(int k, RowSet rows, F func) const {
+    auto& data = static_cast<const DwrfData&>(children_[k]->formatData());
+    auto* inMap = data.inMap();
+    auto* nulls = anyNulls_ ? rawResultNulls_ : nullptr;
+    if (inMap && rows.back() + 1 == rows.size()) {
+      // Dense rows, the indices in 'rows' are the row numbers.
+      bits::forEachSetBit(inMap, 0, rows.size(), [&](vector_size_t i) {
+        if (!nulls || !bits::isBitNull(nulls, i)) {
+          func(i);
+        }
+      });
+      return;
+    }
+    for (vector_size_t i = 0; i < rows.size(); ++i) {
+      if ((!nulls || !bits::isBitNull(nulls, i)) &&
+          (!inMap || bits::isBitSet(inMap, rows[i]))) {
+        func(i);
+      }
+    }
+  }
+
   common::ScanSpec structScanSpec_;
   std::vector<KeyNode<T>> keyNodes_;
   std::vector<VectorPtr> childValues_;
@@ -26,6 +26,8 @@ void SelectiveStringDictionaryColumnReader::init(DwrfParams& params) {
   format_ = params.stripeStreams().format();
   auto& stripe = params.stripeStreams();
   EncodingKey encodingKey{nodeType_->id, params.flatMapContext().sequence};
+  encodingKey_ = encodingKey;
+  dictionaryCache_ = stripe.getStripeDictionaryCache();
 
   DwrfStreamIdentifier dataId;
   DwrfStreamIdentifier lenId;
@@ -156,6 +158,7 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
   // get stride dictionary size and load it if needed
   auto& positions =
       formatData_->as<DwrfData>().index().entry(nextStride).positions();
+  const auto previousStrideDictSize = scanState_.dictionary2.numValues;
   scanState_.dictionary2.numValues = positions.Get(strideDictSizeOffset_);
   if (scanState_.dictionary2.numValues > 0) {
     // seek stride dictionary related streams
@@ -169,7 +172,12 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // Strides without a stride dictionary keep the base vector of the stripe
+  // dictionary, so that expressions that memoize results by dictionary base
+  // reuse them across batches.
+  if (previousStrideDictSize > 0 || scanState_.dictionary2.numValues > 0) {
+    dictionaryValues_ = nullptr;
+  }
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(
@@ -214,6 +222,10 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         scanState_.dictionary.numValues /*length*/,
         scanState_.dictionary.values,
         std::vector<BufferPtr>{scanState_.dictionary.strings});
+    if (dictionaryCache_) {
+      dictionaryValues_ = dictionaryCache_->unifyStringDictionary(
+          encodingKey_, std::move(dictionaryValues_));
+    }
   }
 }
 
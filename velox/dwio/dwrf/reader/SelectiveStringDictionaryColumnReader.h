@@ -104,6 +104,10 @@ class SelectiveStringDictionaryColumnReader
 
   FlatVectorPtr<StringView> dictionaryValues_;
 
+  // Unifies the stripe dictionary with identical ones of previous stripes.
+  EncodingKey encodingKey_;
+  std::shared_ptr<StripeDictionaryCache> dictionaryCache_;
+
   int64_t lastStrideIndex_;
   size_t positionOffset_;
   size_t strideDictSizeOffset_;
@@ -45,4 +45,33 @@ BufferPtr StripeDictionaryCache::getIntDictionary(const EncodingKey& ek) {
   return intDictionaryFactories_.at(ek)->getDictionaryBuffer(pool_);
 }
 
+namespace {
+bool equalStringDictionaries(
+    const FlatVector<StringView>& left,
+    const FlatVector<StringView>& right) {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  auto* leftValues = left.rawValues();
+  auto* rightValues = right.rawValues();
+  for (auto i = 0; i < left.size(); ++i) {
+    if (leftValues[i] != rightValues[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+FlatVectorPtr<StringView> StripeDictionaryCache::unifyStringDictionary(
+    const EncodingKey& ek,
+    FlatVectorPtr<StringView> dictionary) {
+  auto& previous = stringDictionaries_[ek];
+  if (previous && equalStringDictionaries(*previous, *dictionary)) {
+    return previous;
+  }
+  previous = dictionary;
+  return dictionary;
+}
+
 } // namespace facebook::velox::dwrf
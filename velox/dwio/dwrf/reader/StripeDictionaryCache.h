@@ -21,7 +21,7 @@
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/dwrf/common/Common.h"
-#include "velox/vector/BaseVector.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::dwrf {
 class StripeDictionaryCache {
@@ -49,6 +49,21 @@ class StripeDictionaryCache {
 
   BufferPtr getIntDictionary(const EncodingKey& ek);
 
+  /// Returns the string dictionary of 'ek' carried over from a previous
+  /// stripe if it has the same values as 'dictionary'. Otherwise registers
+  /// 'dictionary' for the next stripes and returns it. Readers returning the
+  /// same dictionary base vector across stripes let consumers, e.g.
+  /// VectorHasher, reuse what they computed for the base.
+  FlatVectorPtr<StringView> unifyStringDictionary(
+      const EncodingKey& ek,
+      FlatVectorPtr<StringView> dictionary);
+
+  /// Carries the string dictionaries of the stripe of 'previous' over to the
+  /// stripe of this.
+  void inheritStringDictionaries(const StripeDictionaryCache& previous) {
+    stringDictionaries_ = previous.stringDictionaries_;
+  }
+
  private:
   // This is typically the reader's memory pool.
   memory::MemoryPool* pool_;
@@ -57,6 +72,8 @@ class StripeDictionaryCache {
       std::unique_ptr<DictionaryEntry>,
       EncodingKeyHash>
       intDictionaryFactories_;
+  std::unordered_map<EncodingKey, FlatVectorPtr<StringView>, EncodingKeyHash>
+      stringDictionaries_;
 
   VELOX_FRIEND_TEST(TestStripeDictionaryCache, RegisterDictionary);
 };
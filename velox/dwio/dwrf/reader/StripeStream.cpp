@@ -19,6 +19,7 @@
 
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
+#include "velox/dwio/dwrf/common/PrefetchedInputStream.h"
 #include "velox/dwio/dwrf/common/wrap/coded-stream-wrapper.h"
 #include "velox/dwio/dwrf/reader/StripeStream.h"
 
@@ -343,10 +344,20 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
-  return reader_.getReader().createDecompressedStream(
+  auto stream = reader_.getReader().createDecompressedStream(
       std::move(streamRead),
       streamDebugInfo,
       getDecrypter(si.encodingKey().node));
+  if (opts_.getIOExecutor() && !isIndexStream(si.kind()) &&
+      dynamic_cast<PagedInputStream*>(stream.get())) {
+    auto prefetched = std::make_unique<PrefetchedInputStream>(
+        std::unique_ptr<PagedInputStream>(
+            static_cast<PagedInputStream*>(stream.release())),
+        *pool_);
+    prefetchTasks_.push_back(prefetched->prefetchTask());
+    return prefetched;
+  }
+  return stream;
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -409,4 +420,14 @@ void StripeStreamsImpl::loadReadPlan() {
   input.load(LogType::STREAM_BUNDLE);
 }
 
+void StripeStreamsImpl::prefetchDecompression() {
+  const auto& executor = opts_.getIOExecutor();
+  if (executor) {
+    for (auto& task : prefetchTasks_) {
+      executor->add(std::move(task));
+    }
+  }
+  prefetchTasks_.clear();
+}
+
 } // namespace facebook::velox::dwrf
@@ -288,6 +288,10 @@ class StripeStreamsImpl : public StripeStreamsBase {
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
 
+  // Decompression of the streams returned by getStream(), to be scheduled on
+  // the I/O executor by prefetchDecompression().
+  mutable std::vector<std::function<void()>> prefetchTasks_;
+
  public:
   StripeStreamsImpl(
       const StripeReaderBase& reader,
@@ -355,6 +359,11 @@ class StripeStreamsImpl : public StripeStreamsBase {
   // load data into buffer according to read plan
   void loadReadPlan();
 
+  // Schedules the decompression of the data streams created so far on the
+  // I/O executor of the row reader options, if set. The stripe data must be
+  // loaded.
+  void prefetchDecompression();
+
   std::unique_ptr<dwio::common::SeekableInputStream> getCompressedStream(
       const DwrfStreamIdentifier& si,
       std::string_view label) const;
@@ -4088,6 +4088,29 @@ TEST(ColumnWriterTests, StringColumnWriterAbandonLowValueDictionaries) {
   }
 }
 
+TEST(ColumnWriterTests, StringColumnWriterAbandonDictionaryEarly) {
+  auto pool = addDefaultLeafMemoryPool();
+  constexpr vector_size_t kSize = 1'000;
+  auto batch = BaseVector::create<FlatVector<StringView>>(
+      VARCHAR(), kSize, pool.get());
+  for (auto i = 0; i < kSize; ++i) {
+    batch->set(i, StringView(fmt::format("distinct value {}", i)));
+  }
+  for (uint32_t earlyCheckRows : {0u, 500u}) {
+    auto config = std::make_shared<Config>();
+    config->set(Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 0.4f);
+    config->set(Config::DICTIONARY_EARLY_CHECK_ROWS, earlyCheckRows);
+    WriterContext context{config, defaultMemoryManager().addRootPool()};
+    auto typeWithId = TypeWithId::create(VARCHAR(), 1);
+    auto columnWriter = BaseColumnWriter::create(context, *typeWithId);
+    columnWriter->write(batch, common::Ranges::of(0, kSize));
+    // With early checks the dictionary of distinct values is already
+    // abandoned after the first write, so there is nothing left to abandon.
+    EXPECT_EQ(
+        earlyCheckRows == 0, columnWriter->tryAbandonDictionaries(true));
+  }
+}
+
 TEST(ColumnWriterTests, IntDictWriterDirectValueOverflow) {
   auto config = std::make_shared<Config>();
   auto pool = addDefaultLeafMemoryPool();
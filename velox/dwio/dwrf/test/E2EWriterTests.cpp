@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Statistics.h"
@@ -335,6 +336,59 @@ TEST_F(E2EWriterTests, E2E) {
   E2EWriterTestUtil::testWriter(*leafPool_, type, batches, 1, 1, config);
 }
 
+TEST_F(E2EWriterTests, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "bool_val:boolean,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "timestamp_val:timestamp,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "map_val:map<bigint,double>," /* this is column 8 */
+      "struct_val:struct<a:float,b:string>"
+      ">");
+
+  auto config = std::make_shared<Config>();
+  config->set(Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  config->set(Config::FLATTEN_MAP, true);
+  config->set(Config::MAP_FLAT_COLS, {8});
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < 6; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1500, *leafPool_, nullptr, i));
+  }
+
+  auto writeFile = [&](folly::Executor* executor) {
+    auto sink = std::make_unique<MemorySink>(*leafPool_, 200 * 1024 * 1024);
+    auto sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = executor;
+    options.encodingColumnGroups = 3;
+    dwrf::Writer writer{std::move(sink), options};
+    for (size_t i = 0; i < batches.size(); ++i) {
+      writer.write(batches[i]);
+      if (i % 2 == 1) {
+        writer.flush();
+      }
+    }
+    writer.close();
+    return std::string(sinkPtr->getData(), sinkPtr->size());
+  };
+
+  folly::CPUThreadPoolExecutor executor(4);
+  auto serial = writeFile(nullptr);
+  auto parallel = writeFile(&executor);
+  EXPECT_EQ(serial, parallel);
+}
+
 TEST_F(E2EWriterTests, FlatMapDictionaryEncoding) {
   const size_t batchCount = 4;
   // Start with a size larger than stride to cover splitting into
@@ -1050,11 +1104,10 @@ TEST_F(E2EEncryptionTest, EncryptRoot) {
 
   // make sure footer doesn't have detailed stats
   auto& footer = reader->getFooter();
-  auto& unencryptedStats = footer.statistics();
   auto encryptedStats = reader->getStatistics();
-  ASSERT_EQ(unencryptedStats.size(), encryptedStats->getNumberOfColumns());
-  for (size_t i = 0; i < unencryptedStats.size(); ++i) {
-    auto& stats = unencryptedStats.Get(i);
+  ASSERT_EQ(footer.statisticsSize(), encryptedStats->getNumberOfColumns());
+  for (size_t i = 0; i < footer.statisticsSize(); ++i) {
+    auto& stats = footer.statistics(i);
     ASSERT_TRUE(stats.has_hasnull());
     ASSERT_TRUE(stats.has_numberofvalues());
     ASSERT_FALSE(
@@ -1126,11 +1179,10 @@ TEST_F(E2EEncryptionTest, EncryptSelectedFields) {
 
   // make sure footer doesn't have detailed stats
   auto& footer = reader->getFooter();
-  auto& unencryptedStats = footer.statistics();
   auto encryptedStats = reader->getStatistics();
-  ASSERT_EQ(unencryptedStats.size(), encryptedStats->getNumberOfColumns());
-  for (size_t i = 0; i < unencryptedStats.size(); ++i) {
-    auto& stats = unencryptedStats.Get(i);
+  ASSERT_EQ(footer.statisticsSize(), encryptedStats->getNumberOfColumns());
+  for (size_t i = 0; i < footer.statisticsSize(); ++i) {
+    auto& stats = footer.statistics(i);
     ASSERT_TRUE(stats.has_hasnull());
     ASSERT_TRUE(stats.has_numberofvalues());
     // only unencrypted leaf node in the schema may have detailed stats
@@ -184,4 +184,63 @@ TEST(RowsPerStripeFlushPolicyTest, FlushTest) {
       exception::LoggedException)
       << "Out of Range Stripe";
 }
+
+TEST(MemoryAwareFlushPolicyTest, StripeProgressTest) {
+  MemoryAwareFlushPolicy policy{
+      /* minStripeSize */ 10, /* maxStripeSize */ 200, 1'000};
+  EXPECT_FALSE(policy.shouldFlush(dwio::common::StripeProgress{
+      .stripeRowCount = 5, .stripeSizeEstimate = 40}));
+  EXPECT_TRUE(policy.shouldFlush(dwio::common::StripeProgress{
+      .stripeRowCount = 5, .stripeSizeEstimate = 200}));
+
+  policy.requestFlush();
+  EXPECT_FALSE(policy.shouldFlush(dwio::common::StripeProgress{}))
+      << "Empty stripe keeps the request";
+  EXPECT_TRUE(policy.shouldFlush(dwio::common::StripeProgress{
+      .stripeRowCount = 1, .stripeSizeEstimate = 1}));
+  EXPECT_FALSE(policy.shouldFlush(dwio::common::StripeProgress{
+      .stripeRowCount = 1, .stripeSizeEstimate = 1}))
+      << "The request is consumed by the flush";
+}
+
+TEST(MemoryAwareFlushPolicyTest, MemoryPressureTest) {
+  constexpr int64_t kCapacity = 64 << 20;
+  auto config = std::make_shared<Config>();
+  WriterContext context{
+      config, defaultMemoryManager().addRootPool("MemoryPressure", kCapacity)};
+  MemoryAwareFlushPolicy policy{
+      /* minStripeSize */ 1 << 20,
+      /* maxStripeSize */ 1UL << 30,
+      /* dictionarySizeThreshold */ kCapacity};
+
+  // 10MB raw data are an estimated 3MB stripe that needs 10MB to flush,
+  // which fits in half of the pool.
+  context.stripeRawSize = 10 << 20;
+  EXPECT_EQ(
+      FlushDecision::SKIP, policy.shouldFlushDictionary(false, false, context));
+
+  auto& pool = context.getMemoryPool(MemoryUsageCategory::GENERAL);
+  constexpr int64_t kAllocationSize = 40 << 20;
+  void* buffer = pool.allocate(kAllocationSize);
+  EXPECT_EQ(
+      FlushDecision::FLUSH_DICTIONARY,
+      policy.shouldFlushDictionary(false, false, context));
+
+  // Stripes below the min size are not flushed for memory.
+  context.stripeRawSize = 1 << 20;
+  EXPECT_EQ(
+      FlushDecision::SKIP, policy.shouldFlushDictionary(false, false, context));
+  pool.free(buffer, kAllocationSize);
+}
+
+TEST(MemoryAwareFlushPolicyTest, UnboundedPoolTest) {
+  auto config = std::make_shared<Config>();
+  WriterContext context{
+      config, defaultMemoryManager().addRootPool("UnboundedPool")};
+  MemoryAwareFlushPolicy policy{
+      /* minStripeSize */ 1, /* maxStripeSize */ 1UL << 30, 1UL << 30};
+  context.stripeRawSize = 100 << 20;
+  EXPECT_EQ(
+      FlushDecision::SKIP, policy.shouldFlushDictionary(false, false, context));
+}
 } // namespace facebook::velox::dwrf
@@ -180,4 +180,74 @@ TEST(LayoutPlannerTests, Basic) {
   });
   ASSERT_EQ(pos, dataStreams.size());
 }
+
+TEST(LayoutPlannerTests, flatMapKeysByRows) {
+  auto config = std::make_shared<Config>();
+  config->set(
+      Config::COMPRESSION, dwio::common::CompressionKind::CompressionKind_NONE);
+  WriterContext context{
+      config,
+      facebook::velox::memory::defaultMemoryManager().addRootPool(
+          "LayoutPlannerTests")};
+  std::vector<DwrfStreamIdentifier> streams;
+  std::array<char, 64> data;
+  std::memset(data.data(), 'a', data.size());
+  auto addStream = [&](uint32_t node,
+                       uint32_t seq,
+                       uint32_t col,
+                       StreamKind kind,
+                       uint32_t size) {
+    auto streamId = DwrfStreamIdentifier{node, seq, col, kind};
+    streams.push_back(streamId);
+    AppendOnlyBufferedStream out{context.newStream(streamId)};
+    out.write(data.data(), size);
+    out.flush();
+  };
+
+  auto encryptionHandler =
+      std::make_unique<velox::dwrf::encryption::EncryptionHandler>();
+  EncodingManager encodingManager{*encryptionHandler};
+  auto addEncoding =
+      [&](uint32_t node, uint32_t seq, proto::ColumnEncoding_Kind kind) {
+        auto& encoding = encodingManager.addEncodingToFooter(node);
+        encoding.set_node(node);
+        encoding.set_sequence(seq);
+        encoding.set_kind(kind);
+      };
+
+  addStream(4, 1, 1, StreamKind::StreamKind_DATA, 10); // 0
+  addStream(4, 2, 1, StreamKind::StreamKind_DATA, 20); // 1
+  addStream(4, 3, 1, StreamKind::StreamKind_DATA, 30); // 2
+  addStream(2, 0, 1, StreamKind::StreamKind_PRESENT, 5); // 3
+  addStream(1, 0, 0, StreamKind::StreamKind_DATA, 6); // 4
+
+  addEncoding(1, 0, proto::ColumnEncoding::DIRECT);
+  addEncoding(2, 0, proto::ColumnEncoding::MAP_FLAT);
+  addEncoding(4, 1, proto::ColumnEncoding::DIRECT);
+  addEncoding(4, 2, proto::ColumnEncoding::DIRECT);
+  addEncoding(4, 3, proto::ColumnEncoding::DIRECT);
+
+  auto typeWithId = dwio::common::TypeWithId::create(
+      ROW({INTEGER(), MAP(INTEGER(), INTEGER())}));
+  LayoutPlanner planner{*typeWithId};
+  auto expectDataStreams = [&](const LayoutResult& result,
+                               const std::vector<size_t>& expected) {
+    size_t pos = 0;
+    result.iterateDataStreams([&](auto& stream, auto& /* ignored */) {
+      ASSERT_LT(pos, expected.size());
+      ASSERT_EQ(stream, streams.at(expected[pos++]));
+    });
+    ASSERT_EQ(pos, expected.size());
+  };
+
+  // Without key frequencies the keys are placed by ascending size.
+  expectDataStreams(
+      planner.plan(encodingManager, getStreamList(context)), {4, 3, 0, 1, 2});
+
+  // The keys in the most rows go first.
+  FlatMapKeyRows keyRows{{1, {{1, 10}, {2, 1'000}, {3, 100}}}};
+  expectDataStreams(
+      planner.plan(encodingManager, getStreamList(context), &keyRows),
+      {4, 3, 1, 2, 0});
+}
 } // namespace facebook::velox::dwrf
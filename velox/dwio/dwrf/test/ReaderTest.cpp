@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <velox/buffer/Buffer.h>
 #include "folly/Random.h"
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/DataSink.h"
@@ -546,6 +547,89 @@ TEST(TestReader, testEstimatedSize) {
   }
 }
 
+TEST(TestReader, fileMetadataCache) {
+  const std::string fmSmall(getExampleFilePath("fm_small.orc"));
+  auto metadataCache = std::make_shared<cache::FileMetadataCache>(1 << 20, 0);
+  ReaderOptions readerOpts{defaultPool.get()};
+  readerOpts.setFileMetadataCache(metadataCache, fmSmall);
+  // Sets a threshold below the file size so that only the tail is read.
+  readerOpts.setFilePreloadThreshold(0);
+
+  auto first = DwrfReader::create(
+      createFileBufferedInput(fmSmall, readerOpts.getMemoryPool()),
+      readerOpts);
+  auto second = DwrfReader::create(
+      createFileBufferedInput(fmSmall, readerOpts.getMemoryPool()),
+      readerOpts);
+  auto stats = metadataCache->stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(1, stats.numHits);
+
+  // The readers share the footer.
+  EXPECT_EQ(&first->getFooter(), &second->getFooter());
+  EXPECT_EQ(first->numberOfRows(), second->numberOfRows());
+  EXPECT_EQ(*first->rowType(), *second->rowType());
+  auto firstRows = first->createRowReader(RowReaderOptions());
+  auto secondRows = second->createRowReader(RowReaderOptions());
+  auto firstBatch = BaseVector::create(first->rowType(), 0, defaultPool.get());
+  auto secondBatch =
+      BaseVector::create(second->rowType(), 0, defaultPool.get());
+  while (firstRows->next(1'000, firstBatch)) {
+    ASSERT_TRUE(secondRows->next(1'000, secondBatch));
+    ASSERT_EQ(firstBatch->size(), secondBatch->size());
+    for (auto i = 0; i < firstBatch->size(); ++i) {
+      ASSERT_TRUE(firstBatch->equalValueAt(secondBatch.get(), i, i));
+    }
+  }
+  EXPECT_FALSE(secondRows->next(1'000, secondBatch));
+}
+
+TEST(TestReader, lazyFooterStatistics) {
+  const std::string fmSmall(getExampleFilePath("fm_small.orc"));
+  auto cachePool = memory::addDefaultLeafMemoryPool("fileMetadataCache");
+  auto metadataCache =
+      std::make_shared<cache::FileMetadataCache>(1 << 20, 0, cachePool);
+  ReaderOptions readerOpts{defaultPool.get()};
+  readerOpts.setFileMetadataCache(metadataCache, fmSmall);
+  readerOpts.setFilePreloadThreshold(0);
+
+  auto first = DwrfReader::create(
+      createFileBufferedInput(fmSmall, readerOpts.getMemoryPool()),
+      readerOpts);
+  auto* statistics = first->getFooter().lazyStatistics();
+  ASSERT_NE(statistics, nullptr);
+  ASSERT_EQ(
+      first->getFooter().statisticsSize(), first->getFooter().typesSize());
+  EXPECT_EQ(0, statistics->numParsed());
+  // The serialized statistics are charged to the pool of the cache.
+  EXPECT_GE(cachePool->currentBytes(), statistics->serializedBytes());
+  EXPECT_GT(statistics->serializedBytes(), 0);
+
+  // Only the accessed columns are parsed, once for all readers of the file.
+  EXPECT_EQ(
+      first->numberOfRows().value(),
+      first->columnStatistics(0)->getNumberOfValues().value());
+  first->columnStatistics(1);
+  EXPECT_EQ(2, statistics->numParsed());
+  auto second = DwrfReader::create(
+      createFileBufferedInput(fmSmall, readerOpts.getMemoryPool()),
+      readerOpts);
+  EXPECT_EQ(statistics, second->getFooter().lazyStatistics());
+  EXPECT_EQ(
+      &first->getFooter().statistics(1), &second->getFooter().statistics(1));
+  EXPECT_EQ(2, statistics->numParsed());
+
+  // All columns are parsed for the file statistics.
+  auto fileStats = second->getStatistics();
+  EXPECT_EQ(statistics->size(), fileStats->getNumberOfColumns());
+  EXPECT_EQ(statistics->size(), statistics->numParsed());
+
+  first.reset();
+  second.reset();
+  metadataCache->clear();
+  EXPECT_EQ(0, cachePool->currentBytes());
+}
+
 TEST(TestReader, testStatsCallbackFiredWithoutFiltering) {
   const std::string fmSmall(getExampleFilePath("fm_small.orc"));
 
@@ -1847,6 +1931,55 @@ TEST(TestReader, appendRowNumberColumn) {
   }
 }
 
+TEST(TestReader, stripeDictionaryBaseReusedAcrossStrides) {
+  auto& pool = defaultPool;
+  VectorMaker maker(pool.get());
+  std::vector<std::string> fruits = {"apple", "pear", "grapes", "pineapple"};
+  auto batch = maker.rowVector({maker.flatVector<StringView>(
+      1'000, [&](auto row) { return StringView(fruits[row % 4]); })});
+  auto config = std::make_shared<Config>();
+  config->set(Config::ROW_INDEX_STRIDE, 100u);
+  auto sink = std::make_unique<MemorySink>(*pool, 1 << 20);
+  auto* sinkPtr = sink.get();
+  auto writer = E2EWriterTestUtil::writeData(
+      std::move(sink),
+      asRowType(batch->type()),
+      {batch},
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true));
+  std::string_view data(sinkPtr->getData(), sinkPtr->size());
+  ReaderOptions readerOpts(pool.get());
+  auto reader = DwrfReader::create(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data), *pool),
+      readerOpts);
+
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*batch->type());
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr result = BaseVector::create(batch->type(), 0, pool.get());
+  const BaseVector* base = nullptr;
+  int32_t numRows = 0;
+  while (rowReader->next(100, result) > 0) {
+    auto values = result->asUnchecked<RowVector>()->childAt(0);
+    ASSERT_EQ(VectorEncoding::Simple::DICTIONARY, values->encoding());
+    if (base == nullptr) {
+      base = values->valueVector().get();
+    }
+    // All strides share the stripe dictionary.
+    ASSERT_EQ(base, values->valueVector().get());
+    for (auto i = 0; i < values->size(); ++i) {
+      ASSERT_EQ(
+          fruits[(numRows + i) % 4],
+          values->asUnchecked<SimpleVector<StringView>>()->valueAt(i).str());
+    }
+    numRows += values->size();
+  }
+  EXPECT_EQ(1'000, numRows);
+}
+
 TEST(TestReader, reuseRowNumberColumn) {
   std::vector<std::vector<int32_t>> integerValues{{0, 1, 2, 3, 4}};
   auto& pool = defaultPool;
@@ -1905,3 +2038,217 @@ TEST(TestReader, reuseRowNumberColumn) {
     ASSERT_NE(rowNum.get(), result->asUnchecked<RowVector>()->childAt(1).get());
   }
 }
+
+TEST(TestReader, selectedRows) {
+  // 3 stripes of 5 row groups of 100 rows. Each value is its row number.
+  auto& pool = defaultPool;
+  VectorMaker maker(pool.get());
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    batches.push_back(maker.rowVector({maker.flatVector<int32_t>(
+        500, [&](auto row) { return i * 500 + row; })}));
+  }
+  auto config = std::make_shared<Config>();
+  config->set(Config::ROW_INDEX_STRIDE, 100u);
+  auto sink = std::make_unique<MemorySink>(*pool, 1 << 20);
+  auto* sinkPtr = sink.get();
+  auto writer = E2EWriterTestUtil::writeData(
+      std::move(sink),
+      asRowType(batches[0]->type()),
+      batches,
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true));
+  std::string_view data(sinkPtr->getData(), sinkPtr->size());
+  ReaderOptions readerOpts(pool.get());
+  auto reader = DwrfReader::create(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data), *pool),
+      readerOpts);
+  ASSERT_EQ(3, reader->getFooter().stripesSize());
+
+  // Row groups 2 and 3 of the first stripe and 0 to 3 of the second are
+  // skipped. The third stripe is not read.
+  std::vector<int32_t> selected = {3, 150, 151, 420, 999};
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*batches[0]->type());
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  rowReaderOpts.setAppendRowNumberColumn(true);
+  rowReaderOpts.setSelectedRows(std::make_shared<std::vector<uint64_t>>(
+      selected.begin(), selected.end()));
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(ROW({{"c0", INTEGER()}}), 0, pool.get());
+  std::vector<int32_t> values;
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rowVector = result->asUnchecked<RowVector>();
+    ASSERT_EQ(2, rowVector->childrenSize());
+    DecodedVector decoded(*rowVector->childAt(0));
+    DecodedVector rowNumbers(*rowVector->childAt(1));
+    for (auto i = 0; i < rowVector->size(); ++i) {
+      ASSERT_EQ(decoded.valueAt<int32_t>(i), rowNumbers.valueAt<int64_t>(i));
+      values.push_back(decoded.valueAt<int32_t>(i));
+    }
+  }
+  EXPECT_EQ(selected, values);
+  dwio::common::RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(6, stats.skippedStrides);
+
+  // Selected rows combine with filters.
+  spec->childByName("c0")->setFilter(
+      common::createBigintValues({150, 420, 999}, false));
+  spec->resetCachedValues(true);
+  rowReader = reader->createRowReader(rowReaderOpts);
+  values.clear();
+  while (rowReader->next(1'000, result) > 0) {
+    auto* rowVector = result->asUnchecked<RowVector>();
+    DecodedVector decoded(*rowVector->childAt(0));
+    for (auto i = 0; i < rowVector->size(); ++i) {
+      values.push_back(decoded.valueAt<int32_t>(i));
+    }
+  }
+  EXPECT_EQ((std::vector<int32_t>{150, 420, 999}), values);
+}
+
+TEST(TestReader, bloomFilterSkipsRowGroups) {
+  // 10 row groups of 100 rows with the even numbers and their strings.
+  auto& pool = defaultPool;
+  VectorMaker maker(pool.get());
+  std::vector<VectorPtr> batches{maker.rowVector(
+      {maker.flatVector<int64_t>(1'000, [](auto row) { return row * 2; }),
+       maker.flatVector<std::string>(
+           1'000, [](auto row) { return fmt::format("s{}", row * 2); })})};
+  auto readWith = [&](bool bloomFilter,
+                      std::unique_ptr<common::Filter> c0Filter,
+                      std::unique_ptr<common::Filter> c1Filter,
+                      int64_t expectedRows) {
+    auto config = std::make_shared<Config>();
+    config->set(Config::ROW_INDEX_STRIDE, 100u);
+    if (bloomFilter) {
+      config->set(Config::BLOOM_FILTER_COLS, {0, 1});
+    }
+    auto sink = std::make_unique<MemorySink>(*pool, 1 << 20);
+    auto* sinkPtr = sink.get();
+    auto writer = E2EWriterTestUtil::writeData(
+        std::move(sink),
+        asRowType(batches[0]->type()),
+        batches,
+        config,
+        E2EWriterTestUtil::simpleFlushPolicyFactory(true));
+    std::string_view data(sinkPtr->getData(), sinkPtr->size());
+    ReaderOptions readerOpts(pool.get());
+    auto reader = DwrfReader::create(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(data), *pool),
+        readerOpts);
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*batches[0]->type());
+    if (c0Filter) {
+      spec->childByName("c0")->setFilter(std::move(c0Filter));
+    }
+    if (c1Filter) {
+      spec->childByName("c1")->setFilter(std::move(c1Filter));
+    }
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(batches[0]->type(), 0, pool.get());
+    int64_t numRows = 0;
+    while (rowReader->next(1'000, result) > 0) {
+      numRows += result->size();
+    }
+    EXPECT_EQ(expectedRows, numRows);
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    return stats.skippedStrides;
+  };
+
+  // 301 and 703 are in the ranges of row groups 1 and 3 but in no row.
+  EXPECT_EQ(
+      8, readWith(false, common::createBigintValues({301, 703}, false), {}, 0));
+  EXPECT_EQ(
+      10, readWith(true, common::createBigintValues({301, 703}, false), {}, 0));
+  EXPECT_EQ(
+      9, readWith(true, common::createBigintValues({302, 703}, false), {}, 1));
+  EXPECT_EQ(
+      10,
+      readWith(
+          true,
+          {},
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"s301"}, false),
+          0));
+  EXPECT_EQ(
+      9,
+      readWith(
+          true,
+          {},
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"s302"}, false),
+          1));
+  // Filters that pass nulls cannot use the Bloom filter.
+  EXPECT_EQ(
+      8, readWith(true, common::createBigintValues({301, 703}, true), {}, 0));
+}
+
+TEST(TestReader, prefetchDecompression) {
+  auto& pool = defaultPool;
+  VectorMaker maker(pool.get());
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 2; ++i) {
+    batches.push_back(maker.rowVector(
+        {maker.flatVector<int64_t>(
+             1'000, [&](auto row) { return i * 1'000 + row; }),
+         maker.flatVector<StringView>(1'000, [&](auto row) {
+           return StringView::makeInline(fmt::format("s{}", row % 37));
+         })}));
+  }
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, CompressionKind_ZSTD);
+  config->set(Config::ROW_INDEX_STRIDE, 100u);
+  auto sink = std::make_unique<MemorySink>(*pool, 1 << 20);
+  auto* sinkPtr = sink.get();
+  auto writer = E2EWriterTestUtil::writeData(
+      std::move(sink),
+      asRowType(batches[0]->type()),
+      batches,
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(true));
+  std::string_view data(sinkPtr->getData(), sinkPtr->size());
+  ReaderOptions readerOpts(pool.get());
+  auto reader = DwrfReader::create(
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data), *pool),
+      readerOpts);
+
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  for (bool withExecutor : {false, true}) {
+    SCOPED_TRACE(fmt::format("withExecutor {}", withExecutor));
+    // The filter skips row groups, which seeks the prefetched streams.
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*batches[0]->type());
+    spec->childByName("c0")->setFilter(
+        std::make_unique<common::BigintRange>(450, 1'550, false));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    if (withExecutor) {
+      rowReaderOpts.setIOExecutor(executor);
+    }
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr result = BaseVector::create(batches[0]->type(), 0, pool.get());
+    int64_t expected = 450;
+    while (rowReader->next(100, result) > 0) {
+      auto* row = result->asUnchecked<RowVector>();
+      DecodedVector numbers(*row->childAt(0));
+      DecodedVector strings(*row->childAt(1));
+      for (auto i = 0; i < row->size(); ++i) {
+        ASSERT_EQ(expected, numbers.valueAt<int64_t>(i));
+        ASSERT_EQ(
+            fmt::format("s{}", expected % 1'000 % 37),
+            strings.valueAt<StringView>(i).str());
+        ++expected;
+      }
+    }
+    EXPECT_EQ(1'551, expected);
+  }
+}
@@ -289,6 +289,57 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(CompressionKind_NONE, nullptr, nullptr),
         std::make_tuple(CompressionKind_NONE, &testEncrypter, &testDecrypter)));
 
+TEST(TestCompression, batchDecryption) {
+  auto pool = addDefaultLeafMemoryPool();
+  MemorySink memSink(*pool, DEFAULT_MEM_STREAM_SIZE);
+
+  uint64_t block = 1024;
+  constexpr size_t dataSize = 256 * 1024;
+  std::vector<char> testData(dataSize);
+  generateRandomData(testData.data(), dataSize, true);
+  compressAndVerify(
+      CompressionKind_ZSTD,
+      memSink,
+      block,
+      *pool,
+      testData.data(),
+      dataSize,
+      &testEncrypter);
+
+  // Reads the stream in ranges that end inside blocks, so that the batches
+  // stop at range boundaries.
+  for (uint64_t rangeSize : {0, 3'000}) {
+    TestDecrypter decrypter;
+    decrypter.setKey(testEncrypter.getKey());
+    auto stream = createDecompressor(
+        CompressionKind_ZSTD,
+        std::make_unique<SeekableArrayInputStream>(
+            memSink.getData(), memSink.size(), rangeSize),
+        block,
+        *pool,
+        "Test Compression",
+        &decrypter);
+
+    const char* buffer;
+    int32_t size;
+    size_t pos = 0;
+    while (stream->Next(reinterpret_cast<const void**>(&buffer), &size)) {
+      ASSERT_LE(pos + size, dataSize);
+      ASSERT_EQ(0, memcmp(testData.data() + pos, buffer, size));
+      pos += size;
+    }
+    ASSERT_EQ(pos, dataSize);
+    EXPECT_LT(decrypter.getBatchCount(), decrypter.getCount());
+
+    // Seeking drops the blocks decrypted ahead.
+    std::vector<uint64_t> positions{0, 100};
+    PositionProvider provider(positions);
+    stream->seekToPosition(provider);
+    ASSERT_TRUE(stream->Next(reinterpret_cast<const void**>(&buffer), &size));
+    ASSERT_EQ(0, memcmp(testData.data() + 100, buffer, size));
+  }
+}
+
 typedef std::tuple<CompressionKind, const Encrypter*> TestParams2;
 
 class RecordPositionTest : public TestWithParam<TestParams2> {
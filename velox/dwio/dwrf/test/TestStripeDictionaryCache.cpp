@@ -125,4 +125,39 @@ TEST(TestStripeDictionaryCache, GetDictionaryBuffer) {
     EXPECT_ANY_THROW(cache.getIntDictionary({2, 0}));
   }
 }
+
+TEST(TestStripeDictionaryCache, UnifyStringDictionary) {
+  auto makeDictionary = [](std::vector<std::string> values) {
+    auto dictionary = std::dynamic_pointer_cast<FlatVector<StringView>>(
+        BaseVector::create(VARCHAR(), values.size(), defaultPool.get()));
+    for (auto i = 0; i < values.size(); ++i) {
+      dictionary->set(i, StringView(values[i]));
+    }
+    return dictionary;
+  };
+
+  StripeDictionaryCache firstStripe{defaultPool.get()};
+  auto dictionary = makeDictionary({"a", "b", "a string of a dictionary"});
+  EXPECT_EQ(dictionary, firstStripe.unifyStringDictionary({1, 0}, dictionary));
+
+  // The next stripe gets the dictionary of the first if its values are the
+  // same.
+  StripeDictionaryCache secondStripe{defaultPool.get()};
+  secondStripe.inheritStringDictionaries(firstStripe);
+  EXPECT_EQ(
+      dictionary,
+      secondStripe.unifyStringDictionary(
+          {1, 0}, makeDictionary({"a", "b", "a string of a dictionary"})));
+  auto other = makeDictionary({"a", "b", "c"});
+  EXPECT_EQ(other, secondStripe.unifyStringDictionary({2, 0}, other));
+
+  StripeDictionaryCache thirdStripe{defaultPool.get()};
+  thirdStripe.inheritStringDictionaries(secondStripe);
+  auto changed = makeDictionary({"a", "b"});
+  EXPECT_EQ(changed, thirdStripe.unifyStringDictionary({1, 0}, changed));
+  EXPECT_EQ(
+      other,
+      thirdStripe.unifyStringDictionary(
+          {2, 0}, makeDictionary({"a", "b", "c"})));
+}
 } // namespace facebook::velox::dwrf
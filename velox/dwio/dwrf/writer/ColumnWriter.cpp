@@ -15,7 +15,9 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <folly/ScopeGuard.h>
 #include <velox/dwio/common/exception/Exception.h>
+#include "velox/common/base/AsyncSource.h"
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
@@ -35,7 +37,18 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  SelectivityVector* selectedPtr;
+  if (context_.encodingExecutor()) {
+    if (!selectivityVector_) {
+      selectivityVector_ = std::make_unique<SelectivityVector>(slice->size());
+    } else {
+      selectivityVector_->resize(slice->size());
+    }
+    selectedPtr = selectivityVector_.get();
+  } else {
+    selectedPtr = &context_.getSharedSelectivityVector(slice->size());
+  }
+  auto& selected = *selectedPtr;
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -209,6 +222,8 @@ class IntegerColumnWriter : public BaseColumnWriter {
         dictionaryKeySizeThreshold_{
             getConfig(Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        earlyCheckRows_{getConfig(Config::DICTIONARY_EARLY_CHECK_ROWS)},
+        nextEarlyCheck_{earlyCheckRows_},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE_GE(dictionaryKeySizeThreshold_, 0.0);
@@ -307,6 +322,7 @@ class IntegerColumnWriter : public BaseColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
+    addBloomFilterEntry();
     indexStatsBuilder_->reset();
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
@@ -369,6 +385,18 @@ class IntegerColumnWriter : public BaseColumnWriter {
     return true;
   }
 
+  // Abandons the dictionary as soon as the buffered values of the first
+  // stripe show that it does not pay off, so that the rest of the stripe is
+  // written directly instead of being converted at flush.
+  void checkDictionaryEarly() {
+    if (earlyCheckRows_ == 0 || !firstStripe_ ||
+        rows_.size() < nextEarlyCheck_) {
+      return;
+    }
+    nextEarlyCheck_ = rows_.size() + earlyCheckRows_;
+    tryAbandonDictionaries(false);
+  }
+
  private:
   uint64_t writeDict(
       DecodedVector& decodedVector,
@@ -478,6 +506,10 @@ class IntegerColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   const float dictionaryKeySizeThreshold_;
   const bool sort_;
+  // Number of buffered values between checks of the dictionary efficiency in
+  // the first stripe. 0 checks at flush only.
+  const uint32_t earlyCheckRows_;
+  uint64_t nextEarlyCheck_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
@@ -494,7 +526,9 @@ uint64_t IntegerColumnWriter<T>::write(
     // Decode and then write
     auto localDecoded = decode(slice, ranges);
     auto& decodedVector = localDecoded.get();
-    return writeDict(decodedVector, ranges);
+    auto rawSize = writeDict(decodedVector, ranges);
+    checkDictionaryEarly();
+    return rawSize;
   } else {
     // If the input is not a flat vector we make a complete copy and convert
     // it to flat vector
@@ -522,10 +556,14 @@ uint64_t IntegerColumnWriter<T>::writeDict(
   writeNulls(decodedVector, ranges);
   // make sure we have enough space
   rows_.reserve(rows_.size() + ranges.size());
+  auto* bloomFilter = bloomFilterBuilder_.get();
   auto processRow = [&](vector_size_t pos) {
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
     statsBuilder.addValues(value);
+    if (bloomFilter) {
+      bloomFilter->add(bloomFilterHash(static_cast<int64_t>(value)));
+    }
   };
 
   uint64_t nullCount = 0;
@@ -564,6 +602,14 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
   auto vals = flatVector->rawValues();
 
   auto count = dataDirect_->add(vals, ranges, nulls);
+  if (bloomFilterBuilder_) {
+    for (auto& pos : ranges) {
+      if (!nulls || !bits::isBitNull(nulls, pos)) {
+        bloomFilterBuilder_->add(
+            bloomFilterHash(static_cast<int64_t>(vals[pos])));
+      }
+    }
+  }
   StatisticsBuilderUtils::addValues<T>(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
@@ -837,6 +883,8 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        earlyCheckRows_{getConfig(Config::DICTIONARY_EARLY_CHECK_ROWS)},
+        nextEarlyCheck_{earlyCheckRows_},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE(firstStripe_);
@@ -934,6 +982,7 @@ class StringColumnWriter : public BaseColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
+    addBloomFilterEntry();
     indexStatsBuilder_->reset();
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
@@ -1004,6 +1053,18 @@ class StringColumnWriter : public BaseColumnWriter {
     }
   }
 
+  // Abandons the dictionary as soon as the buffered values of the first
+  // stripe show that it does not pay off, so that the rest of the stripe is
+  // written directly instead of being converted at flush.
+  void checkDictionaryEarly() {
+    if (earlyCheckRows_ == 0 || !firstStripe_ ||
+        rows_.size() < nextEarlyCheck_) {
+      return;
+    }
+    nextEarlyCheck_ = rows_.size() + earlyCheckRows_;
+    tryAbandonDictionaries(false);
+  }
+
  private:
   uint64_t writeDict(
       DecodedVector& decodedVector,
@@ -1123,6 +1184,10 @@ class StringColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
   const bool sort_;
+  // Number of buffered values between checks of the dictionary efficiency in
+  // the first stripe. 0 checks at flush only.
+  const uint32_t earlyCheckRows_;
+  uint64_t nextEarlyCheck_;
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
@@ -1138,7 +1203,9 @@ uint64_t StringColumnWriter::write(
   auto& decodedVector = localDecoded.get();
 
   if (useDictionaryEncoding_) {
-    return writeDict(decodedVector, ranges);
+    auto rawSize = writeDict(decodedVector, ranges);
+    checkDictionaryEarly();
+    return rawSize;
   } else {
     return writeDirect(decodedVector, ranges);
   }
@@ -1154,10 +1221,14 @@ uint64_t StringColumnWriter::writeDict(
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
   uint64_t rawSize = 0;
+  auto* bloomFilter = bloomFilterBuilder_.get();
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
     statsBuilder.addValues(sp);
+    if (bloomFilter) {
+      bloomFilter->add(bloomFilterHash(std::string_view(sp)));
+    }
     rawSize += sp.size();
   };
 
@@ -1198,11 +1269,15 @@ uint64_t StringColumnWriter::writeDirect(
   lengths.reserve(ranges.size());
 
   uint64_t rawSize = 0;
+  auto* bloomFilter = bloomFilterBuilder_.get();
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
     statsBuilder.addValues(sp);
+    if (bloomFilter) {
+      bloomFilter->add(bloomFilterHash(std::string_view(sp)));
+    }
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1646,12 +1721,28 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
+    if (isRoot() && context_.encodingExecutor()) {
+      flushChildrenInParallel(encodingFactory);
+      return;
+    }
     for (auto& c : children_) {
       c->flush(encodingFactory);
     }
   }
 
  private:
+  // Splits the children into groups of adjacent columns and calls
+  // 'func(group, begin, end)' for each group on the encoding executor of the
+  // context. Returns after all groups are done and rethrows the last error.
+  void forEachColumnGroup(
+      const std::function<void(int32_t, size_t, size_t)>& func);
+
+  // Flushes the children in parallel. The encodings are collected per group
+  // and added to the footer in column order, so that the stripe footer is the
+  // same as with a serial flush.
+  void flushChildrenInParallel(
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
@@ -1663,7 +1754,18 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     const common::Ranges& ranges,
     uint64_t nullCount) {
   uint64_t rawSize = 0;
-  if (ranges.size() > 0) {
+  if (ranges.size() > 0 && isRoot() && context_.encodingExecutor()) {
+    std::vector<uint64_t> groupRawSizes(context_.numEncodingGroups());
+    forEachColumnGroup([&](int32_t group, size_t begin, size_t end) {
+      for (auto i = begin; i < end; ++i) {
+        groupRawSizes[group] +=
+            children_[i]->write(rowSlice->childAt(i), ranges);
+      }
+    });
+    for (auto groupRawSize : groupRawSizes) {
+      rawSize += groupRawSize;
+    }
+  } else if (ranges.size() > 0) {
     for (size_t i = 0; i < children_.size(); ++i) {
       rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
     }
@@ -1677,6 +1779,70 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
   return rawSize;
 }
 
+void StructColumnWriter::forEachColumnGroup(
+    const std::function<void(int32_t, size_t, size_t)>& func) {
+  const size_t numChildren = children_.size();
+  const int32_t numGroups = std::min<size_t>(
+      context_.numEncodingGroups(), std::max<size_t>(numChildren, 1));
+  if (numGroups == 1) {
+    func(0, 0, numChildren);
+    return;
+  }
+  std::vector<std::shared_ptr<AsyncSource<bool>>> groups;
+  std::exception_ptr error;
+  auto syncGroups = [&]() {
+    // All groups must be waited for also in case of error because they
+    // reference 'func' and the column writers.
+    for (auto& group : groups) {
+      try {
+        group->move();
+      } catch (const std::exception&) {
+        error = std::current_exception();
+      }
+    }
+  };
+  auto guard = folly::makeGuard(syncGroups);
+  for (auto i = 0; i < numGroups; ++i) {
+    const size_t begin = numChildren * i / numGroups;
+    const size_t end = numChildren * (i + 1) / numGroups;
+    groups.push_back(
+        std::make_shared<AsyncSource<bool>>([&func, i, begin, end]() {
+          func(i, begin, end);
+          return std::make_unique<bool>(true);
+        }));
+    context_.encodingExecutor()->add(
+        [group = groups.back()]() { group->prepare(); });
+  }
+  guard.dismiss();
+  syncGroups();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void StructColumnWriter::flushChildrenInParallel(
+    const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+  using NodeEncoding =
+      std::pair<uint32_t, std::unique_ptr<proto::ColumnEncoding>>;
+  std::vector<std::vector<NodeEncoding>> encodings(
+      context_.numEncodingGroups());
+  forEachColumnGroup([&](int32_t group, size_t begin, size_t end) {
+    auto& groupEncodings = encodings[group];
+    for (auto i = begin; i < end; ++i) {
+      children_[i]->flush([&](uint32_t nodeId) -> proto::ColumnEncoding& {
+        groupEncodings.emplace_back(
+            nodeId, std::make_unique<proto::ColumnEncoding>());
+        return *groupEncodings.back().second;
+      });
+    }
+  });
+  for (auto& groupEncodings : encodings) {
+    for (auto& [nodeId, encoding] : groupEncodings) {
+      encodingFactory(nodeId).Swap(encoding.get());
+    }
+  }
+}
+
 uint64_t StructColumnWriter::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
@@ -83,6 +83,7 @@ class BaseColumnWriter : public ColumnWriter {
     // time, yet we need to maintain and aggregate logical stats.
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     indexBuilder_->addEntry(*indexStatsBuilder_);
+    addBloomFilterEntry();
     indexStatsBuilder_->reset();
     recordPosition();
     for (auto& child : children_) {
@@ -117,6 +118,9 @@ class BaseColumnWriter : public ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->flush();
+    }
   }
 
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
@@ -171,6 +175,10 @@ class BaseColumnWriter : public ColumnWriter {
     auto options = StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type, options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type, options);
+    if (needsBloomFilter()) {
+      bloomFilterBuilder_ = std::make_unique<BloomFilterIndexBuilder>(
+          newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8));
+    }
 
     if (format_ == dwrf::DwrfFormat::kDwrf) {
       VELOX_CHECK(rleVersion_ == velox::dwrf::RleVersion_1);
@@ -227,6 +235,24 @@ class BaseColumnWriter : public ColumnWriter {
     return id_ == 0;
   }
 
+  // True if the values of this top level column of a supported type go to a
+  // Bloom filter per row group.
+  bool needsBloomFilter() const {
+    if (!isIndexEnabled() || sequence_ != 0 || type_.parent == nullptr ||
+        type_.parent->id != 0 || !isBloomFilterSupported(type_.type->kind())) {
+      return false;
+    }
+    const auto& columns = getConfig(Config::BLOOM_FILTER_COLS);
+    return std::find(columns.begin(), columns.end(), type_.column) !=
+        columns.end();
+  }
+
+  void addBloomFilterEntry() {
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
+  }
+
   std::unique_ptr<BufferedOutputStream> newStream(StreamKind kind) {
     return context_.newStream(
         DwrfStreamIdentifier{id_, sequence_, type_.column, kind});
@@ -274,6 +300,8 @@ class BaseColumnWriter : public ColumnWriter {
   const dwio::common::TypeWithId& type_;
   std::vector<std::unique_ptr<BaseColumnWriter>> children_;
   std::unique_ptr<IndexBuilder> indexBuilder_;
+  // Set if the column has a Bloom filter per row group.
+  std::unique_ptr<BloomFilterIndexBuilder> bloomFilterBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
 
@@ -282,6 +310,9 @@ class BaseColumnWriter : public ColumnWriter {
   // callback used to inject the logic that captures positions for flat map
   // in_map stream
   const std::function<void(IndexBuilder&)> onRecordPosition_;
+  // Used by decode() instead of the context's shared SelectivityVector when
+  // column writers run in parallel.
+  std::unique_ptr<SelectivityVector> selectivityVector_;
 
   VELOX_FRIEND_TEST(ColumnWriterTests, LowMemoryModeConfig);
   friend class ValueStatisticsBuilder;
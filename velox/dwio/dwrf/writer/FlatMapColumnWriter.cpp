@@ -97,6 +97,8 @@ void FlatMapColumnWriter<K>::flush(
 
   for (auto& pair : valueWriters_) {
     pair.second.flush(encodingFactory);
+    context_.recordFlatMapKeyRows(
+        type_.column, pair.second.getSequence(), pair.second.inMapRows());
   }
 
   if (collectMapStats_) {
@@ -122,6 +122,7 @@ class ValueWriter {
 
     ranges_.add(offset, offset + 1);
     inMapBuffer_[inMapIndex] = 1;
+    ++inMapRows_;
   }
 
   uint64_t writeBuffers(const VectorPtr& values, uint32_t mapCount) {
@@ -141,6 +142,7 @@ class ValueWriter {
       const VectorPtr& values,
       const common::Ranges& nonNullRanges,
       const BufferPtr& inMapBuffer /* all 1 */) {
+    inMapRows_ += nonNullRanges.size();
     if (nonNullRanges.size()) {
       inMap_->add(
           inMapBuffer->as<char>(),
@@ -172,6 +174,11 @@ class ValueWriter {
     return keyInfo_;
   }
 
+  // Number of rows of the stripe that have the key.
+  uint64_t inMapRows() const {
+    return inMapRows_;
+  }
+
   void createIndexEntry(
       const ValueStatisticsBuilder& valueStatsBuilder,
       MapStatisticsBuilder& mapStatsBuilder) {
@@ -206,6 +213,7 @@ class ValueWriter {
   std::unique_ptr<BaseColumnWriter> columnWriter_;
   dwio::common::DataBuffer<char> inMapBuffer_;
   common::Ranges ranges_;
+  uint64_t inMapRows_{0};
   const bool collectMapStats_;
 };
 
@@ -44,6 +44,58 @@ FlushDecision DefaultFlushPolicy::shouldFlushDictionary(
       context.getMemoryUsage(MemoryUsageCategory::DICTIONARY).currentBytes());
 }
 
+MemoryAwareFlushPolicy::MemoryAwareFlushPolicy(
+    uint64_t minStripeSize,
+    uint64_t maxStripeSize,
+    uint64_t dictionarySizeThreshold,
+    double memoryFraction)
+    : minStripeSize_{minStripeSize},
+      maxStripeSize_{maxStripeSize},
+      dictionarySizeThreshold_{dictionarySizeThreshold},
+      memoryFraction_{memoryFraction} {
+  VELOX_CHECK_LE(minStripeSize_, maxStripeSize_);
+  VELOX_CHECK(
+      memoryFraction_ > 0 && memoryFraction_ <= 1,
+      "Memory fraction must be in (0, 1]: {}",
+      memoryFraction_);
+}
+
+bool MemoryAwareFlushPolicy::shouldFlush(
+    const dwio::common::StripeProgress& stripeProgress) {
+  // Keeps the request for a stripe that has no rows yet.
+  if (stripeProgress.stripeRowCount > 0 && flushRequested_.exchange(false)) {
+    return true;
+  }
+  return stripeProgress.stripeSizeEstimate >= maxStripeSize_;
+}
+
+FlushDecision MemoryAwareFlushPolicy::shouldFlushDictionary(
+    bool /* stripeProgressDecision */,
+    bool /* overMemoryBudget */,
+    const WriterContext& context) {
+  if (context.getMemoryUsage(MemoryUsageCategory::DICTIONARY).currentBytes() >
+      dictionarySizeThreshold_) {
+    return FlushDecision::FLUSH_DICTIONARY;
+  }
+  if (context.getEstimatedStripeSize(context.stripeRawSize) < minStripeSize_) {
+    return FlushDecision::SKIP;
+  }
+  const int64_t usage = context.getTotalMemoryUsage();
+  const int64_t freeBytes = context.getFreeMemoryBytes();
+  if (freeBytes == memory::kMaxMemory) {
+    return FlushDecision::SKIP;
+  }
+  // The flush needs the buffered streams plus the flush overhead. What the
+  // writer has not reserved yet is what the arbitrator would otherwise be
+  // able to give to other queries.
+  const double flushBytes =
+      usage + context.getEstimatedFlushOverhead(context.stripeRawSize);
+  const double availableBytes = static_cast<double>(usage) + freeBytes;
+  return flushBytes > memoryFraction_ * availableBytes
+      ? FlushDecision::FLUSH_DICTIONARY
+      : FlushDecision::SKIP;
+}
+
 RowsPerStripeFlushPolicy::RowsPerStripeFlushPolicy(
     std::vector<uint64_t> rowsPerStripe)
     : rowsPerStripe_{std::move(rowsPerStripe)} {
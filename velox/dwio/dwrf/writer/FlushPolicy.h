@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint>
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/dwrf/writer/WriterContext.h"
@@ -74,6 +75,51 @@ class DefaultFlushPolicy : public DWRFFlushPolicy {
   const uint64_t dictionarySizeThreshold_;
 };
 
+// Sizes stripes by the memory the writer can grow into instead of fixed
+// thresholds. A stripe grows up to 'maxStripeSize' estimated on-disk bytes,
+// i.e. raw bytes scaled by the observed compression ratio, as long as the
+// memory to buffer and flush it stays within 'memoryFraction' of the writer
+// usage plus the free capacity of its root pool. Under memory pressure the
+// stripe is flushed once it reaches 'minStripeSize'. requestFlush() forces
+// the next check to flush, e.g. from a memory reclaimer that can't flush the
+// writer itself.
+class MemoryAwareFlushPolicy : public DWRFFlushPolicy {
+ public:
+  MemoryAwareFlushPolicy(
+      uint64_t minStripeSize,
+      uint64_t maxStripeSize,
+      uint64_t dictionarySizeThreshold,
+      double memoryFraction = 0.5);
+  virtual ~MemoryAwareFlushPolicy() override = default;
+
+  bool shouldFlush(const dwio::common::StripeProgress& stripeProgress) override;
+
+  // Returns FLUSH_DICTIONARY, which makes the writer flush the stripe, if the
+  // dictionaries are over their threshold or the stripe can't grow within
+  // the memory available to the writer.
+  FlushDecision shouldFlushDictionary(
+      bool stripeProgressDecision,
+      bool overMemoryBudget,
+      const WriterContext& context) override;
+
+  void onClose() override {
+    // No-op
+  }
+
+  // Makes the next flush check flush the current stripe if it has any rows.
+  // Thread-safe.
+  void requestFlush() {
+    flushRequested_ = true;
+  }
+
+ private:
+  const uint64_t minStripeSize_;
+  const uint64_t maxStripeSize_;
+  const uint64_t dictionarySizeThreshold_;
+  const double memoryFraction_;
+  std::atomic_bool flushRequested_{false};
+};
+
 class RowsPerStripeFlushPolicy : public DWRFFlushPolicy {
  public:
   explicit RowsPerStripeFlushPolicy(std::vector<uint64_t> rowsPerStripe);
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/dwio/dwrf/common/BloomFilter.h"
 #include "velox/dwio/dwrf/common/OutputStream.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
@@ -101,4 +102,43 @@ class IndexBuilder : public PositionRecorder {
   }
 };
 
+// Builds the BLOOM_FILTER_UTF8 stream of a column: one Bloom filter per row
+// group, sized by the number of non-null values of the row group.
+class BloomFilterIndexBuilder {
+ public:
+  explicit BloomFilterIndexBuilder(std::unique_ptr<BufferedOutputStream> out)
+      : out_{std::move(out)} {}
+
+  void add(uint64_t hash) {
+    hashes_.push_back(hash);
+  }
+
+  // Closes the Bloom filter of the current row group.
+  void addEntry() {
+    BloomFilter<> bloomFilter;
+    bloomFilter.reset(
+        std::max<int32_t>(1, hashes_.size()), BloomFilter<>::kBloomFilterV2);
+    for (auto hash : hashes_) {
+      bloomFilter.insert(hash);
+    }
+    hashes_.clear();
+    std::string serialized(bloomFilter.serializedSize(), '\0');
+    bloomFilter.serialize(serialized.data());
+    auto entry = index_.add_bloomfilter();
+    entry->set_numhashfunctions(kBloomFilterNumHashFunctions);
+    entry->set_utf8bitset(std::move(serialized));
+  }
+
+  void flush() {
+    index_.SerializeToZeroCopyStream(out_.get());
+    out_->flush();
+    index_.Clear();
+  }
+
+ private:
+  std::unique_ptr<BufferedOutputStream> out_;
+  proto::BloomFilterIndex index_;
+  std::vector<uint64_t> hashes_;
+};
+
 } // namespace facebook::velox::dwrf
@@ -239,7 +239,8 @@ LayoutPlanner::LayoutPlanner(const dwio::common::TypeWithId& schema) {
 
 LayoutResult LayoutPlanner::plan(
     const EncodingContainer& encoding,
-    StreamList streams) const {
+    StreamList streams,
+    const FlatMapKeyRows* keyRows) const {
   // place index before data
   auto iter = std::partition(streams.begin(), streams.end(), [](auto& stream) {
     return isIndexStream(stream.first->kind());
@@ -248,8 +249,8 @@ LayoutResult LayoutPlanner::plan(
   auto flatMapCols = getFlatMapColumns(encoding, nodeToColumnMap_);
 
   // sort streams
-  sortBySize(streams.begin(), iter, flatMapCols);
-  sortBySize(iter, streams.end(), flatMapCols);
+  sortBySize(streams.begin(), iter, flatMapCols, keyRows);
+  sortBySize(iter, streams.end(), flatMapCols, keyRows);
 
   return LayoutResult{std::move(streams), indexCount};
 }
@@ -257,7 +258,17 @@ LayoutResult LayoutPlanner::plan(
 void LayoutPlanner::sortBySize(
     StreamList::iterator begin,
     StreamList::iterator end,
-    const folly::F14FastSet<uint32_t>& flatMapCols) {
+    const folly::F14FastSet<uint32_t>& flatMapCols,
+    const FlatMapKeyRows* keyRows) {
+  auto rowsWithKey = [&](uint32_t column, uint32_t sequence) -> uint64_t {
+    auto it = keyRows->find(column);
+    if (it == keyRows->end()) {
+      return 0;
+    }
+    auto rows = it->second.find(sequence);
+    return rows == it->second.end() ? 0 : rows->second;
+  };
+
   // calculate node size
   folly::F14FastMap<uint32_t, uint64_t> nodeSize;
   folly::F14FastMap<MapKey, uint64_t, MapKeyHash, MapKeyEqual> flatMapNodeSize;
@@ -316,6 +327,15 @@ void LayoutPlanner::sortBySize(
         if (seqB == 0) {
           return false;
         }
+        // Keys present in more rows first, so that the frequently read keys
+        // are contiguous and their reads can be coalesced.
+        if (keyRows) {
+          auto rowsA = rowsWithKey(colA, seqA);
+          auto rowsB = rowsWithKey(colB, seqB);
+          if (rowsA != rowsB) {
+            return rowsA > rowsB;
+          }
+        }
       }
 
       sizeA = flatMapNodeSize[{
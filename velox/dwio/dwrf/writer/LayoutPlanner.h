@@ -131,15 +131,20 @@ class LayoutPlanner {
   explicit LayoutPlanner(const dwio::common::TypeWithId& schema);
   virtual ~LayoutPlanner() = default;
 
+  // Places the index streams before the data streams. If 'keyRows' is set,
+  // the keys of a flat map are placed by descending number of rows that have
+  // them and then by size.
   virtual LayoutResult plan(
       const EncodingContainer& encoding,
-      StreamList streamList) const;
+      StreamList streamList,
+      const FlatMapKeyRows* keyRows = nullptr) const;
 
  protected:
   static void sortBySize(
       StreamList::iterator begin,
       StreamList::iterator end,
-      const folly::F14FastSet<uint32_t>& flatMapCols);
+      const folly::F14FastSet<uint32_t>& flatMapCols,
+      const FlatMapKeyRows* keyRows);
 
   // This method assumes flatmap can only be top level fields, which is enforced
   // through the way how flatmap is configured.
@@ -278,7 +278,8 @@ void Writer::flushStripe(bool close) {
   // deals with streams
   uint64_t indexLength = 0;
   sink.setMode(WriterSink::Mode::Index);
-  auto result = layoutPlanner_->plan(encodingManager, getStreamList(context));
+  auto result = layoutPlanner_->plan(
+      encodingManager, getStreamList(context), &context.flatMapKeyRows());
   result.iterateIndexStreams([&](auto& streamId, auto& content) {
     DWIO_ENSURE(
         isIndexStream(streamId.kind()),
@@ -46,6 +46,12 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  // If set, top level columns are split into at most 'encodingColumnGroups'
+  // groups of adjacent columns that are encoded, flushed and compressed in
+  // parallel on this executor. The file is the same as when writing serially.
+  // Not used for encrypted files.
+  folly::Executor* encodingExecutor{nullptr};
+  int32_t encodingColumnGroups{8};
 };
 
 class Writer : public dwio::common::Writer {
@@ -77,6 +83,11 @@ class Writer : public dwio::common::Writer {
         options.config, std::move(pool), std::move(handler));
     auto& context = writerBase_->getContext();
     context.buildPhysicalSizeAggregators(*schema_);
+    if (options.encodingExecutor &&
+        !context.getEncryptionHandler().isEncrypted()) {
+      context.setEncodingExecutor(
+          options.encodingExecutor, options.encodingColumnGroups);
+    }
     if (!options.flushPolicyFactory) {
       flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
           context.stripeSizeFlushThreshold,
@@ -17,6 +17,9 @@
 #pragma once
 
 #include <limits>
+#include <mutex>
+
+#include <folly/Executor.h>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -32,6 +35,11 @@ namespace facebook::velox::dwrf {
 
 enum class MemoryUsageCategory { DICTIONARY, OUTPUT_STREAM, GENERAL };
 
+// Number of rows of a stripe that have the key of each flat map value
+// sequence, by column and sequence.
+using FlatMapKeyRows =
+    folly::F14FastMap<uint32_t, folly::F14FastMap<uint32_t, uint64_t>>;
+
 class WriterContext : public CompressionBufferPool {
  public:
   WriterContext(
@@ -72,8 +80,7 @@ class WriterContext : public CompressionBufferPool {
     }
     validateConfigs();
     VLOG(1) << fmt::format("Compression config: {}", compression);
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        *generalPool_, compressionBlockSize + PAGE_HEADER_SIZE);
+    compressionBuffers_.push_back(newCompressionBuffer());
   }
 
   bool hasStream(const DwrfStreamIdentifier& stream) const {
@@ -100,22 +107,8 @@ class WriterContext : public CompressionBufferPool {
   // flush policy evaluation and would be more accurate after flush.
   std::unique_ptr<BufferedOutputStream> newStream(
       const DwrfStreamIdentifier& stream) {
-    DWIO_ENSURE(
-        !hasStream(stream), "Stream already exists ", stream.toString());
-    streams_.emplace(
-        std::piecewise_construct,
-        std::forward_as_tuple(stream),
-        std::forward_as_tuple(
-            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
-            compressionBlockSize,
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
-            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
-    auto& holder = streams_.at(stream);
-    auto encrypter = handler_->isEncrypted(stream.encodingKey().node)
-        ? std::addressof(
-              handler_->getEncryptionProvider(stream.encodingKey().node))
-        : nullptr;
-    return newStream(compression, holder, encrypter);
+    std::lock_guard<std::mutex> l(mutex_);
+    return newStreamLocked(stream);
   }
 
   std::unique_ptr<DataBufferHolder> newDataBufferHolder(
@@ -140,6 +133,7 @@ class WriterContext : public CompressionBufferPool {
       const EncodingKey& ek,
       velox::memory::MemoryPool& dictionaryPool,
       velox::memory::MemoryPool& generalPool) {
+    std::lock_guard<std::mutex> l(mutex_);
     auto result = dictEncoders_.find(ek);
     if (result == dictEncoders_.end()) {
       auto emplaceResult = dictEncoders_.emplace(
@@ -149,7 +143,7 @@ class WriterContext : public CompressionBufferPool {
               generalPool,
               getConfig(Config::DICTIONARY_SORT_KEYS),
               createDirectEncoder</* isSigned */ true>(
-                  newStream(
+                  newStreamLocked(
                       {ek.node,
                        ek.sequence,
                        0,
@@ -171,6 +165,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void suppressStream(const DwrfStreamIdentifier& stream) {
+    std::lock_guard<std::mutex> l(mutex_);
     DWIO_ENSURE(hasStream(stream));
     auto& collector = streams_.at(stream);
     collector.suppress();
@@ -190,12 +185,27 @@ class WriterContext : public CompressionBufferPool {
     fileRawSize += stripeRawSize;
     stripeRawSize = 0;
     stripeIndex += 1;
+    flatMapKeyRows_.clear();
 
     for (auto& pair : streams_) {
       pair.second.reset();
     }
   }
 
+  // Records that the key written with 'sequence' in flat map 'column' is
+  // present in 'rows' rows of the current stripe.
+  void recordFlatMapKeyRows(
+      uint32_t column,
+      uint32_t sequence,
+      uint64_t rows) {
+    std::lock_guard<std::mutex> l(mutex_);
+    flatMapKeyRows_[column][sequence] = rows;
+  }
+
+  const FlatMapKeyRows& flatMapKeyRows() const {
+    return flatMapKeyRows_;
+  }
+
   void incRowCount(uint64_t count) {
     stripeRowCount += count;
     if (isIndexEnabled) {
@@ -247,6 +257,16 @@ class WriterContext : public CompressionBufferPool {
     return pool_->capacity();
   }
 
+  // Returns the capacity of the root memory pool that is not reserved yet,
+  // i.e. what the writer can still grow into before the memory arbitrator
+  // has to reclaim. Unbounded root pools report kMaxMemory.
+  int64_t getFreeMemoryBytes() const {
+    if (pool_->root()->capacity() == memory::kMaxMemory) {
+      return memory::kMaxMemory;
+    }
+    return pool_->freeBytes();
+  }
+
   const encryption::EncryptionHandler& getEncryptionHandler() const {
     return *handler_;
   }
@@ -275,6 +295,7 @@ class WriterContext : public CompressionBufferPool {
   // cleans up its value writer streams upon reset().
   void removeAllIntDictionaryEncodersOnNode(
       std::function<bool(uint32_t)> predicate) {
+    std::lock_guard<std::mutex> l(mutex_);
     auto iter = dictEncoders_.begin();
     while (iter != dictEncoders_.end()) {
       if (predicate(iter->first.node)) {
@@ -287,6 +308,7 @@ class WriterContext : public CompressionBufferPool {
 
   virtual void removeStreams(
       std::function<bool(const DwrfStreamIdentifier&)> predicate) {
+    std::lock_guard<std::mutex> l(mutex_);
     auto it = streams_.begin();
     while (it != streams_.end()) {
       if (predicate(it->first)) {
@@ -297,18 +319,47 @@ class WriterContext : public CompressionBufferPool {
     }
   }
 
+  // Column writers running in parallel compress concurrently, so a new
+  // buffer is allocated when all buffers are in use.
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    DWIO_ENSURE_NOT_NULL(compressionBuffer_);
-    DWIO_ENSURE_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
+    std::unique_ptr<dwio::common::DataBuffer<char>> buffer;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (!compressionBuffers_.empty()) {
+        buffer = std::move(compressionBuffers_.back());
+        compressionBuffers_.pop_back();
+      }
+    }
+    if (!buffer) {
+      buffer = newCompressionBuffer();
+    }
+    DWIO_ENSURE_GE(buffer->size(), size);
+    return buffer;
   }
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     DWIO_ENSURE_NOT_NULL(buffer);
-    DWIO_ENSURE(!compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(mutex_);
+    compressionBuffers_.push_back(std::move(buffer));
+  }
+
+  /// Makes column writers of top level columns run on 'executor', split into
+  /// at most 'numGroups' groups of adjacent columns. The output is the same as
+  /// when writing serially.
+  void setEncodingExecutor(folly::Executor* executor, int32_t numGroups) {
+    DWIO_ENSURE_GT(numGroups, 0);
+    encodingExecutor_ = executor;
+    numEncodingGroups_ = numGroups;
+  }
+
+  folly::Executor* FOLLY_NULLABLE encodingExecutor() const {
+    return encodingExecutor_;
+  }
+
+  int32_t numEncodingGroups() const {
+    return numEncodingGroups_;
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -495,7 +546,34 @@ class WriterContext : public CompressionBufferPool {
  private:
   void validateConfigs() const;
 
+  std::unique_ptr<dwio::common::DataBuffer<char>> newCompressionBuffer() {
+    return std::make_unique<dwio::common::DataBuffer<char>>(
+        *generalPool_, compressionBlockSize + PAGE_HEADER_SIZE);
+  }
+
+  // Adds a stream. Requires 'mutex_' to be held.
+  std::unique_ptr<BufferedOutputStream> newStreamLocked(
+      const DwrfStreamIdentifier& stream) {
+    DWIO_ENSURE(
+        !hasStream(stream), "Stream already exists ", stream.toString());
+    streams_.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(stream),
+        std::forward_as_tuple(
+            getMemoryPool(MemoryUsageCategory::OUTPUT_STREAM),
+            compressionBlockSize,
+            getConfig(Config::COMPRESSION_BLOCK_SIZE_MIN),
+            getConfig(Config::COMPRESSION_BLOCK_SIZE_EXTEND_RATIO)));
+    auto& holder = streams_.at(stream);
+    auto encrypter = handler_->isEncrypted(stream.encodingKey().node)
+        ? std::addressof(
+              handler_->getEncryptionProvider(stream.encodingKey().node))
+        : nullptr;
+    return newStream(compression, holder, encrypter);
+  }
+
   std::unique_ptr<velox::DecodedVector> getDecodedVector() {
+    std::lock_guard<std::mutex> l(mutex_);
     if (decodedVectorPool_.empty()) {
       return std::make_unique<velox::DecodedVector>();
     }
@@ -505,6 +583,7 @@ class WriterContext : public CompressionBufferPool {
   }
 
   void releaseDecodedVector(std::unique_ptr<velox::DecodedVector>&& vector) {
+    std::lock_guard<std::mutex> l(mutex_);
     decodedVectorPool_.push_back(std::move(vector));
   }
 
@@ -527,15 +606,24 @@ class WriterContext : public CompressionBufferPool {
       std::unique_ptr<AbstractIntegerDictionaryEncoder>,
       EncodingKeyHash>
       dictEncoders_;
+  FlatMapKeyRows flatMapKeyRows_;
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Guards 'streams_', 'dictEncoders_', 'compressionBuffers_',
+  // 'decodedVectorPool_' and 'flatMapKeyRows_', which column writers running
+  // on 'encodingExecutor_' access concurrently.
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
   std::unique_ptr<velox::SelectivityVector> selectivityVector_;
 
+  folly::Executor* encodingExecutor_{nullptr};
+  int32_t numEncodingGroups_{1};
+
   std::unique_ptr<encryption::EncryptionHandler> handler_;
   folly::F14FastMap<uint32_t, uint64_t> nodeSize;
   CompressionRatioTracker compressionRatioTracker_;
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Salts of the split block Bloom filter from the Parquet specification.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Upper bound of the size of a serialized BloomFilterHeader.
+constexpr uint64_t kMaxHeaderSize = 64;
+
+// Writers must produce bitsets between 32 bytes and 128MB.
+constexpr int32_t kMaxBitsetSize = 128 << 20;
+
+void readFully(
+    dwio::common::SeekableInputStream& stream,
+    char* output,
+    int32_t size) {
+  const void* buffer;
+  int32_t bufferSize;
+  while (size > 0) {
+    VELOX_CHECK(
+        stream.Next(&buffer, &bufferSize), "Truncated Parquet Bloom filter");
+    auto toCopy = std::min(size, bufferSize);
+    memcpy(output, buffer, toCopy);
+    output += toCopy;
+    size -= toCopy;
+  }
+}
+} // namespace
+
+// static
+std::unique_ptr<BloomFilter> BloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  auto fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter offset past end of file");
+  std::string headerBytes(std::min(kMaxHeaderSize, fileSize - offset), '\0');
+  auto stream = input.read(
+      offset, headerBytes.size(), dwio::common::LogType::BLOOM_FILTER);
+  readFully(*stream, headerBytes.data(), headerBytes.size());
+
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBytes.data(), headerBytes.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  auto headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  VELOX_CHECK(
+      header.numBytes >= kBytesPerBlock && header.numBytes <= kMaxBitsetSize &&
+          header.numBytes % kBytesPerBlock == 0,
+      "Invalid Parquet Bloom filter size {}",
+      header.numBytes);
+  std::string bitset(header.numBytes, '\0');
+  stream = input.read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::BLOOM_FILTER);
+  readFully(*stream, bitset.data(), bitset.size());
+  return std::make_unique<BloomFilter>(std::move(bitset));
+}
+
+BloomFilter::BloomFilter(std::string bitset)
+    : bitset_(std::move(bitset)), numBlocks_(bitset_.size() / kBytesPerBlock) {}
+
+bool BloomFilter::mayContain(uint64_t hash) const {
+  auto block = ((hash >> 32) * numBlocks_) >> 32;
+  auto key = static_cast<uint32_t>(hash);
+  auto words = reinterpret_cast<const uint32_t*>(
+      bitset_.data() + block * kBytesPerBlock);
+  for (auto i = 0; i < 8; ++i) {
+    auto mask = 1U << ((key * kSalt[i]) >> 27);
+    if (!(words[i] & mask)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+uint64_t BloomFilter::hashInt32(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hashInt64(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hashBytes(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+namespace {
+bool mayContainInt(
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    int64_t value) {
+  if (physicalType == thrift::Type::INT64) {
+    return bloomFilter.mayContain(BloomFilter::hashInt64(value));
+  }
+  if (value < std::numeric_limits<int32_t>::min() ||
+      value > std::numeric_limits<int32_t>::max()) {
+    return false;
+  }
+  return bloomFilter.mayContain(BloomFilter::hashInt32(value));
+}
+
+template <typename Values>
+bool mayContainAnyInt(
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType,
+    const Values& values) {
+  for (auto value : values) {
+    if (mayContainInt(bloomFilter, physicalType, value)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool isBloomFilterApplicable(
+    const common::Filter& filter,
+    thrift::Type::type physicalType) {
+  if (filter.testNull()) {
+    // Nulls are not in the Bloom filter.
+    return false;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+      return (physicalType == thrift::Type::INT32 ||
+              physicalType == thrift::Type::INT64) &&
+          static_cast<const common::BigintRange&>(filter).isSingleValue();
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      return physicalType == thrift::Type::INT32 ||
+          physicalType == thrift::Type::INT64;
+    case common::FilterKind::kBytesRange:
+      return physicalType == thrift::Type::BYTE_ARRAY &&
+          static_cast<const common::BytesRange&>(filter).isSingleValue();
+    case common::FilterKind::kBytesValues:
+      return physicalType == thrift::Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+
+bool testFilterOnBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType) {
+  if (!isBloomFilterApplicable(filter, physicalType)) {
+    return true;
+  }
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return mayContainInt(bloomFilter, physicalType, range.lower());
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter);
+      return mayContainAnyInt(bloomFilter, physicalType, values.values());
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      auto& values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter);
+      return mayContainAnyInt(bloomFilter, physicalType, values.values());
+    }
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      return bloomFilter.mayContain(BloomFilter::hashBytes(range.lower()));
+    }
+    case common::FilterKind::kBytesValues: {
+      auto& values = static_cast<const common::BytesValues&>(filter);
+      for (auto& value : values.values()) {
+        if (bloomFilter.mayContain(BloomFilter::hashBytes(value))) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter of a Parquet column chunk. The bitset consists of
+/// 256 bit blocks. The upper 32 bits of the XXH64 hash of the PLAIN encoded
+/// value select the block and the lower 32 bits select one bit in each of the
+/// 8 words of the block.
+class BloomFilter {
+ public:
+  /// Reads the Bloom filter at file offset 'offset' from 'input'. Returns
+  /// nullptr if the filter uses an algorithm, hash or compression this reader
+  /// does not know.
+  static std::unique_ptr<BloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  explicit BloomFilter(std::string bitset);
+
+  /// Returns false if no value with 'hash' was added to the filter.
+  bool mayContain(uint64_t hash) const;
+
+  /// Return the hash of the PLAIN encoding of 'value' for INT32, INT64 and
+  /// BYTE_ARRAY columns.
+  static uint64_t hashInt32(int32_t value);
+  static uint64_t hashInt64(int64_t value);
+  static uint64_t hashBytes(std::string_view value);
+
+ private:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  const std::string bitset_;
+  const uint32_t numBlocks_;
+};
+
+/// Returns false if no row of a column chunk with 'bloomFilter' can pass
+/// 'filter'. Tests the values of equality and IN filters on columns of
+/// 'physicalType'. Other filters and types can always pass.
+bool testFilterOnBloomFilter(
+    const common::Filter& filter,
+    const BloomFilter& bloomFilter,
+    thrift::Type::type physicalType);
+
+/// True if testFilterOnBloomFilter() can rule out column chunks for 'filter'
+/// on a column of 'physicalType'.
+bool isBloomFilterApplicable(
+    const common::Filter& filter,
+    thrift::Type::type physicalType);
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/common/encode/Coding.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the Parquet DELTA_BINARY_PACKED encoding. The encoded run
+/// consists of a header with the block size, the number of miniblocks per
+/// block, the total value count and the first value, followed by blocks of
+/// bit packed deltas. Each block starts with the zigzag encoded minimum delta
+/// and one bit width byte per miniblock. Arithmetic is done in 64 bit
+/// unsigned integers so that overflowing deltas wrap the way the writer
+/// expects for both INT32 and INT64 columns.
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(const char* FOLLY_NONNULL start, const char* FOLLY_NONNULL end)
+      : bufferStart_(reinterpret_cast<const uint8_t*>(start)),
+        bufferEnd_(reinterpret_cast<const uint8_t*>(end)) {
+    blockSize_ = readVuLong();
+    numMiniblocks_ = readVuLong();
+    totalValues_ = readVuLong();
+    lastValue_ = static_cast<uint64_t>(ZigZag::decode(readVuLong()));
+    VELOX_CHECK_GT(numMiniblocks_, 0, "Invalid DELTA_BINARY_PACKED header");
+    VELOX_CHECK_EQ(
+        blockSize_ % 128, 0, "DELTA_BINARY_PACKED block size must be 128*n");
+    valuesPerMiniblock_ = blockSize_ / numMiniblocks_;
+    VELOX_CHECK_EQ(
+        valuesPerMiniblock_ % 32,
+        0,
+        "DELTA_BINARY_PACKED miniblock size must be 32*n");
+    deltas_.resize(valuesPerMiniblock_);
+    unpacked_.resize(valuesPerMiniblock_);
+    // Force reading a block header before the first miniblock.
+    currentMiniblock_ = numMiniblocks_;
+    positionInMiniblock_ = valuesPerMiniblock_;
+  }
+
+  /// Number of values in the encoded run.
+  int64_t numValues() const {
+    return totalValues_;
+  }
+
+  /// Number of values not yet returned by next().
+  int64_t numRemaining() const {
+    return totalValues_ - numRead_;
+  }
+
+  /// Decodes the next 'count' values into 'result'. T is the physical type of
+  /// the column, i.e. int32_t or int64_t.
+  template <typename T>
+  void next(T* FOLLY_NONNULL result, int64_t count) {
+    VELOX_CHECK_LE(count, numRemaining(), "Reading past end of delta run");
+    int64_t i = 0;
+    if (count > 0 && numRead_ == 0) {
+      result[i++] = static_cast<T>(lastValue_);
+      ++numRead_;
+    }
+    while (i < count) {
+      if (positionInMiniblock_ == valuesPerMiniblock_) {
+        readMiniblock();
+      }
+      auto numInMiniblock = std::min<int64_t>(
+          count - i, valuesPerMiniblock_ - positionInMiniblock_);
+      auto deltas = deltas_.data() + positionInMiniblock_;
+      auto value = lastValue_;
+      for (auto j = 0; j < numInMiniblock; ++j) {
+        value += minDelta_ + deltas[j];
+        result[i + j] = static_cast<T>(value);
+      }
+      lastValue_ = value;
+      i += numInMiniblock;
+      positionInMiniblock_ += numInMiniblock;
+      numRead_ += numInMiniblock;
+    }
+  }
+
+  /// Skips all remaining values and returns the first byte after the encoded
+  /// run. Used for encodings that append data after a delta encoded run.
+  const char* FOLLY_NONNULL skipToEnd() {
+    // The first value is in the header and does not occupy a miniblock.
+    auto numDeltas = numRemaining() - (numRead_ == 0 ? 1 : 0);
+    if (numDeltas < 0) {
+      return reinterpret_cast<const char*>(bufferStart_);
+    }
+    auto inMiniblock = valuesPerMiniblock_ - positionInMiniblock_;
+    numDeltas -= std::min<int64_t>(inMiniblock, numDeltas);
+    while (numDeltas > 0) {
+      if (currentMiniblock_ == numMiniblocks_) {
+        readBlockHeader();
+      }
+      auto bitWidth = bitWidths_[currentMiniblock_++];
+      bufferStart_ = std::min(
+          bufferEnd_, bufferStart_ + miniblockBytes(bitWidth));
+      numDeltas -= std::min<int64_t>(valuesPerMiniblock_, numDeltas);
+    }
+    numRead_ = totalValues_;
+    positionInMiniblock_ = valuesPerMiniblock_;
+    return reinterpret_cast<const char*>(bufferStart_);
+  }
+
+ private:
+  uint64_t readVuLong() {
+    uint64_t result = 0;
+    int32_t shift = 0;
+    for (;;) {
+      VELOX_CHECK_LT(
+          bufferStart_, bufferEnd_, "Truncated DELTA_BINARY_PACKED data");
+      auto byte = *bufferStart_++;
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return result;
+      }
+      shift += 7;
+      VELOX_CHECK_LT(shift, 64, "Invalid varint in DELTA_BINARY_PACKED");
+    }
+  }
+
+  void readBlockHeader() {
+    minDelta_ = static_cast<uint64_t>(ZigZag::decode(readVuLong()));
+    VELOX_CHECK_LE(
+        bufferStart_ + numMiniblocks_,
+        bufferEnd_,
+        "Truncated DELTA_BINARY_PACKED block header");
+    bitWidths_ = bufferStart_;
+    bufferStart_ += numMiniblocks_;
+    currentMiniblock_ = 0;
+  }
+
+  int64_t miniblockBytes(uint8_t bitWidth) const {
+    return valuesPerMiniblock_ * bitWidth / 8;
+  }
+
+  // Unpacks the next miniblock into 'deltas_'.
+  void readMiniblock() {
+    if (currentMiniblock_ == numMiniblocks_) {
+      readBlockHeader();
+    }
+    auto bitWidth = bitWidths_[currentMiniblock_++];
+    VELOX_CHECK_LE(bitWidth, 64, "Invalid DELTA_BINARY_PACKED bit width");
+    positionInMiniblock_ = 0;
+    if (bitWidth == 0) {
+      std::fill(deltas_.begin(), deltas_.end(), 0);
+      return;
+    }
+    auto numBytes = miniblockBytes(bitWidth);
+    auto available = bufferEnd_ - bufferStart_;
+    if (bitWidth <= 32 && available >= numBytes) {
+      auto input = bufferStart_;
+      auto output = unpacked_.data();
+      dwio::common::unpack<uint32_t>(
+          input, numBytes, valuesPerMiniblock_, bitWidth, output);
+      for (auto i = 0; i < valuesPerMiniblock_; ++i) {
+        deltas_[i] = unpacked_[i];
+      }
+    } else {
+      // Wide deltas or a last miniblock that the writer did not pad.
+      auto numValues = std::min<int64_t>(
+          valuesPerMiniblock_, available * 8 / bitWidth);
+      uint64_t bitOffset = 0;
+      for (auto i = 0; i < numValues; ++i) {
+        deltas_[i] = readPacked(bitOffset, bitWidth);
+        bitOffset += bitWidth;
+      }
+    }
+    bufferStart_ += std::min<int64_t>(numBytes, available);
+  }
+
+  uint64_t readPacked(uint64_t bitOffset, uint8_t bitWidth) const {
+    uint64_t result = 0;
+    int32_t numBits = 0;
+    while (numBits < bitWidth) {
+      auto byte = bufferStart_[bitOffset / 8];
+      auto bit = bitOffset & 7;
+      int32_t take = std::min<int32_t>(8 - bit, bitWidth - numBits);
+      result |= static_cast<uint64_t>((byte >> bit) & ((1U << take) - 1))
+          << numBits;
+      numBits += take;
+      bitOffset += take;
+    }
+    return result;
+  }
+
+  const uint8_t* FOLLY_NONNULL bufferStart_;
+  const uint8_t* FOLLY_NONNULL const bufferEnd_;
+
+  uint64_t blockSize_;
+  uint64_t numMiniblocks_;
+  int64_t totalValues_;
+  int64_t valuesPerMiniblock_;
+
+  // Number of values returned so far, including the first value.
+  int64_t numRead_{0};
+
+  // The last value returned. The next value is 'lastValue_' + 'minDelta_' +
+  // the next unpacked delta.
+  uint64_t lastValue_;
+  uint64_t minDelta_{0};
+
+  // Bit widths of the miniblocks of the current block.
+  const uint8_t* FOLLY_NULLABLE bitWidths_{nullptr};
+  uint64_t currentMiniblock_;
+  int64_t positionInMiniblock_;
+
+  // Unpacked deltas of the current miniblock.
+  raw_vector<uint64_t> deltas_;
+
+  // Scratch for unpacking deltas of up to 32 bits.
+  raw_vector<uint32_t> unpacked_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/Nulls.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY encodings of
+/// Parquet BYTE_ARRAY columns. DELTA_LENGTH_BYTE_ARRAY is a
+/// DELTA_BINARY_PACKED run of lengths followed by the concatenated string
+/// bytes. DELTA_BYTE_ARRAY prepends a DELTA_BINARY_PACKED run of lengths of
+/// the prefix shared with the previous value, and the suffixes follow as
+/// DELTA_LENGTH_BYTE_ARRAY. The lengths are decoded for the whole page when
+/// the decoder is made. DELTA_LENGTH_BYTE_ARRAY values are returned in place,
+/// DELTA_BYTE_ARRAY values are reassembled into 'buffer_' since a value
+/// depends on all values before it.
+class DeltaByteArrayDecoder {
+ public:
+  DeltaByteArrayDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end,
+      bool hasPrefixes) {
+    if (hasPrefixes) {
+      DeltaBpDecoder prefixDecoder(start, end);
+      prefixLengths_.resize(prefixDecoder.numValues());
+      prefixDecoder.next(prefixLengths_.data(), prefixLengths_.size());
+      start = prefixDecoder.skipToEnd();
+    }
+    DeltaBpDecoder lengthDecoder(start, end);
+    lengths_.resize(lengthDecoder.numValues());
+    lengthDecoder.next(lengths_.data(), lengths_.size());
+    data_ = lengthDecoder.skipToEnd();
+    if (hasPrefixes) {
+      VELOX_CHECK_EQ(
+          prefixLengths_.size(),
+          lengths_.size(),
+          "DELTA_BYTE_ARRAY prefix and suffix counts differ");
+      assemblePrefixes(end);
+    } else {
+      int64_t totalLength = 0;
+      for (auto length : lengths_) {
+        VELOX_CHECK_GE(length, 0, "Negative DELTA_LENGTH_BYTE_ARRAY length");
+        totalLength += length;
+      }
+      VELOX_CHECK_LE(
+          totalLength, end - data_, "Truncated DELTA_LENGTH_BYTE_ARRAY data");
+    }
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      data_ += lengths_[index_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+ private:
+  // Reconstructs the full values from prefixes of the previous value and
+  // suffixes. Replaces 'lengths_' with the full lengths and points 'data_' to
+  // the concatenated values.
+  void assemblePrefixes(const char* FOLLY_NONNULL end) {
+    int64_t totalLength = 0;
+    int64_t suffixBytes = 0;
+    for (auto i = 0; i < lengths_.size(); ++i) {
+      VELOX_CHECK_GE(lengths_[i], 0, "Negative DELTA_BYTE_ARRAY suffix length");
+      VELOX_CHECK(
+          prefixLengths_[i] >= 0 &&
+              (i == 0 ? prefixLengths_[i] == 0
+                      : prefixLengths_[i] <=
+                       prefixLengths_[i - 1] + lengths_[i - 1]),
+          "Invalid DELTA_BYTE_ARRAY prefix length");
+      suffixBytes += lengths_[i];
+      totalLength += prefixLengths_[i] + lengths_[i];
+    }
+    VELOX_CHECK_LE(
+        suffixBytes, end - data_, "Truncated DELTA_BYTE_ARRAY data");
+    buffer_.resize(totalLength);
+    auto suffix = data_;
+    char* previous = nullptr;
+    char* target = buffer_.data();
+    for (auto i = 0; i < lengths_.size(); ++i) {
+      auto prefixLength = prefixLengths_[i];
+      if (prefixLength) {
+        memcpy(target, previous, prefixLength);
+      }
+      memcpy(target + prefixLength, suffix, lengths_[i]);
+      suffix += lengths_[i];
+      previous = target;
+      lengths_[i] += prefixLength;
+      target += lengths_[i];
+    }
+    data_ = buffer_.data();
+  }
+
+  folly::StringPiece readString() {
+    auto length = lengths_[index_++];
+    data_ += length;
+    return folly::StringPiece(data_ - length, length);
+  }
+
+  // Lengths of the values of the page. Full lengths after prefixes are
+  // applied.
+  raw_vector<int32_t> lengths_;
+  raw_vector<int32_t> prefixLengths_;
+
+  // Index in 'lengths_' of the next value.
+  int32_t index_{0};
+
+  // Start of the next value.
+  const char* FOLLY_NONNULL data_;
+
+  // Reassembled values for DELTA_BYTE_ARRAY.
+  raw_vector<char> buffer_;
+};
+
+} // namespace facebook::velox::parquet
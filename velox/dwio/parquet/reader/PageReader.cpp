@@ -15,16 +15,14 @@
  */
 
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
 
-#include <snappy.h>
 #include <thrift/protocol/TCompactProtocol.h> //@manual
-#include <zlib.h>
-#include <zstd.h>
 
 namespace facebook::velox::parquet {
 
@@ -44,6 +42,9 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
+    if (row != kRepDefOnly && !pageLocations_.empty()) {
+      seekWithPageIndex(row);
+    }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
@@ -75,6 +76,47 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::setPageIndex(
+    std::vector<thrift::PageLocation> pageLocations,
+    uint64_t chunkStart,
+    std::vector<uint64_t> prunedPages) {
+  VELOX_CHECK(isTopLevel_, "Page index is only used for top level columns");
+  pageLocations_ = std::move(pageLocations);
+  chunkStart_ = chunkStart;
+  prunedPages_ = std::move(prunedPages);
+}
+
+int32_t PageReader::pageIndexOfRow(int64_t row) const {
+  auto it = std::upper_bound(
+      pageLocations_.begin(),
+      pageLocations_.end(),
+      row,
+      [](int64_t row, const thrift::PageLocation& location) {
+        return row < location.first_row_index;
+      });
+  VELOX_DCHECK(it != pageLocations_.begin());
+  return it - pageLocations_.begin() - 1;
+}
+
+void PageReader::seekWithPageIndex(int64_t row) {
+  if (chunkStart_ + pageStart_ < pageLocations_[0].offset) {
+    // The dictionary page is not read yet.
+    return;
+  }
+  auto& location = pageLocations_[pageIndexOfRow(row)];
+  uint64_t offset = location.offset - chunkStart_;
+  if (offset <= pageStart_) {
+    return;
+  }
+  std::vector<uint64_t> position = {offset};
+  dwio::common::PositionProvider positionProvider(position);
+  inputStream_->seekToPosition(positionProvider);
+  bufferStart_ = bufferEnd_ = nullptr;
+  pageStart_ = offset;
+  rowOfPage_ = location.first_row_index;
+  numRowsInPage_ = 0;
+}
+
 PageHeader PageReader::readPageHeader() {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
@@ -97,6 +139,16 @@ PageHeader PageReader::readPageHeader() {
   return pageHeader;
 }
 
+const dwio::common::DictionaryValues* FOLLY_NULLABLE
+PageReader::readDictionaryPage() {
+  auto pageHeader = readPageHeader();
+  if (pageHeader.type != thrift::PageType::DICTIONARY_PAGE) {
+    return nullptr;
+  }
+  prepareDictionary(pageHeader);
+  return &dictionary_;
+}
+
 const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer = nullptr;
@@ -121,78 +173,57 @@ const char* PageReader::readBytes(int32_t size, BufferPtr& copy) {
   return copy->as<char>();
 }
 
+namespace {
+dwio::common::CompressionKind toCompressionKind(
+    thrift::CompressionCodec::type codec) {
+  switch (codec) {
+    case thrift::CompressionCodec::SNAPPY:
+      return dwio::common::CompressionKind_SNAPPY;
+    case thrift::CompressionCodec::GZIP:
+      return dwio::common::CompressionKind_GZIP;
+    case thrift::CompressionCodec::ZSTD:
+      return dwio::common::CompressionKind_ZSTD;
+    case thrift::CompressionCodec::BROTLI:
+      return dwio::common::CompressionKind_BROTLI;
+    case thrift::CompressionCodec::LZ4:
+      // The deprecated Parquet LZ4 codec uses the Hadoop framing.
+      return dwio::common::CompressionKind_LZ4_HADOOP;
+    case thrift::CompressionCodec::LZ4_RAW:
+      return dwio::common::CompressionKind_LZ4;
+    default:
+      VELOX_UNSUPPORTED("Unsupported Parquet compression type '{}'", codec);
+  }
+}
+} // namespace
+
 const char* FOLLY_NONNULL PageReader::uncompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
-  switch (codec_) {
-    case thrift::CompressionCodec::UNCOMPRESSED:
-      return pageData;
-    case thrift::CompressionCodec::SNAPPY: {
-      dwio::common::ensureCapacity<char>(
-          uncompressedData_, uncompressedSize, &pool_);
-
-      size_t sizeFromSnappy;
-      if (!snappy::GetUncompressedLength(
-              pageData, compressedSize, &sizeFromSnappy)) {
-        VELOX_FAIL("Snappy uncompressed size not available");
-      }
-      VELOX_CHECK_EQ(uncompressedSize, sizeFromSnappy);
-      snappy::RawUncompress(
-          pageData, compressedSize, uncompressedData_->asMutable<char>());
-      return uncompressedData_->as<char>();
-    }
-    case thrift::CompressionCodec::ZSTD: {
-      dwio::common::ensureCapacity<char>(
-          uncompressedData_, uncompressedSize, &pool_);
-
-      auto ret = ZSTD_decompress(
-          uncompressedData_->asMutable<char>(),
-          uncompressedSize,
-          pageData,
-          compressedSize);
-      VELOX_CHECK(
-          !ZSTD_isError(ret),
-          "ZSTD returned an error: ",
-          ZSTD_getErrorName(ret));
-      return uncompressedData_->as<char>();
-    }
-    case thrift::CompressionCodec::GZIP: {
-      dwio::common::ensureCapacity<char>(
-          uncompressedData_, uncompressedSize, &pool_);
-      z_stream stream;
-      memset(&stream, 0, sizeof(stream));
-      constexpr int WINDOW_BITS = 15;
-      // Determine if this is libz or gzip from header.
-      constexpr int DETECT_CODEC = 32;
-      // Initialize decompressor.
-      auto ret = inflateInit2(&stream, WINDOW_BITS | DETECT_CODEC);
-      VELOX_CHECK(
-          (ret == Z_OK),
-          "zlib inflateInit failed: {}",
-          stream.msg ? stream.msg : "");
-      auto inflateEndGuard = folly::makeGuard([&] {
-        if (inflateEnd(&stream) != Z_OK) {
-          LOG(WARNING) << "inflateEnd: " << (stream.msg ? stream.msg : "");
-        }
-      });
-      // Decompress.
-      stream.next_in =
-          const_cast<Bytef*>(reinterpret_cast<const Bytef*>(pageData));
-      stream.avail_in = static_cast<uInt>(compressedSize);
-      stream.next_out =
-          reinterpret_cast<Bytef*>(uncompressedData_->asMutable<char>());
-      stream.avail_out = static_cast<uInt>(uncompressedSize);
-      ret = inflate(&stream, Z_FINISH);
-      VELOX_CHECK(
-          ret == Z_STREAM_END,
-          "GZipCodec failed: {}",
-          stream.msg ? stream.msg : "");
-      return uncompressedData_->as<char>();
-    }
-    default:
-      VELOX_FAIL("Unsupported Parquet compression type '{}'", codec_);
+  if (codec_ == thrift::CompressionCodec::UNCOMPRESSED) {
+    return pageData;
   }
+  if (!decompressor_) {
+    auto kind = toCompressionKind(codec_);
+    VELOX_CHECK(
+        dwio::common::compression::isDecompressorAvailable(kind),
+        "Parquet compression type '{}' is not available in this build",
+        codec_);
+    // The page sizes come from the page headers, so the decompressor does not
+    // need a block size bound.
+    decompressor_ = dwio::common::compression::createDecompressor(
+        kind, 0, "Parquet page");
+  }
+  dwio::common::ensureCapacity<char>(
+      uncompressedData_, uncompressedSize, &pool_);
+  auto size = decompressor_->decompress(
+      pageData,
+      compressedSize,
+      uncompressedData_->asMutable<char>(),
+      uncompressedSize);
+  VELOX_CHECK_EQ(
+      size, uncompressedSize, "Unexpected uncompressed Parquet page size");
+  return uncompressedData_->as<char>();
 }
 
 void PageReader::setPageRowInfo(bool forRepDef) {
@@ -574,6 +605,113 @@ int32_t parquetTypeBytes(thrift::Type::type type) {
       VELOX_FAIL("Type does not have a byte width {}", type);
   }
 }
+
+// Interleaves the 'kWidth' byte streams of BYTE_STREAM_SPLIT encoded 'data'
+// into 'numValues' values of 'kWidth' bytes at 'result'. Stream 'k' holds byte
+// 'k' of each value. The loop over a block of values reads each stream
+// sequentially and has a fixed trip count for the inner dimension, which lets
+// the compiler turn it into vector shuffles.
+template <int32_t kWidth>
+void decodeByteStreamSplit(
+    const char* FOLLY_NONNULL data,
+    int64_t numValues,
+    char* FOLLY_NONNULL result) {
+  constexpr int32_t kBlock = 64;
+  int64_t i = 0;
+  for (; i + kBlock <= numValues; i += kBlock) {
+    for (auto k = 0; k < kWidth; ++k) {
+      auto stream = data + k * numValues + i;
+      auto out = result + i * kWidth + k;
+      for (auto j = 0; j < kBlock; ++j) {
+        out[j * kWidth] = stream[j];
+      }
+    }
+  }
+  for (; i < numValues; ++i) {
+    for (auto k = 0; k < kWidth; ++k) {
+      result[i * kWidth + k] = data[k * numValues + i];
+    }
+  }
+}
+
+constexpr auto kLess = [](auto left, auto right) { return left < right; };
+constexpr auto kLessEqual = [](auto left, auto right) { return left <= right; };
+constexpr auto kEqual = [](auto left, auto right) { return left == right; };
+
+// Returns a mask with bit i set if 'compare(levels[i], value)' is true for the
+// first 'numLevels' levels. 'numLevels' is at most 64. Full words are compared
+// a SIMD batch at a time.
+template <typename Compare>
+uint64_t levelMask(
+    const int16_t* levels,
+    int32_t numLevels,
+    int16_t value,
+    Compare compare) {
+  constexpr int32_t kWidth = xsimd::batch<int16_t>::size;
+  uint64_t mask = 0;
+  if (numLevels == 64) {
+    auto values = xsimd::broadcast<int16_t>(value);
+    for (auto i = 0; i < 64; i += kWidth) {
+      mask |= static_cast<uint64_t>(simd::toBitMask(
+                  compare(xsimd::load_unaligned(levels + i), values)))
+          << i;
+    }
+    return mask;
+  }
+  for (auto i = 0; i < numLevels; ++i) {
+    mask |= static_cast<uint64_t>(compare(levels[i], value)) << i;
+  }
+  return mask;
+}
+
+// Fast path of DefRepLevelsToList() for levels where all lists at the
+// level of 'info' are present and non-empty, which is the common case
+// of nested data without nulls. Each level with a repetition level
+// below the list's is the start of a list and each level with a
+// repetition level up to the list's is an element of the current
+// list. The lengths are counted from bit masks of these 64 levels at
+// a time. Returns the number of lists written to 'lengths' or -1 if
+// the levels do not qualify or there are more than 'maxLists' lists.
+int32_t denseLevelsToLengths(
+    const int16_t* definitionLevels,
+    const int16_t* repetitionLevels,
+    int32_t numLevels,
+    const ::parquet::internal::LevelInfo& info,
+    int32_t maxLists,
+    int32_t* lengths) {
+  if (numLevels == 0 || repetitionLevels[0] >= info.rep_level) {
+    return -1;
+  }
+  for (auto i = 0; i < numLevels; i += 64) {
+    auto numInWord = std::min<int32_t>(64, numLevels - i);
+    if (levelMask(definitionLevels + i, numInWord, info.def_level, kLess)) {
+      return -1;
+    }
+  }
+  int32_t numLists = 0;
+  for (auto i = 0; i < numLevels; i += 64) {
+    auto numInWord = std::min<int32_t>(64, numLevels - i);
+    auto starts =
+        levelMask(repetitionLevels + i, numInWord, info.rep_level, kLess);
+    auto elements =
+        levelMask(repetitionLevels + i, numInWord, info.rep_level, kLessEqual);
+    if (numLists + __builtin_popcountll(starts) > maxLists) {
+      return -1;
+    }
+    while (starts) {
+      auto start = __builtin_ctzll(starts);
+      if (numLists > 0) {
+        lengths[numLists - 1] +=
+            __builtin_popcountll(elements & bits::lowMask(start));
+      }
+      elements &= ~bits::lowMask(start);
+      lengths[numLists++] = 0;
+      starts &= starts - 1;
+    }
+    lengths[numLists - 1] += __builtin_popcountll(elements);
+  }
+  return numLists;
+}
 } // namespace
 
 void PageReader::preloadRepDefs() {
@@ -625,15 +763,24 @@ void PageReader::decodeRepDefs(int32_t numTopLevelRows) {
   int32_t topFound = 0;
   int32_t i = repDefBegin_;
   if (maxRepeat_ > 0) {
-    for (; i < numLevels; ++i) {
-      if (repetitionLevels_[i] == 0) {
-        ++topFound;
-        if (topFound == numTopLevelRows + 1) {
-          break;
-        }
+    // Each top level row starts at a repetition level of 0. The end
+    // is the start of the row after the last one.
+    repDefEnd_ = numLevels;
+    for (; i < numLevels; i += 64) {
+      auto numInWord = std::min<int32_t>(64, numLevels - i);
+      auto rowStarts =
+          levelMask(repetitionLevels_.data() + i, numInWord, 0, kEqual);
+      auto numStarts = __builtin_popcountll(rowStarts);
+      if (topFound + numStarts < numTopLevelRows + 1) {
+        topFound += numStarts;
+        continue;
+      }
+      for (; topFound < numTopLevelRows; ++topFound) {
+        rowStarts &= rowStarts - 1;
       }
+      repDefEnd_ = i + __builtin_ctzll(rowStarts);
+      break;
     }
-    repDefEnd_ = i;
   } else {
     repDefEnd_ = i + numTopLevelRows;
   }
@@ -661,6 +808,20 @@ int32_t PageReader::getLengthsAndNulls(
           definitionLevels_.data() + begin, end - begin, info, &bits);
       break;
     case LevelMode::kList: {
+      auto numLists = denseLevelsToLengths(
+          definitionLevels_.data() + begin,
+          repetitionLevels_.data() + begin,
+          end - begin,
+          info,
+          maxItems,
+          lengths);
+      if (numLists >= 0) {
+        if (nulls) {
+          bits::fillBits(
+              nulls, nullsStartIndex, nullsStartIndex + numLists, true);
+        }
+        return numLists;
+      }
       ::parquet::internal::DefRepLevelsToList(
           definitionLevels_.data() + begin,
           repetitionLevels_.data() + begin,
@@ -702,6 +863,7 @@ void PageReader::makeDecoder() {
               pageData_, pageData_ + encodedDataSize_);
           break;
         case thrift::Type::BYTE_ARRAY:
+          deltaByteArrayDecoder_.reset();
           stringDecoder_ = std::make_unique<StringDecoder>(
               pageData_, pageData_ + encodedDataSize_);
           break;
@@ -723,11 +885,91 @@ void PageReader::makeDecoder() {
       }
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          makeDeltaBpDecoder(parquetType);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BINARY_PACKED not supported for Parquet type {}",
+              parquetType);
+      }
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      switch (parquetType) {
+        case thrift::Type::FLOAT:
+        case thrift::Type::DOUBLE:
+          makeByteStreamSplitDecoder(parquetType);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "BYTE_STREAM_SPLIT not supported for Parquet type {}",
+              parquetType);
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      switch (parquetType) {
+        case thrift::Type::BYTE_ARRAY:
+          stringDecoder_.reset();
+          deltaByteArrayDecoder_ = std::make_unique<DeltaByteArrayDecoder>(
+              pageData_,
+              pageData_ + encodedDataSize_,
+              encoding_ == Encoding::DELTA_BYTE_ARRAY);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "Encoding {} not supported for Parquet type {}",
+              encoding_,
+              parquetType);
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet");
   }
 }
 
+void PageReader::makeDeltaBpDecoder(thrift::Type::type parquetType) {
+  DeltaBpDecoder decoder(pageData_, pageData_ + encodedDataSize_);
+  auto numValues = decoder.numValues();
+  auto typeBytes = parquetTypeBytes(parquetType);
+  dwio::common::ensureCapacity<char>(
+      decodedValues_, numValues * typeBytes, &pool_);
+  if (parquetType == thrift::Type::INT32) {
+    decoder.next(decodedValues_->asMutable<int32_t>(), numValues);
+  } else {
+    decoder.next(decodedValues_->asMutable<int64_t>(), numValues);
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          decodedValues_->as<char>(), numValues * typeBytes),
+      false,
+      typeBytes);
+}
+
+void PageReader::makeByteStreamSplitDecoder(thrift::Type::type parquetType) {
+  auto typeBytes = parquetTypeBytes(parquetType);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % typeBytes,
+      0,
+      "BYTE_STREAM_SPLIT page size is not a multiple of the value width");
+  auto numValues = encodedDataSize_ / typeBytes;
+  dwio::common::ensureCapacity<char>(
+      decodedValues_, encodedDataSize_, &pool_);
+  auto result = decodedValues_->asMutable<char>();
+  if (typeBytes == sizeof(float)) {
+    decodeByteStreamSplit<sizeof(float)>(pageData_, numValues, result);
+  } else {
+    decodeByteStreamSplit<sizeof(double)>(pageData_, numValues, result);
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          decodedValues_->as<char>(), encodedDataSize_),
+      false,
+      typeBytes);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -746,11 +988,17 @@ void PageReader::skip(int64_t numRows) {
   // Skip nulls
   toSkip = skipNulls(toSkip);
 
-  // Skip the decoder
+  // Skip the decoder. There may be no decoder after skipping to the end of
+  // the column chunk with the page index.
+  if (!toSkip) {
+    return;
+  }
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
+  } else if (deltaByteArrayDecoder_) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
     stringDecoder_->skip(toSkip);
   } else if (booleanDecoder_) {
@@ -862,6 +1110,15 @@ bool PageReader::rowsForPage(
   if (currentVisitorRow_ == numVisitorRows_) {
     return false;
   }
+  if (hasFilter && !prunedPages_.empty()) {
+    skipPrunedPages();
+    if (currentVisitorRow_ == numVisitorRows_) {
+      // Position after the last row to visit as if the rows had been read.
+      auto end = visitBase_ + visitorRows_[numVisitorRows_ - 1] + 1;
+      skip(end - firstUnvisited_);
+      return false;
+    }
+  }
   int32_t numToVisit;
   // Check if the first row to go to is in the current page. If not, seek to the
   // page that contains the row.
@@ -953,6 +1210,26 @@ bool PageReader::rowsForPage(
   return true;
 }
 
+void PageReader::skipPrunedPages() {
+  while (currentVisitorRow_ < numVisitorRows_) {
+    auto page = pageIndexOfRow(visitBase_ + visitorRows_[currentVisitorRow_]);
+    if (!bits::isBitSet(prunedPages_.data(), page)) {
+      return;
+    }
+    if (page + 1 == static_cast<int32_t>(pageLocations_.size())) {
+      currentVisitorRow_ = numVisitorRows_;
+      return;
+    }
+    auto firstOnNextPage =
+        pageLocations_[page + 1].first_row_index - visitBase_;
+    currentVisitorRow_ = std::lower_bound(
+                             visitorRows_ + currentVisitorRow_,
+                             visitorRows_ + numVisitorRows_,
+                             firstOnNextPage) -
+        visitorRows_;
+  }
+}
+
 const VectorPtr& PageReader::dictionaryValues(const TypePtr& type) {
   if (!dictionaryValues_) {
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
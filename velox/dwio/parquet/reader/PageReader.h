@@ -20,7 +20,9 @@
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -130,6 +132,23 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Reads the first page of the column chunk if it is a dictionary page and
+  /// returns the decoded dictionary. Returns nullptr if the chunk does not
+  /// start with a dictionary page. Used for testing a filter on the
+  /// dictionary without reading the data pages.
+  const dwio::common::DictionaryValues* FOLLY_NULLABLE readDictionaryPage();
+
+  /// Sets the page locations from the OffsetIndex of the column chunk. Seeking
+  /// to a row then goes directly to its page instead of reading the headers of
+  /// the pages in between. 'chunkStart' is the file offset of the start of the
+  /// stream of 'this'. 'prunedPages' has a bit set for each page on which no
+  /// row passes the filter of the column. Rows on these pages are dropped
+  /// without decoding when reading with a filter. Only for top level columns.
+  void setPageIndex(
+      std::vector<thrift::PageLocation> pageLocations,
+      uint64_t chunkStart,
+      std::vector<uint64_t> prunedPages);
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -164,6 +183,18 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // Positions 'inputStream_' at the header of the page containing 'row' if
+  // 'pageLocations_' is set and the page is ahead of the current position.
+  // Called from seekToPage() after any dictionary page has been read.
+  void seekWithPageIndex(int64_t row);
+
+  // Returns the index in 'pageLocations_' of the page containing 'row'.
+  int32_t pageIndexOfRow(int64_t row) const;
+
+  // Advances 'currentVisitorRow_' past the rows to visit that are on pages in
+  // 'prunedPages_'.
+  void skipPrunedPages();
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -186,6 +217,17 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Decodes the DELTA_BINARY_PACKED values of the current page into
+  // 'decodedValues_' in the layout of PLAIN encoding and makes
+  // 'directDecoder_' read from there. This way the fast paths of
+  // DirectDecoder apply to delta encoded pages as well.
+  void makeDeltaBpDecoder(thrift::Type::type parquetType);
+
+  // Interleaves the byte streams of a BYTE_STREAM_SPLIT page into
+  // 'decodedValues_' and makes 'directDecoder_' read from there, so that
+  // floating point filters run on the same path as for PLAIN pages.
+  void makeByteStreamSplitDecoder(thrift::Type::type parquetType);
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -289,6 +331,9 @@ class PageReader {
         nullsFromFastPath = dwio::common::useFastPath<Visitor, true>(visitor);
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (deltaByteArrayDecoder_) {
+        nullsFromFastPath = false;
+        deltaByteArrayDecoder_->readWithVisitor<true>(nulls, visitor);
       } else {
         nullsFromFastPath = false;
         stringDecoder_->readWithVisitor<true>(nulls, visitor);
@@ -297,6 +342,8 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (deltaByteArrayDecoder_) {
+        deltaByteArrayDecoder_->readWithVisitor<false>(nulls, visitor);
       } else {
         stringDecoder_->readWithVisitor<false>(nulls, visitor);
       }
@@ -405,9 +452,16 @@ class PageReader {
   // Copy of data if data straddles buffer boundary.
   BufferPtr pageBuffer_;
 
+  // Values of a DELTA_BINARY_PACKED or BYTE_STREAM_SPLIT page, decoded into
+  // PLAIN layout.
+  BufferPtr decodedValues_;
+
   // Uncompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr uncompressedData_;
 
+  // Decompressor for 'codec_'. Created on first compressed page.
+  std::unique_ptr<dwio::common::compression::Decompressor> decompressor_;
+
   // First byte of uncompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -425,6 +479,17 @@ class PageReader {
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
+  // Locations of the data pages from the OffsetIndex. Empty if the page index
+  // is not used.
+  std::vector<thrift::PageLocation> pageLocations_;
+
+  // File offset of the start of 'inputStream_'. 'pageLocations_' have file
+  // offsets.
+  uint64_t chunkStart_{0};
+
+  // Bits for the pages in 'pageLocations_' on which no row passes the filter.
+  std::vector<uint64_t> prunedPages_;
+
   // Below members Keep state between calls to readWithVisitor().
 
   // Original rows in Visitor.
@@ -472,6 +537,7 @@ class PageReader {
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
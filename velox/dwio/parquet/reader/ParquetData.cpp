@@ -15,16 +15,154 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
+namespace {
+template <typename T>
+T readThriftStruct(dwio::common::SeekableInputStream& stream) {
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  int32_t size;
+  VELOX_CHECK(
+      stream.Next(reinterpret_cast<const void**>(&bufferStart), &size),
+      "Empty Parquet page index stream");
+  bufferEnd = bufferStart + size;
+  auto transport = std::make_shared<thrift::ThriftStreamingTransport>(
+      &stream, bufferStart, bufferEnd);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  T result;
+  result.read(&protocol);
+  return result;
+}
+
+bool isDictionaryEncoding(thrift::Encoding::type encoding) {
+  return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+      encoding == thrift::Encoding::RLE_DICTIONARY;
+}
+
+// True if all data pages of the column chunk of 'metaData' are dictionary
+// encoded, so that all its values are in the dictionary. Writers fall back to
+// plain encoding when the dictionary grows too large.
+bool allDataPagesDictionaryEncoded(const thrift::ColumnMetaData& metaData) {
+  if (metaData.__isset.encoding_stats) {
+    for (auto& stats : metaData.encoding_stats) {
+      if ((stats.page_type == thrift::PageType::DATA_PAGE ||
+           stats.page_type == thrift::PageType::DATA_PAGE_V2) &&
+          stats.count > 0 && !isDictionaryEncoding(stats.encoding)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // Without page encoding stats, a PLAIN encoding may come from either a
+  // dictionary page or a fallback data page, so only the encodings of the
+  // levels are allowed besides dictionary encodings.
+  for (auto encoding : metaData.encodings) {
+    if (!isDictionaryEncoding(encoding) &&
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// True if the dictionary values of a column of 'type' stored as 'parquetType'
+// are in the representation the filter is evaluated on.
+bool isDictionaryFilterApplicable(
+    const TypePtr& type,
+    thrift::Type::type parquetType) {
+  if (type->isDecimal()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return parquetType == thrift::Type::INT32 ||
+          parquetType == thrift::Type::INT64;
+    case TypeKind::REAL:
+      return parquetType == thrift::Type::FLOAT;
+    case TypeKind::DOUBLE:
+      return parquetType == thrift::Type::DOUBLE;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return parquetType == thrift::Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+
+// True if any of the values in 'dictionary' passes 'filter'.
+bool testFilterOnDictionary(
+    const common::Filter& filter,
+    const dwio::common::DictionaryValues& dictionary,
+    thrift::Type::type parquetType) {
+  auto numValues = dictionary.numValues;
+  switch (parquetType) {
+    case thrift::Type::INT32: {
+      auto values = dictionary.values->as<int32_t>();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::INT64: {
+      auto values = dictionary.values->as<int64_t>();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filter.testInt64(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::FLOAT: {
+      auto values = dictionary.values->as<float>();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filter.testFloat(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::DOUBLE: {
+      auto values = dictionary.values->as<double>();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filter.testDouble(values[i])) {
+          return true;
+        }
+      }
+      return false;
+    }
+    case thrift::Type::BYTE_ARRAY: {
+      auto values = dictionary.values->as<StringView>();
+      for (auto i = 0; i < numValues; ++i) {
+        if (filter.testBytes(values[i].data(), values[i].size())) {
+          return true;
+        }
+      }
+      return false;
+    }
+    default:
+      return true;
+  }
+}
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, scanSpec, input_, pool());
 }
 
 void ParquetData::filterRowGroups(
@@ -77,9 +215,71 @@ bool ParquetData::rowGroupMatches(
         rowGroup.columns[column].meta_data.statistics,
         *type,
         rowGroup.num_rows);
-    return testFilter(filter, columnStats.get(), rowGroup.num_rows, type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.num_rows, type)) {
+      return false;
+    }
   }
-  return true;
+  return bloomFilterMatches(rowGroupId, *filter) &&
+      dictionaryMatches(rowGroupId, *filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto& columnChunk = rowGroups_[rowGroupId].columns[type_->column];
+  if (!columnChunk.__isset.meta_data ||
+      !columnChunk.meta_data.__isset.bloom_filter_offset ||
+      !type_->parquetType_.has_value() || type_->type->isDecimal() ||
+      !isBloomFilterApplicable(filter, type_->parquetType_.value())) {
+    return true;
+  }
+  auto bloomFilter =
+      BloomFilter::read(input_, columnChunk.meta_data.bloom_filter_offset);
+  if (!bloomFilter) {
+    return true;
+  }
+  return testFilterOnBloomFilter(
+      filter, *bloomFilter, type_->parquetType_.value());
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto& columnChunk = rowGroups_[rowGroupId].columns[type_->column];
+  if (!columnChunk.__isset.meta_data || maxRepeat_ > 0 ||
+      !type_->parquetType_.has_value() ||
+      !isDictionaryFilterApplicable(
+          type_->type, type_->parquetType_.value())) {
+    return true;
+  }
+  auto& metaData = columnChunk.meta_data;
+  if (!metaData.__isset.dictionary_page_offset ||
+      metaData.dictionary_page_offset < 4 ||
+      metaData.data_page_offset <= metaData.dictionary_page_offset ||
+      !allDataPagesDictionaryEncoded(metaData)) {
+    return true;
+  }
+  // Nulls are not in the dictionary.
+  if (maxDefine_ > 0 && filter.testNull() &&
+      !(metaData.__isset.statistics &&
+        metaData.statistics.__isset.null_count &&
+        metaData.statistics.null_count == 0)) {
+    return true;
+  }
+  auto dictionarySize =
+      metaData.data_page_offset - metaData.dictionary_page_offset;
+  auto stream = input_.read(
+      metaData.dictionary_page_offset,
+      dictionarySize,
+      dwio::common::LogType::STREAM);
+  PageReader reader(
+      std::move(stream), pool_, type_, metaData.codec, dictionarySize);
+  auto* dictionary = reader.readDictionaryPage();
+  if (!dictionary) {
+    return true;
+  }
+  return testFilterOnDictionary(
+      filter, *dictionary, type_->parquetType_.value());
 }
 
 void ParquetData::enqueueRowGroup(
@@ -107,6 +307,24 @@ void ParquetData::enqueueRowGroup(
 
   auto id = dwio::common::StreamIdentifier(type_->column);
   streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  chunkStarts_.resize(rowGroups_.size());
+  chunkStarts_[index] = chunkReadOffset;
+
+  // The page index lets a filter skip pages. Pages are only on row boundaries
+  // for top level columns.
+  if (scanSpec_.filter() && maxRepeat_ == 0 && maxDefine_ <= 1 &&
+      chunk.__isset.offset_index_offset && chunk.__isset.column_index_offset) {
+    offsetIndexStreams_.resize(rowGroups_.size());
+    columnIndexStreams_.resize(rowGroups_.size());
+    offsetIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.offset_index_offset),
+         static_cast<uint64_t>(chunk.offset_index_length)},
+        &id);
+    columnIndexStreams_[index] = input.enqueue(
+        {static_cast<uint64_t>(chunk.column_index_offset),
+         static_cast<uint64_t>(chunk.column_index_length)},
+        &id);
+  }
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -120,7 +338,57 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  if (index < offsetIndexStreams_.size() && offsetIndexStreams_[index]) {
+    setPageIndex(index);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
+void ParquetData::setPageIndex(uint32_t index) {
+  auto offsetIndex =
+      readThriftStruct<thrift::OffsetIndex>(*offsetIndexStreams_[index]);
+  auto columnIndex =
+      readThriftStruct<thrift::ColumnIndex>(*columnIndexStreams_[index]);
+  offsetIndexStreams_[index].reset();
+  columnIndexStreams_[index].reset();
+  auto& locations = offsetIndex.page_locations;
+  auto numPages = locations.size();
+  if (numPages == 0 || columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages ||
+      (columnIndex.__isset.null_counts &&
+       columnIndex.null_counts.size() != numPages)) {
+    return;
+  }
+  auto filter = scanSpec_.filter();
+  auto numRowsInRowGroup = rowGroups_[index].num_rows;
+  std::vector<uint64_t> prunedPages(bits::nwords(numPages));
+  bool anyPruned = false;
+  for (auto i = 0; i < numPages; ++i) {
+    auto numRows = (i + 1 < numPages ? locations[i + 1].first_row_index
+                                     : numRowsInRowGroup) -
+        locations[i].first_row_index;
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRows);
+    } else {
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type_->type, numRows);
+    if (!testFilter(filter, columnStats.get(), numRows, type_->type)) {
+      bits::setBit(prunedPages.data(), i);
+      anyPruned = true;
+    }
+  }
+  reader_->setPageIndex(
+      std::move(locations),
+      chunkStarts_[index],
+      anyPruned ? std::move(prunedPages) : std::vector<uint64_t>());
+}
+
 } // namespace facebook::velox::parquet
@@ -28,14 +28,18 @@
 namespace facebook::velox::parquet {
 class ParquetParams : public dwio::common::FormatParams {
  public:
-  ParquetParams(memory::MemoryPool& pool, const thrift::FileMetaData& metaData)
-      : FormatParams(pool), metaData_(metaData) {}
+  ParquetParams(
+      memory::MemoryPool& pool,
+      const thrift::FileMetaData& metaData,
+      dwio::common::BufferedInput& input)
+      : FormatParams(pool), metaData_(metaData), input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+  dwio::common::BufferedInput& input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -44,15 +48,21 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
+      const common::ScanSpec& scanSpec,
+      dwio::common::BufferedInput& input,
       memory::MemoryPool& pool)
       : pool_(pool),
+        input_(input),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        scanSpec_(scanSpec),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
 
-  /// Prepares to read data for 'index'th row group.
+  /// Prepares to read data for 'index'th row group. If the column has a filter
+  /// and the file has a page index, also enqueues the ColumnIndex and
+  /// OffsetIndex of the column chunk.
   void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
 
   /// Positions 'this' at 'index'th row group. enqueueRowGroup must be called
@@ -174,17 +184,46 @@ class ParquetData : public dwio::common::FormatData {
 
  private:
   /// True if 'filter' may have hits for the column of 'this' according to the
-  /// stats in 'rowGroup'.
+  /// stats, the Bloom filter and the dictionary in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// True if the Bloom filter of the column chunk in 'rowGroupId'th row group
+  /// may contain a value passing 'filter'. Reads the Bloom filter from
+  /// 'input_'.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  /// True if some value in the dictionary of the column chunk in
+  /// 'rowGroupId'th row group passes 'filter' or if the chunk may have values
+  /// that are not in the dictionary. Reads the dictionary page from 'input_'.
+  bool dictionaryMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  /// Reads the OffsetIndex and ColumnIndex enqueued for 'index'th row group
+  /// and passes the page locations and the pages on which no row can pass the
+  /// filter to 'reader_'.
+  void setPageIndex(uint32_t index);
+
  protected:
   memory::MemoryPool& pool_;
+  // Input of the file for reading metadata outside of the column chunks.
+  dwio::common::BufferedInput& input_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  const common::ScanSpec& scanSpec_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  // Streams for the OffsetIndex and ColumnIndex of this column in each of
+  // 'rowGroups_'. Only enqueued for top level columns with a filter.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      offsetIndexStreams_;
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>>
+      columnIndexStreams_;
+
+  // File offset of the first enqueued byte of the column chunk in each of
+  // 'rowGroups_'.
+  std::vector<uint64_t> chunkStarts_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
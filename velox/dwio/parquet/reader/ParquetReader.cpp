@@ -48,6 +48,19 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = options_.getFileMetadataCache();
+  if (metadataCache) {
+    auto cached = std::dynamic_pointer_cast<const ParquetFileMetadata>(
+        metadataCache->find(options_.getFileMetadataCachePath(), fileLength_));
+    if (cached) {
+      // The row groups are then read as needed instead of preloading the
+      // whole file.
+      fileMetaData_ = std::shared_ptr<const thrift::FileMetaData>(
+          cached, &cached->metaData);
+      return;
+    }
+  }
+
   preloadFile_ = (dynamic_cast<dwio::common::CachedBufferedInput*>(
                       input_.get()) == nullptr) &&
       (fileLength_ <= filePreloadThreshold_ ||
@@ -97,8 +110,15 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto metadata = std::make_shared<ParquetFileMetadata>();
+  metadata->metaData.read(thriftProtocol.get());
+  metadata->footerLength = footerLength;
+  fileMetaData_ = std::shared_ptr<const thrift::FileMetaData>(
+      metadata, &metadata->metaData);
+  if (metadataCache) {
+    metadataCache->insert(
+        options_.getFileMetadataCachePath(), fileLength_, std::move(metadata));
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -557,7 +577,8 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, readerBase_->fileMetaData());
+  ParquetParams params(
+      pool_, readerBase_->fileMetaData(), readerBase_->bufferedInput());
 
   columnReader_ = ParquetColumnReader::build(
       readerBase_->schemaWithId(), // Id is schema id
@@ -599,6 +620,8 @@ void ParquetRowReader::filterRowGroups() {
     VELOX_CHECK_GE(fileOffset, 0);
     if (fileOffset == 0) {
       rowGroupIds_.push_back(i);
+      firstRowOfRowGroup_.push_back(rowNumber);
+      rowNumber += rowGroups_[i].num_rows;
       continue;
     }
     auto rowGroupInRange =
@@ -617,6 +640,35 @@ void ParquetRowReader::filterRowGroups() {
   }
 }
 
+void ParquetRowReader::filterRemainingRowGroups() {
+  if (nextRowGroupIdsIdx_ >= rowGroupIds_.size()) {
+    return;
+  }
+  ParquetData::FilterRowGroupsResult res;
+  columnReader_->filterRowGroups(0, ParquetStatsContext(), res);
+  if (auto& metadataFilter = options_.getMetadataFilter()) {
+    metadataFilter->eval(res.metadataFilterResults, res.filterResult);
+  }
+
+  // The row groups before 'nextRowGroupIdsIdx_' are read or being read.
+  auto numKept = nextRowGroupIdsIdx_;
+  for (auto i = nextRowGroupIdsIdx_; i < rowGroupIds_.size(); ++i) {
+    const auto rowGroup = rowGroupIds_[i];
+    if (rowGroup < res.totalCount &&
+        bits::isBitSet(res.filterResult.data(), rowGroup)) {
+      ++skippedRowGroups_;
+      // Drops the data of the row group if its prefetch was started.
+      readerBase_->releaseRowGroup(rowGroup);
+      continue;
+    }
+    rowGroupIds_[numKept] = rowGroup;
+    firstRowOfRowGroup_[numKept] = firstRowOfRowGroup_[i];
+    ++numKept;
+  }
+  rowGroupIds_.resize(numKept);
+  firstRowOfRowGroup_.resize(numKept);
+}
+
 int64_t ParquetRowReader::nextRowNumber() {
   if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
       !advanceToNextRowGroup()) {
@@ -670,10 +722,20 @@ void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
   stats.processedStrides += rowGroupIds_.size();
+  stats.skippedLazyRows += columnReader_->numLazySkippedRows();
+}
+
+std::optional<uint64_t> ParquetRowReader::numberOfRowsInRange() const {
+  uint64_t numRows = 0;
+  for (auto rowGroup : rowGroupIds_) {
+    numRows += rowGroups_[rowGroup].num_rows;
+  }
+  return numRows;
 }
 
 void ParquetRowReader::resetFilterCaches() {
   columnReader_->resetFilterCaches();
+  filterRemainingRowGroups();
 }
 
 std::optional<size_t> ParquetRowReader::estimatedRowSize() const {
@@ -29,6 +29,19 @@ enum class ParquetMetricsType { HEADER, FILE_METADATA, FILE, BLOCK, TEST };
 
 class StructColumnReader;
 
+/// The parsed footer of a Parquet file. Immutable, so that the readers of the
+/// same file can share it through a FileMetadataCache.
+struct ParquetFileMetadata : public cache::FileMetadata {
+  thrift::FileMetaData metaData;
+  // Serialized size of the footer.
+  uint32_t footerLength{0};
+
+  uint64_t size() const override {
+    // The parsed footer is a few times the size of its compact encoding.
+    return sizeof(*this) + 4 * footerLength;
+  }
+};
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -77,6 +90,13 @@ class ReaderBase {
       int32_t currentGroup,
       StructColumnReader& reader);
 
+  /// Drops the input of the row group at 'rowGroupIndex' if it was scheduled
+  /// by scheduleRowGroups(). Called for row groups that are not going to be
+  /// read, so that their prefetched data is released.
+  void releaseRowGroup(uint32_t rowGroupIndex) {
+    inputs_.erase(rowGroupIndex);
+  }
+
   /// Returns the uncompressed size for columns in 'type' and its children in
   /// row
   /// group.
@@ -111,7 +131,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Points into a ParquetFileMetadata that may be shared with other readers.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -157,11 +178,18 @@ class ParquetRowReader : public dwio::common::RowReader {
     return true;
   }
 
+  std::optional<uint64_t> numberOfRowsInRange() const override;
+
  private:
   // Compares row group  metadata to filters in ScanSpec in options of
   // ReaderBase and determines the set of row groups to scan.
   void filterRowGroups();
 
+  // Removes the row groups after the current one that the filters in
+  // ScanSpec exclude. Called when the filters change after the first row
+  // group is read, e.g. for dynamic filters.
+  void filterRemainingRowGroups();
+
   // Positions the reader tre at the start of the next row group, as determined
   // by filterRowGroups().
   bool advanceToNextRowGroup();
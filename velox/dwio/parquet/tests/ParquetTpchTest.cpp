@@ -29,11 +29,21 @@ TEST_P(MultiParquetTpchTest, Q1) {
   assertQuery(1);
 }
 
+TEST_P(MultiParquetTpchTest, Q2) {
+  std::vector<uint32_t> sortingKeys{0, 1, 2, 3};
+  assertQuery(2, std::move(sortingKeys));
+}
+
 TEST_P(MultiParquetTpchTest, Q3) {
   std::vector<uint32_t> sortingKeys{1, 2};
   assertQuery(3, std::move(sortingKeys));
 }
 
+TEST_P(MultiParquetTpchTest, Q4) {
+  std::vector<uint32_t> sortingKeys{0};
+  assertQuery(4, std::move(sortingKeys));
+}
+
 TEST_P(MultiParquetTpchTest, Q5) {
   std::vector<uint32_t> sortingKeys{1};
   assertQuery(5, std::move(sortingKeys));
@@ -63,6 +73,11 @@ TEST_P(MultiParquetTpchTest, Q10) {
   assertQuery(10, std::move(sortingKeys));
 }
 
+TEST_P(MultiParquetTpchTest, Q11) {
+  std::vector<uint32_t> sortingKeys{1};
+  assertQuery(11, std::move(sortingKeys));
+}
+
 TEST_P(MultiParquetTpchTest, Q12) {
   std::vector<uint32_t> sortingKeys{0};
   assertQuery(12, std::move(sortingKeys));
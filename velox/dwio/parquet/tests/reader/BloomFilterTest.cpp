@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// Sets the bits for 'hash' in the split block Bloom filter 'bitset' the way
+// Parquet writers do.
+void insert(std::string& bitset, uint64_t hash) {
+  static constexpr uint32_t kSalt[8] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+  uint64_t numBlocks = bitset.size() / 32;
+  auto block = ((hash >> 32) * numBlocks) >> 32;
+  auto words = reinterpret_cast<uint32_t*>(bitset.data() + block * 32);
+  auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < 8; ++i) {
+    words[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+} // namespace
+
+TEST(BloomFilterTest, int64) {
+  std::string bitset(1024, '\0');
+  for (int64_t i = 0; i < 100; ++i) {
+    insert(bitset, BloomFilter::hashInt64(i * 1'000));
+  }
+  BloomFilter bloomFilter(std::move(bitset));
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 100'000; ++i) {
+    auto found = bloomFilter.mayContain(BloomFilter::hashInt64(i));
+    if (i % 1'000 == 0) {
+      EXPECT_TRUE(found);
+    } else if (found) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 1'000);
+
+  auto physicalType = thrift::Type::INT64;
+  EXPECT_TRUE(testFilterOnBloomFilter(
+      common::BigintRange(5'000, 5'000, false), bloomFilter, physicalType));
+  EXPECT_TRUE(testFilterOnBloomFilter(
+      common::BigintValuesUsingHashTable(
+          1, 1'000'000, {1, 2'000, 1'000'000}, false),
+      bloomFilter,
+      physicalType));
+  // A range is not tested against the Bloom filter.
+  EXPECT_TRUE(testFilterOnBloomFilter(
+      common::BigintRange(1, 999, false), bloomFilter, physicalType));
+  // Nulls are not in the Bloom filter.
+  EXPECT_FALSE(isBloomFilterApplicable(
+      common::BigintRange(7, 7, true), physicalType));
+}
+
+TEST(BloomFilterTest, int32) {
+  std::string bitset(256, '\0');
+  insert(bitset, BloomFilter::hashInt32(17));
+  insert(bitset, BloomFilter::hashInt32(-3));
+  BloomFilter bloomFilter(std::move(bitset));
+  auto physicalType = thrift::Type::INT32;
+  EXPECT_TRUE(testFilterOnBloomFilter(
+      common::BigintRange(17, 17, false), bloomFilter, physicalType));
+  EXPECT_TRUE(testFilterOnBloomFilter(
+      common::BigintValuesUsingBitmask(-3, 20, {-3, 20}, false),
+      bloomFilter,
+      physicalType));
+  // Values outside of the physical type range cannot match.
+  EXPECT_FALSE(testFilterOnBloomFilter(
+      common::BigintRange(1L << 40, 1L << 40, false),
+      bloomFilter,
+      physicalType));
+}
+
+TEST(BloomFilterTest, bytes) {
+  std::string bitset(2048, '\0');
+  std::vector<std::string> values;
+  for (auto i = 0; i < 200; ++i) {
+    values.push_back(fmt::format("id-{}", i));
+    insert(bitset, BloomFilter::hashBytes(values.back()));
+  }
+  BloomFilter bloomFilter(std::move(bitset));
+  auto physicalType = thrift::Type::BYTE_ARRAY;
+  for (auto& value : values) {
+    EXPECT_TRUE(testFilterOnBloomFilter(
+        common::BytesRange(value, false, false, value, false, false, false),
+        bloomFilter,
+        physicalType));
+  }
+  int32_t numPassed = 0;
+  for (auto i = 1'000; i < 2'000; ++i) {
+    auto value = fmt::format("id-{}", i);
+    numPassed += testFilterOnBloomFilter(
+        common::BytesValues({value, value + "x"}, false),
+        bloomFilter,
+        physicalType);
+  }
+  EXPECT_LT(numPassed, 100);
+}
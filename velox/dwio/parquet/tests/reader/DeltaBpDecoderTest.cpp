@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// Minimal DELTA_BINARY_PACKED encoder following the Parquet spec. Uses 128
+// value blocks of 4 miniblocks.
+class DeltaBpEncoder {
+ public:
+  static constexpr int32_t kBlockSize = 128;
+  static constexpr int32_t kNumMiniblocks = 4;
+  static constexpr int32_t kMiniblockSize = kBlockSize / kNumMiniblocks;
+
+  template <typename T>
+  static std::string encode(const std::vector<T>& values) {
+    std::string out;
+    writeVuLong(out, kBlockSize);
+    writeVuLong(out, kNumMiniblocks);
+    writeVuLong(out, values.size());
+    writeVuLong(out, ZigZag::encode(values.empty() ? 0 : values[0]));
+    for (size_t start = 1; start < values.size(); start += kBlockSize) {
+      auto end = std::min(values.size(), start + kBlockSize);
+      std::vector<uint64_t> deltas;
+      int64_t minDelta = std::numeric_limits<int64_t>::max();
+      for (auto i = start; i < end; ++i) {
+        // Wrapping subtraction in the width of the physical type.
+        auto delta = static_cast<int64_t>(static_cast<T>(
+            static_cast<std::make_unsigned_t<T>>(values[i]) -
+            static_cast<std::make_unsigned_t<T>>(values[i - 1])));
+        deltas.push_back(delta);
+        minDelta = std::min(minDelta, delta);
+      }
+      writeVuLong(out, ZigZag::encode(minDelta));
+      for (auto& delta : deltas) {
+        delta -= minDelta;
+      }
+      deltas.resize(kBlockSize, 0);
+      auto numUsed =
+          bits::roundUp(end - start, kMiniblockSize) / kMiniblockSize;
+      std::vector<uint8_t> widths(kNumMiniblocks, 0);
+      for (auto m = 0; m < numUsed; ++m) {
+        uint64_t maxDelta = 0;
+        for (auto i = 0; i < kMiniblockSize; ++i) {
+          maxDelta = std::max(maxDelta, deltas[m * kMiniblockSize + i]);
+        }
+        widths[m] = maxDelta ? 64 - __builtin_clzll(maxDelta) : 0;
+      }
+      out.append(reinterpret_cast<const char*>(widths.data()), widths.size());
+      for (auto m = 0; m < numUsed; ++m) {
+        std::string packed(kMiniblockSize * widths[m] / 8, 0);
+        uint64_t bitOffset = 0;
+        for (auto i = 0; i < kMiniblockSize; ++i) {
+          auto delta = deltas[m * kMiniblockSize + i];
+          for (auto bit = 0; bit < widths[m]; ++bit) {
+            if (delta & (1UL << bit)) {
+              packed[bitOffset / 8] |= 1 << (bitOffset % 8);
+            }
+            ++bitOffset;
+          }
+        }
+        out += packed;
+      }
+    }
+    return out;
+  }
+
+ private:
+  static void writeVuLong(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+      out.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+  }
+};
+
+template <typename T>
+void testRoundTrip(const std::vector<T>& values) {
+  auto encoded = DeltaBpEncoder::encode(values);
+  DeltaBpDecoder decoder(encoded.data(), encoded.data() + encoded.size());
+  ASSERT_EQ(values.size(), decoder.numValues());
+  std::vector<T> result(values.size());
+  // Read in uneven batches to cross miniblock and block boundaries.
+  int64_t numRead = 0;
+  int64_t batch = 1;
+  while (numRead < values.size()) {
+    auto count = std::min<int64_t>(batch, values.size() - numRead);
+    decoder.next(result.data() + numRead, count);
+    numRead += count;
+    batch = batch * 3 + 1;
+  }
+  EXPECT_EQ(values, result);
+  EXPECT_EQ(encoded.data() + encoded.size(), decoder.skipToEnd());
+}
+
+std::string encodeStrings(
+    const std::vector<std::string>& values,
+    bool withPrefixes) {
+  std::vector<int32_t> prefixes;
+  std::vector<int32_t> lengths;
+  std::string data;
+  for (auto i = 0; i < values.size(); ++i) {
+    int32_t prefix = 0;
+    if (withPrefixes && i > 0) {
+      auto& previous = values[i - 1];
+      while (prefix < previous.size() && prefix < values[i].size() &&
+             previous[prefix] == values[i][prefix]) {
+        ++prefix;
+      }
+    }
+    prefixes.push_back(prefix);
+    lengths.push_back(values[i].size() - prefix);
+    data += values[i].substr(prefix);
+  }
+  std::string encoded;
+  if (withPrefixes) {
+    encoded = DeltaBpEncoder::encode(prefixes);
+  }
+  return encoded + DeltaBpEncoder::encode(lengths) + data;
+}
+
+// Collects the values of all visited rows. Supports the subset of the
+// ColumnVisitor interface used by decoders when there are no nulls.
+struct CollectingVisitor {
+  static constexpr bool dense = false;
+
+  CollectingVisitor(std::vector<int32_t> rows, std::vector<std::string>& result)
+      : rows_(std::move(rows)), result_(result) {}
+
+  int32_t start() {
+    return rows_[0];
+  }
+
+  bool allowNulls() {
+    return false;
+  }
+
+  int32_t processNull(bool& /*atEnd*/) {
+    VELOX_UNREACHABLE();
+  }
+
+  int32_t checkAndSkipNulls(
+      const uint64_t* /*nulls*/,
+      int32_t& /*current*/,
+      bool& /*atEnd*/) {
+    VELOX_UNREACHABLE();
+  }
+
+  int32_t process(folly::StringPiece value, bool& atEnd) {
+    result_.push_back(value.str());
+    if (++index_ == rows_.size()) {
+      atEnd = true;
+      return 0;
+    }
+    return rows_[index_] - rows_[index_ - 1] - 1;
+  }
+
+  std::vector<int32_t> rows_;
+  std::vector<std::string>& result_;
+  int32_t index_{0};
+};
+
+} // namespace
+
+TEST(DeltaBpDecoderTest, int64) {
+  std::mt19937 rng(1);
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1000; ++i) {
+    values.push_back(i * 1000 + rng() % 100);
+  }
+  testRoundTrip(values);
+}
+
+TEST(DeltaBpDecoderTest, int32) {
+  std::mt19937 rng(1);
+  std::vector<int32_t> values;
+  for (auto i = 0; i < 777; ++i) {
+    values.push_back(static_cast<int32_t>(rng()));
+  }
+  testRoundTrip(values);
+}
+
+TEST(DeltaBpDecoderTest, wideDeltas) {
+  std::vector<int64_t> values = {
+      0,
+      std::numeric_limits<int64_t>::max(),
+      std::numeric_limits<int64_t>::min(),
+      -1,
+      1,
+      std::numeric_limits<int64_t>::min()};
+  testRoundTrip(values);
+}
+
+TEST(DeltaBpDecoderTest, constantAndSingle) {
+  testRoundTrip(std::vector<int64_t>(300, 42));
+  testRoundTrip(std::vector<int32_t>{-5});
+  testRoundTrip(std::vector<int32_t>{});
+}
+
+TEST(DeltaBpDecoderTest, byteArray) {
+  std::vector<std::string> values;
+  for (auto i = 0; i < 500; ++i) {
+    values.push_back(fmt::format("prefix_{}_{}", i / 10, i));
+  }
+  values.push_back("");
+  values.push_back("a somewhat longer string that is not inlined");
+  for (auto withPrefixes : {false, true}) {
+    auto encoded = encodeStrings(values, withPrefixes);
+    DeltaByteArrayDecoder decoder(
+        encoded.data(), encoded.data() + encoded.size(), withPrefixes);
+    // Skip the first 10, then visit every third row.
+    decoder.skip(10);
+    std::vector<int32_t> rows;
+    for (auto i = 0; i + 10 < values.size(); i += 3) {
+      rows.push_back(i);
+    }
+    std::vector<std::string> result;
+    decoder.readWithVisitor<false>(nullptr, CollectingVisitor(rows, result));
+    ASSERT_EQ(rows.size(), result.size());
+    for (auto i = 0; i < rows.size(); ++i) {
+      EXPECT_EQ(values[rows[i] + 10], result[i]);
+    }
+  }
+}
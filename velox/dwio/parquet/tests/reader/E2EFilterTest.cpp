@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
 #include <folly/init/Init.h>
@@ -61,8 +63,13 @@ class E2EFilterTest : public E2EFilterTestBase {
     options_.memoryPool = rootPool_.get();
 
     options_.bufferGrowRatio = 2;
-    writer_ = std::make_unique<facebook::velox::parquet::Writer>(
-        std::move(sink), options_);
+    if (useNativeWriter_) {
+      writer_ = std::make_unique<NativeWriter>(
+          std::move(sink), options_, asRowType(batches[0]->type()));
+    } else {
+      writer_ = std::make_unique<facebook::velox::parquet::Writer>(
+          std::move(sink), options_);
+    }
     for (auto& batch : batches) {
       writer_->write(batch);
       writer_->flush();
@@ -77,8 +84,9 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
-  std::unique_ptr<facebook::velox::parquet::Writer> writer_;
+  std::unique_ptr<dwio::common::Writer> writer_;
   facebook::velox::parquet::WriterOptions options_;
+  bool useNativeWriter_{false};
 };
 
 TEST_F(E2EFilterTest, writerMagic) {
@@ -93,6 +101,34 @@ TEST_F(E2EFilterTest, writerMagic) {
   EXPECT_EQ("PAR1", std::string(data + size - 4, 4));
 }
 
+TEST_F(E2EFilterTest, nativeWriter) {
+  useNativeWriter_ = true;
+  options_.dataPageSize = 4 * 1024;
+  testWithTypes(
+      "boolean_val:boolean,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint,"
+      "float_val:float,"
+      "double_val:double,"
+      "string_val:string,"
+      "date_val:date",
+      [&]() { makeAllNulls("long_null"); },
+      false,
+      {"short_val", "int_val", "long_val", "string_val"},
+      20);
+
+  options_.compression = dwio::common::CompressionKind_SNAPPY;
+  testWithTypes(
+      "int_val:int,"
+      "string_val:string",
+      nullptr,
+      false,
+      {"int_val", "string_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, boolean) {
   testWithTypes(
       "boolean_val:boolean,"
@@ -117,15 +153,38 @@ TEST_F(E2EFilterTest, integerDirect) {
       {"short_val", "int_val", "long_val"},
       20);
 }
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.encoding = ::parquet::Encoding::DELTA_BINARY_PACKED;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {dwio::common::CompressionKind_SNAPPY,
         dwio::common::CompressionKind_ZSTD,
         dwio::common::CompressionKind_GZIP,
+        dwio::common::CompressionKind_LZ4,
+        dwio::common::CompressionKind_LZ4_HADOOP,
+        dwio::common::CompressionKind_BROTLI,
         dwio::common::CompressionKind_NONE}) {
     if (!facebook::velox::parquet::Writer::isCodecAvailable(compression)) {
       continue;
     }
+    if (compression != dwio::common::CompressionKind_NONE &&
+        !dwio::common::compression::isDecompressorAvailable(compression)) {
+      continue;
+    }
 
     options_.dataPageSize = 4 * 1024;
     options_.compression = compression;
@@ -214,6 +273,86 @@ TEST_F(E2EFilterTest, integerDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, dictionaryRowGroupSkip) {
+  // Each row group has the multiples of 10 from 0 to 990. A filter on a value
+  // in that range that is not a multiple of 10 passes the min/max stats but no
+  // dictionary entry, so all row groups are skipped.
+  constexpr int32_t kNumBatches = 4;
+  rowType_ = ROW({"long_val", "string_val"}, {BIGINT(), VARCHAR()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto longs = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), kRowsInGroup, leafPool_.get());
+    auto strings = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kRowsInGroup, leafPool_.get());
+    for (auto row = 0; row < kRowsInGroup; ++row) {
+      auto value = (row % 100) * 10;
+      longs->set(row, value);
+      // Inlined in the StringView.
+      auto string = fmt::format("s{}", value);
+      strings->set(row, StringView(string));
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        kRowsInGroup,
+        std::vector<VectorPtr>{longs, strings}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto readWithFilter = [&](const std::string& column,
+                            std::unique_ptr<Filter> filter,
+                            int64_t expectedRows,
+                            int64_t expectedSkipped) {
+    SCOPED_TRACE(filter->toString());
+    ReaderOptions readerOpts{leafPool_.get()};
+    std::string_view data(sinkPtr_->getData(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName(column)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(rowType_, 1, leafPool_.get());
+    int64_t numRows = 0;
+    while (rowReader->next(1'000, result)) {
+      numRows += result->size();
+    }
+    RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(numRows, expectedRows);
+    EXPECT_EQ(stats.skippedStrides, expectedSkipped);
+  };
+
+  const int64_t kRowsPerValue = kNumBatches * kRowsInGroup / 100;
+  readWithFilter(
+      "long_val", std::make_unique<BigintRange>(5, 5, false), 0, kNumBatches);
+  readWithFilter(
+      "long_val",
+      std::make_unique<BigintRange>(21, 29, false),
+      0,
+      kNumBatches);
+  readWithFilter(
+      "long_val",
+      std::make_unique<BigintRange>(20, 20, false),
+      kRowsPerValue,
+      0);
+  readWithFilter(
+      "string_val",
+      std::make_unique<BytesValues>(std::vector<std::string>{"s15"}, false),
+      0,
+      kNumBatches);
+  readWithFilter(
+      "string_val",
+      std::make_unique<BytesValues>(std::vector<std::string>{"s150"}, false),
+      kRowsPerValue,
+      0);
+}
+
 TEST_F(E2EFilterTest, floatAndDoubleDirect) {
   options_.enableDictionary = false;
   options_.dataPageSize = 4 * 1024;
@@ -235,6 +374,27 @@ TEST_F(E2EFilterTest, floatAndDoubleDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, floatAndDoubleByteStreamSplit) {
+  options_.enableDictionary = false;
+  options_.encoding = ::parquet::Encoding::BYTE_STREAM_SPLIT;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "float_val:float,"
+      "double_val:double,"
+      "float_val2:float,"
+      "double_val2:double,"
+      "float_null:float",
+      [&]() {
+        makeAllNulls("float_null");
+        makeQuantizedFloat<float>("float_val2", 200, true);
+        makeQuantizedFloat<double>("double_val2", 522, true);
+      },
+      true,
+      {"float_val", "double_val", "float_val2", "double_val2", "float_null"},
+      20);
+}
+
 TEST_F(E2EFilterTest, floatAndDouble) {
   // float_val and double_val may be direct since the
   // values are random.float_val2 and double_val2 are expected to be
@@ -227,6 +227,68 @@ TEST_F(ParquetReaderTest, projectNoColumns) {
   ASSERT_FALSE(rowReader->next(kBatchSize, result));
 }
 
+TEST_F(ParquetReaderTest, filterRemainingRowGroups) {
+  // sample.parquet has 'a' = 1..10 in the first and 11..20 in the second row
+  // group. A filter added after the first row group is started prunes the
+  // second row group.
+  auto rowType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
+  ReaderOptions readerOpts{defaultPool.get()};
+  ParquetReader reader =
+      createReader(getExampleFilePath("sample.parquet"), readerOpts);
+  auto scanSpec = makeScanSpec(rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+  auto result = BaseVector::create(rowType, 1, pool_.get());
+  ASSERT_EQ(rowReader->next(5, result), 5);
+  EXPECT_EQ(result->size(), 5);
+
+  scanSpec->childByName("a")->addFilter(*lessThanOrEqual(7));
+  scanSpec->resetCachedValues(true);
+  rowReader->resetFilterCaches();
+  ASSERT_EQ(rowReader->next(5, result), 5);
+  ASSERT_EQ(result->size(), 2);
+  auto a = result->as<RowVector>()->childAt(0)->asFlatVector<int64_t>();
+  EXPECT_EQ(a->valueAt(0), 6);
+  EXPECT_EQ(a->valueAt(1), 7);
+  ASSERT_EQ(rowReader->next(5, result), 0);
+
+  RuntimeStatistics stats;
+  rowReader->updateRuntimeStats(stats);
+  EXPECT_EQ(stats.skippedStrides, 1);
+  EXPECT_EQ(stats.processedStrides, 1);
+}
+
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  auto metadataCache = std::make_shared<cache::FileMetadataCache>(1 << 20, 0);
+  const auto path = getExampleFilePath("sample.parquet");
+  auto rowType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
+  ReaderOptions readerOpts{defaultPool.get()};
+  readerOpts.setFileMetadataCache(metadataCache, path);
+  for (auto i = 0; i < 2; ++i) {
+    ParquetReader reader = createReader(path, readerOpts);
+    EXPECT_EQ(reader.numberOfRows(), 20ULL);
+    EXPECT_EQ(2, reader.numberOfRowGroups());
+
+    // The rows are read the same with a cached footer.
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(makeScanSpec(rowType));
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    auto expected = vectorMaker_->rowVector(
+        {vectorMaker_->flatVector<int64_t>(20, [](auto row) {
+           return row + 1;
+         }),
+         vectorMaker_->flatVector<double>(20, [](auto row) {
+           return row + 1;
+         })});
+    assertReadExpected(rowType, *rowReader, expected, *pool_);
+  }
+  auto stats = metadataCache->stats();
+  EXPECT_EQ(1, stats.numEntries);
+  EXPECT_EQ(2, stats.numLookups);
+  EXPECT_EQ(1, stats.numHits);
+}
+
 TEST_F(ParquetReaderTest, parseIntDecimal) {
   // decimal_dict.parquet two columns (a: DECIMAL(7,2), b: DECIMAL(14,2)) and
   // 6 rows.
@@ -0,0 +1,650 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+
+#include <cmath>
+
+#include <arrow/util/compression.h> // @manual
+#include <folly/Random.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+namespace {
+constexpr char kMagic[] = "PAR1";
+constexpr int32_t kMagicSize = 4;
+
+void appendBytes(DataBuffer<char>& buffer, const void* data, uint64_t size) {
+  if (size > 0) {
+    buffer.extendAppend(
+        buffer.size(), reinterpret_cast<const char*>(data), size);
+  }
+}
+
+// Empties 'buffer'. An unallocated DataBuffer cannot be resized.
+void clearBuffer(DataBuffer<char>& buffer) {
+  if (buffer.capacity() > 0) {
+    buffer.resize(0);
+  }
+}
+
+template <typename T>
+void appendValue(DataBuffer<char>& buffer, T value) {
+  appendBytes(buffer, &value, sizeof(T));
+}
+
+template <typename T>
+void serializeThrift(const T& object, DataBuffer<char>& buffer) {
+  auto transport =
+      std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(transport);
+  object.write(&protocol);
+  uint8_t* data;
+  uint32_t size;
+  transport->getBuffer(&data, &size);
+  appendBytes(buffer, data, size);
+}
+
+thrift::CompressionCodec::type thriftCodec(
+    dwio::common::CompressionKind compression) {
+  switch (compression) {
+    case dwio::common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case dwio::common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case dwio::common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case dwio::common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    case dwio::common::CompressionKind_LZ4:
+      return thrift::CompressionCodec::LZ4_RAW;
+    case dwio::common::CompressionKind_LZ4_HADOOP:
+      return thrift::CompressionCodec::LZ4;
+    case dwio::common::CompressionKind_BROTLI:
+      return thrift::CompressionCodec::BROTLI;
+    default:
+      VELOX_UNSUPPORTED("Unsupported Parquet compression {}", compression);
+  }
+}
+
+thrift::Type::type physicalType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::BOOLEAN:
+      return thrift::Type::BOOLEAN;
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::DATE:
+      return thrift::Type::INT32;
+    case TypeKind::BIGINT:
+      return thrift::Type::INT64;
+    case TypeKind::REAL:
+      return thrift::Type::FLOAT;
+    case TypeKind::DOUBLE:
+      return thrift::Type::DOUBLE;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return thrift::Type::BYTE_ARRAY;
+    default:
+      VELOX_UNSUPPORTED("Unsupported type for Parquet: {}", type.toString());
+  }
+}
+} // namespace
+
+/// Encodes the values of one column of the current row group into data pages.
+class ColumnChunkWriter {
+ public:
+  ColumnChunkWriter(
+      std::string name,
+      TypePtr type,
+      const WriterOptions& options,
+      memory::MemoryPool& pool)
+      : name_(std::move(name)),
+        type_(std::move(type)),
+        physicalType_(physicalType(*type_)),
+        codecType_(thriftCodec(options.compression)),
+        dataPageSize_(options.dataPageSize),
+        values_(pool),
+        levels_(pool),
+        pageBody_(pool),
+        compressed_(pool),
+        pages_(pool) {
+    if (codecType_ != thrift::CompressionCodec::UNCOMPRESSED) {
+      auto codec = arrow::util::Codec::Create(
+          getArrowParquetCompression(options.compression));
+      VELOX_CHECK(
+          codec.ok(),
+          "Cannot create Parquet codec: {}",
+          codec.status().ToString());
+      codec_ = std::move(codec).ValueOrDie();
+    }
+  }
+
+  /// Appends the first 'size' rows of 'vector'.
+  void append(const BaseVector& vector, vector_size_t size) {
+    decoded_.decode(vector);
+    switch (type_->kind()) {
+      case TypeKind::BOOLEAN:
+        appendRows(size, [&](vector_size_t row) {
+          appendBool(decoded_.valueAt<bool>(row));
+        });
+        break;
+      case TypeKind::TINYINT:
+        appendInts<int8_t>(size);
+        break;
+      case TypeKind::SMALLINT:
+        appendInts<int16_t>(size);
+        break;
+      case TypeKind::INTEGER:
+        appendInts<int32_t>(size);
+        break;
+      case TypeKind::DATE:
+        appendRows(size, [&](vector_size_t row) {
+          auto days = decoded_.valueAt<Date>(row).days();
+          appendValue<int32_t>(values_, days);
+          updateIntStats(days);
+        });
+        break;
+      case TypeKind::BIGINT:
+        appendRows(size, [&](vector_size_t row) {
+          auto value = decoded_.valueAt<int64_t>(row);
+          appendValue<int64_t>(values_, value);
+          updateIntStats(value);
+        });
+        break;
+      case TypeKind::REAL:
+        appendFloats<float>(size);
+        break;
+      case TypeKind::DOUBLE:
+        appendFloats<double>(size);
+        break;
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        appendRows(size, [&](vector_size_t row) {
+          auto value = decoded_.valueAt<StringView>(row);
+          appendValue<int32_t>(values_, value.size());
+          appendBytes(values_, value.data(), value.size());
+          updateStringStats(value);
+        });
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+
+  /// Returns the schema element describing the column.
+  thrift::SchemaElement schemaElement() const {
+    thrift::SchemaElement element;
+    element.__set_name(name_);
+    element.__set_type(physicalType_);
+    element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+    switch (type_->kind()) {
+      case TypeKind::TINYINT:
+        element.__set_converted_type(thrift::ConvertedType::INT_8);
+        break;
+      case TypeKind::SMALLINT:
+        element.__set_converted_type(thrift::ConvertedType::INT_16);
+        break;
+      case TypeKind::DATE:
+        element.__set_converted_type(thrift::ConvertedType::DATE);
+        break;
+      case TypeKind::VARCHAR:
+        element.__set_converted_type(thrift::ConvertedType::UTF8);
+        break;
+      default:
+        break;
+    }
+    return element;
+  }
+
+  /// Number of bytes buffered for the current row group.
+  int64_t bufferedBytes() const {
+    return pages_.size() + values_.size() + levels_.size();
+  }
+
+  /// Finishes the column chunk of the current row group and writes its pages
+  /// to 'sink'. 'fileOffset' is the offset of the chunk in the file. Returns
+  /// the metadata for the chunk.
+  thrift::ColumnChunk finish(int64_t fileOffset, dwio::common::DataSink& sink) {
+    if (numValuesInPage_ > 0) {
+      finishPage();
+    }
+    thrift::ColumnMetaData metaData;
+    metaData.type = physicalType_;
+    metaData.encodings = {thrift::Encoding::PLAIN, thrift::Encoding::RLE};
+    metaData.path_in_schema = {name_};
+    metaData.codec = codecType_;
+    metaData.num_values = numValues_;
+    metaData.total_uncompressed_size = totalUncompressedSize_;
+    metaData.total_compressed_size = totalCompressedSize_;
+    metaData.data_page_offset = fileOffset;
+    metaData.__set_statistics(statistics());
+
+    thrift::ColumnChunk chunk;
+    chunk.file_offset = fileOffset;
+    chunk.__set_meta_data(metaData);
+
+    if (pages_.size() > 0) {
+      sink.write(std::move(pages_));
+    }
+    numValues_ = 0;
+    numNulls_ = 0;
+    totalUncompressedSize_ = 0;
+    totalCompressedSize_ = 0;
+    hasMinMax_ = false;
+    return chunk;
+  }
+
+ private:
+  // Calls 'appendNonNull' for each non-null row of the first 'size' rows and
+  // records the definition levels of all rows.
+  template <typename F>
+  void appendRows(vector_size_t size, F appendNonNull) {
+    for (vector_size_t row = 0; row < size; ++row) {
+      if (decoded_.isNullAt(row)) {
+        appendLevel(0);
+        ++numNulls_;
+      } else {
+        appendLevel(1);
+        appendNonNull(row);
+      }
+      ++numValuesInPage_;
+      if (values_.size() >= dataPageSize_) {
+        finishPage();
+      }
+    }
+  }
+
+  template <typename T>
+  void appendInts(vector_size_t size) {
+    appendRows(size, [&](vector_size_t row) {
+      int32_t value = decoded_.valueAt<T>(row);
+      appendValue<int32_t>(values_, value);
+      updateIntStats(value);
+    });
+  }
+
+  template <typename T>
+  void appendFloats(vector_size_t size) {
+    appendRows(size, [&](vector_size_t row) {
+      auto value = decoded_.valueAt<T>(row);
+      appendValue<T>(values_, value);
+      updateDoubleStats(value);
+    });
+  }
+
+  // Booleans are bit packed LSB first.
+  void appendBool(bool value) {
+    if (numBoolsInPage_ % 8 == 0) {
+      values_.append(0);
+    }
+    if (value) {
+      values_.data()[values_.size() - 1] |= 1 << (numBoolsInPage_ % 8);
+    }
+    ++numBoolsInPage_;
+  }
+
+  void updateIntStats(int64_t value) {
+    if (!hasMinMax_) {
+      intMin_ = intMax_ = value;
+      hasMinMax_ = true;
+    } else {
+      intMin_ = std::min(intMin_, value);
+      intMax_ = std::max(intMax_, value);
+    }
+  }
+
+  void updateDoubleStats(double value) {
+    if (std::isnan(value)) {
+      // NaN is not ordered and is left out of min and max.
+      return;
+    }
+    if (!hasMinMax_) {
+      doubleMin_ = doubleMax_ = value;
+      hasMinMax_ = true;
+    } else {
+      doubleMin_ = std::min(doubleMin_, value);
+      doubleMax_ = std::max(doubleMax_, value);
+    }
+  }
+
+  void updateStringStats(StringView value) {
+    if (!hasMinMax_) {
+      stringMin_ = value.str();
+      stringMax_ = value.str();
+      hasMinMax_ = true;
+    } else if (value < StringView(stringMin_)) {
+      stringMin_ = value.str();
+    } else if (StringView(stringMax_) < value) {
+      stringMax_ = value.str();
+    }
+  }
+
+  thrift::Statistics statistics() const {
+    thrift::Statistics stats;
+    stats.__set_null_count(numNulls_);
+    if (!hasMinMax_) {
+      return stats;
+    }
+    switch (physicalType_) {
+      case thrift::Type::INT32:
+        stats.__set_min_value(encodePlain<int32_t>(intMin_));
+        stats.__set_max_value(encodePlain<int32_t>(intMax_));
+        break;
+      case thrift::Type::INT64:
+        stats.__set_min_value(encodePlain<int64_t>(intMin_));
+        stats.__set_max_value(encodePlain<int64_t>(intMax_));
+        break;
+      case thrift::Type::FLOAT:
+        // -0.0 and 0.0 compare equal, so the bounds must cover both.
+        stats.__set_min_value(encodePlain<float>(
+            doubleMin_ == 0 ? -0.0f : static_cast<float>(doubleMin_)));
+        stats.__set_max_value(encodePlain<float>(
+            doubleMax_ == 0 ? 0.0f : static_cast<float>(doubleMax_)));
+        break;
+      case thrift::Type::DOUBLE:
+        stats.__set_min_value(
+            encodePlain<double>(doubleMin_ == 0 ? -0.0 : doubleMin_));
+        stats.__set_max_value(
+            encodePlain<double>(doubleMax_ == 0 ? 0.0 : doubleMax_));
+        break;
+      case thrift::Type::BYTE_ARRAY:
+        stats.__set_min_value(stringMin_);
+        stats.__set_max_value(stringMax_);
+        break;
+      default:
+        break;
+    }
+    return stats;
+  }
+
+  template <typename T>
+  static std::string encodePlain(T value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  // Definition levels are written as RLE runs of bit width 1.
+  void appendLevel(uint8_t level) {
+    if (levelRunLength_ > 0 && level != runLevel_) {
+      finishLevelRun();
+    }
+    runLevel_ = level;
+    ++levelRunLength_;
+  }
+
+  void finishLevelRun() {
+    uint64_t header = static_cast<uint64_t>(levelRunLength_) << 1;
+    while (header >= 0x80) {
+      levels_.append(static_cast<char>(header | 0x80));
+      header >>= 7;
+    }
+    levels_.append(static_cast<char>(header));
+    levels_.append(static_cast<char>(runLevel_));
+    levelRunLength_ = 0;
+  }
+
+  void finishPage() {
+    if (levelRunLength_ > 0) {
+      finishLevelRun();
+    }
+    // V1 pages prefix the RLE definition levels with their length.
+    clearBuffer(pageBody_);
+    appendValue<int32_t>(pageBody_, levels_.size());
+    appendBytes(pageBody_, levels_.data(), levels_.size());
+    appendBytes(pageBody_, values_.data(), values_.size());
+
+    const char* body = pageBody_.data();
+    int64_t bodySize = pageBody_.size();
+    if (codec_) {
+      auto maxSize = codec_->MaxCompressedLen(
+          bodySize, reinterpret_cast<const uint8_t*>(body));
+      compressed_.resize(maxSize);
+      auto compressedSize = codec_->Compress(
+          bodySize,
+          reinterpret_cast<const uint8_t*>(body),
+          maxSize,
+          reinterpret_cast<uint8_t*>(compressed_.data()));
+      VELOX_CHECK(
+          compressedSize.ok(),
+          "Parquet page compression failed: {}",
+          compressedSize.status().ToString());
+      body = compressed_.data();
+      bodySize = compressedSize.ValueOrDie();
+    }
+
+    thrift::PageHeader header;
+    header.type = thrift::PageType::DATA_PAGE;
+    header.uncompressed_page_size = pageBody_.size();
+    header.compressed_page_size = bodySize;
+    thrift::DataPageHeader dataPageHeader;
+    dataPageHeader.num_values = numValuesInPage_;
+    dataPageHeader.encoding = thrift::Encoding::PLAIN;
+    dataPageHeader.definition_level_encoding = thrift::Encoding::RLE;
+    dataPageHeader.repetition_level_encoding = thrift::Encoding::RLE;
+    header.__set_data_page_header(dataPageHeader);
+
+    auto headerStart = pages_.size();
+    serializeThrift(header, pages_);
+    auto headerSize = pages_.size() - headerStart;
+    appendBytes(pages_, body, bodySize);
+
+    totalUncompressedSize_ += headerSize + pageBody_.size();
+    totalCompressedSize_ += headerSize + bodySize;
+    numValues_ += numValuesInPage_;
+    numValuesInPage_ = 0;
+    numBoolsInPage_ = 0;
+    clearBuffer(values_);
+    clearBuffer(levels_);
+  }
+
+  const std::string name_;
+  const TypePtr type_;
+  const thrift::Type::type physicalType_;
+  const thrift::CompressionCodec::type codecType_;
+  const uint64_t dataPageSize_;
+  std::unique_ptr<arrow::util::Codec> codec_;
+
+  DecodedVector decoded_;
+
+  // PLAIN encoded values of the current page.
+  DataBuffer<char> values_;
+
+  // RLE encoded definition levels of the current page.
+  DataBuffer<char> levels_;
+
+  // Scratch for assembling and compressing a page.
+  DataBuffer<char> pageBody_;
+  DataBuffer<char> compressed_;
+
+  // Finished pages of the current column chunk, with headers.
+  DataBuffer<char> pages_;
+
+  // State of the definition level run being accumulated.
+  uint8_t runLevel_{0};
+  int32_t levelRunLength_{0};
+
+  int32_t numValuesInPage_{0};
+  int32_t numBoolsInPage_{0};
+
+  // Totals for the current column chunk.
+  int64_t numValues_{0};
+  int64_t numNulls_{0};
+  int64_t totalUncompressedSize_{0};
+  int64_t totalCompressedSize_{0};
+
+  // Min and max of the non-null values of the column chunk.
+  bool hasMinMax_{false};
+  int64_t intMin_{0};
+  int64_t intMax_{0};
+  double doubleMin_{0};
+  double doubleMax_{0};
+  std::string stringMin_;
+  std::string stringMax_;
+};
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::DataSink> sink,
+    const WriterOptions& options,
+    std::shared_ptr<memory::MemoryPool> pool,
+    RowTypePtr schema)
+    : schema_(std::move(schema)),
+      rowsInRowGroup_(options.rowsInRowGroup),
+      bytesInRowGroup_(options.bytesInRowGroup),
+      pool_(std::move(pool)),
+      generalPool_{pool_->addLeafChild(".general")},
+      sink_(std::move(sink)) {
+  VELOX_CHECK(
+      isSupported(schema_),
+      "Unsupported schema for native Parquet writer: {}",
+      schema_->toString());
+  for (auto i = 0; i < schema_->size(); ++i) {
+    columns_.push_back(std::make_unique<ColumnChunkWriter>(
+        schema_->nameOf(i), schema_->childAt(i), options, *generalPool_));
+  }
+  writeToSink(kMagic, kMagicSize);
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::DataSink> sink,
+    const WriterOptions& options,
+    RowTypePtr schema)
+    : NativeWriter{
+          std::move(sink),
+          options,
+          options.memoryPool->addAggregateChild(fmt::format(
+              "writer_node_{}",
+              folly::to<std::string>(folly::Random::rand64()))),
+          std::move(schema)} {}
+
+NativeWriter::~NativeWriter() = default;
+
+// static
+bool NativeWriter::isSupported(const RowTypePtr& type) {
+  for (auto& child : type->children()) {
+    if (child->isDecimal()) {
+      return false;
+    }
+    switch (child->kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+      case TypeKind::DATE:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+// static
+bool NativeWriter::isCodecAvailable(
+    dwio::common::CompressionKind compression) {
+  return compression == dwio::common::CompressionKind_NONE ||
+      parquet::Writer::isCodecAvailable(compression);
+}
+
+void NativeWriter::write(const VectorPtr& data) {
+  VELOX_CHECK(!closed_, "Writing to a closed Parquet writer");
+  auto row = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(row, "Parquet writer expects a RowVector");
+  VELOX_CHECK_EQ(row->childrenSize(), columns_.size());
+  auto size = row->size();
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns_[i]->append(*row->childAt(i), size);
+  }
+  stagingRows_ += size;
+  int64_t bytes = 0;
+  for (auto& column : columns_) {
+    bytes += column->bufferedBytes();
+  }
+  if (stagingRows_ >= rowsInRowGroup_ || bytes >= bytesInRowGroup_) {
+    flush();
+  }
+}
+
+void NativeWriter::flush() {
+  if (stagingRows_ == 0) {
+    return;
+  }
+  thrift::RowGroup rowGroup;
+  rowGroup.num_rows = stagingRows_;
+  rowGroup.__set_file_offset(fileOffset_);
+  int64_t totalCompressedSize = 0;
+  for (auto& column : columns_) {
+    auto chunk = column->finish(fileOffset_, *sink_);
+    auto& metaData = chunk.meta_data;
+    fileOffset_ += metaData.total_compressed_size;
+    totalCompressedSize += metaData.total_compressed_size;
+    rowGroup.total_byte_size += metaData.total_uncompressed_size;
+    rowGroup.columns.push_back(std::move(chunk));
+  }
+  rowGroup.__set_total_compressed_size(totalCompressedSize);
+  rowGroups_.push_back(std::move(rowGroup));
+  numRows_ += stagingRows_;
+  stagingRows_ = 0;
+}
+
+void NativeWriter::close() {
+  if (closed_) {
+    return;
+  }
+  flush();
+  thrift::FileMetaData metaData;
+  metaData.version = 1;
+  thrift::SchemaElement root;
+  root.__set_name("schema");
+  root.__set_num_children(columns_.size());
+  metaData.schema.push_back(root);
+  for (auto& column : columns_) {
+    metaData.schema.push_back(column->schemaElement());
+  }
+  metaData.num_rows = numRows_;
+  metaData.row_groups = std::move(rowGroups_);
+  metaData.__set_created_by("velox");
+
+  DataBuffer<char> footer(*generalPool_);
+  serializeThrift(metaData, footer);
+  appendValue<int32_t>(footer, footer.size());
+  appendBytes(footer, kMagic, kMagicSize);
+  fileOffset_ += footer.size();
+  sink_->write(std::move(footer));
+  sink_->close();
+  closed_ = true;
+}
+
+void NativeWriter::writeToSink(const char* data, int32_t size) {
+  DataBuffer<char> buffer(*generalPool_);
+  appendBytes(buffer, data, size);
+  sink_->write(std::move(buffer));
+  fileOffset_ += size;
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/common/DataSink.h"
+#include "velox/dwio/common/Writer.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+
+namespace facebook::velox::parquet {
+
+class ColumnChunkWriter;
+
+/// Writes Velox vectors into a DataSink as Parquet without going through
+/// Arrow. Columns are read with DecodedVector, so dictionary, constant and
+/// lazy vectors are encoded without being flattened first. All buffers come
+/// from the writer's MemoryPool. Supports top level columns of BOOLEAN,
+/// TINYINT, SMALLINT, INTEGER, BIGINT, REAL, DOUBLE, VARCHAR, VARBINARY and
+/// DATE. Values are PLAIN encoded into V1 data pages with RLE definition
+/// levels.
+class NativeWriter : public dwio::common::Writer {
+ public:
+  NativeWriter(
+      std::unique_ptr<dwio::common::DataSink> sink,
+      const WriterOptions& options,
+      std::shared_ptr<memory::MemoryPool> pool,
+      RowTypePtr schema);
+
+  NativeWriter(
+      std::unique_ptr<dwio::common::DataSink> sink,
+      const WriterOptions& options,
+      RowTypePtr schema);
+
+  ~NativeWriter() override;
+
+  /// True if all columns of 'type' can be written by NativeWriter.
+  static bool isSupported(const RowTypePtr& type);
+
+  /// True if pages can be compressed with 'compression'.
+  static bool isCodecAvailable(dwio::common::CompressionKind compression);
+
+  /// Appends 'data' into the writer. Starts a new row group when the buffered
+  /// rows or bytes exceed the limits in WriterOptions.
+  void write(const VectorPtr& data) override;
+
+  /// Writes the buffered rows as a row group.
+  void flush() override;
+
+  /// Flushes and writes the footer. Data can no longer be added.
+  void close() override;
+
+ private:
+  void writeToSink(const char* data, int32_t size);
+
+  const RowTypePtr schema_;
+  const int64_t rowsInRowGroup_;
+  const int64_t bytesInRowGroup_;
+
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::shared_ptr<memory::MemoryPool> generalPool_;
+  std::unique_ptr<dwio::common::DataSink> sink_;
+
+  std::vector<std::unique_ptr<ColumnChunkWriter>> columns_;
+
+  // Metadata of the row groups written so far.
+  std::vector<thrift::RowGroup> rowGroups_;
+
+  // Rows buffered in 'columns_' and not yet written.
+  int64_t stagingRows_{0};
+
+  // Number of bytes written to 'sink_'.
+  int64_t fileOffset_{0};
+
+  int64_t numRows_{0};
+  bool closed_{false};
+};
+
+} // namespace facebook::velox::parquet
@@ -19,9 +19,17 @@
 #include <arrow/c/bridge.h> // @manual
 #include <arrow/record_batch.h>
 #include <arrow/table.h> // @manual
+#include <gflags/gflags.h>
 #include <parquet/arrow/writer.h> // @manual
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
+DEFINE_bool(
+    parquet_native_writer,
+    false,
+    "Write Parquet files with NativeWriter instead of the Arrow writer when "
+    "the schema is supported by NativeWriter");
+
 namespace facebook::velox::parquet {
 
 // Utility for buffering Arrow output with a DataBuffer.
@@ -97,6 +105,13 @@ struct ArrowContext {
     return ::parquet::Compression::GZIP;
   } else if (compression == dwio::common::CompressionKind_ZSTD) {
     return ::parquet::Compression::ZSTD;
+  } else if (compression == dwio::common::CompressionKind_LZ4) {
+    // Written as LZ4_RAW.
+    return ::parquet::Compression::LZ4;
+  } else if (compression == dwio::common::CompressionKind_LZ4_HADOOP) {
+    return ::parquet::Compression::LZ4_HADOOP;
+  } else if (compression == dwio::common::CompressionKind_BROTLI) {
+    return ::parquet::Compression::BROTLI;
   } else if (compression == dwio::common::CompressionKind_NONE) {
     return ::parquet::Compression::UNCOMPRESSED;
   } else {
@@ -115,6 +130,9 @@ std::shared_ptr<::parquet::WriterProperties> getArrowParquetWriterOptions(
       properties->compression(getArrowParquetCompression(options.compression));
   properties = properties->data_pagesize(options.dataPageSize);
   properties = properties->max_row_group_length(options.maxRowGroupLength);
+  if (options.encoding.has_value()) {
+    properties = properties->encoding(options.encoding.value());
+  }
   return properties->build();
 }
 
@@ -283,6 +301,14 @@ std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
     std::unique_ptr<dwio::common::DataSink> sink,
     const dwio::common::WriterOptions& options) {
   auto parquetOptions = getParquetOptions(options);
+  if (FLAGS_parquet_native_writer && options.schema &&
+      options.schema->isRow()) {
+    auto rowType = asRowType(options.schema);
+    if (NativeWriter::isSupported(rowType)) {
+      return std::make_unique<NativeWriter>(
+          std::move(sink), parquetOptions, rowType);
+    }
+  }
   return std::make_unique<Writer>(std::move(sink), parquetOptions);
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <arrow/type.h>
+#include <parquet/types.h> // @manual
 #include "velox/dwio/common/Common.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/DataSink.h"
@@ -41,6 +42,9 @@ struct WriterOptions {
   double bufferGrowRatio = 1;
   dwio::common::CompressionKind compression =
       dwio::common::CompressionKind_NONE;
+  // Encoding for pages that are not dictionary encoded. Arrow's default
+  // (PLAIN) is used if not set.
+  std::optional<::parquet::Encoding::type> encoding;
   velox::memory::MemoryPool* memoryPool;
 };
 
@@ -97,6 +101,10 @@ class Writer : public dwio::common::Writer {
   std::shared_ptr<ArrowContext> arrowContext_;
 };
 
+// Returns the Arrow codec for 'compression'.
+::parquet::Compression::type getArrowParquetCompression(
+    dwio::common::CompressionKind compression);
+
 class ParquetWriterFactory : public dwio::common::WriterFactory {
  public:
   ParquetWriterFactory() : WriterFactory(dwio::common::FileFormat::PARQUET) {}
@@ -264,6 +264,27 @@ class Aggregate {
     return numNulls_ && (group[nullByte_] & nullMask_);
   }
 
+  // Calls 'updateRun(group, begin, end)' for each run of consecutive rows in
+  // [begin, end) of 'groups' that go to the same group. All the rows of the
+  // range must be selected. Updating a run at a time keeps the accumulator in
+  // registers when the input is clustered on the grouping keys.
+  template <typename UpdateRun>
+  static void forEachGroupRun(
+      char** groups,
+      vector_size_t begin,
+      vector_size_t end,
+      UpdateRun updateRun) {
+    while (begin < end) {
+      char* group = groups[begin];
+      auto runEnd = begin + 1;
+      while (runEnd < end && groups[runEnd] == group) {
+        ++runEnd;
+      }
+      updateRun(group, begin, runEnd);
+      begin = runEnd;
+    }
+  }
+
   // Sets null flag for all specified groups to true.
   // For any given group, this method can be called at most once.
   void setAllNulls(char** groups, folly::Range<const vector_size_t*> indices) {
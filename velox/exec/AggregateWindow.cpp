@@ -57,6 +57,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // the function value for each row.
     aggregate_ = exec::Aggregate::create(
         name, core::AggregationNode::Step::kSingle, argTypes_, resultType);
+    intermediateType_ = exec::Aggregate::intermediateType(name, argTypes_);
     aggregate_->setAllocator(stringAllocator_);
 
     // Aggregate initialization.
@@ -104,6 +105,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
   }
 
   void apply(
@@ -151,6 +153,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+      if (segmentTree_.empty()) {
+        buildSegmentTree();
+      }
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -336,9 +344,159 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setNullEmptyFramesResults(validRows, resultOffset, result);
   }
 
+  // Returns true if the frames of this block are wide enough for the
+  // segment tree to be cheaper than aggregating each frame from its rows.
+  // Once the tree is built it is used for the rest of the partition.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds) const {
+    if (!segmentTree_.empty()) {
+      return true;
+    }
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
+    });
+    return numFrameRows >=
+        validRows.countSelected() * kMinAverageFrameSizeForSegmentTree;
+  }
+
+  // Builds the intermediate accumulator states of the segment tree for the
+  // whole partition. Level 0 has the state of each row. Each state of level
+  // l + 1 merges 2 adjacent states of level l, so level l has a state for
+  // each aligned run of 2^l rows. Runs past the end of the partition are
+  // never needed and are not built.
+  void buildSegmentTree() {
+    const auto numRows = partition_->numRows();
+    std::vector<VectorPtr> args;
+    args.reserve(argIndices_.size());
+    for (auto i = 0; i < argIndices_.size(); ++i) {
+      if (argIndices_[i] == kConstantChannel) {
+        args.push_back(argVectors_[i]);
+      } else {
+        auto column = BaseVector::create(argTypes_[i], numRows, pool_);
+        partition_->extractColumn(argIndices_[i], 0, numRows, 0, column);
+        args.push_back(std::move(column));
+      }
+    }
+
+    // One group row per state of the level being built. The rows have the
+    // layout of the single group row.
+    const auto rowSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    auto groupsBuffer = AlignedBuffer::allocate<char>(
+        static_cast<size_t>(numRows) * rowSize, pool_);
+    std::vector<char*> groups(numRows);
+    std::vector<vector_size_t> indices(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      groups[i] = groupsBuffer->asMutable<char>() + i * rowSize;
+      indices[i] = i;
+    }
+    // The group of each input row of the level being built.
+    std::vector<char*> inputGroups(numRows);
+
+    auto buildLevel = [&](vector_size_t numGroups,
+                          const std::vector<VectorPtr>& input,
+                          bool intermediate) {
+      const auto numInputs = intermediate ? numGroups * 2 : numGroups;
+      for (auto i = 0; i < numInputs; ++i) {
+        inputGroups[i] = groups[intermediate ? i / 2 : i];
+      }
+      SelectivityVector rows(numInputs);
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(
+          groups.data(),
+          folly::Range<const vector_size_t*>(indices.data(), numGroups));
+      if (intermediate) {
+        aggregate_->addIntermediateResults(
+            inputGroups.data(), rows, input, false);
+      } else {
+        aggregate_->addRawInput(inputGroups.data(), rows, input, false);
+      }
+      auto states = BaseVector::create(intermediateType_, numGroups, pool_);
+      aggregate_->extractAccumulators(groups.data(), numGroups, &states);
+      aggregate_->destroy(folly::Range(groups.data(), numGroups));
+      segmentTree_.push_back(std::move(states));
+    };
+
+    buildLevel(numRows, args, false);
+    for (auto numGroups = numRows / 2; numGroups > 0; numGroups /= 2) {
+      buildLevel(numGroups, {segmentTree_.back()}, true);
+    }
+  }
+
+  // Computes each frame by merging the O(log n) segment tree states that
+  // exactly cover it. The states are merged in row order so that order
+  // sensitive aggregates see their input in frame order.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* rawFrameStarts,
+      const vector_size_t* rawFrameEnds,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+    // (level, index) of the states covering the start and the end of the
+    // frame. The end states are found from the right.
+    std::vector<std::pair<int32_t, vector_size_t>> startStates;
+    std::vector<std::pair<int32_t, vector_size_t>> endStates;
+    std::vector<VectorPtr> states(1);
+
+    validRows.applyToSelected([&](auto i) {
+      startStates.clear();
+      endStates.clear();
+      vector_size_t begin = rawFrameStarts[i];
+      vector_size_t end = rawFrameEnds[i] + 1;
+      for (int32_t level = 0; begin < end; ++level) {
+        if (begin & 1) {
+          startStates.emplace_back(level, begin++);
+        }
+        if (end & 1) {
+          endStates.emplace_back(level, --end);
+        }
+        begin /= 2;
+        end /= 2;
+      }
+
+      const auto numStates = startStates.size() + endStates.size();
+      if (!states[0]) {
+        states[0] = BaseVector::create(intermediateType_, numStates, pool_);
+      } else {
+        BaseVector::prepareForReuse(states[0], numStates);
+      }
+      vector_size_t index = 0;
+      for (const auto& [level, state] : startStates) {
+        states[0]->copy(segmentTree_[level].get(), index++, state, 1);
+      }
+      for (auto it = endStates.rbegin(); it != endStates.rend(); ++it) {
+        states[0]->copy(segmentTree_[it->first].get(), index++, it->second, 1);
+      }
+
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, SelectivityVector(numStates), states, false);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setNullEmptyFramesResults(validRows, resultOffset, result);
+  }
+
+  // Frames that are on average at least this many rows are computed from the
+  // segment tree instead of from their rows.
+  static constexpr int64_t kMinAverageFrameSizeForSegmentTree = 32;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
+  // Type of the accumulator states in 'segmentTree_'.
+  TypePtr intermediateType_;
+
   bool aggregateInitialized_{false};
 
   // Current WindowPartition used for accessing rows in the apply method.
@@ -366,6 +524,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
+
+  // Intermediate accumulator states of the current partition, one vector per
+  // level of the segment tree. See buildSegmentTree(). Built on first use
+  // when a block has wide frames that can't be aggregated incrementally.
+  std::vector<VectorPtr> segmentTree_;
 };
 
 } // namespace
@@ -39,6 +39,7 @@ class AggregationHook : public ValueHook {
   static constexpr Kind kShortDecimalMin = 12;
   static constexpr Kind kLongDecimalMax = 13;
   static constexpr Kind kLongDecimalMin = 14;
+  static constexpr Kind kCount = 15;
 
   // Make null behavior known at compile time. This is useful when
   // templating a column decoding loop with a hook.
@@ -282,4 +283,41 @@ class MinMaxHook final : public AggregationHook {
   }
 };
 
+// Counts the non-null values of each group. The count is never null, so
+// there is no null flag to clear.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  std::string toString() const override {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "CountHook kind:%d", (int)kind());
+    return buf;
+  }
+
+  Kind kind() const override {
+    return kCount;
+  }
+
+  void addValue(vector_size_t row, const void* /*value*/) override {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+
+  void addValues(
+      const vector_size_t* rows,
+      const void* /*values*/,
+      vector_size_t size,
+      uint8_t /*valueWidth*/) override {
+    for (auto i = 0; i < size; ++i) {
+      ++*reinterpret_cast<int64_t*>(findGroup(rows[i]) + offset_);
+    }
+  }
+};
+
 } // namespace facebook::velox::aggregate
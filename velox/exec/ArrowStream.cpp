@@ -14,7 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/ArrowStream.h"
-#include "velox/vector/arrow/Abi.h"
+#include "velox/exec/Task.h"
+#include "velox/vector/arrow/Bridge.h"
 
 namespace facebook::velox::exec {
 
@@ -27,62 +28,163 @@ ArrowStream::ArrowStream(
           arrowStreamNode->outputType(),
           operatorId,
           arrowStreamNode->id(),
-          "ArrowStream") {
-  arrowStream_ = arrowStreamNode->arrowStream();
+          "ArrowStream"),
+      maxPrefetchBatches_(
+          driverCtx->queryConfig().arrowStreamPrefetchBatches()) {
+  // Driver i reads streams i, i + numDrivers, i + 2 * numDrivers etc.
+  const auto& arrowStreams = arrowStreamNode->arrowStreams();
+  const auto numDrivers = driverCtx->task->numDrivers(driverCtx->driver);
+  for (auto i = driverCtx->driverId; i < arrowStreams.size();
+       i += numDrivers) {
+    arrowStreams_.push_back(arrowStreams[i]);
+  }
+  if (maxPrefetchBatches_ > 0) {
+    executor_ = std::make_unique<folly::IOThreadPoolExecutor>(1);
+  }
 }
 
 ArrowStream::~ArrowStream() {
   close();
 }
 
-RowVectorPtr ArrowStream::getOutput() {
-  // Get Arrow array.
-  struct ArrowArray arrowArray;
-  if (arrowStream_->get_next(arrowStream_.get(), &arrowArray)) {
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
+bool ArrowStream::nextBatch(Batch& batch) {
+  while (streamIndex_ < arrowStreams_.size()) {
+    auto* arrowStream = arrowStreams_[streamIndex_].get();
+    // Get Arrow array.
+    if (arrowStream->get_next(arrowStream, &batch.array)) {
+      if (batch.array.release) {
+        batch.array.release(&batch.array);
+      }
+      VELOX_FAIL(
+          "Failed to call get_next on ArrowStream: {}",
+          std::string(getError(arrowStream)));
     }
-    VELOX_FAIL(
-        "Failed to call get_next on ArrowStream: {}", std::string(getError()));
-  }
-  if (arrowArray.release == nullptr) {
-    // End of Stream.
-    finished_ = true;
-    return nullptr;
+    if (batch.array.release == nullptr) {
+      // End of Stream.
+      ++streamIndex_;
+      continue;
+    }
+
+    // Get Arrow schema.
+    if (arrowStream->get_schema(arrowStream, &batch.schema)) {
+      if (batch.schema.release) {
+        batch.schema.release(&batch.schema);
+      }
+      if (batch.array.release) {
+        batch.array.release(&batch.array);
+      }
+      VELOX_FAIL(
+          "Failed to call get_schema on ArrowStream: {}",
+          std::string(getError(arrowStream)));
+    }
+    return true;
   }
+  return false;
+}
 
-  // Get Arrow schema.
-  struct ArrowSchema arrowSchema;
-  if (arrowStream_->get_schema(arrowStream_.get(), &arrowSchema)) {
-    if (arrowSchema.release) {
-      arrowSchema.release(&arrowSchema);
+RowVectorPtr ArrowStream::getOutput() {
+  Batch batch;
+  if (executor_ == nullptr) {
+    if (!nextBatch(batch)) {
+      finished_ = true;
+      return nullptr;
+    }
+  } else {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (error_) {
+      std::rethrow_exception(error_);
     }
-    if (arrowArray.release) {
-      arrowArray.release(&arrowArray);
+    if (batches_.empty()) {
+      finished_ = atEnd_;
+      return nullptr;
     }
-    VELOX_FAIL(
-        "Failed to call get_schema on ArrowStream: {}",
-        std::string(getError()));
+    batch = batches_.front();
+    batches_.pop_front();
+    maybePrefetchLocked();
   }
 
   // Convert Arrow Array into RowVector and return.
   return std::dynamic_pointer_cast<RowVector>(
-      importFromArrowAsOwner(arrowSchema, arrowArray, pool()));
+      importFromArrowAsOwner(batch.schema, batch.array, pool()));
+}
+
+BlockingReason ArrowStream::isBlocked(ContinueFuture* future) {
+  if (executor_ == nullptr) {
+    return BlockingReason::kNotBlocked;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!batches_.empty() || atEnd_ || error_) {
+    return BlockingReason::kNotBlocked;
+  }
+  maybePrefetchLocked();
+  promises_.emplace_back("ArrowStream::isBlocked");
+  *future = promises_.back().getSemiFuture();
+  return BlockingReason::kWaitForProducer;
+}
+
+void ArrowStream::maybePrefetchLocked() {
+  if (closed_ || prefetching_ || atEnd_ || error_ ||
+      batches_.size() >= static_cast<size_t>(maxPrefetchBatches_)) {
+    return;
+  }
+  prefetching_ = true;
+  executor_->add([this]() { prefetch(); });
+}
+
+void ArrowStream::prefetch() {
+  Batch batch;
+  bool hasBatch = false;
+  std::exception_ptr error;
+  try {
+    hasBatch = nextBatch(batch);
+  } catch (const std::exception&) {
+    error = std::current_exception();
+  }
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    prefetching_ = false;
+    if (error) {
+      error_ = error;
+    } else if (hasBatch) {
+      batches_.push_back(batch);
+    } else {
+      atEnd_ = true;
+    }
+    promises.swap(promises_);
+    maybePrefetchLocked();
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
 }
 
 bool ArrowStream::isFinished() {
   return finished_;
 }
 
-const char* ArrowStream::getError() const {
-  const char* lastError = arrowStream_->get_last_error(arrowStream_.get());
+const char* ArrowStream::getError(ArrowArrayStream* arrowStream) const {
+  const char* lastError = arrowStream->get_last_error(arrowStream);
   VELOX_CHECK_NOT_NULL(lastError);
   return lastError;
 }
 
 void ArrowStream::close() {
-  if (arrowStream_->release) {
-    arrowStream_->release(arrowStream_.get());
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    closed_ = true;
+  }
+  // Waits for a running prefetch() before releasing the streams.
+  executor_.reset();
+  for (auto& batch : batches_) {
+    batch.schema.release(&batch.schema);
+    batch.array.release(&batch.array);
+  }
+  batches_.clear();
+  for (auto& arrowStream : arrowStreams_) {
+    if (arrowStream->release) {
+      arrowStream->release(arrowStream.get());
+    }
   }
   SourceOperator::close();
 }
@@ -13,10 +13,12 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/executors/IOThreadPoolExecutor.h>
+
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Operator.h"
+#include "velox/vector/arrow/Abi.h"
 
-struct ArrowArrayStream;
 namespace facebook::velox::exec {
 
 class ArrowStream : public SourceOperator {
@@ -30,20 +32,56 @@ class ArrowStream : public SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
   void close() override;
 
  private:
+  // An Arrow array pulled from a stream with its schema.
+  struct Batch {
+    ArrowArray array;
+    ArrowSchema schema;
+  };
+
+  /// Pulls the next batch from the streams of this driver into 'batch'.
+  /// Returns false after the end of the last stream.
+  bool nextBatch(Batch& batch);
+
+  /// Pulls a batch on 'executor_' and schedules the next pull while there is
+  /// room in 'batches_'.
+  void prefetch();
+
+  /// Schedules a prefetch() unless one is running, the queue is full or the
+  /// streams are at end.
+  void maybePrefetchLocked();
+
   /// Return last error in Arrow array stream.
-  const char* getError() const;
+  const char* getError(ArrowArrayStream* arrowStream) const;
+
+  const int32_t maxPrefetchBatches_;
+
+  // The streams this driver reads in order.
+  std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams_;
+
+  // The index in 'arrowStreams_' of the stream being read.
+  size_t streamIndex_{0};
 
   bool finished_ = false;
-  std::shared_ptr<ArrowArrayStream> arrowStream_;
+
+  // Runs the prefetch() if 'maxPrefetchBatches_' is not 0.
+  std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
+
+  // Serializes access to the members below between the driver and
+  // 'executor_'.
+  std::mutex mutex_;
+  std::deque<Batch> batches_;
+  bool prefetching_{false};
+  bool atEnd_{false};
+  bool closed_{false};
+  std::exception_ptr error_;
+  std::vector<ContinuePromise> promises_;
 };
 
 } // namespace facebook::velox::exec
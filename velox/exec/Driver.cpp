@@ -17,7 +17,10 @@
 #include <folly/ScopeGuard.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
+#include <folly/lang/Bits.h>
 #include <gflags/gflags.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Operator.h"
@@ -71,7 +74,11 @@ std::optional<Spiller::Config> DriverCtx::makeSpillConfig(
           queryConfig.spillStartPartitionBit() +
               queryConfig.spillPartitionBits()),
       queryConfig.maxSpillLevel(),
-      queryConfig.testingSpillPct());
+      queryConfig.testingSpillPct(),
+      SpillCodecOptions{
+          spillCompressionKindFromString(queryConfig.spillCompressionKind()),
+          queryConfig.spillChecksumEnabled()},
+      task->spillTiers());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -85,10 +92,7 @@ BlockingState::BlockingState(
       future_(std::move(future)),
       operator_(op),
       reason_(reason),
-      sinceMicros_(
-          std::chrono::duration_cast<std::chrono::microseconds>(
-              std::chrono::high_resolution_clock::now().time_since_epoch())
-              .count()) {
+      sinceMicros_(getCurrentTimeMicro()) {
   // Set before leaving the thread.
   driver_->state().hasBlockingFuture = true;
   numBlockedDrivers_++;
@@ -108,6 +112,16 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
+          if (auto* trace = task->trace()) {
+            trace->record(
+                {TaskTraceEvent::Kind::kBlocked,
+                 driver->driverCtx()->pipelineId,
+                 driver->driverCtx()->driverId,
+                 state->operator_->operatorId(),
+                 state->sinceMicros_,
+                 getCurrentTimeMicro() - state->sinceMicros_,
+                 static_cast<int64_t>(state->reason_)});
+          }
         }
         VELOX_CHECK(!driver->state().isSuspended);
         VELOX_CHECK(driver->state().hasBlockingFuture);
@@ -192,6 +206,33 @@ std::ostream& operator<<(std::ostream& out, const StopReason& reason) {
   return out << stopReasonString(reason);
 }
 
+namespace {
+// Returns the executor priority for a Task whose Drivers have used 'cpuNanos'
+// of CPU. This makes a multi-level feedback queue out of the priority queues
+// of the executor: a Task starts in the highest queue and drops one queue each
+// time its CPU time doubles, starting at one time slice. The executor maps
+// priority 'p' to queue 'numPriorities / 2 + p' and takes from the highest
+// queue first.
+int8_t taskPriority(
+    uint64_t cpuNanos,
+    uint64_t timeSliceNanos,
+    uint8_t numPriorities) {
+  const uint32_t level = std::min<uint32_t>(
+      folly::findLastSet(cpuNanos / timeSliceNanos), numPriorities - 1);
+  return static_cast<int8_t>(numPriorities - 1 - level - numPriorities / 2);
+}
+
+void addPerfCounters(Operator& op, const process::PerfCounters& delta) {
+  auto lockedStats = op.stats().wlock();
+  lockedStats->addRuntimeStat("cpuCycles", RuntimeCounter(delta.cycles));
+  lockedStats->addRuntimeStat(
+      "instructions", RuntimeCounter(delta.instructions));
+  lockedStats->addRuntimeStat("llcMisses", RuntimeCounter(delta.llcMisses));
+  lockedStats->addRuntimeStat(
+      "branchMisses", RuntimeCounter(delta.branchMisses));
+}
+} // namespace
+
 // static
 void Driver::enqueue(std::shared_ptr<Driver> driver) {
   // This is expected to be called inside the Driver's Tasks's mutex.
@@ -199,8 +240,18 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  const auto numPriorities = executor->getNumPriorities();
+  if (driver->timeSliceMicros_ > 0 && numPriorities > 1) {
+    executor->addWithPriority(
+        [driver]() { Driver::run(driver); },
+        taskPriority(
+            driver->task()->driverCpuNanos(),
+            driver->timeSliceMicros_ * 1'000,
+            numPriorities));
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -212,6 +263,9 @@ void Driver::init(
   operators_ = std::move(operators);
   curOpIndex_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  timeSliceMicros_ = ctx_->queryConfig().driverTimeSliceMs() * 1'000ULL;
 }
 
 namespace {
@@ -277,11 +331,14 @@ void Driver::pushdownFilters(int operatorIndex) {
 }
 
 RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
-  enqueueInternal();
-
   auto self = shared_from_this();
   RowVectorPtr result;
-  auto stop = runInternal(self, blockingState, result);
+  StopReason stop;
+  // A yield has no other Drivers to give the thread to, so continue running.
+  do {
+    enqueueInternal();
+    stop = runInternal(self, blockingState, result);
+  } while (stop == StopReason::kYield);
 
   // We get kBlock if 'result' was produced; kAtEnd if pipeline has finished
   // processing and no more results will be produced; kAlreadyTerminated on
@@ -348,6 +405,7 @@ StopReason Driver::runInternal(
         "queuedWallNanos",
         RuntimeCounter(queuedTime, RuntimeCounter::Unit::kNanos));
   }
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterDriverQueueTimeMs, queuedTime / 1'000'000);
 
   CancelGuard guard(task().get(), &state_, [&](StopReason reason) {
     // This is run on error or cancel exit.
@@ -376,6 +434,11 @@ StopReason Driver::runInternal(
           guard.notThrown();
           return stop;
         }
+        if (timeSliceMicros_ > 0 &&
+            getCurrentTimeMicro() - now >= timeSliceMicros_) {
+          guard.notThrown();
+          return StopReason::kYield;
+        }
 
         auto op = operators_[i].get();
         // In case we are blocked, this index will point to the operator, whose
@@ -417,6 +480,10 @@ StopReason Driver::runInternal(
                   [op](const CpuWallTiming& deltaTiming) {
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto perfTimer = createDeltaPerfCountersTimer(
+                  [op](const process::PerfCounters& delta) {
+                    addPerfCounters(*op, delta);
+                  });
               RuntimeStatWriterScopeGuard statsWriterGuard(op);
               CALL_OPERATOR(result = op->getOutput(), op, "getOutput");
               if (result) {
@@ -438,6 +505,10 @@ StopReason Driver::runInternal(
                   [nextOp](const CpuWallTiming& timing) {
                     nextOp->stats().wlock()->addInputTiming.add(timing);
                   });
+              auto perfTimer = createDeltaPerfCountersTimer(
+                  [nextOp](const process::PerfCounters& delta) {
+                    addPerfCounters(*nextOp, delta);
+                  });
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(resultBytes, result->size());
@@ -447,6 +518,7 @@ StopReason Driver::runInternal(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
 
+              nextOp->maybeCaptureInput(result);
               CALL_OPERATOR(nextOp->addInput(result), nextOp, "addInput");
 
               // The next iteration will see if operators_[i + 1] has
@@ -479,6 +551,10 @@ StopReason Driver::runInternal(
                     [nextOp](const CpuWallTiming& timing) {
                       nextOp->stats().wlock()->finishTiming.add(timing);
                     });
+                auto perfTimer = createDeltaPerfCountersTimer(
+                    [nextOp](const process::PerfCounters& delta) {
+                      addPerfCounters(*nextOp, delta);
+                    });
                 RuntimeStatWriterScopeGuard statsWriterGuard(nextOp);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
@@ -498,6 +574,10 @@ StopReason Driver::runInternal(
                 createDeltaCpuWallTimer([op](const CpuWallTiming& timing) {
                   op->stats().wlock()->getOutputTiming.add(timing);
                 });
+            auto perfTimer = createDeltaPerfCountersTimer(
+                [op](const process::PerfCounters& delta) {
+                  addPerfCounters(*op, delta);
+                });
             CALL_OPERATOR(result = op->getOutput(), op, "getOutput");
             if (result) {
               VELOX_CHECK(
@@ -544,7 +624,25 @@ StopReason Driver::runInternal(
 void Driver::run(std::shared_ptr<Driver> self) {
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  CpuWallTiming timing;
+  StopReason reason;
+  const auto startMicros = getCurrentTimeMicro();
+  {
+    CpuWallTimer timer(timing);
+    reason = self->runInternal(self, blockingState, nullResult);
+  }
+  self->task()->addDriverTiming(timing, reason == StopReason::kYield);
+  if (auto* trace = self->task()->trace()) {
+    trace->record(
+        {TaskTraceEvent::Kind::kOnThread,
+         self->ctx_->pipelineId,
+         self->ctx_->driverId,
+         -1,
+         startMicros,
+         timing.wallNanos / 1'000,
+         static_cast<int64_t>(reason)});
+  }
+  self->task()->maybeSampleMemory(getCurrentTimeMs());
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -648,6 +746,15 @@ bool Driver::mayPushdownAggregation(Operator* aggregation) const {
       aggregation->toString());
 }
 
+std::optional<int64_t> Driver::downstreamRowLimit(const Operator* op) const {
+  for (auto i = 0; i + 1 < operators_.size(); ++i) {
+    if (operators_[i].get() == op) {
+      return operators_[i + 1]->maxInputRows();
+    }
+  }
+  return std::nullopt;
+}
+
 std::unordered_set<column_index_t> Driver::canPushdownFilters(
     const Operator* filterSource,
     const std::vector<column_index_t>& channels) const {
@@ -735,13 +842,24 @@ std::string Driver::toString() {
   return out.str();
 }
 
-SuspendedSection::SuspendedSection(Driver* driver) : driver_(driver) {
+SuspendedSection::SuspendedSection(Driver* driver)
+    : driver_(driver), startMicros_(getCurrentTimeMicro()) {
   if (driver->task()->enterSuspended(driver->state()) != StopReason::kNone) {
     VELOX_FAIL("Terminate detected when entering suspended section");
   }
 }
 
 SuspendedSection::~SuspendedSection() {
+  if (auto* trace = driver_->task()->trace()) {
+    trace->record(
+        {TaskTraceEvent::Kind::kSuspended,
+         driver_->driverCtx()->pipelineId,
+         driver_->driverCtx()->driverId,
+         -1,
+         startMicros_,
+         getCurrentTimeMicro() - startMicros_,
+         0});
+  }
   if (driver_->task()->leaveSuspended(driver_->state()) != StopReason::kNone) {
     VELOX_FAIL("Terminate detected when leaving suspended section");
   }
@@ -773,6 +891,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForConnector";
     case BlockingReason::kWaitForSpill:
       return "kWaitForSpill";
+    case BlockingReason::kWaitForAggregationMerge:
+      return "kWaitForAggregationMerge";
   }
   VELOX_UNREACHABLE();
   return "";
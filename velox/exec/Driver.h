@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
 #include "velox/core/PlanNode.h"
@@ -105,6 +106,9 @@ struct ThreadState {
   // memory, which a third party can revoke while the thread is in
   // this state.
   bool isSuspended{false};
+  // True if created but held back by the Task until there is work for it. See
+  // Task::deferredDrivers_.
+  bool isDeferred{false};
 
   bool isOnThread() const {
     return thread != std::thread::id();
@@ -149,6 +153,9 @@ enum class BlockingReason {
   /// Build operator is blocked waiting for all its peers to stop to run group
   /// spill on all of them.
   kWaitForSpill,
+  /// Final aggregation operator is blocked waiting for all its peers to
+  /// exchange the groups of their hash tables for a parallel merge.
+  kWaitForAggregationMerge,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -274,6 +281,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
       const Operator* filterSource,
       const std::vector<column_index_t>& channels) const;
 
+  // Returns the number of output rows of 'op' after which the operator that
+  // consumes them finishes, e.g. a Limit right after a TableScan. Sources use
+  // this to read no more than needed and to not prefetch more splits.
+  // std::nullopt if the consumer reads all output of 'op'.
+  std::optional<int64_t> downstreamRowLimit(const Operator* op) const;
+
   /// Returns the Operator with 'planNodeId' or nullptr if not found. For
   /// example, hash join probe accesses the corresponding build by id.
   Operator* findOperator(std::string_view planNodeId) const;
@@ -335,6 +348,17 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  /// If 'trackHardwareCounters_' is true, returns a timer that passes the
+  /// hardware counter deltas of the operation to 'func' upon destruction.
+  /// Returns null otherwise.
+  template <typename F>
+  std::unique_ptr<process::DeltaPerfCountersTimer<F>>
+  createDeltaPerfCountersTimer(F&& func) {
+    return trackHardwareCounters_
+        ? std::make_unique<process::DeltaPerfCountersTimer<F>>(std::move(func))
+        : nullptr;
+  }
+
   std::unique_ptr<DriverCtx> ctx_;
   std::atomic_bool closed_{false};
 
@@ -353,6 +377,12 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackHardwareCounters_{false};
+
+  // Time after which 'this' yields its thread. 0 means no limit. From
+  // QueryConfig::driverTimeSliceMs().
+  uint64_t timeSliceMicros_{0};
+
   friend struct DriverFactory;
 };
 
@@ -475,6 +505,7 @@ class SuspendedSection {
 
  private:
   Driver* driver_;
+  const uint64_t startMicros_;
 };
 
 } // namespace facebook::velox::exec
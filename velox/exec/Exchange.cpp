@@ -17,10 +17,26 @@
 #include <velox/common/base/Exceptions.h>
 #include <velox/common/memory/Memory.h>
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
+std::unique_ptr<VectorSerde::Options> exchangeSerdeOptions(
+    const core::QueryConfig& config) {
+  using PrestoVectorSerde = serializer::presto::PrestoVectorSerde;
+  const auto compressionKind = PrestoVectorSerde::compressionKindFromString(
+      config.exchangeCompressionKind());
+  if (compressionKind == folly::io::CodecType::NO_COMPRESSION &&
+      !config.exchangePreserveEncodings()) {
+    return nullptr;
+  }
+  auto options = std::make_unique<PrestoVectorSerde::PrestoOptions>(
+      false, compressionKind);
+  options->preserveEncodings = config.exchangePreserveEncodings();
+  return options;
+}
+
 SerializedPage::SerializedPage(
     std::unique_ptr<folly::IOBuf> iobuf,
     std::function<void(folly::IOBuf&)> onDestructionCb)
@@ -45,6 +61,42 @@ SerializedPage::~SerializedPage() {
 
 void SerializedPage::prepareStreamForDeserialize(ByteStream* input) {
   input->resetInput(std::move(ranges_));
+  if (iobuf_->isManaged()) {
+    // The deserialized vectors may refer to the page via 'input'.
+    input->setInputOwner(std::shared_ptr<folly::IOBuf>(iobuf_->clone()));
+  }
+}
+
+ExchangeRequestWindow::ExchangeRequestWindow(int64_t maxBytes)
+    : maxBytes_(std::max(maxBytes, kMinBytes)),
+      bytes_(std::min(kInitialBytes, maxBytes_)) {}
+
+void ExchangeRequestWindow::responseReceived(
+    int64_t bytes,
+    uint64_t nowMicros,
+    double consumerBytesPerSecond,
+    bool backlogged) {
+  const auto roundTrip =
+      nowMicros > requestMicros_ ? nowMicros - requestMicros_ : 0;
+  roundTripMicros_ = roundTripMicros_ == 0
+      ? roundTrip
+      : 0.8 * roundTripMicros_ + 0.2 * roundTrip;
+  if (backlogged) {
+    bytes_ = std::max(kMinBytes, bytes_ / 2);
+    return;
+  }
+  auto limit = maxBytes_;
+  if (consumerBytesPerSecond > 0) {
+    limit = std::clamp<int64_t>(
+        2 * consumerBytesPerSecond * roundTripMicros_ / 1'000'000,
+        kMinBytes,
+        maxBytes_);
+  }
+  if (bytes >= bytes_) {
+    bytes_ = std::min(2 * bytes_, limit);
+  } else {
+    bytes_ = std::min(bytes_, limit);
+  }
 }
 
 std::shared_ptr<ExchangeSource> ExchangeSource::create(
@@ -90,10 +142,11 @@ class LocalExchangeSource : public ExchangeSource {
     VELOX_CHECK(requestPending_);
     auto requestedSequence = sequence_;
     auto self = shared_from_this();
+    requestSent();
     buffers->getData(
         taskId_,
         destination_,
-        kMaxBytes,
+        requestBytes(),
         sequence_,
         // Since this lambda may outlive 'this', we need to capture a
         // shared_ptr to the current object (self).
@@ -117,7 +170,10 @@ class LocalExchangeSource : public ExchangeSource {
               // Keep looping, there could be extra end markers.
               continue;
             }
-            inputPage->unshare();
+            // The page shares the memory of the producer's buffer, which is
+            // only read. The buffer release function of the producer keeps
+            // the producer task and its memory pools alive until the page is
+            // freed.
             pages.push_back(
                 std::make_unique<SerializedPage>(std::move(inputPage)));
             inputPage = nullptr;
@@ -129,9 +185,12 @@ class LocalExchangeSource : public ExchangeSource {
             {
               std::lock_guard<std::mutex> l(queue_->mutex());
               requestPending_ = false;
+              int64_t numBytes = 0;
               for (auto& page : pages) {
+                numBytes += page->size();
                 queue_->enqueueLocked(std::move(page), promises);
               }
+              responseReceivedLocked(numBytes);
               if (atEnd) {
                 queue_->enqueueLocked(nullptr, promises);
                 atEnd_ = true;
@@ -157,22 +216,33 @@ class LocalExchangeSource : public ExchangeSource {
   }
 
   folly::F14FastMap<std::string, int64_t> stats() const override {
-    return {{"localExchangeSource.numPages", numPages_}};
+    return {
+        {"localExchangeSource.numPages", numPages_},
+        {"localExchangeSource.requestBytes", requestBytes()},
+        {"localExchangeSource.roundTripMicros",
+         static_cast<int64_t>(requestWindow_.roundTripMicros())}};
   }
 
  private:
-  static constexpr uint64_t kMaxBytes = 32 * 1024 * 1024; // 32 MB
-
   // Records the total number of pages fetched from sources.
   int64_t numPages_{0};
 };
 
+// Makes a LocalExchangeSource for a producer task in this process. These are
+// the tasks with "local://" ids and the tasks whose output buffers are in
+// this process, e.g. the producers that run on the same worker as their
+// consumers. Their pages are then handed over by reference, without a network
+// round trip.
 std::unique_ptr<ExchangeSource> createLocalExchangeSource(
     const std::string& taskId,
     int destination,
     std::shared_ptr<ExchangeQueue> queue,
     memory::MemoryPool* pool) {
-  if (strncmp(taskId.c_str(), "local://", 8) == 0) {
+  auto isInProcess = [&]() {
+    auto buffers = PartitionedOutputBufferManager::getInstance().lock();
+    return buffers != nullptr && buffers->hasTask(taskId);
+  };
+  if (strncmp(taskId.c_str(), "local://", 8) == 0 || isInProcess()) {
     return std::make_unique<LocalExchangeSource>(
         taskId, destination, std::move(queue), pool);
   }
@@ -394,7 +464,11 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   getSerde()->deserialize(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+      inputStream_.get(),
+      operatorCtx_->pool(),
+      outputType_,
+      &result_,
+      serdeOptions_.get());
 
   {
     auto lockedStats = stats_.wlock();
@@ -18,11 +18,20 @@
 #include <velox/common/memory/Memory.h>
 #include <velox/common/memory/MemoryAllocator.h>
 #include <memory>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Operator.h"
+#include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
 
+/// Returns the serde options for the pages exchanged between the tasks of a
+/// query with 'config', or nullptr if the defaults apply.
+std::unique_ptr<VectorSerde::Options> exchangeSerdeOptions(
+    const core::QueryConfig& config);
+
 // Corresponds to Presto SerializedPage, i.e. a container for
 // serialize vectors in Presto wire format.
 class SerializedPage {
@@ -107,6 +116,7 @@ class ExchangeQueue {
     }
     totalBytes_ += page->size();
     queue_.push_back(std::move(page));
+    REPORT_ADD_HISTOGRAM_VALUE(kCounterExchangeQueuePages, queue_.size());
     if (!promises_.empty()) {
       // Resume one of the waiting drivers.
       promises.push_back(std::move(promises_.back()));
@@ -156,9 +166,20 @@ class ExchangeQueue {
     queue_.pop_front();
     *atEnd = false;
     totalBytes_ -= page->size();
+    recordDequeueLocked(page->size());
     return page;
   }
 
+  // Returns the rate at which the consumer takes data from 'this' when there
+  // is data to take, or 0 if not known yet.
+  double consumerBytesPerSecond() const {
+    return busyMicros_ == 0 ? 0 : busyBytes_ * 1'000'000.0 / busyMicros_;
+  }
+
+  int numSources() const {
+    return numSources_;
+  }
+
   // Returns the total bytes held by SerializedPages in 'this'.
   uint64_t totalBytes() const {
     return totalBytes_;
@@ -228,6 +249,18 @@ class ExchangeQueue {
     }
   }
 
+  // Counts the time since the previous dequeue towards the consumer rate if
+  // the consumer did not have to wait for data in between.
+  void recordDequeueLocked(uint64_t bytes) {
+    const auto nowMicros = getCurrentTimeMicro();
+    if (hadDataAtLastDequeue_) {
+      busyBytes_ += bytes;
+      busyMicros_ += nowMicros - lastDequeueMicros_;
+    }
+    lastDequeueMicros_ = nowMicros;
+    hadDataAtLastDequeue_ = !queue_.empty();
+  }
+
   int numCompleted_ = 0;
   int numSources_ = 0;
   bool noMoreSources_ = false;
@@ -244,6 +277,58 @@ class ExchangeQueue {
   // If 'totalBytes_' < 'minBytes_', an exchange should request more data from
   // producers.
   uint64_t minBytes_;
+
+  // Bytes dequeued and time taken by the consumer while there was data
+  // queued, for the consumer rate.
+  uint64_t busyBytes_{0};
+  uint64_t busyMicros_{0};
+  uint64_t lastDequeueMicros_{0};
+  bool hadDataAtLastDequeue_{false};
+};
+
+// Sizes the requests of an ExchangeSource like the window of a TCP connection.
+// The data requested at a time should cover the round trip at the rate at
+// which the consumer processes the data of the source: asking for less leaves
+// the consumer idle and asking for more only takes memory. The size starts
+// small and doubles while the responses fill the requests, up to twice the
+// bytes the consumer processes in a round trip. It is halved when the consumer
+// falls behind, i.e. has more than the minBytes() of its queue queued.
+class ExchangeRequestWindow {
+ public:
+  static constexpr int64_t kMinBytes = 64 << 10;
+  static constexpr int64_t kInitialBytes = 1 << 20;
+
+  explicit ExchangeRequestWindow(int64_t maxBytes);
+
+  // Returns the number of bytes to request next.
+  int64_t bytes() const {
+    return bytes_;
+  }
+
+  void requestSent(uint64_t nowMicros) {
+    requestMicros_ = nowMicros;
+  }
+
+  // Updates the size after a response with 'bytes' of data.
+  // 'consumerBytesPerSecond' is the rate at which the consumer processes the
+  // data of this source, 0 if not known. 'backlogged' is true if the consumer
+  // has more data queued than it needs.
+  void responseReceived(
+      int64_t bytes,
+      uint64_t nowMicros,
+      double consumerBytesPerSecond,
+      bool backlogged);
+
+  // Moving average of the time from request to response.
+  uint64_t roundTripMicros() const {
+    return static_cast<uint64_t>(roundTripMicros_);
+  }
+
+ private:
+  const int64_t maxBytes_;
+  int64_t bytes_;
+  uint64_t requestMicros_{0};
+  double roundTripMicros_{0};
 };
 
 class ExchangeSource : public std::enable_shared_from_this<ExchangeSource> {
@@ -295,6 +380,11 @@ class ExchangeSource : public std::enable_shared_from_this<ExchangeSource> {
   // Returns runtime statistics.
   virtual folly::F14FastMap<std::string, int64_t> stats() const = 0;
 
+  // Returns the number of bytes to ask the producer for in the next request.
+  int64_t requestBytes() const {
+    return requestWindow_.bytes();
+  }
+
   virtual std::string toString() {
     std::stringstream out;
     out << "[ExchangeSource " << taskId_ << ":" << destination_
@@ -329,6 +419,24 @@ class ExchangeSource : public std::enable_shared_from_this<ExchangeSource> {
   // so we need to hold an additional shared reference on the memory pool to
   // keeps it alive.
   const std::shared_ptr<memory::MemoryPool> pool_;
+
+  // Call when sending a request to the producer.
+  void requestSent() {
+    requestWindow_.requestSent(getCurrentTimeMicro());
+  }
+
+  // Call with the mutex of 'queue_' held after adding the 'bytes' of a
+  // response to 'queue_'.
+  void responseReceivedLocked(int64_t bytes) {
+    requestWindow_.responseReceived(
+        bytes,
+        getCurrentTimeMicro(),
+        queue_->consumerBytesPerSecond() / std::max(1, queue_->numSources()),
+        queue_->totalBytes() > queue_->minBytes());
+  }
+
+  ExchangeRequestWindow requestWindow_{
+      static_cast<int64_t>(queue_->minBytes())};
 };
 
 struct RemoteConnectorSplit : public connector::ConnectorSplit {
@@ -414,6 +522,8 @@ class Exchange : public SourceOperator {
             exchangeNode->id(),
             operatorType),
         planNodeId_(exchangeNode->id()),
+        serdeOptions_(
+            exchangeSerdeOptions(ctx->task->queryCtx()->queryConfig())),
         exchangeClient_(std::move(exchangeClient)) {}
 
   ~Exchange() override {
@@ -452,6 +562,7 @@ class Exchange : public SourceOperator {
   void recordStats();
 
   const core::PlanNodeId planNodeId_;
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
@@ -52,7 +52,8 @@ FilterProject::FilterProject(
           operatorId,
           project ? project->id() : filter->id(),
           "FilterProject"),
-      hasFilter_(filter != nullptr) {
+      hasFilter_(filter != nullptr),
+      trackExprStats_(driverCtx->queryConfig().exprTrackCpuUsage()) {
   std::vector<core::TypedExprPtr> allExprs;
   if (hasFilter_) {
     allExprs.push_back(filter->filter());
@@ -146,6 +147,7 @@ RowVectorPtr FilterProject::getOutput() {
     numProcessedInputRows_ = size;
     VELOX_CHECK(!isIdentityProjection_);
     project(*rows, evalCtx);
+    updateStats(evalCtx);
 
     if (results_.size() > 0) {
       auto outCol = results_[0];
@@ -165,6 +167,7 @@ RowVectorPtr FilterProject::getOutput() {
   auto numOut = filter(evalCtx, *rows);
   numProcessedInputRows_ = size;
   if (numOut == 0) { // no rows passed the filer
+    updateStats(evalCtx);
     input_ = nullptr;
     return nullptr;
   }
@@ -178,6 +181,7 @@ RowVectorPtr FilterProject::getOutput() {
     }
     project(*rows, evalCtx);
   }
+  updateStats(evalCtx);
 
   return fillOutput(
       numOut, allRowsSelected ? nullptr : filterEvalCtx_.selectedIndices);
@@ -188,6 +192,16 @@ void FilterProject::project(const SelectivityVector& rows, EvalCtx& evalCtx) {
       hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results_);
 }
 
+void FilterProject::updateStats(const EvalCtx& evalCtx) {
+  if (const auto numSkipped = evalCtx.numSkippedLazyRows()) {
+    addRuntimeStat("skippedLazyRows", RuntimeCounter(numSkipped));
+  }
+  if (trackExprStats_) {
+    // The stats of 'exprs_' are cumulative, so they replace the previous ones.
+    stats_.wlock()->expressionStats = exprs_->stats();
+  }
+}
+
 vector_size_t FilterProject::filter(
     EvalCtx& evalCtx,
     const SelectivityVector& allRows) {
@@ -73,8 +73,17 @@ class FilterProject : public Operator {
   // pre-condition: !isIdentityProjection_
   void project(const SelectivityVector& rows, EvalCtx& evalCtx);
 
+  // Adds the number of LazyVector rows that the expressions did not need to
+  // the 'skippedLazyRows' runtime stat. Publishes the per-function stats of
+  // 'exprs_' if QueryConfig.exprTrackCpuUsage() is true.
+  void updateStats(const EvalCtx& evalCtx);
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
+
+  // True if the stats of the expressions are reported in OperatorStats.
+  const bool trackExprStats_;
+
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
@@ -36,6 +36,21 @@ bool areAllLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
   });
 }
 
+bool anyLazyNotLoaded(const std::vector<VectorPtr>& vectors) {
+  return std::any_of(vectors.begin(), vectors.end(), [](const auto& vector) {
+    return isLazyNotLoaded(*vector);
+  });
+}
+
+// The aggregates of a batch are updated in blocks of rows whose groups take
+// about this many bytes, so that the groups stay in the first level cache
+// while all the aggregates update them.
+constexpr int32_t kUpdateBlockBytes = 32 << 10;
+constexpr int32_t kMinUpdateBlockRows = 64;
+
+// Minimum number of aggregates for updating in blocks of rows.
+constexpr int32_t kMinBlockedAggregates = 4;
+
 std::vector<std::optional<column_index_t>> maskChannels(
     const std::vector<AggregateInfo>& aggregates) {
   std::vector<std::optional<column_index_t>> masks;
@@ -57,8 +72,10 @@ GroupingSet::GroupingSet(
     bool isRawInput,
     const Spiller::Config* spillConfig,
     tsan_atomic<bool>* nonReclaimableSection,
-    OperatorCtx* operatorCtx)
-    : preGroupedKeyChannels_(std::move(preGroupedKeys)),
+    OperatorCtx* operatorCtx,
+    int32_t partialRetainedGroupsPct)
+    : inputType_(inputType),
+      preGroupedKeyChannels_(std::move(preGroupedKeys)),
       hashers_(std::move(hashers)),
       isGlobal_(hashers_.empty()),
       isPartial_(isPartial),
@@ -69,7 +86,11 @@ GroupingSet::GroupingSet(
       spillMemoryThreshold_(operatorCtx->driverCtx()
                                 ->queryConfig()
                                 .aggregationSpillMemoryThreshold()),
+      sortFallbackDistinctPct_(operatorCtx->driverCtx()
+                                   ->queryConfig()
+                                   .aggregationSortFallbackDistinctPct()),
       spillConfig_(spillConfig),
+      partialRetainedGroupsPct_(partialRetainedGroupsPct),
       nonReclaimableSection_(nonReclaimableSection),
       stringAllocator_(operatorCtx->pool()),
       rows_(operatorCtx->pool()),
@@ -180,6 +201,7 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   activeRows_.setAll();
 
   addInputForActiveRows(input, mayPushdown);
+  numInputRows_ += numRows;
 }
 
 void GroupingSet::noMoreInput() {
@@ -218,46 +240,118 @@ void GroupingSet::addInputForActiveRows(
   table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
   table_->groupProbe(*lookup_);
   masks_.addInput(input, activeRows_);
+  if (partialRetainedGroupsPct_ > 0) {
+    markRepeatedGroups();
+  }
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
 
-  for (auto i = 0; i < aggregates_.size(); ++i) {
-    if (!aggregates_[i].sortingKeys.empty()) {
-      continue;
+  if (!addInputInBlocks(input)) {
+    for (auto i = 0; i < aggregates_.size(); ++i) {
+      if (!aggregates_[i].sortingKeys.empty()) {
+        continue;
+      }
+
+      auto& function = aggregates_[i].function;
+      if (!newGroups.empty()) {
+        function->initializeNewGroups(groups, newGroups);
+      }
+
+      const auto& rows = getSelectivityVector(i);
+      // Check is mask is false for all rows.
+      if (!rows.hasSelections()) {
+        continue;
+      }
+
+      populateTempVectors(i, input);
+      // TODO(spershin): We disable the pushdown at the moment if selectivity
+      // vector has changed after groups generation, we might want to revisit
+      // this.
+      const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
+          mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
+      if (isRawInput_) {
+        function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      } else {
+        function->addIntermediateResults(
+            groups, rows, tempVectors_, canPushdown);
+      }
     }
+    tempVectors_.clear();
+  }
 
-    auto& function = aggregates_[i].function;
+  if (sortedAggregations_) {
     if (!newGroups.empty()) {
-      function->initializeNewGroups(groups, newGroups);
+      sortedAggregations_->initializeNewGroups(groups, newGroups);
     }
+    sortedAggregations_->addInput(groups, input);
+  }
+}
 
-    const auto& rows = getSelectivityVector(i);
-    // Check is mask is false for all rows.
-    if (!rows.hasSelections()) {
-      continue;
+bool GroupingSet::addInputInBlocks(const RowVectorPtr& input) {
+  const int32_t blockSize = std::max<int32_t>(
+      kMinUpdateBlockRows,
+      kUpdateBlockBytes / table_->rows()->fixedRowSize());
+  if (activeRows_.countSelected() < 2 * blockSize) {
+    return false;
+  }
+  std::vector<int32_t> aggregateIndices;
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (aggregates_[i].sortingKeys.empty()) {
+      aggregateIndices.push_back(i);
     }
-
+  }
+  if (aggregateIndices.size() < kMinBlockedAggregates) {
+    return false;
+  }
+  // Lazy inputs are left to the aggregates to load or push down.
+  blockArgs_.resize(aggregates_.size());
+  for (auto i : aggregateIndices) {
     populateTempVectors(i, input);
-    // TODO(spershin): We disable the pushdown at the moment if selectivity
-    // vector has changed after groups generation, we might want to revisit
-    // this.
-    const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
-        mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
-    if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
-    } else {
-      function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
+    if (anyLazyNotLoaded(tempVectors_)) {
+      tempVectors_.clear();
+      blockArgs_.clear();
+      return false;
     }
+    std::swap(blockArgs_[i], tempVectors_);
   }
   tempVectors_.clear();
 
-  if (sortedAggregations_) {
+  auto* groups = lookup_->hits.data();
+  const auto& newGroups = lookup_->newGroups;
+  for (auto i : aggregateIndices) {
     if (!newGroups.empty()) {
-      sortedAggregations_->initializeNewGroups(groups, newGroups);
+      aggregates_[i].function->initializeNewGroups(groups, newGroups);
     }
-    sortedAggregations_->addInput(groups, input);
   }
+  for (auto begin = activeRows_.begin(); begin < activeRows_.end();
+       begin += blockSize) {
+    const auto end = std::min(begin + blockSize, activeRows_.end());
+    // The aggregates without a mask share the rows of the block.
+    const SelectivityVector* blockedRows = nullptr;
+    for (auto i : aggregateIndices) {
+      const auto& rows = getSelectivityVector(i);
+      if (&rows != blockedRows) {
+        blockRows_ = rows;
+        blockRows_.setValidRange(0, begin, false);
+        blockRows_.setValidRange(end, blockRows_.size(), false);
+        blockRows_.updateBounds();
+        blockedRows = &rows;
+      }
+      if (!blockRows_.hasSelections()) {
+        continue;
+      }
+      if (isRawInput_) {
+        aggregates_[i].function->addRawInput(
+            groups, blockRows_, blockArgs_[i], false);
+      } else {
+        aggregates_[i].function->addIntermediateResults(
+            groups, blockRows_, blockArgs_[i], false);
+      }
+    }
+  }
+  blockArgs_.clear();
+  return true;
 }
 
 void GroupingSet::addRemainingInput() {
@@ -306,10 +400,16 @@ std::vector<Accumulator> GroupingSet::accumulators() {
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(), &pool_);
+        std::move(hashers_),
+        accumulators(),
+        &pool_,
+        partialRetainedGroupsPct_ > 0);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(), &pool_);
+        std::move(hashers_),
+        accumulators(),
+        &pool_,
+        partialRetainedGroupsPct_ > 0);
   }
 
   RowContainer& rows = *table_->rows();
@@ -535,6 +635,9 @@ bool GroupingSet::getOutput(
   if (spiller_) {
     return getOutputWithSpill(batchSize, result);
   }
+  if (partialFlushing_) {
+    return getPartialFlushOutput(batchSize, result);
+  }
 
   // @lint-ignore CLANGTIDY
   char* groups[batchSize];
@@ -586,6 +689,154 @@ void GroupingSet::extractGroups(
   }
 }
 
+void GroupingSet::markRepeatedGroups() {
+  const auto probedFlagOffset = table_->rows()->probedFlagOffset();
+  // 'newGroups' is a sorted subset of 'rows'. All rows but the first ones of
+  // their groups are repeated input.
+  const auto& newGroups = lookup_->newGroups;
+  auto nextNewGroup = newGroups.begin();
+  for (auto row : lookup_->rows) {
+    if (nextNewGroup != newGroups.end() && *nextNewGroup == row) {
+      ++nextNewGroup;
+      continue;
+    }
+    bits::setBit(lookup_->hits[row], probedFlagOffset);
+  }
+}
+
+void GroupingSet::startPartialFlush() {
+  VELOX_CHECK(isPartial_);
+  VELOX_CHECK_GT(partialRetainedGroupsPct_, 0);
+  VELOX_CHECK(!partialFlushing_);
+  partialFlushing_ = true;
+  if (table_ == nullptr) {
+    return;
+  }
+
+  const int64_t maxRetainedGroups =
+      table_->numDistinct() * partialRetainedGroupsPct_ / 100;
+  int64_t numRetainedGroups = 0;
+  auto& rows = *table_->rows();
+  const auto probedFlagOffset = rows.probedFlagOffset();
+  constexpr int32_t kBatch = 1'000;
+  std::vector<char*> groups(kBatch);
+  RowContainerIterator iterator;
+  partialFlushGroups_.reserve(table_->numDistinct());
+  while (auto numGroups = rows.listRows(&iterator, kBatch, groups.data())) {
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* group = groups[i];
+      if (numRetainedGroups < maxRetainedGroups &&
+          bits::isBitSet(group, probedFlagOffset)) {
+        // Kept groups need repeated input again to stay for the next flush.
+        bits::clearBit(group, probedFlagOffset);
+        ++numRetainedGroups;
+      } else {
+        partialFlushGroups_.push_back(group);
+      }
+    }
+  }
+}
+
+bool GroupingSet::getPartialFlushOutput(
+    int32_t batchSize,
+    const RowVectorPtr& result) {
+  if (partialFlushIndex_ < partialFlushGroups_.size()) {
+    const auto numGroups = std::min<size_t>(
+        batchSize, partialFlushGroups_.size() - partialFlushIndex_);
+    extractGroups(
+        folly::Range<char**>(
+            partialFlushGroups_.data() + partialFlushIndex_, numGroups),
+        result);
+    partialFlushIndex_ += numGroups;
+    return true;
+  }
+
+  if (!partialFlushGroups_.empty()) {
+    table_->erase(folly::Range<char**>(
+        partialFlushGroups_.data(), partialFlushGroups_.size()));
+  }
+  partialFlushGroups_.clear();
+  partialFlushIndex_ = 0;
+  partialFlushing_ = false;
+  return false;
+}
+
+void GroupingSet::extractForMerge(
+    uint32_t partition,
+    int32_t batchSize,
+    std::vector<std::vector<RowVectorPtr>>& partitions) {
+  VELOX_CHECK(!isPartial_);
+  VELOX_CHECK(!isRawInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_LT(partition, partitions.size());
+  if (table_ == nullptr) {
+    return;
+  }
+
+  const auto numPartitions = partitions.size();
+  auto& rows = *table_->rows();
+  const auto numKeys = rows.keyTypes().size();
+  std::vector<std::vector<char*>> partitionGroups(numPartitions);
+  constexpr int32_t kBatch = 1'000;
+  std::vector<char*> groups(kBatch);
+  std::vector<uint64_t> hashes(kBatch);
+  RowContainerIterator iterator;
+  while (auto numGroups = rows.listRows(&iterator, kBatch, groups.data())) {
+    folly::Range<char**> range(groups.data(), numGroups);
+    for (auto i = 0; i < numKeys; ++i) {
+      rows.hash(i, range, i > 0, hashes.data());
+    }
+    for (auto i = 0; i < numGroups; ++i) {
+      const auto groupPartition = hashes[i] % numPartitions;
+      if (groupPartition != partition) {
+        partitionGroups[groupPartition].push_back(groups[i]);
+      }
+    }
+  }
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    auto& movedGroups = partitionGroups[i];
+    for (auto start = 0; start < movedGroups.size(); start += batchSize) {
+      const auto numGroups =
+          std::min<size_t>(batchSize, movedGroups.size() - start);
+      partitions[i].push_back(extractMergeInput(
+          folly::Range<char**>(movedGroups.data() + start, numGroups)));
+    }
+    if (!movedGroups.empty()) {
+      table_->erase(
+          folly::Range<char**>(movedGroups.data(), movedGroups.size()));
+    }
+  }
+}
+
+RowVectorPtr GroupingSet::extractMergeInput(folly::Range<char**> groups) {
+  const auto numGroups = groups.size();
+  auto& rows = *table_->rows();
+  std::vector<VectorPtr> children(inputType_->size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    const auto channel = keyChannels_[i];
+    children[channel] =
+        BaseVector::create(inputType_->childAt(channel), numGroups, &pool_);
+    rows.extractColumn(groups.data(), numGroups, i, children[channel]);
+  }
+  for (auto& aggregate : aggregates_) {
+    const auto channel = aggregate.inputs[0];
+    children[channel] =
+        BaseVector::create(inputType_->childAt(channel), numGroups, &pool_);
+    aggregate.function->extractAccumulators(
+        groups.data(), numGroups, &children[channel]);
+  }
+  // Columns that the aggregation does not read.
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i] == nullptr) {
+      children[i] = BaseVector::createNullConstant(
+          inputType_->childAt(i), numGroups, &pool_);
+    }
+  }
+  return std::make_shared<RowVector>(
+      &pool_, inputType_, nullptr, numGroups, std::move(children));
+}
+
 void GroupingSet::resetPartial() {
   if (table_ != nullptr) {
     table_->clear();
@@ -597,6 +848,11 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
   if (!table_ || allocatedBytes() <= maxBytes) {
     return false;
   }
+  if (partialRetainedGroupsPct_ > 0 && table_->rows()->numFreeRows() > 0) {
+    // The rows erased by the last partial flush get reused before the table
+    // grows.
+    return false;
+  }
   if (table_->hashMode() != BaseHashTable::HashMode::kArray) {
     // Not a kArray table, no rehashing will shrink this.
     return true;
@@ -653,19 +909,26 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
       (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
           spillConfig_->testSpillPct) {
     const auto rowsToSpill = std::max<int64_t>(1, numDistinct / 10);
-    spill(
+    spillForInput(
         numDistinct - rowsToSpill,
         outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
     return;
   }
 
+  if (sortBasedAggregation_ && tableIncrement != 0) {
+    // The hash table gives little reduction. Spills all its groups as sorted
+    // runs instead of growing it.
+    spillForInput(0, 0);
+    return;
+  }
+
   const auto currentUsage = pool_.currentBytes();
   if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
     const int64_t bytesToSpill =
         currentUsage * spillConfig_->spillableReservationGrowthPct / 100;
     auto rowsToSpill = std::max<int64_t>(
         1, bytesToSpill / (rows->fixedRowSize() + outOfLineBytesPerRow));
-    spill(
+    spillForInput(
         std::max<int64_t>(0, numDistinct - rowsToSpill),
         std::max<int64_t>(
             0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
@@ -702,12 +965,33 @@ void GroupingSet::ensureInputFits(const RowVectorPtr& input) {
   // the operator memory pool.
   auto rowsToSpill = std::max<int64_t>(
       1, targetIncrement / (rows->fixedRowSize() + outOfLineBytesPerRow));
-  spill(
+  spillForInput(
       std::max<int64_t>(0, numDistinct - rowsToSpill),
       std::max<int64_t>(
           0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
 }
 
+void GroupingSet::spillForInput(int64_t targetRows, int64_t targetBytes) {
+  if (sortBasedAggregation_) {
+    // Spilling a part of the groups would not reduce the spilled data as
+    // almost every input row makes its own group. Spills all of them so that
+    // each spill writes one sorted run per partition.
+    spill(0, 0);
+    return;
+  }
+  spill(targetRows, targetBytes);
+
+  if (sortFallbackDistinctPct_ == 0 || numInputRows_ == 0) {
+    return;
+  }
+  // Each spilled row is a group that the hash table has produced.
+  const int64_t numGroups =
+      spiller_->stats().spilledRows + table_->numDistinct();
+  if (numGroups * 100 >= numInputRows_ * sortFallbackDistinctPct_) {
+    sortBasedAggregation_ = true;
+  }
+}
+
 void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
   // NOTE: if the disk spilling is triggered by the memory arbitrator, then it
   // is possible that the grouping set hasn't processed any input data yet.
@@ -715,39 +999,72 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
   if (table_ == nullptr) {
     return;
   }
-  if (spiller_ == nullptr) {
-    auto rows = table_->rows();
-    auto types = rows->keyTypes();
-    for (const auto& aggregate : aggregates_) {
-      types.push_back(aggregate.intermediateType);
-    }
-    std::vector<std::string> names;
-    for (auto i = 0; i < types.size(); ++i) {
-      names.push_back(fmt::format("s{}", i));
-    }
-    VELOX_DCHECK(pool_.trackUsage());
-    spiller_ = std::make_unique<Spiller>(
-        Spiller::Type::kAggregate,
-        rows,
-        [&](folly::Range<char**> rows) { table_->erase(rows); },
-        ROW(std::move(names), std::move(types)),
-        // Spill up to 8 partitions based on bits starting from 29th of the hash
-        // number. Any from one to three bits would do.
-        spillConfig_->hashBitRange,
-        rows->keyTypes().size(),
-        std::vector<CompareFlags>(),
-        spillConfig_->filePath,
-        spillConfig_->maxFileSize,
-        spillConfig_->minSpillRunSize,
-        Spiller::spillPool(),
-        spillConfig_->executor);
-  }
+  ensureSpiller();
   spiller_->spill(targetRows, targetBytes);
   if (table_->rows()->numRows() == 0) {
     table_->clear();
   }
 }
 
+void GroupingSet::spill(const RowContainerIterator& rowIterator) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK_NULL(spiller_);
+  if (table_ == nullptr) {
+    return;
+  }
+  auto* rows = table_->rows();
+  Spiller::SpillRows spillRows(
+      rows->numRows(), memory::StlAllocator<char*>(pool_));
+  RowContainerIterator iterator = rowIterator;
+  spillRows.resize(
+      rows->listRows(&iterator, spillRows.size(), spillRows.data()));
+  if (spillRows.empty()) {
+    // All the groups have been returned.
+    return;
+  }
+
+  ensureSpiller();
+  spiller_->spillRows(
+      folly::Range<char**>(spillRows.data(), spillRows.size()));
+  // Frees the groups that have been returned. They must be gone before
+  // finishing spill or they would be merged into the output again.
+  table_->clear();
+}
+
+void GroupingSet::ensureSpiller() {
+  if (spiller_ != nullptr) {
+    return;
+  }
+  auto rows = table_->rows();
+  auto types = rows->keyTypes();
+  for (const auto& aggregate : aggregates_) {
+    types.push_back(aggregate.intermediateType);
+  }
+  std::vector<std::string> names;
+  for (auto i = 0; i < types.size(); ++i) {
+    names.push_back(fmt::format("s{}", i));
+  }
+  VELOX_DCHECK(pool_.trackUsage());
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kAggregate,
+      rows,
+      [&](folly::Range<char**> rows) { table_->erase(rows); },
+      ROW(std::move(names), std::move(types)),
+      // Spill up to 8 partitions based on bits starting from 29th of the hash
+      // number. Any from one to three bits would do.
+      spillConfig_->hashBitRange,
+      rows->keyTypes().size(),
+      std::vector<CompareFlags>(),
+      spillConfig_->filePath,
+      spillConfig_->maxFileSize,
+      spillConfig_->minSpillRunSize,
+      Spiller::spillPool(),
+      spillConfig_->executor,
+      spillConfig_->codecOptions,
+      spillConfig_->tiers);
+}
+
 bool GroupingSet::getOutputWithSpill(
     int32_t batchSize,
     const RowVectorPtr& result) {
@@ -37,7 +37,8 @@ class GroupingSet {
       bool isRawInput,
       const Spiller::Config* spillConfig,
       tsan_atomic<bool>* nonReclaimableSection,
-      OperatorCtx* operatorCtx);
+      OperatorCtx* operatorCtx,
+      int32_t partialRetainedGroupsPct = 0);
 
   ~GroupingSet();
 
@@ -71,6 +72,29 @@ class GroupingSet {
 
   void resetPartial();
 
+  /// True if a full partial aggregation can keep some of its groups when it
+  /// flushes. See startPartialFlush().
+  bool canRetainGroups() const {
+    return partialRetainedGroupsPct_ > 0;
+  }
+
+  /// Starts a flush of a full partial aggregation that keeps up to
+  /// 'partialRetainedGroupsPct' % of the groups in the table. The kept groups
+  /// are ones with repeated input since the previous flush. The next
+  /// getOutput() calls return the other groups and erase these from the table
+  /// at the end.
+  void startPartialFlush();
+
+  /// Moves the groups that do not belong to 'partition' out of the table of a
+  /// final aggregation for a merge with the tables of 'partitions.size()' peer
+  /// aggregations. Partitions the groups on the hash of the grouping keys.
+  /// Appends the groups of partition i to 'partitions[i]' as vectors of the
+  /// input type with at most 'batchSize' rows and erases them from the table.
+  void extractForMerge(
+      uint32_t partition,
+      int32_t batchSize,
+      std::vector<std::vector<RowVectorPtr>>& partitions);
+
   /// Returns true if 'this' should start producing partial
   /// aggregation results. Checks the memory consumption against
   /// 'maxBytes'. If exceeding 'maxBytes', sees if changing hash mode
@@ -95,6 +119,25 @@ class GroupingSet {
   /// of this will be in a paused state and off thread.
   void spill(int64_t targetRows, int64_t targetBytes);
 
+  /// Spills the groups that have not been returned yet after the output
+  /// processing has started. 'rowIterator' is the position of the next group
+  /// to return. Frees all the groups in 'table_' and the rest of the output is
+  /// produced from the spilled data. This is a no-op if all the groups have
+  /// been returned. This is called by external memory
+  /// management with the Driver of this in a paused state and off thread.
+  void spill(const RowContainerIterator& rowIterator);
+
+  /// Returns true if spilling has been triggered.
+  bool hasSpilled() const {
+    return spiller_ != nullptr;
+  }
+
+  /// Returns true if the aggregation has switched to sort-based aggregation.
+  /// See QueryConfig::kAggregationSortFallbackDistinctPct.
+  bool isSortBased() const {
+    return sortBasedAggregation_;
+  }
+
   /// Returns the spiller stats including total bytes and rows spilled so far.
   Spiller::Stats spilledStats() const {
     return spiller_ != nullptr ? spiller_->stats() : Spiller::Stats{};
@@ -105,6 +148,12 @@ class GroupingSet {
     return table_ ? table_->stats() : HashTableStats{};
   }
 
+  /// Returns the allocator of the variable width keys and accumulators of
+  /// the groups kept in memory.
+  const HashStringAllocator& groupsAllocator() const {
+    return table_ ? table_->rows()->stringAllocator() : stringAllocator_;
+  }
+
   /// Return the number of rows kept in memory.
   int64_t numRows() const {
     return table_ ? table_->rows()->numRows() : 0;
@@ -142,6 +191,12 @@ class GroupingSet {
 
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
+  // Updates the aggregates from the active rows of 'input' in blocks of rows,
+  // all aggregates for one block before the next block, so that the groups of
+  // a block stay in cache. Returns false without updating if there are too
+  // few rows or aggregates or if some input is an unloaded lazy vector.
+  bool addInputInBlocks(const RowVectorPtr& input);
+
   // If the given aggregation has mask, the method returns reference to the
   // selectivity vector from the maskedActiveRows_ (based on the mask channel
   // index for this aggregation), otherwise it returns reference to activeRows_.
@@ -152,17 +207,38 @@ class GroupingSet {
   // enough to make 'input' fit.
   void ensureInputFits(const RowVectorPtr& input);
 
+  // Spills from ensureInputFits(). Spills all the groups after switching to
+  // sort-based aggregation. Otherwise, spills until under 'targetRows' and
+  // 'targetBytes' and switches to sort-based aggregation if the groups
+  // produced so far are at least 'sortFallbackDistinctPct_' of the input rows.
+  void spillForInput(int64_t targetRows, int64_t targetBytes);
+
   // Copies the grouping keys and aggregates for 'groups' into 'result' If
   // partial output, extracts the intermediate type for aggregates, final result
   // otherwise.
   void extractGroups(folly::Range<char**> groups, const RowVectorPtr& result);
 
+  // Sets the probed flag of the groups of the last input batch that existed
+  // before the batch. Used to pick the groups to keep on a partial flush.
+  void markRepeatedGroups();
+
+  // Returns the next batch of 'partialFlushGroups_'. Erases these from the
+  // table and returns false at the end.
+  bool getPartialFlushOutput(int32_t batchSize, const RowVectorPtr& result);
+
+  // Returns the keys and accumulators of 'groups' as a vector of the input
+  // type of a final aggregation. Used by extractForMerge().
+  RowVectorPtr extractMergeInput(folly::Range<char**> groups);
+
   // Produces output in if spilling has occurred. First produces data
   // from non-spilled partitions, then merges spill runs and unspilled data
   // form spilled partitions. Returns nullptr when at end. 'batchSize' specifies
   // the max number of output rows in 'result'.
   bool getOutputWithSpill(int32_t batchSize, const RowVectorPtr& result);
 
+  // Creates 'spiller_' if it has not been created yet.
+  void ensureSpiller();
+
   // Reads rows from the current spilled partition until producing a batch of
   // final results in 'result'. Returns false and leaves 'result' empty when
   // the partition is fully read. 'batchSize' specifies the max number of output
@@ -194,6 +270,8 @@ class GroupingSet {
   // for 'sortedAggregations_'.
   std::vector<Accumulator> accumulators();
 
+  const RowTypePtr inputType_;
+
   std::vector<column_index_t> keyChannels_;
 
   /// A subset of grouping keys on which the input is clustered.
@@ -214,8 +292,25 @@ class GroupingSet {
   // If it is zero, then there is no such limit.
   const uint64_t spillMemoryThreshold_;
 
+  // The min percentage of the input rows that the groups produced by the hash
+  // table must reach to switch to sort-based aggregation. 0 if disabled.
+  const int32_t sortFallbackDistinctPct_;
+
   const Spiller::Config* const spillConfig_; // Not owned.
 
+  // Max percentage of groups that a partial flush keeps in the table. 0 if
+  // partial flushes output all groups.
+  const int32_t partialRetainedGroupsPct_;
+
+  // The groups to output in the partial flush started by startPartialFlush().
+  std::vector<char*> partialFlushGroups_;
+
+  // Index of the next group to output in 'partialFlushGroups_'.
+  size_t partialFlushIndex_{0};
+
+  // True between startPartialFlush() and the end of its output.
+  bool partialFlushing_{false};
+
   // Indicates if this grouping set and the associated hash aggregation operator
   // is under non-reclaimable execution section or not.
   tsan_atomic<bool>* const nonReclaimableSection_;
@@ -228,6 +323,10 @@ class GroupingSet {
 
   // Place for the arguments of the aggregate being updated.
   std::vector<VectorPtr> tempVectors_;
+  // The arguments of each aggregate and the rows of the block being updated
+  // in addInputInBlocks().
+  std::vector<std::vector<VectorPtr>> blockArgs_;
+  SelectivityVector blockRows_;
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
@@ -293,6 +392,14 @@ class GroupingSet {
   // 'testSpillPct_';.
   uint64_t spillTestCounter_{0};
 
+  // Number of input rows added by addInput().
+  int64_t numInputRows_{0};
+
+  // True if the hash table gives little reduction and a spilling aggregation
+  // no longer grows it. Instead, all its groups are spilled as sorted runs
+  // whenever it is full and the runs are merged when producing output.
+  bool sortBasedAggregation_{false};
+
   // True if partial aggregation has been given up as non-productive.
   bool abandonedPartialAggregation_{false};
 
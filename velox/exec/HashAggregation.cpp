@@ -15,6 +15,7 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include <unordered_set>
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortedAggregations.h"
@@ -22,6 +23,32 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// True if the groups of final aggregations with 'hashers' and 'aggregates' can
+// be extracted from one hash table and added as input to another. Each
+// aggregate must read one intermediate result column that no grouping key or
+// other aggregate reads.
+bool canMergeTables(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers,
+    const std::vector<AggregateInfo>& aggregates) {
+  std::unordered_set<column_index_t> channels;
+  for (const auto& hasher : hashers) {
+    if (!channels.insert(hasher->channel()).second) {
+      return false;
+    }
+  }
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.inputs.size() != 1 ||
+        aggregate.constantInputs[0] != nullptr || aggregate.mask.has_value() ||
+        !aggregate.sortingKeys.empty() ||
+        !channels.insert(aggregate.inputs[0]).second) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 HashAggregation::HashAggregation(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -148,6 +175,27 @@ HashAggregation::HashAggregation(
     }
   }
 
+  parallelMerge_ =
+      aggregationNode->step() == core::AggregationNode::Step::kFinal &&
+      !isGlobal_ && !isDistinct_ && preGroupedChannels.empty() &&
+      !spillConfig_.has_value() &&
+      driverCtx->queryConfig().parallelAggregationMergeEnabled() &&
+      driverCtx->task->numDrivers(driverCtx->driver) > 1 &&
+      canMergeTables(hashers, aggregateInfos);
+
+  // Only a partial aggregation of raw input that flushes on memory pressure can
+  // keep groups across flushes.
+  const bool canRetainGroups = isPartialOutput_ && !isGlobal_ &&
+      !isIntermediate_ && !isDistinct_ && preGroupedChannels.empty();
+  const auto partialRetainedGroupsPct = canRetainGroups
+      ? driverCtx->queryConfig().partialAggregationRetainedGroupsPct()
+      : 0;
+  VELOX_USER_CHECK_LT(
+      partialRetainedGroupsPct,
+      100,
+      "{} must be less than 100",
+      core::QueryConfig::kPartialAggregationRetainedGroupsPct);
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
@@ -158,7 +206,20 @@ HashAggregation::HashAggregation(
       isRawInput(aggregationNode->step()),
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &nonReclaimableSection_,
-      operatorCtx_.get());
+      operatorCtx_.get(),
+      partialRetainedGroupsPct);
+}
+
+bool HashAggregation::shouldRetainGroups() const {
+  if (!groupingSet_->canRetainGroups() || noMoreInput_ ||
+      numInputRows_ == 0) {
+    return false;
+  }
+  // A flush that keeps groups must not abandon the partial aggregation after
+  // it, so only the flushes with a good reduction keep groups.
+  const auto numGroups = groupingSet_->numDistinct();
+  return !abandonPartialAggregationEarly(numGroups) &&
+      100 * numGroups / numInputRows_ <= kPartialMinFinalPct;
 }
 
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
@@ -240,6 +301,19 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats["hashtable.numTombstones"] =
       RuntimeMetric(hashTableStats.numTombstones);
+  runtimeStats["hashtable.rehashTime"] = RuntimeMetric(
+      hashTableStats.rehashTimeUs * 1'000, RuntimeCounter::Unit::kNanos);
+
+  // Free space in the variable width data of the groups that is not returned
+  // to the pool. A large 'freeBytes' relative to 'retainedBytes' is memory
+  // lost to fragmentation, e.g. from updating string min/max accumulators.
+  const auto& allocator = groupingSet_->groupsAllocator();
+  runtimeStats["stringAllocator.retainedBytes"] = RuntimeMetric(
+      allocator.retainedSize(), RuntimeCounter::Unit::kBytes);
+  runtimeStats["stringAllocator.freeBytes"] =
+      RuntimeMetric(allocator.freeSpace(), RuntimeCounter::Unit::kBytes);
+  runtimeStats["stringAllocator.numFreeBlocks"] =
+      RuntimeMetric(allocator.numFreeBlocks());
 }
 
 void HashAggregation::recordSpillStats() {
@@ -276,8 +350,17 @@ void HashAggregation::resetPartialOutputIfNeed() {
     lockedStats->addRuntimeStat("flushTimes", RuntimeCounter(1));
     lockedStats->addRuntimeStat(
         "partialAggregationPct", RuntimeCounter(aggregationPct));
+    if (flushingColdGroups_) {
+      lockedStats->addRuntimeStat(
+          "retainedGroups", RuntimeCounter(groupingSet_->numDistinct()));
+    }
+  }
+  if (flushingColdGroups_) {
+    // The flushed groups are already erased from the table.
+    flushingColdGroups_ = false;
+  } else {
+    groupingSet_->resetPartial();
   }
-  groupingSet_->resetPartial();
   partialFull_ = false;
   if (!finished_) {
     maybeIncreasePartialAggregationMemoryUsage(aggregationPct);
@@ -289,8 +372,6 @@ void HashAggregation::resetPartialOutputIfNeed() {
 
 void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     double aggregationPct) {
-  // If more than this many are unique at full memory, give up on partial agg.
-  constexpr int32_t kPartialMinFinalPct = 40;
   VELOX_DCHECK(isPartialOutput_);
   // If size is at max and there still is not enough reduction, abandon partial
   // aggregation.
@@ -344,6 +425,17 @@ RowVectorPtr HashAggregation::getOutput() {
     return output_;
   }
 
+  if (!mergeInput_.empty()) {
+    VELOX_CHECK(noMoreInput_);
+    int64_t numMergedGroups = 0;
+    for (const auto& input : mergeInput_) {
+      groupingSet_->addInput(input, false);
+      numMergedGroups += input->size();
+    }
+    mergeInput_.clear();
+    addRuntimeStat("parallelMergeInputGroups", RuntimeCounter(numMergedGroups));
+  }
+
   // Produce results if one of the following is true:
   // - received no-more-input message;
   // - partial aggregation reached memory limit;
@@ -383,13 +475,22 @@ RowVectorPtr HashAggregation::getOutput() {
   const auto batchSize =
       isGlobal_ ? 1 : outputBatchRows(groupingSet_->estimateRowSize());
 
+  if (partialFull_ && !flushingColdGroups_ && shouldRetainGroups()) {
+    groupingSet_->startPartialFlush();
+    flushingColdGroups_ = true;
+  }
+
+  // Prevents the memory arbitrator to reclaim memory from this operator while
+  // an output batch is being produced.
+  NonReclaimableSection guard(this);
+
   // Reuse output vectors if possible.
   prepareOutput(batchSize);
 
   bool hasData = groupingSet_->getOutput(batchSize, resultIterator_, output_);
   if (!hasData) {
     resultIterator_.reset();
-    if (noMoreInput_) {
+    if (noMoreInput_ && !flushingColdGroups_) {
       finished_ = true;
     }
     resetPartialOutputIfNeed();
@@ -402,7 +503,71 @@ RowVectorPtr HashAggregation::getOutput() {
 void HashAggregation::noMoreInput() {
   groupingSet_->noMoreInput();
   recordSpillStats();
+  if (groupingSet_->isSortBased()) {
+    addRuntimeStat("sortBasedAggregation", RuntimeCounter(1));
+  }
   Operator::noMoreInput();
+  if (parallelMerge_) {
+    startParallelMerge();
+  }
+}
+
+void HashAggregation::startParallelMerge() {
+  const auto numPartitions =
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+  const auto partition = operatorCtx_->driverCtx()->partitionId;
+  mergeOutput_.resize(numPartitions);
+  groupingSet_->extractForMerge(
+      partition,
+      outputBatchRows(groupingSet_->estimateRowSize()),
+      mergeOutput_);
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last Driver to finish its input hands the groups of each partition
+  // over to the Driver that merges the partition. The other Drivers wait for
+  // it and merge their partitions when they are continued.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(),
+          operatorCtx_->driver(),
+          &mergeFuture_,
+          promises,
+          peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<HashAggregation*> aggregations(numPartitions, nullptr);
+  aggregations[partition] = this;
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    aggregations[peer->driverCtx()->partitionId] = aggregation;
+  }
+  for (auto* source : aggregations) {
+    VELOX_CHECK_NOT_NULL(source);
+    for (auto i = 0; i < numPartitions; ++i) {
+      auto& input = aggregations[i]->mergeInput_;
+      auto& output = source->mergeOutput_[i];
+      input.insert(input.end(), output.begin(), output.end());
+      output.clear();
+    }
+  }
+}
+
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (!mergeFuture_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(mergeFuture_);
+  return BlockingReason::kWaitForAggregationMerge;
 }
 
 bool HashAggregation::isFinished() {
@@ -413,20 +578,36 @@ void HashAggregation::reclaim(uint64_t targetBytes) {
   VELOX_CHECK(canReclaim());
   auto* driver = operatorCtx_->driver();
 
-  /// NOTE: an aggregation operator is reclaimable if it hasn't started output
-  /// processing and is not under non-reclaimable execution section.
-  if (noMoreInput_ || nonReclaimableSection_) {
+  /// NOTE: an aggregation operator is reclaimable if it hasn't finished output
+  /// processing, hasn't spilled before producing output and is not under
+  /// non-reclaimable execution section. A global aggregation has a single
+  /// output group and is not reclaimable after it has started output.
+  if (finished_ || nonReclaimableSection_ ||
+      (noMoreInput_ && (isGlobal_ || groupingSet_->hasSpilled()))) {
     // TODO: add stats to record the non-reclaimable case and reduce the log
     // frequency if it is too verbose.
     LOG(WARNING) << "Can't reclaim from aggregation operator, noMoreInput_["
-                 << noMoreInput_ << "], nonReclaimableSection_["
-                 << nonReclaimableSection_ << "], " << toString();
+                 << noMoreInput_ << "], finished_[" << finished_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << toString();
     return;
   }
 
-  // TODO: support fine-grain disk spilling based on 'targetBytes' after having
-  // row container memory compaction support later.
-  groupingSet_->spill(0, targetBytes);
+  if (noMoreInput_) {
+    // The output processing has started. Spills the groups that have not been
+    // returned and produces the rest of the output from the spilled data.
+    groupingSet_->spill(resultIterator_);
+    if (!groupingSet_->hasSpilled()) {
+      // All the groups have been returned. There is nothing to reclaim.
+      return;
+    }
+    resultIterator_.reset();
+    recordSpillStats();
+  } else {
+    // TODO: support fine-grain disk spilling based on 'targetBytes' after
+    // having row container memory compaction support later.
+    groupingSet_->spill(0, targetBytes);
+  }
   VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
   VELOX_CHECK_EQ(groupingSet_->numDistinct(), 0);
   // Release the minimum reserved memory.
@@ -437,6 +618,8 @@ void HashAggregation::close() {
   Operator::close();
 
   output_ = nullptr;
+  mergeInput_.clear();
+  mergeOutput_.clear();
   groupingSet_.reset();
 }
 } // namespace facebook::velox::exec
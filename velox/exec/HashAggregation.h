@@ -37,9 +37,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -67,10 +65,23 @@ class HashAggregation : public Operator {
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // True if the flush of a full partial aggregation keeps the groups with
+  // repeated input in the table. See GroupingSet::startPartialFlush().
+  bool shouldRetainGroups() const;
+
+  // Invoked on no more input with 'parallelMerge_'. Moves the groups of the
+  // other partitions out of 'groupingSet_' and waits for the peers to do the
+  // same. The last Driver to finish distributes the groups to the operators
+  // that merge them.
+  void startParallelMerge();
+
   // Invoked to record the spilling stats in operator stats after processing all
   // the inputs.
   void recordSpillStats();
 
+  // If more than this many are unique at full memory, give up on partial agg.
+  static constexpr int32_t kPartialMinFinalPct = 40;
+
   const bool isPartialOutput_;
   const bool isDistinct_;
   const bool isGlobal_;
@@ -81,6 +92,8 @@ class HashAggregation : public Operator {
   std::unique_ptr<GroupingSet> groupingSet_;
 
   bool partialFull_ = false;
+  // True while a full partial aggregation outputs the groups it does not keep.
+  bool flushingColdGroups_ = false;
   bool newDistincts_ = false;
   bool finished_ = false;
   // True if partial aggregation has been found to be non-reducing.
@@ -110,6 +123,20 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // True if the Drivers of a final aggregation merge their tables at the end
+  // of input. Each Driver outputs the groups of the hash partition that
+  // matches its partition id.
+  bool parallelMerge_{false};
+
+  // The groups of each partition moved out of 'groupingSet_' for the merge.
+  std::vector<std::vector<RowVectorPtr>> mergeOutput_;
+
+  // The groups of this Driver's partition received from the peers.
+  std::vector<RowVectorPtr> mergeInput_;
+
+  // Realized when all peers have distributed their groups for the merge.
+  ContinueFuture mergeFuture_{ContinueFuture::makeEmpty()};
 };
 
 } // namespace facebook::velox::exec
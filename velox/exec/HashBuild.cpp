@@ -110,6 +110,11 @@ HashBuild::HashBuild(
   tableType_ = ROW(std::move(names), std::move(types));
   setupTable();
   setupSpiller();
+  shareTable_ = canShareTable();
+  // A shared table is probed by the other tasks, which have other probe side
+  // rows.
+  probeKeyFiltersEnabled_ = isInnerJoin(joinType_) && !shareTable_ &&
+      driverCtx->queryConfig().hashJoinProbeBufferMaxRows() > 0;
 
   if (isAntiJoin(joinType_) && joinNode_->filter()) {
     setupFilterForAntiJoins(keyChannelMap);
@@ -187,7 +192,7 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
         *this,
         [&](const std::vector<Operator*>& operators) { runSpill(operators); });
   } else {
-    spillInputReader_ = spillPartition->createReader();
+    spillInputReader_ = spillPartition->createReader(spillConfig()->executor);
 
     const auto startBit = spillPartition->id().partitionBitOffset() +
         spillConfig.hashBitRange.numBits();
@@ -213,7 +218,9 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.codecOptions,
+      spillConfig.tiers);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -290,9 +297,101 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
   }
 }
 
+namespace {
+template <typename T>
+void removeRowsFailingFilter(
+    const common::Filter& filter,
+    const DecodedVector& decoded,
+    SelectivityVector& rows) {
+  for (auto row = rows.begin(); row < rows.end(); ++row) {
+    if (rows.isValid(row) && !filter.testInt64(decoded.valueAt<T>(row))) {
+      rows.setValid(row, false);
+    }
+  }
+}
+} // namespace
+
+void HashBuild::removeInputRowsWithoutProbeMatch() {
+  auto& hashers = table_->hashers();
+  if (probeKeyFilters_.empty()) {
+    auto filters = joinBridge_->probeKeyFilters();
+    if (!filters.has_value()) {
+      return;
+    }
+    probeKeyFilters_ = std::move(filters.value());
+    VELOX_CHECK_EQ(probeKeyFilters_.size(), hashers.size());
+    std::vector<column_index_t> channels;
+    channels.reserve(hashers.size());
+    for (const auto& hasher : hashers) {
+      channels.push_back(hasher->channel());
+    }
+    const auto pushdownChannels =
+        operatorCtx_->driverCtx()->driver->canPushdownFilters(this, channels);
+    for (auto i = 0; i < hashers.size(); ++i) {
+      if (probeKeyFilters_[i] != nullptr &&
+          pushdownChannels.count(channels[i]) > 0) {
+        dynamicFilters_.emplace(channels[i], probeKeyFilters_[i]);
+      }
+    }
+  }
+
+  const auto numRows = activeRows_.countSelected();
+  for (auto i = 0; i < hashers.size(); ++i) {
+    const auto* filter = probeKeyFilters_[i].get();
+    if (filter == nullptr) {
+      continue;
+    }
+    const auto& decoded = hashers[i]->decodedVector();
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        removeRowsFailingFilter<int8_t>(*filter, decoded, activeRows_);
+        break;
+      case TypeKind::SMALLINT:
+        removeRowsFailingFilter<int16_t>(*filter, decoded, activeRows_);
+        break;
+      case TypeKind::INTEGER:
+        removeRowsFailingFilter<int32_t>(*filter, decoded, activeRows_);
+        break;
+      case TypeKind::BIGINT:
+        removeRowsFailingFilter<int64_t>(*filter, decoded, activeRows_);
+        break;
+      default:
+        VELOX_UNREACHABLE(
+            "Unexpected probe key filter type: {}",
+            hashers[i]->type()->toString());
+    }
+  }
+  activeRows_.updateBounds();
+  addRuntimeStat(
+      "probeKeyFilteredRows",
+      RuntimeCounter(numRows - activeRows_.countSelected()));
+}
+
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
 
+  if (shareTable_) {
+    if (!sharedTable_.has_value()) {
+      sharedTable_ = BroadcastHashTableCache::instance().find(
+          operatorCtx_->task()->queryCtx()->queryId(), planNodeId());
+    }
+    if (sharedTable_.has_value()) {
+      // Another task has published the same table.
+      return;
+    }
+  }
+
+  if (canRestoreInBlocks() && !reserveMemory(input)) {
+    // The restored partition doesn't fit in memory and can't be spilled any
+    // further. Build the table from the rows added so far and build the next
+    // table from 'input' and the rest of the spill input after the probe side
+    // has processed this one.
+    VELOX_CHECK_NULL(nextBlockInput_);
+    nextBlockInput_ = std::move(input);
+    noMoreInputInternal();
+    return;
+  }
+
   if (!ensureInputFits(input)) {
     VELOX_CHECK_NOT_NULL(input_);
     VELOX_CHECK(future_.valid());
@@ -321,6 +420,9 @@ void HashBuild::addInput(RowVectorPtr input) {
         activeRows_.countSelected() < input->size()) {
       joinHasNullKeys_ = true;
     }
+    if (probeKeyFiltersEnabled_) {
+      removeInputRowsWithoutProbeMatch();
+    }
   } else if (nullAware_ && !joinHasNullKeys_) {
     for (auto& hasher : hashers) {
       auto& decoded = hasher->decodedVector();
@@ -437,7 +539,7 @@ bool HashBuild::reserveMemory(const RowVectorPtr& input) {
   int64_t flatBytes = input->estimateFlatSize();
 
   // Test-only spill path.
-  if (testingTriggerSpill()) {
+  if (spiller_ != nullptr && testingTriggerSpill()) {
     numSpillRows_ = std::max<int64_t>(1, numRows / 10);
     numSpillBytes_ = numSpillRows_ * outOfLineBytesPerRow;
     return false;
@@ -738,6 +840,7 @@ bool HashBuild::finishHashBuild() {
   otherTables.reserve(peers.size());
   SpillPartitionSet spillPartitions;
   Spiller::Stats spillStats;
+  bool hasMoreBlocks = nextBlockInput_ != nullptr;
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -753,6 +856,7 @@ bool HashBuild::finishHashBuild() {
         }
       }
       otherTables.push_back(std::move(build->table_));
+      hasMoreBlocks |= build->nextBlockInput_ != nullptr;
       if (build->spiller_ != nullptr) {
         spillStats += build->spiller_->stats();
         build->finishSpill(spillPartitions);
@@ -789,6 +893,11 @@ bool HashBuild::finishHashBuild() {
         }
       }
 
+      if (shareTable_) {
+        setSharedHashTable(std::move(otherTables), peers);
+        return true;
+      }
+
       // TODO: re-enable parallel join build with spilling triggered after
       // https://github.com/facebookincubator/velox/issues/3567 is fixed.
       const bool allowPrallelJoinBuild =
@@ -799,10 +908,18 @@ bool HashBuild::finishHashBuild() {
                                 : nullptr);
 
       addRuntimeStats();
+      if (hasMoreBlocks) {
+        addRuntimeStat("spillRestoreBlocks", RuntimeCounter(1));
+      }
+      auto keyFilters = nonEmptySpillPartitions.empty() && !hasMoreBlocks
+          ? makeKeyBloomFilters()
+          : std::vector<std::shared_ptr<common::Filter>>{};
       if (joinBridge_->setHashTable(
               std::move(table_),
               std::move(nonEmptySpillPartitions),
-              joinHasNullKeys_)) {
+              joinHasNullKeys_,
+              std::move(keyFilters),
+              hasMoreBlocks)) {
         spillGroup_->restart();
       }
     }
@@ -811,6 +928,52 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+bool HashBuild::canShareTable() const {
+  return joinNode_->isBroadcastBuild() && !spillEnabled() && !nullAware_ &&
+      !isRightJoin(joinType_) && !isFullJoin(joinType_) &&
+      !isRightSemiProjectJoin(joinType_) &&
+      operatorCtx_->driverCtx()->splitGroupId == kUngroupedGroupId;
+}
+
+void HashBuild::setSharedHashTable(
+    std::vector<std::unique_ptr<BaseHashTable>> otherTables,
+    const std::vector<std::shared_ptr<Driver>>& peers) {
+  auto& cache = BroadcastHashTableCache::instance();
+  const auto& queryId = operatorCtx_->task()->queryCtx()->queryId();
+  auto shared = cache.find(queryId, planNodeId());
+  if (shared.has_value()) {
+    addRuntimeStat("sharedBroadcastTable", RuntimeCounter(1));
+  } else {
+    auto* executor = otherTables.empty()
+        ? nullptr
+        : operatorCtx_->task()->queryCtx()->executor();
+    table_->prepareJoinTable(std::move(otherTables), executor);
+    addRuntimeStats();
+    auto keyFilters = makeKeyBloomFilters();
+    // The rows of the table are in the memory pools of all the build operators
+    // of this task. The pools must outlive the table, which may be probed
+    // after this task is gone.
+    std::vector<std::shared_ptr<memory::MemoryPool>> pools;
+    pools.reserve(peers.size() + 1);
+    pools.push_back(pool()->shared_from_this());
+    for (auto& peer : peers) {
+      pools.push_back(
+          peer->findOperator(planNodeId())->pool()->shared_from_this());
+    }
+    std::shared_ptr<BaseHashTable> table(
+        table_.release(),
+        [pools = std::move(pools)](BaseHashTable* table) { delete table; });
+    shared = cache.publish(
+        queryId,
+        planNodeId(),
+        BroadcastHashTableCache::Entry{
+            std::move(table), std::move(keyFilters)});
+  }
+  table_.reset();
+  joinBridge_->setHashTable(
+      shared->table, {}, joinHasNullKeys_, shared->keyFilters);
+}
+
 void HashBuild::postHashBuildProcess() {
   checkRunning();
 
@@ -835,6 +998,11 @@ void HashBuild::postHashBuildProcess() {
 void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   checkRunning();
 
+  if (spillInput.nextBlock) {
+    restoreNextBlock();
+    return;
+  }
+
   if (spillInput.spillPartition == nullptr) {
     setState(State::kFinish);
     return;
@@ -859,6 +1027,30 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   processSpillInput();
 }
 
+bool HashBuild::canRestoreInBlocks() const {
+  // NOTE: the tables built from the same partition are probed one after the
+  // other, so the join types which track the matches of probe side rows can't
+  // be restored in blocks.
+  return isInputFromSpill() && spiller_ == nullptr && !nullAware_ &&
+      (isInnerJoin(joinType_) || isRightJoin(joinType_) ||
+       isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_));
+}
+
+void HashBuild::restoreNextBlock() {
+  VELOX_CHECK(canRestoreInBlocks());
+
+  table_.reset();
+  setupTable();
+
+  if (nextBlockInput_ != nullptr) {
+    addInput(std::move(nextBlockInput_));
+    if (!isRunning()) {
+      return;
+    }
+  }
+  processSpillInput();
+}
+
 void HashBuild::processSpillInput() {
   checkRunning();
 
@@ -871,6 +1063,111 @@ void HashBuild::processSpillInput() {
   noMoreInputInternal();
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::makeKeyBloomFilters()
+    const {
+  const auto maxSize =
+      operatorCtx_->driverCtx()->queryConfig().joinBloomFilterMaxSize();
+  const auto numDistinct = table_->numDistinct();
+  if (maxSize == 0 || numDistinct == 0 ||
+      numDistinct > std::numeric_limits<int32_t>::max()) {
+    return {};
+  }
+  // Only the join types that push down dynamic filters in HashProbe.
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return {};
+  }
+  // BloomFilter::reset() allocates 2 bytes per expected value.
+  if (2 * bits::nextPowerOfTwo(numDistinct) > maxSize) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  const bool hashMode = table_->hashMode() == BaseHashTable::HashMode::kHash;
+  std::vector<column_index_t> keys;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        // The probe makes an exact filter from the distinct values if these
+        // are known.
+        if (hashMode || hashers[i]->distinctOverflow()) {
+          keys.push_back(i);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  if (keys.empty()) {
+    return {};
+  }
+
+  std::vector<std::shared_ptr<BloomFilter<>>> bloomFilters(keys.size());
+  std::vector<int64_t> mins(keys.size(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> maxs(keys.size(), std::numeric_limits<int64_t>::min());
+  for (auto& bloomFilter : bloomFilters) {
+    bloomFilter = std::make_shared<BloomFilter<>>();
+    bloomFilter->reset(numDistinct);
+  }
+
+  auto* rows = table_->rows();
+  BaseHashTable::RowsIterator iter;
+  std::vector<char*> buffer(1'024);
+  for (;;) {
+    const auto numRows = table_->listAllRows(
+        &iter,
+        buffer.size(),
+        std::numeric_limits<uint64_t>::max(),
+        buffer.data());
+    if (numRows == 0) {
+      break;
+    }
+    for (auto k = 0; k < keys.size(); ++k) {
+      const auto column = rows->columnAt(keys[k]);
+      const auto kind = hashers[keys[k]]->typeKind();
+      for (auto i = 0; i < numRows; ++i) {
+        const char* row = buffer[i];
+        if (RowContainer::isNullAt(row, column.nullByte(), column.nullMask())) {
+          continue;
+        }
+        int64_t value;
+        switch (kind) {
+          case TypeKind::TINYINT:
+            value = RowContainer::valueAt<int8_t>(row, column.offset());
+            break;
+          case TypeKind::SMALLINT:
+            value = RowContainer::valueAt<int16_t>(row, column.offset());
+            break;
+          case TypeKind::INTEGER:
+            value = RowContainer::valueAt<int32_t>(row, column.offset());
+            break;
+          default:
+            value = RowContainer::valueAt<int64_t>(row, column.offset());
+            break;
+        }
+        bloomFilters[k]->insert(folly::hasher<int64_t>()(value));
+        mins[k] = std::min(mins[k], value);
+        maxs[k] = std::max(maxs[k], value);
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> keyFilters(hashers.size());
+  for (auto k = 0; k < keys.size(); ++k) {
+    if (mins[k] > maxs[k]) {
+      // All keys are null.
+      continue;
+    }
+    keyFilters[keys[k]] =
+        std::make_shared<common::BigintValuesUsingBloomFilter>(
+            mins[k], maxs[k], std::move(bloomFilters[k]), false);
+  }
+  return keyFilters;
+}
+
 void HashBuild::addRuntimeStats() {
   // Report range sizes and number of distinct values for the join keys.
   const auto& hashers = table_->hashers();
@@ -895,6 +1192,8 @@ void HashBuild::addRuntimeStats() {
       RuntimeMetric(hashTableStats.capacity);
   lockedStats->runtimeStats["hashtable.numRehashes"] =
       RuntimeMetric(hashTableStats.numRehashes);
+  lockedStats->runtimeStats["hashtable.rehashTime"] = RuntimeMetric(
+      hashTableStats.rehashTimeUs * 1'000, RuntimeCounter::Unit::kNanos);
   lockedStats->runtimeStats["hashtable.numDistinct"] =
       RuntimeMetric(hashTableStats.numDistinct);
   if (hashTableStats.numTombstones != 0) {
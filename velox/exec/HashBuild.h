@@ -215,6 +215,17 @@ class HashBuild final : public Operator {
   // Invoked to process data from spill input reader on restoring.
   void processSpillInput();
 
+  // Indicates if the restored spill partition can be built into multiple
+  // tables, one block of its rows at a time, if it doesn't fit in memory. This
+  // applies if the partition can't be spilled further because of the max spill
+  // level and the join type only tracks the matches of the build side rows.
+  bool canRestoreInBlocks() const;
+
+  // Invoked to build the next table from 'nextBlockInput_' and the rest of
+  // 'spillInputReader_' after the probe side has processed the table built
+  // from the previous block of the restored spill partition.
+  void restoreNextBlock();
+
   // Set up for null-aware and regular anti-join with filter processing.
   void setupFilterForAntiJoins(
       const folly::F14FastMap<column_index_t, column_index_t>& keyChannelMap);
@@ -227,8 +238,33 @@ class HashBuild final : public Operator {
   // will be added to the joined output.
   void removeInputRowsForAntiJoinFilter();
 
+  // Invoked to remove the rows from 'activeRows_' whose join keys are not on
+  // the probe side of an inner join, once the probe side key filters are
+  // known. The first time, the filters are also pushed down into the build
+  // side scan. See HashJoinBridge::probeKeyFilters().
+  void removeInputRowsWithoutProbeMatch();
+
   void addRuntimeStats();
 
+  // Returns true if the tasks of the query on this worker can probe a single
+  // copy of the table of a broadcast join. The table must not be changed by
+  // the probe side, e.g. to flag matched rows, and must have all the build
+  // side rows, i.e. not spill.
+  bool canShareTable() const;
+
+  // Invoked by the last build driver of a broadcast join to hand over the
+  // table published by another task if any, otherwise to finish and publish
+  // its own table built from its table and 'otherTables' of its peers.
+  void setSharedHashTable(
+      std::vector<std::unique_ptr<BaseHashTable>> otherTables,
+      const std::vector<std::shared_ptr<Driver>>& peers);
+
+  // Returns a Bloom filter per integer join key when the table has too many
+  // distinct values for the probe side to push down an exact filter on the
+  // key. Returns an empty vector if 'kJoinBloomFilterMaxSize' is too small or
+  // the join type can't use the filters.
+  std::vector<std::shared_ptr<common::Filter>> makeKeyBloomFilters() const;
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -295,6 +331,10 @@ class HashBuild final : public Operator {
   // Used to read input from previously spilled data for restoring.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
 
+  // The spill input that didn't fit in memory when restoring in blocks. It is
+  // the first input of the next table built from the restored partition.
+  RowVectorPtr nextBlockInput_;
+
   // Reusable memory for spill partition calculation for input data.
   std::vector<uint32_t> spillPartitions_;
 
@@ -307,6 +347,23 @@ class HashBuild final : public Operator {
   // Indicates whether the filter is null-propagating.
   bool filterPropagatesNulls_{false};
 
+  // True if the table is shared with the other tasks of the query on this
+  // worker. See canShareTable().
+  bool shareTable_{false};
+
+  // The table published by another task, if found while adding input. The
+  // rest of the input is then dropped.
+  std::optional<BroadcastHashTableCache::Entry> sharedTable_;
+
+  // True if the build side rows without a match on the probe side are dropped
+  // once the probe side keys are known. See
+  // QueryConfig::hashJoinProbeBufferMaxRows().
+  bool probeKeyFiltersEnabled_{false};
+
+  // A filter on the probe side values of each join key, or null for the keys
+  // without one. Empty until known.
+  std::vector<std::shared_ptr<common::Filter>> probeKeyFilters_;
+
   // Indices of key columns used by the filter in build side table.
   std::vector<column_index_t> keyFilterChannels_;
   // Indices of dependent columns used by the filter in 'decoders_'.
@@ -17,6 +17,7 @@
 #include <re2/re2.h>
 
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -39,9 +40,11 @@ void HashJoinBridge::addBuilder() {
 }
 
 bool HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> keyFilters,
+    bool hasMoreBlocks) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -67,14 +70,23 @@ bool HashJoinBridge::setHashTable(
       VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
       spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
     }
+    if (hasMoreBlocks) {
+      VELOX_CHECK(restoringSpillPartitionId_.has_value());
+      VELOX_CHECK(spillPartitionIdSet.empty());
+      moreBlocksPartitionId_ = restoringSpillPartitionId_;
+    }
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(keyFilters),
+        hasMoreBlocks);
     restoringSpillPartitionId_.reset();
+    restoringNextBlock_ = false;
 
-    hasSpillData = !spillPartitionSets_.empty();
+    hasSpillData =
+        !spillPartitionSets_.empty() || moreBlocksPartitionId_.has_value();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -133,7 +145,15 @@ bool HashJoinBridge::probeFinished() {
     // table from the next spill partition now.
     buildResult_.reset();
 
-    if (!spillPartitionSets_.empty()) {
+    if (moreBlocksPartitionId_.has_value()) {
+      // Build the next table from the rest of the partition before restoring
+      // any other partition as the probe side keeps its probe rows.
+      hasSpillInput = true;
+      restoringSpillPartitionId_ = moreBlocksPartitionId_;
+      moreBlocksPartitionId_.reset();
+      restoringNextBlock_ = true;
+      promises = std::move(promises_);
+    } else if (!spillPartitionSets_.empty()) {
       hasSpillInput = true;
       restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
       restoringSpillShards_ =
@@ -158,7 +178,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
       !restoringSpillPartitionId_.has_value() || !buildResult_.has_value());
 
   if (!restoringSpillPartitionId_.has_value()) {
-    if (spillPartitionSets_.empty()) {
+    if (spillPartitionSets_.empty() && !moreBlocksPartitionId_.has_value()) {
       return HashJoinBridge::SpillInput{};
     } else {
       promises_.emplace_back("HashJoinBridge::spillInputOrFuture");
@@ -166,12 +186,197 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
       return std::nullopt;
     }
   }
+  if (restoringNextBlock_) {
+    return SpillInput(nullptr, true);
+  }
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
   return SpillInput(std::move(spillShard));
 }
 
+std::optional<std::vector<std::shared_ptr<common::Filter>>>
+HashJoinBridge::joinKeyFilters() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!buildResult_.has_value() || buildResult_->table == nullptr ||
+      buildResult_->restoredPartitionId.has_value() ||
+      !buildResult_->spillPartitionIds.empty()) {
+    return std::nullopt;
+  }
+  const auto& table = *buildResult_->table;
+  std::vector<std::shared_ptr<common::Filter>> filters;
+  filters.reserve(table.hashers().size());
+  for (auto i = 0; i < table.hashers().size(); ++i) {
+    filters.push_back(makeJoinKeyFilter(table, buildResult_->keyFilters, i));
+  }
+  return filters;
+}
+
+void HashJoinBridge::addProber(
+    const std::vector<std::unique_ptr<VectorHasher>>& hashers) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  ++numProbers_;
+  if (probeHashers_.empty()) {
+    for (const auto& hasher : hashers) {
+      probeHashers_.push_back(
+          VectorHasher::create(hasher->type(), hasher->channel()));
+    }
+  }
+}
+
+bool HashJoinBridge::addProbeInput(
+    const RowVectorPtr& input,
+    uint64_t maxRows) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (probeKeyFiltersAbandoned_) {
+    return false;
+  }
+  numProbeRows_ += input->size();
+  if (numProbeRows_ > maxRows) {
+    probeKeyFiltersAbandoned_ = true;
+    probeHashers_.clear();
+    return false;
+  }
+  SelectivityVector rows(input->size());
+  for (auto& hasher : probeHashers_) {
+    hasher->decode(*input->childAt(hasher->channel())->loadedVector(), rows);
+  }
+  // Null keys don't match in an inner join.
+  deselectRowsWithNulls(probeHashers_, rows);
+  raw_vector<uint64_t> valueIds(input->size());
+  bool hasValues = false;
+  for (auto& hasher : probeHashers_) {
+    if (!isProbeKeyFilterType(hasher->typeKind())) {
+      continue;
+    }
+    // Only the distinct values are kept, not the ids.
+    hasher->computeValueIds(rows, valueIds);
+    hasValues |= !hasher->distinctOverflow();
+  }
+  if (!hasValues) {
+    probeKeyFiltersAbandoned_ = true;
+    probeHashers_.clear();
+    return false;
+  }
+  return true;
+}
+
+void HashJoinBridge::probeInputFinished(bool noMoreInput) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_LT(numFinishedProbers_, numProbers_);
+  ++numFinishedProbers_;
+  if (!noMoreInput) {
+    probeKeyFiltersAbandoned_ = true;
+    probeHashers_.clear();
+  }
+  if (probeKeyFiltersAbandoned_ || numFinishedProbers_ < numProbers_) {
+    return;
+  }
+  // An integer key without probe side values, e.g. if the probe side is
+  // empty, gets a filter that drops all the build side rows.
+  bool hasFilter = false;
+  probeKeyFilters_.reserve(probeHashers_.size());
+  for (const auto& hasher : probeHashers_) {
+    if (isProbeKeyFilterType(hasher->typeKind())) {
+      probeKeyFilters_.push_back(hasher->getFilter(false));
+      hasFilter |= probeKeyFilters_.back() != nullptr;
+    } else {
+      probeKeyFilters_.push_back(nullptr);
+    }
+  }
+  probeHashers_.clear();
+  probeKeyFiltersReady_ = hasFilter;
+}
+
+std::optional<std::vector<std::shared_ptr<common::Filter>>>
+HashJoinBridge::probeKeyFilters() {
+  if (!probeKeyFiltersReady_) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  return probeKeyFilters_;
+}
+
+bool isProbeKeyFilterType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+namespace {
+std::string broadcastTableKey(
+    const std::string& queryId,
+    const core::PlanNodeId& joinNodeId) {
+  return fmt::format("{}/{}", queryId, joinNodeId);
+}
+} // namespace
+
+// static
+BroadcastHashTableCache& BroadcastHashTableCache::instance() {
+  static BroadcastHashTableCache cache;
+  return cache;
+}
+
+std::optional<BroadcastHashTableCache::Entry> BroadcastHashTableCache::find(
+    const std::string& queryId,
+    const core::PlanNodeId& joinNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(broadcastTableKey(queryId, joinNodeId));
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  auto table = it->second.table.lock();
+  if (table == nullptr) {
+    return std::nullopt;
+  }
+  return Entry{std::move(table), it->second.keyFilters};
+}
+
+BroadcastHashTableCache::Entry BroadcastHashTableCache::publish(
+    const std::string& queryId,
+    const core::PlanNodeId& joinNodeId,
+    Entry entry) {
+  VELOX_CHECK_NOT_NULL(entry.table);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& weakEntry = entries_[broadcastTableKey(queryId, joinNodeId)];
+  if (auto table = weakEntry.table.lock()) {
+    return Entry{std::move(table), weakEntry.keyFilters};
+  }
+  weakEntry.table = entry.table;
+  weakEntry.keyFilters = entry.keyFilters;
+  // Drop the entries of the tables that are no longer used.
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.table.expired()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return entry;
+}
+
+std::unique_ptr<common::Filter> makeJoinKeyFilter(
+    const BaseHashTable& table,
+    const std::vector<std::shared_ptr<common::Filter>>& keyFilters,
+    column_index_t key) {
+  std::unique_ptr<common::Filter> filter;
+  if (table.hashMode() != BaseHashTable::HashMode::kHash) {
+    filter = table.hashers()[key]->getFilter(false);
+  }
+  if (filter == nullptr && key < keyFilters.size() &&
+      keyFilters[key] != nullptr) {
+    filter = keyFilters[key]->clone();
+  }
+  return filter;
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
@@ -15,9 +15,12 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Spill.h"
+#include "velox/exec/VectorHasher.h"
 
 namespace facebook::velox::exec {
 
@@ -37,11 +40,19 @@ class HashJoinBridge : public JoinBridge {
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'keyFilters' has an optional
+  /// filter per join key built from the build side key values, which the
+  /// HashProbe operators can push down as dynamic filters. 'hasMoreBlocks' is
+  /// true if 'table' is built from part of the restored spill partition
+  /// because the partition doesn't fit in memory and can't be spilled further.
+  /// The HashBuild operators build the next table from the rest of the
+  /// partition after the HashProbe operators process 'table'.
   bool setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> keyFilters = {},
+      bool hasMoreBlocks = false);
 
   void setAntiJoinHasNullKeys();
 
@@ -56,11 +67,15 @@ class HashJoinBridge : public JoinBridge {
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _keyFilters = {},
+        bool _hasMoreBlocks = false)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          keyFilters(std::move(_keyFilters)),
+          hasMoreBlocks(_hasMoreBlocks) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -68,6 +83,13 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    // Null or a filter on the build side values of each join key. Empty if
+    // no filters were built.
+    std::vector<std::shared_ptr<common::Filter>> keyFilters;
+    // True if 'table' only has part of the build side rows of
+    // 'restoredPartitionId'. The HashProbe operators need to keep the probe
+    // side rows of the partition to probe the next table built from it.
+    bool hasMoreBlocks{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -86,13 +108,16 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'nextBlock' is true if the HashBuild operator continues
+  /// to build the next table from the partition shard it is restoring.
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool nextBlock = false)
+        : spillPartition(std::move(spillPartition)), nextBlock(nextBlock) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool nextBlock;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -104,9 +129,61 @@ class HashJoinBridge : public JoinBridge {
   std::optional<SpillInput> spillInputOrFuture(
       ContinueFuture* FOLLY_NONNULL future);
 
+  /// Returns a filter on the build side values of each join key, or null for
+  /// the keys without one. Returns std::nullopt if the table is not built yet
+  /// or doesn't have all the build side rows, i.e. the build side spilled.
+  std::optional<std::vector<std::shared_ptr<common::Filter>>> joinKeyFilters();
+
+  /// Invoked by HashProbe operator ctor of an inner join that buffers its
+  /// input while the table is built. 'hashers' are the probe side key hashers
+  /// of the operator.
+  void addProber(const std::vector<std::unique_ptr<VectorHasher>>& hashers);
+
+  /// Invoked by HashProbe operator to add the join keys of a buffered
+  /// 'input'. The function returns false if the probe side has more than
+  /// 'maxRows' rows or too many distinct keys, in which case the probe side
+  /// key filters are abandoned for all the HashProbe operators.
+  bool addProbeInput(const RowVectorPtr& input, uint64_t maxRows);
+
+  /// Invoked by HashProbe operator when it stops buffering input, either
+  /// because it has no more input or because the table is already built.
+  /// When all the HashProbe operators have buffered all their input, the
+  /// bridge makes the filters returned by probeKeyFilters().
+  void probeInputFinished(bool noMoreInput);
+
+  /// Returns a filter on the probe side values of each join key, or null for
+  /// the keys without one, if all the probe side input is buffered and fits
+  /// the limit. The HashBuild operators of an inner join drop the build side
+  /// rows that don't pass them, since these can't have a match. Returns
+  /// std::nullopt otherwise.
+  std::optional<std::vector<std::shared_ptr<common::Filter>>>
+  probeKeyFilters();
+
  private:
   uint32_t numBuilders_{0};
 
+  // The number of HashProbe operators that buffer their input while the table
+  // is built and the number of these that finished buffering.
+  uint32_t numProbers_{0};
+  uint32_t numFinishedProbers_{0};
+
+  // The number of buffered probe side rows.
+  uint64_t numProbeRows_{0};
+
+  // True if the probe side key filters can't be made, e.g. because the probe
+  // side has too many rows.
+  bool probeKeyFiltersAbandoned_{false};
+
+  // Tracks the distinct values of the buffered probe side keys. Only the
+  // integer keys are tracked. See isProbeKeyFilterType().
+  std::vector<std::unique_ptr<VectorHasher>> probeHashers_;
+
+  std::vector<std::shared_ptr<common::Filter>> probeKeyFilters_;
+
+  // Set after 'probeKeyFilters_' is made. Checked without 'mutex_' by the
+  // HashBuild operators on each input.
+  std::atomic<bool> probeKeyFiltersReady_{false};
+
   std::optional<HashBuildResult> buildResult_;
 
   // restoringSpillPartitionXxx member variables are populated by the
@@ -123,6 +200,15 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // Set to the restoring spill partition id if the built table only has part
+  // of its rows. The partition is restored again from the HashBuild
+  // operators' remaining spill input after the probe side finishes.
+  std::optional<SpillPartitionId> moreBlocksPartitionId_;
+
+  // True if the HashBuild operators build the next table from the rest of
+  // 'restoringSpillPartitionId_' instead of from 'restoringSpillShards_'.
+  bool restoringNextBlock_{false};
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
@@ -130,6 +216,57 @@ class HashJoinBridge : public JoinBridge {
   SpillPartitionSet spillPartitionSets_;
 };
 
+/// Shares the hash tables of broadcast joins between the tasks of a query on
+/// the same worker. These tasks all build the same table from the same build
+/// side, so the first task to finish its table publishes it here and the
+/// others probe it instead of their own. A task that has not finished its
+/// table when one is published stops adding to its own. The tables are held by
+/// weak pointers and are freed with the last HashProbe that uses them.
+class BroadcastHashTableCache {
+ public:
+  struct Entry {
+    std::shared_ptr<BaseHashTable> table;
+    std::vector<std::shared_ptr<common::Filter>> keyFilters;
+  };
+
+  static BroadcastHashTableCache& instance();
+
+  /// Returns the table of the join node 'joinNodeId' of 'queryId' if one is
+  /// published and still in use.
+  std::optional<Entry> find(
+      const std::string& queryId,
+      const core::PlanNodeId& joinNodeId);
+
+  /// Publishes 'entry' for the join node unless another task did so first.
+  /// Returns the published entry.
+  Entry publish(
+      const std::string& queryId,
+      const core::PlanNodeId& joinNodeId,
+      Entry entry);
+
+ private:
+  struct WeakEntry {
+    std::weak_ptr<BaseHashTable> table;
+    std::vector<std::shared_ptr<common::Filter>> keyFilters;
+  };
+
+  std::mutex mutex_;
+  // Keyed on query id and join node id.
+  folly::F14FastMap<std::string, WeakEntry> entries_;
+};
+
+// Returns a filter on the values of the 'key'th join key of 'table' or null if
+// there is none. Uses the distinct values of the key if these are known,
+// otherwise the filter for the key in 'keyFilters' if any.
+std::unique_ptr<common::Filter> makeJoinKeyFilter(
+    const BaseHashTable& table,
+    const std::vector<std::shared_ptr<common::Filter>>& keyFilters,
+    column_index_t key);
+
+// Returns true if the probe side values of a join key of 'kind' can be made
+// into a filter on the build side.
+bool isProbeKeyFilterType(TypeKind kind);
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
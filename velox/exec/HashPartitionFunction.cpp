@@ -16,6 +16,9 @@
 #include <velox/exec/HashPartitionFunction.h>
 #include <velox/exec/VectorHasher.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace facebook::velox::exec {
 HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
@@ -143,4 +146,123 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   return std::make_shared<HashPartitionFunctionSpec>(
       ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
 }
+
+namespace {
+// Odd multipliers for deriving the counter of each row of the sketch from the
+// key hash.
+constexpr uint64_t kSketchSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL};
+} // namespace
+
+SkewedHashPartitionFunction::SkewedHashPartitionFunction(
+    int numPartitions,
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& keyChannels,
+    Mode mode,
+    int32_t sprayWidth,
+    double skewFactor)
+    : hashFunction_(numPartitions, inputType, keyChannels),
+      mode_(mode),
+      sprayWidth_(std::clamp<int32_t>(sprayWidth, 1, numPartitions)),
+      skewFactor_(skewFactor) {
+  VELOX_CHECK_GT(skewFactor_, 0);
+  if (mode_ == Mode::kSpray) {
+    sketch_.resize(kSketchDepth * kSketchWidth);
+  }
+}
+
+uint32_t SkewedHashPartitionFunction::addToSketch(uint64_t hash) {
+  static_assert(
+      sizeof(kSketchSeeds) / sizeof(kSketchSeeds[0]) == kSketchDepth);
+  uint32_t count = std::numeric_limits<uint32_t>::max();
+  for (auto row = 0; row < kSketchDepth; ++row) {
+    const auto mixed = (hash + kSketchSeeds[row]) * kSketchSeeds[row];
+    auto& counter =
+        sketch_[row * kSketchWidth + ((mixed >> 32) & (kSketchWidth - 1))];
+    count = std::min(count, ++counter);
+  }
+  return count;
+}
+
+void SkewedHashPartitionFunction::partition(
+    const RowVector& input,
+    std::vector<uint32_t>& partitions) {
+  hashFunction_.partition(input, partitions);
+  if (mode_ == Mode::kReplicate || sprayWidth_ == 1) {
+    return;
+  }
+  const auto& hashes = hashFunction_.hashes();
+  const auto numPartitions = hashFunction_.numPartitions();
+  const auto size = input.size();
+  for (auto i = 0; i < size; ++i) {
+    const auto count = addToSketch(hashes[i]);
+    ++numRows_;
+    if (numRows_ >= kMinRows &&
+        static_cast<double>(count) * numPartitions > skewFactor_ * numRows_) {
+      partitions[i] =
+          (partitions[i] + nextSpray_++ % sprayWidth_) % numPartitions;
+      ++numSprayedRows_;
+    }
+    if (numRows_ >= kDecayRows) {
+      for (auto& counter : sketch_) {
+        counter /= 2;
+      }
+      numRows_ /= 2;
+    }
+  }
+}
+
+std::unique_ptr<core::PartitionFunction>
+SkewedHashPartitionFunctionSpec::create(int numPartitions) const {
+  return std::make_unique<SkewedHashPartitionFunction>(
+      numPartitions, inputType_, keyChannels_, mode_, sprayWidth_, skewFactor_);
+}
+
+std::string SkewedHashPartitionFunctionSpec::toString() const {
+  std::ostringstream keys;
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    if (i > 0) {
+      keys << ", ";
+    }
+    keys << inputType_->nameOf(keyChannels_[i]);
+  }
+  return fmt::format(
+      "SKEWED_HASH({}, {} {})",
+      keys.str(),
+      mode_ == Mode::kSpray ? "spray" : "replicate",
+      sprayWidth_);
+}
+
+folly::dynamic SkewedHashPartitionFunctionSpec::serialize() const {
+  folly::dynamic obj = folly::dynamic::object;
+  obj["name"] = "SkewedHashPartitionFunctionSpec";
+  obj["inputType"] = inputType_->serialize();
+  obj["keyChannels"] = ISerializable::serialize(keyChannels_);
+  obj["mode"] = mode_ == Mode::kSpray ? "SPRAY" : "REPLICATE";
+  obj["sprayWidth"] = sprayWidth_;
+  obj["skewFactor"] = skewFactor_;
+  return obj;
+}
+
+// static
+core::PartitionFunctionSpecPtr SkewedHashPartitionFunctionSpec::deserialize(
+    const folly::dynamic& obj,
+    void* context) {
+  const auto keys = ISerializable::deserialize<std::vector<column_index_t>>(
+      obj["keyChannels"], context);
+  const auto mode = obj["mode"].asString();
+  VELOX_USER_CHECK(
+      mode == "SPRAY" || mode == "REPLICATE",
+      "Unknown skewed partitioning mode: {}",
+      mode);
+  return std::make_shared<SkewedHashPartitionFunctionSpec>(
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      mode == "SPRAY" ? Mode::kSpray : Mode::kReplicate,
+      obj["sprayWidth"].asInt(),
+      obj["skewFactor"].asDouble());
+}
 } // namespace facebook::velox::exec
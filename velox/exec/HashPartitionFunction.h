@@ -44,6 +44,11 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Returns the hashes of the keys of the rows of the last partition() call.
+  const raw_vector<uint64_t>& hashes() const {
+    return hashes_;
+  }
+
  private:
   void init(
       const RowTypePtr& inputType,
@@ -90,4 +95,112 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
 };
+
+/// Hash partitioning for the two sides of a join with skewed keys. In kSpray
+/// mode, which is for the skewed side, rows go to their hash partition unless
+/// their key is hot, in which case they are spread round robin over the
+/// 'sprayWidth' consecutive partitions that start at the hash partition. A key
+/// is hot when a count-min sketch of the key hashes estimates that it alone
+/// has more than 'skewFactor' times the average number of rows of a partition.
+/// Each producer decides which keys are hot from its own input, so in
+/// kReplicate mode, which is for the other side, every row is copied to all
+/// the 'sprayWidth' partitions of its key. The copies make this fit only joins
+/// that do not produce unmatched rows of the replicated side.
+class SkewedHashPartitionFunction : public core::PartitionFunction {
+ public:
+  enum class Mode { kSpray, kReplicate };
+
+  static constexpr double kDefaultSkewFactor = 1.0;
+
+  SkewedHashPartitionFunction(
+      int numPartitions,
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& keyChannels,
+      Mode mode,
+      int32_t sprayWidth,
+      double skewFactor = kDefaultSkewFactor);
+
+  void partition(const RowVector& input, std::vector<uint32_t>& partitions)
+      override;
+
+  int32_t numReplicas() const override {
+    return mode_ == Mode::kReplicate ? sprayWidth_ : 1;
+  }
+
+  int numPartitions() const {
+    return hashFunction_.numPartitions();
+  }
+
+  int32_t sprayWidth() const {
+    return sprayWidth_;
+  }
+
+  /// Number of rows that did not go to their hash partition because their key
+  /// was hot.
+  uint64_t numSprayedRows() const {
+    return numSprayedRows_;
+  }
+
+ private:
+  static constexpr int32_t kSketchDepth = 4;
+  static constexpr int32_t kSketchWidth = 1024;
+  // Number of rows to see before any key can be hot.
+  static constexpr int64_t kMinRows = 10'000;
+  // Number of rows after which the counts are halved, so that the hot keys
+  // are decided by recent input.
+  static constexpr int64_t kDecayRows = 1 << 20;
+
+  // Counts a row with key 'hash' and returns the estimated number of rows with
+  // the key.
+  uint32_t addToSketch(uint64_t hash);
+
+  HashPartitionFunction hashFunction_;
+  const Mode mode_;
+  const int32_t sprayWidth_;
+  const double skewFactor_;
+
+  // 'kSketchDepth' rows of 'kSketchWidth' counters.
+  std::vector<uint32_t> sketch_;
+  int64_t numRows_{0};
+  uint32_t nextSpray_{0};
+  uint64_t numSprayedRows_{0};
+};
+
+/// Factory class to create SkewedHashPartitionFunction. The two sides of a
+/// skewed join use specs with the same keys and 'sprayWidth', one in kSpray
+/// and the other in kReplicate mode.
+class SkewedHashPartitionFunctionSpec : public core::PartitionFunctionSpec {
+ public:
+  using Mode = SkewedHashPartitionFunction::Mode;
+
+  SkewedHashPartitionFunctionSpec(
+      RowTypePtr inputType,
+      std::vector<column_index_t> keyChannels,
+      Mode mode,
+      int32_t sprayWidth,
+      double skewFactor = SkewedHashPartitionFunction::kDefaultSkewFactor)
+      : inputType_{std::move(inputType)},
+        keyChannels_{std::move(keyChannels)},
+        mode_{mode},
+        sprayWidth_{sprayWidth},
+        skewFactor_{skewFactor} {}
+
+  std::unique_ptr<core::PartitionFunction> create(
+      int numPartitions) const override;
+
+  std::string toString() const override;
+
+  folly::dynamic serialize() const override;
+
+  static core::PartitionFunctionSpecPtr deserialize(
+      const folly::dynamic& obj,
+      void* context);
+
+ private:
+  const RowTypePtr inputType_;
+  const std::vector<column_index_t> keyChannels_;
+  const Mode mode_;
+  const int32_t sprayWidth_;
+  const double skewFactor_;
+};
 } // namespace facebook::velox::exec
@@ -15,10 +15,13 @@
  */
 
 #include "velox/exec/HashProbe.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::exec {
 
 namespace {
@@ -115,6 +118,8 @@ HashProbe::HashProbe(
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
       outputBatchSize_{outputBatchRows()},
+      adaptiveOutputBatchRows_{
+          driverCtx->queryConfig().adaptiveOutputBatchRowsEnabled()},
       joinNode_(std::move(joinNode)),
       joinType_{joinNode_->joinType()},
       nullAware_{joinNode_->isNullAware()},
@@ -135,6 +140,18 @@ HashProbe::HashProbe(
   }
 
   lookup_ = std::make_unique<HashLookup>(hashers_);
+  lookup_->probeLane = driverCtx->driverId;
+  lookup_->numProbeLanes = operatorCtx_->task()->numDrivers(driverCtx->driver);
+  if (isInnerJoin(joinType_) &&
+      std::any_of(hashers_.begin(), hashers_.end(), [](const auto& hasher) {
+        return isProbeKeyFilterType(hasher->typeKind());
+      })) {
+    probeBufferMaxRows_ = driverCtx->queryConfig().hashJoinProbeBufferMaxRows();
+    if (probeBufferMaxRows_ > 0) {
+      bufferingInput_ = true;
+      joinBridge_->addProber(hashers_);
+    }
+  }
   auto buildType = joinNode_->sources()[1]->outputType();
   auto tableType = makeTableType(buildType.get(), joinNode_->rightKeys());
   if (joinNode_->filter()) {
@@ -212,8 +229,10 @@ void HashProbe::initializeFilter(
 
 void HashProbe::maybeSetupSpillInput(
     const std::optional<SpillPartitionId>& restoredPartitionId,
-    const SpillPartitionIdSet& spillPartitionIds) {
+    const SpillPartitionIdSet& spillPartitionIds,
+    bool hasMoreBlocks) {
   VELOX_CHECK_NULL(spillInputReader_);
+  VELOX_CHECK_NULL(restoreSpiller_);
 
   // If 'restoredPartitionId' is not null, then 'table_' is built from the
   // spilled build data. Create an unsorted reader to read the probe inputs from
@@ -223,10 +242,30 @@ void HashProbe::maybeSetupSpillInput(
     VELOX_CHECK(iter != spillPartitionSet_.end());
     auto partition = std::move(iter->second);
     VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
-    spillInputReader_ = partition->createReader();
+    spillInputReader_ = partition->createReader(spillConfig_->executor);
     spillPartitionSet_.erase(iter);
   }
 
+  if (hasMoreBlocks) {
+    VELOX_CHECK(restoredPartitionId.has_value());
+    VELOX_CHECK(spillPartitionIds.empty());
+    const auto& spillConfig = spillConfig_.value();
+    const auto startBit = restoredPartitionId->partitionBitOffset();
+    restoreSpiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kHashJoinProbe,
+        probeType_,
+        HashBitRange(startBit, startBit + spillConfig.hashBitRange.numBits()),
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.codecOptions,
+        spillConfig.tiers);
+    restoreSpiller_->setPartitionsSpilled(
+        {static_cast<uint32_t>(restoredPartitionId->partitionNumber())});
+  }
+
   VELOX_CHECK_NULL(spiller_);
   spillInputPartitionIds_ = spillPartitionIds;
   if (spillInputPartitionIds_.empty()) {
@@ -247,7 +286,9 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.maxFileSize,
       spillConfig.minSpillRunSize,
       Spiller::spillPool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.codecOptions,
+      spillConfig.tiers);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -270,6 +311,11 @@ void HashProbe::asyncWaitForHashTable() {
     return;
   }
 
+  if (bufferingInput_) {
+    // The table is built before all the probe side input is buffered.
+    finishBufferingInput(false);
+  }
+
   if (hashBuildResult->hasNullKeys) {
     VELOX_CHECK(nullAware_);
     if (isAntiJoin(joinType_) && !joinNode_->filter()) {
@@ -285,35 +331,44 @@ void HashProbe::asyncWaitForHashTable() {
 
   table_ = std::move(hashBuildResult->table);
   VELOX_CHECK_NOT_NULL(table_);
+  const auto keyFilters = std::move(hashBuildResult->keyFilters);
 
   maybeSetupSpillInput(
-      hashBuildResult->restoredPartitionId, hashBuildResult->spillPartitionIds);
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->spillPartitionIds,
+      hashBuildResult->hasMoreBlocks);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
-      if (!needSpillInput()) {
+      if (!needSpillInput() && restoreSpiller_ == nullptr) {
+        bufferedInput_.clear();
+        noMoreInputDeferred_ = false;
         noMoreInput();
       }
     }
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !keyFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
     // filters to push down.
     //
+    // The exact filter on the distinct values of a key is preferred. The
+    // Bloom filter built by HashBuild is used for the keys with too many
+    // distinct values.
+    //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
-    const auto& buildHashers = table_->hashers();
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
       if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
+        if (auto filter = makeJoinKeyFilter(*table_, keyFilters, i)) {
           dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
         }
       }
@@ -334,6 +389,7 @@ void HashProbe::prepareForSpillRestore() {
   noMoreSpillInput_ = false;
   table_.reset();
   spiller_.reset();
+  restoreSpiller_.reset();
   spillInputReader_.reset();
   spillInputPartitionIds_.clear();
   lastProbeIterator_.reset();
@@ -363,6 +419,10 @@ void HashProbe::addSpillInput() {
     noMoreInputInternal();
     return;
   }
+  if (restoreSpiller_ != nullptr) {
+    restoreSpiller_->spill(
+        *restoreSpiller_->state().spilledPartitionSet().begin(), input_);
+  }
 
   addInput(std::move(input_));
 }
@@ -437,6 +497,13 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
   switch (state_) {
     case ProbeOperatorState::kWaitForBuild:
       VELOX_CHECK_NULL(table_);
+      if (future_.valid() && bufferingInput_) {
+        if (!future_.isReady()) {
+          // Keeps taking input while the table is built.
+          return BlockingReason::kNotBlocked;
+        }
+        future_ = ContinueFuture::makeEmpty();
+      }
       if (!future_.valid()) {
         setRunning();
         asyncWaitForHashTable();
@@ -476,8 +543,10 @@ void HashProbe::clearDynamicFilters() {
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
   //  * build side has no dependent columns.
+  // The buffered input has not been filtered.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      bufferedInput_.empty()) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -500,8 +569,38 @@ void HashProbe::decodeAndDetectNonNullKeys() {
   }
 }
 
+void HashProbe::bufferInput(RowVectorPtr input) {
+  VELOX_CHECK(bufferingInput_);
+  if (!joinBridge_->addProbeInput(input, probeBufferMaxRows_)) {
+    finishBufferingInput(false);
+  }
+  bufferedInput_.push_back(std::move(input));
+}
+
+void HashProbe::finishBufferingInput(bool noMoreInput) {
+  VELOX_CHECK(bufferingInput_);
+  bufferingInput_ = false;
+  joinBridge_->probeInputFinished(noMoreInput);
+  TestValue::adjust(
+      "facebook::velox::exec::HashProbe::finishBufferingInput", this);
+  if (noMoreInput) {
+    int64_t numRows = 0;
+    for (const auto& input : bufferedInput_) {
+      numRows += input->size();
+    }
+    addRuntimeStat("bufferedProbeInputRows", RuntimeCounter(numRows));
+  }
+}
+
 void HashProbe::addInput(RowVectorPtr input) {
+  if (table_ == nullptr) {
+    bufferInput(std::move(input));
+    return;
+  }
   input_ = std::move(input);
+  if (adaptiveOutputBatchRows_) {
+    outputBatchSize_ = outputBatchRows();
+  }
 
   if (input_->size() > 0) {
     noInput_ = false;
@@ -529,7 +628,7 @@ void HashProbe::addInput(RowVectorPtr input) {
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
-      VELOX_CHECK(needSpillInput());
+      VELOX_CHECK(needSpillInput() || restoreSpiller_ != nullptr);
       input_ = nullptr;
       return;
     }
@@ -828,9 +927,28 @@ RowVectorPtr HashProbe::getOutput() {
   if (isFinished()) {
     return nullptr;
   }
+  if (state_ == ProbeOperatorState::kWaitForBuild) {
+    // Buffering input until the table is built.
+    VELOX_CHECK(bufferingInput_);
+    return nullptr;
+  }
   checkRunning();
 
   clearIdentityProjectedOutput();
+  if (!input_ && !bufferedInput_.empty()) {
+    auto input = std::move(bufferedInput_.front());
+    bufferedInput_.pop_front();
+    addInput(std::move(input));
+    if (!input_) {
+      return nullptr;
+    }
+  }
+  if (!input_ && noMoreInputDeferred_) {
+    VELOX_CHECK(bufferedInput_.empty());
+    noMoreInputDeferred_ = false;
+    noMoreInputInternal();
+    return nullptr;
+  }
   if (!input_) {
     if (!hasMoreInput()) {
       if (needLastProbe() && lastProber_) {
@@ -1330,6 +1448,14 @@ void HashProbe::ensureLoadedIfNotAtEnd(column_index_t channel) {
 
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
+  if (table_ == nullptr && probeBufferMaxRows_ > 0) {
+    // The input is buffered while the table is built.
+    if (bufferingInput_) {
+      finishBufferingInput(true);
+    }
+    noMoreInputDeferred_ = true;
+    return;
+  }
   noMoreInputInternal();
 }
 
@@ -1346,6 +1472,9 @@ void HashProbe::noMoreInputInternal() {
         spillInputPartitionIds_.size(), spiller_->spilledPartitionSet().size());
     spiller_->finishSpill(spillPartitionSet_);
   }
+  if (restoreSpiller_ != nullptr) {
+    restoreSpiller_->finishSpill(spillPartitionSet_);
+  }
 
   // Setup spill partition data.
   const bool hasSpillData = hasMoreSpillData();
@@ -1399,8 +1528,10 @@ void HashProbe::close() {
   Operator::close();
 
   // Free up major memory usage.
+  bufferedInput_.clear();
   joinBridge_.reset();
   spiller_.reset();
+  restoreSpiller_.reset();
   table_.reset();
 }
 
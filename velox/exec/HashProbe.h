@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
@@ -37,6 +39,13 @@ class HashProbe : public Operator {
         noMoreSpillInput_ || input_ != nullptr) {
       return false;
     }
+    if (bufferingInput_) {
+      return true;
+    }
+    if (!bufferedInput_.empty()) {
+      // Probes the buffered input first.
+      return false;
+    }
     if (table_) {
       return true;
     }
@@ -85,10 +94,13 @@ class HashProbe : public Operator {
   // 'restoredSpillPartitionId' is not null. If 'spillPartitionIds' is not
   // empty, then spilling has been triggered at the build side and the function
   // will set up a spiller and the associated data structures to spill probe
-  // inputs.
+  // inputs. If 'hasMoreBlocks' is true, then the table only has part of the
+  // build-side rows of the restored partition and the function sets up
+  // 'restoreSpiller_' to keep the probe inputs for the next table.
   void maybeSetupSpillInput(
       const std::optional<SpillPartitionId>& restoredSpillPartitionId,
-      const SpillPartitionIdSet& spillPartitionIds);
+      const SpillPartitionIdSet& spillPartitionIds,
+      bool hasMoreBlocks);
 
   // Sets up 'filter_' and related members.p
   void initializeFilter(
@@ -212,6 +224,15 @@ class HashProbe : public Operator {
   /// Decode join key inputs and populate 'nonNullInputRows_'.
   void decodeAndDetectNonNullKeys();
 
+  // Invoked to keep 'input' until the table is built. The join keys are
+  // added to 'joinBridge_', which makes filters on them for the build side
+  // once all the probe side input is buffered.
+  void bufferInput(RowVectorPtr input);
+
+  // Invoked to stop buffering input. 'noMoreInput' is true if all the input is
+  // buffered.
+  void finishBufferingInput(bool noMoreInput);
+
   // Invoked when there is no more input from either upstream task or spill
   // input. If there is remaining spilled data, then the last finished probe
   // operator is responsible for notifying the hash build operators to build the
@@ -237,7 +258,10 @@ class HashProbe : public Operator {
   }
 
   // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Refreshed for each input if 'adaptiveOutputBatchRows_' is true.
+  uint32_t outputBatchSize_;
+
+  const bool adaptiveOutputBatchRows_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
@@ -293,6 +317,22 @@ class HashProbe : public Operator {
   // same pipeline.
   std::shared_ptr<BaseHashTable> table_;
 
+  // The max number of probe side rows that the HashProbe operators of an
+  // inner join buffer while the table is built. 0 if the input is not
+  // buffered. See QueryConfig::hashJoinProbeBufferMaxRows().
+  uint64_t probeBufferMaxRows_{0};
+
+  // True while the input is buffered waiting for the table.
+  bool bufferingInput_{false};
+
+  // The input received before the table is built. It is probed first once the
+  // table is built.
+  std::deque<RowVectorPtr> bufferedInput_;
+
+  // True if noMoreInput() is called before the table is built. The end of
+  // input is processed after 'bufferedInput_' is probed.
+  bool noMoreInputDeferred_{false};
+
   // Indicates whether there was no input. Used for right semi join project.
   bool noInput_{true};
 
@@ -545,6 +585,12 @@ class HashProbe : public Operator {
   // corresponding spilled data on disk.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
 
+  // 'restoreSpiller_' is only created if 'table_' is built from one block of
+  // a restored spill partition which doesn't fit in memory. It spills the
+  // probe inputs read from 'spillInputReader_' back to the same partition to
+  // probe the table built from the next block.
+  std::unique_ptr<Spiller> restoreSpiller_;
+
   // Sets to true after read all the probe inputs from 'spillInputReader_'.
   bool noMoreSpillInput_{false};
 
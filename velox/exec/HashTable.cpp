@@ -20,6 +20,7 @@
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/process/ProcessBase.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -29,8 +30,93 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 namespace {
 constexpr int32_t kMinTableSizeForParallelJoinBuild = 1000;
+
+// Returns the bytes that a key of 'kind' takes in a packed key, 0 if keys of
+// 'kind' are not packed. Floating point keys are not packed because their
+// equality is not bitwise.
+int32_t packedKeyWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::DATE:
+      return 4;
+    case TypeKind::BIGINT:
+      return 8;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return 1 + StringView::kInlineSize;
+    default:
+      return 0;
+  }
 }
 
+// Writes 'value' to 'out' as a length byte followed by the bytes. Returns
+// false if 'value' is too long.
+inline bool packString(StringView value, char* out) {
+  if (value.size() > StringView::kInlineSize) {
+    return false;
+  }
+  out[0] = value.size();
+  if (!value.empty()) {
+    memcpy(out + 1, value.data(), value.size());
+  }
+  return true;
+}
+
+template <typename T>
+inline void
+packFixedWidth(const DecodedVector& decoded, vector_size_t index, char* out) {
+  const T value = decoded.valueAt<T>(index);
+  memcpy(out, &value, sizeof(T));
+}
+
+// Writes the non-null key at 'index' in 'decoded' to 'out'.
+bool packKey(
+    TypeKind kind,
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* out) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      out[0] = decoded.valueAt<bool>(index);
+      return true;
+    case TypeKind::TINYINT:
+      packFixedWidth<int8_t>(decoded, index, out);
+      return true;
+    case TypeKind::SMALLINT:
+      packFixedWidth<int16_t>(decoded, index, out);
+      return true;
+    case TypeKind::INTEGER:
+      packFixedWidth<int32_t>(decoded, index, out);
+      return true;
+    case TypeKind::DATE:
+      packFixedWidth<Date>(decoded, index, out);
+      return true;
+    case TypeKind::BIGINT:
+      packFixedWidth<int64_t>(decoded, index, out);
+      return true;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return packString(decoded.valueAt<StringView>(index), out);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Writes the non-null key at 'value' in a RowContainer row to 'out'.
+bool packKey(TypeKind kind, const char* value, char* out) {
+  if (kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) {
+    return packString(*reinterpret_cast<const StringView*>(value), out);
+  }
+  memcpy(out, value, packedKeyWidth(kind));
+  return true;
+}
+} // namespace
+
 // static
 std::string BaseHashTable::modeString(HashMode mode) {
   switch (mode) {
@@ -64,6 +150,10 @@ HashTable<ignoreNullKeys>::HashTable(
     }
   }
 
+  if (!isJoinBuild_) {
+    initPackedKeys();
+  }
+
   rows_ = std::make_unique<RowContainer>(
       keys,
       !ignoreNullKeys,
@@ -72,12 +162,106 @@ HashTable<ignoreNullKeys>::HashTable(
       allowDuplicates,
       isJoinBuild,
       hasProbedFlag,
-      hashMode_ != HashMode::kHash,
+      hashMode_ != HashMode::kHash || packedKeySize_ > 0,
       pool,
-      ContainerRowSerde::instance());
+      ContainerRowSerde::instance(),
+      std::max<int32_t>(sizeof(normalized_key_t), packedKeySize_));
   nextOffset_ = rows_->nextOffset();
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::initPackedKeys() {
+  int32_t size = ignoreNullKeys ? 0 : bits::nbytes(hashers_.size());
+  bool hasString = false;
+  std::vector<int32_t> offsets;
+  for (auto& hasher : hashers_) {
+    const auto width = packedKeyWidth(hasher->typeKind());
+    if (width == 0) {
+      return;
+    }
+    hasString |= hasher->typeKind() == TypeKind::VARCHAR ||
+        hasher->typeKind() == TypeKind::VARBINARY;
+    offsets.push_back(size);
+    size += width;
+  }
+  // A single fixed width key compares as fast in the row.
+  if (size > kMaxPackedKeySize || (hashers_.size() == 1 && !hasString)) {
+    return;
+  }
+  packedKeySize_ = size <= kMaxPackedKeySize / 2 ? kMaxPackedKeySize / 2
+                                                  : kMaxPackedKeySize;
+  packedKeyOffsets_ = std::move(offsets);
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::packKeys(HashLookup& lookup) {
+  const auto numWords = packedKeySize_ / sizeof(uint64_t);
+  lookup.packedKeys.resize((lookup.rows.back() + 1) * numWords);
+  for (auto row : lookup.rows) {
+    auto key =
+        reinterpret_cast<char*>(lookup.packedKeys.data() + row * numWords);
+    memset(key, 0, packedKeySize_);
+    for (auto i = 0; i < hashers_.size(); ++i) {
+      const auto& decoded = lookup.hashers[i]->decodedVector();
+      if (!ignoreNullKeys && decoded.isNullAt(row)) {
+        bits::setBit(reinterpret_cast<uint8_t*>(key), i);
+        continue;
+      }
+      if (!packKey(
+              hashers_[i]->typeKind(),
+              decoded,
+              row,
+              key + packedKeyOffsets_[i])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::packRowKeys(char* row) {
+  auto key = row - packedKeySize_;
+  memset(key, 0, packedKeySize_);
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    const auto column = rows_->columnAt(i);
+    if (!ignoreNullKeys && (row[column.nullByte()] & column.nullMask())) {
+      bits::setBit(reinterpret_cast<uint8_t*>(key), i);
+      continue;
+    }
+    if (!packKey(
+            hashers_[i]->typeKind(),
+            row + column.offset(),
+            key + packedKeyOffsets_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::packAllRowKeys() {
+  constexpr int32_t kBatchSize = 1024;
+  // @lint-ignore CLANGTIDY
+  char* rows[kBatchSize];
+  RowContainerIterator iterator;
+  int32_t numRows;
+  while ((numRows = rows_->listRows(&iterator, kBatchSize, rows)) > 0) {
+    for (auto i = 0; i < numRows; ++i) {
+      if (!packRowKeys(rows[i])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::disablePackedKeys() {
+  packedKeySize_ = 0;
+  rows_->disableNormalizedKeys();
+}
+
 class ProbeState {
  public:
   enum class Operation { kProbe, kInsert, kErase };
@@ -311,6 +495,11 @@ char* HashTable<ignoreNullKeys>::insertEntry(
     // the word below the row. Space was reserved in the allocation
     // unless we have given up on normalized keys.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
+  } else if (usePackedKeys()) {
+    memcpy(
+        group - packedKeySize_,
+        lookup.packedKeys.data() + row * (packedKeySize_ / sizeof(uint64_t)),
+        packedKeySize_);
   }
   ++numDistinct_;
   lookup.newGroups.push_back(row);
@@ -376,6 +565,25 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
         !isJoin && extraCheck);
     return;
   }
+  if (!isJoin && usePackedKeys()) {
+    const auto numWords = packedKeySize_ / sizeof(uint64_t);
+    // NOLINT
+    lookup.hits[state.row()] = state.fullProbe<op>(
+        tags_,
+        table_,
+        sizeMask_,
+        -packedKeySize_,
+        [&](char* group, int32_t row) INLINE_LAMBDA {
+          return comparePackedKeys(
+              group, lookup.packedKeys.data() + row * numWords);
+        },
+        [&](int32_t index, int32_t row) {
+          return insertEntry(lookup, row, index);
+        },
+        numTombstones_,
+        extraCheck);
+    return;
+  }
   // NOLINT
   lookup.hits[state.row()] = state.fullProbe<op>(
       tags_,
@@ -432,6 +640,8 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   checkSize(lookup.rows.size());
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
+  } else if (usePackedKeys() && !packKeys(lookup)) {
+    disablePackedKeys();
   }
   ProbeState state1;
   ProbeState state2;
@@ -440,7 +650,11 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   auto rows = lookup.rows.data();
+  const bool prefetch = shouldPrefetchProbes();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (prefetch && probeIndex + kProbePrefetchDistance + 4 <= numProbes) {
+      prefetchProbes(rows + probeIndex + kProbePrefetchDistance, lookup);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -520,8 +734,16 @@ void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   if (hashMode_ == HashMode::kArray) {
-    for (auto row : lookup.rows) {
-      auto index = lookup.hashes[row];
+    const auto numRows = lookup.rows.size();
+    const auto* rows = lookup.rows.data();
+    const auto* hashes = lookup.hashes.data();
+    const bool prefetch = shouldPrefetchProbes();
+    for (auto i = 0; i < numRows; ++i) {
+      if (prefetch && i + kProbePrefetchDistance < numRows) {
+        __builtin_prefetch(table_ + hashes[rows[i + kProbePrefetchDistance]]);
+      }
+      auto row = rows[i];
+      auto index = hashes[row];
       DCHECK_LT(index, capacity_);
       lookup.hits[row] = table_[index]; // NOLINT
     }
@@ -534,12 +756,16 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = joinProbeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
   ProbeState state4;
+  const bool prefetch = shouldPrefetchProbes();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (prefetch && probeIndex + kProbePrefetchDistance + 4 <= numProbes) {
+      prefetchProbes(rows + probeIndex + kProbePrefetchDistance, lookup);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(tags_, sizeMask_, lookup.hashes[row], row);
     row = rows[probeIndex + 1];
@@ -569,7 +795,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
+  const vector_size_t* rows = joinProbeRows(lookup);
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -577,7 +803,11 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   const uint64_t* keys = lookup.normalizedKeys.data();
   const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
+  const bool prefetch = shouldPrefetchProbes();
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    if (prefetch && probeIndex + kProbePrefetchDistance + 4 <= numProbes) {
+      prefetchProbes(rows + probeIndex + kProbePrefetchDistance, lookup);
+    }
     int32_t row = rows[probeIndex];
     state1.preProbe(tags_, sizeMask_, hashes[row], row);
     row = rows[probeIndex + 1];
@@ -608,6 +838,60 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::prefetchProbes(
+    const vector_size_t* rows,
+    const HashLookup& lookup) const {
+  for (auto i = 0; i < 4; ++i) {
+    const auto index =
+        ProbeState::tagsByteOffset(lookup.hashes[rows[i]], sizeMask_);
+    __builtin_prefetch(tags_ + index);
+    __builtin_prefetch(table_ + index);
+  }
+}
+
+template <bool ignoreNullKeys>
+const vector_size_t* HashTable<ignoreNullKeys>::joinProbeRows(
+    HashLookup& lookup) const {
+  const auto numRows = lookup.rows.size();
+  // One tag byte and one row pointer per slot.
+  const uint64_t tableBytes = capacity_ * (sizeof(char*) + 1);
+  if (numRows < kMinRowsForPartitionedProbe ||
+      tableBytes < minTableBytesForPartitionedProbe_ ||
+      tableBytes < 2 * kPartitionedProbeSliceBytes) {
+    return lookup.rows.data();
+  }
+  const int32_t partitionBits = std::min<int32_t>(
+      {kMaxPartitionedProbeBits,
+       sizeBits_,
+       63 - __builtin_clzll(tableBytes / kPartitionedProbeSliceBytes)});
+  const auto shift = sizeBits_ - partitionBits;
+  const auto hashes = lookup.hashes.data();
+  const int32_t numSlices = 1 << partitionBits;
+  std::vector<int32_t> offsets(numSlices, 0);
+  for (auto row : lookup.rows) {
+    ++offsets[(hashes[row] & sizeMask_) >> shift];
+  }
+  // The slices are laid out starting at the first slice of this probe's lane
+  // and wrap around.
+  const int32_t firstSlice = lookup.numProbeLanes > 1
+      ? static_cast<int64_t>(lookup.probeLane % lookup.numProbeLanes) *
+          numSlices / lookup.numProbeLanes
+      : 0;
+  int32_t offset = 0;
+  for (auto i = 0; i < numSlices; ++i) {
+    auto& sliceOffset = offsets[(firstSlice + i) & (numSlices - 1)];
+    const auto numSliceRows = sliceOffset;
+    sliceOffset = offset;
+    offset += numSliceRows;
+  }
+  lookup.partitionedRows.resize(numRows);
+  for (auto row : lookup.rows) {
+    lookup.partitionedRows[offsets[(hashes[row] & sizeMask_) >> shift]++] = row;
+  }
+  return lookup.partitionedRows.data();
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
   VELOX_CHECK(bits::isPowerOfTwo(size), "Size is not a power of two: {}", size);
@@ -1088,6 +1372,13 @@ void HashTable<ignoreNullKeys>::insertForJoin(
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash() {
   ++numRehashes_;
+  const auto timeBeforeUs = rehashTimeUs_;
+  const auto startUs = getCurrentTimeMicro();
+  SCOPE_EXIT {
+    // A rehash that changes the hash mode runs a nested rehash, whose time
+    // is already included here.
+    rehashTimeUs_ = timeBeforeUs + (getCurrentTimeMicro() - startUs);
+  };
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
     parallelJoinBuild();
@@ -1132,7 +1423,12 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
     for (auto& hasher : hashers_) {
       hasher->resetStats();
     }
-    rows_->disableNormalizedKeys();
+    // Packed keys replace the normalized keys below the rows.
+    if (packedKeySize_ == 0) {
+      rows_->disableNormalizedKeys();
+    } else if (!packAllRowKeys()) {
+      disablePackedKeys();
+    }
     capacity_ = 0;
     // Makes tables of the right size and rehashes.
     checkSize(numNew);
@@ -41,11 +41,24 @@ struct HashLookup {
   raw_vector<uint64_t> hashes;
   // If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   raw_vector<uint64_t> normalizedKeys;
+  // If the table stores packed keys, the packed keys of the input rows,
+  // 'packedKeySize' / 8 words per row.
+  raw_vector<uint64_t> packedKeys;
   // Hit for each row of input. nullptr if no hit. Points to the
   // corresponding group row.
   raw_vector<char*> hits;
   // Indices of newly inserted rows (not found during probe).
   std::vector<vector_size_t> newGroups;
+  // 'rows' grouped by the slice of a large join table that they probe. Set
+  // by HashTable::joinProbe().
+  raw_vector<vector_size_t> partitionedRows;
+  // Position of this probe among the concurrent probes of the same table.
+  // The probe with lane i of n visits the slices of a partitioned probe
+  // starting at slice i * numSlices / n, so that concurrent probes of a
+  // shared table work on different slices instead of contending for the
+  // same one.
+  int32_t probeLane{0};
+  int32_t numProbeLanes{1};
 };
 
 struct HashTableStats {
@@ -54,6 +67,8 @@ struct HashTableStats {
   int64_t numDistinct{0};
   /// Counts the number of tombstone table slots.
   int64_t numTombstones{0};
+  /// Time spent in rehash() calls.
+  uint64_t rehashTimeUs{0};
 };
 
 class BaseHashTable {
@@ -323,7 +338,8 @@ class HashTable : public BaseHashTable {
   // second occurrences of a key are to be silently ignored or will
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
-  // that matches join condition for right and full outer joins.
+  // that matches join condition for right and full outer joins. A partial
+  // aggregation uses the bit to track the groups with repeated input.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -336,14 +352,15 @@ class HashTable : public BaseHashTable {
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* FOLLY_NULLABLE pool) {
+      memory::MemoryPool* FOLLY_NULLABLE pool,
+      bool hasProbedFlag = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
         std::vector<TypePtr>{},
         false, // allowDuplicates
         false, // isJoinBuild
-        false, // hasProbedFlag
+        hasProbedFlag,
         pool);
   }
 
@@ -420,7 +437,7 @@ class HashTable : public BaseHashTable {
 
   HashTableStats stats() const override {
     return HashTableStats{
-        capacity_, numRehashes_, numDistinct_, numTombstones_};
+        capacity_, numRehashes_, numDistinct_, numTombstones_, rehashTimeUs_};
   }
 
   bool hasDuplicateKeys() const override {
@@ -463,6 +480,17 @@ class HashTable : public BaseHashTable {
     return rehashSize(capacity_ - numTombstones_);
   }
 
+  /// Sets the min size in bytes of the table for grouping the rows of a join
+  /// probe by the slice of the table that they probe.
+  void testingSetMinTableBytesForPartitionedProbe(uint64_t bytes) {
+    minTableBytesForPartitionedProbe_ = bytes;
+  }
+
+  /// Sets the min size in bytes of the table for prefetching ahead in probes.
+  void testingSetMinTableBytesForProbePrefetch(uint64_t bytes) {
+    minTableBytesForProbePrefetch_ = bytes;
+  }
+
   std::string toString() override;
 
   /// Invoked to check the consistency of the internal state. The function scans
@@ -478,6 +506,12 @@ class HashTable : public BaseHashTable {
     setHashMode(mode, numNew);
   }
 
+  /// Returns the size in bytes of the packed keys stored below each row, 0 if
+  /// keys are not packed.
+  int32_t packedKeySize() const {
+    return packedKeySize_;
+  }
+
  private:
   // Returns the number of entries after which the table gets rehashed.
   static uint64_t rehashSize(int64_t size) {
@@ -625,9 +659,62 @@ class HashTable : public BaseHashTable {
   template <bool isJoin>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
+  // Sets 'packedKeySize_' and 'packedKeyOffsets_' if the keys of a group by
+  // are of types that can be packed in at most kMaxPackedKeySize bytes.
+  void initPackedKeys();
+
+  // Fills 'lookup.packedKeys' from the keys of 'lookup.rows'. Returns false
+  // if some key does not fit, e.g. a string longer than
+  // StringView::kInlineSize.
+  bool packKeys(HashLookup& lookup);
+
+  // Packs the keys of 'row' into the bytes below 'row'. Returns false if some
+  // key does not fit.
+  bool packRowKeys(char* FOLLY_NONNULL row);
+
+  // Packs the keys of all rows in 'rows_'. Returns false if some key does not
+  // fit.
+  bool packAllRowKeys();
+
+  // Stops using packed keys. Keys are compared in the rows from then on.
+  void disablePackedKeys();
+
+  bool usePackedKeys() const {
+    return packedKeySize_ > 0 && hashMode_ == HashMode::kHash;
+  }
+
+  // Returns true if the packed key below 'group' equals 'key'.
+  bool comparePackedKeys(
+      const char* FOLLY_NONNULL group,
+      const uint64_t* FOLLY_NONNULL key) const {
+    auto packed = reinterpret_cast<const uint64_t*>(group - packedKeySize_);
+    uint64_t diff = 0;
+    for (auto i = 0; i < packedKeySize_ / sizeof(uint64_t); ++i) {
+      diff |= packed[i] ^ key[i];
+    }
+    return diff == 0;
+  }
+
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns the rows of 'lookup' in the order that joinProbe() probes them.
+  // If the table is larger than the cache, the rows are radix partitioned on
+  // the top bits of their bucket index, so that consecutive probes fall in a
+  // cache sized slice of the table. Returns 'lookup.rows' otherwise.
+  const vector_size_t* joinProbeRows(HashLookup& lookup) const;
+
+  // True if the table is larger than the cache, so that probes prefetch the
+  // tags and row pointers of the rows 'kProbePrefetchDistance' ahead.
+  bool shouldPrefetchProbes() const {
+    return capacity_ * (sizeof(char*) + 1) >= minTableBytesForProbePrefetch_;
+  }
+
+  // Prefetches the tags and row pointers that the probes of the 4 rows at
+  // 'rows' read first.
+  void prefetchProbes(const vector_size_t* rows, const HashLookup& lookup)
+      const;
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -666,6 +753,45 @@ class HashTable : public BaseHashTable {
     return isJoinBuild_ ? 0 : 50;
   }
 
+  // A join probe partitions its rows if the table is larger than this, which
+  // is more than a typical last level cache.
+  static constexpr uint64_t kMinTableBytesForPartitionedProbe = 32UL << 20;
+
+  // Bytes of the table that the probes of one partition access.
+  static constexpr uint64_t kPartitionedProbeSliceBytes = 1UL << 20;
+
+  static constexpr int32_t kMaxPartitionedProbeBits = 10;
+
+  // Min number of rows for partitioning a join probe.
+  static constexpr int32_t kMinRowsForPartitionedProbe = 256;
+
+  // Probes of tables at least this large prefetch ahead. This is on the order
+  // of a L2 cache.
+  static constexpr uint64_t kMinTableBytesForProbePrefetch = 1UL << 20;
+
+  // Number of rows between a prefetch and the probe that uses it.
+  static constexpr int32_t kProbePrefetchDistance = 16;
+
+  uint64_t minTableBytesForPartitionedProbe_{
+      kMinTableBytesForPartitionedProbe};
+
+  uint64_t minTableBytesForProbePrefetch_{kMinTableBytesForProbePrefetch};
+
+  // Max bytes of keys that are stored packed below each row.
+  static constexpr int32_t kMaxPackedKeySize = 32;
+
+  // Size of the packed keys stored below each row of a group by, 16 or 32
+  // bytes, 0 if keys are not packed. A packed key has a null flag per key
+  // if null keys are allowed, followed by the keys in order. A fixed width
+  // key is copied as is and a string is a length byte followed by up to
+  // StringView::kInlineSize bytes. The rest is 0. In kHash mode, a probe
+  // compares the packed keys with a few word compares instead of comparing
+  // the keys one by one.
+  int32_t packedKeySize_{0};
+
+  // Offset of each key in a packed key.
+  std::vector<int32_t> packedKeyOffsets_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
@@ -687,6 +813,8 @@ class HashTable : public BaseHashTable {
   int64_t numTombstones_{0};
   /// Counts the number of rehash() calls.
   int64_t numRehashes_{0};
+  /// Time spent in rehash() calls.
+  uint64_t rehashTimeUs_{0};
   HashMode hashMode_ = HashMode::kArray;
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
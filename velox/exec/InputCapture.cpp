@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/InputCapture.h"
+
+#include <folly/Conv.h>
+#include <folly/String.h>
+#include <folly/json.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <tuple>
+
+#include "velox/common/base/Fs.h"
+#include "velox/vector/VectorSaver.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+constexpr const char* kPlanFileName = "plan.json";
+constexpr const char* kVectorFileSuffix = ".vector";
+
+std::string taskDirectory(
+    const core::QueryConfig& config,
+    const std::string& taskId) {
+  return fmt::format("{}/{}", config.inputCaptureDir(), taskId);
+}
+
+bool capturesPlanNode(
+    const core::QueryConfig& config,
+    const core::PlanNodeId& planNodeId) {
+  std::vector<folly::StringPiece> ids;
+  folly::split(',', config.inputCapturePlanNodeIds(), ids, true);
+  return std::find(ids.begin(), ids.end(), planNodeId) != ids.end();
+}
+
+struct CapturedFile {
+  std::string operatorType;
+  int32_t pipelineId;
+  int32_t driverId;
+  int32_t batch;
+  std::string path;
+};
+
+// Parses <operatorType>_<pipelineId>_<driverId>_<batch>.vector. Returns
+// std::nullopt for other file names.
+std::optional<CapturedFile> parseFileName(const fs::path& path) {
+  if (path.extension() != kVectorFileSuffix) {
+    return std::nullopt;
+  }
+  std::vector<std::string> parts;
+  folly::split('_', path.stem().string(), parts);
+  if (parts.size() < 4) {
+    return std::nullopt;
+  }
+  const auto n = parts.size();
+  std::vector<std::string> typeParts(parts.begin(), parts.end() - 3);
+  try {
+    return CapturedFile{
+        folly::join('_', typeParts),
+        folly::to<int32_t>(parts[n - 3]),
+        folly::to<int32_t>(parts[n - 2]),
+        folly::to<int32_t>(parts[n - 1]),
+        path.string()};
+  } catch (const folly::ConversionError&) {
+    return std::nullopt;
+  }
+}
+
+core::PlanNodePtr findNode(
+    const core::PlanNodePtr& plan,
+    const core::PlanNodeId& planNodeId) {
+  if (plan->id() == planNodeId) {
+    return plan;
+  }
+  for (const auto& source : plan->sources()) {
+    if (auto node = findNode(source, planNodeId)) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
+// static
+bool InputCapture::enabled(const core::QueryConfig& config) {
+  return !config.inputCapturePlanNodeIds().empty() &&
+      !config.inputCaptureDir().empty() && config.inputCaptureMaxBatches() > 0;
+}
+
+// static
+std::unique_ptr<InputCapture> InputCapture::create(
+    const core::QueryConfig& config,
+    const std::string& taskId,
+    const core::PlanNodeId& planNodeId,
+    const std::string& operatorType,
+    int32_t pipelineId,
+    int32_t driverId) {
+  if (!enabled(config) || !capturesPlanNode(config, planNodeId)) {
+    return nullptr;
+  }
+  const auto directory =
+      planNodeDirectory(taskDirectory(config, taskId), planNodeId);
+  if (!common::generateFileDirectory(directory.c_str())) {
+    LOG(WARNING) << "Cannot create input capture directory " << directory;
+    return nullptr;
+  }
+  return std::unique_ptr<InputCapture>(new InputCapture(
+      fmt::format(
+          "{}/{}_{}_{}", directory, operatorType, pipelineId, driverId),
+      config.inputCaptureMaxBatches()));
+}
+
+// static
+void InputCapture::savePlan(
+    const core::QueryConfig& config,
+    const std::string& taskId,
+    const core::PlanNode& plan) {
+  const auto directory = taskDirectory(config, taskId);
+  try {
+    const auto json = folly::toJson(plan.serialize());
+    if (!common::generateFileDirectory(directory.c_str())) {
+      LOG(WARNING) << "Cannot create input capture directory " << directory;
+      return;
+    }
+    saveStringToFile(
+        json, fmt::format("{}/{}", directory, kPlanFileName).c_str());
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Cannot save the plan of task " << taskId
+                 << " for input capture: " << e.what();
+  }
+}
+
+void InputCapture::capture(const RowVectorPtr& input) {
+  if (numCaptured_ >= maxBatches_) {
+    return;
+  }
+  const auto path = fmt::format(
+      "{}_{}{}", filePrefix_, numCaptured_, kVectorFileSuffix);
+  try {
+    // A lazy vector that was not loaded when saved cannot be loaded after
+    // being restored.
+    std::vector<VectorPtr> children;
+    children.reserve(input->childrenSize());
+    for (const auto& child : input->children()) {
+      children.push_back(BaseVector::loadedVectorShared(child));
+    }
+    auto loaded = std::make_shared<RowVector>(
+        input->pool(),
+        input->type(),
+        input->nulls(),
+        input->size(),
+        std::move(children));
+    saveVectorToFile(loaded.get(), path.c_str());
+    ++numCaptured_;
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Stopping input capture after failing to write " << path
+                 << ": " << e.what();
+    numCaptured_ = maxBatches_;
+  }
+}
+
+// static
+std::string InputCapture::planNodeDirectory(
+    const std::string& taskDir,
+    const core::PlanNodeId& planNodeId) {
+  return fmt::format("{}/{}", taskDir, planNodeId);
+}
+
+// static
+std::vector<RowVectorPtr> InputCapture::restore(
+    const std::string& directory,
+    memory::MemoryPool* pool,
+    const std::string& operatorType) {
+  std::vector<CapturedFile> files;
+  for (const auto& entry : fs::directory_iterator(directory)) {
+    auto file = parseFileName(entry.path());
+    if (file.has_value() &&
+        (operatorType.empty() || file->operatorType == operatorType)) {
+      files.push_back(std::move(file.value()));
+    }
+  }
+  std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+    return std::tie(a.operatorType, a.pipelineId, a.driverId, a.batch) <
+        std::tie(b.operatorType, b.pipelineId, b.driverId, b.batch);
+  });
+
+  std::vector<RowVectorPtr> inputs;
+  inputs.reserve(files.size());
+  for (const auto& file : files) {
+    inputs.push_back(std::dynamic_pointer_cast<RowVector>(
+        restoreVectorFromFile(file.path.c_str(), pool)));
+    VELOX_CHECK_NOT_NULL(inputs.back(), "Not a RowVector: {}", file.path);
+  }
+  return inputs;
+}
+
+// static
+core::PlanNodePtr InputCapture::makeReplayPlan(
+    const core::PlanNodePtr& plan,
+    const core::PlanNodeId& planNodeId,
+    std::vector<RowVectorPtr> inputs,
+    memory::MemoryPool* pool) {
+  auto node = findNode(plan, planNodeId);
+  VELOX_USER_CHECK_NOT_NULL(node, "Plan node not found: {}", planNodeId);
+  VELOX_USER_CHECK_EQ(
+      node->sources().size(),
+      1,
+      "Only plan nodes with one source can be replayed: {}",
+      node->toString());
+  VELOX_USER_CHECK(!inputs.empty(), "No inputs to replay");
+
+  // Replaces the source of the node in its serialized form so that any
+  // serializable plan node can be replayed.
+  auto serialized = node->serialize();
+  serialized["sources"] = folly::dynamic::array(
+      core::ValuesNode(fmt::format("{}.replay", planNodeId), std::move(inputs))
+          .serialize());
+  return ISerializable::deserialize<core::PlanNode>(serialized, pool);
+}
+
+} // namespace facebook::velox::exec
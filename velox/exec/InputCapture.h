@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "velox/core/PlanNode.h"
+#include "velox/core/QueryConfig.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Saves the first input batches of an operator to files so that a slow
+/// operator of a production query can be replayed in a benchmark. Enabled by
+/// the input_capture_plan_node_ids and input_capture_dir query configs.
+///
+/// The files of a task are laid out as:
+///   <input_capture_dir>/<taskId>/plan.json
+///   <input_capture_dir>/<taskId>/<planNodeId>/
+///       <operatorType>_<pipelineId>_<driverId>_<batch>.vector
+///
+/// plan.json holds the serialized plan of the task. Each .vector file holds a
+/// batch written by saveVector(). Each operator of a captured plan node writes
+/// its own files, e.g. both HashBuild and HashProbe for a join.
+class InputCapture {
+ public:
+  /// Returns an InputCapture for an operator of 'planNodeId' if 'config'
+  /// enables capture for that plan node, nullptr otherwise.
+  static std::unique_ptr<InputCapture> create(
+      const core::QueryConfig& config,
+      const std::string& taskId,
+      const core::PlanNodeId& planNodeId,
+      const std::string& operatorType,
+      int32_t pipelineId,
+      int32_t driverId);
+
+  /// Returns true if 'config' enables input capture for any plan node.
+  static bool enabled(const core::QueryConfig& config);
+
+  /// Saves 'plan' as JSON to <input_capture_dir>/<taskId>/plan.json. Logs and
+  /// ignores errors, e.g. for plan nodes that do not support serialization.
+  static void savePlan(
+      const core::QueryConfig& config,
+      const std::string& taskId,
+      const core::PlanNode& plan);
+
+  /// Saves 'input' unless the configured number of batches has been saved.
+  /// Lazy columns are loaded first. Logs write errors and stops capturing
+  /// instead of failing the query.
+  void capture(const RowVectorPtr& input);
+
+  /// Returns the number of batches saved so far.
+  int32_t numCaptured() const {
+    return numCaptured_;
+  }
+
+  /// Returns the directory with the captured inputs of 'planNodeId' in the
+  /// task capture directory 'taskDir', i.e. <input_capture_dir>/<taskId>.
+  static std::string planNodeDirectory(
+      const std::string& taskDir,
+      const core::PlanNodeId& planNodeId);
+
+  /// Reads the batches saved in 'directory' whose file names start with
+  /// 'operatorType', ordered by pipeline, driver and batch. Reads all batches
+  /// if 'operatorType' is empty.
+  static std::vector<RowVectorPtr> restore(
+      const std::string& directory,
+      memory::MemoryPool* pool,
+      const std::string& operatorType = "");
+
+  /// Returns a copy of the plan node 'planNodeId' in 'plan' that reads
+  /// 'inputs' from a ValuesNode instead of its source. The node must have a
+  /// single source. Requires the plan node and expression SerDe to be
+  /// registered.
+  static core::PlanNodePtr makeReplayPlan(
+      const core::PlanNodePtr& plan,
+      const core::PlanNodeId& planNodeId,
+      std::vector<RowVectorPtr> inputs,
+      memory::MemoryPool* pool);
+
+ private:
+  InputCapture(std::string filePrefix, int32_t maxBatches)
+      : filePrefix_(std::move(filePrefix)), maxBatches_(maxBatches) {}
+
+  // Path of the files without the batch number and suffix.
+  const std::string filePrefix_;
+  const int32_t maxBatches_;
+  int32_t numCaptured_{0};
+};
+
+} // namespace facebook::velox::exec
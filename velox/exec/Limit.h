@@ -38,6 +38,13 @@ class Limit : public Operator {
     return finished_ || (noMoreInput_ && input_ == nullptr);
   }
 
+  std::optional<int64_t> maxInputRows() const override {
+    if (input_ != nullptr) {
+      return std::nullopt;
+    }
+    return static_cast<int64_t>(remainingOffset_) + remainingLimit_;
+  }
+
  private:
   int32_t remainingOffset_;
   int32_t remainingLimit_;
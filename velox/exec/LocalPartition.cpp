@@ -62,6 +62,36 @@ void LocalExchangeQueue::addProducer() {
   });
 }
 
+void LocalExchangeQueue::enableScaling(
+    int64_t scaleUpBytes,
+    std::function<bool()> canScaleUp) {
+  VELOX_CHECK_GT(scaleUpBytes, 0);
+  queue_.withWLock([&](auto& /*queue*/) {
+    scaleUpBytes_ = scaleUpBytes;
+    canScaleUp_ = std::move(canScaleUp);
+    numActiveConsumers_ = 1;
+  });
+}
+
+int LocalExchangeQueue::numActiveConsumers() {
+  return queue_.withWLock(
+      [&](auto& /*queue*/) { return numActiveConsumers_; });
+}
+
+bool LocalExchangeQueue::maybeScaleUpLocked() {
+  if (scaleUpBytes_ == 0 || numActiveConsumers_ >= numConsumers_ ||
+      queuedBytes_ < scaleUpBytes_ ||
+      enqueuedBytes_ - lastScaleUpBytes_ < scaleUpBytes_) {
+    return false;
+  }
+  if (canScaleUp_ && !canScaleUp_()) {
+    return false;
+  }
+  ++numActiveConsumers_;
+  lastScaleUpBytes_ = enqueuedBytes_;
+  return true;
+}
+
 void LocalExchangeQueue::noMoreProducers() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> producerPromises;
@@ -94,6 +124,9 @@ BlockingReason LocalExchangeQueue::enqueue(
       return true;
     }
     queue.push(std::move(input));
+    queuedBytes_ += inputBytes;
+    enqueuedBytes_ += inputBytes;
+    maybeScaleUpLocked();
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -136,12 +169,15 @@ void LocalExchangeQueue::noMoreData() {
 BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
-    RowVectorPtr* data) {
+    RowVectorPtr* data,
+    int consumer) {
   std::vector<ContinuePromise> producerPromises;
+  std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
-    if (queue.empty()) {
+    const bool inactive = scaleUpBytes_ > 0 && consumer >= numActiveConsumers_;
+    if (queue.empty() || inactive) {
       if (isFinishedLocked(queue)) {
         return BlockingReason::kNotBlocked;
       }
@@ -155,17 +191,21 @@ BlockingReason LocalExchangeQueue::next(
     *data = queue.front();
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    const auto bytes = (*data)->estimateFlatSize();
+    queuedBytes_ -= bytes;
+    memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
 
     if (noMoreProducers_ && pendingProducers_ == 0 && queue.empty()) {
       producerPromises = std::move(producerPromises_);
+      // Inactive consumers wait for the queue to be drained.
+      consumerPromises = std::move(consumerPromises_);
     }
 
     return BlockingReason::kNotBlocked;
   });
   notify(memoryPromises);
   notify(producerPromises);
+  notify(consumerPromises);
   return blockingReason;
 }
 
@@ -204,11 +244,17 @@ void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
   queue_.withWLock([&](auto& queue) {
+    if (numOpenConsumers_ > 1) {
+      // Other consumers still read from the queue.
+      --numOpenConsumers_;
+      return;
+    }
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
       freedBytes += queue.front()->estimateFlatSize();
       queue.pop();
     }
+    queuedBytes_ = 0;
 
     if (freedBytes) {
       memoryPromises = memoryManager_->decreaseMemoryUsage(freedBytes);
@@ -223,6 +269,10 @@ void LocalExchangeQueue::close() {
   notify(memoryPromises);
 }
 
+bool LocalExchangeQueue::isClosed() {
+  return queue_.withWLock([&](auto& /*queue*/) { return closed_; });
+}
+
 LocalExchange::LocalExchange(
     int32_t operatorId,
     DriverCtx* ctx,
@@ -254,7 +304,7 @@ BlockingReason LocalExchange::isBlocked(ContinueFuture* future) {
 
 RowVectorPtr LocalExchange::getOutput() {
   RowVectorPtr data;
-  blockingReason_ = queue_->next(&future_, pool(), &data);
+  blockingReason_ = queue_->next(&future_, pool(), &data, partition_);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     return nullptr;
   }
@@ -404,6 +454,13 @@ void LocalPartition::noMoreInput() {
 }
 
 bool LocalPartition::isFinished() {
+  // If all consumers are done, e.g. after a Limit, the producers stop early.
+  if (std::all_of(queues_.begin(), queues_.end(), [](const auto& queue) {
+        return queue->isClosed();
+      })) {
+    return true;
+  }
+
   if (!futures_.empty() || !noMoreInput_) {
     return false;
   }
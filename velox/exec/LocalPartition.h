@@ -48,13 +48,19 @@ class LocalExchangeMemoryManager {
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
 /// must be called after all producers have been registered. A producer calls
 /// 'enqueue' multiple time to put the data and calls 'noMoreData' when done.
-/// Consumers call 'next' repeatedly to fetch the data.
+/// Consumers call 'next' repeatedly to fetch the data. A queue may be shared by
+/// 'numConsumers' consumers that each take the next available vector.
 class LocalExchangeQueue {
  public:
   LocalExchangeQueue(
       std::shared_ptr<LocalExchangeMemoryManager> memoryManager,
-      int partition)
-      : memoryManager_{std::move(memoryManager)}, partition_{partition} {}
+      int partition,
+      int numConsumers = 1)
+      : memoryManager_{std::move(memoryManager)},
+        partition_{partition},
+        numConsumers_{numConsumers},
+        numActiveConsumers_{numConsumers},
+        numOpenConsumers_{numConsumers} {}
 
   std::string toString() const {
     return fmt::format("LocalExchangeQueue({})", partition_);
@@ -62,6 +68,17 @@ class LocalExchangeQueue {
 
   void addProducer();
 
+  /// Makes a shared queue start with a single active consumer and activate
+  /// one more each time at least 'scaleUpBytes' are queued and at least
+  /// 'scaleUpBytes' were enqueued since the last activation, provided that
+  /// 'canScaleUp' returns true. Inactive consumers wait for activation or
+  /// the end of the data and then finish without receiving any. This is used
+  /// to scale the number of table writers with the amount of data.
+  void enableScaling(int64_t scaleUpBytes, std::function<bool()> canScaleUp);
+
+  /// Returns the number of consumers that may receive data.
+  int numActiveConsumers();
+
   void noMoreProducers();
 
   /// Used by a producer to add data. Returning kNotBlocked if can accept more
@@ -79,8 +96,13 @@ class LocalExchangeQueue {
   /// once there is data to fetch or if all producers report completion.
   ///
   /// @param pool Memory pool used to copy the data before returning.
-  BlockingReason
-  next(ContinueFuture* future, memory::MemoryPool* pool, RowVectorPtr* data);
+  /// @param consumer The number of the consumer of a shared queue. Only
+  /// matters if scaling is enabled.
+  BlockingReason next(
+      ContinueFuture* future,
+      memory::MemoryPool* pool,
+      RowVectorPtr* data,
+      int consumer = 0);
 
   /// Used by producers to get notified when all data has been fetched. Returns
   /// kNotBlocked if all data has been fetched. Otherwise, returns
@@ -93,12 +115,21 @@ class LocalExchangeQueue {
   bool isFinished();
 
   /// Drop remaining data from the queue and notify consumers and producers if
-  /// called before all the data has been processed. No-op otherwise.
+  /// called before all the data has been processed. No-op otherwise. A shared
+  /// queue is closed by the last of its consumers.
   void close();
 
+  /// Returns true if all consumers have closed the queue. Data enqueued after
+  /// this is dropped.
+  bool isClosed();
+
  private:
   bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
 
+  // Activates one more consumer if scaling is enabled and the queue is backed
+  // up. Returns true if a consumer was activated.
+  bool maybeScaleUpLocked();
+
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
   folly::Synchronized<std::queue<RowVectorPtr>> queue_;
@@ -111,6 +142,19 @@ class LocalExchangeQueue {
   // zero.
   std::vector<ContinuePromise> producerPromises_;
   int pendingProducers_{0};
+  const int numConsumers_;
+  // Consumers numbered below this may receive data.
+  int numActiveConsumers_;
+  // Number of consumers that have not called close().
+  int numOpenConsumers_;
+  // Scaling of active consumers. 0 'scaleUpBytes_' disables scaling.
+  int64_t scaleUpBytes_{0};
+  std::function<bool()> canScaleUp_;
+  // Bytes in 'queue_', bytes enqueued in total and the latter at the last
+  // activation of a consumer.
+  int64_t queuedBytes_{0};
+  int64_t enqueuedBytes_{0};
+  int64_t lastScaleUpBytes_{0};
   bool noMoreProducers_{false};
   bool closed_{false};
 };
@@ -153,7 +197,9 @@ class LocalExchange : public SourceOperator {
 };
 
 /// Hash partitions the data using specified keys. The number of partitions is
-/// determined by the number of LocalExchangeQueues(s) found in the task.
+/// determined by the number of LocalExchangeQueues(s) found in the task. A
+/// work stealing round robin exchange has a single queue shared by all
+/// consumers, which receives whole input vectors.
 class LocalPartition : public Operator {
  public:
   LocalPartition(
@@ -30,6 +30,7 @@
 #include "velox/exec/MarkDistinct.h"
 #include "velox/exec/Merge.h"
 #include "velox/exec/MergeJoin.h"
+#include "velox/exec/MergeSmallVectors.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/NestedLoopJoinProbe.h"
 #include "velox/exec/OrderBy.h"
@@ -187,9 +188,11 @@ uint32_t maxDrivers(const DriverFactory& driverFactory) {
       if (!values->isParallelizable()) {
         return 1;
       }
-    } else if (std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
-      // ArrowStream node must run single-threaded.
-      return 1;
+    } else if (
+        auto arrowStream =
+            std::dynamic_pointer_cast<const core::ArrowStreamNode>(node)) {
+      // Each driver of an ArrowStream node reads its own streams.
+      return arrowStream->arrowStreams().size();
     } else if (
         auto limit = std::dynamic_pointer_cast<const core::LimitNode>(node)) {
       // final limit must run single-threaded
@@ -366,6 +369,112 @@ void LocalPlanner::markMixedJoinBridges(
   }
 }
 
+namespace {
+// Rewrites a partial aggregation over a GroupId into a pre-aggregation of the
+// GroupId input on all grouping keys, a GroupId over the pre-aggregated rows
+// and an intermediate aggregation of the grouping sets. The input is then
+// aggregated once and only the partial results are replicated per grouping
+// set. Returns the three plan nodes in pipeline order or an empty vector if
+// 'aggregation' cannot be rewritten.
+std::vector<core::PlanNodePtr> makeGroupingSetsPreAggregation(
+    const std::shared_ptr<const core::GroupIdNode>& groupId,
+    const std::shared_ptr<const core::AggregationNode>& aggregation) {
+  using Step = core::AggregationNode::Step;
+  if (aggregation->step() != Step::kPartial ||
+      aggregation->aggregates().empty() ||
+      !aggregation->preGroupedKeys().empty() ||
+      aggregation->ignoreNullKeys()) {
+    return {};
+  }
+
+  std::vector<core::FieldAccessTypedExprPtr> preGroupingKeys;
+  std::unordered_set<std::string> preGroupingKeyNames;
+  for (const auto& info : groupId->groupingKeyInfos()) {
+    if (preGroupingKeyNames.insert(info.input->name()).second) {
+      preGroupingKeys.push_back(info.input);
+    }
+  }
+  for (const auto& name : aggregation->aggregateNames()) {
+    if (preGroupingKeyNames.count(name) > 0) {
+      return {};
+    }
+  }
+
+  // The aggregates must read only the aggregation inputs of the GroupId,
+  // which have the same names in its input.
+  std::unordered_set<std::string> aggregationInputs;
+  for (const auto& input : groupId->aggregationInputs()) {
+    aggregationInputs.insert(input->name());
+  }
+  for (const auto& aggregate : aggregation->aggregates()) {
+    if (aggregate.mask != nullptr || !aggregate.sortingKeys.empty()) {
+      return {};
+    }
+    for (const auto& input : aggregate.call->inputs()) {
+      if (auto field =
+              std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+                  input)) {
+        if (aggregationInputs.count(field->name()) == 0) {
+          return {};
+        }
+      } else if (!std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+                     input)) {
+        return {};
+      }
+    }
+  }
+
+  auto preAggregation = std::make_shared<core::AggregationNode>(
+      fmt::format("{}.preAggregation", aggregation->id()),
+      Step::kPartial,
+      preGroupingKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregation->aggregateNames(),
+      aggregation->aggregates(),
+      false,
+      groupId->sources()[0]);
+
+  const auto numKeys = aggregation->groupingKeys().size();
+  const auto& aggregateNames = aggregation->aggregateNames();
+  std::vector<core::FieldAccessTypedExprPtr> intermediateInputs;
+  std::vector<core::AggregationNode::Aggregate> intermediateAggregates;
+  for (auto i = 0; i < aggregateNames.size(); ++i) {
+    const auto& type = aggregation->outputType()->childAt(numKeys + i);
+    auto field =
+        std::make_shared<core::FieldAccessTypedExpr>(type, aggregateNames[i]);
+    intermediateInputs.push_back(field);
+    intermediateAggregates.push_back(
+        {std::make_shared<core::CallTypedExpr>(
+             type,
+             std::vector<core::TypedExprPtr>{field},
+             aggregation->aggregates()[i].call->name()),
+         nullptr,
+         {},
+         {}});
+  }
+
+  auto preAggregatedGroupId = std::make_shared<core::GroupIdNode>(
+      groupId->id(),
+      groupId->groupingSets(),
+      groupId->groupingKeyInfos(),
+      std::move(intermediateInputs),
+      groupId->outputType()->names().back(),
+      preAggregation);
+
+  auto intermediateAggregation = std::make_shared<core::AggregationNode>(
+      aggregation->id(),
+      Step::kIntermediate,
+      aggregation->groupingKeys(),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      intermediateAggregates,
+      false,
+      preAggregatedGroupId);
+
+  return {preAggregation, preAggregatedGroupId, intermediateAggregation};
+}
+} // namespace
+
 std::shared_ptr<Driver> DriverFactory::createDriver(
     std::unique_ptr<DriverCtx> ctx,
     std::shared_ptr<ExchangeClient> exchangeClient,
@@ -388,12 +497,20 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
                 std::dynamic_pointer_cast<const core::ProjectNode>(next)) {
           operators.push_back(std::make_unique<FilterProject>(
               id, ctx.get(), filterNode, projectNode));
+          if (ctx->queryConfig().mergeSmallVectorsEnabled()) {
+            operators.push_back(std::make_unique<MergeSmallVectors>(
+                operators.size(), ctx.get(), projectNode->outputType()));
+          }
           i++;
           continue;
         }
       }
       operators.push_back(
           std::make_unique<FilterProject>(id, ctx.get(), filterNode, nullptr));
+      if (ctx->queryConfig().mergeSmallVectorsEnabled()) {
+        operators.push_back(std::make_unique<MergeSmallVectors>(
+            operators.size(), ctx.get(), filterNode->outputType()));
+      }
     } else if (
         auto projectNode =
             std::dynamic_pointer_cast<const core::ProjectNode>(planNode)) {
@@ -466,6 +583,35 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto groupIdNode =
             std::dynamic_pointer_cast<const core::GroupIdNode>(planNode)) {
+      std::vector<core::PlanNodePtr> preAggregation;
+      if (ctx->queryConfig().groupingSetsPreAggregationEnabled() &&
+          i < planNodes.size() - 1) {
+        if (auto aggregationNode =
+                std::dynamic_pointer_cast<const core::AggregationNode>(
+                    planNodes[i + 1])) {
+          preAggregation =
+              makeGroupingSetsPreAggregation(groupIdNode, aggregationNode);
+        }
+      }
+      if (!preAggregation.empty()) {
+        operators.push_back(std::make_unique<HashAggregation>(
+            id,
+            ctx.get(),
+            std::dynamic_pointer_cast<const core::AggregationNode>(
+                preAggregation[0])));
+        operators.push_back(std::make_unique<GroupId>(
+            operators.size(),
+            ctx.get(),
+            std::dynamic_pointer_cast<const core::GroupIdNode>(
+                preAggregation[1])));
+        operators.push_back(std::make_unique<HashAggregation>(
+            operators.size(),
+            ctx.get(),
+            std::dynamic_pointer_cast<const core::AggregationNode>(
+                preAggregation[2])));
+        i++;
+        continue;
+      }
       operators.push_back(
           std::make_unique<GroupId>(id, ctx.get(), groupIdNode));
     } else if (
@@ -499,8 +645,28 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto markDistinctNode =
             std::dynamic_pointer_cast<const core::MarkDistinctNode>(planNode)) {
-      operators.push_back(
-          std::make_unique<MarkDistinct>(id, ctx.get(), markDistinctNode));
+      // A chain of MarkDistinct nodes on columns of the same input is marked
+      // in one operator unless it may spill.
+      std::vector<std::shared_ptr<const core::MarkDistinctNode>> chain{
+          markDistinctNode};
+      const auto& inputType = markDistinctNode->sources()[0]->outputType();
+      while (!markDistinctNode->canSpill(ctx->queryConfig()) &&
+             i + chain.size() < planNodes.size()) {
+        auto next = std::dynamic_pointer_cast<const core::MarkDistinctNode>(
+            planNodes[i + chain.size()]);
+        if (next == nullptr ||
+            !std::all_of(
+                next->distinctKeys().begin(),
+                next->distinctKeys().end(),
+                [&](const auto& key) {
+                  return inputType->containsChild(key->name());
+                })) {
+          break;
+        }
+        chain.push_back(std::move(next));
+      }
+      operators.push_back(std::make_unique<MarkDistinct>(id, ctx.get(), chain));
+      i += chain.size() - 1;
     } else if (
         auto localMerge =
             std::dynamic_pointer_cast<const core::LocalMergeNode>(planNode)) {
@@ -19,6 +19,7 @@
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
+#include <numeric>
 #include <utility>
 
 namespace facebook::velox::exec {
@@ -27,60 +28,291 @@ MarkDistinct::MarkDistinct(
     int32_t operatorId,
     DriverCtx* driverCtx,
     const std::shared_ptr<const core::MarkDistinctNode>& planNode)
+    : MarkDistinct(
+          operatorId,
+          driverCtx,
+          std::vector<std::shared_ptr<const core::MarkDistinctNode>>{
+              planNode}) {}
+
+MarkDistinct::MarkDistinct(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::vector<std::shared_ptr<const core::MarkDistinctNode>>&
+        planNodes)
     : Operator(
           driverCtx,
-          planNode->outputType(),
+          planNodes.back()->outputType(),
           operatorId,
-          planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
+          planNodes.back()->id(),
+          "MarkDistinct",
+          planNodes.size() == 1 &&
+                  planNodes[0]->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_{planNodes[0]->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
+  const auto& planNode = planNodes[0];
 
   // Set all input columns as identity projection.
   for (auto i = 0; i < inputType->size(); ++i) {
     identityProjections_.emplace_back(i, i);
   }
 
-  // We will use result[0] for distinct mask output.
-  resultProjections_.emplace_back(0, inputType->size());
+  // We will use result[i] for the distinct mask output of the ith node.
+  for (auto i = 0; i < planNodes.size(); ++i) {
+    resultProjections_.emplace_back(i, inputType->size() + i);
+  }
+
+  for (auto i = 1; i < planNodes.size(); ++i) {
+    fusedGroupingSets_.push_back(GroupingSet::createForMarkDistinct(
+        inputType,
+        createVectorHashers(inputType, planNodes[i]->distinctKeys()),
+        operatorCtx_.get(),
+        &nonReclaimableSection_));
+  }
+
+  auto hashers = createVectorHashers(inputType, planNode->distinctKeys());
+  if (canSpill()) {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (const auto& hasher : hashers) {
+      keyChannels_.push_back(hasher->channel());
+      names.push_back(inputType->nameOf(hasher->channel()));
+      types.push_back(hasher->type());
+    }
+    keySpillType_ = ROW(std::move(names), std::move(types));
+  }
 
   groupingSet_ = GroupingSet::createForMarkDistinct(
       inputType,
-      createVectorHashers(inputType, planNode->distinctKeys()),
+      std::move(hashers),
       operatorCtx_.get(),
       &nonReclaimableSection_);
 
-  results_.resize(1);
+  results_.resize(planNodes.size());
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+  if (inputSpiller_ != nullptr) {
+    inputSpillHashFunction_->partition(*input, spillPartitions_);
+    inputSpiller_->spillPartitioned(input, spillPartitions_);
+    return;
+  }
+
   groupingSet_->addInput(input, false /*mayPushdown*/);
+  for (auto& groupingSet : fusedGroupingSets_) {
+    groupingSet->addInput(input, false /*mayPushdown*/);
+  }
+
+  input_ = std::move(input);
+}
+
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+  if (inputSpiller_ != nullptr) {
+    keySpiller_->finishSpill(keySpillPartitionSet_);
+    inputSpiller_->finishSpill(inputSpillPartitionSet_);
+    recordSpillStats();
+    restoreNextSpillPartition();
+  }
+}
+
+void MarkDistinct::ensureInputFits(const RowVectorPtr& input) {
+  if (!canSpill() || inputSpiller_ != nullptr) {
+    return;
+  }
+  if (groupingSet_->allocatedBytes() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  const auto& spillConfig = spillConfig_.value();
+  // Test-only spill path.
+  if (spillConfig.testSpillPct > 0 &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    spill();
+    return;
+  }
+
+  // Takes the flat size of the input as a cap on the memory needed to add its
+  // distinct keys. There must be at least 2x of that in reservation.
+  const int64_t increment = input->estimateFlatSize();
+  if (pool()->availableReservation() > 2 * increment) {
+    return;
+  }
+  const auto targetIncrement = std::max<int64_t>(
+      increment * 2,
+      pool()->currentBytes() * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool()->maybeReserve(targetIncrement)) {
+    return;
+  }
+  spill();
+}
+
+void MarkDistinct::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a mark distinct operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from mark distinct operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  if (inputSpiller_ == nullptr) {
+    spill();
+  }
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK(canSpill());
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  const auto& spillConfig = spillConfig_.value();
+  auto makeSpiller = [&](const RowTypePtr& type) {
+    auto spiller = std::make_unique<Spiller>(
+        Spiller::Type::kPartitionedInput,
+        type,
+        spillConfig.hashBitRange,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.codecOptions,
+        spillConfig.tiers);
+    SpillPartitionNumSet partitions;
+    for (auto i = 0; i < spillConfig.hashBitRange.numPartitions(); ++i) {
+      partitions.insert(i);
+    }
+    spiller->setPartitionsSpilled(partitions);
+    return spiller;
+  };
+  keySpiller_ = makeSpiller(keySpillType_);
+  inputSpiller_ = makeSpiller(inputType_);
+
+  std::vector<column_index_t> spillKeyChannels(keyChannels_.size());
+  std::iota(spillKeyChannels.begin(), spillKeyChannels.end(), 0);
+  keySpillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      spillConfig.hashBitRange, keySpillType_, spillKeyChannels);
+  inputSpillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      spillConfig.hashBitRange, inputType_, keyChannels_);
+
+  // NOTE: disk spilling use the system disk spilling memory pool instead of
+  // the operator memory pool. 'groupingSet_' clears its hash table after all
+  // the keys are read.
+  RowContainerIterator iter;
+  const auto batchSize = outputBatchRows();
+  for (;;) {
+    auto batch = BaseVector::create<RowVector>(
+        keySpillType_, 0, &Spiller::spillPool());
+    if (!groupingSet_->getOutput(batchSize, iter, batch)) {
+      break;
+    }
+    keySpillHashFunction_->partition(*batch, spillPartitions_);
+    keySpiller_->spillPartitioned(batch, spillPartitions_);
+  }
+}
 
+void MarkDistinct::restoreNextSpillPartition() {
+  VELOX_CHECK_NULL(spillInputReader_);
+  if (inputSpillPartitionSet_.empty()) {
+    return;
+  }
+
+  auto it = inputSpillPartitionSet_.begin();
+  auto keyIt = keySpillPartitionSet_.find(it->first);
+  if (keyIt != keySpillPartitionSet_.end()) {
+    auto keyReader = keyIt->second->createReader(spillConfig_->executor);
+    RowVectorPtr data;
+    while (keyReader->nextBatch(data)) {
+      // Make an input shaped vector with the spilled keys at their input
+      // channels to add to 'groupingSet_'.
+      const auto numRows = data->size();
+      std::vector<VectorPtr> children(inputType_->size());
+      for (auto i = 0; i < inputType_->size(); ++i) {
+        children[i] = BaseVector::createNullConstant(
+            inputType_->childAt(i), numRows, pool());
+      }
+      for (auto i = 0; i < keyChannels_.size(); ++i) {
+        children[keyChannels_[i]] = data->childAt(i);
+      }
+      groupingSet_->addInput(
+          std::make_shared<RowVector>(
+              pool(), inputType_, nullptr, numRows, std::move(children)),
+          false /*mayPushdown*/);
+    }
+    keySpillPartitionSet_.erase(keyIt);
+  }
+  spillInputReader_ = it->second->createReader(spillConfig_->executor);
+  inputSpillPartitionSet_.erase(it);
+}
+
+void MarkDistinct::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+  VELOX_CHECK_NOT_NULL(spillInputReader_);
+
+  RowVectorPtr input;
+  if (!spillInputReader_->nextBatch(input)) {
+    // Done with the current spill partition.
+    spillInputReader_ = nullptr;
+    groupingSet_->resetPartial();
+    restoreNextSpillPartition();
+    return;
+  }
+  groupingSet_->addInput(input, false /*mayPushdown*/);
   input_ = std::move(input);
 }
 
+void MarkDistinct::recordSpillStats() {
+  VELOX_CHECK_NOT_NULL(inputSpiller_);
+  VELOX_CHECK(noMoreInput_);
+
+  auto spillStats = keySpiller_->stats();
+  spillStats += inputSpiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
+  if (input_ == nullptr && spillInputReader_ != nullptr) {
+    addSpillInput();
+  }
   if (isFinished() || !input_) {
     return nullptr;
   }
 
   auto outputSize = input_->size();
-  // Re-use memory for the ID vector if possible.
-  VectorPtr& result = results_[0];
-  if (result && result.unique()) {
-    BaseVector::prepareForReuse(result, outputSize);
-  } else {
-    result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
-  }
+  for (auto i = 0; i < results_.size(); ++i) {
+    // Re-use memory for the ID vector if possible.
+    VectorPtr& result = results_[i];
+    if (result && result.unique()) {
+      BaseVector::prepareForReuse(result, outputSize);
+    } else {
+      result = BaseVector::create(BOOLEAN(), outputSize, operatorCtx_->pool());
+    }
 
-  // newGroups contains the indices of distinct rows.
-  // For each index in newGroups, we mark the index'th bit true in the result
-  // vector.
-  auto resultBits =
-      results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
+    // newGroups contains the indices of distinct rows.
+    // For each index in newGroups, we mark the index'th bit true in the result
+    // vector.
+    auto resultBits =
+        result->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
-  bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
-    bits::setBit(resultBits, i, true);
+    bits::fillBits(resultBits, 0, outputSize, false);
+    const auto& groupingSet =
+        i == 0 ? groupingSet_ : fusedGroupingSets_[i - 1];
+    for (const auto row : groupingSet->hashLookup().newGroups) {
+      bits::setBit(resultBits, row, true);
+    }
   }
   auto output = fillOutput(outputSize, nullptr);
 
@@ -92,6 +324,6 @@ RowVectorPtr MarkDistinct::getOutput() {
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ && spillInputReader_ == nullptr;
 }
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -28,8 +29,21 @@ class MarkDistinct : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
+  /// Marks the distinct keys of a chain of MarkDistinct nodes in one
+  /// operator. 'planNodes' are in pipeline order. The distinct keys of all of
+  /// them must be columns of the input of the first one. The output gets all
+  /// the marker columns in one pass over the input. Spilling is supported
+  /// only for a single node.
+  MarkDistinct(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::vector<std::shared_ptr<const core::MarkDistinctNode>>&
+          planNodes);
+
+  /// NOTE: the spilled input is processed one spill partition at a time after
+  /// all the input is received, which doesn't preserve the input order.
   bool preservesOrder() const override {
-    return true;
+    return !canSpill();
   }
 
   bool needsInput() const override {
@@ -38,6 +52,8 @@ class MarkDistinct : public Operator {
 
   void addInput(RowVectorPtr input) override;
 
+  void noMoreInput() override;
+
   RowVectorPtr getOutput() override;
 
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
@@ -46,8 +62,58 @@ class MarkDistinct : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
+  // Spills the distinct keys if 'input' can't fit in memory. Only used before
+  // spilling is triggered.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the distinct keys and switches all the partitions to spilling. Any
+  // input received after this is spilled directly and marked one spill
+  // partition at a time after all the input is received.
+  void spill();
+
+  // Restores the distinct keys of the next spill partition into
+  // 'groupingSet_' and sets 'spillInputReader_' to read its spilled input.
+  void restoreNextSpillPartition();
+
+  // Reads the next batch of spilled input of the current spill partition into
+  // 'input_'. Moves to the next spill partition if the current one is
+  // exhausted.
+  void addSpillInput();
+
+  void recordSpillStats();
+
   std::unique_ptr<GroupingSet> groupingSet_;
+
+  // The distinct keys of the MarkDistinct nodes fused after the first one.
+  // The marker of the ith is in results_[i + 1].
+  std::vector<std::unique_ptr<GroupingSet>> fusedGroupingSets_;
+
+  const RowTypePtr inputType_;
+
+  // Channels of the distinct keys in the input.
+  std::vector<column_index_t> keyChannels_;
+
+  // The type of the spilled distinct keys.
+  RowTypePtr keySpillType_;
+
+  // Spillers for the distinct keys and the input received after spilling.
+  // Both are created on the first spill and share the hash bit range so that
+  // the same partition of both holds the same distinct keys.
+  std::unique_ptr<Spiller> keySpiller_;
+  std::unique_ptr<Spiller> inputSpiller_;
+  std::unique_ptr<HashPartitionFunction> keySpillHashFunction_;
+  std::unique_ptr<HashPartitionFunction> inputSpillHashFunction_;
+  std::vector<uint32_t> spillPartitions_;
+
+  SpillPartitionSet keySpillPartitionSet_;
+  SpillPartitionSet inputSpillPartitionSet_;
+
+  // Reads the spilled input of the spill partition being processed.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  uint64_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
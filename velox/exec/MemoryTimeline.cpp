@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/MemoryTimeline.h"
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+std::string memoryTimelineKindString(MemoryTimelineEvent::Kind kind) {
+  switch (kind) {
+    case MemoryTimelineEvent::Kind::kReservation:
+      return "reservation";
+    case MemoryTimelineEvent::Kind::kSpillStart:
+      return "spill start";
+    case MemoryTimelineEvent::Kind::kSpillEnd:
+      return "spill end";
+    case MemoryTimelineEvent::Kind::kArbitrationRequest:
+      return "arbitration request";
+    case MemoryTimelineEvent::Kind::kArbitrationGrant:
+      return "arbitration grant";
+    case MemoryTimelineEvent::Kind::kCachePressure:
+      return "cache";
+  }
+  VELOX_UNREACHABLE();
+}
+
+MemoryTimeline::MemoryTimeline(size_t capacity, uint64_t sampleIntervalMs)
+    : capacity_(capacity), sampleIntervalMs_(sampleIntervalMs) {
+  VELOX_CHECK_GT(capacity_, 0);
+  events_.reserve(capacity_);
+}
+
+void MemoryTimeline::record(const MemoryTimelineEvent& event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numRecorded_;
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+    return;
+  }
+  events_[next_] = event;
+  next_ = (next_ + 1) % capacity_;
+}
+
+bool MemoryTimeline::startSample(uint64_t nowMs) {
+  auto lastMs = lastSampleMs_.load(std::memory_order_relaxed);
+  if (lastMs != 0 && nowMs < lastMs + sampleIntervalMs_) {
+    return false;
+  }
+  return lastSampleMs_.compare_exchange_strong(lastMs, nowMs);
+}
+
+std::vector<MemoryTimelineEvent> MemoryTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<MemoryTimelineEvent> result;
+  result.reserve(events_.size());
+  result.insert(result.end(), events_.begin() + next_, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + next_);
+  return result;
+}
+
+uint64_t MemoryTimeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numRecorded_ - events_.size();
+}
+
+} // namespace facebook::velox::exec
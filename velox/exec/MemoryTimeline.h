@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// One point of the memory timeline of a Task.
+struct MemoryTimelineEvent {
+  enum class Kind : uint8_t {
+    /// Periodic sample of the reserved bytes of an operator's memory pool.
+    kReservation,
+    /// The memory arbitrator started to reclaim memory from an operator,
+    /// e.g. by spilling. 'bytes' is the reservation of the operator.
+    kSpillStart,
+    /// The reclaim ended. 'bytes' is the number of reclaimed bytes.
+    kSpillEnd,
+    /// An operator waits for the memory arbitrator to grow its memory pool.
+    /// 'bytes' is the reservation of the operator.
+    kArbitrationRequest,
+    /// The arbitration of an operator finished. 'bytes' is the reservation of
+    /// the operator.
+    kArbitrationGrant,
+    /// Periodic sample of the bytes held by the AsyncDataCache of the query.
+    /// The event is not for an operator.
+    kCachePressure,
+  };
+
+  Kind kind;
+  int32_t pipelineId;
+  /// The operator id in the pipeline, -1 for kCachePressure.
+  int32_t operatorId;
+  /// Millisecond wall time since epoch.
+  uint64_t timeMs;
+  int64_t bytes;
+};
+
+std::string memoryTimelineKindString(MemoryTimelineEvent::Kind kind);
+
+/// Bounded buffer of the latest MemoryTimelineEvents of a Task. Reservations
+/// are sampled by the Drivers when they go off thread, at most once per
+/// sample interval for the Task. Thread-safe.
+class MemoryTimeline {
+ public:
+  MemoryTimeline(size_t capacity, uint64_t sampleIntervalMs);
+
+  /// Adds 'event' and drops the oldest event if full.
+  void record(const MemoryTimelineEvent& event);
+
+  /// Returns true if the caller should record a sample at 'nowMs', i.e. if
+  /// no sample was taken in the last sample interval. Only one of the
+  /// concurrent callers gets true.
+  bool startSample(uint64_t nowMs);
+
+  /// Returns the retained events, oldest first.
+  std::vector<MemoryTimelineEvent> events() const;
+
+  /// Returns the number of events dropped because the buffer was full.
+  uint64_t numDropped() const;
+
+ private:
+  const size_t capacity_;
+  const uint64_t sampleIntervalMs_;
+  std::atomic<uint64_t> lastSampleMs_{0};
+  mutable std::mutex mutex_;
+  std::vector<MemoryTimelineEvent> events_;
+  // Position of the oldest event once 'events_' is full.
+  size_t next_{0};
+  uint64_t numRecorded_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -15,7 +15,9 @@
  */
 
 #include "velox/exec/Merge.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 using facebook::velox::common::testutil::TestValue;
@@ -30,14 +32,16 @@ Merge::Merge(
         sortingKeys,
     const std::vector<core::SortOrder>& sortingOrders,
     const std::string& planNodeId,
-    const std::string& operatorType)
+    const std::string& operatorType,
+    int32_t numMergeRanges)
     : SourceOperator(
           driverCtx,
           std::move(outputType),
           operatorId,
           planNodeId,
           operatorType),
-      outputBatchSize_{outputBatchRows()} {
+      outputBatchSize_{outputBatchRows()},
+      numMergeRanges_{numMergeRanges} {
   auto numKeys = sortingKeys.size();
   sortingKeys_.reserve(numKeys);
   for (int i = 0; i < numKeys; ++i) {
@@ -89,7 +93,13 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
   }
 
   // No merging is needed if there is only one source.
-  if (streams_.empty() && sources_.size() > 1) {
+  if (isRangeMerge()) {
+    if (sourceBatches_.empty()) {
+      sourceBatches_.resize(sources_.size());
+      sourceOffsets_.resize(sources_.size(), 0);
+      sourcesAtEnd_.resize(sources_.size(), false);
+    }
+  } else if (streams_.empty() && sources_.size() > 1) {
     initializeTreeOfLosers();
   }
 
@@ -97,6 +107,7 @@ BlockingReason Merge::isBlocked(ContinueFuture* future) {
     for (auto& cursor : streams_) {
       cursor->isBlocked(sourceBlockingFutures_);
     }
+    fetchSourceBatches();
   }
 
   if (!sourceBlockingFutures_.empty()) {
@@ -131,6 +142,10 @@ RowVectorPtr Merge::getOutput() {
     return data;
   }
 
+  if (isRangeMerge()) {
+    return getRangeMergeOutput();
+  }
+
   if (!output_) {
     output_ = BaseVector::create<RowVector>(
         outputType_, outputBatchSize_, operatorCtx_->pool());
@@ -181,6 +196,372 @@ RowVectorPtr Merge::getOutput() {
   }
 }
 
+void Merge::fetchSourceBatches() {
+  for (auto i = 0; i < sourceBatches_.size(); ++i) {
+    while (!sourcesAtEnd_[i] && sourceBatches_[i] == nullptr) {
+      ContinueFuture future;
+      RowVectorPtr data;
+      auto reason = sources_[i]->next(data, &future);
+      if (reason != BlockingReason::kNotBlocked) {
+        sourceBlockingFutures_.emplace_back(std::move(future));
+        break;
+      }
+      if (data == nullptr) {
+        sourcesAtEnd_[i] = true;
+      } else if (data->size() > 0) {
+        for (auto& child : data->children()) {
+          child = BaseVector::loadedVectorShared(child);
+        }
+        sourceBatches_[i] = std::move(data);
+        sourceOffsets_[i] = 0;
+      }
+    }
+  }
+}
+
+namespace {
+int32_t compareRows(
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    const RowVector& left,
+    vector_size_t leftRow,
+    const RowVector& right,
+    vector_size_t rightRow) {
+  for (const auto& [channel, flags] : sortingKeys) {
+    if (auto result = left.childAt(channel)
+                          ->compare(
+                              right.childAt(channel).get(),
+                              leftRow,
+                              rightRow,
+                              flags)
+                          .value()) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+// Returns the first row in [begin, end) of 'run' that is not less than
+// 'row' of 'other'. The rows of 'run' are ordered.
+vector_size_t lowerBound(
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    const RowVector& run,
+    vector_size_t begin,
+    vector_size_t end,
+    const RowVector& other,
+    vector_size_t row) {
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+    if (compareRows(sortingKeys, run, middle, other, row) < 0) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+// Returns the first row in [begin, end) of 'run' that is greater than 'row'
+// of 'other'. The rows of 'run' are ordered.
+vector_size_t upperBound(
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    const RowVector& run,
+    vector_size_t begin,
+    vector_size_t end,
+    const RowVector& other,
+    vector_size_t row) {
+  while (begin < end) {
+    const auto middle = begin + (end - begin) / 2;
+    if (compareRows(sortingKeys, run, middle, other, row) <= 0) {
+      begin = middle + 1;
+    } else {
+      end = middle;
+    }
+  }
+  return begin;
+}
+
+class RunStream final : public MergeStream {
+ public:
+  RunStream(
+      const SortedRun& run,
+      const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys)
+      : data_{run.data.get()}, row_{run.begin}, end_{run.end} {
+    keyColumns_.reserve(sortingKeys.size());
+    for (const auto& [channel, flags] : sortingKeys) {
+      keyColumns_.emplace_back(data_->childAt(channel).get(), flags);
+    }
+  }
+
+  bool hasData() const override {
+    return row_ < end_;
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    const auto& otherStream = static_cast<const RunStream&>(other);
+    for (auto i = 0; i < keyColumns_.size(); ++i) {
+      const auto& [column, flags] = keyColumns_[i];
+      if (auto result =
+              column
+                  ->compare(
+                      otherStream.keyColumns_[i].first,
+                      row_,
+                      otherStream.row_,
+                      flags)
+                  .value()) {
+        return result < 0;
+      }
+    }
+    return false;
+  }
+
+  const RowVector* data() const {
+    return data_;
+  }
+
+  vector_size_t row() const {
+    return row_;
+  }
+
+  void pop() {
+    ++row_;
+  }
+
+ private:
+  const RowVector* const data_;
+  vector_size_t row_;
+  const vector_size_t end_;
+  std::vector<std::pair<const BaseVector*, CompareFlags>> keyColumns_;
+};
+
+// Merges 'runs' on the calling thread.
+std::vector<RowVectorPtr> mergeRuns(
+    const std::vector<SortedRun>& runs,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    uint32_t outputBatchSize,
+    memory::MemoryPool* pool) {
+  std::vector<std::unique_ptr<RunStream>> streams;
+  streams.reserve(runs.size());
+  for (const auto& run : runs) {
+    streams.push_back(std::make_unique<RunStream>(run, sortingKeys));
+  }
+  TreeOfLosers<RunStream> treeOfLosers(std::move(streams));
+
+  const auto& type = runs[0].data->type();
+  std::vector<RowVectorPtr> merged;
+  std::vector<const RowVector*> sources;
+  std::vector<vector_size_t> sourceRows;
+  sources.reserve(outputBatchSize);
+  sourceRows.reserve(outputBatchSize);
+  auto flush = [&]() {
+    auto output = BaseVector::create<RowVector>(type, sources.size(), pool);
+    for (auto& child : output->children()) {
+      child->resize(sources.size());
+    }
+    gatherCopy(output.get(), 0, sources.size(), sources, sourceRows);
+    merged.push_back(std::move(output));
+    sources.clear();
+    sourceRows.clear();
+  };
+  while (auto* stream = treeOfLosers.next()) {
+    sources.push_back(stream->data());
+    sourceRows.push_back(stream->row());
+    stream->pop();
+    if (sources.size() == outputBatchSize) {
+      flush();
+    }
+  }
+  if (!sources.empty()) {
+    flush();
+  }
+  return merged;
+}
+
+// Splits 'runs' into at most 'numRanges' ranges of keys with about the same
+// number of rows. The splitters are taken from 'numRanges' evenly spaced
+// sample rows of each run, each weighted by the rows of the run it stands
+// for. A range holds the rows from one splitter up to the next.
+std::vector<std::vector<SortedRun>> splitRuns(
+    const std::vector<SortedRun>& runs,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    int32_t numRanges,
+    vector_size_t numRows) {
+  struct Sample {
+    const RowVector* data;
+    vector_size_t row;
+    double weight;
+  };
+  std::vector<Sample> samples;
+  samples.reserve(runs.size() * numRanges);
+  for (const auto& run : runs) {
+    const auto size = run.end - run.begin;
+    for (auto i = 0; i < numRanges; ++i) {
+      samples.push_back(
+          {run.data.get(),
+           run.begin +
+               static_cast<vector_size_t>(
+                   (2 * i + 1) * static_cast<int64_t>(size) / (2 * numRanges)),
+           static_cast<double>(size) / numRanges});
+    }
+  }
+  std::sort(samples.begin(), samples.end(), [&](const auto& a, const auto& b) {
+    return compareRows(sortingKeys, *a.data, a.row, *b.data, b.row) < 0;
+  });
+
+  std::vector<Sample> splitters;
+  double cumulativeRows = 0;
+  for (const auto& sample : samples) {
+    cumulativeRows += sample.weight;
+    if (static_cast<int32_t>(splitters.size()) + 1 < numRanges &&
+        cumulativeRows >=
+            static_cast<double>(numRows) * (splitters.size() + 1) / numRanges) {
+      splitters.push_back(sample);
+    }
+  }
+
+  std::vector<std::vector<SortedRun>> ranges(splitters.size() + 1);
+  for (const auto& run : runs) {
+    auto begin = run.begin;
+    for (auto i = 0; i < ranges.size(); ++i) {
+      const auto end = i < splitters.size() ? lowerBound(
+                                                  sortingKeys,
+                                                  *run.data,
+                                                  begin,
+                                                  run.end,
+                                                  *splitters[i].data,
+                                                  splitters[i].row)
+                                            : run.end;
+      if (end > begin) {
+        ranges[i].push_back({run.data, begin, end});
+      }
+      begin = end;
+    }
+  }
+  return ranges;
+}
+} // namespace
+
+std::vector<RowVectorPtr> mergeSortedRuns(
+    const std::vector<SortedRun>& runs,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    int32_t numRanges,
+    folly::Executor* executor,
+    uint32_t outputBatchSize,
+    memory::MemoryPool* pool) {
+  if (runs.empty()) {
+    return {};
+  }
+  vector_size_t numRows = 0;
+  for (const auto& run : runs) {
+    numRows += run.end - run.begin;
+  }
+  // A range of less than an output batch is not worth a separate merge.
+  numRanges = std::min<int64_t>(numRanges, numRows / outputBatchSize);
+  if (numRanges <= 1 || runs.size() == 1) {
+    return mergeRuns(runs, sortingKeys, outputBatchSize, pool);
+  }
+
+  auto ranges = splitRuns(runs, sortingKeys, numRanges, numRows);
+  std::vector<std::shared_ptr<AsyncSource<std::vector<RowVectorPtr>>>> merges;
+  merges.reserve(ranges.size());
+  for (auto& range : ranges) {
+    if (range.empty()) {
+      continue;
+    }
+    merges.push_back(std::make_shared<AsyncSource<std::vector<RowVectorPtr>>>(
+        [range = std::move(range), sortingKeys, outputBatchSize, pool]() {
+          return std::make_unique<std::vector<RowVectorPtr>>(
+              mergeRuns(range, sortingKeys, outputBatchSize, pool));
+        }));
+    if (executor && merges.size() > 1) {
+      // The first range is merged on the calling thread.
+      executor->add([merge = merges.back()]() { merge->prepare(); });
+    }
+  }
+
+  // All merges must finish before returning because they allocate from
+  // 'pool'.
+  std::vector<RowVectorPtr> merged;
+  std::exception_ptr error;
+  for (auto& merge : merges) {
+    try {
+      auto batches = merge->move();
+      if (!error) {
+        merged.insert(merged.end(), batches->begin(), batches->end());
+      }
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return merged;
+}
+
+RowVectorPtr Merge::getRangeMergeOutput() {
+  if (mergedBatches_.empty()) {
+    // The last rows of the current batches bound the rows that can be merged
+    // now. The source whose last row is the smallest bounds all others.
+    std::optional<int32_t> boundSource;
+    for (auto i = 0; i < sources_.size(); ++i) {
+      if (sourcesAtEnd_[i]) {
+        continue;
+      }
+      const auto& batch = sourceBatches_[i];
+      if (batch == nullptr) {
+        // Waiting for the next batch of this source.
+        return nullptr;
+      }
+      if (!boundSource.has_value() ||
+          compareRows(
+              sortingKeys_,
+              *batch,
+              batch->size() - 1,
+              *sourceBatches_[*boundSource],
+              sourceBatches_[*boundSource]->size() - 1) < 0) {
+        boundSource = i;
+      }
+    }
+    if (!boundSource.has_value()) {
+      finished_ = true;
+      return nullptr;
+    }
+
+    const auto bound = sourceBatches_[*boundSource];
+    const auto boundRow = bound->size() - 1;
+    std::vector<SortedRun> runs;
+    for (auto i = 0; i < sources_.size(); ++i) {
+      auto& batch = sourceBatches_[i];
+      if (batch == nullptr) {
+        continue;
+      }
+      const auto begin = sourceOffsets_[i];
+      const auto end = upperBound(
+          sortingKeys_, *batch, begin, batch->size(), *bound, boundRow);
+      if (end > begin) {
+        runs.push_back({batch, begin, end});
+      }
+      sourceOffsets_[i] = end;
+      if (end == batch->size()) {
+        batch = nullptr;
+      }
+    }
+
+    auto merged = mergeSortedRuns(
+        runs,
+        sortingKeys_,
+        numMergeRanges_,
+        operatorCtx_->task()->queryCtx()->executor(),
+        outputBatchSize_,
+        pool());
+    mergedBatches_.insert(mergedBatches_.end(), merged.begin(), merged.end());
+  }
+
+  auto output = std::move(mergedBatches_.front());
+  mergedBatches_.pop_front();
+  return output;
+}
+
 void Merge::close() {
   for (auto& source : sources_) {
     source->close();
@@ -279,7 +660,8 @@ LocalMerge::LocalMerge(
           localMergeNode->sortingKeys(),
           localMergeNode->sortingOrders(),
           localMergeNode->id(),
-          "LocalMerge") {
+          "LocalMerge",
+          driverCtx->queryConfig().localMergeParallelism()) {
   VELOX_CHECK_EQ(
       operatorCtx_->driverCtx()->driverId,
       0,
@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <deque>
+
+#include <folly/Executor.h>
+
 #include "velox/exec/Exchange.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -23,9 +27,31 @@ namespace facebook::velox::exec {
 
 class SourceStream;
 
+/// A range of rows of a batch that is ordered on the merge keys.
+struct SortedRun {
+  RowVectorPtr data;
+  vector_size_t begin;
+  vector_size_t end;
+};
+
+/// Merges ordered 'runs' into ordered batches of at most 'outputBatchSize'
+/// rows. If 'numRanges' is > 1 and the runs have enough rows, the key space
+/// is split into 'numRanges' ranges at keys sampled from the runs. The ranges
+/// are merged in parallel on 'executor', or one after the other if 'executor'
+/// is null, and the merged ranges are returned in key order.
+std::vector<RowVectorPtr> mergeSortedRuns(
+    const std::vector<SortedRun>& runs,
+    const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys,
+    int32_t numRanges,
+    folly::Executor* executor,
+    uint32_t outputBatchSize,
+    memory::MemoryPool* pool);
+
 // Merge operator Implementation: This implementation uses priority queue
 // to perform a k-way merge of its inputs. It stops merging if any one of
-// its inputs is blocked.
+// its inputs is blocked. With 'numMergeRanges' > 1, it instead buffers one
+// batch per source and merges the rows up to the smallest last key of these
+// batches with mergeSortedRuns, 'numMergeRanges' key ranges in parallel.
 class Merge : public SourceOperator {
  public:
   Merge(
@@ -36,7 +62,8 @@ class Merge : public SourceOperator {
           sortingKeys,
       const std::vector<core::SortOrder>& sortingOrders,
       const std::string& planNodeId,
-      const std::string& operatorType);
+      const std::string& operatorType,
+      int32_t numMergeRanges = 1);
 
   BlockingReason isBlocked(ContinueFuture* future) override;
 
@@ -58,9 +85,25 @@ class Merge : public SourceOperator {
  private:
   void initializeTreeOfLosers();
 
+  /// True if merging the sources by key ranges.
+  bool isRangeMerge() const {
+    return numMergeRanges_ > 1 && sources_.size() > 1;
+  }
+
+  /// Fetches the next batch for the sources without a current batch. Appends
+  /// a future to 'sourceBlockingFutures_' for each source that is blocked.
+  void fetchSourceBatches();
+
+  /// Merges the rows of the current source batches that sort before the rows
+  /// of any batch still to come.
+  RowVectorPtr getRangeMergeOutput();
+
   /// Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
 
+  /// Number of key ranges merged in parallel.
+  const int32_t numMergeRanges_;
+
   std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_;
 
   /// A list of cursors over batches of ordered source data. One per source.
@@ -80,6 +123,19 @@ class Merge : public SourceOperator {
   /// A list of blocking futures for sources. These are populates when a given
   /// source is blocked waiting for the next batch of data.
   std::vector<ContinueFuture> sourceBlockingFutures_;
+
+  /// Current batch of each source in a range merge, nullptr if the next batch
+  /// must be fetched. Aligned with 'sources_'.
+  std::vector<RowVectorPtr> sourceBatches_;
+
+  /// First row of each batch in 'sourceBatches_' that is not merged yet.
+  std::vector<vector_size_t> sourceOffsets_;
+
+  /// True for each source that is exhausted.
+  std::vector<bool> sourcesAtEnd_;
+
+  /// Merged batches not returned yet, in key order.
+  std::deque<RowVectorPtr> mergedBatches_;
 };
 
 class SourceStream final : public MergeStream {
@@ -168,8 +224,9 @@ class SourceStream final : public MergeStream {
 };
 
 // LocalMerge merges its source's output into a single stream of
-// sorted rows. It runs single threaded. The sources may run multi-threaded and
-// in the same task.
+// sorted rows. It runs single threaded, except for merging key ranges in
+// parallel if local_merge_parallelism is > 1. The sources may run
+// multi-threaded and in the same task.
 class LocalMerge : public Merge {
  public:
   LocalMerge(
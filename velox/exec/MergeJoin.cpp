@@ -34,8 +34,14 @@ MergeJoin::MergeJoin(
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()} {
   VELOX_USER_CHECK(
-      joinNode->isInnerJoin() || joinNode->isLeftJoin(),
-      "Merge join supports only inner and left joins. Other join types are not supported yet.");
+      joinNode->isInnerJoin() || joinNode->isLeftJoin() ||
+          joinNode->isRightJoin() || joinNode->isFullJoin() ||
+          joinNode->isLeftSemiFilterJoin() || joinNode->isAntiJoin(),
+      "Merge join supports only inner, left, right, full, left semi and anti joins. Other join types are not supported yet.");
+  VELOX_USER_CHECK(
+      joinNode->filter() == nullptr ||
+          !(joinNode->isRightJoin() || joinNode->isFullJoin()),
+      "Merge join supports right and full joins only without a filter.");
 
   leftKeys_.reserve(numKeys_);
   rightKeys_.reserve(numKeys_);
@@ -69,7 +75,8 @@ MergeJoin::MergeJoin(
   if (joinNode->filter()) {
     initializeFilter(joinNode->filter(), leftType, rightType);
 
-    if (joinNode->isLeftJoin()) {
+    if (joinNode->isLeftJoin() || joinNode->isLeftSemiFilterJoin() ||
+        joinNode->isAntiJoin()) {
       leftJoinTracker_ = LeftJoinTracker(outputBatchSize_, pool());
     }
   }
@@ -226,6 +233,19 @@ void MergeJoin::addOutputRowForLeftJoin(
   ++outputSize_;
 }
 
+void MergeJoin::addOutputRowForRightJoin(
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+
+  for (const auto& projection : leftProjections_) {
+    const auto& target = output_->childAt(projection.outputChannel);
+    target->setNull(outputSize_, true);
+  }
+
+  ++outputSize_;
+}
+
 void MergeJoin::addOutputRow(
     const RowVectorPtr& left,
     vector_size_t leftIndex,
@@ -302,6 +322,15 @@ void MergeJoin::prepareOutput() {
 bool MergeJoin::addToOutput() {
   prepareOutput();
 
+  if (isAntiJoin(joinType_) && !filter_) {
+    // Left rows with a match are not output.
+    leftMatch_.reset();
+    rightMatch_.reset();
+    return outputSize_ == outputBatchSize_;
+  }
+  // Without a filter, a semi join outputs each left row once.
+  const bool firstRightRowOnly = isLeftSemiFilterJoin(joinType_) && !filter_;
+
   size_t firstLeftBatch;
   vector_size_t leftStartIndex;
   if (leftMatch_->cursor) {
@@ -329,12 +358,15 @@ bool MergeJoin::addToOutput() {
           ? rightMatch_->cursor->index
           : rightMatch_->startIndex;
 
-      auto numRights = rightMatch_->inputs.size();
+      auto numRights = firstRightRowOnly ? 1 : rightMatch_->inputs.size();
       for (size_t r = firstRightBatch; r < numRights; ++r) {
         auto right = rightMatch_->inputs[r];
         auto rightStart = r == firstRightBatch ? rightStartIndex : 0;
         auto rightEnd =
             r == numRights - 1 ? rightMatch_->endIndex : right->size();
+        if (firstRightRowOnly) {
+          rightEnd = rightStart + 1;
+        }
 
         for (auto j = rightStart; j < rightEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
@@ -355,19 +387,24 @@ bool MergeJoin::addToOutput() {
 }
 
 namespace {
+bool hasNullKey(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t row) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->isNullAt(row)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 vector_size_t firstNonNull(
     const RowVectorPtr& rowVector,
     const std::vector<column_index_t>& keys,
     vector_size_t start = 0) {
   for (auto i = start; i < rowVector->size(); ++i) {
-    bool hasNull = false;
-    for (auto key : keys) {
-      if (rowVector->childAt(key)->isNullAt(i)) {
-        hasNull = true;
-        break;
-      }
-    }
-    if (!hasNull) {
+    if (!hasNullKey(rowVector, keys, i)) {
       return i;
     }
   }
@@ -376,6 +413,22 @@ vector_size_t firstNonNull(
 }
 } // namespace
 
+int32_t MergeJoin::compare() const {
+  if ((isRightJoin(joinType_) || isFullJoin(joinType_)) &&
+      hasNullKey(rightInput_, rightKeys_, rightIndex_)) {
+    return 1;
+  }
+  return compare(
+      leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
+}
+
+vector_size_t MergeJoin::firstRightRow(vector_size_t start) const {
+  if (isRightJoin(joinType_) || isFullJoin(joinType_)) {
+    return start;
+  }
+  return firstNonNull(rightInput_, rightKeys_, start);
+}
+
 RowVectorPtr MergeJoin::getOutput() {
   // Make sure to have is-blocked or needs-input as true if returning null
   // output. Otherwise, Driver assumes the operator is finished.
@@ -416,7 +469,7 @@ RowVectorPtr MergeJoin::getOutput() {
         }
 
         if (rightInput_) {
-          rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          rightIndex_ = firstRightRow(0);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -475,8 +528,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
-        rightIndex_ =
-            firstNonNull(rightInput_, rightKeys_, rightMatch_->endIndex);
+        rightIndex_ = firstRightRow(rightMatch_->endIndex);
         if (rightIndex_ == rightInput_->size()) {
           rightInput_ = nullptr;
         }
@@ -501,7 +553,12 @@ RowVectorPtr MergeJoin::doGetOutput() {
   }
 
   if (!input_ || !rightInput_) {
-    if (isLeftJoin(joinType_)) {
+    const bool outputLeftMisses = isLeftJoin(joinType_) ||
+        isFullJoin(joinType_) || isAntiJoin(joinType_);
+    const bool outputRightMisses =
+        isRightJoin(joinType_) || isFullJoin(joinType_);
+
+    if (outputLeftMisses) {
       if (input_ && noMoreRightInput_) {
         prepareOutput();
         while (true) {
@@ -519,7 +576,35 @@ RowVectorPtr MergeJoin::doGetOutput() {
           }
         }
       }
+    }
+
+    if (outputRightMisses && rightInput_ && noMoreInput_) {
+      prepareOutput();
+      while (rightInput_) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+
+        ++rightIndex_;
+        if (rightIndex_ == rightInput_->size()) {
+          // Ran out of rows on the right side.
+          rightInput_ = nullptr;
+        }
+      }
+    }
 
+    if (outputRightMisses) {
+      if (noMoreInput_ && noMoreRightInput_ && output_) {
+        output_->resize(outputSize_);
+        return std::move(output_);
+      }
+      if (noMoreRightInput_ && !outputLeftMisses) {
+        // Right join doesn't need the rest of the left side.
+        input_ = nullptr;
+      }
+    } else if (outputLeftMisses) {
       if (noMoreInput_ && output_) {
         output_->resize(outputSize_);
         return std::move(output_);
@@ -544,7 +629,8 @@ RowVectorPtr MergeJoin::doGetOutput() {
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
-      if (isLeftJoin(joinType_)) {
+      if (isLeftJoin(joinType_) || isFullJoin(joinType_) ||
+          isAntiJoin(joinType_)) {
         prepareOutput();
 
         if (outputSize_ == outputBatchSize_) {
@@ -565,7 +651,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (isRightJoin(joinType_) || isFullJoin(joinType_)) {
+        prepareOutput();
+
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+      }
+
+      rightIndex_ = firstRightRow(rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -616,7 +712,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       index_ = endIndex;
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, endRightIndex);
+      rightIndex_ = firstRightRow(endRightIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -655,8 +751,13 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
     evaluateFilter(filterRows);
 
     // If all matches for a given left-side row fail the filter, add a row to
-    // the output with nulls for the right-side columns.
+    // the output with nulls for the right-side columns. Semi joins output
+    // only left-side rows that passed.
+    const bool isSemiJoin = isLeftSemiFilterJoin(joinType_);
     auto onMiss = [&](auto row) {
+      if (isSemiJoin) {
+        return;
+      }
       rawIndices[numPassed++] = row;
 
       for (auto& projection : rightProjections_) {
@@ -669,10 +770,14 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
       if (filterRows.isValid(i)) {
         const bool passed = !decodedFilterResult_.isNullAt(i) &&
             decodedFilterResult_.valueAt<bool>(i);
+        // Anti joins drop left-side rows with a passing match. Semi joins
+        // keep the first passing match only.
+        const bool keep = passed && !isAntiJoin(joinType_) &&
+            !(isSemiJoin && leftJoinTracker_->passedBefore(i));
 
         leftJoinTracker_->processFilterResult(i, passed, onMiss);
 
-        if (passed) {
+        if (keep) {
           rawIndices[numPassed++] = i;
         }
       } else {
@@ -721,6 +826,11 @@ void MergeJoin::evaluateFilter(const SelectivityVector& rows) {
 }
 
 bool MergeJoin::isFinished() {
+  if (isRightJoin(joinType_) || isFullJoin(joinType_)) {
+    // Right-side rows without a match are output after the left side is done.
+    return noMoreInput_ && input_ == nullptr && noMoreRightInput_ &&
+        rightInput_ == nullptr && output_ == nullptr;
+  }
   return noMoreInput_ && input_ == nullptr;
 }
 
@@ -60,10 +60,13 @@ class MergeJoin : public Operator {
       vector_size_t otherIndex);
 
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
-  int32_t compare() const {
-    return compare(
-        leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
-  }
+  // A right-side row with a null key never matches. Right and full joins,
+  // which keep such rows, treat it as less than any left-side row.
+  int32_t compare() const;
+
+  // Returns the first row at or after 'start' in rightInput_ to process. Rows
+  // with null keys are skipped unless the join type outputs them.
+  vector_size_t firstRightRow(vector_size_t start) const;
 
   // Compare two rows on the left: index_ and index.
   int32_t compareLeft(vector_size_t index) const {
@@ -180,6 +183,13 @@ class MergeJoin : public Operator {
       const RowVectorPtr& left,
       vector_size_t leftIndex);
 
+  /// Adds one row of output for a right-side row with no left-side match.
+  /// Copies values from the 'rightIndex' row of 'right' and fills in nulls
+  /// for columns that correspond to the left side.
+  void addOutputRowForRightJoin(
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
   /// Evaluates join filter on 'filterInput_' and returns 'output' that contains
   /// a subset of rows on which the filter passed. Returns nullptr if no rows
   /// passed the filter.
@@ -284,6 +294,15 @@ class MergeJoin : public Operator {
       }
     }
 
+    /// Returns true if a previous output row for the same left-side row as
+    /// 'outputIndex' passed the filter. Must be called before
+    /// 'processFilterResult' for 'outputIndex'. Used by semi joins to output
+    /// each left-side row at most once.
+    bool passedBefore(vector_size_t outputIndex) const {
+      return currentRowPassed_ &&
+          rawLeftRowNumbers_[outputIndex] == currentLeftRowNumber_;
+    }
+
     /// Called when all rows from the current output batch are processed and the
     /// next batch of output will start with a new left-side row or there will
     /// be no more batches. Calls 'onMiss' for the last left-side row if the
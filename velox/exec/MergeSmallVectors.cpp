@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/MergeSmallVectors.h"
+#include "velox/exec/OperatorUtils.h"
+
+namespace facebook::velox::exec {
+
+MergeSmallVectors::MergeSmallVectors(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    RowTypePtr outputType)
+    : Operator(
+          driverCtx,
+          std::move(outputType),
+          operatorId,
+          "N/A",
+          "MergeSmallVectors"),
+      minOutputRows_{std::max<vector_size_t>(outputBatchRows() / 2, 1)} {
+  // Rows are passed through as is, so dynamic filters of the downstream
+  // operators can be pushed through this.
+  const auto numColumns = outputType_->size();
+  identityProjections_.reserve(numColumns);
+  for (column_index_t i = 0; i < numColumns; ++i) {
+    identityProjections_.emplace_back(i, i);
+  }
+}
+
+void MergeSmallVectors::addInput(RowVectorPtr input) {
+  numInputBytes_ += input->estimateFlatSize();
+  numInputRows_ += input->size();
+  minOutputRows_ = std::max<vector_size_t>(
+      outputBatchRows(numInputBytes_ / numInputRows_) / 2, 1);
+  numBufferedRows_ += input->size();
+  inputs_.push_back(std::move(input));
+}
+
+RowVectorPtr MergeSmallVectors::getOutput() {
+  if (inputs_.empty() ||
+      (!noMoreInput_ && numBufferedRows_ < minOutputRows_)) {
+    return nullptr;
+  }
+  RowVectorPtr output;
+  if (inputs_.size() == 1) {
+    output = std::move(inputs_[0]);
+  } else {
+    output = BaseVector::create<RowVector>(
+        outputType_, numBufferedRows_, pool());
+    vector_size_t offset = 0;
+    for (auto& input : inputs_) {
+      loadColumns(input, *operatorCtx_->execCtx());
+      output->copy(input.get(), offset, 0, input->size());
+      offset += input->size();
+    }
+    addRuntimeStat("mergedVectors", RuntimeCounter(inputs_.size()));
+  }
+  inputs_.clear();
+  numBufferedRows_ = 0;
+  return output;
+}
+
+} // namespace facebook::velox::exec
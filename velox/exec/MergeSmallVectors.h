@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Merges small input vectors into vectors of at least half the output batch
+/// size. Inserted after selective filters with
+/// QueryConfig::mergeSmallVectorsEnabled(). Like CallbackSink, this has no
+/// plan node of its own. An input that is large enough by itself passes
+/// through without a copy.
+class MergeSmallVectors : public Operator {
+ public:
+  MergeSmallVectors(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      RowTypePtr outputType);
+
+  bool needsInput() const override {
+    return !noMoreInput_ && numBufferedRows_ < minOutputRows_;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  BlockingReason isBlocked(ContinueFuture* /*future*/) override {
+    return BlockingReason::kNotBlocked;
+  }
+
+  bool isFinished() override {
+    return noMoreInput_ && inputs_.empty();
+  }
+
+ private:
+  // Number of rows at which the buffered inputs are output. This is half the
+  // output batch size for the average size of the input rows so far.
+  vector_size_t minOutputRows_;
+
+  std::vector<RowVectorPtr> inputs_;
+  vector_size_t numBufferedRows_{0};
+
+  // Totals over all inputs for the average row size.
+  uint64_t numInputBytes_{0};
+  uint64_t numInputRows_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -18,6 +18,141 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool isRangeType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::DATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns the name of 'expr' if it is a column of the input.
+const std::string* fieldName(const core::TypedExprPtr& expr) {
+  auto field = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr ||
+      !(field->inputs().empty() ||
+        (field->inputs().size() == 1 &&
+         dynamic_cast<const core::InputTypedExpr*>(
+             field->inputs()[0].get())))) {
+    return nullptr;
+  }
+  return &field->name();
+}
+
+void addConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<const core::CallTypedExpr*>& conjuncts) {
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr) {
+    return;
+  }
+  if (call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      addConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(call);
+}
+} // namespace
+
+// static
+std::optional<NestedLoopJoinRange> NestedLoopJoinRange::make(
+    const core::NestedLoopJoinNode& joinNode,
+    const core::QueryConfig& config) {
+  if (joinNode.joinCondition() == nullptr ||
+      !config.nestedLoopJoinRangeEnabled()) {
+    return std::nullopt;
+  }
+  const auto& probeType = joinNode.sources()[0]->outputType();
+  const auto& buildType = joinNode.sources()[1]->outputType();
+  auto probeChannel = [&](const core::TypedExprPtr& expr) {
+    auto name = fieldName(expr);
+    return name ? probeType->getChildIdxIfExists(*name) : std::nullopt;
+  };
+  auto buildChannel = [&](const core::TypedExprPtr& expr) {
+    auto name = fieldName(expr);
+    return name ? buildType->getChildIdxIfExists(*name) : std::nullopt;
+  };
+
+  std::vector<const core::CallTypedExpr*> conjuncts;
+  addConjuncts(joinNode.joinCondition(), conjuncts);
+  std::optional<column_index_t> probe;
+  std::optional<column_index_t> low;
+  std::optional<column_index_t> high;
+  // Records 'lower <= upper' if one side is the probe column and the other a
+  // build column. A strict comparison gives the same candidates.
+  auto addBound = [&](const core::TypedExprPtr& lower,
+                      const core::TypedExprPtr& upper) {
+    auto probeUpper = probeChannel(upper);
+    auto buildLower = buildChannel(lower);
+    if (probeUpper.has_value() && buildLower.has_value() &&
+        (!probe.has_value() || probe == probeUpper)) {
+      probe = probeUpper;
+      low = buildLower;
+      return;
+    }
+    auto probeLower = probeChannel(lower);
+    auto buildUpper = buildChannel(upper);
+    if (probeLower.has_value() && buildUpper.has_value() &&
+        (!probe.has_value() || probe == probeLower)) {
+      probe = probeLower;
+      high = buildUpper;
+    }
+  };
+  for (auto* conjunct : conjuncts) {
+    const auto& name = conjunct->name();
+    const auto& inputs = conjunct->inputs();
+    if (name == "between" && inputs.size() == 3) {
+      addBound(inputs[1], inputs[0]);
+      addBound(inputs[0], inputs[2]);
+    } else if ((name == "lt" || name == "lte") && inputs.size() == 2) {
+      addBound(inputs[0], inputs[1]);
+    } else if ((name == "gt" || name == "gte") && inputs.size() == 2) {
+      addBound(inputs[1], inputs[0]);
+    }
+    if (low.has_value() && high.has_value()) {
+      break;
+    }
+  }
+  if (!low.has_value() || !high.has_value()) {
+    return std::nullopt;
+  }
+  const auto& probeKeyType = probeType->childAt(probe.value());
+  if (!isRangeType(probeKeyType) ||
+      !probeKeyType->equivalent(*buildType->childAt(low.value())) ||
+      !probeKeyType->equivalent(*buildType->childAt(high.value()))) {
+    return std::nullopt;
+  }
+  return NestedLoopJoinRange{probe.value(), low.value(), high.value()};
+}
+
+// static
+int64_t NestedLoopJoinRange::valueAt(
+    const DecodedVector& decoded,
+    vector_size_t row) {
+  switch (decoded.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      return decoded.valueAt<int8_t>(row);
+    case TypeKind::SMALLINT:
+      return decoded.valueAt<int16_t>(row);
+    case TypeKind::INTEGER:
+      return decoded.valueAt<int32_t>(row);
+    case TypeKind::BIGINT:
+      return decoded.valueAt<int64_t>(row);
+    case TypeKind::DATE:
+      return decoded.valueAt<Date>(row).days();
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
   std::vector<ContinuePromise> promises;
   {
@@ -50,7 +185,8 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild"),
+      range_(NestedLoopJoinRange::make(*joinNode, driverCtx->queryConfig())) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -105,12 +241,61 @@ void NestedLoopJoinBuild::noMoreInput() {
     }
   }
 
+  if (range_.has_value() && !dataVectors_.empty()) {
+    dataVectors_ = {sortByRangeLow()};
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
       ->setData(std::move(dataVectors_));
 }
 
+RowVectorPtr NestedLoopJoinBuild::sortByRangeLow() {
+  RowVectorPtr data;
+  if (dataVectors_.size() == 1) {
+    data = std::move(dataVectors_[0]);
+  } else {
+    vector_size_t numRows = 0;
+    for (const auto& vector : dataVectors_) {
+      numRows += vector->size();
+    }
+    data = BaseVector::create<RowVector>(
+        dataVectors_[0]->type(), numRows, pool());
+    vector_size_t offset = 0;
+    for (const auto& vector : dataVectors_) {
+      data->copy(vector.get(), offset, 0, vector->size());
+      offset += vector->size();
+    }
+  }
+  dataVectors_.clear();
+
+  const auto numRows = data->size();
+  SelectivityVector rows(numRows);
+  DecodedVector low(*data->childAt(range_->buildLowChannel), rows);
+  DecodedVector high(*data->childAt(range_->buildHighChannel), rows);
+  std::vector<int64_t> lowValues(numRows);
+  std::vector<vector_size_t> order;
+  order.reserve(numRows);
+  std::vector<vector_size_t> nullRows;
+  for (auto row = 0; row < numRows; ++row) {
+    if (low.isNullAt(row) || high.isNullAt(row)) {
+      nullRows.push_back(row);
+    } else {
+      lowValues[row] = NestedLoopJoinRange::valueAt(low, row);
+      order.push_back(row);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), [&](auto left, auto right) {
+    return lowValues[left] < lowValues[right];
+  });
+  order.insert(order.end(), nullRows.begin(), nullRows.end());
+
+  auto sorted = BaseVector::create<RowVector>(data->type(), numRows, pool());
+  sorted->copy(data.get(), rows, order.data());
+  return sorted;
+}
+
 bool NestedLoopJoinBuild::isFinished() {
   return !future_.valid() && noMoreInput_;
 }
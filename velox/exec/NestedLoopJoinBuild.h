@@ -17,9 +17,30 @@
 
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::exec {
 
+/// A nested loop join condition that bounds a probe column by two build
+/// columns, e.g. 'p BETWEEN b_start AND b_end' or 'p >= b_start AND p < b_end'
+/// among other conjuncts. The build side is then sorted on the lower bound so
+/// that the probe can find the build rows whose interval may contain a probe
+/// value by binary search. The full condition is still evaluated on these.
+struct NestedLoopJoinRange {
+  column_index_t probeChannel;
+  column_index_t buildLowChannel;
+  column_index_t buildHighChannel;
+
+  /// Returns the range of 'joinNode' if its condition has one over integer or
+  /// date columns and QueryConfig::nestedLoopJoinRangeEnabled() is true.
+  static std::optional<NestedLoopJoinRange> make(
+      const core::NestedLoopJoinNode& joinNode,
+      const core::QueryConfig& config);
+
+  /// Returns the value of an integer or date column as int64_t.
+  static int64_t valueAt(const DecodedVector& decoded, vector_size_t row);
+};
+
 class NestedLoopJoinBridge : public JoinBridge {
  public:
   void setData(std::vector<RowVectorPtr> buildVectors);
@@ -59,6 +80,12 @@ class NestedLoopJoinBuild : public Operator {
   }
 
  private:
+  // Returns the rows of 'dataVectors_' in one vector sorted on the lower
+  // bound of 'range_'. Rows with a null bound go last.
+  RowVectorPtr sortByRangeLow();
+
+  const std::optional<NestedLoopJoinRange> range_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
   // Future for synchronizing with other Drivers of the same pipeline. All build
@@ -55,7 +55,8 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->id(),
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
-      joinType_(joinNode->joinType()) {
+      joinType_(joinNode->joinType()),
+      range_(NestedLoopJoinRange::make(*joinNode, driverCtx->queryConfig())) {
   auto probeType = joinNode->sources()[0]->outputType();
   auto buildType = joinNode->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
@@ -82,6 +83,10 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
       }
       VELOX_CHECK(buildVectors_.has_value());
 
+      if (range_.has_value() && !buildSideEmpty_) {
+        initializeRange();
+      }
+
       if (needsBuildMismatch(joinType_)) {
         buildMatched_.resize(buildVectors_->size());
         for (auto i = 0; i < buildVectors_->size(); ++i) {
@@ -117,6 +122,9 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (range_.has_value()) {
+    rangeProbe_.decode(*input_->childAt(range_->probeChannel));
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -162,9 +170,9 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
-    output = doMatch(probeCnt);
-    if (advanceProbeRows(probeCnt)) {
+    const vector_size_t numRows = nextCrossProduct();
+    output = doMatch(numRows);
+    if (advanceProbeRows()) {
       if (!needsProbeMismatch(joinType_)) {
         finishProbeInput();
       }
@@ -320,75 +328,107 @@ bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   return true;
 }
 
-vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
+void NestedLoopJoinProbe::initializeRange() {
+  VELOX_CHECK_EQ(buildVectors_->size(), 1);
+  const auto& build = buildVectors_.value()[0];
+  DecodedVector low(*build->childAt(range_->buildLowChannel));
+  DecodedVector high(*build->childAt(range_->buildHighChannel));
+  rangeLows_.reserve(build->size());
+  rangeMaxHighs_.reserve(build->size());
+  for (auto row = 0; row < build->size(); ++row) {
+    if (low.isNullAt(row) || high.isNullAt(row)) {
+      // The rows with a null bound are last and never match.
+      break;
+    }
+    rangeLows_.push_back(NestedLoopJoinRange::valueAt(low, row));
+    const auto highValue = NestedLoopJoinRange::valueAt(high, row);
+    rangeMaxHighs_.push_back(
+        row == 0 ? highValue : std::max(rangeMaxHighs_.back(), highValue));
+  }
+}
+
+std::pair<vector_size_t, vector_size_t> NestedLoopJoinProbe::buildRowRange(
+    vector_size_t probeRow) const {
+  if (!range_.has_value()) {
+    return {0, buildVectors_.value()[buildIndex_]->size()};
+  }
+  if (rangeProbe_.isNullAt(probeRow)) {
+    return {0, 0};
+  }
+  const auto value = NestedLoopJoinRange::valueAt(rangeProbe_, probeRow);
+  // The candidates start at or below 'value' and the interval of one of them
+  // or of a row before it ends at or above 'value'.
+  const auto end =
+      std::upper_bound(rangeLows_.begin(), rangeLows_.end(), value) -
+      rangeLows_.begin();
+  const auto begin = std::lower_bound(
+                         rangeMaxHighs_.begin(),
+                         rangeMaxHighs_.begin() + end,
+                         value) -
+      rangeMaxHighs_.begin();
+  return {begin, end};
+}
+
+vector_size_t NestedLoopJoinProbe::nextCrossProduct() {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
 
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, outputBatchSize_, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, outputBatchSize_, pool());
   const auto inputSize = input_->size();
-  auto numBuildRows = buildVectors_.value()[buildIndex_]->size();
-  vector_size_t numProbeRows;
-  if (numBuildRows > outputBatchSize_) {
-    numProbeRows = 1;
-  } else {
-    numProbeRows = std::min(
-        (vector_size_t)outputBatchSize_ / numBuildRows, inputSize - probeRow_);
-  }
-  return numProbeRows;
+  vector_size_t numRows = 0;
+  while (probeRow_ < inputSize && numRows < outputBatchSize_) {
+    const auto [begin, end] = buildRowRange(probeRow_);
+    const auto start = std::max(buildRow_, begin);
+    const auto count = std::min<vector_size_t>(
+        std::max(end - start, 0), outputBatchSize_ - numRows);
+    std::fill(
+        rawProbeIndices.begin() + numRows,
+        rawProbeIndices.begin() + numRows + count,
+        probeRow_);
+    std::iota(
+        rawBuildIndices.begin() + numRows,
+        rawBuildIndices.begin() + numRows + count,
+        start);
+    numRows += count;
+    if (start + count < end) {
+      // The batch is full. Continue with the rest of the build rows next time.
+      buildRow_ = start + count;
+      break;
+    }
+    buildRow_ = 0;
+    ++probeRow_;
+  }
+  return numRows;
 }
 
 RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
-    vector_size_t probeCnt,
+    vector_size_t numRows,
     const RowTypePtr& outputType,
     const std::vector<IdentityProjection>& probeProjections,
     const std::vector<IdentityProjection>& buildProjections) {
-  VELOX_CHECK_GT(probeCnt, 0);
+  VELOX_CHECK_GT(numRows, 0);
   VELOX_CHECK(!hasProbedAllBuildData());
 
-  const auto buildSize = buildVectors_.value()[buildIndex_]->size();
-  const auto numOutputRows = probeCnt * buildSize;
-  const bool probeCntChanged = (probeCnt != numPrevProbedRows_);
-  numPrevProbedRows_ = probeCnt;
-  auto output =
-      BaseVector::create<RowVector>(outputType, numOutputRows, pool());
-
-  auto rawProbeIndices =
-      initializeRowNumberMapping(probeIndices_, numOutputRows, pool());
-  for (auto i = 0; i < probeCnt; ++i) {
-    std::fill(
-        rawProbeIndices.begin() + i * buildSize,
-        rawProbeIndices.begin() + (i + 1) * buildSize,
-        probeRow_ + i);
-  }
-
-  if (probeCntChanged) {
-    auto rawBuildIndices_ =
-        initializeRowNumberMapping(buildIndices_, numOutputRows, pool());
-    for (auto i = 0; i < probeCnt; ++i) {
-      std::iota(
-          rawBuildIndices_.begin() + i * buildSize,
-          rawBuildIndices_.begin() + (i + 1) * buildSize,
-          0);
-    }
-  }
-
-  projectChildren(
-      output, input_, probeProjections, numOutputRows, probeIndices_);
+  auto output = BaseVector::create<RowVector>(outputType, numRows, pool());
+  projectChildren(output, input_, probeProjections, numRows, probeIndices_);
   projectChildren(
       output,
       buildVectors_.value()[buildIndex_],
       buildProjections,
-      numOutputRows,
+      numRows,
       buildIndices_);
   return output;
 }
 
-bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
-  probeRow_ += probeCnt;
+bool NestedLoopJoinProbe::advanceProbeRows() {
   if (probeRow_ < input_->size()) {
     return false;
   }
   probeRow_ = 0;
-  numPrevProbedRows_ = 0;
+  buildRow_ = 0;
   do {
     ++buildIndex_;
   } while (!hasProbedAllBuildData() &&
@@ -396,17 +436,21 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
   return hasProbedAllBuildData();
 }
 
-RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
+RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t numRows) {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
 
+  if (numRows == 0) {
+    return nullptr;
+  }
+
   if (joinCondition_ == nullptr) {
     return getCrossProduct(
-        probeCnt, outputType_, identityProjections_, buildProjections_);
+        numRows, outputType_, identityProjections_, buildProjections_);
   }
 
   auto filterInput = getCrossProduct(
-      probeCnt,
+      numRows,
       filterInputType_,
       filterProbeProjections_,
       filterBuildProjections_);
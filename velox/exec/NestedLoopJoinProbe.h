@@ -56,12 +56,23 @@ class NestedLoopJoinProbe : public Operator {
 
   bool getBuildData(ContinueFuture* future);
 
-  // Calculates the number of probe rows to match with the build side vectors
-  // given the output batch size limit.
-  vector_size_t getNumProbeRows() const;
-
-  // Generates cross product of next 'probeCnt' rows of input_, and all rows of
-  // build side vector at 'buildIndex_' in 'buildData_'.
+  // Pairs rows of input_ from 'probeRow_' with rows of the build side vector
+  // at 'buildIndex_' from 'buildRow_' into 'probeIndices_' and
+  // 'buildIndices_'. Makes at most 'outputBatchSize_' pairs, so that a block
+  // of probe rows is paired with a block of build rows, and advances
+  // 'probeRow_' and 'buildRow_' past them. Returns the number of pairs.
+  vector_size_t nextCrossProduct();
+
+  // Returns the rows of the build side vector at 'buildIndex_' to pair with
+  // 'probeRow'. These are all rows unless 'range_' is set.
+  std::pair<vector_size_t, vector_size_t> buildRowRange(
+      vector_size_t probeRow) const;
+
+  // Makes the search arrays of 'range_' from the build side vector.
+  void initializeRange();
+
+  // Generates the cross product of the 'numRows' pairs made by
+  // nextCrossProduct().
   // 'outputType' specifies the type of output.
   // Projections from input_ and buildData_ to the output are specified by
   // 'probeProjections' and 'buildProjections' respectively. Caller is
@@ -70,19 +81,20 @@ class NestedLoopJoinProbe : public Operator {
   // TODO: consider consolidate the routine of producing cartesian product that
   // can be reused at MergeJoin::addToOutput
   RowVectorPtr getCrossProduct(
-      vector_size_t probeCnt,
+      vector_size_t numRows,
       const RowTypePtr& outputType,
       const std::vector<IdentityProjection>& probeProjections,
       const std::vector<IdentityProjection>& buildProjections);
 
-  // Evaluates joinCondition against the output of getCrossProduct(probeCnt),
+  // Evaluates joinCondition against the output of getCrossProduct(numRows),
   // returns the result that passed joinCondition, updates probeMatched_,
   // buildMatched_ accordingly.
-  RowVectorPtr doMatch(vector_size_t probeCnt);
+  RowVectorPtr doMatch(vector_size_t numRows);
 
-  // Updates 'probeRow_' and 'buildIndex_' by advancing 'probeRow_' by probeCnt.
-  // Returns true if 'buildIndex_' points to the end of 'buildData_'.
-  bool advanceProbeRows(vector_size_t probeCnt);
+  // Advances 'buildIndex_' if all rows of input_ have been paired with the
+  // current build side vector. Returns true if 'buildIndex_' points to the end
+  // of 'buildData_'.
+  bool advanceProbeRows();
 
   bool hasProbedAllBuildData() const {
     return (buildIndex_ == buildVectors_.value().size());
@@ -134,9 +146,9 @@ class NestedLoopJoinProbe : public Operator {
   // Probe side state
   // Input row to process on next call to getOutput().
   vector_size_t probeRow_{0};
-  // Records the number of probed rows in last getCrossProduct() call. It is
-  // reset upon each 'buildIndex_' update.
-  vector_size_t numPrevProbedRows_{0};
+  // Next row of the build side vector to pair with 'probeRow_'. 0 if no rows
+  // have been paired with 'probeRow_' yet.
+  vector_size_t buildRow_{0};
   bool lastProbe_{false};
   // Represents whether probe side rows have been matched.
   SelectivityVector probeMatched_;
@@ -157,6 +169,17 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<SelectivityVector> buildMatched_;
   std::vector<IdentityProjection> filterBuildProjections_;
   BufferPtr buildOutMapping_;
+
+  // Set if the join condition bounds a probe column by two build columns. The
+  // build side is then one vector sorted on the lower bound, with the rows
+  // with a null bound last.
+  const std::optional<NestedLoopJoinRange> range_;
+  // The lower bounds of the build rows with non-null bounds, ascending.
+  std::vector<int64_t> rangeLows_;
+  // The running max of the upper bounds of the same rows.
+  std::vector<int64_t> rangeMaxHighs_;
+  // The probe column of 'range_' for input_.
+  DecodedVector rangeProbe_;
 };
 
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/process/ProcessBase.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/OperatorUtils.h"
@@ -47,7 +48,20 @@ std::shared_ptr<connector::ConnectorQueryCtx>
 OperatorCtx::createConnectorQueryCtx(
     const std::string& connectorId,
     const std::string& planNodeId,
-    memory::MemoryPool* connectorPool) const {
+    memory::MemoryPool* connectorPool,
+    const Spiller::Config* spillConfig) const {
+  std::optional<connector::ConnectorSpillConfig> connectorSpillConfig;
+  if (spillConfig != nullptr) {
+    connectorSpillConfig = connector::ConnectorSpillConfig{
+        spillConfig->filePath,
+        spillConfig->maxFileSize,
+        spillConfig->minSpillRunSize,
+        spillConfig->executor,
+        spillConfig->spillableReservationGrowthPct,
+        spillConfig->testSpillPct,
+        spillConfig->codecOptions.compressionKind,
+        spillConfig->codecOptions.checksumEnabled};
+  }
   return std::make_shared<connector::ConnectorQueryCtx>(
       pool_,
       connectorPool,
@@ -57,7 +71,8 @@ OperatorCtx::createConnectorQueryCtx(
       driverCtx_->task->queryCtx()->allocator(),
       taskId(),
       planNodeId,
-      driverCtx_->driverId);
+      driverCtx_->driverId,
+      std::move(connectorSpillConfig));
 }
 
 Operator::Operator(
@@ -77,8 +92,15 @@ Operator::Operator(
       stats_(OperatorStats{
           operatorId,
           driverCtx->pipelineId,
-          std::move(planNodeId),
-          std::move(operatorType)}) {
+          planNodeId,
+          operatorType}),
+      inputCapture_(InputCapture::create(
+          driverCtx->queryConfig(),
+          driverCtx->task->taskId(),
+          planNodeId,
+          operatorType,
+          driverCtx->pipelineId,
+          driverCtx->driverId)) {
   maybeSetReclaimer();
 }
 
@@ -231,6 +253,14 @@ uint32_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
 
+  if (!averageRowSize.has_value() &&
+      queryConfig.adaptiveOutputBatchRowsEnabled()) {
+    const auto lockedStats = stats_.rlock();
+    if (lockedStats->outputPositions > 0) {
+      averageRowSize =
+          lockedStats->outputBytes / lockedStats->outputPositions;
+    }
+  }
   if (!averageRowSize.has_value()) {
     return queryConfig.preferredOutputBatchRows();
   }
@@ -252,10 +282,7 @@ uint32_t Operator::outputBatchRows(
 }
 
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
-  uint64_t now =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          std::chrono::high_resolution_clock::now().time_since_epoch())
-          .count();
+  const uint64_t now = getCurrentTimeMicro();
   const auto wallNanos = (now - start) * 1000;
   const auto blockReason = blockingReasonToString(reason).substr(1);
 
@@ -268,6 +295,24 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::releaseVectorPool() {
+  auto* vectorPool = operatorCtx_->vectorPoolIfCreated();
+  if (vectorPool == nullptr) {
+    return;
+  }
+  const auto& vectorPoolStats = vectorPool->stats();
+  if (vectorPoolStats.numAllocated > 0 || vectorPoolStats.numRecycled > 0) {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        "vectorPoolAllocations",
+        RuntimeCounter(vectorPoolStats.numAllocated));
+    lockedStats->addRuntimeStat(
+        "vectorPoolReuses", RuntimeCounter(vectorPoolStats.numRecycled));
+  }
+  vectorPool->resetStats();
+  vectorPool->clear();
+}
+
 std::string Operator::toString() const {
   std::stringstream out;
   if (auto task = operatorCtx_->task()) {
@@ -371,6 +416,10 @@ void OperatorStats::add(const OperatorStats& other) {
     }
   }
 
+  for (const auto& [name, stats] : other.expressionStats) {
+    expressionStats[name].add(stats);
+  }
+
   numDrivers += other.numDrivers;
   spilledBytes += other.spilledBytes;
   spilledRows += other.spilledRows;
@@ -400,6 +449,7 @@ void OperatorStats::clear() {
   memoryStats.clear();
 
   runtimeStats.clear();
+  expressionStats.clear();
 }
 
 std::unique_ptr<memory::MemoryReclaimer> Operator::MemoryReclaimer::create(
@@ -420,6 +470,14 @@ void Operator::MemoryReclaimer::enterArbitration() {
     // terminated.
     VELOX_FAIL("Terminate detected when entering suspension");
   }
+  if (auto* timeline = driver->task()->memoryTimeline()) {
+    timeline->record(
+        {MemoryTimelineEvent::Kind::kArbitrationRequest,
+         driver->driverCtx()->pipelineId,
+         op_->operatorId(),
+         getCurrentTimeMs(),
+         op_->pool()->reservedBytes()});
+  }
 }
 
 void Operator::MemoryReclaimer::leaveArbitration() noexcept {
@@ -428,6 +486,14 @@ void Operator::MemoryReclaimer::leaveArbitration() noexcept {
   // processing.
   VELOX_CHECK_NOT_NULL(driver);
   VELOX_CHECK_EQ(std::this_thread::get_id(), driver->state().thread);
+  if (auto* timeline = driver->task()->memoryTimeline()) {
+    timeline->record(
+        {MemoryTimelineEvent::Kind::kArbitrationGrant,
+         driver->driverCtx()->pipelineId,
+         op_->operatorId(),
+         getCurrentTimeMs(),
+         op_->pool()->reservedBytes()});
+  }
   driver->task()->leaveSuspended(driver->state());
 }
 
@@ -459,8 +525,41 @@ uint64_t Operator::MemoryReclaimer::reclaim(
       driver->state().isTerminated);
   VELOX_CHECK(driver->task()->pauseRequested());
 
+  // Free the vectors cached for reuse before spilling.
+  if (auto* vectorPool = op_->operatorCtx_->vectorPoolIfCreated()) {
+    vectorPool->clear();
+  }
+  auto* timeline = driver->task()->memoryTimeline();
+  if (timeline != nullptr) {
+    timeline->record(
+        {MemoryTimelineEvent::Kind::kSpillStart,
+         driver->driverCtx()->pipelineId,
+         op_->operatorId(),
+         getCurrentTimeMs(),
+         pool->reservedBytes()});
+  }
+  const auto startMicros = getCurrentTimeMicro();
   op_->reclaim(targetBytes);
-  return pool->shrinkManaged(pool, targetBytes);
+  const auto reclaimedBytes = pool->shrinkManaged(pool, targetBytes);
+  if (timeline != nullptr) {
+    timeline->record(
+        {MemoryTimelineEvent::Kind::kSpillEnd,
+         driver->driverCtx()->pipelineId,
+         op_->operatorId(),
+         getCurrentTimeMs(),
+         static_cast<int64_t>(reclaimedBytes)});
+  }
+  if (auto* trace = driver->task()->trace()) {
+    trace->record(
+        {TaskTraceEvent::Kind::kReclaim,
+         driver->driverCtx()->pipelineId,
+         driver->driverCtx()->driverId,
+         op_->operatorId(),
+         startMicros,
+         getCurrentTimeMicro() - startMicros,
+         static_cast<int64_t>(reclaimedBytes)});
+  }
+  return reclaimedBytes;
 }
 
 void Operator::MemoryReclaimer::abort(memory::MemoryPool* pool) {
@@ -19,8 +19,10 @@
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
+#include "velox/exec/InputCapture.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Spiller.h"
+#include "velox/expression/ExprStats.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::exec {
@@ -140,6 +142,10 @@ struct OperatorStats {
 
   std::unordered_map<std::string, RuntimeMetric> runtimeStats;
 
+  /// Stats of the expressions evaluated by the operator, by function name.
+  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
+  std::unordered_map<std::string, ExprStats> expressionStats;
+
   int numDrivers = 0;
 
   OperatorStats(
@@ -209,14 +215,21 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Returns the vector pool of execCtx() or nullptr if execCtx() has not been
+  /// made.
+  VectorPool* vectorPoolIfCreated() const {
+    return execCtx_ ? &execCtx_->vectorPool() : nullptr;
+  }
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
-  /// for connector use.
+  /// for connector use. 'spillConfig' is passed on to the connector if set.
   std::shared_ptr<connector::ConnectorQueryCtx> createConnectorQueryCtx(
       const std::string& connectorId,
       const std::string& planNodeId,
-      memory::MemoryPool* connectorPool) const;
+      memory::MemoryPool* connectorPool,
+      const Spiller::Config* spillConfig = nullptr) const;
 
  private:
   DriverCtx* const driverCtx_;
@@ -301,6 +314,14 @@ class Operator : public BaseRuntimeStatWriter {
   // @param input Non-empty input vector.
   virtual void addInput(RowVectorPtr input) = 0;
 
+  /// Saves 'input' for replay if the query config enables input capture for
+  /// the plan node of 'this'. Called by the Driver before addInput().
+  void maybeCaptureInput(const RowVectorPtr& input) {
+    if (UNLIKELY(inputCapture_ != nullptr)) {
+      inputCapture_->capture(input);
+    }
+  }
+
   // Informs 'this' that addInput will no longer be called. This means
   // that any partial state kept by 'this' should be returned by
   // the next call(s) to getOutput. Not used if operator is a source operator,
@@ -353,6 +374,13 @@ class Operator : public BaseRuntimeStatWriter {
     return false;
   }
 
+  // Returns the number of further input rows after which this operator
+  // finishes regardless of the rest of its input, e.g. the rows left to a
+  // Limit. std::nullopt if the operator consumes all its input.
+  virtual std::optional<int64_t> maxInputRows() const {
+    return std::nullopt;
+  }
+
   // Adds a filter dynamically generated by a downstream operator. Called only
   // if canAddFilter() returns true.
   virtual void addDynamicFilter(
@@ -374,6 +402,7 @@ class Operator : public BaseRuntimeStatWriter {
   virtual void close() {
     input_ = nullptr;
     results_.clear();
+    releaseVectorPool();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -492,6 +521,10 @@ class Operator : public BaseRuntimeStatWriter {
   static std::vector<std::unique_ptr<PlanNodeTranslator>>& translators();
   friend class NonReclaimableSection;
 
+  // Adds the allocation and reuse counts of the vector pool of 'this' to the
+  // runtime stats and frees the vectors it caches.
+  void releaseVectorPool();
+
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
     static std::unique_ptr<memory::MemoryReclaimer> create(
@@ -570,7 +603,8 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows, or with adaptiveOutputBatchRowsEnabled, uses the
+  /// average size of the rows this has output so far once there are any.
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
@@ -582,6 +616,9 @@ class Operator : public BaseRuntimeStatWriter {
 
   folly::Synchronized<OperatorStats> stats_;
 
+  /// Set if the query config enables input capture for the plan node.
+  const std::unique_ptr<InputCapture> inputCapture_;
+
   /// Indicates if an operator is under a non-reclaimable execution section.
   /// This prevents the memory arbitrator from reclaiming memory from this
   /// operator if it happens to be suspended for memory arbitration processing.
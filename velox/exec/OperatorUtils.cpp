@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -416,4 +417,116 @@ void projectChildren(
         wrapChild(size, mapping, src[projection.inputChannel]);
   }
 }
+
+namespace {
+// ORs into 'boundaries' a bit for each row in [1, size) whose value differs
+// from the previous one. Nulls are ignored.
+template <typename T>
+void flatKeyBoundaries(
+    const T* values,
+    vector_size_t size,
+    uint64_t* boundaries) {
+  using Batch = xsimd::batch<T>;
+  constexpr vector_size_t kBatch = Batch::size;
+  static_assert(64 % kBatch == 0);
+  vector_size_t row = 1;
+  for (; row < std::min(kBatch, size); ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(boundaries, row);
+    }
+  }
+  // 'row' is a multiple of kBatch, so the bits of one batch never straddle
+  // two words.
+  for (; row + kBatch <= size; row += kBatch) {
+    const uint64_t mask = simd::toBitMask(
+        Batch::load_unaligned(values + row) !=
+        Batch::load_unaligned(values + row - 1));
+    if (mask != 0) {
+      boundaries[row / 64] |= mask << (row % 64);
+    }
+  }
+  for (; row < size; ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(boundaries, row);
+    }
+  }
+}
+
+// Returns true if the boundaries of flat 'key' were added to 'boundaries'.
+bool addFlatKeyBoundaries(
+    const DecodedVector& key,
+    vector_size_t size,
+    uint64_t* boundaries) {
+  if (!key.isIdentityMapping()) {
+    return false;
+  }
+  auto* nulls = key.base()->rawNulls();
+  // Rows next to a null are fixed up after comparing the values, so with nulls
+  // the differences of this key are collected separately.
+  std::vector<uint64_t> keyBoundaries;
+  auto* target = boundaries;
+  if (nulls) {
+    keyBoundaries.resize(bits::nwords(size));
+    target = keyBoundaries.data();
+  }
+  switch (key.base()->typeKind()) {
+    case TypeKind::TINYINT:
+      flatKeyBoundaries(key.data<int8_t>(), size, target);
+      break;
+    case TypeKind::SMALLINT:
+      flatKeyBoundaries(key.data<int16_t>(), size, target);
+      break;
+    case TypeKind::INTEGER:
+      flatKeyBoundaries(key.data<int32_t>(), size, target);
+      break;
+    case TypeKind::BIGINT:
+      flatKeyBoundaries(key.data<int64_t>(), size, target);
+      break;
+    default:
+      return false;
+  }
+  if (nulls) {
+    bits::forEachUnsetBit(nulls, 0, size, [&](vector_size_t row) {
+      if (row > 0) {
+        bits::setBit(target, row, !bits::isBitNull(nulls, row - 1));
+      }
+      if (row + 1 < size) {
+        bits::setBit(target, row + 1, !bits::isBitNull(nulls, row + 1));
+      }
+    });
+    bits::orBits(boundaries, target, 0, size);
+  }
+  return true;
+}
+} // namespace
+
+void findKeyBoundaries(
+    const std::vector<DecodedVector>& keys,
+    vector_size_t size,
+    uint64_t* boundaries) {
+  std::fill(boundaries, boundaries + bits::nwords(size), 0);
+  for (const auto& key : keys) {
+    if (key.isConstantMapping() ||
+        addFlatKeyBoundaries(key, size, boundaries)) {
+      continue;
+    }
+    auto* base = key.base();
+    for (auto row = 1; row < size; ++row) {
+      if (bits::isBitSet(boundaries, row)) {
+        continue;
+      }
+      const bool isNull = key.isNullAt(row);
+      const bool prevIsNull = key.isNullAt(row - 1);
+      if (isNull || prevIsNull) {
+        if (isNull != prevIsNull) {
+          bits::setBit(boundaries, row);
+        }
+      } else if (!base->equalValueAt(
+                     base, key.index(row), key.index(row - 1))) {
+        bits::setBit(boundaries, row);
+      }
+    }
+  }
+}
+
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spiller.h"
+#include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::exec {
 
@@ -155,4 +156,17 @@ void projectChildren(
     int32_t size,
     const BufferPtr& mapping);
 
+/// Sets bit 'i' of 'boundaries' for each row 'i' in [1, size) that differs
+/// from row 'i - 1' in any of 'keys', and clears all other bits, including bit
+/// 0. 'boundaries' must have space for bits::nwords(size) words. Nulls compare
+/// equal to each other and different from any value, as in
+/// BaseVector::equalValueAt. Flat integer keys are compared against themselves
+/// shifted by one row with SIMD instructions and the per-key differences are
+/// OR'ed together. Finds runs of equal keys in clustered input, e.g. groups in
+/// streaming aggregation, window partitions or merge join key runs.
+void findKeyBoundaries(
+    const std::vector<DecodedVector>& keys,
+    vector_size_t size,
+    uint64_t* boundaries);
+
 } // namespace facebook::velox::exec
@@ -16,10 +16,11 @@
 #include "velox/exec/OrderBy.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 #include "velox/vector/FlatVector.h"
 
-#include <boost/sort/sort.hpp>
+#include <numeric>
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -47,7 +48,9 @@ OrderBy::OrderBy(
       numSortKeys_(orderByNode->sortingKeys().size()),
       spillMemoryThreshold_(operatorCtx_->driverCtx()
                                 ->queryConfig()
-                                .orderBySpillMemoryThreshold()) {
+                                .orderBySpillMemoryThreshold()),
+      sortThreads_(
+          operatorCtx_->driverCtx()->queryConfig().orderBySortThreads()) {
   VELOX_CHECK(pool()->trackUsage());
 
   std::vector<TypePtr> keyTypes;
@@ -209,49 +212,95 @@ void OrderBy::reclaim(uint64_t targetBytes) {
   VELOX_CHECK(canReclaim());
   auto* driver = operatorCtx_->driver();
 
-  // NOTE: an order by operator is reclaimable if it hasn't started output
-  // processing and is not under non-reclaimable execution section.
-  if (noMoreInput_ || nonReclaimableSection_) {
+  // NOTE: an order by operator is reclaimable if it hasn't finished output
+  // processing, hasn't spilled before producing output and is not under
+  // non-reclaimable execution section.
+  if (finished_ || nonReclaimableSection_ ||
+      (noMoreInput_ && spiller_ != nullptr)) {
     // TODO: add stats to record the non-reclaimable case and reduce the log
     // frequency if it is too verbose.
     LOG(WARNING) << "Can't reclaim from order by operator, noMoreInput_["
-                 << noMoreInput_ << "], nonReclaimableSection_["
-                 << nonReclaimableSection_ << "], " << toString();
+                 << noMoreInput_ << "], finished_[" << finished_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << toString();
     return;
   }
 
-  // TODO: support fine-grain disk spilling based on 'targetBytes' after having
-  // row container memory compaction support later.
-  spill(0, targetBytes);
-  VELOX_CHECK_EQ(data_->numRows(), 0);
-  data_->clear();
+  if (noMoreInput_) {
+    // The output processing has started. Spills the rows that have not been
+    // returned and switches to produce the output from the spilled data.
+    spillOutput();
+  } else {
+    // TODO: support fine-grain disk spilling based on 'targetBytes' after
+    // having row container memory compaction support later.
+    spill(0, targetBytes);
+    VELOX_CHECK_EQ(data_->numRows(), 0);
+    data_->clear();
+  }
   // Release the minimum reserved memory.
   pool()->release();
 }
 
+void OrderBy::ensureSpiller() {
+  if (spiller_ != nullptr) {
+    return;
+  }
+  const auto& spillConfig = spillConfig_.value();
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kOrderBy,
+      data_.get(),
+      [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+      internalStoreType_,
+      data_->keyTypes().size(),
+      keyCompareFlags_,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      Spiller::spillPool(),
+      spillConfig.executor,
+      spillConfig.codecOptions,
+      spillConfig.tiers);
+  VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+}
+
 void OrderBy::spill(int64_t targetRows, int64_t targetBytes) {
   VELOX_CHECK_GE(targetRows, 0);
   VELOX_CHECK_GE(targetBytes, 0);
 
-  if (spiller_ == nullptr) {
-    const auto& spillConfig = spillConfig_.value();
-    spiller_ = std::make_unique<Spiller>(
-        Spiller::Type::kOrderBy,
-        data_.get(),
-        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
-        internalStoreType_,
-        data_->keyTypes().size(),
-        keyCompareFlags_,
-        spillConfig.filePath,
-        spillConfig.maxFileSize,
-        spillConfig.minSpillRunSize,
-        Spiller::spillPool(),
-        spillConfig.executor);
-    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
-  }
+  ensureSpiller();
   spiller_->spill(targetRows, targetBytes);
 }
 
+void OrderBy::spillOutput() {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_LT(numRowsReturned_, numRows_);
+  VELOX_CHECK_EQ(returningRows_.size(), numRows_);
+
+  ensureSpiller();
+  spiller_->spillRows(folly::Range<char**>(
+      returningRows_.data() + numRowsReturned_, numRows_ - numRowsReturned_));
+  // Frees the returned rows. They must be gone before finishing spill or they
+  // would be merged into the output again.
+  returningRows_.clear();
+  returningRows_.shrink_to_fit();
+  data_->clear();
+  startSpillMerge();
+}
+
+void OrderBy::startSpillMerge() {
+  // Finish spill, and we shouldn't get any rows from non-spilled partition as
+  // there is only one hash partition for orderBy operator.
+  Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+  VELOX_CHECK(nonSpilledRows.empty());
+
+  VELOX_CHECK_NULL(spillMerge_);
+  recordSpillStats();
+  spillMerge_ = spiller_->startMerge(0);
+  spillSources_.resize(outputBatchSize_);
+  spillSourceRows_.resize(outputBatchSize_);
+}
+
 void OrderBy::noMoreInput() {
   Operator::noMoreInput();
 
@@ -261,39 +310,26 @@ void OrderBy::noMoreInput() {
     return;
   }
 
+  // Prevents the memory arbitrator to reclaim memory from this operator while
+  // the rows are being sorted.
+  NonReclaimableSection guard(this);
+
   if (spiller_ == nullptr) {
     VELOX_CHECK_EQ(numRows_, data_->numRows());
     // Sort the pointers to the rows in RowContainer (data_) instead of sorting
-    // the rows.
+    // the rows. The leading keys are compared on a binary prefix.
     returningRows_.resize(numRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numRows_, returningRows_.data());
-    constexpr uint16_t kSortThreads = 8;
-    boost::sort::parallel_stable_sort(
-        returningRows_.begin(),
-        returningRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < numSortKeys_; ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, keyCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        },
-        kSortThreads);
-
+    std::vector<column_index_t> keyColumns(numSortKeys_);
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    PrefixSort(data_.get(), std::move(keyColumns), keyCompareFlags_)
+        .sort(
+            returningRows_,
+            operatorCtx_->task()->queryCtx()->executor(),
+            sortThreads_);
   } else {
-    // Finish spill, and we shouldn't get any rows from non-spilled partition as
-    // there is only one hash partition for orderBy operator.
-    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
-    VELOX_CHECK(nonSpilledRows.empty());
-
-    VELOX_CHECK_NULL(spillMerge_);
-    recordSpillStats();
-    spillMerge_ = spiller_->startMerge(0);
-    spillSources_.resize(outputBatchSize_);
-    spillSourceRows_.resize(outputBatchSize_);
+    startSpillMerge();
   }
 }
 
@@ -314,6 +350,9 @@ RowVectorPtr OrderBy::getOutput() {
   if (finished_ || !noMoreInput_ || numRows_ == numRowsReturned_) {
     return nullptr;
   }
+  // Prevents the memory arbitrator to reclaim memory from this operator while
+  // an output batch is being produced.
+  NonReclaimableSection guard(this);
   prepareOutput();
 
   if (spiller_ != nullptr) {
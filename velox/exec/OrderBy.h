@@ -80,6 +80,18 @@ class OrderBy : public Operator {
   // in a paused state and off thread.
   void spill(int64_t targetRows, int64_t targetBytes);
 
+  // Creates 'spiller_' if it has not been created yet.
+  void ensureSpiller();
+
+  // Invoked by external memory management after the output processing has
+  // started without spilling. Spills the sorted rows that have not been
+  // returned, frees 'data_' and produces the rest of the output from the
+  // spilled data.
+  void spillOutput();
+
+  // Finishes spilling and sets up 'spillMerge_' to read back the spilled data.
+  void startSpillMerge();
+
   // Invoked to record the spilling stats in operator stats after processing all
   // the inputs.
   void recordSpillStats();
@@ -90,6 +102,9 @@ class OrderBy : public Operator {
   // If it is zero, then there is no such limit.
   const uint64_t spillMemoryThreshold_;
 
+  // Maximum number of threads for sorting the rows without spilling.
+  const int32_t sortThreads_;
+
   // The map from column channel in 'output_' to the corresponding one stored in
   // 'data_'. The column channel might be reordered to ensure the sorting key
   // columns stored first in 'data_'.
@@ -24,6 +24,9 @@ void registerPartitionFunctionSerDe() {
 
   registry.Register(
       "HashPartitionFunctionSpec", HashPartitionFunctionSpec::deserialize);
+  registry.Register(
+      "SkewedHashPartitionFunctionSpec",
+      SkewedHashPartitionFunctionSpec::deserialize);
   registry.Register(
       "RoundRobinPartitionFunctionSpec",
       RoundRobinPartitionFunctionSpec::deserialize);
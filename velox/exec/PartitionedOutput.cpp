@@ -38,14 +38,16 @@ BlockingReason Destination::advance(
     return flush(bufferManager, bufferReleaseFn, future);
   }
   auto firstRow = row_;
+  // Rows, not ranges, since runs of consecutive rows are single ranges.
+  int64_t numRows = 0;
   for (; row_ < rows_.size(); ++row_) {
     // TODO: add support for serializing partial ranges if the full range is too
     // big.
     for (vector_size_t i = 0; i < rows_[row_].size; i++) {
       bytesInCurrent_ += sizes[rows_[row_].begin + i];
     }
-    if (bytesInCurrent_ >= adjustedMaxBytes ||
-        row_ - firstRow >= targetNumRows_) {
+    numRows += rows_[row_].size;
+    if (bytesInCurrent_ >= adjustedMaxBytes || numRows > targetNumRows_) {
       serialize(output, firstRow, row_ + 1);
       if (row_ == rows_.size() - 1) {
         *atEnd = true;
@@ -70,7 +72,7 @@ void Destination::serialize(
     for (vector_size_t i = begin; i < end; i++) {
       numRows += rows_[i].size;
     }
-    current_->createStreamTree(rowType, numRows);
+    current_->createStreamTree(rowType, numRows, serdeOptions_);
   }
   current_->append(output, folly::Range(&rows_[begin], end - begin));
 }
@@ -130,7 +132,9 @@ PartitionedOutput::PartitionedOutput(
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      serdeOptions_(
+          exchangeSerdeOptions(ctx->task->queryCtx()->queryConfig())) {
   if (numDestinations_ == 1 || planNode->isBroadcast()) {
     VELOX_CHECK(keyChannels_.empty());
     VELOX_CHECK_NULL(partitionFunction_);
@@ -162,7 +166,8 @@ void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
-      destinations_.push_back(std::make_unique<Destination>(taskId, i, pool()));
+      destinations_.push_back(std::make_unique<Destination>(
+          taskId, i, pool(), serdeOptions_.get()));
     }
   }
 }
@@ -219,6 +224,8 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
     destinations_[0]->addRows(IndexRange{0, numInput});
   } else {
     partitionFunction_->partition(*input_, partitions_);
+    const auto numReplicas =
+        std::min<int32_t>(partitionFunction_->numReplicas(), numDestinations_);
     if (replicateNullsAndAny_) {
       collectNullRows();
 
@@ -237,17 +244,49 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
             destination->addRow(i);
           }
         } else {
-          destinations_[partitions_[i]]->addRow(i);
+          addRow(i, numReplicas);
         }
       }
+    } else if (numReplicas == 1) {
+      addRowsByPartition(numInput);
     } else {
       for (vector_size_t i = 0; i < numInput; ++i) {
-        destinations_[partitions_[i]]->addRow(i);
+        addRow(i, numReplicas);
       }
     }
   }
 }
 
+void PartitionedOutput::addRowsByPartition(vector_size_t numInput) {
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    ++partitionOffsets_[partitions_[i] + 1];
+  }
+  for (auto i = 1; i <= numDestinations_; ++i) {
+    partitionOffsets_[i] += partitionOffsets_[i - 1];
+  }
+  // Each offset moves from the start to the end of the rows of its partition.
+  partitionRows_.resize(numInput);
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    partitionRows_[partitionOffsets_[partitions_[i]]++] = i;
+  }
+  vector_size_t begin = 0;
+  for (auto i = 0; i < numDestinations_; ++i) {
+    const auto end = partitionOffsets_[i];
+    if (end > begin) {
+      destinations_[i]->addRows(folly::Range<const vector_size_t*>(
+          partitionRows_.data() + begin, end - begin));
+    }
+    begin = end;
+  }
+}
+
+void PartitionedOutput::addRow(vector_size_t row, int32_t numReplicas) {
+  for (auto i = 0; i < numReplicas; ++i) {
+    destinations_[(partitions_[row] + i) % numDestinations_]->addRow(row);
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -27,8 +27,12 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* FOLLY_NONNULL pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* FOLLY_NONNULL pool,
+      const VectorSerde::Options* FOLLY_NULLABLE serdeOptions = nullptr)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        serdeOptions_(serdeOptions) {
     setTargetSizePct();
   }
 
@@ -46,6 +50,18 @@ class Destination {
     rows_.push_back(rows);
   }
 
+  // Adds 'rows', which are in ascending order. Runs of consecutive rows are
+  // added as single ranges.
+  void addRows(folly::Range<const vector_size_t*> rows) {
+    for (auto row : rows) {
+      if (!rows_.empty() && rows_.back().begin + rows_.back().size == row) {
+        ++rows_.back().size;
+      } else {
+        rows_.push_back(IndexRange{row, 1});
+      }
+    }
+  }
+
   BlockingReason advance(
       uint64_t maxBytes,
       const std::vector<vector_size_t>& sizes,
@@ -92,6 +108,7 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* FOLLY_NONNULL const pool_;
+  const VectorSerde::Options* FOLLY_NULLABLE const serdeOptions_;
   uint64_t bytesInCurrent_{0};
   std::vector<IndexRange> rows_;
 
@@ -173,6 +190,14 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  /// Adds 'row' to the 'numReplicas' destinations that follow its partition,
+  /// starting with the partition itself.
+  void addRow(vector_size_t row, int32_t numReplicas);
+
+  /// Adds the rows of each destination in one pass per destination. The rows
+  /// are first grouped by partition with a counting sort of 'partitions_'.
+  void addRowsByPartition(vector_size_t numInput);
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -182,6 +207,7 @@ class PartitionedOutput : public Operator {
   const std::weak_ptr<exec::PartitionedOutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -200,6 +226,10 @@ class PartitionedOutput : public Operator {
   SelectivityVector rows_;
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
+  // End of the rows of each partition in 'partitionRows_' after
+  // addRowsByPartition().
+  std::vector<vector_size_t> partitionOffsets_;
+  std::vector<vector_size_t> partitionRows_;
   std::vector<DecodedVector> decodedVectors_;
 };
 
@@ -345,6 +345,13 @@ class PartitionedOutputBufferManager {
 
   void removeTask(const std::string& taskId);
 
+  // Returns true if 'taskId' runs in this process and has its output buffers
+  // here, so that its consumers in this process can read the buffers
+  // directly.
+  bool hasTask(const std::string& taskId) {
+    return getBufferIfExists(taskId) != nullptr;
+  }
+
   static std::weak_ptr<PartitionedOutputBufferManager> getInstance();
 
   uint64_t numBuffers() const;
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/PlanNodeStats.h"
+
+#include <algorithm>
+
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/exec/TaskStats.h"
 
@@ -60,6 +63,10 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
     }
   }
 
+  for (const auto& [name, exprStats] : stats.expressionStats) {
+    expressionStats[name].add(exprStats);
+  }
+
   // Populating number of drivers for plan nodes with multiple operators is not
   // useful. Each operator could have been executed in different pipelines with
   // different number of drivers.
@@ -154,6 +161,13 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       }
       stat["customStats"] = cs;
 
+      folly::dynamic es = folly::dynamic::object;
+      for (const auto& [name, exprStats] :
+           operatorStat.second->expressionStats) {
+        es[name] = exprStats.toString();
+      }
+      stat["expressionStats"] = es;
+
       jsonStats.push_back(stat);
     }
   }
@@ -185,6 +199,91 @@ void printCustomStats(
     metric.printMetric(stream);
   }
 }
+
+// Prints one line per function with CPU time, rows, rows skipped because of
+// null or failed inputs and batches evaluated on peeled inputs. The most
+// expensive functions come first.
+void printExpressionStats(
+    const std::unordered_map<std::string, ExprStats>& stats,
+    const std::string& indentation,
+    std::stringstream& stream) {
+  std::vector<std::pair<std::string_view, const ExprStats*>> orderedStats;
+  orderedStats.reserve(stats.size());
+  for (const auto& [name, exprStats] : stats) {
+    orderedStats.emplace_back(name, &exprStats);
+  }
+  std::sort(
+      orderedStats.begin(),
+      orderedStats.end(),
+      [](const auto& left, const auto& right) {
+        if (left.second->timing.cpuNanos != right.second->timing.cpuNanos) {
+          return left.second->timing.cpuNanos > right.second->timing.cpuNanos;
+        }
+        return left.first < right.first;
+      });
+
+  for (const auto& [name, exprStats] : orderedStats) {
+    stream << std::endl;
+    stream << indentation << "expr " << name
+           << ": Cpu time: " << succinctNanos(exprStats->timing.cpuNanos)
+           << ", Rows: " << exprStats->numProcessedRows
+           << ", Batches: " << exprStats->numProcessedVectors
+           << ", Null rows: " << exprStats->numNullRows
+           << ", Peeled batches: " << exprStats->numPeeledVectors;
+  }
+}
+
+// Summary of the memory timeline events of the operators of a plan node.
+struct MemoryTimelineSummary {
+  int64_t peakReservation{0};
+  uint64_t peakReservationTimeMs{0};
+  int32_t numSpills{0};
+  int64_t spillReclaimedBytes{0};
+  int32_t numArbitrationRequests{0};
+};
+
+std::unordered_map<core::PlanNodeId, MemoryTimelineSummary>
+summarizeMemoryTimeline(const TaskStats& taskStats) {
+  std::unordered_map<core::PlanNodeId, MemoryTimelineSummary> summaries;
+  for (const auto& event : taskStats.memoryTimeline) {
+    if (event.pipelineId < 0 ||
+        event.pipelineId >= taskStats.pipelineStats.size()) {
+      continue;
+    }
+    const auto& operatorStats =
+        taskStats.pipelineStats[event.pipelineId].operatorStats;
+    if (event.operatorId < 0 || event.operatorId >= operatorStats.size()) {
+      continue;
+    }
+    auto& summary = summaries[operatorStats[event.operatorId].planNodeId];
+    switch (event.kind) {
+      case MemoryTimelineEvent::Kind::kReservation:
+        if (event.bytes > summary.peakReservation) {
+          summary.peakReservation = event.bytes;
+          summary.peakReservationTimeMs = event.timeMs;
+        }
+        break;
+      case MemoryTimelineEvent::Kind::kSpillStart:
+        ++summary.numSpills;
+        break;
+      case MemoryTimelineEvent::Kind::kSpillEnd:
+        summary.spillReclaimedBytes += event.bytes;
+        break;
+      case MemoryTimelineEvent::Kind::kArbitrationRequest:
+        ++summary.numArbitrationRequests;
+        break;
+      default:
+        break;
+    }
+  }
+  return summaries;
+}
+
+uint64_t timeSinceStartMs(const TaskStats& taskStats, uint64_t timeMs) {
+  return timeMs > taskStats.executionStartTimeMs
+      ? timeMs - taskStats.executionStartTimeMs
+      : 0;
+}
 } // namespace
 
 std::string printPlanWithStats(
@@ -193,8 +292,9 @@ std::string printPlanWithStats(
     bool includeCustomStats) {
   auto planStats = toPlanStats(taskStats);
   auto leafPlanNodes = plan.leafPlanNodeIds();
+  auto memorySummaries = summarizeMemoryTimeline(taskStats);
 
-  return plan.toString(
+  auto result = plan.toString(
       true,
       true,
       [&](const auto& planNodeId, const auto& indentation, auto& stream) {
@@ -217,13 +317,48 @@ std::string printPlanWithStats(
             if (includeCustomStats) {
               printCustomStats(
                   entry.second->customStats, indentation + "   ", stream);
+              printExpressionStats(
+                  entry.second->expressionStats, indentation + "   ", stream);
             }
           }
         } else {
           if (includeCustomStats) {
             printCustomStats(stats.customStats, indentation + "   ", stream);
+            printExpressionStats(
+                stats.expressionStats, indentation + "   ", stream);
           }
         }
+
+        auto memorySummary = memorySummaries.find(planNodeId);
+        if (memorySummary != memorySummaries.end()) {
+          const auto& summary = memorySummary->second;
+          stream << std::endl;
+          stream << indentation << "Memory timeline: peak reservation "
+                 << succinctBytes(summary.peakReservation) << " at "
+                 << succinctMillis(timeSinceStartMs(
+                        taskStats, summary.peakReservationTimeMs))
+                 << ", Spills: " << summary.numSpills << ", Spill reclaimed: "
+                 << succinctBytes(summary.spillReclaimedBytes)
+                 << ", Arbitration requests: "
+                 << summary.numArbitrationRequests;
+        }
       });
+
+  int64_t peakCacheBytes{-1};
+  uint64_t peakCacheTimeMs{0};
+  for (const auto& event : taskStats.memoryTimeline) {
+    if (event.kind == MemoryTimelineEvent::Kind::kCachePressure &&
+        event.bytes > peakCacheBytes) {
+      peakCacheBytes = event.bytes;
+      peakCacheTimeMs = event.timeMs;
+    }
+  }
+  if (peakCacheBytes >= 0) {
+    result += fmt::format(
+        "Cache: peak {} at {}\n",
+        succinctBytes(peakCacheBytes),
+        succinctMillis(timeSinceStartMs(taskStats, peakCacheTimeMs)));
+  }
+  return result;
 }
 } // namespace facebook::velox::exec
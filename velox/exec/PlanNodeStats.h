@@ -90,6 +90,10 @@ struct PlanNodeStats {
   /// Operator-specific counters.
   std::unordered_map<std::string, RuntimeMetric> customStats;
 
+  /// Stats of the expressions evaluated by the operators, by function name.
+  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
+  std::unordered_map<std::string, ExprStats> expressionStats;
+
   /// Breakdown of stats by operator type.
   std::unordered_map<std::string, std::unique_ptr<PlanNodeStats>> operatorStats;
 
@@ -138,7 +142,8 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats);
 ///
 /// Note that input row counts and sizes are printed only for leaf plan nodes.
 ///
-/// @param includeCustomStats If true, prints operator-specific counters.
+/// @param includeCustomStats If true, prints operator-specific counters and
+/// the stats of the expressions by function name.
 std::string printPlanWithStats(
     const core::PlanNode& plan,
     const TaskStats& taskStats,
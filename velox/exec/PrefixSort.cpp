@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+#include <folly/lang/Bits.h>
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Returns the number of bytes of a key of 'kind' in the prefix, 0 for
+// strings, which take up to kMaxStringPrefixBytes, and -1 for kinds that are
+// not encoded.
+int32_t encodedWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DATE:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    case TypeKind::TIMESTAMP:
+      return 16;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+template <typename T>
+void writeBigEndian(T value, uint8_t* out) {
+  if constexpr (sizeof(T) > 1) {
+    value = folly::Endian::big(value);
+  }
+  std::memcpy(out, &value, sizeof(T));
+}
+
+// Flips the sign bit so that negative values sort before positive values as
+// unsigned.
+template <typename T>
+void encodeInteger(T value, uint8_t* out) {
+  using U = std::make_unsigned_t<T>;
+  constexpr U kSignBit = U(1) << (sizeof(T) * 8 - 1);
+  writeBigEndian<U>(static_cast<U>(value) ^ kSignBit, out);
+}
+
+// Inverts negative values and flips the sign bit of positive values. NaN is
+// larger than all other values and -0.0 equals 0.0, as in
+// RowContainer::compare.
+template <typename T>
+void encodeFloat(T value, uint8_t* out) {
+  using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+  constexpr U kSignBit = U(1) << (sizeof(T) * 8 - 1);
+  if (std::isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  } else if (value == 0) {
+    value = 0;
+  }
+  U bits;
+  std::memcpy(&bits, &value, sizeof(T));
+  writeBigEndian<U>(bits & kSignBit ? ~bits : bits ^ kSignBit, out);
+}
+
+template <typename T>
+T valueAt(const char* row, RowColumn column) {
+  return *reinterpret_cast<const T*>(row + column.offset());
+}
+
+// Runs 'task' for 0 to 'numTasks' - 1 on 'executor' and waits for all tasks.
+// A task that has not started by the time it is waited for runs on the caller
+// thread. Rethrows the last error after all tasks are done, since the tasks
+// reference the caller's stack.
+void runParallel(
+    folly::Executor* executor,
+    int32_t numTasks,
+    const std::function<void(int32_t)>& task) {
+  std::vector<std::shared_ptr<AsyncSource<bool>>> items;
+  for (auto i = 0; i < numTasks; ++i) {
+    items.push_back(std::make_shared<AsyncSource<bool>>([&task, i]() {
+      task(i);
+      return std::make_unique<bool>(true);
+    }));
+    executor->add([item = items.back()]() { item->prepare(); });
+  }
+  std::exception_ptr error;
+  for (auto& item : items) {
+    try {
+      item->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Stable sorts 'items' with 'less'. With an 'executor', sorts up to
+// 'numThreads' runs of at least PrefixSort::kMinRowsPerThread items in
+// parallel and merges adjacent pairs of runs until one run is left.
+template <typename T, typename Less>
+void stableSort(
+    std::vector<T>& items,
+    Less less,
+    folly::Executor* executor,
+    int32_t numThreads) {
+  const int32_t numRuns = executor == nullptr
+      ? 1
+      : std::min<int64_t>(
+            numThreads, items.size() / PrefixSort::kMinRowsPerThread);
+  if (numRuns <= 1) {
+    std::stable_sort(items.begin(), items.end(), less);
+    return;
+  }
+  std::vector<size_t> bounds(numRuns + 1);
+  for (auto i = 0; i <= numRuns; ++i) {
+    bounds[i] = items.size() * i / numRuns;
+  }
+  const auto begin = items.begin();
+  runParallel(executor, numRuns, [&](int32_t run) {
+    std::stable_sort(begin + bounds[run], begin + bounds[run + 1], less);
+  });
+  for (auto width = 1; width < numRuns; width *= 2) {
+    const int32_t numMerges = (numRuns + width - 1) / (2 * width);
+    runParallel(executor, numMerges, [&](int32_t merge) {
+      const auto first = merge * 2 * width;
+      std::inplace_merge(
+          begin + bounds[first],
+          begin + bounds[first + width],
+          begin + bounds[std::min(first + 2 * width, numRuns)],
+          less);
+    });
+  }
+}
+} // namespace
+
+PrefixSort::PrefixSort(
+    RowContainer* data,
+    std::vector<column_index_t> keyColumns,
+    std::vector<CompareFlags> keyFlags)
+    : data_(data),
+      keyColumns_(std::move(keyColumns)),
+      keyFlags_(std::move(keyFlags)) {
+  VELOX_CHECK_EQ(keyColumns_.size(), keyFlags_.size());
+  int32_t offset = 0;
+  for (auto i = 0; i < keyColumns_.size(); ++i) {
+    const auto kind = data_->columnTypes()[keyColumns_[i]]->kind();
+    const auto width = encodedWidth(kind);
+    const auto column = data_->columnAt(keyColumns_[i]);
+    if (width == 0) {
+      // A string is encoded up to the prefix size and is never complete.
+      const auto numBytes =
+          std::min(kMaxPrefixBytes - offset - 1, kMaxStringPrefixBytes);
+      if (numBytes > 0) {
+        encodings_.push_back({column, kind, keyFlags_[i], offset, numBytes});
+        offset += 1 + numBytes;
+      }
+      break;
+    }
+    if (width < 0 || offset + 1 + width > kMaxPrefixBytes) {
+      break;
+    }
+    encodings_.push_back({column, kind, keyFlags_[i], offset, width});
+    offset += 1 + width;
+    ++numCompleteKeys_;
+  }
+  prefixBytes_ = bits::roundUp(offset, sizeof(uint64_t));
+}
+
+void PrefixSort::encode(const char* row, uint8_t* prefix) const {
+  std::memset(prefix, 0, prefixBytes_);
+  for (const auto& key : encodings_) {
+    auto* out = prefix + key.offset;
+    const bool isNull = RowContainer::isNullAt(
+        row, key.column.nullByte(), key.column.nullMask());
+    out[0] = isNull == key.flags.nullsFirst ? 0 : 1;
+    if (isNull) {
+      continue;
+    }
+    auto* value = out + 1;
+    switch (key.kind) {
+      case TypeKind::BOOLEAN:
+        value[0] = valueAt<bool>(row, key.column);
+        break;
+      case TypeKind::TINYINT:
+        encodeInteger(valueAt<int8_t>(row, key.column), value);
+        break;
+      case TypeKind::SMALLINT:
+        encodeInteger(valueAt<int16_t>(row, key.column), value);
+        break;
+      case TypeKind::INTEGER:
+        encodeInteger(valueAt<int32_t>(row, key.column), value);
+        break;
+      case TypeKind::BIGINT:
+        encodeInteger(valueAt<int64_t>(row, key.column), value);
+        break;
+      case TypeKind::REAL:
+        encodeFloat(valueAt<float>(row, key.column), value);
+        break;
+      case TypeKind::DOUBLE:
+        encodeFloat(valueAt<double>(row, key.column), value);
+        break;
+      case TypeKind::DATE:
+        encodeInteger(valueAt<Date>(row, key.column).days(), value);
+        break;
+      case TypeKind::TIMESTAMP: {
+        const auto timestamp = valueAt<Timestamp>(row, key.column);
+        encodeInteger(timestamp.getSeconds(), value);
+        writeBigEndian(timestamp.getNanos(), value + sizeof(int64_t));
+        break;
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        // Shorter strings are padded with zeros. Strings that are equal in
+        // the prefix are compared in full.
+        auto string = valueAt<StringView>(row, key.column);
+        std::string storage;
+        if (!string.isInline()) {
+          string = HashStringAllocator::contiguousString(string, storage);
+        }
+        std::memcpy(
+            value,
+            string.data(),
+            std::min<int32_t>(string.size(), key.numBytes));
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+    if (!key.flags.ascending) {
+      for (auto i = 0; i < key.numBytes; ++i) {
+        value[i] = ~value[i];
+      }
+    }
+  }
+}
+
+int32_t
+PrefixSort::compare(const char* left, const char* right, int32_t firstKey) {
+  for (auto i = firstKey; i < keyColumns_.size(); ++i) {
+    if (auto result =
+            data_->compare(left, right, keyColumns_[i], keyFlags_[i])) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+template <int32_t kNumWords>
+void PrefixSort::sortWithPrefix(
+    std::vector<char*>& rows,
+    folly::Executor* executor,
+    int32_t numThreads) {
+  struct Entry {
+    uint8_t prefix[kNumWords * sizeof(uint64_t)];
+    char* row;
+  };
+  std::vector<Entry> entries(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    encode(rows[i], entries[i].prefix);
+    entries[i].row = rows[i];
+  }
+  const bool complete = numCompleteKeys_ == keyColumns_.size();
+  stableSort(
+      entries,
+      [&](const Entry& left, const Entry& right) {
+        if (auto result =
+                std::memcmp(left.prefix, right.prefix, sizeof(left.prefix))) {
+          return result < 0;
+        }
+        return !complete && compare(left.row, right.row, numCompleteKeys_) < 0;
+      },
+      executor,
+      numThreads);
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+void PrefixSort::sort(
+    std::vector<char*>& rows,
+    folly::Executor* executor,
+    int32_t numThreads) {
+  if (rows.size() >= kMinRows) {
+    switch (prefixBytes_) {
+      case 8:
+        return sortWithPrefix<1>(rows, executor, numThreads);
+      case 16:
+        return sortWithPrefix<2>(rows, executor, numThreads);
+      case 24:
+        return sortWithPrefix<3>(rows, executor, numThreads);
+      case 32:
+        return sortWithPrefix<4>(rows, executor, numThreads);
+      default:
+        VELOX_CHECK_EQ(prefixBytes_, 0);
+        break;
+    }
+  }
+  stableSort(
+      rows,
+      [&](const char* left, const char* right) {
+        return compare(left, right) < 0;
+      },
+      executor,
+      numThreads);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/Executor.h>
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts the rows of a RowContainer on a binary prefix of their sort keys.
+/// The leading keys of each row are encoded into a fixed size byte string,
+/// the prefix, so that comparing the prefixes with memcmp orders the rows
+/// like comparing the keys with RowContainer::compare. The encoding covers
+/// the null order, descending keys and the leading bytes of strings. The
+/// prefixes are sorted together with the row pointers, so that most
+/// comparisons do not touch the rows. Rows with equal prefixes are compared
+/// with RowContainer::compare from the first key the prefix does not cover
+/// fully.
+class PrefixSort {
+ public:
+  /// Maximum size of the prefix of a row.
+  static constexpr int32_t kMaxPrefixBytes = 32;
+
+  /// Maximum number of leading bytes of a string key in the prefix.
+  static constexpr int32_t kMaxStringPrefixBytes = 15;
+
+  /// Below this many rows, the rows are sorted without prefixes.
+  static constexpr int32_t kMinRows = 64;
+
+  /// Minimum number of rows sorted by each thread of a parallel sort.
+  static constexpr int32_t kMinRowsPerThread = 10'000;
+
+  /// 'keyColumns' are the columns of the sort keys in 'data' in the order of
+  /// significance. 'keyFlags' are the respective compare flags.
+  PrefixSort(
+      RowContainer* data,
+      std::vector<column_index_t> keyColumns,
+      std::vector<CompareFlags> keyFlags);
+
+  /// Sorts 'rows' of the container. Keeps the order of equal rows. If
+  /// 'executor' is set, sorts up to 'numThreads' runs of the rows on
+  /// 'executor' and merges them. The caller thread takes part in the work, so
+  /// that the sort completes even if 'executor' has no free threads.
+  void sort(
+      std::vector<char*>& rows,
+      folly::Executor* executor = nullptr,
+      int32_t numThreads = 1);
+
+  /// Compares 'left' and 'right' on the keys starting at 'firstKey'. Returns
+  /// 0 for equal, < 0 for left < right, > 0 otherwise.
+  int32_t compare(const char* left, const char* right, int32_t firstKey = 0);
+
+  /// Size of the prefix of a row. 0 if the first key cannot be encoded, e.g.
+  /// if it is a complex type.
+  int32_t prefixBytes() const {
+    return prefixBytes_;
+  }
+
+  /// Number of leading keys the prefix covers fully. Rows with equal prefixes
+  /// are equal on these keys.
+  int32_t numCompleteKeys() const {
+    return numCompleteKeys_;
+  }
+
+  /// Writes the prefixBytes() bytes of the prefix of 'row' to 'prefix'.
+  void encode(const char* row, uint8_t* prefix) const;
+
+ private:
+  // Position of a key in the prefix.
+  struct KeyEncoding {
+    RowColumn column;
+    TypeKind kind;
+    CompareFlags flags;
+    // Offset of the null byte of the key in the prefix. The value follows.
+    int32_t offset;
+    // Number of bytes of the value.
+    int32_t numBytes;
+  };
+
+  template <int32_t kNumWords>
+  void sortWithPrefix(
+      std::vector<char*>& rows,
+      folly::Executor* executor,
+      int32_t numThreads);
+
+  RowContainer* const data_;
+  const std::vector<column_index_t> keyColumns_;
+  const std::vector<CompareFlags> keyFlags_;
+  std::vector<KeyEncoding> encodings_;
+  int32_t prefixBytes_{0};
+  int32_t numCompleteKeys_{0};
+};
+
+} // namespace facebook::velox::exec
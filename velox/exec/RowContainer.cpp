@@ -108,7 +108,8 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    const RowSerde& serde)
+    const RowSerde& serde,
+    int32_t normalizedKeySize)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       accumulators_(accumulators),
@@ -225,7 +226,7 @@ RowContainer::RowContainer(
     }
   }
   originalNormalizedKeySize_ = hasNormalizedKeys_
-      ? bits::roundUp(sizeof(normalized_key_t), alignment_)
+      ? bits::roundUp(normalizedKeySize, alignment_)
       : 0;
   normalizedKeySize_ = originalNormalizedKeySize_;
   for (auto i = 0; i < offsets_.size(); ++i) {
@@ -432,6 +433,120 @@ void RowContainer::storeComplexType(
       StringView(reinterpret_cast<char*>(position.position), stream.size());
 }
 
+namespace {
+// True if a column of 'kind' is stored as a StringView that may point to
+// memory of the HashStringAllocator.
+bool isVariableWidth(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::ROW:
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+      return true;
+    default:
+      return false;
+  }
+}
+} // namespace
+
+int32_t RowContainer::serializedRowSize(const char* row) const {
+  int32_t size = fixedRowSize_;
+  for (auto i = 0; i < types_.size(); ++i) {
+    if (!isVariableWidth(typeKinds_[i])) {
+      continue;
+    }
+    const auto column = rowColumns_[i];
+    if (isNullAt(row, column.nullByte(), column.nullMask())) {
+      continue;
+    }
+    const auto value = valueAt<StringView>(row, column.offset());
+    if (!value.isInline()) {
+      size += value.size();
+    }
+  }
+  return size;
+}
+
+void RowContainer::extractSerializedRows(
+    folly::Range<char**> rows,
+    const VectorPtr& result) {
+  for (const auto& accumulator : accumulators_) {
+    VELOX_CHECK(
+        accumulator.isFixedSize() && !accumulator.usesExternalMemory(),
+        "Cannot serialize rows with variable width accumulators");
+  }
+  result->resize(rows.size());
+  auto* flatResult = result->asFlatVector<StringView>();
+  VELOX_CHECK_NOT_NULL(flatResult);
+  size_t totalBytes = 0;
+  for (const auto* row : rows) {
+    totalBytes += serializedRowSize(row);
+  }
+  auto* buffer = flatResult->getRawStringBufferWithSpace(totalBytes);
+  ByteStream stream;
+  for (auto i = 0; i < rows.size(); ++i) {
+    const char* row = rows[i];
+    char* start = buffer;
+    memcpy(buffer, row, fixedRowSize_);
+    buffer += fixedRowSize_;
+    for (auto column = 0; column < types_.size(); ++column) {
+      if (!isVariableWidth(typeKinds_[column])) {
+        continue;
+      }
+      const auto rowColumn = rowColumns_[column];
+      if (isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+        continue;
+      }
+      const auto value = valueAt<StringView>(row, rowColumn.offset());
+      if (value.isInline()) {
+        continue;
+      }
+      prepareRead(row, rowColumn.offset(), stream);
+      stream.readBytes(buffer, value.size());
+      buffer += value.size();
+    }
+    flatResult->setNoCopy(i, StringView(start, buffer - start));
+  }
+}
+
+void RowContainer::storeSerializedRow(
+    const FlatVector<StringView>& vector,
+    vector_size_t index,
+    char* row) {
+  VELOX_CHECK(!vector.isNullAt(index));
+  const auto serialized = vector.valueAt(index);
+  const char* data = serialized.data();
+  memcpy(row, data, fixedRowSize_);
+  data += fixedRowSize_;
+  if (nextOffset_) {
+    *reinterpret_cast<char**>(row + nextOffset_) = nullptr;
+  }
+  if (rowSizeOffset_) {
+    variableRowSize(row) = 0;
+  }
+  bits::clearBit(row, freeFlagOffset_);
+  for (auto column = 0; column < types_.size(); ++column) {
+    if (!isVariableWidth(typeKinds_[column])) {
+      continue;
+    }
+    const auto rowColumn = rowColumns_[column];
+    if (isNullAt(row, rowColumn.nullByte(), rowColumn.nullMask())) {
+      continue;
+    }
+    auto& value = valueAt<StringView>(row, rowColumn.offset());
+    if (value.isInline()) {
+      continue;
+    }
+    const auto size = value.size();
+    value = StringView(data, size);
+    data += size;
+    RowSizeTracker tracker(row[rowSizeOffset_], stringAllocator_);
+    stringAllocator_.copyMultipart(row, rowColumn.offset());
+  }
+  VELOX_CHECK_EQ(data - serialized.data(), serialized.size());
+}
+
 //   static
 int32_t RowContainer::compareStringAsc(
     StringView left,
@@ -456,6 +571,19 @@ int RowContainer::compareComplexType(
   return serde_.compare(stream, decoded, index, flags);
 }
 
+bool RowContainer::equalsString(StringView stored, StringView other) {
+  if (stored.isInline() || stored.size() != other.size()) {
+    return stored == other;
+  }
+  // A non-inline 'stored' may be in several pieces but its first piece has
+  // at least the 4 prefix bytes.
+  if (memcmp(stored.data(), other.data(), StringView::kPrefixSize) != 0) {
+    return false;
+  }
+  std::string storage;
+  return HashStringAllocator::contiguousString(stored, storage) == other;
+}
+
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
   std::string leftStorage;
   std::string rightStorage;
@@ -827,8 +955,19 @@ RowComparator::RowComparator(
 }
 
 bool RowComparator::operator()(const char* lhs, const char* rhs) {
+  return compare(lhs, rhs) < 0;
+}
+
+bool RowComparator::operator()(
+    const std::vector<DecodedVector>& decodedVectors,
+    vector_size_t index,
+    const char* rhs) {
+  return compare(decodedVectors, index, rhs) < 0;
+}
+
+int32_t RowComparator::compare(const char* lhs, const char* rhs) {
   if (lhs == rhs) {
-    return false;
+    return 0;
   }
   for (auto& key : keyInfo_) {
     if (auto result = rowContainer_->compare(
@@ -836,13 +975,13 @@ bool RowComparator::operator()(const char* lhs, const char* rhs) {
             rhs,
             key.first,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result < 0;
+      return result;
     }
   }
-  return false;
+  return 0;
 }
 
-bool RowComparator::operator()(
+int32_t RowComparator::compare(
     const std::vector<DecodedVector>& decodedVectors,
     vector_size_t index,
     const char* rhs) {
@@ -853,9 +992,9 @@ bool RowComparator::operator()(
             decodedVectors[key.first],
             index,
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result > 0;
+      return -result;
     }
   }
-  return false;
+  return 0;
 }
 } // namespace facebook::velox::exec
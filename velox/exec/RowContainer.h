@@ -205,7 +205,9 @@ class RowContainer {
   // below each row for a normalized key that collapses all parts
   // into one word for faster comparison. The bulk allocation is done
   // from 'allocator'.  'serde_' is used for serializing complex
-  // type values into the container.
+  // type values into the container. 'normalizedKeySize' is the number
+  // of bytes reserved below each row if 'hasNormalizedKey' is true. This
+  // is more than a word if the keys are stored packed below the row.
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -216,7 +218,8 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* FOLLY_NONNULL pool,
-      const RowSerde& serde);
+      const RowSerde& serde,
+      int32_t normalizedKeySize = sizeof(normalized_key_t));
 
   // Allocates a new row and initializes possible aggregates to null.
   char* FOLLY_NONNULL newRow();
@@ -266,6 +269,30 @@ class RowContainer {
       char* FOLLY_NONNULL row,
       int32_t columnIndex);
 
+  /// Returns the size of the row-native serialized form of 'row' made by
+  /// extractSerializedRows().
+  int32_t serializedRowSize(const char* FOLLY_NONNULL row) const;
+
+  /// Copies 'rows' into the VARBINARY vector 'result' in a row-native form:
+  /// the fixed width part of each row followed by the variable width values
+  /// that are not inlined in it, in column order. The sizes of these values
+  /// are in the StringViews of the fixed width part. Resizes 'result' to
+  /// 'rows.size()'. The rows can be restored into a container with the same
+  /// layout by storeSerializedRow(). Accumulators must have a fixed size and
+  /// no external memory.
+  void extractSerializedRows(
+      folly::Range<char**> rows,
+      const VectorPtr& result);
+
+  /// Restores the 'index'th row of 'vector', made by extractSerializedRows(),
+  /// into 'row', a row from newRow(). Copies the fixed width part and then the
+  /// variable width values into 'stringAllocator_'. Does not set a normalized
+  /// key or the next row pointer of a hash join build side.
+  void storeSerializedRow(
+      const FlatVector<StringView>& vector,
+      vector_size_t index,
+      char* FOLLY_NONNULL row);
+
   HashStringAllocator& stringAllocator() {
     return stringAllocator_;
   }
@@ -586,6 +613,11 @@ class RowContainer {
         stringAllocator_.freeSpace());
   }
 
+  // Returns the number of erased rows that newRow() can reuse.
+  uint64_t numFreeRows() const {
+    return numFreeRows_;
+  }
+
   // Returns the average size of rows in bytes stored in this container.
   std::optional<int64_t> estimateRowSize() const;
 
@@ -882,8 +914,8 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      return equalsString(
+          valueAt<StringView>(row, offset), decoded.valueAt<StringView>(index));
     }
     return decoded.valueAt<T>(index) == valueAt<T>(row, offset);
   }
@@ -901,8 +933,8 @@ class RowContainer {
       return compareComplexType(row, offset, decoded, index) == 0;
     }
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
-      return compareStringAsc(
-                 valueAt<StringView>(row, offset), decoded, index) == 0;
+      return equalsString(
+          valueAt<StringView>(row, offset), decoded.valueAt<StringView>(index));
     }
 
     return decoded.valueAt<T>(index) == valueAt<T>(row, offset);
@@ -1057,6 +1089,11 @@ class RowContainer {
 
   static int32_t compareStringAsc(StringView left, StringView right);
 
+  // Returns true if 'stored', a string in a row, equals 'other'. Inline
+  // strings are compared as 2 words and strings that differ in size or in
+  // the first 4 bytes are rejected without making 'stored' contiguous.
+  static bool equalsString(StringView stored, StringView other);
+
   int32_t compareComplexType(
       const char* FOLLY_NONNULL row,
       int32_t offset,
@@ -1366,6 +1403,16 @@ class RowComparator {
       vector_size_t index,
       const char* rhs);
 
+  /// Returns a negative value if lhs < rhs, 0 if the keys of lhs and rhs are
+  /// equal and a positive value otherwise.
+  int32_t compare(const char* lhs, const char* rhs);
+
+  /// Compares decodeVectors[index] with rhs like compare() above.
+  int32_t compare(
+      const std::vector<DecodedVector>& decodedVectors,
+      vector_size_t index,
+      const char* rhs);
+
  private:
   std::vector<std::pair<column_index_t, core::SortOrder>> keyInfo_;
   RowContainer* rowContainer_;
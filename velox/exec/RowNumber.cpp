@@ -15,6 +15,8 @@
  */
 #include "velox/exec/RowNumber.h"
 
+#include <numeric>
+
 namespace facebook::velox::exec {
 
 RowNumber::RowNumber(
@@ -26,9 +28,13 @@ RowNumber::RowNumber(
           rowNumberNode->outputType(),
           operatorId,
           rowNumberNode->id(),
-          "RowNumber"),
-      limit_{rowNumberNode->limit()} {
-  const auto& inputType = rowNumberNode->sources()[0]->outputType();
+          "RowNumber",
+          rowNumberNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      limit_{rowNumberNode->limit()},
+      inputType_{rowNumberNode->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
   const auto& keys = rowNumberNode->partitionKeys();
   const auto numKeys = keys.size();
 
@@ -45,6 +51,19 @@ RowNumber::RowNumber(
 
     const auto numRowsColumn = table_->rows()->columnAt(numKeys);
     numRowsOffset_ = numRowsColumn.offset();
+
+    if (canSpill()) {
+      std::vector<std::string> names;
+      std::vector<TypePtr> types;
+      for (const auto& hasher : table_->hashers()) {
+        keyChannels_.push_back(hasher->channel());
+        names.push_back(inputType->nameOf(hasher->channel()));
+        types.push_back(hasher->type());
+      }
+      names.push_back(outputType_->nameOf(inputType->size()));
+      types.push_back(BIGINT());
+      tableSpillType_ = ROW(std::move(names), std::move(types));
+    }
   }
 
   identityProjections_.reserve(inputType->size());
@@ -57,9 +76,24 @@ RowNumber::RowNumber(
 }
 
 void RowNumber::addInput(RowVectorPtr input) {
+  if (table_ != nullptr) {
+    ensureInputFits(input);
+    if (inputSpiller_ != nullptr) {
+      inputSpillHashFunction_->partition(*input, spillPartitions_);
+      inputSpiller_->spillPartitioned(input, spillPartitions_);
+      return;
+    }
+  }
+  processInput(std::move(input));
+}
+
+void RowNumber::processInput(RowVectorPtr input) {
   const auto numInput = input->size();
 
   if (table_) {
+    // Prevents the memory arbitrator to reclaim memory from this operator
+    // while 'lookup_' references the hash table rows.
+    NonReclaimableSection guard(this);
     SelectivityVector rows(numInput);
     table_->prepareForProbe(*lookup_, input, rows, false);
     table_->groupProbe(*lookup_);
@@ -73,6 +107,216 @@ void RowNumber::addInput(RowVectorPtr input) {
   input_ = std::move(input);
 }
 
+void RowNumber::noMoreInput() {
+  Operator::noMoreInput();
+  if (inputSpiller_ != nullptr) {
+    tableSpiller_->finishSpill(tableSpillPartitionSet_);
+    inputSpiller_->finishSpill(inputSpillPartitionSet_);
+    recordSpillStats();
+    restoreNextSpillPartition();
+  }
+}
+
+void RowNumber::ensureInputFits(const RowVectorPtr& input) {
+  if (!canSpill() || inputSpiller_ != nullptr) {
+    return;
+  }
+  const auto numDistinct = table_->numDistinct();
+  if (numDistinct == 0) {
+    // Table is empty. Nothing to spill.
+    return;
+  }
+
+  const auto& spillConfig = spillConfig_.value();
+  // Test-only spill path.
+  if (spillConfig.testSpillPct > 0 &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    spill();
+    return;
+  }
+
+  const auto tableIncrement = table_->hashTableSizeIncrease(input->size());
+  auto* rows = table_->rows();
+  auto [freeRows, outOfLineFreeBytes] = rows->freeSpace();
+  const auto outOfLineBytes =
+      rows->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t flatBytes = input->estimateFlatSize();
+  if (!tableIncrement && freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatBytes)) {
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const auto increment =
+      rows->sizeIncrement(input->size(), outOfLineBytes ? flatBytes : 0) +
+      tableIncrement;
+  // There must be at least 2x the increment in reservation.
+  if (pool()->availableReservation() > 2 * increment) {
+    return;
+  }
+  const auto targetIncrement = std::max<int64_t>(
+      increment * 2,
+      pool()->currentBytes() * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool()->maybeReserve(targetIncrement)) {
+    return;
+  }
+  spill();
+}
+
+void RowNumber::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a row number operator is reclaimable if it hasn't started output
+  // processing, is not under non-reclaimable execution section and has no
+  // pending input which references the hash table rows.
+  if (noMoreInput_ || nonReclaimableSection_ || input_ != nullptr) {
+    LOG(WARNING) << "Can't reclaim from row number operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  if (inputSpiller_ == nullptr) {
+    spill();
+  }
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void RowNumber::spill() {
+  VELOX_CHECK(canSpill());
+  VELOX_CHECK_NULL(inputSpiller_);
+  VELOX_CHECK_NULL(input_);
+
+  const auto& spillConfig = spillConfig_.value();
+  auto makeSpiller = [&](const RowTypePtr& type) {
+    auto spiller = std::make_unique<Spiller>(
+        Spiller::Type::kPartitionedInput,
+        type,
+        spillConfig.hashBitRange,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.codecOptions,
+        spillConfig.tiers);
+    SpillPartitionNumSet partitions;
+    for (auto i = 0; i < spillConfig.hashBitRange.numPartitions(); ++i) {
+      partitions.insert(i);
+    }
+    spiller->setPartitionsSpilled(partitions);
+    return spiller;
+  };
+  tableSpiller_ = makeSpiller(tableSpillType_);
+  inputSpiller_ = makeSpiller(inputType_);
+
+  std::vector<column_index_t> tableKeyChannels(keyChannels_.size());
+  std::iota(tableKeyChannels.begin(), tableKeyChannels.end(), 0);
+  tableSpillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      spillConfig.hashBitRange, tableSpillType_, tableKeyChannels);
+  inputSpillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      spillConfig.hashBitRange, inputType_, keyChannels_);
+
+  // NOTE: disk spilling use the system disk spilling memory pool instead of
+  // the operator memory pool.
+  auto* rows = table_->rows();
+  RowContainerIterator iter;
+  std::vector<char*> spillRows(outputBatchRows(rows->estimateRowSize()));
+  for (;;) {
+    const auto numRows =
+        rows->listRows(&iter, spillRows.size(), spillRows.data());
+    if (numRows == 0) {
+      break;
+    }
+    auto batch = BaseVector::create<RowVector>(
+        tableSpillType_, numRows, &Spiller::spillPool());
+    for (auto i = 0; i < tableSpillType_->size(); ++i) {
+      rows->extractColumn(spillRows.data(), numRows, i, batch->childAt(i));
+    }
+    tableSpillHashFunction_->partition(*batch, spillPartitions_);
+    tableSpiller_->spillPartitioned(batch, spillPartitions_);
+  }
+  table_->clear();
+}
+
+void RowNumber::restoreNextSpillPartition() {
+  VELOX_CHECK_NULL(spillInputReader_);
+  if (inputSpillPartitionSet_.empty()) {
+    return;
+  }
+
+  auto it = inputSpillPartitionSet_.begin();
+  auto tableIt = tableSpillPartitionSet_.find(it->first);
+  if (tableIt != tableSpillPartitionSet_.end()) {
+    auto tableReader = tableIt->second->createReader(spillConfig_->executor);
+    RowVectorPtr data;
+    while (tableReader->nextBatch(data)) {
+      restoreSpilledTable(data);
+    }
+    tableSpillPartitionSet_.erase(tableIt);
+  }
+  spillInputReader_ = it->second->createReader(spillConfig_->executor);
+  inputSpillPartitionSet_.erase(it);
+}
+
+void RowNumber::restoreSpilledTable(const RowVectorPtr& data) {
+  const auto numInput = data->size();
+  const auto numKeys = keyChannels_.size();
+
+  // Make an input shaped vector with the spilled keys at their input channels
+  // for the hash table to probe.
+  std::vector<VectorPtr> children(inputType_->size());
+  for (auto i = 0; i < inputType_->size(); ++i) {
+    children[i] = BaseVector::createNullConstant(
+        inputType_->childAt(i), numInput, pool());
+  }
+  for (auto i = 0; i < numKeys; ++i) {
+    children[keyChannels_[i]] = data->childAt(i);
+  }
+  auto keys = std::make_shared<RowVector>(
+      pool(), inputType_, nullptr, numInput, std::move(children));
+
+  SelectivityVector rows(numInput);
+  table_->prepareForProbe(*lookup_, keys, rows, false);
+  table_->groupProbe(*lookup_);
+
+  DecodedVector numRowsVector(*data->childAt(numKeys));
+  for (auto i = 0; i < numInput; ++i) {
+    setNumRows(lookup_->hits[i], numRowsVector.valueAt<int64_t>(i));
+  }
+}
+
+void RowNumber::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+  VELOX_CHECK_NOT_NULL(spillInputReader_);
+
+  RowVectorPtr input;
+  if (!spillInputReader_->nextBatch(input)) {
+    // Done with the current spill partition.
+    spillInputReader_ = nullptr;
+    table_->clear();
+    restoreNextSpillPartition();
+    return;
+  }
+  processInput(std::move(input));
+}
+
+void RowNumber::recordSpillStats() {
+  VELOX_CHECK_NOT_NULL(inputSpiller_);
+  VELOX_CHECK(noMoreInput_);
+
+  auto spillStats = tableSpiller_->stats();
+  spillStats += inputSpiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
+}
+
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -85,7 +329,13 @@ FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
 
 RowVectorPtr RowNumber::getOutput() {
   if (input_ == nullptr) {
-    return nullptr;
+    if (spillInputReader_ == nullptr) {
+      return nullptr;
+    }
+    addSpillInput();
+    if (input_ == nullptr) {
+      return nullptr;
+    }
   }
 
   if (!table_) {
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
@@ -35,15 +36,48 @@ class RowNumber : public Operator {
     return !noMoreInput_ && !finishedEarly_;
   }
 
+  void noMoreInput() override;
+
   BlockingReason isBlocked(ContinueFuture* /* unused */) override {
     return BlockingReason::kNotBlocked;
   }
 
   bool isFinished() override {
-    return (noMoreInput_ && input_ == nullptr) || finishedEarly_;
+    return (noMoreInput_ && input_ == nullptr &&
+            spillInputReader_ == nullptr) ||
+        finishedEarly_;
   }
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
+  // Adds 'input' to the hash table and keeps it for the next getOutput() call.
+  void processInput(RowVectorPtr input);
+
+  // Spills the hash table if 'input' can't fit in memory. Only used before
+  // spilling is triggered.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the hash table and switches all the partitions to spilling. Any
+  // input received after this is spilled directly and the row numbers are
+  // computed one spill partition at a time after all the input is received.
+  void spill();
+
+  // Restores the row counts of the next spill partition into the hash table
+  // and sets 'spillInputReader_' to read its spilled input.
+  void restoreNextSpillPartition();
+
+  // Inserts the row counts read from the spilled hash table back into the
+  // hash table.
+  void restoreSpilledTable(const RowVectorPtr& data);
+
+  // Reads the next batch of spilled input of the current spill partition into
+  // 'input_'. Moves to the next spill partition if the current one is
+  // exhausted.
+  void addSpillInput();
+
+  void recordSpillStats();
+
   int64_t numRows(char* partition);
 
   void setNumRows(char* partition, int64_t numRows);
@@ -68,5 +102,31 @@ class RowNumber : public Operator {
   /// the input. This happens when there are no partitioning keys and the
   /// operator already received 'limit_' rows.
   bool finishedEarly_{false};
+
+  const RowTypePtr inputType_;
+
+  // Channels of the partition keys in the input.
+  std::vector<column_index_t> keyChannels_;
+
+  // The type of the spilled hash table rows: the partition keys followed by
+  // the number of rows seen so far.
+  RowTypePtr tableSpillType_;
+
+  // Spillers for the hash table rows and the input received after spilling.
+  // Both are created on the first spill and share the hash bit range so that
+  // the same partition of both holds the same partition keys.
+  std::unique_ptr<Spiller> tableSpiller_;
+  std::unique_ptr<Spiller> inputSpiller_;
+  std::unique_ptr<HashPartitionFunction> tableSpillHashFunction_;
+  std::unique_ptr<HashPartitionFunction> inputSpillHashFunction_;
+  std::vector<uint32_t> spillPartitions_;
+
+  SpillPartitionSet tableSpillPartitionSet_;
+  SpillPartitionSet inputSpillPartitionSet_;
+
+  // Reads the spilled input of the spill partition being processed.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  uint64_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
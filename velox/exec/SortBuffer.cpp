@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/SortBuffer.h"
+
+#include <numeric>
+
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
+
+namespace facebook::velox::exec {
+
+SortBuffer::SortBuffer(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& sortColumnIndices,
+    const std::vector<CompareFlags>& sortCompareFlags,
+    uint32_t outputBatchSize,
+    memory::MemoryPool* pool,
+    std::optional<Spiller::Config> spillConfig,
+    uint64_t spillMemoryThreshold)
+    : inputType_(inputType),
+      outputBatchSize_(outputBatchSize),
+      pool_(pool),
+      spillConfig_(std::move(spillConfig)),
+      spillMemoryThreshold_(spillMemoryThreshold),
+      sortCompareFlags_(sortCompareFlags) {
+  VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags.size());
+  VELOX_CHECK(!sortColumnIndices.empty(), "Sort buffer needs sort keys");
+  VELOX_CHECK_GT(outputBatchSize_, 0);
+
+  // Stores the sort key columns first in 'data_' so that the row container
+  // can compare and spill them in key order.
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  std::vector<TypePtr> types;
+  std::vector<std::string> names;
+  std::unordered_set<column_index_t> keyChannels;
+  for (column_index_t i = 0; i < sortColumnIndices.size(); ++i) {
+    const auto channel = sortColumnIndices[i];
+    VELOX_CHECK_LT(channel, inputType_->size());
+    VELOX_CHECK(
+        keyChannels.insert(channel).second,
+        "Duplicate sort key: {}",
+        inputType_->nameOf(channel));
+    columnMap_.emplace_back(i, channel);
+    keyTypes.push_back(inputType_->childAt(channel));
+    types.push_back(keyTypes.back());
+    names.push_back(inputType_->nameOf(channel));
+  }
+  for (column_index_t channel = 0, nextColumn = sortColumnIndices.size();
+       channel < inputType_->size();
+       ++channel) {
+    if (keyChannels.count(channel) != 0) {
+      continue;
+    }
+    columnMap_.emplace_back(nextColumn++, channel);
+    dependentTypes.push_back(inputType_->childAt(channel));
+    types.push_back(dependentTypes.back());
+    names.push_back(inputType_->nameOf(channel));
+  }
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool_);
+  spillerStoreType_ = ROW(std::move(names), std::move(types));
+}
+
+void SortBuffer::addInput(const RowVectorPtr& input) {
+  VELOX_CHECK(!noMoreInput_);
+  ensureInputFits(input);
+
+  const SelectivityVector allRows(input->size());
+  std::vector<char*> rows(input->size());
+  for (auto row = 0; row < input->size(); ++row) {
+    rows[row] = data_->newRow();
+  }
+  for (const auto& columnProjection : columnMap_) {
+    DecodedVector decoded(
+        *input->childAt(columnProjection.outputChannel), allRows);
+    for (auto i = 0; i < input->size(); ++i) {
+      data_->store(decoded, i, rows[i], columnProjection.inputChannel);
+    }
+  }
+  numInputRows_ += input->size();
+}
+
+void SortBuffer::noMoreInput() {
+  VELOX_CHECK(!noMoreInput_);
+  noMoreInput_ = true;
+  if (numInputRows_ == 0) {
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    VELOX_CHECK_EQ(numInputRows_, data_->numRows());
+    sortedRows_.resize(numInputRows_);
+    RowContainerIterator iter;
+    data_->listRows(&iter, numInputRows_, sortedRows_.data());
+    std::vector<column_index_t> keyColumns(sortCompareFlags_.size());
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    PrefixSort(data_.get(), std::move(keyColumns), sortCompareFlags_)
+        .sort(sortedRows_);
+    return;
+  }
+
+  // There is a single spill partition, so all remaining rows are spilled as
+  // the last sorted run.
+  const auto nonSpilledRows = spiller_->finishSpill();
+  VELOX_CHECK(nonSpilledRows.empty());
+  spillMerge_ = spiller_->startMerge(0);
+  spillSources_.resize(outputBatchSize_);
+  spillSourceRows_.resize(outputBatchSize_);
+}
+
+RowVectorPtr SortBuffer::getOutput() {
+  VELOX_CHECK(noMoreInput_);
+  if (numOutputRows_ == numInputRows_) {
+    return nullptr;
+  }
+  prepareOutput(std::min<vector_size_t>(
+      numInputRows_ - numOutputRows_, outputBatchSize_));
+  if (spiller_ != nullptr) {
+    getOutputWithSpill();
+  } else {
+    getOutputWithoutSpill();
+  }
+  return output_;
+}
+
+Spiller::Stats SortBuffer::spilledStats() const {
+  if (spiller_ == nullptr) {
+    return {};
+  }
+  return spiller_->stats();
+}
+
+void SortBuffer::ensureInputFits(const RowVectorPtr& input) {
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+  const int64_t numRows = data_->numRows();
+  if (numRows == 0) {
+    return;
+  }
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input->estimateFlatSize();
+  const auto& spillConfig = spillConfig_.value();
+
+  // Test-only spill path.
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    spill(0, 0);
+    return;
+  }
+
+  const auto currentUsage = pool_->currentBytes();
+  if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
+    spill(0, 0);
+    return;
+  }
+
+  if (freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
+  if (pool_->availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool_->maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
+void SortBuffer::spill(int64_t targetRows, int64_t targetBytes) {
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillerStoreType_,
+        data_->keyTypes().size(),
+        sortCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.codecOptions,
+        spillConfig.tiers);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+  if (data_->numRows() == 0) {
+    data_->clear();
+  }
+}
+
+void SortBuffer::prepareOutput(vector_size_t batchSize) {
+  if (output_ != nullptr) {
+    VectorPtr output = std::move(output_);
+    BaseVector::prepareForReuse(output, batchSize);
+    output_ = std::static_pointer_cast<RowVector>(output);
+  } else {
+    output_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(inputType_, batchSize, pool_));
+  }
+  for (auto& child : output_->children()) {
+    child->resize(batchSize);
+  }
+}
+
+void SortBuffer::getOutputWithoutSpill() {
+  VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+  for (const auto& columnProjection : columnMap_) {
+    data_->extractColumn(
+        sortedRows_.data() + numOutputRows_,
+        output_->size(),
+        columnProjection.inputChannel,
+        output_->childAt(columnProjection.outputChannel));
+  }
+  numOutputRows_ += output_->size();
+}
+
+void SortBuffer::getOutputWithSpill() {
+  VELOX_CHECK_NOT_NULL(spillMerge_);
+  int32_t outputRow = 0;
+  int32_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < output_->size()) {
+    SpillMergeStream* stream = spillMerge_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+
+    spillSources_[outputSize] = &stream->current();
+    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
+    ++outputSize;
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          output_.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          columnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+    stream->pop();
+  }
+  if (FOLLY_LIKELY(outputSize != 0)) {
+    gatherCopy(
+        output_.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        columnMap_);
+  }
+  numOutputRows_ += output_->size();
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
+#include "velox/exec/TreeOfLosers.h"
+#include "velox/vector/ComplexVector.h"
+
+namespace facebook::velox::exec {
+
+/// Buffers rows in a RowContainer and returns them sorted on a set of key
+/// columns after all input is added. If 'spillConfig' is set, sorted runs are
+/// spilled to disk when the memory of 'pool' cannot grow or exceeds
+/// 'spillMemoryThreshold', and are merged with the rest of the rows on output.
+/// Used by operators and data sinks that need to sort their input, e.g. a
+/// writer of sorted files.
+class SortBuffer {
+ public:
+  /// 'sortColumnIndices' are the channels of the sort keys in 'inputType' in
+  /// the order of significance. 'sortCompareFlags' are the respective compare
+  /// flags. The output has 'inputType'.
+  SortBuffer(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& sortColumnIndices,
+      const std::vector<CompareFlags>& sortCompareFlags,
+      uint32_t outputBatchSize,
+      memory::MemoryPool* pool,
+      std::optional<Spiller::Config> spillConfig = std::nullopt,
+      uint64_t spillMemoryThreshold = 0);
+
+  void addInput(const RowVectorPtr& input);
+
+  /// Sorts the buffered rows or, if any have been spilled, starts merging the
+  /// spilled runs. No input may be added after this.
+  void noMoreInput();
+
+  /// Returns the next batch of at most 'outputBatchSize' sorted rows or
+  /// nullptr if all rows have been returned. Must be called after
+  /// noMoreInput().
+  RowVectorPtr getOutput();
+
+  uint64_t numInputRows() const {
+    return numInputRows_;
+  }
+
+  /// Returns the stats of spilling, all zero if nothing has been spilled.
+  Spiller::Stats spilledStats() const;
+
+ private:
+  // Spills sorted runs of the buffered rows if 'input' may not fit in memory.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  void prepareOutput(vector_size_t batchSize);
+
+  void getOutputWithoutSpill();
+
+  void getOutputWithSpill();
+
+  const RowTypePtr inputType_;
+  const uint32_t outputBatchSize_;
+  memory::MemoryPool* const pool_;
+  const std::optional<Spiller::Config> spillConfig_;
+  const uint64_t spillMemoryThreshold_;
+
+  std::vector<CompareFlags> sortCompareFlags_;
+  // The map from column channel in 'output_' to the corresponding one stored
+  // in 'data_'. The sort key columns are stored first in 'data_'.
+  std::vector<IdentityProjection> columnMap_;
+  std::unique_ptr<RowContainer> data_;
+  // The type of the rows in 'data_' and in the spill files.
+  RowTypePtr spillerStoreType_;
+
+  uint64_t numInputRows_{0};
+  uint64_t numOutputRows_{0};
+  bool noMoreInput_{false};
+
+  // Sorted rows of 'data_' if nothing has been spilled.
+  std::vector<char*> sortedRows_;
+
+  std::unique_ptr<Spiller> spiller_;
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+  // Counts input batches for test-only spilling.
+  uint64_t spillTestCounter_{0};
+  // The source rows to copy to 'output_' in order when merging spilled runs.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
+
+  RowVectorPtr output_;
+};
+
+} // namespace facebook::velox::exec
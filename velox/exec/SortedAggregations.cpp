@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/SortedAggregations.h"
+#include "velox/exec/PrefixSort.h"
 
 namespace facebook::velox::exec {
 
@@ -169,42 +170,22 @@ void SortedAggregations::addSingleGroupInput(
   }
 }
 
-bool SortedAggregations::compareRowsWithKeys(
-    const char* lhs,
-    const char* rhs,
-    const std::vector<std::pair<column_index_t, core::SortOrder>>& keys) {
-  if (lhs == rhs) {
-    return false;
-  }
-  for (auto& key : keys) {
-    if (auto result = inputData_->compare(
-            lhs,
-            rhs,
-            key.first,
-            {key.second.isNullsFirst(), key.second.isAscending(), false})) {
-      return result < 0;
-    }
-  }
-  return false;
-}
-
 void SortedAggregations::noMoreInput() {}
 
 void SortedAggregations::sortSingleGroup(
     std::vector<char*>& groupRows,
     const AggregateInfo& aggregate) {
-  std::vector<std::pair<column_index_t, core::SortOrder>> keys;
+  std::vector<column_index_t> keyColumns;
+  std::vector<CompareFlags> keyFlags;
   for (auto i = 0; i < aggregate.sortingKeys.size(); ++i) {
-    keys.push_back(
-        {inputMapping_[aggregate.sortingKeys[i]], aggregate.sortingOrders[i]});
-  }
-
-  std::sort(
-      groupRows.begin(),
-      groupRows.end(),
-      [&](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, keys);
-      });
+    keyColumns.push_back(inputMapping_[aggregate.sortingKeys[i]]);
+    keyFlags.push_back(
+        {aggregate.sortingOrders[i].isNullsFirst(),
+         aggregate.sortingOrders[i].isAscending(),
+         false});
+  }
+  PrefixSort(inputData_.get(), std::move(keyColumns), std::move(keyFlags))
+      .sort(groupRows);
 }
 
 std::vector<VectorPtr> SortedAggregations::extractSingleGroup(
@@ -71,11 +71,6 @@ class SortedAggregations {
  private:
   void addNewRow(char* group, char* newRow);
 
-  bool compareRowsWithKeys(
-      const char* lhs,
-      const char* rhs,
-      const std::vector<std::pair<column_index_t, core::SortOrder>>& keys);
-
   void sortSingleGroup(
       std::vector<char*>& groupRows,
       const AggregateInfo& aggregate);
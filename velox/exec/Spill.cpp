@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/Spill.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
@@ -31,12 +34,117 @@ static const serializer::presto::PrestoVectorSerde::PrestoOptions
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
+folly::io::CodecType spillCompressionKindFromString(const std::string& name) {
+  static const std::unordered_map<std::string, folly::io::CodecType> kCodecs{
+      {"none", folly::io::CodecType::NO_COMPRESSION},
+      {"lz4", folly::io::CodecType::LZ4},
+      {"snappy", folly::io::CodecType::SNAPPY},
+      {"zstd", folly::io::CodecType::ZSTD},
+  };
+  auto it = kCodecs.find(name);
+  VELOX_USER_CHECK(
+      it != kCodecs.end(), "Unknown spill compression codec: {}", name);
+  VELOX_USER_CHECK(
+      folly::io::hasCodec(it->second),
+      "Spill compression codec is not available: {}",
+      name);
+  return it->second;
+}
+
+SpillTiers::SpillTiers(
+    const std::string& localDirectory,
+    const std::string& overflowDirectory,
+    uint64_t maxLocalBytes,
+    uint64_t maxBytes)
+    : localDirectory_(localDirectory),
+      overflowDirectory_(overflowDirectory),
+      maxLocalBytes_(
+          maxLocalBytes == 0 ? std::numeric_limits<uint64_t>::max()
+                             : maxLocalBytes),
+      maxBytes_(
+          maxBytes == 0 ? std::numeric_limits<uint64_t>::max() : maxBytes) {
+  VELOX_CHECK(!localDirectory_.empty());
+}
+
+SpillTiers::Tier SpillTiers::nextFileTier() const {
+  if (overflowDirectory_.empty() || bytes(Tier::kLocal) < maxLocalBytes_) {
+    return Tier::kLocal;
+  }
+  return Tier::kOverflow;
+}
+
+std::string SpillTiers::path(Tier tier, const std::string& path) const {
+  if (tier == Tier::kLocal) {
+    return path;
+  }
+  VELOX_CHECK_EQ(
+      path.compare(0, localDirectory_.size(), localDirectory_),
+      0,
+      "Spill file {} is not in the spill directory {}",
+      path,
+      localDirectory_);
+  return overflowDirectory_ + path.substr(localDirectory_.size());
+}
+
+void SpillTiers::addBytes(Tier tier, uint64_t bytes) {
+  bytes_[static_cast<int32_t>(tier)] += bytes;
+  const auto totalBytes = totalBytes_ += bytes;
+  if (totalBytes > maxBytes_) {
+    VELOX_SPILL_LIMIT_EXCEEDED(fmt::format(
+        "Spilled {} exceeds the spill limit of {}",
+        succinctBytes(totalBytes),
+        succinctBytes(maxBytes_)));
+  }
+}
+
+SpillInput::~SpillInput() {
+  if (readAhead_ == nullptr) {
+    return;
+  }
+  try {
+    readAhead_->move();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Spill file read-ahead failed: " << e.what();
+  }
+}
+
 void SpillInput::next(bool /*throwIfPastEnd*/) {
-  int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+  int32_t readBytes;
+  if (readAhead_ != nullptr) {
+    auto bytes = readAhead_->move();
+    readAhead_.reset();
+    VELOX_CHECK_NOT_NULL(bytes);
+    readBytes = *bytes;
+    std::swap(buffer_, readAheadBuffer_);
+  } else {
+    readBytes = std::min(input_->size() - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    input_->pread(offset_, readBytes, buffer_->asMutable<char>());
+  }
   setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  input_->pread(offset_, readBytes, buffer_->asMutable<char>());
   offset_ += readBytes;
+  startReadAhead();
+}
+
+void SpillInput::startReadAhead() {
+  if (executor_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  if (readAheadBuffer_ == nullptr) {
+    readAheadBuffer_ =
+        AlignedBuffer::allocate<char>(buffer_->capacity(), buffer_->pool());
+  }
+  const int32_t readBytes =
+      std::min(size_ - offset_, readAheadBuffer_->capacity());
+  readAhead_ = std::make_shared<AsyncSource<int32_t>>(
+      [input = input_.get(),
+       data = readAheadBuffer_->asMutable<char>(),
+       offset = offset_,
+       readBytes]() {
+        input->pread(offset, readBytes, data);
+        return std::make_unique<int32_t>(readBytes);
+      });
+  executor_->add([readAhead = readAhead_]() { readAhead->prepare(); });
 }
 
 void SpillMergeStream::pop() {
@@ -53,27 +161,70 @@ WriteFile& SpillFile::output() {
   return *output_;
 }
 
-void SpillFile::startRead() {
+void SpillFile::startRead(folly::Executor* executor) {
   constexpr uint64_t kMaxReadBufferSize =
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
+  // Overflow files are typically on a remote file system where each read has
+  // a high latency, so they are read in larger pieces.
+  constexpr uint64_t kMaxOverflowReadBufferSize =
+      (8 << 20) - AlignedBuffer::kPaddedSize; // 8MB - padding.
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), &pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+      std::min<uint64_t>(
+          fileSize_,
+          tier_ == SpillTiers::Tier::kOverflow ? kMaxOverflowReadBufferSize
+                                               : kMaxReadBufferSize),
+      &pool_);
+  input_ = std::make_unique<SpillInput>(
+      std::move(file), std::move(buffer), executor);
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   if (input_->atEnd()) {
     return false;
   }
+  if (!codecOptions_.framed()) {
+    VectorStreamGroup::read(
+        input_.get(), &pool_, type_, &rowVector, &kDefaultSerdeOptions);
+    return true;
+  }
+  ByteStream page;
+  readFramedPage(page);
   VectorStreamGroup::read(
-      input_.get(), &pool_, type_, &rowVector, &kDefaultSerdeOptions);
+      &page, &pool_, type_, &rowVector, &kDefaultSerdeOptions);
   return true;
 }
 
+void SpillFile::readFramedPage(ByteStream& page) {
+  const auto uncompressedSize = input_->read<int32_t>();
+  const auto size = input_->read<int32_t>();
+  VELOX_CHECK_GT(size, 0, "Corrupted spill file {}", path_);
+  if (!pageBuffer_ || pageBuffer_->capacity() < static_cast<uint64_t>(size)) {
+    pageBuffer_ = AlignedBuffer::allocate<char>(size, &pool_);
+  }
+  input_->readBytes(pageBuffer_->asMutable<uint8_t>(), size);
+  if (size == uncompressedSize) {
+    // The page did not compress and was written as is.
+    page.setRange({pageBuffer_->asMutable<uint8_t>(), size, 0});
+    return;
+  }
+  if (!codec_) {
+    codec_ = folly::io::getCodec(codecOptions_.compressionKind);
+  }
+  auto compressed =
+      folly::IOBuf::wrapBufferAsValue(pageBuffer_->as<char>(), size);
+  uncompressedPage_ = codec_->uncompress(&compressed, uncompressedSize);
+  uncompressedPage_->coalesce();
+  VELOX_CHECK_EQ(uncompressedPage_->length(), uncompressedSize);
+  page.setRange(
+      {uncompressedPage_->writableData(),
+       static_cast<int32_t>(uncompressedPage_->length()),
+       0});
+}
+
 WriteFile& SpillFileList::currentOutput() {
   if (files_.empty() || !files_.back()->isWritable() ||
       files_.back()->size() > targetFileSize_) {
@@ -85,23 +236,54 @@ WriteFile& SpillFileList::currentOutput() {
         numSortingKeys_,
         sortCompareFlags_,
         fmt::format("{}-{}", path_, files_.size()),
-        pool_));
+        pool_,
+        codecOptions_,
+        tiers_));
   }
   return files_.back()->output();
 }
 
 void SpillFileList::flush() {
   if (batch_) {
+    // The serializer writes a checksum of the page if the stream has a
+    // listener.
+    serializer::presto::PrestoOutputStreamListener listener;
     IOBufOutputStream out(
-        pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+        pool_,
+        codecOptions_.checksumEnabled ? &listener : nullptr,
+        std::max<int64_t>(64 * 1024, batch_->size()));
     batch_->flush(&out);
     batch_.reset();
     auto iobuf = out.getIOBuf();
     auto& file = currentOutput();
+    const auto startSize = file.size();
+    if (codecOptions_.framed()) {
+      const int32_t uncompressedSize = iobuf->computeChainDataLength();
+      if (codec_) {
+        auto compressed = codec_->compress(iobuf.get());
+        if (compressed->computeChainDataLength() < uncompressedSize) {
+          iobuf = std::move(compressed);
+        }
+      }
+      // Each page is preceded by its uncompressed and stored sizes. The sizes
+      // are equal if the page is stored uncompressed.
+      const int32_t header[2] = {
+          uncompressedSize,
+          static_cast<int32_t>(iobuf->computeChainDataLength())};
+      file.append(std::string_view(
+          reinterpret_cast<const char*>(header), sizeof(header)));
+      uncompressedBytes_ += uncompressedSize;
+      compressedBytes_ += header[1];
+    }
+    REPORT_ADD_STAT_VALUE(
+        kCounterSpillWriteBytes, iobuf->computeChainDataLength());
     for (auto& range : *iobuf) {
       file.append(std::string_view(
           reinterpret_cast<const char*>(range.data()), range.size()));
     }
+    if (tiers_) {
+      tiers_->addBytes(files_.back()->tier(), file.size() - startSize);
+    }
   }
 }
 
@@ -144,6 +326,28 @@ void SpillFileList::recordRuntimeStats() {
         "spillFileSize",
         RuntimeCounter(file->size(), RuntimeCounter::Unit::kBytes));
   }
+  if (tiers_ != nullptr) {
+    uint64_t localBytes = 0;
+    uint64_t overflowBytes = 0;
+    for (const auto& file : files_) {
+      (file->tier() == SpillTiers::Tier::kLocal ? localBytes : overflowBytes) +=
+          file->size();
+    }
+    addThreadLocalRuntimeStat(
+        "spillLocalBytes",
+        RuntimeCounter(localBytes, RuntimeCounter::Unit::kBytes));
+    addThreadLocalRuntimeStat(
+        "spillOverflowBytes",
+        RuntimeCounter(overflowBytes, RuntimeCounter::Unit::kBytes));
+  }
+  if (codec_ != nullptr) {
+    addThreadLocalRuntimeStat(
+        "spillUncompressedBytes",
+        RuntimeCounter(uncompressedBytes_, RuntimeCounter::Unit::kBytes));
+    addThreadLocalRuntimeStat(
+        "spillCompressedBytes",
+        RuntimeCounter(compressedBytes_, RuntimeCounter::Unit::kBytes));
+  }
 }
 
 std::vector<std::string> SpillFileList::testingSpilledFilePaths() const {
@@ -173,7 +377,9 @@ void SpillState::appendToPartition(
         sortCompareFlags_,
         fmt::format("{}-spill-{}", path_, partition),
         targetFileSize_,
-        pool_);
+        pool_,
+        codecOptions_,
+        tiers_);
   }
 
   IndexRange range{0, rows->size()};
@@ -182,12 +388,14 @@ void SpillState::appendToPartition(
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>> SpillState::startMerge(
     int32_t partition,
-    std::unique_ptr<SpillMergeStream>&& extra) {
+    std::unique_ptr<SpillMergeStream>&& extra,
+    folly::Executor* executor) {
   VELOX_CHECK_LT(partition, files_.size());
   std::vector<std::unique_ptr<SpillMergeStream>> result;
   if (auto list = std::move(files_[partition]); list) {
     for (auto& file : list->files()) {
-      result.push_back(FileSpillMergeStream::create(std::move(file)));
+      result.push_back(
+          FileSpillMergeStream::create(std::move(file), executor));
     }
   }
   VELOX_DCHECK_EQ(!result.empty(), isPartitionSpilled(partition));
@@ -272,11 +480,11 @@ std::vector<std::unique_ptr<SpillPartition>> SpillPartition::split(
 }
 
 std::unique_ptr<UnorderedStreamReader<BatchStream>>
-SpillPartition::createReader() {
+SpillPartition::createReader(folly::Executor* executor) {
   std::vector<std::unique_ptr<BatchStream>> streams;
   streams.reserve(files_.size());
   for (auto& file : files_) {
-    streams.push_back(FileSpillBatchStream::create(std::move(file)));
+    streams.push_back(FileSpillBatchStream::create(std::move(file), executor));
   }
   files_.clear();
   return std::make_unique<UnorderedStreamReader<BatchStream>>(
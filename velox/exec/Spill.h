@@ -16,8 +16,12 @@
 
 #pragma once
 
+#include <array>
+
+#include <folly/compression/Compression.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/UnorderedStreamReader.h"
@@ -25,19 +29,106 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorStream.h"
 
+#define VELOX_SPILL_LIMIT_EXCEEDED(errorMessage)                    \
+  _VELOX_THROW(                                                     \
+      ::facebook::velox::VeloxRuntimeError,                         \
+      ::facebook::velox::error_source::kErrorSourceRuntime.c_str(), \
+      ::facebook::velox::error_code::kSpillLimitExceeded.c_str(),   \
+      /* isRetriable */ true,                                       \
+      "{}",                                                         \
+      errorMessage);
+
 namespace facebook::velox::exec {
 
+/// Places the spill files of a task in tiers of storage. New files go to the
+/// local spill directory until the files there hold 'maxLocalBytes', then to
+/// an overflow directory, typically on a remote file system such as S3 or
+/// HDFS. Also enforces a quota on the total bytes spilled by the task. Shared
+/// by all the spillers of a task.
+class SpillTiers {
+ public:
+  enum class Tier : int8_t {
+    kLocal = 0,
+    kOverflow = 1,
+  };
+  static constexpr int32_t kNumTiers = 2;
+
+  /// 'localDirectory' is the directory under which the spill file paths of the
+  /// task are made. An empty 'overflowDirectory' keeps all the files local. 0
+  /// for 'maxLocalBytes' or 'maxBytes' means no limit.
+  SpillTiers(
+      const std::string& localDirectory,
+      const std::string& overflowDirectory,
+      uint64_t maxLocalBytes,
+      uint64_t maxBytes);
+
+  /// Returns the tier of a new spill file. A file goes to the local tier if
+  /// the local tier is under its limit when the file is created, so the local
+  /// tier may exceed its limit by up to one file per spiller.
+  Tier nextFileTier() const;
+
+  /// Returns the path in 'tier' of a spill file whose local path is 'path'.
+  std::string path(Tier tier, const std::string& path) const;
+
+  /// Records 'bytes' written to a spill file in 'tier'. Throws if the task has
+  /// spilled more than 'maxBytes'.
+  void addBytes(Tier tier, uint64_t bytes);
+
+  uint64_t bytes(Tier tier) const {
+    return bytes_[static_cast<int32_t>(tier)];
+  }
+
+ private:
+  const std::string localDirectory_;
+  const std::string overflowDirectory_;
+  const uint64_t maxLocalBytes_;
+  const uint64_t maxBytes_;
+
+  std::atomic<uint64_t> totalBytes_{0};
+  std::array<std::atomic<uint64_t>, kNumTiers> bytes_{};
+};
+
+/// Specifies how the serialized pages of spill files are encoded.
+struct SpillCodecOptions {
+  /// Codec for compressing each serialized page. Pages are written as is with
+  /// NO_COMPRESSION.
+  folly::io::CodecType compressionKind{folly::io::CodecType::NO_COMPRESSION};
+
+  /// If true, each page carries a CRC32 checksum of its content that is
+  /// verified when the page is read back.
+  bool checksumEnabled{false};
+
+  /// True if pages are written with a size header and read back whole.
+  bool framed() const {
+    return compressionKind != folly::io::CodecType::NO_COMPRESSION ||
+        checksumEnabled;
+  }
+};
+
+/// Returns the codec for the spill compression 'name', which is one of "none",
+/// "lz4", "snappy" or "zstd". Throws if the codec is unknown or not available
+/// in this build.
+folly::io::CodecType spillCompressionKindFromString(const std::string& name);
+
 // Input stream backed by spill file.
 class SpillInput : public ByteStream {
  public:
-  // Reads from 'input' using 'buffer' for buffering reads.
-  SpillInput(std::unique_ptr<ReadFile>&& input, BufferPtr buffer)
+  // Reads from 'input' using 'buffer' for buffering reads. If 'executor' is
+  // set, the next buffer of the file is read ahead on 'executor' into a second
+  // buffer of the same size while the current buffer is being consumed.
+  SpillInput(
+      std::unique_ptr<ReadFile>&& input,
+      BufferPtr buffer,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr)
       : input_(std::move(input)),
         buffer_(std::move(buffer)),
+        executor_(executor),
         size_(input_->size()) {
     next(true);
   }
 
+  ~SpillInput() override;
+
   void next(bool throwIfPastEnd) override;
 
   // True if all of the file has been read into vectors.
@@ -46,11 +137,22 @@ class SpillInput : public ByteStream {
   }
 
  private:
+  // Starts reading the buffer after 'offset_' on 'executor_' if there is
+  // one.
+  void startReadAhead();
+
   std::unique_ptr<ReadFile> input_;
   BufferPtr buffer_;
+  folly::Executor* const FOLLY_NULLABLE executor_;
   const uint64_t size_;
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+
+  // Buffer and byte count of the read-ahead after 'offset_'. The destructor
+  // waits for a pending read-ahead, so that it does not outlive 'input_' and
+  // 'readAheadBuffer_'.
+  BufferPtr readAheadBuffer_;
+  std::shared_ptr<AsyncSource<int32_t>> readAhead_;
 };
 
 /// Represents a spill file that is first in write mode and then
@@ -68,13 +170,20 @@ class SpillFile {
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr)
       : type_(std::move(type)),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         pool_(pool),
+        codecOptions_(codecOptions),
+        tiers_(std::move(tiers)),
         ordinal_(ordinalCounter_++),
-        path_(fmt::format("{}-{}", path, ordinal_)) {
+        tier_(tiers_ ? tiers_->nextFileTier() : SpillTiers::Tier::kLocal),
+        path_(
+            tiers_ ? tiers_->path(tier_, fmt::format("{}-{}", path, ordinal_))
+                   : fmt::format("{}-{}", path, ordinal_)) {
     // NOTE: if the spilling operator has specified the sort comparison flags,
     // then it must match the number of sorting keys.
     VELOX_CHECK(
@@ -110,7 +219,8 @@ class SpillFile {
 
   /// Prepares 'this' for reading. Positions the read at the first row of
   /// content. The caller must call output() and finishWrite() before this.
-  void startRead();
+  /// If 'executor' is set, the file is read ahead on 'executor'.
+  void startRead(folly::Executor* FOLLY_NULLABLE executor = nullptr);
 
   bool nextBatch(RowVectorPtr& rowVector);
 
@@ -128,11 +238,20 @@ class SpillFile {
     return fmt::format("{}", ordinal_);
   }
 
+  /// Returns the storage tier of the file.
+  SpillTiers::Tier tier() const {
+    return tier_;
+  }
+
   const std::string& testingFilePath() const {
     return path_;
   }
 
  private:
+  // Reads the next page written with a frame header. Decompresses the page if
+  // needed and returns a stream over its serialized content.
+  void readFramedPage(ByteStream& page);
+
   static std::atomic<int32_t> ordinalCounter_;
 
   // Type of 'rowVector_'. Needed for setting up writing.
@@ -140,15 +259,23 @@ class SpillFile {
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   memory::MemoryPool& pool_;
+  const SpillCodecOptions codecOptions_;
+  const std::shared_ptr<SpillTiers> tiers_;
 
   // Ordinal number used for making a label for debugging.
   const int32_t ordinal_;
+  const SpillTiers::Tier tier_;
   const std::string path_;
 
   // Byte size of the backing file. Set when finishing writing.
   uint64_t fileSize_ = 0;
   std::unique_ptr<WriteFile> output_;
   std::unique_ptr<SpillInput> input_;
+
+  // Codec and buffers for reading a framed page and its uncompressed content.
+  std::unique_ptr<folly::io::Codec> codec_;
+  BufferPtr pageBuffer_;
+  std::unique_ptr<folly::IOBuf> uncompressedPage_;
 };
 
 using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
@@ -163,6 +290,9 @@ class SpillFileList {
   /// data is sorted. 'path' is a file path prefix. ' 'targetFileSize' is the
   /// target byte size of a single file in the file set. 'pool' is used for
   /// buffering and constructing the result data read from 'this'.
+  /// 'codecOptions' specifies the compression and checksums of the pages.
+  /// 'tiers', if set, places the files in local or overflow storage and
+  /// accounts for their bytes.
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
@@ -172,13 +302,22 @@ class SpillFileList {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr)
       : type_(type),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         path_(path),
         targetFileSize_(targetFileSize),
-        pool_(pool) {
+        pool_(pool),
+        codecOptions_(codecOptions),
+        tiers_(std::move(tiers)),
+        codec_(
+            codecOptions_.compressionKind ==
+                    folly::io::CodecType::NO_COMPRESSION
+                ? nullptr
+                : folly::io::getCodec(codecOptions_.compressionKind)) {
     // NOTE: if the associated spilling operator has specified the sort
     // comparison flags, then it must match the number of sorting keys.
     VELOX_CHECK(
@@ -230,8 +369,14 @@ class SpillFileList {
   const std::string path_;
   const uint64_t targetFileSize_;
   memory::MemoryPool& pool_;
+  const SpillCodecOptions codecOptions_;
+  const std::shared_ptr<SpillTiers> tiers_;
+  const std::unique_ptr<folly::io::Codec> codec_;
   std::unique_ptr<VectorStreamGroup> batch_;
   SpillFiles files_;
+  // Bytes of serialized pages before and after compression.
+  uint64_t uncompressedBytes_{0};
+  uint64_t compressedBytes_{0};
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -363,8 +508,9 @@ class SpillMergeStream : public MergeStream {
 class FileSpillMergeStream : public SpillMergeStream {
  public:
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillFile> spillFile) {
-    spillFile->startRead();
+      std::unique_ptr<SpillFile> spillFile,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr) {
+    spillFile->startRead(executor);
     auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
     spillStream->nextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
@@ -403,22 +549,28 @@ class FileSpillMergeStream : public SpillMergeStream {
 class FileSpillBatchStream : public BatchStream {
  public:
   static std::unique_ptr<BatchStream> create(
-      std::unique_ptr<SpillFile> spillFile) {
-    auto* spillStream = new FileSpillBatchStream(std::move(spillFile));
+      std::unique_ptr<SpillFile> spillFile,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr) {
+    auto* spillStream =
+        new FileSpillBatchStream(std::move(spillFile), executor);
     return std::unique_ptr<BatchStream>(spillStream);
   }
 
   bool nextBatch(RowVectorPtr& batch) override {
     if (FOLLY_UNLIKELY(!isFileOpened_)) {
-      spillFile_->startRead();
+      spillFile_->startRead(executor_);
       isFileOpened_ = true;
     }
     return spillFile_->nextBatch(batch);
   }
 
  private:
-  explicit FileSpillBatchStream(std::unique_ptr<SpillFile> spillFile)
-      : isFileOpened_(false), spillFile_(std::move(spillFile)) {
+  FileSpillBatchStream(
+      std::unique_ptr<SpillFile> spillFile,
+      folly::Executor* FOLLY_NULLABLE executor)
+      : isFileOpened_(false),
+        spillFile_(std::move(spillFile)),
+        executor_(executor) {
     VELOX_CHECK_NOT_NULL(spillFile_);
   }
 
@@ -428,6 +580,8 @@ class FileSpillBatchStream : public BatchStream {
   // we don't open too many files at the same time.
   bool isFileOpened_;
   std::unique_ptr<SpillFile> spillFile_;
+  // Executor for reading ahead 'spillFile_'. Not owned.
+  folly::Executor* const FOLLY_NULLABLE executor_;
 };
 
 /// Identifies a spill partition generated from a given spilling operator. It
@@ -529,7 +683,10 @@ class SpillPartition {
 
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
-  std::unique_ptr<UnorderedStreamReader<BatchStream>> createReader();
+  /// Returns a reader over the files of 'this'. If 'executor' is set, each
+  /// file is read ahead on 'executor'.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> createReader(
+      folly::Executor* FOLLY_NULLABLE executor = nullptr);
 
  private:
   SpillPartitionId id_;
@@ -549,19 +706,25 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. 'codecOptions' specifies the compression and checksums of the
+  /// spill files. 'tiers', if set, places the spill files in local or overflow
+  /// storage.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
       int32_t numSortingKeys,
       const std::vector<CompareFlags>& sortCompareFlags,
       uint64_t targetFileSize,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr)
       : path_(path),
         maxPartitions_(maxPartitions),
         numSortingKeys_(numSortingKeys),
         sortCompareFlags_(sortCompareFlags),
         targetFileSize_(targetFileSize),
+        codecOptions_(codecOptions),
+        tiers_(std::move(tiers)),
         pool_(pool),
         files_(maxPartitions_) {}
 
@@ -617,10 +780,12 @@ class SpillState {
 
   // Starts reading values for 'partition'. If 'extra' is non-null, it can be
   // a stream of rows from a RowContainer so as to merge unspilled data with
-  // spilled data.
+  // spilled data. If 'executor' is set, each spill file is read ahead on
+  // 'executor'.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
       int32_t partition,
-      std::unique_ptr<SpillMergeStream>&& extra);
+      std::unique_ptr<SpillMergeStream>&& extra,
+      folly::Executor* FOLLY_NULLABLE executor = nullptr);
 
   bool hasFiles(int32_t partition) const {
     return partition < files_.size() && files_[partition];
@@ -646,6 +811,8 @@ class SpillState {
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
   const uint64_t targetFileSize_;
+  const SpillCodecOptions codecOptions_;
+  const std::shared_ptr<SpillTiers> tiers_;
 
   memory::MemoryPool& pool_;
 
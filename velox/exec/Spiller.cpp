@@ -19,13 +19,17 @@
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/OperatorUtils.h"
 
 using facebook::velox::common::testutil::TestValue;
 
 namespace facebook::velox::exec {
 namespace {
 constexpr int32_t kLogEveryN = 32;
-}
+
+// Number of rows to hash and divide into spill partitions at a time.
+constexpr int32_t kHashBatchSize = 4096;
+} // namespace
 
 Spiller::Spiller(
     Type type,
@@ -38,7 +42,9 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const SpillCodecOptions& codecOptions,
+    std::shared_ptr<SpillTiers> tiers)
     : Spiller(
           type,
           container,
@@ -51,7 +57,9 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
+          executor,
+          codecOptions,
+          std::move(tiers)) {
   VELOX_CHECK_EQ(type_, Type::kOrderBy);
 }
 
@@ -63,7 +71,9 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* FOLLY_NULLABLE executor)
+    folly::Executor* FOLLY_NULLABLE executor,
+    const SpillCodecOptions& codecOptions,
+    std::shared_ptr<SpillTiers> tiers)
     : Spiller(
           type,
           nullptr,
@@ -76,8 +86,13 @@ Spiller::Spiller(
           targetFileSize,
           minSpillRunSize,
           pool,
-          executor) {
-  VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
+          executor,
+          codecOptions,
+          std::move(tiers)) {
+  VELOX_CHECK(
+      type_ == Type::kHashJoinProbe || type_ == Type::kPartitionedInput,
+      "Unexpected spiller type without row container: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -92,7 +107,9 @@ Spiller::Spiller(
     uint64_t targetFileSize,
     uint64_t minSpillRunSize,
     memory::MemoryPool& pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const SpillCodecOptions& codecOptions,
+    std::shared_ptr<SpillTiers> tiers)
     : type_(type),
       container_(container),
       eraser_(eraser),
@@ -105,13 +122,17 @@ Spiller::Spiller(
           numSortingKeys,
           sortCompareFlags,
           targetFileSize,
-          pool),
+          pool,
+          codecOptions,
+          std::move(tiers)),
       pool_(pool),
       executor_(executor) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
-  VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
+  VELOX_CHECK_EQ(
+      container_ == nullptr,
+      type_ == Type::kHashJoinProbe || type_ == Type::kPartitionedInput);
   // kOrderBy spiller type must only have one partition.
   VELOX_CHECK((type_ != Type::kOrderBy) || (state_.maxPartitions() == 1));
   spillRuns_.reserve(state_.maxPartitions());
@@ -149,7 +170,7 @@ int64_t Spiller::extractSpillVector(
     int64_t maxBytes,
     RowVectorPtr& spillVector,
     size_t& nextBatchIndex) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NOT_NULL(container_);
 
   auto limit = std::min<size_t>(rows.size() - nextBatchIndex, maxRows);
   assert(!rows.empty());
@@ -257,7 +278,7 @@ void Spiller::ensureSorted(SpillRun& run) {
 }
 
 std::unique_ptr<Spiller::SpillStatus> Spiller::writeSpill(int32_t partition) {
-  VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
+  VELOX_CHECK_NOT_NULL(container_);
   VELOX_CHECK_EQ(pendingSpillPartitions_.count(partition), 1);
   // Target size of a single vector of spilled content. One of
   // these will be materialized at a time for each stream of the
@@ -344,13 +365,15 @@ void Spiller::advanceSpill() {
 }
 
 bool Spiller::needSort() const {
-  return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild;
+  return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild &&
+      type_ != Type::kPartitionedInput;
 }
 
 void Spiller::spill(uint64_t targetRows, uint64_t targetBytes) {
   VELOX_CHECK(!spillFinalized_);
 
-  if (type_ == Type::kHashJoinBuild || type_ == Type::kHashJoinProbe) {
+  if (type_ == Type::kHashJoinBuild || type_ == Type::kHashJoinProbe ||
+      type_ == Type::kPartitionedInput) {
     VELOX_FAIL("Don't support incremental spill on type: {}", typeName(type_));
   }
 
@@ -413,7 +436,7 @@ void Spiller::spill(uint64_t targetRows, uint64_t targetBytes) {
 
 void Spiller::spill(const SpillPartitionNumSet& partitions) {
   VELOX_CHECK(!spillFinalized_);
-  if (type_ == Type::kHashJoinProbe) {
+  if (container_ == nullptr) {
     VELOX_FAIL("There is no row container for {}", typeName(type_));
   }
   if (!pendingSpillPartitions_.empty()) {
@@ -442,6 +465,38 @@ void Spiller::spill(const SpillPartitionNumSet& partitions) {
   }
 }
 
+void Spiller::spillRows(folly::Range<char**> rows) {
+  VELOX_CHECK(!spillFinalized_);
+  if (type_ != Type::kOrderBy && type_ != Type::kAggregate) {
+    VELOX_FAIL("Don't support spilling given rows on type: {}", toString());
+  }
+  if (!pendingSpillPartitions_.empty()) {
+    VELOX_FAIL(
+        "There are pending spilling operations on partitions: {}",
+        folly::join(",", pendingSpillPartitions_));
+  }
+
+  clearSpillRuns();
+  std::vector<uint64_t> hashes(kHashBatchSize);
+  for (size_t start = 0; start < rows.size(); start += kHashBatchSize) {
+    const auto numRows = std::min<size_t>(kHashBatchSize, rows.size() - start);
+    addToSpillRuns(rows.subpiece(start, numRows), hashes, nullptr);
+  }
+
+  for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
+    if (spillRuns_[partition].rows.empty()) {
+      continue;
+    }
+    if (!state_.isPartitionSpilled(partition)) {
+      state_.setPartitionSpilled(partition);
+    }
+    pendingSpillPartitions_.insert(partition);
+  }
+  while (!pendingSpillPartitions_.empty()) {
+    advanceSpill();
+  }
+}
+
 void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   VELOX_CHECK(!spillFinalized_);
 
@@ -464,6 +519,55 @@ void Spiller::spill(uint32_t partition, const RowVectorPtr& spillVector) {
   state_.appendToPartition(partition, spillVector);
 }
 
+void Spiller::spillPartitioned(
+    const RowVectorPtr& input,
+    const std::vector<uint32_t>& partitions) {
+  VELOX_CHECK_EQ(type_, Type::kPartitionedInput);
+  VELOX_CHECK_GE(partitions.size(), input->size());
+
+  const auto numInput = input->size();
+  std::vector<vector_size_t> numPartitionRows(state_.maxPartitions(), 0);
+  for (auto row = 0; row < numInput; ++row) {
+    ++numPartitionRows[partitions[row]];
+  }
+
+  std::vector<BufferPtr> indices(state_.maxPartitions());
+  std::vector<vector_size_t*> rawIndices(state_.maxPartitions(), nullptr);
+  for (auto partition = 0; partition < state_.maxPartitions(); ++partition) {
+    if (numPartitionRows[partition] == 0 ||
+        numPartitionRows[partition] == numInput) {
+      continue;
+    }
+    indices[partition] = allocateIndices(numPartitionRows[partition], &pool_);
+    rawIndices[partition] = indices[partition]->asMutable<vector_size_t>();
+  }
+  std::fill(numPartitionRows.begin(), numPartitionRows.end(), 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = partitions[row];
+    if (rawIndices[partition] != nullptr) {
+      rawIndices[partition][numPartitionRows[partition]] = row;
+    }
+    ++numPartitionRows[partition];
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (auto partition = 0; partition < state_.maxPartitions(); ++partition) {
+    const auto numRows = numPartitionRows[partition];
+    if (numRows == 0) {
+      continue;
+    }
+    if (numRows == numInput) {
+      spill(partition, input);
+    } else {
+      spill(partition, wrap(numRows, indices[partition], input));
+    }
+  }
+}
+
 int32_t Spiller::pickNextPartitionToSpill() {
   VELOX_DCHECK_EQ(spillRuns_.size(), state_.maxPartitions());
 
@@ -506,7 +610,7 @@ Spiller::SpillRows Spiller::finishSpill() {
 
   SpillRows rowsFromNonSpillingPartitions(
       0, memory::StlAllocator<char*>(pool_));
-  if (type_ != Spiller::Type::kHashJoinProbe) {
+  if (container_ != nullptr) {
     fillSpillRuns(&rowsFromNonSpillingPartitions);
   }
   return rowsFromNonSpillingPartitions;
@@ -539,44 +643,52 @@ void Spiller::fillSpillRuns(SpillRows* rowsFromNonSpillingPartitions) {
   clearSpillRuns();
 
   RowContainerIterator iterator;
-  // Number of rows to hash and divide into spill partitions at a time.
-  constexpr int32_t kHashBatchSize = 4096;
   std::vector<uint64_t> hashes(kHashBatchSize);
   std::vector<char*> rows(kHashBatchSize);
   for (;;) {
     auto numRows = container_->listRows(
         &iterator, rows.size(), RowContainer::kUnlimited, rows.data());
-    // Calculate hashes for this batch of spill candidates.
-    auto rowSet = folly::Range<char**>(rows.data(), numRows);
-    for (auto i = 0; i < container_->keyTypes().size(); ++i) {
-      container_->hash(i, rowSet, i > 0, hashes.data());
-    }
-
-    // Put each in its run.
-    for (auto i = 0; i < numRows; ++i) {
-      // TODO: consider to cache the hash bits in row container so we only need
-      // to calculate them once.
-      const auto partition = (type_ == Type::kOrderBy)
-          ? 0
-          : bits_.partition(hashes[i], state_.maxPartitions());
-      VELOX_DCHECK_GE(partition, 0);
-      // If 'rowsFromNonSpillingPartitions' is not null, it is used to collect
-      // the rows from non-spilling partitions when finishes spilling.
-      if (FOLLY_UNLIKELY(
-              rowsFromNonSpillingPartitions != nullptr &&
-              !state_.isPartitionSpilled(partition))) {
-        rowsFromNonSpillingPartitions->push_back(rows[i]);
-        continue;
-      }
-      spillRuns_[partition].rows.push_back(rows[i]);
-      spillRuns_[partition].numBytes += container_->rowSize(rows[i]);
-    }
+    addToSpillRuns(
+        folly::Range<char**>(rows.data(), numRows),
+        hashes,
+        rowsFromNonSpillingPartitions);
     if (numRows == 0) {
       break;
     }
   }
 }
 
+void Spiller::addToSpillRuns(
+    folly::Range<char**> rows,
+    std::vector<uint64_t>& hashes,
+    SpillRows* rowsFromNonSpillingPartitions) {
+  VELOX_DCHECK_GE(hashes.size(), rows.size());
+  // Calculate hashes for this batch of spill candidates.
+  for (auto i = 0; i < container_->keyTypes().size(); ++i) {
+    container_->hash(i, rows, i > 0, hashes.data());
+  }
+
+  // Put each in its run.
+  for (auto i = 0; i < rows.size(); ++i) {
+    // TODO: consider to cache the hash bits in row container so we only need
+    // to calculate them once.
+    const auto partition = (type_ == Type::kOrderBy)
+        ? 0
+        : bits_.partition(hashes[i], state_.maxPartitions());
+    VELOX_DCHECK_GE(partition, 0);
+    // If 'rowsFromNonSpillingPartitions' is not null, it is used to collect
+    // the rows from non-spilling partitions when finishes spilling.
+    if (FOLLY_UNLIKELY(
+            rowsFromNonSpillingPartitions != nullptr &&
+            !state_.isPartitionSpilled(partition))) {
+      rowsFromNonSpillingPartitions->push_back(rows[i]);
+      continue;
+    }
+    spillRuns_[partition].rows.push_back(rows[i]);
+    spillRuns_[partition].numBytes += container_->rowSize(rows[i]);
+  }
+}
+
 void Spiller::clearNonSpillingRuns() {
   for (auto partition = 0; partition < spillRuns_.size(); ++partition) {
     if (pendingSpillPartitions_.count(partition) == 0) {
@@ -634,6 +746,8 @@ std::string Spiller::typeName(Type type) {
       return "HASH_JOIN_PROBE";
     case Type::kAggregate:
       return "AGGREGATE";
+    case Type::kPartitionedInput:
+      return "PARTITIONED_INPUT";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
       return fmt::format("UNKNOWN TYPE: {}", static_cast<int>(type));
@@ -641,7 +755,7 @@ std::string Spiller::typeName(Type type) {
 }
 
 void Spiller::fillSpillRuns(std::vector<SpillableStats>& statsList) {
-  if (FOLLY_UNLIKELY(type_ == Type::kHashJoinProbe)) {
+  if (FOLLY_UNLIKELY(container_ == nullptr)) {
     VELOX_FAIL("There is no row container for {}", typeName(type_));
   }
   statsList.resize(state_.maxPartitions());
@@ -33,8 +33,11 @@ class Spiller {
     kHashJoinProbe = 2,
     // Used for order by.
     kOrderBy = 3,
+    // Used for operators which append input vectors to hash partitions
+    // directly such as row number, topN row number and mark distinct.
+    kPartitionedInput = 4,
   };
-  static constexpr int kNumTypes = 4;
+  static constexpr int kNumTypes = 5;
   static std::string typeName(Type);
 
   // Specifies the config for spilling.
@@ -47,7 +50,9 @@ class Spiller {
         int32_t _spillableReservationGrowthPct,
         const HashBitRange& _hashBitRange,
         int32_t _maxSpillLevel,
-        int32_t _testSpillPct)
+        int32_t _testSpillPct,
+        const SpillCodecOptions& _codecOptions = {},
+        std::shared_ptr<SpillTiers> _tiers = nullptr)
         : filePath(_filePath),
           maxFileSize(
               _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -57,7 +62,9 @@ class Spiller {
           spillableReservationGrowthPct(_spillableReservationGrowthPct),
           hashBitRange(_hashBitRange),
           maxSpillLevel(_maxSpillLevel),
-          testSpillPct(_testSpillPct) {}
+          testSpillPct(_testSpillPct),
+          codecOptions(_codecOptions),
+          tiers(std::move(_tiers)) {}
 
     /// Returns the spilling level with given 'startBitOffset'.
     ///
@@ -104,6 +111,14 @@ class Spiller {
     // Percentage of input batches to be spilled for testing. 0 means no
     // spilling for test.
     int32_t testSpillPct;
+
+    // Compression and checksums of the spill files.
+    SpillCodecOptions codecOptions;
+
+    // Places the spill files in local or overflow storage and enforces the
+    // spill quota of the task. If nullptr, all files are written under
+    // 'filePath' without a quota.
+    std::shared_ptr<SpillTiers> tiers;
   };
 
   using SpillRows = std::vector<char*, memory::StlAllocator<char*>>;
@@ -121,7 +136,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr);
 
   Spiller(
       Type type,
@@ -131,7 +148,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr);
 
   Spiller(
       Type type,
@@ -145,7 +164,9 @@ class Spiller {
       uint64_t targetFileSize,
       uint64_t minSpillRunSize,
       memory::MemoryPool& pool,
-      folly::Executor* FOLLY_NULLABLE executor);
+      folly::Executor* FOLLY_NULLABLE executor,
+      const SpillCodecOptions& codecOptions = {},
+      std::shared_ptr<SpillTiers> tiers = nullptr);
 
   /// Spills rows from 'this' until there are under 'targetRows' rows
   /// and 'targetBytes' of allocated variable length space in use. spill()
@@ -171,12 +192,26 @@ class Spiller {
 
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
-  /// hash join build and hash join probe.
+  /// hash join build, hash join probe and the kPartitionedInput spillers.
   ///
   /// NOTE: the spilling operator should first mark 'partition' as spilling and
   /// spill any data buffered in row container before call this.
   void spill(uint32_t partition, const RowVectorPtr& spillVector);
 
+  /// Appends each row of 'input' to the spill file of the partition given by
+  /// the row's entry in 'partitions'. It is only used by the kPartitionedInput
+  /// spiller and all the partitions must already be marked as spilling.
+  void spillPartitioned(
+      const RowVectorPtr& input,
+      const std::vector<uint32_t>& partitions);
+
+  /// Spills all of 'rows' which must be rows of the row container. It is used
+  /// by kOrderBy and kAggregate spillers to spill the rows that have not been
+  /// returned yet once an operator has started producing output. The rows are
+  /// erased from the row container as they are written. All the partitions
+  /// that receive rows are marked as spilling.
+  void spillRows(folly::Range<char**> rows);
+
   /// Contains the amount of spillable data of a partition which includes the
   /// number of spillable rows and bytes.
   struct SpillableStats {
@@ -203,7 +238,8 @@ class Spiller {
     if (FOLLY_UNLIKELY(!needSort())) {
       VELOX_FAIL("Can't sort merge the unsorted spill data: {}", toString());
     }
-    return state_.startMerge(partition, spillMergeStreamOverRows(partition));
+    return state_.startMerge(
+        partition, spillMergeStreamOverRows(partition), executor_);
   }
 
   // Extracts up to 'maxRows' or 'maxBytes' from 'rows' into
@@ -371,6 +407,15 @@ class Spiller {
   void fillSpillRuns(
       SpillRows* FOLLY_NULLABLE rowsFromNonSpillingPartitions = nullptr);
 
+  // Adds 'rows' to the spill runs of their hash partitions. 'hashes' is a
+  // scratch buffer of at least rows.size() entries. If
+  // 'rowsFromNonSpillingPartitions' is not null, the rows from the non-spilling
+  // partitions are collected there instead.
+  void addToSpillRuns(
+      folly::Range<char**> rows,
+      std::vector<uint64_t>& hashes,
+      SpillRows* FOLLY_NULLABLE rowsFromNonSpillingPartitions);
+
   // Picks the next partition to spill. In case of non kHashJoin type, the
   // function picks the partition with spillable data no matter it has spilled
   // or not. For kHashJoin, the function first tries to pick the one from the
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <atomic>
+
 #include "velox/connectors/Connector.h"
 
 namespace facebook::velox::exec {
@@ -22,6 +24,10 @@ namespace facebook::velox::exec {
 struct Split {
   std::shared_ptr<velox::connector::ConnectorSplit> connectorSplit;
   int32_t groupId{-1}; // Bucketed group id (-1 means 'none').
+  // Set if this is a piece of a split that a table scan divided among its
+  // drivers. The number of pieces of the split not yet finished. The split
+  // is finished when its last piece is.
+  std::shared_ptr<std::atomic<int32_t>> numPendingPieces;
 
   Split() = default;
 
@@ -32,19 +38,24 @@ struct Split {
 
   Split(Split&& other)
       : connectorSplit(std::move(other.connectorSplit)),
-        groupId(other.groupId) {}
+        groupId(other.groupId),
+        numPendingPieces(std::move(other.numPendingPieces)) {}
 
   Split(const Split& other)
-      : connectorSplit(other.connectorSplit), groupId(other.groupId) {}
+      : connectorSplit(other.connectorSplit),
+        groupId(other.groupId),
+        numPendingPieces(other.numPendingPieces) {}
 
   void operator=(Split&& other) {
     connectorSplit = std::move(other.connectorSplit);
     groupId = other.groupId;
+    numPendingPieces = std::move(other.numPendingPieces);
   }
 
   void operator=(const Split& other) {
     connectorSplit = other.connectorSplit;
     groupId = other.groupId;
+    numPendingPieces = other.numPendingPieces;
   }
 
   inline bool hasConnectorSplit() const {
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/StreamingAggregation.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/RowContainer.h"
 
 namespace facebook::velox::exec {
@@ -200,40 +201,42 @@ RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
 
 void StreamingAggregation::assignGroups() {
   auto numInput = input_->size();
+  if (numInput == 0) {
+    return;
+  }
 
   inputGroups_.resize(numInput);
 
-  // Look for the end of the last group.
-  vector_size_t index = 0;
-  if (prevInput_) {
-    auto prevIndex = prevInput_->size() - 1;
-    auto* prevGroup = groups_[numGroups_ - 1];
-    for (; index < numInput; ++index) {
-      if (equalKeys(groupingKeys_, prevInput_, prevIndex, input_, index)) {
-        inputGroups_[index] = prevGroup;
-      } else {
-        break;
-      }
-    }
+  for (auto i = 0; i < groupingKeys_.size(); ++i) {
+    decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
   }
 
-  if (index < numInput) {
-    for (auto i = 0; i < groupingKeys_.size(); ++i) {
-      decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
-    }
-
-    auto* newGroup = startNewGroup(index);
-    inputGroups_[index] = newGroup;
+  groupBoundaries_.resize(bits::nwords(numInput));
+  findKeyBoundaries(decodedKeys_, numInput, groupBoundaries_.data());
+
+  // The first run of rows continues the last group if it matches the last row
+  // of the previous input.
+  char* group;
+  if (prevInput_ &&
+      equalKeys(groupingKeys_, prevInput_, prevInput_->size() - 1, input_, 0)) {
+    group = groups_[numGroups_ - 1];
+  } else {
+    group = startNewGroup(0);
+  }
 
-    for (auto i = index + 1; i < numInput; ++i) {
-      if (equalKeys(groupingKeys_, input_, index, input_, i)) {
-        inputGroups_[i] = inputGroups_[index];
-      } else {
-        newGroup = startNewGroup(i);
-        inputGroups_[i] = newGroup;
-        index = i;
-      }
+  vector_size_t start = 0;
+  for (;;) {
+    auto end = bits::findFirstBit(groupBoundaries_.data(), start + 1, numInput);
+    if (end < 0) {
+      end = numInput;
+    }
+    std::fill(
+        inputGroups_.begin() + start, inputGroups_.begin() + end, group);
+    if (end == numInput) {
+      break;
     }
+    group = startNewGroup(end);
+    start = end;
   }
 }
 
@@ -14,11 +14,17 @@
  * limitations under the License.
  */
 #include "velox/exec/TableScan.h"
+#include <cmath>
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
 DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
+DEFINE_int32(
+    split_preload_max_per_driver,
+    8,
+    "Upper limit of splits to prefetch per driver when preloading a split "
+    "takes longer than reading one");
 
 namespace facebook::velox::exec {
 
@@ -45,7 +51,10 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       readBatchSize_(driverCtx_->task->queryCtx()
                          ->queryConfig()
-                         .preferredOutputBatchRows()) {
+                         .preferredOutputBatchRows()),
+      splitPieceSize_(driverCtx_->task->queryCtx()
+                          ->queryConfig()
+                          .tableScanSplitPieceSize()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -54,18 +63,27 @@ RowVectorPtr TableScan::getOutput() {
     return nullptr;
   }
 
+  if (driverCtx_->task->remoteDynamicFiltersVersion() !=
+      remoteDynamicFiltersVersion_) {
+    addRemoteDynamicFilters();
+  }
+
   for (;;) {
     if (needNewSplit_) {
       exec::Split split;
-      blockingReason_ = driverCtx_->task->getSplitOrFuture(
-          driverCtx_->splitGroupId,
-          planNodeId(),
-          split,
-          blockingFuture_,
-          maxPreloadedSplits_,
-          splitPreloader_);
-      if (blockingReason_ != BlockingReason::kNotBlocked) {
-        return nullptr;
+      if (preloadingSplit_.hasConnectorSplit()) {
+        split = std::move(preloadingSplit_);
+      } else {
+        blockingReason_ = driverCtx_->task->getSplitOrFuture(
+            driverCtx_->splitGroupId,
+            planNodeId(),
+            split,
+            blockingFuture_,
+            maxPreloadedSplits_,
+            splitPreloader_);
+        if (blockingReason_ != BlockingReason::kNotBlocked) {
+          return nullptr;
+        }
       }
 
       if (!split.hasConnectorSplit()) {
@@ -91,14 +109,30 @@ RowVectorPtr TableScan::getOutput() {
         return nullptr;
       }
 
-      const auto& connectorSplit = split.connectorSplit;
+      if (split.connectorSplit->dataSource &&
+          !split.connectorSplit->dataSource->isReadyOrFuture(
+              &blockingFuture_)) {
+        // The preload is running on the connector's executor. Go off thread
+        // until it is done instead of blocking the driver thread on it.
+        preloadingSplit_ = std::move(split);
+        blockingReason_ = BlockingReason::kWaitForConnector;
+        addRuntimeStat("waitForPreloadedSplits", RuntimeCounter(1));
+        return nullptr;
+      }
+
       needNewSplit_ = false;
 
       VELOX_CHECK_EQ(
           connector_->connectorId(),
-          connectorSplit->connectorId,
+          split.connectorSplit->connectorId,
           "Got splits with different connector IDs");
 
+      if (split.numPendingPieces == nullptr) {
+        maybeDivideSplit(split);
+      }
+      numPendingPieces_ = std::move(split.numPendingPieces);
+      const auto& connectorSplit = split.connectorSplit;
+
       if (!dataSource_) {
         connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
             connectorSplit->connectorId, planNodeId(), connectorPool_);
@@ -139,6 +173,7 @@ RowVectorPtr TableScan::getOutput() {
       } else {
         dataSource_->addSplit(connectorSplit);
       }
+      splitStartMicros_ = getCurrentTimeMicro();
       ++stats_.wlock()->numSplits;
 
       auto estimatedRowSize = dataSource_->estimatedRowSize();
@@ -160,7 +195,7 @@ RowVectorPtr TableScan::getOutput() {
          },
          &debugString_});
 
-    auto dataOptional = dataSource_->next(readBatchSize_, blockingFuture_);
+    auto dataOptional = dataSource_->next(nextReadSize(), blockingFuture_);
     checkPreload();
 
     {
@@ -200,13 +235,52 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (maxPreloadedSplits_ > 0) {
+        lockedStats->addRuntimeStat(
+            "splitPreloadDepth", RuntimeCounter(preloadDepth()));
+      }
     }
 
-    driverCtx_->task->splitFinished();
+    splitMicros_ += getCurrentTimeMicro() - splitStartMicros_;
+    ++numFinishedSplits_;
+    if (numPendingPieces_ == nullptr || --*numPendingPieces_ == 0) {
+      driverCtx_->task->splitFinished();
+    }
+    numPendingPieces_ = nullptr;
     needNewSplit_ = true;
   }
 }
 
+void TableScan::maybeDivideSplit(exec::Split& split) {
+  // A preloaded split has its data source made for the whole split.
+  if (splitPieceSize_ == 0 || split.connectorSplit->dataSource != nullptr ||
+      driverCtx_->task->numDrivers(driverCtx_->driver) == 1) {
+    return;
+  }
+  auto pieces = connector_->divideSplit(split.connectorSplit, splitPieceSize_);
+  if (pieces.size() <= 1) {
+    return;
+  }
+  // Reads the first piece and leaves the others to the first driver that
+  // needs a split, which may be this one again.
+  auto numPendingPieces = std::make_shared<std::atomic<int32_t>>(pieces.size());
+  std::vector<exec::Split> otherPieces;
+  otherPieces.reserve(pieces.size() - 1);
+  for (auto i = 1; i < pieces.size(); ++i) {
+    otherPieces.emplace_back(std::move(pieces[i]), split.groupId);
+    otherPieces.back().numPendingPieces = numPendingPieces;
+  }
+  split.connectorSplit = std::move(pieces[0]);
+  split.numPendingPieces = std::move(numPendingPieces);
+  driverCtx_->task->addSplitPieces(
+      driverCtx_->splitGroupId, planNodeId(), std::move(otherPieces));
+
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat("dividedSplits", RuntimeCounter(1));
+  lockedStats->addRuntimeStat(
+      "splitPieces", RuntimeCounter(static_cast<int64_t>(pieces.size())));
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -221,10 +295,12 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
        ctx = operatorCtx_->createConnectorQueryCtx(
            split->connectorId, planNodeId(), connectorPool_),
        task = operatorCtx_->task(),
+       timing = preloadTiming_,
        split]() -> std::unique_ptr<connector::DataSource> {
         if (task->isCancelled()) {
           return nullptr;
         }
+        const auto startMicros = getCurrentTimeMicro();
         auto debugString =
             fmt::format("Split {} Task {}", split->toString(), task->taskId());
         ExceptionContextSetter exceptionContext(
@@ -238,19 +314,57 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
           return nullptr;
         }
         ptr->addSplit(split);
+        timing->micros += getCurrentTimeMicro() - startMicros;
+        ++timing->count;
         return ptr;
       });
 }
 
+int32_t TableScan::preloadDepth() const {
+  const int32_t minDepth = FLAGS_split_preload_per_driver;
+  const int32_t maxDepth =
+      std::max(minDepth, FLAGS_split_preload_max_per_driver);
+  const uint64_t numPreloads = preloadTiming_->count;
+  if (numPreloads == 0 || numFinishedSplits_ == 0 || splitMicros_ == 0) {
+    return minDepth;
+  }
+  // A driver consumes a split per 'splitMicros_ / numFinishedSplits_'. To
+  // not wait for the next split, there must be enough splits in preload to
+  // cover the latency of one preload.
+  const double preloadMicros =
+      static_cast<double>(preloadTiming_->micros) / numPreloads;
+  const double splitMicros =
+      static_cast<double>(splitMicros_) / numFinishedSplits_;
+  return std::clamp<int64_t>(
+      std::ceil(preloadMicros / splitMicros), minDepth, maxDepth);
+}
+
+uint64_t TableScan::nextReadSize() {
+  const auto limit = driverCtx_->driver->downstreamRowLimit(this);
+  if (!limit.has_value()) {
+    return readBatchSize_;
+  }
+  constexpr int32_t kMaxShift = 20;
+  const uint64_t size = std::max<int64_t>(limit.value(), 1)
+      << std::min(numLimitedReads_++, kMaxShift);
+  return std::min<uint64_t>(size, readBatchSize_);
+}
+
 void TableScan::checkPreload() {
   auto executor = connector_->executor();
   if (FLAGS_split_preload_per_driver == 0 || !executor ||
       !connector_->supportsSplitPreload()) {
     return;
   }
+  // A scan under a limit of less than a batch most likely stops within the
+  // current split, so splits are not read ahead.
+  const auto limit = driverCtx_->driver->downstreamRowLimit(this);
+  if (limit.has_value() && limit.value() <= readBatchSize_) {
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
-    maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        FLAGS_split_preload_per_driver;
+    maxPreloadedSplits_ =
+        driverCtx_->task->numDrivers(driverCtx_->driver) * preloadDepth();
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor, this](std::shared_ptr<connector::ConnectorSplit> split) {
@@ -274,8 +388,33 @@ void TableScan::addDynamicFilter(
     const std::shared_ptr<common::Filter>& filter) {
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
-  } else {
+    return;
+  }
+  auto it = pendingDynamicFilters_.find(outputChannel);
+  if (it == pendingDynamicFilters_.end()) {
     pendingDynamicFilters_.emplace(outputChannel, filter);
+  } else {
+    it->second = it->second->mergeWith(filter.get());
+  }
+}
+
+void TableScan::addRemoteDynamicFilters() {
+  // Reads the version first so that filters added concurrently are picked up
+  // on the next call.
+  remoteDynamicFiltersVersion_ =
+      driverCtx_->task->remoteDynamicFiltersVersion();
+  if (!canAddDynamicFilter()) {
+    return;
+  }
+  const auto filters = driverCtx_->task->remoteDynamicFilters(planNodeId());
+  for (auto i = numRemoteDynamicFilters_; i < filters.size(); ++i) {
+    addDynamicFilter(filters[i].first, filters[i].second);
+  }
+  if (filters.size() > numRemoteDynamicFilters_) {
+    addRuntimeStat(
+        "remoteDynamicFiltersAccepted",
+        RuntimeCounter(filters.size() - numRemoteDynamicFilters_));
+    numRemoteDynamicFilters_ = filters.size();
   }
 }
 
@@ -19,6 +19,7 @@
 #include "velox/exec/Operator.h"
 
 DECLARE_int32(split_preload_per_driver);
+DECLARE_int32(split_preload_max_per_driver);
 
 namespace facebook::velox::exec {
 
@@ -63,12 +64,33 @@ class TableScan : public SourceOperator {
   // when getting splits.
   void checkPreload();
 
+  // Returns the number of rows to read in the next DataSource::next(). This is
+  // 'readBatchSize_' unless the consumer of the output stops after fewer rows,
+  // e.g. a Limit. In that case the read size starts at the remaining limit
+  // and doubles with each read, in case filters drop most of the rows.
+  uint64_t nextReadSize();
+
+  // Divides 'split' into pieces of about 'splitPieceSize_' bytes if it is
+  // large and the scan has more than one driver. Replaces 'split' with the
+  // first piece and adds the other pieces to the Task for the other drivers.
+  void maybeDivideSplit(exec::Split& split);
+
   // Sets 'split->dataSource' to be a Asyncsource that makes a
   // DataSource to read 'split'. This source will be prepared in the
   // background on the executor of the connector. If the DataSource is
   // needed before prepare is done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Returns the number of splits to preload per driver. This is
+  // FLAGS_split_preload_per_driver unless preloading a split has taken
+  // longer than reading one, in which case the depth grows to the ratio of
+  // the two, up to FLAGS_split_preload_max_per_driver.
+  int32_t preloadDepth() const;
+
+  // Adds the filters added to the Task with addRemoteDynamicFilters() since
+  // the last call.
+  void addRemoteDynamicFilters();
+
   // Process-wide IO wait time.
   static std::atomic<uint64_t> ioWaitNanos_;
 
@@ -81,6 +103,9 @@ class TableScan : public SourceOperator {
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   BlockingReason blockingReason_;
   bool needNewSplit_ = true;
+  // A split taken from the Task whose preload was still running. Read once
+  // the preload is done.
+  exec::Split preloadingSplit_;
   std::shared_ptr<connector::Connector> connector_;
   std::shared_ptr<connector::ConnectorQueryCtx> connectorQueryCtx_;
   std::unique_ptr<connector::DataSource> dataSource_;
@@ -89,6 +114,13 @@ class TableScan : public SourceOperator {
   std::unordered_map<column_index_t, std::shared_ptr<common::Filter>>
       pendingDynamicFilters_;
 
+  // Task::remoteDynamicFiltersVersion() at the last addRemoteDynamicFilters()
+  // call.
+  uint64_t remoteDynamicFiltersVersion_{0};
+
+  // Number of the Task's remote dynamic filters for this scan added so far.
+  size_t numRemoteDynamicFilters_{0};
+
   int32_t maxPreloadedSplits_{0};
 
   // Callback passed to getSplitOrFuture() for triggering async
@@ -105,8 +137,36 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Total time spent in preloading splits and the number of preloads.
+  // Updated from the executor threads, possibly after 'this' is gone.
+  struct PreloadTiming {
+    std::atomic<uint64_t> micros{0};
+    std::atomic<uint64_t> count{0};
+  };
+  std::shared_ptr<PreloadTiming> preloadTiming_{
+      std::make_shared<PreloadTiming>()};
+
+  // Start time of the current split.
+  uint64_t splitStartMicros_{0};
+
+  // Total wall time from adding a split to finishing it in this driver and
+  // the number of finished splits.
+  uint64_t splitMicros_{0};
+  int32_t numFinishedSplits_{0};
+
   int32_t readBatchSize_;
 
+  // Number of reads made with a size capped by a downstream row limit.
+  int32_t numLimitedReads_{0};
+
+  // Byte size of the pieces that large splits are divided into. 0 if splits
+  // are not divided.
+  const uint64_t splitPieceSize_;
+
+  // Set if the current split is a piece of a divided split. The number of
+  // pieces of that split that are not finished.
+  std::shared_ptr<std::atomic<int32_t>> numPendingPieces_;
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
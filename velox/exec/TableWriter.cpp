@@ -29,7 +29,10 @@ TableWriter::TableWriter(
           tableWriteNode->outputType(),
           operatorId,
           tableWriteNode->id(),
-          "TableWrite"),
+          "TableWrite",
+          tableWriteNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       driverCtx_(driverCtx),
       connectorPool_(driverCtx_->task->addConnectorPoolLocked(
           planNodeId(),
@@ -43,7 +46,10 @@ TableWriter::TableWriter(
   const auto& connectorId = tableWriteNode->insertTableHandle()->connectorId();
   connector_ = connector::getConnector(connectorId);
   connectorQueryCtx_ = operatorCtx_->createConnectorQueryCtx(
-      connectorId, planNodeId(), connectorPool_);
+      connectorId,
+      planNodeId(),
+      connectorPool_,
+      spillConfig_.has_value() ? &spillConfig_.value() : nullptr);
 
   auto names = tableWriteNode->columnNames();
   auto types = tableWriteNode->columns()->children();
@@ -89,10 +95,36 @@ void TableWriter::addInput(RowVectorPtr input) {
   if (!dataSink_) {
     createDataSink();
   }
-  dataSink_->appendData(mappedInput);
+  {
+    // Prevents the memory arbitrator from flushing the data sink in the middle
+    // of a write.
+    NonReclaimableSection guard(this);
+    dataSink_->appendData(mappedInput);
+  }
   numWrittenRows_ += input->size();
 }
 
+bool TableWriter::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim() || closed_) {
+    return false;
+  }
+  // The data sink buffers its data in the connector pool.
+  reclaimableBytes = connectorPool_->reservedBytes();
+  return true;
+}
+
+void TableWriter::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+  if (closed_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from table writer operator, closed_["
+                 << closed_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+  dataSink_->reclaim(targetBytes);
+}
+
 RowVectorPtr TableWriter::getOutput() {
   // Making sure the output is read only once after the write is fully done.
   if (!noMoreInput_ || finished_) {
@@ -114,6 +146,10 @@ RowVectorPtr TableWriter::getOutput() {
   }
 
   std::vector<std::string> fragments = dataSink_->finish();
+  // Each fragment describes the file of one writer of the data sink.
+  stats_.wlock()->addRuntimeStat(
+      "numWrittenFiles",
+      RuntimeCounter(static_cast<int64_t>(fragments.size())));
 
   vector_size_t numOutputRows = fragments.size() + 1;
 
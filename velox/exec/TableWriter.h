@@ -39,6 +39,9 @@ class TableWriter : public Operator {
 
   void noMoreInput() override {
     Operator::noMoreInput();
+    // Prevents the memory arbitrator from reclaiming from the data sink while
+    // it writes out and closes its files.
+    NonReclaimableSection guard(this);
     close();
   }
 
@@ -61,6 +64,17 @@ class TableWriter : public Operator {
     return finished_;
   }
 
+  // The spill config is only passed on to the data sink, which spills the
+  // rows it buffers by itself. The memory arbitrator reclaims from the data
+  // sink, e.g. by flushing the file writers.
+  bool canReclaim() const override {
+    return dataSink_ != nullptr && dataSink_->canReclaim();
+  }
+
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   void createDataSink();
 
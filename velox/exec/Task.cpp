@@ -13,21 +13,26 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <boost/lexical_cast.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <map>
 #include <string>
 
+#include <folly/synchronization/CallOnce.h>
+
 #include "velox/codegen/Codegen.h"
+#include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/time/Timer.h"
 #include "velox/exec/Exchange.h"
 #include "velox/exec/HashBuild.h"
+#include "velox/exec/InputCapture.h"
 #include "velox/exec/LocalPlanner.h"
 #include "velox/exec/Merge.h"
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/exec/RoundRobinPartitionFunction.h"
 #include "velox/exec/Task.h"
 #if CODEGEN_ENABLED == 1
 #include "velox/experimental/codegen/CodegenLogger.h"
@@ -153,13 +158,53 @@ std::unordered_map<core::PlanNodeId, SplitsState> buildSplitStates(
 }
 
 std::string makeUuid() {
-  return boost::lexical_cast<std::string>(boost::uuids::random_generator()());
+  // Seeding a generator is a large part of the cost of making a Task, so each
+  // thread keeps one.
+  thread_local boost::uuids::random_generator generator;
+  return boost::uuids::to_string(generator());
 }
 
 // Returns true if an operator is a hash join operator given 'operatorType'.
 bool isHashJoinOperator(const std::string& operatorType) {
   return (operatorType == "HashBuild") || (operatorType == "HashProbe");
 }
+
+// Returns true if the consumers of the local exchange 'planNode' share a
+// single queue. Only round robin assigns no row to a particular consumer.
+bool isWorkStealingExchange(
+    const core::PlanNodePtr& planNode,
+    const core::QueryConfig& config) {
+  if (!config.localExchangeWorkStealing()) {
+    return false;
+  }
+  auto localPartition =
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(planNode);
+  return localPartition != nullptr &&
+      dynamic_cast<const RoundRobinPartitionFunctionSpec*>(
+          &localPartition->partitionFunctionSpec()) != nullptr;
+}
+
+// Returns true if the consumers of the round robin local exchange at the
+// start of 'planNodes' are table writers to scale with the amount of data.
+bool isScaledWriterExchange(
+    const std::vector<core::PlanNodePtr>& planNodes,
+    const core::QueryConfig& config) {
+  if (!config.scaleWriters()) {
+    return false;
+  }
+  auto localPartition =
+      std::dynamic_pointer_cast<const core::LocalPartitionNode>(
+          planNodes.front());
+  if (localPartition == nullptr ||
+      dynamic_cast<const RoundRobinPartitionFunctionSpec*>(
+          &localPartition->partitionFunctionSpec()) == nullptr) {
+    return false;
+  }
+  return std::any_of(planNodes.begin(), planNodes.end(), [](const auto& node) {
+    return std::dynamic_pointer_cast<const core::TableWriteNode>(node) !=
+        nullptr;
+  });
+}
 } // namespace
 
 std::string taskStateString(TaskState state) {
@@ -307,17 +352,36 @@ bool Task::allNodesReceivedNoMoreSplitsMessageLocked() const {
 }
 
 void Task::removeSpillDirectoryIfExists() {
-  if (!spillDirectory_.empty()) {
+  for (const auto* directory : {&spillDirectory_, &spillOverflowDirectory_}) {
+    if (directory->empty()) {
+      continue;
+    }
     try {
-      auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-      fs->rmdir(spillDirectory_);
+      auto fs = filesystems::getFileSystem(*directory, nullptr);
+      fs->rmdir(*directory);
     } catch (const std::exception& e) {
-      LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
+      LOG(ERROR) << "Failed to remove spill directory '" << *directory
                  << "' for Task " << taskId() << ": " << e.what();
     }
   }
 }
 
+std::shared_ptr<SpillTiers> Task::spillTiers() {
+  std::call_once(spillTiersOnce_, [&]() {
+    const auto& queryConfig = queryCtx_->queryConfig();
+    if (spillDirectory_.empty() ||
+        (spillOverflowDirectory_.empty() && queryConfig.maxSpillBytes() == 0)) {
+      return;
+    }
+    spillTiers_ = std::make_shared<SpillTiers>(
+        spillDirectory_,
+        spillOverflowDirectory_,
+        queryConfig.maxLocalSpillBytes(),
+        queryConfig.maxSpillBytes());
+  });
+  return spillTiers_;
+}
+
 void Task::initTaskPool() {
   VELOX_CHECK_NULL(pool_);
   pool_ = queryCtx_->pool()->addAggregateChild(
@@ -550,6 +614,22 @@ void Task::start(
     VELOX_CHECK(self->drivers_.empty());
     self->concurrentSplitGroups_ = concurrentSplitGroups;
     self->taskStats_.executionStartTimeMs = getCurrentTimeMs();
+    if (const auto maxEvents =
+            self->queryCtx()->queryConfig().taskTraceMaxEvents()) {
+      self->trace_ = std::make_unique<TaskTrace>(maxEvents);
+    }
+    if (const auto maxEvents =
+            self->queryCtx()->queryConfig().memoryTimelineMaxEvents()) {
+      self->memoryTimeline_ = std::make_unique<MemoryTimeline>(
+          maxEvents,
+          self->queryCtx()->queryConfig().memoryTimelineSampleIntervalMs());
+    }
+    if (InputCapture::enabled(self->queryCtx()->queryConfig())) {
+      InputCapture::savePlan(
+          self->queryCtx()->queryConfig(),
+          self->taskId_,
+          *self->planFragment_.planNode);
+    }
 
 #if CODEGEN_ENABLED == 1
     const auto& config = self->queryCtx()->queryConfig();
@@ -687,15 +767,24 @@ void Task::start(
     if (dynamic_cast<const folly::InlineLikeExecutor*>(
             self->queryCtx()->executor())) {
       l.unlock();
+    } else if (self->queryCtx()
+                   ->queryConfig()
+                   .tableScanAdaptiveDriversEnabled()) {
+      // Deferred Drivers are enqueued later inside 'mutex_', which an inline
+      // executor does not allow.
+      self->deferTableScanDriversLocked();
     }
     // We might have first slots taken for grouped execution drivers, so need
-    // only to enqueue the ungrouped execution drivers.
+    // only to enqueue the ungrouped execution drivers. Deferred Drivers count
+    // as running since they are not finished.
     for (auto it = self->drivers_.end() - self->numDriversUngrouped_;
          it != self->drivers_.end();
          ++it) {
       if (*it) {
         ++self->numRunningDrivers_;
-        Driver::enqueue(*it);
+        if (!(*it)->state().isDeferred) {
+          Driver::enqueue(*it);
+        }
       }
     }
   }
@@ -724,10 +813,11 @@ void Task::resume(std::shared_ptr<Task> self) {
         // the cancel flag is reset. This check needs to be inside 'mutex_'.
         continue;
       }
-      if (driver->state().isEnqueued) {
+      if (driver->state().isEnqueued || driver->state().isDeferred) {
         // A Driver can wait for a thread and there can be a
         // pause/resume during the wait. The Driver should not be
-        // enqueued twice.
+        // enqueued twice. A deferred Driver is enqueued when there is
+        // work for it.
         continue;
       }
       VELOX_CHECK(!driver->isOnThread() && !driver->isTerminated());
@@ -796,8 +886,16 @@ void Task::createSplitGroupStateLocked(uint32_t splitGroupId) {
 
     auto exchangeId = factory->needsLocalExchange();
     if (exchangeId.has_value()) {
+      const auto& config = queryCtx_->queryConfig();
+      const bool scaleWriters =
+          isScaledWriterExchange(factory->planNodes, config);
       createLocalExchangeQueuesLocked(
-          splitGroupId, exchangeId.value(), factory->numDrivers);
+          splitGroupId,
+          exchangeId.value(),
+          factory->numDrivers,
+          scaleWriters ||
+              isWorkStealingExchange(factory->planNodes.front(), config),
+          scaleWriters);
     }
 
     addHashJoinBridgesLocked(splitGroupId, factory->needsHashJoinBridges());
@@ -977,6 +1075,74 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked(
   }
 }
 
+void Task::deferTableScanDriversLocked() {
+  // The number of Drivers to start per scan node.
+  std::unordered_map<core::PlanNodeId, size_t> numToStart;
+  for (auto it = drivers_.end() - numDriversUngrouped_; it != drivers_.end();
+       ++it) {
+    auto& driver = *it;
+    if (driver == nullptr) {
+      continue;
+    }
+    const auto& factory = driverFactories_[driver->driverCtx()->pipelineId];
+    if (factory->numDrivers < 2 ||
+        !std::dynamic_pointer_cast<const core::TableScanNode>(
+            factory->planNodes.front())) {
+      continue;
+    }
+    const auto& planNodeId = factory->leafNodeId();
+    auto [startIt, inserted] = numToStart.emplace(planNodeId, 1);
+    if (inserted) {
+      // Splits can be added before start.
+      auto splitsIt = splitsStates_.find(planNodeId);
+      if (splitsIt != splitsStates_.end()) {
+        const auto& splitsState = splitsIt->second;
+        auto storeIt = splitsState.groupSplitsStores.find(kUngroupedGroupId);
+        if (splitsState.noMoreSplits) {
+          startIt->second = factory->numDrivers;
+        } else if (storeIt != splitsState.groupSplitsStores.end()) {
+          startIt->second = std::max<size_t>(
+              1,
+              storeIt->second.splits.size() +
+                  storeIt->second.splitPieces.size());
+        }
+      }
+    }
+    if (startIt->second > 0) {
+      --startIt->second;
+      continue;
+    }
+    driver->state().isDeferred = true;
+    deferredDrivers_[planNodeId].push_back(driver);
+    ++taskStats_.numDeferredDrivers;
+  }
+}
+
+void Task::startDeferredDriversLocked(
+    const core::PlanNodeId& planNodeId,
+    size_t count,
+    bool forSplits) {
+  auto it = deferredDrivers_.find(planNodeId);
+  if (it == deferredDrivers_.end()) {
+    return;
+  }
+  auto& drivers = it->second;
+  for (; count > 0 && !drivers.empty(); --count) {
+    auto driver = std::move(drivers.back());
+    drivers.pop_back();
+    driver->state().isDeferred = false;
+    if (forSplits) {
+      ++taskStats_.numDeferredDriversStartedForSplits;
+    }
+    if (!driver->isTerminated()) {
+      Driver::enqueue(driver);
+    }
+  }
+  if (drivers.empty()) {
+    deferredDrivers_.erase(it);
+  }
+}
+
 void Task::setMaxSplitSequenceId(
     const core::PlanNodeId& planNodeId,
     long maxSequenceId) {
@@ -1008,6 +1174,10 @@ bool Task::addSplitWithSequence(
       if (sequenceId > splitsState.maxSequenceId) {
         promise = addSplitLocked(splitsState, std::move(split));
         added = true;
+        if (promise == nullptr) {
+          // No Driver waits for a split.
+          startDeferredDriversLocked(planNodeId, 1, true);
+        }
       }
     }
   }
@@ -1032,6 +1202,10 @@ void Task::addSplit(const core::PlanNodeId& planNodeId, exec::Split&& split) {
     if (isTaskRunning) {
       promise = addSplitLocked(
           getPlanNodeSplitsStateLocked(planNodeId), std::move(split));
+      if (promise == nullptr) {
+        // No Driver waits for a split.
+        startDeferredDriversLocked(planNodeId, 1, true);
+      }
     }
   }
 
@@ -1091,7 +1265,23 @@ std::unique_ptr<ContinuePromise> Task::addSplitLocked(
 std::unique_ptr<ContinuePromise> Task::addSplitToStoreLocked(
     SplitsStore& splitsStore,
     exec::Split&& split) {
-  splitsStore.splits.push_back(split);
+  const auto weight =
+      split.connectorSplit ? split.connectorSplit->splitWeight : 0;
+  if (weight > 0 && queryCtx_->queryConfig().tableScanLargestSplitFirst()) {
+    // Splits of unknown weight go to the back, so 'splits' stays ordered by
+    // decreasing weight.
+    auto it = std::upper_bound(
+        splitsStore.splits.begin(),
+        splitsStore.splits.end(),
+        weight,
+        [](uint64_t weight, const exec::Split& other) {
+          return other.connectorSplit == nullptr ||
+              weight > other.connectorSplit->splitWeight;
+        });
+    splitsStore.splits.insert(it, split);
+  } else {
+    splitsStore.splits.push_back(split);
+  }
   if (splitsStore.splitPromises.empty()) {
     return nullptr;
   }
@@ -1101,6 +1291,32 @@ std::unique_ptr<ContinuePromise> Task::addSplitToStoreLocked(
   return promise;
 }
 
+void Task::addSplitPieces(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId,
+    std::vector<exec::Split>&& pieces) {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto& splitsStore = getPlanNodeSplitsStateLocked(planNodeId)
+                            .groupSplitsStores[splitGroupId];
+    // Wakes up the drivers that wait for splits, one per piece.
+    while (!splitsStore.splitPromises.empty() &&
+           promises.size() < pieces.size()) {
+      promises.push_back(std::move(splitsStore.splitPromises.back()));
+      splitsStore.splitPromises.pop_back();
+    }
+    for (auto& piece : pieces) {
+      splitsStore.splitPieces.push_back(std::move(piece));
+    }
+    startDeferredDriversLocked(
+        planNodeId, pieces.size() - promises.size(), true);
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
 void Task::noMoreSplitsForGroup(
     const core::PlanNodeId& planNodeId,
     int32_t splitGroupId) {
@@ -1152,6 +1368,10 @@ void Task::noMoreSplits(const core::PlanNodeId& planNodeId) {
           kUngroupedGroupId, SplitsStore{{}, true, {}});
     }
 
+    // The deferred Drivers finish once they see there are no more splits.
+    startDeferredDriversLocked(
+        planNodeId, std::numeric_limits<size_t>::max(), false);
+
     allFinished = checkNoMoreSplitGroupsLocked();
 
     if (!isRunningLocked()) {
@@ -1223,6 +1443,11 @@ BlockingReason Task::getSplitOrFutureLocked(
     ContinueFuture& future,
     int32_t maxPreloadSplits,
     std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload) {
+  if (!splitsStore.splitPieces.empty()) {
+    split = std::move(splitsStore.splitPieces.front());
+    splitsStore.splitPieces.pop_front();
+    return BlockingReason::kNotBlocked;
+  }
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -1515,6 +1740,104 @@ std::shared_ptr<HashJoinBridge> Task::getHashJoinBridgeLocked(
   return getJoinBridgeInternalLocked<HashJoinBridge>(splitGroupId, planNodeId);
 }
 
+std::optional<folly::dynamic> Task::exportJoinFilters(
+    const core::PlanNodeId& joinNodeId,
+    uint32_t splitGroupId) {
+  const auto* joinNode = dynamic_cast<const core::HashJoinNode*>(
+      core::PlanNode::findFirstNode(
+          planFragment_.planNode.get(), [&](const core::PlanNode* node) {
+            return node->id() == joinNodeId;
+          }));
+  VELOX_USER_CHECK_NOT_NULL(
+      joinNode,
+      "Hash join plan node {} not found in task {}",
+      joinNodeId,
+      taskId());
+  // Only the join types that drop the probe rows without a match.
+  if (!joinNode->isInnerJoin() && !joinNode->isLeftSemiFilterJoin() &&
+      !joinNode->isRightSemiFilterJoin() &&
+      !joinNode->isRightSemiProjectJoin()) {
+    return std::nullopt;
+  }
+
+  std::shared_ptr<HashJoinBridge> bridge;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto groupIt = splitGroupStates_.find(splitGroupId);
+    if (groupIt == splitGroupStates_.end()) {
+      return std::nullopt;
+    }
+    auto bridgeIt = groupIt->second.bridges.find(joinNodeId);
+    if (bridgeIt == groupIt->second.bridges.end()) {
+      return std::nullopt;
+    }
+    bridge = std::dynamic_pointer_cast<HashJoinBridge>(bridgeIt->second);
+  }
+  VELOX_CHECK_NOT_NULL(bridge);
+
+  auto filters = bridge->joinKeyFilters();
+  if (!filters.has_value()) {
+    return std::nullopt;
+  }
+  folly::dynamic serialized = folly::dynamic::array;
+  for (const auto& filter : filters.value()) {
+    serialized.push_back(filter ? filter->serialize() : folly::dynamic());
+  }
+  return serialized;
+}
+
+void Task::addRemoteDynamicFilters(
+    const core::PlanNodeId& scanNodeId,
+    const folly::dynamic& filters) {
+  static folly::once_flag kOnce;
+  folly::call_once(kOnce, []() { common::Filter::registerSerDe(); });
+
+  const auto* scanNode = dynamic_cast<const core::TableScanNode*>(
+      core::PlanNode::findFirstNode(
+          planFragment_.planNode.get(), [&](const core::PlanNode* node) {
+            return node->id() == scanNodeId;
+          }));
+  VELOX_USER_CHECK_NOT_NULL(
+      scanNode,
+      "Table scan plan node {} not found in task {}",
+      scanNodeId,
+      taskId());
+  VELOX_USER_CHECK(filters.isObject(), "Dynamic filters must be an object");
+
+  std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>
+      newFilters;
+  for (const auto& [name, serialized] : filters.items()) {
+    const auto channel =
+        scanNode->outputType()->getChildIdxIfExists(name.asString());
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Column {} not found in the output of table scan {}",
+        name.asString(),
+        scanNodeId);
+    newFilters.emplace_back(
+        channel.value(),
+        ISerializable::deserialize<common::Filter>(serialized)->clone());
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& scanFilters = remoteDynamicFilters_[scanNodeId];
+  scanFilters.insert(
+      scanFilters.end(),
+      std::make_move_iterator(newFilters.begin()),
+      std::make_move_iterator(newFilters.end()));
+  ++remoteDynamicFiltersVersion_;
+}
+
+std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>
+Task::remoteDynamicFilters(const core::PlanNodeId& scanNodeId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = remoteDynamicFilters_.find(scanNodeId);
+  if (it == remoteDynamicFilters_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
 std::shared_ptr<NestedLoopJoinBridge> Task::getNestedLoopJoinBridge(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId) {
@@ -1634,6 +1957,7 @@ ContinueFuture Task::terminate(TaskState terminalState) {
         }
       }
     }
+    deferredDrivers_.clear();
     exchangeClients.swap(exchangeClients_);
   }
 
@@ -1768,6 +2092,9 @@ TaskStats Task::taskStats() const {
   TaskStats taskStats = taskStats_;
 
   taskStats.numTotalDrivers = drivers_.size();
+  taskStats.driverCpuNanos = driverCpuNanos_;
+  taskStats.driverWallNanos = driverWallNanos_;
+  taskStats.numDriverYields = numDriverYields_;
 
   // Add stats of the drivers (their operators) that are still running.
   for (const auto& driver : drivers_) {
@@ -1793,10 +2120,59 @@ TaskStats Task::taskStats() const {
       ++taskStats.numBlockedDrivers[driver->blockingReason()];
     }
   }
+  if (memoryTimeline_ != nullptr) {
+    taskStats.memoryTimeline = memoryTimeline_->events();
+  }
 
   return taskStats;
 }
 
+void Task::maybeSampleMemory(uint64_t nowMs) {
+  if (memoryTimeline_ == nullptr || !memoryTimeline_->startSample(nowMs)) {
+    return;
+  }
+  // Reserved bytes by pipeline and operator id.
+  std::map<std::pair<int32_t, int32_t>, int64_t> reservations;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    for (const auto& driver : drivers_) {
+      if (driver == nullptr) {
+        continue;
+      }
+      for (auto* op : driver->operators()) {
+        reservations[{driver->driverCtx()->pipelineId, op->operatorId()}] +=
+            op->pool()->reservedBytes();
+      }
+    }
+  }
+  for (const auto& [id, bytes] : reservations) {
+    memoryTimeline_->record(
+        {MemoryTimelineEvent::Kind::kReservation,
+         id.first,
+         id.second,
+         nowMs,
+         bytes});
+  }
+  if (auto* cache =
+          dynamic_cast<cache::AsyncDataCache*>(queryCtx_->allocator())) {
+    memoryTimeline_->record(
+        {MemoryTimelineEvent::Kind::kCachePressure,
+         -1,
+         -1,
+         nowMs,
+         static_cast<int64_t>(
+             cache->cachedPages() * memory::AllocationTraits::kPageSize)});
+  }
+}
+
+std::string Task::toChromeTrace() const {
+  VELOX_USER_CHECK_NOT_NULL(
+      trace_,
+      "Task trace is not enabled, see {}",
+      core::QueryConfig::kTaskTraceMaxEvents);
+  return trace_->toChromeTrace(taskId_);
+}
+
 uint64_t Task::timeSinceStartMs() const {
   std::lock_guard<std::mutex> l(mutex_);
   return timeSinceStartMsLocked();
@@ -1934,7 +2310,9 @@ std::shared_ptr<MergeJoinSource> Task::getMergeJoinSource(
 void Task::createLocalExchangeQueuesLocked(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
-    int numPartitions) {
+    int numPartitions,
+    bool workStealing,
+    bool scaleWriters) {
   auto& splitGroupState = splitGroupStates_[splitGroupId];
   VELOX_CHECK(
       splitGroupState.localExchanges.find(planNodeId) ==
@@ -1948,6 +2326,27 @@ void Task::createLocalExchangeQueuesLocked(
   exchange.memoryManager = std::make_shared<LocalExchangeMemoryManager>(
       queryCtx_->queryConfig().maxLocalExchangeBufferSize());
 
+  if (workStealing) {
+    // Consumers take whole vectors from one queue in arrival order.
+    exchange.workStealing = true;
+    exchange.queues.emplace_back(std::make_shared<LocalExchangeQueue>(
+        exchange.memoryManager, 0, numPartitions));
+    if (scaleWriters) {
+      // Another writer starts when half of the exchange buffer backs up,
+      // unless the query is close to its memory limit.
+      const auto& config = queryCtx_->queryConfig();
+      const double maxMemoryRatio = config.scaleWriterMaxMemoryUsageRatio();
+      exchange.queues.back()->enableScaling(
+          std::max<int64_t>(1, config.maxLocalExchangeBufferSize() / 2),
+          [pool = queryCtx_->pool(), maxMemoryRatio]() {
+            return pool->currentBytes() <
+                maxMemoryRatio * static_cast<double>(pool->maxCapacity());
+          });
+    }
+    splitGroupState.localExchanges.insert({planNodeId, std::move(exchange)});
+    return;
+  }
+
   exchange.queues.reserve(numPartitions);
   for (auto i = 0; i < numPartitions; ++i) {
     exchange.queues.emplace_back(
@@ -1971,6 +2370,11 @@ std::shared_ptr<LocalExchangeQueue> Task::getLocalExchangeQueue(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
     int partition) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+  auto it = splitGroupState.localExchanges.find(planNodeId);
+  if (it != splitGroupState.localExchanges.end() && it->second.workStealing) {
+    return it->second.queues[0];
+  }
   const auto& queues = getLocalExchangeQueues(splitGroupId, planNodeId);
   VELOX_CHECK_LT(
       partition,
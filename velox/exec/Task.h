@@ -18,10 +18,12 @@
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/LocalPartition.h"
+#include "velox/exec/MemoryTimeline.h"
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/exec/TaskTrace.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -72,6 +74,13 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectory_ = spillDirectory;
   }
 
+  /// Specify a directory, typically on a remote file system, to which data is
+  /// spilled once the spill directory holds QueryConfig::maxLocalSpillBytes()
+  /// of spill files.
+  void setSpillOverflowDirectory(const std::string& spillOverflowDirectory) {
+    spillOverflowDirectory_ = spillOverflowDirectory;
+  }
+
   std::string toString() const;
 
   /// Returns universally unique identifier of the task.
@@ -193,6 +202,38 @@ class Task : public std::enable_shared_from_this<Task> {
   /// corresponding to plan node with specified ID.
   void noMoreSplits(const core::PlanNodeId& planNodeId);
 
+  /// Returns the filters on the build side join keys of the hash join
+  /// 'joinNodeId' serialized with Filter::serialize(). Element i is the filter
+  /// on the i-th join key or null if the key has no filter. These can be
+  /// relayed to the probe side scans in other tasks with
+  /// addRemoteDynamicFilters(). Returns std::nullopt if the build side table
+  /// is not ready yet or can't be used to filter the probe side, e.g. because
+  /// of the join type or spilling.
+  std::optional<folly::dynamic> exportJoinFilters(
+      const core::PlanNodeId& joinNodeId,
+      uint32_t splitGroupId = kUngroupedGroupId);
+
+  /// Adds dynamic filters produced outside of this task, e.g. by the hash
+  /// join build of a remote task, to the TableScan 'scanNodeId'. 'filters'
+  /// is an object that maps output column names of the scan to filters
+  /// serialized with Filter::serialize(). The filters are applied to the
+  /// running scans and the ones created later.
+  void addRemoteDynamicFilters(
+      const core::PlanNodeId& scanNodeId,
+      const folly::dynamic& filters);
+
+  /// Returns the number of addRemoteDynamicFilters() calls so far. Used by the
+  /// TableScan operators to check for new filters without locking.
+  uint64_t remoteDynamicFiltersVersion() const {
+    return remoteDynamicFiltersVersion_;
+  }
+
+  /// Returns the filters added with addRemoteDynamicFilters() for the
+  /// TableScan 'scanNodeId' in the order these were added. Each filter is on
+  /// an output channel of the scan.
+  std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>
+  remoteDynamicFilters(const core::PlanNodeId& scanNodeId) const;
+
   /// Updates the total number of output buffers to broadcast or arbitrarily
   /// distribute the results of the execution to. Used when plan tree ends with
   /// a PartitionedOutputNode with broadcast of arbitrary output type.
@@ -337,6 +378,15 @@ class Task : public std::enable_shared_from_this<Task> {
 
   void multipleSplitsFinished(int32_t numSplits);
 
+  /// Adds the pieces of a split that a driver of the source operator of
+  /// 'planNodeId' has divided. The other drivers get these before new
+  /// splits. The pieces are not new splits: the split is finished once when
+  /// all its pieces are finished.
+  void addSplitPieces(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId,
+      std::vector<exec::Split>&& pieces);
+
   /// Adds a MergeSource for the specified splitGroupId and planNodeId.
   std::shared_ptr<MergeSource> addLocalMergeSource(
       uint32_t splitGroupId,
@@ -356,10 +406,16 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  /// Creates 'numPartitions' queues for the local exchange 'planNodeId', or a
+  /// single queue shared by all consumers if 'workStealing' is true. If
+  /// 'scaleWriters' is true, the shared queue activates its consumers as the
+  /// data backs up.
   void createLocalExchangeQueuesLocked(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
-      int numPartitions);
+      int numPartitions,
+      bool workStealing,
+      bool scaleWriters = false);
 
   void noMoreLocalExchangeProducers(uint32_t splitGroupId);
 
@@ -539,6 +595,43 @@ class Task : public std::enable_shared_from_this<Task> {
   /// 'this' at the time of requesting yield. Returns 0 if yield not requested.
   int32_t yieldIfDue(uint64_t startTimeMicros);
 
+  /// Adds the CPU and wall time of one run of a Driver of 'this' on an
+  /// executor thread. 'yielded' is true if the Driver went off thread to let
+  /// other Drivers run.
+  void addDriverTiming(const CpuWallTiming& timing, bool yielded) {
+    driverCpuNanos_ += timing.cpuNanos;
+    driverWallNanos_ += timing.wallNanos;
+    if (yielded) {
+      ++numDriverYields_;
+    }
+  }
+
+  /// Returns the trace of Driver events or nullptr if
+  /// QueryConfig::taskTraceMaxEvents() is 0. Set at start.
+  TaskTrace* trace() const {
+    return trace_.get();
+  }
+
+  /// Returns the memory timeline or nullptr if
+  /// QueryConfig::memoryTimelineMaxEvents() is 0. Set at start.
+  MemoryTimeline* memoryTimeline() const {
+    return memoryTimeline_.get();
+  }
+
+  /// Records the reservations of all operators, summed over the Drivers of
+  /// each pipeline, and the size of the AsyncDataCache into the memory
+  /// timeline if a sample is due at 'nowMs'.
+  void maybeSampleMemory(uint64_t nowMs);
+
+  /// Returns the trace of Driver events in the Chrome trace event JSON
+  /// format. Throws if the trace is not enabled.
+  std::string toChromeTrace() const;
+
+  /// Returns the CPU time used by Drivers of 'this' on executor threads.
+  uint64_t driverCpuNanos() const {
+    return driverCpuNanos_;
+  }
+
   /// Once 'pauseRequested_' is set, it will not be cleared until
   /// task::resume(). It is therefore OK to read it without a mutex
   /// from a thread that this flag concerns.
@@ -569,6 +662,14 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  const std::string& spillOverflowDirectory() const {
+    return spillOverflowDirectory_;
+  }
+
+  /// Returns the spill tiers shared by the spillers of this task, or nullptr
+  /// if the task has neither a spill overflow directory nor a spill quota.
+  std::shared_ptr<SpillTiers> spillTiers();
+
   /// True if produces output via PartitionedOutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -736,6 +837,18 @@ class Task : public std::enable_shared_from_this<Task> {
   /// processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked(std::shared_ptr<Task>& self);
 
+  /// Holds back the ungrouped Drivers of table scan pipelines beyond one per
+  /// queued split. Called at start before the Drivers are enqueued.
+  void deferTableScanDriversLocked();
+
+  /// Enqueues up to 'count' deferred Drivers of the pipeline whose leaf node is
+  /// 'planNodeId'. 'forSplits' is true if the Drivers are started because of
+  /// queued splits.
+  void startDeferredDriversLocked(
+      const core::PlanNodeId& planNodeId,
+      size_t count,
+      bool forSplits);
+
   void driverClosedLocked();
 
   /// Returns true if Task is in kRunning state, but all output drivers finished
@@ -885,6 +998,16 @@ class Task : public std::enable_shared_from_this<Task> {
   std::exception_ptr exception_ = nullptr;
   mutable std::mutex mutex_;
 
+  // Filters added by addRemoteDynamicFilters() keyed by the TableScan plan
+  // node ID. Protected by 'mutex_'.
+  std::unordered_map<
+      core::PlanNodeId,
+      std::vector<std::pair<column_index_t, std::shared_ptr<common::Filter>>>>
+      remoteDynamicFilters_;
+
+  // Incremented on each update of 'remoteDynamicFilters_'.
+  std::atomic<uint64_t> remoteDynamicFiltersVersion_{0};
+
   // Exchange clients. One per pipeline / source. Null for pipelines, which
   // don't need it.
   //
@@ -968,6 +1091,11 @@ class Task : public std::enable_shared_from_this<Task> {
   /// manage splits of the plan nodes that expect splits.
   std::unordered_map<core::PlanNodeId, SplitsState> splitsStates_;
 
+  /// Drivers of table scan pipelines that are in 'drivers_' but have not been
+  /// enqueued yet, keyed on the id of the scan node.
+  std::unordered_map<core::PlanNodeId, std::vector<std::shared_ptr<Driver>>>
+      deferredDrivers_;
+
   // Promises that are fulfilled when the task is completed (terminated).
   std::vector<ContinuePromise> taskCompletionPromises_;
 
@@ -1001,6 +1129,13 @@ class Task : public std::enable_shared_from_this<Task> {
   // one thread running. Used to decide if continuous run should be
   // interrupted by yieldIfDue().
   tsan_atomic<uint64_t> onThreadSince_{0};
+  // CPU and wall time of Drivers on executor threads and the number of yields.
+  // Updated outside 'mutex_' after each Driver run.
+  std::atomic<uint64_t> driverCpuNanos_{0};
+  std::atomic<uint64_t> driverWallNanos_{0};
+  std::atomic<uint64_t> numDriverYields_{0};
+  std::unique_ptr<TaskTrace> trace_;
+  std::unique_ptr<MemoryTimeline> memoryTimeline_;
   // Promises for the futures returned to callers of requestPause() or
   // terminate(). They are fulfilled when the last thread stops
   // running for 'this'.
@@ -1008,6 +1143,12 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Base spill directory for this task.
   std::string spillDirectory_;
+
+  // Directory for the spill files that do not fit in 'spillDirectory_'.
+  std::string spillOverflowDirectory_;
+
+  std::once_flag spillTiersOnce_;
+  std::shared_ptr<SpillTiers> spillTiers_;
 };
 
 /// Listener invoked on task completion.
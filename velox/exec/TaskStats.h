@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "velox/exec/Driver.h"
+#include "velox/exec/MemoryTimeline.h"
 
 namespace facebook::velox::exec {
 
@@ -85,6 +86,26 @@ struct TaskStats {
   uint64_t numRunningDrivers{0};
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
+
+  /// CPU and wall time spent by Drivers on executor threads, summed over all
+  /// Drivers. Does not include Drivers run by Task::next().
+  uint64_t driverCpuNanos{0};
+  uint64_t driverWallNanos{0};
+  /// The number of times a Driver went off thread to let other Drivers run,
+  /// because its time slice was used up or a yield was requested.
+  uint64_t numDriverYields{0};
+  /// The number of table scan Drivers held back at Task start. See
+  /// QueryConfig::tableScanAdaptiveDriversEnabled().
+  uint64_t numDeferredDrivers{0};
+  /// The number of deferred Drivers that were started because splits were
+  /// queued while no Driver waited for one. The other deferred Drivers started
+  /// when no more splits arrived.
+  uint64_t numDeferredDriversStartedForSplits{0};
+
+  /// The retained events of the memory timeline, oldest first. Empty unless
+  /// QueryConfig::memoryTimelineMaxEvents() is set. The operators are
+  /// identified by pipeline and operator id, as in 'pipelineStats'.
+  std::vector<MemoryTimelineEvent> memoryTimeline;
 };
 
 } // namespace facebook::velox::exec
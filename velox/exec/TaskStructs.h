@@ -50,6 +50,9 @@ struct BarrierState {
 struct SplitsStore {
   /// Arrived (added), but not distributed yet, splits.
   std::deque<exec::Split> splits;
+  /// Pieces of splits that a driver divided for the other drivers. These are
+  /// distributed before 'splits'.
+  std::deque<exec::Split> splitPieces;
   /// Signal, that no more splits will arrive.
   bool noMoreSplits{false};
   /// Blocking promises given out when out of splits to distribute.
@@ -77,6 +80,8 @@ struct SplitsState {
 struct LocalExchangeState {
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager;
   std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  /// True if all consumers share the single queue in 'queues'.
+  bool workStealing{false};
 };
 
 /// Stores inter-operator state (exchange, bridges) for split groups.
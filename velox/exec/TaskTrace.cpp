@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/TaskTrace.h"
+
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/exec/Driver.h"
+
+namespace facebook::velox::exec {
+
+TaskTrace::TaskTrace(size_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+  events_.reserve(capacity_);
+}
+
+void TaskTrace::record(const TaskTraceEvent& event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numRecorded_;
+  if (events_.size() < capacity_) {
+    events_.push_back(event);
+    return;
+  }
+  events_[next_] = event;
+  next_ = (next_ + 1) % capacity_;
+}
+
+std::vector<TaskTraceEvent> TaskTrace::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<TaskTraceEvent> result;
+  result.reserve(events_.size());
+  result.insert(result.end(), events_.begin() + next_, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + next_);
+  return result;
+}
+
+uint64_t TaskTrace::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numRecorded_ - events_.size();
+}
+
+namespace {
+folly::dynamic toChromeEvent(const TaskTraceEvent& event) {
+  folly::dynamic args = folly::dynamic::object;
+  std::string name;
+  switch (event.kind) {
+    case TaskTraceEvent::Kind::kOnThread:
+      name = "run";
+      args["stopReason"] =
+          stopReasonString(static_cast<StopReason>(event.detail));
+      break;
+    case TaskTraceEvent::Kind::kBlocked:
+      name = blockingReasonToString(static_cast<BlockingReason>(event.detail));
+      args["operatorId"] = event.operatorId;
+      break;
+    case TaskTraceEvent::Kind::kSuspended:
+      name = "suspended";
+      break;
+    case TaskTraceEvent::Kind::kReclaim:
+      name = "reclaim";
+      args["operatorId"] = event.operatorId;
+      args["reclaimedBytes"] = event.detail;
+      break;
+  }
+  folly::dynamic result = folly::dynamic::object;
+  result["name"] = name;
+  result["ph"] = "X";
+  result["ts"] = static_cast<int64_t>(event.startMicros);
+  result["dur"] = static_cast<int64_t>(event.durationMicros);
+  result["pid"] = event.pipelineId;
+  result["tid"] = event.driverId;
+  result["args"] = std::move(args);
+  return result;
+}
+} // namespace
+
+std::string TaskTrace::toChromeTrace(const std::string& taskId) const {
+  const auto retained = events();
+  folly::dynamic traceEvents = folly::dynamic::array;
+  for (const auto& event : retained) {
+    traceEvents.push_back(toChromeEvent(event));
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  trace["otherData"] = folly::dynamic::object("taskId", taskId)(
+      "droppedEvents", static_cast<int64_t>(numDropped()));
+  return folly::toJson(trace);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// One span of the execution timeline of a Driver.
+struct TaskTraceEvent {
+  enum class Kind : uint8_t {
+    /// The Driver ran on an executor thread. 'detail' is the StopReason.
+    kOnThread,
+    /// The Driver was off thread waiting for a future of an operator.
+    /// 'detail' is the BlockingReason.
+    kBlocked,
+    /// The Driver was on thread in a suspended section, e.g. waiting for the
+    /// memory arbitrator.
+    kSuspended,
+    /// The memory arbitrator reclaimed memory from an operator, e.g. by
+    /// spilling. 'detail' is the number of reclaimed bytes.
+    kReclaim,
+  };
+
+  Kind kind;
+  int32_t pipelineId;
+  int32_t driverId;
+  /// Operator id for kBlocked and kReclaim, -1 otherwise.
+  int32_t operatorId;
+  /// Microsecond wall time since epoch.
+  uint64_t startMicros;
+  uint64_t durationMicros;
+  int64_t detail;
+};
+
+/// Bounded buffer of the latest TaskTraceEvents of a Task. Events are
+/// recorded per Driver run or wait, not per batch, so that recording can stay
+/// on in production. Thread-safe.
+class TaskTrace {
+ public:
+  explicit TaskTrace(size_t capacity);
+
+  /// Adds 'event' and drops the oldest event if full.
+  void record(const TaskTraceEvent& event);
+
+  /// Returns the retained events, oldest first.
+  std::vector<TaskTraceEvent> events() const;
+
+  /// Returns the number of events dropped because the buffer was full.
+  uint64_t numDropped() const;
+
+  /// Returns the retained events in the Chrome trace event JSON format, which
+  /// chrome://tracing and Perfetto load. Pipelines are shown as processes and
+  /// Drivers as threads.
+  std::string toChromeTrace(const std::string& taskId) const;
+
+ private:
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  std::vector<TaskTraceEvent> events_;
+  // Position of the oldest event once 'events_' is full.
+  size_t next_{0};
+  uint64_t numRecorded_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -36,15 +36,181 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {}
+      decodedVectors_(outputType_->children().size()) {
+  const auto& leadingKey = topNNode->sortingKeys()[0];
+  const auto& leadingOrder = topNNode->sortingOrders()[0];
+  switch (leadingKey->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      thresholdChannel_ = outputType_->getChildIdx(leadingKey->name());
+      thresholdAscending_ = leadingOrder.isAscending();
+      thresholdNullsFirst_ = leadingOrder.isNullsFirst();
+      break;
+    default:
+      break;
+  }
+}
+
+template <typename T>
+void TopN::selectThresholdCandidates(
+    const DecodedVector& keys,
+    T threshold,
+    SelectivityVector& rows) const {
+  const auto numRows = rows.size();
+  if (keys.isIdentityMapping() && !keys.mayHaveNulls()) {
+    // Computes the rows 64 at a time with a loop the compiler vectorizes.
+    const T* values = keys.data<T>();
+    auto* bits = rows.asMutableRange().bits();
+    for (auto begin = 0; begin < numRows; begin += 64) {
+      const auto end = std::min<int32_t>(begin + 64, numRows);
+      uint64_t word = 0;
+      if (thresholdAscending_) {
+        for (auto row = begin; row < end; ++row) {
+          word |= static_cast<uint64_t>(values[row] <= threshold)
+              << (row - begin);
+        }
+      } else {
+        for (auto row = begin; row < end; ++row) {
+          word |= static_cast<uint64_t>(values[row] >= threshold)
+              << (row - begin);
+        }
+      }
+      bits[begin / 64] = word;
+    }
+  } else {
+    for (auto row = 0; row < numRows; ++row) {
+      bool candidate;
+      if (keys.isNullAt(row)) {
+        // A null key is better than the non-null threshold if nulls are first.
+        candidate = thresholdNullsFirst_;
+      } else {
+        const auto value = keys.valueAt<T>(row);
+        candidate =
+            thresholdAscending_ ? value <= threshold : value >= threshold;
+      }
+      rows.setValid(row, candidate);
+    }
+  }
+  rows.updateBounds();
+}
+
+void TopN::selectThresholdCandidates(SelectivityVector& rows) {
+  const auto channel = thresholdChannel_.value();
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(channel);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    // If nulls are first, the heap holds only nulls and only null keys can
+    // tie with them. If nulls are last, any key may be better.
+    if (thresholdNullsFirst_) {
+      const auto& keys = decodedVectors_[channel];
+      for (auto row = 0; row < rows.size(); ++row) {
+        rows.setValid(row, keys.isNullAt(row));
+      }
+      rows.updateBounds();
+    }
+    return;
+  }
+  const auto& keys = decodedVectors_[channel];
+  const auto offset = column.offset();
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+      selectThresholdCandidates<int8_t>(
+          keys, RowContainer::valueAt<int8_t>(topRow, offset), rows);
+      break;
+    case TypeKind::SMALLINT:
+      selectThresholdCandidates<int16_t>(
+          keys, RowContainer::valueAt<int16_t>(topRow, offset), rows);
+      break;
+    case TypeKind::INTEGER:
+      selectThresholdCandidates<int32_t>(
+          keys, RowContainer::valueAt<int32_t>(topRow, offset), rows);
+      break;
+    case TypeKind::BIGINT:
+      selectThresholdCandidates<int64_t>(
+          keys, RowContainer::valueAt<int64_t>(topRow, offset), rows);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void TopN::maybePushdownThreshold() {
+  if (topRows_.empty() || topRows_.size() < count_) {
+    return;
+  }
+  const auto channel = thresholdChannel_.value();
+  if (!canPushdownThreshold_.has_value()) {
+    canPushdownThreshold_ =
+        operatorCtx_->driverCtx()->driver->canPushdownFilters(this, {channel})
+            .count(channel) > 0;
+  }
+  if (!canPushdownThreshold_.value()) {
+    return;
+  }
+  const char* topRow = topRows_.top();
+  const auto column = data_->columnAt(channel);
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    return;
+  }
+  int64_t threshold;
+  const auto offset = column.offset();
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+      threshold = RowContainer::valueAt<int8_t>(topRow, offset);
+      break;
+    case TypeKind::SMALLINT:
+      threshold = RowContainer::valueAt<int16_t>(topRow, offset);
+      break;
+    case TypeKind::INTEGER:
+      threshold = RowContainer::valueAt<int32_t>(topRow, offset);
+      break;
+    case TypeKind::BIGINT:
+      threshold = RowContainer::valueAt<int64_t>(topRow, offset);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  if (pushedThreshold_ == threshold) {
+    return;
+  }
+  pushedThreshold_ = threshold;
+  // Rows equal to the threshold may still win on the other keys.
+  dynamicFilters_[channel] = thresholdAscending_
+      ? std::make_shared<common::BigintRange>(
+            std::numeric_limits<int64_t>::min(),
+            threshold,
+            thresholdNullsFirst_)
+      : std::make_shared<common::BigintRange>(
+            threshold,
+            std::numeric_limits<int64_t>::max(),
+            thresholdNullsFirst_);
+}
 
 void TopN::addInput(RowVectorPtr input) {
-  // TODO Decode keys first, then decode the rest only for passing positions
+  candidateRows_.resizeFill(input->size(), true);
+  if (thresholdChannel_.has_value() && !topRows_.empty() &&
+      topRows_.size() == count_) {
+    const auto channel = thresholdChannel_.value();
+    decodedVectors_[channel].decode(*input->childAt(channel));
+    selectThresholdCandidates(candidateRows_);
+    const auto numCandidates = candidateRows_.countSelected();
+    if (numCandidates < input->size()) {
+      addRuntimeStat(
+          "thresholdFilteredRows",
+          RuntimeCounter(input->size() - numCandidates));
+    }
+    if (numCandidates == 0) {
+      return;
+    }
+  }
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
-    decodedVectors_[col].decode(*input->childAt(col));
+    decodedVectors_[col].decode(*input->childAt(col), candidateRows_);
   }
 
-  for (auto row = 0; row < input->size(); ++row) {
+  candidateRows_.applyToSelected([&](auto row) {
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -52,7 +218,7 @@ void TopN::addInput(RowVectorPtr input) {
       char* topRow = topRows_.top();
 
       if (!comparator_(decodedVectors_, row, topRow)) {
-        continue;
+        return;
       }
       topRows_.pop();
       // Reuse the topRow's memory.
@@ -64,6 +230,10 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     topRows_.push(newRow);
+  });
+
+  if (thresholdChannel_.has_value()) {
+    maybePushdownThreshold();
   }
 }
 
@@ -44,6 +44,22 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Clears the rows of 'rows' whose leading sorting key is worse than that of
+  // the current top row. These rows cannot displace the top row.
+  void selectThresholdCandidates(SelectivityVector& rows);
+
+  template <typename T>
+  void selectThresholdCandidates(
+      const DecodedVector& keys,
+      T threshold,
+      SelectivityVector& rows) const;
+
+  // Adds a dynamic range filter on the leading sorting key that excludes the
+  // values worse than that of the current top row. Pushed into the upstream
+  // TableScan, this lets the scan skip rows, row groups and stripes that
+  // cannot reach the top 'count_'.
+  void maybePushdownThreshold();
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -65,5 +81,22 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Channel of the leading sorting key if it is of integer type. Once the
+  // heap is full, the input is filtered by this key against the key of the
+  // top row before the rows are compared one by one.
+  std::optional<column_index_t> thresholdChannel_;
+  bool thresholdAscending_{true};
+  bool thresholdNullsFirst_{false};
+
+  // Set on first use. True if a filter on 'thresholdChannel_' can be pushed
+  // down to the source of the pipeline.
+  std::optional<bool> canPushdownThreshold_;
+
+  // The leading key value of the top row at the last filter pushdown.
+  std::optional<int64_t> pushedThreshold_;
+
+  // Rows of the current input that may enter the heap.
+  SelectivityVector candidateRows_;
 };
 } // namespace facebook::velox::exec
@@ -26,8 +26,12 @@ TopNRowNumber::TopNRowNumber(
           node->outputType(),
           operatorId,
           node->id(),
-          "TopNRowNumber"),
+          "TopNRowNumber",
+          node->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       limit_{node->limit()},
+      rankFunction_{node->rankFunction()},
       generateRowNumber_{node->generateRowNumber()},
       inputType_{node->sources()[0]->outputType()},
       data_(std::make_unique<RowContainer>(inputType_->children(), pool())),
@@ -70,6 +74,22 @@ TopNRowNumber::TopNRowNumber(
 }
 
 void TopNRowNumber::addInput(RowVectorPtr input) {
+  if (table_ != nullptr) {
+    ensureInputFits(input);
+    if (spiller_ != nullptr) {
+      spillHashFunction_->partition(*input, spillPartitions_);
+      spiller_->spillPartitioned(input, spillPartitions_);
+      return;
+    }
+  }
+  processInput(input);
+}
+
+void TopNRowNumber::processInput(const RowVectorPtr& input) {
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   const auto numInput = input->size();
 
   for (auto i = 0; i < inputType_->size(); ++i) {
@@ -109,6 +129,11 @@ void TopNRowNumber::processInputRow(
     const RowVectorPtr& input,
     vector_size_t index,
     TopRows& partition) {
+  if (rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber) {
+    processInputRowWithTies(input, index, partition);
+    return;
+  }
+
   auto& topRows = partition.rows;
 
   char* newRow = nullptr;
@@ -136,6 +161,60 @@ void TopNRowNumber::processInputRow(
   topRows.push(newRow);
 }
 
+void TopNRowNumber::processInputRowWithTies(
+    const RowVectorPtr& input,
+    vector_size_t index,
+    TopRows& partition) {
+  auto& sortedRows = partition.sortedRows;
+  const bool isRank =
+      rankFunction_ == core::TopNRowNumberNode::RankFunction::kRank;
+
+  // Once the partition has 'limit' rows (or peer groups for dense_rank), a
+  // row after the last one has a rank above the limit. A row tied with the
+  // last one has the same rank and is kept.
+  const bool full = isRank ? sortedRows.size() >= limit_
+                           : partition.numPeerGroups >= limit_;
+  if (full &&
+      comparator_.compare(decodedVectors_, index, *sortedRows.rbegin()) > 0) {
+    // Drop this input row.
+    return;
+  }
+
+  char* newRow = data_->newRow();
+  for (auto col = 0; col < input->childrenSize(); ++col) {
+    data_->store(decodedVectors_[col], index, newRow, col);
+  }
+
+  // The new row is inserted after its peers, so it starts a new peer group
+  // unless the row before it is a peer.
+  auto it = sortedRows.insert(newRow);
+  if (it == sortedRows.begin() ||
+      comparator_.compare(*std::prev(it), newRow) != 0) {
+    ++partition.numPeerGroups;
+  }
+
+  // A new row before the last peer group moves that group one rank (or dense
+  // rank) down. Drop the group if that is now past the limit. The other rows
+  // stay within the limit.
+  if (sortedRows.size() <= limit_) {
+    return;
+  }
+  auto lastGroup = sortedRows.equal_range(*sortedRows.rbegin());
+  bool dropLastGroup;
+  if (isRank) {
+    const auto numLastRows = std::distance(lastGroup.first, lastGroup.second);
+    dropLastGroup = sortedRows.size() - numLastRows + 1 > limit_;
+  } else {
+    dropLastGroup = partition.numPeerGroups > limit_;
+  }
+  if (dropLastGroup) {
+    droppedRows_.assign(lastGroup.first, lastGroup.second);
+    sortedRows.erase(lastGroup.first, lastGroup.second);
+    data_->eraseRows(folly::Range(droppedRows_.data(), droppedRows_.size()));
+    --partition.numPeerGroups;
+  }
+}
+
 void TopNRowNumber::noMoreInput() {
   Operator::noMoreInput();
 
@@ -146,6 +225,163 @@ void TopNRowNumber::noMoreInput() {
 
   outputBatchSize_ = outputBatchRows(rowSize);
   outputRows_.resize(outputBatchSize_);
+
+  if (spiller_ != nullptr) {
+    spiller_->finishSpill(spillPartitionSet_);
+    recordSpillStats();
+  }
+}
+
+void TopNRowNumber::ensureInputFits(const RowVectorPtr& input) {
+  if (!canSpill() || spiller_ != nullptr) {
+    return;
+  }
+  const auto numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+
+  const auto& spillConfig = spillConfig_.value();
+  // Test-only spill path.
+  if (spillConfig.testSpillPct > 0 &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    spill();
+    return;
+  }
+
+  const auto tableIncrement = table_->hashTableSizeIncrease(input->size());
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t flatBytes = input->estimateFlatSize();
+  if (!tableIncrement && freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatBytes)) {
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const auto increment =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatBytes : 0) +
+      table_->rows()->sizeIncrement(input->size(), 0) + tableIncrement;
+  // There must be at least 2x the increment in reservation.
+  if (pool()->availableReservation() > 2 * increment) {
+    return;
+  }
+  const auto targetIncrement = std::max<int64_t>(
+      increment * 2,
+      pool()->currentBytes() * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool()->maybeReserve(targetIncrement)) {
+    return;
+  }
+  spill();
+}
+
+void TopNRowNumber::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a topN row number operator is reclaimable if it hasn't started
+  // output processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from topN row number operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    spill();
+  }
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void TopNRowNumber::spill() {
+  VELOX_CHECK(canSpill());
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_NOT_NULL(table_);
+
+  const auto& spillConfig = spillConfig_.value();
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kPartitionedInput,
+      inputType_,
+      spillConfig.hashBitRange,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      Spiller::spillPool(),
+      spillConfig.executor,
+      spillConfig.codecOptions,
+      spillConfig.tiers);
+  SpillPartitionNumSet partitions;
+  for (auto i = 0; i < spillConfig.hashBitRange.numPartitions(); ++i) {
+    partitions.insert(i);
+  }
+  spiller_->setPartitionsSpilled(partitions);
+
+  std::vector<column_index_t> keyChannels;
+  for (const auto& hasher : table_->hashers()) {
+    keyChannels.push_back(hasher->channel());
+  }
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      spillConfig.hashBitRange, inputType_, keyChannels);
+
+  // NOTE: disk spilling use the system disk spilling memory pool instead of
+  // the operator memory pool.
+  RowContainerIterator iter;
+  std::vector<char*> spillRows(outputBatchRows(data_->estimateRowSize()));
+  for (;;) {
+    const auto numRows =
+        data_->listRows(&iter, spillRows.size(), spillRows.data());
+    if (numRows == 0) {
+      break;
+    }
+    auto batch = BaseVector::create<RowVector>(
+        inputType_, numRows, &Spiller::spillPool());
+    for (auto i = 0; i < inputType_->size(); ++i) {
+      data_->extractColumn(spillRows.data(), numRows, i, batch->childAt(i));
+    }
+    spillHashFunction_->partition(*batch, spillPartitions_);
+    spiller_->spillPartitioned(batch, spillPartitions_);
+  }
+  table_->clear();
+  data_->clear();
+}
+
+bool TopNRowNumber::restoreNextSpillPartition() {
+  if (spillPartitionSet_.empty()) {
+    return false;
+  }
+
+  table_->clear();
+  data_->clear();
+  partitionIt_.reset();
+  numPartitions_ = 0;
+  currentPartition_.reset();
+  remainingRowsInPartition_ = 0;
+
+  auto it = spillPartitionSet_.begin();
+  auto reader = it->second->createReader(spillConfig_->executor);
+  spillPartitionSet_.erase(it);
+  RowVectorPtr input;
+  while (reader->nextBatch(input)) {
+    processInput(input);
+  }
+  return true;
+}
+
+void TopNRowNumber::recordSpillStats() {
+  VELOX_CHECK_NOT_NULL(spiller_);
+  VELOX_CHECK(noMoreInput_);
+
+  const auto spillStats = spiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
 }
 
 TopNRowNumber::TopRows* TopNRowNumber::nextPartition() {
@@ -196,6 +432,11 @@ void TopNRowNumber::appendPartitionRows(
     vector_size_t size,
     vector_size_t outputOffset,
     FlatVector<int64_t>* rowNumbers) {
+  if (rankFunction_ != core::TopNRowNumberNode::RankFunction::kRowNumber) {
+    appendSortedPartitionRows(partition, size, outputOffset, rowNumbers);
+    return;
+  }
+
   // Append 'size' partition rows in reverse order starting from 'start' row.
   auto rowNumber = partition.rows.size() - start;
   for (auto i = 0; i < size; ++i) {
@@ -208,11 +449,50 @@ void TopNRowNumber::appendPartitionRows(
   }
 }
 
+void TopNRowNumber::appendSortedPartitionRows(
+    TopRows& partition,
+    vector_size_t size,
+    vector_size_t outputOffset,
+    FlatVector<int64_t>* ranks) {
+  auto& sortedRows = partition.sortedRows;
+  const bool isRank =
+      rankFunction_ == core::TopNRowNumberNode::RankFunction::kRank;
+  for (auto i = 0; i < size; ++i) {
+    auto it = sortedRows.begin();
+    char* row = *it;
+    ++partition.numOutputRows;
+    if (partition.lastOutputRow == nullptr ||
+        comparator_.compare(partition.lastOutputRow, row) != 0) {
+      partition.lastOutputRank =
+          isRank ? partition.numOutputRows : partition.lastOutputRank + 1;
+    }
+    if (ranks) {
+      ranks->set(outputOffset + i, partition.lastOutputRank);
+    }
+    outputRows_[outputOffset + i] = row;
+    partition.lastOutputRow = row;
+    sortedRows.erase(it);
+  }
+}
+
 RowVectorPtr TopNRowNumber::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
 
+  for (;;) {
+    auto output = getOutputFromMemory();
+    if (output != nullptr) {
+      return output;
+    }
+    if (!restoreNextSpillPartition()) {
+      finished_ = true;
+      return nullptr;
+    }
+  }
+}
+
+RowVectorPtr TopNRowNumber::getOutputFromMemory() {
   // Loop over partitions and emit sorted rows along with row numbers.
   auto output =
       BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
@@ -225,7 +505,7 @@ RowVectorPtr TopNRowNumber::getOutput() {
   vector_size_t offset = 0;
   if (remainingRowsInPartition_ > 0) {
     auto& partition = currentPartition();
-    auto start = partition.rows.size() - remainingRowsInPartition_;
+    auto start = partition.size() - remainingRowsInPartition_;
     auto numRows =
         std::min<vector_size_t>(outputBatchSize_, remainingRowsInPartition_);
     appendPartitionRows(partition, start, numRows, offset, rowNumbers);
@@ -239,7 +519,7 @@ RowVectorPtr TopNRowNumber::getOutput() {
       break;
     }
 
-    auto numRows = partition->rows.size();
+    auto numRows = partition->size();
     if (offset + numRows > outputBatchSize_) {
       remainingRowsInPartition_ = offset + numRows - outputBatchSize_;
 
@@ -257,7 +537,6 @@ RowVectorPtr TopNRowNumber::getOutput() {
   }
 
   if (offset == 0) {
-    finished_ = true;
     return nullptr;
   }
 
@@ -15,14 +15,19 @@
  */
 #pragma once
 
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
+#include <set>
+
 namespace facebook::velox::exec {
 
 /// Partitions the input using specified partitioning keys, sorts rows within
-/// partitions using specified sorting keys, assigns row numbers and returns up
-/// to specified number of rows per partition.
+/// partitions using specified sorting keys, assigns row numbers (or ranks) and
+/// returns up to specified number of rows per partition. With rank and
+/// dense_rank, the rows tied with the last row within the limit are returned
+/// too.
 ///
 /// It is allowed to not specify partitioning keys. In this case the whole input
 /// is treated as a single partition.
@@ -32,8 +37,15 @@ namespace facebook::velox::exec {
 /// The limit (maximum number of rows to return per partition) must be greater
 /// than zero.
 ///
-/// This is an optimized version of a Window operator with a single row_number
-/// window function followed by a row_number <= N filter.
+/// This is an optimized version of a Window operator with a single row_number,
+/// rank or dense_rank window function followed by a <= N filter on its value.
+/// Without the row number column the operator can run before the exchange of
+/// a distributed plan to cut the data to the top rows of each partition.
+///
+/// With partitioning keys, the operator can spill. It then spills the top rows
+/// of all the partitions and any later input by the hash of the partitioning
+/// keys, and processes one spill partition at a time in memory after all the
+/// input is received.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -57,13 +69,17 @@ class TopNRowNumber : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
-  /// A priority queue to keep track of top 'limit' rows for a given partition.
+  /// Keeps track of the top rows for a given partition. row_number uses
+  /// a priority queue of the top 'limit' rows. rank and dense_rank keep the
+  /// rows sorted so that the rows tied with the last row can be found.
   struct TopRows {
     struct Compare {
       RowComparator& comparator;
 
-      bool operator()(const char* lhs, const char* rhs) {
+      bool operator()(const char* lhs, const char* rhs) const {
         return comparator(lhs, rhs);
       }
     };
@@ -71,10 +87,48 @@ class TopNRowNumber : public Operator {
     std::priority_queue<char*, std::vector<char*, StlAllocator<char*>>, Compare>
         rows;
 
+    std::multiset<char*, Compare, StlAllocator<char*>> sortedRows;
+
+    /// Number of distinct sorting key values in 'sortedRows'.
+    int64_t numPeerGroups{0};
+
+    /// The last row of 'sortedRows' added to the output and its rank. Ranks
+    /// continue from these when a partition spans output batches.
+    const char* lastOutputRow{nullptr};
+    int64_t numOutputRows{0};
+    int64_t lastOutputRank{0};
+
     TopRows(HashStringAllocator* allocator, RowComparator& comparator)
-        : rows{{comparator}, StlAllocator<char*>(allocator)} {}
+        : rows{{comparator}, StlAllocator<char*>(allocator)},
+          sortedRows{Compare{comparator}, StlAllocator<char*>(allocator)} {}
+
+    size_t size() const {
+      return rows.size() + sortedRows.size();
+    }
   };
 
+  /// Adds 'input' to the partitions kept in memory.
+  void processInput(const RowVectorPtr& input);
+
+  /// Returns the next output batch from the partitions kept in memory or
+  /// nullptr if there are no rows left.
+  RowVectorPtr getOutputFromMemory();
+
+  /// Spills the top rows if 'input' can't fit in memory. Only used before
+  /// spilling is triggered.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  /// Spills the top rows of all the partitions and switches all the spill
+  /// partitions to spilling so that any input received after this is spilled
+  /// directly.
+  void spill();
+
+  /// Clears the partitions kept in memory and reads the next spill partition
+  /// into memory. Returns false if there are no spill partitions left.
+  bool restoreNextSpillPartition();
+
+  void recordSpillStats();
+
   void initializeNewPartitions();
 
   TopRows& partitionAt(char* group) {
@@ -87,6 +141,13 @@ class TopNRowNumber : public Operator {
       vector_size_t index,
       TopRows& partition);
 
+  /// processInputRow() for rank and dense_rank. Keeps the rows whose rank is
+  /// at most 'limit_'.
+  void processInputRowWithTies(
+      const RowVectorPtr& input,
+      vector_size_t index,
+      TopRows& partition);
+
   /// Returns next partition to add to output or nullptr if there are no
   /// partitions left.
   TopRows* nextPartition();
@@ -103,7 +164,16 @@ class TopNRowNumber : public Operator {
       vector_size_t outputOffset,
       FlatVector<int64_t>* rowNumbers);
 
+  /// appendPartitionRows() for rank and dense_rank. Appends the first 'size'
+  /// remaining rows in sort order and optionally populates their ranks.
+  void appendSortedPartitionRows(
+      TopRows& partition,
+      vector_size_t size,
+      vector_size_t outputOffset,
+      FlatVector<int64_t>* ranks);
+
   const int32_t limit_;
+  const core::TopNRowNumberNode::RankFunction rankFunction_;
   const bool generateRowNumber_;
   const RowTypePtr inputType_;
 
@@ -126,6 +196,10 @@ class TopNRowNumber : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
 
+  /// Rows removed from a partition by rank and dense_rank. Kept to reuse
+  /// memory.
+  std::vector<char*> droppedRows_;
+
   bool finished_{false};
 
   /// Maximum number of rows in the output batch.
@@ -141,5 +215,14 @@ class TopNRowNumber : public Operator {
   size_t numPartitions_{0};
   std::optional<int32_t> currentPartition_;
   vector_size_t remainingRowsInPartition_{0};
+
+  /// Spills the stored rows and the input received after spilling by the hash
+  /// of the partitioning keys. Created on the first spill.
+  std::unique_ptr<Spiller> spiller_;
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+  std::vector<uint32_t> spillPartitions_;
+  SpillPartitionSet spillPartitionSet_;
+
+  uint64_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
@@ -30,7 +30,8 @@ Unnest::Unnest(
           operatorId,
           unnestNode->id(),
           "Unnest"),
-      withOrdinality_(unnestNode->withOrdinality()) {
+      withOrdinality_(unnestNode->withOrdinality()),
+      maxOutputRows_(outputBatchRows()) {
   const auto& inputType = unnestNode->sources()[0]->outputType();
   const auto& unnestVariables = unnestNode->unnestVariables();
   for (const auto& variable : unnestVariables) {
@@ -41,6 +42,9 @@ Unnest::Unnest(
   }
 
   unnestDecoded_.resize(unnestVariables.size());
+  rawSizes_.resize(unnestVariables.size());
+  rawOffsets_.resize(unnestVariables.size());
+  rawIndices_.resize(unnestVariables.size());
 
   if (withOrdinality_) {
     VELOX_CHECK_EQ(
@@ -58,67 +62,81 @@ Unnest::Unnest(
 
 void Unnest::addInput(RowVectorPtr input) {
   input_ = std::move(input);
-}
-
-RowVectorPtr Unnest::getOutput() {
-  if (!input_) {
-    return nullptr;
-  }
+  nextRow_ = 0;
+  nextElement_ = 0;
 
-  auto size = input_->size();
+  const auto size = input_->size();
   inputRows_.resize(size);
 
-  // The max number of elements at each row across all unnested columns.
-  auto maxSizes = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
-  auto rawMaxSizes = maxSizes->asMutable<int64_t>();
-
-  std::vector<const vector_size_t*> rawSizes;
-  std::vector<const vector_size_t*> rawOffsets;
-  std::vector<const vector_size_t*> rawIndices;
-
-  rawSizes.resize(unnestChannels_.size());
-  rawOffsets.resize(unnestChannels_.size());
-  rawIndices.resize(unnestChannels_.size());
+  if (maxSizes_ == nullptr ||
+      maxSizes_->capacity() < size * sizeof(vector_size_t)) {
+    maxSizes_ = allocateSizes(size, pool());
+    rawMaxSizes_ = maxSizes_->asMutable<vector_size_t>();
+  }
+  std::fill(rawMaxSizes_, rawMaxSizes_ + size, 0);
 
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto& unnestVector = input_->childAt(unnestChannels_[channel]);
     unnestDecoded_[channel].decode(*unnestVector, inputRows_);
 
     auto& currentDecoded = unnestDecoded_[channel];
-    rawIndices[channel] = currentDecoded.indices();
+    rawIndices_[channel] = currentDecoded.indices();
 
-    const ArrayVector* unnestBaseArray;
-    const MapVector* unnestBaseMap;
     if (unnestVector->typeKind() == TypeKind::ARRAY) {
-      unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      rawSizes[channel] = unnestBaseArray->rawSizes();
-      rawOffsets[channel] = unnestBaseArray->rawOffsets();
+      const auto* unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
+      rawSizes_[channel] = unnestBaseArray->rawSizes();
+      rawOffsets_[channel] = unnestBaseArray->rawOffsets();
     } else {
       VELOX_CHECK(unnestVector->typeKind() == TypeKind::MAP);
-      unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      rawSizes[channel] = unnestBaseMap->rawSizes();
-      rawOffsets[channel] = unnestBaseMap->rawOffsets();
+      const auto* unnestBaseMap = currentDecoded.base()->as<MapVector>();
+      rawSizes_[channel] = unnestBaseMap->rawSizes();
+      rawOffsets_[channel] = unnestBaseMap->rawOffsets();
     }
 
     // Count max number of elements per row.
-    auto currentSizes = rawSizes[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentIndices = rawIndices_[channel];
     for (auto row = 0; row < size; ++row) {
       if (!currentDecoded.isNullAt(row)) {
         auto unnestSize = currentSizes[currentIndices[row]];
-        if (rawMaxSizes[row] < unnestSize) {
-          rawMaxSizes[row] = unnestSize;
+        if (rawMaxSizes_[row] < unnestSize) {
+          rawMaxSizes_[row] = unnestSize;
         }
       }
     }
   }
+}
+
+Unnest::RowRange Unnest::nextRowRange() {
+  const auto size = input_->size();
+  RowRange range{nextRow_, nextElement_, nextRow_, nextElement_, 0};
+  // Stop at 'maxOutputRows_' even in the middle of a row.
+  while (range.endRow < size && range.numElements < maxOutputRows_) {
+    const auto numRowElements = rawMaxSizes_[range.endRow];
+    const auto numTaken = std::min(
+        numRowElements - range.endElement,
+        maxOutputRows_ - range.numElements);
+    range.numElements += numTaken;
+    range.endElement += numTaken;
+    if (range.endElement == numRowElements) {
+      ++range.endRow;
+      range.endElement = 0;
+    }
+  }
+
+  nextRow_ = range.endRow;
+  nextElement_ = range.endElement;
+  return range;
+}
 
-  // Calculate the number of rows in the unnest result.
-  int numElements = 0;
-  for (auto row = 0; row < size; ++row) {
-    numElements += rawMaxSizes[row];
+RowVectorPtr Unnest::getOutput() {
+  if (!input_) {
+    return nullptr;
   }
 
+  const auto range = nextRowRange();
+  const auto numElements = range.numElements;
+
   if (numElements == 0) {
     // All arrays/maps are null or empty.
     input_ = nullptr;
@@ -126,15 +144,16 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   // Create "indices" buffer to repeat rows as many times as there are elements
-  // in the array (or map) in unnestDecoded.
+  // in the array (or map) in unnestDecoded. All "replicated" columns share
+  // this buffer.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = 0; row < size; ++row) {
-    for (auto i = 0; i < rawMaxSizes[row]; i++) {
-      rawRepeatedIndices[index++] = row;
-    }
-  }
+  range.forEachRow(rawMaxSizes_, [&](auto row, auto start, auto end) {
+    const auto numRepeats = end - start;
+    std::fill_n(rawRepeatedIndices + index, numRepeats, row);
+    index += numRepeats;
+  });
 
   // Wrap "replicated" columns in a dictionary using 'repeatedIndices'.
   std::vector<VectorPtr> outputs(outputType_->size());
@@ -144,12 +163,41 @@ RowVectorPtr Unnest::getOutput() {
   }
 
   // Create unnest columns.
-  vector_size_t outputsIndex = identityProjections_.size();
+  generateUnnestColumns(range, identityProjections_.size(), outputs);
+
+  if (withOrdinality_) {
+    auto ordinalityVector = std::dynamic_pointer_cast<FlatVector<int64_t>>(
+        BaseVector::create(BIGINT(), numElements, pool()));
+
+    // Set the ordinality at each result row to be the index of the element in
+    // the original array (or map) plus one.
+    auto rawOrdinality = ordinalityVector->mutableRawValues();
+    range.forEachRow(rawMaxSizes_, [&](auto /*row*/, auto start, auto end) {
+      std::iota(rawOrdinality, rawOrdinality + end - start, start + 1);
+      rawOrdinality += end - start;
+    });
+
+    // Ordinality column is always at the end.
+    outputs.back() = std::move(ordinalityVector);
+  }
+
+  if (nextRow_ == input_->size()) {
+    input_ = nullptr;
+  }
+  return std::make_shared<RowVector>(
+      pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
+}
+
+void Unnest::generateUnnestColumns(
+    const RowRange& range,
+    vector_size_t index,
+    std::vector<VectorPtr>& outputs) {
+  const auto numElements = range.numElements;
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto currentSizes = rawSizes[channel];
-    auto currentOffsets = rawOffsets[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentOffsets = rawOffsets_[channel];
+    auto currentIndices = rawIndices_[channel];
 
     BufferPtr elementIndices = allocateIndices(numElements, pool());
     auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
@@ -158,82 +206,62 @@ RowVectorPtr Unnest::getOutput() {
         AlignedBuffer::allocate<bool>(numElements, pool(), bits::kNotNull);
     auto rawNulls = nulls->asMutable<uint64_t>();
 
-    // Make dictionary index for elements column since they may be out of order.
-    index = 0;
+    // Make dictionary index for elements column since they may be out of
+    // order. If the elements of the batch are contiguous and have no nulls
+    // added, slice the elements vector instead.
+    vector_size_t outputIndex = 0;
+    std::optional<vector_size_t> firstElement;
     bool identityMapping = true;
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-
+    range.forEachRow(rawMaxSizes_, [&](auto row, auto start, auto end) {
       if (!currentDecoded.isNullAt(row)) {
-        auto offset = currentOffsets[currentIndices[row]];
-        auto unnestSize = currentSizes[currentIndices[row]];
+        const auto offset = currentOffsets[currentIndices[row]];
+        const auto unnestSize = currentSizes[currentIndices[row]];
+        const auto unnestEnd = std::min(unnestSize, end);
 
-        if (index != offset || unnestSize < maxSize) {
+        if (!firstElement.has_value()) {
+          firstElement = offset + start;
+        }
+        if (firstElement.value() + outputIndex != offset + start ||
+            unnestEnd < end) {
           identityMapping = false;
         }
 
-        for (auto i = 0; i < unnestSize; i++) {
-          rawElementIndices[index++] = offset + i;
+        for (auto i = start; i < unnestEnd; ++i) {
+          rawElementIndices[outputIndex++] = offset + i;
         }
 
-        for (auto i = unnestSize; i < maxSize; ++i) {
-          bits::setNull(rawNulls, index++, true);
+        for (auto i = std::max(start, unnestEnd); i < end; ++i) {
+          bits::setNull(rawNulls, outputIndex++, true);
         }
-      } else if (maxSize > 0) {
+      } else {
         identityMapping = false;
 
-        for (auto i = 0; i < maxSize; ++i) {
-          bits::setNull(rawNulls, index++, true);
+        for (auto i = start; i < end; ++i) {
+          bits::setNull(rawNulls, outputIndex++, true);
         }
       }
-    }
+    });
+
+    auto makeColumn = [&](const VectorPtr& elements) {
+      if (identityMapping) {
+        return elements->slice(firstElement.value(), numElements);
+      }
+      return wrapChild(numElements, elementIndices, elements, nulls);
+    };
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
       // Construct unnest column using Array elements wrapped using above
       // created dictionary.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                elementIndices,
-                unnestBaseArray->elements(),
-                nulls);
+      outputs[index++] = makeColumn(unnestBaseArray->elements());
     } else {
       // Construct two unnest columns for Map keys and values vectors wrapped
       // using above created dictionary.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapKeys(), nulls);
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapValues(), nulls);
-    }
-  }
-
-  if (withOrdinality_) {
-    auto ordinalityVector = std::dynamic_pointer_cast<FlatVector<int64_t>>(
-        BaseVector::create(BIGINT(), numElements, pool()));
-
-    // Set the ordinality at each result row to be the index of the element in
-    // the original array (or map) plus one.
-    auto rawOrdinality = ordinalityVector->mutableRawValues();
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-      std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-      rawOrdinality += maxSize;
+      outputs[index++] = makeColumn(unnestBaseMap->mapKeys());
+      outputs[index++] = makeColumn(unnestBaseMap->mapValues());
     }
-
-    // Ordinality column is always at the end.
-    outputs.back() = std::move(ordinalityVector);
   }
-
-  input_ = nullptr;
-  return std::make_shared<RowVector>(
-      pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
 }
 
 bool Unnest::isFinished() {
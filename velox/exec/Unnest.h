@@ -29,7 +29,7 @@ class Unnest : public Operator {
   }
 
   bool needsInput() const override {
-    return true;
+    return input_ == nullptr;
   }
 
   void addInput(RowVectorPtr input) override;
@@ -39,11 +39,63 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
+  // Range of rows of 'input_' that goes into one batch of output. The range
+  // starts at element 'startElement' of row 'startRow' and ends before element
+  // 'endElement' of row 'endRow'. A large array or map may be split across
+  // several batches.
+  struct RowRange {
+    vector_size_t startRow;
+    vector_size_t startElement;
+    vector_size_t endRow;
+    vector_size_t endElement;
+    vector_size_t numElements;
+
+    // Calls 'func(row, start, end)' for each row in the range with the range
+    // of elements of the row in the batch.
+    template <typename TFunc>
+    void forEachRow(const vector_size_t* rawMaxSizes, TFunc func) const {
+      for (auto row = startRow; row <= endRow; ++row) {
+        const auto start = row == startRow ? startElement : 0;
+        const auto end = row == endRow ? endElement : rawMaxSizes[row];
+        if (start < end) {
+          func(row, start, end);
+        }
+      }
+    }
+  };
+
+  // Returns the range of rows for the next batch of at most 'maxOutputRows_'
+  // rows starting at 'nextRow_' and 'nextElement_'. Advances these.
+  RowRange nextRowRange();
+
+  // Creates the unnested columns for 'range' starting at 'outputs[index]'.
+  void generateUnnestColumns(
+      const RowRange& range,
+      vector_size_t index,
+      std::vector<VectorPtr>& outputs);
+
   std::vector<column_index_t> unnestChannels_;
 
   SelectivityVector inputRows_;
   std::vector<DecodedVector> unnestDecoded_;
 
+  // Sizes, offsets and indices of the decoded unnested columns of 'input_'.
+  std::vector<const vector_size_t*> rawSizes_;
+  std::vector<const vector_size_t*> rawOffsets_;
+  std::vector<const vector_size_t*> rawIndices_;
+
+  // The max number of elements at each row of 'input_' across all unnested
+  // columns.
+  BufferPtr maxSizes_;
+  vector_size_t* rawMaxSizes_{nullptr};
+
+  // Row and element of 'input_' to start the next batch of output from.
+  vector_size_t nextRow_{0};
+  vector_size_t nextElement_{0};
+
   const bool withOrdinality_;
+
+  // Maximum number of rows in a batch of output.
+  const vector_size_t maxOutputRows_;
 };
 } // namespace facebook::velox::exec
@@ -90,18 +90,24 @@ void VectorHasher::hashValues(
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+    auto* hashes = &cachedHashes_;
+    if (hashedBase_ != nullptr && decoded_.base() == hashedBase_.get()) {
+      hashes = &baseHashes_;
+    }
+    if (hashes == &cachedHashes_ || baseHashes_.empty()) {
+      hashes->resize(decoded_.base()->size());
+      std::fill(hashes->begin(), hashes->end(), kNullHash);
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
         return;
       }
       auto baseIndex = decoded_.index(row);
-      uint64_t hash = cachedHashes_[baseIndex];
+      uint64_t hash = (*hashes)[baseIndex];
       if (hash == kNullHash) {
         hash = hashOne<Kind>(decoded_, row);
-        cachedHashes_[baseIndex] = hash;
+        (*hashes)[baseIndex] = hash;
       }
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
@@ -178,6 +178,16 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    // Successive batches of a dictionary encoded string column often share
+    // the dictionary, e.g. the batches of a stripe of a file. The hashes of
+    // the dictionary are then computed once.
+    if (vector.encoding() == VectorEncoding::Simple::DICTIONARY &&
+        (typeKind_ == TypeKind::VARCHAR || typeKind_ == TypeKind::VARBINARY) &&
+        vector.valueVector()->isFlatEncoding() &&
+        vector.valueVector() != hashedBase_) {
+      hashedBase_ = vector.valueVector();
+      baseHashes_.clear();
+    }
   }
 
   DecodedVector& decodedVector() {
@@ -248,6 +258,11 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there are too many distinct values to keep track of.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
@@ -543,6 +558,11 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // The dictionary base of the last decoded string vector and the hashes of
+  // its values. kNullHash marks values not hashed yet.
+  VectorPtr hashedBase_;
+  raw_vector<uint64_t> baseHashes_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
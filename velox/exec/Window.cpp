@@ -15,6 +15,7 @@
  */
 #include "velox/exec/Window.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Task.h"
 
 DEFINE_bool(SkipRowSortInWindowOp, false, "Skip row sort");
@@ -53,11 +54,15 @@ Window::Window(
           windowNode->outputType(),
           operatorId,
           windowNode->id(),
-          "Window"),
+          "Window",
+          windowNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       numInputColumns_(windowNode->sources()[0]->outputType()->size()),
-      data_(std::make_unique<RowContainer>(
-          windowNode->sources()[0]->outputType()->children(),
-          pool())),
+      inputsSorted_(windowNode->inputsSorted()),
+      spillMemoryThreshold_(operatorCtx_->driverCtx()
+                                ->queryConfig()
+                                .windowSpillMemoryThreshold()),
       decodedInputVectors_(numInputColumns_),
       stringAllocator_(pool()) {
   auto inputType = windowNode->sources()[0]->outputType();
@@ -73,9 +78,11 @@ Window::Window(
   allKeyInfo_.insert(
       allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
 
+  createRowContainer(inputType);
+
   std::vector<exec::RowColumn> inputColumns;
   for (int i = 0; i < inputType->children().size(); i++) {
-    inputColumns.push_back(data_->columnAt(i));
+    inputColumns.push_back(data_->columnAt(dataColumns_[i]));
   }
   // The WindowPartition is structured over all the input columns data.
   // Individual functions access its input argument column values from it.
@@ -89,6 +96,47 @@ Window::Window(
   initRangeValuesMap();
 }
 
+void Window::createRowContainer(const RowTypePtr& inputType) {
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  // Input channels in the order of the columns of 'data_'.
+  std::vector<column_index_t> channels;
+  channels.reserve(numInputColumns_);
+  dataColumns_.resize(numInputColumns_, kConstantChannel);
+
+  // A sort key that is also a partition key doesn't change the order, so each
+  // input channel is stored once.
+  for (const auto& [channel, sortOrder] : allKeyInfo_) {
+    if (dataColumns_[channel] != kConstantChannel) {
+      continue;
+    }
+    dataColumns_[channel] = channels.size();
+    channels.push_back(channel);
+    keyTypes.push_back(inputType->childAt(channel));
+    keyCompareFlags_.push_back(
+        {sortOrder.isNullsFirst(), sortOrder.isAscending(), false, false});
+  }
+  for (column_index_t channel = 0; channel < numInputColumns_; ++channel) {
+    if (dataColumns_[channel] != kConstantChannel) {
+      continue;
+    }
+    dataColumns_[channel] = channels.size();
+    channels.push_back(channel);
+    dependentTypes.push_back(inputType->childAt(channel));
+  }
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(numInputColumns_);
+  types.reserve(numInputColumns_);
+  for (auto channel : channels) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool());
+  spillType_ = ROW(std::move(names), std::move(types));
+}
+
 Window::WindowFrame Window::createWindowFrame(
     core::WindowNode::Frame frame,
     const RowTypePtr& inputType) {
@@ -186,19 +234,205 @@ void Window::initRangeValuesMap() {
 }
 
 void Window::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
     decodedInputVectors_[col].decode(*input->childAt(col));
   }
 
+  const vector_size_t firstNewRow = sortedRows_.size();
   // Add all the rows into the RowContainer.
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
 
     for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
+      data_->store(decodedInputVectors_[col], row, newRow, dataColumns_[col]);
+    }
+    if (inputsSorted_) {
+      sortedRows_.push_back(newRow);
     }
   }
   numRows_ += input->size();
+
+  if (inputsSorted_) {
+    updatePartitionStartRows(firstNewRow);
+  }
+}
+
+bool Window::isSamePartition(const char* lhs, const char* rhs) {
+  for (const auto& key : partitionKeyInfo_) {
+    if (data_->compare(lhs, rhs, dataColumns_[key.first])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Window::updatePartitionStartRows(vector_size_t firstNewRow) {
+  if (partitionStartRows_.empty()) {
+    partitionStartRows_.push_back(0);
+  }
+  for (auto i = std::max<vector_size_t>(1, firstNewRow);
+       i < sortedRows_.size();
+       ++i) {
+    if (!isSamePartition(sortedRows_[i - 1], sortedRows_[i])) {
+      partitionStartRows_.push_back(i);
+    }
+  }
+}
+
+void Window::releaseProcessedRows() {
+  VELOX_CHECK(inputsSorted_);
+  VELOX_CHECK_EQ(numProcessedRows_, partitionStartRows_.back());
+  data_->eraseRows(folly::Range<char**>(sortedRows_.data(), numProcessedRows_));
+  sortedRows_.erase(
+      sortedRows_.begin(), sortedRows_.begin() + numProcessedRows_);
+  partitionStartRows_.clear();
+  if (!sortedRows_.empty()) {
+    partitionStartRows_.push_back(0);
+  }
+  numProcessedRows_ = 0;
+  currentPartition_ = 0;
+  peerStartRow_ = 0;
+  peerEndRow_ = 0;
+}
+
+void Window::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+
+  const int64_t numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input->estimateFlatSize();
+
+  const auto& spillConfig = spillConfig_.value();
+  // Test-only spill path.
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
+    spill(
+        numRows - rowsToSpill,
+        outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
+    return;
+  }
+
+  const auto currentUsage = pool()->currentBytes();
+  if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
+    const int64_t bytesToSpill =
+        currentUsage * spillConfig.spillableReservationGrowthPct / 100;
+    auto rowsToSpill = std::max<int64_t>(
+        1, bytesToSpill / (data_->fixedRowSize() + outOfLineBytesPerRow));
+    spill(
+        std::max<int64_t>(0, numRows - rowsToSpill),
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  if (freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    // Enough free rows for input rows and enough variable length free
+    // space for the flat size of the whole vector. If outOfLineBytes
+    // is 0 there is no need for variable length space.
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
+
+  // There must be at least 2x the increment in reservation.
+  if (pool()->availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+
+  // Check if can increase reservation. The increment is the larger of twice the
+  // maximum increment from this input and 'spillableReservationGrowthPct_' of
+  // the current reservation.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool()->maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
+void Window::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a window operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from window operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  spill(0, targetBytes);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  data_->clear();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void Window::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillType_,
+        data_->keyTypes().size(),
+        keyCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        Spiller::spillPool(),
+        spillConfig.executor,
+        spillConfig.codecOptions,
+        spillConfig.tiers);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+}
+
+void Window::recordSpillStats() {
+  VELOX_CHECK_NOT_NULL(spiller_);
+  VELOX_CHECK(noMoreInput_);
+
+  const auto spillStats = spiller_->stats();
+  auto lockedStats = stats_.wlock();
+  lockedStats->spilledBytes = spillStats.spilledBytes;
+  lockedStats->spilledRows = spillStats.spilledRows;
+  lockedStats->spilledPartitions = spillStats.spilledPartitions;
+  lockedStats->spilledFiles = spillStats.spilledFiles;
 }
 
 inline bool Window::compareRowsWithKeys(
@@ -212,7 +446,7 @@ inline bool Window::compareRowsWithKeys(
     if (auto result = data_->compare(
             lhs,
             rhs,
-            key.first,
+            dataColumns_[key.first],
             {key.second.isNullsFirst(), key.second.isAscending(), false})) {
       return result < 0;
     }
@@ -247,8 +481,8 @@ void Window::createPeerAndFrameBuffers() {
 }
 
 void Window::computePartitionStartRows() {
-  // Randomly assuming that max 10000 partitions are in the data.
-  partitionStartRows_.reserve(numRows_);
+  partitionStartRows_.clear();
+  partitionStartRows_.reserve(sortedRows_.size() + 1);
   auto partitionCompare = [&](const char* lhs, const char* rhs) -> bool {
     return compareRowsWithKeys(lhs, rhs, partitionKeyInfo_);
   };
@@ -281,12 +515,15 @@ void Window::sortPartitions() {
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
   if (!FLAGS_SkipRowSortInWindowOp) {
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-        });
+    std::vector<column_index_t> keyColumns;
+    std::vector<CompareFlags> keyFlags;
+    for (const auto& [channel, sortOrder] : allKeyInfo_) {
+      keyColumns.push_back(dataColumns_[channel]);
+      keyFlags.push_back(
+          {sortOrder.isNullsFirst(), sortOrder.isAscending(), false});
+    }
+    PrefixSort(data_.get(), std::move(keyColumns), std::move(keyFlags))
+        .sort(sortedRows_);
   }
 
   computePartitionStartRows();
@@ -294,6 +531,53 @@ void Window::sortPartitions() {
   currentPartition_ = 0;
 }
 
+void Window::loadSpilledPartitions() {
+  VELOX_CHECK_NOT_NULL(spillMerge_);
+  data_->clear();
+  sortedRows_.clear();
+  numProcessedRows_ = 0;
+  peerStartRow_ = 0;
+  peerEndRow_ = 0;
+
+  // Returns true if the current row of 'stream' is in the partition of 'row'.
+  auto isSamePartition = [&](const char* row, SpillMergeStream& stream) {
+    const auto index = stream.currentIndex();
+    for (const auto& key : partitionKeyInfo_) {
+      const auto column = dataColumns_[key.first];
+      if (data_->compare(
+              row, data_->columnAt(column), stream.decoded(column), index)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (;;) {
+    auto* stream = spillMerge_->next();
+    if (stream == nullptr) {
+      break;
+    }
+    // Stop at the next partition boundary once there are enough rows for an
+    // output batch.
+    if (sortedRows_.size() >= numRowsPerOutput_ &&
+        !isSamePartition(sortedRows_.back(), *stream)) {
+      break;
+    }
+    const auto index = stream->currentIndex();
+    char* newRow = data_->newRow();
+    for (auto col = 0; col < numInputColumns_; ++col) {
+      data_->store(stream->decoded(col), index, newRow, col);
+    }
+    sortedRows_.push_back(newRow);
+    stream->pop();
+  }
+
+  if (!sortedRows_.empty()) {
+    computePartitionStartRows();
+  }
+  currentPartition_ = 0;
+}
+
 void Window::noMoreInput() {
   Operator::noMoreInput();
   // No data.
@@ -302,6 +586,28 @@ void Window::noMoreInput() {
     return;
   }
 
+  if (inputsSorted_) {
+    // The last partition is complete now.
+    if (!sortedRows_.empty()) {
+      partitionStartRows_.push_back(sortedRows_.size());
+    }
+    return;
+  }
+
+  if (spiller_ != nullptr) {
+    createPeerAndFrameBuffers();
+    // Finish spill, and we shouldn't get any rows from non-spilled partition as
+    // there is only one partition for the window spiller.
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+
+    VELOX_CHECK_NULL(spillMerge_);
+    recordSpillStats();
+    spillMerge_ = spiller_->startMerge(0);
+    loadSpilledPartitions();
+    return;
+  }
+
   // At this point we have seen all the input rows. We can start
   // outputting rows now.
   // However, some preparation is needed. The rows should be
@@ -311,34 +617,87 @@ void Window::noMoreInput() {
   createPeerAndFrameBuffers();
 }
 
+#define VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH(                           \
+    TEMPLATE_FUNC, typeKind, ...)                                             \
+  [&]() {                                                                     \
+    switch (typeKind) {                                                       \
+      case ::facebook::velox::TypeKind::INTEGER: {                            \
+        return TEMPLATE_FUNC<::facebook::velox::TypeKind::INTEGER>(           \
+            __VA_ARGS__);                                                     \
+      }                                                                       \
+      case ::facebook::velox::TypeKind::TINYINT: {                            \
+        return TEMPLATE_FUNC<::facebook::velox::TypeKind::TINYINT>(           \
+            __VA_ARGS__);                                                     \
+      }                                                                       \
+      case ::facebook::velox::TypeKind::SMALLINT: {                           \
+        return TEMPLATE_FUNC<::facebook::velox::TypeKind::SMALLINT>(          \
+            __VA_ARGS__);                                                     \
+      }                                                                       \
+      case ::facebook::velox::TypeKind::BIGINT: {                             \
+        return TEMPLATE_FUNC<::facebook::velox::TypeKind::BIGINT>(            \
+            __VA_ARGS__);                                                     \
+      }                                                                       \
+      case ::facebook::velox::TypeKind::DATE: {                               \
+        return TEMPLATE_FUNC<::facebook::velox::TypeKind::DATE>(__VA_ARGS__); \
+      }                                                                       \
+      default:                                                                \
+        VELOX_FAIL(                                                           \
+            "Not supported type for sort key!: {}",                           \
+            mapTypeKindToName(typeKind));                                     \
+    }                                                                         \
+  }()
+
+namespace {
+
+inline int64_t toRangeKey(int64_t value) {
+  return value;
+}
+
+inline int64_t toRangeKey(Date value) {
+  return value.days();
+}
+
+} // namespace
+
+template <TypeKind T>
+void Window::computeRangeKeys(const VectorPtr& values) {
+  using NativeType = typename TypeTraits<T>::NativeType;
+  auto* rawValues = values->asFlatVector<NativeType>()->rawValues();
+  auto& keys = rangeValuesMap_.keys;
+  for (auto i = rangeValuesMap_.firstNonNullRow;
+       i < rangeValuesMap_.endNonNullRow;
+       i++) {
+    keys[i] = toRangeKey(rawValues[i]);
+  }
+}
+
 void Window::computeRangeValuesMap() {
-  auto peerCompare = [&](const char* lhs, const char* rhs) -> bool {
-    return compareRowsWithKeys(lhs, rhs, sortKeyInfo_);
-  };
   auto firstPartitionRow = partitionStartRows_[currentPartition_];
   auto lastPartitionRow = partitionStartRows_[currentPartition_ + 1] - 1;
   auto numRows = lastPartitionRow - firstPartitionRow + 1;
   rangeValuesMap_.rangeValues->resize(numRows);
-  rangeValuesMap_.rowIndices.resize(numRows);
-
-  rangeValuesMap_.rowIndices[0] = 0;
-  int j = 1;
-  for (auto i = firstPartitionRow + 1; i <= lastPartitionRow; i++) {
-    // Here, we removed the below check code, in order to keep raw values.
-    // if (peerCompare(sortedRows_[i - 1], sortedRows_[i])) {
-    // The order by values are extracted from the Window partition which
-    // starts from row number 0 for the firstPartitionRow. So the index
-    // requires adjustment.
-    rangeValuesMap_.rowIndices[j++] = i - firstPartitionRow;
-    // }
-  }
-
-  // If sort key is desc then reverse the rowIndices so that the range values
-  // are guaranteed ascending for the further lookup logic.
-  auto valueIndexesRange = folly::Range(rangeValuesMap_.rowIndices.data(), j);
   windowPartition_->extractColumn(
-      sortKeyInfo_[0].first, valueIndexesRange, 0, rangeValuesMap_.rangeValues);
+      sortKeyInfo_[0].first, 0, numRows, 0, rangeValuesMap_.rangeValues);
+
+  const auto& values = rangeValuesMap_.rangeValues;
+  vector_size_t firstNonNullRow = 0;
+  vector_size_t endNonNullRow = numRows;
+  if (values->mayHaveNulls()) {
+    while (firstNonNullRow < numRows && values->isNullAt(firstNonNullRow)) {
+      firstNonNullRow++;
+    }
+    while (endNonNullRow > firstNonNullRow &&
+           values->isNullAt(endNonNullRow - 1)) {
+      endNonNullRow--;
+    }
+  }
+  rangeValuesMap_.firstNonNullRow = firstNonNullRow;
+  rangeValuesMap_.endNonNullRow = endNonNullRow;
+  rangeValuesMap_.keys.resize(numRows);
+  VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH(
+      computeRangeKeys, rangeValuesMap_.rangeType->kind(), values);
 }
+#undef VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH
 
 void Window::callResetPartition(vector_size_t partitionNumber) {
   partitionOffset_ = 0;
@@ -402,83 +761,6 @@ void Window::updateKRowsFrameBounds(
   }
 }
 
-namespace {
-
-template <typename T>
-vector_size_t findIndex(
-    const T value,
-    vector_size_t leftBound,
-    vector_size_t rightBound,
-    const FlatVectorPtr<T>& values,
-    bool findStart) {
-  vector_size_t originalRightBound = rightBound;
-  vector_size_t originalLeftBound = leftBound;
-  while (leftBound < rightBound) {
-    vector_size_t mid = round((leftBound + rightBound) / 2.0);
-    auto midValue = values->valueAt(mid);
-    if (value == midValue) {
-      return mid;
-    }
-
-    if (value < midValue) {
-      rightBound = mid - 1;
-    } else {
-      leftBound = mid + 1;
-    }
-  }
-
-  // The value is not found but leftBound == rightBound at this point.
-  // This could be a value which is the least number greater than
-  // or the largest number less than value.
-  // The semantics of this function are to always return the smallest larger
-  // value (or rightBound if end of range).
-  if (findStart) {
-    if (value <= values->valueAt(rightBound)) {
-      // return std::max(originalLeftBound, rightBound);
-      return rightBound;
-    }
-    return std::min(originalRightBound, rightBound + 1);
-  }
-  if (value < values->valueAt(rightBound)) {
-    return std::max(originalLeftBound, rightBound - 1);
-  }
-  // std::max(originalLeftBound, rightBound)?
-  return std::min(originalRightBound, rightBound);
-}
-
-} // namespace
-
-// TODO: unify into one function.
-template <typename T>
-inline vector_size_t Window::kRangeStartBoundSearch(
-    const T value,
-    vector_size_t leftBound,
-    vector_size_t rightBound,
-    const FlatVectorPtr<T>& valuesVector,
-    const vector_size_t* rawPeerStarts,
-    vector_size_t& indexFound) {
-  auto index = findIndex<T>(value, leftBound, rightBound, valuesVector, true);
-  indexFound = index;
-  // Since this is a kPreceding bound it includes the row at the index.
-  return rangeValuesMap_.rowIndices[rawPeerStarts[index]];
-}
-
-// TODO: lastRightBoundRow looks useless.
-template <typename T>
-vector_size_t Window::kRangeEndBoundSearch(
-    const T value,
-    vector_size_t leftBound,
-    vector_size_t rightBound,
-    vector_size_t lastRightBoundRow,
-    const FlatVectorPtr<T>& valuesVector,
-    const vector_size_t* rawPeerEnds,
-    vector_size_t& indexFound) {
-  auto index = findIndex<T>(value, leftBound, rightBound, valuesVector, false);
-  indexFound = index;
-  return rangeValuesMap_.rowIndices[rawPeerEnds[index]];
-}
-
-template <TypeKind T>
 void Window::updateKRangeFrameBounds(
     bool isKPreceding,
     bool isStartBound,
@@ -487,98 +769,87 @@ void Window::updateKRangeFrameBounds(
     vector_size_t* rawFrameBounds,
     const vector_size_t* rawPeerStarts,
     const vector_size_t* rawPeerEnds) {
-  using NativeType = typename TypeTraits<T>::NativeType;
-  // Extract the order by key column to calculate the range values for the frame
-  // boundaries.
-  std::shared_ptr<const Type> sortKeyType =
-      outputType_->childAt(sortKeyInfo_[0].first);
-  auto orderByValues = BaseVector::create(sortKeyType, numRows, pool());
-  windowPartition_->extractColumn(
-      sortKeyInfo_[0].first, partitionOffset_, numRows, 0, orderByValues);
-  auto* rangeValuesFlatVector = orderByValues->asFlatVector<NativeType>();
-  auto* rawRangeValues = rangeValuesFlatVector->mutableRawValues();
-
+  const int64_t* offsets = nullptr;
+  int64_t constantOffset = 0;
   if (frameArg.index == kConstantChannel) {
-    auto constantOffset = frameArg.constant.value();
-    constantOffset = isKPreceding ? -constantOffset : constantOffset;
-    for (int i = 0; i < numRows; i++) {
-      rawRangeValues[i] = rangeValuesFlatVector->valueAt(i) + constantOffset;
-    }
+    constantOffset = frameArg.constant.value();
   } else {
     windowPartition_->extractColumn(
         frameArg.index, partitionOffset_, numRows, 0, frameArg.value);
-    auto offsets = frameArg.value->values()->as<int64_t>();
+    offsets = frameArg.value->values()->as<int64_t>();
     for (auto i = 0; i < numRows; i++) {
       VELOX_USER_CHECK(
           !frameArg.value->isNullAt(i), "k in frame bounds cannot be null");
       VELOX_USER_CHECK_GE(
           offsets[i], 1, "k in frame bounds must be at least 1");
     }
+  }
 
-    auto precedingFactor = isKPreceding ? -1 : 1;
-    for (auto i = 0; i < numRows; i++) {
-      rawRangeValues[i] = rangeValuesFlatVector->valueAt(i) +
-          vector_size_t(precedingFactor * offsets[i]);
+  const auto& values = rangeValuesMap_.rangeValues;
+  const auto* keys = rangeValuesMap_.keys.data();
+  const auto firstNonNullRow = rangeValuesMap_.firstNonNullRow;
+  const auto endNonNullRow = rangeValuesMap_.endNonNullRow;
+  const auto numPartitionRows = static_cast<vector_size_t>(values->size());
+  const bool ascending = sortKeyInfo_[0].second.isAscending();
+  // The bound value is the order by value of the row plus or minus the
+  // offset. It is computed in 128 bits so that it can't overflow. A PRECEDING
+  // bound moves towards the start of the partition, which has the smaller
+  // values if the order is ascending and the larger ones otherwise.
+  const int128_t sign = isKPreceding == ascending ? -1 : 1;
+
+  // A frame starts at the first row that is not before the bound value in
+  // the sort order and ends at the row before the first row that is after
+  // the bound value. 'inFront' is true for the rows before that first row. It
+  // is true for a prefix of the non-null rows.
+  int128_t boundValue = 0;
+  auto inFront = [&](vector_size_t row) {
+    if (isStartBound) {
+      return ascending ? keys[row] < boundValue : keys[row] > boundValue;
     }
-  }
+    return ascending ? keys[row] <= boundValue : keys[row] >= boundValue;
+  };
 
-  // Set the frame bounds from looking up the rangeValues index.
-  vector_size_t leftBound = 0;
-  vector_size_t rightBound = rangeValuesMap_.rowIndices.size() - 1;
-  auto lastPartitionRow = partitionStartRows_[currentPartition_ + 1] - 1;
-  auto rangeIndexValues = std::dynamic_pointer_cast<FlatVector<NativeType>>(
-      rangeValuesMap_.rangeValues);
-  vector_size_t indexFound;
-  if (isStartBound) {
-    vector_size_t dynamicLeftBound = leftBound;
-    vector_size_t dynamicRightBound = 0;
-    for (auto i = 0; i < numRows; i++) {
-      // Handle null.
-      // Different with duckDB result. May need to separate the handling for
-      // spark & presto.
-      if (rangeValuesFlatVector->mayHaveNulls() &&
-          rangeValuesFlatVector->isNullAt(i)) {
-        rawFrameBounds[i] = i;
-        continue;
-      }
-      // It is supposed the index being found is always on the left of the
-      // current handling position if we only consider positive lower value
-      // offset (>= 1).
-      dynamicRightBound = i;
-      rawFrameBounds[i] = kRangeStartBoundSearch<NativeType>(
-          rawRangeValues[i],
-          dynamicLeftBound,
-          dynamicRightBound,
-          rangeIndexValues,
-          rawPeerStarts,
-          indexFound);
-      dynamicLeftBound = indexFound;
+  // With a constant offset the bound values follow the sort order of the
+  // rows, so the first row that is not 'inFront' only moves forward. Only the
+  // first row of the block needs a binary search. With per-row offsets each
+  // row is searched.
+  vector_size_t cursor = -1;
+  for (auto i = 0; i < numRows; i++) {
+    const auto row = partitionOffset_ + i;
+    // The frame of a row with a null order by value is its peer group, i.e.
+    // all the rows with null values.
+    if (values->isNullAt(row)) {
+      rawFrameBounds[i] = isStartBound ? rawPeerStarts[i] : rawPeerEnds[i];
+      continue;
     }
-  } else {
-    vector_size_t dynamicRightBound = rightBound;
-    vector_size_t dynamicLeftBound = 0;
-    for (auto i = 0; i < numRows; i++) {
-      // Handle null.
-      // Different with duckDB result. May need to separate the handling for
-      // spark & presto.
-      if (rangeValuesFlatVector->mayHaveNulls() &&
-          rangeValuesFlatVector->isNullAt(i)) {
-        rawFrameBounds[i] = i;
-        continue;
+
+    boundValue =
+        keys[row] + sign * (offsets != nullptr ? offsets[i] : constantOffset);
+    if (offsets != nullptr || cursor < 0) {
+      vector_size_t low = firstNonNullRow;
+      vector_size_t high = endNonNullRow;
+      while (low < high) {
+        const auto mid = low + (high - low) / 2;
+        if (inFront(mid)) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      cursor = low;
+    } else {
+      while (cursor < endNonNullRow && inFront(cursor)) {
+        cursor++;
       }
-      // It is supposed the index being found is always on the right of the
-      // current handling position if we only consider positive higher value
-      // offset (>= 1).
-      dynamicLeftBound = i;
-      rawFrameBounds[i] = kRangeEndBoundSearch<NativeType>(
-          rawRangeValues[i],
-          dynamicLeftBound,
-          dynamicRightBound,
-          lastPartitionRow,
-          rangeIndexValues,
-          rawPeerEnds,
-          indexFound);
-      dynamicRightBound = rightBound;
+    }
+
+    // Frames that would start after the last non-null row or end before the
+    // first one are empty. They are marked invalid by computeValidFrames.
+    if (isStartBound) {
+      rawFrameBounds[i] =
+          cursor == endNonNullRow ? numPartitionRows : cursor;
+    } else {
+      rawFrameBounds[i] = cursor == firstNonNullRow ? -1 : cursor - 1;
     }
   }
 }
@@ -627,40 +898,7 @@ void Window::updateFrameBounds(
         updateKRowsFrameBounds(
             true, frameArg.value(), startRow, numRows, rawFrameBounds);
       } else {
-#define VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH(                           \
-    TEMPLATE_FUNC, typeKind, ...)                                             \
-  [&]() {                                                                     \
-    switch (typeKind) {                                                       \
-      case ::facebook::velox::TypeKind::INTEGER: {                            \
-        return TEMPLATE_FUNC<::facebook::velox::TypeKind::INTEGER>(           \
-            __VA_ARGS__);                                                     \
-      }                                                                       \
-      case ::facebook::velox::TypeKind::TINYINT: {                            \
-        return TEMPLATE_FUNC<::facebook::velox::TypeKind::TINYINT>(           \
-            __VA_ARGS__);                                                     \
-      }                                                                       \
-      case ::facebook::velox::TypeKind::SMALLINT: {                           \
-        return TEMPLATE_FUNC<::facebook::velox::TypeKind::SMALLINT>(          \
-            __VA_ARGS__);                                                     \
-      }                                                                       \
-      case ::facebook::velox::TypeKind::BIGINT: {                             \
-        return TEMPLATE_FUNC<::facebook::velox::TypeKind::BIGINT>(            \
-            __VA_ARGS__);                                                     \
-      }                                                                       \
-      case ::facebook::velox::TypeKind::DATE: {                               \
-        return TEMPLATE_FUNC<::facebook::velox::TypeKind::DATE>(__VA_ARGS__); \
-      }                                                                       \
-      default:                                                                \
-        VELOX_FAIL(                                                           \
-            "Not supported type for sort key!: {}",                           \
-            mapTypeKindToName(typeKind));                                     \
-    }                                                                         \
-  }()
-        // Sort key type.
-        auto sortKeyTypePtr = outputType_->childAt(sortKeyInfo_[0].first);
-        VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH(
-            updateKRangeFrameBounds,
-            sortKeyTypePtr->kind(),
+        updateKRangeFrameBounds(
             true,
             isStartBound,
             frameArg.value(),
@@ -676,11 +914,7 @@ void Window::updateFrameBounds(
         updateKRowsFrameBounds(
             false, frameArg.value(), startRow, numRows, rawFrameBounds);
       } else {
-        // Sort key type.
-        auto sortKeyTypePtr = outputType_->childAt(sortKeyInfo_[0].first);
-        VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH(
-            updateKRangeFrameBounds,
-            sortKeyTypePtr->kind(),
+        updateKRangeFrameBounds(
             false,
             isStartBound,
             frameArg.value(),
@@ -688,7 +922,6 @@ void Window::updateFrameBounds(
             rawFrameBounds,
             rawPeerStarts,
             rawPeerEnds);
-#undef VELOX_DYNAMIC_LIMITED_SCALAR_TYPE_DISPATCH
       }
       break;
     }
@@ -892,11 +1125,23 @@ void Window::callApplyLoop(
 }
 
 RowVectorPtr Window::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_) {
+    return nullptr;
+  }
+  if (inputsSorted_) {
+    if (partitionStartRows_.empty() ||
+        numProcessedRows_ == partitionStartRows_.back()) {
+      // No complete partition to output.
+      return nullptr;
+    }
+    if (peerStartBuffer_ == nullptr) {
+      createPeerAndFrameBuffers();
+    }
+  } else if (!noMoreInput_) {
     return nullptr;
   }
 
-  auto numRowsLeft = numRows_ - numProcessedRows_;
+  vector_size_t numRowsLeft = partitionStartRows_.back() - numProcessedRows_;
   auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = std::dynamic_pointer_cast<RowVector>(
       BaseVector::create(outputType_, numOutputRows, operatorCtx_->pool()));
@@ -906,7 +1151,7 @@ RowVectorPtr Window::getOutput() {
     data_->extractColumn(
         sortedRows_.data() + numProcessedRows_,
         numOutputRows,
-        i,
+        dataColumns_[i],
         result->childAt(i));
   }
 
@@ -926,8 +1171,27 @@ RowVectorPtr Window::getOutput() {
     result->childAt(j) = windowOutputs[j - numInputColumns_];
   }
 
+  if (inputsSorted_) {
+    if (numProcessedRows_ == partitionStartRows_.back()) {
+      releaseProcessedRows();
+      finished_ = noMoreInput_ && sortedRows_.empty();
+    }
+    return result;
+  }
+
+  if (numProcessedRows_ == sortedRows_.size() && spillMerge_ != nullptr) {
+    loadSpilledPartitions();
+  }
   finished_ = (numProcessedRows_ == sortedRows_.size());
   return result;
 }
 
+void Window::close() {
+  Operator::close();
+
+  spillMerge_.reset();
+  spiller_.reset();
+  data_.reset();
+}
+
 } // namespace facebook::velox::exec
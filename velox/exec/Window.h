@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/WindowPartition.h"
 
@@ -34,6 +35,17 @@ namespace facebook::velox::exec {
 ///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
+///
+/// If the input is already partitioned and sorted (WindowNode::inputsSorted),
+/// the operator runs in streaming mode: a partition is output as soon as the
+/// first row of the next partition arrives and its rows are then released,
+/// so only the largest partition needs to be held in memory.
+///
+/// Otherwise, if spilling is enabled, the input rows are spilled sorted by
+/// (partition_by keys + order_by keys) when memory runs short. After all the
+/// input is received, the spilled runs are merged and read back a few
+/// partitions at a time, so only the partitions being output need to be held
+/// in memory.
 class Window : public Operator {
  public:
   Window(
@@ -46,7 +58,11 @@ class Window : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_;
+    // In streaming mode, the complete partitions are output before accepting
+    // more input.
+    return !noMoreInput_ &&
+        (!inputsSorted_ || partitionStartRows_.empty() ||
+         numProcessedRows_ == partitionStartRows_.back());
   }
 
   void noMoreInput() override;
@@ -59,6 +75,10 @@ class Window : public Operator {
     return finished_;
   }
 
+  void reclaim(uint64_t targetBytes) override;
+
+  void close() override;
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -86,6 +106,30 @@ class Window : public Operator {
       const std::shared_ptr<const core::WindowNode>& windowNode,
       const RowTypePtr& inputType);
 
+  // Creates 'data_' with the partition and sort keys stored first as the keys
+  // of the RowContainer, followed by the other input columns. Sets
+  // 'dataColumns_', 'keyCompareFlags_' and 'spillType_' to match.
+  void createRowContainer(const RowTypePtr& inputType);
+
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills enough to
+  // make 'input' fit.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills content until under 'targetRows' and under 'targetBytes' of out of
+  // line data are left. If 'targetRows' is 0, spills everything.
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  // Invoked to record the spilling stats in operator stats after processing all
+  // the inputs.
+  void recordSpillStats();
+
+  // Reads the next partitions from 'spillMerge_' into 'data_' and sets up
+  // 'sortedRows_' and 'partitionStartRows_' for them. Reads whole partitions
+  // until at least 'numRowsPerOutput_' rows are loaded or the spilled data is
+  // exhausted. Leaves 'sortedRows_' empty if there are no more rows.
+  void loadSpilledPartitions();
+
   // Helper function to initialize range values map for k Range frames.
   void initRangeValuesMap();
 
@@ -93,6 +137,18 @@ class Window : public Operator {
   // row indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
 
+  // Returns true if 'lhs' and 'rhs' have the same partition keys.
+  bool isSamePartition(const char* lhs, const char* rhs);
+
+  // Used in streaming mode to add the rows of 'sortedRows_' from
+  // 'firstNewRow' on to 'partitionStartRows_'. The last partition is only
+  // complete once the next partition starts or there is no more input.
+  void updatePartitionStartRows(vector_size_t firstNewRow);
+
+  // Used in streaming mode to free the rows of the partitions that have been
+  // output and continue with the incomplete last partition.
+  void releaseProcessedRows();
+
   // Function to compute the partitionStartRows_ structure.
   // partitionStartRows_ is vector of the starting rows index
   // of each partition in the data. This is an auxiliary
@@ -156,7 +212,9 @@ class Window : public Operator {
       vector_size_t numRows,
       vector_size_t* rawFrameBounds);
 
-  template <TypeKind T>
+  // Helper function to update frame bounds for kPreceding, kFollowing range
+  // frames. Sweeps the sorted order by values of the partition, so a block
+  // with a constant offset takes linear time.
   void updateKRangeFrameBounds(
       bool isKPreceding,
       bool isStartBound,
@@ -166,6 +224,10 @@ class Window : public Operator {
       const vector_size_t* rawPeerStarts,
       const vector_size_t* rawPeerEnds);
 
+  // Fills rangeValuesMap_.keys from the order by 'values' of the partition.
+  template <TypeKind T>
+  void computeRangeKeys(const VectorPtr& values);
+
   // Helper function to update frame bounds.
   void updateFrameBounds(
       const WindowFrame& windowFrame,
@@ -176,33 +238,44 @@ class Window : public Operator {
       const vector_size_t* rawPeerEnds,
       vector_size_t* rawFrameBounds);
 
-  template <typename T>
-  vector_size_t kRangeStartBoundSearch(
-      const T value,
-      vector_size_t leftBound,
-      vector_size_t rightBound,
-      const FlatVectorPtr<T>& valuesVector,
-      const vector_size_t* rawPeerStarts,
-      vector_size_t& indexFound);
-
-  template <typename T>
-  vector_size_t kRangeEndBoundSearch(
-      const T value,
-      vector_size_t leftBound,
-      vector_size_t rightBound,
-      vector_size_t lastRightBoundRow,
-      const FlatVectorPtr<T>& valuesVector,
-      const vector_size_t* rawPeerEnds,
-      vector_size_t& indexFound);
-
   bool finished_ = false;
   const vector_size_t numInputColumns_;
 
+  // True if the input is partitioned and sorted, so partitions are output as
+  // soon as they are complete.
+  const bool inputsSorted_;
+
+  // The maximum memory usage that a window operator can hold before spilling.
+  // If it is zero, then there is no such limit.
+  const uint64_t spillMemoryThreshold_;
+
   // The Window operator needs to see all the input rows before starting
   // any function computation. As the Window operators gets input rows
-  // we store the rows in the RowContainer (data_).
+  // we store the rows in the RowContainer (data_). If input was spilled,
+  // 'data_' holds the partitions read back from the spilled runs that are
+  // being output.
   std::unique_ptr<RowContainer> data_;
 
+  // The column of 'data_' storing each input channel. The partition and sort
+  // key columns are stored first so that the spiller can sort and merge the
+  // rows on them.
+  std::vector<column_index_t> dataColumns_;
+
+  // Sort order of the key columns of 'data_'.
+  std::vector<CompareFlags> keyCompareFlags_;
+
+  // The row type of 'data_' used for spilling.
+  RowTypePtr spillType_;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_'.
+  uint64_t spillTestCounter_{0};
+
+  // Set to read back spilled data if disk spilling has been triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
   // The decodedInputVectors_ are reused across addInput() calls to decode
   // the partition and sort keys for the above RowContainer.
   std::vector<DecodedVector> decodedInputVectors_;
@@ -238,7 +311,8 @@ class Window : public Operator {
   // Vector of pointers to each input row in the data_ RowContainer.
   // The rows are sorted by partitionKeys + sortKeys. This total
   // ordering can be used to split partitions (with the correct
-  // order by) for the processing.
+  // order by) for the processing. If input was spilled, this only
+  // has the rows of the partitions currently loaded in data_.
   std::vector<char*> sortedRows_;
 
   // Window partition object used to provide per-partition
@@ -251,7 +325,9 @@ class Window : public Operator {
   // This is a vector that gives the index of the start row
   // (in sortedRows_) of each partition in the RowContainer data_.
   // This auxiliary structure helps demarcate partitions in
-  // getOutput calls.
+  // getOutput calls. The last element is the end of the last
+  // complete partition. In streaming mode, the rows after it are
+  // the rows of a partition that is still receiving input.
   std::vector<vector_size_t> partitionStartRows_;
 
   // The following 4 Buffers are used to pass peer and frame start and
@@ -278,21 +354,20 @@ class Window : public Operator {
   // There is one SelectivityVector per window function.
   std::vector<SelectivityVector> validFrames_;
 
-  // When computing k Range frames, the range value for the frame index needs
-  // to be mapped to the partition row for the value.
-  // This is an auxiliary structure to materialize a mapping from
-  // range value -> row index (in RowContainer) for that purpose.
-  // It uses a vector of the ordered range values and another vector of the
-  // corresponding row indices. Ideally a binary search
-  // tree or B-tree index (especially if the data is spilled to disk) should be
-  // used.
+  // When computing k Range frames, the frame bounds are found by comparing
+  // the order by values of the partition rows with the value of the current
+  // row plus or minus the offset. This holds the order by values of the
+  // current partition in partition order.
   struct RangeValuesMap {
     TypePtr rangeType;
-    // The range values appear in sorted order in this vector.
+    // The order by values of the partition rows.
     VectorPtr rangeValues;
-    // TODO (Make this a BufferPtr so that it can be allocated in the
-    // MemoryPool) ?
-    std::vector<vector_size_t> rowIndices;
+    // The non-null 'rangeValues' as int64_t. DATE values are in days.
+    std::vector<int64_t> keys;
+    // Nulls sort together at the start or the end of the partition. The rows
+    // with non-null values are [firstNonNullRow, endNonNullRow).
+    vector_size_t firstNonNullRow;
+    vector_size_t endNonNullRow;
   };
   RangeValuesMap rangeValuesMap_;
 
@@ -77,19 +77,59 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  // Makes 'numVectors' batches of a partitioning key and two low cardinality
+  // string columns. The string columns of all batches are dictionaries over
+  // the same values, like the columns read from one file.
+  std::vector<RowVectorPtr> makeDictionaryRows(
+      int32_t numVectors,
+      int32_t rowsPerVector) {
+    auto makeDictionary = [&](int32_t cardinality) {
+      return makeFlatVector<std::string>(cardinality, [](auto row) {
+        return fmt::format("low cardinality string value {}", row);
+      });
+    };
+    auto small = makeDictionary(16);
+    auto large = makeDictionary(200);
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      vectors.push_back(makeRowVector(
+          {makeFlatVector<int64_t>(
+               rowsPerVector,
+               [&](auto row) { return i * rowsPerVector + row; }),
+           wrapInDictionary(
+               makeIndices(rowsPerVector, [](auto row) { return row % 16; }),
+               rowsPerVector,
+               small),
+           wrapInDictionary(
+               makeIndices(
+                   rowsPerVector, [](auto row) { return (row * 7) % 200; }),
+               rowsPerVector,
+               large)}));
+    }
+    return vectors;
+  }
+
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      bool preserveEncodings = false,
+      int32_t numPartitions = 0) {
     assert(!vectors.empty());
+    // Each partition is consumed by its own task.
+    if (numPartitions == 0) {
+      numPartitions = width;
+    }
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kExchangePreserveEncodings] =
+        preserveEncodings ? "true" : "false";
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
                         .values(vectors, true)
-                        .partitionedOutput({"c0"}, width)
+                        .partitionedOutput({"c0"}, numPartitions)
                         .planNode();
 
     auto startMicros = getCurrentTimeMicro();
@@ -110,7 +150,7 @@ class ExchangeBenchmark : public VectorTestBase {
                        .planNode();
 
     std::vector<exec::Split> finalAggSplits;
-    for (int i = 0; i < width; i++) {
+    for (int i = 0; i < numPartitions; i++) {
       auto taskId = makeTaskId("final-agg", i);
       finalAggSplits.push_back(
           exec::Split(std::make_shared<exec::RemoteConnectorSplit>(taskId)));
@@ -299,12 +339,15 @@ std::vector<RowVectorPtr> flat10k;
 std::vector<RowVectorPtr> deep10k;
 std::vector<RowVectorPtr> flat50;
 std::vector<RowVectorPtr> deep50;
+std::vector<RowVectorPtr> dictionary10k;
 
 Counters flat10kCounters;
 Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
 Counters localFlat10kCounters;
+Counters dictionary10kCounters;
+Counters dictionary10kEncodedCounters;
 
 BENCHMARK(exchanegeFlat10k) {
   bm.run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -322,6 +365,36 @@ BENCHMARK_RELATIVE(exchanegeDeep50) {
   bm.run(deep50, FLAGS_width, FLAGS_task_width, deep50Counters);
 }
 
+BENCHMARK(exchangeDictionary10k) {
+  bm.run(dictionary10k, FLAGS_width, FLAGS_task_width, dictionary10kCounters);
+}
+
+BENCHMARK_RELATIVE(exchangeDictionary10kPreserveEncodings) {
+  bm.run(
+      dictionary10k,
+      FLAGS_width,
+      FLAGS_task_width,
+      dictionary10kEncodedCounters,
+      true);
+}
+
+// Routing of rows to many destinations. Each of 'FLAGS_width' producers sends
+// a partition to each of 'numPartitions' consumers.
+void exchangeFlat10kPartitions(uint32_t /*iterations*/, int32_t numPartitions) {
+  Counters counters;
+  bm.run(
+      flat10k,
+      FLAGS_width,
+      FLAGS_task_width,
+      counters,
+      false,
+      numPartitions);
+}
+
+BENCHMARK_NAMED_PARAM(exchangeFlat10kPartitions, 16, 16);
+BENCHMARK_NAMED_PARAM(exchangeFlat10kPartitions, 256, 256);
+BENCHMARK_NAMED_PARAM(exchangeFlat10kPartitions, 1024, 1024);
+
 BENCHMARK(localFlat10k) {
   bm.runLocal(
       flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
@@ -378,12 +451,17 @@ int main(int argc, char** argv) {
   deep10k = bm.makeRows(deepType, 10, 10000);
   flat50 = bm.makeRows(flatType, 2000, 50);
   deep50 = bm.makeRows(deepType, 2000, 50);
+  dictionary10k = bm.makeDictionaryRows(10, 10000);
 
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
-            << "deep50: " << deep50Counters.toString() << std::endl;
+            << "deep50: " << deep50Counters.toString() << std::endl
+            << "dictionary10k: " << dictionary10kCounters.toString()
+            << std::endl
+            << "dictionary10k preserving encodings: "
+            << dictionary10kEncodedCounters.toString() << std::endl;
   return 0;
   return 0;
 }
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <numeric>
+#include "velox/exec/HashTable.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+constexpr int32_t kBatchSize = 1'024;
+constexpr int32_t kNumProbeBatches = 100;
+
+// A hash table with 'numKeys' random BIGINT keys and batches of keys that all
+// hit the table. Measures the probes with and without prefetching.
+class ProbeTable {
+ public:
+  explicit ProbeTable(int32_t numKeys) : numKeys_(numKeys) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    hashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    table_ = HashTable<false>::createForAggregation(
+        std::move(hashers), {}, pool_.get());
+    lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    std::vector<int64_t> keys(numKeys);
+    for (auto& key : keys) {
+      key = folly::Random::rand64(rng);
+    }
+    for (auto start = 0; start < numKeys; start += kBatchSize) {
+      const auto size = std::min(kBatchSize, numKeys - start);
+      auto batch = vectorMaker_.flatVector<int64_t>(
+          size, [&](auto row) { return keys[start + row]; });
+      while (!hash(batch)) {
+        table_->decideHashMode(size);
+      }
+      table_->groupProbe(*lookup_);
+    }
+    for (auto i = 0; i < kNumProbeBatches; ++i) {
+      probeBatches_.push_back(vectorMaker_.flatVector<int64_t>(
+          kBatchSize, [&](auto /*row*/) {
+            return keys[folly::Random::rand32(numKeys, rng)];
+          }));
+    }
+  }
+
+  int32_t numKeys() const {
+    return numKeys_;
+  }
+
+  void setPrefetch(bool prefetch) {
+    table_->testingSetMinTableBytesForProbePrefetch(
+        prefetch ? 0 : std::numeric_limits<uint64_t>::max());
+  }
+
+  // Probes all the batches and returns the number of hits.
+  int64_t probe(bool join) {
+    int64_t numHits = 0;
+    for (const auto& batch : probeBatches_) {
+      VELOX_CHECK(hash(batch));
+      if (join) {
+        table_->joinProbe(*lookup_);
+      } else {
+        table_->groupProbe(*lookup_);
+      }
+      for (auto row : lookup_->rows) {
+        numHits += lookup_->hits[row] != nullptr;
+      }
+    }
+    return numHits;
+  }
+
+ private:
+  // Sets up 'lookup_' for probing 'keys'. Returns false if the keys do not
+  // fit the value ids of the table.
+  bool hash(const VectorPtr& keys) {
+    const SelectivityVector rows(keys->size());
+    lookup_->reset(keys->size());
+    std::iota(lookup_->rows.begin(), lookup_->rows.end(), 0);
+    auto& hasher = table_->hashers()[0];
+    hasher->decode(*keys, rows);
+    if (table_->hashMode() == BaseHashTable::HashMode::kHash) {
+      hasher->hash(rows, false, lookup_->hashes);
+      return true;
+    }
+    return hasher->computeValueIds(rows, lookup_->hashes);
+  }
+
+  const int32_t numKeys_;
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  VectorMaker vectorMaker_{pool_.get()};
+  std::unique_ptr<HashTable<false>> table_;
+  std::unique_ptr<HashLookup> lookup_;
+  std::vector<VectorPtr> probeBatches_;
+};
+
+// Keeps the table of the last size so that the benchmarks of one size share
+// it.
+ProbeTable& probeTable(int32_t numKeys) {
+  static std::unique_ptr<ProbeTable> table;
+  if (table == nullptr || table->numKeys() != numKeys) {
+    table.reset();
+    table = std::make_unique<ProbeTable>(numKeys);
+  }
+  return *table;
+}
+
+void probe(uint32_t iterations, int32_t numKeys, bool join, bool prefetch) {
+  folly::BenchmarkSuspender suspender;
+  auto& table = probeTable(numKeys);
+  table.setPrefetch(prefetch);
+  suspender.dismiss();
+
+  int64_t numHits = 0;
+  for (uint32_t i = 0; i < iterations; ++i) {
+    numHits += table.probe(join);
+  }
+  folly::doNotOptimizeAway(numHits);
+}
+
+void joinProbe(uint32_t iterations, int32_t numKeys) {
+  probe(iterations, numKeys, true, false);
+}
+
+void joinProbePrefetch(uint32_t iterations, int32_t numKeys) {
+  probe(iterations, numKeys, true, true);
+}
+
+void groupProbe(uint32_t iterations, int32_t numKeys) {
+  probe(iterations, numKeys, false, false);
+}
+
+void groupProbePrefetch(uint32_t iterations, int32_t numKeys) {
+  probe(iterations, numKeys, false, true);
+}
+} // namespace
+
+// The tables take about 20 bytes per key plus 9 bytes per slot, e.g. 450KB for
+// 10K keys, which fits in L2, and 600MB for 20M keys, which is 10x larger than
+// a big last level cache.
+BENCHMARK_NAMED_PARAM(joinProbe, 10K, 10'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(joinProbePrefetch, 10K, 10'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 10K, 10'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(groupProbePrefetch, 10K, 10'000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(joinProbe, 200K, 200'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(joinProbePrefetch, 200K, 200'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 200K, 200'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(groupProbePrefetch, 200K, 200'000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(joinProbe, 2M, 2'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(joinProbePrefetch, 2M, 2'000'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 2M, 2'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(groupProbePrefetch, 2M, 2'000'000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(joinProbe, 20M, 20'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(joinProbePrefetch, 20M, 20'000'000);
+BENCHMARK_NAMED_PARAM(groupProbe, 20M, 20'000'000);
+BENCHMARK_RELATIVE_NAMED_PARAM(groupProbePrefetch, 20M, 20'000'000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
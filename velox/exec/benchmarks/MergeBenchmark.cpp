@@ -15,16 +15,78 @@
  */
 
 #include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
 
 #include <gflags/gflags.h>
 
+#include "velox/exec/Merge.h"
 #include "velox/exec/TreeOfLosers.h"
 #include "velox/exec/tests/utils/MergeTestBase.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
+namespace {
+// Merges ordered batches with mergeSortedRuns, on one thread or by key ranges
+// in parallel.
+class RangeMergeBenchmark : public facebook::velox::test::VectorTestBase {
+ public:
+  // Returns one ordered batch of 'numRows' random keys of 'keyType' and a
+  // payload column per source.
+  std::vector<exec::SortedRun>
+  makeRuns(int32_t numSources, vector_size_t numRows, TypeKind keyType) {
+    std::vector<exec::SortedRun> runs;
+    for (auto i = 0; i < numSources; ++i) {
+      std::vector<int64_t> keys(numRows);
+      for (auto& key : keys) {
+        key = folly::Random::rand64(rng_) % 1'000'000'000;
+      }
+      std::sort(keys.begin(), keys.end());
+      VectorPtr keyVector;
+      if (keyType == TypeKind::VARCHAR) {
+        // Zero padded so that the strings sort like the numbers.
+        std::vector<std::string> strings(numRows);
+        for (auto row = 0; row < numRows; ++row) {
+          strings[row] = fmt::format("{:020}", keys[row]);
+        }
+        keyVector = makeFlatVector<StringView>(
+            numRows, [&](auto row) { return StringView(strings[row]); });
+      } else {
+        keyVector = makeFlatVector<int64_t>(
+            numRows, [&](auto row) { return keys[row]; });
+      }
+      auto payload =
+          makeFlatVector<int64_t>(numRows, [](auto row) { return row; });
+      runs.push_back({makeRowVector({keyVector, payload}), 0, numRows});
+    }
+    return runs;
+  }
+
+  void merge(const std::vector<exec::SortedRun>& runs, int32_t numRanges) {
+    auto merged = exec::mergeSortedRuns(
+        runs, sortingKeys_, numRanges, &executor_, 1'024, pool());
+    folly::doNotOptimizeAway(merged);
+  }
+
+ private:
+  const std::vector<std::pair<column_index_t, CompareFlags>> sortingKeys_{
+      {0, CompareFlags{}}};
+  folly::Random::DefaultGenerator rng_{1};
+  folly::CPUThreadPoolExecutor executor_{8};
+};
+
+constexpr int32_t kNumRanges = 8;
+
+std::unique_ptr<RangeMergeBenchmark> rangeMerge;
+std::vector<exec::SortedRun> bigint8;
+std::vector<exec::SortedRun> bigint64;
+std::vector<exec::SortedRun> varchar8;
+std::vector<exec::SortedRun> varchar64;
+} // namespace
+
 TestData narrow;
 TestData medium;
 TestData wide;
@@ -53,6 +115,38 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK(bigint8Sources) {
+  rangeMerge->merge(bigint8, 1);
+}
+
+BENCHMARK_RELATIVE(bigint8SourcesRanges) {
+  rangeMerge->merge(bigint8, kNumRanges);
+}
+
+BENCHMARK(bigint64Sources) {
+  rangeMerge->merge(bigint64, 1);
+}
+
+BENCHMARK_RELATIVE(bigint64SourcesRanges) {
+  rangeMerge->merge(bigint64, kNumRanges);
+}
+
+BENCHMARK(varchar8Sources) {
+  rangeMerge->merge(varchar8, 1);
+}
+
+BENCHMARK_RELATIVE(varchar8SourcesRanges) {
+  rangeMerge->merge(varchar8, kNumRanges);
+}
+
+BENCHMARK(varchar64Sources) {
+  rangeMerge->merge(varchar64, 1);
+}
+
+BENCHMARK_RELATIVE(varchar64SourcesRanges) {
+  rangeMerge->merge(varchar64, kNumRanges);
+}
+
 int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
@@ -61,6 +155,11 @@ int main(int argc, char* argv[]) {
   narrow = test.makeTestData(100'000'000, 7);
   medium = test.makeTestData(10'000'0000, 37);
   wide = test.makeTestData(10'000'0000, 1029);
+  rangeMerge = std::make_unique<RangeMergeBenchmark>();
+  bigint8 = rangeMerge->makeRuns(8, 128'000, TypeKind::BIGINT);
+  bigint64 = rangeMerge->makeRuns(64, 16'000, TypeKind::BIGINT);
+  varchar8 = rangeMerge->makeRuns(8, 128'000, TypeKind::VARCHAR);
+  varchar64 = rangeMerge->makeRuns(64, 16'000, TypeKind::VARCHAR);
   folly::runBenchmarks();
   return 0;
 }
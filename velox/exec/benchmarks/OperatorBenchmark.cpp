@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+DEFINE_int64(
+    spill_memory_bytes,
+    1 << 20,
+    "Memory threshold of the operators in the '_spill' cases. Spilling "
+    "starts when an operator holds more than this");
+
+/// Benchmark for the memory intensive operators: hash join, hash aggregation,
+/// order by, top n and window. Each operator runs on fuzzer generated data
+/// and is swept over the key type (BIGINT or VARCHAR), the number of distinct
+/// keys, the number of BIGINT payload columns and the ratio of nulls. The
+/// operators that can spill also run with a memory threshold of
+/// --spill_memory_bytes that forces spilling.
+///
+/// Case names are <operator>_<key type>_<distinct keys>k_<payload columns>p_
+/// <null pct>n[_spill]. Run with --bm_regex to pick cases and --bm_json_verbose
+/// or --json for machine readable results.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+using namespace facebook::velox::test;
+
+namespace {
+
+constexpr int32_t kNumBatches = 10;
+constexpr int32_t kBatchSize = 10'000;
+
+struct Dataset {
+  // Probe side or the only input.
+  std::vector<RowVectorPtr> rows;
+  // Build side of the hash join: each distinct key once with a payload.
+  std::vector<RowVectorPtr> buildRows;
+  // Projection of all payload columns, e.g. {"sum(p0)", "sum(p1)"}.
+  std::vector<std::string> sums;
+};
+
+class OperatorBenchmark : public VectorTestBase {
+ public:
+  OperatorBenchmark() : spillDirectory_(TempDirectoryPath::create()) {}
+
+  void makeBenchmarks(
+      const TypePtr& keyType,
+      int32_t numDistinctKeys,
+      int32_t numPayloadColumns,
+      double nullRatio) {
+    auto data = std::make_shared<Dataset>(makeDataset(
+        keyType, numDistinctKeys, numPayloadColumns, nullRatio));
+    const auto suffix = fmt::format(
+        "{}_{}k_{}p_{}n",
+        keyType->toString(),
+        numDistinctKeys / 1'000,
+        numPayloadColumns,
+        static_cast<int32_t>(nullRatio * 100));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+
+    auto hashJoin = PlanBuilder(planNodeIdGenerator)
+                        .values(data->rows)
+                        .hashJoin(
+                            {"k"},
+                            {"u_k"},
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(data->buildRows)
+                                .planNode(),
+                            "",
+                            {"k", "u_p"})
+                        .singleAggregation({}, {"count(1)"})
+                        .planNode();
+    auto aggregation = PlanBuilder()
+                           .values(data->rows)
+                           .singleAggregation({"k"}, data->sums)
+                           .singleAggregation({}, {"count(1)"})
+                           .planNode();
+    auto orderBy = PlanBuilder()
+                       .values(data->rows)
+                       .orderBy({"k"}, false)
+                       .singleAggregation({}, {"count(1)"})
+                       .planNode();
+    auto topN = PlanBuilder()
+                    .values(data->rows)
+                    .topN({"k"}, 100, false)
+                    .singleAggregation({}, {"count(1)"})
+                    .planNode();
+    auto window = PlanBuilder()
+                      .values(data->rows)
+                      .window(
+                          {"row_number() over (partition by k order by p0)"})
+                      .singleAggregation({}, {"count(1)"})
+                      .planNode();
+
+    for (auto spill : {false, true}) {
+      const auto name = spill ? suffix + "_spill" : suffix;
+      addBenchmark("HashJoin_" + name, hashJoin, spill);
+      addBenchmark("HashAggregation_" + name, aggregation, spill);
+      addBenchmark("OrderBy_" + name, orderBy, spill);
+      addBenchmark("Window_" + name, window, spill);
+    }
+    // TopN does not spill.
+    addBenchmark("TopN_" + suffix, topN, false);
+    datasets_.push_back(std::move(data));
+  }
+
+ private:
+  Dataset makeDataset(
+      const TypePtr& keyType,
+      int32_t numDistinctKeys,
+      int32_t numPayloadColumns,
+      double nullRatio) {
+    VectorFuzzer::Options options;
+    options.nullRatio = nullRatio;
+    options.stringLength = 16;
+    VectorFuzzer fuzzer(options, pool_.get());
+
+    // Keys are drawn from a fixed set of distinct values so that the number
+    // of groups and join matches does not depend on the fuzzer.
+    auto distinctKeys = fuzzer.fuzzFlat(keyType, numDistinctKeys);
+
+    Dataset data;
+    std::vector<std::string> names = {"k"};
+    for (auto i = 0; i < numPayloadColumns; ++i) {
+      names.push_back(fmt::format("p{}", i));
+      data.sums.push_back(fmt::format("sum(p{})", i));
+    }
+    for (auto i = 0; i < kNumBatches; ++i) {
+      std::vector<vector_size_t> keyRows(kBatchSize);
+      for (auto& row : keyRows) {
+        row = folly::Random::rand32(numDistinctKeys, rng_);
+      }
+      auto keys = BaseVector::create(keyType, kBatchSize, pool_.get());
+      keys->copy(
+          distinctKeys.get(), SelectivityVector(kBatchSize), keyRows.data());
+
+      std::vector<VectorPtr> children = {keys};
+      for (auto j = 0; j < numPayloadColumns; ++j) {
+        children.push_back(fuzzer.fuzzFlat(BIGINT(), kBatchSize));
+      }
+      data.rows.push_back(makeRowVector(names, children));
+    }
+    data.buildRows.push_back(makeRowVector(
+        {"u_k", "u_p"},
+        {distinctKeys, fuzzer.fuzzFlat(BIGINT(), numDistinctKeys)}));
+    return data;
+  }
+
+  void addBenchmark(
+      const std::string& name,
+      const core::PlanNodePtr& plan,
+      bool spill) {
+    folly::addBenchmark(__FILE__, name, [this, plan, spill]() {
+      run(plan, spill);
+      return 1;
+    });
+  }
+
+  void run(const core::PlanNodePtr& plan, bool spill) {
+    AssertQueryBuilder builder(plan);
+    if (spill) {
+      const auto threshold = std::to_string(FLAGS_spill_memory_bytes);
+      builder.spillDirectory(spillDirectory_->path)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(
+              core::QueryConfig::kAggregationSpillMemoryThreshold, threshold)
+          .config(core::QueryConfig::kJoinSpillMemoryThreshold, threshold)
+          .config(core::QueryConfig::kOrderBySpillMemoryThreshold, threshold)
+          .config(core::QueryConfig::kWindowSpillMemoryThreshold, threshold);
+    }
+    builder.copyResults(pool_.get());
+  }
+
+  const std::shared_ptr<TempDirectoryPath> spillDirectory_;
+  folly::Random::DefaultGenerator rng_;
+  std::vector<std::shared_ptr<Dataset>> datasets_;
+};
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  parse::registerTypeResolver();
+
+  OperatorBenchmark bm;
+  for (const auto& keyType : {BIGINT(), VARCHAR()}) {
+    for (auto numDistinctKeys : {1'000, 50'000}) {
+      for (auto numPayloadColumns : {1, 8}) {
+        for (auto nullRatio : {0.0, 0.1}) {
+          bm.makeBenchmarks(
+              keyType, numDistinctKeys, numPayloadColumns, nullRatio);
+        }
+      }
+    }
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/json.h>
+#include <gflags/gflags.h>
+
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/connectors/hive/TableHandle.h"
+#include "velox/exec/InputCapture.h"
+#include "velox/exec/PartitionFunction.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
+#include "velox/vector/VectorSaver.h"
+
+DEFINE_string(
+    task_dir,
+    "",
+    "Directory with the inputs captured for a task, i.e. "
+    "<input_capture_dir>/<taskId>");
+
+DEFINE_string(plan_node_id, "", "Id of the plan node to replay");
+
+DEFINE_string(
+    operator_type,
+    "",
+    "Replays only the inputs of this operator type, e.g. HashProbe. All "
+    "captured inputs of the plan node if empty");
+
+/// Replays the input batches captured from a production query by setting the
+/// input_capture_plan_node_ids and input_capture_dir query configs. The plan
+/// node --plan_node_id of the captured plan is run on the captured inputs of
+/// its operators in one Driver, instead of its source. Run with
+/// --task_dir=<input_capture_dir>/<taskId> --plan_node_id=<id>.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  VELOX_USER_CHECK(!FLAGS_task_dir.empty(), "--task_dir is required");
+  VELOX_USER_CHECK(!FLAGS_plan_node_id.empty(), "--plan_node_id is required");
+
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  window::prestosql::registerAllWindowFunctions();
+  Type::registerSerDe();
+  common::Filter::registerSerDe();
+  connector::hive::HiveTableHandle::registerSerDe();
+  connector::hive::LocationHandle::registerSerDe();
+  connector::hive::HiveColumnHandle::registerSerDe();
+  connector::hive::HiveInsertTableHandle::registerSerDe();
+  connector::hive::registerHivePartitionFunctionSerDe();
+  core::PlanNode::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  registerPartitionFunctionSerDe();
+
+  auto pool = memory::addDefaultLeafMemoryPool();
+  auto plan = ISerializable::deserialize<core::PlanNode>(
+      folly::parseJson(restoreStringFromFile(
+          fmt::format("{}/plan.json", FLAGS_task_dir).c_str())),
+      pool.get());
+  auto inputs = InputCapture::restore(
+      InputCapture::planNodeDirectory(FLAGS_task_dir, FLAGS_plan_node_id),
+      pool.get(),
+      FLAGS_operator_type);
+  int64_t numRows = 0;
+  for (const auto& input : inputs) {
+    numRows += input->size();
+  }
+  LOG(INFO) << "Replaying " << inputs.size() << " batches with " << numRows
+            << " rows";
+
+  test::CursorParameters params;
+  params.planNode = InputCapture::makeReplayPlan(
+      plan, FLAGS_plan_node_id, std::move(inputs), pool.get());
+  folly::addBenchmark(
+      __FILE__, fmt::format("replay_{}", FLAGS_plan_node_id), [&]() {
+        test::readCursor(params, [](Task*) {});
+        return 1;
+      });
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/tests/utils/Cursor.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+/// Measures the startup latency of short queries: the time from making a Task
+/// to its first output batch. The inputs are a single small batch, so that
+/// the time is dominated by Task::create, LocalPlanner::plan, creating the
+/// drivers and operators with their memory pools and compiling the
+/// expressions of each driver. Each plan runs with 1 and 8 drivers per
+/// pipeline.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class TaskStartupBenchmark : public VectorTestBase {
+ public:
+  TaskStartupBenchmark() {
+    data_ = {makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 7; }),
+        makeFlatVector<std::string>(
+            100, [](auto row) { return fmt::format("s{}", row % 11); }),
+    })};
+    filterProject_ = makeFilterProject();
+    aggregation_ = makeAggregation();
+    hashJoin_ = makeHashJoin();
+  }
+
+  const core::PlanNodePtr& filterProject() const {
+    return filterProject_;
+  }
+
+  const core::PlanNodePtr& aggregation() const {
+    return aggregation_;
+  }
+
+  const core::PlanNodePtr& hashJoin() const {
+    return hashJoin_;
+  }
+
+  // Makes a Task for 'plan' and waits for its first output batch.
+  void run(const core::PlanNodePtr& plan, int32_t numDrivers) {
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = numDrivers;
+    auto cursor = std::make_unique<TaskCursor>(params);
+    cursor->moveNext();
+    BENCHMARK_SUSPEND {
+      while (cursor->moveNext()) {
+      }
+      cursor.reset();
+    }
+  }
+
+ private:
+  // A filter followed by projections with a number of function calls.
+  core::PlanNodePtr makeFilterProject() const {
+    return PlanBuilder()
+        .values(data_, true)
+        .filter("c0 % 3 <> 1 AND c2 LIKE 's1%'")
+        .project(
+            {"c0 + c1 * 2",
+             "c0 - c1",
+             "c0 % 10",
+             "substr(c2, 2)",
+             "upper(c2)",
+             "length(c2) + c1",
+             "concat(c2, '-', c2)",
+             "if(c1 > 3, c0, c1)",
+             "coalesce(c0, c1)",
+             "c0 between 10 and 40"})
+        .planNode();
+  }
+
+  // An aggregation split over a local exchange.
+  core::PlanNodePtr makeAggregation() const {
+    return PlanBuilder()
+        .values(data_, true)
+        .partialAggregation({"c1"}, {"sum(c0)", "count(1)", "max(c2)"})
+        .localPartition({"c1"})
+        .finalAggregation()
+        .planNode();
+  }
+
+  // A hash join of two pipelines.
+  core::PlanNodePtr makeHashJoin() const {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(data_, true)
+        .hashJoin(
+            {"c1"},
+            {"u1"},
+            PlanBuilder(planNodeIdGenerator)
+                .values(data_, true)
+                .project({"c0 AS u0", "c1 AS u1"})
+                .planNode(),
+            "c0 < u0",
+            {"c0", "c2", "u0"})
+        .planNode();
+  }
+
+  std::vector<RowVectorPtr> data_;
+  core::PlanNodePtr filterProject_;
+  core::PlanNodePtr aggregation_;
+  core::PlanNodePtr hashJoin_;
+};
+
+std::unique_ptr<TaskStartupBenchmark> benchmark;
+
+void run(const core::PlanNodePtr& plan, int32_t numDrivers, uint32_t n) {
+  for (auto i = 0; i < n; ++i) {
+    benchmark->run(plan, numDrivers);
+  }
+}
+
+BENCHMARK(filterProject1, n) {
+  run(benchmark->filterProject(), 1, n);
+}
+
+BENCHMARK_RELATIVE(filterProject8, n) {
+  run(benchmark->filterProject(), 8, n);
+}
+
+BENCHMARK(aggregation1, n) {
+  run(benchmark->aggregation(), 1, n);
+}
+
+BENCHMARK_RELATIVE(aggregation8, n) {
+  run(benchmark->aggregation(), 8, n);
+}
+
+BENCHMARK(hashJoin1, n) {
+  run(benchmark->hashJoin(), 1, n);
+}
+
+BENCHMARK_RELATIVE(hashJoin8, n) {
+  run(benchmark->hashJoin(), 8, n);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  benchmark = std::make_unique<TaskStartupBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
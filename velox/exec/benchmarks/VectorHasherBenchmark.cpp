@@ -177,6 +177,37 @@ BENCHMARK_RELATIVE(computeValueIdsFlatStrings) {
   benchmarkComputeValueIdsForStrings(true);
 }
 
+// Hashes 1'000 distinct strings of 'length' bytes. Strings of up to 12 bytes
+// are inline in the StringView.
+void benchmarkHashStrings(int32_t length) {
+  folly::BenchmarkSuspender suspender;
+  vector_size_t size = 1'000;
+  BenchmarkBase base;
+  std::vector<std::string> strings(size);
+  for (auto i = 0; i < size; ++i) {
+    strings[i] = fmt::format("{:0>{}}", i, length);
+  }
+  auto values = base.vectorMaker().flatVector(strings);
+  VectorHasher hasher(VARCHAR(), 0);
+  SelectivityVector rows(size);
+  raw_vector<uint64_t> result(size);
+  suspender.dismiss();
+
+  for (int i = 0; i < 10'000; i++) {
+    hasher.decode(*values, rows);
+    hasher.hash(rows, false, result);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK(hashInlineStrings) {
+  benchmarkHashStrings(10);
+}
+
+BENCHMARK_RELATIVE(hashLongStrings) {
+  benchmarkHashStrings(40);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
@@ -668,6 +668,95 @@ TEST_F(AggregationTest, allKeyTypes) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, manyAggregatesLargeBatches) {
+  // Large batches with many aggregates are updated in blocks of rows. Covers
+  // masks, constant arguments and intermediate input.
+  constexpr int32_t kNumRows = 10'000;
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 3; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            kNumRows, [&](auto row) { return (row * 31 + i) % 1'000; }),
+        makeFlatVector<int64_t>(
+            kNumRows, [&](auto row) { return row + i; }, nullEvery(7)),
+        makeFlatVector<double>(kNumRows, [](auto row) { return row * 0.5; }),
+        makeFlatVector<bool>(kNumRows, [](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(batches);
+  const std::vector<std::string> aggregates = {
+      "sum(c1)",
+      "count(c1)",
+      "avg(c2)",
+      "min(c2)",
+      "max(c1)",
+      "sum(c1)",
+      "count(1)",
+      "sum(c2)"};
+  const std::vector<std::string> masks = {"", "", "", "c3", "", "c3", "", "c3"};
+  const std::string sql =
+      "SELECT c0, sum(c1), count(c1), avg(c2), min(c2) FILTER (WHERE c3), "
+      "max(c1), sum(c1) FILTER (WHERE c3), count(1), "
+      "sum(c2) FILTER (WHERE c3) FROM tmp GROUP BY c0";
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .singleAggregation({"c0"}, aggregates, masks)
+                  .planNode();
+  assertQuery(plan, sql);
+
+  plan = PlanBuilder()
+             .values(batches)
+             .partialAggregation({"c0"}, aggregates, masks)
+             .finalAggregation()
+             .planNode();
+  assertQuery(plan, sql);
+}
+
+TEST_F(AggregationTest, parallelFinalAggregationMerge) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (i * 1'000 + row) % 97; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [](auto row) {
+              return StringView::makeInline(fmt::format("key{}", row % 5));
+            },
+            nullEvery(13)),
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row; }),
+    }));
+  }
+  // Each of the 4 drivers reads all the vectors.
+  std::vector<RowVectorPtr> expectedInput;
+  for (auto i = 0; i < 4; ++i) {
+    expectedInput.insert(expectedInput.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(expectedInput);
+
+  core::PlanNodeId finalAggNodeId;
+  auto plan = PlanBuilder()
+                  .values(vectors, true)
+                  .partialAggregation(
+                      {"c0", "c1"}, {"sum(c2)", "max(c2)", "count(1)"})
+                  .finalAggregation()
+                  .capturePlanNodeId(finalAggNodeId)
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(QueryConfig::kParallelAggregationMergeEnabled, "true")
+          .maxDrivers(4)
+          .assertResults(
+              "SELECT c0, c1, sum(c2), max(c2), count(1) FROM tmp GROUP BY 1, 2");
+  EXPECT_GT(
+      toPlanStats(task->taskStats())
+          .at(finalAggNodeId)
+          .customStats.at("parallelMergeInputGroups")
+          .sum,
+      0);
+}
+
 TEST_F(AggregationTest, partialAggregationMemoryLimit) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -747,6 +836,44 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationRetainedGroups) {
+  // Each batch has 7 hot keys and 10 keys that appear once.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000,
+        [&](auto row) { return row % 100 == 0 ? 1'000 * i + row : row % 7; },
+        nullEvery(11))}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto& retainedGroupsPct : {"0", "50"}) {
+    SCOPED_TRACE(fmt::format("retainedGroupsPct: {}", retainedGroupsPct));
+    core::PlanNodeId aggNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kMaxPartialAggregationMemory, "1")
+            .config(
+                QueryConfig::kPartialAggregationRetainedGroupsPct,
+                retainedGroupsPct)
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)", "sum(c0)"})
+                      .capturePlanNodeId(aggNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1), sum(c0) FROM tmp GROUP BY 1");
+    const auto& stats =
+        toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+    EXPECT_GT(stats.at("flushTimes").sum, 0);
+    if (std::string(retainedGroupsPct) == "0") {
+      EXPECT_EQ(stats.count("retainedGroups"), 0);
+    } else {
+      EXPECT_GT(stats.at("retainedGroups").sum, 0);
+    }
+  }
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -837,6 +964,13 @@ TEST_F(AggregationTest, largeValueRangeArray) {
   // then expected to change hash mode and rehash.
   EXPECT_EQ(1, runtimeStats.at("hashtable.numRehashes").count);
 
+  // The array_agg accumulators are in the allocator of the groups.
+  EXPECT_LT(0, runtimeStats.at("stringAllocator.retainedBytes").sum);
+  EXPECT_GE(
+      runtimeStats.at("stringAllocator.retainedBytes").sum,
+      runtimeStats.at("stringAllocator.freeBytes").sum);
+  EXPECT_EQ(1, runtimeStats.count("stringAllocator.numFreeBlocks"));
+
   // The partial agg is expected to flush just once. The final agg gets one
   // batch.
   EXPECT_EQ(1, stats.at(finalAggId).inputVectors);
@@ -1030,6 +1164,63 @@ TEST_F(AggregationTest, spillWithMemoryLimit) {
   }
 }
 
+TEST_F(AggregationTest, sortBasedAggregationFallback) {
+  struct {
+    // Number of distinct keys in each batch. 0 means unique keys.
+    int32_t numKeysPerBatch;
+    bool expectSortBased;
+
+    std::string debugString() const {
+      return fmt::format(
+          "numKeysPerBatch:{}, expectSortBased:{}",
+          numKeysPerBatch,
+          expectSortBased);
+    }
+  } testSettings[] = {{0, true}, {10, false}};
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+
+    constexpr int32_t kBatchSize = 1'000;
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              kBatchSize,
+              [&](auto row) {
+                return testData.numKeysPerBatch == 0
+                    ? i * kBatchSize + row
+                    : row % testData.numKeysPerBatch;
+              }),
+          makeFlatVector<int64_t>(kBatchSize, [](auto row) { return row; }),
+      }));
+    }
+    createDuckDbTable(vectors);
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    core::PlanNodeId aggrNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(QueryConfig::kSpillEnabled, "true")
+            .config(QueryConfig::kAggregationSpillEnabled, "true")
+            .config(QueryConfig::kTestingSpillPct, "100")
+            .config(QueryConfig::kAggregationSortFallbackDistinctPct, "90")
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .singleAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                      .capturePlanNodeId(aggrNodeId)
+                      .planNode())
+            .assertResults("SELECT c0, sum(c1), count(1) FROM tmp GROUP BY c0");
+
+    const auto planStats = toPlanStats(task->taskStats()).at(aggrNodeId);
+    ASSERT_GT(planStats.spilledBytes, 0);
+    ASSERT_EQ(
+        planStats.customStats.count("sortBasedAggregation") != 0,
+        testData.expectSortBased);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  }
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, spillWithEmptyPartition) {
   constexpr int32_t kNumDistinct = 100'000;
   constexpr int64_t kMaxBytes = 20LL << 20; // 20 MB
@@ -1396,6 +1587,81 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsPreAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<StringView>(
+              size,
+              [](auto row) {
+                auto str = std::string(row % 12, 'x');
+                return StringView(str);
+              }),
+      });
+
+  createDuckDbTable({data});
+
+  // Cube. The input is aggregated once on (k1, k2) and the 4 grouping sets
+  // are computed from the 187 partial groups.
+  core::PlanNodeId partialAggId;
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupId({{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"a", "b"})
+                  .partialAggregation(
+                      {"k1", "k2", "group_id"},
+                      {"count(1) as count_1",
+                       "sum(a) as sum_a",
+                       "max(b) as max_b",
+                       "avg(a) as avg_a"})
+                  .capturePlanNodeId(partialAggId)
+                  .finalAggregation()
+                  .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kGroupingSetsPreAggregationEnabled, "true")
+          .assertResults(
+              "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp GROUP BY CUBE (k1, k2)");
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_EQ(
+      size,
+      planStats.at(fmt::format("{}.preAggregation", partialAggId)).inputRows);
+  ASSERT_EQ(4 * 187, planStats.at(partialAggId).inputRows);
+
+  // The masks are projected between GroupId and the aggregation, so the plan
+  // runs as is.
+  plan = PlanBuilder()
+             .values({data})
+             .groupId({{"k1"}, {"k2"}}, {"a", "b"})
+             .project(
+                 {"k1",
+                  "k2",
+                  "group_id",
+                  "a",
+                  "b",
+                  "group_id = 0 as mask_a",
+                  "group_id = 1 as mask_b"})
+             .partialAggregation(
+                 {"k1", "k2", "group_id"},
+                 {"count(1) as count_1", "sum(a) as sum_a", "max(b) as max_b"},
+                 {"", "mask_a", "mask_b"})
+             .finalAggregation()
+             .project({"k1", "k2", "count_1", "sum_a", "max_b"})
+             .planNode();
+
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kGroupingSetsPreAggregationEnabled, "true")
+      .assertResults(
+          "SELECT k1, null, count(1), sum(a), null FROM tmp GROUP BY k1 "
+          "UNION ALL "
+          "SELECT null, k2, count(1), null, max(b) FROM tmp GROUP BY k2");
+}
+
 TEST_F(AggregationTest, groupingSetsByExpand) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -2219,8 +2485,9 @@ DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringOutputProcessing) {
       ASSERT_GT(reclaimableBytes, 0);
       const auto usedMemory = op->pool()->currentBytes();
       op->reclaim(folly::Random::oneIn(2) ? 0 : folly::Random::rand32(rng_));
-      // No reclaim as the operator has started output processing.
-      ASSERT_EQ(usedMemory, op->pool()->currentBytes());
+      // The rows not returned yet are spilled and the rest of the output is
+      // produced from the spilled data.
+      ASSERT_LT(op->pool()->currentBytes(), usedMemory);
     } else {
       ASSERT_EQ(reclaimableBytes, 0);
       VELOX_ASSERT_THROW(
@@ -2234,8 +2501,13 @@ DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringOutputProcessing) {
     taskThread.join();
 
     auto stats = task->taskStats().pipelineStats;
-    ASSERT_EQ(stats[0].operatorStats[1].spilledBytes, 0);
-    ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 0);
+    if (enableSpilling) {
+      ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+      ASSERT_GT(stats[0].operatorStats[1].spilledPartitions, 0);
+    } else {
+      ASSERT_EQ(stats[0].operatorStats[1].spilledBytes, 0);
+      ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 0);
+    }
     OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
   }
 }
@@ -196,6 +196,56 @@ TEST_F(ArrowStreamTest, basic) {
   assertQuery(plan, "SELECT * FROM tmp");
 }
 
+TEST_F(ArrowStreamTest, prefetchAndParallel) {
+  vector_size_t size = 1'000;
+  std::vector<std::vector<RowVectorPtr>> streamVectors(4);
+  std::vector<RowVectorPtr> allVectors;
+  for (int32_t i = 0; i < streamVectors.size(); ++i) {
+    for (int32_t j = 0; j < 3; ++j) {
+      auto vector = makeRowVector(
+          {makeFlatVector<int32_t>(size, [&](auto row) { return i + row; }),
+           makeFlatVector<StringView>(
+               size,
+               [&](auto row) {
+                 return StringView::makeInline(std::to_string(j + row));
+               },
+               nullEvery(7))});
+      streamVectors[i].push_back(vector);
+      allVectors.push_back(vector);
+    }
+  }
+  createDuckDbTable(allVectors);
+  auto type = asRowType(allVectors[0]->type());
+
+  // Each case reads every stream once, on 1 or 4 drivers and with or without
+  // prefetching.
+  std::vector<std::pair<int32_t, int32_t>> testSettings = {
+      {1, 0}, {1, 2}, {4, 0}, {4, 1}};
+  for (auto [numDrivers, prefetchBatches] : testSettings) {
+    SCOPED_TRACE(fmt::format(
+        "numDrivers {} prefetchBatches {}", numDrivers, prefetchBatches));
+    std::vector<std::shared_ptr<ArrowArrayStream>> arrowStreams;
+    for (const auto& vectors : streamVectors) {
+      auto arrowStream = std::make_shared<ArrowArrayStream>();
+      exportArrowStream(
+          std::make_shared<ArrowReader>(pool_, vectors, type),
+          arrowStream.get());
+      arrowStreams.push_back(std::move(arrowStream));
+    }
+    auto plan =
+        std::make_shared<core::ArrowStreamNode>("0", type, arrowStreams);
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(numDrivers)
+        .config(
+            core::QueryConfig::kArrowStreamPrefetchBatches,
+            std::to_string(prefetchBatches))
+        .assertResults("SELECT * FROM tmp");
+    for (const auto& arrowStream : arrowStreams) {
+      EXPECT_EQ(arrowStream->release, nullptr);
+    }
+  }
+}
+
 TEST_F(ArrowStreamTest, error) {
   vector_size_t size = 1'000;
   std::vector<RowVectorPtr> vectors;
@@ -225,4 +275,16 @@ TEST_F(ArrowStreamTest, error) {
   VELOX_ASSERT_THROW(
       AssertQueryBuilder(plan).copyResults(pool_.get()),
       "Failed to call get_schema on ArrowStream: get_schema failed.");
+
+  // The errors of a prefetch are thrown on the driver.
+  exportArrowStream(
+      std::make_shared<ArrowReader>(pool_, vectors, type, true, false),
+      &arrowStream);
+  plan = std::make_shared<core::ArrowStreamNode>(
+      "0", type, std::make_shared<ArrowArrayStream>(arrowStream));
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kArrowStreamPrefetchBatches, "2")
+          .copyResults(pool_.get()),
+      "Failed to call get_next on ArrowStream: get_next failed.");
 }
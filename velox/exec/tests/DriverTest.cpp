@@ -605,6 +605,34 @@ TEST_F(DriverTest, yield) {
   }
 }
 
+TEST_F(DriverTest, timeSlice) {
+  CursorParameters params;
+  int32_t hits;
+  params.planNode = makeValuesFilterProject(
+      rowType_,
+      "m1 % 10 > 0",
+      "m1 % 3 + m2 % 5 + m3 % 7 + m4 % 11 + m5 % 13 + m6 % 17 + m7 % 19",
+      1'000,
+      1'000,
+      [](int64_t num) { return num % 10 > 0; },
+      &hits);
+  params.maxDrivers = 4;
+  std::unordered_map<std::string, std::string> queryConfig{
+      {core::QueryConfig::kDriverTimeSliceMs, "1"}};
+  params.queryCtx =
+      std::make_shared<core::QueryCtx>(executor_.get(), std::move(queryConfig));
+  int32_t numRead = 0;
+  readResults(params, ResultOperation::kRead, 1'000'000, &numRead);
+  EXPECT_EQ(numRead, 4 * hits);
+  auto& task = tasks_[0];
+  EXPECT_TRUE(waitForTaskCompletion(task.get(), 1'000'000));
+  // Each Driver runs for far more than one time slice.
+  const auto taskStats = task->taskStats();
+  EXPECT_GT(taskStats.numDriverYields, 0);
+  EXPECT_GT(taskStats.driverCpuNanos, 0);
+  EXPECT_GT(taskStats.driverWallNanos, 0);
+}
+
 // A testing Operator that periodically does one of the following:
 //
 // 1. Blocks and registers a resume that continues the Driver after a timed
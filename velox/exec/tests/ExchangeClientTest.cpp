@@ -44,5 +44,50 @@ TEST(ExchangeClientTest, nonVeloxCreateExchangeSourceException) {
       "Task ID: xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx.");
 }
 
+TEST(ExchangeClientTest, requestWindow) {
+  constexpr int64_t kMB = 1 << 20;
+  ExchangeRequestWindow window(32 * kMB);
+  ASSERT_EQ(ExchangeRequestWindow::kInitialBytes, window.bytes());
+
+  // Full responses double the size up to the maximum while the consumer rate
+  // is not known.
+  uint64_t nowMicros = 1'000;
+  auto respond = [&](int64_t bytes, double rate, bool backlogged) {
+    window.requestSent(nowMicros);
+    nowMicros += 10'000;
+    window.responseReceived(bytes, nowMicros, rate, backlogged);
+  };
+  respond(kMB, 0, false);
+  ASSERT_EQ(2 * kMB, window.bytes());
+  ASSERT_EQ(10'000, window.roundTripMicros());
+  for (auto i = 0; i < 10; ++i) {
+    respond(window.bytes(), 0, false);
+  }
+  ASSERT_EQ(32 * kMB, window.bytes());
+
+  // Partial responses do not grow the size.
+  respond(kMB, 0, false);
+  ASSERT_EQ(32 * kMB, window.bytes());
+
+  // A backlogged consumer halves the size down to the minimum.
+  respond(kMB, 0, true);
+  ASSERT_EQ(16 * kMB, window.bytes());
+  for (auto i = 0; i < 20; ++i) {
+    respond(kMB, 0, true);
+  }
+  ASSERT_EQ(ExchangeRequestWindow::kMinBytes, window.bytes());
+
+  // With a known consumer rate, the size grows to twice the bytes consumed in
+  // a round trip of 10ms, i.e. 2MB at 100MB/s.
+  for (auto i = 0; i < 20; ++i) {
+    respond(window.bytes(), 100 * kMB, false);
+  }
+  ASSERT_EQ(2 * kMB, window.bytes());
+
+  // A slower consumer shrinks the size.
+  respond(kMB, 10 * kMB, false);
+  ASSERT_EQ(2 * kMB / 10, window.bytes());
+}
+
 } // namespace
 } // namespace facebook::velox::exec
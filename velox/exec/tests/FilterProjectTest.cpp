@@ -15,6 +15,7 @@
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -322,3 +323,53 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
                   .planNode();
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
+
+TEST_F(FilterProjectTest, mergeSmallVectors) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [&](auto row) { return i * 1'000 + row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  auto mergeStats = [](const std::shared_ptr<Task>& task) {
+    for (const auto& stats : task->taskStats().pipelineStats[0].operatorStats) {
+      if (stats.operatorType == "MergeSmallVectors") {
+        return std::optional<OperatorStats>(stats);
+      }
+    }
+    return std::optional<OperatorStats>();
+  };
+
+  // The filter passes 10 rows of each input. These are merged into one
+  // vector.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c0 % 100 = 0")
+                  .project({"c0", "c0 * 2"})
+                  .planNode();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kMergeSmallVectorsEnabled, "true")
+          .assertResults("SELECT c0, c0 * 2 FROM tmp WHERE c0 % 100 = 0");
+  auto stats = mergeStats(task);
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->inputVectors, 10);
+  EXPECT_EQ(stats->outputVectors, 1);
+  EXPECT_EQ(stats->outputPositions, 100);
+  EXPECT_EQ(stats->runtimeStats.at("mergedVectors").sum, 10);
+
+  // Inputs that are large enough pass through.
+  plan = PlanBuilder().values(vectors).filter("c0 % 100 > 0").planNode();
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kMergeSmallVectorsEnabled, "true")
+             .assertResults("SELECT * FROM tmp WHERE c0 % 100 > 0");
+  stats = mergeStats(task);
+  ASSERT_TRUE(stats.has_value());
+  EXPECT_EQ(stats->outputVectors, 10);
+  EXPECT_EQ(stats->runtimeStats.count("mergedVectors"), 0);
+
+  // Not inserted by default.
+  task = assertQuery(plan, "SELECT * FROM tmp WHERE c0 % 100 > 0");
+  EXPECT_FALSE(mergeStats(task).has_value());
+}
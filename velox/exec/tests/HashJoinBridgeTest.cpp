@@ -223,6 +223,40 @@ TEST_P(HashJoinBridgeTest, withoutSpill) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, joinKeyFilters) {
+  auto joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+  ASSERT_FALSE(joinBridge->joinKeyFilters().has_value());
+
+  joinBridge->setHashTable(createFakeHashTable(), {}, false);
+  auto filters = joinBridge->joinKeyFilters();
+  ASSERT_TRUE(filters.has_value());
+  ASSERT_EQ(filters->size(), rowType_->size());
+  // The table has no rows so no probe row can pass the filters.
+  for (const auto& filter : filters.value()) {
+    ASSERT_TRUE(filter != nullptr);
+    ASSERT_EQ(filter->kind(), common::FilterKind::kAlwaysFalse);
+  }
+
+  ASSERT_FALSE(joinBridge->probeFinished());
+  ASSERT_FALSE(joinBridge->joinKeyFilters().has_value());
+
+  // No filters if the table doesn't have all the build side rows.
+  joinBridge = createJoinBridge();
+  for (int32_t i = 0; i < numBuilders_; ++i) {
+    joinBridge->addBuilder();
+  }
+  joinBridge->start();
+  joinBridge->setHashTable(
+      createFakeHashTable(),
+      makeFakeSpillPartitionSet(startPartitionBitOffset_),
+      false);
+  ASSERT_FALSE(joinBridge->joinKeyFilters().has_value());
+}
+
 TEST_P(HashJoinBridgeTest, withSpill) {
   struct {
     int32_t spillLevel;
@@ -3964,6 +3964,95 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, dynamicBloomFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 3'000;
+  // More distinct build keys than VectorHasher keeps track of, so the probe
+  // can't make an IN filter on the key.
+  const int32_t numRowsBuild = 120'000;
+
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  std::vector<RowVectorPtr> probeVectors;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe, [&](auto row) { return row + i * numRowsProbe; }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  // Every 7th value matches a build side key.
+  std::vector<RowVectorPtr> buildVectors;
+  for (int i = 0; i < 4; ++i) {
+    buildVectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsBuild / 4,
+            [i](auto row) { return 7 * (row + i * numRowsBuild / 4); }),
+        makeFlatVector<int64_t>(numRowsBuild / 4, [](auto row) { return row; }),
+    }));
+  }
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+
+  for (const auto maxSize : {0, 1 << 20}) {
+    SCOPED_TRACE(fmt::format("maxSize: {}", maxSize));
+    core::PlanNodeId probeScanId;
+    auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(probeType)
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      buildSide,
+                      "",
+                      {"c0", "c1", "u_c1"},
+                      core::JoinType::kInner)
+                  .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .config(
+            core::QueryConfig::kJoinBloomFilterMaxSize, std::to_string(maxSize))
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .referenceQuery("SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill || maxSize == 0) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            // About 1/7 of the rows match plus the false positives.
+            ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+          }
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -4241,6 +4330,125 @@ TEST_F(HashJoinTest, memoryUsage) {
 /// Test an edge case in producing small output batches where the logic to
 /// calculate the set of probe-side rows to load lazy vectors for was triggering
 /// a crash.
+TEST_F(HashJoinTest, adaptiveOutputBatchRows) {
+  // Each probe row matches 1'000 build rows, so each probe vector produces
+  // 10'000 rows.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 2; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(10, [](auto row) { return row; })}));
+  }
+  auto buildVectors = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int64_t>(10'000, [](auto row) { return row % 10; }),
+          makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      });
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values({buildVectors})
+                          .planNode(),
+                      "",
+                      {"c0", "u_c1"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  auto numOutputVectors = [&](bool adaptive) {
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kAdaptiveOutputBatchRowsEnabled,
+                adaptive ? "true" : "false")
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "160000")
+            .assertTypeAndNumRows(
+                ROW({"c0", "u_c1"}, {BIGINT(), BIGINT()}), 20'000);
+    return toPlanStats(task->taskStats())
+        .at(joinNodeId)
+        .operatorStats.at("HashProbe")
+        ->outputVectors;
+  };
+
+  // Without adaptivity, each probe vector produces batches of 1024 rows. With
+  // it, the second one fills batches of 160KB, which hold several thousand
+  // rows of two bigints.
+  EXPECT_EQ(numOutputVectors(false), 20);
+  EXPECT_LT(numOutputVectors(true), 20);
+}
+
+TEST_F(HashJoinTest, probeKeyFilters) {
+  // The probe side has 20 distinct keys, of which one in ten is present on
+  // the build side.
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 2; ++i) {
+    probeVectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        10, [i](auto row) { return (i * 10 + row) * 1'000; })}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int64_t>(
+                1'000, [i](auto row) { return (i * 1'000 + row) * 10; }),
+            makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+        }));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(probeVectors)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(buildVectors)
+                          .planNode(),
+                      "",
+                      {"c0", "u_c1"})
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+
+  // Hold the build side until the probe side has buffered all its input so
+  // that every build batch is filtered by the probe keys.
+  folly::EventCount probeWait;
+  std::atomic_bool probeFinished{false};
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::HashProbe::finishBufferingInput",
+      std::function<void(Operator*)>([&](Operator* /*unused*/) {
+        probeFinished = true;
+        probeWait.notifyAll();
+      }));
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() == "HashBuild") {
+          probeWait.await([&]() { return probeFinished.load(); });
+        }
+      }));
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kHashJoinProbeBufferMaxRows, "100")
+                  .assertResults(
+                      "SELECT t.c0, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0");
+  const auto& operatorStats =
+      toPlanStats(task->taskStats()).at(joinNodeId).operatorStats;
+  const auto& probeStats = operatorStats.at("HashProbe")->customStats;
+  ASSERT_EQ(probeStats.at("bufferedProbeInputRows").sum, 20);
+  // Only the 20 build rows that match a probe key are kept.
+  const auto& buildStats = operatorStats.at("HashBuild")->customStats;
+  ASSERT_EQ(buildStats.at("probeKeyFilteredRows").sum, 5'000 - 20);
+}
+
 TEST_F(HashJoinTest, smallOutputBatchSize) {
   // Setup probe data with 50 non-null matching keys followed by 50 null
   // keys: 1, 2, 1, 2,...null, null.
@@ -4321,6 +4529,81 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+TEST_F(HashJoinTest, spillRestoreInBlocks) {
+  // Most of the build side rows have the same key, so the spilled partition
+  // with the key doesn't fit in memory at the max spill level.
+  std::vector<RowVectorPtr> buildVectors = makeBatches(10, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_k0", "u_v0"},
+        {makeFlatVector<int32_t>(
+             100, [](auto row) { return row % 10 == 0 ? row : 7; }),
+         makeFlatVector<int32_t>(
+             100, [batch](auto row) { return batch * 100 + row; })});
+  });
+  std::vector<RowVectorPtr> probeVectors = makeBatches(5, [&](int32_t batch) {
+    return makeRowVector(
+        {"t_k0", "t_v0"},
+        {makeFlatVector<int32_t>(100, [](auto row) { return row % 23; }),
+         makeFlatVector<int32_t>(
+             100, [batch](auto row) { return batch * 100 + row; })});
+  });
+
+  struct {
+    core::JoinType joinType;
+    std::vector<std::string> outputLayout;
+    std::string referenceQuery;
+
+    std::string debugString() const {
+      return core::joinTypeName(joinType);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner,
+       {"t_k0", "t_v0", "u_k0", "u_v0"},
+       "SELECT t_k0, t_v0, u_k0, u_v0 FROM t, u WHERE t_k0 = u_k0"},
+      {core::JoinType::kRight,
+       {"t_k0", "t_v0", "u_k0", "u_v0"},
+       "SELECT t_k0, t_v0, u_k0, u_v0 FROM t RIGHT JOIN u ON t_k0 = u_k0"},
+      {core::JoinType::kRightSemiFilter,
+       {"u_k0", "u_v0"},
+       "SELECT u_k0, u_v0 FROM u WHERE u_k0 IN (SELECT t_k0 FROM t)"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto tempDirectory = exec::test::TempDirectoryPath::create();
+    auto testProbeVectors = probeVectors;
+    auto testBuildVectors = buildVectors;
+    auto outputLayout = testData.outputLayout;
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t_k0"})
+        .probeVectors(std::move(testProbeVectors))
+        .buildKeys({"u_k0"})
+        .buildVectors(std::move(testBuildVectors))
+        .joinType(testData.joinType)
+        .joinOutputLayout(std::move(outputLayout))
+        .config(core::QueryConfig::kJoinSpillMemoryThreshold, "1")
+        .config(core::QueryConfig::kMaxSpillLevel, "0")
+        .injectSpill(false)
+        .spillDirectory(tempDirectory->path)
+        .referenceQuery(testData.referenceQuery)
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+          int64_t numBlocks{0};
+          for (auto& pipelineStat : task->taskStats().pipelineStats) {
+            for (auto& operatorStat : pipelineStat.operatorStats) {
+              if (operatorStat.operatorType == "HashBuild" &&
+                  operatorStat.runtimeStats.count("spillRestoreBlocks") != 0) {
+                numBlocks +=
+                    operatorStat.runtimeStats["spillRestoreBlocks"].sum;
+              }
+            }
+          }
+          ASSERT_GT(numBlocks, 0);
+          ASSERT_EQ(maxHashBuildSpillLevel(*task), 0);
+        })
+        .run();
+  }
+}
+
 // The test is to verify if the hash build reservation has been released on task
 // error.
 DEBUG_ONLY_TEST_F(HashJoinTest, buildReservationReleaseCheck) {
@@ -5368,4 +5651,60 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeAbortDuringInputProcessing) {
     Task::testingWaitForAllTasksToBeDeleted();
   }
 }
+DEBUG_ONLY_TEST_F(HashJoinTest, sharedBroadcastTable) {
+  auto probe = makeRowVector(
+      {"t_k", "t_v"},
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row % 100; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  auto build = makeRowVector(
+      {"u_k", "u_v"},
+      {makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return -row; })});
+  createDuckDbTable("t", {probe});
+  createDuckDbTable("u", {build});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator).values({build}).planNode();
+  core::PlanNodeId joinNodeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values({probe})
+                  .hashJoin(
+                      {"t_k"},
+                      {"u_k"},
+                      buildSide,
+                      "",
+                      {"t_k", "t_v", "u_v"},
+                      core::JoinType::kInner,
+                      false,
+                      true)
+                  .capturePlanNodeId(joinNodeId)
+                  .planNode();
+  const std::string sql = "SELECT t_k, t_v, u_v FROM t, u WHERE t_k = u_k";
+
+  // Runs a second task of the same query while the first one probes its
+  // table. The second task probes the table of the first one.
+  auto queryCtx = std::make_shared<core::QueryCtx>(driverExecutor_.get());
+  std::atomic_bool secondTaskStarted{false};
+  std::shared_ptr<Task> secondTask;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::Driver::runInternal::addInput",
+      std::function<void(Operator*)>([&](Operator* op) {
+        if (op->operatorType() != "HashProbe" ||
+            secondTaskStarted.exchange(true)) {
+          return;
+        }
+        secondTask = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                         .queryCtx(queryCtx)
+                         .assertResults(sql);
+      }));
+  auto firstTask = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                       .queryCtx(queryCtx)
+                       .assertResults(sql);
+  ASSERT_NE(secondTask, nullptr);
+
+  auto firstStats = toPlanStats(firstTask->taskStats()).at(joinNodeId);
+  ASSERT_EQ(0, firstStats.customStats.count("sharedBroadcastTable"));
+  auto secondStats = toPlanStats(secondTask->taskStats()).at(joinNodeId);
+  ASSERT_EQ(1, secondStats.customStats.at("sharedBroadcastTable").sum);
+}
 } // namespace
@@ -154,3 +154,76 @@ TEST_F(HashPartitionFunctionTest, spec) {
     ASSERT_EQ(hashSpec->toString(), copy->toString());
   }
 }
+
+TEST_F(HashPartitionFunctionTest, skewed) {
+  const int numRows = 20'000;
+  const int64_t kHotKey = -1;
+  // Every other row has the same key.
+  RowVectorPtr vector = makeRowVector({makeFlatVector<int64_t>(
+      numRows, [&](auto row) { return row % 2 == 0 ? kHotKey : row; })});
+  RowTypePtr rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> hashPartitions;
+  HashPartitionFunction hashFunction(8, rowType, {0});
+  hashFunction.partition(*vector, hashPartitions);
+  const auto hotPartition = hashPartitions[0];
+
+  // The replicated side goes to the hash partitions and to the 3 partitions
+  // after them.
+  std::vector<uint32_t> partitions;
+  SkewedHashPartitionFunction replicateFunction(
+      8, rowType, {0}, SkewedHashPartitionFunction::Mode::kReplicate, 4);
+  replicateFunction.partition(*vector, partitions);
+  EXPECT_EQ(hashPartitions, partitions);
+  EXPECT_EQ(4, replicateFunction.numReplicas());
+  EXPECT_EQ(0, replicateFunction.numSprayedRows());
+
+  // The hot key is spread over 4 partitions once enough rows have been seen.
+  // The other keys go to their hash partitions.
+  SkewedHashPartitionFunction sprayFunction(
+      8, rowType, {0}, SkewedHashPartitionFunction::Mode::kSpray, 4);
+  sprayFunction.partition(*vector, partitions);
+  EXPECT_EQ(1, sprayFunction.numReplicas());
+  EXPECT_EQ(numRows / 4, sprayFunction.numSprayedRows());
+  std::vector<int32_t> numHotRows(4);
+  for (auto i = 0; i < numRows; ++i) {
+    if (i % 2 == 1) {
+      EXPECT_EQ(hashPartitions[i], partitions[i]);
+    } else {
+      const auto offset = (partitions[i] + 8 - hotPartition) % 8;
+      ASSERT_LT(offset, 4);
+      ++numHotRows[offset];
+    }
+  }
+  EXPECT_EQ(numRows / 4 + numRows / 16, numHotRows[0]);
+  for (auto offset = 1; offset < 4; ++offset) {
+    EXPECT_EQ(numRows / 16, numHotRows[offset]);
+  }
+
+  // The spray width is at most the number of partitions.
+  SkewedHashPartitionFunction narrowFunction(
+      2, rowType, {0}, SkewedHashPartitionFunction::Mode::kReplicate, 4);
+  EXPECT_EQ(2, narrowFunction.numReplicas());
+}
+
+TEST_F(HashPartitionFunctionTest, skewedSpec) {
+  Type::registerSerDe();
+
+  RowTypePtr inputType(ROW({"c0", "c1"}, {BIGINT(), VARCHAR()}));
+  for (auto mode :
+       {SkewedHashPartitionFunction::Mode::kSpray,
+        SkewedHashPartitionFunction::Mode::kReplicate}) {
+    auto spec = std::make_unique<SkewedHashPartitionFunctionSpec>(
+        inputType, std::vector<column_index_t>{1, 0}, mode, 4, 2.0);
+    ASSERT_EQ(
+        mode == SkewedHashPartitionFunction::Mode::kSpray
+            ? "SKEWED_HASH(c1, c0, spray 4)"
+            : "SKEWED_HASH(c1, c0, replicate 4)",
+        spec->toString());
+
+    auto copy =
+        SkewedHashPartitionFunctionSpec::deserialize(spec->serialize(), pool());
+    ASSERT_EQ(spec->toString(), copy->toString());
+    ASSERT_EQ(spec->serialize(), copy->serialize());
+  }
+}
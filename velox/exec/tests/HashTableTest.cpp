@@ -94,6 +94,10 @@ class HashTableTest : public testing::TestWithParam<bool> {
     }
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
     EXPECT_EQ(topTable_->hashMode(), mode);
+    if (minTableBytesForPartitionedProbe_.has_value()) {
+      topTable_->testingSetMinTableBytesForPartitionedProbe(
+          minTableBytesForPartitionedProbe_.value());
+    }
     LOG(INFO) << "Made table " << describeTable();
     testProbe();
     testEraseEveryN(3);
@@ -352,6 +356,8 @@ class HashTableTest : public testing::TestWithParam<bool> {
 
   void testProbe() {
     auto lookup = std::make_unique<HashLookup>(topTable_->hashers());
+    lookup->probeLane = probeLane_;
+    lookup->numProbeLanes = numProbeLanes_;
     auto batchSize = batches_[0]->size();
     SelectivityVector rows(batchSize);
     auto mode = topTable_->hashMode();
@@ -490,6 +496,10 @@ class HashTableTest : public testing::TestWithParam<bool> {
   // Spacing between consecutive generated keys. Affects whether
   // Vectorhashers make ranges or ids of distinct values.
   int64_t keySpacing_ = 1;
+  // Overrides the table size above which join probes are partitioned.
+  std::optional<uint64_t> minTableBytesForPartitionedProbe_;
+  int32_t probeLane_{0};
+  int32_t numProbeLanes_{1};
   std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
 };
 
@@ -534,6 +544,30 @@ TEST_P(HashTableTest, structKey) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
 }
 
+TEST_P(HashTableTest, partitionedProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  minTableBytesForPartitionedProbe_ = 0;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, staggeredPartitionedProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  keySpacing_ = 1000;
+  minTableBytesForPartitionedProbe_ = 0;
+  probeLane_ = 3;
+  numProbeLanes_ = 4;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 2);
+}
+
+TEST_P(HashTableTest, partitionedNormalizedKeyProbe) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  minTableBytesForPartitionedProbe_ = 0;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 100000, 2, type, 2);
+}
+
 TEST_P(HashTableTest, mixed6Sparse) {
   auto type =
       ROW({"k1", "k2", "k3", "k4", "k5", "k6"},
@@ -754,6 +788,61 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, packedKeys) {
+  auto rowType = ROW({"k1", "k2"}, {BIGINT(), VARCHAR()});
+  auto table = createHashTableForAggregation(rowType, 2);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  // 1 null byte, 8 bytes of BIGINT and 13 bytes of string round up to 32.
+  ASSERT_EQ(table->packedKeySize(), 32);
+
+  constexpr int32_t kSize = 10'000;
+  std::vector<std::string> strings(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    strings[i] = fmt::format("s{}", i % 100);
+  }
+  auto makeBatch = [&](int32_t longStringRow) {
+    return vectorMaker_->rowVector(
+        {vectorMaker_->flatVector<int64_t>(
+             kSize,
+             [](auto row) { return row / 100; },
+             [](auto row) { return row % 71 == 0; }),
+         vectorMaker_->flatVector<StringView>(
+             kSize,
+             [&](auto row) {
+               return row == longStringRow
+                   ? StringView("a string that is not inlined")
+                   : StringView(strings[row]);
+             },
+             [](auto row) { return row % 97 == 0; })});
+  };
+  auto batch = makeBatch(-1);
+
+  // Groups inserted before switching to kHash get their keys packed.
+  insertGroups(*batch, *lookup, *table);
+  const auto numDistinct = table->numDistinct();
+  table->testingSetHashMode(BaseHashTable::HashMode::kHash, 0);
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  ASSERT_EQ(table->packedKeySize(), 32);
+
+  std::vector<char*> hits(lookup->hits.begin(), lookup->hits.end());
+  insertGroups(*batch, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), numDistinct);
+  for (auto i = 0; i < kSize; ++i) {
+    ASSERT_EQ(lookup->hits[i], hits[i]);
+  }
+
+  // A key that does not fit disables packing. The groups are still found.
+  auto longStringBatch = makeBatch(1);
+  insertGroups(*longStringBatch, *lookup, *table);
+  ASSERT_EQ(table->packedKeySize(), 0);
+  ASSERT_EQ(table->numDistinct(), numDistinct + 1);
+  for (auto i = 0; i < kSize; ++i) {
+    if (i != 1) {
+      ASSERT_EQ(lookup->hits[i], hits[i]);
+    }
+  }
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = vectorMaker_->flatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/InputCapture.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/vector/VectorSaver.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class InputCaptureTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    Type::registerSerDe();
+    core::PlanNode::registerSerDe();
+    core::ITypedExpr::registerSerDe();
+  }
+
+  std::vector<RowVectorPtr> makeData(int32_t numBatches) {
+    std::vector<RowVectorPtr> data;
+    for (auto i = 0; i < numBatches; ++i) {
+      data.push_back(makeRowVector({
+          makeFlatVector<int64_t>(100, [i](auto row) { return i * 100 + row; }),
+          makeFlatVector<int32_t>(100, [](auto row) { return row % 7; }),
+      }));
+    }
+    return data;
+  }
+};
+
+TEST_F(InputCaptureTest, captureAndReplay) {
+  auto data = makeData(5);
+  auto captureDir = TempDirectoryPath::create();
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .project({"c0 + c1 AS s", "c1"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  // Capture does not change the results.
+  auto results = AssertQueryBuilder(plan).copyResults(pool());
+  auto task = AssertQueryBuilder(plan)
+                  .config(
+                      core::QueryConfig::kInputCapturePlanNodeIds,
+                      fmt::format("x,{}", projectId))
+                  .config(core::QueryConfig::kInputCaptureDir, captureDir->path)
+                  .config(core::QueryConfig::kInputCaptureMaxBatches, "3")
+                  .assertResults(results);
+
+  const auto taskDir = fmt::format("{}/{}", captureDir->path, task->taskId());
+  // Only the first 3 batches are saved.
+  auto inputs = InputCapture::restore(
+      InputCapture::planNodeDirectory(taskDir, projectId), pool());
+  ASSERT_EQ(inputs.size(), 3);
+  for (auto i = 0; i < inputs.size(); ++i) {
+    assertEqualVectors(data[i], inputs[i]);
+  }
+  EXPECT_EQ(
+      InputCapture::restore(
+          InputCapture::planNodeDirectory(taskDir, projectId),
+          pool(),
+          "Unknown")
+          .size(),
+      0);
+
+  // The saved plan and inputs replay the project on the captured batches.
+  auto savedPlan = ISerializable::deserialize<core::PlanNode>(
+      folly::parseJson(
+          restoreStringFromFile(fmt::format("{}/plan.json", taskDir).c_str())),
+      pool());
+  auto replayPlan =
+      InputCapture::makeReplayPlan(savedPlan, projectId, inputs, pool());
+  ASSERT_EQ(replayPlan->id(), projectId);
+  std::vector<RowVectorPtr> captured(data.begin(), data.begin() + 3);
+  auto expected =
+      AssertQueryBuilder(PlanBuilder()
+                             .values(captured)
+                             .project({"c0 + c1 AS s", "c1"})
+                             .planNode())
+          .copyResults(pool());
+  AssertQueryBuilder(replayPlan).assertResults(expected);
+
+  VELOX_ASSERT_THROW(
+      InputCapture::makeReplayPlan(savedPlan, "missing", inputs, pool()),
+      "Plan node not found: missing");
+}
+
+TEST_F(InputCaptureTest, disabled) {
+  auto data = makeData(2);
+  auto captureDir = TempDirectoryPath::create();
+  core::PlanNodeId projectId;
+  auto plan = PlanBuilder()
+                  .values(data)
+                  .project({"c0 + c1 AS s"})
+                  .capturePlanNodeId(projectId)
+                  .planNode();
+  auto results = AssertQueryBuilder(plan).copyResults(pool());
+  // No plan node id is set.
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kInputCaptureDir, captureDir->path)
+                  .assertResults(results);
+  EXPECT_TRUE(fs::is_empty(captureDir->path));
+
+  // Another plan node is captured.
+  task = AssertQueryBuilder(plan)
+             .config(core::QueryConfig::kInputCapturePlanNodeIds, "other")
+             .config(core::QueryConfig::kInputCaptureDir, captureDir->path)
+             .assertResults(results);
+  const auto taskDir = fmt::format("{}/{}", captureDir->path, task->taskId());
+  EXPECT_TRUE(fs::exists(fmt::format("{}/plan.json", taskDir)));
+  EXPECT_FALSE(
+      fs::exists(InputCapture::planNodeDirectory(taskDir, projectId)));
+}
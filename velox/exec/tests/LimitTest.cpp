@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -97,3 +99,35 @@ TEST_F(LimitTest, limitOverLocalExchange) {
   ASSERT_EQ(20, numRead);
   ASSERT_TRUE(waitForTaskCompletion(cursor.task().get()));
 }
+
+TEST_F(LimitTest, limitOverTableScan) {
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(10'000, [](auto row) { return row; })});
+  createDuckDbTable({data});
+
+  auto file = TempFilePath::create();
+  writeToFile(file->path, {data});
+
+  // The scan reads only as many rows as the limit needs.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(asRowType(data->type()))
+                  .capturePlanNodeId(scanNodeId)
+                  .limit(0, 5, true)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .split(makeHiveConnectorSplit(file->path))
+                  .assertTypeAndNumRows(asRowType(data->type()), 5);
+  auto scanStats = exec::toPlanStats(task->taskStats()).at(scanNodeId);
+  ASSERT_EQ(5, scanStats.rawInputRows);
+
+  // With a filter that drops most rows, the reads grow until the limit is
+  // filled.
+  plan = PlanBuilder()
+             .tableScan(asRowType(data->type()), {"c0 >= 9990"})
+             .limit(0, 5, true)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .split(makeHiveConnectorSplit(file->path))
+      .assertResults("SELECT * FROM tmp WHERE c0 >= 9990 LIMIT 5");
+}
@@ -192,6 +192,106 @@ TEST_F(LocalPartitionTest, partition) {
   verifyExchangeSourceOperatorStats(task, 300, 6);
 }
 
+TEST_F(LocalPartitionTest, workStealing) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatSequence<int32_t>(i * 100, 100)}));
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .localPartitionRoundRobin(
+              {PlanBuilder(planNodeIdGenerator).values(vectors).planNode()})
+          .project({"c0 * 2"})
+          .planNode();
+
+  // Round robin slices each input vector among the 4 consumers.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .maxDrivers(4)
+                  .assertResults("SELECT c0 * 2 FROM tmp");
+  verifyExchangeSourceOperatorStats(task, 1'000, 40);
+
+  // With work stealing, the consumers take whole input vectors.
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .maxDrivers(4)
+             .config(core::QueryConfig::kLocalExchangeWorkStealing, "true")
+             .assertResults("SELECT c0 * 2 FROM tmp");
+  verifyExchangeSourceOperatorStats(task, 1'000, 10);
+
+  // A consumer that finishes early does not drop the data of the others.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .localPartitionRoundRobin(
+                 {PlanBuilder(planNodeIdGenerator).values(vectors).planNode()})
+             .limit(0, 1, true)
+             .planNode();
+  auto result =
+      AssertQueryBuilder(plan)
+          .maxDrivers(4)
+          .config(core::QueryConfig::kLocalExchangeWorkStealing, "true")
+          .copyResults(pool());
+  ASSERT_LE(1, result->size());
+  ASSERT_GE(4, result->size());
+}
+
+TEST_F(LocalPartitionTest, scaledConsumers) {
+  auto memoryManager = std::make_shared<LocalExchangeMemoryManager>(1L << 30);
+  auto queue = std::make_shared<LocalExchangeQueue>(memoryManager, 0, 4);
+  auto vector = makeRowVector({makeFlatSequence<int32_t>(0, 100)});
+  const auto bytes = vector->estimateFlatSize();
+  bool canScaleUp = true;
+  queue->enableScaling(2 * bytes, [&]() { return canScaleUp; });
+  queue->addProducer();
+  queue->noMoreProducers();
+
+  ContinueFuture future;
+  RowVectorPtr data;
+  auto enqueue = [&]() {
+    ASSERT_EQ(queue->enqueue(vector, &future), BlockingReason::kNotBlocked);
+  };
+
+  // Consumer 1 waits while only consumer 0 is active.
+  enqueue();
+  ASSERT_EQ(queue->numActiveConsumers(), 1);
+  ASSERT_EQ(
+      queue->next(&future, pool(), &data, 1),
+      BlockingReason::kWaitForProducer);
+
+  // Two queued vectors activate consumer 1.
+  enqueue();
+  ASSERT_EQ(queue->numActiveConsumers(), 2);
+  ASSERT_EQ(
+      queue->next(&future, pool(), &data, 1), BlockingReason::kNotBlocked);
+  ASSERT_NE(data, nullptr);
+
+  // No consumer is activated while 'canScaleUp' says no.
+  canScaleUp = false;
+  for (auto i = 0; i < 3; ++i) {
+    enqueue();
+  }
+  ASSERT_EQ(queue->numActiveConsumers(), 2);
+  canScaleUp = true;
+  enqueue();
+  ASSERT_EQ(queue->numActiveConsumers(), 3);
+  queue->noMoreData();
+
+  // Consumer 3 is never activated and finishes once the others have taken all
+  // the data.
+  ASSERT_EQ(
+      queue->next(&future, pool(), &data, 3),
+      BlockingReason::kWaitForProducer);
+  for (auto i = 0; i < 5; ++i) {
+    ASSERT_EQ(
+        queue->next(&future, pool(), &data, 2), BlockingReason::kNotBlocked);
+    ASSERT_NE(data, nullptr);
+  }
+  ASSERT_EQ(
+      queue->next(&future, pool(), &data, 3), BlockingReason::kNotBlocked);
+  ASSERT_EQ(data, nullptr);
+  ASSERT_TRUE(queue->isFinished());
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +143,71 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, fusedMarkers) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 7; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 101; }),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return i + row % 3; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .markDistinct("c1_distinct", {"c0", "c1"})
+          .markDistinct("c2_distinct", {"c0", "c2"})
+          .markDistinct("c12_distinct", {"c0", "c1", "c2"})
+          .singleAggregation(
+              {"c0"},
+              {"count(c1)", "sum(c2)", "count(c1)", "count(1)"},
+              {"c1_distinct", "c2_distinct", "c12_distinct", ""})
+          .planNode();
+
+  // The three MarkDistinct nodes run as one operator.
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .assertResults(
+              "SELECT c0, count(distinct c1), sum(distinct c2), "
+              "count(distinct c1 * 1000 + c2), count(1) FROM tmp GROUP BY 1");
+  ASSERT_EQ(task->taskStats().pipelineStats[0].operatorStats.size(), 3);
+}
+
+TEST_F(MarkDistinctTest, spill) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [i](auto row) { return (i * 1'000 + row) % 3'001; }),
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = TempDirectoryPath::create();
+  core::PlanNodeId markDistinctId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("c0_distinct", {"c0"})
+                  .capturePlanNodeId(markDistinctId)
+                  .planNode();
+  // NOTE: the first row of each distinct key in the input order is marked,
+  // which is the row with the smallest c1.
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kMarkDistinctSpillEnabled, "true")
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .assertResults(
+              "SELECT c0, c1, row_number() over (partition by c0 order by c1) = 1 FROM tmp");
+  const auto stats = toPlanStats(task->taskStats()).at(markDistinctId);
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/MemoryTimeline.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+MemoryTimelineEvent makeEvent(uint64_t timeMs, int64_t bytes = 0) {
+  return {MemoryTimelineEvent::Kind::kReservation, 0, 0, timeMs, bytes};
+}
+} // namespace
+
+class MemoryTimelineTest : public OperatorTestBase {};
+
+TEST_F(MemoryTimelineTest, ringBuffer) {
+  MemoryTimeline timeline(3, 1'000);
+  for (auto i = 0; i < 2; ++i) {
+    timeline.record(makeEvent(i));
+  }
+  EXPECT_EQ(timeline.events().size(), 2);
+  EXPECT_EQ(timeline.numDropped(), 0);
+
+  for (auto i = 2; i < 7; ++i) {
+    timeline.record(makeEvent(i));
+  }
+  // Keeps the latest events, oldest first.
+  auto events = timeline.events();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].timeMs, 4);
+  EXPECT_EQ(events[1].timeMs, 5);
+  EXPECT_EQ(events[2].timeMs, 6);
+  EXPECT_EQ(timeline.numDropped(), 4);
+}
+
+TEST_F(MemoryTimelineTest, sampleInterval) {
+  MemoryTimeline timeline(10, 1'000);
+  EXPECT_TRUE(timeline.startSample(5'000));
+  EXPECT_FALSE(timeline.startSample(5'000));
+  EXPECT_FALSE(timeline.startSample(5'999));
+  EXPECT_TRUE(timeline.startSample(6'000));
+  EXPECT_FALSE(timeline.startSample(6'500));
+}
+
+TEST_F(MemoryTimelineTest, task) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto plan = PlanBuilder().values({data}).planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kMemoryTimelineMaxEvents, "100")
+                  .assertResults(data);
+  ASSERT_NE(task->memoryTimeline(), nullptr);
+
+  // Adds events for the Values operator to show them in the plan.
+  auto stats = task->taskStats();
+  const auto startMs = stats.executionStartTimeMs;
+  stats.memoryTimeline = {
+      makeEvent(startMs + 10, 1 << 20),
+      makeEvent(startMs + 20, 2 << 20),
+      {MemoryTimelineEvent::Kind::kSpillStart, 0, 0, startMs + 30, 2 << 20},
+      {MemoryTimelineEvent::Kind::kSpillEnd, 0, 0, startMs + 40, 1 << 20},
+      {MemoryTimelineEvent::Kind::kArbitrationRequest, 0, 0, startMs + 50, 0},
+      {MemoryTimelineEvent::Kind::kCachePressure, -1, -1, startMs + 60, 1024},
+  };
+  auto printed = printPlanWithStats(*plan, stats);
+  EXPECT_NE(
+      printed.find("Memory timeline: peak reservation 2.00MB at 20ms, "
+                   "Spills: 1, Spill reclaimed: 1.00MB, "
+                   "Arbitration requests: 1"),
+      std::string::npos)
+      << printed;
+  EXPECT_NE(printed.find("Cache: peak 1.00KB at 60ms"), std::string::npos)
+      << printed;
+}
+
+TEST_F(MemoryTimelineTest, disabled) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(10, folly::identity)});
+  auto plan = PlanBuilder().values({data}).planNode();
+  auto task = AssertQueryBuilder(plan).assertResults(data);
+  EXPECT_EQ(task->memoryTimeline(), nullptr);
+  auto stats = task->taskStats();
+  EXPECT_TRUE(stats.memoryTimeline.empty());
+  EXPECT_EQ(
+      printPlanWithStats(*plan, stats).find("Memory timeline"),
+      std::string::npos);
+}
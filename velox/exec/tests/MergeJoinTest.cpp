@@ -178,6 +178,51 @@ class MergeJoinTest : public HiveConnectorTestBase {
     assertQuery(
         makeCursorParameters(plan, 10'000),
         "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
+
+    // Test RIGHT, FULL, SEMI and ANTI joins with small, regular and large
+    // output batch sizes.
+    auto makePlan = [&](core::JoinType joinType,
+                        const std::vector<std::string>& outputLayout) {
+      planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      return PlanBuilder(planNodeIdGenerator)
+          .values(left)
+          .mergeJoin(
+              {"c0"},
+              {"u_c0"},
+              PlanBuilder(planNodeIdGenerator)
+                  .values(right)
+                  .project({"c1 as u_c1", "c0 as u_c0"})
+                  .planNode(),
+              "",
+              outputLayout,
+              joinType)
+          .planNode();
+    };
+
+    for (auto batchSize : {16, 1024, 10'000}) {
+      assertQuery(
+          makeCursorParameters(
+              makePlan(core::JoinType::kRight, {"c0", "c1", "u_c1"}),
+              batchSize),
+          "SELECT t.c0, t.c1, u.c1 FROM t RIGHT JOIN u ON t.c0 = u.c0");
+
+      assertQuery(
+          makeCursorParameters(
+              makePlan(core::JoinType::kFull, {"c0", "c1", "u_c1"}),
+              batchSize),
+          "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
+
+      assertQuery(
+          makeCursorParameters(
+              makePlan(core::JoinType::kLeftSemiFilter, {"c0", "c1"}),
+              batchSize),
+          "SELECT t.c0, t.c1 FROM t WHERE t.c0 IN (SELECT c0 FROM u)");
+
+      assertQuery(
+          makeCursorParameters(
+              makePlan(core::JoinType::kAnti, {"c0", "c1"}), batchSize),
+          "SELECT t.c0, t.c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE u.c0 = t.c0)");
+    }
   }
 };
 
@@ -415,6 +460,60 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, semiAndAntiJoinFilter) {
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({5, 10, 10, 15, 20, 20, 25}),
+          makeFlatVector<int32_t>({0, 0, 1, 2, 3, 4, 5}),
+      });
+
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({10, 10, 10, 15, 20, 20, 30}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5, 6}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = [&](const std::string& filter, core::JoinType joinType) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            {"t_c0", "t_c1"},
+            joinType)
+        .planNode();
+  };
+
+  for (auto batchSize : {1, 3, 16}) {
+    for (auto filter :
+         {"t_c1 + u_c1 > 3",
+          "t_c1 + u_c1 < 3",
+          "t_c1 + u_c1 > 100",
+          "t_c1 + u_c1 < 100"}) {
+      assertQuery(
+          makeCursorParameters(
+              plan(filter, core::JoinType::kLeftSemiFilter), batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+
+      assertQuery(
+          makeCursorParameters(plan(filter, core::JoinType::kAnti), batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+    }
+  }
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -539,3 +638,47 @@ TEST_F(MergeJoinTest, nullKeys) {
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
 }
+
+  // Right join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kRight)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t RIGHT JOIN u ON t.t0 = u.u0");
+
+  // Full join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kFull)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+
+  // Anti join outputs left-side rows with null keys.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0"},
+                 core::JoinType::kAnti)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT * FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.t0 = u.u0)");
+}
@@ -182,3 +182,49 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+TEST_F(MergeTest, rangeMerge) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 8; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](auto row) { return (row * 7 + i * 13) % 997; },
+            nullEvery(31)),
+        makeFlatVector<StringView>(
+            batchSize,
+            [&](auto row) {
+              return StringView::makeInline(std::to_string(row % 89 + i));
+            }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  const std::vector<std::pair<std::string, uint32_t>> orderBys = {
+      {"c0 NULLS LAST", 0}, {"c0 DESC NULLS FIRST", 0}, {"c1 DESC", 1}};
+  for (const auto& [orderBy, keyIndex] : orderBys) {
+    SCOPED_TRACE(orderBy);
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    std::vector<std::shared_ptr<const core::PlanNode>> sources;
+    for (auto i = 0; i < vectors.size(); i += 2) {
+      sources.push_back(PlanBuilder(planNodeIdGenerator)
+                            .values({vectors[i], vectors[i + 1]})
+                            .orderBy({orderBy}, true)
+                            .planNode());
+    }
+    CursorParameters params;
+    params.planNode = PlanBuilder(planNodeIdGenerator)
+                          .localMerge({orderBy}, std::move(sources))
+                          .planNode();
+    params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    params.queryCtx->testingOverrideConfigUnsafe({
+        {core::QueryConfig::kLocalMergeParallelism, "4"},
+        {core::QueryConfig::kPreferredOutputBatchRows, "100"},
+    });
+    assertQueryOrdered(
+        params,
+        fmt::format("SELECT * FROM tmp ORDER BY {}", orderBy),
+        {keyIndex});
+  }
+}
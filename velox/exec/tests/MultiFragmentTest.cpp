@@ -21,8 +21,10 @@
 #include "velox/dwio/common/DataSink.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -308,6 +310,31 @@ TEST_F(MultiFragmentTest, distributedTableScan) {
   }
 }
 
+TEST_F(MultiFragmentTest, compressedExchange) {
+  if (!folly::io::hasCodec(folly::io::CodecType::LZ4)) {
+    GTEST_SKIP() << "LZ4 is not available";
+  }
+  configSettings_[core::QueryConfig::kExchangeCompressionKind] = "lz4";
+  setupSources(10, 1000);
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .project({"c0 % 10", "c1 % 2", "c2"})
+                      .partitionedOutput({}, 1, {"c2", "p1", "p0"})
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  Task::start(leafTask, 4);
+  addHiveSplits(leafTask, filePaths_);
+
+  auto op = PlanBuilder().exchange(leafPlan->outputType()).planNode();
+  AssertQueryBuilder(op, duckDbQueryRunner_)
+      .split(std::make_shared<RemoteConnectorSplit>(leafTaskId))
+      .config(core::QueryConfig::kExchangeCompressionKind, "lz4")
+      .assertResults("SELECT c2, c1 % 2, c0 % 10 FROM tmp");
+
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+}
+
 TEST_F(MultiFragmentTest, mergeExchange) {
   setupSources(20, 1000);
 
@@ -576,6 +603,65 @@ TEST_F(MultiFragmentTest, replicateNullsAndAny) {
   }
 }
 
+TEST_F(MultiFragmentTest, skewedPartitionedOutput) {
+  auto data = makeRowVector(
+      {makeFlatVector<int32_t>(1'000, [](auto row) { return row; })});
+
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto addTask = [&](std::shared_ptr<Task> task,
+                     const std::vector<std::string>& remoteTaskIds) {
+    tasks.emplace_back(task);
+    Task::start(task, 1);
+    if (!remoteTaskIds.empty()) {
+      addRemoteSplits(task, remoteTaskIds);
+    }
+  };
+
+  // Make leaf task: Values -> Repartitioning (3-way), replicating each row to
+  // 2 partitions.
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan =
+      PlanBuilder()
+          .values({data})
+          .partitionedOutput(
+              {"c0"},
+              3,
+              false,
+              std::make_shared<SkewedHashPartitionFunctionSpec>(
+                  asRowType(data->type()),
+                  std::vector<column_index_t>{0},
+                  SkewedHashPartitionFunctionSpec::Mode::kReplicate,
+                  2))
+          .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  addTask(leafTask, {});
+
+  core::PlanNodePtr finalAggPlan;
+  std::vector<std::string> finalAggTaskIds;
+  for (int i = 0; i < 3; i++) {
+    finalAggPlan = PlanBuilder()
+                       .exchange(leafPlan->outputType())
+                       .partialAggregation({}, {"count(1)"})
+                       .partitionedOutput({}, 1)
+                       .planNode();
+
+    finalAggTaskIds.push_back(makeTaskId("final-agg", i));
+    auto task = makeTask(finalAggTaskIds.back(), finalAggPlan, i);
+    addTask(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder()
+                .exchange(finalAggPlan->outputType())
+                .finalAggregation({}, {"sum(a0)"}, {BIGINT()})
+                .planNode();
+
+  assertQuery(op, finalAggTaskIds, "SELECT 2000");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
 // Test query finishing before all splits have been scheduled.
 TEST_F(MultiFragmentTest, limit) {
   auto data = makeRowVector({makeFlatVector<int32_t>(
@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/NestedLoopJoinBuild.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
@@ -394,3 +396,134 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, smallOutputBatchSize) {
+  // Build vectors are larger than the output batch size, so each probe row is
+  // paired with a block of build rows at a time.
+  auto probeVectors = makeBatches(20, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(100, 3, buildType_, pool_.get());
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  for (const auto joinType : joinTypes_) {
+    SCOPED_TRACE(joinTypeName(joinType));
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .nestedLoopJoin(
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "t0 < u0",
+                        {"t0", "u0"},
+                        joinType)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+        .assertResults(fmt::format(
+            "SELECT t0, u0 FROM t {} JOIN u ON t.t0 < u.u0",
+            joinTypeName(joinType)));
+  }
+}
+
+TEST_F(NestedLoopJoinTest, rangeCondition) {
+  auto rangeOf = [&](const std::string& condition) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values({makeRowVector(
+                {"t0", "t1"},
+                {makeFlatVector<int64_t>({1}), makeFlatVector<double>({1})})})
+            .nestedLoopJoin(
+                PlanBuilder(planNodeIdGenerator)
+                    .values({makeRowVector(
+                        {"u0", "u1", "u2"},
+                        {makeFlatVector<int64_t>({1}),
+                         makeFlatVector<int64_t>({1}),
+                         makeFlatVector<double>({1})})})
+                    .planNode(),
+                condition,
+                {"t0", "u0"})
+            .planNode();
+    return NestedLoopJoinRange::make(
+        *std::dynamic_pointer_cast<const core::NestedLoopJoinNode>(plan),
+        core::QueryConfig({}));
+  };
+
+  auto range = rangeOf("t0 BETWEEN u0 AND u1");
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(range->probeChannel, 0);
+  EXPECT_EQ(range->buildLowChannel, 0);
+  EXPECT_EQ(range->buildHighChannel, 1);
+
+  range = rangeOf("u1 > t0 AND t1 > u2 AND u0 <= t0");
+  ASSERT_TRUE(range.has_value());
+  EXPECT_EQ(range->buildLowChannel, 0);
+  EXPECT_EQ(range->buildHighChannel, 1);
+
+  // A single bound, a bound under OR and a floating point bound are not
+  // ranges.
+  EXPECT_FALSE(rangeOf("t0 < u0").has_value());
+  EXPECT_FALSE(rangeOf("t0 >= u0 AND (t0 <= u1 OR t1 > u2)").has_value());
+  EXPECT_FALSE(rangeOf("t1 BETWEEN u2 AND u2").has_value());
+}
+
+TEST_F(NestedLoopJoinTest, rangeJoin) {
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {"t0"},
+        {makeFlatVector<int64_t>(
+            300,
+            [i](auto row) { return (i * 300 + row) * 7 % 1'000; },
+            nullEvery(17))}));
+  }
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return (i * 100 + row) * 13 % 1'000; }),
+         makeFlatVector<int64_t>(
+             100,
+             [i](auto row) {
+               return (i * 100 + row) * 13 % 1'000 + row % 50;
+             },
+             nullEvery(23))}));
+  }
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  const std::vector<std::string> conditions = {
+      "t0 BETWEEN u0 AND u1",
+      "u0 < t0 AND t0 < u1 AND t0 % 2 = 0",
+      "t0 >= u0 AND u1 >= t0 AND u1 - u0 > 10"};
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  for (const auto& condition : conditions) {
+    for (const auto joinType : joinTypes_) {
+      for (const auto enabled : {false, true}) {
+        SCOPED_TRACE(fmt::format(
+            "{} {} enabled: {}", condition, joinTypeName(joinType), enabled));
+        auto plan = PlanBuilder(planNodeIdGenerator)
+                        .values(probeVectors)
+                        .nestedLoopJoin(
+                            PlanBuilder(planNodeIdGenerator)
+                                .values(buildVectors)
+                                .planNode(),
+                            condition,
+                            {"t0", "u0", "u1"},
+                            joinType)
+                        .planNode();
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(
+                core::QueryConfig::kNestedLoopJoinRangeEnabled,
+                enabled ? "true" : "false")
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+            .assertResults(fmt::format(
+                "SELECT t0, u0, u1 FROM t {} JOIN u ON {}",
+                joinTypeName(joinType),
+                condition));
+      }
+    }
+  }
+}
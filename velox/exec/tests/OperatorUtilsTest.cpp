@@ -359,3 +359,44 @@ TEST_F(OperatorUtilsTest, projectChildren) {
     }
   }
 }
+
+TEST_F(OperatorUtilsTest, findKeyBoundaries) {
+  const vector_size_t size = 1'000;
+  std::vector<VectorPtr> keys = {
+      makeConstant<int32_t>(7, size),
+      makeFlatVector<int8_t>(size, [](auto row) { return row / 300; }),
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return row / 7; },
+          [](auto row) { return row % 50 < 3 || row == 999; }),
+      wrapInDictionary(
+          makeIndices(size, [](auto row) { return row; }),
+          size,
+          makeFlatVector<int32_t>(size, [](auto row) { return row / 11; })),
+      makeFlatVector<StringView>(
+          size,
+          [](auto row) { return StringView(fmt::format("k{}", row / 13)); },
+          nullEvery(17)),
+  };
+
+  SelectivityVector rows(size);
+  // Checks every prefix of the keys, so each key type runs first once.
+  for (auto numKeys = 1; numKeys <= keys.size(); ++numKeys) {
+    std::vector<DecodedVector> decoded(numKeys);
+    for (auto i = 0; i < numKeys; ++i) {
+      decoded[i].decode(*keys[i], rows);
+    }
+    std::vector<uint64_t> boundaries(bits::nwords(size), ~0ULL);
+    findKeyBoundaries(decoded, size, boundaries.data());
+
+    ASSERT_FALSE(bits::isBitSet(boundaries.data(), 0));
+    for (auto row = 1; row < size; ++row) {
+      bool expected = false;
+      for (auto i = 0; i < numKeys; ++i) {
+        expected |= !keys[i]->equalValueAt(keys[i].get(), row, row - 1);
+      }
+      ASSERT_EQ(expected, bits::isBitSet(boundaries.data(), row))
+          << "row " << row << " with " << numKeys << " keys";
+    }
+  }
+}
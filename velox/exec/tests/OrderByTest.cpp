@@ -421,6 +421,59 @@ TEST_F(OrderByTest, outputBatchRows) {
   }
 }
 
+TEST_F(OrderByTest, sortThreads) {
+  const int kNumBatches = 4;
+  const int kNumRows = 20'000;
+  std::vector<RowVectorPtr> batches;
+  for (int i = 0; i < kNumBatches; ++i) {
+    batches.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             kNumRows,
+             [&](auto row) { return (row * 7'919 + i) % 5'000; },
+             nullEvery(13)),
+         makeFlatVector<StringView>(kNumRows, [&](auto row) {
+           return StringView::makeInline(std::to_string(row + i));
+         })}));
+  }
+  createDuckDbTable(batches);
+  const std::vector<std::string> orderBy = {"c0 DESC NULLS FIRST", "c1"};
+  const std::string sql =
+      "SELECT * FROM tmp ORDER BY c0 DESC NULLS FIRST, c1";
+
+  for (auto sortThreads : {1, 4}) {
+    SCOPED_TRACE(fmt::format("sortThreads: {}", sortThreads));
+    auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+    queryCtx->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kOrderBySortThreads,
+          std::to_string(sortThreads)}});
+    CursorParameters params;
+    params.planNode =
+        PlanBuilder().values(batches).orderBy(orderBy, false).planNode();
+    params.queryCtx = queryCtx;
+    assertQueryOrdered(params, sql, {0, 1});
+  }
+
+  // Each driver sorts a share of the input and a LocalMerge merges the
+  // runs.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kOrderBySortThreads, "1"}});
+  CursorParameters params;
+  params.planNode = PlanBuilder(planNodeIdGenerator)
+                        .localMerge(
+                            orderBy,
+                            {PlanBuilder(planNodeIdGenerator)
+                                 .values(batches)
+                                 .localPartitionRoundRobin()
+                                 .orderBy(orderBy, true)
+                                 .planNode()})
+                        .planNode();
+  params.queryCtx = queryCtx;
+  params.maxDrivers = 4;
+  assertQueryOrdered(params, sql, {0, 1});
+}
+
 TEST_F(OrderByTest, spill) {
   const int kNumBatches = 3;
   const int kNumRows = 100'000;
@@ -1017,8 +1070,9 @@ DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringOutputProcessing) {
       ASSERT_GT(reclaimableBytes, 0);
       const auto usedMemoryBytes = op->pool()->currentBytes();
       op->reclaim(folly::Random::oneIn(2) ? 0 : folly::Random::rand32(rng_));
-      // No reclaim as the operator has started output processing.
-      ASSERT_EQ(usedMemoryBytes, op->pool()->currentBytes());
+      // The rows not returned yet are spilled and the rest of the output is
+      // produced from the spilled data.
+      ASSERT_LT(op->pool()->currentBytes(), usedMemoryBytes);
     } else {
       ASSERT_EQ(reclaimableBytes, 0);
       VELOX_ASSERT_THROW(
@@ -1031,8 +1085,13 @@ DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringOutputProcessing) {
     taskThread.join();
 
     auto stats = task->taskStats().pipelineStats;
-    ASSERT_EQ(stats[0].operatorStats[1].spilledBytes, 0);
-    ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 0);
+    if (enableSpilling) {
+      ASSERT_GT(stats[0].operatorStats[1].spilledBytes, 0);
+      ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 1);
+    } else {
+      ASSERT_EQ(stats[0].operatorStats[1].spilledBytes, 0);
+      ASSERT_EQ(stats[0].operatorStats[1].spilledPartitions, 0);
+    }
     OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
   }
 }
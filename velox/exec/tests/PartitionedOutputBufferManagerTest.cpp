@@ -938,6 +938,45 @@ TEST_F(PartitionedOutputBufferManagerTest, setQueueErrorWithPendingPages) {
       auto page = queue->dequeueLocked(&atEnd, &future), std::runtime_error);
 }
 
+TEST_F(PartitionedOutputBufferManagerTest, inProcessExchangeSource) {
+  ExchangeSource::registerFactory();
+  const std::string taskId = "inProcess.0.0";
+  VELOX_ASSERT_THROW(
+      ExchangeSource::create(
+          taskId, 0, std::make_shared<ExchangeQueue>(1 << 20), pool_.get()),
+      "No ExchangeSource factory matches inProcess.0.0");
+
+  // A task with its output buffers in this process is read directly, without
+  // copying its pages.
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputBuffer::Kind::kPartitioned, 1, 1);
+  auto page = makeSerializedPage(rowType_, 100);
+  const auto* data = page->getIOBuf()->data();
+  ContinueFuture future;
+  ASSERT_EQ(
+      BlockingReason::kNotBlocked,
+      bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+
+  auto queue = std::make_shared<ExchangeQueue>(1 << 20);
+  auto source = ExchangeSource::create(taskId, 0, queue, pool_.get());
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    queue->addSourceLocked();
+    ASSERT_TRUE(source->shouldRequestLocked());
+  }
+  source->request();
+  {
+    std::lock_guard<std::mutex> l(queue->mutex());
+    bool atEnd;
+    auto received = queue->dequeueLocked(&atEnd, &future);
+    ASSERT_NE(nullptr, received);
+    ASSERT_EQ(data, received->getIOBuf()->data());
+  }
+  source->close();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(PartitionedOutputBufferManagerTest, getDataOnFailedTask) {
   // Fetching data on a task which was either never initialized in the buffer
   // manager or was removed by a parallel thread must return false. The `notify`
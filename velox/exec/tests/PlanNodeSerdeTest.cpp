@@ -399,6 +399,13 @@ TEST_F(PlanNodeSerdeTest, window) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .streamingWindow({"sum(c0) over (partition by c1 order by c2)"})
+             .planNode();
+
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, rowNumber) {
@@ -440,6 +447,12 @@ TEST_F(PlanNodeSerdeTest, topNRowNumber) {
              .topNRowNumber({"c0"}, {"c1", "c2"}, 10, false)
              .planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .topNRank("rank", {"c0"}, {"c1", "c2"}, 10, true)
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, write) {
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <numeric>
+#include "velox/exec/tests/utils/RowContainerTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+class PrefixSortTest : public exec::test::RowContainerTestBase {
+ protected:
+  // Stores the columns of 'data' as the keys of a new container and returns
+  // the rows in insertion order.
+  std::vector<char*> store(const RowVectorPtr& data) {
+    container_ = std::make_unique<RowContainer>(
+        data->type()->asRow().children(), pool_.get());
+    std::vector<char*> rows(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      rows[i] = container_->newRow();
+    }
+    const SelectivityVector allRows(data->size());
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column), allRows);
+      for (auto i = 0; i < data->size(); ++i) {
+        container_->store(decoded, i, rows[i], column);
+      }
+    }
+    return rows;
+  }
+
+  // Sorts 'rows' on all columns with 'flags' with a PrefixSort and checks
+  // that the order is the same as the one of a stable sort with
+  // RowContainer::compare.
+  void testSort(
+      std::vector<char*> rows,
+      const std::vector<CompareFlags>& flags,
+      int32_t expectedPrefixBytes,
+      int32_t expectedCompleteKeys) {
+    std::vector<column_index_t> keyColumns(flags.size());
+    std::iota(keyColumns.begin(), keyColumns.end(), 0);
+    PrefixSort prefixSort(container_.get(), keyColumns, flags);
+    EXPECT_EQ(expectedPrefixBytes, prefixSort.prefixBytes());
+    EXPECT_EQ(expectedCompleteKeys, prefixSort.numCompleteKeys());
+
+    auto expected = rows;
+    std::stable_sort(
+        expected.begin(),
+        expected.end(),
+        [&](const char* left, const char* right) {
+          for (auto i = 0; i < flags.size(); ++i) {
+            if (auto result = container_->compare(left, right, i, flags[i])) {
+              return result < 0;
+            }
+          }
+          return false;
+        });
+    auto actual = rows;
+    prefixSort.sort(actual);
+    ASSERT_EQ(expected, actual);
+    // An odd number of runs leaves a run without a merge partner.
+    for (auto numThreads : {2, 5}) {
+      actual = rows;
+      prefixSort.sort(actual, executor_.get(), numThreads);
+      ASSERT_EQ(expected, actual);
+    }
+  }
+
+  std::unique_ptr<RowContainer> container_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(4)};
+};
+
+const std::vector<CompareFlags> kAllFlags = {
+    {true, true, false, false},
+    {true, false, false, false},
+    {false, true, false, false},
+    {false, false, false, false}};
+
+TEST_F(PrefixSortTest, fixedWidth) {
+  constexpr int32_t kNumRows = 1'000;
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  const auto infinity = std::numeric_limits<double>::infinity();
+  const std::vector<double> doubles = {
+      0.0, -0.0, 1.5, -1.5, nan, infinity, -infinity, 1e-300};
+  auto rows = store(makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows,
+          [](auto row) { return (row % 7 - 3) * (1LL << (row % 60)); },
+          nullEvery(11)),
+      makeFlatVector<double>(
+          kNumRows,
+          [&](auto row) { return doubles[row % doubles.size()]; },
+          nullEvery(13)),
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 5 - 2; }),
+  }));
+  for (const auto& first : kAllFlags) {
+    for (const auto& second : kAllFlags) {
+      // Each key takes a null byte and 8 or 4 bytes of value.
+      testSort(rows, {first, second, {}}, 24, 3);
+    }
+  }
+  // A key that does not fit is left to the compare of ties.
+  testSort(rows, {{}, {}, {}}, 24, 3);
+}
+
+TEST_F(PrefixSortTest, strings) {
+  constexpr int32_t kNumRows = 1'000;
+  // Long strings that differ after the bytes in the prefix, short strings
+  // and strings with trailing zeros.
+  const std::vector<std::string> strings = {
+      std::string(20, 'a') + "b",
+      std::string(20, 'a') + "a",
+      std::string(20, 'a'),
+      "a",
+      "",
+      std::string("a\0", 2),
+      "ab",
+      "\xff\xfe"};
+  auto rows = store(makeRowVector({
+      makeFlatVector<StringView>(
+          kNumRows,
+          [&](auto row) { return StringView(strings[row % strings.size()]); },
+          nullEvery(17)),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 3; }),
+  }));
+  for (const auto& flags : kAllFlags) {
+    // The prefix ends with the first string key, which is never complete.
+    testSort(rows, {flags, flags}, 16, 0);
+  }
+
+  rows = store(makeRowVector({
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 4; }),
+      makeFlatVector<StringView>(
+          kNumRows,
+          [&](auto row) { return StringView(strings[row % strings.size()]); }),
+  }));
+  for (const auto& flags : kAllFlags) {
+    testSort(rows, {flags, flags}, 24, 1);
+  }
+}
+
+TEST_F(PrefixSortTest, unsupportedKey) {
+  constexpr int32_t kNumRows = 200;
+  std::vector<std::vector<int64_t>> arrays;
+  for (auto i = 0; i < kNumRows; ++i) {
+    arrays.push_back({i % 3, i % 7});
+  }
+  auto rows = store(makeRowVector({
+      makeArrayVector<int64_t>(arrays),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 5; }),
+  }));
+  testSort(rows, {{}, {}}, 0, 0);
+
+  rows = store(makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row % 5; }),
+      makeArrayVector<int64_t>(arrays),
+  }));
+  testSort(rows, {{}, {}}, 16, 1);
+}
+
+TEST_F(PrefixSortTest, parallel) {
+  const int32_t kNumRows = 5 * PrefixSort::kMinRowsPerThread + 11;
+  auto rows = store(makeRowVector({
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return (row * 7'919) % 1'000; }),
+      makeFlatVector<StringView>(
+          kNumRows,
+          [](auto row) {
+            return StringView::makeInline(std::to_string(row % 97));
+          }),
+  }));
+  testSort(rows, {{}, {}}, 32, 1);
+  testSort(rows, {{true, false, false, false}, {}}, 32, 1);
+}
+
+TEST_F(PrefixSortTest, fewRows) {
+  auto rows = store(makeRowVector({
+      makeFlatVector<int64_t>({3, 1, 2, 1}),
+  }));
+  testSort(rows, {{}}, 16, 1);
+}
+} // namespace
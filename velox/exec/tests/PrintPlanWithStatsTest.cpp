@@ -164,6 +164,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"        hashtable.capacity\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        hashtable.numDistinct\\s+sum: 100, count: 1, min: 100, max: 100"},
        {"        hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
+       {"        hashtable.rehashTime\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        queuedWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"        rangeKey0\\s+sum: 200, count: 1, min: 200, max: 200"},
        {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
@@ -190,6 +191,8 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          dynamicFiltersAccepted[ ]* sum: 1, count: 1, min: 1, max: 1"},
        {"          ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
        {"          localReadBytes      [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+       {"          numCoalescedRead    [ ]* sum: .+, count: 1, min: .+, max: .+"},
+       {"          numCoalescedRequests[ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numLocalRead        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          numPrefetch         [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          numRamRead          [ ]* sum: 40, count: 1, min: 40, max: 40"},
@@ -207,6 +210,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedLazyRows     [ ]* sum: .+, count: 1, min: .+, max: .+"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
@@ -271,15 +275,21 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"      hashtable.numDistinct\\s+sum: 835, count: 1, min: 835, max: 835"},
          {"      hashtable.numRehashes\\s+sum: 1, count: 1, min: 1, max: 1"},
          {"      hashtable.numTombstones\\s+sum: 0, count: 1, min: 0, max: 0"},
+         {"      hashtable.rehashTime\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      loadedToValueHook\\s+sum: 50000, count: 5, min: 10000, max: 10000"},
          {"      runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"      runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      stringAllocator.freeBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      stringAllocator.numFreeBlocks\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"      stringAllocator.retainedBytes\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"  -- TableScan\\[table: hive_table\\] -> c0:BIGINT, c1:INTEGER, c2:SMALLINT, c3:REAL, c4:DOUBLE, c5:VARCHAR"},
          {"     Input: 10000 rows \\(.+\\), Output: 10000 rows \\(.+\\), Cpu time: .+, Blocked wall time: .+, Peak memory: .+, Memory allocations: .+, Threads: 1, Splits: 1"},
          {"        dataSourceWallNanos[ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        ioWaitNanos      [ ]* sum: .+, count: .+ min: .+, max: .+"},
          {"        localReadBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
+         {"        numCoalescedRead [ ]* sum: .+, count: 1, min: .+, max: .+"},
+         {"        numCoalescedRequests[ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        numLocalRead     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        numPrefetch      [ ]* sum: .+, count: .+, min: .+, max: .+"},
          {"        numRamRead       [ ]* sum: 6, count: 1, min: 6, max: 6"},
@@ -298,6 +308,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedLazyRows  [ ]* sum: .+, count: 1, min: .+, max: .+"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
@@ -305,3 +316,41 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        totalScanTime    [ ]* sum: .+, count: .+, min: .+, max: .+"}});
   }
 }
+
+TEST_F(PrintPlanWithStatsTest, expressionStats) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [](auto row) { return row; }, nullEvery(10))}));
+  }
+
+  core::PlanNodeId projectId;
+  auto op = PlanBuilder()
+                .values(vectors)
+                .project({"c0 + 1"})
+                .capturePlanNodeId(projectId)
+                .planNode();
+
+  std::vector<RowVectorPtr> expected;
+  for (auto i = 0; i < vectors.size(); ++i) {
+    expected.push_back(makeRowVector({makeFlatVector<int64_t>(
+        1'000, [](auto row) { return row + 1; }, nullEvery(10))}));
+  }
+  auto task = AssertQueryBuilder(op)
+                  .config(core::QueryConfig::kExprTrackCpuUsage, "true")
+                  .assertResults(expected);
+  ensureTaskCompletion(task.get());
+
+  auto planStats = exec::toPlanStats(task->taskStats());
+  const auto& stats = planStats.at(projectId).expressionStats.at("plus");
+  EXPECT_EQ(9'000, stats.numProcessedRows);
+  EXPECT_EQ(10, stats.numProcessedVectors);
+  EXPECT_EQ(1'000, stats.numNullRows);
+
+  ASSERT_TRUE(RE2::PartialMatch(
+      printPlanWithStats(*op, task->taskStats(), true),
+      "\n      expr plus: Cpu time: .+, Rows: 9000, Batches: 10, "
+      "Null rows: 1000, Peeled batches: 0"));
+  ASSERT_FALSE(RE2::PartialMatch(
+      printPlanWithStats(*op, task->taskStats()), "expr plus"));
+}
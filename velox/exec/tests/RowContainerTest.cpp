@@ -1053,3 +1053,58 @@ TEST_F(RowContainerTest, probedFlag) {
           {true, true, true, true, std::nullopt, true}),
       result);
 }
+
+TEST_F(RowContainerTest, serializedRows) {
+  // A long string is stored out of line in 'stringAllocator_', possibly in
+  // several pieces.
+  const std::string longString(100'000, 'x');
+  auto input = makeRowVector({
+      makeNullableFlatVector<int64_t>({1, std::nullopt, 3, 4, 5}),
+      makeNullableFlatVector<std::string>(
+          {"short", "a string of more than 12 bytes", std::nullopt, "", "z"}),
+      makeNullableArrayVector<int32_t>(
+          {{{1, 2, 3, 4, 5, 6, 7}}, {{}}, std::nullopt, {{1}}, {{2, 3}}}),
+      makeFlatVector<std::string>(
+          {longString, "b", "also out of line in the container", "d", "e"}),
+  });
+  const auto size = input->size();
+  auto source = makeRowContainer(
+      {BIGINT(), VARCHAR()}, {ARRAY(INTEGER()), VARCHAR()}, false);
+  std::vector<char*> rows(size);
+  std::vector<DecodedVector> decoded(input->childrenSize());
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    decoded[column].decode(*input->childAt(column));
+  }
+  for (auto i = 0; i < size; ++i) {
+    rows[i] = source->newRow();
+    for (auto column = 0; column < decoded.size(); ++column) {
+      source->store(decoded[column], i, rows[i], column);
+    }
+  }
+
+  auto serialized = BaseVector::create(VARBINARY(), 0, pool());
+  source->extractSerializedRows(folly::Range(rows.data(), size), serialized);
+  ASSERT_EQ(size, serialized->size());
+  for (auto i = 0; i < size; ++i) {
+    EXPECT_EQ(
+        source->serializedRowSize(rows[i]),
+        serialized->asFlatVector<StringView>()->valueAt(i).size());
+  }
+  // The serialized rows do not depend on the source container.
+  source.reset();
+
+  auto target = makeRowContainer(
+      {BIGINT(), VARCHAR()}, {ARRAY(INTEGER()), VARCHAR()}, false);
+  std::vector<char*> restored(size);
+  for (auto i = 0; i < size; ++i) {
+    restored[i] = target->newRow();
+    target->storeSerializedRow(
+        *serialized->asFlatVector<StringView>(), i, restored[i]);
+  }
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    testExtractColumn(*target, restored, column, input->childAt(column));
+  }
+  checkSizes(restored, *target);
+  target->eraseRows(folly::Range(restored.data(), size));
+  EXPECT_EQ(0, target->numRows());
+}
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 namespace facebook::velox::exec::test {
 
@@ -103,4 +106,50 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, spill) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 97; }),
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+
+  createDuckDbTable(data);
+
+  auto testSpill = [&](std::optional<int32_t> limit) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit.value_or(-1)));
+    auto spillDirectory = TempDirectoryPath::create();
+    core::PlanNodeId rowNumberId;
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .rowNumber({"c0"}, limit)
+                    .capturePlanNodeId(rowNumberId)
+                    .planNode();
+    // NOTE: the row numbers follow the input order within each partition,
+    // which is the order of c1.
+    auto sql =
+        "SELECT * FROM (SELECT *, row_number() over (partition by c0 order by c1) as rn FROM tmp) ";
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kRowNumberSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(
+                limit.has_value()
+                    ? fmt::format("{} WHERE rn <= {}", sql, limit.value())
+                    : std::string(sql));
+    const auto stats = toPlanStats(task->taskStats()).at(rowNumberId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  };
+
+  testSpill(std::nullopt);
+  testSpill(1);
+  testSpill(50);
+}
+
 } // namespace facebook::velox::exec::test
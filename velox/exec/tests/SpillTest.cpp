@@ -14,10 +14,12 @@
  * limitations under the License.
  */
 #include "velox/exec/Spill.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -89,7 +91,8 @@ class SpillTest : public testing::Test,
       int numBatches,
       int numRowsPerBatch = 1000,
       int numDuplicates = 1,
-      const std::vector<CompareFlags>& compareFlags = {}) {
+      const std::vector<CompareFlags>& compareFlags = {},
+      const SpillCodecOptions& codecOptions = {}) {
     ASSERT_TRUE(compareFlags.empty() || compareFlags.size() == 1);
     ASSERT_EQ(numBatches % 2, 0);
 
@@ -144,7 +147,13 @@ class SpillTest : public testing::Test,
     // the batch number of the vector in the partition. When read back, both
     // partitions produce an ascending sequence of integers without gaps.
     state_ = std::make_unique<SpillState>(
-        spillPath_, numPartitions, 1, compareFlags, targetFileSize, *pool());
+        spillPath_,
+        numPartitions,
+        1,
+        compareFlags,
+        targetFileSize,
+        *pool(),
+        codecOptions);
     EXPECT_EQ(targetFileSize, state_->targetFileSize());
     EXPECT_EQ(numPartitions, state_->maxPartitions());
     EXPECT_EQ(0, state_->spilledPartitions());
@@ -227,7 +236,8 @@ class SpillTest : public testing::Test,
       int numBatches,
       int numDuplicates,
       const std::vector<CompareFlags>& compareFlags,
-      uint64_t expectedNumSpilledFiles) {
+      uint64_t expectedNumSpilledFiles,
+      const SpillCodecOptions& codecOptions = {}) {
     const int numRowsPerBatch = 20'000;
     SCOPED_TRACE(fmt::format(
         "targetFileSize: {}, numPartitions: {}, numBatches: {}, numDuplicates: {}, nullsFirst: {}, ascending: {}",
@@ -243,7 +253,8 @@ class SpillTest : public testing::Test,
         numBatches,
         numRowsPerBatch,
         numDuplicates,
-        compareFlags);
+        compareFlags,
+        codecOptions);
 
     ASSERT_EQ(expectedNumSpilledFiles, state_->spilledFiles());
     std::vector<std::string> spilledFiles = state_->testingSpilledFilePaths();
@@ -337,6 +348,24 @@ TEST_F(SpillTest, spillState) {
   spillStateTest(kGB, 2, 10, 10, {}, 10);
 }
 
+TEST_F(SpillTest, spillStateWithCodec) {
+  const std::vector<SpillCodecOptions> codecOptionsList = {
+      {folly::io::CodecType::NO_COMPRESSION, true},
+      {folly::io::CodecType::ZSTD, false},
+      {folly::io::CodecType::ZSTD, true}};
+  for (const auto& codecOptions : codecOptionsList) {
+    SCOPED_TRACE(fmt::format(
+        "compression: {}, checksum: {}",
+        static_cast<int>(codecOptions.compressionKind),
+        codecOptions.checksumEnabled));
+    if (!folly::io::hasCodec(codecOptions.compressionKind)) {
+      continue;
+    }
+    spillStateTest(kGB, 2, 10, 1, {CompareFlags{true, true}}, 10, codecOptions);
+    spillStateTest(1, 2, 10, 10, {}, 10 * 2, codecOptions);
+  }
+}
+
 TEST_F(SpillTest, spillTimestamp) {
   // Verify that timestamp type retains it nanosecond precision when spilled and
   // read back.
@@ -372,6 +401,146 @@ TEST_F(SpillTest, spillTimestamp) {
   ASSERT_EQ(nullptr, merge->next());
 }
 
+TEST_F(SpillTest, spillTiers) {
+  auto localDirectory = exec::test::TempDirectoryPath::create();
+  auto overflowDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  auto tiers = std::make_shared<SpillTiers>(
+      localDirectory->path, overflowDirectory->path, 1, 0);
+  // A target file size of 1 starts a new file on each append. The first file
+  // fills the local tier and the following ones go to the overflow tier.
+  SpillState state(
+      localDirectory->path + "/test",
+      1,
+      1,
+      emptyCompareFlags,
+      1,
+      *pool(),
+      {},
+      tiers);
+  const int32_t kNumBatches = 3;
+  state.setPartitionSpilled(0);
+  for (auto i = 0; i < kNumBatches; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>({i * 2, i * 2 + 1})}));
+  }
+  state.finishWrite(0);
+
+  const auto paths = state.testingSpilledFilePaths();
+  ASSERT_EQ(paths.size(), kNumBatches);
+  ASSERT_EQ(paths[0].find(localDirectory->path), 0);
+  for (auto i = 1; i < kNumBatches; ++i) {
+    ASSERT_EQ(paths[i].find(overflowDirectory->path), 0) << paths[i];
+  }
+  ASSERT_GT(tiers->bytes(SpillTiers::Tier::kLocal), 0);
+  ASSERT_GT(
+      tiers->bytes(SpillTiers::Tier::kOverflow),
+      tiers->bytes(SpillTiers::Tier::kLocal));
+  ASSERT_EQ(
+      tiers->bytes(SpillTiers::Tier::kLocal) +
+          tiers->bytes(SpillTiers::Tier::kOverflow),
+      state.spilledBytes());
+
+  auto merge = state.startMerge(0, nullptr);
+  ASSERT_EQ(
+      stats_["spillLocalBytes"].sum, tiers->bytes(SpillTiers::Tier::kLocal));
+  ASSERT_EQ(
+      stats_["spillOverflowBytes"].sum,
+      tiers->bytes(SpillTiers::Tier::kOverflow));
+  for (auto i = 0; i < kNumBatches * 2; ++i) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+
+  // A spill quota smaller than a spilled page fails the spill.
+  auto limitedTiers =
+      std::make_shared<SpillTiers>(localDirectory->path, "", 0, 1);
+  SpillState limitedState(
+      localDirectory->path + "/limited",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      *pool(),
+      {},
+      limitedTiers);
+  limitedState.setPartitionSpilled(0);
+  VELOX_ASSERT_THROW(
+      limitedState.appendToPartition(
+          0, makeRowVector({makeFlatVector<int64_t>({1, 2})})),
+      "exceeds the spill limit");
+}
+
+TEST_F(SpillTest, spillReadAhead) {
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  // Each run is larger than the 1MB read buffer, so it is read in several
+  // pieces, each read ahead on 'executor'.
+  const int32_t kNumRuns = 3;
+  const int32_t kRowsPerBatch = 50'000;
+  const int32_t kBatchesPerRun = 4;
+  auto makeState = [&](const std::string& name) {
+    auto state = std::make_unique<SpillState>(
+        tempDirectory->path + "/" + name,
+        1,
+        1,
+        emptyCompareFlags,
+        kGB,
+        *pool());
+    state->setPartitionSpilled(0);
+    for (auto run = 0; run < kNumRuns; ++run) {
+      for (auto batch = 0; batch < kBatchesPerRun; ++batch) {
+        state->appendToPartition(
+            0,
+            makeRowVector({makeFlatVector<int64_t>(
+                kRowsPerBatch, [&](auto row) {
+                  return ((batch * kRowsPerBatch) + row) * kNumRuns + run;
+                })}));
+      }
+      state->finishWrite(0);
+    }
+    return state;
+  };
+  const int64_t kNumRows = kNumRuns * kBatchesPerRun * kRowsPerBatch;
+
+  auto mergeState = makeState("merge");
+  auto merge = mergeState->startMerge(0, nullptr, executor.get());
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+
+  auto readerState = makeState("reader");
+  SpillPartition partition(SpillPartitionId(0, 0), readerState->files(0));
+  auto reader = partition.createReader(executor.get());
+  int64_t sum = 0;
+  int64_t numRows = 0;
+  RowVectorPtr batch;
+  while (reader->nextBatch(batch)) {
+    auto* values = batch->childAt(0)->asFlatVector<int64_t>();
+    for (auto i = 0; i < batch->size(); ++i) {
+      sum += values->valueAt(i);
+    }
+    numRows += batch->size();
+  }
+  ASSERT_EQ(kNumRows, numRows);
+  ASSERT_EQ(kNumRows * (kNumRows - 1) / 2, sum);
+
+  // A stream destroyed before the end of its file waits for its read-ahead.
+  auto abandonedState = makeState("abandoned");
+  auto abandoned = abandonedState->startMerge(0, nullptr, executor.get());
+  ASSERT_NE(nullptr, abandoned->next());
+  abandoned.reset();
+  executor->join();
+}
+
 TEST_F(SpillTest, spillStateWithSmallTargetFileSize) {
   // Set the target file size to a small value to open a new file on each batch
   // write.
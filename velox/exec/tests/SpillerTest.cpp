@@ -153,6 +153,13 @@ class SpillerTest : public exec::test::RowContainerTestBase {
   }
 
  protected:
+  // kHashJoinProbe and kPartitionedInput spillers append vectors to the spill
+  // files directly.
+  bool hasRowContainer() const {
+    return type_ != Spiller::Type::kHashJoinProbe &&
+        type_ != Spiller::Type::kPartitionedInput;
+  }
+
   void testSortedSpill(
       int32_t spillPct,
       int numDuplicates,
@@ -263,7 +270,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
     // spilling will be tested separately.
     rowContainer_ = makeRowContainer(keys, dependents, false);
 
-    if (numRows == 0 || type_ == Spiller::Type::kHashJoinProbe) {
+    if (numRows == 0 || !hasRowContainer()) {
       return;
     }
     const SelectivityVector allRows(numRows);
@@ -395,8 +402,9 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       bool makeError) {
     stats_.clear();
 
-    if (type_ == Spiller::Type::kHashJoinProbe) {
-      // kHashJoinProbe doesn't have associated row container.
+    if (!hasRowContainer()) {
+      // kHashJoinProbe and kPartitionedInput don't have associated row
+      // container.
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowType_,
@@ -600,9 +608,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       int numBatchRows,
       int numAppendBatches,
       int targetFileSize) {
-    ASSERT_TRUE(
-        type_ == Spiller::Type::kHashJoinBuild ||
-        type_ == Spiller::Type::kHashJoinProbe);
+    ASSERT_TRUE(type_ == Spiller::Type::kHashJoinBuild || !hasRowContainer());
 
     const int numSpillPartitions =
         1 + folly::Random().rand32() % numPartitions_;
@@ -643,7 +649,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       splitByPartition(rowVector_, spillHashFunction, inputsByPartition);
 
       std::vector<Spiller::SpillableStats> statsList;
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (!hasRowContainer()) {
         spiller_->setPartitionsSpilled(spillPartitionNumSet);
 #ifndef NDEBUG
         ASSERT_ANY_THROW(spiller_->setPartitionsSpilled(spillPartitionNumSet));
@@ -688,9 +694,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       std::vector<std::unique_ptr<Spiller>> spillers,
       const SpillPartitionNumSet& spillPartitionNumSet,
       const std::vector<std::vector<RowVectorPtr>>& inputsByPartition) {
-    ASSERT_TRUE(
-        type_ == Spiller::Type::kHashJoinBuild ||
-        type_ == Spiller::Type::kHashJoinProbe);
+    ASSERT_TRUE(type_ == Spiller::Type::kHashJoinBuild || !hasRowContainer());
 
     SpillPartitionSet spillPartitionSet;
     for (auto& spiller : spillers) {
@@ -705,7 +709,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_EQ(
           hashBits_.begin(), spillPartitionEntry.first.partitionBitOffset());
       auto reader = spillPartitionEntry.second->createReader();
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (!hasRowContainer()) {
         // For hash probe type, we append each input vector as one batch in
         // spill file so that we can do one-to-one comparison.
         for (int i = 0; i < inputsByPartition[partition].size(); ++i) {
@@ -757,9 +761,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
   void verifyNonSortedSpillData(
       const SpillPartitionNumSet& spillPartitionNumSet,
       const std::vector<std::vector<RowVectorPtr>>& inputsByPartition) {
-    ASSERT_TRUE(
-        type_ == Spiller::Type::kHashJoinBuild ||
-        type_ == Spiller::Type::kHashJoinProbe);
+    ASSERT_TRUE(type_ == Spiller::Type::kHashJoinBuild || !hasRowContainer());
 
     SpillPartitionSet spillPartitionSet;
     spiller_->finishSpill(spillPartitionSet);
@@ -772,7 +774,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
       ASSERT_EQ(
           hashBits_.begin(), spillPartitionEntry.first.partitionBitOffset());
       auto reader = spillPartitionEntry.second->createReader();
-      if (type_ == Spiller::Type::kHashJoinProbe) {
+      if (!hasRowContainer()) {
         // For hash probe type, we append each input vector as one batch in
         // spill file so that we can do one-to-one comparison.
         for (int i = 0; i < inputsByPartition[partition].size(); ++i) {
@@ -885,7 +887,9 @@ class NoHashJoin : public SpillerTest,
   static std::vector<TestParam> getTestParams() {
     return TestParamsBuilder{
         .typesToExclude =
-            {Spiller::Type::kHashJoinProbe, Spiller::Type::kHashJoinBuild}}
+            {Spiller::Type::kHashJoinProbe,
+             Spiller::Type::kHashJoinBuild,
+             Spiller::Type::kPartitionedInput}}
         .getTestParams();
   }
 };
@@ -900,6 +904,7 @@ class NoHashJoinNoOrderBy : public SpillerTest,
         .typesToExclude =
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
+             Spiller::Type::kPartitionedInput,
              Spiller::Type::kOrderBy}}
         .getTestParams();
   }
@@ -948,6 +953,31 @@ TEST_P(NoHashJoin, error) {
   testSortedSpill(100, 1, 0, true);
 }
 
+TEST_P(NoHashJoin, spillRows) {
+  constexpr int32_t kNumRows = 5'000;
+  setupSpillData(rowType_, numKeys_, kNumRows, 1, [&](RowVectorPtr rows) {
+    // Set ordinal so that the sorted order is unambiguous.
+    setSequentialValue(rows, 5);
+  });
+  sortSpillData();
+  setupSpiller(2'000'000, 0, false);
+
+  // Spill the second half of the rows as if the first half had been returned
+  // as output.
+  const int32_t numSpillRows = kNumRows / 2;
+  spiller_->spillRows(folly::Range<char**>(
+      rows_.data() + kNumRows - numSpillRows, numSpillRows));
+  ASSERT_TRUE(spiller_->isAnySpilled());
+  ASSERT_EQ(rowContainer_->numRows(), kNumRows - numSpillRows);
+  ASSERT_EQ(spiller_->stats().spilledRows, numSpillRows);
+
+  // The rows left in the container are merged with the spilled ones from the
+  // spilled partitions.
+  spiller_->finishSpill();
+  ASSERT_ANY_THROW(spiller_->spillRows(folly::Range<char**>(rows_.data(), 1)));
+  verifySortedSpillData();
+}
+
 TEST_P(NoHashJoinNoOrderBy, spillWithEmptyPartitions) {
   // kOrderBy type which has only one partition which is not relevant for this
   // test.
@@ -1221,6 +1251,7 @@ class HashJoinBuildOnly : public SpillerTest,
         .typesToExclude =
             {Spiller::Type::kAggregate,
              Spiller::Type::kHashJoinProbe,
+             Spiller::Type::kPartitionedInput,
              Spiller::Type::kOrderBy}}
         .getTestParams();
   }
@@ -367,6 +367,71 @@ TEST_F(TableScanTest, subfieldPruningRowType) {
   }
 }
 
+TEST_F(TableScanTest, subfieldPruningDeepRowType) {
+  auto leafType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
+  auto wideType = ROW({"w0", "w1", "w2"}, {leafType, leafType, VARCHAR()});
+  auto innerType = ROW({"x", "y"}, {leafType, wideType});
+  auto columnType = ROW({"c", "d"}, {innerType, wideType});
+  auto rowType = ROW({"e"}, {columnType});
+  auto vectors = makeVectors(10, 1'000, rowType);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  std::vector<common::Subfield> requiredSubfields;
+  requiredSubfields.emplace_back("e.c.x.a");
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignments;
+  assignments["e"] = std::make_shared<HiveColumnHandle>(
+      "e",
+      HiveColumnHandle::ColumnType::kRegular,
+      columnType,
+      columnType,
+      std::move(requiredSubfields));
+  auto op = PlanBuilder()
+                .tableScan(rowType, makeTableHandle(), assignments)
+                .planNode();
+  auto split = makeHiveConnectorSplit(filePath->path);
+  auto result = AssertQueryBuilder(op).split(split).copyResults(pool());
+  ASSERT_EQ(result->size(), 10'000);
+  auto e = result->as<RowVector>()->childAt(0)->as<RowVector>();
+  ASSERT_TRUE(e);
+  ASSERT_EQ(e->childrenSize(), 2);
+  auto c = e->childAt(0)->as<RowVector>();
+  ASSERT_TRUE(c);
+  ASSERT_EQ(c->childrenSize(), 2);
+  auto x = c->childAt(0)->as<RowVector>();
+  ASSERT_TRUE(x);
+  ASSERT_EQ(x->childrenSize(), 2);
+  auto a = x->childAt(0);
+  int j = 0;
+  for (auto& vec : vectors) {
+    auto ee = vec->childAt(0)->as<RowVector>();
+    auto cc = ee->childAt(0)->as<RowVector>();
+    auto xx = cc->childAt(0)->as<RowVector>();
+    auto aa = xx->childAt(0);
+    for (int i = 0; i < vec->size(); ++i) {
+      if (ee->isNullAt(i) || cc->isNullAt(i) || xx->isNullAt(i) ||
+          aa->isNullAt(i)) {
+        ASSERT_TRUE(
+            e->isNullAt(j) || c->isNullAt(j) || x->isNullAt(j) ||
+            a->isNullAt(j));
+      } else {
+        ASSERT_TRUE(aa->equalValueAt(a.get(), i, j));
+      }
+      ++j;
+    }
+  }
+  ASSERT_EQ(j, result->size());
+  // The pruned fields at every level are null.
+  for (const auto& pruned : {e->childAt(1), c->childAt(1), x->childAt(1)}) {
+    ASSERT_EQ(pruned->size(), result->size());
+    for (int i = 0; i < pruned->size(); ++i) {
+      ASSERT_TRUE(
+          e->isNullAt(i) || c->isNullAt(i) || x->isNullAt(i) ||
+          pruned->isNullAt(i));
+    }
+  }
+}
+
 TEST_F(TableScanTest, subfieldPruningRemainingFilterSubfieldsMissing) {
   auto columnType = ROW({"a", "b", "c"}, {BIGINT(), BIGINT(), BIGINT()});
   auto rowType = ROW({"e"}, {columnType});
@@ -676,6 +741,32 @@ TEST_F(TableScanTest, constDictLazy) {
   assertQuery(op, {filePath}, "SELECT 2 FROM tmp WHERE c0 = 5");
 }
 
+TEST_F(TableScanTest, runLengthEncodedColumns) {
+  vector_size_t size = 10'000;
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(size, [](auto row) { return row / 100; }),
+       makeFlatVector<std::string>(
+           size, [](auto row) { return fmt::format("s{}", row / 1'000); }),
+       makeFlatVector<int64_t>(
+           size, [](auto row) { return row; }, nullEvery(7))});
+
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, {rowVector});
+  createDuckDbTable({rowVector});
+
+  auto rowType = asRowType(rowVector->type());
+  auto op = PlanBuilder()
+                .tableScan(rowType, {}, "c0 % 3 = 1")
+                .project({"c0 * 2", "concat(c1, 'x')", "c2 + 1"})
+                .planNode();
+  AssertQueryBuilder(op, duckDbQueryRunner_)
+      .split(makeHiveConnectorSplit(filePath->path))
+      .connectorConfig(
+          kHiveConnectorId, HiveConfig::kMinAverageRunLength, "10")
+      .assertResults(
+          "SELECT c0 * 2, concat(c1, 'x'), c2 + 1 FROM tmp WHERE c0 % 3 = 1");
+}
+
 TEST_F(TableScanTest, count) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -699,6 +790,102 @@ TEST_F(TableScanTest, count) {
   EXPECT_EQ(numRead, 10'000);
 }
 
+TEST_F(TableScanTest, countFromMetadata) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits = {
+      HiveConnectorSplitBuilder(filePath->path)
+          .partitionKey("ds", "2023-01-01")
+          .build(),
+      HiveConnectorSplitBuilder(filePath->path)
+          .partitionKey("ds", "2023-01-02")
+          .build()};
+
+  // count(*) with a filter on the partition key takes the row count from the
+  // footer.
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      ROW({}, {}),
+                      makeTableHandle(SubfieldFiltersBuilder()
+                                          .add("ds", equal("2023-01-01"))
+                                          .build()),
+                      assignments)
+                  .singleAggregation({}, {"count(1)"})
+                  .planNode();
+  auto task = assertQuery(plan, splits, "SELECT count(*) FROM tmp");
+  EXPECT_EQ(getTableScanRuntimeStats(task)["metadataOnlySplits"].sum, 1);
+  EXPECT_EQ(getSkippedSplitsStat(task), 1);
+
+  // A filter on a data column needs the data.
+  plan = PlanBuilder()
+             .tableScan(
+                 ROW({}, {}),
+                 makeTableHandle(SubfieldFiltersBuilder()
+                                     .add("c0", greaterThan(0))
+                                     .build()),
+                 assignments)
+             .singleAggregation({}, {"count(1)"})
+             .planNode();
+  splits.pop_back();
+  task = assertQuery(plan, splits, "SELECT count(*) FROM tmp WHERE c0 > 0");
+  EXPECT_EQ(getTableScanRuntimeStats(task)["metadataOnlySplits"].sum, 0);
+}
+
+TEST_F(TableScanTest, remoteDynamicFilters) {
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row % 7; }),
+  });
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, {vector});
+
+  CursorParameters params;
+  params.planNode = tableScanNode(asRowType(vector->type()));
+  auto cursor = std::make_unique<TaskCursor>(params);
+  const auto scanNodeId = params.planNode->id();
+
+  VELOX_ASSERT_THROW(
+      cursor->task()->addRemoteDynamicFilters(
+          scanNodeId,
+          folly::dynamic::object(
+              "c9", common::BigintRange(0, 10, false).serialize())),
+      "Column c9 not found in the output of table scan");
+
+  // Filters as sent by the hash join builds of two other tasks.
+  cursor->task()->addRemoteDynamicFilters(
+      scanNodeId,
+      folly::dynamic::object(
+          "c0", common::BigintRange(100, 999, false).serialize()));
+  cursor->task()->addRemoteDynamicFilters(
+      scanNodeId,
+      folly::dynamic::object(
+          "c1", common::BigintRange(0, 0, false).serialize()));
+
+  cursor->task()->addSplit(scanNodeId, makeHiveSplit(filePath->path));
+  cursor->task()->noMoreSplits(scanNodeId);
+
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    auto result = cursor->current()->as<RowVector>();
+    auto c0 = result->childAt(0)->asFlatVector<int64_t>();
+    auto c1 = result->childAt(1)->asFlatVector<int32_t>();
+    for (auto i = 0; i < result->size(); ++i) {
+      ASSERT_GE(c0->valueAt(i), 100);
+      ASSERT_LE(c0->valueAt(i), 999);
+      ASSERT_EQ(c1->valueAt(i), 0);
+    }
+    numRead += result->size();
+  }
+  // Multiples of 7 in [100, 999].
+  EXPECT_EQ(numRead, 128);
+}
+
 TEST_F(TableScanTest, batchSize) {
   // Make a wide row of many BIGINT columns to ensure that row size is
   // larger than 1KB.
@@ -878,6 +1065,10 @@ TEST_F(TableScanTest, multipleSplits) {
     auto stats = getTableScanRuntimeStats(task);
     if (numPrefetchSplit != 0) {
       ASSERT_GT(stats.at("preloadedSplits").sum, 10);
+      ASSERT_GE(stats.at("splitPreloadDepth").min, numPrefetchSplit);
+      ASSERT_LE(
+          stats.at("splitPreloadDepth").max,
+          FLAGS_split_preload_max_per_driver);
     } else {
       ASSERT_EQ(stats.count("preloadedSplits"), 0);
     }
@@ -925,6 +1116,102 @@ TEST_F(TableScanTest, splitOffsetAndLength) {
       "SELECT * FROM tmp LIMIT 0");
 }
 
+TEST_F(TableScanTest, divideLargeSplit) {
+  // A tiny stripe size makes a stripe of each vector.
+  auto vectors = makeVectors(20, 1'000);
+  auto filePath = TempFilePath::create();
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::STRIPE_SIZE, 1UL);
+  writeToFile(filePath->path, vectors, config);
+  createDuckDbTable(vectors);
+  const auto fileSize = fs::file_size(filePath->path);
+
+  for (const uint64_t pieceSize : {0UL, fileSize / 8, fileSize / 2}) {
+    SCOPED_TRACE(fmt::format("pieceSize {}", pieceSize));
+    auto task = AssertQueryBuilder(tableScanNode(), duckDbQueryRunner_)
+                    .maxDrivers(4)
+                    .config(
+                        core::QueryConfig::kTableScanSplitPieceSize,
+                        folly::to<std::string>(pieceSize))
+                    .split(makeHiveConnectorSplit(filePath->path, 0, fileSize))
+                    .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    if (pieceSize == 0) {
+      ASSERT_EQ(stats.count("dividedSplits"), 0);
+    } else {
+      ASSERT_EQ(stats.at("dividedSplits").sum, 1);
+      ASSERT_EQ(stats.at("splitPieces").sum, fileSize / pieceSize);
+    }
+    ASSERT_EQ(task->taskStats().numFinishedSplits, 1);
+  }
+}
+
+TEST_F(TableScanTest, largestSplitFirst) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  const std::vector<int32_t> numRows = {100, 3'000, 1'000, 2'000};
+  auto filePaths = makeFilePaths(numRows.size());
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  // File size and file index.
+  std::vector<std::pair<uint64_t, int32_t>> sizes;
+  for (auto i = 0; i < numRows.size(); ++i) {
+    writeToFile(
+        filePaths[i]->path,
+        makeRowVector({makeFlatVector<int64_t>(numRows[i], [&](auto row) {
+          return i * 1'000'000 + row * 7'919 % 1'000;
+        })}));
+    const auto size = fs::file_size(filePaths[i]->path);
+    splits.push_back(makeHiveConnectorSplit(filePaths[i]->path, 0, size));
+    sizes.emplace_back(size, i);
+  }
+  std::sort(sizes.rbegin(), sizes.rend());
+
+  auto result =
+      AssertQueryBuilder(tableScanNode(rowType))
+          .config(core::QueryConfig::kTableScanLargestSplitFirst, "true")
+          .splits(splits)
+          .copyResults(pool());
+  // The only driver reads the files in decreasing order of size.
+  auto* c0 = result->childAt(0)->asFlatVector<int64_t>();
+  ASSERT_EQ(result->size(), 6'100);
+  vector_size_t row = 0;
+  for (const auto& [size, i] : sizes) {
+    for (auto j = 0; j < numRows[i]; ++j, ++row) {
+      ASSERT_EQ(c0->valueAt(row) / 1'000'000, i);
+    }
+  }
+}
+
+TEST_F(TableScanTest, adaptiveDrivers) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+
+  CursorParameters params;
+  params.planNode = tableScanNode();
+  params.maxDrivers = 4;
+  auto cursor = std::make_unique<TaskCursor>(params);
+  auto task = cursor->task();
+  task->queryCtx()->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kTableScanAdaptiveDriversEnabled, "true"}});
+  // No splits are queued at start, so only one Driver runs.
+  cursor->start();
+  EXPECT_EQ(task->taskStats().numDeferredDrivers, 3);
+
+  for (const auto& filePath : filePaths) {
+    task->addSplit("0", makeHiveSplit(filePath->path));
+  }
+  task->noMoreSplits("0");
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(numRead, 10'000);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  EXPECT_LE(task->taskStats().numDeferredDriversStartedForSplits, 3);
+}
+
 TEST_F(TableScanTest, fileNotFound) {
   CursorParameters params;
   params.planNode = tableScanNode();
@@ -2123,6 +2410,24 @@ TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   EXPECT_EQ(skippedStrides.sum, 1);
 }
 
+TEST_F(TableScanTest, remainingFilterSkippedLazyRows) {
+  auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+       makeFlatVector<int64_t>(1'000, [](auto row) { return row * 2; })})};
+  auto filePaths = makeFilePaths(1);
+  writeToFile(filePaths[0]->path, vectors);
+  createDuckDbTable(vectors);
+
+  // c1 is only projected, so it is loaded lazily for the rows that pass the
+  // remaining filter on c0.
+  auto task = assertQuery(
+      PlanBuilder().tableScan(rowType, {}, "c0 % 4 = 0").planNode(),
+      filePaths,
+      "SELECT * FROM tmp WHERE c0 % 4 = 0");
+  EXPECT_EQ(getTableScanRuntimeStats(task)["skippedLazyRows"].sum, 750);
+}
+
 /// Test the handling of constant remaining filter results which occur when
 /// filter input is a dictionary vector with all indices being the same (i.e.
 /// DictionaryVector::isConstant() == true).
@@ -2231,6 +2536,26 @@ TEST_F(TableScanTest, aggregationPushdown) {
   // 5 aggregates processing 10K rows each via pushdown.
   EXPECT_EQ(5 * 10'000, loadedToValueHook(task, 1));
 
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation(
+               {"c5"},
+               {"count(c0)",
+                "count(c1)",
+                "count(c2)",
+                "count(c3)",
+                "count(c4)",
+                "count(c6)"})
+           .planNode();
+
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT c5, count(c0), count(c1), count(c2), count(c3), count(c4), "
+      "count(c6) FROM tmp group by c5");
+  // 6 aggregates processing 10K rows each via pushdown.
+  EXPECT_EQ(6 * 10'000, loadedToValueHook(task, 1));
+
   // Pushdown should also happen if there is a FilterProject node that doesn't
   // touch columns being aggregated
   op = PlanBuilder()
@@ -2550,3 +2875,41 @@ TEST_F(TableScanTest, parallelPrepare) {
   }
   AssertQueryBuilder(plan).splits(splits).copyResults(pool_.get());
 }
+
+TEST_F(TableScanTest, topNThresholdPushdown) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), INTEGER()});
+  auto filePaths = makeFilePaths(10);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [i](auto row) { return i * 1'000 + row; }),
+         makeFlatVector<int32_t>(1'000, [](auto row) { return row; })}));
+    writeToFile(filePaths[i]->path, vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  // Once the first file fills the TopN, the filter on the threshold excludes
+  // the other files by their statistics.
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType)
+                  .topN({"c0"}, 10, false)
+                  .planNode();
+  auto task = assertQueryOrdered(
+      plan,
+      makeHiveConnectorSplits(filePaths),
+      "SELECT * FROM tmp ORDER BY c0 LIMIT 10",
+      {0});
+  ASSERT_GT(getTableScanRuntimeStats(task)["dynamicFiltersAccepted"].sum, 0);
+  ASSERT_GT(getSkippedSplitsStat(task), 0);
+
+  plan = PlanBuilder(pool_.get())
+             .tableScan(rowType)
+             .topN({"c0 DESC"}, 10, false)
+             .planNode();
+  assertQueryOrdered(
+      plan,
+      makeHiveConnectorSplits(filePaths),
+      "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10",
+      {0});
+}
@@ -592,6 +592,25 @@ class TableWriteTest : public HiveConnectorTestBase {
     for (const auto bucketId : bucketIds) {
       ASSERT_EQ(expectedBucketId, bucketId);
     }
+
+    // The rows of a sorted bucket file are in the order of the sort columns.
+    for (vector_size_t row = 1; row < resultVector->size(); ++row) {
+      for (const auto& sortColumn : bucketProperty_->sortedBy()) {
+        const auto& column = resultVector->childAt(
+            tableSchema_->getChildIdx(sortColumn->sortColumn()));
+        const CompareFlags flags{
+            sortColumn->sortOrder().isNullsFirst(),
+            sortColumn->sortOrder().isAscending(),
+            false,
+            false};
+        const auto result =
+            column->compare(column.get(), row - 1, row, flags).value();
+        if (result != 0) {
+          ASSERT_LT(result, 0);
+          break;
+        }
+      }
+    }
   }
 
   // Verifies the file layout and data produced by a table writer.
@@ -780,6 +799,12 @@ class BucketedTableOnlyWriteTest
         HiveBucketProperty::Kind::kPrestoNative,
         false}
                              .value);
+    testParams.push_back(TestParam{
+        TestMode::kBucketed,
+        CommitStrategy::kNoCommit,
+        HiveBucketProperty::Kind::kPrestoNative,
+        true}
+                             .value);
     return testParams;
   }
 };
@@ -1168,6 +1193,46 @@ TEST_P(PartitionedTableWriterTest, multiplePartitions) {
   }
 }
 
+TEST_P(PartitionedTableWriterTest, maxWriterMemory) {
+  const int32_t numPartitions = 20;
+  const int32_t numBatches = 10;
+  auto rowType =
+      ROW({"c0", "p0", "c3", "c5"}, {INTEGER(), INTEGER(), REAL(), VARCHAR()});
+  std::vector<RowVectorPtr> vectors = makeBatches(numBatches, [&](auto batch) {
+    return makeRowVector(
+        rowType->names(),
+        {makeFlatVector<int32_t>(
+             1'000, [&](auto row) { return batch * 1'000 + row; }),
+         makeFlatVector<int32_t>(
+             1'000, [&](auto row) { return row % numPartitions; }),
+         makeFlatVector<float>(1'000, [&](auto row) { return row + 0.5; }),
+         makeFlatVector<StringView>(1'000, [&](auto row) {
+           return StringView::makeInline(fmt::format("str_{}", row * 7));
+         })});
+  });
+  createDuckDbTable(vectors);
+
+  // A budget of one byte makes the writers flush their stripes after every
+  // input, which writes many small stripes per file.
+  auto outputDirectory = TempDirectoryPath::create();
+  auto plan = createInsertPlan(
+      PlanBuilder().values(vectors),
+      rowType,
+      outputDirectory->path,
+      {"p0"},
+      bucketProperty_,
+      connector::hive::LocationHandle::TableType::kNew,
+      commitStrategy_);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .connectorConfig(kHiveConnectorId, HiveConfig::kMaxWriterMemory, "1")
+      .assertResults("SELECT count(*) FROM tmp");
+
+  assertQuery(
+      PlanBuilder().tableScan(rowType).planNode(),
+      makeHiveConnectorSplits(outputDirectory),
+      "SELECT * FROM tmp");
+}
+
 TEST_P(PartitionedTableWriterTest, singlePartition) {
   const int32_t numBatches = 2;
 
@@ -1417,6 +1482,37 @@ TEST_P(UnpartitionedTableWriterTest, appendToAnExistingUnpartitionedTable) {
   }
 }
 
+TEST_P(UnpartitionedTableWriterTest, scaleWriters) {
+  auto input = makeVectors(4, 100);
+  createDuckDbTable(input);
+
+  auto write = [&](bool scaleWriters) {
+    auto outputDirectory = TempDirectoryPath::create();
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = createInsertPlan(
+        PlanBuilder(planNodeIdGenerator)
+            .localPartitionRoundRobin(
+                {PlanBuilder(planNodeIdGenerator).values(input).planNode()}),
+        rowType_,
+        outputDirectory->path);
+    AssertQueryBuilder(plan)
+        .maxDrivers(4)
+        .config(
+            core::QueryConfig::kScaleWriters, scaleWriters ? "true" : "false")
+        .copyResults(pool());
+    assertQuery(
+        PlanBuilder().tableScan(rowType_).planNode(),
+        makeHiveConnectorSplits(outputDirectory->path),
+        "SELECT * FROM tmp");
+    return listAllFiles(outputDirectory->path).size();
+  };
+
+  // Round robin gives rows to all 4 writers. A small insert with scaled
+  // writers has one writer until the local exchange buffer backs up.
+  EXPECT_EQ(write(false), 4);
+  EXPECT_EQ(write(true), 1);
+}
+
 TEST_P(BucketedTableOnlyWriteTest, bucketCountLimit) {
   SCOPED_TRACE(testParam_.toString());
   auto input = makeVectors(1, 100);
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/exec/TaskTrace.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "velox/exec/Driver.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+TaskTraceEvent makeEvent(uint64_t startMicros) {
+  return {
+      TaskTraceEvent::Kind::kOnThread,
+      0,
+      1,
+      -1,
+      startMicros,
+      10,
+      static_cast<int64_t>(StopReason::kBlock)};
+}
+} // namespace
+
+class TaskTraceTest : public OperatorTestBase {};
+
+TEST_F(TaskTraceTest, ringBuffer) {
+  TaskTrace trace(3);
+  for (auto i = 0; i < 2; ++i) {
+    trace.record(makeEvent(i));
+  }
+  EXPECT_EQ(trace.events().size(), 2);
+  EXPECT_EQ(trace.numDropped(), 0);
+
+  for (auto i = 2; i < 7; ++i) {
+    trace.record(makeEvent(i));
+  }
+  // Keeps the latest events, oldest first.
+  auto events = trace.events();
+  ASSERT_EQ(events.size(), 3);
+  EXPECT_EQ(events[0].startMicros, 4);
+  EXPECT_EQ(events[1].startMicros, 5);
+  EXPECT_EQ(events[2].startMicros, 6);
+  EXPECT_EQ(trace.numDropped(), 4);
+}
+
+TEST_F(TaskTraceTest, chromeTrace) {
+  TaskTrace trace(10);
+  trace.record(makeEvent(100));
+  trace.record(
+      {TaskTraceEvent::Kind::kBlocked,
+       2,
+       3,
+       1,
+       110,
+       20,
+       static_cast<int64_t>(BlockingReason::kWaitForSplit)});
+
+  auto json = folly::parseJson(trace.toChromeTrace("task.0"));
+  EXPECT_EQ(json["otherData"]["taskId"], "task.0");
+  EXPECT_EQ(json["otherData"]["droppedEvents"], 0);
+  const auto& events = json["traceEvents"];
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0]["name"], "run");
+  EXPECT_EQ(events[0]["ph"], "X");
+  EXPECT_EQ(events[0]["ts"], 100);
+  EXPECT_EQ(events[0]["dur"], 10);
+  EXPECT_EQ(events[0]["pid"], 0);
+  EXPECT_EQ(events[0]["tid"], 1);
+  EXPECT_EQ(events[0]["args"]["stopReason"], "BLOCK");
+  EXPECT_EQ(events[1]["name"], "kWaitForSplit");
+  EXPECT_EQ(events[1]["pid"], 2);
+  EXPECT_EQ(events[1]["tid"], 3);
+  EXPECT_EQ(events[1]["args"]["operatorId"], 1);
+}
+
+TEST_F(TaskTraceTest, task) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto task = AssertQueryBuilder(PlanBuilder().values({data}).planNode())
+                  .config(core::QueryConfig::kTaskTraceMaxEvents, "100")
+                  .assertResults(data);
+  ASSERT_NE(task->trace(), nullptr);
+  // The Driver records its last run after the results are consumed.
+  for (auto i = 0; i < 100 && task->trace()->events().empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // NOLINT
+  }
+  auto json = folly::parseJson(task->toChromeTrace());
+  EXPECT_EQ(json["otherData"]["taskId"], task->taskId());
+  ASSERT_GT(json["traceEvents"].size(), 0);
+  EXPECT_EQ(json["traceEvents"][0]["name"], "run");
+}
+
+TEST_F(TaskTraceTest, disabled) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(10, folly::identity)});
+  auto task = AssertQueryBuilder(PlanBuilder().values({data}).planNode())
+                  .assertResults(data);
+  EXPECT_EQ(task->trace(), nullptr);
+  EXPECT_THROW(task->toChromeTrace(), VeloxUserError);
+}
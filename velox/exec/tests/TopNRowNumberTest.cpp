@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox::exec::test;
 
@@ -166,5 +168,119 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(100);
 }
 
+TEST_F(TopNRowNumberTest, rank) {
+  const vector_size_t size = 10'000;
+  auto data = makeRowVector({
+      // Partitioning key.
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 7; }),
+      // Sorting key with many ties.
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row / 7) % 50; }, nullEvery(13)),
+      // Data.
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  createDuckDbTable({data});
+
+  auto testLimit = [&](const std::string& function, auto limit) {
+    SCOPED_TRACE(fmt::format("{} limit: {}", function, limit));
+    auto plan = PlanBuilder()
+                    .values({data})
+                    .topNRank(function, {"c0"}, {"c1 nulls last"}, limit, true)
+                    .planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchBytes, "1024")
+        .assertResults(fmt::format(
+            "SELECT * FROM (SELECT *, {}() over (partition by c0 order by c1 nulls last) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+
+    // Do not emit ranks, as in a partial top-N before an exchange.
+    plan = PlanBuilder()
+               .values({data})
+               .topNRank(function, {"c0"}, {"c1 desc nulls last"}, limit, false)
+               .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT c0, c1, c2 FROM (SELECT *, {}() over (partition by c0 order by c1 desc nulls last) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+
+    // No partitioning keys.
+    plan = PlanBuilder()
+               .values({data})
+               .topNRank(function, {}, {"c1 nulls first"}, limit, true)
+               .planNode();
+    assertQuery(
+        plan,
+        fmt::format(
+            "SELECT * FROM (SELECT *, {}() over (order by c1 nulls first) as rn FROM tmp) "
+            " WHERE rn <= {}",
+            function,
+            limit));
+  };
+
+  for (const auto& function : {"rank", "dense_rank"}) {
+    testLimit(function, 1);
+    testLimit(function, 5);
+    testLimit(function, 30);
+    testLimit(function, 100);
+  }
+}
+
+TEST_F(TopNRowNumberTest, spill) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({
+        // Partitioning key.
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row % 97; }),
+        // Sorting key.
+        makeFlatVector<int64_t>(
+            1'000, [i](auto row) { return (10 - i) * 1'000 - row; }),
+        // Data.
+        makeFlatVector<StringView>(
+            1'000,
+            [](auto row) {
+              return StringView::makeInline(fmt::format("{}", row));
+            },
+            nullEvery(7)),
+    }));
+  }
+
+  createDuckDbTable(data);
+
+  auto testLimit = [&](auto limit) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit));
+    auto spillDirectory = TempDirectoryPath::create();
+    core::PlanNodeId topNRowNumberId;
+    auto plan = PlanBuilder()
+                    .values(data)
+                    .topNRowNumber({"c0"}, {"c1"}, limit, true)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(fmt::format(
+                "SELECT * FROM (SELECT *, row_number() over (partition by c0 order by c1) as rn FROM tmp) "
+                " WHERE rn <= {}",
+                limit));
+    const auto stats = toPlanStats(task->taskStats()).at(topNRowNumberId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  };
+
+  testLimit(1);
+  testLimit(5);
+  testLimit(100);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -230,6 +231,38 @@ TEST_F(TopNTest, multiBatch) {
   testSingleKey(vectors, "c2", 2'500);
 }
 
+TEST_F(TopNTest, thresholdFilter) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int32_t>(
+        batchSize,
+        [&](vector_size_t row) { return batchSize * i + row; },
+        nullEvery(7));
+    auto c1 = makeFlatVector<int64_t>(
+        batchSize, [](vector_size_t row) { return row % 3; });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  // The first batch fills the TopN. The later batches are dropped by the
+  // threshold on c0, except for rows that tie or sort before it.
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c0"}, 10, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c0 NULLS LAST LIMIT 10", {0});
+  auto stats = toPlanStats(task->taskStats()).at(topNId);
+  ASSERT_EQ(stats.customStats.at("thresholdFilteredRows").sum, 4 * batchSize);
+
+  // Rows with a null c0 and the same c1 are identical, so ties on them do not
+  // make the result non-deterministic.
+  testTwoKeys(vectors, "c1", "c0", 10);
+}
+
 TEST_F(TopNTest, empty) {
   vector_size_t batchSize = 1'000;
   std::vector<RowVectorPtr> vectors;
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -403,3 +404,43 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
            .planNode();
   assertQueryReturnsEmptyResult(op);
 }
+
+TEST_F(UnnestTest, batchSize) {
+  // Arrays much larger than the output batch size, with null and empty arrays
+  // in between.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(10, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          10,
+          [](auto row) { return row % 4 == 1 ? 0 : 1'000 + row; },
+          [](auto row, auto index) { return row * 10'000 + index; },
+          nullEvery(3)),
+      makeMapVector<int64_t, double>(
+          10,
+          [](auto row) { return row * 100; },
+          [](auto row) { return row; },
+          [](auto row) { return row * 0.1; }),
+  });
+
+  auto op = PlanBuilder()
+                .values({vector})
+                .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                .planNode();
+  const auto expected = AssertQueryBuilder(op).copyResults(pool());
+
+  for (auto batchSize : {1, 7, 100, 1'000}) {
+    SCOPED_TRACE(fmt::format("batchSize: {}", batchSize));
+    auto task =
+        AssertQueryBuilder(op)
+            .config(
+                core::QueryConfig::kPreferredOutputBatchRows,
+                std::to_string(batchSize))
+            .assertResults(expected);
+
+    const auto& stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_EQ(stats.outputPositions, expected->size());
+    ASSERT_EQ(
+        stats.outputVectors,
+        bits::roundUp(expected->size(), batchSize) / batchSize);
+  }
+}
@@ -303,6 +303,45 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+TEST_F(VectorHasherTest, stringDictionarySharedAcrossBatches) {
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
+  auto base = vectorMaker_->flatVector<std::string>(
+      {"apple", "banana", "a string longer than twelve bytes"});
+
+  auto makeBatch = [&](vector_size_t offset) {
+    BufferPtr indices =
+        AlignedBuffer::allocate<vector_size_t>(100, pool_.get());
+    auto rawIndices = indices->asMutable<vector_size_t>();
+    for (int32_t i = 0; i < 100; i++) {
+      rawIndices[i] = (i + offset) % 3;
+    }
+    return BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, 100, base);
+  };
+
+  // The second batch reuses the hashes of the base computed for odd rows of
+  // the first and hashes the rest.
+  raw_vector<uint64_t> hashes(100);
+  for (auto offset = 0; offset < 3; ++offset) {
+    auto batch = makeBatch(offset);
+    const auto& rows = offset == 0 ? oddRows_ : allRows_;
+    hasher->decode(*batch, rows);
+    hasher->hash(rows, false, hashes);
+    rows.applyToSelected([&](auto row) {
+      EXPECT_EQ(hashes[row], base->hashValueAt((row + offset) % 3))
+          << "at " << row;
+    });
+  }
+
+  // A new base with the same size does not reuse the hashes.
+  base = vectorMaker_->flatVector<std::string>({"x", "y", "z"});
+  auto batch = makeBatch(0);
+  hasher->decode(*batch, allRows_);
+  hasher->hash(allRows_, false, hashes);
+  for (int32_t i = 0; i < 100; i++) {
+    EXPECT_EQ(hashes[i], base->hashValueAt(i % 3)) << "at " << i;
+  }
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
@@ -612,6 +612,9 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param broadcastBuild Indicates that all the tasks running the join get
+  /// the same build side, so that the tasks of a query on the same worker can
+  /// share the hash table.
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -619,7 +622,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      bool broadcastBuild = false);
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
@@ -709,6 +713,12 @@ class PlanBuilder {
   ///  rows between a + 10 preceding and 10 following)"
   PlanBuilder& window(const std::vector<std::string>& windowFunctions);
 
+  /// Same as window(), but the input must already be clustered on the
+  /// PARTITION BY keys and sorted on the ORDER BY keys within each partition.
+  /// The Window operator outputs each partition as soon as the next one starts
+  /// instead of buffering all the input.
+  PlanBuilder& streamingWindow(const std::vector<std::string>& windowFunctions);
+
   /// Add a RowNumberNode to compute single row_number window function with an
   /// optional limit and no sorting.
   PlanBuilder& rowNumber(
@@ -723,6 +733,16 @@ class PlanBuilder {
       int32_t limit,
       bool generateRowNumber);
 
+  /// Add a TopNRowNumberNode to compute single row_number, rank or dense_rank
+  /// window function with a limit applied to sorted partitions. The output
+  /// column, if generated, is named after the function.
+  PlanBuilder& topNRank(
+      std::string_view function,
+      const std::vector<std::string>& partitionKeys,
+      const std::vector<std::string>& sortingKeys,
+      int32_t limit,
+      bool generateRank);
+
   /// Add a MarkDistinctNode to compute aggregate mask channel
   /// @param markerKey Name of output mask channel
   /// @param distinctKeys List of columns to be marked distinct.
@@ -794,6 +814,10 @@ class PlanBuilder {
 
   std::vector<core::TypedExprPtr> exprs(const std::vector<std::string>& names);
 
+  PlanBuilder& window(
+      const std::vector<std::string>& windowFunctions,
+      bool inputsSorted);
+
   std::vector<std::shared_ptr<const core::FieldAccessTypedExpr>> fields(
       const std::vector<std::string>& names);
 
@@ -339,6 +339,118 @@ velox::variant arrayVariantAt(
   return velox::variant::array(std::move(array));
 }
 
+// Returns the DuckDB type whose values are read directly as 'kind', or
+// INVALID if there is none.
+::duckdb::LogicalTypeId directDuckType(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      return ::duckdb::LogicalTypeId::BOOLEAN;
+    case TypeKind::TINYINT:
+      return ::duckdb::LogicalTypeId::TINYINT;
+    case TypeKind::SMALLINT:
+      return ::duckdb::LogicalTypeId::SMALLINT;
+    case TypeKind::INTEGER:
+      return ::duckdb::LogicalTypeId::INTEGER;
+    case TypeKind::BIGINT:
+      return ::duckdb::LogicalTypeId::BIGINT;
+    case TypeKind::REAL:
+      return ::duckdb::LogicalTypeId::FLOAT;
+    case TypeKind::DOUBLE:
+      return ::duckdb::LogicalTypeId::DOUBLE;
+    case TypeKind::VARCHAR:
+      return ::duckdb::LogicalTypeId::VARCHAR;
+    case TypeKind::VARBINARY:
+      return ::duckdb::LogicalTypeId::BLOB;
+    case TypeKind::TIMESTAMP:
+      return ::duckdb::LogicalTypeId::TIMESTAMP;
+    case TypeKind::DATE:
+      return ::duckdb::LogicalTypeId::DATE;
+    default:
+      return ::duckdb::LogicalTypeId::INVALID;
+  }
+}
+
+template <TypeKind kind>
+velox::variant directVariantAt(
+    const ::duckdb::data_ptr_t data,
+    ::duckdb::idx_t index) {
+  using T = typename TypeTraits<kind>::NativeType;
+  return velox::variant(reinterpret_cast<const T*>(data)[index]);
+}
+
+template <>
+velox::variant directVariantAt<TypeKind::VARCHAR>(
+    const ::duckdb::data_ptr_t data,
+    ::duckdb::idx_t index) {
+  const auto& value = reinterpret_cast<const ::duckdb::string_t*>(data)[index];
+  return velox::variant(StringView(value.GetDataUnsafe(), value.GetSize()));
+}
+
+template <>
+velox::variant directVariantAt<TypeKind::VARBINARY>(
+    const ::duckdb::data_ptr_t data,
+    ::duckdb::idx_t index) {
+  return directVariantAt<TypeKind::VARCHAR>(data, index);
+}
+
+template <>
+velox::variant directVariantAt<TypeKind::TIMESTAMP>(
+    const ::duckdb::data_ptr_t data,
+    ::duckdb::idx_t index) {
+  return velox::variant::timestamp(duckdbTimestampToVelox(
+      reinterpret_cast<const ::duckdb::timestamp_t*>(data)[index]));
+}
+
+template <>
+velox::variant directVariantAt<TypeKind::DATE>(
+    const ::duckdb::data_ptr_t data,
+    ::duckdb::idx_t index) {
+  return velox::variant::date(::duckdb::Date::EpochDays(
+      reinterpret_cast<const ::duckdb::date_t*>(data)[index]));
+}
+
+template <TypeKind kind>
+void materializeColumnDirectImpl(
+    const ::duckdb::VectorData& data,
+    size_t size,
+    size_t column,
+    const variant& null,
+    std::vector<MaterializedRow>& rows) {
+  for (size_t i = 0; i < size; ++i) {
+    const auto index = data.sel->get_index(i);
+    rows[i][column] = data.validity.RowIsValid(index)
+        ? directVariantAt<kind>(data.data, index)
+        : null;
+  }
+}
+
+// Reads the values of a scalar column from the DuckDB data instead of making a
+// ::duckdb::Value per row. Returns false if the column must be read by Value.
+bool materializeColumnDirect(
+    ::duckdb::DataChunk* dataChunk,
+    size_t column,
+    const TypePtr& type,
+    const variant& null,
+    std::vector<MaterializedRow>& rows) {
+  auto& vector = dataChunk->data[column];
+  if (!type->isPrimitiveType() || type->isDecimal() ||
+      type->isIntervalDayTime() ||
+      vector.GetType().id() != directDuckType(type->kind())) {
+    return false;
+  }
+  ::duckdb::VectorData data;
+  vector.Orrify(dataChunk->size(), data);
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      materializeColumnDirectImpl,
+      type->kind(),
+      data,
+      dataChunk->size(),
+      column,
+      null,
+      rows);
+  return true;
+}
+
 std::vector<MaterializedRow> materialize(
     ::duckdb::DataChunk* dataChunk,
     const std::shared_ptr<const RowType>& rowType) {
@@ -346,42 +458,35 @@ std::vector<MaterializedRow> materialize(
       rowType->size(), dataChunk->GetTypes().size(), "Wrong number of columns");
 
   auto size = dataChunk->size();
-  std::vector<MaterializedRow> rows;
-  rows.reserve(size);
+  std::vector<MaterializedRow> rows(size, MaterializedRow(rowType->size()));
 
-  // Pre-compute null values for all columns.
-  std::vector<variant> nulls;
   for (size_t j = 0; j < rowType->size(); ++j) {
-    nulls.emplace_back(nullVariant(rowType->childAt(j)));
-  }
-
-  for (size_t i = 0; i < size; ++i) {
-    MaterializedRow row;
-    row.reserve(rowType->size());
-    for (size_t j = 0; j < rowType->size(); ++j) {
-      auto type = rowType->childAt(j);
-      auto typeKind = type->kind();
-      if (dataChunk->GetValue(j, i).IsNull()) {
-        row.push_back(nulls[j]);
+    auto type = rowType->childAt(j);
+    auto typeKind = type->kind();
+    const auto null = nullVariant(type);
+    if (materializeColumnDirect(dataChunk, j, type, null, rows)) {
+      continue;
+    }
+    for (size_t i = 0; i < size; ++i) {
+      auto value = dataChunk->GetValue(j, i);
+      if (value.IsNull()) {
+        rows[i][j] = null;
       } else if (typeKind == TypeKind::ARRAY) {
-        row.push_back(arrayVariantAt(dataChunk->GetValue(j, i), type));
+        rows[i][j] = arrayVariantAt(value, type);
       } else if (typeKind == TypeKind::MAP) {
-        row.push_back(mapVariantAt(dataChunk->GetValue(j, i), type));
+        rows[i][j] = mapVariantAt(value, type);
       } else if (typeKind == TypeKind::ROW) {
-        row.push_back(rowVariantAt(dataChunk->GetValue(j, i), type));
+        rows[i][j] = rowVariantAt(value, type);
       } else if (type->isDecimal()) {
-        row.push_back(duckdb::decimalVariant(dataChunk->GetValue(j, i)));
+        rows[i][j] = duckdb::decimalVariant(value);
       } else if (type->isIntervalDayTime()) {
-        auto value = variant(::duckdb::Interval::GetMicro(
-            dataChunk->GetValue(j, i).GetValue<::duckdb::interval_t>()));
-        row.push_back(value);
+        rows[i][j] = variant(::duckdb::Interval::GetMicro(
+            value.GetValue<::duckdb::interval_t>()));
       } else {
-        auto value = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        rows[i][j] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
             variantAt, typeKind, dataChunk, i, j);
-        row.push_back(value);
       }
     }
-    rows.push_back(row);
   }
   return rows;
 }
@@ -147,8 +147,12 @@ TpchPlan TpchQueryBuilder::getQueryPlan(int queryId) const {
   switch (queryId) {
     case 1:
       return getQ1Plan();
+    case 2:
+      return getQ2Plan();
     case 3:
       return getQ3Plan();
+    case 4:
+      return getQ4Plan();
     case 5:
       return getQ5Plan();
     case 6:
@@ -161,6 +165,8 @@ TpchPlan TpchQueryBuilder::getQueryPlan(int queryId) const {
       return getQ9Plan();
     case 10:
       return getQ10Plan();
+    case 11:
+      return getQ11Plan();
     case 12:
       return getQ12Plan();
     case 13:
@@ -241,6 +247,209 @@ TpchPlan TpchQueryBuilder::getQ1Plan() const {
   return context;
 }
 
+TpchPlan TpchQueryBuilder::getQ2Plan() const {
+  std::vector<std::string> partColumns = {
+      "p_partkey", "p_mfgr", "p_type", "p_size"};
+  std::vector<std::string> supplierColumns = {
+      "s_suppkey",
+      "s_name",
+      "s_address",
+      "s_nationkey",
+      "s_phone",
+      "s_acctbal",
+      "s_comment"};
+  std::vector<std::string> supplierColumnsWithKey = {
+      "s_suppkey", "s_nationkey"};
+  std::vector<std::string> partsuppColumns = {
+      "ps_partkey", "ps_suppkey", "ps_supplycost"};
+  std::vector<std::string> nationColumns = {
+      "n_nationkey", "n_name", "n_regionkey"};
+  std::vector<std::string> nationColumnsWithKey = {
+      "n_nationkey", "n_regionkey"};
+  std::vector<std::string> regionColumns = {"r_regionkey", "r_name"};
+
+  const auto partSelectedRowType = getRowType(kPart, partColumns);
+  const auto& partFileColumns = getFileColumnNames(kPart);
+  const auto supplierSelectedRowType = getRowType(kSupplier, supplierColumns);
+  const auto supplierSelectedRowTypeWithKey =
+      getRowType(kSupplier, supplierColumnsWithKey);
+  const auto& supplierFileColumns = getFileColumnNames(kSupplier);
+  const auto partsuppSelectedRowType = getRowType(kPartsupp, partsuppColumns);
+  const auto& partsuppFileColumns = getFileColumnNames(kPartsupp);
+  const auto nationSelectedRowType = getRowType(kNation, nationColumns);
+  const auto nationSelectedRowTypeWithKey =
+      getRowType(kNation, nationColumnsWithKey);
+  const auto& nationFileColumns = getFileColumnNames(kNation);
+  const auto regionSelectedRowType = getRowType(kRegion, regionColumns);
+  const auto& regionFileColumns = getFileColumnNames(kRegion);
+
+  const std::string regionNameFilter = "r_name = 'EUROPE'";
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId partScanNodeId;
+  core::PlanNodeId supplierScanNodeId;
+  core::PlanNodeId supplierAggScanNodeId;
+  core::PlanNodeId partsuppScanNodeId;
+  core::PlanNodeId partsuppAggScanNodeId;
+  core::PlanNodeId nationScanNodeId;
+  core::PlanNodeId nationAggScanNodeId;
+  core::PlanNodeId regionScanNodeId;
+  core::PlanNodeId regionAggScanNodeId;
+
+  // Suppliers in EUROPE for the correlated min(ps_supplycost) subquery.
+  auto regionAgg = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .tableScan(
+                           kRegion,
+                           regionSelectedRowType,
+                           regionFileColumns,
+                           {regionNameFilter})
+                       .capturePlanNodeId(regionAggScanNodeId)
+                       .planNode();
+
+  auto nationJoinRegionAgg =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kNation, nationSelectedRowTypeWithKey, nationFileColumns)
+          .capturePlanNodeId(nationAggScanNodeId)
+          .hashJoin(
+              {"n_regionkey"}, {"r_regionkey"}, regionAgg, "", {"n_nationkey"})
+          .planNode();
+
+  auto supplierJoinNationAgg =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kSupplier, supplierSelectedRowTypeWithKey, supplierFileColumns)
+          .capturePlanNodeId(supplierAggScanNodeId)
+          .hashJoin(
+              {"s_nationkey"},
+              {"n_nationkey"},
+              nationJoinRegionAgg,
+              "",
+              {"s_suppkey"})
+          .planNode();
+
+  auto minSupplyCost =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kPartsupp, partsuppSelectedRowType, partsuppFileColumns)
+          .capturePlanNodeId(partsuppAggScanNodeId)
+          .hashJoin(
+              {"ps_suppkey"},
+              {"s_suppkey"},
+              supplierJoinNationAgg,
+              "",
+              {"ps_partkey", "ps_supplycost"})
+          .partialAggregation(
+              {"ps_partkey"}, {"min(ps_supplycost) AS min_supplycost"})
+          .localPartition({"ps_partkey"})
+          .finalAggregation()
+          .project({"ps_partkey AS min_partkey", "min_supplycost"})
+          .planNode();
+
+  // Suppliers in EUROPE with the columns of the query result.
+  auto region = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kRegion,
+                        regionSelectedRowType,
+                        regionFileColumns,
+                        {regionNameFilter})
+                    .capturePlanNodeId(regionScanNodeId)
+                    .planNode();
+
+  auto nationJoinRegion =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kNation, nationSelectedRowType, nationFileColumns)
+          .capturePlanNodeId(nationScanNodeId)
+          .hashJoin(
+              {"n_regionkey"},
+              {"r_regionkey"},
+              region,
+              "",
+              {"n_nationkey", "n_name"})
+          .planNode();
+
+  auto supplierJoinNation =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kSupplier, supplierSelectedRowType, supplierFileColumns)
+          .capturePlanNodeId(supplierScanNodeId)
+          .hashJoin(
+              {"s_nationkey"},
+              {"n_nationkey"},
+              nationJoinRegion,
+              "",
+              {"s_suppkey",
+               "s_name",
+               "s_address",
+               "s_phone",
+               "s_acctbal",
+               "s_comment",
+               "n_name"})
+          .planNode();
+
+  auto part = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(
+                      kPart,
+                      partSelectedRowType,
+                      partFileColumns,
+                      {"p_size = 15"},
+                      "p_type LIKE '%BRASS'")
+                  .capturePlanNodeId(partScanNodeId)
+                  .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kPartsupp, partsuppSelectedRowType, partsuppFileColumns)
+          .capturePlanNodeId(partsuppScanNodeId)
+          .hashJoin(
+              {"ps_partkey"},
+              {"p_partkey"},
+              part,
+              "",
+              {"ps_partkey", "ps_suppkey", "ps_supplycost", "p_mfgr"})
+          .hashJoin(
+              {"ps_suppkey"},
+              {"s_suppkey"},
+              supplierJoinNation,
+              "",
+              {"ps_partkey",
+               "ps_supplycost",
+               "p_mfgr",
+               "s_name",
+               "s_address",
+               "s_phone",
+               "s_acctbal",
+               "s_comment",
+               "n_name"})
+          .hashJoin(
+              {"ps_partkey", "ps_supplycost"},
+              {"min_partkey", "min_supplycost"},
+              minSupplyCost,
+              "",
+              {"s_acctbal",
+               "s_name",
+               "n_name",
+               "ps_partkey",
+               "p_mfgr",
+               "s_address",
+               "s_phone",
+               "s_comment"})
+          .orderBy({"s_acctbal DESC", "n_name", "s_name", "ps_partkey"}, false)
+          .limit(0, 100, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[partScanNodeId] = getTableFilePaths(kPart);
+  context.dataFiles[supplierScanNodeId] = getTableFilePaths(kSupplier);
+  context.dataFiles[supplierAggScanNodeId] = getTableFilePaths(kSupplier);
+  context.dataFiles[partsuppScanNodeId] = getTableFilePaths(kPartsupp);
+  context.dataFiles[partsuppAggScanNodeId] = getTableFilePaths(kPartsupp);
+  context.dataFiles[nationScanNodeId] = getTableFilePaths(kNation);
+  context.dataFiles[nationAggScanNodeId] = getTableFilePaths(kNation);
+  context.dataFiles[regionScanNodeId] = getTableFilePaths(kRegion);
+  context.dataFiles[regionAggScanNodeId] = getTableFilePaths(kRegion);
+  context.dataFileFormat = format_;
+  return context;
+}
+
 TpchPlan TpchQueryBuilder::getQ3Plan() const {
   std::vector<std::string> lineitemColumns = {
       "l_shipdate", "l_orderkey", "l_extendedprice", "l_discount"};
@@ -329,6 +538,65 @@ TpchPlan TpchQueryBuilder::getQ3Plan() const {
   return context;
 }
 
+TpchPlan TpchQueryBuilder::getQ4Plan() const {
+  std::vector<std::string> ordersColumns = {
+      "o_orderkey", "o_orderdate", "o_orderpriority"};
+  std::vector<std::string> lineitemColumns = {
+      "l_orderkey", "l_commitdate", "l_receiptdate"};
+
+  const auto ordersSelectedRowType = getRowType(kOrders, ordersColumns);
+  const auto& ordersFileColumns = getFileColumnNames(kOrders);
+  const auto lineitemSelectedRowType = getRowType(kLineitem, lineitemColumns);
+  const auto& lineitemFileColumns = getFileColumnNames(kLineitem);
+
+  const std::string orderDateFilter = formatDateFilter(
+      "o_orderdate", ordersSelectedRowType, "'1993-07-01'", "'1993-09-30'");
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId ordersScanNodeId;
+  core::PlanNodeId lineitemScanNodeId;
+
+  auto orders = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kOrders,
+                        ordersSelectedRowType,
+                        ordersFileColumns,
+                        {orderDateFilter})
+                    .capturePlanNodeId(ordersScanNodeId)
+                    .planNode();
+
+  // The EXISTS subquery is a right semi join that builds on the filtered
+  // orders and probes with the much larger lineitem.
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(
+              kLineitem,
+              lineitemSelectedRowType,
+              lineitemFileColumns,
+              {},
+              "l_commitdate < l_receiptdate")
+          .capturePlanNodeId(lineitemScanNodeId)
+          .hashJoin(
+              {"l_orderkey"},
+              {"o_orderkey"},
+              orders,
+              "",
+              {"o_orderpriority"},
+              core::JoinType::kRightSemiFilter)
+          .partialAggregation({"o_orderpriority"}, {"count(0) AS order_count"})
+          .localPartition({})
+          .finalAggregation()
+          .orderBy({"o_orderpriority"}, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[ordersScanNodeId] = getTableFilePaths(kOrders);
+  context.dataFiles[lineitemScanNodeId] = getTableFilePaths(kLineitem);
+  context.dataFileFormat = format_;
+  return context;
+}
+
 TpchPlan TpchQueryBuilder::getQ5Plan() const {
   std::vector<std::string> customerColumns = {"c_custkey", "c_nationkey"};
   std::vector<std::string> ordersColumns = {
@@ -1062,6 +1330,112 @@ TpchPlan TpchQueryBuilder::getQ10Plan() const {
   return context;
 }
 
+TpchPlan TpchQueryBuilder::getQ11Plan() const {
+  std::vector<std::string> partsuppColumns = {
+      "ps_partkey", "ps_suppkey", "ps_availqty", "ps_supplycost"};
+  std::vector<std::string> supplierColumns = {"s_suppkey", "s_nationkey"};
+  std::vector<std::string> nationColumns = {"n_nationkey", "n_name"};
+
+  const auto partsuppSelectedRowType = getRowType(kPartsupp, partsuppColumns);
+  const auto& partsuppFileColumns = getFileColumnNames(kPartsupp);
+  const auto supplierSelectedRowType = getRowType(kSupplier, supplierColumns);
+  const auto& supplierFileColumns = getFileColumnNames(kSupplier);
+  const auto nationSelectedRowType = getRowType(kNation, nationColumns);
+  const auto& nationFileColumns = getFileColumnNames(kNation);
+
+  const std::string nationNameFilter = "n_name = 'GERMANY'";
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId partsuppScanNodeId;
+  core::PlanNodeId partsuppAggScanNodeId;
+  core::PlanNodeId supplierScanNodeId;
+  core::PlanNodeId supplierAggScanNodeId;
+  core::PlanNodeId nationScanNodeId;
+  core::PlanNodeId nationAggScanNodeId;
+
+  // Total value of the stock of suppliers in GERMANY for the HAVING clause.
+  auto nationAgg = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .tableScan(
+                           kNation,
+                           nationSelectedRowType,
+                           nationFileColumns,
+                           {nationNameFilter})
+                       .capturePlanNodeId(nationAggScanNodeId)
+                       .planNode();
+
+  auto supplierJoinNationAgg =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kSupplier, supplierSelectedRowType, supplierFileColumns)
+          .capturePlanNodeId(supplierAggScanNodeId)
+          .hashJoin(
+              {"s_nationkey"}, {"n_nationkey"}, nationAgg, "", {"s_suppkey"})
+          .planNode();
+
+  auto totalValue =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kPartsupp, partsuppSelectedRowType, partsuppFileColumns)
+          .capturePlanNodeId(partsuppAggScanNodeId)
+          .hashJoin(
+              {"ps_suppkey"},
+              {"s_suppkey"},
+              supplierJoinNationAgg,
+              "",
+              {"ps_availqty", "ps_supplycost"})
+          .project({"ps_supplycost * ps_availqty AS part_value"})
+          .partialAggregation({}, {"sum(part_value) AS total_value"})
+          .localPartition({})
+          .finalAggregation()
+          .project({"total_value * 0.0001 AS min_value"})
+          .planNode();
+
+  auto nation = PlanBuilder(planNodeIdGenerator, pool_.get())
+                    .tableScan(
+                        kNation,
+                        nationSelectedRowType,
+                        nationFileColumns,
+                        {nationNameFilter})
+                    .capturePlanNodeId(nationScanNodeId)
+                    .planNode();
+
+  auto supplierJoinNation =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kSupplier, supplierSelectedRowType, supplierFileColumns)
+          .capturePlanNodeId(supplierScanNodeId)
+          .hashJoin({"s_nationkey"}, {"n_nationkey"}, nation, "", {"s_suppkey"})
+          .planNode();
+
+  auto plan =
+      PlanBuilder(planNodeIdGenerator, pool_.get())
+          .tableScan(kPartsupp, partsuppSelectedRowType, partsuppFileColumns)
+          .capturePlanNodeId(partsuppScanNodeId)
+          .hashJoin(
+              {"ps_suppkey"},
+              {"s_suppkey"},
+              supplierJoinNation,
+              "",
+              {"ps_partkey", "ps_availqty", "ps_supplycost"})
+          .project({"ps_partkey", "ps_supplycost * ps_availqty AS part_value"})
+          .partialAggregation({"ps_partkey"}, {"sum(part_value) AS value"})
+          .localPartition({"ps_partkey"})
+          .finalAggregation()
+          .nestedLoopJoin(totalValue, {"ps_partkey", "value", "min_value"})
+          .filter("value > min_value")
+          .project({"ps_partkey", "value"})
+          .orderBy({"value DESC"}, false)
+          .planNode();
+
+  TpchPlan context;
+  context.plan = std::move(plan);
+  context.dataFiles[partsuppScanNodeId] = getTableFilePaths(kPartsupp);
+  context.dataFiles[partsuppAggScanNodeId] = getTableFilePaths(kPartsupp);
+  context.dataFiles[supplierScanNodeId] = getTableFilePaths(kSupplier);
+  context.dataFiles[supplierAggScanNodeId] = getTableFilePaths(kSupplier);
+  context.dataFiles[nationScanNodeId] = getTableFilePaths(kNation);
+  context.dataFiles[nationAggScanNodeId] = getTableFilePaths(kNation);
+  context.dataFileFormat = format_;
+  return context;
+}
+
 TpchPlan TpchQueryBuilder::getQ12Plan() const {
   std::vector<std::string> ordersColumns = {"o_orderkey", "o_orderpriority"};
   std::vector<std::string> lineitemColumns = {
@@ -110,6 +110,19 @@ class CompiledExpressionTransformVisitor {
   bool compileFilter_;
   bool mergeFilter_;
 
+  /// Returns the library compiled from 'fileString', or std::nullopt if the
+  /// compilation failed and the expressions must stay interpreted.
+  std::optional<std::filesystem::path> compileAndLink(
+      const std::string& fileString) {
+    try {
+      return codeManager_.compiler().compileAndLink({}, fileString);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Codegen: compilation failed, using interpreted "
+                   << "expressions: " << e.what();
+      return std::nullopt;
+    }
+  }
+
   std::optional<std::reference_wrapper<const GeneratedExpressionStruct>>
   getGeneratedCode(const std::shared_ptr<const ITypedExpr>& expression) {
     auto it = compiledExprAnalysisResult_.generatedCode_.find(expression);
@@ -487,14 +500,21 @@ class CompiledExpressionTransformVisitor {
             fmt::arg(
                 "isDefaultNullStrict",
                 isDefaultNullStrict(filter.id()) ? "true" : "false")));
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
+    if (!dynamicObject.has_value()) {
+      // Keep the interpreted filter.
+      return utils::adapter::FilterCopy::copyWith(
+          filter,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          *ranges::begin(children));
+    }
 
     // Extract the row input expression from the current filter
     const auto inputType = filter.sources()[0]->outputType();
 
     std::shared_ptr<const ITypedExpr> newFilter = buildCompiledCallExpr(
-        dynamicObject, concatOutputType, concatInputType, inputType)[0];
+        dynamicObject.value(), concatOutputType, concatInputType, inputType)[0];
 
     // Build new filter node with newly generated expressions
     return utils::adapter::FilterCopy::copyWith(
@@ -586,8 +606,16 @@ class CompiledExpressionTransformVisitor {
                 "isDefaultNullStrict",
                 isDefaultNullStrict ? "true" : "false")));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
+    if (!dynamicObject.has_value()) {
+      // Keep the interpreted projections and filter.
+      return utils::adapter::ProjectCopy::copyWith(
+          projection,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          *ranges::begin(children));
+    }
     std::vector<std::shared_ptr<const ITypedExpr>> newProjections;
 
     // Extract the row input expression from the current projection
@@ -595,7 +623,10 @@ class CompiledExpressionTransformVisitor {
 
     std::vector<std::shared_ptr<const ITypedExpr>> newExpressions =
         buildCompiledCallExpr(
-            dynamicObject, concatOutputType, concatInputType, inputType);
+            dynamicObject.value(),
+            concatOutputType,
+            concatInputType,
+            inputType);
 
     // oldToNewExpressionColumnMap[Index] in the new projection list maps to
     // projection.projections()[Index] in the old;
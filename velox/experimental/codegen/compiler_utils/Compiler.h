@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <mutex>
+#include <unordered_map>
 #include "glog/logging.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/experimental/codegen/compiler_utils/CompilerOptions.h"
@@ -189,6 +191,35 @@ class Compiler {
     return dynamicLibPath;
   }
 
+  /// Compiles 'cppContent' and links it into a dynamic library. The libraries
+  /// are cached for the life of the process by the source, the libraries and
+  /// the compiler arguments, so that a recurring expression is compiled only
+  /// once.
+  /// \param additionalLibraries
+  /// \param cppContent  c++ file content
+  /// \return path to the generated .so
+  std::filesystem::path compileAndLink(
+      const std::vector<LibraryDescriptor>& additionalLibraries,
+      const std::string& cppContent) {
+    DefaultScopedTimer timer("CompileAndLink", eventSequence_);
+    auto key = fingerprint(additionalLibraries, cppContent);
+    auto& cache = libraryCache();
+    {
+      std::lock_guard<std::mutex> l(cache.mutex);
+      auto it = cache.libraries.find(key);
+      if (it != cache.libraries.end() && std::filesystem::exists(it->second)) {
+        return it->second;
+      }
+    }
+
+    // Concurrent misses on the same key compile twice and keep the last.
+    auto object = compileString(additionalLibraries, cppContent);
+    auto library = link(additionalLibraries, {object});
+    std::lock_guard<std::mutex> l(cache.mutex);
+    cache.libraries[key] = library;
+    return library;
+  }
+
   /// Construct a command object which execution would compile the give files.
   /// \param additionalLibraries
   /// \param cppFile
@@ -267,6 +298,29 @@ class Compiler {
   }
 
  private:
+  struct LibraryCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::filesystem::path> libraries;
+  };
+
+  static LibraryCache& libraryCache() {
+    static LibraryCache cache;
+    return cache;
+  }
+
+  // Returns a key identifying the library built from 'cppContent'.
+  std::string fingerprint(
+      const std::vector<LibraryDescriptor>& additionalLibraries,
+      const std::string& cppContent) {
+    // The commands without file names carry the compiler, the options and
+    // the libraries.
+    return fmt::format(
+        "{}\n{}\n{}",
+        compileCommand(additionalLibraries, "", "").toString(),
+        linkCommand(additionalLibraries, {}, "").toString(),
+        cppContent);
+  }
+
   void includePathArgs(
       const LibraryDescriptor& library,
       std::vector<std::string>& args) {
@@ -290,4 +290,47 @@ TEST(Compiler, CompileAndLink) {
   ASSERT_EQ(dlerror(), nullptr);
   ASSERT_EQ(f(), 24);
 };
+
+TEST(Compiler, compileAndLinkCache) {
+  auto sourceCode1 = R"a(
+  extern "C" {
+  int f() {
+    return 24;
+  };
+  }
+  )a";
+
+  auto sourceCode2 = R"a(
+  extern "C" {
+  int f() {
+    return 32;
+  };
+  }
+  )a";
+
+  DefaultScopedTimer::EventSequence eventSequence;
+  Compiler compiler(testCompilerOptions(), eventSequence);
+
+  auto sharedObject = compiler.compileAndLink({}, sourceCode1);
+  ASSERT_TRUE(std::filesystem::exists(sharedObject));
+
+  // The same source is not compiled again, also by another compiler.
+  Compiler otherCompiler(testCompilerOptions(), eventSequence);
+  ASSERT_EQ(sharedObject, compiler.compileAndLink({}, sourceCode1));
+  ASSERT_EQ(sharedObject, otherCompiler.compileAndLink({}, sourceCode1));
+
+  auto sharedObject2 = compiler.compileAndLink({}, sourceCode2);
+  ASSERT_NE(sharedObject, sharedObject2);
+
+  auto libraryPtr =
+      native_loader::NativeLibraryLoader::loadLibraryInternal(sharedObject2);
+  auto f = (int (*)())dlsym(libraryPtr, "f");
+  ASSERT_EQ(dlerror(), nullptr);
+  ASSERT_EQ(f(), 32);
+
+  // A removed library is built again.
+  std::filesystem::remove(sharedObject);
+  auto rebuilt = compiler.compileAndLink({}, sourceCode1);
+  ASSERT_TRUE(std::filesystem::exists(rebuilt));
+}
 } // namespace facebook::velox::codegen::compiler_utils::test
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+namespace facebook::velox::gpu {
+
+/// Returns the 'bitWidth' bit value number 'index' of 'packed', in which
+/// values are packed LSB first with no padding, the layout of Parquet and
+/// DWRF bit-packed integers. 'numBytes' is the size of 'packed'; bytes past
+/// the end read as 0, so the last page does not need padding.
+__device__ inline uint32_t unpackValue(
+    const uint8_t* packed,
+    size_t numBytes,
+    uint8_t bitWidth,
+    size_t index) {
+  const auto bit = index * bitWidth;
+  const auto firstByte = bit / 8;
+  const auto shift = bit % 8;
+  // At most 32 + 7 bits, i.e. 5 bytes.
+  uint64_t word = 0;
+  const auto lastByte = (bit + bitWidth + 7) / 8;
+  for (auto i = firstByte; i < lastByte && i < numBytes; ++i) {
+    word |= static_cast<uint64_t>(packed[i]) << (8 * (i - firstByte));
+  }
+  const auto mask = bitWidth == 32 ? ~0U : (1U << bitWidth) - 1;
+  return static_cast<uint32_t>(word >> shift) & mask;
+}
+
+/// One bit-packed run: 'numValues' values of 'bitWidth' bits at 'packed' to be
+/// written to 'values'. 'bitWidth' must fit in T. A page usually holds several
+/// runs of different widths, so the runs of a batch of pages are unpacked by
+/// one kernel launch.
+template <typename T>
+struct BitPackedRun {
+  static_assert(std::is_unsigned_v<T> && sizeof(T) <= sizeof(uint32_t));
+
+  const uint8_t* packed;
+  T* values;
+  uint32_t numValues;
+  uint8_t bitWidth;
+};
+
+/// Unpacks 'runs'. Each block unpacks one run at a time, with its threads
+/// writing consecutive values for coalesced stores.
+template <typename T>
+__global__ void unpackRuns(const BitPackedRun<T>* runs, int32_t numRuns) {
+  for (auto r = blockIdx.x; r < numRuns; r += gridDim.x) {
+    const auto run = runs[r];
+    assert(run.bitWidth >= 1 && run.bitWidth <= 8 * sizeof(T));
+    const auto numBytes = (size_t(run.numValues) * run.bitWidth + 7) / 8;
+    for (auto i = threadIdx.x; i < run.numValues; i += blockDim.x) {
+      run.values[i] =
+          static_cast<T>(unpackValue(run.packed, numBytes, run.bitWidth, i));
+    }
+  }
+}
+
+} // namespace facebook::velox::gpu
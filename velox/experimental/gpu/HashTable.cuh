@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace facebook::velox::gpu {
+
+/// Fixed capacity hash table in device memory from 32 or 64 bit keys to 64 bit
+/// values, with linear probing. Slots are claimed with atomicCAS, so any number
+/// of threads can insert at the same time. The table does not grow: the caller
+/// sizes it for the expected number of distinct keys and falls back to the CPU
+/// when insert() reports that the table is full. kEmptyKey marks free slots
+/// and cannot be inserted.
+template <typename T>
+class HashTable {
+  static_assert(
+      std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t>,
+      "Only 32 and 64 bit keys are supported");
+
+ public:
+  static constexpr T kEmptyKey = std::numeric_limits<T>::min();
+
+  /// 'keys' and 'values' are device arrays of 'capacity' elements, which must
+  /// be a power of 2. The table must be cleared with clearHashTable() before
+  /// first use.
+  __host__ __device__ HashTable(T* keys, int64_t* values, size_t capacity)
+      : keys_(keys), values_(values), capacityMask_(capacity - 1) {
+    assert(__builtin_popcountll(capacity) == 1);
+  }
+
+  __host__ __device__ size_t capacity() const {
+    return capacityMask_ + 1;
+  }
+
+  /// Returns the value slot of 'key', inserting 'key' if it is not in the
+  /// table. The value of a new key is the one set by clearHashTable(). Returns
+  /// nullptr if the table is full.
+  __device__ int64_t* insert(T key) {
+    auto slot = hash(key) & capacityMask_;
+    for (size_t i = 0; i <= capacityMask_; ++i) {
+      const auto previous = compareAndSwap(keys_ + slot, kEmptyKey, key);
+      if (previous == kEmptyKey || previous == key) {
+        return values_ + slot;
+      }
+      slot = (slot + 1) & capacityMask_;
+    }
+    return nullptr;
+  }
+
+  /// Returns the value slot of 'key' or nullptr if 'key' is not in the table.
+  __device__ const int64_t* find(T key) const {
+    auto slot = hash(key) & capacityMask_;
+    for (size_t i = 0; i <= capacityMask_; ++i) {
+      const auto slotKey = keys_[slot];
+      if (slotKey == key) {
+        return values_ + slot;
+      }
+      if (slotKey == kEmptyKey) {
+        return nullptr;
+      }
+      slot = (slot + 1) & capacityMask_;
+    }
+    return nullptr;
+  }
+
+  __host__ __device__ T* keys() const {
+    return keys_;
+  }
+
+  __host__ __device__ int64_t* values() const {
+    return values_;
+  }
+
+ private:
+  __device__ static T compareAndSwap(T* address, T expected, T desired) {
+    if constexpr (sizeof(T) == sizeof(unsigned long long)) {
+      return static_cast<T>(atomicCAS(
+          reinterpret_cast<unsigned long long*>(address),
+          static_cast<unsigned long long>(expected),
+          static_cast<unsigned long long>(desired)));
+    } else {
+      return static_cast<T>(atomicCAS(
+          reinterpret_cast<unsigned int*>(address),
+          static_cast<unsigned int>(expected),
+          static_cast<unsigned int>(desired)));
+    }
+  }
+
+  // Murmur3 finalizer.
+  __device__ static uint64_t hash(T key) {
+    auto h = static_cast<uint64_t>(key);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  T* const keys_;
+  int64_t* const values_;
+  const size_t capacityMask_;
+};
+
+/// Marks all slots of 'table' free and sets their values to 'initialValue'.
+/// This is 0 for sums and -1 for the row chains of joinBuild().
+template <typename T>
+__global__ void clearHashTable(HashTable<T> table, int64_t initialValue) {
+  for (auto i = threadIdx.x + size_t(blockIdx.x) * blockDim.x;
+       i < table.capacity();
+       i += size_t(blockDim.x) * gridDim.x) {
+    table.keys()[i] = HashTable<T>::kEmptyKey;
+    table.values()[i] = initialValue;
+  }
+}
+
+/// Groups by 'keys' and sums 'values' into the values of 'table', which must
+/// be cleared with 0. Sets '*overflow' if the table ran out of slots, in which
+/// case the caller must redo the aggregation on the CPU.
+template <typename T>
+__global__ void aggregateSum(
+    HashTable<T> table,
+    const T* keys,
+    const int64_t* values,
+    size_t numRows,
+    int* overflow) {
+  for (auto i = threadIdx.x + size_t(blockIdx.x) * blockDim.x; i < numRows;
+       i += size_t(blockDim.x) * gridDim.x) {
+    auto* sum = table.insert(keys[i]);
+    if (sum == nullptr) {
+      *overflow = 1;
+      continue;
+    }
+    atomicAdd(
+        reinterpret_cast<unsigned long long*>(sum),
+        static_cast<unsigned long long>(values[i]));
+  }
+}
+
+/// Inserts the build side 'keys' of a hash join, numbered from 'firstRow'.
+/// The table value of a key is the last inserted build row with the key, and
+/// 'nextRows', which has an entry per build row, links each row to the
+/// previous row with the same key. -1 ends the chain, so 'table' must be
+/// cleared with -1.
+template <typename T>
+__global__ void joinBuild(
+    HashTable<T> table,
+    const T* keys,
+    size_t numRows,
+    int64_t firstRow,
+    int64_t* nextRows,
+    int* overflow) {
+  for (auto i = threadIdx.x + size_t(blockIdx.x) * blockDim.x; i < numRows;
+       i += size_t(blockDim.x) * gridDim.x) {
+    auto* head = table.insert(keys[i]);
+    if (head == nullptr) {
+      *overflow = 1;
+      continue;
+    }
+    nextRows[firstRow + i] = static_cast<int64_t>(atomicExch(
+        reinterpret_cast<unsigned long long*>(head),
+        static_cast<unsigned long long>(firstRow + i)));
+  }
+}
+
+/// Writes the number of build rows matching each of the probe side 'keys' to
+/// 'numMatches'. The matching build rows of a probe row are found by following
+/// 'nextRows' from the table value.
+template <typename T>
+__global__ void joinCountMatches(
+    HashTable<T> table,
+    const int64_t* nextRows,
+    const T* keys,
+    size_t numRows,
+    int32_t* numMatches) {
+  for (auto i = threadIdx.x + size_t(blockIdx.x) * blockDim.x; i < numRows;
+       i += size_t(blockDim.x) * gridDim.x) {
+    int32_t count = 0;
+    if (const auto* head = table.find(keys[i])) {
+      for (auto row = *head; row != -1; row = nextRows[row]) {
+        ++count;
+      }
+    }
+    numMatches[i] = count;
+  }
+}
+
+} // namespace facebook::velox::gpu
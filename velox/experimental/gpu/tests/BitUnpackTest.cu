@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <random>
+#include <vector>
+#include "velox/experimental/gpu/BitUnpack.cuh"
+#include "velox/experimental/gpu/Common.h"
+
+DEFINE_int64(num_values, 64 << 20, "Values to unpack");
+DEFINE_int32(max_run_values, 4096, "Maximum values in a bit-packed run");
+DEFINE_int64(
+    batch_bytes,
+    16 << 20,
+    "Packed bytes copied to the device at once");
+DEFINE_bool(validate, true, "Compare the unpacked values with the originals");
+
+constexpr int kBlockSize = 256;
+constexpr int kGridSize = 1024;
+
+namespace facebook::velox::gpu {
+namespace {
+
+struct HostRun {
+  size_t packedOffset;
+  size_t valueOffset;
+  uint32_t numValues;
+  uint8_t bitWidth;
+};
+
+// Appends 'values' packed LSB first in 'bitWidth' bits to 'packed'.
+void pack(
+    const uint32_t* values,
+    uint32_t numValues,
+    uint8_t bitWidth,
+    std::vector<uint8_t>& packed) {
+  const auto start = packed.size();
+  packed.resize(start + (size_t(numValues) * bitWidth + 7) / 8);
+  for (uint32_t i = 0; i < numValues; ++i) {
+    const auto bit = size_t(i) * bitWidth;
+    for (auto b = 0; b < bitWidth; ++b) {
+      if (values[i] >> b & 1) {
+        packed[start + (bit + b) / 8] |= 1 << ((bit + b) % 8);
+      }
+    }
+  }
+}
+
+void testUnpack() {
+  std::mt19937 rng(1);
+  std::vector<uint32_t> expected(FLAGS_num_values);
+  std::vector<uint8_t> packed;
+  std::vector<HostRun> runs;
+  for (size_t valueOffset = 0; valueOffset < FLAGS_num_values;) {
+    HostRun run;
+    run.bitWidth = 1 + rng() % 32;
+    run.numValues = std::min<size_t>(
+        1 + rng() % FLAGS_max_run_values, FLAGS_num_values - valueOffset);
+    run.packedOffset = packed.size();
+    run.valueOffset = valueOffset;
+    const auto mask = run.bitWidth == 32 ? ~0U : (1U << run.bitWidth) - 1;
+    for (uint32_t i = 0; i < run.numValues; ++i) {
+      expected[valueOffset + i] = rng() & mask;
+    }
+    pack(expected.data() + valueOffset, run.numValues, run.bitWidth, packed);
+    valueOffset += run.numValues;
+    runs.push_back(run);
+  }
+
+  // Pinned host memory lets the copies overlap with the kernels.
+  uint8_t* hostPacked;
+  uint32_t* hostValues;
+  CUDA_CHECK_FATAL(cudaMallocHost(&hostPacked, packed.size()));
+  CUDA_CHECK_FATAL(
+      cudaMallocHost(&hostValues, FLAGS_num_values * sizeof(uint32_t)));
+  memcpy(hostPacked, packed.data(), packed.size());
+
+  // Batches start at a run boundary once 'batch_bytes' are reached.
+  std::vector<size_t> batchStarts;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    if (batchStarts.empty() ||
+        runs[i].packedOffset - runs[batchStarts.back()].packedOffset >=
+            FLAGS_batch_bytes) {
+      batchStarts.push_back(i);
+    }
+  }
+  batchStarts.push_back(runs.size());
+  auto packedOffset = [&](size_t run) {
+    return run < runs.size() ? runs[run].packedOffset : packed.size();
+  };
+  auto valueOffset = [&](size_t run) {
+    return run < runs.size() ? runs[run].valueOffset : FLAGS_num_values;
+  };
+  size_t maxBatchBytes = 0;
+  size_t maxBatchValues = 0;
+  size_t maxBatchRuns = 0;
+  for (size_t i = 0; i + 1 < batchStarts.size(); ++i) {
+    const auto first = batchStarts[i];
+    const auto end = batchStarts[i + 1];
+    maxBatchBytes =
+        std::max(maxBatchBytes, packedOffset(end) - packedOffset(first));
+    maxBatchValues =
+        std::max(maxBatchValues, valueOffset(end) - valueOffset(first));
+    maxBatchRuns = std::max(maxBatchRuns, end - first);
+  }
+
+  uint8_t* devicePacked[2];
+  uint32_t* deviceValues[2];
+  BitPackedRun<uint32_t>* deviceRuns[2];
+  BitPackedRun<uint32_t>* hostRuns[2];
+  CudaStream streams[] = {
+      createCudaStream(),
+      createCudaStream(),
+  };
+  for (auto i = 0; i < 2; ++i) {
+    CUDA_CHECK_FATAL(cudaMalloc(&devicePacked[i], maxBatchBytes));
+    CUDA_CHECK_FATAL(
+        cudaMalloc(&deviceValues[i], maxBatchValues * sizeof(uint32_t)));
+    CUDA_CHECK_FATAL(cudaMalloc(
+        &deviceRuns[i], maxBatchRuns * sizeof(BitPackedRun<uint32_t>)));
+    CUDA_CHECK_FATAL(cudaMallocHost(
+        &hostRuns[i], maxBatchRuns * sizeof(BitPackedRun<uint32_t>)));
+  }
+
+  auto start = createCudaEvent();
+  auto stop = createCudaEvent();
+  CUDA_CHECK_FATAL(cudaEventRecord(start.get()));
+  for (size_t batch = 0; batch + 1 < batchStarts.size(); ++batch) {
+    const auto buffer = batch % 2;
+    auto* stream = streams[buffer].get();
+    // The descriptors of this buffer are rewritten below, so wait for the
+    // batch that last used it.
+    CUDA_CHECK_FATAL(cudaStreamSynchronize(stream));
+    const auto firstRun = batchStarts[batch];
+    const auto endRun = batchStarts[batch + 1];
+    const auto firstByte = packedOffset(firstRun);
+    const auto firstValue = valueOffset(firstRun);
+    for (auto r = firstRun; r < endRun; ++r) {
+      const auto& run = runs[r];
+      hostRuns[buffer][r - firstRun] = {
+          devicePacked[buffer] + run.packedOffset - firstByte,
+          deviceValues[buffer] + run.valueOffset - firstValue,
+          run.numValues,
+          run.bitWidth};
+    }
+    const int32_t numRuns = endRun - firstRun;
+    CUDA_CHECK_FATAL(cudaMemcpyAsync(
+        devicePacked[buffer],
+        hostPacked + firstByte,
+        packedOffset(endRun) - firstByte,
+        cudaMemcpyHostToDevice,
+        stream));
+    CUDA_CHECK_FATAL(cudaMemcpyAsync(
+        deviceRuns[buffer],
+        hostRuns[buffer],
+        numRuns * sizeof(BitPackedRun<uint32_t>),
+        cudaMemcpyHostToDevice,
+        stream));
+    unpackRuns<<<kGridSize, kBlockSize, 0, stream>>>(
+        deviceRuns[buffer], numRuns);
+    CUDA_CHECK_FATAL(cudaGetLastError());
+    CUDA_CHECK_FATAL(cudaMemcpyAsync(
+        hostValues + firstValue,
+        deviceValues[buffer],
+        (valueOffset(endRun) - firstValue) * sizeof(uint32_t),
+        cudaMemcpyDeviceToHost,
+        stream));
+  }
+  CUDA_CHECK_FATAL(cudaEventRecord(stop.get()));
+  CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+  float time;
+  CUDA_CHECK_FATAL(cudaEventElapsedTime(&time, start.get(), stop.get()));
+  printf(
+      "Unpacked %ld values in %zu runs from %zu bytes: %.2f GB/s packed, "
+      "%.2f G values/s\n",
+      FLAGS_num_values,
+      runs.size(),
+      packed.size(),
+      packed.size() * 1e-6 / time,
+      FLAGS_num_values * 1e-6 / time);
+
+  if (FLAGS_validate) {
+    for (int64_t i = 0; i < FLAGS_num_values; ++i) {
+      if (hostValues[i] != expected[i]) {
+        fprintf(
+            stderr,
+            "Value %ld is %u, expected %u\n",
+            i,
+            hostValues[i],
+            expected[i]);
+        abort();
+      }
+    }
+  }
+
+  for (auto i = 0; i < 2; ++i) {
+    CUDA_CHECK_LOG(cudaFree(devicePacked[i]));
+    CUDA_CHECK_LOG(cudaFree(deviceValues[i]));
+    CUDA_CHECK_LOG(cudaFree(deviceRuns[i]));
+    CUDA_CHECK_LOG(cudaFreeHost(hostRuns[i]));
+  }
+  CUDA_CHECK_LOG(cudaFreeHost(hostPacked));
+  CUDA_CHECK_LOG(cudaFreeHost(hostValues));
+}
+
+} // namespace
+} // namespace facebook::velox::gpu
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  facebook::velox::gpu::testUnpack();
+  return 0;
+}
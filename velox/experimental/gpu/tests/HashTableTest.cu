@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "velox/experimental/gpu/Common.h"
+#include "velox/experimental/gpu/HashTable.cuh"
+
+DEFINE_int64(num_rows, 64 << 20, "Rows aggregated and probed");
+DEFINE_int64(num_keys, 1 << 20, "Distinct keys");
+DEFINE_int64(batch_rows, 4 << 20, "Rows copied to the device at a time");
+DEFINE_bool(validate, true, "Compare the results with the CPU");
+
+constexpr int kBlockSize = 256;
+constexpr int kGridSize = 1024;
+
+namespace facebook::velox::gpu {
+namespace {
+
+template <typename T>
+CudaPtr<T[]> deviceArray(size_t size) {
+  T* ptr;
+  CUDA_CHECK_FATAL(cudaMalloc(&ptr, size * sizeof(T)));
+  return CudaPtr<T[]>(ptr);
+}
+
+size_t tableCapacity(int64_t numKeys) {
+  // At most half full.
+  size_t capacity = 1;
+  while (capacity < 2 * numKeys) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+// Streams 'hostKeys' and 'hostValues' through two pinned device buffers and
+// calls 'process(deviceKeys, deviceValues, firstRow, numRows, stream)' on one
+// batch while the next one is copied.
+template <typename Process>
+void forEachBatch(
+    const int64_t* hostKeys,
+    const int64_t* hostValues,
+    Process process) {
+  CudaPtr<int64_t[]> keys[] = {
+      deviceArray<int64_t>(FLAGS_batch_rows),
+      deviceArray<int64_t>(FLAGS_batch_rows),
+  };
+  CudaPtr<int64_t[]> values[] = {
+      deviceArray<int64_t>(FLAGS_batch_rows),
+      deviceArray<int64_t>(FLAGS_batch_rows),
+  };
+  CudaStream streams[] = {
+      createCudaStream(),
+      createCudaStream(),
+  };
+  for (int64_t firstRow = 0, i = 0; firstRow < FLAGS_num_rows;
+       firstRow += FLAGS_batch_rows, ++i) {
+    const auto buffer = i % 2;
+    const auto numRows = std::min(FLAGS_batch_rows, FLAGS_num_rows - firstRow);
+    auto* stream = streams[buffer].get();
+    // Work on the same stream is in order, so the copy waits for the previous
+    // kernel on this buffer while the other stream keeps the device busy.
+    CUDA_CHECK_FATAL(cudaMemcpyAsync(
+        keys[buffer].get(),
+        hostKeys + firstRow,
+        numRows * sizeof(int64_t),
+        cudaMemcpyHostToDevice,
+        stream));
+    if (hostValues != nullptr) {
+      CUDA_CHECK_FATAL(cudaMemcpyAsync(
+          values[buffer].get(),
+          hostValues + firstRow,
+          numRows * sizeof(int64_t),
+          cudaMemcpyHostToDevice,
+          stream));
+    }
+    process(
+        keys[buffer].get(), values[buffer].get(), firstRow, numRows, stream);
+  }
+  CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+}
+
+void testAggregation(const int64_t* hostKeys, const int64_t* hostValues) {
+  const auto capacity = tableCapacity(FLAGS_num_keys);
+  auto tableKeys = deviceArray<int64_t>(capacity);
+  auto tableValues = deviceArray<int64_t>(capacity);
+  auto overflow = deviceArray<int>(1);
+  CUDA_CHECK_FATAL(cudaMemset(overflow.get(), 0, sizeof(int)));
+  HashTable<int64_t> table(tableKeys.get(), tableValues.get(), capacity);
+  clearHashTable<<<kGridSize, kBlockSize>>>(table, 0);
+  CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+
+  auto start = createCudaEvent();
+  auto stop = createCudaEvent();
+  CUDA_CHECK_FATAL(cudaEventRecord(start.get()));
+  forEachBatch(
+      hostKeys,
+      hostValues,
+      [&](const int64_t* keys,
+          const int64_t* values,
+          int64_t /*firstRow*/,
+          int64_t numRows,
+          cudaStream_t stream) {
+        aggregateSum<<<kGridSize, kBlockSize, 0, stream>>>(
+            table, keys, values, numRows, overflow.get());
+        CUDA_CHECK_FATAL(cudaGetLastError());
+      });
+  CUDA_CHECK_FATAL(cudaEventRecord(stop.get()));
+  CUDA_CHECK_FATAL(cudaEventSynchronize(stop.get()));
+  float time;
+  CUDA_CHECK_FATAL(cudaEventElapsedTime(&time, start.get(), stop.get()));
+  printf(
+      "Aggregation of %ld rows into %ld keys: %.2f M rows/s\n",
+      FLAGS_num_rows,
+      FLAGS_num_keys,
+      FLAGS_num_rows * 1e-3 / time);
+
+  int hostOverflow;
+  CUDA_CHECK_FATAL(cudaMemcpy(
+      &hostOverflow, overflow.get(), sizeof(int), cudaMemcpyDeviceToHost));
+  if (hostOverflow) {
+    fprintf(stderr, "Hash table overflow\n");
+    abort();
+  }
+  if (!FLAGS_validate) {
+    return;
+  }
+  std::unordered_map<int64_t, int64_t> expected;
+  for (int64_t i = 0; i < FLAGS_num_rows; ++i) {
+    expected[hostKeys[i]] += hostValues[i];
+  }
+  std::vector<int64_t> keys(capacity);
+  std::vector<int64_t> sums(capacity);
+  CUDA_CHECK_FATAL(cudaMemcpy(
+      keys.data(),
+      tableKeys.get(),
+      capacity * sizeof(int64_t),
+      cudaMemcpyDeviceToHost));
+  CUDA_CHECK_FATAL(cudaMemcpy(
+      sums.data(),
+      tableValues.get(),
+      capacity * sizeof(int64_t),
+      cudaMemcpyDeviceToHost));
+  size_t numGroups = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    if (keys[i] == HashTable<int64_t>::kEmptyKey) {
+      continue;
+    }
+    ++numGroups;
+    auto it = expected.find(keys[i]);
+    if (it == expected.end() || it->second != sums[i]) {
+      fprintf(stderr, "Wrong sum for key %ld\n", keys[i]);
+      abort();
+    }
+  }
+  if (numGroups != expected.size()) {
+    fprintf(
+        stderr, "Expected %zu groups, got %zu\n", expected.size(), numGroups);
+    abort();
+  }
+}
+
+void testJoin(const int64_t* hostKeys) {
+  // The build side has each distinct key twice, so each probe row matches 2
+  // build rows.
+  const int64_t numBuildRows = 2 * FLAGS_num_keys;
+  int64_t* buildKeys;
+  CUDA_CHECK_FATAL(cudaMallocHost(&buildKeys, numBuildRows * sizeof(int64_t)));
+  for (int64_t i = 0; i < numBuildRows; ++i) {
+    buildKeys[i] = i % FLAGS_num_keys;
+  }
+  const auto capacity = tableCapacity(FLAGS_num_keys);
+  auto tableKeys = deviceArray<int64_t>(capacity);
+  auto tableValues = deviceArray<int64_t>(capacity);
+  auto nextRows = deviceArray<int64_t>(numBuildRows);
+  auto deviceBuildKeys = deviceArray<int64_t>(numBuildRows);
+  auto overflow = deviceArray<int>(1);
+  CUDA_CHECK_FATAL(cudaMemset(overflow.get(), 0, sizeof(int)));
+  HashTable<int64_t> table(tableKeys.get(), tableValues.get(), capacity);
+  clearHashTable<<<kGridSize, kBlockSize>>>(table, -1);
+  CUDA_CHECK_FATAL(cudaMemcpy(
+      deviceBuildKeys.get(),
+      buildKeys,
+      numBuildRows * sizeof(int64_t),
+      cudaMemcpyHostToDevice));
+  joinBuild<<<kGridSize, kBlockSize>>>(
+      table,
+      deviceBuildKeys.get(),
+      numBuildRows,
+      0,
+      nextRows.get(),
+      overflow.get());
+  CUDA_CHECK_FATAL(cudaGetLastError());
+  CUDA_CHECK_FATAL(cudaDeviceSynchronize());
+
+  int32_t* numMatches;
+  CUDA_CHECK_FATAL(
+      cudaMallocHost(&numMatches, FLAGS_num_rows * sizeof(int32_t)));
+  auto deviceNumMatches = deviceArray<int32_t>(FLAGS_batch_rows * 2);
+  auto start = createCudaEvent();
+  auto stop = createCudaEvent();
+  CUDA_CHECK_FATAL(cudaEventRecord(start.get()));
+  int64_t batch = 0;
+  forEachBatch(
+      hostKeys,
+      nullptr,
+      [&](const int64_t* keys,
+          const int64_t* /*values*/,
+          int64_t firstRow,
+          int64_t numRows,
+          cudaStream_t stream) {
+        auto* matches =
+            deviceNumMatches.get() + (batch++ % 2) * FLAGS_batch_rows;
+        joinCountMatches<<<kGridSize, kBlockSize, 0, stream>>>(
+            table, nextRows.get(), keys, numRows, matches);
+        CUDA_CHECK_FATAL(cudaGetLastError());
+        CUDA_CHECK_FATAL(cudaMemcpyAsync(
+            numMatches + firstRow,
+            matches,
+            numRows * sizeof(int32_t),
+            cudaMemcpyDeviceToHost,
+            stream));
+      });
+  CUDA_CHECK_FATAL(cudaEventRecord(stop.get()));
+  CUDA_CHECK_FATAL(cudaEventSynchronize(stop.get()));
+  float time;
+  CUDA_CHECK_FATAL(cudaEventElapsedTime(&time, start.get(), stop.get()));
+  printf(
+      "Probe of %ld rows against %ld build rows: %.2f M rows/s\n",
+      FLAGS_num_rows,
+      numBuildRows,
+      FLAGS_num_rows * 1e-3 / time);
+
+  if (FLAGS_validate) {
+    for (int64_t i = 0; i < FLAGS_num_rows; ++i) {
+      if (numMatches[i] != 2) {
+        fprintf(stderr, "Row %ld has %d matches\n", i, numMatches[i]);
+        abort();
+      }
+    }
+  }
+  CUDA_CHECK_LOG(cudaFreeHost(numMatches));
+  CUDA_CHECK_LOG(cudaFreeHost(buildKeys));
+}
+
+} // namespace
+} // namespace facebook::velox::gpu
+
+int main(int argc, char** argv) {
+  using namespace facebook::velox::gpu;
+  folly::init(&argc, &argv);
+  // Pinned host memory lets the copies overlap with the kernels.
+  int64_t* keys;
+  int64_t* values;
+  CUDA_CHECK_FATAL(cudaMallocHost(&keys, FLAGS_num_rows * sizeof(int64_t)));
+  CUDA_CHECK_FATAL(cudaMallocHost(&values, FLAGS_num_rows * sizeof(int64_t)));
+  std::mt19937_64 rng(1);
+  for (int64_t i = 0; i < FLAGS_num_rows; ++i) {
+    keys[i] = rng() % FLAGS_num_keys;
+    values[i] = rng() % 1000;
+  }
+  testAggregation(keys, values);
+  testJoin(keys);
+  CUDA_CHECK_LOG(cudaFreeHost(keys));
+  CUDA_CHECK_LOG(cudaFreeHost(values));
+  return 0;
+}
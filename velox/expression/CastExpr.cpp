@@ -16,6 +16,8 @@
 
 #include "velox/expression/CastExpr.h"
 
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 
 #include <fmt/format.h>
@@ -28,6 +30,7 @@
 #include "velox/external/date/tz.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
 #include "velox/type/DecimalUtilOp.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/type/Type.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FunctionVector.h"
@@ -209,6 +212,158 @@ void applyVarCharToDecimalCastKernel(
   });
 }
 
+// Returns true if the 8 little endian bytes in 'word' are all ASCII digits.
+inline bool isEightDigits(uint64_t word) {
+  return ((word & 0xF0F0F0F0F0F0F0F0ULL) |
+          (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+      0x3333333333333333ULL;
+}
+
+// Returns the value of the 8 ASCII digits in 'word', the first digit in the
+// lowest byte. Combines pairs of digits, then pairs of pairs and so on with 3
+// multiplications instead of a loop.
+inline uint32_t parseEightDigits(uint64_t word) {
+  word = ((word & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+  word = ((word & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+  return ((word & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+}
+
+// Appends the digits in [begin, end) to 'value'. Returns false if there is a
+// character other than a digit. The caller limits the number of digits so
+// that 'value' does not overflow.
+inline bool parseDigits(const char* begin, const char* end, uint64_t& value) {
+  for (; end - begin >= 8; begin += 8) {
+    uint64_t word;
+    memcpy(&word, begin, sizeof(word));
+    if (!isEightDigits(word)) {
+      return false;
+    }
+    value = value * 100'000'000 + parseEightDigits(word);
+  }
+  for (; begin < end; ++begin) {
+    const uint8_t digit = *begin - '0';
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  return true;
+}
+
+// The fast paths below accept only the most common format of each type and
+// return false for anything else. The string is then converted by the regular
+// Converter, which accepts the other formats or reports the error. A string
+// accepted by a fast path converts to the same value in the regular path.
+
+// [-]digits, up to 18 digits, within the range of T.
+template <typename T>
+bool tryCastStringToInteger(const StringView& value, T& result) {
+  const char* begin = value.data();
+  const char* end = begin + value.size();
+  const bool negative = begin < end && *begin == '-';
+  begin += negative;
+  if (begin == end || end - begin > 18) {
+    return false;
+  }
+  uint64_t magnitude = 0;
+  if (!parseDigits(begin, end, magnitude)) {
+    return false;
+  }
+  const int64_t number =
+      negative ? -static_cast<int64_t>(magnitude) : magnitude;
+  if (number < std::numeric_limits<T>::min() ||
+      number > std::numeric_limits<T>::max()) {
+    return false;
+  }
+  result = number;
+  return true;
+}
+
+// [-]digits[.digits], up to 15 digits in total. The digits and the power of
+// ten are then exact doubles, so that a single division gives the correctly
+// rounded result.
+bool tryCastStringToDouble(const StringView& value, double& result) {
+  static constexpr double kPowersOfTen[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+      1e13, 1e14, 1e15};
+  const char* begin = value.data();
+  const char* end = begin + value.size();
+  const bool negative = begin < end && *begin == '-';
+  begin += negative;
+  const char* point = static_cast<const char*>(memchr(begin, '.', end - begin));
+  const char* integerEnd = point ? point : end;
+  const int32_t numFractionDigits = point ? end - point - 1 : 0;
+  if (integerEnd == begin || (point && numFractionDigits == 0) ||
+      (integerEnd - begin) + numFractionDigits > 15) {
+    return false;
+  }
+  uint64_t digits = 0;
+  if (!parseDigits(begin, integerEnd, digits) ||
+      (point && !parseDigits(point + 1, end, digits))) {
+    return false;
+  }
+  const double number =
+      static_cast<double>(digits) / kPowersOfTen[numFractionDigits];
+  result = negative ? -number : number;
+  return true;
+}
+
+// YYYY-MM-DD.
+bool tryCastStringToDate(const StringView& value, Date& result) {
+  const char* data = value.data();
+  if (value.size() != 10 || data[4] != '-' || data[7] != '-') {
+    return false;
+  }
+  uint64_t year = 0;
+  uint64_t month = 0;
+  uint64_t day = 0;
+  if (!parseDigits(data, data + 4, year) ||
+      !parseDigits(data + 5, data + 7, month) ||
+      !parseDigits(data + 8, data + 10, day) ||
+      !util::isValidDate(year, month, day)) {
+    return false;
+  }
+  result = Date(util::daysSinceEpochFromDate(year, month, day));
+  return true;
+}
+
+template <TypeKind Kind>
+constexpr bool hasFastCastFromString() {
+  return Kind == TypeKind::TINYINT || Kind == TypeKind::SMALLINT ||
+      Kind == TypeKind::INTEGER || Kind == TypeKind::BIGINT ||
+      Kind == TypeKind::DOUBLE || Kind == TypeKind::DATE;
+}
+
+// Converts the strings of 'rows' in the common formats with the fast paths
+// above. Returns the rows left for the regular path.
+template <TypeKind ToKind>
+const SelectivityVector& castFromStringFast(
+    const SelectivityVector& rows,
+    const FlatVector<StringView>& input,
+    FlatVector<typename TypeTraits<ToKind>::NativeType>& result,
+    LocalSelectivityVector& remainingRowsHolder) {
+  using To = typename TypeTraits<ToKind>::NativeType;
+  auto* remainingRows = remainingRowsHolder.get(rows.end(), false);
+  const auto* rawInput = input.rawValues();
+  result.clearNulls(rows);
+  auto* rawResult = result.mutableRawValues();
+  rows.applyToSelected([&](auto row) {
+    bool converted;
+    if constexpr (ToKind == TypeKind::DOUBLE) {
+      converted = tryCastStringToDouble(rawInput[row], rawResult[row]);
+    } else if constexpr (ToKind == TypeKind::DATE) {
+      converted = tryCastStringToDate(rawInput[row], rawResult[row]);
+    } else {
+      converted = tryCastStringToInteger<To>(rawInput[row], rawResult[row]);
+    }
+    if (!converted) {
+      remainingRows->setValid(row, true);
+    }
+  });
+  remainingRows->updateBounds();
+  return *remainingRows;
+}
+
 template <TypeKind ToKind, TypeKind FromKind>
 void applyCastPrimitives(
     const SelectivityVector& rows,
@@ -222,8 +377,26 @@ void applyCastPrimitives(
   const bool isCastIntAllowDecimal = queryConfig.isCastIntAllowDecimal();
   auto* inputSimpleVector = input.as<SimpleVector<From>>();
 
+  // Flat strings in the common formats are converted without the per-row
+  // exception handling. Only the other rows take the regular path.
+  const SelectivityVector* remainingRows = &rows;
+  LocalSelectivityVector remainingRowsHolder(context);
+  if constexpr (
+      FromKind == TypeKind::VARCHAR && hasFastCastFromString<ToKind>()) {
+    if (input.isFlatEncoding()) {
+      remainingRows = &castFromStringFast<ToKind>(
+          rows,
+          *input.asUnchecked<FlatVector<StringView>>(),
+          *resultFlatVector,
+          remainingRowsHolder);
+      if (!remainingRows->hasSelections()) {
+        return;
+      }
+    }
+  }
+
   if (!queryConfig.isCastToIntByTruncate()) {
-    context.applyToSelectedNoThrow(rows, [&](int row) {
+    context.applyToSelectedNoThrow(*remainingRows, [&](int row) {
       try {
         // Passing a false truncate flag
         if (isCastIntAllowDecimal) {
@@ -248,7 +421,7 @@ void applyCastPrimitives(
       }
     });
   } else {
-    context.applyToSelectedNoThrow(rows, [&](int row) {
+    context.applyToSelectedNoThrow(*remainingRows, [&](int row) {
       try {
         // Passing a true truncate flag
         if (isCastIntAllowDecimal) {
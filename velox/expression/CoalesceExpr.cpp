@@ -54,7 +54,7 @@ void CoalesceExpr::evalSpecialForm(
 
   exec::LocalDecodedVector decodedVector(context);
   for (int i = 0; i < inputs_.size(); i++) {
-    inputs_[i]->eval(*activeRows, context, result);
+    evalConditionalInput(i, *activeRows, context, result);
 
     if (!result->mayHaveNulls()) {
       // No nulls left.
@@ -34,6 +34,10 @@ class CoalesceExpr : public SpecialForm {
       EvalCtx& context,
       VectorPtr& result) override;
 
+  bool isConditional() const override {
+    return true;
+  }
+
  private:
   void computePropagatesNulls() override {
     propagatesNulls_ = false;
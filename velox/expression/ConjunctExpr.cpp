@@ -95,6 +95,14 @@ void ConjunctExpr::evalSpecialForm(
     const SelectivityVector& rows,
     EvalCtx& context,
     VectorPtr& result) {
+  if (!reorderEnabledChecked_) {
+    reorderEnabled_ = inputs_.size() > 1 &&
+        context.execCtx()
+            ->queryCtx()
+            ->queryConfig()
+            .adaptiveFilterReorderingEnabled();
+    reorderEnabledChecked_ = true;
+  }
   // TODO Revisit error handling
   bool throwOnError = *context.mutableThrowOnError();
   ScopedVarSetter saveError(context.mutableThrowOnError(), false);
@@ -132,7 +140,11 @@ void ConjunctExpr::evalSpecialForm(
       context.swapErrors(errors);
     }
 
-    SelectivityTimer timer(selectivity_[inputOrder_[i]], numActive);
+    // Time the input only if the timing may change the order.
+    std::optional<SelectivityTimer> timer;
+    if (reorderEnabled_) {
+      timer.emplace(selectivity_[inputOrder_[i]], numActive);
+    }
     inputs_[inputOrder_[i]]->eval(*activeRows, context, inputResult);
     if (context.errors()) {
       handleErrors = true;
@@ -151,7 +163,9 @@ void ConjunctExpr::evalSpecialForm(
       activeRows->updateBounds();
     }
     numActive = activeRows->countSelected();
-    selectivity_[inputOrder_[i]].addOutput(numActive);
+    if (reorderEnabled_) {
+      selectivity_[inputOrder_[i]].addOutput(numActive);
+    }
 
     if (!numActive) {
       break;
@@ -159,19 +173,17 @@ void ConjunctExpr::evalSpecialForm(
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
-  if (!reorderEnabledChecked_) {
-    reorderEnabled_ = context.execCtx()
-                          ->queryCtx()
-                          ->queryConfig()
-                          .adaptiveFilterReorderingEnabled();
-    reorderEnabledChecked_ = true;
-  }
   if (reorderEnabled_) {
     maybeReorderInputs();
   }
 }
 
 void ConjunctExpr::maybeReorderInputs() {
+  for (auto& selectivity : selectivity_) {
+    if (selectivity.numIn() > kDecayRows) {
+      selectivity.decay();
+    }
+  }
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
     if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
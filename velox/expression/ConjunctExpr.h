@@ -68,12 +68,17 @@ class ConjunctExpr : public SpecialForm {
       std::vector<VectorPtr>* complexConstants = nullptr) const override;
 
  private:
+  static constexpr uint64_t kDecayRows = 1'000'000;
+
   static TypePtr resolveType(const std::vector<TypePtr>& argTypes);
 
   void computePropagatesNulls() override {
     propagatesNulls_ = false;
   }
 
+  // Puts the inputs that drop the most rows per unit of time first. The
+  // statistics of an input are halved after every kDecayRows rows so that the
+  // order follows changes in the data.
   void maybeReorderInputs();
 
   void updateResult(
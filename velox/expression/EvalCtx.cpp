@@ -179,6 +179,31 @@ void EvalCtx::setErrors(
       [&](auto row) { addError(row, veloxException, errors_); });
 }
 
+namespace {
+VeloxUserError toVeloxUserError(const Status& status) {
+  return VeloxUserError(
+      __FILE__,
+      __LINE__,
+      __FUNCTION__,
+      "",
+      status.message(),
+      error_source::kErrorSourceUser.c_str(),
+      status.code() == StatusCode::kArithmeticError
+          ? error_code::kArithmeticError.c_str()
+          : error_code::kInvalidArgument.c_str(),
+      /* isRetriable */ false);
+}
+} // namespace
+
+void EvalCtx::setStatus(vector_size_t index, const Status& status) {
+  VELOX_DCHECK(!status.ok());
+  if (throwOnError_) {
+    throw toVeloxUserError(status);
+  }
+
+  addError(index, std::make_exception_ptr(toVeloxUserError(status)), errors_);
+}
+
 void EvalCtx::addElementErrorsToTopLevel(
     const SelectivityVector& elementRows,
     const BufferPtr& elementToTopLevelRows,
@@ -219,6 +244,10 @@ VectorPtr EvalCtx::ensureFieldLoaded(
   auto field = getField(index);
   if (isLazyNotLoaded(*field)) {
     const auto& rowsToLoad = isFinalSelection_ ? rows : *finalSelection_;
+    const auto numRowsToLoad = rowsToLoad.countSelected();
+    if (numRowsToLoad < field->size()) {
+      numSkippedLazyRows_ += field->size() - numRowsToLoad;
+    }
 
     LocalDecodedVector holder(*this);
     auto decoded = holder.get();
@@ -18,7 +18,10 @@
 
 #include <functional>
 
+#include <folly/container/F14Map.h>
+
 #include "velox/common/base/Portability.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -65,6 +68,28 @@ class EvalCtx {
 
   VectorPtr ensureFieldLoaded(int32_t index, const SelectivityVector& rows);
 
+  // Number of rows of LazyVectors that were not loaded because no expression
+  // was evaluated on them.
+  uint64_t numSkippedLazyRows() const {
+    return numSkippedLazyRows_;
+  }
+
+  /// Returns the state that the functions evaluated with this context share
+  /// for 'input', e.g. the documents of a JSON vector parsed once for all the
+  /// JSON functions on it. 'kind' is the address of a tag that identifies the
+  /// kind of state. The slot is empty the first time. The context keeps
+  /// 'input' alive so that no other vector takes its address while the state
+  /// is cached.
+  std::shared_ptr<void>& sharedInputState(
+      const VectorPtr& input,
+      const void* kind) {
+    auto& entry = sharedInputStates_[std::make_pair(input.get(), kind)];
+    if (!entry.first) {
+      entry.first = input;
+    }
+    return entry.second;
+  }
+
   void setPeeled(int32_t index, const VectorPtr& vector) {
     if (peeledFields_.size() <= index) {
       peeledFields_.resize(index + 1);
@@ -87,6 +112,11 @@ class EvalCtx {
       const SelectivityVector& rows,
       const std::exception_ptr& exceptionPtr);
 
+  /// Records a non-OK 'status' returned by a function for row 'index'. Throws
+  /// the equivalent VeloxUserError if throwOnError() is true. Otherwise sets
+  /// the error without throwing and catching it.
+  void setStatus(vector_size_t index, const Status& status);
+
   /// Invokes a function on each selected row. Records per-row exceptions by
   /// calling 'setError'. The function must take a single "row" argument of type
   /// vector_size_t and return void.
@@ -304,6 +334,15 @@ class EvalCtx {
   // in a opaque flat vector, which will translate to a
   // std::shared_ptr<std::exception_ptr>.
   ErrorVectorPtr errors_;
+
+  uint64_t numSkippedLazyRows_{0};
+
+  // See sharedInputState(). Maps an input and a kind of state to the input and
+  // the state.
+  folly::F14FastMap<
+      std::pair<const BaseVector*, const void*>,
+      std::pair<VectorPtr, std::shared_ptr<void>>>
+      sharedInputStates_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the an
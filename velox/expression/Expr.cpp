@@ -188,6 +188,16 @@ bool Expr::allSupportFlatNoNullsFastPath(
   return true;
 }
 
+void Expr::countFieldReferences(FieldReferenceCounts& counts) const {
+  if (inputs_.empty() && is<FieldReference>()) {
+    ++counts[static_cast<const FieldReference*>(this)];
+    return;
+  }
+  for (const auto& input : inputs_) {
+    input->countFieldReferences(counts);
+  }
+}
+
 void Expr::computeMetadata() {
   // Compute metadata for all the inputs.
   for (auto& input : inputs_) {
@@ -924,6 +934,7 @@ Expr::PeelEncodingsResult Expr::peelEncodings(
   if (!peeledEncoding) {
     return Expr::PeelEncodingsResult::empty();
   }
+  ++stats_.numPeeledVectors;
 
   // Translate the relevant rows.
   SelectivityVector* newFinalSelection = nullptr;
@@ -1114,6 +1125,10 @@ void Expr::evalWithNulls(
       LocalSelectivityVector nonNullHolder(context);
       if (removeSureNulls(rows, context, nonNullHolder)) {
         ScopedVarSetter noMoreNulls(context.mutableNullsPruned(), true);
+        if (trackCpuUsage_) {
+          stats_.numNullRows +=
+              rows.countSelected() - nonNullHolder.get()->countSelected();
+        }
         if (nonNullHolder.get()->hasSelections()) {
           evalAll(*nonNullHolder.get(), context, result);
         }
@@ -1378,6 +1393,10 @@ void Expr::evalAllImpl(
   // Write non-selected rows in remainingRows as nulls in the result if some
   // rows have been skipped.
   if (remainingRows.mayHaveChanged()) {
+    if (trackCpuUsage_) {
+      stats_.numNullRows +=
+          rows.countSelected() - remainingRows.rows().countSelected();
+    }
     addNulls(rows, remainingRows.rows().asRange().bits(), context, result);
   }
   releaseInputValues(context);
@@ -1414,6 +1433,7 @@ bool Expr::applyFunctionWithPeeling(
   if (!peeledEncoding) {
     return false;
   }
+  ++stats_.numPeeledVectors;
   inputValues_ = std::move(peeledVectors);
   peeledVectors.clear();
 
@@ -1608,6 +1628,13 @@ ExprSet::ExprSet(
     mergeFields(
         distinctFields_, multiplyReferencedFields_, expr->distinctFields());
   }
+  Expr::FieldReferenceCounts fieldReferenceCounts;
+  for (auto& expr : exprs_) {
+    expr->countFieldReferences(fieldReferenceCounts);
+  }
+  for (auto& expr : exprs_) {
+    expr->computeExclusiveFields(fieldReferenceCounts);
+  }
 }
 
 namespace {
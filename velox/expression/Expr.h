@@ -25,6 +25,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/ExprStats.h"
 #include "velox/vector/SimpleVector.h"
 
 /// GFlag used to enable saving input vector and expression SQL on disk in case
@@ -46,32 +47,6 @@ class ExprSet;
 class FieldReference;
 class VectorFunction;
 
-struct ExprStats {
-  /// Requires QueryConfig.exprTrackCpuUsage() to be 'true'.
-  CpuWallTiming timing;
-
-  /// Number of processed rows.
-  uint64_t numProcessedRows{0};
-
-  /// Number of processed vectors / batches. Allows to compute average batch
-  /// size.
-  uint64_t numProcessedVectors{0};
-
-  void add(const ExprStats& other) {
-    timing.add(other.timing);
-    numProcessedRows += other.numProcessedRows;
-    numProcessedVectors += other.numProcessedVectors;
-  }
-
-  std::string toString() const {
-    return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
-        timing.toString(),
-        numProcessedRows,
-        numProcessedVectors);
-  }
-};
-
 /// Maintains a set of rows for evaluation and removes rows with
 /// nulls or errors as needed. Helps to avoid copying SelectivityVector in cases
 /// when evaluation doesn't encounter nulls or errors.
@@ -234,6 +209,22 @@ class Expr {
 
   virtual void computeMetadata();
 
+  /// Number of references to each top-level field in an ExprSet.
+  using FieldReferenceCounts =
+      folly::F14FastMap<const FieldReference*, int32_t>;
+
+  /// Adds the references to top-level fields in this expression and its
+  /// inputs to 'counts'. A common sub-expression is counted once per use.
+  void countFieldReferences(FieldReferenceCounts& counts) const;
+
+  /// Called once all the expressions of an ExprSet are compiled. 'counts' has
+  /// the number of references to each top-level field in the ExprSet.
+  virtual void computeExclusiveFields(const FieldReferenceCounts& counts) {
+    for (auto& input : inputs_) {
+      input->computeExclusiveFields(counts);
+    }
+  }
+
   virtual void reset() {
     sharedSubexprResults_.clear();
   }
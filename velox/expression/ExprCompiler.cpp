@@ -20,6 +20,7 @@
 #include "velox/expression/ConjunctExpr.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/Expr.h"
+#include "velox/expression/ExprRewriteRegistry.h"
 #include "velox/expression/FieldReference.h"
 #include "velox/expression/LambdaExpr.h"
 #include "velox/expression/SimpleFunctionRegistry.h"
@@ -550,6 +551,35 @@ std::unordered_set<std::string> collectFlatteningCandidates(
     return flatteningCandidates;
   });
 }
+
+/// Applies 'rewrites' bottom up to the calls in 'expr'. Does not look into
+/// lambdas, casts or other non-call expressions. Returns 'expr' if nothing
+/// was rewritten.
+TypedExprPtr rewriteExpression(
+    const TypedExprPtr& expr,
+    const std::vector<ExpressionRewrite>& rewrites) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr) {
+    return expr;
+  }
+  std::vector<TypedExprPtr> inputs;
+  inputs.reserve(call->inputs().size());
+  bool inputsRewritten = false;
+  for (const auto& input : call->inputs()) {
+    inputs.push_back(rewriteExpression(input, rewrites));
+    inputsRewritten |= inputs.back() != input;
+  }
+  TypedExprPtr result = inputsRewritten
+      ? std::make_shared<core::CallTypedExpr>(
+            call->type(), std::move(inputs), call->name())
+      : expr;
+  for (const auto& rewrite : rewrites) {
+    if (auto rewritten = rewrite(result)) {
+      return rewritten;
+    }
+  }
+  return result;
+}
 } // namespace
 
 std::vector<std::shared_ptr<Expr>> compileExpressions(
@@ -561,11 +591,23 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  // The rewritten trees must outlive the compilation since the dedup map of
+  // 'scope' refers to their nodes.
+  std::vector<TypedExprPtr> rewrittenSources;
+  if (auto rewrites = expressionRewrites(); !rewrites.empty()) {
+    rewrittenSources.reserve(sources.size());
+    for (const auto& source : sources) {
+      rewrittenSources.push_back(rewriteExpression(source, rewrites));
+    }
+  }
+  const auto& typedExprs =
+      rewrittenSources.empty() ? sources : rewrittenSources;
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(typedExprs);
 
-  for (auto& source : sources) {
+  for (auto& source : typedExprs) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprRewriteRegistry.h"
+
+#include <folly/Synchronized.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+using RewriteList = std::vector<std::pair<std::string, ExpressionRewrite>>;
+
+folly::Synchronized<RewriteList>& rewriteRegistry() {
+  static folly::Synchronized<RewriteList> rewrites;
+  return rewrites;
+}
+} // namespace
+
+void registerExpressionRewrite(
+    const std::string& name,
+    ExpressionRewrite rewrite) {
+  rewriteRegistry().withWLock([&](auto& rewrites) {
+    for (auto& [existingName, existing] : rewrites) {
+      if (existingName == name) {
+        existing = std::move(rewrite);
+        return;
+      }
+    }
+    rewrites.emplace_back(name, std::move(rewrite));
+  });
+}
+
+bool unregisterExpressionRewrite(const std::string& name) {
+  return rewriteRegistry().withWLock([&](auto& rewrites) {
+    for (auto it = rewrites.begin(); it != rewrites.end(); ++it) {
+      if (it->first == name) {
+        rewrites.erase(it);
+        return true;
+      }
+    }
+    return false;
+  });
+}
+
+std::vector<ExpressionRewrite> expressionRewrites() {
+  return rewriteRegistry().withRLock([](const auto& rewrites) {
+    std::vector<ExpressionRewrite> result;
+    result.reserve(rewrites.size());
+    for (const auto& [name, rewrite] : rewrites) {
+      result.push_back(rewrite);
+    }
+    return result;
+  });
+}
+
+} // namespace facebook::velox::exec
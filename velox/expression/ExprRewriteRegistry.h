@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "velox/core/ITypedExpr.h"
+
+namespace facebook::velox::exec {
+
+/// Rewrites a call in an expression tree into an equivalent expression that
+/// evaluates faster, e.g. an OR of several LIKEs on the same string into one
+/// multi-pattern match. Returns nullptr if the rewrite does not apply.
+using ExpressionRewrite =
+    std::function<core::TypedExprPtr(const core::TypedExprPtr&)>;
+
+/// Registers 'rewrite' under 'name', replacing a rewrite registered under the
+/// same name. The ExprCompiler applies the registered rewrites bottom up to
+/// the calls of the expressions it compiles. The first rewrite that applies
+/// to a call replaces the call.
+void registerExpressionRewrite(
+    const std::string& name,
+    ExpressionRewrite rewrite);
+
+/// Removes the rewrite registered under 'name'. Returns false if there is
+/// none.
+bool unregisterExpressionRewrite(const std::string& name);
+
+/// Returns the registered rewrites in the order of registration.
+std::vector<ExpressionRewrite> expressionRewrites();
+
+} // namespace facebook::velox::exec
@@ -116,6 +116,14 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  /// True if the function provides callNullFreeBatch() and all rows can be
+  /// computed with a single call when all arguments are flat without nulls.
+  constexpr bool static nullFreeBatchEligible() {
+    return FUNC::udf_has_callNullFreeBatch && fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN &&
+        allArgsFlatConstantFastPathEligible();
+  }
+
   constexpr bool static allArgsFlatConstantFastPathEligible() {
     return allArgsFlatConstantFastPathEligibleImpl(
         std::make_index_sequence<FUNC::num_args>());
@@ -155,8 +163,9 @@ class SimpleFunctionAdapter : public VectorFunction {
         const TypePtr& outputType,
         EvalCtx& _context,
         VectorPtr& _result,
-        bool isResultReused)
-        : rows{_rows}, context{_context} {
+        bool isResultReused,
+        FUNC& _fn)
+        : rows{_rows}, context{_context}, fn{_fn} {
       // If we're reusing the input, we've already checked that the vector
       // is unique, as is nulls.  We also know the size of the vector is
       // at least as large as the size of rows.
@@ -177,13 +186,25 @@ class SimpleFunctionAdapter : public VectorFunction {
 
     template <typename Callable>
     void applyToSelectedNoThrow(Callable func) {
-      context.template applyToSelectedNoThrow<Callable>(*rows, func);
+      if constexpr (FUNC::udf_has_call_return_status) {
+        // Errors returned by call() are recorded without throwing, so that
+        // TRY masks failing rows without unwinding the stack.
+        context.applyToSelectedNoThrow(*rows, [&](auto row) INLINE_LAMBDA {
+          func(row);
+          if (UNLIKELY(fn.hasError())) {
+            context.setStatus(row, fn.takeError());
+          }
+        });
+      } else {
+        context.template applyToSelectedNoThrow<Callable>(*rows, func);
+      }
     }
 
     const SelectivityVector* rows;
     result_vector_t* result;
     VectorWriter<typename FUNC::return_type> resultWriter;
     EvalCtx& context;
+    FUNC& fn;
     bool allAscii{false};
     bool mayHaveNullsRecursive{false};
   };
@@ -298,7 +319,7 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     ApplyContext applyContext{
-        &rows, outputType, context, *reusableResult, isResultReused};
+        &rows, outputType, context, *reusableResult, isResultReused, *fn_};
 
     // If the function provides an initialize() method and it threw, we set that
     // exception in all active rows and we're done with it.
@@ -331,7 +352,9 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     std::vector<std::optional<LocalDecodedVector>> decoded;
-    if (allPrimitiveArgsFlatConstant(args)) {
+    if (tryApplyNullFreeBatch(applyContext, args)) {
+      // All rows were computed by callNullFreeBatch().
+    } else if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
           allArgsFlatConstantFastPathEligible() && specializeForAllEncodings) {
         unpackSpecializeForAllEncodings<0>(applyContext, args);
@@ -430,6 +453,47 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Computes all rows with one callNullFreeBatch() over the raw values of the
+  // arguments if the function provides it, 'rows' is a contiguous range and
+  // all arguments are flat without nulls. Returns false otherwise.
+  bool tryApplyNullFreeBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    if constexpr (nullFreeBatchEligible()) {
+      if (!applyContext.rows->isAllSelected()) {
+        return false;
+      }
+      for (const auto& arg : args) {
+        if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+          return false;
+        }
+      }
+      applyNullFreeBatch(
+          applyContext, args, std::make_index_sequence<FUNC::num_args>());
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  template <size_t... Is>
+  void applyNullFreeBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    (*fn_).callNullFreeBatch(
+        applyContext.resultWriter.data_,
+        rawFlatValues<Is>(args)...,
+        applyContext.rows->size());
+  }
+
+  template <int32_t POSITION>
+  static const auto* rawFlatValues(const std::vector<VectorPtr>& args) {
+    using type =
+        typename VectorExec::template resolver<arg_at<POSITION>>::in_type;
+    return args[POSITION]->asUnchecked<FlatVector<type>>()->rawValues();
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
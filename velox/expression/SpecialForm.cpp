@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/SpecialForm.h"
+#include "velox/expression/FieldReference.h"
+#include "velox/expression/ScopedVarSetter.h"
+
+namespace facebook::velox::exec {
+
+void SpecialForm::computeExclusiveFields(const FieldReferenceCounts& counts) {
+  Expr::computeExclusiveFields(counts);
+  exclusiveFields_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    FieldReferenceCounts inputCounts;
+    inputs_[i]->countFieldReferences(inputCounts);
+    auto& fields = exclusiveFields_[i];
+    fields.clear();
+    for (const auto& [field, count] : inputCounts) {
+      auto it = counts.find(field);
+      if (it == counts.end() || it->second != count) {
+        fields.clear();
+        break;
+      }
+      fields.push_back(const_cast<FieldReference*>(field));
+    }
+  }
+}
+
+void SpecialForm::evalConditionalInput(
+    int32_t index,
+    const SelectivityVector& rows,
+    EvalCtx& context,
+    VectorPtr& result) {
+  auto& input = inputs_[index];
+  if (context.isFinalSelection() || *context.finalSelection() == rows ||
+      index >= exclusiveFields_.size() ||
+      !std::any_of(
+          exclusiveFields_[index].begin(),
+          exclusiveFields_[index].end(),
+          [&](auto* field) {
+            return isLazyNotLoaded(*context.getField(field->index(context)));
+          })) {
+    input->eval(rows, context, result);
+    return;
+  }
+
+  // Evaluate as if 'rows' were the final selection so that the LazyVectors
+  // are loaded only for 'rows'. The values outside of 'rows' are not loaded,
+  // so the result is copied instead of being moved into 'result'.
+  VectorPtr inputResult;
+  {
+    ScopedVarSetter finalSelection(context.mutableIsFinalSelection(), true);
+    input->eval(rows, context, inputResult);
+  }
+  context.ensureWritable(rows, type(), result);
+  result->copy(inputResult.get(), rows, nullptr);
+  context.releaseVector(inputResult);
+}
+
+} // namespace facebook::velox::exec
@@ -40,5 +40,24 @@ class SpecialForm : public Expr {
   virtual void computePropagatesNulls() {
     VELOX_NYI();
   }
+
+  void computeExclusiveFields(const FieldReferenceCounts& counts) override;
+
+ protected:
+  // Evaluates inputs_[index] on 'rows' and writes the values for 'rows' into
+  // 'result'. Used for the inputs of conditional forms that see only a subset
+  // of the rows. If the input is the only reader of its fields in the ExprSet,
+  // LazyVectors of these fields that are not loaded yet are loaded only for
+  // 'rows', not for the final selection.
+  void evalConditionalInput(
+      int32_t index,
+      const SelectivityVector& rows,
+      EvalCtx& context,
+      VectorPtr& result);
+
+ private:
+  // The fields read by each input if no other expression of the ExprSet reads
+  // them and empty otherwise.
+  std::vector<std::vector<FieldReference*>> exclusiveFields_;
 };
 } // namespace facebook::velox::exec
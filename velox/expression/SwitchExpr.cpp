@@ -86,7 +86,7 @@ void SwitchExpr::evalSpecialForm(
       break;
     }
     // evaluate the case condition
-    inputs_[2 * i]->eval(*remainingRows.get(), context, condition);
+    evalConditionalInput(2 * i, *remainingRows.get(), context, condition);
 
     if (context.errors()) {
       context.deselectErrors(*remainingRows);
@@ -107,7 +107,7 @@ void SwitchExpr::evalSpecialForm(
         nullptr);
     switch (booleanMix) {
       case BooleanMix::kAllTrue:
-        inputs_[2 * i + 1]->eval(*remainingRows.get(), context, result);
+        evalConditionalInput(2 * i + 1, *remainingRows.get(), context, result);
         remainingRows->clearAll();
         continue;
       case BooleanMix::kAllNull:
@@ -124,7 +124,7 @@ void SwitchExpr::evalSpecialForm(
         thenRows.get()->updateBounds();
 
         if (thenRows.get()->hasSelections()) {
-          inputs_[2 * i + 1]->eval(*thenRows.get(), context, result);
+          evalConditionalInput(2 * i + 1, *thenRows.get(), context, result);
           remainingRows.get()->deselect(*thenRows.get());
         }
       }
@@ -135,7 +135,8 @@ void SwitchExpr::evalSpecialForm(
   // Evaluate the "else" clause.
   if (remainingRows.get()->hasSelections()) {
     if (hasElseClause_) {
-      inputs_.back()->eval(*remainingRows.get(), context, result);
+      evalConditionalInput(
+          inputs_.size() - 1, *remainingRows.get(), context, result);
     } else {
       context.ensureWritable(*remainingRows.get(), type(), result);
 
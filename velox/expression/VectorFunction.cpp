@@ -14,9 +14,12 @@
  * limitations under the License.
  */
 #include "velox/expression/VectorFunction.h"
+#include <mutex>
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "folly/container/F14Map.h"
+#include "velox/common/base/BitUtil.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -26,6 +29,110 @@ VectorFunctionMap& vectorFunctionFactories() {
   return factories;
 }
 
+namespace {
+struct SharedFunctionKey {
+  std::string name;
+  std::vector<VectorFunctionArg> args;
+
+  bool operator==(const SharedFunctionKey& other) const {
+    if (name != other.name || args.size() != other.args.size()) {
+      return false;
+    }
+    for (auto i = 0; i < args.size(); ++i) {
+      const auto& arg = args[i];
+      const auto& otherArg = other.args[i];
+      if (*arg.type != *otherArg.type ||
+          (arg.constantValue == nullptr) !=
+              (otherArg.constantValue == nullptr)) {
+        return false;
+      }
+      if (arg.constantValue &&
+          !arg.constantValue->equalValueAt(
+              otherArg.constantValue.get(), 0, 0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+struct SharedFunctionKeyHasher {
+  size_t operator()(const SharedFunctionKey& key) const {
+    auto hash = folly::hasher<std::string>()(key.name);
+    for (const auto& arg : key.args) {
+      hash = bits::hashMix(hash, arg.type->hashKind());
+      if (arg.constantValue) {
+        hash = bits::hashMix(hash, arg.constantValue->hashValueAt(0));
+      }
+    }
+    return hash;
+  }
+};
+
+// Instances of functions that support sharing. The expressions using an
+// instance keep it alive. Expired entries are removed on insert.
+struct SharedFunctions {
+  std::mutex mutex;
+  folly::F14FastMap<
+      SharedFunctionKey,
+      std::weak_ptr<VectorFunction>,
+      SharedFunctionKeyHasher>
+      functions;
+};
+
+SharedFunctions& sharedFunctions() {
+  static SharedFunctions functions;
+  return functions;
+}
+
+// Returns the shared instance of 'name' for 'inputArgs', creating it with
+// 'factory' if no expression uses one.
+std::shared_ptr<VectorFunction> getSharedVectorFunction(
+    const std::string& name,
+    const std::vector<VectorFunctionArg>& inputArgs,
+    const VectorFunctionFactory& factory) {
+  SharedFunctionKey key{name, inputArgs};
+  auto& shared = sharedFunctions();
+  // Creating under the mutex makes concurrent drivers wait for the first one
+  // instead of all repeating the setup.
+  std::lock_guard<std::mutex> l(shared.mutex);
+  auto it = shared.functions.find(key);
+  if (it != shared.functions.end()) {
+    if (auto function = it->second.lock()) {
+      return function;
+    }
+  }
+  auto function = factory(name, inputArgs);
+  if (function == nullptr) {
+    return nullptr;
+  }
+  for (auto entry = shared.functions.begin();
+       entry != shared.functions.end();) {
+    if (entry->second.expired()) {
+      entry = shared.functions.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+  shared.functions[std::move(key)] = function;
+  return function;
+}
+
+// Drops shared instances of 'name' so that a new registration takes effect.
+void removeSharedVectorFunctions(const std::string& name) {
+  auto& shared = sharedFunctions();
+  std::lock_guard<std::mutex> l(shared.mutex);
+  for (auto entry = shared.functions.begin();
+       entry != shared.functions.end();) {
+    if (entry->first.name == name) {
+      entry = shared.functions.erase(entry);
+    } else {
+      ++entry;
+    }
+  }
+}
+} // namespace
+
 std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
     const std::string& name) {
   auto sanitizedName = sanitizeName(name);
@@ -81,7 +188,12 @@ std::shared_ptr<VectorFunction> getVectorFunction(
           auto& functionMap) -> std::shared_ptr<VectorFunction> {
         if (resolveVectorFunction(sanitizedName, inputTypes)) {
           auto functionIterator = functionMap.find(sanitizedName);
-          return functionIterator->second.factory(sanitizedName, inputArgs);
+          const auto& entry = functionIterator->second;
+          if (entry.metadata.supportsSharing) {
+            return getSharedVectorFunction(
+                sanitizedName, inputArgs, entry.factory);
+          }
+          return entry.factory(sanitizedName, inputArgs);
         }
         return nullptr;
       });
@@ -99,6 +211,7 @@ bool registerStatefulVectorFunction(
   auto sanitizedName = sanitizeName(name);
 
   if (overwrite) {
+    removeSharedVectorFunctions(sanitizedName);
     vectorFunctionFactories().withWLock([&](auto& functionMap) {
       // Insert/overwrite.
       functionMap[sanitizedName] = {
@@ -197,6 +197,15 @@ struct VectorFunctionMetadata {
   /// type.
   bool supportsFlattening{false};
 
+  /// Boolean indicating whether an instance created by the factory of a
+  /// stateful function may be used by many expressions on many threads at the
+  /// same time. Such instances are created once for each function name and set
+  /// of argument types and constant values and shared by all expressions that
+  /// call the function with the same arguments. This saves repeating expensive
+  /// setup from constant arguments, e.g. building the hash set of a large IN
+  /// list, in every driver. The function must not modify its state in apply().
+  bool supportsSharing{false};
+
   // TODO Add is-deterministic flag.
 };
 
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/type/Conversions.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 using namespace facebook::velox;
@@ -59,8 +60,81 @@ class CastBenchmark : public functions::test::FunctionBenchmarkBase {
 
     return cnt;
   }
+
+  // Casts 'size' strings made by 'makeString' to 'outputType' in an
+  // expression.
+  size_t doRunFromString(
+      const TypePtr& outputType,
+      const std::function<std::string(vector_size_t)>& makeString) {
+    folly::BenchmarkSuspender suspender;
+    auto rowVector = makeStrings(makeString);
+    auto exprSet = compileExpression(
+        fmt::format("cast(c0 as {})", outputType->toString()),
+        asRowType(rowVector->type()));
+    suspender.dismiss();
+
+    size_t cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      cnt += evaluate(exprSet, rowVector)->size();
+    }
+    return cnt;
+  }
+
+  // Converts the same strings one at a time with util::Converter and
+  // try/catch, like the cast did before the fast paths.
+  template <TypeKind ToKind>
+  size_t doRunConverter(
+      const std::function<std::string(vector_size_t)>& makeString) {
+    folly::BenchmarkSuspender suspender;
+    auto rowVector = makeStrings(makeString);
+    auto* strings = rowVector->childAt(0)->asFlatVector<StringView>();
+    auto result = BaseVector::create<
+        FlatVector<typename TypeTraits<ToKind>::NativeType>>(
+        createScalarType(ToKind), strings->size(), pool());
+    suspender.dismiss();
+
+    size_t cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      for (auto row = 0; row < strings->size(); ++row) {
+        try {
+          result->set(
+              row, util::Converter<ToKind>::cast(strings->valueAt(row)));
+        } catch (const std::exception&) {
+          result->setNull(row, true);
+        }
+      }
+      cnt += strings->size();
+    }
+    return cnt;
+  }
+
+ private:
+  static constexpr vector_size_t kNumStrings = 10'000;
+
+  RowVectorPtr makeStrings(
+      const std::function<std::string(vector_size_t)>& makeString) {
+    std::vector<std::string> strings;
+    strings.reserve(kNumStrings);
+    for (auto i = 0; i < kNumStrings; ++i) {
+      strings.push_back(makeString(i));
+    }
+    return vectorMaker_.rowVector({vectorMaker_.flatVector(strings)});
+  }
 };
 
+std::string bigintString(vector_size_t row) {
+  return std::to_string((row * 7'919LL) * (row % 2 ? -1 : 1) * 1'000'003);
+}
+
+std::string doubleString(vector_size_t row) {
+  return fmt::format("{}.{}", row * 7'919 - 50'000, row % 1'000);
+}
+
+std::string dateString(vector_size_t row) {
+  return fmt::format(
+      "{}-{:02}-{:02}", 1970 + row % 80, 1 + row % 12, 1 + row % 28);
+}
+
 BENCHMARK_MULTI(scalar) {
   folly::BenchmarkSuspender suspender;
   CastBenchmark benchmark;
@@ -69,6 +143,36 @@ BENCHMARK_MULTI(scalar) {
   return benchmark.doRun(INTEGER(), BIGINT());
 }
 
+BENCHMARK_MULTI(varcharToBigint) {
+  CastBenchmark benchmark;
+  return benchmark.doRunFromString(BIGINT(), bigintString);
+}
+
+BENCHMARK_RELATIVE_MULTI(varcharToBigintConverter) {
+  CastBenchmark benchmark;
+  return benchmark.doRunConverter<TypeKind::BIGINT>(bigintString);
+}
+
+BENCHMARK_MULTI(varcharToDouble) {
+  CastBenchmark benchmark;
+  return benchmark.doRunFromString(DOUBLE(), doubleString);
+}
+
+BENCHMARK_RELATIVE_MULTI(varcharToDoubleConverter) {
+  CastBenchmark benchmark;
+  return benchmark.doRunConverter<TypeKind::DOUBLE>(doubleString);
+}
+
+BENCHMARK_MULTI(varcharToDate) {
+  CastBenchmark benchmark;
+  return benchmark.doRunFromString(DATE(), dateString);
+}
+
+BENCHMARK_RELATIVE_MULTI(varcharToDateConverter) {
+  CastBenchmark benchmark;
+  return benchmark.doRunConverter<TypeKind::DATE>(dateString);
+}
+
 BENCHMARK_MULTI(renameSmallStruct) {
   folly::BenchmarkSuspender suspender;
   CastBenchmark benchmark;
@@ -433,6 +433,83 @@ TEST_F(CastExprTest, date) {
       "date", inputWrongFormat, nullResult, true, false);
 }
 
+TEST_F(CastExprTest, stringFastPaths) {
+  // The common formats are parsed by the fast paths, the others by the
+  // regular Converter. Both must give the same results.
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"0",
+       "-0",
+       "12345678",
+       "-123456789012",
+       "999999999999999999",
+       "-999999999999999999",
+       "1000000000000000000",
+       "9223372036854775807",
+       "-9223372036854775808",
+       "00012",
+       std::nullopt},
+      {0,
+       0,
+       12345678,
+       -123456789012,
+       999999999999999999,
+       -999999999999999999,
+       1000000000000000000,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       12,
+       std::nullopt});
+  testCast<std::string, int16_t>(
+      "smallint",
+      {"32767", "-32768", "32768", "12345678a", "", "-", "1.5"},
+      {32767,
+       -32768,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+  testCast<std::string, int32_t>(
+      "integer", {"123", "2147483648"}, {123, 0}, true);
+
+  testCast<std::string, double>(
+      "double",
+      {"0",
+       "-0",
+       "1.5",
+       "-123.25",
+       "0.1",
+       "123456789012345",
+       "1234567890.12345",
+       "1234567890.1234567",
+       "1e3",
+       "abc",
+       std::nullopt},
+      {0.0,
+       -0.0,
+       1.5,
+       -123.25,
+       0.1,
+       123456789012345.0,
+       1234567890.12345,
+       1234567890.1234567,
+       1000.0,
+       std::nullopt,
+       std::nullopt},
+      false,
+      true);
+
+  testCast<std::string, Date>(
+      "date",
+      {"2020-02-29", "0001-01-01", "2021-02-29", "2021-13-01", "2021-1a-01"},
+      {Date(18321), Date(-719162), std::nullopt, std::nullopt, std::nullopt},
+      false,
+      true);
+}
+
 TEST_F(CastExprTest, invalidDate) {
   testCast<int8_t, Date>("date", {12}, {Date(0)}, true);
   testCast<int16_t, Date>("date", {1234}, {Date(0)}, true);
@@ -150,6 +150,40 @@ TEST_F(ExprStatsTest, printWithStats) {
   }
 }
 
+TEST_F(ExprStatsTest, nullsAndPeeling) {
+  vector_size_t size = 1'024;
+
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          size, [](auto row) { return row; }, nullEvery(4)),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+  });
+  auto rowType = asRowType(data->type());
+
+  // Rows where c0 is null are not evaluated.
+  {
+    auto exprSet = compileExpressions({"c0 + c1"}, rowType);
+    evaluate(*exprSet, data);
+    auto stats = exprSet->stats();
+    ASSERT_EQ(size / 4, stats.at("plus").numNullRows);
+    ASSERT_EQ(size - size / 4, stats.at("plus").numProcessedRows);
+    ASSERT_EQ(0, stats.at("plus").numPeeledVectors);
+  }
+
+  // The dictionary encoding of the inputs is peeled off.
+  auto indices = makeIndices(size, [](auto row) { return row / 5; });
+  data = makeRowVector({
+      wrapInDictionary(indices, size, data->childAt(0)),
+      wrapInDictionary(indices, size, data->childAt(1)),
+  });
+  {
+    auto exprSet = compileExpressions({"c0 + c1"}, rowType);
+    evaluate(*exprSet, data);
+    auto stats = exprSet->stats();
+    ASSERT_EQ(1, stats.at("plus").numPeeledVectors);
+  }
+}
+
 struct Event {
   std::string uuid;
   std::unordered_map<std::string, exec::ExprStats> stats;
@@ -452,6 +452,65 @@ TEST_F(ExprTest, reorder) {
   }
 }
 
+TEST_F(ExprTest, reorderFollowsData) {
+  constexpr int32_t kBatchSize = 10'000;
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), BIGINT()});
+  auto exprSet = compileExpression("c0 < 100 and c1 < 100", rowType);
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+
+  // Makes a batch where only the input at 'falseInput' drops rows.
+  auto makeBatch = [&](int32_t falseInput) {
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [&](auto row) { return falseInput == 0 && row % 10 ? 1000 : 0; }),
+        makeFlatVector<int64_t>(
+            kBatchSize,
+            [&](auto row) { return falseInput == 1 && row % 10 ? 1000 : 0; }),
+    });
+  };
+
+  auto expected = makeFlatVector<bool>(
+      kBatchSize, [](auto row) { return row % 10 == 0; });
+  auto evaluateBatches = [&](int32_t falseInput) {
+    auto data = makeBatch(falseInput);
+    for (auto i = 0; i < 200; ++i) {
+      assertEqualVectors(expected, evaluate(exprSet.get(), data));
+    }
+  };
+
+  evaluateBatches(0);
+  // The input that drops rows is first.
+  const auto* first = &condition->selectivityAt(0);
+  EXPECT_LT(first->numOut(), first->numIn());
+  EXPECT_EQ(
+      condition->selectivityAt(1).numOut(),
+      condition->selectivityAt(1).numIn());
+
+  // The other input starts dropping the rows and moves to the front.
+  evaluateBatches(1);
+  EXPECT_NE(first, &condition->selectivityAt(0));
+  EXPECT_EQ(first, &condition->selectivityAt(1));
+}
+
+TEST_F(ExprTest, reorderDisabled) {
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kAdaptiveFilterReorderingEnabled, "false"}});
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; })});
+  auto exprSet =
+      compileExpression("c0 % 7 = 0 and c0 < 10", asRowType(data->type()));
+  evaluate(exprSet.get(), data);
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+  for (auto i = 0; i < condition->inputs().size(); ++i) {
+    EXPECT_EQ(0, condition->selectivityAt(i).numIn());
+  }
+}
+
 TEST_F(ExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -1153,6 +1212,37 @@ TEST_F(ExprTest, keepInRegistry) {
       vectorFunction, exec::getVectorFunction("NonExistingFunction", {}, {}));
 }
 
+TEST_F(ExprTest, sharedVectorFunction) {
+  auto inList = [&](std::vector<int64_t> values) {
+    return BaseVector::wrapInConstant(
+        1, 0, makeArrayVector<int64_t>({values}));
+  };
+  const std::vector<TypePtr> types{BIGINT(), ARRAY(BIGINT())};
+
+  // Expressions with the same IN list share the function instance.
+  auto function =
+      exec::getVectorFunction("in", types, {nullptr, inList({1, 2, 3})});
+  ASSERT_TRUE(function != nullptr);
+  ASSERT_EQ(
+      function,
+      exec::getVectorFunction("in", types, {nullptr, inList({1, 2, 3})}));
+
+  auto otherFunction =
+      exec::getVectorFunction("in", types, {nullptr, inList({1, 2, 4})});
+  ASSERT_TRUE(otherFunction != nullptr);
+  ASSERT_NE(function, otherFunction);
+
+  // Functions without the flag get a new instance each time.
+  ASSERT_NE(
+      exec::getVectorFunction("concat", {VARCHAR(), VARCHAR()}, {}),
+      exec::getVectorFunction("concat", {VARCHAR(), VARCHAR()}, {}));
+
+  // An instance no expression uses is not kept.
+  std::weak_ptr<exec::VectorFunction> weakFunction = function;
+  function.reset();
+  ASSERT_TRUE(weakFunction.expired());
+}
+
 TEST_F(ExprTest, lazyVectors) {
   vector_size_t size = 1'000;
 
@@ -1350,15 +1440,15 @@ TEST_F(ExprTest, lazyVectorAccessTwiceInDifferentExpressions) {
 TEST_F(ExprTest, selectiveLazyLoadingIf) {
   const vector_size_t size = 1'000;
 
-  // Evaluate IF expression. Columns under IF must be loaded for "all" rows
-  // because the engine currently doesn't know whether a column is used in a
-  // single branch (then or else) or in both.
+  // Evaluate IF expression. Columns used in both branches are loaded for all
+  // rows of the IF. Columns used only in one branch are loaded only for the
+  // rows of that branch.
   auto valueAt = [](auto row) { return row; };
 
   auto a = makeLazyFlatVector<int64_t>(
       size, valueAt, nullptr, size, [](auto row) { return row; });
   auto b = makeLazyFlatVector<int64_t>(
-      size, valueAt, nullptr, size, [](auto row) { return row; });
+      size, valueAt, nullptr, size / 2, [](auto row) { return row * 2; });
   auto c = makeLazyFlatVector<int64_t>(
       size, valueAt, nullptr, size, [](auto row) { return row; });
 
@@ -1367,6 +1457,55 @@ TEST_F(ExprTest, selectiveLazyLoadingIf) {
   auto expected = makeFlatVector<int64_t>(
       size, [](auto row) { return row % 2 == 0 ? row + row : row / 3; });
   assertEqualVectors(expected, result);
+
+  // A column used in one branch and outside of the IF is loaded for all rows.
+  a = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size, [](auto row) { return row; });
+  b = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size, [](auto row) { return row; });
+  result = evaluate("if (c0 % 2 = 0, c1, 0) + c1", makeRowVector({a, b}));
+  expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 2 == 0 ? row + row : row; });
+  assertEqualVectors(expected, result);
+}
+
+TEST_F(ExprTest, selectiveLazyLoadingSwitchAndCoalesce) {
+  const vector_size_t size = 1'000;
+  auto valueAt = [](auto row) { return row; };
+
+  // Each branch loads its column only for its own rows.
+  auto a = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size, [](auto row) { return row; });
+  auto b = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size / 4, [](auto row) { return row * 4; });
+  auto c = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size / 4, [](auto row) { return row * 4 + 1; });
+  auto d = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size / 2, [](auto row) {
+        return row / 2 * 4 + 2 + row % 2;
+      });
+  auto data = makeRowVector({a, b, c, d});
+  auto exprSet = compileExpression(
+      "case c0 % 4 when 0 then c1 when 1 then c2 * 2 else c3 + 1 end",
+      asRowType(data->type()));
+  exec::EvalCtx context(execCtx_.get(), exprSet.get(), data.get());
+  std::vector<VectorPtr> results(1);
+  exprSet->eval(SelectivityVector(size), context, results);
+  auto expected = makeFlatVector<int64_t>(size, [](auto row) {
+    return row % 4 == 0 ? row : row % 4 == 1 ? row * 2 : row + 1;
+  });
+  assertEqualVectors(expected, results[0]);
+  EXPECT_EQ(size * 2, context.numSkippedLazyRows());
+
+  // The second argument of coalesce is loaded only where the first is null.
+  a = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullEvery(5), size, [](auto row) { return row; });
+  b = makeLazyFlatVector<int64_t>(
+      size, valueAt, nullptr, size / 5, [](auto row) { return row * 5; });
+  auto result = evaluate("coalesce(c0, c1 * 10)", makeRowVector({a, b}));
+  expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row % 5 == 0 ? row * 10 : row; });
+  assertEqualVectors(expected, result);
 }
 
 namespace {
@@ -1109,6 +1109,66 @@ TEST_F(SimpleFunctionTest, testAllNotNull) {
   assertEqualVectors(expected, result);
 }
 
+template <typename T>
+struct BatchPlusFunction {
+  static inline int32_t numBatches{0};
+
+  void call(int64_t& out, int64_t a, int64_t b) {
+    out = a + b;
+  }
+
+  void callNullFreeBatch(
+      int64_t* out,
+      const int64_t* a,
+      const int64_t* b,
+      int32_t size) {
+    ++numBatches;
+    for (auto i = 0; i < size; ++i) {
+      out[i] = a[i] + b[i];
+    }
+  }
+};
+
+// Test that callNullFreeBatch is called only for all rows of flat inputs
+// without nulls.
+TEST_F(SimpleFunctionTest, callNullFreeBatch) {
+  registerFunction<BatchPlusFunction, int64_t, int64_t, int64_t>(
+      {"batch_plus"});
+  auto& numBatches = BatchPlusFunction<exec::VectorExec>::numBatches;
+  auto a = makeFlatVector<int64_t>(100, [](auto row) { return row; });
+  auto b = makeFlatVector<int64_t>(100, [](auto row) { return row * 10; });
+  auto data = makeRowVector({a, b});
+
+  auto result = evaluate("batch_plus(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return row * 11; }), result);
+  EXPECT_EQ(1, numBatches);
+
+  // Constant argument.
+  result = evaluate("batch_plus(c0, 1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return row + 1; }), result);
+  EXPECT_EQ(1, numBatches);
+
+  // A subset of rows.
+  result = evaluate("if(c0 % 2 = 0, batch_plus(c0, c1), 0)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row % 2 == 0 ? row * 11 : 0; }),
+      result);
+  EXPECT_EQ(1, numBatches);
+
+  // Nulls.
+  auto nullable = makeFlatVector<int64_t>(
+      100, [](auto row) { return row; }, nullEvery(3));
+  result = evaluate("batch_plus(c0, c1)", makeRowVector({nullable, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row * 11; }, nullEvery(3)),
+      result);
+  EXPECT_EQ(1, numBatches);
+}
+
 // Test that SimpleFunctionRegistry does not crash in multithreaded environment.
 TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   std::vector<std::thread> threads;
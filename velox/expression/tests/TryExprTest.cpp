@@ -432,4 +432,44 @@ TEST_F(TryExprTest, earlyTerminationWithEmptyRows) {
   assertEqualVectors(
       makeNullableFlatVector<bool>({false, false, std::nullopt}), result);
 }
+
+// Returns the input if it is not empty. Reports an error for empty input
+// through Status instead of throwing.
+template <typename T>
+struct NotEmptyFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  Status call(out_type<Varchar>& out, const arg_type<Varchar>& input) {
+    if (input.empty()) {
+      return Status::UserError("Input is empty");
+    }
+    out = input;
+    return Status::OK();
+  }
+};
+
+TEST_F(TryExprTest, statusErrors) {
+  registerFunction<NotEmptyFunction, Varchar, Varchar>({"not_empty"});
+
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {"a", "", std::nullopt, "a long string value", ""})});
+  auto result = evaluate("try(not_empty(c0))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<StringView>(
+          {"a",
+           std::nullopt,
+           std::nullopt,
+           "a long string value",
+           std::nullopt}),
+      result);
+
+  VELOX_ASSERT_THROW(evaluate("not_empty(c0)", data), "Input is empty");
+
+  // The errors of a conjunct are dropped when the other side decides the
+  // result.
+  result = evaluate("not_empty(c0) = 'a' or c0 = ''", data);
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, std::nullopt, false, true}),
+      result);
+}
 } // namespace facebook::velox
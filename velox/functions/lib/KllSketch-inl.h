@@ -293,6 +293,48 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  if (n_ == 0) {
+    minValue_ = maxValue_ = values[0];
+  }
+  for (const auto& value : values) {
+    minValue_ = std::min(minValue_, value, C());
+    maxValue_ = std::max(maxValue_, value, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  while (i < values.size()) {
+    if (items_.size() < k_ && numLevels() == 1) {
+      const auto count =
+          std::min<size_t>(values.size() - i, k_ - items_.size());
+      items_.insert(
+          items_.end(), values.begin() + i, values.begin() + i + count);
+      levels_[1] += count;
+      i += count;
+    } else if (levels_[0] == 0) {
+      // Level zero is full. Compact and add one value.
+      items_[insertPosition()] = values[i++];
+    } else {
+      // Level zero grows down from levels_[0]. The order of the values in it
+      // does not matter since it is not sorted.
+      const auto count = std::min<size_t>(values.size() - i, levels_[0]);
+      levels_[0] -= count;
+      std::copy(
+          values.begin() + i,
+          values.begin() + i + count,
+          items_.begin() + levels_[0]);
+      i += count;
+    }
+  }
+  n_ += values.size();
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
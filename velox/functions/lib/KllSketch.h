@@ -60,6 +60,12 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add a batch of values to the sketch.  Equivalent to calling
+  /// insert(T) for each value, but copies the values into the free
+  /// space of level zero in runs and only compacts when level zero is
+  /// full.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -70,6 +70,20 @@ BufferPtr toWrapCapture(
   return wrapCapture;
 }
 
+// Returns the indices that align the captures of 'callable' with the nested
+// elements, or nullptr if 'callable' has no captures. Reuses
+// 'elementToTopLevelRows' from getElementToTopLevelRows() for the same rows,
+// which has the same content for the rows 'callable' is applied to, instead of
+// computing it again.
+inline BufferPtr toWrapCapture(
+    const Callable* callable,
+    const BufferPtr& elementToTopLevelRows) {
+  if (!callable->hasCapture()) {
+    return nullptr;
+  }
+  return elementToTopLevelRows;
+}
+
 // Given possibly wrapped array vector, flattens the wrappings and returns a
 // flat array vector. Returns the original vector unmodified if the vector is
 // not wrapped. Flattening is shallow, e.g. elements vector may still be
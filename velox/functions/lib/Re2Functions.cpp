@@ -16,10 +16,15 @@
 #include "velox/functions/lib/Re2Functions.h"
 
 #include <re2/re2.h>
+#include <re2/set.h>
+#include <algorithm>
+#include <functional>
 #include <optional>
 #include <string>
 
+#include "velox/core/Expressions.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 namespace {
@@ -421,6 +426,9 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
 
   bool match(StringView input) const {
     switch (P) {
+      case PatternKind::kSubstring:
+        return substringFinder_.find(std::string_view(input)) !=
+            std::string_view::npos;
       case PatternKind::kExactlyN:
         return input.size() == reducedPatternLength_;
       case PatternKind::kAtLeastN:
@@ -431,6 +439,8 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
         return matchPrefixPattern(input, pattern_, reducedPatternLength_);
       case PatternKind::kSuffix:
         return matchSuffixPattern(input, pattern_, reducedPatternLength_);
+      default:
+        VELOX_UNREACHABLE();
     }
   }
 
@@ -466,8 +476,20 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
   }
 
  private:
+  // Returns the fixed part of a '%fixed%' pattern.
+  static std::string_view fixedSubstring(
+      StringView pattern,
+      vector_size_t length) {
+    std::string_view patternView(pattern);
+    return patternView.substr(patternView.find_first_not_of('%'), length);
+  }
+
   StringView pattern_;
   vector_size_t reducedPatternLength_;
+  const stringCore::SubstringFinder substringFinder_{
+      P == PatternKind::kSubstring
+          ? fixedSubstring(pattern_, reducedPatternLength_)
+          : std::string_view()};
 };
 
 class LikeWithRe2 final : public VectorFunction {
@@ -721,6 +743,224 @@ std::shared_ptr<VectorFunction> makeRe2MatchImpl(
   return kMatchExpr;
 }
 
+// Matches a string against several constant patterns in one pass of an
+// RE2::Set instead of one pass per pattern. Returns true if any pattern
+// matches a substring.
+class Re2SearchAny final : public VectorFunction {
+ public:
+  explicit Re2SearchAny(const std::vector<std::string>& patterns)
+      : set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED) {
+    for (const auto& pattern : patterns) {
+      std::string error;
+      VELOX_USER_CHECK_GE(
+          set_.Add(pattern, &error),
+          0,
+          "invalid regular expression:{}",
+          error);
+    }
+    // The combined automaton may exceed the memory limit of RE2 although
+    // each pattern fits. Then the patterns are matched one by one.
+    if (!set_.Compile()) {
+      for (const auto& pattern : patterns) {
+        regexes_.push_back(std::make_unique<RE2>(pattern, RE2::Quiet));
+        checkForBadPattern(*regexes_.back());
+      }
+    }
+  }
+
+  bool match(StringView input) const {
+    if (regexes_.empty()) {
+      return set_.Match(toStringPiece(input), nullptr);
+    }
+    for (const auto& re : regexes_) {
+      if (re2PartialMatch(input, *re)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_GE(args.size(), 2);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    if (toSearch->isConstantMapping()) {
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
+      return;
+    }
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+      result.set(i, match(toSearch->valueAt<StringView>(i)));
+    });
+  }
+
+ private:
+  RE2::Set set_;
+  // Set if 'set_' could not be compiled.
+  std::vector<std::unique_ptr<RE2>> regexes_;
+};
+
+// Returns the string value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return vector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<std::string>();
+}
+
+// Returns the patterns for Re2SearchAny that are equivalent to 'call', or
+// std::nullopt if 'call' is not a like, search or search any call with
+// constant patterns that can be combined. LIKE patterns that are not
+// generic are left alone since they are matched faster with memcmp.
+std::optional<std::vector<std::string>> toSearchAnyPatterns(
+    const core::CallTypedExpr& call,
+    const std::string& likeName,
+    const std::string& searchName,
+    const std::string& searchAnyName) {
+  const auto& inputs = call.inputs();
+  if (call.name() == searchAnyName) {
+    std::vector<std::string> patterns;
+    for (auto i = 1; i < inputs.size(); ++i) {
+      auto pattern = constantString(inputs[i]);
+      if (!pattern.has_value()) {
+        return std::nullopt;
+      }
+      patterns.push_back(std::move(pattern.value()));
+    }
+    return patterns;
+  }
+  if (inputs.size() != 2 ||
+      (call.name() != likeName && call.name() != searchName)) {
+    return std::nullopt;
+  }
+  auto pattern = constantString(inputs[1]);
+  if (!pattern.has_value()) {
+    return std::nullopt;
+  }
+  if (call.name() == searchName) {
+    // Invalid patterns keep their own call, which raises the error.
+    if (!RE2(pattern.value(), RE2::Quiet).ok()) {
+      return std::nullopt;
+    }
+    return std::vector<std::string>{std::move(pattern.value())};
+  }
+  // Many '%fixed%' disjuncts are still cheaper as one regular expression.
+  const auto patternKind = determinePatternKind(StringView(pattern.value()));
+  if (patternKind.first != PatternKind::kGeneric &&
+      patternKind.first != PatternKind::kSubstring) {
+    return std::nullopt;
+  }
+  bool validPattern;
+  auto regex =
+      likePatternToRe2(StringView(pattern.value()), std::nullopt, validPattern);
+  // LIKE matches '_' and '%' to new lines.
+  return std::vector<std::string>{"(?s)" + regex};
+}
+
+// Replaces the combinable disjuncts of 'expr' on the same string with one
+// call to 'searchAnyName'. Returns nullptr if 'expr' is not an OR with at
+// least 2 combinable disjuncts on the same string.
+core::TypedExprPtr rewriteRe2Disjunction(
+    const core::TypedExprPtr& expr,
+    const std::string& likeName,
+    const std::string& searchName,
+    const std::string& searchAnyName) {
+  static const std::string kOr = "or";
+  auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call == nullptr || call->name() != kOr) {
+    return nullptr;
+  }
+
+  // Combinable disjuncts on the same string.
+  struct Group {
+    core::TypedExprPtr input;
+    std::vector<core::TypedExprPtr> disjuncts;
+    std::vector<std::string> patterns;
+    // Position of the first disjunct in 'disjuncts' below.
+    size_t position;
+  };
+  std::vector<Group> groups;
+  // The disjuncts that are not combinable and a nullptr at the position of
+  // each group.
+  std::vector<core::TypedExprPtr> disjuncts;
+  std::function<void(const core::TypedExprPtr&)> addDisjunct =
+      [&](const core::TypedExprPtr& disjunct) {
+        auto disjunctCall =
+            dynamic_cast<const core::CallTypedExpr*>(disjunct.get());
+        if (disjunctCall == nullptr) {
+          disjuncts.push_back(disjunct);
+          return;
+        }
+        if (disjunctCall->name() == kOr) {
+          for (const auto& input : disjunctCall->inputs()) {
+            addDisjunct(input);
+          }
+          return;
+        }
+        auto patterns = toSearchAnyPatterns(
+            *disjunctCall, likeName, searchName, searchAnyName);
+        if (!patterns.has_value()) {
+          disjuncts.push_back(disjunct);
+          return;
+        }
+        const auto& input = disjunctCall->inputs()[0];
+        auto group = std::find_if(
+            groups.begin(), groups.end(), [&](const auto& other) {
+              return *other.input == *input;
+            });
+        if (group == groups.end()) {
+          groups.push_back({input, {}, {}, disjuncts.size()});
+          disjuncts.push_back(nullptr);
+          group = groups.end() - 1;
+        }
+        group->disjuncts.push_back(disjunct);
+        group->patterns.insert(
+            group->patterns.end(), patterns->begin(), patterns->end());
+      };
+  addDisjunct(expr);
+
+  bool rewritten = false;
+  for (auto& group : groups) {
+    if (group.disjuncts.size() == 1) {
+      disjuncts[group.position] = group.disjuncts[0];
+      continue;
+    }
+    std::vector<core::TypedExprPtr> inputs{group.input};
+    for (auto& pattern : group.patterns) {
+      inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+          VARCHAR(), variant(std::move(pattern))));
+    }
+    disjuncts[group.position] = std::make_shared<core::CallTypedExpr>(
+        BOOLEAN(), std::move(inputs), searchAnyName);
+    rewritten = true;
+  }
+  if (!rewritten) {
+    return nullptr;
+  }
+  if (disjuncts.size() == 1) {
+    return disjuncts[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(), std::move(disjuncts), kOr);
+}
+
 } // namespace
 
 std::shared_ptr<VectorFunction> makeRe2Match(
@@ -753,6 +993,43 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures() {
               .build()};
 }
 
+std::shared_ptr<VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<VectorFunctionArg>& inputArgs) {
+  VELOX_USER_CHECK_GE(
+      inputArgs.size(), 2, "{} requires at least 2 arguments", name);
+  std::vector<std::string> patterns;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    BaseVector* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires the patterns to be non-null constants",
+        name);
+    patterns.push_back(
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<Re2SearchAny>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .variableArity()
+              .build()};
+}
+
+exec::ExpressionRewrite makeRe2DisjunctionRewrite(
+    const std::string& likeName,
+    const std::string& searchName,
+    const std::string& searchAnyName) {
+  return [=](const core::TypedExprPtr& expr) {
+    return rewriteRe2Disjunction(expr, likeName, searchName, searchAnyName);
+  };
+}
+
 std::shared_ptr<VectorFunction> makeRe2Extract(
     const std::string& name,
     const std::vector<VectorFunctionArg>& inputArgs,
@@ -843,6 +1120,9 @@ std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   vector_size_t i = 0;
   // Index of the first % or _ character.
   vector_size_t wildcardStart = -1;
+  // Index of the first % or _ character after the fixed pattern, if the
+  // pattern starts with wildcard characters.
+  vector_size_t secondWildcardStart = -1;
   // Index of the first character that is not % and not _.
   vector_size_t fixedPatternStart = -1;
   // Total number of % characters.
@@ -854,13 +1134,18 @@ std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   while (i < patternLength) {
     if (patternStr[i] == '%' || patternStr[i] == '_') {
       // Ensures that pattern has a single contiguous stream of wildcard
-      // characters.
-      if (wildcardStart != -1) {
+      // characters on each side of the fixed pattern. A second stream
+      // follows the fixed pattern because the streams alternate.
+      if (secondWildcardStart != -1) {
         return std::make_pair(PatternKind::kGeneric, 0);
       }
       // Look till the last contiguous wildcard character, starting from this
       // index, is found, or the end of pattern is reached.
-      wildcardStart = i;
+      if (wildcardStart == -1) {
+        wildcardStart = i;
+      } else {
+        secondWildcardStart = i;
+      }
       while (i < patternLength &&
              (patternStr[i] == '%' || patternStr[i] == '_')) {
         singleCharacterWildcardCount += (patternStr[i] == '_');
@@ -897,6 +1182,9 @@ std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   if (singleCharacterWildcardCount) {
     return {PatternKind::kGeneric, 0};
   }
+  if (secondWildcardStart != -1) {
+    return {PatternKind::kSubstring, secondWildcardStart - fixedPatternStart};
+  }
   // Classify pattern as prefix pattern or suffix pattern based on the
   // positions of the fixed pattern and contiguous wildcard character stream.
   if (fixedPatternStart < wildcardStart) {
@@ -986,6 +1274,10 @@ std::shared_ptr<exec::VectorFunction> makeLike(
       case PatternKind::kSuffix:
         return std::make_shared<OptimizedLikeWithMemcmp<PatternKind::kSuffix>>(
             pattern, reducedLength);
+      case PatternKind::kSubstring:
+        return std::make_shared<
+            OptimizedLikeWithMemcmp<PatternKind::kSubstring>>(
+            pattern, reducedLength);
       default:
         return std::make_shared<LikeWithRe2>(pattern, escapeChar);
     }
@@ -20,6 +20,7 @@
 
 #include <re2/re2.h>
 
+#include "velox/expression/ExprRewriteRegistry.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/Udf.h"
 #include "velox/vector/BaseVector.h"
@@ -39,6 +40,9 @@ enum class PatternKind {
   kPrefix,
   /// Fixed pattern preceded by one or more '%', such as '%foo', '%%%hello'.
   kSuffix,
+  /// Fixed pattern preceded and followed by one or more '%', such as '%foo%',
+  /// '%%hello%'.
+  kSubstring,
   /// Patterns which do not fit any of the above types, such as 'hello_world',
   /// '_presto%'.
   kGeneric,
@@ -71,6 +75,31 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// re2SearchAny(string, pattern, ...) → bool
+///
+/// Returns whether str has a substr that matches any of the constant regex
+/// patterns. The patterns are compiled into one RE2::Set, so that the string
+/// is scanned once for all of them. If a pattern is invalid, throws an
+/// exception.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures();
+
+/// Returns an expression rewrite that replaces the disjuncts of an OR that
+/// match the same string with constant patterns with one call to
+/// 'searchAnyName', a function made by makeRe2SearchAny. The disjuncts are
+/// calls to 'likeName' without an escape character and with a pattern that
+/// is not matched with memcmp, calls to 'searchName' with a valid regex and
+/// calls to 'searchAnyName'. Applies if there are at least 2 of them on one
+/// string. E.g. 'c0 LIKE '%a%' OR c0 LIKE '%b%' OR regexp_like(c0, 'c+')'
+/// is matched in one pass over c0.
+exec::ExpressionRewrite makeRe2DisjunctionRewrite(
+    const std::string& likeName,
+    const std::string& searchName,
+    const std::string& searchAnyName);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
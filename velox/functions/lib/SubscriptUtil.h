@@ -16,12 +16,133 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Type.h"
 #include "velox/vector/NullsBuilder.h"
 
 namespace facebook::velox::functions {
 
+namespace detail {
+
+/// Returns the position of the first element of 'keys[begin, end)' that is
+/// equal to 'key', or -1 if there is none. Compares a batch of keys at a
+/// time.
+template <typename T>
+vector_size_t
+findKey(const T* keys, vector_size_t begin, vector_size_t end, T key) {
+  using Batch = xsimd::batch<T>;
+  const auto searchKey = Batch::broadcast(key);
+  auto offset = begin;
+  for (; offset + static_cast<vector_size_t>(Batch::size) <= end;
+       offset += Batch::size) {
+    const uint64_t hits =
+        simd::toBitMask(Batch::load_unaligned(keys + offset) == searchKey);
+    if (hits) {
+      return offset + __builtin_ctzll(hits);
+    }
+  }
+  for (; offset < end; ++offset) {
+    if (keys[offset] == key) {
+      return offset;
+    }
+  }
+  return -1;
+}
+
+/// Hash indexes over the keys of the maps of one MapVector. Used when a map
+/// may be looked up more than once in a batch, e.g. when the maps are wrapped
+/// in a dictionary or the map is constant. A map gets an index on its second
+/// lookup if it has at least kMinIndexedKeys keys. Maps looked up once and
+/// small maps are scanned instead. Not used for floating point keys, where
+/// equality does not match bitwise hashing.
+template <typename TKey>
+class MapKeyIndex {
+ public:
+  static constexpr vector_size_t kMinIndexedKeys = 16;
+
+  explicit MapKeyIndex(const DecodedVector& keys) : keys_(keys) {}
+
+  /// Returns the offset of the first key equal to 'key' in the map at
+  /// 'mapIndex', whose keys are at [offset, offset + size), or -1 if there
+  /// is none. Calls 'scan()' to look up maps that have no index.
+  template <typename Scan>
+  vector_size_t find(
+      vector_size_t mapIndex,
+      vector_size_t offset,
+      vector_size_t size,
+      const TKey& key,
+      Scan scan) {
+    if (size < kMinIndexedKeys) {
+      return scan();
+    }
+    auto [it, inserted] = tables_.try_emplace(mapIndex);
+    if (inserted) {
+      return scan();
+    }
+    auto& table = it->second;
+    if (table.mask == 0) {
+      build(table, offset, size);
+    }
+    return probe(table, key);
+  }
+
+ private:
+  // Open addressing table of key offsets at [firstSlot, firstSlot + mask]
+  // in 'slots_'. 'mask' is 0 until the table is built.
+  struct Table {
+    vector_size_t firstSlot{0};
+    uint32_t mask{0};
+  };
+
+  static constexpr vector_size_t kEmpty = -1;
+
+  uint32_t hash(const TKey& key) const {
+    return folly::hasher<TKey>()(key);
+  }
+
+  void build(Table& table, vector_size_t offset, vector_size_t size) {
+    const auto capacity = bits::nextPowerOfTwo(2 * size);
+    table.firstSlot = slots_.size();
+    table.mask = capacity - 1;
+    slots_.resize(slots_.size() + capacity, kEmpty);
+    auto* slots = slots_.data() + table.firstSlot;
+    for (auto i = offset; i < offset + size; ++i) {
+      const auto key = keys_.valueAt<TKey>(i);
+      auto slot = hash(key) & table.mask;
+      // Keeps the first of duplicate keys, as the scan would find it.
+      while (slots[slot] != kEmpty &&
+             !(keys_.valueAt<TKey>(slots[slot]) == key)) {
+        slot = (slot + 1) & table.mask;
+      }
+      if (slots[slot] == kEmpty) {
+        slots[slot] = i;
+      }
+    }
+  }
+
+  vector_size_t probe(const Table& table, const TKey& key) const {
+    const auto* slots = slots_.data() + table.firstSlot;
+    auto slot = hash(key) & table.mask;
+    while (slots[slot] != kEmpty) {
+      if (keys_.valueAt<TKey>(slots[slot]) == key) {
+        return slots[slot];
+      }
+      slot = (slot + 1) & table.mask;
+    }
+    return -1;
+  }
+
+  const DecodedVector& keys_;
+  folly::F14FastMap<vector_size_t, Table> tables_;
+  std::vector<vector_size_t> slots_;
+};
+
+} // namespace detail
+
 /// Generic subscript/element_at implementation for both array and map data
 /// types.
 ///
@@ -328,32 +449,61 @@ class SubscriptImpl : public exec::VectorFunction {
     auto rawSizes = baseMap->rawSizes();
     auto rawOffsets = baseMap->rawOffsets();
 
-    // Lambda that does the search for a key, for each row.
-    auto processRow = [&](vector_size_t row, TKey searchKey) {
-      size_t mapIndex = mapIndices[row];
-      size_t offsetStart = rawOffsets[mapIndex];
-      size_t offsetEnd = offsetStart + rawSizes[mapIndex];
-      bool found = false;
-
-      // Sequentially check each key on this map for a match. We use a
-      // sequential scan over the keys because it's easier to express (and
-      // likely has good memory locality), but if we find that this is slow
-      // for large maps we could try to canonicalize the whole vector and binary
-      // search `searchKey`.
-      for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
+    // Flat keys of a primitive type are compared a batch at a time.
+    const TKey* rawKeys = nullptr;
+    if constexpr (std::is_arithmetic_v<TKey>) {
+      if (decodedMapKeys->isIdentityMapping()) {
+        rawKeys = decodedMapKeys->data<TKey>();
+      }
+    }
+
+    // Sequentially checks each key of the map for a match. This has good
+    // memory locality and is fast when each map is looked up once.
+    auto scan = [&](vector_size_t offsetStart,
+                    vector_size_t offsetEnd,
+                    const TKey& searchKey) -> vector_size_t {
+      if constexpr (std::is_arithmetic_v<TKey>) {
+        if (rawKeys) {
+          return detail::findKey(rawKeys, offsetStart, offsetEnd, searchKey);
+        }
+      }
+      for (auto offset = offsetStart; offset < offsetEnd; ++offset) {
         if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
-          rawIndices[row] = offset;
-          found = true;
-          break;
+          return offset;
         }
       }
+      return -1;
+    };
+
+    // When rows may share a map, the maps that are looked up repeatedly get
+    // a hash index over their keys.
+    std::optional<detail::MapKeyIndex<TKey>> keyIndex;
+    if constexpr (!std::is_floating_point_v<TKey>) {
+      if (!decodedMap->isIdentityMapping()) {
+        keyIndex.emplace(*decodedMapKeys);
+      }
+    }
+
+    // Lambda that does the search for a key, for each row.
+    auto processRow = [&](vector_size_t row, TKey searchKey) {
+      const vector_size_t mapIndex = mapIndices[row];
+      const vector_size_t offsetStart = rawOffsets[mapIndex];
+      const vector_size_t size = rawSizes[mapIndex];
+      auto scanMap = [&]() {
+        return scan(offsetStart, offsetStart + size, searchKey);
+      };
+      const auto offset = keyIndex.has_value()
+          ? keyIndex->find(mapIndex, offsetStart, size, searchKey, scanMap)
+          : scanMap();
 
       // NB: We still allow non-existent map keys, even if out of bounds is
       // disabled for arrays.
 
       // Handle NULLs.
-      if (!found) {
+      if (offset == -1) {
         nullsBuilder.setNull(row);
+      } else {
+        rawIndices[row] = offset;
       }
     };
 
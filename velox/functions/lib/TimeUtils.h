@@ -37,23 +37,94 @@ FOLLY_ALWAYS_INLINE const date::time_zone* getTimeZoneFromConfig(
   return nullptr;
 }
 
+// Returns the offset from UTC of 'timeZone' at 'seconds' since the epoch.
+// The offset and the range of time in which it holds are cached per thread,
+// so that consecutive timestamps between the same two transitions of the
+// time zone do not look up the time zone rules.
+FOLLY_ALWAYS_INLINE int64_t
+getTimeZoneOffset(const date::time_zone& timeZone, int64_t seconds) {
+  struct CachedOffset {
+    const date::time_zone* timeZone{nullptr};
+    int64_t begin{0};
+    int64_t end{0};
+    int64_t offset{0};
+  };
+  static thread_local CachedOffset cached;
+  if (cached.timeZone != &timeZone || seconds < cached.begin ||
+      seconds >= cached.end) {
+    const auto info =
+        timeZone.get_info(date::sys_seconds(std::chrono::seconds(seconds)));
+    cached.timeZone = &timeZone;
+    cached.begin = info.begin.time_since_epoch().count();
+    cached.end = info.end.time_since_epoch().count();
+    cached.offset = info.offset.count();
+  }
+  return cached.offset;
+}
+
 FOLLY_ALWAYS_INLINE int64_t
 getSeconds(Timestamp timestamp, const date::time_zone* timeZone) {
   if (timeZone != nullptr) {
-    timestamp.toTimezone(*timeZone);
-    return timestamp.getSeconds();
+    return timestamp.getSeconds() +
+        getTimeZoneOffset(*timeZone, timestamp.getSeconds());
   } else {
     return timestamp.getSeconds();
   }
 }
+
+// Sets the fields of 'dateTime' like gmtime_r() but with integer arithmetic.
+// The date is computed with the days to civil date conversion from
+// http://howardhinnant.github.io/date_algorithms.html. Returns false if the
+// year does not fit in 'tm_year'.
+FOLLY_ALWAYS_INLINE bool toDateTime(int64_t seconds, std::tm& dateTime) {
+  static constexpr int32_t kDaysBeforeMonth[] = {
+      0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+  int64_t days = seconds / kSecondsInDay;
+  int64_t secondsInDay = seconds % kSecondsInDay;
+  if (secondsInDay < 0) {
+    secondsInDay += kSecondsInDay;
+    --days;
+  }
+  // Years start on March 1 so that the leap day is the last day of a year.
+  const int64_t shifted = days + 719'468;
+  const int64_t era = (shifted >= 0 ? shifted : shifted - 146'096) / 146'097;
+  const int64_t dayOfEra = shifted - era * 146'097;
+  const int64_t yearOfEra = (dayOfEra - dayOfEra / 1'460 +
+                             dayOfEra / 36'524 - dayOfEra / 146'096) /
+      365;
+  const int64_t dayOfYear =
+      dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+  const int64_t day = dayOfYear - (153 * shiftedMonth + 2) / 5 + 1;
+  const int64_t month = shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9;
+  const int64_t year = yearOfEra + era * 400 + (month <= 2);
+  if (year - 1900 < std::numeric_limits<int>::min() ||
+      year - 1900 > std::numeric_limits<int>::max()) {
+    return false;
+  }
+  const bool isLeapYear =
+      year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  dateTime = std::tm{};
+  dateTime.tm_sec = secondsInDay % 60;
+  dateTime.tm_min = secondsInDay / 60 % 60;
+  dateTime.tm_hour = secondsInDay / 3'600;
+  dateTime.tm_mday = day;
+  dateTime.tm_mon = month - 1;
+  dateTime.tm_year = year - 1900;
+  // 1970-01-01 is a Thursday.
+  dateTime.tm_wday = (days % kDaysInWeek + kDaysInWeek + 4) % kDaysInWeek;
+  dateTime.tm_yday =
+      kDaysBeforeMonth[month - 1] + day - 1 + (isLeapYear && month > 2);
+  return true;
+}
 } // namespace
 
 FOLLY_ALWAYS_INLINE
 std::tm getDateTime(Timestamp timestamp, const date::time_zone* timeZone) {
   int64_t seconds = getSeconds(timestamp, timeZone);
   std::tm dateTime;
-  VELOX_USER_CHECK_NOT_NULL(
-      gmtime_r((const time_t*)&seconds, &dateTime),
+  VELOX_USER_CHECK(
+      toDateTime(seconds, dateTime),
       "Timestamp is too large: {} seconds since epoch",
       seconds);
   return dateTime;
@@ -63,10 +134,8 @@ FOLLY_ALWAYS_INLINE
 std::tm getDateTime(Date date) {
   int64_t seconds = date.days() * kSecondsInDay;
   std::tm dateTime;
-  VELOX_USER_CHECK_NOT_NULL(
-      gmtime_r((const time_t*)&seconds, &dateTime),
-      "Date is too large: {} days",
-      date.days());
+  VELOX_USER_CHECK(
+      toDateTime(seconds, dateTime), "Date is too large: {} days", date.days());
   return dateTime;
 }
 
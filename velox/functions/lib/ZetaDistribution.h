@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <memory>
 #include <random>
+#include <vector>
 
 #include "velox/common/base/Exceptions.h"
 
@@ -31,31 +33,34 @@ namespace facebook::velox::functions {
 ///
 /// \f[ \zeta(s) = \sum_{i=1}^n \frac{1}{i^s} \f]
 ///
-/// This is mainly used to generate test data with skewed frequencies.
+/// This is mainly used to generate test data with skewed frequencies. Copies
+/// share the CDF, so copying a distribution over many values is cheap.
 struct ZetaDistribution {
-  ZetaDistribution(double s, int n) : cdf_(n) {
+  ZetaDistribution(double s, int n) {
     VELOX_CHECK(s > 1 && n >= 1);
+    std::vector<double> cdf(n);
     double z = 0;
     for (int i = 1; i <= n; ++i) {
       z += pow(i, -s);
-      cdf_[i - 1] = z;
+      cdf[i - 1] = z;
     }
-    cdf_.pop_back();
-    for (double& p : cdf_) {
+    cdf.pop_back();
+    for (double& p : cdf) {
       p /= z;
     }
+    cdf_ = std::make_shared<const std::vector<double>>(std::move(cdf));
   }
 
   template <typename Generator>
   int operator()(Generator& g) {
     double z = uniform_(g);
-    auto it = std::lower_bound(cdf_.begin(), cdf_.end(), z);
-    return 1 + (it - cdf_.begin());
+    auto it = std::lower_bound(cdf_->begin(), cdf_->end(), z);
+    return 1 + (it - cdf_->begin());
   }
 
  private:
   std::uniform_real_distribution<> uniform_{0, 1};
-  std::vector<double> cdf_;
+  std::shared_ptr<const std::vector<double>> cdf_;
 };
 
 } // namespace facebook::velox::functions
@@ -129,6 +129,25 @@ class SimpleNumericAggregate : public exec::Aggregate {
       });
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
+      if (rows.isAllSelected()) {
+        // Updates a copy of the accumulator for each run of rows of a group.
+        exec::Aggregate::forEachGroupRun(
+            groups,
+            rows.begin(),
+            rows.end(),
+            [&](char* group, vector_size_t begin, vector_size_t end) {
+              if constexpr (tableHasNulls) {
+                exec::Aggregate::clearNull(group);
+              }
+              auto* accumulator = exec::Aggregate::value<TData>(group);
+              TData result = *accumulator;
+              for (auto i = begin; i < end; ++i) {
+                updateSingleValue(result, TData(data[i]));
+              }
+              *accumulator = result;
+            });
+        return;
+      }
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<tableHasNulls, TData>(
             groups[i], TData(data[i]), updateSingleValue);
@@ -170,25 +189,53 @@ class SimpleNumericAggregate : public exec::Aggregate {
             rows.countSelected());
         updateNonNullValue<true, TData>(group, initialValue, updateSingleValue);
       }
-    } else if (decoded.mayHaveNulls()) {
-      rows.applyToSelected([&](vector_size_t i) {
-        if (decoded.isNullAt(i)) {
-          return;
-        }
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
-      });
+      return;
+    }
+
+    // The values are reduced into a copy of the accumulator, so that the
+    // loops do not store to the group on every row and can be vectorized.
+    auto* accumulator = exec::Aggregate::value<TData>(group);
+    TData result = *accumulator;
+    bool hasValue = false;
+    if (decoded.mayHaveNulls()) {
+      if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+        auto data = decoded.data<TValue>();
+        auto nulls = decoded.nulls();
+        rows.applyToSelected([&](vector_size_t i) {
+          if (bits::isBitSet(nulls, i)) {
+            updateSingleValue(result, TData(data[i]));
+            hasValue = true;
+          }
+        });
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          if (!decoded.isNullAt(i)) {
+            updateSingleValue(result, TData(decoded.valueAt<TValue>(i)));
+            hasValue = true;
+          }
+        });
+      }
     } else if (decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
       auto data = decoded.data<TValue>();
-      rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(data[i]), updateSingleValue);
-      });
+      if (rows.isAllSelected()) {
+        for (auto i = rows.begin(); i < rows.end(); ++i) {
+          updateSingleValue(result, TData(data[i]));
+        }
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          updateSingleValue(result, TData(data[i]));
+        });
+      }
+      hasValue = rows.hasSelections();
     } else {
       rows.applyToSelected([&](vector_size_t i) {
-        updateNonNullValue<true, TData>(
-            group, TData(decoded.valueAt<TValue>(i)), updateSingleValue);
+        updateSingleValue(result, TData(decoded.valueAt<TValue>(i)));
       });
+      hasValue = rows.hasSelections();
+    }
+    if (hasValue) {
+      exec::Aggregate::clearNull(group);
+      *accumulator = result;
     }
   }
 
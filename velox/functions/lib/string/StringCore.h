@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -47,8 +48,19 @@ namespace stringCore {
 /// Check if a given string is ascii
 static bool isAscii(const char* str, size_t length);
 
+/// Checks a SIMD width of bytes at a time. A byte with the high bit set is
+/// negative as int8_t.
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  using Batch = xsimd::batch<int8_t>;
+  size_t i = 0;
+  for (; i + Batch::size <= length; i += Batch::size) {
+    auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(str + i));
+    if (simd::toBitMask(bytes < Batch::broadcast(0))) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -230,6 +242,58 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
   return size;
 }
 
+/// Finds a fixed needle in strings with SIMD, after the "generic SIMD"
+/// algorithm of Wojciech Mula. Compares the first and the last byte of the
+/// needle with a SIMD width of candidate positions at a time and compares the
+/// rest of the needle only where both match. The needle bytes are broadcast
+/// once at construction, so that a constant needle is set up once for all the
+/// strings it is searched in. The needle is not copied.
+class SubstringFinder {
+ public:
+  explicit SubstringFinder(std::string_view needle)
+      : needle_{needle},
+        first_{Batch::broadcast(needle.empty() ? 0 : needle.front())},
+        last_{Batch::broadcast(needle.empty() ? 0 : needle.back())} {}
+
+  /// Returns the byte index of the first instance of the needle in 'string'
+  /// at or after 'start', or std::string_view::npos if there is none.
+  size_t find(std::string_view string, size_t start = 0) const {
+    const auto size = needle_.size();
+    if (size <= 1 || start >= string.size() ||
+        string.size() - start < size) {
+      // memchr is vectorized for a single byte.
+      return string.find(needle_, start);
+    }
+    const auto* data = reinterpret_cast<const int8_t*>(string.data());
+    // One past the last position where the needle can start.
+    const auto end = string.size() - size + 1;
+    auto i = start;
+    for (; i + Batch::size <= end; i += Batch::size) {
+      auto matches = simd::toBitMask(
+          (Batch::load_unaligned(data + i) == first_) &
+          (Batch::load_unaligned(data + i + size - 1) == last_));
+      while (matches) {
+        const auto position = i + __builtin_ctz(matches);
+        if (memcmp(
+                string.data() + position + 1,
+                needle_.data() + 1,
+                size - 2) == 0) {
+          return position;
+        }
+        matches &= matches - 1;
+      }
+    }
+    return string.find(needle_, i);
+  }
+
+ private:
+  using Batch = xsimd::batch<int8_t>;
+
+  const std::string_view needle_;
+  const Batch first_;
+  const Batch last_;
+};
+
 /// Returns the start byte index of the Nth instance of subString in
 /// string. Search starts from startPosition. Positions start with 0. If not
 /// found, -1 is returned.
@@ -248,7 +312,7 @@ static int64_t findNthInstanceByteIndexFromStart(
     return -1;
   }
 
-  auto byteIndex = string.find(subString, startPosition);
+  auto byteIndex = SubstringFinder(subString).find(string, startPosition);
   // Not found
   if (byteIndex == std::string_view::npos) {
     return -1;
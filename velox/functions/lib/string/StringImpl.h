@@ -321,9 +321,10 @@ FOLLY_ALWAYS_INLINE bool splitPart(
     }
     return false;
   }
+  const SubstringFinder finder(delim);
   while (curPos <= inputSv.size()) {
     size_t start = curPos;
-    curPos = inputSv.find(delim, curPos);
+    curPos = finder.find(inputSv, curPos);
     if (iteration == index) {
       size_t end = curPos;
       if (end == std::string_view::npos) {
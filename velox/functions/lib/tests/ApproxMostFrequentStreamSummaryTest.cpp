@@ -110,6 +110,28 @@ TEST(ApproxMostFrequentStreamSummaryTest, approx) {
   }
 }
 
+TEST(ApproxMostFrequentStreamSummaryTest, insertRun) {
+  // Inserting a run of equal values one by one and at once with the length
+  // of the run as count must give the same summary, also when values are
+  // evicted.
+  constexpr int kCapacity = 20;
+  ZetaDistribution dist(1.01, 1000);
+  std::default_random_engine gen(0);
+  ApproxMostFrequentStreamSummary<int> oneByOne;
+  ApproxMostFrequentStreamSummary<int> runs;
+  oneByOne.setCapacity(kCapacity);
+  runs.setCapacity(kCapacity);
+  for (int i = 0; i < 10'000; ++i) {
+    const int v = dist(gen);
+    const int runLength = 1 + gen() % 5;
+    for (int j = 0; j < runLength; ++j) {
+      oneByOne.insert(v);
+    }
+    runs.insert(v, runLength);
+  }
+  EXPECT_EQ(oneByOne.topK(kCapacity), runs.topK(kCapacity));
+}
+
 TEST(ApproxMostFrequentStreamSummaryTest, serialize) {
   ApproxMostFrequentStreamSummary<int> summary;
   summary.setCapacity(100);
@@ -122,6 +122,28 @@ TEST(KllSketchTest, randomInput) {
   }
 }
 
+TEST(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  constexpr int M = 1001;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+  // Batches of varying size hit the initial fill, the compactions and the
+  // runs in between. The same seed gives the same compactions.
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  for (int i = 0, size = 1; i < N; i += size, size = size * 3 % 1000 + 1) {
+    size = std::min(size, N - i);
+    kll.insert(folly::Range<const double*>(values.data() + i, size));
+  }
+  kll.finish();
+  expected.finish();
+  ASSERT_EQ(kll.totalCount(), N);
+  auto q = linspace(M);
+  EXPECT_EQ(
+      kll.estimateQuantiles(folly::Range(q.begin(), q.end())),
+      expected.estimateQuantiles(folly::Range(q.begin(), q.end())));
+}
+
 TEST(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
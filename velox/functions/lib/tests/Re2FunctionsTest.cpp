@@ -49,6 +49,8 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
         "re2_match", re2MatchSignatures(), makeRe2Match);
     exec::registerStatefulVectorFunction(
         "re2_search", re2SearchSignatures(), makeRe2Search);
+    exec::registerStatefulVectorFunction(
+        "re2_search_any", re2SearchAnySignatures(), makeRe2SearchAny);
     exec::registerStatefulVectorFunction(
         "re2_extract", re2ExtractSignatures(), makeRegexExtract);
     exec::registerStatefulVectorFunction(
@@ -439,6 +441,35 @@ TEST_F(Re2FunctionsTest, likeDeterminePatternKind) {
   testPattern("%%_%aBcD", PatternKind::kGeneric, 0);
   testPattern("%%a%%BcD", PatternKind::kGeneric, 0);
   testPattern("foo%bar", PatternKind::kGeneric, 0);
+
+  testPattern("%presto%", PatternKind::kSubstring, 6);
+  testPattern("%%hello%%%", PatternKind::kSubstring, 5);
+  testPattern("%a%", PatternKind::kSubstring, 1);
+  testPattern("%_a%", PatternKind::kGeneric, 0);
+  testPattern("%a_%", PatternKind::kGeneric, 0);
+  testPattern("%a%b%", PatternKind::kGeneric, 0);
+}
+
+TEST_F(Re2FunctionsTest, likeSubstring) {
+  auto like = [&](const std::string& str, const std::string& pattern) {
+    return evaluateOnce<bool>(
+               fmt::format("like(c0, '{}')", pattern), std::make_optional(str))
+        .value();
+  };
+
+  // Strings longer than a SIMD width with the fixed pattern at the start,
+  // middle and end, and near misses that match only the first and last byte.
+  const std::string filler(70, 'x');
+  EXPECT_TRUE(like("green", "%green%"));
+  EXPECT_TRUE(like("green" + filler, "%green%"));
+  EXPECT_TRUE(like(filler + "green" + filler, "%%green%"));
+  EXPECT_TRUE(like(filler + "green", "%green%%"));
+  EXPECT_FALSE(like(filler + "gren" + filler, "%green%"));
+  EXPECT_FALSE(like(filler + "gxxxn" + filler + "gree", "%green%"));
+  EXPECT_FALSE(like("", "%g%"));
+  EXPECT_TRUE(like(filler + "g", "%g%"));
+  EXPECT_TRUE(like(filler + "gn", "%gn%"));
+  EXPECT_FALSE(like(filler + "g", "%gn%"));
 }
 
 TEST_F(Re2FunctionsTest, likePatternWildcard) {
@@ -855,6 +886,39 @@ TEST_F(Re2FunctionsTest, regexExtractAllBadArgs) {
   EXPECT_THROW(eval("123", "[a-z]+", 1), VeloxException);
 }
 
+TEST_F(Re2FunctionsTest, searchAny) {
+  auto data = makeRowVector({makeNullableFlatVector<std::string>(
+      {"xaay", "b\nc", "zzz", std::nullopt, "prefix-q", "ccc"})});
+  auto expected = makeNullableFlatVector<bool>(
+      {true, true, false, std::nullopt, true, true});
+  const std::string expression =
+      "like(c0, '%aa%') or like(c0, 'b_c') or re2_search(c0, 'c{3}') "
+      "or like(c0, 'prefix%')";
+
+  auto exprSet = compileExpression(expression, asRowType(data->type()));
+  EXPECT_EQ(exprSet->toString().find("re2_search_any"), std::string::npos);
+  assertEqualVectors(expected, evaluate(*exprSet, data));
+
+  // The generic LIKEs and the search are matched together. The prefix LIKE
+  // keeps its own call.
+  exec::registerExpressionRewrite(
+      "re2_search_any",
+      makeRe2DisjunctionRewrite("like", "re2_search", "re2_search_any"));
+  exprSet = compileExpression(expression, asRowType(data->type()));
+  EXPECT_NE(exprSet->toString().find("re2_search_any"), std::string::npos);
+  EXPECT_NE(exprSet->toString().find("prefix%"), std::string::npos);
+  assertEqualVectors(expected, evaluate(*exprSet, data));
+
+  assertEqualVectors(
+      makeNullableFlatVector<bool>(
+          {false, true, true, std::nullopt, false, false}),
+      evaluate("re2_search_any(c0, '^b', 'zz$', 'q{2}')", data));
+  VELOX_ASSERT_THROW(
+      evaluate("re2_search_any(c0, 'a', '(')", data),
+      "invalid regular expression");
+  exec::unregisterExpressionRewrite("re2_search_any");
+}
+
 TEST_F(Re2FunctionsTest, tryException) {
   // Assert we throw without try.
   VELOX_ASSERT_THROW(
@@ -47,6 +47,17 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = plus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -56,6 +67,17 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = minus(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -65,6 +87,17 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = multiply(a[i], b[i]);
+    }
+  }
 };
 
 template <typename T>
@@ -71,6 +71,9 @@ class ArrayDistinctFunction : public exec::VectorFunction {
   }
 
  private:
+  // Arrays up to this size are deduplicated without hashing.
+  static constexpr vector_size_t kMaxLinearSearchSize = 8;
+
   VectorPtr applyFlat(
       const SelectivityVector& rows,
       const VectorPtr& arg,
@@ -105,12 +108,28 @@ class ArrayDistinctFunction : public exec::VectorFunction {
 
       rawOffsets[row] = indicesCursor;
       bool hasNulls = false;
+      T distinct[kMaxLinearSearchSize];
+      vector_size_t numDistinct = 0;
       for (vector_size_t i = offset; i < offset + size; ++i) {
         if (elements->isNullAt(i)) {
           if (!hasNulls) {
             hasNulls = true;
             rawNewIndices[indicesCursor++] = i;
           }
+        } else if (size <= kMaxLinearSearchSize) {
+          // Small arrays compare against the values already added.
+          auto value = elements->valueAt<T>(i);
+          bool found = false;
+          for (auto j = 0; j < numDistinct; ++j) {
+            if (distinct[j] == value) {
+              found = true;
+              break;
+            }
+          }
+          if (!found) {
+            distinct[numDistinct++] = value;
+            rawNewIndices[indicesCursor++] = i;
+          }
         } else {
           auto value = elements->valueAt<T>(i);
 
@@ -120,7 +139,9 @@ class ArrayDistinctFunction : public exec::VectorFunction {
         }
       }
 
-      uniqueSet.clear();
+      if (size > kMaxLinearSearchSize) {
+        uniqueSet.clear();
+      }
       rawSizes[row] = indicesCursor - rawOffsets[row];
     });
 
@@ -35,6 +35,39 @@ struct SetWithNull {
   bool hasNull{false};
   static constexpr vector_size_t kInitialSetSize{128};
 };
+
+// Arrays up to this size are searched linearly instead of building a set for
+// them.
+constexpr vector_size_t kMaxLinearSearchSize = 8;
+
+// Returns true if a non-null element in [offset, offset + size) of 'elements'
+// is equal to 'value'.
+template <typename T>
+bool containsLinear(
+    const DecodedVector& elements,
+    vector_size_t offset,
+    vector_size_t size,
+    const T& value) {
+  for (auto i = offset; i < offset + size; ++i) {
+    if (!elements.isNullAt(i) && elements.valueAt<T>(i) == value) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if [offset, offset + size) of 'elements' has a null.
+inline bool hasNullLinear(
+    const DecodedVector& elements,
+    vector_size_t offset,
+    vector_size_t size) {
+  for (auto i = offset; i < offset + size; ++i) {
+    if (elements.isNullAt(i)) {
+      return true;
+    }
+  }
+  return false;
+}
 // Generates a set based on the elements of an ArrayVector. Note that we take
 // rightSet as a parameter (instead of returning a new one) to reuse the
 // allocated memory.
@@ -158,15 +191,24 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
 
     // Lambda that process each row. This is detached from the code so we can
     // apply it differently based on whether the right-hand side set is constant
-    // or not.
+    // or not. 'rightContains(value)' tells if the right-hand side has 'value'.
+    // Small left-hand side arrays check for duplicates in the output without
+    // 'outputSet'.
     auto processRow = [&](vector_size_t row,
-                          const SetWithNull<T>& rightSet,
+                          bool rightHasNull,
+                          const auto& rightContains,
                           SetWithNull<T>& outputSet) {
       auto idx = decodedLeftArray->index(row);
       auto size = baseLeftArray->sizeAt(idx);
       auto offset = baseLeftArray->offsetAt(idx);
 
-      outputSet.reset();
+      const bool smallOutput = size <= kMaxLinearSearchSize;
+      T output[kMaxLinearSearchSize];
+      vector_size_t numOutput = 0;
+      bool outputHasNull = false;
+      if (!smallOutput) {
+        outputSet.reset();
+      }
       rawNewOffsets[row] = indicesCursor;
 
       // Scans the array elements on the left-hand side.
@@ -175,16 +217,16 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
           // For a NULL value not added to the output row yet, insert in
           // array_intersect if it was found on the rhs (and not found in the
           // case of array_except).
-          if (!outputSet.hasNull) {
+          if (!outputHasNull) {
             bool setNull = false;
             if constexpr (isIntersect) {
-              setNull = rightSet.hasNull;
+              setNull = rightHasNull;
             } else {
-              setNull = !rightSet.hasNull;
+              setNull = !rightHasNull;
             }
             if (setNull) {
               bits::setNull(rawNewElementNulls, indicesCursor++, true);
-              outputSet.hasNull = true;
+              outputHasNull = true;
             }
           }
         } else {
@@ -194,15 +236,21 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
           // (check outputSet).
           bool addValue = false;
           if constexpr (isIntersect) {
-            addValue = rightSet.set.count(val) > 0;
+            addValue = rightContains(val);
           } else {
-            addValue = rightSet.set.count(val) == 0;
+            addValue = !rightContains(val);
+          }
+          if (!addValue) {
+            continue;
           }
-          if (addValue) {
-            auto it = outputSet.set.insert(val);
-            if (it.second) {
+          if (smallOutput) {
+            if (std::find(output, output + numOutput, val) ==
+                output + numOutput) {
+              output[numOutput++] = val;
               rawNewIndices[indicesCursor++] = i;
             }
+          } else if (outputSet.set.insert(val).second) {
+            rawNewIndices[indicesCursor++] = i;
           }
         }
       }
@@ -213,8 +261,12 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
 
     // Optimized case when the right-hand side array is constant.
     if (constantSet_.has_value()) {
+      const auto& rightSet = *constantSet_;
+      auto rightContains = [&](const T& value) {
+        return rightSet.set.count(value) > 0;
+      };
       rows.applyToSelected([&](vector_size_t row) {
-        processRow(row, *constantSet_, outputSet);
+        processRow(row, rightSet.hasNull, rightContains, outputSet);
       });
     }
     // General case when no arrays are constant and both sets need to be
@@ -227,10 +279,27 @@ class ArrayIntersectExceptFunction : public exec::VectorFunction {
           decodeArrayElements(rightHolder, rightElementsHolder, rows);
       SetWithNull<T> rightSet;
       auto rightArrayVector = rightHolder.get()->base()->as<ArrayVector>();
+      auto rightContains = [&](const T& value) {
+        return rightSet.set.count(value) > 0;
+      };
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightHolder.get()->index(row);
+        const auto rightSize = rightArrayVector->sizeAt(idx);
+        if (rightSize <= kMaxLinearSearchSize) {
+          // Small right-hand side arrays are searched without a set.
+          const auto rightOffset = rightArrayVector->offsetAt(idx);
+          processRow(
+              row,
+              hasNullLinear(*decodedRightElements, rightOffset, rightSize),
+              [&](const T& value) {
+                return containsLinear(
+                    *decodedRightElements, rightOffset, rightSize, value);
+              },
+              outputSet);
+          return;
+        }
         generateSet<T>(rightArrayVector, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet, outputSet);
+        processRow(row, rightSet.hasNull, rightContains, outputSet);
       });
     }
 
@@ -280,11 +349,13 @@ class ArraysOverlapFunction : public exec::VectorFunction {
     auto baseLeftArray = decodedLeftArray->base()->as<ArrayVector>();
     context.ensureWritable(rows, BOOLEAN(), result);
     auto resultBoolVector = result->template asFlatVector<bool>();
-    auto processRow = [&](auto row, const SetWithNull<T>& rightSet) {
+    auto processRow = [&](auto row,
+                          bool rightHasNull,
+                          const auto& rightContains) {
       auto idx = decodedLeftArray->index(row);
       auto offset = baseLeftArray->offsetAt(idx);
       auto size = baseLeftArray->sizeAt(idx);
-      bool hasNull = rightSet.hasNull;
+      bool hasNull = rightHasNull;
       for (auto i = offset; i < (offset + size); ++i) {
         // For each element in the current row search for it in the rightSet.
         if (decodedLeftElements->isNullAt(i)) {
@@ -292,7 +363,7 @@ class ArraysOverlapFunction : public exec::VectorFunction {
           hasNull = true;
           continue;
         }
-        if (rightSet.set.count(decodedLeftElements->valueAt<T>(i)) > 0) {
+        if (rightContains(decodedLeftElements->valueAt<T>(i))) {
           // Found an overlapping element. Add to result set.
           resultBoolVector->set(row, true);
           return;
@@ -308,8 +379,13 @@ class ArraysOverlapFunction : public exec::VectorFunction {
     };
 
     if (constantSet_.has_value()) {
-      rows.applyToSelected(
-          [&](vector_size_t row) { processRow(row, *constantSet_); });
+      const auto& rightSet = *constantSet_;
+      auto rightContains = [&](const T& value) {
+        return rightSet.set.count(value) > 0;
+      };
+      rows.applyToSelected([&](vector_size_t row) {
+        processRow(row, rightSet.hasNull, rightContains);
+      });
     }
     // General case when no arrays are constant and both sets need to be
     // computed for each row.
@@ -320,10 +396,26 @@ class ArraysOverlapFunction : public exec::VectorFunction {
           decodeArrayElements(rightDecoder, rightElementsDecoder, rows);
       SetWithNull<T> rightSet;
       auto baseRightArray = rightDecoder.get()->base()->as<ArrayVector>();
+      auto rightContains = [&](const T& value) {
+        return rightSet.set.count(value) > 0;
+      };
       rows.applyToSelected([&](vector_size_t row) {
         auto idx = rightDecoder.get()->index(row);
+        const auto rightSize = baseRightArray->sizeAt(idx);
+        if (rightSize <= kMaxLinearSearchSize) {
+          // Small right-hand side arrays are searched without a set.
+          const auto rightOffset = baseRightArray->offsetAt(idx);
+          processRow(
+              row,
+              hasNullLinear(*decodedRightElements, rightOffset, rightSize),
+              [&](const T& value) {
+                return containsLinear(
+                    *decodedRightElements, rightOffset, rightSize, value);
+              });
+          return;
+        }
         generateSet<T>(baseRightArray, decodedRightElements, idx, rightSet);
-        processRow(row, rightSet);
+        processRow(row, rightSet.hasNull, rightContains);
       });
     }
   }
@@ -64,8 +64,7 @@ class MatchFunction : public exec::VectorFunction {
       ErrorVectorPtr elementErrors;
       auto elementRows =
           toElementRows<ArrayVector>(numElements, *entry.rows, flatArray.get());
-      auto wrapCapture = toWrapCapture<ArrayVector>(
-          numElements, entry.callable, *entry.rows, flatArray);
+      auto wrapCapture = toWrapCapture(entry.callable, elementToTopLevelRows);
       entry.callable->applyNoThrow(
           elementRows,
           finalSelection,
@@ -88,6 +88,112 @@ inline void swapWithNull(
   vector->setNull(index, true);
 }
 
+// Arrays up to this size are sorted by insertion sort, and arrays of up to 4
+// elements by a sorting network. Neither allocates.
+constexpr vector_size_t kMaxInsertionSortSize = 8;
+
+// Arrays of integers with at least this many elements per byte of the
+// integer are radix sorted, e.g. 256 elements for BIGINT.
+constexpr vector_size_t kMinRadixSortSizePerByte = 32;
+
+template <typename T>
+inline void compareSwap(T& a, T& b) {
+  if (b < a) {
+    std::swap(a, b);
+  }
+}
+
+template <typename T>
+void insertionSort(T* values, vector_size_t size) {
+  switch (size) {
+    case 2:
+      compareSwap(values[0], values[1]);
+      return;
+    case 3:
+      compareSwap(values[0], values[1]);
+      compareSwap(values[1], values[2]);
+      compareSwap(values[0], values[1]);
+      return;
+    case 4:
+      compareSwap(values[0], values[1]);
+      compareSwap(values[2], values[3]);
+      compareSwap(values[0], values[2]);
+      compareSwap(values[1], values[3]);
+      compareSwap(values[1], values[2]);
+      return;
+    default:
+      break;
+  }
+  for (vector_size_t i = 1; i < size; ++i) {
+    const T value = values[i];
+    auto j = i;
+    for (; j > 0 && value < values[j - 1]; --j) {
+      values[j] = values[j - 1];
+    }
+    values[j] = value;
+  }
+}
+
+// Sorts 'values' with a least significant byte first radix sort. Skips the
+// bytes that are the same in all values. 'scratch' is reused across arrays.
+template <typename T>
+void radixSort(T* values, vector_size_t size, std::vector<T>& scratch) {
+  using U = std::make_unsigned_t<T>;
+  constexpr int32_t kNumBytes = sizeof(T);
+  // Flipping the sign bit orders signed values as unsigned.
+  constexpr U kSignBit = U(1) << (8 * sizeof(T) - 1);
+  auto byteAt = [](T value, int32_t byte) {
+    return ((static_cast<U>(value) ^ kSignBit) >> (8 * byte)) & 0xff;
+  };
+
+  vector_size_t counts[kNumBytes][256] = {};
+  for (vector_size_t i = 0; i < size; ++i) {
+    for (auto byte = 0; byte < kNumBytes; ++byte) {
+      ++counts[byte][byteAt(values[i], byte)];
+    }
+  }
+
+  if (scratch.size() < static_cast<size_t>(size)) {
+    scratch.resize(size);
+  }
+  T* from = values;
+  T* to = scratch.data();
+  for (auto byte = 0; byte < kNumBytes; ++byte) {
+    auto* byteCounts = counts[byte];
+    if (byteCounts[byteAt(from[0], byte)] == size) {
+      continue;
+    }
+    vector_size_t offset = 0;
+    for (auto i = 0; i < 256; ++i) {
+      const auto count = byteCounts[i];
+      byteCounts[i] = offset;
+      offset += count;
+    }
+    for (vector_size_t i = 0; i < size; ++i) {
+      to[byteCounts[byteAt(from[i], byte)]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  if (from != values) {
+    std::copy(from, from + size, values);
+  }
+}
+
+template <typename T>
+void sortValues(T* values, vector_size_t size, std::vector<T>& scratch) {
+  if (size <= kMaxInsertionSortSize) {
+    insertionSort(values, size);
+    return;
+  }
+  if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t)) {
+    if (size >= kMinRadixSortSizePerByte * static_cast<int32_t>(sizeof(T))) {
+      radixSort(values, size, scratch);
+      return;
+    }
+  }
+  std::sort(values, values + size);
+}
+
 template <TypeKind kind>
 void applyScalarType(
     const SelectivityVector& rows,
@@ -112,6 +218,8 @@ void applyScalarType(
       inputElements.get(), inputElementRows, /*toSourceRow=*/nullptr);
 
   auto flatResults = resultElements->asFlatVector<T>();
+  // Radix sort buffer shared by all rows.
+  std::vector<T> scratch;
 
   auto processRow = [&](vector_size_t row) {
     const auto size = inputArray->sizeAt(row);
@@ -139,7 +247,7 @@ void applyScalarType(
       bits::fillBits(rawBits, endZeroRow, endRow, bits::kNotNull);
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
-      std::sort(resultRawValues + startRow, resultRawValues + endRow);
+      sortValues(resultRawValues + startRow, endRow - startRow, scratch);
     }
   };
   rows.applyToSelected(processRow);
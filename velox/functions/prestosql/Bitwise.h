@@ -25,6 +25,17 @@ struct BitwiseAndFunction {
     result = a & b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      int64_t* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] & b[i];
+    }
+  }
 };
 
 template <typename T>
@@ -57,6 +68,14 @@ struct BitwiseNotFunction {
     result = ~a;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void
+  callNullFreeBatch(int64_t* result, const TInput* a, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = ~a[i];
+    }
+  }
 };
 
 template <typename T>
@@ -66,6 +85,17 @@ struct BitwiseOrFunction {
     result = a | b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      int64_t* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] | b[i];
+    }
+  }
 };
 
 template <typename T>
@@ -75,6 +105,17 @@ struct BitwiseXorFunction {
     result = a ^ b;
     return true;
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callNullFreeBatch(
+      int64_t* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] ^ b[i];
+    }
+  }
 };
 
 template <typename T>
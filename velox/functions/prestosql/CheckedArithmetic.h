@@ -19,60 +19,91 @@
 #include <limits>
 #include "CheckedArithmeticImpl.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/functions/Macros.h"
 
 namespace facebook::velox::functions {
 
+// The checked functions return errors as Status rather than throwing, so that
+// overflows under TRY do not unwind the stack. The messages match
+// facebook::velox::checkedPlus() and friends.
+
 template <typename T>
 struct CheckedPlusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedPlus(a, b);
+    if (UNLIKELY(__builtin_add_overflow(a, b, &result))) {
+      return Status::ArithmeticError("integer overflow: {} + {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedMinusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedMinus(a, b);
+    if (UNLIKELY(__builtin_sub_overflow(a, b, &result))) {
+      return Status::ArithmeticError("integer overflow: {} - {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedMultiplyFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedMultiply(a, b);
+    if (UNLIKELY(__builtin_mul_overflow(a, b, &result))) {
+      return Status::ArithmeticError("integer overflow: {} * {}", a, b);
+    }
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedDivideFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedDivide(a, b);
+    if (UNLIKELY(b == 0)) {
+      return Status::ArithmeticError("division by zero");
+    }
+    if constexpr (std::is_integral_v<TInput>) {
+      if (UNLIKELY(a == std::numeric_limits<TInput>::min() && b == -1)) {
+        return Status::ArithmeticError("integer overflow: {} / {}", a, b);
+      }
+    }
+    result = a / b;
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedModulusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
+    if (UNLIKELY(b == 0)) {
+      return Status::ArithmeticError("Cannot divide by 0");
+    }
     result = checkedModulus(a, b);
+    return Status::OK();
   }
 };
 
 template <typename T>
 struct CheckedNegateFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void call(TInput& result, const TInput& a) {
-    result = checkedNegate(a);
+  FOLLY_ALWAYS_INLINE Status call(TInput& result, const TInput& a) {
+    if (UNLIKELY(a == std::numeric_limits<TInput>::min())) {
+      return Status::ArithmeticError("Cannot negate minimum value");
+    }
+    result = std::negate<TInput>()(a);
+    return Status::OK();
   }
 };
 
@@ -354,9 +354,11 @@ class Multiply {
   template <typename R, typename A, typename B>
   inline static void
   apply(R& r, const A& a, const B& b, uint8_t aRescale, uint8_t bRescale) {
-    r = checkedMultiply<R>(
-        checkedMultiply<R>(R(a), R(b)),
-        R(DecimalUtil::kPowersOfTen[aRescale + bRescale]));
+    r = DecimalUtil::multiply<R>(a, b);
+    if (aRescale + bRescale > 0) {
+      r = DecimalUtil::multiply<R>(
+          r, DecimalUtil::kPowersOfTen[aRescale + bRescale]);
+    }
     DecimalUtil::valueInRange(r);
   }
 
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Filter.h"
 
@@ -139,7 +140,17 @@ std::pair<std::unique_ptr<common::Filter>, bool> createDateValuesFilter(
 class InPredicate : public exec::VectorFunction {
  public:
   explicit InPredicate(std::unique_ptr<common::Filter> filter, bool alwaysNull)
-      : filter_{std::move(filter)}, alwaysNull_(alwaysNull) {}
+      : filter_{std::move(filter)},
+        alwaysNull_(alwaysNull),
+        values_(sortedValues(filter_.get())) {}
+
+  /// IN lists of up to this many integers that would be looked up in a hash
+  /// table are tested by comparing a batch of rows with each value.
+  static constexpr int32_t kMaxSimdValues = 16;
+
+  /// IN lists of up to this many integers that would be looked up in a hash
+  /// table are tested with a branchless binary search of the sorted values.
+  static constexpr int32_t kMaxSortedValues = 512;
 
   static std::shared_ptr<InPredicate> create(
       const std::string& /*name*/,
@@ -181,6 +192,12 @@ class InPredicate : public exec::VectorFunction {
         std::move(filter.first), filter.second);
   }
 
+  // The filter is immutable, so that all drivers can share the instance built
+  // for an IN list.
+  static exec::VectorFunctionMetadata metadata() {
+    return {false /* supportsFlattening */, true /* supportsSharing */};
+  }
+
   // x IN (2, null) returns null when x != 2 and true when x == 2.
   // Null for x always produces null, regardless of 'IN' list.
   bool isDefaultNullBehavior() const override {
@@ -318,6 +335,20 @@ class InPredicate : public exec::VectorFunction {
 
     auto* rawResults = boolResult->mutableRawValues<uint64_t>();
 
+    if constexpr (std::is_integral_v<T>) {
+      if (!values_.empty() && !passOrNull) {
+        testValues(rows, rawValues, rawResults);
+        if (flatArg->mayHaveNulls()) {
+          rows.applyToSelected([&](auto row) {
+            if (flatArg->isNullAt(row)) {
+              boolResult->setNull(row, true);
+            }
+          });
+        }
+        return;
+      }
+    }
+
     if (flatArg->mayHaveNulls() || passOrNull) {
       rows.applyToSelected([&](auto row) {
         if (flatArg->isNullAt(row)) {
@@ -331,6 +362,12 @@ class InPredicate : public exec::VectorFunction {
           }
         }
       });
+    } else if (std::is_same_v<T, StringView> && rows.isAllSelected()) {
+      // Strings are tested in a batch. See Filter::testStringViews.
+      filter_->testStringViews(
+          reinterpret_cast<const StringView*>(rawValues),
+          rows.end(),
+          rawResults);
     } else {
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(rawValues[row]);
@@ -339,13 +376,111 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Returns the values of 'filter' if it is a hash table over few enough
+  // integers to be tested by 'testValues'.
+  static std::vector<int64_t> sortedValues(const common::Filter* filter) {
+    if (filter == nullptr ||
+        filter->kind() != common::FilterKind::kBigintValuesUsingHashTable) {
+      return {};
+    }
+    const auto& values =
+        static_cast<const common::BigintValuesUsingHashTable*>(filter)
+            ->values();
+    if (values.size() > kMaxSortedValues) {
+      return {};
+    }
+    return values;
+  }
+
+  // Returns true if 'value' is in 'values_'. The search has no data dependent
+  // branches, so that it does not suffer from mispredictions.
+  template <typename T>
+  bool testSorted(T value) const {
+    const int64_t* base = values_.data();
+    auto size = values_.size();
+    while (size > 1) {
+      const auto half = size / 2;
+      base = base[half] <= value ? base + half : base;
+      size -= half;
+    }
+    return *base == value;
+  }
+
+  // Sets the bits of 'rawResults' for 'rows' to whether the corresponding
+  // 'rawValues' are in 'values_'. Full words of 64 rows are tested at a time
+  // and only the bits of selected rows are changed.
+  template <typename T>
+  void testValues(
+      const SelectivityVector& rows,
+      const T* rawValues,
+      uint64_t* rawResults) const {
+    const int32_t numValues = values_.size();
+    if (numValues <= kMaxSimdValues) {
+      constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+      xsimd::batch<T> broadcasts[kMaxSimdValues];
+      for (auto i = 0; i < numValues; ++i) {
+        broadcasts[i] = xsimd::broadcast<T>(static_cast<T>(values_[i]));
+      }
+      testWords(rows, rawValues, rawResults, [&](const T* words) {
+        uint64_t result = 0;
+        for (auto i = 0; i < 64; i += kBatchSize) {
+          auto data = xsimd::batch<T>::load_unaligned(words + i);
+          auto hits = data == broadcasts[0];
+          for (auto j = 1; j < numValues; ++j) {
+            hits = hits | (data == broadcasts[j]);
+          }
+          result |= static_cast<uint64_t>(simd::toBitMask(hits)) << i;
+        }
+        return result;
+      });
+    } else {
+      testWords(rows, rawValues, rawResults, [&](const T* words) {
+        uint64_t result = 0;
+        for (auto i = 0; i < 64; ++i) {
+          result |= static_cast<uint64_t>(testSorted(words[i])) << i;
+        }
+        return result;
+      });
+    }
+  }
+
+  // Calls 'testWord' for each word of 64 rows below rows.end() that has a
+  // selected row and merges the returned bits into 'rawResults'. The rows of
+  // the last partial word are tested one by one.
+  template <typename T, typename TestWord>
+  void testWords(
+      const SelectivityVector& rows,
+      const T* rawValues,
+      uint64_t* rawResults,
+      TestWord testWord) const {
+    const auto* selected = rows.asRange().bits();
+    const vector_size_t fullEnd = rows.end() & ~63;
+    for (auto begin = rows.begin() & ~63; begin < fullEnd; begin += 64) {
+      const auto mask = selected[begin / 64];
+      if (mask == 0) {
+        continue;
+      }
+      auto& word = rawResults[begin / 64];
+      word = (word & ~mask) | (testWord(rawValues + begin) & mask);
+    }
+    for (auto row = std::max(fullEnd, rows.begin()); row < rows.end(); ++row) {
+      if (rows.isValid(row)) {
+        bits::setBit(rawResults, row, testSorted(rawValues[row]));
+      }
+    }
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
+  // The sorted values of an integer IN list that is tested with 'testValues'
+  // instead of 'filter_'. Empty if 'filter_' is used.
+  const std::vector<int64_t> values_;
 };
 } // namespace
 
-VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION(
+VELOX_DECLARE_STATEFUL_VECTOR_FUNCTION_WITH_METADATA(
     udf_in,
     InPredicate::signatures(),
+    InPredicate::metadata(),
     InPredicate::create);
 } // namespace facebook::velox::functions
@@ -13,7 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/DecodedArgs.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/json/JsonExtractor.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
@@ -116,6 +118,124 @@ class JsonParseFunction : public exec::VectorFunction {
   }
 };
 
+// Documents of a vector of JSON strings parsed by json_extract_scalar. The
+// documents are parsed on first use and shared by all json_extract_scalar
+// calls on the same vector in an EvalCtx, so that a query extracting several
+// paths from one column parses each document once per batch.
+class ParsedJsonDocuments {
+ public:
+  explicit ParsedJsonDocuments(vector_size_t size)
+      : documents_(size), parsed_(size, false) {}
+
+  // Returns the document at 'index' of the vector, parsing 'json' if this is
+  // the first use. Returns nullptr if 'json' is not valid JSON.
+  const folly::dynamic* document(vector_size_t index, StringView json) {
+    if (!parsed_[index]) {
+      parsed_[index] = true;
+      documents_[index] = parse(json);
+    }
+    return documents_[index].get_pointer();
+  }
+
+  static folly::Optional<folly::dynamic> parse(StringView json) {
+    try {
+      return folly::parseJson(json);
+    } catch (const folly::json::parse_error&) {
+    } catch (const folly::ConversionError&) {
+      // Folly might throw a conversion error while parsing the input json.
+    }
+    return folly::none;
+  }
+
+ private:
+  std::vector<folly::Optional<folly::dynamic>> documents_;
+  std::vector<bool> parsed_;
+};
+
+class JsonExtractScalarVectorFunction : public exec::VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto* json = decodedArgs.at(0);
+    auto* path = decodedArgs.at(1);
+
+    context.ensureWritable(rows, VARCHAR(), result);
+    auto* flatResult = result->asFlatVector<StringView>();
+
+    auto extractScalar = [&](vector_size_t row,
+                             const folly::dynamic* document) {
+      // An invalid document gives null but an invalid path must still
+      // throw, so extract from a null document.
+      static const folly::dynamic kNullDocument = nullptr;
+      auto scalar = functions::jsonExtractScalar(
+          document ? *document : kNullDocument,
+          folly::StringPiece(path->valueAt<StringView>(row)));
+      if (scalar.has_value()) {
+        flatResult->set(row, StringView(*scalar));
+      } else {
+        flatResult->setNull(row, true);
+      }
+    };
+
+    if (json->isConstantMapping()) {
+      folly::Optional<folly::dynamic> document;
+      if (!json->isNullAt(rows.begin())) {
+        document =
+            ParsedJsonDocuments::parse(json->valueAt<StringView>(rows.begin()));
+      }
+      context.applyToSelectedNoThrow(rows, [&](auto row) {
+        if (json->isNullAt(row) || path->isNullAt(row)) {
+          flatResult->setNull(row, true);
+        } else {
+          extractScalar(row, document.get_pointer());
+        }
+      });
+      return;
+    }
+
+    // The documents are cached by the rows of 'args[0]'. Dictionary encoded
+    // inputs share the cache as long as they are the same vector.
+    auto& state = context.sharedInputState(args[0], &kStateKind);
+    if (!state) {
+      state = std::make_shared<ParsedJsonDocuments>(args[0]->size());
+    }
+    auto* documents = static_cast<ParsedJsonDocuments*>(state.get());
+    context.applyToSelectedNoThrow(rows, [&](auto row) {
+      if (json->isNullAt(row) || path->isNullAt(row)) {
+        flatResult->setNull(row, true);
+      } else {
+        extractScalar(
+            row, documents->document(row, json->valueAt<StringView>(row)));
+      }
+    });
+  }
+
+  static std::vector<std::shared_ptr<exec::FunctionSignature>> signatures() {
+    // json, varchar -> varchar
+    // varchar, varchar -> varchar
+    return {
+        exec::FunctionSignatureBuilder()
+            .returnType("varchar")
+            .argumentType("json")
+            .argumentType("varchar")
+            .build(),
+        exec::FunctionSignatureBuilder()
+            .returnType("varchar")
+            .argumentType("varchar")
+            .argumentType("varchar")
+            .build()};
+  }
+
+ private:
+  // Identifies the ParsedJsonDocuments in EvalCtx::sharedInputState().
+  static constexpr char kStateKind{0};
+};
+
 } // namespace
 
 VELOX_DECLARE_VECTOR_FUNCTION(
@@ -127,4 +247,9 @@ VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_parse,
     JsonParseFunction::signatures(),
     std::make_unique<JsonParseFunction>());
+
+VELOX_DECLARE_VECTOR_FUNCTION(
+    udf_json_extract_scalar,
+    JsonExtractScalarVectorFunction::signatures(),
+    std::make_unique<JsonExtractScalarVectorFunction>());
 } // namespace facebook::velox::functions
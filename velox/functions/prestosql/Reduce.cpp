@@ -19,37 +19,37 @@
 namespace facebook::velox::functions {
 namespace {
 
-/// Populates indices of the n-th elements of the arrays.
-/// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
-/// Sets elementIndices[row] to the index of the n-th element in the 'elements'
-/// vector.
+/// Populates indices of the n-th elements of the arrays in 'activeRows', the
+/// rows whose arrays had an (n-1)-th element. Removes the rows whose arrays
+/// have no n-th element from 'activeRows' and 'arrayRows', so that each step
+/// only visits the arrays that have elements left. Sets elementIndices[row] to
+/// the index of the n-th element in the 'elements' vector. The indices of the
+/// other rows keep valid values from earlier steps.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
-    const SelectivityVector& rows,
     vector_size_t n,
+    std::vector<vector_size_t>& activeRows,
     SelectivityVector& arrayRows,
     BufferPtr& elementIndices) {
   auto* rawSizes = arrayVector->rawSizes();
   auto* rawOffsets = arrayVector->rawOffsets();
-  auto* rawNulls = arrayVector->rawNulls();
 
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
-  arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
-
-  rows.applyToSelected([&](auto row) {
-    if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
-      if (n < rawSizes[row]) {
-        arrayRows.setValid(row, true);
-        rawElementIndices[row] = rawOffsets[row] + n;
-      }
+  vector_size_t numActive = 0;
+  for (auto row : activeRows) {
+    if (n < rawSizes[row]) {
+      rawElementIndices[row] = rawOffsets[row] + n;
+      activeRows[numActive++] = row;
+    } else {
+      arrayRows.setValid(row, false);
     }
-  });
+  }
+  activeRows.resize(numActive);
   arrayRows.updateBounds();
 
-  return arrayRows.hasSelections();
+  return numActive > 0;
 }
 
 /// See documentation at
@@ -104,6 +104,7 @@ class ReduceFunction : public exec::VectorFunction {
     BufferPtr elementIndices =
         allocateIndices(flatArray->size(), context.pool());
     SelectivityVector arrayRows(flatArray->size(), false);
+    std::vector<vector_size_t> activeRows;
 
     // Iteratively apply input function to array elements.
     // First, apply input function to first elements of all arrays.
@@ -114,6 +115,17 @@ class ReduceFunction : public exec::VectorFunction {
     while (auto entry = inputFuncIt.next()) {
       VectorPtr state = initialState;
 
+      // Start with the rows that have non-empty arrays.
+      activeRows.clear();
+      arrayRows.clearAll();
+      entry.rows->applyToSelected([&](auto row) {
+        if ((!rawNulls || !bits::isBitNull(rawNulls, row)) &&
+            rawSizes[row] > 0) {
+          activeRows.push_back(row);
+          arrayRows.setValid(row, true);
+        }
+      });
+
       vector_size_t n = 0;
       while (true) {
         // 'state' might use the 'elementIndices', in that case we need to
@@ -122,12 +134,12 @@ class ReduceFunction : public exec::VectorFunction {
           elementIndices = allocateIndices(flatArray->size(), context.pool());
         }
 
-        // Sets arrayRows[row] to true if array at that row has n-th element, to
-        // false otherwise.
+        // Keeps arrayRows[row] set only if array at that row has n-th
+        // element.
         // Set elementIndices[row] to the index of the n-th element in the
         // array's elements vector.
         if (!toNthElementRows(
-                flatArray, *entry.rows, n, arrayRows, elementIndices)) {
+                flatArray, n, activeRows, arrayRows, elementIndices)) {
           break; // Ran out of elements in all arrays.
         }
 
@@ -19,6 +19,7 @@
 #include "velox/expression/StringWriter.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/expression/VectorWriters.h"
+#include "velox/functions/lib/string/StringCore.h"
 
 namespace facebook::velox::functions {
 
@@ -111,12 +112,16 @@ class SplitFunction : public exec::VectorFunction {
         (noLimit or limits->isConstantMapping())) {
       const auto* rawStrings = strings->data<StringView>();
       const auto delim = delims->valueAt<StringView>(0);
+      // The delimiter is looked for with SIMD. The broadcasts of its bytes
+      // are made once for all rows.
+      const stringCore::SubstringFinder finder(
+          std::string_view(delim.data(), delim.size()));
 
       if (noLimit) {
         const I limit = std::numeric_limits<I>::max();
         rows.applyToSelected([&](vector_size_t row) {
           applyInner<false, I>(
-              rawStrings[row], delim, limit, row, resultWriter);
+              rawStrings[row], finder, delim.size(), limit, row, resultWriter);
         });
       } else {
         const I limit = limits->valueAt<I>(0);
@@ -124,7 +129,12 @@ class SplitFunction : public exec::VectorFunction {
         if (limit > 0) {
           rows.applyToSelected([&](vector_size_t row) {
             applyInner<true, I>(
-                rawStrings[row], delim, limit, row, resultWriter);
+                rawStrings[row],
+                finder,
+                delim.size(),
+                limit,
+                row,
+                resultWriter);
           });
         } else {
           auto pex = std::make_exception_ptr(
@@ -159,9 +169,12 @@ class SplitFunction : public exec::VectorFunction {
     if (limits == nullptr) {
       auto limit = std::numeric_limits<I>::max();
       rows.applyToSelected([&](vector_size_t row) {
+        const auto delim = delims->valueAt<StringView>(row);
         applyInner<false, I>(
             strings->valueAt<StringView>(row),
-            delims->valueAt<StringView>(row),
+            stringCore::SubstringFinder(
+                std::string_view(delim.data(), delim.size())),
+            delim.size(),
             limit,
             row,
             resultWriter);
@@ -170,9 +183,12 @@ class SplitFunction : public exec::VectorFunction {
       rows.applyToSelected([&](vector_size_t row) {
         const I limit = limits->valueAt<I>(row);
         if (limit > 0) {
+          const auto delim = delims->valueAt<StringView>(row);
           applyInner<true, I>(
               strings->valueAt<StringView>(row),
-              delims->valueAt<StringView>(row),
+              stringCore::SubstringFinder(
+                  std::string_view(delim.data(), delim.size())),
+              delim.size(),
               limit,
               row,
               resultWriter);
@@ -191,7 +207,8 @@ class SplitFunction : public exec::VectorFunction {
   template <bool hasLimit = false, typename I>
   inline void applyInner(
       StringView input,
-      const StringView delim,
+      const stringCore::SubstringFinder& delimFinder,
+      size_t delimSize,
       I limit,
       vector_size_t row,
       exec::VectorWriter<Array<Varchar>>& resultWriter) const {
@@ -211,14 +228,13 @@ class SplitFunction : public exec::VectorFunction {
     // string or the limit.
     int32_t addedElements{0};
     std::string_view sinput(input.data(), input.size());
-    const std::string_view sdelim(delim.data(), delim.size());
     while (true) {
       // Find the byte of the 1st delimiter.
-      auto byteIndex = sinput.find(sdelim, 0);
+      auto byteIndex = delimFinder.find(sinput);
 
       // Special case for empty delimiters. Split character by character with an
       // empty string at the end.
-      if (sdelim.empty()) {
+      if (delimSize == 0) {
         byteIndex++;
       }
 
@@ -232,7 +248,7 @@ class SplitFunction : public exec::VectorFunction {
 
       // Advance input by the size of the element + delimiter.
       // Note: should we add 'advance' method?
-      const auto advanceBytes = byteIndex + sdelim.size();
+      const auto advanceBytes = byteIndex + delimSize;
       sinput = std::string_view(
           sinput.data() + advanceBytes, sinput.size() - advanceBytes);
 
@@ -68,8 +68,7 @@ class TransformFunction : public exec::VectorFunction {
     while (auto entry = it.next()) {
       auto elementRows = toElementRows<ArrayVector>(
           newNumElements, *entry.rows, flatArray.get());
-      auto wrapCapture = toWrapCapture<ArrayVector>(
-          newNumElements, entry.callable, *entry.rows, flatArray);
+      auto wrapCapture = toWrapCapture(entry.callable, elementToTopLevelRows);
 
       entry.callable->apply(
           elementRows,
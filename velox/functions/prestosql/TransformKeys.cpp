@@ -69,8 +69,7 @@ class TransformKeysFunction : public exec::VectorFunction {
     while (auto entry = it.next()) {
       auto keyRows =
           toElementRows<MapVector>(numKeys, *entry.rows, flatMap.get());
-      auto wrapCapture = toWrapCapture<MapVector>(
-          numKeys, entry.callable, *entry.rows, flatMap);
+      auto wrapCapture = toWrapCapture(entry.callable, elementToTopLevelRows);
 
       entry.callable->apply(
           keyRows,
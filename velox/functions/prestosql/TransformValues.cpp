@@ -68,8 +68,7 @@ class TransformValuesFunction : public exec::VectorFunction {
     while (auto entry = it.next()) {
       auto valueRows =
           toElementRows<MapVector>(numValues, *entry.rows, flatMap.get());
-      auto wrapCapture = toWrapCapture<MapVector>(
-          numValues, entry.callable, *entry.rows, flatMap);
+      auto wrapCapture = toWrapCapture(entry.callable, elementToTopLevelRows);
 
       entry.callable->apply(
           valueRows,
@@ -15,41 +15,148 @@
  */
 
 #include "URLFunctions.h"
+#include <algorithm>
+#include "velox/common/base/SimdUtil.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::functions {
+namespace {
 
-bool matchAuthorityAndPath(
-    const boost::cmatch& urlMatch,
-    boost::cmatch& authAndPathMatch,
-    boost::cmatch& authorityMatch,
-    bool& hasAuthority) {
-  static const boost::regex kAuthorityAndPathRegex("//([^/]*)(/.*)?");
-  auto authorityAndPath = submatch(urlMatch, 2);
-  if (!boost::regex_match(
-          authorityAndPath.begin(),
-          authorityAndPath.end(),
-          authAndPathMatch,
-          kAuthorityAndPathRegex)) {
-    // Does not start with //, doesn't have authority.
-    hasAuthority = false;
+bool isAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool isSchemeChar(char c) {
+  return isAlpha(c) || isDigit(c) || c == '+' || c == '.' || c == '-';
+}
+
+// Sets 'question' and 'hash' to the offsets of the first '?' and the first
+// '#' in 'data'. An offset is 'size' if the character is not found. The scan
+// stops at the first '#', so 'question' is only meaningful if it is less
+// than 'hash'. Both delimiters are looked for in a single pass over batches
+// of bytes.
+void findQueryAndFragment(
+    const char* data,
+    size_t size,
+    size_t& question,
+    size_t& hash) {
+  using Batch = xsimd::batch<int8_t>;
+  question = size;
+  hash = size;
+  const auto questions = Batch::broadcast('?');
+  const auto hashes = Batch::broadcast('#');
+  size_t i = 0;
+  for (; i + Batch::size <= size; i += Batch::size) {
+    auto bytes =
+        Batch::load_unaligned(reinterpret_cast<const int8_t*>(data + i));
+    if (question == size) {
+      const uint64_t mask = simd::toBitMask(bytes == questions);
+      if (mask) {
+        question = i + __builtin_ctzll(mask);
+      }
+    }
+    const uint64_t mask = simd::toBitMask(bytes == hashes);
+    if (mask) {
+      hash = i + __builtin_ctzll(mask);
+      return;
+    }
+  }
+  for (; i < size; ++i) {
+    if (data[i] == '?' && question == size) {
+      question = i;
+    } else if (data[i] == '#') {
+      hash = i;
+      return;
+    }
+  }
+}
+
+// Parses [begin, end) as host[:port], where the host is an IP literal in
+// brackets or does not contain '[' or ':' and the port is all digits.
+bool parseHostAndPort(const char* begin, const char* end, ParsedUrl& parsed) {
+  const char* hostEnd = begin;
+  if (begin < end && *begin == '[') {
+    hostEnd = findChar(begin, end, ']');
+    if (hostEnd == end) {
+      return false;
+    }
+    ++hostEnd;
+  } else {
+    while (hostEnd < end && *hostEnd != '[' && *hostEnd != ':') {
+      ++hostEnd;
+    }
+  }
+  const char* port = hostEnd;
+  if (hostEnd < end) {
+    if (*hostEnd != ':') {
+      return false;
+    }
+    ++port;
+    if (!std::all_of(port, end, isDigit)) {
+      return false;
+    }
+  }
+  parsed.host = StringView(begin, hostEnd - begin);
+  parsed.port = StringView(port, end - port);
+  return true;
+}
+
+// Parses [begin, end) as [userinfo@]host[:port]. The user info ends at the
+// first '@'. If the rest is not a valid host and port, the whole authority
+// is tried as one.
+bool parseAuthority(const char* begin, const char* end, ParsedUrl& parsed) {
+  const char* at = findChar(begin, end, '@');
+  if (at != end && parseHostAndPort(at + 1, end, parsed)) {
     return true;
   }
+  return parseHostAndPort(begin, end, parsed);
+}
 
-  static const boost::regex kAuthorityRegex(
-      "(?:([^@:]*)(?::([^@]*))?@)?" // username, password.
-      "(\\[[^\\]]*\\]|[^\\[:]*)" // host (IP-literal (e.g. '['+IPv6+']',
-      // dotted-IPv4, or named host).
-      "(?::(\\d*))?"); // port.
+} // namespace
 
-  const auto authority = authAndPathMatch[1];
-  if (!boost::regex_match(
-          authority.first, authority.second, authorityMatch, kAuthorityRegex)) {
-    return false; // Invalid URI Authority.
+bool parseUrl(StringView url, ParsedUrl& parsed) {
+  const char* data = url.data();
+  const size_t size = url.size();
+  if (size == 0 || !isAlpha(data[0])) {
+    return false;
+  }
+  size_t schemeEnd = 1;
+  while (schemeEnd < size && isSchemeChar(data[schemeEnd])) {
+    ++schemeEnd;
+  }
+  if (schemeEnd == size || data[schemeEnd] != ':') {
+    return false;
   }
+  parsed = ParsedUrl();
+  parsed.protocol = StringView(data, schemeEnd);
 
-  hasAuthority = true;
+  const char* rest = data + schemeEnd + 1;
+  const size_t restSize = size - schemeEnd - 1;
+  size_t question;
+  size_t hash;
+  findQueryAndFragment(rest, restSize, question, hash);
+  if (question < hash) {
+    parsed.query = StringView(rest + question + 1, hash - question - 1);
+  }
+  if (hash < restSize) {
+    parsed.fragment = StringView(rest + hash + 1, restSize - hash - 1);
+  }
 
+  // The authority and the path end at the query or the fragment.
+  const auto pathEnd = std::min(question, hash);
+  if (pathEnd < 2 || rest[0] != '/' || rest[1] != '/') {
+    parsed.path = StringView(rest, pathEnd);
+    return true;
+  }
+  const char* authority = rest + 2;
+  const char* authorityEnd = findChar(authority, rest + pathEnd, '/');
+  if (parseAuthority(authority, authorityEnd, parsed)) {
+    parsed.path = StringView(authorityEnd, rest + pathEnd - authorityEnd);
+  }
   return true;
 }
 
@@ -15,28 +15,18 @@
  */
 #pragma once
 
-#include <boost/regex.hpp>
 #include <cctype>
+#include <cstring>
 #include "velox/functions/Macros.h"
 
 namespace facebook::velox::functions {
 
 namespace {
-FOLLY_ALWAYS_INLINE StringView submatch(const boost::cmatch& match, int idx) {
-  const auto& sub = match[idx];
-  return StringView(sub.first, sub.length());
-}
-
-template <typename TInString>
-bool parse(const TInString& rawUrl, boost::cmatch& match) {
-  static const boost::regex kUriRegex(
-      "([a-zA-Z][a-zA-Z0-9+.-]*):" // scheme:
-      "([^?#]*)" // authority and path
-      "(?:\\?([^#]*))?" // ?query
-      "(?:#(.*))?"); // #fragment
-
-  return boost::regex_match(
-      rawUrl.data(), rawUrl.data() + rawUrl.size(), match, kUriRegex);
+// Returns the first occurrence of 'c' in [begin, end) or 'end' if not found.
+FOLLY_ALWAYS_INLINE const char*
+findChar(const char* begin, const char* end, char c) {
+  auto* found = static_cast<const char*>(memchr(begin, c, end - begin));
+  return found ? found : end;
 }
 
 FOLLY_ALWAYS_INLINE unsigned char toHex(unsigned char c) {
@@ -124,11 +114,22 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
 
 } // namespace
 
-bool matchAuthorityAndPath(
-    const boost::cmatch& urlMatch,
-    boost::cmatch& authAndPathMatch,
-    boost::cmatch& authorityMatch,
-    bool& hasAuthority);
+/// The components of a URL. All point into the parsed string. A component
+/// that is not present is empty.
+struct ParsedUrl {
+  StringView protocol;
+  StringView host;
+  StringView port;
+  StringView path;
+  StringView query;
+  StringView fragment;
+};
+
+/// Parses 'url' of the form scheme:[//authority]path[?query][#fragment] in
+/// one pass and sets all components of 'parsed'. Returns false if 'url' does
+/// not start with a scheme. If the authority is not valid, the host, port and
+/// path are empty.
+bool parseUrl(StringView url, ParsedUrl& parsed);
 
 template <typename T>
 struct UrlExtractProtocolFunction {
@@ -143,11 +144,11 @@ struct UrlExtractProtocolFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
     } else {
-      result.setNoCopy(submatch(match, 1));
+      result.setNoCopy(parsed.protocol);
     }
     return true;
   }
@@ -166,11 +167,11 @@ struct UrlExtractFragmentFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
     } else {
-      result.setNoCopy(submatch(match, 4));
+      result.setNoCopy(parsed.fragment);
     }
     return true;
   }
@@ -189,21 +190,11 @@ struct UrlExtractHostFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
-      return true;
-    }
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority) &&
-        hasAuthority) {
-      result.setNoCopy(submatch(authorityMatch, 3));
     } else {
-      result.setEmpty();
+      result.setNoCopy(parsed.host);
     }
     return true;
   }
@@ -214,24 +205,16 @@ struct UrlExtractPortFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE bool call(int64_t& result, const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       return false;
     }
 
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority) &&
-        hasAuthority) {
-      auto port = submatch(authorityMatch, 4);
-      if (!port.empty()) {
-        try {
-          result = to<int64_t>(port);
-          return true;
-        } catch (folly::ConversionError const&) {
-        }
+    if (!parsed.port.empty()) {
+      try {
+        result = to<int64_t>(parsed.port);
+        return true;
+      } catch (folly::ConversionError const&) {
       }
     }
     return false;
@@ -251,25 +234,13 @@ struct UrlExtractPathFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
       return true;
     }
 
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority)) {
-      if (hasAuthority) {
-        result.setNoCopy(submatch(authAndPathMatch, 2));
-      } else {
-        result.setNoCopy(submatch(match, 2));
-      }
-    }
-
+    result.setNoCopy(parsed.path);
     return true;
   }
 };
@@ -287,14 +258,13 @@ struct UrlExtractQueryFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
       return true;
     }
 
-    auto query = submatch(match, 3);
-    result.setNoCopy(query);
+    result.setNoCopy(parsed.query);
     return true;
   }
 };
@@ -313,37 +283,27 @@ struct UrlExtractParameterFunction {
       out_type<Varchar>& result,
       const arg_type<Varchar>& url,
       const arg_type<Varchar>& param) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    ParsedUrl parsed;
+    if (!parseUrl(url, parsed)) {
       result.setEmpty();
       return false;
     }
 
-    auto query = submatch(match, 3);
-    if (!query.empty()) {
-      // Parse query string.
-      static const boost::regex kQueryParamRegex(
-          "(^|&)" // start of query or start of parameter "&"
-          "([^=&]*)=?" // parameter name and "=" if value is expected
-          "([^=&]*)" // parameter value
-          "(?=(&|$))" // forward reference, next should be end of query or
-                      // start of next parameter
-      );
-
-      const boost::cregex_iterator begin(
-          query.data(), query.data() + query.size(), kQueryParamRegex);
-      boost::cregex_iterator end;
-
-      for (auto it = begin; it != end; ++it) {
-        if (it->length(2) != 0) { // key shouldnt be empty.
-          auto key = submatch((*it), 2);
-          if (param.compare(key) == 0) {
-            auto value = submatch((*it), 3);
-            result.setNoCopy(value);
-            return true;
-          }
-        }
+    // The query is a list of key[=value] parameters separated by '&'.
+    // Parameters with an empty key or with more than one '=' are ignored.
+    const char* begin = parsed.query.data();
+    const char* const end = begin + parsed.query.size();
+    while (begin < end) {
+      const char* next = findChar(begin, end, '&');
+      const char* keyEnd = findChar(begin, next, '=');
+      if (keyEnd != begin &&
+          (keyEnd == next || findChar(keyEnd + 1, next, '=') == next) &&
+          param.compare(StringView(begin, keyEnd - begin)) == 0) {
+        const char* value = std::min(keyEnd + 1, next);
+        result.setNoCopy(StringView(value, next - value));
+        return true;
       }
+      begin = next + 1;
     }
 
     return false;
@@ -54,12 +54,7 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool) override {
     decodeArguments(rows, args);
-    rows.applyToSelected([&](auto row) {
-      if (!decodedValues_.isNullAt(row)) {
-        auto summary = initSummary(groups[row]);
-        summary->insert(decodedValues_.valueAt<T>(row));
-      }
-    });
+    insertRuns(rows, [&](auto row) { return groups[row]; });
   }
 
   void addIntermediateResults(
@@ -76,12 +71,7 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
       const std::vector<VectorPtr>& args,
       bool) override {
     decodeArguments(rows, args);
-    auto summary = initSummary(group);
-    rows.applyToSelected([&](auto row) {
-      if (!decodedValues_.isNullAt(row)) {
-        summary->insert(decodedValues_.valueAt<T>(row));
-      }
-    });
+    insertRuns(rows, [&](auto /*row*/) { return group; });
   }
 
   void addSingleGroupIntermediateResults(
@@ -219,6 +209,38 @@ struct ApproxMostFrequentAggregate : exec::Aggregate {
     setConstantArgument(name, val, vec.valueAt<int64_t>(0));
   }
 
+  // Inserts the non-null values of 'rows' into the summaries of the groups
+  // given by 'getGroup'. Consecutive rows with the same group and value are
+  // inserted once with the length of the run as count. This leaves a summary
+  // in the same state as inserting the rows one by one, so the result does not
+  // change.
+  template <typename GetGroup>
+  void insertRuns(const SelectivityVector& rows, GetGroup getGroup) {
+    char* runGroup = nullptr;
+    T runValue{};
+    int64_t runLength = 0;
+    rows.applyToSelected([&](auto row) {
+      if (decodedValues_.isNullAt(row)) {
+        return;
+      }
+      auto* group = getGroup(row);
+      const auto value = decodedValues_.valueAt<T>(row);
+      if (runLength > 0 && group == runGroup && value == runValue) {
+        ++runLength;
+        return;
+      }
+      if (runLength > 0) {
+        initSummary(runGroup)->insert(runValue, runLength);
+      }
+      runGroup = group;
+      runValue = value;
+      runLength = 1;
+    });
+    if (runLength > 0) {
+      initSummary(runGroup)->insert(runValue, runLength);
+    }
+  }
+
   StreamSummary* initSummary(char* group) {
     auto summary = value<StreamSummary>(group);
     VELOX_USER_CHECK_LE(capacity_, std::numeric_limits<int>::max());
@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -375,19 +379,23 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
+      // Gathers the values and inserts them in one batch.
+      values_.resize(rows.countSelected());
+      size_t numValues = 0;
       if (decodedValue_.mayHaveNulls()) {
         rows.applyToSelected([&](auto row) {
           if (decodedValue_.isNullAt(row)) {
             return;
           }
 
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_[numValues++] = decodedValue_.valueAt<T>(row);
         });
       } else {
         rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_[numValues++] = decodedValue_.valueAt<T>(row);
         });
       }
+      accumulator->append(folly::Range<const T*>(values_.data(), numValues));
     }
   }
 
@@ -571,6 +579,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Values of a batch for a single group.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
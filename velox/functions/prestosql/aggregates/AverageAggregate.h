@@ -114,6 +114,21 @@ class AverageAggregate : public exec::Aggregate {
       });
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       auto data = decodedRaw_.data<T>();
+      if (rows.isAllSelected()) {
+        exec::Aggregate::forEachGroupRun(
+            groups,
+            rows.begin(),
+            rows.end(),
+            [&](char* group, vector_size_t begin, vector_size_t end) {
+              auto sum = accumulator(group)->sum;
+              for (auto i = begin; i < end; ++i) {
+                sum += data[i];
+              }
+              accumulator(group)->sum = sum;
+              accumulator(group)->count += end - begin;
+            });
+        return;
+      }
       rows.applyToSelected([&](vector_size_t i) {
         updateNonNullValue<false>(groups[i], data[i]);
       });
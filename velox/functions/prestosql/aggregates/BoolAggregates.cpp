@@ -72,6 +72,41 @@ class BoolAndOrAggregate : public SimpleNumericAggregate<bool, bool, bool> {
   }
 
  protected:
+  // Reduces flat input into 'group' a word of rows at a time. Returns false
+  // without updating if 'arg' is not flat.
+  bool updateOneGroupFromFlat(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg) {
+    if (arg->encoding() != VectorEncoding::Simple::FLAT) {
+      return false;
+    }
+    const auto* values =
+        arg->asUnchecked<FlatVector<bool>>()->rawValues<uint64_t>();
+    const auto* nulls = arg->rawNulls();
+    const auto* selected = rows.asRange().bits();
+    bool hasValue = false;
+    // True if some value is not the initial value, i.e. false for bool_and
+    // and true for bool_or.
+    bool flipped = false;
+    bits::forEachWord(
+        rows.begin(), rows.end(), [&](int32_t index, uint64_t mask) {
+          const auto active =
+              selected[index] & mask & (nulls ? nulls[index] : ~0ULL);
+          const auto flippedBits =
+              initialValue_ ? ~values[index] : values[index];
+          hasValue |= active != 0;
+          flipped |= (active & flippedBits) != 0;
+        });
+    if (hasValue) {
+      clearNull(group);
+      if (flipped) {
+        *value<bool>(group) = !initialValue_;
+      }
+    }
+    return true;
+  }
+
   const bool initialValue_;
 };
 
@@ -105,6 +140,9 @@ class BoolAndAggregate final : public BoolAndOrAggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (updateOneGroupFromFlat(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
@@ -156,6 +194,9 @@ class BoolOrAggregate final : public BoolAndOrAggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool mayPushdown) override {
+    if (updateOneGroupFromFlat(group, rows, args[0])) {
+      return;
+    }
     BaseAggregate::updateOneGroup(
         group,
         rows,
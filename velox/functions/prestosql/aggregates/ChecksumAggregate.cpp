@@ -142,14 +142,22 @@ class ChecksumAggregate : public exec::Aggregate {
     hasher->hash(arg, rows, hashes);
     auto rawHashes = hashes->as<int64_t>();
 
-    rows.applyToSelected([&](vector_size_t row) {
+    // The checksum is a sum of hash * XXH_PRIME64_1 over the rows, with nulls
+    // counting as a hash of 1. Summing the hashes of the batch first and
+    // multiplying once gives the same result modulo 2^64.
+    uint64_t hashSum = 0;
+    if (arg->mayHaveNulls()) {
+      rows.applyToSelected([&](vector_size_t row) {
+        hashSum += arg->isNullAt(row) ? 1 : rawHashes[row];
+      });
+    } else {
+      rows.applyToSelected(
+          [&](vector_size_t row) { hashSum += rawHashes[row]; });
+    }
+    if (rows.hasSelections()) {
       clearNull(group);
-      if (arg->isNullAt(row)) {
-        computeHashForNull(group);
-      } else {
-        computeHash(group, rawHashes[row]);
-      }
-    });
+      computeHash(group, hashSum);
+    }
   }
 
   void addSingleGroupIntermediateResults(
@@ -174,8 +182,10 @@ class ChecksumAggregate : public exec::Aggregate {
   }
 
  private:
-  FOLLY_ALWAYS_INLINE void computeHash(char* group, const int64_t hash) {
-    *value<int64_t>(group) += hash * XXH_PRIME64_1;
+  FOLLY_ALWAYS_INLINE void computeHash(char* group, const uint64_t hash) {
+    // Unsigned arithmetic wraps around like the signed arithmetic of Presto.
+    auto& checksum = *value<uint64_t>(group);
+    checksum += hash * XXH_PRIME64_1;
   }
 
   FOLLY_ALWAYS_INLINE void computeHashForNull(char* group) {
@@ -68,8 +68,7 @@ void ValueList::appendNonNull(
   exec::ContainerRowSerde::instance().serialize(values, index, stream);
   totalBytes_ += stream.size();
   ++size_;
-  auto reserve = std::max<int32_t>(1024, std::min<int64_t>(128, totalBytes_));
-  dataCurrent_ = allocator->finishWrite(stream, reserve);
+  dataCurrent_ = allocator->finishWrite(stream, reserveBytes());
 }
 
 void ValueList::appendValue(
@@ -89,12 +88,27 @@ void ValueList::appendRange(
     vector_size_t offset,
     vector_size_t size,
     HashStringAllocator* allocator) {
-  for (auto index = offset; index < offset + size; ++index) {
-    if (vector->isNullAt(index)) {
-      appendNull(allocator);
-    } else {
-      appendNonNull(*vector, index, allocator);
+  // Writes the values up to the next word of null flags in one stream. The
+  // null flags are written between the runs since only one write to
+  // 'allocator' can be open at a time.
+  auto index = offset;
+  const auto end = offset + size;
+  while (index < end) {
+    prepareAppend(allocator);
+    const auto numValues =
+        std::min<vector_size_t>(end - index, 64 - size_ % 64);
+    ByteStream stream(allocator);
+    allocator->extendWrite(dataCurrent_, stream);
+    for (auto i = 0; i < numValues; ++i, ++index) {
+      if (vector->isNullAt(index)) {
+        lastNulls_ |= 1UL << (size_ % 64);
+      } else {
+        exec::ContainerRowSerde::instance().serialize(*vector, index, stream);
+      }
+      ++size_;
     }
+    totalBytes_ += stream.size();
+    dataCurrent_ = allocator->finishWrite(stream, reserveBytes());
   }
 }
 
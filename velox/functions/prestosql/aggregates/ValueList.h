@@ -72,6 +72,17 @@ class ValueList {
   // sizes for lots of small arrays.
   static constexpr int kInitialSize = 44;
 
+  // Bounds of the free space left after the last value of a list. The
+  // reserve grows with the size of the list, so that many small lists do
+  // not each hold kMaxReserveBytes and a large list grows in few ranges.
+  static constexpr int32_t kMinReserveBytes = 128;
+  static constexpr int32_t kMaxReserveBytes = 1024;
+
+  int32_t reserveBytes() const {
+    return std::min<int64_t>(
+        kMaxReserveBytes, std::max<int64_t>(kMinReserveBytes, totalBytes_));
+  }
+
   void appendNull(HashStringAllocator* allocator);
 
   void appendNonNull(
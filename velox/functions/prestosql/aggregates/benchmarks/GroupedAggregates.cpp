@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+
+#include "velox/exec/Aggregate.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/vector/FlatVector.h"
+
+using namespace facebook::velox;
+
+namespace {
+constexpr int32_t kNumRows = 10'000;
+constexpr int32_t kRowSizeOffset = 8;
+constexpr int32_t kOffset = kRowSizeOffset + 8;
+
+// Measures the update of grouped accumulators from flat input without nulls,
+// without the hash table. The rows of a batch go to 'numGroups' groups either
+// in random order or clustered, i.e. consecutive rows of a group.
+class GroupedUpdate {
+ public:
+  GroupedUpdate(
+      const std::string& name,
+      const TypePtr& inputType,
+      int32_t numGroups,
+      bool clustered) {
+    function_ = exec::Aggregate::create(
+        name,
+        core::AggregationNode::Step::kPartial,
+        {inputType},
+        exec::Aggregate::intermediateType(name, {inputType}));
+    function_->setAllocator(&allocator_);
+    function_->setOffsets(kOffset, 0, 1, kRowSizeOffset);
+
+    const auto rowSize = bits::roundUp(
+        kOffset + function_->accumulatorFixedWidthSize(), sizeof(int64_t));
+    groupRows_.resize(numGroups * rowSize);
+    std::vector<char*> allGroups(numGroups);
+    std::vector<vector_size_t> indices(numGroups);
+    for (auto i = 0; i < numGroups; ++i) {
+      allGroups[i] = groupRows_.data() + i * rowSize;
+      indices[i] = i;
+    }
+    function_->initializeNewGroups(allGroups.data(), indices);
+
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    groups_.resize(kNumRows);
+    for (auto row = 0; row < kNumRows; ++row) {
+      groups_[row] = clustered
+          ? allGroups[static_cast<int64_t>(row) * numGroups / kNumRows]
+          : allGroups[folly::Random::rand32(numGroups, rng)];
+    }
+    input_ = BaseVector::create(inputType, kNumRows, pool_.get());
+    if (inputType->kind() == TypeKind::BIGINT) {
+      auto* values = input_->asFlatVector<int64_t>()->mutableRawValues();
+      for (auto row = 0; row < kNumRows; ++row) {
+        values[row] = folly::Random::rand32(1'000'000, rng);
+      }
+    } else {
+      auto* values = input_->asFlatVector<double>()->mutableRawValues();
+      for (auto row = 0; row < kNumRows; ++row) {
+        values[row] = folly::Random::randDouble01(rng);
+      }
+    }
+  }
+
+  void run(uint32_t iterations) {
+    const std::vector<VectorPtr> args = {input_};
+    for (auto i = 0; i < iterations; ++i) {
+      function_->addRawInput(groups_.data(), rows_, args, false);
+    }
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  HashStringAllocator allocator_{pool_.get()};
+  std::unique_ptr<exec::Aggregate> function_;
+  std::vector<char> groupRows_;
+  std::vector<char*> groups_;
+  VectorPtr input_;
+  const SelectivityVector rows_{kNumRows};
+};
+
+void update(
+    uint32_t iterations,
+    const std::string& name,
+    const TypePtr& type,
+    int32_t numGroups,
+    bool clustered) {
+  folly::BenchmarkSuspender suspender;
+  GroupedUpdate groupedUpdate(name, type, numGroups, clustered);
+  suspender.dismiss();
+  groupedUpdate.run(iterations);
+}
+
+void shuffled(
+    uint32_t iterations,
+    const std::string& name,
+    int32_t numGroups) {
+  update(iterations, name, BIGINT(), numGroups, false);
+}
+
+void clustered(
+    uint32_t iterations,
+    const std::string& name,
+    int32_t numGroups) {
+  update(iterations, name, BIGINT(), numGroups, true);
+}
+
+void shuffledDouble(
+    uint32_t iterations,
+    const std::string& name,
+    int32_t numGroups) {
+  update(iterations, name, DOUBLE(), numGroups, false);
+}
+} // namespace
+
+#define GROUPED_BENCHMARKS(_name_)                                            \
+  BENCHMARK_NAMED_PARAM(shuffled, _name_##_16, #_name_, 16);                  \
+  BENCHMARK_RELATIVE_NAMED_PARAM(clustered, _name_##_16, #_name_, 16);        \
+  BENCHMARK_NAMED_PARAM(shuffled, _name_##_100K, #_name_, 100'000);           \
+  BENCHMARK_RELATIVE_NAMED_PARAM(clustered, _name_##_100K, #_name_, 100'000); \
+  BENCHMARK_NAMED_PARAM(shuffledDouble, _name_##_16, #_name_, 16);            \
+  BENCHMARK_NAMED_PARAM(shuffledDouble, _name_##_100K, #_name_, 100'000);     \
+  BENCHMARK_DRAW_LINE();
+
+GROUPED_BENCHMARKS(sum)
+GROUPED_BENCHMARKS(count)
+GROUPED_BENCHMARKS(avg)
+GROUPED_BENCHMARKS(min)
+GROUPED_BENCHMARKS(max)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  aggregate::prestosql::registerAllAggregateFunctions();
+  folly::runBenchmarks();
+  return 0;
+}
@@ -88,6 +88,35 @@ TEST_P(BoolAndOrTest, basic) {
           "SELECT {}(c1::TINYINT) FROM tmp WHERE c0 % 2 = 0", duckDbName));
 }
 
+TEST_P(BoolAndOrTest, flatInput) {
+  // Global aggregation of flat input is reduced a word at a time. Covers
+  // a single differing value, nulls and all nulls.
+  constexpr int32_t kSize = 1'000;
+  std::vector<RowVectorPtr> vectors = {makeRowVector({
+      makeFlatVector<bool>(
+          kSize, [](auto /*row*/) { return true; }, nullEvery(3)),
+      makeFlatVector<bool>(
+          kSize, [](auto /*row*/) { return false; }, nullEvery(5)),
+      makeFlatVector<bool>(kSize, [](auto row) { return row != 700; }),
+      makeAllNullFlatVector<bool>(kSize),
+  })};
+  createDuckDbTable(vectors);
+
+  const auto veloxName = GetParam().veloxName;
+  const auto duckDbName = GetParam().duckDbName;
+  testAggregations(
+      vectors,
+      {},
+      {fmt::format("{}(c0)", veloxName),
+       fmt::format("{}(c1)", veloxName),
+       fmt::format("{}(c2)", veloxName),
+       fmt::format("{}(c3)", veloxName)},
+      fmt::format(
+          "SELECT {0}(c0::TINYINT), {0}(c1::TINYINT), {0}(c2::TINYINT), "
+          "{0}(c3::TINYINT) FROM tmp",
+          duckDbName));
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     BoolAndOrTest,
     BoolAndOrTest,
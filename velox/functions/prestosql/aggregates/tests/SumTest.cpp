@@ -500,6 +500,26 @@ TEST_F(SumTest, boolKey) {
       vectors, {"c0"}, {"sum(c1)"}, "SELECT c0, sum(c1) FROM tmp GROUP BY 1");
 }
 
+TEST_F(SumTest, clusteredKeys) {
+  // Runs of consecutive rows with the same key are added up together.
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(size, [&](auto row) { return row / 37 + i; }),
+         makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+         makeFlatVector<double>(size, [](auto row) { return row * 0.25; })}));
+  }
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"sum(c1)", "sum(c2)", "count(c1)", "count(1)", "avg(c2)", "min(c1)"},
+      "SELECT c0, sum(c1), sum(c2), count(c1), count(1), avg(c2), min(c1) "
+      "FROM tmp GROUP BY 1");
+}
+
 TEST_F(SumTest, emptyValues) {
   auto rowType = ROW({"c0", "c1"}, {INTEGER(), BIGINT()});
   auto vector = makeRowVector(
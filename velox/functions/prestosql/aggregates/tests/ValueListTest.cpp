@@ -127,3 +127,38 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, appendRanges) {
+  // Ranges that start and end in the middle of a word of null flags.
+  auto data = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; }, test::VectorMaker::nullEvery(3));
+  aggregate::ValueList values;
+  vector_size_t offset = 0;
+  for (auto size = 1; offset < data->size(); size = size * 2 + 3) {
+    size = std::min(size, data->size() - offset);
+    values.appendRange(data, offset, size, allocator());
+    offset += size;
+  }
+  ASSERT_EQ(data->size(), values.size());
+  assertEqualVectors(data, read(values, data->type(), data->size()));
+}
+
+TEST_F(ValueListTest, smallListsMemory) {
+  // Many short lists, like array_agg over many small groups, keep little free
+  // space each.
+  constexpr int32_t kNumLists = 10'000;
+  auto data = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  DecodedVector decoded(*data);
+  std::vector<aggregate::ValueList> lists(kNumLists);
+  for (auto& list : lists) {
+    for (auto i = 0; i < data->size(); ++i) {
+      list.appendValue(decoded, i, allocator());
+    }
+  }
+  EXPECT_LT(allocator()->cumulativeBytes(), kNumLists * 512);
+
+  assertEqualVectors(data, read(lists.back(), data->type(), data->size()));
+  for (auto& list : lists) {
+    list.free(allocator());
+  }
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+// Measures array_sort, array_distinct, array_intersect and array_except on
+// many small arrays and on fewer large arrays of BIGINT and INTEGER.
+class ArraySortBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  ArraySortBenchmark() : FunctionBenchmarkBase() {
+    functions::prestosql::registerArrayFunctions();
+  }
+
+  // Runs 'expression' over two columns c0 and c1 of arrays of 'arraySize'
+  // elements on average, with 'numElements' elements in total.
+  template <typename T>
+  void run(
+      const std::string& expression,
+      vector_size_t arraySize,
+      vector_size_t numElements = 100'000) {
+    folly::BenchmarkSuspender suspender;
+    const vector_size_t numRows = numElements / arraySize;
+    // Sizes vary from 1 to 2 * arraySize - 1, values repeat.
+    auto sizeAt = [&](auto row) { return 1 + (row * 7) % (2 * arraySize - 1); };
+    auto valueAt = [&](auto row) {
+      return static_cast<T>((row * 0x9E3779B1LL) % (2 * arraySize));
+    };
+    auto c0 = vectorMaker_.arrayVector<T>(numRows, sizeAt, valueAt);
+    auto c1 = vectorMaker_.arrayVector<T>(
+        numRows, sizeAt, [&](auto row) { return valueAt(row + 1); });
+    auto rowVector = vectorMaker_.rowVector({c0, c1});
+    auto exprSet = compileExpression(expression, rowVector->type());
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      cnt += evaluate(exprSet, rowVector)->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+};
+
+std::unique_ptr<ArraySortBenchmark> benchmark;
+
+BENCHMARK(sortSmall) {
+  benchmark->run<int64_t>("array_sort(c0)", 4);
+}
+
+BENCHMARK(sortMedium) {
+  benchmark->run<int64_t>("array_sort(c0)", 50);
+}
+
+BENCHMARK(sortLarge) {
+  benchmark->run<int64_t>("array_sort(c0)", 2'000);
+}
+
+BENCHMARK(sortLargeInteger) {
+  benchmark->run<int32_t>("array_sort(c0)", 2'000);
+}
+
+BENCHMARK(distinctSmall) {
+  benchmark->run<int64_t>("array_distinct(c0)", 4);
+}
+
+BENCHMARK(distinctLarge) {
+  benchmark->run<int64_t>("array_distinct(c0)", 2'000);
+}
+
+BENCHMARK(intersectSmall) {
+  benchmark->run<int64_t>("array_intersect(c0, c1)", 4);
+}
+
+BENCHMARK(intersectLarge) {
+  benchmark->run<int64_t>("array_intersect(c0, c1)", 2'000);
+}
+
+BENCHMARK(exceptSmall) {
+  benchmark->run<int64_t>("array_except(c0, c1)", 4);
+}
+
+BENCHMARK(exceptLarge) {
+  benchmark->run<int64_t>("array_except(c0, c1)", 2'000);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<ArraySortBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
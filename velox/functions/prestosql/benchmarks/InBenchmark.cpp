@@ -56,14 +56,18 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
         {VectorFuzzer(opts, pool()).fuzzFlat(INTEGER())});
   }
 
-  void run(size_t numValues) {
+  // Evaluates IN over 'numValues' multiples of 'step'. A small 'step'
+  // makes a list that is tested with a bitmask. A large one makes a list that
+  // is tested by comparing with each value, by a binary search or by a hash
+  // table depending on 'numValues'.
+  void run(size_t numValues, int32_t step = 2) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData();
 
     std::ostringstream inList;
     inList << "0";
     for (auto i = 1; i < numValues; ++i) {
-      inList << ", " << i * 2;
+      inList << ", " << i * step;
     }
 
     auto sql = fmt::format("c0 IN ({})", inList.str());
@@ -116,6 +120,26 @@ BENCHMARK_RELATIVE(in) {
   benchmark.run(10);
 }
 
+BENCHMARK_RELATIVE(inSparse) {
+  InBenchmark benchmark;
+  benchmark.run(10, 1'000'000);
+}
+
+BENCHMARK(fastIn100) {
+  InBenchmark benchmark;
+  benchmark.runFast(100);
+}
+
+BENCHMARK_RELATIVE(in100) {
+  InBenchmark benchmark;
+  benchmark.run(100);
+}
+
+BENCHMARK_RELATIVE(in100Sparse) {
+  InBenchmark benchmark;
+  benchmark.run(100, 1'000'000);
+}
+
 BENCHMARK(fastIn1K) {
   InBenchmark benchmark;
   benchmark.runFast(1'000);
@@ -126,6 +150,11 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK_RELATIVE(in1KSparse) {
+  InBenchmark benchmark;
+  benchmark.run(1'000, 1'000'000);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -47,6 +47,8 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
         {"folly_json_array_length"});
     registerFunction<SIMDJsonArrayLengthFunction, int64_t, Json>(
         {"simd_json_array_length"});
+    registerFunction<JsonExtractScalarFunction, Varchar, Json, Varchar>(
+        {"folly_json_extract_scalar"});
   }
 
   std::string prepareData(int jsonSize) {
@@ -100,6 +102,32 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Extracts 'numPaths' fields of the same documents in one ExprSet.
+  void runWithJsonExtractScalar(
+      int iter,
+      int vectorSize,
+      const std::string& fnName,
+      int numPaths) {
+    folly::BenchmarkSuspender suspender;
+
+    std::string json = "{";
+    for (auto i = 0; i < 20; ++i) {
+      json += fmt::format(R"({}"k{}": "v{}")", i == 0 ? "" : ",", i, i);
+    }
+    json += "}";
+    auto rowVector = vectorMaker_.rowVector({makeJsonData(json, vectorSize)});
+    std::vector<core::TypedExprPtr> exprs;
+    for (auto i = 0; i < numPaths; ++i) {
+      auto untyped = parse::parseExpr(
+          fmt::format("{}(c0, '$.k{}')", fnName, i * 3), options_);
+      exprs.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    exec::ExprSet exprSet(std::move(exprs), &execCtx_);
+    suspender.dismiss();
+    doRun(iter, exprSet, rowVector);
+  }
+
   void doRun(
       const int iter,
       velox::exec::ExprSet& exprSet,
@@ -162,6 +190,22 @@ void SIMDJsonArrayLength(int iter, int vectorSize, int jsonSize) {
   benchmark.runWithJson(iter, vectorSize, "simd_json_array_length", json);
 }
 
+void FollyJsonExtractScalar(int iter, int vectorSize, int numPaths) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalar(
+      iter, vectorSize, "folly_json_extract_scalar", numPaths);
+}
+
+void JsonExtractScalar(int iter, int vectorSize, int numPaths) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  suspender.dismiss();
+  benchmark.runWithJsonExtractScalar(
+      iter, vectorSize, "json_extract_scalar", numPaths);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(FollyIsJsonScalar, 100_iters_10bytes_size, 100, 10);
@@ -282,6 +326,15 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(FollyJsonExtractScalar, 100_iters_1_path, 100, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(JsonExtractScalar, 100_iters_1_path, 100, 1);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(FollyJsonExtractScalar, 100_iters_5_paths, 100, 5);
+BENCHMARK_RELATIVE_NAMED_PARAM(JsonExtractScalar, 100_iters_5_paths, 100, 5);
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 } // namespace facebook::velox::functions::prestosql
 
@@ -171,6 +171,19 @@ bool isScalarType(const folly::Optional<folly::dynamic>& json) {
       !json->isNull();
 }
 
+folly::Optional<std::string> toScalar(
+    const folly::Optional<folly::dynamic>& json) {
+  // Not a scalar value
+  if (isScalarType(json)) {
+    if (json->isBool()) {
+      return json->asBool() ? std::string{"true"} : std::string{"false"};
+    } else {
+      return json->asString();
+    }
+  }
+  return folly::none;
+}
+
 } // namespace
 
 folly::Optional<folly::dynamic> jsonExtract(
@@ -210,16 +223,13 @@ folly::Optional<folly::dynamic> jsonExtract(
 folly::Optional<std::string> jsonExtractScalar(
     folly::StringPiece json,
     folly::StringPiece path) {
-  auto res = jsonExtract(json, path);
-  // Not a scalar value
-  if (isScalarType(res)) {
-    if (res->isBool()) {
-      return res->asBool() ? std::string{"true"} : std::string{"false"};
-    } else {
-      return res->asString();
-    }
-  }
-  return folly::none;
+  return toScalar(jsonExtract(json, path));
+}
+
+folly::Optional<std::string> jsonExtractScalar(
+    const folly::dynamic& json,
+    folly::StringPiece path) {
+  return toScalar(jsonExtract(json, path));
 }
 
 folly::Optional<std::string> jsonExtractScalar(
@@ -63,6 +63,12 @@ folly::Optional<std::string> jsonExtractScalar(
     folly::StringPiece json,
     folly::StringPiece path);
 
+/// Same as above for a parsed 'json'. Allows parsing a document once for
+/// several paths.
+folly::Optional<std::string> jsonExtractScalar(
+    const folly::dynamic& json,
+    folly::StringPiece path);
+
 folly::Optional<folly::dynamic> jsonExtract(
     const std::string& json,
     const std::string& path);
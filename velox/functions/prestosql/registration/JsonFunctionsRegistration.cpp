@@ -25,10 +25,8 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<SIMDIsJsonScalarFunction, bool, Json>(
       {prefix + "is_json_scalar"});
 
-  registerFunction<JsonExtractScalarFunction, Varchar, Json, Varchar>(
-      {prefix + "json_extract_scalar"});
-  registerFunction<JsonExtractScalarFunction, Varchar, Varchar, Varchar>(
-      {prefix + "json_extract_scalar"});
+  VELOX_REGISTER_VECTOR_FUNCTION(
+      udf_json_extract_scalar, prefix + "json_extract_scalar");
 
   registerFunction<JsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
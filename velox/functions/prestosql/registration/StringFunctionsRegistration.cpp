@@ -22,6 +22,12 @@
 namespace facebook::velox::functions {
 
 namespace {
+// Compiled patterns are only read when matching, so that all drivers can share
+// the instance built for a constant pattern.
+const exec::VectorFunctionMetadata kRegexMetadata{
+    false /* supportsFlattening */,
+    true /* supportsSharing */};
+
 std::shared_ptr<exec::VectorFunction> makeRegexExtract(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs) {
@@ -58,7 +64,7 @@ void registerSimpleFunctions(const std::string& prefix) {
       {prefix + "rpad"});
 
   exec::registerStatefulVectorFunction(
-      prefix + "like", likeSignatures(), makeLike);
+      prefix + "like", likeSignatures(), makeLike, kRegexMetadata);
 
   registerFunction<SplitPart, Varchar, Varchar, Varchar, int64_t>(
       {prefix + "split_part"});
@@ -83,13 +89,33 @@ void registerStringFunctions(const std::string& prefix) {
 
   // Regex functions
   exec::registerStatefulVectorFunction(
-      prefix + "regexp_extract", re2ExtractSignatures(), makeRegexExtract);
+      prefix + "regexp_extract",
+      re2ExtractSignatures(),
+      makeRegexExtract,
+      kRegexMetadata);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_extract_all",
       re2ExtractAllSignatures(),
-      makeRe2ExtractAll);
+      makeRe2ExtractAll,
+      kRegexMetadata);
+  exec::registerStatefulVectorFunction(
+      prefix + "regexp_like",
+      re2SearchSignatures(),
+      makeRe2Search,
+      kRegexMetadata);
   exec::registerStatefulVectorFunction(
-      prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+      prefix + "$internal$regexp_like_any",
+      re2SearchAnySignatures(),
+      makeRe2SearchAny,
+      kRegexMetadata);
+  // Matches the LIKEs and regexp_likes of a disjunction on one string in one
+  // pass.
+  exec::registerExpressionRewrite(
+      prefix + "regexp_like_any",
+      makeRe2DisjunctionRewrite(
+          prefix + "like",
+          prefix + "regexp_like",
+          prefix + "$internal$regexp_like_any"));
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
@@ -117,6 +117,41 @@ TEST_F(ArithmeticTest, multiply) {
       "integer overflow: -2147483648 * -1");
 }
 
+TEST_F(ArithmeticTest, tryOverflow) {
+  constexpr auto kMax = std::numeric_limits<int64_t>::max();
+  constexpr auto kMin = std::numeric_limits<int64_t>::min();
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>({1, kMax, kMin, 10, kMin}),
+      makeFlatVector<int64_t>({2, 1, 1, 0, -1}),
+  });
+
+  // The checked functions return errors without throwing. TRY turns the
+  // failing rows into nulls.
+  auto test = [&](const std::string& expression,
+                  const std::vector<std::optional<int64_t>>& expected) {
+    SCOPED_TRACE(expression);
+    assertEqualVectors(
+        makeNullableFlatVector<int64_t>(expected),
+        evaluate(fmt::format("try({})", expression), data));
+  };
+  test("c0 + c1", {3, std::nullopt, kMin + 1, 10, std::nullopt});
+  test("c0 - c1", {-1, kMax - 1, std::nullopt, 10, kMin + 1});
+  test("c0 * c1", {2, kMax, kMin, 0, std::nullopt});
+  test("c0 / c1", {0, kMax, kMin, std::nullopt, std::nullopt});
+  test("c0 % c1", {1, 0, 0, std::nullopt, 0});
+  test("-c0", {-1, -kMax, std::nullopt, -10, std::nullopt});
+
+  // Without TRY the errors are thrown as arithmetic errors.
+  try {
+    evaluate("c0 + c1", data);
+    FAIL() << "Expected an exception";
+  } catch (const VeloxUserError& e) {
+    EXPECT_EQ(e.errorCode(), error_code::kArithmeticError);
+    EXPECT_EQ(e.message(), "integer overflow: 9223372036854775807 + 1");
+  }
+  VELOX_ASSERT_THROW(evaluate("c0 % c1", data), "Cannot divide by 0");
+}
+
 TEST_F(ArithmeticTest, mod) {
   std::vector<double> numerDouble = {0, 6, 0, -7, -1, -9, 9, 10.1};
   std::vector<double> denomDouble = {1, 2, -1, 3, -1, -3, -3, -99.9};
@@ -329,3 +329,40 @@ TEST_F(ArrayDistinctTest, constant) {
   expected = makeConstantArray<int64_t>(size, {6});
   assertEqualVectors(expected, result);
 }
+
+// Arrays around the size where the function switches from comparing values to
+// a hash set.
+TEST_F(ArrayDistinctTest, smallAndLargeArrays) {
+  auto array = makeNullableArrayVector<int64_t>({
+      {1, 2, 1, std::nullopt, 3, 2, std::nullopt, 4},
+      {1, 2, 1, std::nullopt, 3, 2, std::nullopt, 4, 5},
+      {5, 4, 3, 2, 1, 1, 2, 3, 4, 5, 6, std::nullopt, 6, 7, std::nullopt},
+  });
+  auto expected = makeNullableArrayVector<int64_t>({
+      {1, 2, std::nullopt, 3, 4},
+      {1, 2, std::nullopt, 3, 4, 5},
+      {5, 4, 3, 2, 1, 6, std::nullopt, 7},
+  });
+  testExpr(expected, "array_distinct(C0)", {array});
+
+  using S = StringView;
+  const S longString("a long string value");
+  auto strings = makeNullableArrayVector<StringView>({
+      {S("a"), S("b"), S("a"), longString, S("b")},
+      {S("a"),
+       S("b"),
+       S("c"),
+       S("d"),
+       longString,
+       S("e"),
+       S("f"),
+       longString,
+       S("a"),
+       S("g")},
+  });
+  auto expectedStrings = makeNullableArrayVector<StringView>({
+      {S("a"), S("b"), longString},
+      {S("a"), S("b"), S("c"), S("d"), longString, S("e"), S("f"), S("g")},
+  });
+  testExpr(expectedStrings, "array_distinct(C0)", {strings});
+}
@@ -325,3 +325,27 @@ TEST_F(ArrayExceptTest, dictionaryEncodedElementsInConstant) {
       "array_except(c0, testing_dictionary_array_elements(ARRAY [0, 1, 3, 2, 2, 3, 2]))",
       {array});
 }
+
+// Left and right-hand side arrays below and above the size where the function
+// switches from linear searches to hash sets.
+TEST_F(ArrayExceptTest, smallAndLargeArrays) {
+  auto left = makeNullableArrayVector<int32_t>({
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 1, 2, std::nullopt},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 1, 2, std::nullopt},
+      {3, 1, 3, std::nullopt},
+      {3, 1, 3, std::nullopt},
+  });
+  auto right = makeNullableArrayVector<int32_t>({
+      {2, 4, 6, 8, 10, 12, 14, 16, 18, std::nullopt},
+      {9, 1, 1},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10},
+      {std::nullopt, 3},
+  });
+  auto expected = makeNullableArrayVector<int32_t>({
+      {1, 3, 5, 7, 9},
+      {2, 3, 4, 5, 6, 7, 8, std::nullopt},
+      {std::nullopt},
+      {1},
+  });
+  testExpr(expected, "array_except(C0, C1)", {left, right});
+}
@@ -227,6 +227,35 @@ class ArraySortTest : public FunctionBaseTest,
     }
   }
 
+  // Sorts arrays of sizes that take the sorting network, insertion sort,
+  // radix sort and std::sort paths, with negative values, duplicates and
+  // nulls.
+  template <typename T>
+  void testArraySizes() {
+    std::vector<std::vector<std::optional<T>>> arrays;
+    for (auto size : {0, 1, 2, 3, 4, 5, 8, 9, 17, 100, 255, 256, 1'000}) {
+      std::vector<std::optional<T>> array;
+      for (auto i = 0; i < size; ++i) {
+        if (i % 11 == 3) {
+          array.push_back(std::nullopt);
+        } else {
+          // The product wraps around to negative values of T.
+          array.push_back(static_cast<T>((i * 0x9E3779B1LL + size) >> 7));
+        }
+      }
+      arrays.push_back(std::move(array));
+    }
+    auto input = makeNullableArrayVector<T>(arrays);
+
+    for (auto& array : arrays) {
+      std::sort(array.begin(), array.end(), [](const auto& a, const auto& b) {
+        return a.has_value() && (!b.has_value() || *a < *b);
+      });
+    }
+    auto result = evaluate("array_sort(c0)", makeRowVector({input}));
+    assertEqualVectors(makeNullableArrayVector<T>(arrays), result);
+  }
+
   // Specify the number of values per each data vector in 'dataVectorsByType_'.
   const int numValues_;
   std::unordered_map<TypeKind, VectorPtr> dataVectorsByType_;
@@ -516,6 +545,14 @@ TEST_F(ArraySortTest, wellFormedVectors) {
       arrayVec->elements()->size());
 }
 
+TEST_F(ArraySortTest, arraySizes) {
+  testArraySizes<int8_t>();
+  testArraySizes<int16_t>();
+  testArraySizes<int32_t>();
+  testArraySizes<int64_t>();
+  testArraySizes<double>();
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     ArraySortTest,
     ArraySortTest,
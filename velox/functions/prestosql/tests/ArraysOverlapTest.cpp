@@ -228,3 +228,25 @@ TEST_F(ArraysOverlapTest, dictionaryEncodedElementsInConstant) {
       "arrays_overlap(testing_dictionary_array_elements(ARRAY [2, 2, 3, 1, 2, 2]), c0)",
       {array});
 }
+
+// Right-hand side arrays below and above the size where the function switches
+// from linear searches to hash sets.
+TEST_F(ArraysOverlapTest, smallAndLargeArrays) {
+  auto left = makeNullableArrayVector<int32_t>({
+      {20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30},
+      {20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30},
+      {20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30},
+      {1, 2},
+      {std::nullopt, 2},
+  });
+  auto right = makeNullableArrayVector<int32_t>({
+      {1, 2, 3},
+      {1, 2, 3, 30},
+      {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, std::nullopt},
+      {0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 2},
+      {3, std::nullopt},
+  });
+  auto expected = makeNullableFlatVector<bool>(
+      {false, true, std::nullopt, true, std::nullopt});
+  testExpr(expected, "arrays_overlap(C0, C1)", {left, right});
+}
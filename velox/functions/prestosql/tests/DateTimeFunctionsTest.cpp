@@ -441,6 +441,51 @@ TEST_F(DateTimeFunctionsTest, year) {
   EXPECT_EQ(2001, year(Timestamp(998423705, 321000000)));
 }
 
+// The date fields are computed with integer arithmetic and the time zone
+// offsets are cached between transitions. Checks these against gmtime_r and
+// the time zone database over a wide range of timestamps.
+TEST_F(DateTimeFunctionsTest, dateFieldsBatch) {
+  constexpr int32_t kSize = 10'000;
+  // Steps of about 29.7 days and 19 hours cover about 800 years around the
+  // epoch and every time of day.
+  constexpr int64_t kStep = 2'569'019;
+  auto timestamps = makeFlatVector<Timestamp>(kSize, [&](auto row) {
+    return Timestamp((row - kSize / 2) * kStep, 0);
+  });
+  auto data = makeRowVector({timestamps});
+
+  for (const auto* timeZoneName : {"", "America/Los_Angeles", "Asia/Kolkata"}) {
+    const date::time_zone* timeZone = nullptr;
+    if (*timeZoneName != '\0') {
+      setQueryTimeZone(timeZoneName);
+      timeZone = date::locate_zone(timeZoneName);
+    }
+    auto year = evaluate<SimpleVector<int64_t>>("year(c0)", data);
+    auto month = evaluate<SimpleVector<int64_t>>("month(c0)", data);
+    auto day = evaluate<SimpleVector<int64_t>>("day(c0)", data);
+    auto hour = evaluate<SimpleVector<int64_t>>("hour(c0)", data);
+    auto dayOfWeek = evaluate<SimpleVector<int64_t>>("day_of_week(c0)", data);
+    auto dayOfYear = evaluate<SimpleVector<int64_t>>("day_of_year(c0)", data);
+    for (auto i = 0; i < kSize; ++i) {
+      time_t seconds = timestamps->valueAt(i).getSeconds();
+      if (timeZone != nullptr) {
+        const date::sys_seconds utc{std::chrono::seconds(seconds)};
+        seconds += timeZone->get_info(utc).offset.count();
+      }
+      std::tm expected;
+      ASSERT_NE(gmtime_r(&seconds, &expected), nullptr);
+      SCOPED_TRACE(fmt::format("{} {}", timeZoneName, seconds));
+      ASSERT_EQ(year->valueAt(i), 1900 + expected.tm_year);
+      ASSERT_EQ(month->valueAt(i), 1 + expected.tm_mon);
+      ASSERT_EQ(day->valueAt(i), expected.tm_mday);
+      ASSERT_EQ(hour->valueAt(i), expected.tm_hour);
+      ASSERT_EQ(
+          dayOfWeek->valueAt(i), expected.tm_wday == 0 ? 7 : expected.tm_wday);
+      ASSERT_EQ(dayOfYear->valueAt(i), 1 + expected.tm_yday);
+    }
+  }
+}
+
 TEST_F(DateTimeFunctionsTest, yearDate) {
   const auto year = [&](std::optional<Date> date) {
     return evaluateOnce<int64_t>("year(c0)", date);
@@ -351,6 +351,44 @@ TEST_F(DecimalArithmeticTest, decimalDivTest) {
       "Decimal overflow: 99999999999999999999999999999999999999 * 10000");
 }
 
+// Long decimals that fit in 64 bits are multiplied and divided with 64-bit
+// instructions. Checks that they give the same results as wider values in
+// the same vector.
+TEST_F(DecimalArithmeticTest, longDecimalMixedMagnitudes) {
+  const int128_t kTwoTo64 = HugeInt::build(1, 0);
+  auto a = makeLongDecimalFlatVector(
+      {17, -77, 3 * kTwoTo64 + 1, -2 * kTwoTo64 + 1, 1'000'000'007, 5},
+      DECIMAL(38, 0));
+  auto b = makeLongDecimalFlatVector(
+      {5, 11, 3, 2, -(int128_t(1) << 40), kTwoTo64}, DECIMAL(38, 0));
+
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeLongDecimalFlatVector(
+          {85,
+           -847,
+           9 * kTwoTo64 + 3,
+           -4 * kTwoTo64 + 2,
+           -1'000'000'007 * (int128_t(1) << 40),
+           5 * kTwoTo64},
+          DECIMAL(38, 0)),
+      "c0 * c1",
+      {a, b});
+
+  // Divide and round-up.
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeLongDecimalFlatVector(
+          {3, -7, kTwoTo64, -kTwoTo64, 0, 0}, DECIMAL(38, 0)),
+      "c0 / c1",
+      {a, b});
+  testDecimalExpr<TypeKind::HUGEINT>(
+      makeLongDecimalFlatVector(
+          {DecimalUtil::kPowersOfTen[30] / 7}, DECIMAL(38, 0)),
+      "c0 / c1",
+      {makeLongDecimalFlatVector(
+           {DecimalUtil::kPowersOfTen[30]}, DECIMAL(38, 0)),
+       makeLongDecimalFlatVector({7}, DECIMAL(38, 0))});
+}
+
 TEST_F(DecimalArithmeticTest, decimalDivDifferentTypes) {
   testDecimalExpr<TypeKind::BIGINT>(
       {makeShortDecimalFlatVector({1, 1, -1, 1}, DECIMAL(12, 2))},
@@ -62,6 +62,57 @@ class ElementAtTest : public FunctionBaseTest {
         "element_at(C0, C1)", {mapVector, indicesVector}, expectedValueAt);
   }
 
+  // Looks up keys in maps with more keys than fit in one SIMD batch, flat
+  // and wrapped in a dictionary that repeats each map, so that the maps get
+  // a hash index. 'toKey' maps an int to a key of type T.
+  template <typename T>
+  void testLargeMap(std::function<T(vector_size_t)> toKey) {
+    constexpr vector_size_t kMapSize = 100;
+    constexpr vector_size_t kNumMaps = 10;
+    // The keys of each map are in descending order. The values are offsets.
+    auto mapVector = makeMapVector<T, int64_t>(
+        kNumMaps,
+        [](auto /*row*/) { return kMapSize; },
+        [&](auto idx) { return toKey(kMapSize - 1 - idx % kMapSize); },
+        [](auto idx) { return idx; });
+    auto keyAt = [](vector_size_t row) { return row % (kMapSize + 50); };
+    auto indicesVector = makeFlatVector<T>(
+        kVectorSize, [&](vector_size_t row) { return toKey(keyAt(row)); });
+    auto expectedNullAt = [&](vector_size_t row) {
+      return keyAt(row) >= kMapSize;
+    };
+
+    auto mapRow = [](vector_size_t row) { return (row * 7) % kNumMaps; };
+    auto dictionaryMap = wrapInDictionary(
+        makeIndices(kVectorSize, mapRow), kVectorSize, mapVector);
+    testElementAt<int64_t>(
+        "element_at(C0, C1)",
+        {dictionaryMap, indicesVector},
+        [&](vector_size_t row) {
+          return mapRow(row) * kMapSize + kMapSize - 1 - keyAt(row);
+        },
+        expectedNullAt);
+
+    auto flatIndices = makeFlatVector<T>(
+        kNumMaps, [&](vector_size_t row) { return toKey(keyAt(row * 13)); });
+    testElementAt<int64_t>(
+        "element_at(C0, C1)",
+        {mapVector, flatIndices},
+        [&](vector_size_t row) {
+          return row * kMapSize + kMapSize - 1 - keyAt(row * 13);
+        },
+        [&](vector_size_t row) { return keyAt(row * 13) >= kMapSize; });
+
+    // A constant key looked up in the repeated maps.
+    testElementAt<int64_t>(
+        "element_at(C0, C1)",
+        {dictionaryMap, makeConstant(toKey(3), kVectorSize)},
+        [&](vector_size_t row) {
+          return mapRow(row) * kMapSize + kMapSize - 1 - 3;
+        },
+        [](vector_size_t /*row*/) { return false; });
+  }
+
   template <typename T = int64_t>
   std::optional<T> elementAtSimple(
       const std::string& expression,
@@ -665,6 +716,39 @@ TEST_F(ElementAtTest, variableInputMap) {
   testVariableInputMap<StringView>(); // VARCHAR
 }
 
+TEST_F(ElementAtTest, largeMap) {
+  testLargeMap<int64_t>([](auto i) { return i * 1'000'003; });
+  testLargeMap<int32_t>([](auto i) { return i; });
+  testLargeMap<int16_t>([](auto i) { return i - 50; });
+  testLargeMap<int8_t>([](auto i) { return i - 50; });
+  testLargeMap<float>([](auto i) { return i * 0.5; });
+  testLargeMap<double>([](auto i) { return i * 0.25; });
+  testLargeMap<StringView>([](auto i) {
+    return StringView::makeInline(folly::to<std::string>("key", i));
+  });
+}
+
+TEST_F(ElementAtTest, duplicateKeysInLargeMap) {
+  // Maps of 40 keys where each key appears twice. The first match is
+  // returned with and without a hash index.
+  auto mapVector = makeMapVector<int64_t, int64_t>(
+      2,
+      [](auto /*row*/) { return 40; },
+      [](auto idx) { return idx % 20; },
+      [](auto idx) { return idx; });
+  auto dictionaryMap = wrapInDictionary(
+      makeIndices(kVectorSize, [](auto row) { return row % 2; }),
+      kVectorSize,
+      mapVector);
+  auto keys = makeFlatVector<int64_t>(
+      kVectorSize, [](vector_size_t row) { return row % 25; });
+  testElementAt<int64_t>(
+      "element_at(C0, C1)",
+      {dictionaryMap, keys},
+      [](vector_size_t row) { return (row % 2) * 40 + row % 25; },
+      [](vector_size_t row) { return row % 25 >= 20; });
+}
+
 TEST_F(ElementAtTest, variableInputArray) {
   {
     auto indicesVector = makeFlatVector<int64_t>(
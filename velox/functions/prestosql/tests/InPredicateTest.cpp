@@ -167,21 +167,83 @@ class InPredicateTest : public FunctionBaseTest {
     result = evaluate<SimpleVector<bool>>("c1 IN (1, 3, 5)", rowVector);
     assertEqualVectors(constNull, result);
   }
+
+  // Tests IN lists whose values are spread too far apart for a bitmask, so
+  // that they are tested by comparing with each value or by a binary search
+  // depending on the number of values. The in-list has 'numValues' multiples
+  // of 'step' and every other multiple in the input is in the list.
+  template <typename T>
+  void testSparseIntegers(int32_t numValues, int32_t step) {
+    const vector_size_t size = 1'000;
+    auto valueAt = [&](auto row) {
+      return static_cast<T>(
+          row % (2 * numValues) * step + (row % 5 == 0));
+    };
+    auto isIn = [&](auto row) {
+      return row % (2 * numValues) % 2 == 0 && row % 5 != 0;
+    };
+    auto rowVector = makeRowVector({
+        makeFlatVector<T>(size, valueAt),
+        makeFlatVector<T>(size, valueAt, nullEvery(7)),
+    });
+
+    std::ostringstream inList;
+    for (auto i = 0; i < 2 * numValues; i += 2) {
+      inList << (i == 0 ? "" : ", ") << i * step;
+    }
+
+    auto result = evaluate<SimpleVector<bool>>(
+        fmt::format("c0 IN ({})", inList.str()), rowVector);
+    assertEqualVectors(makeFlatVector<bool>(size, isIn), result);
+
+    result = evaluate<SimpleVector<bool>>(
+        fmt::format("c1 IN ({})", inList.str()), rowVector);
+    assertEqualVectors(
+        makeFlatVector<bool>(size, isIn, nullEvery(7)), result);
+
+    // Only the selected rows of a reused result are changed.
+    SelectivityVector rows(size);
+    for (auto row = 0; row < size; row += 3) {
+      rows.setValid(row, false);
+    }
+    rows.setValid(size - 1, false);
+    rows.updateBounds();
+    VectorPtr reused = makeFlatVector<bool>(size, [](auto row) {
+      return row % 2 == 0;
+    });
+    result = evaluate<SimpleVector<bool>>(
+        fmt::format("c0 IN ({})", inList.str()), rowVector, rows, reused);
+    assertEqualVectors(
+        makeFlatVector<bool>(
+            size,
+            [&](auto row) {
+              return rows.isValid(row) ? isIn(row) : row % 2 == 0;
+            }),
+        result);
+  }
 };
 
 TEST_F(InPredicateTest, bigint) {
   testIntegers<int64_t>();
   testsIntegerConstant<int64_t>();
+  testSparseIntegers<int64_t>(5, 1'000);
+  testSparseIntegers<int64_t>(100, 1'000);
+  testSparseIntegers<int64_t>(600, 1'000);
 }
 
 TEST_F(InPredicateTest, integer) {
   testIntegers<int32_t>();
   testsIntegerConstant<int32_t>();
+  testSparseIntegers<int32_t>(5, 1'000);
+  testSparseIntegers<int32_t>(100, 1'000);
+  testSparseIntegers<int32_t>(600, 1'000);
 }
 
 TEST_F(InPredicateTest, smallint) {
   testIntegers<int16_t>();
   testsIntegerConstant<int16_t>();
+  testSparseIntegers<int16_t>(5, 300);
+  testSparseIntegers<int16_t>(100, 150);
 }
 
 TEST_F(InPredicateTest, tinyint) {
@@ -208,6 +208,51 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  // Several paths extracted from the same input in one ExprSet share the
+  // parsed documents.
+  auto json = makeNullableFlatVector<StringView>(
+      {R"({"a": 1, "b": {"c": "x"}})",
+       "invalid",
+       std::nullopt,
+       R"({"a": true, "b": []})"},
+      JSON());
+  auto test = [&](const VectorPtr& input,
+                  const std::vector<std::vector<std::optional<StringView>>>&
+                      expected) {
+    auto data = makeRowVector({input});
+    auto exprSet = compileExpressions(
+        {"json_extract_scalar(c0, '$.a')",
+         "json_extract_scalar(c0, '$.b.c')",
+         "json_extract_scalar(c0, '$.b')"},
+        asRowType(data->type()));
+    exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+    SelectivityVector rows(data->size());
+    std::vector<VectorPtr> results(expected.size());
+    exprSet->eval(rows, context, results);
+    for (auto i = 0; i < expected.size(); ++i) {
+      velox::test::assertEqualVectors(
+          makeNullableFlatVector<StringView>(expected[i]), results[i]);
+    }
+  };
+
+  test(
+      json,
+      {{"1", std::nullopt, std::nullopt, "true"},
+       {"x", std::nullopt, std::nullopt, std::nullopt},
+       {std::nullopt, std::nullopt, std::nullopt, std::nullopt}});
+  test(
+      wrapInDictionary(makeIndicesInReverse(4), 4, json),
+      {{"true", std::nullopt, std::nullopt, "1"},
+       {std::nullopt, std::nullopt, std::nullopt, "x"},
+       {std::nullopt, std::nullopt, std::nullopt, std::nullopt}});
+
+  // An invalid path throws even for invalid documents.
+  auto data = makeRowVector({makeFlatVector<StringView>({"invalid"}, JSON())});
+  EXPECT_THROW(
+      evaluate("json_extract_scalar(c0, '$k1')", data), VeloxUserError);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -142,6 +142,36 @@ TEST_F(ReduceTest, finalSelection) {
   assertEqualVectors(expectedResult, result);
 }
 
+// A few long arrays among many short ones. The steps past the end of the
+// short arrays only visit the long ones. The lambda uses a capture.
+TEST_F(ReduceTest, skewedSizes) {
+  vector_size_t size = 1'000;
+  auto sizeAt = [](auto row) { return row % 100 == 7 ? 500 + row : row % 3; };
+  auto inputArray = makeArrayVector<int64_t>(
+      size,
+      sizeAt,
+      [](auto row, auto index) { return row + index; },
+      nullEvery(13));
+  auto input = makeRowVector(
+      {inputArray,
+       makeFlatVector<int64_t>(size, [](auto row) { return row % 4; })});
+
+  auto result = evaluate<SimpleVector<int64_t>>(
+      "reduce(c0, 0, (s, x) -> s + x * c1, s -> s)", input);
+
+  auto expectedResult = makeFlatVector<int64_t>(
+      size,
+      [&](auto row) {
+        int64_t sum = 0;
+        for (auto i = 0; i < sizeAt(row); i++) {
+          sum += (row + i) * (row % 4);
+        }
+        return sum;
+      },
+      nullEvery(13));
+  assertEqualVectors(expectedResult, result);
+}
+
 TEST_F(ReduceTest, elementIndicesOverwrite) {
   auto data = makeRowVector({
       makeFlatVector<int64_t>({1, 2}),
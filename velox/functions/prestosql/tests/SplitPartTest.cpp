@@ -79,6 +79,17 @@ TEST_F(SplitPartTest, basic) {
   EXPECT_EQ("緑の空", split_part("зелёное небоలేదాలేదాలేదా緑の空లేదా", "లేదా", 4));
   EXPECT_EQ("", split_part("зелёное небоలేదాలేదాలేదా緑の空లేదా", "లేదా", 5));
   EXPECT_FALSE(split_part("зелёное небоలేదాలేదాలేదా緑の空లేదా", "లేదా", 6));
+
+  // Long fields with a multi-byte delimiter.
+  const std::string line =
+      "2023-01-01T00:00:00||GET /index.html HTTP/1.1||200||"
+      "Mozilla/5.0 (X11; Linux x86_64)||";
+  EXPECT_EQ("2023-01-01T00:00:00", split_part(line, "||", 1));
+  EXPECT_EQ("GET /index.html HTTP/1.1", split_part(line, "||", 2));
+  EXPECT_EQ("200", split_part(line, "||", 3));
+  EXPECT_EQ("Mozilla/5.0 (X11; Linux x86_64)", split_part(line, "||", 4));
+  EXPECT_EQ("", split_part(line, "||", 5));
+  EXPECT_FALSE(split_part(line, "||", 6).has_value());
 }
 } // namespace
 } // namespace facebook::velox::functions::test
@@ -307,3 +307,43 @@ TEST_F(SplitTest, splitError) {
   // Limit should be positive.
   VELOX_ASSERT_THROW(RUN("split(C0, C1, C2)", 0), "Limit must be positive");
 }
+
+/// The elements of the result refer to the strings of the input and share
+/// its string buffers.
+TEST_F(SplitTest, zeroCopy) {
+  const std::vector<std::string> lines{
+      "2023-01-01T00:00:00||GET /index.html HTTP/1.1||200||Mozilla/5.0",
+      "2023-01-01T00:00:01||POST /api/v1/items HTTP/1.1||201||curl/7.68.0",
+  };
+  auto input = makeFlatVector<std::string>(lines);
+  auto result = evaluate<ArrayVector>(
+      "split(c0, '||')", makeRowVector({input}));
+
+  auto expected = makeArrayVector<StringView>({
+      {"2023-01-01T00:00:00", "GET /index.html HTTP/1.1", "200", "Mozilla/5.0"},
+      {"2023-01-01T00:00:01",
+       "POST /api/v1/items HTTP/1.1",
+       "201",
+       "curl/7.68.0"},
+  });
+  assertEqualVectors(expected, result);
+
+  auto* elements = result->elements()->asFlatVector<StringView>();
+  ASSERT_EQ(elements->stringBuffers().size(), input->stringBuffers().size());
+  for (auto i = 0; i < elements->stringBuffers().size(); ++i) {
+    EXPECT_EQ(elements->stringBuffers()[i], input->stringBuffers()[i]);
+  }
+  for (auto row = 0; row < lines.size(); ++row) {
+    const auto* begin = input->valueAt(row).data();
+    const auto* end = begin + input->valueAt(row).size();
+    for (auto i = result->offsetAt(row);
+         i < result->offsetAt(row) + result->sizeAt(row);
+         ++i) {
+      const auto element = elements->valueAt(i);
+      if (!element.isInline()) {
+        EXPECT_GE(element.data(), begin);
+        EXPECT_LE(element.data() + element.size(), end);
+      }
+    }
+  }
+}
@@ -947,6 +947,16 @@ TEST_F(StringFunctionsTest, stringPosition) {
       {{"\u4FE1\u5FF5,\u7231,\u5E0C\u671B", "\u5E0C\u671B", 1}, 6},
   };
 
+  // Strings longer than a SIMD width, with a near miss that matches only the
+  // first and last byte of the substring.
+  const std::string filler(40, 'a');
+  strpos_input_test_t testsLongWithPosition = {
+      {{filler + "xyz" + filler + "xyz", "xyz", 1}, 41},
+      {{filler + "xyz" + filler + "xyz", "xyz", 2}, 84},
+      {{filler + "xaz" + filler, "xyz", 1}, 0},
+      {{filler + filler + "xy", "xyz", 1}, 0},
+  };
+
   // We dont have to try all encoding combinations here since there is a test
   // that test the encoding resolution but we want to to have a test for each
   // possible resolution
@@ -957,6 +967,8 @@ TEST_F(StringFunctionsTest, stringPosition) {
       testsAsciiWithPosition, {false, false}, true);
   testStringPositionAllFlatVector<int64_t>(
       testsAsciiWithPosition, {false, false}, true);
+  testStringPositionAllFlatVector<int64_t>(
+      testsLongWithPosition, {true, true}, true);
 
   // Test constant vectors
   auto rows = makeRowVector(makeRowType({BIGINT()}), 10);
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -102,6 +105,66 @@ TEST_P(RankTest, rangeFrames) {
   testKRangeFrames(function_);
 }
 
+// Tests all functions with the input spilled and read back a few partitions
+// at a time.
+TEST_P(RankTest, spill) {
+  const std::vector<RowVectorPtr> input = {
+      makeSimpleVector(40), makeSimpleVector(50), makeSimpleVector(60)};
+  createDuckDbTable(input);
+  auto queryInfo = buildWindowQuery(input, function_, overClause_, "");
+  SCOPED_TRACE(queryInfo.functionSql);
+
+  auto spillDirectory = TempDirectoryPath::create();
+  auto task = AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                  .config(core::QueryConfig::kTestingSpillPct, "100")
+                  .assertResults(queryInfo.querySql);
+  auto stats = task->taskStats().pipelineStats;
+  ASSERT_LT(0, stats[0].operatorStats[1].spilledBytes);
+  ASSERT_LT(0, stats[0].operatorStats[1].spilledRows);
+}
+
+class StreamingRankTest : public WindowTestBase {
+ protected:
+  void SetUp() override {
+    WindowTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+};
+
+// Tests all functions on input that is already partitioned and sorted, with
+// partitions spanning several input vectors.
+TEST_F(StreamingRankTest, presortedInput) {
+  constexpr vector_size_t kBatchSize = 10;
+  std::vector<RowVectorPtr> input;
+  for (auto batch = 0; batch < 5; ++batch) {
+    const auto offset = batch * kBatchSize;
+    input.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            kBatchSize, [&](auto row) { return (offset + row) / 12; }),
+        makeFlatVector<int32_t>(
+            kBatchSize, [&](auto row) { return (offset + row) % 12 / 4; }),
+        makeFlatVector<int64_t>(
+            kBatchSize, [&](auto row) { return (offset + row) % 4 + 1; }),
+    }));
+  }
+  createDuckDbTable(input);
+
+  for (const auto& function : kRankFunctions) {
+    const auto functionSql = fmt::format(
+        "{} over (partition by c0 order by c1, c2)", function);
+    SCOPED_TRACE(functionSql);
+    auto plan = PlanBuilder()
+                    .values(input)
+                    .streamingWindow({functionSql})
+                    .planNode();
+    assertQuery(
+        plan, fmt::format("SELECT c0, c1, c2, {} FROM tmp", functionSql));
+  }
+}
+
 // Run above tests for all combinations of rank function and over clauses.
 VELOX_INSTANTIATE_TEST_SUITE_P(
     RankTestInstantiation,
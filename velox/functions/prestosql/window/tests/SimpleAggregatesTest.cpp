@@ -127,6 +127,30 @@ TEST_F(StringAggregatesTest, nonFixedWidthAggregate) {
   testWindowFunction(input, "max(c2)", kOverClauses);
 }
 
+// Tests sliding frames wide enough to be computed from the aggregate states
+// of larger runs of rows.
+TEST_F(StringAggregatesTest, wideSlidingFrames) {
+  auto size = 1'000;
+  auto input = {makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 3; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      makeRandomInputVector(BIGINT(), size, 0.2),
+      makeRandomInputVector(VARCHAR(), size, 0.3),
+  })};
+
+  const std::vector<std::string> kWideFrames = {
+      "rows between 100 preceding and 50 following",
+      "rows between 40 preceding and current row",
+      "rows between current row and unbounded following",
+      "rows between 20 following and 200 following",
+  };
+  const std::vector<std::string> kOverClause = {"partition by c0 order by c1"};
+  for (const auto& function :
+       {"sum(c2)", "count(c2)", "avg(c2)", "min(c3)", "max(c3)"}) {
+    testWindowFunction(input, function, kOverClause, kWideFrames);
+  }
+}
+
 class KPrecedingFollowingTest : public WindowTestBase {
  public:
   const std::vector<std::string> kRangeFrames = {
@@ -207,6 +231,34 @@ TEST_F(KPrecedingFollowingTest, rangeFrames3) {
   }
 }
 
+TEST_F(KPrecedingFollowingTest, rangeFramesLargePartitions) {
+  // Partitions of 500 rows with repeated order by values.
+  auto size = 1'000;
+  auto vectors = makeRowVector({
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 2; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row / 3; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row % 5 + 1; }),
+  });
+
+  const std::vector<std::string> kFrames = {
+      "range between 20 preceding and current row",
+      "range between 10 preceding and 30 following",
+      "range between c2 preceding and c2 following",
+  };
+  // Frames that are empty at the start or the end of the partitions. These
+  // are only tested with sum, which is null for an empty frame.
+  const std::vector<std::string> kEmptyFrames = {
+      "range between 5 following and 40 following",
+      "range between 40 preceding and 5 preceding",
+  };
+  for (const auto& overClause :
+       {"partition by c0 order by c1", "partition by c0 order by c1 desc"}) {
+    testWindowFunction({vectors}, "count(c1)", {overClause}, kFrames);
+    testWindowFunction({vectors}, "sum(c1)", {overClause}, kFrames);
+    testWindowFunction({vectors}, "sum(c1)", {overClause}, kEmptyFrames);
+  }
+}
+
 TEST_F(KPrecedingFollowingTest, rowsFrames) {
   auto vectors = makeRowVector({
       makeFlatVector<int64_t>({1, 1, 2147483650, 3, 2, 2147483650}),
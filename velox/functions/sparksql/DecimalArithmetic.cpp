@@ -455,9 +455,11 @@ class Multiply {
       bool* overflow) {
     // derive from Arrow
     if (rPrecision < 38) {
-      auto res = checkedMultiply<R>(
-          checkedMultiply<R>(a, b),
-          R(DecimalUtil::kPowersOfTen[aRescale + bRescale]));
+      auto res = DecimalUtil::multiply<R>(a, b);
+      if (aRescale + bRescale > 0) {
+        res = DecimalUtil::multiply<R>(
+            res, DecimalUtil::kPowersOfTen[aRescale + bRescale]);
+      }
       if (!*overflow) {
         r = res;
       }
@@ -468,7 +470,7 @@ class Multiply {
       auto deltaScale = aScale + bScale - rScale;
       if (deltaScale == 0) {
         // No scale down
-        auto res = checkedMultiply<R>(a, b);
+        auto res = DecimalUtil::multiply<R>(a, b);
         if (!*overflow) {
           r = res;
         }
@@ -515,7 +517,7 @@ class Multiply {
           if (LIKELY(deltaScale <= 38)) {
             // The largest value that result can have here is (2^64 - 1) * (2^63
             // - 1), which is greater than BasicDecimal128::kMaxValue.
-            auto res = checkedMultiply<R>(a, b);
+            auto res = DecimalUtil::multiply<R>(a, b);
             VELOX_DCHECK(!*overflow);
             // Since deltaScale is greater than zero, result can now be at most
             // ((2^64 - 1) * (2^63 - 1)) / 10, which is less than
@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/type/DecimalUtil.h"
 #include "velox/vector/FlatVector.h"
@@ -25,6 +26,91 @@
 namespace facebook::velox::functions::sparksql {
 namespace {
 
+// Hashes the values of a flat column at 'rows' into 'hashes', using the
+// previous 'hashes' as seeds. If 'rows' is a contiguous range, 'hashRange'
+// hashes the range several rows at a time. Otherwise 'hashRow' hashes one
+// row.
+template <typename T, typename HashType, typename HashRange, typename HashRow>
+void hashFlat(
+    const T* values,
+    const SelectivityVector& rows,
+    HashType* hashes,
+    HashRange hashRange,
+    HashRow hashRow) {
+  if (rows.isAllSelected()) {
+    hashRange(
+        values + rows.begin(),
+        rows.end() - rows.begin(),
+        hashes + rows.begin());
+    return;
+  }
+  rows.applyToSelected(
+      [&](auto row) { hashes[row] = hashRow(values[row], hashes[row]); });
+}
+
+// Hashes a flat column without decoding each row. Returns false if the type
+// of the column has no such path.
+template <typename HashClass, typename HashType>
+bool hashFlatColumn(
+    HashClass& hash,
+    TypeKind kind,
+    const DecodedVector& decoded,
+    const SelectivityVector& rows,
+    HashType* hashes) {
+  static_assert(sizeof(Date) == sizeof(int32_t));
+  auto hashInt32s = [&](const int32_t* values, auto size, HashType* out) {
+    hash.hashInt32s(values, size, out);
+  };
+  auto hashInt32 = [&](int32_t value, HashType seed) {
+    return hash.hashInt32(value, seed);
+  };
+  switch (kind) {
+    case TypeKind::INTEGER:
+      hashFlat(decoded.data<int32_t>(), rows, hashes, hashInt32s, hashInt32);
+      return true;
+    case TypeKind::DATE:
+      // A Date hashes as its int32_t days.
+      hashFlat(
+          reinterpret_cast<const int32_t*>(decoded.data<Date>()),
+          rows,
+          hashes,
+          hashInt32s,
+          hashInt32);
+      return true;
+    case TypeKind::BIGINT:
+      hashFlat(
+          decoded.data<int64_t>(),
+          rows,
+          hashes,
+          [&](const int64_t* values, auto size, HashType* out) {
+            hash.hashInt64s(values, size, out);
+          },
+          [&](int64_t value, HashType seed) {
+            return hash.hashInt64(value, seed);
+          });
+      return true;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      auto hashString = [&](const StringView& value, HashType seed) {
+        return hash.hashBytes(value, seed);
+      };
+      hashFlat(
+          decoded.data<StringView>(),
+          rows,
+          hashes,
+          [&](const StringView* values, auto size, HashType* out) {
+            for (auto i = 0; i < size; ++i) {
+              out[i] = hashString(values[i], out[i]);
+            }
+          },
+          hashString);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <typename ReturnType, typename HashClass, typename SeedType>
@@ -44,6 +130,10 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](int row) { result.set(row, seed); });
+  // The hashes are computed on unsigned types to avoid undefined overflow.
+  auto* rawHashes =
+      reinterpret_cast<std::make_unsigned_t<ReturnType>*>(
+          result.mutableRawValues());
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -57,6 +147,11 @@ void applyWithType(
           decoded->nulls(), rows.begin(), rows.end());
       selected = selectedMinusNulls.get();
     }
+    if (decoded->isIdentityMapping() &&
+        hashFlatColumn(
+            hash, args[i]->type()->kind(), *decoded, *selected, rawHashes)) {
+      continue;
+    }
     switch (args[i]->type()->kind()) {
 // Derived from InterpretedHashFunction.hash:
 // https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
@@ -100,7 +195,7 @@ void applyWithType(
 class Murmur3Hash final {
  public:
   uint32_t hashInt32(int32_t input, uint32_t seed) {
-    uint32_t k1 = mixK1(input);
+    uint32_t k1 = mixK1<uint32_t>(input);
     uint32_t h1 = mixH1(seed, k1);
     return fmix(h1, 4);
   }
@@ -118,6 +213,41 @@ class Murmur3Hash final {
     return fmix(h1, 8);
   }
 
+  // Hashes 'size' values into 'hashes', using the previous 'hashes' as seeds.
+  // Runs one SIMD lane per value.
+  void hashInt32s(const int32_t* values, int32_t size, uint32_t* hashes) {
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      auto k1 = mixK1(
+          Batch::load_unaligned(reinterpret_cast<const uint32_t*>(values + i)));
+      auto h1 = mixH1(Batch::load_unaligned(hashes + i), k1);
+      fmix(h1, 4).store_unaligned(hashes + i);
+    }
+    for (; i < size; ++i) {
+      hashes[i] = hashInt32(values[i], hashes[i]);
+    }
+  }
+
+  void hashInt64s(const int64_t* values, int32_t size, uint32_t* hashes) {
+    uint32_t low[kBatchSize];
+    uint32_t high[kBatchSize];
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      for (auto j = 0; j < kBatchSize; ++j) {
+        const uint64_t value = values[i + j];
+        low[j] = value;
+        high[j] = value >> 32;
+      }
+      auto h1 = mixH1(
+          Batch::load_unaligned(hashes + i), mixK1(Batch::load_unaligned(low)));
+      h1 = mixH1(h1, mixK1(Batch::load_unaligned(high)));
+      fmix(h1, 8).store_unaligned(hashes + i);
+    }
+    for (; i < size; ++i) {
+      hashes[i] = hashInt64(values[i], hashes[i]);
+    }
+  }
+
   // Floating point numbers are hashed as if they are integers, with
   // -0f defined to have the same output as +0f.
   uint32_t hashFloat(float input, uint32_t seed) {
@@ -140,7 +270,7 @@ class Murmur3Hash final {
       h1 = mixH1(h1, mixK1(*reinterpret_cast<const uint32_t*>(i)));
     }
     for (; i != end; ++i) {
-      h1 = mixH1(h1, mixK1(*i));
+      h1 = mixH1(h1, mixK1<uint32_t>(*i));
     }
     return fmix(h1, input.size());
   }
@@ -161,27 +291,39 @@ class Murmur3Hash final {
   }
 
  private:
-  uint32_t mixK1(uint32_t k1) {
-    k1 *= 0xcc9e2d51;
-    k1 = bits::rotateLeft(k1, 15);
-    k1 *= 0x1b873593;
+  using Batch = xsimd::batch<uint32_t>;
+  static constexpr int32_t kBatchSize = Batch::size;
+
+  // The mix functions take either a uint32_t or a Batch of them.
+  template <typename T>
+  static T rotateLeft(T x, int32_t bits) {
+    return (x << bits) | (x >> (32 - bits));
+  }
+
+  template <typename T>
+  static T mixK1(T k1) {
+    k1 *= T(0xcc9e2d51);
+    k1 = rotateLeft(k1, 15);
+    k1 *= T(0x1b873593);
     return k1;
   }
 
-  uint32_t mixH1(uint32_t h1, uint32_t k1) {
+  template <typename T>
+  static T mixH1(T h1, T k1) {
     h1 ^= k1;
-    h1 = bits::rotateLeft(h1, 13);
-    h1 = h1 * 5 + 0xe6546b64;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * T(5) + T(0xe6546b64);
     return h1;
   }
 
   // Finalization mix - force all bits of a hash block to avalanche
-  uint32_t fmix(uint32_t h1, uint32_t length) {
-    h1 ^= length;
+  template <typename T>
+  static T fmix(T h1, uint32_t length) {
+    h1 ^= T(length);
     h1 ^= h1 >> 16;
-    h1 *= 0x85ebca6b;
+    h1 *= T(0x85ebca6b);
     h1 ^= h1 >> 13;
-    h1 *= 0xc2b2ae35;
+    h1 *= T(0xc2b2ae35);
     h1 ^= h1 >> 16;
     return h1;
   }
@@ -226,6 +368,21 @@ class XxHash64 final {
     return fmix(hash);
   }
 
+  // Hashes 'size' values into 'hashes', using the previous 'hashes' as seeds.
+  // There are no 64 bit SIMD multiplies before AVX-512, so these are tight
+  // scalar loops over the raw values.
+  void hashInt32s(const int32_t* values, int32_t size, uint64_t* hashes) {
+    for (auto i = 0; i < size; ++i) {
+      hashes[i] = hashInt32(values[i], hashes[i]);
+    }
+  }
+
+  void hashInt64s(const int64_t* values, int32_t size, uint64_t* hashes) {
+    for (auto i = 0; i < size; ++i) {
+      hashes[i] = hashInt64(values[i], hashes[i]);
+    }
+  }
+
   // Floating point numbers are hashed as if they are integers, with
   // -0f defined to have the same output as +0f.
   int64_t hashFloat(float input, uint64_t seed) {
@@ -260,18 +417,18 @@ class XxHash64 final {
     return fmix(hash);
   }
 
-  uint32_t hashDate(Date input, uint32_t seed) {
+  int64_t hashDate(Date input, uint64_t seed) {
     return hashInt32(input.days(), seed);
   }
 
-  uint32_t hashInt128(int128_t input, uint32_t seed) {
+  int64_t hashInt128(int128_t input, uint64_t seed) {
     char* data = DecimalUtil::ToByteArray(input);
     auto value = hashBytes(StringView(data, 16), seed);
     delete data;
     return value;
   }
 
-  uint32_t hashTimestamp(Timestamp input, uint32_t seed) {
+  int64_t hashTimestamp(Timestamp input, uint64_t seed) {
     return hashInt64(input.toMicros(), seed);
   }
 
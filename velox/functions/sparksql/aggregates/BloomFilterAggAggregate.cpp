@@ -45,9 +45,9 @@ struct BloomFilterAccumulator {
     return bloomFilter.isSet();
   }
 
-  void init(int32_t capacity) {
+  void init(int32_t capacity, int8_t version) {
     if (!bloomFilter.isSet()) {
-      bloomFilter.reset(capacity);
+      bloomFilter.reset(capacity, version);
     }
   }
 
@@ -60,8 +60,8 @@ struct BloomFilterAccumulator {
 
 class BloomFilterAggAggregate : public exec::Aggregate {
  public:
-  explicit BloomFilterAggAggregate(const TypePtr& resultType)
-      : Aggregate(resultType) {}
+  BloomFilterAggAggregate(const TypePtr& resultType, int8_t version)
+      : Aggregate(resultType), version_(version) {}
 
   int32_t accumulatorFixedWidthSize() const override {
     return sizeof(BloomFilterAccumulator);
@@ -94,7 +94,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
       auto group = groups[row];
       auto tracker = trackRowSize(group);
       auto accumulator = value<BloomFilterAccumulator>(group);
-      accumulator->init(capacity_);
+      accumulator->init(capacity_, version_);
       accumulator->insert(decodedRaw_.valueAt<int64_t>(row));
     });
   }
@@ -127,7 +127,7 @@ class BloomFilterAggAggregate : public exec::Aggregate {
     computeCapacity();
     auto tracker = trackRowSize(group);
     auto accumulator = value<BloomFilterAccumulator>(group);
-    accumulator->init(capacity_);
+    accumulator->init(capacity_, version_);
     // for gluten tpcds test
     /*VELOX_USER_CHECK(
         !decodedRaw_.mayHaveNulls(),
@@ -264,6 +264,9 @@ class BloomFilterAggAggregate : public exec::Aggregate {
   }
 
   static constexpr int64_t kMissingArgument = -1;
+  // Version of the Bloom filters produced from raw input. Intermediate
+  // results keep the version they were produced with.
+  const int8_t version_;
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedRaw_;
   DecodedVector decodedIntermediate_;
@@ -275,7 +278,8 @@ class BloomFilterAggAggregate : public exec::Aggregate {
 } // namespace
 
 exec::AggregateRegistrationResult registerBloomFilterAggAggregate(
-    const std::string& name) {
+    const std::string& name,
+    int8_t version) {
   std::vector<std::shared_ptr<exec::AggregateFunctionSignature>> signatures{
       exec::AggregateFunctionSignatureBuilder()
           .argumentType("bigint")
@@ -299,11 +303,11 @@ exec::AggregateRegistrationResult registerBloomFilterAggAggregate(
   return exec::registerAggregateFunction(
       name,
       std::move(signatures),
-      [name](
+      [name, version](
           core::AggregationNode::Step /* step */,
           const std::vector<TypePtr>& /* argTypes */,
           const TypePtr& resultType) -> std::unique_ptr<exec::Aggregate> {
-        return std::make_unique<BloomFilterAggAggregate>(resultType);
+        return std::make_unique<BloomFilterAggAggregate>(resultType, version);
       });
 }
 } // namespace facebook::velox::functions::aggregate::sparksql
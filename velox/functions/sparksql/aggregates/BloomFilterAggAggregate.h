@@ -18,11 +18,17 @@
 
 #include <string>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/exec/AggregateUtil.h"
 
 namespace facebook::velox::functions::aggregate::sparksql {
 
+/// Registers bloom_filter_agg under 'name'. 'version' is the version of the
+/// Bloom filters built from raw input, BloomFilter<>::kBloomFilterV1 or the
+/// blocked BloomFilter<>::kBloomFilterV2. Version 1 is the default so that
+/// the filters can be read by workers that do not know version 2.
 exec::AggregateRegistrationResult registerBloomFilterAggAggregate(
-    const std::string& name);
+    const std::string& name,
+    int8_t version = BloomFilter<>::kBloomFilterV1);
 
 } // namespace facebook::velox::functions::aggregate::sparksql
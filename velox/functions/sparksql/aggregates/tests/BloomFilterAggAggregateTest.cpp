@@ -18,6 +18,7 @@
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 #include "velox/functions/lib/aggregates/tests/AggregationTestBase.h"
+#include "velox/functions/sparksql/aggregates/BloomFilterAggAggregate.h"
 #include "velox/functions/sparksql/aggregates/Register.h"
 
 namespace facebook::velox::functions::aggregate::sparksql::test {
@@ -31,9 +32,11 @@ class BloomFilterAggAggregateTest
     allowInputShuffle();
   }
 
-  std::string getSerializedBloomFilter(int32_t capacity) {
+  std::string getSerializedBloomFilter(
+      int32_t capacity,
+      int8_t version = BloomFilter<>::kBloomFilterV1) {
     BloomFilter bloomFilter;
-    bloomFilter.reset(capacity);
+    bloomFilter.reset(capacity, version);
     for (auto i = 0; i < 9; ++i) {
       bloomFilter.insert(folly::hasher<int64_t>()(i));
     }
@@ -70,6 +73,19 @@ TEST_F(BloomFilterAggAggregateTest, bloomFilterAggArgument) {
   testAggregations(vectors, {}, {"bloom_filter_agg(c0)"}, expected2);
 }
 
+TEST_F(BloomFilterAggAggregateTest, blocked) {
+  registerBloomFilterAggAggregate(
+      "bloom_filter_agg_v2", BloomFilter<>::kBloomFilterV2);
+  auto vectors = {makeRowVector({makeFlatVector<int64_t>(
+      100, [](vector_size_t row) { return row % 9; })})};
+  auto bloomFilter =
+      getSerializedBloomFilter(4, BloomFilter<>::kBloomFilterV2);
+  auto expected = {
+      makeRowVector({makeConstant<StringView>(StringView(bloomFilter), 1)})};
+
+  testAggregations(vectors, {}, {"bloom_filter_agg_v2(c0, 5, 64)"}, expected);
+}
+
 TEST_F(BloomFilterAggAggregateTest, emptyInput) {
   auto vectors = {makeRowVector({makeFlatVector<int64_t>({})})};
   auto expected = {makeRowVector(
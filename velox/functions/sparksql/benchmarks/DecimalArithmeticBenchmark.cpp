@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/sparksql/RegisterArithmetic.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+class DecimalArithmeticBenchmark
+    : public functions::test::FunctionBenchmarkBase {
+ public:
+  DecimalArithmeticBenchmark() : FunctionBenchmarkBase() {
+    functions::sparksql::registerArithmeticFunctions("");
+  }
+
+  // Evaluates 'expression' over two DECIMAL(38, 2) columns. If 'wide' is
+  // false, the values fit in 64 bits, as most values of money columns do.
+  // Otherwise the values need all 128 bits.
+  void run(const std::string& expression, bool wide) {
+    folly::BenchmarkSuspender suspender;
+    const vector_size_t size = 1'000;
+    const int128_t base = wide ? HugeInt::build(1'000, 0) : 0;
+    auto makeColumn = [&](int64_t seed) {
+      std::vector<int128_t> values(size);
+      for (auto i = 0; i < size; ++i) {
+        values[i] = base + (i + 1) * seed * (i % 2 == 0 ? 1 : -1);
+      }
+      return maker().longDecimalFlatVector(values, DECIMAL(38, 2));
+    };
+    auto data = maker().rowVector({makeColumn(12'345), makeColumn(7)});
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    int cnt = 0;
+    for (auto i = 0; i < 1'000; ++i) {
+      cnt += evaluate(exprSet, data)->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+};
+
+BENCHMARK(add) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_add(c0, c1)", false);
+}
+
+BENCHMARK_RELATIVE(addWide) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_add(c0, c1)", true);
+}
+
+BENCHMARK(multiply) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_multiply(c0, c1)", false);
+}
+
+BENCHMARK_RELATIVE(multiplyWide) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_multiply(c0, c1)", true);
+}
+
+BENCHMARK(divide) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_divide(c0, c1)", false);
+}
+
+BENCHMARK_RELATIVE(divideWide) {
+  DecimalArithmeticBenchmark benchmark;
+  benchmark.run("decimal_divide(c0, c1)", true);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
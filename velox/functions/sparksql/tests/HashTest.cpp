@@ -113,5 +113,41 @@ TEST_F(HashTest, Float) {
   EXPECT_EQ(hash<float>(-limits::infinity()), 427440766);
 }
 
+// Flat columns are hashed without decoding each row. The results must match
+// hashing the same values through a dictionary.
+TEST_F(HashTest, flatColumns) {
+  constexpr int32_t kSize = 1'000;
+  std::vector<std::string> strings(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    strings[i] = std::string(i % 37, 'a' + i % 26);
+  }
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(
+          kSize, [](auto row) { return row * 7919; }, nullEvery(11)),
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 0x123456789L; }, nullEvery(13)),
+      makeFlatVector<StringView>(
+          kSize,
+          [&](auto row) { return StringView(strings[row]); },
+          nullEvery(17)),
+      makeFlatVector<Date>(kSize, [](auto row) { return Date(row - 500); }),
+      makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; }),
+  });
+  std::vector<VectorPtr> children;
+  for (auto& child : data->children()) {
+    children.push_back(wrapInDictionary(
+        makeIndices(kSize, [](auto row) { return row; }), kSize, child));
+  }
+  auto dictionaryData = makeRowVector(children);
+
+  for (const auto& expression :
+       {"hash(c0, c1, c2, c3)",
+        "xxhash64(c0, c1, c2, c3)",
+        "if(c4, hash(c0, c1, c2, c3), hash(c1))"}) {
+    assertEqualVectors(
+        evaluate(expression, dictionaryData), evaluate(expression, data));
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
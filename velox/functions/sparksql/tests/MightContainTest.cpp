@@ -51,9 +51,11 @@ class MightContainTest : public SparkFunctionBaseTest {
     velox::test::assertEqualVectors(expected, results[0]);
   }
 
-  std::string getSerializedBloomFilter(int32_t kSize) {
+  std::string getSerializedBloomFilter(
+      int32_t kSize,
+      int8_t version = BloomFilter<>::kBloomFilterV1) {
     BloomFilter bloomFilter;
-    bloomFilter.reset(kSize);
+    bloomFilter.reset(kSize, version);
     for (auto i = 0; i < kSize; ++i) {
       bloomFilter.insert(folly::hasher<int64_t>()(i));
     }
@@ -84,6 +86,19 @@ TEST_F(MightContainTest, basic) {
   testMightContain(serialized, values, expected);
 }
 
+TEST_F(MightContainTest, blocked) {
+  constexpr int32_t kSize = 10;
+  auto serialized =
+      getSerializedBloomFilter(kSize, BloomFilter<>::kBloomFilterV2);
+  auto value =
+      makeFlatVector<int64_t>(kSize, [](vector_size_t row) { return row; });
+  testMightContain(serialized, value, makeConstant(true, kSize));
+
+  auto valueNotContain = makeFlatVector<int64_t>(
+      kSize, [](vector_size_t row) { return row + 123451; });
+  testMightContain(serialized, valueNotContain, makeConstant(false, kSize));
+}
+
 TEST_F(MightContainTest, nullBloomFilter) {
   auto value = makeFlatVector<int64_t>({2, 4});
   auto expected = makeNullConstant(TypeKind::BOOLEAN, value->size());
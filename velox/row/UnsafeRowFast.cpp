@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/row/UnsafeRowFast.h"
+#include "velox/row/UnsafeRowDeserializers.h"
 
 namespace facebook::velox::row {
 
@@ -27,6 +28,63 @@ int32_t alignBits(int32_t numBits) {
 int32_t alignBytes(int32_t numBytes) {
   return bits::roundUp(numBytes, 8);
 }
+
+// Copies consecutive 'values' into the field at 'fieldOffset' of rows starting
+// at 'buffer + bufferOffsets[i]'.
+template <typename T>
+void storeStrided(
+    const char* values,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    int32_t fieldOffset,
+    char* buffer) {
+  auto typedValues = reinterpret_cast<const T*>(values);
+  for (auto i = 0; i < size; ++i) {
+    *reinterpret_cast<T*>(buffer + bufferOffsets[i] + fieldOffset) =
+        typedValues[i];
+  }
+}
+
+// Reads the fixed-width or string field 'field' of all rows in 'data' into a
+// flat vector.
+template <TypeKind Kind>
+VectorPtr deserializeColumn(
+    const std::vector<std::string_view>& data,
+    int32_t field,
+    int32_t fieldOffset,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto numRows = data.size();
+  auto vector = BaseVector::create<FlatVector<T>>(type, numRows, pool);
+  if constexpr (Kind == TypeKind::HUGEINT) {
+    VELOX_UNREACHABLE("HUGEINT is not stored in the fixed-width region");
+  } else {
+    for (auto row = 0; row < numRows; ++row) {
+      const char* rawData = data[row].data();
+      if (bits::isBitSet(rawData, field)) {
+        vector->setNull(row, true);
+        continue;
+      }
+      const char* fieldData = rawData + fieldOffset;
+      if constexpr (std::is_same_v<T, StringView>) {
+        const auto sizeAndOffset =
+            *reinterpret_cast<const uint64_t*>(fieldData);
+        vector->set(
+            row,
+            StringView(
+                rawData + (sizeAndOffset >> 32),
+                static_cast<uint32_t>(sizeAndOffset)));
+      } else if constexpr (std::is_same_v<T, Timestamp>) {
+        const auto micros = *reinterpret_cast<const int64_t*>(fieldData);
+        vector->set(row, Timestamp::fromMicros(micros));
+      } else {
+        vector->set(row, *reinterpret_cast<const T*>(fieldData));
+      }
+    }
+  }
+  return vector;
+}
 } // namespace
 
 // static
@@ -172,6 +230,150 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t size,
+    int32_t* sizes) {
+  const int32_t fixedBytes = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + size, fixedBytes);
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += alignBytes(child.variableWidthRowSize(childIndex));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    char* buffer) {
+  // Offset of the next variable-width value in each row.
+  std::vector<int64_t> variableWidthOffsets(
+      size, rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    const int32_t fieldOffset = rowNullBytes_ + i * kFieldWidth;
+
+    if (childIsFixedWidth_[i] && decoded_.isIdentityMapping() &&
+        !child.decoded_.mayHaveNulls() &&
+        child.serializeFixedWidthStrided(
+            offset, size, bufferOffsets, fieldOffset, buffer)) {
+      continue;
+    }
+
+    for (auto row = 0; row < size; ++row) {
+      const auto childIndex = decoded_.index(offset + row);
+      char* rowBuffer = buffer + bufferOffsets[row];
+
+      // Write null bit.
+      if (child.isNullAt(childIndex)) {
+        bits::setBit(rowBuffer, i, true);
+        continue;
+      }
+
+      // Write value.
+      if (childIsFixedWidth_[i]) {
+        child.serializeFixedWidth(childIndex, rowBuffer + fieldOffset);
+        continue;
+      }
+
+      auto& variableWidthOffset = variableWidthOffsets[row];
+      auto serializedBytes = child.serializeVariableWidth(
+          childIndex, rowBuffer + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | serializedBytes;
+      *reinterpret_cast<uint64_t*>(rowBuffer + fieldOffset) = sizeAndOffset;
+
+      if (child.typeKind_ == TypeKind::HUGEINT) {
+        variableWidthOffset += 16;
+      } else {
+        variableWidthOffset += alignBytes(serializedBytes);
+      }
+    }
+  }
+}
+
+// static
+RowVectorPtr UnsafeRowFast::deserialize(
+    const std::vector<std::string_view>& data,
+    const RowTypePtr& rowType,
+    memory::MemoryPool* pool) {
+  const auto numFields = rowType->size();
+  const int32_t nullBytes = alignBits(numFields);
+
+  std::vector<VectorPtr> columns(numFields);
+  std::vector<std::optional<std::string_view>> columnData;
+  for (auto i = 0; i < numFields; ++i) {
+    const auto& type = rowType->childAt(i);
+    const int32_t fieldOffset = nullBytes + i * kFieldWidth;
+    if (type->isPrimitiveType() && type->kind() != TypeKind::HUGEINT) {
+      columns[i] = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          deserializeColumn, type->kind(), data, i, fieldOffset, type, pool);
+      continue;
+    }
+
+    // Complex types and decimals take the views of the field in each row.
+    columnData.resize(data.size());
+    for (auto row = 0; row < data.size(); ++row) {
+      const char* rawData = data[row].data();
+      if (bits::isBitSet(rawData, i)) {
+        columnData[row] = std::nullopt;
+      } else if (type->isFixedWidth()) {
+        columnData[row] = std::string_view(
+            rawData + fieldOffset, serializedSizeInBytes(type));
+      } else {
+        const auto sizeAndOffset =
+            *reinterpret_cast<const uint64_t*>(rawData + fieldOffset);
+        columnData[row] = std::string_view(
+            rawData + (sizeAndOffset >> 32),
+            static_cast<uint32_t>(sizeAndOffset));
+      }
+    }
+    columns[i] = UnsafeRowDeserializer::deserialize(
+        columnData, type, pool, numFields, i);
+  }
+
+  return std::make_shared<RowVector>(
+      pool, rowType, BufferPtr(nullptr), data.size(), std::move(columns));
+}
+
+bool UnsafeRowFast::serializeFixedWidthStrided(
+    vector_size_t offset,
+    vector_size_t size,
+    const size_t* bufferOffsets,
+    int32_t fieldOffset,
+    char* buffer) {
+  if (!supportsBulkCopy_) {
+    return false;
+  }
+  const char* values = decoded_.data<char>() + offset * valueBytes_;
+  switch (valueBytes_) {
+    case 1:
+      storeStrided<int8_t>(values, size, bufferOffsets, fieldOffset, buffer);
+      return true;
+    case 2:
+      storeStrided<int16_t>(values, size, bufferOffsets, fieldOffset, buffer);
+      return true;
+    case 4:
+      storeStrided<int32_t>(values, size, bufferOffsets, fieldOffset, buffer);
+      return true;
+    case 8:
+      storeStrided<int64_t>(values, size, bufferOffsets, fieldOffset, buffer);
+      return true;
+    default:
+      return false;
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -36,6 +36,28 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes serialized sizes of 'size' rows starting at 'offset' into 'sizes'.
+  /// Computes the sizes one column at a time. Use only if 'fixedRowSize'
+  /// returned std::nullopt.
+  void rowSizes(vector_size_t offset, vector_size_t size, int32_t* sizes);
+
+  /// Serializes 'size' rows starting at 'offset' one column at a time. Row
+  /// 'offset + i' is written at 'buffer + bufferOffsets[i]'. Each row must have
+  /// sufficient capacity and be set to all zeros.
+  void serialize(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      char* buffer);
+
+  /// Deserializes UnsafeRows of 'rowType' one column at a time. Top-level
+  /// fixed-width and string columns are read directly from the rows. Other
+  /// columns are deserialized by UnsafeRowDeserializer.
+  static RowVectorPtr deserialize(
+      const std::vector<std::string_view>& data,
+      const RowTypePtr& rowType,
+      memory::MemoryPool* pool);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -57,6 +79,16 @@ class UnsafeRowFast {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes 'size' fixed-width values starting at 'offset' into the field at
+  /// 'fieldOffset' of consecutive rows starting at 'buffer + bufferOffsets[i]'.
+  /// Returns false if the values cannot be copied without decoding.
+  bool serializeFixedWidthStrided(
+      vector_size_t offset,
+      vector_size_t size,
+      const size_t* bufferOffsets,
+      int32_t fieldOffset,
+      char* buffer);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
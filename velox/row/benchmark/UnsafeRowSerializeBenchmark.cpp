@@ -16,6 +16,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -24,60 +25,119 @@ namespace {
 
 class SerializeBenchmark {
  public:
-  void run(const RowTypePtr& rowType) {
+  void serialize(const RowTypePtr& rowType, bool columnar) {
     folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto buffer = columnar ? serializeColumnar(fast, rowType, data->size())
+                           : serializeRowwise(fast, rowType, data->size());
+    folly::doNotOptimizeAway(buffer);
+  }
+
+  void deserialize(const RowTypePtr& rowType, bool columnar) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    UnsafeRowFast fast(data);
+    auto buffer = serializeColumnar(fast, rowType, data->size());
+    std::vector<std::string_view> rows;
+    std::vector<std::optional<std::string_view>> optionalRows;
+    for (auto i = 0; i < data->size(); ++i) {
+      rows.push_back(
+          std::string_view(buffer->as<char>() + offsets_[i], sizes_[i]));
+      optionalRows.push_back(rows.back());
+    }
+    suspender.dismiss();
+
+    VectorPtr result;
+    if (columnar) {
+      result = UnsafeRowFast::deserialize(rows, rowType, pool());
+    } else {
+      result =
+          UnsafeRowDeserializer::deserialize(optionalRows, rowType, pool());
+    }
+    folly::doNotOptimizeAway(result);
+  }
 
+ private:
+  RowVectorPtr makeData(const RowTypePtr& rowType) {
     VectorFuzzer::Options options;
     options.vectorSize = 1'000;
 
     const auto seed = 1; // For reproducibility.
     VectorFuzzer fuzzer(options, pool_.get(), seed);
 
-    auto data = fuzzer.fuzzInputRow(rowType);
-
-    suspender.dismiss();
-
-    UnsafeRowFast fast(data);
+    return fuzzer.fuzzInputRow(rowType);
+  }
 
+  // Serializes one row at a time.
+  BufferPtr serializeRowwise(
+      UnsafeRowFast& fast,
+      const RowTypePtr& rowType,
+      vector_size_t numRows) {
     size_t totalSize = 0;
-    if (auto fixedRowSize =
-            UnsafeRowFast::fixedRowSize(asRowType(data->type()))) {
-      totalSize += fixedRowSize.value() * data->size();
+    if (auto fixedRowSize = UnsafeRowFast::fixedRowSize(rowType)) {
+      totalSize += fixedRowSize.value() * numRows;
     } else {
-      for (auto i = 0; i < data->size(); ++i) {
+      for (auto i = 0; i < numRows; ++i) {
         auto rowSize = fast.rowSize(i);
         totalSize += rowSize;
       }
     }
 
-    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool());
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
     auto rawBuffer = buffer->asMutable<char>();
 
     size_t offset = 0;
-    for (auto i = 0; i < data->size(); ++i) {
+    for (auto i = 0; i < numRows; ++i) {
       auto rowSize = fast.serialize(i, rawBuffer + offset);
       offset += rowSize;
     }
 
     VELOX_CHECK_EQ(totalSize, offset);
+    return buffer;
+  }
+
+  // Computes the row sizes and writes the rows one column at a time.
+  BufferPtr serializeColumnar(
+      UnsafeRowFast& fast,
+      const RowTypePtr& rowType,
+      vector_size_t numRows) {
+    sizes_.resize(numRows);
+    if (auto fixedRowSize = UnsafeRowFast::fixedRowSize(rowType)) {
+      std::fill(sizes_.begin(), sizes_.end(), fixedRowSize.value());
+    } else {
+      fast.rowSizes(0, numRows, sizes_.data());
+    }
+
+    offsets_.resize(numRows);
+    size_t totalSize = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      offsets_[i] = totalSize;
+      totalSize += sizes_[i];
+    }
+
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    fast.serialize(0, numRows, offsets_.data(), buffer->asMutable<char>());
+    return buffer;
   }
 
- private:
   memory::MemoryPool* pool() {
     return pool_.get();
   }
 
   std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  std::vector<int32_t> sizes_;
+  std::vector<size_t> offsets_;
 };
 
-BENCHMARK(fixedWidth5) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()}));
+RowTypePtr fixedWidth5Type() {
+  return ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()});
 }
 
-BENCHMARK(fixedWidth10) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({
+RowTypePtr fixedWidth10Type() {
+  return ROW({
       BIGINT(),
       BIGINT(),
       BIGINT(),
@@ -88,56 +148,76 @@ BENCHMARK(fixedWidth10) {
       BIGINT(),
       BIGINT(),
       BIGINT(),
-  }));
+  });
 }
 
-BENCHMARK(fixedWidth20) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({
+RowTypePtr fixedWidth20Type() {
+  return ROW({
       BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(), BIGINT(),
       BIGINT(), BIGINT(), BIGINT(), DOUBLE(), DOUBLE(), DOUBLE(), DOUBLE(),
       DOUBLE(), DOUBLE(), DOUBLE(), DOUBLE(), BIGINT(), BIGINT(),
-  }));
+  });
 }
 
-BENCHMARK(strings1) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({BIGINT(), VARCHAR()}));
+RowTypePtr strings1Type() {
+  return ROW({BIGINT(), VARCHAR()});
 }
 
-BENCHMARK(strings5) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({
+RowTypePtr strings5Type() {
+  return ROW({
       BIGINT(),
       VARCHAR(),
       VARCHAR(),
       VARCHAR(),
       VARCHAR(),
       VARCHAR(),
-  }));
+  });
 }
 
-BENCHMARK(arrays) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({BIGINT(), ARRAY(BIGINT())}));
+RowTypePtr arraysType() {
+  return ROW({BIGINT(), ARRAY(BIGINT())});
 }
 
-BENCHMARK(nestedArrays) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({BIGINT(), ARRAY(ARRAY(BIGINT()))}));
+RowTypePtr nestedArraysType() {
+  return ROW({BIGINT(), ARRAY(ARRAY(BIGINT()))});
 }
 
-BENCHMARK(maps) {
-  SerializeBenchmark benchmark;
-  benchmark.run(ROW({BIGINT(), MAP(BIGINT(), REAL())}));
+RowTypePtr mapsType() {
+  return ROW({BIGINT(), MAP(BIGINT(), REAL())});
 }
 
-BENCHMARK(structs) {
-  SerializeBenchmark benchmark;
-  benchmark.run(
-      ROW({BIGINT(), ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()})}));
+RowTypePtr structsType() {
+  return ROW(
+      {BIGINT(), ROW({BIGINT(), DOUBLE(), BOOLEAN(), TINYINT(), REAL()})});
 }
 
+// Compares row by row and columnar serialization and deserialization of
+// 'name##Type()'.
+#define SERDE_BENCHMARKS(name)                                 \
+  BENCHMARK(name) {                                            \
+    SerializeBenchmark().serialize(name##Type(), false);       \
+  }                                                            \
+  BENCHMARK_RELATIVE(name##Columnar) {                         \
+    SerializeBenchmark().serialize(name##Type(), true);        \
+  }                                                            \
+  BENCHMARK(name##Deserialize) {                               \
+    SerializeBenchmark().deserialize(name##Type(), false);     \
+  }                                                            \
+  BENCHMARK_RELATIVE(name##DeserializeColumnar) {              \
+    SerializeBenchmark().deserialize(name##Type(), true);      \
+  }                                                            \
+  BENCHMARK_DRAW_LINE();
+
+SERDE_BENCHMARKS(fixedWidth5)
+SERDE_BENCHMARKS(fixedWidth10)
+SERDE_BENCHMARKS(fixedWidth20)
+SERDE_BENCHMARKS(strings1)
+SERDE_BENCHMARKS(strings5)
+SERDE_BENCHMARKS(arrays)
+SERDE_BENCHMARKS(nestedArrays)
+SERDE_BENCHMARKS(maps)
+SERDE_BENCHMARKS(structs)
+
 } // namespace
 } // namespace facebook::velox::row
 
@@ -161,5 +161,75 @@ TEST_F(UnsafeRowFuzzTests, fast) {
   });
 }
 
+TEST_F(UnsafeRowFuzzTests, columnar) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      TIMESTAMP(),
+      DATE(),
+      ARRAY(VARCHAR()),
+      MAP(BIGINT(), ARRAY(REAL())),
+      ROW({BOOLEAN(), INTEGER(), VARCHAR()}),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = kNumBuffers;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+  opts.containerVariableLength = true;
+  opts.containerLength = 10;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMicroSeconds;
+  VectorFuzzer fuzzer(opts, pool_.get());
+
+  for (auto i = 0; i < 20; ++i) {
+    clearBuffers();
+    auto seed = folly::Random::rand32();
+    SCOPED_TRACE(fmt::format("seed: {}", seed));
+    fuzzer.reSeed(seed);
+    // Flat inputs without nulls take the strided copy of fixed-width columns.
+    auto data = i % 2 == 0
+        ? fuzzer.fuzzInputRow(rowType)
+        : std::dynamic_pointer_cast<RowVector>(
+              fuzzer.fuzzFlatNotNull(rowType));
+
+    UnsafeRowFast fast(data);
+    const auto numRows = data->size();
+    std::vector<int32_t> sizes(numRows);
+    fast.rowSizes(0, numRows, sizes.data());
+
+    std::vector<size_t> offsets(numRows);
+    size_t totalSize = 0;
+    for (auto row = 0; row < numRows; ++row) {
+      ASSERT_EQ(fast.rowSize(row), sizes[row]);
+      offsets[row] = totalSize;
+      totalSize += sizes[row];
+    }
+
+    // The columnar serialization matches the row by row one.
+    std::vector<char> buffer(totalSize, 0);
+    fast.serialize(0, numRows, offsets.data(), buffer.data());
+    std::vector<std::string_view> serialized;
+    for (auto row = 0; row < numRows; ++row) {
+      ASSERT_EQ(sizes[row], fast.serialize(row, buffers_[row]));
+      ASSERT_EQ(
+          0, memcmp(buffers_[row], buffer.data() + offsets[row], sizes[row]));
+      serialized.push_back(
+          std::string_view(buffer.data() + offsets[row], sizes[row]));
+    }
+
+    auto result = UnsafeRowFast::deserialize(serialized, rowType, pool_.get());
+    assertEqualVectors(data, result);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::row
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/serializers/PrestoSerializer.h"
+#include <folly/Random.h>
 #include "velox/common/base/Crc.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
@@ -29,6 +30,9 @@ constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
 constexpr folly::StringPiece kRLE{"RLE"};
+constexpr folly::StringPiece kDictionary{"DICTIONARY"};
+// Size of the instance id that follows the ids of a dictionary block.
+constexpr int32_t kDictionaryIdSize = 3 * sizeof(int64_t);
 
 int64_t computeChecksum(
     PrestoOutputStreamListener* listener,
@@ -42,15 +46,19 @@ int64_t computeChecksum(
   return result.checksum();
 }
 
+// Computes the checksum of a page from the 'sizeInBytes' bytes of page data at
+// the current position of 'source', which is compressed if the compressed bit
+// of 'codecMarker' is set.
 int64_t computeChecksum(
     ByteStream* source,
     int codecMarker,
     int numRows,
-    int uncompressedSize) {
+    int uncompressedSize,
+    int sizeInBytes) {
   auto offset = source->tellp();
   bits::Crc32 crc32;
 
-  auto remainingBytes = uncompressedSize;
+  auto remainingBytes = sizeInBytes;
   while (remainingBytes > 0) {
     auto data = source->nextView(remainingBytes);
     VELOX_CHECK_GT(data.size(), 0);
@@ -320,6 +328,47 @@ readNulls(ByteStream* source, vector_size_t size, BaseVector* result) {
   return nullCount;
 }
 
+// Keeps the memory of an input page alive for a BufferView over the page.
+class PageReleaser {
+ public:
+  explicit PageReleaser(std::shared_ptr<folly::IOBuf> page)
+      : page_(std::move(page)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<folly::IOBuf> page_;
+};
+
+// True if the values of T in the wire format have the layout of a FlatVector
+// when there are no nulls.
+template <typename T>
+constexpr bool isViewable() {
+  return (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+          sizeof(T) <= sizeof(int64_t)) ||
+      std::is_same_v<T, Date>;
+}
+
+// Returns a view over the next 'size' values of T in 'source' that holds the
+// memory of 'source' alive. Returns nullptr if 'source' has no owner or the
+// values are not contiguous, in which case nothing is read. The values are
+// not necessarily aligned, like the values that ByteStream::read() returns.
+template <typename T>
+BufferPtr readValuesView(ByteStream* source, vector_size_t size) {
+  if (source->inputOwner() == nullptr) {
+    return nullptr;
+  }
+  const auto numBytes = size * sizeof(T);
+  const auto* data = source->nextContiguous(numBytes);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  return BufferView<PageReleaser>::create(
+      data, numBytes, PageReleaser(source->inputOwner()));
+}
+
 template <typename T>
 void read(
     ByteStream* source,
@@ -328,7 +377,9 @@ void read(
     VectorPtr* result,
     bool useLosslessTimestamp) {
   int32_t size = source->read<int32_t>();
-  if (*result && result->unique()) {
+  // A vector over a previous page is not reused since resizing would copy it.
+  if (*result && result->unique() &&
+      !((*result)->values() && (*result)->values()->isView())) {
     (*result)->resize(size);
   } else {
     *result = BaseVector::create(type, size, pool);
@@ -337,6 +388,21 @@ void read(
   auto flatResult = (*result)->asFlatVector<T>();
   auto nullCount = readNulls(source, size, flatResult);
 
+  if constexpr (isViewable<T>()) {
+    if (nullCount == 0) {
+      if (auto view = readValuesView<T>(source, size)) {
+        *result = std::make_shared<FlatVector<T>>(
+            pool,
+            type,
+            nullptr,
+            size,
+            std::move(view),
+            std::vector<BufferPtr>{});
+        return;
+      }
+    }
+  }
+
   BufferPtr values = flatResult->mutableValues(size);
   if constexpr (std::is_same_v<T, Timestamp>) {
     if (useLosslessTimestamp) {
@@ -433,6 +499,24 @@ void readConstantVector(
   *result = BaseVector::wrapInConstant(size, 0, children[0]);
 }
 
+void readDictionaryVector(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr* result,
+    bool useLosslessTimestamp) {
+  auto size = source->read<int32_t>();
+  std::vector<TypePtr> childTypes = {type};
+  std::vector<VectorPtr> children(1);
+  readColumns(source, pool, childTypes, &children, useLosslessTimestamp);
+  auto indices = allocateIndices(size, pool);
+  source->readBytes(
+      indices->asMutable<uint8_t>(), size * sizeof(vector_size_t));
+  // Skip the instance id of the dictionary.
+  source->skip(kDictionaryIdSize);
+  *result = BaseVector::wrapInDictionary(nullptr, indices, size, children[0]);
+}
+
 void readArrayVector(
     ByteStream* source,
     std::shared_ptr<const Type> type,
@@ -705,8 +789,18 @@ void readColumns(
     if (encoding == kRLE) {
       readConstantVector(
           source, types[i], pool, &(*result)[i], useLosslessTimestamp);
+    } else if (encoding == kDictionary) {
+      readDictionaryVector(
+          source, types[i], pool, &(*result)[i], useLosslessTimestamp);
     } else {
       checkTypeEncoding(encoding, types[i]);
+      auto& previous = (*result)[i];
+      if (previous != nullptr &&
+          (previous->encoding() == VectorEncoding::Simple::CONSTANT ||
+           previous->encoding() == VectorEncoding::Simple::DICTIONARY)) {
+        // The readers reuse only vectors of the encoding they read.
+        previous.reset();
+      }
       auto it = readers.find(types[i]->kind());
       VELOX_CHECK(
           it != readers.end(),
@@ -1662,13 +1756,23 @@ class PrestoVectorSerializer : public VectorSerializer {
       std::shared_ptr<const RowType> rowType,
       int32_t numRows,
       StreamArena* streamArena,
-      bool useLosslessTimestamp) {
+      const PrestoVectorSerde::PrestoOptions& options)
+      : streamArena_(streamArena),
+        useLosslessTimestamp_(options.useLosslessTimestamp),
+        codec_(
+            options.compressionKind == folly::io::CodecType::NO_COMPRESSION
+                ? nullptr
+                : folly::io::getCodec(options.compressionKind)),
+        minCompressionRatio_(options.minCompressionRatio) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
     for (int i = 0; i < numTypes; i++) {
       streams_[i] = std::make_unique<VectorStream>(
-          types[i], streamArena, numRows, useLosslessTimestamp);
+          types[i], streamArena, numRows, useLosslessTimestamp_);
+    }
+    if (options.preserveEncodings) {
+      encodedColumns_.resize(numTypes);
     }
   }
 
@@ -1679,6 +1783,10 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (newRows > 0) {
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+        if (!encodedColumns_.empty() &&
+            appendEncoded(i, vector->childAt(i), ranges, newRows)) {
+          continue;
+        }
         serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
       }
     }
@@ -1686,8 +1794,12 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   vector_size_t maxSerializedSize() override {
     vector_size_t size = 0;
-    for (auto& stream : streams_) {
-      size += stream->maxSerializedSize();
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (isEncoded(i)) {
+        size += encodedSerializedSize(encodedColumns_[i]);
+      } else {
+        size += streams_[i]->maxSerializedSize();
+      }
     }
     size += 25; /* flush header layout size */
     return size;
@@ -1703,6 +1815,8 @@ class PrestoVectorSerializer : public VectorSerializer {
       VELOX_CHECK(child->isConstantEncoding());
     }
 
+    // The page is RLE encoded as a whole.
+    encodedColumns_.clear();
     std::vector<IndexRange> ranges{{0, 1}};
     append(vector, folly::Range(ranges.data(), ranges.size()));
 
@@ -1741,22 +1855,13 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (listener) {
       listener->resume();
     }
-    writeInt32(out, streams_.size());
-
-    if (rle) {
-      // Write RLE encoding marker.
-      writeInt32(out, kRLE.size());
-      out->write(kRLE.data(), kRLE.size());
-      // Write number of RLE values.
-      writeInt32(out, numRows);
-    }
-
-    // std::cout << "before stream " << out->tellp() << std::endl;
-
-    for (auto& stream : streams_) {
-      stream->flush(out);
+    int32_t uncompressedSize;
+    if (codec_ == nullptr) {
+      flushColumns(numRows, rle, out);
+      uncompressedSize = (int32_t)out->tellp() - offset - kHeaderSize;
+    } else {
+      uncompressedSize = flushCompressed(numRows, rle, out, codec);
     }
-    // std::cout << "after stream " << out->tellp() << std::endl;
 
     // Pause CRC computation
     if (listener) {
@@ -1765,25 +1870,238 @@ class PrestoVectorSerializer : public VectorSerializer {
 
     // Fill in uncompressedSizeInBytes & sizeInBytes
     int32_t size = (int32_t)out->tellp() - offset;
-    int32_t uncompressedSize = size - kHeaderSize;
+    int32_t sizeInBytes = size - kHeaderSize;
     int64_t crc = 0;
     if (listener) {
       crc = computeChecksum(listener, codec, numRows, uncompressedSize);
     }
 
-    out->seekp(offset + kSizeInBytesOffset);
-    writeInt32(out, uncompressedSize);
+    out->seekp(offset + kCodecMarkerOffset);
+    out->write(&codec, 1);
     writeInt32(out, uncompressedSize);
+    writeInt32(out, sizeInBytes);
     writeInt64(out, crc);
     out->seekp(offset + size);
   }
 
  private:
+  // Writes the number of columns and the column streams.
+  void flushColumns(int32_t numRows, bool rle, OutputStream* out) {
+    writeInt32(out, streams_.size());
+
+    if (rle) {
+      // Write RLE encoding marker.
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      // Write number of RLE values.
+      writeInt32(out, numRows);
+    }
+
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (isEncoded(i)) {
+        flushEncoded(encodedColumns_[i], out);
+      } else {
+        streams_[i]->flush(out);
+      }
+    }
+  }
+
+  // A top level column that is serialized with its dictionary or constant
+  // encoding instead of as flat values.
+  struct EncodedColumn {
+    // The dictionary values or the constant vector. nullptr if the column is
+    // not encoded.
+    VectorPtr base;
+    bool isConstant{false};
+    // True if the column is flat in 'streams_'.
+    bool flat{false};
+    // The ids of the rows in 'base' for a dictionary.
+    std::vector<vector_size_t> ids;
+    // The number of rows of a constant.
+    int32_t numRows{0};
+    // 'base' serialized. Has one row for a constant.
+    std::unique_ptr<VectorStream> baseStream;
+    // Instance id of the dictionary.
+    int64_t dictionaryId[2]{0, 0};
+  };
+
+  bool isEncoded(int32_t column) const {
+    return !encodedColumns_.empty() && encodedColumns_[column].base != nullptr;
+  }
+
+  // Adds 'ranges' of 'vector' to the encoded column at 'column'. Returns false
+  // if 'vector' cannot be added in encoded form, in which case the caller adds
+  // it to 'streams_'. A column is encoded if its first rows are a constant or
+  // a dictionary over no more values than the number of rows. The column is
+  // flattened when rows with another constant value or dictionary are added.
+  bool appendEncoded(
+      int32_t column,
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      int32_t numNewRows) {
+    auto& encoded = encodedColumns_[column];
+    if (encoded.flat) {
+      return false;
+    }
+    if (encoded.base == nullptr) {
+      if (!startEncoded(encoded, vector, numNewRows)) {
+        encoded.flat = true;
+        return false;
+      }
+    } else if (!matchesEncoded(encoded, *vector)) {
+      flattenEncoded(column);
+      return false;
+    }
+    if (encoded.isConstant) {
+      encoded.numRows += numNewRows;
+      return true;
+    }
+    auto* indices = vector->wrapInfo()->as<vector_size_t>();
+    for (const auto& range : ranges) {
+      encoded.ids.insert(
+          encoded.ids.end(),
+          indices + range.begin,
+          indices + range.begin + range.size);
+    }
+    return true;
+  }
+
+  bool startEncoded(
+      EncodedColumn& encoded,
+      const VectorPtr& vector,
+      int32_t numNewRows) {
+    IndexRange baseRange{0, 1};
+    switch (vector->encoding()) {
+      case VectorEncoding::Simple::CONSTANT:
+        encoded.isConstant = true;
+        encoded.base = vector;
+        break;
+      case VectorEncoding::Simple::DICTIONARY:
+        if (vector->rawNulls() != nullptr ||
+            vector->valueVector()->size() > numNewRows) {
+          return false;
+        }
+        encoded.base = vector->valueVector();
+        baseRange.size = encoded.base->size();
+        encoded.dictionaryId[0] = folly::Random::rand64();
+        encoded.dictionaryId[1] = folly::Random::rand64();
+        break;
+      default:
+        return false;
+    }
+    encoded.baseStream = std::make_unique<VectorStream>(
+        vector->type(), streamArena_, baseRange.size, useLosslessTimestamp_);
+    serializeColumn(
+        encoded.base.get(),
+        folly::Range(&baseRange, 1),
+        encoded.baseStream.get());
+    return true;
+  }
+
+  static bool matchesEncoded(
+      const EncodedColumn& encoded,
+      const BaseVector& vector) {
+    if (encoded.isConstant) {
+      return vector.encoding() == VectorEncoding::Simple::CONSTANT &&
+          vector.equalValueAt(encoded.base.get(), 0, 0);
+    }
+    return vector.encoding() == VectorEncoding::Simple::DICTIONARY &&
+        vector.rawNulls() == nullptr &&
+        vector.valueVector() == encoded.base;
+  }
+
+  // Moves the rows of the encoded column at 'column' to 'streams_' as flat
+  // values.
+  void flattenEncoded(int32_t column) {
+    auto& encoded = encodedColumns_[column];
+    std::vector<IndexRange> ranges;
+    if (encoded.isConstant) {
+      ranges.resize(encoded.numRows, IndexRange{0, 1});
+    } else {
+      ranges.reserve(encoded.ids.size());
+      for (auto id : encoded.ids) {
+        ranges.push_back({id, 1});
+      }
+    }
+    serializeColumn(
+        encoded.base.get(),
+        folly::Range(ranges.data(), ranges.size()),
+        streams_[column].get());
+    encoded = EncodedColumn();
+    encoded.flat = true;
+  }
+
+  static vector_size_t encodedSerializedSize(EncodedColumn& encoded) {
+    if (encoded.isConstant) {
+      return sizeof(int32_t) + kRLE.size() + sizeof(int32_t) +
+          encoded.baseStream->maxSerializedSize();
+    }
+    return sizeof(int32_t) + kDictionary.size() + sizeof(int32_t) +
+        encoded.baseStream->maxSerializedSize() +
+        encoded.ids.size() * sizeof(int32_t) + kDictionaryIdSize;
+  }
+
+  // Writes an encoded column as a Presto RLE or DICTIONARY block.
+  static void flushEncoded(EncodedColumn& encoded, OutputStream* out) {
+    if (encoded.isConstant) {
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      writeInt32(out, encoded.numRows);
+      encoded.baseStream->flush(out);
+      return;
+    }
+    writeInt32(out, kDictionary.size());
+    out->write(kDictionary.data(), kDictionary.size());
+    writeInt32(out, encoded.ids.size());
+    encoded.baseStream->flush(out);
+    static_assert(sizeof(vector_size_t) == sizeof(int32_t));
+    out->write(
+        reinterpret_cast<const char*>(encoded.ids.data()),
+        encoded.ids.size() * sizeof(int32_t));
+    writeInt64(out, encoded.dictionaryId[0]);
+    writeInt64(out, encoded.dictionaryId[1]);
+    // Sequence id.
+    writeInt64(out, 0);
+  }
+
+  // Writes the page data to 'out' compressed with 'codec_' if this saves
+  // enough space and sets the compressed bit of 'codec' if so. Returns the
+  // uncompressed size of the page data.
+  int32_t flushCompressed(
+      int32_t numRows,
+      bool rle,
+      OutputStream* out,
+      char& codec) {
+    IOBufOutputStream uncompressedStream(
+        *streamArena_->pool(), nullptr, maxSerializedSize());
+    flushColumns(numRows, rle, &uncompressedStream);
+    auto uncompressed = uncompressedStream.getIOBuf();
+    const auto uncompressedSize = uncompressed->computeChainDataLength();
+    auto compressed = codec_->compress(uncompressed.get());
+    const auto* page = uncompressed.get();
+    if (compressed->computeChainDataLength() <=
+        uncompressedSize * minCompressionRatio_) {
+      page = compressed.get();
+      codec |= kCompressedBitMask;
+    }
+    for (const auto& range : *page) {
+      out->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    return uncompressedSize;
+  }
+
+  static const int32_t kCodecMarkerOffset{4};
   static const int32_t kSizeInBytesOffset{4 + 1};
   static const int32_t kHeaderSize{kSizeInBytesOffset + 4 + 4 + 8};
 
+  StreamArena* const streamArena_;
+  const bool useLosslessTimestamp_;
+  const std::unique_ptr<folly::io::Codec> codec_;
+  const float minCompressionRatio_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+  // One entry per column if preserving encodings, else empty.
+  std::vector<EncodedColumn> encodedColumns_;
 };
 } // namespace
 
@@ -1799,11 +2117,13 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
     int32_t numRows,
     StreamArena* streamArena,
     const Options* options) {
-  bool useLosslessTimestamp = options != nullptr
-      ? static_cast<const PrestoOptions*>(options)->useLosslessTimestamp
-      : false;
+  static const PrestoOptions kDefaultOptions(false);
   return std::make_unique<PrestoVectorSerializer>(
-      type, numRows, streamArena, useLosslessTimestamp);
+      type,
+      numRows,
+      streamArena,
+      options != nullptr ? *static_cast<const PrestoOptions*>(options)
+                         : kDefaultOptions);
 }
 
 void PrestoVectorSerde::serializeConstants(
@@ -1836,25 +2156,64 @@ void PrestoVectorSerde::deserialize(
 
   auto pageCodecMarker = source->read<int8_t>();
   auto uncompressedSize = source->read<int32_t>();
-  // skip size in bytes
-  source->skip(4);
+  auto sizeInBytes = source->read<int32_t>();
   auto checksum = source->read<int64_t>();
 
   int64_t actualCheckSum = 0;
   if (isChecksumBitSet(pageCodecMarker)) {
-    actualCheckSum =
-        computeChecksum(source, pageCodecMarker, numRows, uncompressedSize);
+    actualCheckSum = computeChecksum(
+        source, pageCodecMarker, numRows, uncompressedSize, sizeInBytes);
   }
 
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  // skip number of columns
-  source->skip(4);
-
   auto children = &(*result)->children();
   auto childTypes = type->as<TypeKind::ROW>().children();
-  readColumns(source, pool, childTypes, children, useLosslessTimestamp);
+  if (!isCompressedBitSet(pageCodecMarker)) {
+    // skip number of columns
+    source->skip(4);
+    readColumns(source, pool, childTypes, children, useLosslessTimestamp);
+    return;
+  }
+
+  const auto compressionKind = options != nullptr
+      ? static_cast<const PrestoOptions*>(options)->compressionKind
+      : folly::io::CodecType::NO_COMPRESSION;
+  VELOX_CHECK(
+      compressionKind != folly::io::CodecType::NO_COMPRESSION,
+      "Received a compressed page without a compression codec");
+  auto compressed = folly::IOBuf::create(sizeInBytes);
+  source->readBytes(compressed->writableData(), sizeInBytes);
+  compressed->append(sizeInBytes);
+  auto uncompressed = folly::io::getCodec(compressionKind)
+                          ->uncompress(compressed.get(), uncompressedSize);
+  auto data = uncompressed->coalesce();
+  ByteStream uncompressedSource;
+  uncompressedSource.setRange(
+      {const_cast<uint8_t*>(data.data()), (int32_t)data.size(), 0});
+  // skip number of columns
+  uncompressedSource.skip(4);
+  readColumns(
+      &uncompressedSource, pool, childTypes, children, useLosslessTimestamp);
+}
+
+// static
+folly::io::CodecType PrestoVectorSerde::compressionKindFromString(
+    const std::string& name) {
+  static const std::unordered_map<std::string, folly::io::CodecType> kCodecs{
+      {"none", folly::io::CodecType::NO_COMPRESSION},
+      {"lz4", folly::io::CodecType::LZ4},
+      {"snappy", folly::io::CodecType::SNAPPY},
+      {"zstd", folly::io::CodecType::ZSTD},
+  };
+  auto it = kCodecs.find(name);
+  VELOX_USER_CHECK(it != kCodecs.end(), "Unknown compression codec: {}", name);
+  VELOX_USER_CHECK(
+      folly::io::hasCodec(it->second),
+      "Compression codec is not available: {}",
+      name);
+  return it->second;
 }
 
 // static
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #pragma once
+#include <folly/compression/Compression.h>
+
 #include "velox/common/base/Crc.h"
 #include "velox/vector/VectorStream.h"
 
@@ -22,15 +24,44 @@ class PrestoVectorSerde : public VectorSerde {
  public:
   // Input options that the serializer recognizes.
   struct PrestoOptions : VectorSerde::Options {
-    explicit PrestoOptions(bool useLosslessTimestamp)
-        : useLosslessTimestamp(useLosslessTimestamp) {}
+    // Presto Java sends a page raw unless compression makes it at most 80%
+    // of its uncompressed size.
+    static constexpr float kDefaultMinCompressionRatio = 0.8;
+
+    explicit PrestoOptions(
+        bool useLosslessTimestamp,
+        folly::io::CodecType compressionKind =
+            folly::io::CodecType::NO_COMPRESSION,
+        float minCompressionRatio = kDefaultMinCompressionRatio)
+        : useLosslessTimestamp(useLosslessTimestamp),
+          compressionKind(compressionKind),
+          minCompressionRatio(minCompressionRatio) {}
     // Currently presto only supports millisecond precision and the serializer
     // converts velox native timestamp to that resulting in loss of precision.
     // This option allows it to serialize with nanosecond precision and is
     // currently used for spilling. Is false by default.
     bool useLosslessTimestamp{false};
+
+    // Codec for compressing the pages. A compressed page has the compressed
+    // bit set in its codec marker, as in Presto Java. The codec is not
+    // recorded in the page, so the reader must be given the same codec.
+    folly::io::CodecType compressionKind{folly::io::CodecType::NO_COMPRESSION};
+
+    // A page is sent compressed only if the compressed size divided by the
+    // uncompressed size is at most this. Otherwise the page is sent raw.
+    float minCompressionRatio{kDefaultMinCompressionRatio};
+
+    // If true, top level dictionary and constant columns are sent as Presto
+    // DICTIONARY and RLE blocks and read back as DictionaryVector and
+    // ConstantVector. Otherwise all columns are sent flat.
+    bool preserveEncodings{false};
   };
 
+  /// Returns the codec for 'name', which is one of "none", "lz4", "snappy" or
+  /// "zstd". Throws if the codec is unknown or not available in this build.
+  static folly::io::CodecType compressionKindFromString(
+      const std::string& name);
+
   void estimateSerializedSize(
       VectorPtr vector,
       const folly::Range<const IndexRange*>& ranges,
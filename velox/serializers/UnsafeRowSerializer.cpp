@@ -15,7 +15,6 @@
  */
 #include "velox/serializers/UnsafeRowSerializer.h"
 #include <folly/lang/Bits.h>
-#include "velox/row/UnsafeRowDeserializers.h"
 #include "velox/row/UnsafeRowFast.h"
 
 namespace facebook::velox::serializer::spark {
@@ -38,41 +37,52 @@ class UnsafeRowVectorSerializer : public VectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
-    size_t totalSize = 0;
+    size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
+    if (numRows == 0) {
+      return;
+    }
+
+    // Compute the sizes of all rows one column at a time.
     row::UnsafeRowFast unsafeRow(vector);
+    rowSizes_.resize(numRows);
     if (auto fixedRowSize =
             row::UnsafeRowFast::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
-
+      std::fill(rowSizes_.begin(), rowSizes_.end(), fixedRowSize.value());
     } else {
+      size_t index = 0;
       for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += unsafeRow.rowSize(i) + sizeof(TRowSize);
-        }
+        unsafeRow.rowSizes(range.begin, range.size, rowSizes_.data() + index);
+        index += range.size;
       }
     }
 
-    if (totalSize == 0) {
-      return;
+    // Each row is preceded by its size.
+    size_t totalSize = 0;
+    rowOffsets_.resize(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rowOffsets_[i] = totalSize + sizeof(TRowSize);
+      totalSize += sizeof(TRowSize) + rowSizes_[i];
     }
 
     BufferPtr buffer = AlignedBuffer::allocate<char>(totalSize, pool_, 0);
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
-    size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size =
-            unsafeRow.serialize(i, rawBuffer + offset + sizeof(TRowSize));
+    for (auto i = 0; i < numRows; ++i) {
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + rowOffsets_[i] - sizeof(TRowSize)) =
+          folly::Endian::big<TRowSize>(rowSizes_[i]);
+    }
 
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    // Write row data one column at a time.
+    size_t index = 0;
+    for (const auto& range : ranges) {
+      unsafeRow.serialize(
+          range.begin, range.size, rowOffsets_.data() + index, rawBuffer);
+      index += range.size;
     }
   }
 
@@ -86,6 +96,9 @@ class UnsafeRowVectorSerializer : public VectorSerializer {
  private:
   memory::MemoryPool* const FOLLY_NONNULL pool_;
   std::vector<BufferPtr> buffers_;
+  // Reusable serialized sizes and buffer offsets of the rows of an append.
+  std::vector<int32_t> rowSizes_;
+  std::vector<size_t> rowOffsets_;
 };
 } // namespace
 
@@ -103,7 +116,7 @@ void UnsafeRowVectorSerde::deserialize(
     RowTypePtr type,
     RowVectorPtr* result,
     const Options* /* options */) {
-  std::vector<std::optional<std::string_view>> serializedRows;
+  std::vector<std::string_view> serializedRows;
   while (!source->atEnd()) {
     // First read row size in big endian order.
     auto rowSize =
@@ -118,9 +131,7 @@ void UnsafeRowVectorSerde::deserialize(
     return;
   }
 
-  *result = std::dynamic_pointer_cast<RowVector>(
-      velox::row::UnsafeRowDeserializer::deserialize(
-          serializedRows, type, pool));
+  *result = velox::row::UnsafeRowFast::deserialize(serializedRows, type, pool);
 }
 
 // static
@@ -459,3 +459,145 @@ TEST_F(PrestoSerializerTest, ioBufRoundTrip) {
     assertEqualVectors(inputRowVector, outputRowVector);
   }
 }
+
+TEST_F(PrestoSerializerTest, compression) {
+  for (const auto kind :
+       {folly::io::CodecType::LZ4, folly::io::CodecType::ZSTD}) {
+    if (!folly::io::hasCodec(kind)) {
+      continue;
+    }
+    SCOPED_TRACE(folly::io::getCodec(kind)->getName());
+    const serializer::presto::PrestoVectorSerde::PrestoOptions options(
+        false, kind);
+    // Repeated values compress well and are sent compressed.
+    auto rowVector = vectorMaker_->rowVector(
+        {vectorMaker_->flatVector<int64_t>(
+             10'000, [](vector_size_t row) { return row % 7; }),
+         vectorMaker_->flatVector<StringView>(10'000, [](vector_size_t row) {
+           return StringView(row % 2 ? "aaaaaaaaaaaaaaaaaaaa" : "bbbb");
+         })});
+    std::ostringstream out;
+    serialize(rowVector, &out, &options, false);
+    const auto serialized = out.str();
+    // The codec marker follows the number of rows.
+    ASSERT_EQ(serialized[4] & 1, 1);
+    ASSERT_LT(serialized.size(), 10'000 * 8);
+    auto rowType = asRowType(rowVector->type());
+    assertEqualVectors(deserialize(rowType, serialized, &options), rowVector);
+    VELOX_ASSERT_THROW(
+        deserialize(rowType, serialized, nullptr),
+        "Received a compressed page without a compression codec");
+
+    // Random values do not compress enough and are sent raw.
+    folly::Random::DefaultGenerator rng(1);
+    auto randomVector =
+        vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+            10'000, [&](vector_size_t /*row*/) {
+              return folly::Random::rand64(rng);
+            })});
+    std::ostringstream randomOut;
+    serialize(randomVector, &randomOut, &options, false);
+    const auto randomSerialized = randomOut.str();
+    ASSERT_EQ(randomSerialized[4] & 1, 0);
+    assertEqualVectors(
+        deserialize(asRowType(randomVector->type()), randomSerialized, nullptr),
+        randomVector);
+  }
+}
+
+TEST_F(PrestoSerializerTest, preserveEncodings) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options(false);
+  options.preserveEncodings = true;
+  const vector_size_t size = 1'000;
+  auto dictionary = vectorMaker_->flatVector<StringView>(
+      {"apple", "banana", "cherry is a long fruit name"});
+  auto indices =
+      makeIndices(size, [](auto row) { return row % 3; }, pool_.get());
+  auto rowVector = vectorMaker_->rowVector(
+      {BaseVector::wrapInDictionary(nullptr, indices, size, dictionary),
+       BaseVector::createConstant(VARCHAR(), "constant", size, pool_.get()),
+       vectorMaker_->flatVector<int64_t>(
+           size, [](vector_size_t row) { return row; })});
+  auto rowType = asRowType(rowVector->type());
+
+  std::ostringstream flatOut;
+  serialize(rowVector, &flatOut, nullptr);
+  auto flat = deserialize(rowType, flatOut.str(), nullptr);
+  ASSERT_EQ(flat->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(flat->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+
+  std::ostringstream out;
+  serialize(rowVector, &out, &options);
+  auto deserialized = deserialize(rowType, out.str(), nullptr);
+  assertEqualVectors(rowVector, deserialized);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(),
+      VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(deserialized->childAt(0)->valueVector()->size(), 3);
+  ASSERT_EQ(
+      deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_LT(out.str().size(), flatOut.str().size());
+
+  // A dictionary or constant that changes within a page is flattened.
+  auto otherRowVector = vectorMaker_->rowVector(
+      {BaseVector::wrapInDictionary(
+           nullptr, indices, size, BaseVector::copy(*dictionary)),
+       BaseVector::createConstant(VARCHAR(), "other", size, pool_.get()),
+       vectorMaker_->flatVector<int64_t>(
+           size, [](vector_size_t row) { return row; })});
+  std::ostringstream mixedOut;
+  serialize({rowVector, otherRowVector}, &mixedOut, &options);
+  auto mixed = deserialize(rowType, mixedOut.str(), nullptr);
+  ASSERT_EQ(mixed->size(), 2 * size);
+  ASSERT_EQ(mixed->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+  ASSERT_EQ(mixed->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+  for (auto row = 0; row < size; ++row) {
+    ASSERT_TRUE(mixed->equalValueAt(rowVector.get(), row, row));
+    ASSERT_TRUE(mixed->equalValueAt(otherRowVector.get(), size + row, row));
+  }
+}
+
+TEST_F(PrestoSerializerTest, valuesViewOverInput) {
+  auto rowVector = vectorMaker_->rowVector(
+      {vectorMaker_->flatVector<int64_t>(
+           1'000, [](vector_size_t row) { return row; }),
+       vectorMaker_->flatVector<double>(
+           1'000, [](vector_size_t row) { return row * 0.1; }),
+       vectorMaker_->flatVector<int32_t>(
+           1'000,
+           [](vector_size_t row) { return row; },
+           [](vector_size_t row) { return row % 5 == 0; })});
+  auto rowType = asRowType(rowVector->type());
+  std::ostringstream out;
+  serialize(rowVector, &out, nullptr);
+
+  std::shared_ptr<folly::IOBuf> page = folly::IOBuf::copyBuffer(out.str());
+  auto byteStream = std::make_unique<ByteStream>();
+  byteStream->setRange(
+      {page->writableData(), static_cast<int32_t>(page->length()), 0});
+  byteStream->setInputOwner(page);
+  RowVectorPtr deserialized;
+  serde_->deserialize(
+      byteStream.get(), pool_.get(), rowType, &deserialized, nullptr);
+  auto isInPage = [&](const VectorPtr& vector) {
+    auto* data = vector->values()->as<uint8_t>();
+    return vector->values()->isView() && data >= page->data() &&
+        data < page->data() + page->length();
+  };
+  // Columns without nulls are views over the page. The column with nulls is
+  // copied since the page has only its non-null values.
+  ASSERT_TRUE(isInPage(deserialized->childAt(0)));
+  ASSERT_TRUE(isInPage(deserialized->childAt(1)));
+  ASSERT_FALSE(deserialized->childAt(2)->values()->isView());
+
+  // The vectors keep the page alive.
+  byteStream.reset();
+  page.reset();
+  assertEqualVectors(rowVector, deserialized);
+
+  // Without an owner the values are copied.
+  deserialized = deserialize(rowType, out.str(), nullptr);
+  ASSERT_FALSE(deserialized->childAt(0)->values()->isView());
+  assertEqualVectors(rowVector, deserialized);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+namespace facebook::velox::substrait {
+
+std::shared_ptr<const SubstraitPlanCache::Entry> SubstraitPlanCache::get(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto entry = cache_.get(key);
+  return entry.has_value() ? entry.value() : nullptr;
+}
+
+void SubstraitPlanCache::put(
+    const std::string& key,
+    std::shared_ptr<const Entry> entry) {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.add(key, std::move(entry));
+}
+
+void SubstraitPlanCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.clear();
+}
+
+SimpleLRUCacheStats SubstraitPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.getStats();
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::substrait {
+
+/// Caches the Velox plans converted from Substrait plans so that plans that
+/// differ only in the files they scan are converted once. The key is the
+/// Substrait plan with the file paths, starts, lengths and partition indices
+/// of its ReadRels removed. These are the split-specific slots of the plan:
+/// they only feed the SplitInfo of each scan and are filled in from the
+/// incoming plan on every lookup. Thread-safe.
+class SubstraitPlanCache {
+ public:
+  struct Entry {
+    core::PlanNodePtr plan;
+
+    /// The number of plan node ids used by 'plan'.
+    int numPlanNodeIds;
+
+    /// The id of the scan node of each ReadRel of the plan in the order of
+    /// SubstraitVeloxPlanConverter::collectReadRels. Empty for ReadRels not
+    /// converted to a TableScanNode.
+    std::vector<core::PlanNodeId> scanNodeIds;
+  };
+
+  explicit SubstraitPlanCache(size_t maxEntries)
+      : pool_(memory::addDefaultLeafMemoryPool("substraitPlanCache")),
+        cache_(maxEntries) {}
+
+  /// Returns the entry cached for 'key' or nullptr.
+  std::shared_ptr<const Entry> get(const std::string& key);
+
+  void put(const std::string& key, std::shared_ptr<const Entry> entry);
+
+  void clear();
+
+  SimpleLRUCacheStats stats() const;
+
+  /// The pool for the vectors of cached plans, e.g. values and constants.
+  /// These outlive the query that converted the plan and may not be
+  /// allocated from its pool.
+  memory::MemoryPool* pool() const {
+    return pool_.get();
+  }
+
+ private:
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const Entry>> cache_;
+};
+
+} // namespace facebook::velox::substrait
@@ -15,6 +15,11 @@
  */
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
+
+#include <folly/ScopeGuard.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
 #include "velox/substrait/TypeUtils.h"
 #include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
@@ -37,6 +42,46 @@ core::SortOrder toSortOrder(const ::substrait::SortField& sortField) {
   }
 }
 
+const ::substrait::Rel& topRel(const ::substrait::PlanRel& planRel) {
+  return planRel.has_root() ? planRel.root().input() : planRel.rel();
+}
+
+/// Returns the key of 'plan' in SubstraitPlanCache: 'plan' without the
+/// paths, starts, lengths and partition indices of the files it reads. Only
+/// the format of the last file is kept, as only that affects the
+/// conversion.
+std::string planCacheKey(const ::substrait::Plan& plan) {
+  ::substrait::Plan canonical = plan;
+  std::vector<const ::substrait::ReadRel*> readRels;
+  SubstraitVeloxPlanConverter::collectReadRels(
+      topRel(canonical.relations(0)), readRels);
+  for (const auto* readRel : readRels) {
+    if (!readRel->has_local_files() ||
+        readRel->local_files().items_size() == 0) {
+      continue;
+    }
+    // 'readRel' points into 'canonical', which is owned here.
+    auto* files =
+        const_cast<::substrait::ReadRel*>(readRel)->mutable_local_files();
+    auto file = files->items(files->items_size() - 1);
+    file.clear_path_type();
+    file.clear_partition_index();
+    file.clear_start();
+    file.clear_length();
+    files->clear_items();
+    *files->add_items() = std::move(file);
+  }
+
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream coded(&stream);
+    coded.SetSerializationDeterministic(true);
+    canonical.SerializeToCodedStream(&coded);
+  }
+  return key;
+}
+
 /// Holds the information required to create
 /// a project node to simulate the emit
 /// behavior in Substrait.
@@ -688,6 +733,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
       sortingOrders,
       windowColumnNames,
       windowNodeFunctions,
+      false,
       childNode);
 }
 
@@ -825,7 +871,6 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   // Check if the ReadRel specifies an input of stream. If yes, the pre-built
   // input node will be used as the data source.
-  auto splitInfo = std::make_shared<SplitInfo>();
   auto streamIdx = streamIsInput(readRel);
   if (streamIdx >= 0) {
     if (inputNodesMap_.find(streamIdx) == inputNodesMap_.end()) {
@@ -833,7 +878,9 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
           "Could not find source index {} in input nodes map.", streamIdx);
     }
     auto streamNode = inputNodesMap_[streamIdx];
+    auto splitInfo = std::make_shared<SplitInfo>();
     splitInfo->isStream = true;
+    scanNodeIds_.emplace_back();
     splitInfoMap_[streamNode->id()] = splitInfo;
     return streamNode;
   }
@@ -857,35 +904,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     }
   }
 
-  // Parse local files and construct split info.
-  if (readRel.has_local_files()) {
-    using SubstraitFileFormatCase =
-        ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
-    const auto& fileList = readRel.local_files().items();
-    splitInfo->paths.reserve(fileList.size());
-    splitInfo->starts.reserve(fileList.size());
-    splitInfo->lengths.reserve(fileList.size());
-    for (const auto& file : fileList) {
-      // Expect all Partitions share the same index.
-      splitInfo->partitionIndex = file.partition_index();
-      splitInfo->paths.emplace_back(file.uri_file());
-      splitInfo->starts.emplace_back(file.start());
-      splitInfo->lengths.emplace_back(file.length());
-      switch (file.file_format_case()) {
-        case SubstraitFileFormatCase::kOrc:
-          splitInfo->format = dwio::common::FileFormat::ORC;
-          break;
-        case SubstraitFileFormatCase::kDwrf:
-          splitInfo->format = dwio::common::FileFormat::DWRF;
-          break;
-        case SubstraitFileFormatCase::kParquet:
-          splitInfo->format = dwio::common::FileFormat::PARQUET;
-          break;
-        default:
-          splitInfo->format = dwio::common::FileFormat::UNKNOWN;
-      }
-    }
-  }
+  auto splitInfo = toSplitInfo(readRel);
   // Do not hard-code connector ID and allow for connectors other than Hive.
   static const std::string kHiveConnectorId = "test-hive";
 
@@ -981,6 +1000,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   auto outputType = ROW(std::move(outNames), std::move(veloxTypeList));
 
   if (readRel.has_virtual_table()) {
+    scanNodeIds_.emplace_back();
     return toVeloxPlan(readRel, outputType);
   } else {
     auto tableScanNode = std::make_shared<core::TableScanNode>(
@@ -990,10 +1010,46 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
         std::move(assignments));
     // Set split info map.
     splitInfoMap_[tableScanNode->id()] = splitInfo;
+    scanNodeIds_.push_back(tableScanNode->id());
     return tableScanNode;
   }
 }
 
+std::shared_ptr<SplitInfo> SubstraitVeloxPlanConverter::toSplitInfo(
+    const ::substrait::ReadRel& readRel) {
+  auto splitInfo = std::make_shared<SplitInfo>();
+  // Parse local files and construct split info.
+  if (readRel.has_local_files()) {
+    using SubstraitFileFormatCase =
+        ::substrait::ReadRel_LocalFiles_FileOrFiles::FileFormatCase;
+    const auto& fileList = readRel.local_files().items();
+    splitInfo->paths.reserve(fileList.size());
+    splitInfo->starts.reserve(fileList.size());
+    splitInfo->lengths.reserve(fileList.size());
+    for (const auto& file : fileList) {
+      // Expect all Partitions share the same index.
+      splitInfo->partitionIndex = file.partition_index();
+      splitInfo->paths.emplace_back(file.uri_file());
+      splitInfo->starts.emplace_back(file.start());
+      splitInfo->lengths.emplace_back(file.length());
+      switch (file.file_format_case()) {
+        case SubstraitFileFormatCase::kOrc:
+          splitInfo->format = dwio::common::FileFormat::ORC;
+          break;
+        case SubstraitFileFormatCase::kDwrf:
+          splitInfo->format = dwio::common::FileFormat::DWRF;
+          break;
+        case SubstraitFileFormatCase::kParquet:
+          splitInfo->format = dwio::common::FileFormat::PARQUET;
+          break;
+        default:
+          splitInfo->format = dwio::common::FileFormat::UNKNOWN;
+      }
+    }
+  }
+  return splitInfo;
+}
+
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     const RowTypePtr& type) {
@@ -1104,26 +1160,109 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   VELOX_FAIL("Input is expected in RelRoot.");
 }
 
+core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
+    const ::substrait::PlanRel& planRel) {
+  if (planRel.has_root()) {
+    return toVeloxPlan(planRel.root());
+  }
+  if (planRel.has_rel()) {
+    return toVeloxPlan(planRel.rel());
+  }
+
+  VELOX_FAIL("RelRoot or Rel is expected in Plan.");
+}
+
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::Plan& substraitPlan) {
   VELOX_CHECK(
       checkTypeExtension(substraitPlan),
       "The type extension only have unknown type.")
+  // In fact, only one RelRoot or Rel is expected here.
+  VELOX_CHECK_EQ(substraitPlan.relations_size(), 1);
+
+  // The ids and the names of the nodes of a cached plan start at 0. Plans
+  // reading streams depend on the input nodes of the task.
+  if (planCache_ != nullptr && !validationMode_ && planNodeId_ == 0 &&
+      inputNodesMap_.empty()) {
+    return toVeloxPlanCached(substraitPlan);
+  }
+
   // Construct the function map based on the Substrait representation,
   // and initialize the expression converter with it.
   constructFunctionMap(substraitPlan);
+  return toVeloxPlan(substraitPlan.relations(0));
+}
 
-  // In fact, only one RelRoot or Rel is expected here.
-  VELOX_CHECK_EQ(substraitPlan.relations_size(), 1);
-  const auto& rel = substraitPlan.relations(0);
-  if (rel.has_root()) {
-    return toVeloxPlan(rel.root());
-  }
-  if (rel.has_rel()) {
-    return toVeloxPlan(rel.rel());
+core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlanCached(
+    const ::substrait::Plan& substraitPlan) {
+  const auto& planRel = substraitPlan.relations(0);
+  std::vector<const ::substrait::ReadRel*> readRels;
+  if (!collectReadRels(topRel(planRel), readRels)) {
+    constructFunctionMap(substraitPlan);
+    return toVeloxPlan(planRel);
+  }
+
+  const auto key = planCacheKey(substraitPlan);
+  if (auto entry = planCache_->get(key)) {
+    VELOX_CHECK_EQ(entry->scanNodeIds.size(), readRels.size());
+    constructFunctionMap(substraitPlan);
+    planNodeId_ = entry->numPlanNodeIds;
+    for (auto i = 0; i < readRels.size(); ++i) {
+      if (!entry->scanNodeIds[i].empty()) {
+        splitInfoMap_[entry->scanNodeIds[i]] = toSplitInfo(*readRels[i]);
+      }
+    }
+    return entry->plan;
   }
 
-  VELOX_FAIL("RelRoot or Rel is expected in Plan.");
+  // The vectors of a cached plan outlive the query converting it.
+  auto* queryPool = pool_;
+  pool_ = planCache_->pool();
+  SCOPE_EXIT {
+    pool_ = queryPool;
+  };
+  constructFunctionMap(substraitPlan);
+  scanNodeIds_.clear();
+  auto entry = std::make_shared<SubstraitPlanCache::Entry>();
+  entry->plan = toVeloxPlan(planRel);
+  entry->numPlanNodeIds = planNodeId_;
+  if (scanNodeIds_.size() == readRels.size()) {
+    entry->scanNodeIds = std::move(scanNodeIds_);
+    auto plan = entry->plan;
+    planCache_->put(key, std::move(entry));
+    return plan;
+  }
+  return entry->plan;
+}
+
+// static
+bool SubstraitVeloxPlanConverter::collectReadRels(
+    const ::substrait::Rel& rel,
+    std::vector<const ::substrait::ReadRel*>& readRels) {
+  switch (rel.rel_type_case()) {
+    case ::substrait::Rel::RelTypeCase::kRead:
+      readRels.push_back(&rel.read());
+      return true;
+    case ::substrait::Rel::RelTypeCase::kFilter:
+      return collectReadRels(rel.filter().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kFetch:
+      return collectReadRels(rel.fetch().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kAggregate:
+      return collectReadRels(rel.aggregate().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kSort:
+      return collectReadRels(rel.sort().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kProject:
+      return collectReadRels(rel.project().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kExpand:
+      return collectReadRels(rel.expand().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kWindow:
+      return collectReadRels(rel.window().input(), readRels);
+    case ::substrait::Rel::RelTypeCase::kJoin:
+      return collectReadRels(rel.join().left(), readRels) &&
+          collectReadRels(rel.join().right(), readRels);
+    default:
+      return false;
+  }
 }
 
 std::string SubstraitVeloxPlanConverter::nextPlanNodeId() {
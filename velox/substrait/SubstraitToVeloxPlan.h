@@ -18,6 +18,7 @@
 
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/core/PlanNode.h"
+#include "velox/substrait/SubstraitPlanCache.h"
 #include "velox/substrait/SubstraitToVeloxExpr.h"
 #include "velox/substrait/TypeUtils.h"
 
@@ -45,10 +46,15 @@ struct SplitInfo {
 /// This class is used to convert the Substrait plan into Velox plan.
 class SubstraitVeloxPlanConverter {
  public:
+  /// If 'planCache' is set, plans that differ only in the files they scan
+  /// are converted once and share the cached Velox plan.
   SubstraitVeloxPlanConverter(
       memory::MemoryPool* pool,
-      bool validationMode = false)
-      : pool_(pool), validationMode_(validationMode) {}
+      bool validationMode = false,
+      std::shared_ptr<SubstraitPlanCache> planCache = nullptr)
+      : pool_(pool),
+        validationMode_(validationMode),
+        planCache_(std::move(planCache)) {}
   /// Used to convert Substrait ExpandRel into Velox PlanNode.
   core::PlanNodePtr toVeloxPlan(const ::substrait::ExpandRel& expandRel);
 
@@ -97,6 +103,13 @@ class SubstraitVeloxPlanConverter {
   /// Used to convert Substrait Plan into Velox PlanNode.
   core::PlanNodePtr toVeloxPlan(const ::substrait::Plan& substraitPlan);
 
+  /// Appends the ReadRels under 'rel' to 'readRels' in the order they are
+  /// converted. Returns false if 'rel' has a relation this does not know the
+  /// inputs of.
+  static bool collectReadRels(
+      const ::substrait::Rel& rel,
+      std::vector<const ::substrait::ReadRel*>& readRels);
+
   /// Used to construct the function map between the index
   /// and the Substrait function name. Initialize the expression
   /// converter based on the constructed function map.
@@ -504,6 +517,15 @@ class SubstraitVeloxPlanConverter {
       const std::shared_ptr<const core::PlanNode>& childNode,
       const core::AggregationNode::Step& aggStep);
 
+  /// Converts the RelRoot or Rel of a Substrait plan.
+  core::PlanNodePtr toVeloxPlan(const ::substrait::PlanRel& planRel);
+
+  /// Converts 'substraitPlan' through 'planCache_'.
+  core::PlanNodePtr toVeloxPlanCached(const ::substrait::Plan& substraitPlan);
+
+  /// Returns the split info of the local files of 'readRel'.
+  std::shared_ptr<SplitInfo> toSplitInfo(const ::substrait::ReadRel& readRel);
+
   /// Helper function to convert the input of Substrait Rel to Velox Node.
   template <typename T>
   core::PlanNodePtr convertSingleInput(T rel) {
@@ -542,6 +564,13 @@ class SubstraitVeloxPlanConverter {
 
   /// A flag used to specify validation.
   bool validationMode_ = false;
+
+  /// Cache of converted plans. May be nullptr.
+  const std::shared_ptr<SubstraitPlanCache> planCache_;
+
+  /// The id of the scan node of each converted ReadRel in conversion order.
+  /// Empty for ReadRels not converted to a TableScanNode.
+  std::vector<core::PlanNodeId> scanNodeIds_;
 };
 
 } // namespace facebook::velox::substrait
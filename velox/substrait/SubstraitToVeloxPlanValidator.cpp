@@ -18,6 +18,7 @@
 #include <google/protobuf/wrappers.pb.h>
 #include <string>
 #include "TypeUtils.h"
+#include <folly/Synchronized.h>
 #include "velox/exec/Aggregate.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/type/Tokenizer.h"
@@ -891,63 +892,93 @@ TypePtr SubstraitToVeloxPlanValidator::getRowType(
   return std::make_shared<RowType>(std::move(names), std::move(types));
 }
 
+std::optional<std::string>
+SubstraitToVeloxPlanValidator::bindAggFunctionSignature(
+    const std::string& funcSpec,
+    bool isPartial) {
+  std::vector<TypePtr> types;
+  bool isDecimal = false;
+  try {
+    std::vector<std::string> funcTypes;
+    subParser_->getSubFunctionTypes(funcSpec, funcTypes);
+    types.reserve(funcTypes.size());
+    for (auto& type : funcTypes) {
+      if (!isDecimal && type.find("dec") != std::string::npos) {
+        isDecimal = true;
+      }
+      if (type.find("struct") != std::string::npos) {
+        types.emplace_back(getRowType(type));
+      } else if (type.find("dec") != std::string::npos) {
+        types.emplace_back(getDecimalType(type));
+      } else {
+        types.emplace_back(toVeloxType(subParser_->parseType(type)));
+      }
+    }
+  } catch (const VeloxException& err) {
+    return "native validation failed due to: Validation failed for input type in AggregateRel function due to:" +
+        err.message();
+  }
+  auto funcName = subParser_->mapToVeloxFunction(
+      subParser_->getSubFunctionName(funcSpec), isDecimal);
+  auto signatures = exec::getAggregateFunctionSignatures(funcName);
+  if (!signatures) {
+    return std::nullopt;
+  }
+  for (const auto& signature : signatures.value()) {
+    exec::SignatureBinder binder(*signature, types);
+    if (binder.tryBind()) {
+      auto resolveType = binder.tryResolveType(
+          isPartial ? signature->intermediateType()
+                    : signature->returnType());
+      if (resolveType == nullptr) {
+        return "native validation failed due to: Validation failed for function " +
+            funcName + "resolve type in AggregateRel.";
+      }
+      return "";
+    }
+  }
+  return "native validation failed due to: Validation failed for function " +
+      funcName + " bind in AggregateRel.";
+}
+
 bool SubstraitToVeloxPlanValidator::validateAggRelFunctionType(
     const ::substrait::AggregateRel& aggRel) {
   if (aggRel.measures_size() == 0) {
     return true;
   }
 
+  // Plans of the same query shape repeat the same functions. The result of
+  // binding a function is kept per signature and step for the process.
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::optional<std::string>>>
+      bindResults;
+  const bool isPartial =
+      exec::isPartialOutput(planConverter_->toAggregationStep(aggRel));
   for (const auto& smea : aggRel.measures()) {
     const auto& aggFunction = smea.measure();
     auto funcSpec =
         planConverter_->findFuncSpec(aggFunction.function_reference());
-    std::vector<TypePtr> types;
-    bool isDecimal = false;
-    try {
-      std::vector<std::string> funcTypes;
-      subParser_->getSubFunctionTypes(funcSpec, funcTypes);
-      types.reserve(funcTypes.size());
-      for (auto& type : funcTypes) {
-        if (!isDecimal && type.find("dec") != std::string::npos) {
-          isDecimal = true;
-        }
-        if (type.find("struct") != std::string::npos) {
-          types.emplace_back(getRowType(type));
-        } else if (type.find("dec") != std::string::npos) {
-          types.emplace_back(getDecimalType(type));
-        } else {
-          types.emplace_back(toVeloxType(subParser_->parseType(type)));
-        }
+    auto key = fmt::format("{}:{}", funcSpec, isPartial);
+    std::optional<std::string> result;
+    bool found = false;
+    {
+      auto results = bindResults.rlock();
+      auto it = results->find(key);
+      if (it != results->end()) {
+        result = it->second;
+        found = true;
       }
-    } catch (const VeloxException& err) {
-      logValidateMsg(
-          "native validation failed due to: Validation failed for input type in AggregateRel function due to:" +
-          err.message());
-      return false;
     }
-    auto funcName = subParser_->mapToVeloxFunction(
-        subParser_->getSubFunctionName(funcSpec), isDecimal);
-    if (auto signatures = exec::getAggregateFunctionSignatures(funcName)) {
-      for (const auto& signature : signatures.value()) {
-        exec::SignatureBinder binder(*signature, types);
-        if (binder.tryBind()) {
-          auto resolveType = binder.tryResolveType(
-              exec::isPartialOutput(planConverter_->toAggregationStep(aggRel))
-                  ? signature->intermediateType()
-                  : signature->returnType());
-          if (resolveType == nullptr) {
-            logValidateMsg(
-                "native validation failed due to: Validation failed for function " +
-                funcName + "resolve type in AggregateRel.");
-            return false;
-          }
-          return true;
-        }
+    if (!found) {
+      result = bindAggFunctionSignature(funcSpec, isPartial);
+      bindResults.wlock()->emplace(std::move(key), result);
+    }
+    if (result.has_value()) {
+      if (!result->empty()) {
+        logValidateMsg(result.value());
+        return false;
       }
-      logValidateMsg(
-          "native validation failed due to: Validation failed for function " +
-          funcName + " bind in AggregateRel.");
-      return false;
+      return true;
     }
   }
   logValidateMsg(
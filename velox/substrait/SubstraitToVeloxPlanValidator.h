@@ -98,6 +98,13 @@ class SubstraitToVeloxPlanValidator {
   bool validateAggRelFunctionType(
       const ::substrait::AggregateRel& substraitAgg);
 
+  /// Binds the aggregate function 'funcSpec' to its signatures. Returns an
+  /// empty string if it binds, the error message if not, and std::nullopt if
+  /// there is no such function.
+  std::optional<std::string> bindAggFunctionSignature(
+      const std::string& funcSpec,
+      bool isPartial);
+
   /// Validate the round scalar function.
   bool validateRound(
       const ::substrait::Expression::ScalarFunction& scalarFunction,
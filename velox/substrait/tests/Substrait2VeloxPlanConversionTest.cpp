@@ -328,3 +328,50 @@ TEST_F(Substrait2VeloxPlanConversionTest, filterUpper) {
       "[(key, BigintRange: [-2147483648, 2] no nulls)]] -> n0_0:INTEGER\n",
       planNode->toString(true, true));
 }
+
+TEST_F(Substrait2VeloxPlanConversionTest, planCache) {
+  std::string subPlanPath =
+      getDataFilePath("velox/substrait/tests", "data/filter_upper.json");
+
+  ::substrait::Plan substraitPlan;
+  JsonToProtoConverter::readFromFile(subPlanPath, substraitPlan);
+  auto planCache = std::make_shared<vestrait::SubstraitPlanCache>(10);
+  auto pool = memory::addDefaultLeafMemoryPool();
+
+  vestrait::SubstraitVeloxPlanConverter converter(
+      pool.get(), false, planCache);
+  auto planNode = converter.toVeloxPlan(substraitPlan);
+  ASSERT_EQ(0, planCache->stats().numHits);
+  ASSERT_EQ(1, planCache->stats().curSize);
+
+  // The same plan on other files reuses the converted plan and reports the
+  // files of the new plan.
+  std::vector<const ::substrait::ReadRel*> readRels;
+  ASSERT_TRUE(vestrait::SubstraitVeloxPlanConverter::collectReadRels(
+      substraitPlan.relations(0).root().input(), readRels));
+  ASSERT_EQ(1, readRels.size());
+  auto* file = const_cast<::substrait::ReadRel*>(readRels[0])
+                   ->mutable_local_files()
+                   ->mutable_items(0);
+  file->set_uri_file("file:///tmp/other.parquet");
+  file->set_start(100);
+
+  vestrait::SubstraitVeloxPlanConverter otherConverter(
+      pool.get(), false, planCache);
+  auto otherPlanNode = otherConverter.toVeloxPlan(substraitPlan);
+  ASSERT_EQ(planNode, otherPlanNode);
+  ASSERT_EQ(1, planCache->stats().numHits);
+  const auto& splitInfo =
+      otherConverter.splitInfos().at(*planNode->leafPlanNodeIds().begin());
+  ASSERT_EQ(
+      std::vector<std::string>{"file:///tmp/other.parquet"}, splitInfo->paths);
+  ASSERT_EQ(std::vector<u_int64_t>{100}, splitInfo->starts);
+
+  // A different format is a different plan shape.
+  file->mutable_orc();
+  vestrait::SubstraitVeloxPlanConverter orcConverter(
+      pool.get(), false, planCache);
+  orcConverter.toVeloxPlan(substraitPlan);
+  ASSERT_EQ(1, planCache->stats().numHits);
+  ASSERT_EQ(2, planCache->stats().curSize);
+}
@@ -37,6 +37,19 @@ class DBGenBackend {
     DBGenContext dbgenCtx;
     load_dists(
         10 * 1024 * 1024, &dbgenCtx); // 10 MB buffer size for text generation.
+
+    // mk_order(), mk_part(), mk_supp() and mk_cust() lazily initialize
+    // function-level statics (formats and the date table) on their first
+    // call. Generate one row of each here so that splits can later be
+    // generated concurrently from different threads without racing on it.
+    order_t order;
+    mk_order(1, &order, &dbgenCtx, /*update-num=*/0);
+    part_t part;
+    mk_part(1, &part, &dbgenCtx);
+    supplier_t supplier;
+    mk_supp(1, &supplier, &dbgenCtx);
+    customer_t customer;
+    mk_cust(1, &customer, &dbgenCtx);
   }
   ~DBGenBackend() {
     cleanup_dists();
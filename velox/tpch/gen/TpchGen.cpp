@@ -19,6 +19,7 @@
 #include "velox/external/duckdb/tpch/dbgen/include/dbgen/dss.h"
 #include "velox/external/duckdb/tpch/dbgen/include/dbgen/dsstypes.h"
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -82,10 +83,18 @@ double decimalToDouble(int64_t value) {
   return (double)value * 0.01;
 }
 
-Date toDate(std::string_view stringDate) {
-  Date date;
-  parseTo(stringDate, date);
-  return date;
+// Dbgen always formats dates as 'YYYY-MM-DD', so decode the digits directly
+// instead of going through the generic date parser.
+Date toDate(const char* stringDate) {
+  auto digits = [&](int32_t begin, int32_t count) {
+    int32_t value = 0;
+    for (auto i = begin; i < begin + count; ++i) {
+      value = value * 10 + (stringDate[i] - '0');
+    }
+    return value;
+  };
+  return Date(util::daysSinceEpochFromDate(
+      digits(0, 4), digits(5, 2), digits(8, 2)));
 }
 } // namespace
 
@@ -367,14 +376,16 @@ RowVectorPtr genTpchOrders(
       getRowCount(Table::TBL_ORDERS, scaleFactor), maxRows, offset);
   auto children = allocateVectors(ordersRowType, vectorSize, pool);
 
-  auto orderKeyVector = children[0]->asFlatVector<int64_t>();
-  auto custKeyVector = children[1]->asFlatVector<int64_t>();
+  // Fixed-width columns are written straight into their value buffers.
+  auto orderKeys = children[0]->asFlatVector<int64_t>()->mutableRawValues();
+  auto custKeys = children[1]->asFlatVector<int64_t>()->mutableRawValues();
   auto orderStatusVector = children[2]->asFlatVector<StringView>();
-  auto totalPriceVector = children[3]->asFlatVector<double>();
-  auto orderDateVector = children[4]->asFlatVector<Date>();
+  auto totalPrices = children[3]->asFlatVector<double>()->mutableRawValues();
+  auto orderDates = children[4]->asFlatVector<Date>()->mutableRawValues();
   auto orderPriorityVector = children[5]->asFlatVector<StringView>();
   auto clerkVector = children[6]->asFlatVector<StringView>();
-  auto shipPriorityVector = children[7]->asFlatVector<int32_t>();
+  auto shipPriorities =
+      children[7]->asFlatVector<int32_t>()->mutableRawValues();
   auto commentVector = children[8]->asFlatVector<StringView>();
 
   DBGenIterator dbgenIt(scaleFactor);
@@ -386,15 +397,15 @@ RowVectorPtr genTpchOrders(
   for (size_t i = 0; i < vectorSize; ++i) {
     dbgenIt.genOrder(i + offset + 1, order);
 
-    orderKeyVector->set(i, order.okey);
-    custKeyVector->set(i, order.custkey);
+    orderKeys[i] = order.okey;
+    custKeys[i] = order.custkey;
     orderStatusVector->set(i, StringView(&order.orderstatus, 1));
-    totalPriceVector->set(i, decimalToDouble(order.totalprice));
-    orderDateVector->set(i, toDate(order.odate));
+    totalPrices[i] = decimalToDouble(order.totalprice);
+    orderDates[i] = toDate(order.odate);
     orderPriorityVector->set(
         i, StringView(order.opriority, strlen(order.opriority)));
     clerkVector->set(i, StringView(order.clerk, strlen(order.clerk)));
-    shipPriorityVector->set(i, order.spriority);
+    shipPriorities[i] = order.spriority;
     commentVector->set(i, StringView(order.comment, order.clen));
   }
   return std::make_shared<RowVector>(
@@ -416,21 +427,23 @@ RowVectorPtr genTpchLineItem(
   auto lineItemRowType = getTableSchema(Table::TBL_LINEITEM);
   auto children = allocateVectors(lineItemRowType, lineItemUpperBound, pool);
 
-  auto orderKeyVector = children[0]->asFlatVector<int64_t>();
-  auto partKeyVector = children[1]->asFlatVector<int64_t>();
-  auto suppKeyVector = children[2]->asFlatVector<int64_t>();
-  auto lineNumberVector = children[3]->asFlatVector<int32_t>();
+  // Fixed-width columns are written straight into their value buffers.
+  auto orderKeys = children[0]->asFlatVector<int64_t>()->mutableRawValues();
+  auto partKeys = children[1]->asFlatVector<int64_t>()->mutableRawValues();
+  auto suppKeys = children[2]->asFlatVector<int64_t>()->mutableRawValues();
+  auto lineNumbers = children[3]->asFlatVector<int32_t>()->mutableRawValues();
 
-  auto quantityVector = children[4]->asFlatVector<double>();
-  auto extendedPriceVector = children[5]->asFlatVector<double>();
-  auto discountVector = children[6]->asFlatVector<double>();
-  auto taxVector = children[7]->asFlatVector<double>();
+  auto quantities = children[4]->asFlatVector<double>()->mutableRawValues();
+  auto extendedPrices =
+      children[5]->asFlatVector<double>()->mutableRawValues();
+  auto discounts = children[6]->asFlatVector<double>()->mutableRawValues();
+  auto taxes = children[7]->asFlatVector<double>()->mutableRawValues();
 
   auto returnFlagVector = children[8]->asFlatVector<StringView>();
   auto lineStatusVector = children[9]->asFlatVector<StringView>();
-  auto shipDateVector = children[10]->asFlatVector<Date>();
-  auto commitDateVector = children[11]->asFlatVector<Date>();
-  auto receiptDateVector = children[12]->asFlatVector<Date>();
+  auto shipDates = children[10]->asFlatVector<Date>()->mutableRawValues();
+  auto commitDates = children[11]->asFlatVector<Date>()->mutableRawValues();
+  auto receiptDates = children[12]->asFlatVector<Date>()->mutableRawValues();
   auto shipInstructVector = children[13]->asFlatVector<StringView>();
   auto shipModeVector = children[14]->asFlatVector<StringView>();
   auto commentVector = children[15]->asFlatVector<StringView>();
@@ -450,31 +463,30 @@ RowVectorPtr genTpchLineItem(
 
     for (size_t l = 0; l < order.lines; ++l) {
       const auto& line = order.l[l];
-      orderKeyVector->set(lineItemCount + l, line.okey);
-      partKeyVector->set(lineItemCount + l, line.partkey);
-      suppKeyVector->set(lineItemCount + l, line.suppkey);
+      const auto row = lineItemCount + l;
+      orderKeys[row] = line.okey;
+      partKeys[row] = line.partkey;
+      suppKeys[row] = line.suppkey;
 
-      lineNumberVector->set(lineItemCount + l, line.lcnt);
+      lineNumbers[row] = line.lcnt;
 
-      quantityVector->set(lineItemCount + l, decimalToDouble(line.quantity));
-      extendedPriceVector->set(lineItemCount + l, decimalToDouble(line.eprice));
-      discountVector->set(lineItemCount + l, decimalToDouble(line.discount));
-      taxVector->set(lineItemCount + l, decimalToDouble(line.tax));
+      quantities[row] = decimalToDouble(line.quantity);
+      extendedPrices[row] = decimalToDouble(line.eprice);
+      discounts[row] = decimalToDouble(line.discount);
+      taxes[row] = decimalToDouble(line.tax);
 
-      returnFlagVector->set(lineItemCount + l, StringView(line.rflag, 1));
-      lineStatusVector->set(lineItemCount + l, StringView(line.lstatus, 1));
+      returnFlagVector->set(row, StringView(line.rflag, 1));
+      lineStatusVector->set(row, StringView(line.lstatus, 1));
 
-      shipDateVector->set(lineItemCount + l, toDate(line.sdate));
-      commitDateVector->set(lineItemCount + l, toDate(line.cdate));
-      receiptDateVector->set(lineItemCount + l, toDate(line.rdate));
+      shipDates[row] = toDate(line.sdate);
+      commitDates[row] = toDate(line.cdate);
+      receiptDates[row] = toDate(line.rdate);
 
       shipInstructVector->set(
-          lineItemCount + l,
-          StringView(line.shipinstruct, strlen(line.shipinstruct)));
+          row, StringView(line.shipinstruct, strlen(line.shipinstruct)));
       shipModeVector->set(
-          lineItemCount + l, StringView(line.shipmode, strlen(line.shipmode)));
-      commentVector->set(
-          lineItemCount + l, StringView(line.comment, strlen(line.comment)));
+          row, StringView(line.shipmode, strlen(line.shipmode)));
+      commentVector->set(row, StringView(line.comment, strlen(line.comment)));
     }
     lineItemCount += order.lines;
   }
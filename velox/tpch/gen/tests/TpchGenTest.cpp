@@ -15,6 +15,7 @@
  */
 
 #include <folly/init/Init.h>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "velox/tpch/gen/TpchGen.h"
@@ -410,6 +411,37 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+TEST_F(TpchGenTestLineItemTest, concurrent) {
+  // Splits of the same table generated from several threads at once must
+  // match the serially generated data.
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kOrdersPerSplit = 500;
+  std::vector<RowVectorPtr> expected;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    expected.push_back(
+        genTpchLineItem(pool_.get(), kOrdersPerSplit, i * kOrdersPerSplit));
+  }
+
+  std::vector<RowVectorPtr> results(kNumThreads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      results[i] =
+          genTpchLineItem(pool_.get(), kOrdersPerSplit, i * kOrdersPerSplit);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    ASSERT_EQ(expected[i]->size(), results[i]->size());
+    for (size_t row = 0; row < expected[i]->size(); ++row) {
+      ASSERT_TRUE(expected[i]->equalValueAt(results[i].get(), row, row));
+    }
+  }
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
@@ -99,6 +99,45 @@ class DecimalUtil {
 #endif
   }
 
+  /// Returns true if 'value' fits in 64 bits. Most long decimal values do, and
+  /// for them 128-bit multiplies and divides, which are library calls, can be
+  /// done with single 64-bit instructions.
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static bool fitsInt64(const T& value) {
+    return value == static_cast<int64_t>(value);
+  }
+
+  /// Returns a * b as R and throws on overflow like checkedMultiply. The
+  /// product of factors that fit in 64 bits always fits in 128 bits, so it
+  /// needs no overflow check.
+  template <typename R, typename A, typename B>
+  FOLLY_ALWAYS_INLINE static R multiply(const A& a, const B& b) {
+    if constexpr (std::is_same_v<R, int128_t>) {
+      if (fitsInt64(a) && fitsInt64(b)) {
+        return R(static_cast<int64_t>(a)) * static_cast<int64_t>(b);
+      }
+    }
+    return checkedMultiply<R>(R(a), R(b), "Decimal");
+  }
+
+  /// Returns 'dividend' / 'divisor' and sets 'remainder' to 'dividend' %
+  /// 'divisor' for non-negative arguments. Uses 64-bit division if both
+  /// arguments fit.
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static T
+  divideUnsigned(const T& dividend, const T& divisor, T& remainder) {
+    if constexpr (std::is_same_v<T, int128_t>) {
+      if (fitsInt64(dividend) && fitsInt64(divisor)) {
+        const auto a = static_cast<uint64_t>(dividend);
+        const auto b = static_cast<uint64_t>(divisor);
+        remainder = a % b;
+        return a / b;
+      }
+    }
+    remainder = dividend % divisor;
+    return dividend / divisor;
+  }
+
   template <typename TInput, typename TOutput>
   inline static std::optional<TOutput> rescaleWithRoundUp(
       const TInput inputValue,
@@ -221,12 +260,11 @@ class DecimalUtil {
       resultSign *= -1;
       unsignedDivisor *= -1;
     }
-    unsignedDividendRescaled = checkedMultiply<R>(
-        unsignedDividendRescaled,
-        R(DecimalUtil::kPowersOfTen[aRescale]),
-        "Decimal");
-    R quotient = unsignedDividendRescaled / unsignedDivisor;
-    R remainder = unsignedDividendRescaled % unsignedDivisor;
+    unsignedDividendRescaled = multiply<R>(
+        unsignedDividendRescaled, DecimalUtil::kPowersOfTen[aRescale]);
+    R remainder;
+    R quotient =
+        divideUnsigned(unsignedDividendRescaled, unsignedDivisor, remainder);
     if (!noRoundUp && static_cast<const B>(remainder) * 2 >= unsignedDivisor) {
       ++quotient;
     }
@@ -160,7 +160,13 @@ class DecimalUtilOp {
   FOLLY_ALWAYS_INLINE static int128_t
   multiply(int128_t a, int128_t b, bool* overflow) {
     int128_t value;
-    *overflow = __builtin_mul_overflow(a, b, &value);
+    if (DecimalUtil::fitsInt64(a) && DecimalUtil::fitsInt64(b)) {
+      // Cannot overflow 128 bits.
+      value = a * b;
+      *overflow = false;
+    } else {
+      *overflow = __builtin_mul_overflow(a, b, &value);
+    }
     if (!*overflow && value >= velox::DecimalUtil::kLongDecimalMin &&
         value <= velox::DecimalUtil::kLongDecimalMax) {
       return value;
@@ -206,8 +212,9 @@ class DecimalUtilOp {
       if (*overflow) {
         return R(-1);
       }
-      R quotient = unsignedDividendRescaled / unsignedDivisor;
-      R remainder = unsignedDividendRescaled % unsignedDivisor;
+      R remainder;
+      R quotient = DecimalUtil::divideUnsigned(
+          unsignedDividendRescaled, unsignedDivisor, remainder);
       if (!noRoundUp && remainder * 2 >= unsignedDivisor) {
         ++quotient;
       }
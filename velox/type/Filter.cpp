@@ -20,7 +20,10 @@
 #include <set>
 #include <string>
 
+#include <folly/hash/Hash.h>
+
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -88,6 +91,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintRange:
       strKind = "HugeintRange";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -122,6 +128,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kBigintMultiRange, "kBigintMultiRange"},
       {FilterKind::kMultiRange, "kMultiRange"},
       {FilterKind::kHugeintRange, "kHugeintRange"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -160,6 +168,8 @@ void Filter::registerSerDe() {
       "BigintValuesUsingHashTable", BigintValuesUsingHashTable::create);
   registry.Register(
       "BigintValuesUsingBitmask", BigintValuesUsingBitmask::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register(
       "NegatedBigintValuesUsingHashTable",
       NegatedBigintValuesUsingHashTable::create);
@@ -304,7 +314,7 @@ folly::dynamic BigintValuesUsingHashTable::serialize() const {
   obj["max"] = max_;
 
   folly::dynamic values = folly::dynamic::array;
-  for (auto v : values_) {
+  for (auto v : table_->values) {
     values.push_back(v);
   }
   obj["values"] = values;
@@ -327,20 +337,14 @@ bool BigintValuesUsingHashTable::testingEquals(const Filter& other) const {
       dynamic_cast<const BigintValuesUsingHashTable*>(&other);
   bool res = otherBigintValues != nullptr && Filter::testingBaseEquals(other) &&
       min_ == otherBigintValues->min_ && max_ == otherBigintValues->max_ &&
-      values_.size() == otherBigintValues->values_.size();
+      values().size() == otherBigintValues->values().size();
 
   if (!res) {
     return false;
   }
 
-  // values_ can be compared pair-wise since they are sorted.
-  for (size_t i = 0; i < values_.size(); ++i) {
-    if (values_.at(i) != otherBigintValues->values_.at(i)) {
-      return false;
-    }
-  }
-
-  return true;
+  // The values can be compared pair-wise since they are sorted.
+  return values() == otherBigintValues->values();
 }
 
 folly::dynamic BigintValuesUsingBitmask::serialize() const {
@@ -389,6 +393,44 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
   return true;
 }
 
+namespace {
+std::string serializeBloomFilter(const BloomFilter<>& bloomFilter) {
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  return serialized;
+}
+} // namespace
+
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  obj["bloomFilter"] =
+      encoding::Base64::encode(serializeBloomFilter(*bloomFilter_));
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto serialized = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(serialized.data());
+
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  return otherBloomFilter != nullptr && Filter::testingBaseEquals(other) &&
+      min_ == otherBloomFilter->min_ && max_ == otherBloomFilter->max_ &&
+      serializeBloomFilter(*bloomFilter_) ==
+      serializeBloomFilter(*otherBloomFilter->bloomFilter_);
+}
+
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
   auto obj = Filter::serializeBase("NegatedBigintValuesUsingHashTable");
   obj["nonNegated"] = nonNegated_->serialize();
@@ -552,7 +594,7 @@ bool NegatedBytesRange::testingEquals(const Filter& other) const {
 folly::dynamic BytesValues::serialize() const {
   auto obj = Filter::serializeBase("BytesValues");
   folly::dynamic values = folly::dynamic::array;
-  for (auto v : values_) {
+  for (const auto& v : table_->values) {
     values.push_back(v);
   }
   obj["values"] = values;
@@ -577,21 +619,21 @@ bool BytesValues::testingEquals(const Filter& other) const {
   auto res = otherBytesValues != nullptr && Filter::testingBaseEquals(other) &&
       lower_ == otherBytesValues->lower_ &&
       upper_ == otherBytesValues->upper_ &&
-      values_.size() == otherBytesValues->values_.size() &&
-      lengths_.size() == otherBytesValues->lengths_.size();
+      table_->values.size() == otherBytesValues->table_->values.size() &&
+      table_->lengths.size() == otherBytesValues->table_->lengths.size();
 
   if (!res) {
     return false;
   }
 
-  for (const auto& v : values_) {
-    if (!otherBytesValues->values_.contains(v)) {
+  for (const auto& v : table_->values) {
+    if (!otherBytesValues->table_->values.contains(v)) {
       return false;
     }
   }
 
-  for (auto l : lengths_) {
-    if (!otherBytesValues->lengths_.contains(l)) {
+  for (auto l : table_->lengths) {
+    if (!otherBytesValues->table_->lengths.contains(l)) {
       return false;
     }
   }
@@ -761,6 +803,41 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilter<>> bloomFilter,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)) {
+  VELOX_CHECK_LE(min, max, "min must be no greater than max");
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64(int64_t value) const {
+  if (value < min_ || value > max_) {
+    return false;
+  }
+  return bloomFilter_->mayContain(folly::hasher<int64_t>()(value));
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return !(min > max_ || max < min_);
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -768,28 +845,30 @@ BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     bool nullAllowed)
     : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingHashTable),
       min_(min),
-      max_(max),
-      values_(values) {
+      max_(max) {
   constexpr int32_t kPaddingElements = 4;
   VELOX_CHECK(min < max, "min must be less than max");
   VELOX_CHECK(values.size() > 1, "values must contain at least 2 entries");
 
+  auto table = std::make_shared<Table>();
+  auto& hashTable = table->hashTable;
   // Size the hash table to be 2+x the entry count, e.g. 10 entries
   // gets 1 << log2 of 50 == 32. The filter is expected to fail often so we
   // wish to increase the chance of hitting empty on first probe.
   auto size = 1u << (uint32_t)std::log2(values.size() * 5);
-  hashTable_.resize(size + kPaddingElements);
-  sizeMask_ = size - 1;
-  std::fill(hashTable_.begin(), hashTable_.end(), kEmptyMarker);
+  hashTable.resize(size + kPaddingElements);
+  table->sizeMask = size - 1;
+  const auto sizeMask = table->sizeMask;
+  std::fill(hashTable.begin(), hashTable.end(), kEmptyMarker);
   for (auto value : values) {
     if (value == kEmptyMarker) {
-      containsEmptyMarker_ = true;
+      table->containsEmptyMarker = true;
     } else {
-      auto position = ((value * M) & sizeMask_);
+      auto position = ((value * M) & sizeMask);
       for (auto i = position; i < position + size; i++) {
-        uint32_t index = i & sizeMask_;
-        if (hashTable_[index] == kEmptyMarker) {
-          hashTable_[index] = value;
+        uint32_t index = i & sizeMask;
+        if (hashTable[index] == kEmptyMarker) {
+          hashTable[index] = value;
           break;
         }
       }
@@ -798,22 +877,42 @@ BigintValuesUsingHashTable::BigintValuesUsingHashTable(
   // Replicate the last element of hashTable kPaddingEntries times at 'size_' so
   // that one can load a full vector of elements past the last used index.
   for (auto i = 0; i < kPaddingElements; ++i) {
-    hashTable_[sizeMask_ + 1 + i] = hashTable_[sizeMask_];
+    hashTable[sizeMask + 1 + i] = hashTable[sizeMask];
+  }
+  table->values = values;
+  std::sort(table->values.begin(), table->values.end());
+
+  if (values.size() >= kMinValuesForBloomFilter) {
+    // 2 bytes per value. A value that is not in the list is probed in a single
+    // cache line of the Bloom filter, which is 1/8 of the size of the hash
+    // table.
+    table->bloomFilter = std::make_unique<BloomFilter<>>();
+    table->bloomFilter->reset(values.size());
+    for (auto value : values) {
+      table->bloomFilter->insert(folly::hasher<int64_t>()(value));
+    }
   }
-  std::sort(values_.begin(), values_.end());
+  table_ = std::move(table);
+}
+
+bool BigintValuesUsingHashTable::mayContain(int64_t value) const {
+  return !table_->bloomFilter ||
+      table_->bloomFilter->mayContain(folly::hasher<int64_t>()(value));
 }
 
 bool BigintValuesUsingHashTable::testInt64(int64_t value) const {
-  if (containsEmptyMarker_ && value == kEmptyMarker) {
+  if (table_->containsEmptyMarker && value == kEmptyMarker) {
     return true;
   }
-  if (value < min_ || value > max_) {
+  if (value < min_ || value > max_ || !mayContain(value)) {
     return false;
   }
-  uint32_t pos = (value * M) & sizeMask_;
-  for (auto i = pos; i <= pos + sizeMask_; i++) {
-    int32_t idx = i & sizeMask_;
-    int64_t l = hashTable_[idx];
+  const auto sizeMask = table_->sizeMask;
+  const auto* hashTable = table_->hashTable.data();
+  uint32_t pos = (value * M) & sizeMask;
+  for (auto i = pos; i <= pos + sizeMask; i++) {
+    int32_t idx = i & sizeMask;
+    int64_t l = hashTable[idx];
     if (l == kEmptyMarker) {
       return false;
     }
@@ -831,15 +930,35 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
   if (simd::toBitMask(outOfRange) == simd::allSetBitMask<int64_t>()) {
     return xsimd::batch_bool<int64_t>(false);
   }
-  if (containsEmptyMarker_) {
+  if (table_->containsEmptyMarker) {
     return Filter::testValues(x);
   }
+  const auto sizeMask = table_->sizeMask;
+  const auto* hashTable = table_->hashTable.data();
+  auto probe = ~outOfRange;
+  if (table_->bloomFilter) {
+    // The lanes that miss the Bloom filter do not load from the hash table.
+    constexpr int kAlign = xsimd::default_arch::alignment();
+    alignas(kAlign) int64_t valuesArray[xsimd::batch<int64_t>::size];
+    x.store_aligned(valuesArray);
+    uint16_t lanes = simd::toBitMask(probe);
+    uint16_t mayContainBits = 0;
+    while (lanes) {
+      auto lane = bits::getAndClearLastSetBit(lanes);
+      if (mayContain(valuesArray[lane])) {
+        mayContainBits |= 1 << lane;
+      }
+    }
+    if (!mayContainBits) {
+      return xsimd::batch_bool<int64_t>(false);
+    }
+    probe = simd::fromBitMask<int64_t>(mayContainBits);
+  }
   auto allEmpty = xsimd::broadcast<int64_t>(kEmptyMarker);
   // Temporarily casted to unsigned to suppress overflow error.
   auto indices = simd::reinterpretBatch<int64_t>(
-      simd::reinterpretBatch<uint64_t>(x) * M & sizeMask_);
-  auto data =
-      simd::maskGather(allEmpty, ~outOfRange, hashTable_.data(), indices);
+      simd::reinterpretBatch<uint64_t>(x) * M & sizeMask);
+  auto data = simd::maskGather(allEmpty, probe, hashTable, indices);
   // The lanes with kEmptyMarker missed, the lanes matching x hit and the other
   // lanes must check next positions.
 
@@ -865,7 +984,7 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
     int64_t value = valuesArray[lane];
     auto allValue = xsimd::broadcast<int64_t>(value);
     for (;;) {
-      auto line = xsimd::load_unaligned(hashTable_.data() + index);
+      auto line = xsimd::load_unaligned(hashTable + index);
 
       if (simd::toBitMask(line == allValue)) {
         resultBits |= 1 << lane;
@@ -876,7 +995,7 @@ xsimd::batch_bool<int64_t> BigintValuesUsingHashTable::testValues(
         break;
       }
       index += line.size;
-      if (index > sizeMask_) {
+      if (index > sizeMask) {
         index = 0;
       }
     }
@@ -910,8 +1029,9 @@ bool BigintValuesUsingHashTable::testInt64Range(
   if (min > max_ || max < min_) {
     return false;
   }
-  auto it = std::lower_bound(values_.begin(), values_.end(), min);
-  assert(it != values_.end()); // min is already tested to be <= max_.
+  const auto& values = table_->values;
+  auto it = std::lower_bound(values.begin(), values.end(), min);
+  assert(it != values.end()); // min is already tested to be <= max_.
   if (min == *it) {
     return true;
   }
@@ -1139,6 +1259,37 @@ bool BytesRange::testBytes(const char* value, int32_t length) const {
   return true;
 }
 
+void BytesRange::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  // StringView compares the sizes and prefixes first and only reads the rest
+  // of the strings when these are equal.
+  const StringView lower(lower_);
+  const StringView upper(upper_);
+  const bool emptyPasses = testBytes(nullptr, 0);
+  for (auto i = 0; i < numValues; ++i) {
+    const auto& value = values[i];
+    bool pass;
+    if (value.empty()) {
+      pass = emptyPasses;
+    } else if (singleValue_) {
+      pass = value == lower;
+    } else {
+      pass = true;
+      if (!lowerUnbounded_) {
+        const auto compare = value.compare(lower);
+        pass = compare > 0 || (!lowerExclusive_ && compare == 0);
+      }
+      if (pass && !upperUnbounded_) {
+        const auto compare = value.compare(upper);
+        pass = compare < 0 || (!upperExclusive_ && compare == 0);
+      }
+    }
+    bits::setBit(passed, i, pass);
+  }
+}
+
 bool BytesRange::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1179,6 +1330,51 @@ bool BytesRange::testBytesRange(
   return true;
 }
 
+// static
+void BytesValues::initializeHashTable(Table& table) {
+  for (auto length : table.lengths) {
+    if (length < 64) {
+      table.shortLengths |= 1ULL << length;
+    }
+  }
+  const auto tableSize =
+      bits::nextPowerOfTwo(std::max<uint64_t>(16, table.values.size() * 2));
+  table.hashTable.assign(tableSize, StringView());
+  table.hashTableMask = tableSize - 1;
+  if (table.values.size() >= kMinValuesForBloomFilter) {
+    table.bloomFilter = std::make_unique<BloomFilter<>>();
+    table.bloomFilter->reset(table.values.size());
+  }
+  for (const auto& value : table.values) {
+    if (value.empty()) {
+      continue;
+    }
+    StringView entry(value);
+    const auto hash = hashValue(entry);
+    if (table.bloomFilter) {
+      table.bloomFilter->insert(hash);
+    }
+    auto index = hash & table.hashTableMask;
+    while (!table.hashTable[index].empty()) {
+      index = (index + 1) & table.hashTableMask;
+    }
+    table.hashTable[index] = entry;
+  }
+}
+
+void BytesValues::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  for (auto i = 0; i < numValues; ++i) {
+    const auto& value = values[i];
+    bits::setBit(
+        passed,
+        i,
+        testLength(value.size()) && (value.empty() || contains(value)));
+  }
+}
+
 bool BytesValues::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1383,6 +1579,19 @@ bool MultiRange::testBytes(const char* value, int32_t length) const {
   return false;
 }
 
+void MultiRange::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  const auto numWords = bits::nwords(numValues);
+  std::vector<uint64_t> filterPassed(numWords);
+  bits::fillBits(passed, 0, numValues, false);
+  for (const auto& filter : filters_) {
+    filter->testStringViews(values, numValues, filterPassed.data());
+    bits::orBits(passed, filterPassed.data(), 0, numValues);
+  }
+}
+
 bool MultiRange::testLength(int32_t length) const {
   for (const auto& filter : filters_) {
     if (filter->testLength(length)) {
@@ -1735,6 +1944,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
@@ -1839,6 +2049,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     }
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kNegatedBigintValuesUsingHashTable:
     case FilterKind::kNegatedBigintValuesUsingBitmask: {
@@ -1894,12 +2105,13 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
       return mergeWith(min, max, other);
     }
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
 
       std::vector<int64_t> valuesToKeep;
-      if (containsEmptyMarker_ && other->testInt64(kEmptyMarker)) {
+      if (table_->containsEmptyMarker && other->testInt64(kEmptyMarker)) {
         valuesToKeep.emplace_back(kEmptyMarker);
       }
       for (const auto& range : otherMultiRange->ranges()) {
@@ -1907,7 +2119,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
         auto max = std::min(max_, range->upper());
 
         if (min <= max) {
-          for (int64_t v : values_) {
+          for (int64_t v : table_->values) {
             if (range->testInt64(v)) {
               valuesToKeep.emplace_back(v);
             }
@@ -1947,12 +2159,12 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
   }
 
   std::vector<int64_t> valuesToKeep;
-  valuesToKeep.reserve(values_.size());
-  if (containsEmptyMarker_ && other->testInt64(kEmptyMarker)) {
+  valuesToKeep.reserve(table_->values.size());
+  if (table_->containsEmptyMarker && other->testInt64(kEmptyMarker)) {
     valuesToKeep.emplace_back(kEmptyMarker);
   }
 
-  for (int64_t v : hashTable_) {
+  for (int64_t v : table_->hashTable) {
     if (v != kEmptyMarker && other->testInt64(v)) {
       valuesToKeep.emplace_back(v);
     }
@@ -1994,6 +2206,8 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
 
       return mergeWith(min, max, other);
     }
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      return other->mergeWith(this);
     case FilterKind::kBigintMultiRange: {
       auto otherMultiRange = dynamic_cast<const BigintMultiRange*>(other);
 
@@ -2036,6 +2250,62 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
   return createBigintValues(valuesToKeep, bothNullAllowed);
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this, false);
+    case FilterKind::kBigintRange: {
+      auto otherRange = static_cast<const BigintRange*>(other);
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto min = std::max(min_, otherRange->lower());
+      auto max = std::min(max_, otherRange->upper());
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      // Keeps the listed values that may pass 'this', so the result is exact.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto values = other->kind() == FilterKind::kBigintValuesUsingHashTable
+          ? static_cast<const BigintValuesUsingHashTable*>(other)->values()
+          : static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      std::vector<int64_t> valuesToKeep;
+      for (auto value : values) {
+        if (testInt64(value)) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(valuesToKeep, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // Two Bloom filters of different sizes can't be combined. Both may pass
+      // extra values, so keeping one with the common range is still valid.
+      auto otherBloomFilter =
+          static_cast<const BigintValuesUsingBloomFilter*>(other);
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto min = std::max(min_, otherBloomFilter->min_);
+      auto max = std::min(max_, otherBloomFilter->max_);
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, bothNullAllowed);
+    }
+    default:
+      // 'this' only narrows down the values passing 'other', so 'other' alone
+      // is a valid result.
+      return other->clone(nullAllowed_ && other->testNull());
+  }
+}
+
 std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     const Filter* other) const {
   // Rules of NegatedBigintValuesUsingHashTable with IsNull/IsNotNull
@@ -2056,6 +2326,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kBigintValuesUsingHashTable:
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
+    case FilterKind::kBigintValuesUsingBloomFilter:
     case FilterKind::kBigintMultiRange: {
       return other->mergeWith(this);
     }
@@ -2096,6 +2367,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kBigintValuesUsingBitmask:
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
+    case FilterKind::kBigintValuesUsingBloomFilter:
     case FilterKind::kBigintMultiRange: {
       return other->mergeWith(this);
     }
@@ -2136,6 +2408,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kBigintRange:
     case FilterKind::kNegatedBigintRange:
     case FilterKind::kBigintValuesUsingBitmask:
+    case FilterKind::kBigintValuesUsingBloomFilter:
     case FilterKind::kBigintValuesUsingHashTable: {
       return other->mergeWith(this);
     }
@@ -2329,7 +2602,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
       newValues.reserve(smallerFilter->values().size());
 
       for (const auto& value : smallerFilter->values()) {
-        if (largerFilter->values_.contains(value)) {
+        if (largerFilter->values().contains(value)) {
           newValues.emplace_back(value);
         }
       }
@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -55,6 +56,7 @@ enum class FilterKind {
   kBigintMultiRange,
   kMultiRange,
   kHugeintRange,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -190,6 +192,20 @@ class Filter : public velox::ISerializable {
     VELOX_UNSUPPORTED("{}: testBytes() is not supported.", toString());
   }
 
+  /// Tests 'numValues' non-null strings and sets the bits of 'passed' for
+  /// the ones that pass and clears the others. Filters on strings override
+  /// this to test a batch without a virtual call per value and to decide on
+  /// the size and prefix kept in the StringView where possible, without
+  /// reading the out of line part of the string.
+  virtual void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const {
+    for (auto i = 0; i < numValues; ++i) {
+      bits::setBit(passed, i, testBytes(values[i].data(), values[i].size()));
+    }
+  }
+
   // Returns true if it is useful to call testLength before other
   // tests. This should be true for string IN and equals because it is
   // possible to fail these based on the length alone. This would
@@ -861,7 +877,11 @@ class HugeintRange final : public Filter {
 };
 
 /// IN-list filter for integral data types. Implemented as a hash table. Good
-/// for large number of values that do not fit within a small range.
+/// for large number of values that do not fit within a small range. Lists of
+/// at least kMinValuesForBloomFilter values also get a Bloom filter that is
+/// checked before the hash table, so that most values that do not pass are
+/// decided without a cache miss on the table. The hash table and the Bloom
+/// filter are shared by the clones of the filter.
 class BigintValuesUsingHashTable final : public Filter {
  public:
   /// @param min Minimum value.
@@ -881,10 +901,7 @@ class BigintValuesUsingHashTable final : public Filter {
       : Filter(true, nullAllowed, other.kind()),
         min_(other.min_),
         max_(other.max_),
-        hashTable_(other.hashTable_),
-        containsEmptyMarker_(other.containsEmptyMarker_),
-        values_(other.values_),
-        sizeMask_(other.sizeMask_) {}
+        table_(other.table_) {}
 
   folly::dynamic serialize() const override;
 
@@ -919,13 +936,23 @@ class BigintValuesUsingHashTable final : public Filter {
   }
 
   const std::vector<int64_t>& values() const {
-    return values_;
+    return table_->values;
   }
 
   const std::vector<int64_t>& hashTable() const {
-    return hashTable_;
+    return table_->hashTable;
   }
 
+  /// Returns the Bloom filter over folly::hasher<int64_t> of the values or
+  /// nullptr if there are fewer than kMinValuesForBloomFilter values.
+  const BloomFilter<>* bloomFilter() const {
+    return table_->bloomFilter.get();
+  }
+
+  /// Minimum number of values for which the hash table is large enough to be
+  /// worth a Bloom filter in front of it.
+  static constexpr int32_t kMinValuesForBloomFilter = 10'000;
+
   std::string toString() const final {
     return fmt::format(
         "BigintValuesUsingHashTable: [{}, {}] {}",
@@ -940,16 +967,28 @@ class BigintValuesUsingHashTable final : public Filter {
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
 
+  // Returns true if the Bloom filter, if any, may contain 'value'.
+  bool mayContain(int64_t value) const;
+
   static constexpr int64_t kEmptyMarker = 0xdeadbeefbadefeedL;
   // from Murmur hash
   static constexpr uint64_t M = 0xc6a4a7935bd1e995L;
 
+  // The lookup structures. These do not change after construction.
+  struct Table {
+    std::vector<int64_t> hashTable;
+    bool containsEmptyMarker = false;
+    // The values in ascending order.
+    std::vector<int64_t> values;
+    int32_t sizeMask;
+    std::unique_ptr<BloomFilter<>> bloomFilter;
+  };
+
   const int64_t min_;
   const int64_t max_;
-  std::vector<int64_t> hashTable_;
-  bool containsEmptyMarker_ = false;
-  std::vector<int64_t> values_;
-  int32_t sizeMask_;
+  // Shared by the clones of 'this', e.g. the copies of a large IN list in the
+  // ScanSpecs of the drivers of a scan.
+  std::shared_ptr<const Table> table_;
 };
 
 /// IN-list filter for integral data types. Implemented as a bitmask. Offers
@@ -1008,6 +1047,90 @@ class BigintValuesUsingBitmask final : public Filter {
   const int64_t max_;
 };
 
+/// IN-list filter for integral data types with too many values to list.
+/// Implemented as a Bloom filter over the folly::hasher of the values and a
+/// [min, max] range. The filter may pass values not in the list, so it is
+/// only used where passing extra rows is allowed, e.g. for dynamic filters
+/// made from the build side of a hash join.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter over folly::hasher<int64_t> of the
+  /// values that pass the filter.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+        min_(other.min_),
+        max_(other.max_),
+        bloomFilter_(other.bloomFilter_) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          *this, nullAllowed.value());
+    } else {
+      return std::make_unique<BigintValuesUsingBloomFilter>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final;
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return Filter::testValues(x);
+  }
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return Filter::testValues(x);
+  }
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  const BloomFilter<>& bloomFilter() const {
+    return *bloomFilter_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  const int64_t min_;
+  const int64_t max_;
+  // Shared by the clones of 'this', e.g. the dynamic filters pushed into the
+  // scans of several drivers.
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+};
+
 // NOT IN-list filter for integral data types. Implemented as a hash table. Good
 // for large number of rejected values that do not fit within a small range.
 class NegatedBigintValuesUsingHashTable final : public Filter {
@@ -1545,6 +1668,11 @@ class BytesRange final : public AbstractRange {
 
   bool testBytes(const char* value, int32_t length) const final;
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1649,6 +1777,14 @@ class NegatedBytesRange final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final {
+    nonNegated_->testStringViews(values, numValues, passed);
+    bits::negate(reinterpret_cast<char*>(passed), numValues);
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1700,21 +1836,23 @@ class BytesValues final : public Filter {
       : Filter(true, nullAllowed, FilterKind::kBytesValues) {
     VELOX_CHECK(!values.empty(), "values must not be empty");
 
+    auto table = std::make_shared<Table>();
     for (const auto& value : values) {
-      lengths_.insert(value.size());
-      values_.insert(value);
+      table->lengths.insert(value.size());
+      table->values.insert(value);
     }
 
-    lower_ = *std::min_element(values_.begin(), values_.end());
-    upper_ = *std::max_element(values_.begin(), values_.end());
+    lower_ = *std::min_element(table->values.begin(), table->values.end());
+    upper_ = *std::max_element(table->values.begin(), table->values.end());
+    initializeHashTable(*table);
+    table_ = std::move(table);
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
       : Filter(true, nullAllowed, FilterKind::kBytesValues),
         lower_(other.lower_),
         upper_(other.upper_),
-        values_(other.values_),
-        lengths_(other.lengths_) {}
+        table_(other.table_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1730,14 +1868,24 @@ class BytesValues final : public Filter {
   }
 
   bool testLength(int32_t length) const final {
-    return lengths_.contains(length);
+    if (length < 64) {
+      return (table_->shortLengths >> length) & 1;
+    }
+    return table_->lengths.contains(length);
   }
 
   bool testBytes(const char* value, int32_t length) const final {
-    return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+    if (!testLength(length)) {
+      return false;
+    }
+    return length == 0 || contains(StringView(value, length));
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1746,16 +1894,74 @@ class BytesValues final : public Filter {
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
 
   const folly::F14FastSet<std::string>& values() const {
-    return values_;
+    return table_->values;
   }
 
+  /// Returns the Bloom filter over the hashes of the non-empty values or
+  /// nullptr if there are fewer than kMinValuesForBloomFilter values.
+  const BloomFilter<>* bloomFilter() const {
+    return table_->bloomFilter.get();
+  }
+
+  /// Minimum number of values for which the hash table is large enough to be
+  /// worth a Bloom filter in front of it.
+  static constexpr int32_t kMinValuesForBloomFilter = 10'000;
+
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // The lookup structures. These do not change after construction.
+  struct Table {
+    folly::F14FastSet<std::string> values;
+    folly::F14FastSet<uint32_t> lengths;
+
+    // Bit 'i' is set if there is a value of length 'i' < 64, so that most
+    // length checks don't need a hash lookup.
+    uint64_t shortLengths{0};
+
+    // Open addressing hash table of the non-empty values, probed without
+    // building a std::string for the tested value. The hash is seeded with
+    // the length so that values of different lengths fall into different
+    // slots. Empty entries mark free slots. The entries reference 'values'.
+    std::vector<StringView> hashTable;
+    uint64_t hashTableMask{0};
+
+    // Set if there are at least kMinValuesForBloomFilter values.
+    std::unique_ptr<BloomFilter<>> bloomFilter;
+  };
+
+  static void initializeHashTable(Table& table);
+
+  static uint64_t hashValue(StringView value) {
+    return bits::hashBytes(value.size(), value.data(), value.size());
+  }
+
+  // Returns true if non-empty 'value' of one of the lengths in the list is
+  // in the hash table.
+  bool contains(StringView value) const {
+    const auto hash = hashValue(value);
+    if (table_->bloomFilter && !table_->bloomFilter->mayContain(hash)) {
+      return false;
+    }
+    const auto& hashTable = table_->hashTable;
+    const auto mask = table_->hashTableMask;
+    for (auto index = hash & mask;; index = (index + 1) & mask) {
+      const auto& entry = hashTable[index];
+      if (entry.empty()) {
+        return false;
+      }
+      // Compares the size and the prefix before the rest of the bytes.
+      if (entry == value) {
+        return true;
+      }
+    }
+  }
+
   std::string lower_;
   std::string upper_;
-  folly::F14FastSet<std::string> values_;
-  folly::F14FastSet<uint32_t> lengths_;
+  // Shared by the clones of 'this', e.g. the copies of a large IN list in the
+  // ScanSpecs of the drivers of a scan.
+  std::shared_ptr<const Table> table_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -1842,6 +2048,14 @@ class NegatedBytesValues final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final {
+    nonNegated_->testStringViews(values, numValues, passed);
+    bits::negate(reinterpret_cast<char*>(passed), numValues);
+  }
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1897,6 +2111,11 @@ class MultiRange final : public Filter {
 
   bool testBytes(const char* value, int32_t length) const final;
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testLength(int32_t length) const final;
 
   bool testBytesRange(
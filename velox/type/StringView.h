@@ -24,6 +24,7 @@
 #include <folly/Format.h>
 #include <folly/Range.h>
 #include <folly/dynamic.h>
+#include <folly/hash/Hash.h>
 
 #include <fmt/format.h>
 
@@ -283,8 +284,17 @@ namespace folly {
 template <>
 struct hasher<::facebook::velox::StringView> {
   size_t operator()(const ::facebook::velox::StringView view) const {
+    if (view.isInline()) {
+      // The inline part is zeroed at construction, so the 2 words of the
+      // StringView identify the string. Mixing them is several times faster
+      // than hashing the bytes.
+      uint64_t words[2];
+      memcpy(words, &view, sizeof(words));
+      // The seed keeps the hash of the empty string from being 0.
+      constexpr uint64_t kSeed = 0x9e3779b97f4a7c15ULL;
+      return hash::hash_128_to_64(words[0], words[1] ^ kSeed);
+    }
     return hash::SpookyHashV2::Hash64(view.data(), view.size(), 0);
-    // return facebook::velox::bits::hashBytes(1, view.data(), view.size());
   }
 };
 
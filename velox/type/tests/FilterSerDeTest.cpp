@@ -17,6 +17,7 @@
 #include <limits>
 #include <memory>
 
+#include <folly/hash/Hash.h>
 #include <velox/type/Filter.h>
 #include "velox/expression/ExprToSubfieldFilter.h"
 
@@ -65,6 +66,26 @@ TEST_F(FilterSerDeTest, bigintFilters) {
   testSerde(HugeintRange(lower, upper, false));
 }
 
+TEST_F(FilterSerDeTest, largeValuesFilters) {
+  // The lists are large enough for the filters to have Bloom filters, which
+  // are rebuilt from the values on deserialization.
+  std::vector<int64_t> values;
+  std::vector<std::string> strValues;
+  for (auto i = 0; i < BigintValuesUsingHashTable::kMinValuesForBloomFilter;
+       ++i) {
+    values.push_back(i * 1209);
+    strValues.push_back(std::to_string(i * 1209));
+  }
+  for (auto nullAllowed : {false, true}) {
+    testSerde(BigintValuesUsingHashTable(
+        values.front(), values.back(), values, nullAllowed));
+    testSerde(NegatedBigintValuesUsingHashTable(
+        values.front(), values.back(), values, nullAllowed));
+    testSerde(BytesValues(strValues, nullAllowed));
+    testSerde(NegatedBytesValues(strValues, nullAllowed));
+  }
+}
+
 TEST_F(FilterSerDeTest, valuesFilters) {
   for (int r = 0; r < 7; ++r) {
     int64_t lower = 13;
@@ -87,6 +108,13 @@ TEST_F(FilterSerDeTest, valuesFilters) {
           NegatedBigintValuesUsingHashTable(lower, upper, values, nullAllowed));
       testSerde(
           NegatedBigintValuesUsingBitmask(lower, upper, values, nullAllowed));
+      auto bloomFilter = std::make_shared<BloomFilter<>>();
+      bloomFilter->reset(values.size());
+      for (auto value : values) {
+        bloomFilter->insert(folly::hasher<int64_t>()(value));
+      }
+      testSerde(BigintValuesUsingBloomFilter(
+          lower, upper, std::move(bloomFilter), nullAllowed));
       testSerde(BytesValues(strValues, nullAllowed));
       testSerde(NegatedBytesValues(strValues, nullAllowed));
     }
@@ -20,6 +20,8 @@
 #include <numeric>
 #include <optional>
 
+#include <folly/hash/Hash.h>
+
 #include <velox/type/DecimalUtil.h>
 #include "velox/expression/ExprToSubfieldFilter.h"
 #include "velox/type/Filter.h"
@@ -396,6 +398,43 @@ TEST(FilterTest, bigintValuesUsingHashTableSimd) {
   checkSimd(filter.get(), values, verify);
 }
 
+TEST(FilterTest, bigintValuesUsingHashTableWithBloomFilter) {
+  std::vector<int64_t> numbers;
+  folly::F14FastSet<int64_t> numberSet;
+  for (auto i = 0; i < 2 * BigintValuesUsingHashTable::kMinValuesForBloomFilter;
+       ++i) {
+    numbers.push_back(i * 1209);
+    numberSet.insert(i * 1209);
+  }
+  auto filter = createBigintValues(numbers, false);
+  auto* hashTableFilter =
+      dynamic_cast<BigintValuesUsingHashTable*>(filter.get());
+  ASSERT_TRUE(hashTableFilter);
+  ASSERT_TRUE(hashTableFilter->bloomFilter() != nullptr);
+
+  // The values in the list pass and the Bloom filter false positives are
+  // caught by the hash table.
+  auto verify = [&](int64_t x) { return numberSet.contains(x); };
+  for (auto i = -10; i < numbers.back() + 10; i += 7) {
+    ASSERT_EQ(filter->testInt64(i), verify(i)) << i;
+  }
+  applySimdTestToVector(numbers, *filter, verify);
+
+  // The clones share the lookup structures.
+  auto clone = filter->clone(true);
+  ASSERT_EQ(
+      static_cast<BigintValuesUsingHashTable*>(clone.get())->bloomFilter(),
+      hashTableFilter->bloomFilter());
+  ASSERT_TRUE(clone->testNull());
+  applySimdTestToVector(numbers, *clone, verify);
+
+  // A small list does not get a Bloom filter.
+  filter = createBigintValues({1, 1'000'000}, false);
+  ASSERT_TRUE(
+      static_cast<BigintValuesUsingHashTable*>(filter.get())->bloomFilter() ==
+      nullptr);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingHashTableSimd) {
   std::vector<int64_t> numbers;
   // make a worst case filter where every item falls on the same slot.
@@ -454,6 +493,56 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (auto i = 0; i < 1'000; ++i) {
+    bloomFilter->insert(folly::hasher<int64_t>()(i * 7));
+  }
+  auto filter = std::make_unique<BigintValuesUsingBloomFilter>(
+      0, 7 * 999, bloomFilter, false);
+
+  for (auto i = 0; i < 1'000; ++i) {
+    EXPECT_TRUE(filter->testInt64(i * 7));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    numFalsePositives += filter->testInt64(i * 7 + 1);
+  }
+  EXPECT_LT(numFalsePositives, 100);
+
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-7));
+  EXPECT_FALSE(filter->testInt64(7 * 1'000));
+
+  EXPECT_TRUE(filter->testInt64Range(5, 50, false));
+  EXPECT_TRUE(filter->testInt64Range(14, 14, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -5, false));
+  EXPECT_FALSE(filter->testInt64Range(7'000, 8'000, false));
+
+  // Merging with a range narrows down the range of the Bloom filter.
+  BigintRange range(100, 200, false);
+  auto merged = filter->mergeWith(&range);
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(105));
+  EXPECT_FALSE(merged->testInt64(98));
+  EXPECT_FALSE(merged->testInt64(203));
+  merged = range.mergeWith(filter.get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+
+  BigintRange outOfRange(10'000, 20'000, false);
+  EXPECT_EQ(filter->mergeWith(&outOfRange)->kind(), FilterKind::kAlwaysFalse);
+
+  // Merging with a list of values gives the exact values passing both.
+  auto values = createBigintValues({7, 8, 14, 15, 10'000}, false);
+  merged = values->mergeWith(filter.get());
+  for (auto value : {7, 14}) {
+    EXPECT_TRUE(merged->testInt64(value));
+  }
+  EXPECT_FALSE(merged->testInt64(10'000));
+  EXPECT_FALSE(merged->testInt64(9));
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -946,6 +1035,31 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bytesValuesWithBloomFilter) {
+  std::vector<std::string> values;
+  for (auto i = 0; i < 2 * BytesValues::kMinValuesForBloomFilter; ++i) {
+    values.push_back(fmt::format("value {}", i * 3));
+  }
+  auto filter = in(values);
+  ASSERT_TRUE(filter->bloomFilter() != nullptr);
+  for (auto i = 0; i < 6 * BytesValues::kMinValuesForBloomFilter; ++i) {
+    auto value = fmt::format("value {}", i);
+    ASSERT_EQ(filter->testBytes(value.data(), value.size()), i % 3 == 0)
+        << value;
+  }
+
+  // The clones share the lookup structures.
+  auto clone = filter->clone(true);
+  ASSERT_EQ(
+      static_cast<BytesValues*>(clone.get())->bloomFilter(),
+      filter->bloomFilter());
+  ASSERT_TRUE(clone->testBytes("value 0", 7));
+  ASSERT_FALSE(clone->testBytes("value 1", 7));
+  ASSERT_TRUE(clone->testNull());
+
+  ASSERT_TRUE(in({"a", "b"})->bloomFilter() == nullptr);
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
@@ -1048,6 +1162,74 @@ TEST(FilterTest, multiRange) {
   EXPECT_TRUE(filter->testBytes("abc", 3));
 }
 
+TEST(FilterTest, testStringViews) {
+  // Values of either side of the 4 byte prefix and the 12 byte inline size,
+  // sharing prefixes with the filter values and of length over 64.
+  std::vector<std::string> strings = {
+      "",
+      "a",
+      "abc",
+      "abcd",
+      "abcde",
+      "apple",
+      "banana",
+      "dragon",
+      "dragonfly",
+      "drought",
+      "integra.",
+      "renovitur",
+      "abcdefghijkl",
+      "abcdefghijklm",
+      "abcdefghijkln",
+      "abcdefghijklmnopqrstuvwxyz",
+      std::string(70, 'x'),
+      std::string(71, 'x'),
+  };
+  std::vector<StringView> values;
+  for (auto i = 0; i < 100; ++i) {
+    const auto& string = strings[(i * 7) % strings.size()];
+    values.emplace_back(string.data(), string.size());
+  }
+
+  auto assertSameAsTestBytes = [&](const Filter& filter) {
+    std::vector<uint64_t> passed(bits::nwords(values.size()), 0);
+    filter.testStringViews(values.data(), values.size(), passed.data());
+    for (auto i = 0; i < values.size(); ++i) {
+      EXPECT_EQ(
+          filter.testBytes(values[i].data(), values[i].size()),
+          bits::isBitSet(passed.data(), i))
+          << filter.toString() << " " << values[i];
+    }
+  };
+
+  assertSameAsTestBytes(*equal("abcdefghijklm"));
+  assertSameAsTestBytes(*equal("abc"));
+  assertSameAsTestBytes(*equal(""));
+  assertSameAsTestBytes(*between("abcd", "abcdefghijklm"));
+  assertSameAsTestBytes(*betweenExclusive("abcd", "abcdefghijklm"));
+  assertSameAsTestBytes(*lessThan("dragon"));
+  assertSameAsTestBytes(*greaterThanOrEqual("abcdefghijkl"));
+  assertSameAsTestBytes(*notBetween("abcde", "dragonfly"));
+
+  std::vector<std::string> inList = {
+      "",
+      "abc",
+      "abcdefghijklm",
+      "renovitur",
+      "integra.",
+      std::string(70, 'x')};
+  auto bytesValues = in(inList);
+  assertSameAsTestBytes(*bytesValues);
+  assertSameAsTestBytes(*bytesValues->clone());
+  assertSameAsTestBytes(*notIn(inList));
+  assertSameAsTestBytes(
+      *in(std::vector<std::string>{"abcdefghijkln", "zzz"}));
+
+  assertSameAsTestBytes(
+      *orFilter(between("abc", "abc"), greaterThanOrEqual("dragon")));
+  assertSameAsTestBytes(*orFilter(lessThan(""), greaterThan("")));
+}
+
 TEST(FilterTest, multiRangeWithNaNs) {
   // x <> 1.2 with nanAllowed true
   auto filter =
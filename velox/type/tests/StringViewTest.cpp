@@ -16,6 +16,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <sstream>
+#include <unordered_set>
 #include "velox/type/Type.h"
 
 using namespace facebook::velox;
@@ -80,6 +81,30 @@ TEST(StringView, container) {
   }
 }
 
+TEST(StringView, hash) {
+  folly::hasher<StringView> hasher;
+  // Equal strings from different buffers hash the same, inline or not.
+  for (auto length : {0, 1, 4, 5, 11, 12, 13, 40}) {
+    std::string first(length, 'x');
+    std::string second(length, 'x');
+    EXPECT_EQ(hasher(StringView(first)), hasher(StringView(second)));
+  }
+  EXPECT_NE(0, hasher(StringView("")));
+
+  // Inline strings that differ in size or in any byte hash differently.
+  std::unordered_set<uint64_t> hashes;
+  std::string value(12, 'a');
+  for (auto length = 0; length <= 12; ++length) {
+    hashes.insert(hasher(StringView(value.data(), length)));
+  }
+  for (auto i = 0; i < 12; ++i) {
+    value[i] = 'b';
+    hashes.insert(hasher(StringView(value)));
+    value[i] = 'a';
+  }
+  EXPECT_EQ(13 + 12, hashes.size());
+}
+
 TEST(StringView, selfComparison) {
   std::vector<std::string> texts{
       "USA", // Within prefix
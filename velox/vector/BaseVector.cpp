@@ -183,6 +183,82 @@ VectorPtr BaseVector::wrapInSequence(
       addSequence, kind, std::move(lengths), size, std::move(vector));
 }
 
+template <TypeKind kind>
+static VectorPtr encodeRunsImpl(
+    const VectorPtr& vector,
+    vector_size_t minAverageRunLength) {
+  using T = typename TypeTraits<kind>::NativeType;
+  if constexpr (std::is_same_v<T, bool>) {
+    return nullptr;
+  } else {
+    auto* flat = vector->asUnchecked<FlatVector<T>>();
+    const auto size = flat->size();
+    const auto* rawValues = flat->rawValues();
+    const auto* rawNulls = flat->rawNulls();
+    auto isRunStart = [&](vector_size_t row) {
+      if (row == 0) {
+        return true;
+      }
+      if (rawNulls) {
+        const bool isNull = bits::isBitNull(rawNulls, row);
+        if (isNull != bits::isBitNull(rawNulls, row - 1)) {
+          return true;
+        }
+        if (isNull) {
+          return false;
+        }
+      }
+      return !(rawValues[row] == rawValues[row - 1]);
+    };
+
+    // Stop counting as soon as the runs are too short on average.
+    const vector_size_t maxRuns = size / minAverageRunLength;
+    vector_size_t numRuns = 0;
+    for (vector_size_t row = 0; row < size; ++row) {
+      if (isRunStart(row) && ++numRuns > maxRuns) {
+        return nullptr;
+      }
+    }
+
+    auto* pool = vector->pool();
+    auto lengths = AlignedBuffer::allocate<vector_size_t>(numRuns, pool);
+    auto* rawLengths = lengths->asMutable<vector_size_t>();
+    auto values = std::static_pointer_cast<FlatVector<T>>(
+        BaseVector::create(vector->type(), numRuns, pool));
+    vector_size_t run = -1;
+    for (vector_size_t row = 0; row < size; ++row) {
+      if (isRunStart(row)) {
+        ++run;
+        rawLengths[run] = 0;
+        if (rawNulls && bits::isBitNull(rawNulls, row)) {
+          values->setNull(run, true);
+        } else {
+          values->mutableRawValues()[run] = rawValues[row];
+        }
+      }
+      ++rawLengths[run];
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      values->setStringBuffers(flat->stringBuffers());
+    }
+    return BaseVector::wrapInSequence(std::move(lengths), size, values);
+  }
+}
+
+// static
+VectorPtr BaseVector::encodeRuns(
+    const VectorPtr& vector,
+    vector_size_t minAverageRunLength) {
+  VELOX_CHECK_GT(minAverageRunLength, 0);
+  if (vector->encoding() != VectorEncoding::Simple::FLAT ||
+      !vector->type()->isPrimitiveType() ||
+      vector->typeKind() == TypeKind::UNKNOWN || vector->size() == 0) {
+    return nullptr;
+  }
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      encodeRunsImpl, vector->typeKind(), vector, minAverageRunLength);
+}
+
 template <TypeKind kind>
 static VectorPtr addConstant(
     vector_size_t size,
@@ -467,6 +467,15 @@ class BaseVector {
   static VectorPtr
   wrapInSequence(BufferPtr lengths, vector_size_t size, VectorPtr vector);
 
+  /// Returns a SequenceVector over the runs of equal consecutive values of the
+  /// flat scalar 'vector' if the runs are on average at least
+  /// 'minAverageRunLength' rows long. Returns nullptr otherwise, and for
+  /// boolean, complex or non-flat vectors. String values share the string
+  /// buffers of 'vector'.
+  static VectorPtr encodeRuns(
+      const VectorPtr& vector,
+      vector_size_t minAverageRunLength);
+
   // Creates a ConstantVector of specified length and value coming from the
   // 'index' element of the 'vector'. Peels off any encodings of the 'vector'
   // before making a new ConstantVector. The result vector is either a
@@ -312,6 +312,51 @@ void DecodedVector::fillInIndices() {
       "DecodedVector::indices_ must be set for non-constant non-consecutive mapping.");
 }
 
+void DecodedVector::gatherNulls(
+    const SelectivityVector& rows,
+    uint64_t* out) const {
+  const auto begin = rows.begin();
+  const auto end = rows.end();
+  if (!nulls_ || (isConstantMapping_ && !bits::isBitNull(nulls_, 0))) {
+    if (rows.isAllSelected()) {
+      bits::fillBits(out, begin, end, bits::kNotNull);
+    } else {
+      rows.applyToSelected(
+          [&](vector_size_t row) { bits::clearNull(out, row); });
+    }
+    return;
+  }
+  if (isConstantMapping_) {
+    rows.applyToSelected([&](vector_size_t row) { bits::setNull(out, row); });
+    return;
+  }
+  if (isIdentityMapping_ || hasExtraNulls_) {
+    // The nulls are by top-level row.
+    if (rows.isAllSelected()) {
+      bits::copyBits(nulls_, begin, out, begin, end - begin);
+    } else {
+      rows.applyToSelected([&](vector_size_t row) {
+        bits::setNull(out, row, bits::isBitNull(nulls_, row));
+      });
+    }
+    return;
+  }
+  // The nulls are by base row. All indices are set if there are no extra
+  // nulls.
+  vector_size_t row = begin;
+  if (rows.isAllSelected()) {
+    auto* outBytes = reinterpret_cast<uint8_t*>(out);
+    for (; row + 8 <= end; row += 8) {
+      outBytes[row / 8] = simd::gather8Bits(nulls_, indices_ + row, 8);
+    }
+  }
+  for (; row < end; ++row) {
+    if (rows.isValid(row)) {
+      bits::setNull(out, row, bits::isBitNull(nulls_, indices_[row]));
+    }
+  }
+}
+
 void DecodedVector::makeIndicesMutable() {
   if (indicesNotCopied()) {
     copiedIndices_.resize(size_ > 0 ? size_ : 1);
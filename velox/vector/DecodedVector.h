@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/type/HugeInt.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/SelectivityVector.h"
@@ -181,6 +182,20 @@ class DecodedVector {
     return reinterpret_cast<const T*>(data_)[index(idx)];
   }
 
+  /// Copies the values of the top-level 'rows' to 'out', so that out[i] ==
+  /// valueAt<T>(i) for each of 'rows'. 'out' must have space for rows.end()
+  /// values. The values at null or unselected positions are undefined. Lets a
+  /// caller loop over a flat array instead of calling valueAt() per row. A
+  /// dictionary over 4 or 8 byte types is gathered with SIMD if all rows are
+  /// selected.
+  template <typename T>
+  void gather(const SelectivityVector& rows, T* out) const;
+
+  /// Copies the null flags of the top-level 'rows' to 'out' as a bit per row
+  /// that is set for non-null rows, like BaseVector::nulls(). The bits of the
+  /// other rows are not changed. 'out' must have space for rows.end() bits.
+  void gatherNulls(const SelectivityVector& rows, uint64_t* out) const;
+
   /// If false, there are no nulls. Otherwise, there is a possibility that there
   /// are some nulls, but no certainty.
   bool mayHaveNulls() const {
@@ -449,4 +464,50 @@ inline int128_t DecodedVector::valueAt(vector_size_t idx) const {
   return HugeInt::deserialize(valuePosition);
 }
 
+template <typename T>
+void DecodedVector::gather(const SelectivityVector& rows, T* out) const {
+  static_assert(!std::is_same_v<T, bool>, "Booleans are stored as bits");
+  const auto begin = rows.begin();
+  const auto end = rows.end();
+  if (begin >= end) {
+    return;
+  }
+  if (isConstantMapping_) {
+    std::fill(out + begin, out + end, valueAt<T>(begin));
+    return;
+  }
+  if (isIdentityMapping_) {
+    memcpy(out + begin, data<T>() + begin, (end - begin) * sizeof(T));
+    return;
+  }
+  if constexpr (sizeof(T) == 4 || sizeof(T) == 8) {
+    // The indices of unselected rows and of nulls added by wrappers may not
+    // be set.
+    if (!isIdentityMapping_ && !hasExtraNulls_ && rows.isAllSelected()) {
+      using TInt = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+      constexpr int32_t kBatchSize = xsimd::batch<TInt>::size;
+      const auto* base = reinterpret_cast<const TInt*>(data_);
+      auto* rawOut = reinterpret_cast<TInt*>(out);
+      vector_size_t row = begin;
+      for (; row + kBatchSize <= end; row += kBatchSize) {
+        simd::gather<TInt, int32_t>(base, indices_ + row)
+            .store_unaligned(rawOut + row);
+      }
+      for (; row < end; ++row) {
+        rawOut[row] = base[indices_[row]];
+      }
+      return;
+    }
+  }
+  if (hasExtraNulls_) {
+    rows.applyToSelected([&](vector_size_t row) {
+      if (!bits::isBitNull(nulls_, row)) {
+        out[row] = valueAt<T>(row);
+      }
+    });
+    return;
+  }
+  rows.applyToSelected([&](vector_size_t row) { out[row] = valueAt<T>(row); });
+}
+
 } // namespace facebook::velox
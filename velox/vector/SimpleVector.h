@@ -261,13 +261,17 @@ class SimpleVector : public BaseVector {
     }
     ensureIsAsciiCapacity(rows.end());
     bool isAllAscii = true;
-    rows.template applyToSelected([&](auto row) {
-      if (!isNullAt(row)) {
-        auto string = valueAt(row);
-        isAllAscii &=
-            functions::stringCore::isAscii(string.data(), string.size());
-      }
-    });
+    if (isFlatEncoding() && values()) {
+      isAllAscii = isAllAsciiFlat(rows);
+    } else {
+      rows.template applyToSelected([&](auto row) {
+        if (!isNullAt(row)) {
+          auto string = valueAt(row);
+          isAllAscii &=
+              functions::stringCore::isAscii(string.data(), string.size());
+        }
+      });
+    }
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
     if (!asciiInfo.asciiSetRows().hasSelections()) {
@@ -313,6 +317,38 @@ class SimpleVector : public BaseVector {
   }
 
  protected:
+  /// Returns true if the strings of a flat vector in 'rows' are ASCII. Reads
+  /// the StringViews directly instead of through valueAt(). The 12 bytes of
+  /// inline strings are zero padded and OR'ed together across rows, so that
+  /// they need a single check at the end. Out of line strings are checked
+  /// with SIMD.
+  template <typename U = T>
+  typename std::enable_if_t<std::is_same_v<U, StringView>, bool>
+  isAllAsciiFlat(const SelectivityVector& rows) const {
+    constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+    const auto* strings = values()->template as<StringView>();
+    const auto* nulls = rawNulls();
+    uint64_t inlineBytes = 0;
+    bool isAllAscii = true;
+    rows.template applyToSelected([&](auto row) {
+      if (nulls && bits::isBitNull(nulls, row)) {
+        return;
+      }
+      const auto& string = strings[row];
+      if (string.isInline()) {
+        uint32_t prefix;
+        uint64_t inlined;
+        memcpy(&prefix, string.data(), sizeof(prefix));
+        memcpy(&inlined, string.data() + sizeof(prefix), sizeof(inlined));
+        inlineBytes |= prefix | inlined;
+      } else if (isAllAscii) {
+        isAllAscii =
+            functions::stringCore::isAscii(string.data(), string.size());
+      }
+    });
+    return isAllAscii && (inlineBytes & kHighBits) == 0;
+  }
+
   template <typename U = T>
   typename std::enable_if_t<std::is_same_v<U, StringView>, void>
   ensureIsAsciiCapacity(vector_size_t size) {
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,13 +48,62 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+bool isComplexType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Resizes 'vector' and the children of rows to 'size'. Elements of arrays and
+/// maps are left empty, as in a vector from BaseVector::create.
+void resizeRecycled(BaseVector& vector, vector_size_t size) {
+  if (vector.size() != size) {
+    vector.resize(size);
+  }
+  if (vector.typeKind() == TypeKind::ROW) {
+    for (auto& child : vector.asUnchecked<RowVector>()->children()) {
+      if (child) {
+        resizeRecycled(*child, size);
+      }
+    }
+  }
+}
 } // namespace
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool add) {
+  for (auto& [cachedType, typePool] : complexVectors_) {
+    if (*cachedType == *type) {
+      return &typePool;
+    }
+  }
+  if (!add || complexVectors_.size() >= kNumComplexTypes) {
+    return nullptr;
+  }
+  complexVectors_.emplace_back(type, TypePool{});
+  return &complexVectors_.back().second;
+}
+
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0) {
+      return vectors_[cacheIndex].pop(type, size, *pool_, stats_);
+    }
+    if (isComplexType(type)) {
+      if (auto* typePool = complexTypePool(type, false)) {
+        return typePool->pop(type, size, *pool_, stats_);
+      }
+    }
   }
+  ++stats_.numAllocated;
   return BaseVector::create(type, size, pool_);
 }
 
@@ -66,10 +116,22 @@ bool VectorPool::release(VectorPtr& vector) {
   }
 
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
-    return false;
+  if (cacheIndex >= 0) {
+    return vectors_[cacheIndex].maybePushBack(vector);
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  if (isComplexType(vector->type())) {
+    if (auto* typePool = complexTypePool(vector->type(), true)) {
+      return typePool->maybePushBack(vector);
+    }
+  }
+  return false;
+}
+
+void VectorPool::clear() {
+  for (auto& typePool : vectors_) {
+    typePool = TypePool{};
+  }
+  complexVectors_.clear();
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,8 +148,11 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // an array, map or row vector whose buffers and children are all unique and
+  // mutable.
+  if (!vector->isWritable() ||
+      (vector->isFlatEncoding() && !vector->values())) {
     return false;
   }
   if (size >= kNumPerType) {
@@ -102,8 +167,10 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
 VectorPtr VectorPool::TypePool::pop(
     const TypePtr& type,
     vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
+    memory::MemoryPool& pool,
+    Stats& stats) {
   if (size) {
+    ++stats.numRecycled;
     auto result = std::move(vectors[--size]);
     if (UNLIKELY(result->rawNulls() != nullptr)) {
       // This is a recyclable vector, no need to check uniqueness.
@@ -120,11 +187,10 @@ VectorPtr VectorPool::TypePool::pop(
           0,
           std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
     }
-    if (result->size() != vectorSize) {
-      result->resize(vectorSize);
-    }
+    resizeRecycled(*result, vectorSize);
     return result;
   }
+  ++stats.numAllocated;
   return BaseVector::create(type, vectorSize, &pool);
 }
 } // namespace facebook::velox
@@ -23,12 +23,21 @@ namespace facebook::velox {
 /// A thread-level cache of pre-allocated flat vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
 /// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// Singleton built-in types and up to 8 distinct array, map and row types are
+/// supported. A recycled complex vector keeps its offsets, sizes and nulls
+/// buffers and its children, and a recycled string vector keeps one string
+/// buffer. Decimal types, fixed-size array type and custom types are not
+/// supported. Calling 'get' for an unsupported type already returns a newly
+/// allocated vector. Calling 'release' for an unsupported type is a no-op.
 class VectorPool {
  public:
+  struct Stats {
+    /// Number of vectors 'get' allocated.
+    uint64_t numAllocated{0};
+    /// Number of vectors 'get' took from the cache.
+    uint64_t numRecycled{0};
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
@@ -42,12 +51,26 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  /// Frees the cached vectors, e.g. when the owner is done or under memory
+  /// pressure.
+  void clear();
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+  void resetStats() {
+    stats_ = Stats{};
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
 
+  static constexpr int32_t kNumComplexTypes = 8;
+
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
@@ -57,9 +80,14 @@ class VectorPool {
     VectorPtr pop(
         const TypePtr& type,
         vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+        memory::MemoryPool& pool,
+        Stats& stats);
   };
 
+  /// Returns the cache for the complex 'type'. Makes one if there are fewer
+  /// than kNumComplexTypes and 'add' is true, otherwise returns nullptr.
+  TypePool* complexTypePool(const TypePtr& type, bool add);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +95,11 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated vectors of complex types with their types.
+  std::vector<std::pair<TypePtr, TypePool>> complexVectors_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
@@ -21,24 +21,34 @@
 #include "velox/common/base/CheckedArithmetic.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/ConstantVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/arrow/Abi.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace facebook::velox {
 
 namespace {
 
 // The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// and one for offsets (2). String views use more, see resizeBuffers().
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers, nullptr), bufferPtrs_(kMaxBuffers) {}
+
+  // Makes room for 'numBuffers' buffers. The pointer returned by
+  // getArrowBuffers() changes.
+  void resizeBuffers(size_t numBuffers) {
+    if (numBuffers > buffers_.size()) {
+      buffers_.resize(numBuffers, nullptr);
+      bufferPtrs_.resize(numBuffers);
     }
   }
 
@@ -56,7 +66,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -87,11 +97,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -209,6 +219,7 @@ static void releaseArrowSchema(ArrowSchema* arrowSchema) {
 // Returns the Arrow C data interface format type for a given Velox type.
 const char* exportArrowFormatStr(
     const TypePtr& type,
+    const ArrowOptions& options,
     std::string& formatBuffer) {
   if (type->isDecimal()) {
     // Decimal types encode the precision, scale values.
@@ -235,9 +246,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
 
     case TypeKind::TIMESTAMP:
       // TODO: need to figure out how we'll map this since in Velox we currently
@@ -437,11 +448,122 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Arrow string views have the layout of StringView, except that a string that
+// is not inlined is addressed by a buffer index and an offset instead of a
+// pointer. The views are rewritten, the string buffers are shared.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[StringView::kPrefixSize];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  // Indices of 'stringBuffers' in ascending order of address.
+  std::vector<int32_t> sortedBuffers(stringBuffers.size());
+  std::iota(sortedBuffers.begin(), sortedBuffers.end(), 0);
+  std::sort(sortedBuffers.begin(), sortedBuffers.end(), [&](auto l, auto r) {
+    return stringBuffers[l]->as<char>() < stringBuffers[r]->as<char>();
+  });
+  // Returns the index of the string buffer that contains 'sv' or -1.
+  auto findBuffer = [&](StringView sv) -> int32_t {
+    auto it = std::upper_bound(
+        sortedBuffers.begin(),
+        sortedBuffers.end(),
+        sv.data(),
+        [&](const char* data, auto index) {
+          return data < stringBuffers[index]->as<char>();
+        });
+    if (it == sortedBuffers.begin()) {
+      return -1;
+    }
+    const auto& buffer = stringBuffers[*(it - 1)];
+    return sv.data() + sv.size() <= buffer->as<char>() + buffer->size()
+        ? *(it - 1)
+        : -1;
+  };
+
+  // Strings not in 'stringBuffers' are copied to one more buffer.
+  size_t copiedSize = 0;
+  rows.apply([&](vector_size_t i) {
+    if (!vec.isNullAt(i)) {
+      auto sv = vec.valueAtFast(i);
+      if (!sv.isInline() && findBuffer(sv) < 0) {
+        copiedSize += sv.size();
+      }
+    }
+  });
+  const int32_t numDataBuffers = stringBuffers.size() + (copiedSize > 0);
+  out.n_buffers = 3 + numDataBuffers;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+  }
+  char* rawCopied = nullptr;
+  if (copiedSize > 0) {
+    holder.setBuffer(
+        numDataBuffers + 1, AlignedBuffer::allocate<char>(copiedSize, pool));
+    rawCopied = holder.getBufferAs<char>(numDataBuffers + 1);
+  }
+  auto sizes = AlignedBuffer::allocate<int64_t>(numDataBuffers, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    rawSizes[i] = stringBuffers[i]->size();
+  }
+  if (copiedSize > 0) {
+    rawSizes[numDataBuffers - 1] = copiedSize;
+  }
+  holder.setBuffer(2 + numDataBuffers, sizes);
+
+  auto views = AlignedBuffer::allocate<StringView>(out.length, pool);
+  auto* rawViews = views->asMutable<ArrowStringView>();
+  size_t copiedOffset = 0;
+  vector_size_t j = 0; // index into rawViews
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j++];
+    if (vec.isNullAt(i)) {
+      memset(&view, 0, sizeof(view));
+      return;
+    }
+    auto sv = vec.valueAtFast(i);
+    if (sv.isInline()) {
+      // Inlined strings are padded with zeros in both layouts.
+      memcpy(&view, &sv, sizeof(view));
+      return;
+    }
+    view.size = sv.size();
+    memcpy(view.prefix, sv.data(), sizeof(view.prefix));
+    auto index = findBuffer(sv);
+    if (index >= 0) {
+      auto offset = sv.data() - stringBuffers[index]->as<char>();
+      VELOX_CHECK_LE(offset, std::numeric_limits<int32_t>::max());
+      view.bufferIndex = index;
+      view.offset = offset;
+    } else {
+      memcpy(rawCopied + copiedOffset, sv.data(), sv.size());
+      view.bufferIndex = numDataBuffers - 1;
+      view.offset = copiedOffset;
+      copiedOffset += sv.size();
+    }
+  });
+  holder.setBuffer(1, views);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_children = 0;
   out.children = nullptr;
@@ -462,8 +584,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -476,13 +611,15 @@ void exportBase(
     const BaseVector&,
     const Selection&,
     ArrowArray&,
-    memory::MemoryPool*);
+    memory::MemoryPool*,
+    const ArrowOptions&);
 
 void exportRows(
     const RowVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_buffers = 1;
   holder.resizeChildren(vec.childrenSize());
@@ -494,7 +631,8 @@ void exportRows(
           *vec.childAt(i)->loadedVector(),
           rows,
           *holder.allocateChild(i),
-          pool);
+          pool,
+          options);
     } catch (const VeloxException&) {
       for (column_index_t j = 0; j < i; ++j) {
         // When exception is thrown, i th child is guaranteed unset.
@@ -555,6 +693,7 @@ void exportArrays(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   Selection childRows(vec.elements()->size());
   exportOffsets(vec, rows, out, pool, holder, childRows);
@@ -563,7 +702,8 @@ void exportArrays(
       *vec.elements()->loadedVector(),
       childRows,
       *holder.allocateChild(0),
-      pool);
+      pool,
+      options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -573,6 +713,7 @@ void exportMaps(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   RowVector child(
       pool,
@@ -583,7 +724,7 @@ void exportMaps(
   Selection childRows(child.size());
   exportOffsets(vec, rows, out, pool, holder, childRows);
   holder.resizeChildren(1);
-  exportBase(child, childRows, *holder.allocateChild(0), pool);
+  exportBase(child, childRows, *holder.allocateChild(0), pool, options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -593,6 +734,7 @@ void exportDictionary(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_buffers = 2;
   out.n_children = 0;
@@ -605,14 +747,80 @@ void exportDictionary(
   }
   auto& values = *vec.valueVector()->loadedVector();
   out.dictionary = holder.allocateDictionary();
-  exportBase(values, Selection(values.size()), *out.dictionary, pool);
+  exportBase(values, Selection(values.size()), *out.dictionary, pool, options);
+}
+
+// Exports a constant as a run-end encoded array with one run. The values child
+// is the constant's value vector, or a copy of the value for scalars.
+void exportConstant(
+    const BaseVector& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    const ArrowOptions& options,
+    VeloxToArrowBridgeHolder& holder) {
+  // Run-end encoded arrays have no buffers, not even for nulls.
+  out.n_buffers = 0;
+  out.null_count = 0;
+  const int32_t numRuns = out.length > 0 ? 1 : 0;
+  holder.resizeChildren(2);
+  out.n_children = 2;
+  out.children = holder.getChildrenArrays();
+
+  auto runEnds = AlignedBuffer::allocate<int32_t>(numRuns, pool);
+  if (numRuns > 0) {
+    VELOX_CHECK_LE(out.length, std::numeric_limits<int32_t>::max());
+    runEnds->asMutable<int32_t>()[0] = out.length;
+  }
+  FlatVector<int32_t> runEndsVector(
+      pool,
+      INTEGER(),
+      nullptr,
+      numRuns,
+      std::move(runEnds),
+      std::vector<BufferPtr>());
+  exportBase(
+      runEndsVector,
+      Selection(numRuns),
+      *holder.allocateChild(0),
+      pool,
+      options);
+
+  try {
+    if (!vec.type()->isPrimitiveType() && !vec.isNullAt(0)) {
+      const auto& constant = *vec.asUnchecked<ConstantVector<ComplexType>>();
+      const auto& valueVector = constant.valueVector();
+      Selection valueRows(valueVector->size());
+      valueRows.clearAll();
+      if (numRuns > 0) {
+        valueRows.addRange(constant.index(), 1);
+      }
+      exportBase(
+          *valueVector->loadedVector(),
+          valueRows,
+          *holder.allocateChild(1),
+          pool,
+          options);
+    } else {
+      auto value = BaseVector::create(vec.type(), numRuns, pool);
+      if (numRuns > 0) {
+        value->copy(&vec, 0, 0, 1);
+      }
+      exportBase(
+          *value, Selection(numRuns), *holder.allocateChild(1), pool, options);
+    }
+  } catch (const VeloxException&) {
+    out.children[0]->release(out.children[0]);
+    throw;
+  }
 }
 
 void exportBase(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
   auto holder = std::make_unique<VeloxToArrowBridgeHolder>();
   out.buffers = holder->getArrowBuffers();
   out.length = rows.count();
@@ -621,19 +829,25 @@ void exportBase(
   exportNulls(vec, rows, out, pool, *holder);
   switch (vec.encoding()) {
     case VectorEncoding::Simple::FLAT:
-      exportFlat(vec, rows, out, pool, *holder);
+      exportFlat(vec, rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::ROW:
-      exportRows(*vec.asUnchecked<RowVector>(), rows, out, pool, *holder);
+      exportRows(
+          *vec.asUnchecked<RowVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::ARRAY:
-      exportArrays(*vec.asUnchecked<ArrayVector>(), rows, out, pool, *holder);
+      exportArrays(
+          *vec.asUnchecked<ArrayVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::MAP:
-      exportMaps(*vec.asUnchecked<MapVector>(), rows, out, pool, *holder);
+      exportMaps(
+          *vec.asUnchecked<MapVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::DICTIONARY:
-      exportDictionary(vec, rows, out, pool, *holder);
+      exportDictionary(vec, rows, out, pool, options, *holder);
+      break;
+    case VectorEncoding::Simple::CONSTANT:
+      exportConstant(vec, rows, out, pool, options, *holder);
       break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
@@ -647,11 +861,15 @@ void exportBase(
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool) {
-  exportBase(*vector, Selection(vector->size()), arrowArray, pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  exportBase(*vector, Selection(vector->size()), arrowArray, pool, options);
 }
 
-void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
+void exportToArrow(
+    const VectorPtr& vec,
+    ArrowSchema& arrowSchema,
+    const ArrowOptions& options) {
   auto& type = vec->type();
 
   arrowSchema.name = nullptr;
@@ -671,10 +889,40 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
     arrowSchema.format = "i";
     bridgeHolder->dictionary = std::make_unique<ArrowSchema>();
     arrowSchema.dictionary = bridgeHolder->dictionary.get();
-    exportToArrow(vec->valueVector(), *arrowSchema.dictionary);
+    exportToArrow(vec->valueVector(), *arrowSchema.dictionary, options);
+
+  } else if (vec->encoding() == VectorEncoding::Simple::CONSTANT) {
+    arrowSchema.format = "+r";
+    arrowSchema.dictionary = nullptr;
+    bridgeHolder->childrenRaw.resize(2);
+    bridgeHolder->childrenOwned.resize(2);
+    arrowSchema.children = bridgeHolder->childrenRaw.data();
+    arrowSchema.n_children = 2;
+    auto runEnds = std::make_unique<ArrowSchema>();
+    exportToArrow(
+        BaseVector::create(INTEGER(), 0, vec->pool()), *runEnds, options);
+    runEnds->name = "run_ends";
+    // Run ends are never null.
+    runEnds->flags = 0;
+    arrowSchema.children[0] = runEnds.get();
+    bridgeHolder->childrenOwned[0] = std::move(runEnds);
+    try {
+      auto values = std::make_unique<ArrowSchema>();
+      auto valueVector = !type->isPrimitiveType() && !vec->isNullAt(0)
+          ? vec->valueVector()
+          : BaseVector::create(type, 0, vec->pool());
+      exportToArrow(valueVector, *values, options);
+      values->name = "values";
+      arrowSchema.children[1] = values.get();
+      bridgeHolder->childrenOwned[1] = std::move(values);
+    } catch (const VeloxException&) {
+      arrowSchema.children[0]->release(arrowSchema.children[0]);
+      throw;
+    }
 
   } else {
-    arrowSchema.format = exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+    arrowSchema.format =
+        exportArrowFormatStr(type, options, bridgeHolder->formatBuffer);
     arrowSchema.dictionary = nullptr;
 
     if (type->kind() == TypeKind::MAP) {
@@ -689,14 +937,14 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
           0,
           std::vector<VectorPtr>{maps.mapKeys(), maps.mapValues()},
           maps.getNullCount());
-      exportToArrow(rows, *child);
+      exportToArrow(rows, *child, options);
       child->name = "entries";
       setUniqueChild(std::move(child), *bridgeHolder, arrowSchema);
 
     } else if (type->kind() == TypeKind::ARRAY) {
       auto child = std::make_unique<ArrowSchema>();
       auto& arrays = *vec->asUnchecked<ArrayVector>();
-      exportToArrow(arrays.elements(), *child);
+      exportToArrow(arrays.elements(), *child, options);
       // Name is required, and "item" is the default name used in arrow itself.
       child->name = "item";
       setUniqueChild(std::move(child), *bridgeHolder, arrowSchema);
@@ -729,7 +977,7 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
         try {
           auto& currentSchema = bridgeHolder->childrenOwned[i];
           currentSchema = std::make_unique<ArrowSchema>();
-          exportToArrow(rows.childAt(i), *currentSchema);
+          exportToArrow(rows.childAt(i), *currentSchema, options);
           currentSchema->name = bridgeHolder->rowType->nameOf(i).data();
           arrowSchema.children[i] = currentSchema.get();
         } catch (const VeloxException& e) {
@@ -789,6 +1037,16 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
     case 'Z':
       return VARBINARY();
 
+    // String views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       // Mapping it to ttn for now.
       if (format[1] == 't' && format[2] == 'n') {
@@ -837,6 +1095,12 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
               importFromArrow(*child.children[1]));
         }
 
+        // Run-end encoded. The type is the type of the values.
+        case 'r':
+          VELOX_CHECK_EQ(arrowSchema.n_children, 2);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[1]);
+          return importFromArrow(*arrowSchema.children[1]);
+
         // Struct/rows.
         case 's': {
           // Loop collecting the child types and names.
@@ -979,6 +1243,60 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* sizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringViewBuffers;
+  stringViewBuffers.reserve(numDataBuffers);
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    stringViewBuffers.emplace_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], sizes[i]));
+  }
+
+  // The views that are not inlined point to their buffer by index and offset
+  // in Arrow and by address in Velox.
+  const auto* views = static_cast<const StringView*>(arrowArray.buffers[1]);
+  BufferPtr stringViews =
+      AlignedBuffer::allocate<StringView>(arrowArray.length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  memcpy(rawStringViews, views, arrowArray.length * sizeof(StringView));
+  for (auto i = 0; i < arrowArray.length; ++i) {
+    if (!rawStringViews[i].isInline()) {
+      int32_t location[2];
+      memcpy(
+          location,
+          reinterpret_cast<const char*>(&views[i]) + 2 * sizeof(int32_t),
+          sizeof(location));
+      VELOX_USER_CHECK_LT(location[0], numDataBuffers);
+      rawStringViews[i] = StringView(
+          static_cast<const char*>(arrowArray.buffers[2 + location[0]]) +
+              location[1],
+          rawStringViews[i].size());
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      arrowArray.length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1167,6 +1485,44 @@ VectorPtr createDictionaryVector(
       std::move(wrapped));
 }
 
+// Imports a run-end encoded array as a constant if it has a single run and as
+// a dictionary over the values otherwise.
+VectorPtr createRunEndEncodedVector(
+    memory::MemoryPool* pool,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_CHECK_EQ(arrowArray.n_children, 2);
+  VELOX_USER_CHECK_EQ(
+      strcmp(arrowSchema.children[0]->format, "i"),
+      0,
+      "Only int32 run ends are supported for arrow conversion");
+  auto runEnds = importFromArrowImpl(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  auto values = importFromArrowImpl(
+      *arrowSchema.children[1], *arrowArray.children[1], pool, isViewer);
+  const auto* rawRunEnds =
+      runEnds->asUnchecked<FlatVector<int32_t>>()->rawValues();
+  const auto numRuns = runEnds->size();
+  VELOX_CHECK_LE(numRuns, values->size());
+  if (numRuns == 1) {
+    VELOX_CHECK_EQ(rawRunEnds[0], arrowArray.length);
+    return BaseVector::wrapInConstant(arrowArray.length, 0, std::move(values));
+  }
+  auto indices = allocateIndices(arrowArray.length, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns; ++run) {
+    VELOX_CHECK_LE(rawRunEnds[run], arrowArray.length);
+    for (; row < rawRunEnds[run]; ++row) {
+      rawIndices[row] = run;
+    }
+  }
+  VELOX_CHECK_EQ(row, arrowArray.length);
+  return BaseVector::wrapInDictionary(
+      nullptr, std::move(indices), arrowArray.length, std::move(values));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1185,6 +1541,11 @@ VectorPtr importFromArrowImpl(
   // First parse and generate a Velox type.
   auto type = importFromArrow(arrowSchema);
 
+  // Run-end encoded arrays have no buffers of their own.
+  if (strcmp(arrowSchema.format, "+r") == 0) {
+    return createRunEndEncodedVector(pool, arrowSchema, arrowArray, isViewer);
+  }
+
   // Wrap the nulls buffer into a Velox BufferView (zero-copy). Null buffer size
   // needs to be at least one bit per element.
   BufferPtr nulls = nullptr;
@@ -1208,6 +1569,10 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
+  if (arrowSchema.format[0] == 'v') {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
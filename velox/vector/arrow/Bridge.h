@@ -27,6 +27,16 @@ struct ArrowSchema;
 
 namespace facebook::velox {
 
+/// Options for exporting Velox vectors to Arrow. The same options must be
+/// passed when exporting the ArrowSchema and the ArrowArray of a vector.
+struct ArrowOptions {
+  /// Exports VARCHAR and VARBINARY as Arrow string view arrays (utf8_view and
+  /// binary_view) which share the string buffers of the Velox vector instead
+  /// of copying the strings into an offsets and data layout. The consumer
+  /// needs Arrow 15 or later to read these.
+  bool exportToStringView{false};
+};
+
 /// Export a generic Velox Vector to an ArrowArray, as defined by Arrow's C data
 /// interface:
 ///
@@ -44,6 +54,10 @@ namespace facebook::velox {
 /// where the conversion is not zero-copy, e.g. for strings) and throws in case
 /// the conversion is not implemented yet.
 ///
+/// Dictionary vectors are exported as Arrow dictionary arrays and constant
+/// vectors as Arrow run-end encoded arrays with a single run, both without
+/// copying the wrapped values.
+///
 /// Example usage:
 ///
 ///   ArrowArray arrowArray;
@@ -57,7 +71,8 @@ namespace facebook::velox {
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options = ArrowOptions{});
 
 /// Export the type of a Velox vector to an ArrowSchema.
 ///
@@ -78,7 +93,10 @@ void exportToArrow(
 ///
 /// NOTE: Since Arrow couples type and encoding, we need both Velox type and
 /// actual data (containing encoding) to create an ArrowSchema.
-void exportToArrow(const VectorPtr&, ArrowSchema&);
+void exportToArrow(
+    const VectorPtr&,
+    ArrowSchema&,
+    const ArrowOptions& options = ArrowOptions{});
 
 /// Import an ArrowSchema into a Velox Type object.
 ///
@@ -107,7 +125,10 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema);
 /// carry a pointer to it, but not really used in most cases - unless the
 /// conversion itself requires a new allocation. In most cases no new
 /// allocations are required, unless for arrays of varchars (or varbinaries) and
-/// complex types written out of order.
+/// complex types written out of order. For string view arrays only the views
+/// are converted; the string data stays in the Arrow buffers. Run-end encoded
+/// arrays become constant vectors if they have one run and dictionary vectors
+/// otherwise.
 ///
 /// The new Velox vector returned contains only references to the underlying
 /// buffers, so it's the client's responsibility to ensure the buffer's
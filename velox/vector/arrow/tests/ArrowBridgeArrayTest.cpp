@@ -651,6 +651,124 @@ TEST_F(ArrowBridgeArrayExportTest, dictionaryNested) {
   EXPECT_EQ(values.Value(2), 3);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, constant) {
+  auto vector =
+      BaseVector::createConstant(INTEGER(), variant(10), 100, pool_.get());
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowSchema);
+  exportToArrow(vector, arrowArray, pool_.get());
+  EXPECT_STREQ(arrowSchema.format, "+r");
+  ASSERT_EQ(arrowSchema.n_children, 2);
+  EXPECT_STREQ(arrowSchema.children[0]->format, "i");
+  EXPECT_STREQ(arrowSchema.children[1]->format, "i");
+
+  EXPECT_EQ(arrowArray.length, 100);
+  EXPECT_EQ(arrowArray.null_count, 0);
+  EXPECT_EQ(arrowArray.n_buffers, 0);
+  ASSERT_EQ(arrowArray.n_children, 2);
+  const auto& runEnds = *arrowArray.children[0];
+  ASSERT_EQ(runEnds.length, 1);
+  EXPECT_EQ(static_cast<const int32_t*>(runEnds.buffers[1])[0], 100);
+  const auto& values = *arrowArray.children[1];
+  ASSERT_EQ(values.length, 1);
+  EXPECT_EQ(static_cast<const int32_t*>(values.buffers[1])[0], 10);
+
+  auto imported =
+      importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  ASSERT_TRUE(imported->isConstantEncoding());
+  ASSERT_EQ(imported->size(), 100);
+  EXPECT_TRUE(imported->equalValueAt(vector.get(), 99, 99));
+  arrowArray.release(&arrowArray);
+  arrowSchema.release(&arrowSchema);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, constantComplex) {
+  auto arrays = vectorMaker_.arrayVector<int64_t>({{1, 2}, {3, 4, 5}});
+  auto vector = BaseVector::wrapInConstant(10, 1, arrays);
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowSchema);
+  exportToArrow(vector, arrowArray, pool_.get());
+  EXPECT_STREQ(arrowSchema.format, "+r");
+  EXPECT_STREQ(arrowSchema.children[1]->format, "+l");
+
+  // The values are the one array of the constant, sharing the elements.
+  const auto& values = *arrowArray.children[1];
+  ASSERT_EQ(values.length, 1);
+  const auto* offsets = static_cast<const int32_t*>(values.buffers[1]);
+  EXPECT_EQ(offsets[0], 0);
+  EXPECT_EQ(offsets[1], 3);
+
+  auto imported =
+      importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->size(), 10);
+  for (vector_size_t i = 0; i < imported->size(); ++i) {
+    EXPECT_TRUE(imported->equalValueAt(vector.get(), i, i));
+  }
+  arrowArray.release(&arrowArray);
+  arrowSchema.release(&arrowSchema);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, constantNull) {
+  auto vector = BaseVector::createNullConstant(VARCHAR(), 5, pool_.get());
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowSchema);
+  exportToArrow(vector, arrowArray, pool_.get());
+  const auto& values = *arrowArray.children[1];
+  ASSERT_EQ(values.length, 1);
+  EXPECT_TRUE(
+      bits::isBitNull(static_cast<const uint64_t*>(values.buffers[0]), 0));
+
+  auto imported =
+      importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->size(), 5);
+  EXPECT_TRUE(imported->isNullAt(4));
+  arrowArray.release(&arrowArray);
+  arrowSchema.release(&arrowSchema);
+}
+
+TEST_F(ArrowBridgeArrayExportTest, stringView) {
+  auto vector = vectorMaker_.flatVectorNullable<std::string>({
+      "short",
+      std::nullopt,
+      "a string that is too long to be inlined",
+      "",
+      "another string that is not inlined",
+  });
+  ArrowOptions options;
+  options.exportToStringView = true;
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vector, arrowSchema, options);
+  exportToArrow(vector, arrowArray, pool_.get(), options);
+  EXPECT_STREQ(arrowSchema.format, "vu");
+
+  // Nulls, views, the string buffers of the vector and their sizes.
+  const auto& stringBuffers =
+      vector->asFlatVector<StringView>()->stringBuffers();
+  ASSERT_EQ(arrowArray.n_buffers, 3 + stringBuffers.size());
+  for (auto i = 0; i < stringBuffers.size(); ++i) {
+    EXPECT_EQ(arrowArray.buffers[2 + i], stringBuffers[i]->as<void>());
+  }
+  EXPECT_EQ(arrowArray.null_count, 1);
+
+  auto imported =
+      importFromArrowAsViewer(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->size(), vector->size());
+  for (vector_size_t i = 0; i < vector->size(); ++i) {
+    EXPECT_TRUE(imported->equalValueAt(vector.get(), i, i));
+  }
+  // The imported strings point into the exported buffers.
+  EXPECT_EQ(
+      imported->asFlatVector<StringView>()->valueAt(2).data(),
+      vector->asFlatVector<StringView>()->valueAt(2).data());
+  imported.reset();
+  arrowArray.release(&arrowArray);
+  arrowSchema.release(&arrowSchema);
+}
+
 TEST_F(ArrowBridgeArrayExportTest, unsupported) {
   ArrowArray arrowArray;
   VectorPtr vector;
@@ -659,8 +777,11 @@ TEST_F(ArrowBridgeArrayExportTest, unsupported) {
   vector = vectorMaker_.flatVectorNullable<Timestamp>({});
   exportToArrow(vector, arrowArray, pool_.get());
 
-  // Constant encoding.
-  vector = BaseVector::createConstant(INTEGER(), variant(10), 10, pool_.get());
+  // Sequence encoding.
+  vector = BaseVector::wrapInSequence(
+      makeBuffer<vector_size_t>({10}),
+      10,
+      vectorMaker_.flatVector<int32_t>({1}));
   EXPECT_THROW(exportToArrow(vector, arrowArray, pool_.get()), VeloxException);
 }
 
@@ -19,6 +19,8 @@
 #include "velox/type/Type.h"
 #include "velox/vector/BaseVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+#include "velox/vector/SelectivityVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 #include "velox/vector/fuzzer/Utils.h"
 
@@ -91,10 +93,20 @@ class ScalarGeneratorSpec : public GeneratorSpec {
       memory::MemoryPool* pool,
       size_t vectorSize) const override {
     using TFlat = typename KindToFlatVector<KIND>::type;
+    using TCpp = typename TypeTraits<KIND>::NativeType;
     VectorPtr vector = BaseVector::create(type_, vectorSize, pool);
     auto flatVector = vector->as<TFlat>();
-    for (size_t i = 0; i < vectorSize; ++i) {
-      flatVector->set(i, distribution_(rng));
+    // Generates from a copy so that threads can share a spec.
+    auto distribution = distribution_;
+    if constexpr (KIND == TypeKind::BOOLEAN) {
+      for (size_t i = 0; i < vectorSize; ++i) {
+        flatVector->set(i, distribution(rng));
+      }
+    } else {
+      auto rawValues = flatVector->mutableRawValues();
+      for (size_t i = 0; i < vectorSize; ++i) {
+        rawValues[i] = static_cast<TCpp>(distribution(rng));
+      }
     }
     return vector;
   }
@@ -103,6 +115,162 @@ class ScalarGeneratorSpec : public GeneratorSpec {
   Distribution distribution_;
 };
 
+/// Generates random lower case ASCII strings with lengths drawn from
+/// 'lengthDistribution'. The characters of a vector are in one buffer.
+template <typename Distribution>
+class VarcharGeneratorSpec : public GeneratorSpec {
+ public:
+  VarcharGeneratorSpec(
+      TypePtr type,
+      Distribution&& lengthDistribution,
+      double nullProbability)
+      : GeneratorSpec(type, nullProbability),
+        lengthDistribution_(std::forward<Distribution>(lengthDistribution)) {
+    using Ret = std::result_of_t<Distribution(FuzzerGenerator&)>;
+    static_assert(std::is_convertible_v<Ret, vector_size_t>);
+  }
+
+ protected:
+  VectorPtr generateDataImpl(
+      FuzzerGenerator& rng,
+      memory::MemoryPool* pool,
+      size_t vectorSize) const override {
+    auto vector =
+        BaseVector::create<FlatVector<StringView>>(type_, vectorSize, pool);
+    auto lengthDistribution = lengthDistribution_;
+    std::vector<vector_size_t> lengths(vectorSize);
+    size_t totalLength = 0;
+    for (auto i = 0; i < vectorSize; ++i) {
+      lengths[i] = std::max<vector_size_t>(0, lengthDistribution(rng));
+      totalLength += lengths[i];
+    }
+    auto buffer = AlignedBuffer::allocate<char>(totalLength, pool);
+    auto rawBuffer = buffer->asMutable<char>();
+    // 26^6 < 2^32, so each draw gives 6 letters.
+    for (size_t i = 0; i < totalLength; i += 6) {
+      uint32_t random = rng();
+      const auto end = std::min(totalLength, i + 6);
+      for (auto j = i; j < end; ++j) {
+        rawBuffer[j] = 'a' + random % 26;
+        random /= 26;
+      }
+    }
+    size_t offset = 0;
+    for (auto i = 0; i < vectorSize; ++i) {
+      vector->setNoCopy(i, StringView(rawBuffer + offset, lengths[i]));
+      offset += lengths[i];
+    }
+    vector->addStringBuffer(std::move(buffer));
+    return vector;
+  }
+
+ private:
+  Distribution lengthDistribution_;
+};
+
+/// Generates the strings 'prefix' followed by a key drawn from
+/// 'keyDistribution'. The number of distinct keys is set by the distribution,
+/// e.g. a uniform distribution over a range or a ZetaDistribution for skewed
+/// keys. Specs with the same prefix produce matching keys, e.g. for the two
+/// sides of a join.
+template <typename Distribution>
+class KeyVarcharGeneratorSpec : public GeneratorSpec {
+ public:
+  KeyVarcharGeneratorSpec(
+      TypePtr type,
+      Distribution&& keyDistribution,
+      std::string prefix,
+      double nullProbability)
+      : GeneratorSpec(type, nullProbability),
+        keyDistribution_(std::forward<Distribution>(keyDistribution)),
+        prefix_(std::move(prefix)) {
+    using Ret = std::result_of_t<Distribution(FuzzerGenerator&)>;
+    static_assert(std::is_convertible_v<Ret, int64_t>);
+  }
+
+ protected:
+  VectorPtr generateDataImpl(
+      FuzzerGenerator& rng,
+      memory::MemoryPool* pool,
+      size_t vectorSize) const override {
+    auto vector =
+        BaseVector::create<FlatVector<StringView>>(type_, vectorSize, pool);
+    auto keyDistribution = keyDistribution_;
+    std::string key = prefix_;
+    for (auto i = 0; i < vectorSize; ++i) {
+      key.resize(prefix_.size());
+      key += std::to_string(static_cast<int64_t>(keyDistribution(rng)));
+      vector->set(i, StringView(key));
+    }
+    return vector;
+  }
+
+ private:
+  Distribution keyDistribution_;
+  const std::string prefix_;
+};
+
+/// Generates a child of a row that repeats the value of the earlier child
+/// 'source' of the row with probability 'correlation' and takes the value
+/// generated by 'base' otherwise. With correlation 1 the column is a copy of
+/// 'source', with correlation 0 it is independent of it.
+class CorrelatedGeneratorSpec : public GeneratorSpec {
+ public:
+  CorrelatedGeneratorSpec(
+      GeneratorSpecPtr base,
+      column_index_t source,
+      double correlation)
+      : GeneratorSpec(base->type(), 0.0),
+        base_(std::move(base)),
+        source_(source),
+        correlation_(correlation) {
+    VELOX_CHECK_GE(correlation_, 0.0);
+    VELOX_CHECK_LE(correlation_, 1.0);
+  }
+
+  column_index_t source() const {
+    return source_;
+  }
+
+  VectorPtr generateCorrelated(
+      FuzzerGenerator& rng,
+      memory::MemoryPool* pool,
+      size_t vectorSize,
+      const VectorPtr& source) const {
+    VELOX_CHECK_GE(source->size(), vectorSize);
+    auto independent = base_->generateData(rng, pool, vectorSize);
+    SelectivityVector fromSource(vectorSize, false);
+    for (auto i = 0; i < vectorSize; ++i) {
+      if (coinToss(rng, correlation_)) {
+        fromSource.setValid(i, true);
+      }
+    }
+    fromSource.updateBounds();
+    if (!fromSource.hasSelections()) {
+      return independent;
+    }
+    SelectivityVector fromBase(vectorSize);
+    fromBase.deselect(fromSource);
+    auto result = BaseVector::create(type_, vectorSize, pool);
+    result->copy(source.get(), fromSource, nullptr);
+    result->copy(independent.get(), fromBase, nullptr);
+    return result;
+  }
+
+ protected:
+  VectorPtr generateDataImpl(
+      FuzzerGenerator&,
+      memory::MemoryPool*,
+      size_t /*vectorSize*/) const override {
+    VELOX_USER_FAIL("A correlated column can only be generated in a row");
+  }
+
+ private:
+  const GeneratorSpecPtr base_;
+  const column_index_t source_;
+  const double correlation_;
+};
+
 class RowGeneratorSpec : public GeneratorSpec {
  public:
   RowGeneratorSpec(
@@ -110,7 +278,19 @@ class RowGeneratorSpec : public GeneratorSpec {
       std::vector<GeneratorSpecPtr>&& generatorSpecVector,
       double nullProbability)
       : GeneratorSpec(type, nullProbability),
-        children_(std::move(generatorSpecVector)) {}
+        children_(std::move(generatorSpecVector)) {
+    for (column_index_t i = 0; i < children_.size(); ++i) {
+      if (auto correlated = dynamic_cast<const CorrelatedGeneratorSpec*>(
+              children_[i].get())) {
+        const auto source = correlated->source();
+        VELOX_USER_CHECK_LT(
+            source, i, "A correlated column must follow its source column");
+        VELOX_USER_CHECK(
+            children_[source]->type()->equivalent(*correlated->type()),
+            "A correlated column must have the type of its source column");
+      }
+    }
+  }
 
   ~RowGeneratorSpec() {}
 
@@ -121,7 +301,13 @@ class RowGeneratorSpec : public GeneratorSpec {
       size_t vectorSize) const override {
     std::vector<VectorPtr> children;
     for (auto child : children_) {
-      children.push_back(child->generateData(rng, pool, vectorSize));
+      if (auto correlated =
+              dynamic_cast<const CorrelatedGeneratorSpec*>(child.get())) {
+        children.push_back(correlated->generateCorrelated(
+            rng, pool, vectorSize, children[correlated->source()]));
+      } else {
+        children.push_back(child->generateData(rng, pool, vectorSize));
+      }
     }
     auto rowType = std::dynamic_pointer_cast<const RowType>(type_);
     return std::make_shared<RowVector>(
@@ -159,11 +345,12 @@ class ArrayGeneratorSpec : public GeneratorSpec {
     auto sizes = allocateSizes(vectorSize, pool);
     auto rawSizes = sizes->asMutable<vector_size_t>();
     vector_size_t numElements = 0;
+    auto lengthDistribution = lengthDistribution_;
 
     // Randomly creates container size.
     for (auto i = 0; i < vectorSize; ++i) {
       rawOffsets[i] = numElements;
-      vector_size_t length = lengthDistribution_(rng);
+      vector_size_t length = lengthDistribution(rng);
       rawSizes[i] = length;
       numElements += length;
     }
@@ -206,11 +393,12 @@ class MapGeneratorSpec : public GeneratorSpec {
     auto sizes = allocateSizes(vectorSize, pool);
     auto rawSizes = sizes->asMutable<vector_size_t>();
     vector_size_t childSize = 0;
+    auto lengthDistribution = lengthDistribution_;
 
     // Randomly creates container size.
     for (auto i = 0; i < vectorSize; ++i) {
       rawOffsets[i] = childSize;
-      auto length = lengthDistribution_(rng);
+      auto length = lengthDistribution(rng);
       rawSizes[i] = length;
       childSize += length;
     }
@@ -338,6 +526,37 @@ DEFINE_RANDOM_SCALAR_FACTORY(RANDOM_DOUBLE, DOUBLE)
 
 #undef DEFINE_RANDOM_SCALAR_FACTORY
 
+template <typename Distribution>
+inline GeneratorSpecPtr RANDOM_VARCHAR(
+    Distribution&& lengthDistribution,
+    double nullProbability = 0.0) {
+  return std::make_shared<const VarcharGeneratorSpec<Distribution>>(
+      VARCHAR(),
+      std::forward<Distribution>(lengthDistribution),
+      nullProbability);
+}
+
+template <typename Distribution>
+inline GeneratorSpecPtr RANDOM_VARCHAR_KEY(
+    Distribution&& keyDistribution,
+    std::string prefix = "",
+    double nullProbability = 0.0) {
+  return std::make_shared<const KeyVarcharGeneratorSpec<Distribution>>(
+      VARCHAR(),
+      std::forward<Distribution>(keyDistribution),
+      std::move(prefix),
+      nullProbability);
+}
+
+/// 'source' is the index of an earlier child in the enclosing RANDOM_ROW.
+inline GeneratorSpecPtr CORRELATED(
+    GeneratorSpecPtr base,
+    column_index_t source,
+    double correlation) {
+  return std::make_shared<const CorrelatedGeneratorSpec>(
+      std::move(base), source, correlation);
+}
+
 inline GeneratorSpecPtr RANDOM_ROW(
     std::vector<GeneratorSpecPtr>&& generatorSpecVector,
     double nullProbability = 0.0) {
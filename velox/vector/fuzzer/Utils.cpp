@@ -34,6 +34,9 @@ BufferPtr generateNullsBuffer(
     memory::MemoryPool* pool,
     vector_size_t vectorSize,
     double nullProbability) {
+  if (nullProbability <= 0) {
+    return nullptr;
+  }
   NullsBuilder builder{vectorSize, pool};
   for (size_t i = 0; i < vectorSize; ++i) {
     if (coinToss(rng, nullProbability)) {
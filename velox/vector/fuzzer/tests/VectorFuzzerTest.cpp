@@ -17,11 +17,14 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/Memory.h"
 #include "velox/vector/DictionaryVector.h"
+#include "velox/vector/fuzzer/GeneratorSpec.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
 using namespace facebook::velox;
+using namespace facebook::velox::generator_spec_maker;
 
 namespace {
 
@@ -743,4 +746,85 @@ TEST_F(VectorFuzzerTest, complexTooLarge) {
       VeloxUserError);
 }
 
+TEST_F(VectorFuzzerTest, generatorSpecVarchar) {
+  FuzzerGenerator rng(1);
+  auto spec = RANDOM_VARCHAR(std::uniform_int_distribution<int32_t>(3, 20));
+  auto vector = spec->generateData(rng, pool(), 1'000);
+  ASSERT_FALSE(vector->mayHaveNulls());
+  auto flat = vector->asFlatVector<StringView>();
+  ASSERT_NE(flat, nullptr);
+  for (auto i = 0; i < flat->size(); ++i) {
+    auto value = flat->valueAt(i);
+    ASSERT_GE(value.size(), 3);
+    ASSERT_LE(value.size(), 20);
+    for (auto c : std::string_view(value)) {
+      ASSERT_TRUE(c >= 'a' && c <= 'z');
+    }
+  }
+}
+
+TEST_F(VectorFuzzerTest, generatorSpecKeys) {
+  FuzzerGenerator rng(1);
+  auto spec = RANDOM_VARCHAR_KEY(
+      std::uniform_int_distribution<int32_t>(0, 9), "customer_", 0.1);
+  auto vector = spec->generateData(rng, pool(), 1'000);
+  auto flat = vector->asFlatVector<StringView>();
+  std::unordered_set<std::string> keys;
+  vector_size_t numNulls = 0;
+  for (auto i = 0; i < flat->size(); ++i) {
+    if (flat->isNullAt(i)) {
+      ++numNulls;
+      continue;
+    }
+    keys.insert(flat->valueAt(i).str());
+  }
+  EXPECT_GT(numNulls, 0);
+  EXPECT_EQ(keys.size(), 10);
+  EXPECT_EQ(keys.count("customer_0"), 1);
+  EXPECT_EQ(keys.count("customer_9"), 1);
+}
+
+TEST_F(VectorFuzzerTest, generatorSpecCorrelated) {
+  FuzzerGenerator rng(1);
+  auto spec = RANDOM_ROW({
+      RANDOM_BIGINT(std::uniform_int_distribution<int64_t>(0, 1'000)),
+      CORRELATED(
+          RANDOM_BIGINT(std::uniform_int_distribution<int64_t>(2'000, 3'000)),
+          0,
+          0.5),
+      CORRELATED(
+          RANDOM_BIGINT(std::uniform_int_distribution<int64_t>(0, 1'000)),
+          0,
+          1.0),
+  });
+  auto vector = spec->generateData(rng, pool(), 1'000)->as<RowVector>();
+  auto source = vector->childAt(0)->asFlatVector<int64_t>();
+  auto half = vector->childAt(1);
+  auto copy = vector->childAt(2);
+  vector_size_t numEqual = 0;
+  for (auto i = 0; i < vector->size(); ++i) {
+    ASSERT_TRUE(copy->equalValueAt(source, i, i));
+    numEqual += half->equalValueAt(source, i, i);
+  }
+  EXPECT_GT(numEqual, 400);
+  EXPECT_LT(numEqual, 600);
+
+  // The source must be an earlier column of the same type.
+  VELOX_ASSERT_THROW(
+      RANDOM_ROW({CORRELATED(
+          RANDOM_BIGINT(std::uniform_int_distribution<int64_t>(0, 10)),
+          0,
+          0.5)}),
+      "A correlated column must follow its source column");
+  VELOX_ASSERT_THROW(
+      RANDOM_ROW({
+          RANDOM_INTEGER(std::uniform_int_distribution<int32_t>(0, 10)),
+          CORRELATED(
+              RANDOM_BIGINT(std::uniform_int_distribution<int64_t>(0, 10)),
+              0,
+              0.5),
+      }),
+      "A correlated column must have the type of its source column");
+}
+
 } // namespace
@@ -1396,4 +1396,60 @@ TEST_F(DecodedVectorTest, previousIndicesInReUsedDecodedVector) {
   EXPECT_EQ(rawIndices[0], 0);
 }
 
+TEST_F(DecodedVectorTest, gather) {
+  auto test = [&](const VectorPtr& vector) {
+    SCOPED_TRACE(vector->toString());
+    for (const auto* rows : {&allSelected_, &halfSelected_}) {
+      DecodedVector decoded(*vector, *rows);
+      std::vector<int64_t> values(rows->end());
+      std::vector<uint64_t> nulls(bits::nwords(rows->end()), 0);
+      decoded.gather(*rows, values.data());
+      decoded.gatherNulls(*rows, nulls.data());
+      rows->applyToSelected([&](auto row) {
+        ASSERT_EQ(bits::isBitNull(nulls.data(), row), vector->isNullAt(row));
+        if (!vector->isNullAt(row)) {
+          ASSERT_EQ(values[row], decoded.valueAt<int64_t>(row));
+        }
+      });
+    }
+  };
+
+  const vector_size_t size = allSelected_.size();
+  auto flat = makeFlatVector<int64_t>(size, [](auto row) { return row; });
+  auto flatNulls = makeFlatVector<int64_t>(
+      size, [](auto row) { return row; }, nullEvery(3));
+  auto reversed = makeIndicesInReverse(size);
+  test(flat);
+  test(flatNulls);
+  test(makeConstant<int64_t>(11, size));
+  test(makeNullConstant(TypeKind::BIGINT, size));
+  test(wrapInDictionary(reversed, size, flat));
+  test(wrapInDictionary(reversed, size, flatNulls));
+  // Nulls added by the dictionary.
+  test(BaseVector::wrapInDictionary(
+      makeNulls(size, nullEvery(5)), reversed, size, flatNulls));
+  test(wrapInDictionary(
+      reversed, size, wrapInDictionary(reversed, size, flatNulls)));
+
+  // 4 byte and floating point values.
+  auto doubles = wrapInDictionary(
+      reversed,
+      size,
+      makeFlatVector<double>(size, [](auto row) { return row / 2.0; }));
+  DecodedVector decodedDoubles(*doubles, allSelected_);
+  std::vector<double> doubleValues(size);
+  decodedDoubles.gather(allSelected_, doubleValues.data());
+  auto ints = wrapInDictionary(
+      reversed, size, makeFlatVector<int32_t>(size, [](auto row) {
+        return row;
+      }));
+  DecodedVector decodedInts(*ints, allSelected_);
+  std::vector<int32_t> intValues(size);
+  decodedInts.gather(allSelected_, intValues.data());
+  for (auto i = 0; i < size; ++i) {
+    ASSERT_EQ(doubleValues[i], (size - 1 - i) / 2.0);
+    ASSERT_EQ(intValues[i], size - 1 - i);
+  }
+}
+
 } // namespace facebook::velox::test
@@ -254,6 +254,36 @@ TEST_F(SimpleVectorNonParameterizedTest, computeAscii) {
   }
 }
 
+TEST_F(SimpleVectorNonParameterizedTest, computeAsciiFlat) {
+  // Inline strings, out of line strings longer than a SIMD width and strings
+  // with a non-ASCII character at the start, middle and tail.
+  const std::string longAscii(70, 'a');
+  std::vector<std::pair<std::string, bool>> testCases = {
+      {"abc", true},
+      {"ab\u00e9", false},
+      {"abcdefghijk\u00e9", false},
+      {longAscii, true},
+      {"\u00e9" + longAscii, false},
+      {longAscii.substr(0, 40) + "\u00e9" + longAscii.substr(0, 20), false},
+      {longAscii + "\u00e9", false},
+  };
+  for (const auto& [string, isAscii] : testCases) {
+    SCOPED_TRACE(string);
+    auto vector = maker_.flatVectorNullable<StringView>(
+        {StringView("ascii"),
+         StringView(string),
+         std::nullopt,
+         StringView(longAscii)});
+    SelectivityVector all(vector->size());
+    ASSERT_EQ(vector->computeAndSetIsAscii(all), isAscii);
+
+    // A null row is ignored even if its value is not ASCII.
+    vector->invalidateIsAscii();
+    vector->setNull(1, true);
+    ASSERT_TRUE(vector->computeAndSetIsAscii(all));
+  }
+}
+
 TEST_F(SimpleVectorNonParameterizedTest, isAscii) {
   for (auto encoding : kAsciiEncodings) {
     LOG(INFO) << "Running:" << encoding;
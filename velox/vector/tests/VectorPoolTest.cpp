@@ -146,4 +146,77 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+  auto rowType = ROW({"a", "b"}, {ARRAY(BIGINT()), MAP(INTEGER(), VARCHAR())});
+
+  auto vector = vectorPool.get(rowType, 100);
+  ASSERT_EQ(100, vector->size());
+  auto* rowVector = vector->as<RowVector>();
+  rowVector->setNull(5, true);
+  auto* arrayVector = rowVector->childAt(0)->as<ArrayVector>();
+  arrayVector->elements()->resize(300);
+  for (auto i = 0; i < 100; ++i) {
+    arrayVector->setOffsetAndSize(i, i * 3, 3);
+  }
+
+  auto* vectorPtr = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+
+  // A recycled vector has its rows reset to not null, empty arrays and maps.
+  vector = vectorPool.get(rowType, 200);
+  ASSERT_EQ(vectorPtr, vector.get());
+  ASSERT_EQ(200, vector->size());
+  rowVector = vector->as<RowVector>();
+  arrayVector = rowVector->childAt(0)->as<ArrayVector>();
+  ASSERT_EQ(200, arrayVector->size());
+  ASSERT_EQ(200, rowVector->childAt(1)->size());
+  ASSERT_EQ(0, arrayVector->elements()->size());
+  for (auto i = 0; i < 200; ++i) {
+    ASSERT_FALSE(rowVector->isNullAt(i));
+    ASSERT_EQ(0, arrayVector->sizeAt(i));
+  }
+
+  // A vector with a shared child is not recycled.
+  auto child = rowVector->childAt(0);
+  ASSERT_FALSE(vectorPool.release(vector));
+  child.reset();
+
+  // Types are compared by value.
+  ASSERT_TRUE(vectorPool.release(vector));
+  vector = vectorPool.get(
+      ROW({"a", "b"}, {ARRAY(BIGINT()), MAP(INTEGER(), VARCHAR())}), 10);
+  ASSERT_EQ(vectorPtr, vector.get());
+  ASSERT_EQ(10, vector->size());
+}
+
+TEST_F(VectorPoolTest, stats) {
+  VectorPool vectorPool(pool());
+
+  auto flat = vectorPool.get(BIGINT(), 100);
+  auto array = vectorPool.get(ARRAY(VARCHAR()), 100);
+  ASSERT_EQ(2, vectorPool.stats().numAllocated);
+  ASSERT_EQ(0, vectorPool.stats().numRecycled);
+
+  ASSERT_TRUE(vectorPool.release(flat));
+  ASSERT_TRUE(vectorPool.release(array));
+  flat = vectorPool.get(BIGINT(), 100);
+  array = vectorPool.get(ARRAY(VARCHAR()), 100);
+  ASSERT_EQ(2, vectorPool.stats().numAllocated);
+  ASSERT_EQ(2, vectorPool.stats().numRecycled);
+
+  // Cleared vectors are allocated again.
+  ASSERT_TRUE(vectorPool.release(flat));
+  ASSERT_TRUE(vectorPool.release(array));
+  vectorPool.clear();
+  flat = vectorPool.get(BIGINT(), 100);
+  array = vectorPool.get(ARRAY(VARCHAR()), 100);
+  ASSERT_EQ(4, vectorPool.stats().numAllocated);
+  ASSERT_EQ(2, vectorPool.stats().numRecycled);
+
+  vectorPool.resetStats();
+  ASSERT_EQ(0, vectorPool.stats().numAllocated);
+  ASSERT_EQ(0, vectorPool.stats().numRecycled);
+}
 } // namespace facebook::velox::test
@@ -2496,6 +2496,32 @@ TEST_F(VectorTest, resizeArrayAndMapResetOffsets) {
   }
 }
 
+TEST_F(VectorTest, encodeRuns) {
+  auto flat = makeNullableFlatVector<int64_t>(
+      {1, 1, 1, std::nullopt, std::nullopt, 2, 2, 2, 2, 1});
+  auto encoded = BaseVector::encodeRuns(flat, 2);
+  ASSERT_NE(encoded, nullptr);
+  ASSERT_EQ(VectorEncoding::Simple::SEQUENCE, encoded->encoding());
+  ASSERT_EQ(4, encoded->valueVector()->size());
+  test::assertEqualVectors(flat, encoded);
+
+  // Runs that are too short on average.
+  ASSERT_EQ(BaseVector::encodeRuns(flat, 3), nullptr);
+
+  auto strings = makeFlatVector<std::string>(
+      {"a long string value", "a long string value", "b", "b", "b", "b"});
+  encoded = BaseVector::encodeRuns(strings, 3);
+  ASSERT_NE(encoded, nullptr);
+  ASSERT_EQ(2, encoded->valueVector()->size());
+  test::assertEqualVectors(strings, encoded);
+
+  // Only flat scalar vectors are encoded.
+  ASSERT_EQ(
+      BaseVector::encodeRuns(makeFlatVector<bool>({true, true, true}), 1),
+      nullptr);
+  ASSERT_EQ(BaseVector::encodeRuns(makeConstant<int64_t>(1, 100), 1), nullptr);
+}
+
 TEST_F(VectorTest, getRawStringBufferWithSpace) {
   auto vector =
       makeFlatVector<StringView>({"ee", "rr", "rryy", "12345678901234"});